@@ -0,0 +1,134 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Synthetic heaps that stress the garbage collector. Each benchmark builds
+// its heap in setup and then churns it in run. With d8, which provides
+// performance.pauses(), the harness records every collection of the
+// measured iterations and samples the heap after each iteration. Needs
+// ../workload-base.js.
+//
+// For a benchmark named Foo the harness prints
+//   Foo: <iterations per second>
+//   Foo-Scavenges: <number of scavenges>
+//   Foo-Scavenge-P50, Foo-Scavenge-P99, Foo-Scavenge-Max: <pauses in ms>
+//   Foo-MarkCompacts: <number of mark-compacts>
+//   Foo-MarkCompact-P50, Foo-MarkCompact-P99, Foo-MarkCompact-Max
+//   Foo-LimitGrowth: <growth of the old generation limit in MB>
+//   Foo-HeapSize: <committed heap size at the end in MB>
+//   Foo-PeakRSS: <largest resident set size in MB>
+//   Foo-RSSGrowth: <growth of the resident set size in MB>
+// Pause percentiles are omitted for types of collection that did not
+// happen. With --series among the arguments, the samples are also printed
+// one per line as
+//   Foo-Sample: <time in ms> <used MB> <limit MB> <rss MB>
+
+
+function GCBenchmark(name, setup, run, tearDown) {
+  WorkloadBenchmark.call(this, name, setup, run, tearDown);
+}
+
+
+GCBenchmark.prototype = Object.create(WorkloadBenchmark.prototype);
+GCBenchmark.prototype.constructor = GCBenchmark;
+GCBenchmark.prototype.kWarmupTime = 500;
+GCBenchmark.prototype.kMeasureTime = 3000;
+GCBenchmark.prototype.kMinIterations = 10;
+
+
+function GCSample(time, pauses) {
+  this.time = time;
+  this.used = pauses.usedHeapSize;
+  this.total = pauses.totalHeapSize;
+  this.limit = pauses.allocationLimit;
+  this.rss = pauses.rss;
+}
+
+
+// Samples the heap and collects the collections after every iteration.
+// Only the collections of the measured iterations are reported, so the log
+// is drained first.
+function GCRecorder() {
+  var pauses = WorkloadBenchmark.Pauses(true);
+  this.first = new GCSample(WorkloadBenchmark.Now(), pauses);
+  this.samples = [];
+  this.collections = [];
+  this.dropped = 0;
+}
+
+
+GCRecorder.prototype.Before = function() { }
+
+
+GCRecorder.prototype.After = function(end) {
+  var pauses = WorkloadBenchmark.Pauses(true);
+  this.samples.push(new GCSample(end, pauses));
+  this.collections.push.apply(this.collections, pauses.collections);
+  this.dropped += pauses.droppedCollections;
+}
+
+
+GCBenchmark.prototype.CreateRecorder = function() {
+  return WorkloadBenchmark.Pauses ? new GCRecorder() : null;
+}
+
+
+function MB(bytes) {
+  return (bytes / (1024 * 1024)).toFixed(2);
+}
+
+
+GCBenchmark.prototype.ReportPauses = function(label, durations) {
+  print(this.name + '-' + label + 's: ' + durations.length);
+  if (durations.length == 0) return;
+  var sorted = durations.slice().sort(function(a, b) { return a - b; });
+  var prefix = this.name + '-' + label;
+  print(prefix + '-P50: ' +
+        WorkloadBenchmark.Percentile(sorted, 50).toFixed(3));
+  print(prefix + '-P99: ' +
+        WorkloadBenchmark.Percentile(sorted, 99).toFixed(3));
+  print(prefix + '-Max: ' + sorted[sorted.length - 1].toFixed(3));
+}
+
+
+GCBenchmark.prototype.Report = function(samples, recorder) {
+  var total = 0;
+  for (var i = 0; i < samples.length; i++) total += samples[i];
+  print(this.name + ': ' + (1000 * samples.length / total).toFixed(2));
+  if (!recorder) return;
+
+  var scavenges = [];
+  var markCompacts = [];
+  var collections = recorder.collections;
+  for (var i = 0; i < collections.length; i++) {
+    var durations =
+        collections[i].type == 'scavenge' ? scavenges : markCompacts;
+    durations.push(collections[i].duration);
+  }
+  this.ReportPauses('Scavenge', scavenges);
+  this.ReportPauses('MarkCompact', markCompacts);
+  if (recorder.dropped > 0) {
+    print(this.name + '-DroppedPauses: ' + recorder.dropped);
+  }
+
+  var first = recorder.first;
+  var heapSamples = recorder.samples;
+  var last = heapSamples[heapSamples.length - 1];
+  var peakRSS = first.rss;
+  for (var i = 0; i < heapSamples.length; i++) {
+    peakRSS = Math.max(peakRSS, heapSamples[i].rss);
+  }
+  print(this.name + '-LimitGrowth: ' + MB(last.limit - first.limit));
+  print(this.name + '-HeapSize: ' + MB(last.total));
+  if (first.rss >= 0) {
+    print(this.name + '-PeakRSS: ' + MB(peakRSS));
+    print(this.name + '-RSSGrowth: ' + MB(last.rss - first.rss));
+  }
+  if (!WorkloadBenchmark.options.series) return;
+  for (var i = 0; i < heapSamples.length; i++) {
+    var sample = heapSamples[i];
+    print(this.name + '-Sample: ' + (sample.time - first.time).toFixed(1) +
+          ' ' + MB(sample.used) + ' ' + MB(sample.limit) + ' ' +
+          MB(sample.rss));
+  }
+}
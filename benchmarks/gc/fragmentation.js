@@ -0,0 +1,48 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Allocates long-lived objects of very different sizes interleaved with
+// each other and then frees a random half of them in every iteration,
+// refilling the holes with objects of other sizes. The old generation ends
+// up with many partially used pages, which makes sweeping and the free
+// lists work hard and gives compaction something to do.
+
+var kSlots = 50000;
+var kFreedPerIteration = 10000;
+var kSizes = [2, 7, 16, 50, 130, 400, 1200];
+
+var fragmentationSlots = null;
+
+
+function NewFragment(size) {
+  var fragment = new Array(size);
+  for (var i = 0; i < size; i++) fragment[i] = i;
+  return fragment;
+}
+
+
+function SetUpFragmentation() {
+  fragmentationSlots = new Array(kSlots);
+  for (var i = 0; i < kSlots; i++) {
+    fragmentationSlots[i] = NewFragment(kSizes[i % kSizes.length]);
+  }
+}
+
+
+function RunFragmentation() {
+  for (var i = 0; i < kFreedPerIteration; i++) {
+    var index = Math.floor(Math.random() * kSlots);
+    var size = kSizes[Math.floor(Math.random() * kSizes.length)];
+    fragmentationSlots[index] = NewFragment(size);
+  }
+}
+
+
+function TearDownFragmentation() {
+  fragmentationSlots = null;
+}
+
+
+new GCBenchmark('Fragmentation', SetUpFragmentation, RunFragmentation,
+                TearDownFragmentation);
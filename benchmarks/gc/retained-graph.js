@@ -0,0 +1,64 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A large, long-lived object graph of records with string and array
+// fields, of which a small fraction is replaced in every iteration. Most of
+// the graph survives every collection, so full collections have to mark
+// all of it, while the replaced records are promoted before they die.
+
+var kGraphNodes = 200000;
+var kReplacedPerIteration = 2000;
+var kNeighbours = 4;
+
+var graphNodes = null;
+
+
+function GraphNode(id) {
+  this.id = id;
+  this.name = 'node-' + id;
+  this.weight = Math.random();
+  this.neighbours = new Array(kNeighbours);
+  this.payload = [id, id * 2, id * 3];
+}
+
+
+function LinkNode(node) {
+  for (var i = 0; i < kNeighbours; i++) {
+    node.neighbours[i] = graphNodes[Math.floor(Math.random() * kGraphNodes)];
+  }
+}
+
+
+function SetUpRetainedGraph() {
+  graphNodes = new Array(kGraphNodes);
+  for (var i = 0; i < kGraphNodes; i++) graphNodes[i] = new GraphNode(i);
+  for (var i = 0; i < kGraphNodes; i++) LinkNode(graphNodes[i]);
+}
+
+
+function RunRetainedGraph() {
+  for (var i = 0; i < kReplacedPerIteration; i++) {
+    var index = Math.floor(Math.random() * kGraphNodes);
+    var node = new GraphNode(index);
+    graphNodes[index] = node;
+    LinkNode(node);
+  }
+  // Walk a part of the graph so that the churn is not dead code.
+  var node = graphNodes[0];
+  var sum = 0;
+  for (var i = 0; i < 1000; i++) {
+    sum += node.weight;
+    node = node.neighbours[i % kNeighbours];
+  }
+  if (isNaN(sum)) throw new Error('RetainedGraph: bad weights');
+}
+
+
+function TearDownRetainedGraph() {
+  graphNodes = null;
+}
+
+
+new GCBenchmark('RetainedGraph', SetUpRetainedGraph, RunRetainedGraph,
+                TearDownRetainedGraph);
@@ -0,0 +1,18 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Runs the GC workloads with d8, e.g. from this directory:
+//   d8 --expose-gc run.js
+// Names of benchmarks given after -- restrict the run to those benchmarks,
+// and --series prints the heap samples of every iteration:
+//   d8 --expose-gc run.js -- Fragmentation --series
+
+load('../workload-base.js');
+load('base.js');
+load('retained-graph.js');
+load('fragmentation.js');
+load('store-buffer.js');
+load('weak-storm.js');
+
+WorkloadBenchmark.RunAll(typeof arguments != 'undefined' ? arguments : []);
@@ -0,0 +1,54 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Stores pointers to freshly allocated objects into a large array and
+// into many small objects that live in the old generation. Every store
+// creates an old-to-new pointer that the write barrier records in the
+// store buffer, and scavenges have to process all of them.
+
+var kOldObjects = 100000;
+var kStoresPerIteration = 200000;
+
+var storeBufferArray = null;
+var storeBufferObjects = null;
+
+
+function StoreBufferHolder() {
+  this.value = null;
+}
+
+
+function SetUpStoreBuffer() {
+  storeBufferArray = new Array(kOldObjects);
+  storeBufferObjects = new Array(kOldObjects);
+  for (var i = 0; i < kOldObjects; i++) {
+    storeBufferArray[i] = null;
+    storeBufferObjects[i] = new StoreBufferHolder();
+  }
+  // Move the holders into the old generation.
+  if (typeof gc == 'function') gc();
+}
+
+
+function RunStoreBuffer() {
+  for (var i = 0; i < kStoresPerIteration; i++) {
+    var index = Math.floor(Math.random() * kOldObjects);
+    var value = {index: index};
+    if (i & 1) {
+      storeBufferArray[index] = value;
+    } else {
+      storeBufferObjects[index].value = value;
+    }
+  }
+}
+
+
+function TearDownStoreBuffer() {
+  storeBufferArray = null;
+  storeBufferObjects = null;
+}
+
+
+new GCBenchmark('StoreBuffer', SetUpStoreBuffer, RunStoreBuffer,
+                TearDownStoreBuffer);
@@ -0,0 +1,56 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Creates and drops large numbers of weak references, in the form of
+// WeakMap entries keyed by short-lived objects and WeakSets of long-lived
+// ones, so that every mark-compact has many ephemerons to process and
+// clear.
+
+var kLiveKeys = 20000;
+var kWeakEntriesPerIteration = 50000;
+
+var weakStormKeys = null;
+var weakStormMap = null;
+var weakStormSet = null;
+
+
+function SetUpWeakStorm() {
+  weakStormKeys = new Array(kLiveKeys);
+  weakStormMap = new WeakMap();
+  weakStormSet = new WeakSet();
+  for (var i = 0; i < kLiveKeys; i++) {
+    var key = {id: i};
+    weakStormKeys[i] = key;
+    weakStormMap.set(key, {value: i});
+    weakStormSet.add(key);
+  }
+}
+
+
+function RunWeakStorm() {
+  // Entries whose keys die right away.
+  for (var i = 0; i < kWeakEntriesPerIteration; i++) {
+    weakStormMap.set({id: i}, [i]);
+  }
+  // Replace some of the live keys, so that their entries die later.
+  for (var i = 0; i < kLiveKeys / 10; i++) {
+    var index = Math.floor(Math.random() * kLiveKeys);
+    var key = {id: index};
+    weakStormKeys[index] = key;
+    weakStormMap.set(key, {value: index});
+    weakStormSet.add(key);
+  }
+  // A fresh WeakMap every iteration drops all of the old one's entries.
+  if (Math.random() < 0.1) weakStormMap = new WeakMap();
+}
+
+
+function TearDownWeakStorm() {
+  weakStormKeys = null;
+  weakStormMap = null;
+  weakStormSet = null;
+}
+
+
+new GCBenchmark('WeakStorm', SetUpWeakStorm, RunWeakStorm, TearDownWeakStorm);
@@ -0,0 +1,91 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The server workloads report their throughput together with the
+// distribution of their iteration times. Pauses of the garbage collector
+// show up in the upper percentiles of that distribution. Needs
+// ../workload-base.js.
+//
+// For a benchmark named Foo the harness prints
+//   Foo: <iterations per second>
+//   Foo-P50: <median iteration time in ms>
+//   Foo-P99: <99th percentile iteration time in ms>
+//   Foo-Max: <longest iteration time in ms>
+// When run with d8, which provides performance.pauses(), the iterations at
+// or above the 99th percentile are attributed to scavenges, mark-compacts
+// (including the incremental marking leading up to them) and compilation:
+//   Foo-P99-Scavenge: <mean scavenge time per outlier in ms>
+//   Foo-P99-MarkCompact: <mean mark-compact time per outlier in ms>
+//   Foo-P99-Compiles: <mean number of compiled functions per outlier>
+
+
+function ServerBenchmark(name, setup, run, tearDown) {
+  WorkloadBenchmark.call(this, name, setup, run, tearDown);
+}
+
+
+ServerBenchmark.prototype = Object.create(WorkloadBenchmark.prototype);
+ServerBenchmark.prototype.constructor = ServerBenchmark;
+
+
+// The pauses of one iteration, as differences of performance.pauses().
+function ServerPauses(before, after) {
+  this.scavenge = after.scavengeTime - before.scavengeTime;
+  this.markCompact = after.markCompactTime - before.markCompactTime +
+      after.incrementalMarkingTime - before.incrementalMarkingTime;
+  this.compiles = after.compiles - before.compiles;
+}
+
+
+// Records the pauses of every iteration.
+function ServerRecorder() {
+  this.pauses = [];
+  this.before = null;
+}
+
+
+ServerRecorder.prototype.Before = function() {
+  this.before = WorkloadBenchmark.Pauses();
+}
+
+
+ServerRecorder.prototype.After = function(end) {
+  this.pauses.push(new ServerPauses(this.before, WorkloadBenchmark.Pauses()));
+}
+
+
+ServerBenchmark.prototype.CreateRecorder = function() {
+  return WorkloadBenchmark.Pauses ? new ServerRecorder() : null;
+}
+
+
+ServerBenchmark.prototype.Report = function(samples, recorder) {
+  var total = 0;
+  for (var i = 0; i < samples.length; i++) total += samples[i];
+  var sorted = samples.slice().sort(function(a, b) { return a - b; });
+  var p99 = WorkloadBenchmark.Percentile(sorted, 99);
+  print(this.name + ': ' + (1000 * samples.length / total).toFixed(2));
+  print(this.name + '-P50: ' +
+        WorkloadBenchmark.Percentile(sorted, 50).toFixed(3));
+  print(this.name + '-P99: ' + p99.toFixed(3));
+  print(this.name + '-Max: ' + sorted[sorted.length - 1].toFixed(3));
+  if (!recorder) return;
+
+  var pauses = recorder.pauses;
+  var outliers = 0;
+  var scavenge = 0;
+  var markCompact = 0;
+  var compiles = 0;
+  for (var i = 0; i < samples.length; i++) {
+    if (samples[i] < p99) continue;
+    outliers++;
+    scavenge += pauses[i].scavenge;
+    markCompact += pauses[i].markCompact;
+    compiles += pauses[i].compiles;
+  }
+  print(this.name + '-P99-Scavenge: ' + (scavenge / outliers).toFixed(3));
+  print(this.name + '-P99-MarkCompact: ' +
+        (markCompact / outliers).toFixed(3));
+  print(this.name + '-P99-Compiles: ' + (compiles / outliers).toFixed(2));
+}
@@ -0,0 +1,58 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// JSON round-trips of API-style payloads: an array of records with nested
+// objects, short and long strings, numbers and booleans. Each iteration
+// parses the serialized payload, touches every record and serializes it
+// again.
+
+function JSONRecord(i) {
+  return {
+    id: i,
+    uuid: 'a1b2c3d4-' + (i * 7919 % 100000) + '-' + (i % 997),
+    active: (i % 3) != 0,
+    score: Math.random() * 1000,
+    tags: ['alpha', 'beta', 'gamma'].slice(0, 1 + (i % 3)),
+    owner: { name: 'user' + (i % 1000), email: 'user' + i + '@example.com' },
+    description: 'Lorem ipsum dolor sit amet, consectetur adipiscing elit ' +
+                 i + ', sed do eiusmod tempor "incididunt" ut labore.',
+    history: [ { at: 1400000000 + i, op: 'create' },
+               { at: 1400000100 + i, op: 'update' } ]
+  };
+}
+
+
+function JSONRoundTripBenchmark(megabytes) {
+  var text;
+  function Setup() {
+    var records = [];
+    var size = 2;
+    for (var i = 0; size < megabytes * 1024 * 1024; i++) {
+      var record = JSONRecord(i);
+      size += JSON.stringify(record).length + 1;
+      records.push(record);
+    }
+    text = JSON.stringify(records);
+  }
+  function Run() {
+    var records = JSON.parse(text);
+    var sum = 0;
+    for (var i = 0; i < records.length; i++) {
+      sum += records[i].owner.name.length;
+    }
+    var result = JSON.stringify(records);
+    if (result.length != text.length || sum == 0) {
+      throw new Error('JSON round-trip mismatch');
+    }
+  }
+  function TearDown() {
+    text = null;
+  }
+  new ServerBenchmark('JSON' + megabytes + 'MB', Setup, Run, TearDown);
+}
+
+
+JSONRoundTripBenchmark(1);
+JSONRoundTripBenchmark(10);
+JSONRoundTripBenchmark(50);
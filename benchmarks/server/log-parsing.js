@@ -0,0 +1,73 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Parsing of web server access logs: lines in combined log format are split
+// with a regular expression, the request line and query string are taken
+// apart, and per-status and per-path statistics are aggregated.
+
+var LogText = null;
+
+var LogLineRegExp = new RegExp(
+    '^(\\S+) \\S+ (\\S+) \\[([^\\]]+)\\] "(\\w+) ([^ "]+) HTTP/([\\d.]+)" ' +
+    '(\\d{3}) (\\d+|-) "([^"]*)" "([^"]*)"$', 'gm');
+var LogQueryRegExp = /([^&=?]+)=([^&]*)/g;
+
+
+function LogSetup() {
+  var methods = ['GET', 'GET', 'GET', 'POST', 'PUT', 'DELETE'];
+  var paths = ['/', '/index.html', '/api/v1/users', '/api/v1/orders',
+               '/static/app.js', '/search'];
+  var agents = ['Mozilla/5.0 (X11; Linux x86_64)', 'curl/7.35.0',
+                'Mozilla/5.0 (Macintosh; Intel Mac OS X 10_9_5)'];
+  var statuses = [200, 200, 200, 200, 304, 404, 500];
+  var lines = [];
+  for (var i = 0; i < 20000; i++) {
+    var path = paths[i % paths.length];
+    if ((i % 3) == 0) path += '?q=term' + (i % 50) + '&page=' + (i % 7);
+    lines.push('10.0.' + (i % 256) + '.' + (i * 7 % 256) + ' - user' +
+               (i % 30) + ' [10/Oct/2014:13:55:' + (i % 60) + ' +0000] "' +
+               methods[i % methods.length] + ' ' + path + ' HTTP/1.1" ' +
+               statuses[i % statuses.length] + ' ' +
+               ((i % 11) ? Math.floor(Math.random() * 50000) : '-') +
+               ' "http://example.com/ref' + (i % 13) + '" "' +
+               agents[i % agents.length] + '"');
+  }
+  LogText = lines.join('\n');
+}
+
+
+function LogRun() {
+  var byStatus = {};
+  var byPath = {};
+  var bytes = 0;
+  var queries = 0;
+  var match;
+  LogLineRegExp.lastIndex = 0;
+  while ((match = LogLineRegExp.exec(LogText)) !== null) {
+    var status = match[7];
+    byStatus[status] = (byStatus[status] || 0) + 1;
+    var target = match[5];
+    var question = target.indexOf('?');
+    var path = question < 0 ? target : target.substring(0, question);
+    byPath[path] = (byPath[path] || 0) + 1;
+    if (match[8] != '-') bytes += parseInt(match[8], 10);
+    if (question >= 0) {
+      target.replace(LogQueryRegExp, function(all, key, value) {
+        queries++;
+        return all;
+      });
+    }
+  }
+  if (byStatus['200'] === undefined || queries == 0) {
+    throw new Error('Log parsing failed');
+  }
+}
+
+
+function LogTearDown() {
+  LogText = null;
+}
+
+
+new ServerBenchmark('LogParsing', LogSetup, LogRun, LogTearDown);
@@ -0,0 +1,92 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// An LRU cache in front of a slow backend, built on Map's insertion order,
+// with a Set tracking the keys of dirty entries. Keys follow a skewed
+// distribution so that hits, misses and evictions all happen.
+
+function LRUCache(capacity) {
+  this.capacity = capacity;
+  this.map = new Map();
+  this.dirty = new Set();
+}
+
+
+LRUCache.prototype.get = function(key) {
+  var value = this.map.get(key);
+  if (value === undefined) return undefined;
+  // Move the entry to the most recently used position.
+  this.map.delete(key);
+  this.map.set(key, value);
+  return value;
+}
+
+
+LRUCache.prototype.set = function(key, value) {
+  if (this.map.has(key)) {
+    this.map.delete(key);
+  } else if (this.map.size >= this.capacity) {
+    var oldest = this.map.keys().next().value;
+    this.map.delete(oldest);
+    this.dirty.delete(oldest);
+  }
+  this.map.set(key, value);
+}
+
+
+LRUCache.prototype.markDirty = function(key) {
+  if (this.map.has(key)) this.dirty.add(key);
+}
+
+
+LRUCache.prototype.flush = function() {
+  var count = 0;
+  this.dirty.forEach(function(key) { count++; });
+  this.dirty.clear();
+  return count;
+}
+
+
+var LRUCacheInstance = null;
+var LRUCacheKeys = [];
+
+
+function LRUCacheSetup() {
+  LRUCacheInstance = new LRUCache(10000);
+  for (var i = 0; i < 20000; i++) {
+    // Squaring a uniform sample skews the keys towards small numbers.
+    var r = Math.random();
+    LRUCacheKeys.push('session:' + Math.floor(r * r * 50000));
+  }
+}
+
+
+function LRUCacheRun() {
+  var cache = LRUCacheInstance;
+  var hits = 0;
+  for (var i = 0; i < LRUCacheKeys.length; i++) {
+    var key = LRUCacheKeys[i];
+    var value = cache.get(key);
+    if (value !== undefined) {
+      hits++;
+      if ((i & 15) == 0) {
+        value.count++;
+        cache.markDirty(key);
+      }
+    } else {
+      cache.set(key, { key: key, count: 1, payload: [i, i + 1, i + 2] });
+    }
+    if ((i & 1023) == 0) cache.flush();
+  }
+  if (hits == 0) throw new Error('No cache hits');
+}
+
+
+function LRUCacheTearDown() {
+  LRUCacheInstance = null;
+  LRUCacheKeys = [];
+}
+
+
+new ServerBenchmark('LRUCache', LRUCacheSetup, LRUCacheRun, LRUCacheTearDown);
@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Request handling as written with promises: every request runs through a
+// chain of asynchronous steps (authentication, lookup, transformation and
+// serialization), a fraction of them fail and are recovered by a catch
+// handler, and the requests of a batch are joined with Promise.all. Each
+// iteration drains the microtask queue, which needs --allow-natives-syntax.
+
+var PromiseStore = null;
+
+
+function PromiseLookup(id) {
+  return new Promise(function(resolve, reject) {
+    var entry = PromiseStore[id % PromiseStore.length];
+    if (entry.missing) {
+      reject(new Error('not found: ' + id));
+    } else {
+      resolve(entry);
+    }
+  });
+}
+
+
+function PromiseHandle(id) {
+  return Promise.resolve({ id: id, user: 'user' + (id % 100) })
+      .then(function(request) {
+        if (request.user.length == 0) throw new Error('unauthenticated');
+        return PromiseLookup(request.id);
+      })
+      .then(function(entry) {
+        return { id: entry.id, total: entry.values.reduce(
+            function(a, b) { return a + b; }, 0) };
+      })
+      .catch(function(error) {
+        return { id: id, error: error.message };
+      })
+      .then(function(response) {
+        return JSON.stringify(response);
+      });
+}
+
+
+function PromiseSetup() {
+  PromiseStore = [];
+  for (var i = 0; i < 1000; i++) {
+    PromiseStore.push({ id: i, missing: (i % 10) == 0,
+                        values: [i, i * 2, i * 3, i * 4] });
+  }
+}
+
+
+function PromiseRun() {
+  var responses = null;
+  var batch = [];
+  for (var i = 0; i < 2000; i++) batch.push(PromiseHandle(i));
+  Promise.all(batch).then(function(results) { responses = results; });
+  %RunMicrotasks();
+  if (responses === null || responses.length != batch.length) {
+    throw new Error('Promise chains did not complete');
+  }
+}
+
+
+function PromiseTearDown() {
+  PromiseStore = null;
+}
+
+
+new ServerBenchmark('PromiseChains', PromiseSetup, PromiseRun,
+                    PromiseTearDown);
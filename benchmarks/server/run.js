@@ -0,0 +1,18 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Runs the server workloads with d8, e.g. from this directory:
+//   d8 --allow-natives-syntax run.js
+// Names of benchmarks given after -- restrict the run to those benchmarks:
+//   d8 --allow-natives-syntax run.js -- LRUCache JSON1MB
+
+load('../workload-base.js');
+load('base.js');
+load('json.js');
+load('templates.js');
+load('lru-cache.js');
+load('promises.js');
+load('log-parsing.js');
+
+WorkloadBenchmark.RunAll(typeof arguments != 'undefined' ? arguments : []);
@@ -0,0 +1,78 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Page rendering as done by server-side template engines: templates are
+// compiled once into lists of literal chunks and placeholders, and each
+// iteration renders a page of rows by string concatenation, HTML escaping
+// every interpolated value.
+
+var TemplateRows = [];
+var TemplateCompiled = null;
+
+
+function TemplateCompile(source) {
+  var parts = source.split(/\{\{(\w+)\}\}/);
+  var chunks = [];
+  for (var i = 0; i < parts.length; i++) {
+    chunks.push({ literal: (i % 2) == 0, text: parts[i] });
+  }
+  return chunks;
+}
+
+
+function TemplateEscape(value) {
+  var s = String(value);
+  if (!/[&<>"']/.test(s)) return s;
+  return s.replace(/&/g, '&amp;').replace(/</g, '&lt;')
+          .replace(/>/g, '&gt;').replace(/"/g, '&quot;')
+          .replace(/'/g, '&#39;');
+}
+
+
+function TemplateRender(chunks, data) {
+  var out = '';
+  for (var i = 0; i < chunks.length; i++) {
+    var chunk = chunks[i];
+    out += chunk.literal ? chunk.text : TemplateEscape(data[chunk.text]);
+  }
+  return out;
+}
+
+
+function TemplateSetup() {
+  TemplateCompiled = TemplateCompile(
+      '<tr class="{{kind}}"><td>{{id}}</td><td><a href="/u/{{user}}">' +
+      '{{name}}</a></td><td>{{amount}}</td><td>{{note}}</td></tr>\n');
+  for (var i = 0; i < 2000; i++) {
+    TemplateRows.push({
+      kind: (i % 2) ? 'odd' : 'even',
+      id: i,
+      user: 'u' + (i * 31 % 5000),
+      name: 'Customer <' + i + '>',
+      amount: (Math.random() * 10000).toFixed(2),
+      note: (i % 5) ? 'ok' : 'needs "review" & follow-up'
+    });
+  }
+}
+
+
+function TemplateRun() {
+  var page = '<html><body><table>\n';
+  for (var i = 0; i < TemplateRows.length; i++) {
+    page += TemplateRender(TemplateCompiled, TemplateRows[i]);
+  }
+  page += '</table></body></html>\n';
+  // Flatten the result like a server writing it to a socket would.
+  if (page.charCodeAt(page.length - 1) != 10) throw new Error('Bad page');
+}
+
+
+function TemplateTearDown() {
+  TemplateRows = [];
+  TemplateCompiled = null;
+}
+
+
+new ServerBenchmark('TemplateRender', TemplateSetup, TemplateRun,
+                    TemplateTearDown);
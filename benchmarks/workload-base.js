@@ -0,0 +1,129 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A small harness for long-running, allocation-heavy workloads, shared by
+// the suites in server/ and gc/. Unlike the score-based harness in base.js,
+// a benchmark is run for a fixed time and every iteration is timed. A suite
+// derives its benchmark type from WorkloadBenchmark and decides what to
+// record around every iteration and what to report at the end:
+//
+//   CreateRecorder(): returns an object whose Before() and After(end) are
+//     called around every measured iteration, or null.
+//   Report(samples, recorder): prints the results, given the iteration
+//     times in ms and the recorder.
+//
+// When run with d8, performance.pauses() provides the collections,
+// compilations and heap sizes to record.
+
+
+function WorkloadBenchmark(name, setup, run, tearDown) {
+  this.name = name;
+  this.setup = setup;
+  this.run = run;
+  this.tearDown = tearDown || function() { };
+  WorkloadBenchmark.benchmarks.push(this);
+}
+
+
+WorkloadBenchmark.benchmarks = [];
+
+
+// Options given as --<option> arguments to RunAll, set to true.
+WorkloadBenchmark.options = {};
+
+
+// Minimum time spent warming up and measuring each benchmark, in ms. Suites
+// may override them on their prototype.
+WorkloadBenchmark.prototype.kWarmupTime = 250;
+WorkloadBenchmark.prototype.kMeasureTime = 2000;
+WorkloadBenchmark.prototype.kMinIterations = 5;
+
+
+// Deterministic replacement for Math.random, see base.js.
+Math.random = (function() {
+  var seed = 49734321;
+  return function() {
+    // Robert Jenkins' 32 bit integer hash function.
+    seed = ((seed + 0x7ed55d16) + (seed << 12))  & 0xffffffff;
+    seed = ((seed ^ 0xc761c23c) ^ (seed >>> 19)) & 0xffffffff;
+    seed = ((seed + 0x165667b1) + (seed << 5))   & 0xffffffff;
+    seed = ((seed + 0xd3a2646c) ^ (seed << 9))   & 0xffffffff;
+    seed = ((seed + 0xfd7046c5) + (seed << 3))   & 0xffffffff;
+    seed = ((seed ^ 0xb55a4f09) ^ (seed >>> 16)) & 0xffffffff;
+    return (seed & 0xfffffff) / 0x10000000;
+  };
+})();
+
+
+WorkloadBenchmark.Now = (typeof performance != 'undefined' && performance.now)
+    ? function() { return performance.now(); }
+    : function() { return Date.now(); };
+
+
+WorkloadBenchmark.Pauses =
+    (typeof performance != 'undefined' && performance.pauses)
+    ? function(drain) { return performance.pauses(drain); }
+    : null;
+
+
+WorkloadBenchmark.Percentile = function(sorted, percentile) {
+  var index = Math.ceil(sorted.length * percentile / 100) - 1;
+  return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+}
+
+
+WorkloadBenchmark.prototype.CreateRecorder = function() {
+  return null;
+}
+
+
+// Runs the benchmark until {time} ms have passed and at least
+// kMinIterations iterations were done, and returns the iteration times.
+WorkloadBenchmark.prototype.Measure = function(time, recorder) {
+  var samples = [];
+  var elapsed = 0;
+  while (elapsed < time || samples.length < this.kMinIterations) {
+    if (recorder) recorder.Before();
+    var start = WorkloadBenchmark.Now();
+    this.run();
+    var end = WorkloadBenchmark.Now();
+    if (recorder) recorder.After(end);
+    samples.push(end - start);
+    elapsed += end - start;
+  }
+  return samples;
+}
+
+
+WorkloadBenchmark.prototype.Execute = function() {
+  this.setup();
+  this.Measure(this.kWarmupTime, null);
+  var recorder = this.CreateRecorder();
+  var samples = this.Measure(this.kMeasureTime, recorder);
+  this.tearDown();
+  this.Report(samples, recorder);
+}
+
+
+// Runs all registered benchmarks, or only those whose names are given.
+WorkloadBenchmark.RunAll = function(args) {
+  var names = [];
+  for (var i = 0; i < args.length; i++) {
+    if (args[i].indexOf('--') == 0) {
+      WorkloadBenchmark.options[args[i].substring(2)] = true;
+    } else {
+      names.push(args[i]);
+    }
+  }
+  var benchmarks = WorkloadBenchmark.benchmarks;
+  for (var i = 0; i < benchmarks.length; i++) {
+    var benchmark = benchmarks[i];
+    if (names.length > 0 && names.indexOf(benchmark.name) < 0) continue;
+    try {
+      benchmark.Execute();
+    } catch (e) {
+      print(benchmark.name + ': ' + e);
+    }
+  }
+}
@@ -17,8 +17,11 @@ namespace platform {
  * is the number of worker threads to allocate for background jobs. If a value
  * of zero is passed, a suitable default based on the current number of
  * processors online will be chosen.
+ * If |idle_task_support| is true then idle tasks are enabled, and the embedder
+ * has to call |RunIdleTasks| to run them.
  */
-v8::Platform* CreateDefaultPlatform(int thread_pool_size = 0);
+v8::Platform* CreateDefaultPlatform(int thread_pool_size = 0,
+                                    bool idle_task_support = false);
 
 
 /**
@@ -32,6 +35,18 @@ v8::Platform* CreateDefaultPlatform(int thread_pool_size = 0);
 bool PumpMessageLoop(v8::Platform* platform, v8::Isolate* isolate);
 
 
+/**
+ * Runs pending idle tasks for the given isolate for at most
+ * |idle_time_in_seconds| seconds.
+ *
+ * The caller has to make sure that this is called from the right thread.
+ * This call does not block if no task is pending. The |platform| has to be
+ * created using |CreateDefaultPlatform| with idle task support enabled.
+ */
+void RunIdleTasks(v8::Platform* platform, v8::Isolate* isolate,
+                  double idle_time_in_seconds);
+
+
 }  // namespace platform
 }  // namespace v8
 
@@ -19,6 +19,20 @@ class Task {
   virtual void Run() = 0;
 };
 
+
+/**
+ * An IdleTask represents a unit of work to be performed in idle time.
+ * The Run method is invoked with an argument that specifies the deadline in
+ * seconds returned by MonotonicallyIncreasingTime().
+ * The idle task is expected to complete by this deadline.
+ */
+class IdleTask {
+ public:
+  virtual ~IdleTask() {}
+
+  virtual void Run(double deadline_in_seconds) = 0;
+};
+
 /**
  * V8 Platform abstraction layer.
  *
@@ -37,6 +51,21 @@ class Platform {
     kLongRunningTask
   };
 
+  /**
+   * This enum is used to indicate how urgent a background task is. Tasks
+   * that block the main thread of an isolate, e.g. parallel garbage
+   * collection work, should not have to wait for tasks that merely produce
+   * results eventually, e.g. concurrent compilation.
+   */
+  enum TaskPriority {
+    // The main thread is or will soon be waiting for the task.
+    kUserBlockingPriority,
+    // The result of the task is needed, but nobody waits for it.
+    kUserVisiblePriority,
+    // The task can be deferred until there is nothing else to do.
+    kBestEffortPriority
+  };
+
   virtual ~Platform() {}
 
   /**
@@ -49,6 +78,18 @@ class Platform {
   virtual void CallOnBackgroundThread(Task* task,
                                       ExpectedRuntime expected_runtime) = 0;
 
+  /**
+   * Same as CallOnBackgroundThread, but tells the platform which |isolate|
+   * the task belongs to and how urgent it is. Platforms may use this to run
+   * more urgent tasks first and to share the worker threads fairly between
+   * isolates. The default implementation ignores the extra information.
+   */
+  virtual void CallOnBackgroundThreadWithPriority(
+      Isolate* isolate, Task* task, ExpectedRuntime expected_runtime,
+      TaskPriority priority) {
+    CallOnBackgroundThread(task, expected_runtime);
+  }
+
   /**
    * Schedules a task to be invoked on a foreground thread wrt a specific
    * |isolate|. Tasks posted for the same isolate should be execute in order of
@@ -56,6 +97,32 @@ class Platform {
    */
   virtual void CallOnForegroundThread(Isolate* isolate, Task* task) = 0;
 
+  /**
+   * Schedules a task to be invoked on a foreground thread wrt a specific
+   * |isolate| after the given number of seconds |delay_in_seconds|.
+   * Tasks posted for the same isolate should be execute in order of
+   * scheduling. The definition of "foreground" is opaque to V8.
+   */
+  virtual void CallDelayedOnForegroundThread(Isolate* isolate, Task* task,
+                                             double delay_in_seconds) = 0;
+
+  /**
+   * Schedules a task to be invoked on a foreground thread wrt a specific
+   * |isolate| when the embedder is idle.
+   * Requires that IdleTasksEnabled(isolate) is true.
+   * Idle tasks may be reordered relative to other task types and may be
+   * starved for an arbitrarily long time if no idle time is available.
+   * The definition of "foreground" is opaque to V8.
+   */
+  virtual void CallIdleOnForegroundThread(Isolate* isolate, IdleTask* task) {
+    // Platforms without idle time support never run idle tasks.
+    delete task;
+  }
+
+  /**
+   * Returns true if idle tasks are enabled for the given |isolate|.
+   */
+  virtual bool IdleTasksEnabled(Isolate* isolate) { return false; }
 
   /**
    * Monotonically increasing time in seconds from an arbitrary fixed point in
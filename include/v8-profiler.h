@@ -126,6 +126,43 @@ class V8_EXPORT CpuProfile {
  * Interface for controlling CPU profiling. Instance of the
  * profiler can be retrieved using v8::Isolate::GetCpuProfiler.
  */
+/**
+ * A frame of a stack sampled in the continuous profiling mode. The strings
+ * are owned by the profiler and stay valid until all profiles are deleted.
+ */
+struct CpuProfileFrame {
+  const char* function_name;
+  const char* resource_name;
+  int script_id;
+  int line_number;
+  int column_number;
+};
+
+
+/**
+ * Receives the samples aggregated in the continuous profiling mode, see
+ * CpuProfiler::DrainContinuousProfile.
+ */
+class V8_EXPORT ContinuousProfileVisitor {
+ public:
+  virtual ~ContinuousProfileVisitor() {}
+
+  /**
+   * Called for every stack that was sampled since the previous drain.
+   * The id identifies the stack for as long as continuous profiling is
+   * running. The frames are ordered from the top of the stack.
+   */
+  virtual void VisitStack(unsigned stack_id, unsigned sample_count,
+                          const CpuProfileFrame* frames, int frame_count) = 0;
+
+  /**
+   * Called with the number of samples since the previous drain that were
+   * dropped because the table of distinct stacks was full.
+   */
+  virtual void VisitDroppedSamples(unsigned sample_count) {}
+};
+
+
 class V8_EXPORT CpuProfiler {
  public:
   /**
@@ -135,6 +172,16 @@ class V8_EXPORT CpuProfiler {
    */
   void SetSamplingInterval(int us);
 
+  /**
+   * Makes the profiler take its samples when the profiled thread has used
+   * up a sampling interval of CPU time, instead of interrupting the thread
+   * with a signal at every interval of wall time. The thread is then not
+   * interrupted while it is blocked, and idle time is not sampled. Only
+   * supported on Linux, other platforms ignore it. This method must be
+   * called when there are no profiles being recorded.
+   */
+  void SetCpuTimeSampling(bool enable);
+
   /**
    * Starts collecting CPU profile. Title may be an empty string. It
    * is allowed to have several profiles being collected at
@@ -163,6 +210,28 @@ class V8_EXPORT CpuProfiler {
   V8_DEPRECATED("Use StopProfiling",
       const CpuProfile* StopCpuProfiling(Handle<String> title));
 
+  /**
+   * Starts the continuous profiling mode. Samples are not added to a
+   * profile tree but counted per distinct stack, in a table of at most
+   * |max_stacks| stacks, so the memory used does not grow with the time
+   * spent profiling. It can run alongside profiles started with
+   * StartProfiling.
+   */
+  void StartContinuousProfiling(int max_stacks);
+
+  /**
+   * Passes the stacks sampled since the previous call to the visitor and
+   * resets their counts, without stopping the profiler. The visitor must
+   * not call back into the profiler.
+   */
+  void DrainContinuousProfile(ContinuousProfileVisitor* visitor);
+
+  /**
+   * Stops the continuous profiling mode. Samples that were not drained
+   * are discarded.
+   */
+  void StopContinuousProfiling();
+
   /**
    * Tells the profiler whether the embedder is idle.
    */
@@ -383,6 +452,40 @@ class V8_EXPORT ActivityControl {  // NOLINT
 };
 
 
+/**
+ * A frame of an allocation stack captured by the sampling heap profiler.
+ * The strings are owned by the profiler and stay valid until sampling is
+ * stopped.
+ */
+struct SampledAllocationFrame {
+  static const int kNoLineNumberInfo = 0;
+
+  const char* function_name;
+  const char* resource_name;
+  int script_id;
+  int line_number;
+};
+
+
+/**
+ * Receives the live sampled allocations, see
+ * HeapProfiler::GetSampledAllocations.
+ */
+class V8_EXPORT SampledAllocationVisitor {
+ public:
+  virtual ~SampledAllocationVisitor() {}
+
+  /**
+   * Called for every stack that allocated sampled objects which are still
+   * alive. The frames are ordered from the top of the stack. |live_count|
+   * is the number of these objects and |live_size| their size in bytes.
+   */
+  virtual void VisitStack(const SampledAllocationFrame* frames,
+                          int frame_count, unsigned live_count,
+                          size_t live_size) = 0;
+};
+
+
 /**
  * Interface for controlling heap profiling. Instance of the
  * profiler can be retrieved using v8::Isolate::GetHeapProfiler.
@@ -452,6 +555,19 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot and writes it to the stream in the JSON format of
+   * HeapSnapshot::Serialize, without keeping the snapshot. Only the nodes
+   * are held in memory: the edges are extracted from the heap a second time
+   * while they are written, which takes longer but needs a fraction of the
+   * memory of TakeHeapSnapshot. Returns false if the control aborted it.
+   */
+  bool StreamHeapSnapshot(
+      OutputStream* stream,
+      Handle<String> title,
+      ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -484,6 +600,25 @@ class V8_EXPORT HeapProfiler {
    */
   void StopTrackingHeapObjects();
 
+  /**
+   * Starts sampling the allocations. Unlike allocation tracking, which
+   * records every allocation, this takes a stack trace on average once per
+   * |sample_interval| allocated bytes and is cheap enough to be left on in
+   * production. An object of size s is sampled with probability
+   * 1 - exp(-s / sample_interval). Does nothing if sampling has already
+   * been started.
+   */
+  void StartSamplingHeapProfiler(uint64_t sample_interval = 512 * 1024);
+
+  /**
+   * Reports the sampled objects that are still alive, aggregated per
+   * allocation stack.
+   */
+  void GetSampledAllocations(SampledAllocationVisitor* visitor);
+
+  /** Stops sampling the allocations and discards the samples. */
+  void StopSamplingHeapProfiler();
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
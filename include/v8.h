@@ -62,6 +62,7 @@ namespace v8 {
 
 class AccessorSignature;
 class Array;
+class ArrayBuffer;
 class Boolean;
 class BooleanObject;
 class Context;
@@ -83,6 +84,7 @@ class NumberObject;
 class Object;
 class ObjectOperationDescriptor;
 class ObjectTemplate;
+class OutputStream;
 class Platform;
 class Primitive;
 class Promise;
@@ -130,12 +132,17 @@ class Arguments;
 class Heap;
 class HeapObject;
 class Isolate;
+class IsolateTemplate;
 class Object;
 struct StreamedSource;
 template<typename T> class CustomArguments;
 class PropertyCallbackArguments;
 class FunctionCallbackArguments;
+class Deoptimizer;
+class GCTracer;
 class GlobalHandles;
+class ValueDeserializer;
+class ValueSerializer;
 }
 
 
@@ -433,6 +440,71 @@ class WeakCallbackData {
 };
 
 
+static const int kInternalFieldsInWeakCallback = 2;
+
+
+/**
+ * The data passed to the callbacks of phantom handles, see
+ * PersistentBase::SetWeak(P*, WeakCallbackInfo<P>::Callback,
+ * WeakCallbackType).
+ */
+template <typename T>
+class WeakCallbackInfo {
+ public:
+  typedef void (*Callback)(const WeakCallbackInfo<T>& data);
+
+  V8_INLINE Isolate* GetIsolate() const { return isolate_; }
+  V8_INLINE T* GetParameter() const { return parameter_; }
+
+  /**
+   * Returns an aligned pointer that was stored in the internal fields of the
+   * object, for handles made weak with kWeakCallbackInternalFields.
+   */
+  V8_INLINE void* GetInternalField(int index) const {
+    return internal_fields_[index];
+  }
+
+  /**
+   * The callback is first called while the garbage collector is finishing
+   * up, in a batch with the callbacks of all other phantom handles that died
+   * in the same collection.  This first pass must reset the handle and must
+   * not call into V8.  It can ask for a second pass, which runs later,
+   * usually from a foreground task, and may use the V8 API.
+   */
+  V8_INLINE void SetSecondPassCallback(Callback callback) const {
+    *callback_ = callback;
+  }
+
+ private:
+  friend class internal::GlobalHandles;
+  WeakCallbackInfo(Isolate* isolate, T* parameter,
+                   void* internal_fields[kInternalFieldsInWeakCallback],
+                   Callback* callback)
+      : isolate_(isolate), parameter_(parameter), callback_(callback) {
+    for (int i = 0; i < kInternalFieldsInWeakCallback; i++) {
+      internal_fields_[i] = internal_fields[i];
+    }
+  }
+
+  Isolate* isolate_;
+  T* parameter_;
+  Callback* callback_;
+  void* internal_fields_[kInternalFieldsInWeakCallback];
+};
+
+
+/**
+ * Selects what is passed to the callback of a phantom handle:
+ * kWeakCallbackParameter only passes the parameter, while
+ * kWeakCallbackInternalFields also passes the first two internal fields of
+ * the object, which are read before the object is collected.
+ */
+enum WeakCallbackType {
+  kWeakCallbackParameter,
+  kWeakCallbackInternalFields
+};
+
+
 /**
  * An object reference that is independent of any handle scope.  Where
  * a Local handle only lives as long as the HandleScope in which it was
@@ -512,6 +584,18 @@ template <class T> class PersistentBase {
       P* parameter,
       typename WeakCallbackData<S, P>::Callback callback);
 
+  /**
+   * Makes this a phantom handle.  Unlike the callbacks above, the callback
+   * does not get the object, so the object cannot be resurrected: the
+   * garbage collector clears the handle when the object dies and only calls
+   * the callback afterwards, see WeakCallbackInfo.  Phantom handles are
+   * much cheaper to process than regular weak handles.
+   */
+  template <typename P>
+  V8_INLINE void SetWeak(P* parameter,
+                         typename WeakCallbackInfo<P>::Callback callback,
+                         WeakCallbackType type);
+
   template<typename P>
   V8_INLINE P* ClearWeak();
 
@@ -820,10 +904,16 @@ class V8_EXPORT HandleScope {
 
   void Initialize(Isolate* isolate);
 
-  static internal::Object** CreateHandle(internal::Isolate* isolate,
-                                         internal::Object* value);
+  // Takes the next slot of the current handle block without calling into
+  // V8. Only when the block is used up or the scope is sealed, or if
+  // V8_ENABLE_CHECKS is defined, SlowCreateHandle does the work.
+  V8_INLINE static internal::Object** CreateHandle(internal::Isolate* isolate,
+                                                   internal::Object* value);
 
  private:
+  static internal::Object** SlowCreateHandle(internal::Isolate* isolate,
+                                             internal::Object* value);
+
   // Uses heap_object to obtain the current Isolate.
   static internal::Object** CreateHandle(internal::HeapObject* heap_object,
                                          internal::Object* value);
@@ -883,6 +973,31 @@ class V8_EXPORT EscapableHandleScope : public HandleScope {
 };
 
 
+/**
+ * A SealHandleScope forbids the creation of local handles in the current
+ * handle scope while it is alive. Handles can still be created in handle
+ * scopes that are opened inside it. This helps to find code that leaks
+ * handles into an outer scope, e.g. in a loop.
+ */
+class V8_EXPORT SealHandleScope {
+ public:
+  SealHandleScope(Isolate* isolate);
+  ~SealHandleScope();
+
+ private:
+  // Make it hard to create heap-allocated or illegal handle scopes by
+  // disallowing certain operations.
+  SealHandleScope(const SealHandleScope&);
+  void operator=(const SealHandleScope&);
+  void* operator new(size_t size);
+  void operator delete(void*, size_t);
+
+  internal::Isolate* isolate_;
+  int prev_sealed_level_;
+  internal::Object** prev_limit_;
+};
+
+
 /**
  * A simple Maybe type, representing an object which may or may not have a
  * value.
@@ -1225,6 +1340,53 @@ class V8_EXPORT ScriptCompiler {
   static Local<Script> Compile(Isolate* isolate, StreamedSource* source,
                                Handle<String> full_source_string,
                                const ScriptOrigin& origin);
+
+  /**
+   * Produces a code cache for the given script, like kProduceCodeCache, that
+   * additionally contains unoptimized code for every function of the script
+   * that has been compiled so far. Call it after the script ran through its
+   * typical startup, so that compiling from the cache with kConsumeCodeCache
+   * needs no lazy compilation on those paths. Requires an entered context.
+   * Returns NULL if no cache could be produced; otherwise the data is owned
+   * by the caller.
+   */
+  static CachedData* CreateCodeCache(Handle<UnboundScript> script);
+
+  /**
+   * Returns the pretenuring decisions V8 has learned so far for object and
+   * array literals of the given script. The returned data is owned by the
+   * caller and keyed by the V8 version and the script source. Pass it to
+   * ConsumePretenuringData right after compiling the same source in a fresh
+   * isolate, e.g. from the code cache, so that long-lived literals are
+   * allocated in old space from the start.
+   */
+  static CachedData* CreatePretenuringData(Handle<UnboundScript> script);
+
+  /**
+   * Preloads pretenuring decisions produced by CreatePretenuringData. Returns
+   * false if the data was rejected, e.g. because it was produced for a
+   * different source or V8 version.
+   */
+  static bool ConsumePretenuringData(Handle<UnboundScript> script,
+                                     const CachedData* data);
+
+  /**
+   * Returns which functions of the given script V8 has optimized so far. Like
+   * the pretenuring data, the returned data is owned by the caller and keyed
+   * by the V8 version and the script source. Pass it to ConsumeTieringData
+   * right after compiling the same source in a fresh isolate, so that these
+   * functions are optimized as soon as their type feedback is stable instead
+   * of after the usual warm-up.
+   */
+  static CachedData* CreateTieringData(Handle<UnboundScript> script);
+
+  /**
+   * Preloads tiering data produced by CreateTieringData. Returns false if the
+   * data was rejected, e.g. because it was produced for a different source
+   * or V8 version.
+   */
+  static bool ConsumeTieringData(Handle<UnboundScript> script,
+                                 const CachedData* data);
 };
 
 
@@ -1450,6 +1612,145 @@ class V8_EXPORT JSON {
    * \return The corresponding value if successfully parsed.
    */
   static Local<Value> Parse(Local<String> json_string);
+
+  /**
+   * Serializes |value| like JSON.stringify and writes the result to
+   * |stream| in UTF-8 encoded chunks of at most stream->GetChunkSize()
+   * bytes while the serialization proceeds, without creating the result
+   * string. Chunks are written with WriteAsciiChunk; the serialization
+   * waits for each write to return. EndOfStream is called once the whole
+   * result has been written.
+   *
+   * \param value The value to serialize.
+   * \param stream The stream receiving the chunks.
+   * \return false if an exception was thrown, if |value| has no JSON
+   *   representation (e.g. undefined), or if the stream aborted writing.
+   */
+  static bool Stringify(Local<Value> value, OutputStream* stream);
+};
+
+
+/**
+ * Writes values to a compact binary format, for example to post them to
+ * another isolate. Undefined, null, booleans, numbers, strings, plain
+ * objects, arrays, Dates, Maps, Sets, ArrayBuffers and their views are
+ * supported; other values throw a DataCloneError. Objects that are reached
+ * more than once, including cycles, keep their identity within one value.
+ *
+ * The data is read by ValueDeserializer, which has to be of the same V8
+ * version.
+ */
+class V8_EXPORT ValueSerializer {
+ public:
+  class V8_EXPORT Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    /**
+     * Called for objects with internal fields, which are created by the
+     * embedder. The delegate writes the object with WriteUint32 and
+     * WriteRawBytes and returns true, or returns false or throws to make
+     * serialization fail.
+     */
+    virtual bool WriteHostObject(Isolate* isolate, Local<Object> object) = 0;
+  };
+
+  explicit ValueSerializer(Isolate* isolate, Delegate* delegate = NULL);
+  ~ValueSerializer();
+
+  /**
+   * Writes the version of the format. Called once before the values.
+   */
+  void WriteHeader();
+
+  /**
+   * Writes |value| and returns true, or returns false if an exception was
+   * thrown.
+   */
+  bool WriteValue(Handle<Value> value);
+
+  /**
+   * Makes |array_buffer| be written as |transfer_id| instead of by copying
+   * its contents. The same id has to be passed to
+   * ValueDeserializer::TransferArrayBuffer with the buffer that replaces it.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<ArrayBuffer> array_buffer);
+
+  /**
+   * For use by the delegate.
+   */
+  void WriteUint32(uint32_t value);
+  void WriteRawBytes(const void* source, size_t length);
+
+  /**
+   * The data written so far. It is owned by the serializer.
+   */
+  const uint8_t* Data() const;
+  size_t Size() const;
+
+ private:
+  internal::ValueSerializer* serializer_;
+
+  ValueSerializer(const ValueSerializer&);
+  void operator=(const ValueSerializer&);
+};
+
+
+/**
+ * Reads values written by ValueSerializer. Malformed data throws an Error.
+ */
+class V8_EXPORT ValueDeserializer {
+ public:
+  class V8_EXPORT Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    /**
+     * Reads an object written by ValueSerializer::Delegate::WriteHostObject
+     * with ReadUint32 and ReadRawBytes. Returns an empty handle, possibly
+     * after throwing, if the object cannot be read.
+     */
+    virtual Local<Object> ReadHostObject(Isolate* isolate) = 0;
+  };
+
+  /**
+   * |data| has to stay alive while the deserializer reads from it.
+   */
+  ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size,
+                    Delegate* delegate = NULL);
+  ~ValueDeserializer();
+
+  /**
+   * Reads and checks the version of the format. Returns false if an
+   * exception was thrown.
+   */
+  bool ReadHeader();
+
+  /**
+   * Reads the next value. Returns an empty handle if an exception was
+   * thrown.
+   */
+  Local<Value> ReadValue();
+
+  /**
+   * Makes the buffer written as |transfer_id| be read as |array_buffer|.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<ArrayBuffer> array_buffer);
+
+  /**
+   * For use by the delegate. Return false if the data ends early.
+   * ReadRawBytes points |data| into the data passed to the constructor.
+   */
+  bool ReadUint32(uint32_t* value);
+  bool ReadRawBytes(size_t length, const void** data);
+
+ private:
+  internal::ValueDeserializer* deserializer_;
+
+  ValueDeserializer(const ValueDeserializer&);
+  void operator=(const ValueDeserializer&);
 };
 
 
@@ -2055,6 +2356,36 @@ class V8_EXPORT String : public Name {
    */
   bool MakeExternal(ExternalOneByteStringResource* resource);
 
+  /**
+   * Creates a new external string that refers to length bytes of the backing
+   * store of the given ArrayBuffer, starting at byte_offset, without copying
+   * them. The bytes are interpreted as Latin-1. The ArrayBuffer is kept alive
+   * for as long as the string is. It must not be neutered and the referenced
+   * bytes must not be modified in that time.
+   */
+  static Local<String> NewExternal(Isolate* isolate,
+                                   Handle<ArrayBuffer> buffer,
+                                   size_t byte_offset,
+                                   size_t length);
+
+  typedef void (*ExternalReleaseCallback)(const char* data, size_t length,
+                                          void* parameter);
+
+  /**
+   * Creates a new external string that refers to the given Latin-1 data
+   * without copying it and without an ExternalOneByteStringResource of the
+   * embedder's own. The data may be a slice of a larger buffer, e.g. a
+   * reference counted network buffer. When the string is no longer live on
+   * V8's heap, or if it cannot be created, the callback is called with the
+   * data, the length and the parameter, after which V8 does not access the
+   * data anymore. The data must not be modified before that.
+   */
+  static Local<String> NewExternal(Isolate* isolate,
+                                   const char* data,
+                                   size_t length,
+                                   ExternalReleaseCallback callback,
+                                   void* parameter);
+
   /**
    * Returns true if this string can be made external.
    */
@@ -2593,6 +2924,16 @@ class V8_EXPORT Object : public Value {
 
   static Local<Object> New(Isolate* isolate);
 
+  /**
+   * Creates an object with the own data properties |names| set to |values|.
+   * Same as calling ForceSet() for every property on a new object, but when
+   * the names are distinct and none of them is an array index, the object is
+   * allocated with its final map and the values go directly into in-object
+   * fields.
+   */
+  static Local<Object> New(Isolate* isolate, Handle<Name> names[],
+                           Handle<Value> values[], int length);
+
   V8_INLINE static Object* Cast(Value* obj);
 
  private:
@@ -2622,6 +2963,18 @@ class V8_EXPORT Array : public Object {
    */
   static Local<Array> New(Isolate* isolate, int length = 0);
 
+  /**
+   * Creates an array of |object_count| objects that all have the own data
+   * properties |names|, as if created by Object::New(isolate, names, ...).
+   * The values are given row by row: the value of property j of object i is
+   * |values[i * property_count + j]|. The shape of the objects is only
+   * computed once, which makes this the cheapest way to turn many records
+   * into JavaScript objects.
+   */
+  static Local<Array> NewObjects(Isolate* isolate, Handle<Name> names[],
+                                 int property_count, Handle<Value> values[],
+                                 int object_count);
+
   V8_INLINE static Array* Cast(Value* obj);
  private:
   Array();
@@ -2744,6 +3097,26 @@ class PropertyCallbackInfo {
 typedef void (*FunctionCallback)(const FunctionCallbackInfo<Value>& info);
 
 
+/**
+ * The C types that a fast call handler can take and return, see
+ * FunctionTemplate::SetFastCallHandler().
+ */
+enum FastCallType {
+  kFastCallVoid,    // void, only as the return type.
+  kFastCallInt32,   // int32_t
+  kFastCallDouble,  // double
+  kFastCallBool,    // bool
+  kFastCallHolder   // void*, only as the first parameter.
+};
+
+
+/**
+ * A plain C function, cast to the right type by the caller according to the
+ * FastCallTypes it was registered with.
+ */
+typedef void (*FastCallHandler)();
+
+
 /**
  * A JavaScript function object (ECMA-262, 15.3).
  */
@@ -2909,6 +3282,16 @@ class V8_EXPORT ArrayBuffer : public Object {
      * That memory is guaranteed to be previously allocated by |Allocate|.
      */
     virtual void Free(void* data, size_t length) = 0;
+
+    /**
+     * Returns a new allocator for embedders that create many short-lived
+     * ArrayBuffers. It keeps freed backing stores of up to 1 MB in size
+     * classes for reuse, maps larger ones lazily zeroed from the OS and
+     * returns memory to the OS in batches on a background thread. The
+     * caller takes ownership, and the platform must be initialized before
+     * the allocator is used.
+     */
+    static Allocator* NewPooledAllocator();
   };
 
   /**
@@ -2935,6 +3318,14 @@ class V8_EXPORT ArrayBuffer : public Object {
     friend class ArrayBuffer;
   };
 
+  /**
+   * Whether an |ArrayBuffer| created over an existing memory block owns it.
+   * With |kInternalized| the block is freed with |Allocator::Free| when the
+   * |ArrayBuffer| is garbage-collected, so it has to have been allocated
+   * with the allocator set with V8::SetArrayBufferAllocator.
+   */
+  enum CreationMode { kInternalized, kExternalized };
+
 
   /**
    * Data length in bytes.
@@ -2951,12 +3342,25 @@ class V8_EXPORT ArrayBuffer : public Object {
 
   /**
    * Create a new ArrayBuffer over an existing memory block.
-   * The created array buffer is immediately in externalized state.
-   * The memory block will not be reclaimed when a created ArrayBuffer
-   * is garbage-collected.
+   * In |kExternalized| mode the created array buffer is immediately in
+   * externalized state, and the memory block will not be reclaimed when
+   * the ArrayBuffer is garbage-collected. In |kInternalized| mode the
+   * ArrayBuffer takes ownership of the memory block.
    */
   static Local<ArrayBuffer> New(Isolate* isolate, void* data,
-                                size_t byte_length);
+                                size_t byte_length,
+                                CreationMode mode = kExternalized);
+
+  /**
+   * Create a new SharedArrayBuffer over an existing memory block, which may
+   * be in use by SharedArrayBuffers of other isolates at the same time; the
+   * Atomics operations of all of them synchronize with each other. The
+   * buffer is in externalized state, so the embedder has to keep the memory
+   * block alive as long as any of the buffers is alive. Requires
+   * --harmony-atomics.
+   */
+  static Local<ArrayBuffer> NewShared(Isolate* isolate, void* data,
+                                      size_t byte_length);
 
   /**
    * Returns true if ArrayBuffer is extrenalized, that is, does not
@@ -2964,11 +3368,17 @@ class V8_EXPORT ArrayBuffer : public Object {
    */
   bool IsExternal() const;
 
+  /**
+   * Returns true if this is a SharedArrayBuffer. Shared buffers cannot be
+   * neutered.
+   */
+  bool IsShared() const;
+
   /**
    * Neuters this ArrayBuffer and all its views (typed arrays).
    * Neutering sets the byte length of the buffer and all typed arrays to zero,
    * preventing JavaScript from ever accessing underlying backing store.
-   * ArrayBuffer should have been externalized.
+   * ArrayBuffer should have been externalized and must not be shared.
    */
   void Neuter();
 
@@ -2983,6 +3393,14 @@ class V8_EXPORT ArrayBuffer : public Object {
    */
   Contents Externalize();
 
+  /**
+   * Returns the pointer to the underlying memory block and the byte length
+   * without externalizing the ArrayBuffer. The ArrayBuffer keeps owning the
+   * memory block, so the pointer is only valid as long as the ArrayBuffer
+   * is alive and not neutered.
+   */
+  Contents GetContents();
+
   V8_INLINE static ArrayBuffer* Cast(Value* obj);
 
   static const int kInternalFieldCount = V8_ARRAY_BUFFER_INTERNAL_FIELD_COUNT;
@@ -3500,6 +3918,21 @@ typedef void (*NamedPropertyEnumeratorCallback)(
     const PropertyCallbackInfo<Array>& info);
 
 
+/**
+ * Configuration flags for named property handlers, see
+ * ObjectTemplate::SetNamedPropertyHandler.
+ *
+ * A non-masking handler promises that it never intercepts names that are
+ * properties of the object itself, e.g. the fields and accessors set up by
+ * the object template. Accesses to those properties then skip the handler,
+ * so that inline caches can handle them like on any other object.
+ */
+enum NamedPropertyHandlerFlags {
+  kDefaultNamedPropertyHandler = 0,
+  kNonMaskingNamedPropertyHandler = 1
+};
+
+
 /**
  * Returns the value of the property if the getter intercepts the
  * request.  Otherwise, returns an empty handle.
@@ -3691,6 +4124,27 @@ class V8_EXPORT FunctionTemplate : public Template {
   void SetCallHandler(FunctionCallback callback,
                       Handle<Value> data = Handle<Value>());
 
+  static const int kMaxFastCallParameters = 4;
+
+  /**
+   * Set a plain C function that optimized code may call directly instead
+   * of the call-handler callback, without creating a FunctionCallbackInfo
+   * and without leaving the VM state.  |parameter_types| lists the
+   * parameters of |handler|: every kFastCallInt32, kFastCallDouble and
+   * kFastCallBool parameter receives the next JavaScript argument, unboxed,
+   * and a leading kFastCallHolder parameter receives the aligned pointer in
+   * internal field 0 of the holder, see
+   * Object::GetAlignedPointerFromInternalField.
+   *
+   * The handler is only used for call sites that pass exactly the declared
+   * number of arguments.  Calls where an argument does not have the
+   * declared type go to the call-handler callback, which must therefore be
+   * set and behave the same.  The handler must not call into V8.
+   */
+  void SetFastCallHandler(FastCallHandler handler, FastCallType return_type,
+                          int parameter_count,
+                          const FastCallType* parameter_types);
+
   /** Set the predefined length property for the FunctionTemplate. */
   void SetLength(int length);
 
@@ -3830,6 +4284,7 @@ class V8_EXPORT ObjectTemplate : public Template {
    *   properties of an object.
    * \param data A piece of data that will be passed to the callbacks
    *   whenever they are invoked.
+   * \param flags See NamedPropertyHandlerFlags.
    */
   void SetNamedPropertyHandler(
       NamedPropertyGetterCallback getter,
@@ -3837,7 +4292,8 @@ class V8_EXPORT ObjectTemplate : public Template {
       NamedPropertyQueryCallback query = 0,
       NamedPropertyDeleterCallback deleter = 0,
       NamedPropertyEnumeratorCallback enumerator = 0,
-      Handle<Value> data = Handle<Value>());
+      Handle<Value> data = Handle<Value>(),
+      NamedPropertyHandlerFlags flags = kDefaultNamedPropertyHandler);
 
   /**
    * Sets an indexed property handler on the object template.
@@ -4133,6 +4589,12 @@ class V8_EXPORT ResourceConstraints {
   void set_code_range_size(size_t value) {
     code_range_size_ = value;
   }
+  size_t zone_segment_pool_size() const { return zone_segment_pool_size_; }
+  // Sets how many bytes of compiler scratch memory the isolate may keep
+  // around for reuse by later compilations. Zero keeps the default.
+  void set_zone_segment_pool_size(size_t value) {
+    zone_segment_pool_size_ = value;
+  }
 
  private:
   int max_semi_space_size_;
@@ -4141,6 +4603,7 @@ class V8_EXPORT ResourceConstraints {
   uint32_t* stack_limit_;
   int max_available_threads_;
   size_t code_range_size_;
+  size_t zone_segment_pool_size_;
 };
 
 
@@ -4218,6 +4681,64 @@ typedef void (*PromiseRejectCallback)(Handle<Promise> promise,
                                       Handle<Value> value,
                                       PromiseRejectEvent event);
 
+// --- Deoptimization Callback ---
+
+/**
+ * Describes the deoptimization of an optimized function, see
+ * Isolate::SetDeoptimizationCallback.
+ */
+class V8_EXPORT DeoptimizationEvent {
+ public:
+  enum Type { kEager, kLazy, kSoft, kDebugger };
+
+  static const int kNoLineNumberInfo = 0;
+
+  /** The function whose optimized code was deoptimized. */
+  Local<Function> function() const { return function_; }
+  Type type() const { return type_; }
+  /** Index of the deoptimization point in the optimized code. */
+  int bailout_id() const { return bailout_id_; }
+  /**
+   * Script id, source position and 1-based line number at which execution
+   * continues in unoptimized code.
+   */
+  int script_id() const { return script_id_; }
+  int position() const { return position_; }
+  int line_number() const { return line_number_; }
+  /**
+   * Description of the check that failed, or NULL if the optimized code was
+   * not compiled with --code-comments.
+   */
+  const char* reason() const { return reason_; }
+  /** Number of times the function has been optimized and deoptimized. */
+  int opt_count() const { return opt_count_; }
+  int deopt_count() const { return deopt_count_; }
+  /**
+   * The reason why optimization was disabled for the function, or NULL if
+   * it can still be optimized.
+   */
+  const char* optimization_disabled_reason() const {
+    return optimization_disabled_reason_;
+  }
+
+ private:
+  Local<Function> function_;
+  Type type_;
+  int bailout_id_;
+  int script_id_;
+  int position_;
+  int line_number_;
+  const char* reason_;
+  int opt_count_;
+  int deopt_count_;
+  const char* optimization_disabled_reason_;
+
+  friend class internal::Deoptimizer;
+};
+
+typedef void (*DeoptimizationCallback)(Isolate* isolate,
+                                       const DeoptimizationEvent& event);
+
 // --- Microtask Callback ---
 typedef void (*MicrotaskCallback)(void* data);
 
@@ -4253,7 +4774,8 @@ enum GCCallbackFlags {
   kNoGCCallbackFlags = 0,
   kGCCallbackFlagCompacted = 1 << 0,
   kGCCallbackFlagConstructRetainedObjectInfos = 1 << 1,
-  kGCCallbackFlagForced = 1 << 2
+  kGCCallbackFlagForced = 1 << 2,
+  kGCCallbackFlagSynchronousPhantomCallbackProcessing = 1 << 3
 };
 
 typedef void (*GCPrologueCallback)(GCType type, GCCallbackFlags flags);
@@ -4289,6 +4811,177 @@ class V8_EXPORT HeapStatistics {
 };
 
 
+/**
+ * Timing and memory statistics of a single garbage collection, see
+ * Isolate::GetGCStatistics. All durations are in milliseconds.
+ */
+class V8_EXPORT GCStatistics {
+ public:
+  enum Phase {
+    kExternal,  // Time spent in the embedder's GC callbacks.
+    kMark,
+    kSweep,
+    kEvacuate,
+    kUpdatePointers,
+    kWeakCollections,
+    kFlushCode,
+    kScavengeRoots,
+    kScavengeOldToNew,
+    kScavengeSemiSpace,
+    kNumberOfPhases
+  };
+
+  GCStatistics();
+  GCType type() const { return type_; }
+  double start_time() const { return start_time_; }
+  double duration() const { return end_time_ - start_time_; }
+  double phase_duration(Phase phase) const { return phases_[phase]; }
+  // Time spent in incremental marking steps that led up to this collection.
+  double incremental_marking_duration() const {
+    return incremental_marking_duration_;
+  }
+  // Time the mutator ran between the end of the previous collection and the
+  // start of this one.
+  double mutator_duration() const { return mutator_duration_; }
+  // Fraction of the time since the end of the previous collection that was
+  // spent outside of the garbage collector, in the range [0, 1].
+  double mutator_utilization() const;
+  size_t size_before() const { return size_before_; }
+  size_t size_after() const { return size_after_; }
+  size_t freed_bytes() const {
+    return size_before_ > size_after_ ? size_before_ - size_after_ : 0;
+  }
+  size_t promoted_bytes() const { return promoted_bytes_; }
+  size_t semi_space_copied_bytes() const { return semi_space_copied_bytes_; }
+  // Percentage of the new space objects that survived this collection.
+  double survival_rate() const { return survival_rate_; }
+
+ private:
+  GCType type_;
+  double start_time_;
+  double end_time_;
+  double phases_[kNumberOfPhases];
+  double incremental_marking_duration_;
+  double mutator_duration_;
+  size_t size_before_;
+  size_t size_after_;
+  size_t promoted_bytes_;
+  size_t semi_space_copied_bytes_;
+  double survival_rate_;
+
+  friend class internal::GCTracer;
+};
+
+
+/**
+ * Distribution of the durations recorded by one of the built-in histogram
+ * timers, see Isolate::GetHistogramTimerStatistics. The timers only record
+ * with --native-histograms. All durations are in microseconds and accurate
+ * to within 1/16th of their value.
+ */
+class V8_EXPORT HistogramTimerStatistics {
+ public:
+  HistogramTimerStatistics();
+  const char* name() { return name_; }
+  size_t count() { return count_; }
+  int64_t p50() { return p50_; }
+  int64_t p99() { return p99_; }
+  int64_t p999() { return p999_; }
+  int64_t max() { return max_; }
+
+ private:
+  const char* name_;
+  size_t count_;
+  int64_t p50_;
+  int64_t p99_;
+  int64_t p999_;
+  int64_t max_;
+
+  friend class Isolate;
+};
+
+
+/**
+ * Interface for iterating through the inline cache sites of the unoptimized
+ * code in an isolate, see Isolate::VisitInlineCacheSites.
+ */
+class V8_EXPORT InlineCacheSiteVisitor {  // NOLINT
+ public:
+  enum Kind {
+    kLoad,
+    kKeyedLoad,
+    kStore,
+    kKeyedStore,
+    kCompare,
+    kBinaryOperation,
+    kOtherKind
+  };
+
+  enum State {
+    kUninitialized,
+    kPremonomorphic,
+    kMonomorphic,
+    kPolymorphic,
+    kMegamorphic,
+    kGeneric
+  };
+
+  virtual ~InlineCacheSiteVisitor() {}
+
+  /**
+   * Called for each site. |script_id| is the id of the script containing
+   * the site, or UnboundScript::kNoScriptId, and |position| is the character
+   * offset of the site in the script source.
+   */
+  virtual void VisitInlineCacheSite(Kind kind, State state, int script_id,
+                                    int position) {}
+};
+
+
+/**
+ * Counts of the inline cache sites of the unoptimized code in an isolate by
+ * state, see Isolate::GetInlineCacheStatistics.
+ */
+class V8_EXPORT InlineCacheStatistics {
+ public:
+  InlineCacheStatistics();
+  size_t uninitialized_sites() { return uninitialized_sites_; }
+  size_t premonomorphic_sites() { return premonomorphic_sites_; }
+  size_t monomorphic_sites() { return monomorphic_sites_; }
+  size_t polymorphic_sites() { return polymorphic_sites_; }
+  size_t megamorphic_sites() { return megamorphic_sites_; }
+  size_t generic_sites() { return generic_sites_; }
+
+ private:
+  size_t uninitialized_sites_;
+  size_t premonomorphic_sites_;
+  size_t monomorphic_sites_;
+  size_t polymorphic_sites_;
+  size_t megamorphic_sites_;
+  size_t generic_sites_;
+
+  friend class Isolate;
+};
+
+
+/**
+ * Interface for iterating through the runtime call statistics of an
+ * isolate, see Isolate::VisitRuntimeCallStats.
+ */
+class V8_EXPORT RuntimeCallStatsVisitor {  // NOLINT
+ public:
+  virtual ~RuntimeCallStatsVisitor() {}
+
+  /**
+   * Called for each C++ runtime function or builtin that has been called
+   * since the statistics were last reset. |time_in_microseconds| excludes
+   * the time spent in nested runtime calls.
+   */
+  virtual void VisitRuntimeCallCounter(const char* name, int64_t count,
+                                       int64_t time_in_microseconds) = 0;
+};
+
+
 class RetainedObjectInfo;
 
 
@@ -4603,6 +5296,66 @@ class V8_EXPORT Isolate {
    */
   void GetHeapStatistics(HeapStatistics* heap_statistics);
 
+  /**
+   * Get statistics about the last completed garbage collection. Returns
+   * false if there has not been any garbage collection yet.
+   */
+  bool GetGCStatistics(GCStatistics* gc_statistics);
+
+  /**
+   * Returns the number of the built-in histogram timers, which cover
+   * compilation, garbage collection and inline cache misses among others.
+   */
+  size_t NumberOfHistogramTimers();
+
+  /**
+   * Get the distribution of the durations recorded by the histogram timer
+   * with the given index. Returns false if the index is out of range.
+   */
+  bool GetHistogramTimerStatistics(HistogramTimerStatistics* statistics,
+                                   size_t index);
+
+  /**
+   * Copies the execution counts of the basic blocks of the most recent
+   * TurboFan compilation of |function| with --turbo-profiling into |counts|,
+   * in the reverse post-order of its schedule. Returns the number of blocks,
+   * which may exceed |capacity|, or 0 if the function was not instrumented.
+   */
+  size_t GetBasicBlockCounts(Handle<Function> function, uint32_t* counts,
+                             size_t capacity);
+
+  /**
+   * Resets the basic block counts of all the instrumented TurboFan
+   * compilations of |function|.
+   */
+  void ResetBasicBlockCounts(Handle<Function> function);
+
+  /**
+   * Get the number of inline cache sites in unoptimized code by state.
+   * Walks the heap (without triggering a GC), so it should only be sampled
+   * occasionally, but it costs nothing while the inline caches run. Call
+   * sites keep their state in type feedback vectors and are not included.
+   */
+  void GetInlineCacheStatistics(InlineCacheStatistics* statistics);
+
+  /**
+   * Calls |visitor| for every inline cache site counted by
+   * GetInlineCacheStatistics. The visitor must not call into V8.
+   */
+  void VisitInlineCacheSites(InlineCacheSiteVisitor* visitor);
+
+  /**
+   * Calls |visitor| with the number of calls into and the time spent in
+   * each C++ runtime function and builtin. Only recorded with
+   * --runtime-call-stats.
+   */
+  void VisitRuntimeCallStats(RuntimeCallStatsVisitor* visitor);
+
+  /**
+   * Resets the runtime call statistics reported by VisitRuntimeCallStats.
+   */
+  void ResetRuntimeCallStats();
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -4747,6 +5500,32 @@ class V8_EXPORT Isolate {
    */
   void RemoveGCEpilogueCallback(GCEpilogueCallback callback);
 
+  typedef void (*GCStatisticsCallback)(Isolate* isolate,
+                                       const GCStatistics& statistics);
+
+  /**
+   * Enables the host application to receive the statistics of every garbage
+   * collection as soon as it has finished. The callback is invoked while the
+   * garbage collector is still active, so it must neither allocate on the
+   * V8 heap nor call into JavaScript. Passing NULL removes the callback.
+   */
+  void SetGCStatisticsCallback(GCStatisticsCallback callback);
+
+  typedef size_t (*NearHeapLimitCallback)(void* data,
+                                          size_t current_heap_limit,
+                                          size_t initial_heap_limit);
+
+  /**
+   * Enables the host application to react before the isolate runs out of
+   * old generation space. The callback is invoked after a full garbage
+   * collection that left little room below the current limit, and once more
+   * before V8 gives up with an out of memory error. It may return a larger
+   * limit, which V8 then adopts, or terminate execution of the isolate and
+   * return the current limit unchanged. Limits are in bytes. Passing NULL
+   * removes the callback; a raised limit stays in place.
+   */
+  void SetNearHeapLimitCallback(NearHeapLimitCallback callback, void* data);
+
   /**
    * Request V8 to interrupt long running JavaScript code and invoke
    * the given |callback| passing the given |data| to it. After |callback|
@@ -4801,6 +5580,13 @@ class V8_EXPORT Isolate {
    */
   void SetPromiseRejectCallback(PromiseRejectCallback callback);
 
+  /**
+   * Set callback to notify about every deoptimization of optimized code,
+   * right after the deoptimized frames have been materialized. The callback
+   * must not call into JavaScript. Passing NULL removes the callback.
+   */
+  void SetDeoptimizationCallback(DeoptimizationCallback callback);
+
   /**
    * Experimental: Runs the Microtask Work Queue until empty
    * Any exceptions thrown by microtask callbacks are swallowed.
@@ -4863,6 +5649,14 @@ class V8_EXPORT Isolate {
    */
   bool IdleNotification(int idle_time_in_ms);
 
+  /**
+   * Same as IdleNotification, but the end of the idle period is given as a
+   * deadline in seconds, on the clock returned by
+   * Platform::MonotonicallyIncreasingTime(). This allows V8 to make use of
+   * idle periods that are not a whole number of milliseconds long.
+   */
+  bool IdleNotificationDeadline(double deadline_in_seconds);
+
   /**
    * Optional notification that the system is running low on memory.
    * V8 uses these notifications to attempt to free memory.
@@ -4944,6 +5738,41 @@ class V8_EXPORT Isolate {
   void CollectAllGarbage(const char* gc_reason);
 };
 
+
+/**
+ * Hands out isolates that were fully initialized ahead of time.
+ *
+ * Creating an isolate sets up its heap, deserializes the snapshot and
+ * generates code stubs. An IsolateTemplate does this work on background
+ * threads of the platform for up to |pool_size| isolates with the given
+ * parameters, so that NewIsolate() usually only has to take a prepared
+ * isolate and bind its stack limits to the calling thread. Every isolate
+ * handed out is refilled in the background.
+ *
+ * The isolates are independent of each other and have to be disposed by
+ * the embedder as usual. Isolates that were not handed out are disposed
+ * when the template is destroyed.
+ */
+class V8_EXPORT IsolateTemplate {
+ public:
+  IsolateTemplate(const Isolate::CreateParams& params, int pool_size);
+  ~IsolateTemplate();
+
+  /**
+   * Returns a new isolate. Creates one on the calling thread if no prepared
+   * isolate is available yet.
+   */
+  Isolate* NewIsolate();
+
+ private:
+  // Prevent copying. Not implemented.
+  IsolateTemplate(const IsolateTemplate&);
+  IsolateTemplate& operator=(const IsolateTemplate&);
+
+  internal::IsolateTemplate* impl_;
+};
+
+
 class V8_EXPORT StartupData {
  public:
   enum CompressionAlgorithm {
@@ -5091,6 +5920,9 @@ class V8_EXPORT V8 {
    *   tries to make use of its built-ins.
    * - To avoid unnecessary copies of data, V8 will point directly into the
    *   given data blob, so pretty please keep it around until V8 exit.
+   * - V8 never writes to the blob. It can be a read-only mapping of the
+   *   blob file, which processes mapping the same file share, and V8 only
+   *   touches the parts it uses, e.g. the sources of compiled natives.
    * - Compression of the startup blob might be useful, but needs to
    *   handled entirely on the embedders' side.
    * - The call will abort if the data is invalid.
@@ -5098,6 +5930,22 @@ class V8_EXPORT V8 {
   static void SetNativesDataBlob(StartupData* startup_blob);
   static void SetSnapshotDataBlob(StartupData* startup_blob);
 
+  /**
+   * Create a new startup snapshot blob whose context has additionally run
+   * the given script, e.g. the runtime of an embedder framework. Contexts
+   * created from it with Context::New start out with the effects of that
+   * script, without running it again.
+   *
+   * Note:
+   * - The blob is meant to be passed to SetSnapshotDataBlob in a process
+   *   built with external startup data and the same V8 version and flags.
+   * - The script must not depend on the embedder's object templates,
+   *   extensions, or external references that differ between processes.
+   * - The returned data is owned by the caller (delete[] data). It is empty
+   *   (NULL data) if the script threw or could not be compiled.
+   */
+  static StartupData CreateSnapshotDataBlob(const char* custom_source = NULL);
+
   /**
    * Adds a message listener.
    *
@@ -5319,6 +6167,9 @@ class V8_EXPORT V8 {
   static void MakeWeak(internal::Object** global_handle,
                        void* data,
                        WeakCallback weak_callback);
+  static void MakeWeak(internal::Object** global_handle, void* data,
+                       WeakCallbackInfo<void>::Callback weak_callback,
+                       WeakCallbackType type);
   static void* ClearWeak(internal::Object** global_handle);
   static void Eternalize(Isolate* isolate,
                          Value* handle,
@@ -5902,8 +6753,10 @@ class Internals {
   static const int kExternalOneByteRepresentationTag = 0x06;
 
   static const int kIsolateEmbedderDataOffset = 0 * kApiPointerSize;
+  static const int kIsolateHandleScopeNextOffset = 4 * kApiPointerSize;
+  static const int kIsolateHandleScopeLimitOffset = 5 * kApiPointerSize;
   static const int kAmountOfExternalAllocatedMemoryOffset =
-      4 * kApiPointerSize;
+      6 * kApiPointerSize + 2 * kApiIntSize;
   static const int kAmountOfExternalAllocatedMemoryAtLastGlobalGCOffset =
       kAmountOfExternalAllocatedMemoryOffset + kApiInt64Size;
   static const int kIsolateRootsOffset =
@@ -5913,7 +6766,7 @@ class Internals {
   static const int kNullValueRootIndex = 7;
   static const int kTrueValueRootIndex = 8;
   static const int kFalseValueRootIndex = 9;
-  static const int kEmptyStringRootIndex = 153;
+  static const int kEmptyStringRootIndex = 157;
 
   // The external allocation limit should be below 256 MB on all architectures
   // to avoid that resource-constrained embedders run low on memory.
@@ -5921,17 +6774,17 @@ class Internals {
 
   static const int kNodeClassIdOffset = 1 * kApiPointerSize;
   static const int kNodeFlagsOffset = 1 * kApiPointerSize + 3;
-  static const int kNodeStateMask = 0xf;
+  static const int kNodeStateMask = 0x7;
   static const int kNodeStateIsWeakValue = 2;
   static const int kNodeStateIsPendingValue = 3;
   static const int kNodeStateIsNearDeathValue = 4;
-  static const int kNodeIsIndependentShift = 4;
-  static const int kNodeIsPartiallyDependentShift = 5;
+  static const int kNodeIsIndependentShift = 3;
+  static const int kNodeIsPartiallyDependentShift = 4;
 
-  static const int kJSObjectType = 0xbc;
+  static const int kJSObjectType = 0xbf;
   static const int kFirstNonstringType = 0x80;
   static const int kOddballType = 0x83;
-  static const int kForeignType = 0x88;
+  static const int kForeignType = 0x8b;
 
   static const int kUndefinedOddballKind = 5;
   static const int kNullOddballKind = 3;
@@ -6024,6 +6877,12 @@ class Internals {
     return reinterpret_cast<internal::Object**>(addr + index * kApiPointerSize);
   }
 
+  V8_INLINE static internal::Object*** GetHandleScopeField(
+      internal::Isolate* isolate, int offset) {
+    uint8_t* addr = reinterpret_cast<uint8_t*>(isolate) + offset;
+    return reinterpret_cast<internal::Object***>(addr);
+  }
+
   template <typename T>
   V8_INLINE static T ReadField(const internal::Object* ptr, int offset) {
     const uint8_t* addr =
@@ -6072,6 +6931,25 @@ Handle<T> Handle<T>::New(Isolate* isolate, T* that) {
 }
 
 
+internal::Object** HandleScope::CreateHandle(internal::Isolate* isolate,
+                                             internal::Object* value) {
+#ifndef V8_ENABLE_CHECKS
+  typedef internal::Object O;
+  typedef internal::Internals I;
+  O*** next = I::GetHandleScopeField(isolate, I::kIsolateHandleScopeNextOffset);
+  O** limit =
+      *I::GetHandleScopeField(isolate, I::kIsolateHandleScopeLimitOffset);
+  O** result = *next;
+  if (result != limit) {
+    *next = result + 1;
+    *result = value;
+    return result;
+  }
+#endif
+  return SlowCreateHandle(isolate, value);
+}
+
+
 template <class T>
 Local<T> Local<T>::New(Isolate* isolate, T* that) {
   if (that == NULL) return Local<T>();
@@ -6198,6 +7076,17 @@ void PersistentBase<T>::SetWeak(
 }
 
 
+template <class T>
+template <typename P>
+void PersistentBase<T>::SetWeak(
+    P* parameter, typename WeakCallbackInfo<P>::Callback callback,
+    WeakCallbackType type) {
+  typedef typename WeakCallbackInfo<void>::Callback Callback;
+  V8::MakeWeak(reinterpret_cast<internal::Object**>(this->val_), parameter,
+               reinterpret_cast<Callback>(callback), type);
+}
+
+
 template <class T>
 template<typename P>
 P* PersistentBase<T>::ClearWeak() {
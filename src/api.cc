@@ -12,11 +12,13 @@
 #include "include/v8-debug.h"
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
+#include "src/array-buffer-allocator.h"
 #include "src/assert-scope.h"
 #include "src/background-parsing-task.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/basic-block-profiler.h"
 #include "src/bootstrapper.h"
 #include "src/code-stubs.h"
 #include "src/compiler.h"
@@ -29,8 +31,11 @@
 #include "src/global-handles.h"
 #include "src/heap-profiler.h"
 #include "src/heap-snapshot-generator-inl.h"
+#include "src/ic/ic.h"
 #include "src/icu_util.h"
+#include "src/isolate-template.h"
 #include "src/json-parser.h"
+#include "src/json-stringifier.h"
 #include "src/messages.h"
 #include "src/natives.h"
 #include "src/parser.h"
@@ -41,11 +46,14 @@
 #include "src/runtime/runtime.h"
 #include "src/runtime-profiler.h"
 #include "src/sampler.h"
+#include "src/sampling-heap-profiler.h"
 #include "src/scanner-character-streams.h"
+#include "src/serialize.h"
 #include "src/simulator.h"
 #include "src/snapshot.h"
 #include "src/unicode-inl.h"
 #include "src/v8threads.h"
+#include "src/value-serializer.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
 
@@ -349,6 +357,65 @@ void V8::SetSnapshotDataBlob(StartupData* snapshot_blob) {
 }
 
 
+StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
+  Isolate::CreateParams params;
+  params.enable_serializer = true;
+  Isolate* isolate = v8::Isolate::New(params);
+  StartupData result = {NULL, 0, 0};
+  {
+    Isolate::Scope isolate_scope(isolate);
+    i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Persistent<Context> context;
+    bool success = true;
+    {
+      HandleScope handle_scope(isolate);
+      Local<Context> new_context = Context::New(isolate);
+      context.Reset(isolate, new_context);
+      if (custom_source != NULL) {
+        Context::Scope context_scope(new_context);
+        TryCatch try_catch;
+        Local<Script> script =
+            Script::Compile(String::NewFromUtf8(isolate, custom_source));
+        success = !script.IsEmpty() && !script->Run().IsEmpty();
+      }
+    }
+    if (success) {
+      // Make sure all builtin scripts are cached.
+      {
+        HandleScope scope(isolate);
+        for (int i = 0; i < i::Natives::GetBuiltinsCount(); i++) {
+          internal_isolate->bootstrapper()->NativesSourceLookup(i);
+        }
+      }
+      // Drop the stray root that would otherwise keep pointing at the
+      // context, see mksnapshot.
+      internal_isolate->heap()->CollectAllGarbage(i::Heap::kNoGCFlags,
+                                                  "CreateSnapshotDataBlob");
+      i::Object* raw_context = *v8::Utils::OpenPersistent(context);
+      context.Reset();
+
+      i::List<i::byte> snapshot_data;
+      i::ListSnapshotSink snapshot_sink(&snapshot_data);
+      i::StartupSerializer ser(internal_isolate, &snapshot_sink);
+      ser.SerializeStrongReferences();
+
+      i::List<i::byte> context_data;
+      i::ListSnapshotSink context_sink(&context_data);
+      i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
+      context_ser.Serialize(&raw_context);
+      ser.SerializeWeakReferences();
+
+      result = i::CreateSnapshotBlob(snapshot_data, ser, context_data,
+                                     context_ser);
+    } else {
+      context.Reset();
+    }
+  }
+  isolate->Dispose();
+  return result;
+}
+
+
 void V8::SetFatalErrorHandler(FatalErrorCallback that) {
   i::Isolate* isolate = i::Isolate::Current();
   isolate->set_exception_behavior(that);
@@ -425,7 +492,8 @@ ResourceConstraints::ResourceConstraints()
       max_executable_size_(0),
       stack_limit_(NULL),
       max_available_threads_(0),
-      code_range_size_(0) { }
+      code_range_size_(0),
+      zone_segment_pool_size_(0) { }
 
 void ResourceConstraints::ConfigureDefaults(uint64_t physical_memory,
                                             uint64_t virtual_memory_limit,
@@ -489,6 +557,11 @@ void SetResourceConstraints(i::Isolate* isolate,
   }
 
   isolate->set_max_available_threads(constraints.max_available_threads());
+
+  if (constraints.zone_segment_pool_size() != 0) {
+    isolate->zone_segment_pool()->set_max_pooled_bytes(
+        constraints.zone_segment_pool_size());
+  }
 }
 
 
@@ -518,6 +591,13 @@ void V8::MakeWeak(i::Object** object,
 }
 
 
+void V8::MakeWeak(i::Object** object, void* parameter,
+                  WeakCallbackInfo<void>::Callback weak_callback,
+                  WeakCallbackType type) {
+  i::GlobalHandles::MakeWeak(object, parameter, weak_callback, type);
+}
+
+
 void* V8::ClearWeak(i::Object** obj) {
   return i::GlobalHandles::ClearWeakness(obj);
 }
@@ -577,7 +657,8 @@ int HandleScope::NumberOfHandles(Isolate* isolate) {
 }
 
 
-i::Object** HandleScope::CreateHandle(i::Isolate* isolate, i::Object* value) {
+i::Object** HandleScope::SlowCreateHandle(i::Isolate* isolate,
+                                          i::Object* value) {
   return i::HandleScope::CreateHandle(isolate, value);
 }
 
@@ -610,6 +691,26 @@ i::Object** EscapableHandleScope::Escape(i::Object** escape_value) {
 }
 
 
+SealHandleScope::SealHandleScope(Isolate* isolate) {
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+
+  isolate_ = internal_isolate;
+  i::HandleScopeData* current = internal_isolate->handle_scope_data();
+  prev_limit_ = current->limit;
+  current->limit = current->next;
+  prev_sealed_level_ = current->sealed_level;
+  current->sealed_level = current->level;
+}
+
+
+SealHandleScope::~SealHandleScope() {
+  i::HandleScopeData* current = isolate_->handle_scope_data();
+  DCHECK_EQ(current->next, current->limit);
+  current->limit = prev_limit_;
+  current->sealed_level = prev_sealed_level_;
+}
+
+
 void Context::Enter() {
   i::Handle<i::Context> env = Utils::OpenHandle(this);
   i::Isolate* isolate = env->GetIsolate();
@@ -1123,6 +1224,36 @@ void FunctionTemplate::SetCallHandler(FunctionCallback callback,
 }
 
 
+void FunctionTemplate::SetFastCallHandler(FastCallHandler handler,
+                                          FastCallType return_type,
+                                          int parameter_count,
+                                          const FastCallType* parameter_types) {
+  i::Handle<i::FunctionTemplateInfo> info = Utils::OpenHandle(this);
+  i::Isolate* isolate = info->GetIsolate();
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  const char* location = "v8::FunctionTemplate::SetFastCallHandler";
+  if (!Utils::ApiCheck(parameter_count >= 0 &&
+                           parameter_count <= kMaxFastCallParameters,
+                       location, "Too many parameters")) {
+    return;
+  }
+  if (!Utils::ApiCheck(return_type != kFastCallHolder, location,
+                       "Invalid return type")) {
+    return;
+  }
+  for (int i = 0; i < parameter_count; i++) {
+    FastCallType type = parameter_types[i];
+    bool valid = type == kFastCallHolder ? i == 0 : type != kFastCallVoid;
+    if (!Utils::ApiCheck(valid, location, "Invalid parameter type")) return;
+  }
+  int signature = i::FunctionTemplateInfo::EncodeFastCallSignature(
+      return_type, parameter_count, parameter_types);
+  SET_FIELD_WRAPPED(info, set_fast_call_handler, handler);
+  info->set_fast_call_signature(i::Smi::FromInt(signature));
+}
+
+
 static i::Handle<i::AccessorInfo> SetAccessorInfoProperties(
     i::Handle<i::AccessorInfo> obj,
     v8::Handle<Name> name,
@@ -1401,7 +1532,8 @@ void ObjectTemplate::SetNamedPropertyHandler(
     NamedPropertyQueryCallback query,
     NamedPropertyDeleterCallback remover,
     NamedPropertyEnumeratorCallback enumerator,
-    Handle<Value> data) {
+    Handle<Value> data,
+    NamedPropertyHandlerFlags flags) {
   i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
   ENTER_V8(isolate);
   i::HandleScope scope(isolate);
@@ -1413,6 +1545,8 @@ void ObjectTemplate::SetNamedPropertyHandler(
       isolate->factory()->NewStruct(i::INTERCEPTOR_INFO_TYPE);
   i::Handle<i::InterceptorInfo> obj =
       i::Handle<i::InterceptorInfo>::cast(struct_obj);
+  obj->set_flag(0);
+  obj->set_non_masking((flags & kNonMaskingNamedPropertyHandler) != 0);
 
   if (getter != 0) SET_FIELD_WRAPPED(obj, set_getter, getter);
   if (setter != 0) SET_FIELD_WRAPPED(obj, set_setter, setter);
@@ -1489,6 +1623,7 @@ void ObjectTemplate::SetIndexedPropertyHandler(
       isolate->factory()->NewStruct(i::INTERCEPTOR_INFO_TYPE);
   i::Handle<i::InterceptorInfo> obj =
       i::Handle<i::InterceptorInfo>::cast(struct_obj);
+  obj->set_flag(0);
 
   if (getter != 0) SET_FIELD_WRAPPED(obj, set_getter, getter);
   if (setter != 0) SET_FIELD_WRAPPED(obj, set_setter, setter);
@@ -1878,6 +2013,101 @@ Local<Script> ScriptCompiler::Compile(Isolate* v8_isolate,
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Handle<UnboundScript> script) {
+  i::Handle<i::SharedFunctionInfo> info =
+      i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(*script));
+  i::Isolate* isolate = info->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::CreateCodeCache()", return NULL);
+  LOG_API(isolate, "ScriptCompiler::CreateCodeCache");
+  ENTER_V8(isolate);
+  if (!i::FLAG_serialize_toplevel || isolate->debug()->is_loaded()) {
+    return NULL;
+  }
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data = i::Compiler::SerializeCompiledFunctions(info);
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
+ScriptCompiler::CachedData* ScriptCompiler::CreatePretenuringData(
+    Handle<UnboundScript> script) {
+  i::Handle<i::SharedFunctionInfo> info =
+      i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(*script));
+  i::Isolate* isolate = info->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::CreatePretenuringData()",
+             return NULL);
+  LOG_API(isolate, "ScriptCompiler::CreatePretenuringData");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data =
+      i::CodeSerializer::SerializePretenuringDecisions(isolate, info);
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
+bool ScriptCompiler::ConsumePretenuringData(
+    Handle<UnboundScript> script, const CachedData* data) {
+  i::Handle<i::SharedFunctionInfo> info =
+      i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(*script));
+  i::Isolate* isolate = info->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::ConsumePretenuringData()",
+             return false);
+  LOG_API(isolate, "ScriptCompiler::ConsumePretenuringData");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  // ScriptData takes care of pointer-aligning the data.
+  i::ScriptData script_data(data->data, data->length);
+  return i::CodeSerializer::DeserializePretenuringDecisions(
+      isolate, &script_data, info);
+}
+
+
+ScriptCompiler::CachedData* ScriptCompiler::CreateTieringData(
+    Handle<UnboundScript> script) {
+  i::Handle<i::SharedFunctionInfo> info =
+      i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(*script));
+  i::Isolate* isolate = info->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::CreateTieringData()", return NULL);
+  LOG_API(isolate, "ScriptCompiler::CreateTieringData");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data =
+      i::CodeSerializer::SerializeTieringHints(isolate, info);
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
+bool ScriptCompiler::ConsumeTieringData(Handle<UnboundScript> script,
+                                        const CachedData* data) {
+  i::Handle<i::SharedFunctionInfo> info =
+      i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(*script));
+  i::Isolate* isolate = info->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::ConsumeTieringData()",
+             return false);
+  LOG_API(isolate, "ScriptCompiler::ConsumeTieringData");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  // ScriptData takes care of pointer-aligning the data.
+  i::ScriptData script_data(data->data, data->length);
+  return i::CodeSerializer::DeserializeTieringHints(isolate, &script_data,
+                                                    info);
+}
+
+
 Local<Script> Script::Compile(v8::Handle<String> source,
                               v8::ScriptOrigin* origin) {
   i::Handle<i::String> str = Utils::OpenHandle(*source);
@@ -2381,6 +2611,122 @@ Local<Value> JSON::Parse(Local<String> json_string) {
 }
 
 
+bool JSON::Stringify(Local<Value> value, OutputStream* stream) {
+  i::Handle<i::Object> object = Utils::OpenHandle(*value);
+  i::Isolate* isolate = i::Isolate::Current();
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  i::BasicJsonStringifier stringifier(isolate);
+  i::Handle<i::Object> result;
+  has_pending_exception =
+      !stringifier.StringifyToStream(object, stream).ToHandle(&result);
+  EXCEPTION_BAILOUT_CHECK(isolate, false);
+  return result->IsTrue();
+}
+
+
+// --- V a l u e S e r i a l i z e r ---
+
+ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate)
+    : serializer_(new i::ValueSerializer(
+          reinterpret_cast<i::Isolate*>(isolate), delegate)) {}
+
+
+ValueSerializer::~ValueSerializer() { delete serializer_; }
+
+
+void ValueSerializer::WriteHeader() { serializer_->WriteHeader(); }
+
+
+bool ValueSerializer::WriteValue(Handle<Value> value) {
+  i::Isolate* isolate = serializer_->isolate();
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  has_pending_exception =
+      !serializer_->WriteValue(Utils::OpenHandle(*value));
+  EXCEPTION_BAILOUT_CHECK(isolate, false);
+  return true;
+}
+
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Handle<ArrayBuffer> array_buffer) {
+  serializer_->TransferArrayBuffer(transfer_id,
+                                   Utils::OpenHandle(*array_buffer));
+}
+
+
+void ValueSerializer::WriteUint32(uint32_t value) {
+  serializer_->WriteUint32(value);
+}
+
+
+void ValueSerializer::WriteRawBytes(const void* source, size_t length) {
+  serializer_->WriteRawBytes(source, length);
+}
+
+
+const uint8_t* ValueSerializer::Data() const { return serializer_->data(); }
+
+
+size_t ValueSerializer::Size() const { return serializer_->size(); }
+
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data,
+                                     size_t size, Delegate* delegate) {
+  Utils::ApiCheck(size <= static_cast<size_t>(i::kMaxInt),
+                  "v8::ValueDeserializer::ValueDeserializer",
+                  "Data is too large");
+  deserializer_ = new i::ValueDeserializer(
+      reinterpret_cast<i::Isolate*>(isolate),
+      i::Vector<const uint8_t>(data, static_cast<int>(size)), delegate);
+}
+
+
+ValueDeserializer::~ValueDeserializer() { delete deserializer_; }
+
+
+bool ValueDeserializer::ReadHeader() {
+  i::Isolate* isolate = deserializer_->isolate();
+  ENTER_V8(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  has_pending_exception = !deserializer_->ReadHeader();
+  EXCEPTION_BAILOUT_CHECK(isolate, false);
+  return true;
+}
+
+
+Local<Value> ValueDeserializer::ReadValue() {
+  i::Isolate* isolate = deserializer_->isolate();
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  i::Handle<i::Object> result;
+  has_pending_exception = !deserializer_->ReadValue().ToHandle(&result);
+  EXCEPTION_BAILOUT_CHECK(isolate, Local<Value>());
+  return Utils::ToLocal(scope.CloseAndEscape(result));
+}
+
+
+void ValueDeserializer::TransferArrayBuffer(uint32_t transfer_id,
+                                            Handle<ArrayBuffer> array_buffer) {
+  deserializer_->TransferArrayBuffer(transfer_id,
+                                     Utils::OpenHandle(*array_buffer));
+}
+
+
+bool ValueDeserializer::ReadUint32(uint32_t* value) {
+  return deserializer_->ReadUint32(value);
+}
+
+
+bool ValueDeserializer::ReadRawBytes(size_t length, const void** data) {
+  return deserializer_->ReadRawBytes(length, data);
+}
+
+
 // --- D a t a ---
 
 bool Value::FullIsUndefined() const {
@@ -4655,14 +5001,29 @@ class Utf8WriterVisitor {
       }
       // Write the characters to the stream.
       if (sizeof(Char) == 1) {
-        for (; i < fast_length; i++) {
+        while (i < fast_length) {
+          // Runs of ASCII characters are already valid UTF-8, so they are
+          // found a word at a time and copied in bulk.
+          int ascii_length = v8::internal::String::NonAsciiStart(
+              reinterpret_cast<const char*>(chars), fast_length - i);
+          v8::internal::MemCopy(buffer, chars, ascii_length);
+          buffer += ascii_length;
+          chars += ascii_length;
+          i += ascii_length;
+          if (i == fast_length) break;
           buffer +=
               Utf8::EncodeOneByte(buffer, static_cast<uint8_t>(*chars++));
+          i++;
           DCHECK(capacity_ == -1 || (buffer - start_) <= capacity_);
         }
       } else {
         for (; i < fast_length; i++) {
           uint16_t character = *chars++;
+          if (character <= Utf8::kMaxOneByteChar) {
+            *buffer++ = static_cast<char>(character);
+            last_character = character;
+            continue;
+          }
           buffer += Utf8::Encode(buffer,
                                  character,
                                  last_character,
@@ -5072,6 +5433,11 @@ void v8::V8::SetReturnAddressLocationResolver(
   i::V8::SetReturnAddressLocationResolver(return_address_resolver);
 }
 
+v8::ArrayBuffer::Allocator* v8::ArrayBuffer::Allocator::NewPooledAllocator() {
+  return new i::PooledArrayBufferAllocator();
+}
+
+
 void v8::V8::SetArrayBufferAllocator(
     ArrayBuffer::Allocator* allocator) {
   if (!Utils::ApiCheck(i::V8::ArrayBufferAllocator() == NULL,
@@ -5095,6 +5461,41 @@ HeapStatistics::HeapStatistics(): total_heap_size_(0),
                                   heap_size_limit_(0) { }
 
 
+GCStatistics::GCStatistics()
+    : type_(kGCTypeAll),
+      start_time_(0.0),
+      end_time_(0.0),
+      incremental_marking_duration_(0.0),
+      mutator_duration_(0.0),
+      size_before_(0),
+      size_after_(0),
+      promoted_bytes_(0),
+      semi_space_copied_bytes_(0),
+      survival_rate_(0.0) {
+  for (int i = 0; i < kNumberOfPhases; i++) phases_[i] = 0.0;
+}
+
+
+double GCStatistics::mutator_utilization() const {
+  double total = mutator_duration_ + duration();
+  if (total <= 0) return 1.0;
+  return mutator_duration_ / total;
+}
+
+
+HistogramTimerStatistics::HistogramTimerStatistics()
+    : name_(NULL), count_(0), p50_(0), p99_(0), p999_(0), max_(0) {}
+
+
+InlineCacheStatistics::InlineCacheStatistics()
+    : uninitialized_sites_(0),
+      premonomorphic_sites_(0),
+      monomorphic_sites_(0),
+      polymorphic_sites_(0),
+      megamorphic_sites_(0),
+      generic_sites_(0) {}
+
+
 void v8::V8::VisitExternalResources(ExternalResourceVisitor* visitor) {
   i::Isolate* isolate = i::Isolate::Current();
   isolate->heap()->VisitExternalResources(visitor);
@@ -5509,6 +5910,66 @@ static i::MaybeHandle<i::String> NewExternalOneByteStringHandle(
 }
 
 
+// Refers to a range of the backing store of an ArrayBuffer, which is kept
+// alive through a global handle until the external string is disposed.
+class ArrayBufferExternalOneByteStringResource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  ArrayBufferExternalOneByteStringResource(v8::Isolate* isolate,
+                                           Handle<ArrayBuffer> buffer,
+                                           const char* data,
+                                           size_t length)
+      : buffer_(isolate, buffer), data_(data), length_(length) {}
+  virtual ~ArrayBufferExternalOneByteStringResource() { buffer_.Reset(); }
+  virtual const char* data() const { return data_; }
+  virtual size_t length() const { return length_; }
+
+ private:
+  Persistent<ArrayBuffer> buffer_;
+  const char* data_;
+  size_t length_;
+};
+
+
+// Refers to memory of the embedder, which is notified through the release
+// callback once the external string is disposed.
+class CallbackExternalOneByteStringResource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  CallbackExternalOneByteStringResource(
+      const char* data, size_t length,
+      v8::String::ExternalReleaseCallback callback, void* parameter)
+      : data_(data), length_(length), callback_(callback),
+        parameter_(parameter) {}
+  virtual ~CallbackExternalOneByteStringResource() {
+    callback_(data_, length_, parameter_);
+  }
+  virtual const char* data() const { return data_; }
+  virtual size_t length() const { return length_; }
+
+ private:
+  const char* data_;
+  size_t length_;
+  v8::String::ExternalReleaseCallback callback_;
+  void* parameter_;
+};
+
+
+// Creates an external string for a resource owned by V8. The resource is
+// disposed right away if the string cannot be created.
+static Local<String> NewOwnedExternalOneByteString(
+    i::Isolate* isolate, v8::String::ExternalOneByteStringResource* resource) {
+  EXCEPTION_PREAMBLE(isolate);
+  i::Handle<i::String> string;
+  has_pending_exception =
+      !NewExternalOneByteStringHandle(isolate, resource).ToHandle(&string);
+  if (has_pending_exception) delete resource;
+  EXCEPTION_BAILOUT_CHECK(isolate, Local<String>());
+  isolate->heap()->external_string_table()->AddString(*string);
+  return Utils::ToLocal(string);
+}
+
+
 Local<String> v8::String::NewExternal(
     Isolate* isolate,
     v8::String::ExternalStringResource* resource) {
@@ -5568,6 +6029,48 @@ Local<String> v8::String::NewExternal(
 }
 
 
+Local<String> v8::String::NewExternal(Isolate* isolate,
+                                      Handle<ArrayBuffer> buffer,
+                                      size_t byte_offset,
+                                      size_t length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, "String::NewExternal(ArrayBuffer)");
+  ENTER_V8(i_isolate);
+  i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(*buffer);
+  size_t byte_length = static_cast<size_t>(obj->byte_length()->Number());
+  Utils::ApiCheck(byte_offset <= byte_length &&
+                      length <= byte_length - byte_offset,
+                  "v8::String::NewExternal",
+                  "Range exceeds the ArrayBuffer");
+  if (length == 0) return Utils::ToLocal(i_isolate->factory()->empty_string());
+  const char* data = static_cast<const char*>(obj->backing_store());
+  return NewOwnedExternalOneByteString(
+      i_isolate, new ArrayBufferExternalOneByteStringResource(
+                     isolate, buffer, data + byte_offset, length));
+}
+
+
+Local<String> v8::String::NewExternal(Isolate* isolate,
+                                      const char* data,
+                                      size_t length,
+                                      ExternalReleaseCallback callback,
+                                      void* parameter) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, "String::NewExternal(ReleaseCallback)");
+  ENTER_V8(i_isolate);
+  CHECK(callback != NULL);
+  if (length == 0) {
+    callback(data, length, parameter);
+    return Utils::ToLocal(i_isolate->factory()->empty_string());
+  }
+  CHECK(data != NULL);
+  return NewOwnedExternalOneByteString(
+      i_isolate, new CallbackExternalOneByteStringResource(data, length,
+                                                           callback,
+                                                           parameter));
+}
+
+
 bool v8::String::MakeExternal(
     v8::String::ExternalOneByteStringResource* resource) {
   i::Handle<i::String> obj = Utils::OpenHandle(this);
@@ -5624,6 +6127,104 @@ Local<v8::Object> v8::Object::New(Isolate* isolate) {
 }
 
 
+// Returns the map for objects with fast in-object fields for |keys|, whose
+// fields have been generalized so that any value can be stored in them
+// directly. Fails if the keys cannot all become such fields. The keys are
+// internalized in place.
+static i::MaybeHandle<i::Map> MapForProperties(i::Isolate* isolate,
+                                               i::Handle<i::FixedArray> keys) {
+  i::Factory* factory = isolate->factory();
+  int length = keys->length();
+  // All fields have to fit into the object itself.
+  static const int kMaxFields =
+      (i::JSObject::kMaxInstanceSize - i::JSObject::kHeaderSize) /
+      i::kPointerSize;
+  if (length > kMaxFields) return i::MaybeHandle<i::Map>();
+  for (int i = 0; i < length; i++) {
+    i::Handle<i::Name> key(i::Name::cast(keys->get(i)), isolate);
+    if (key->IsString()) {
+      uint32_t index;
+      i::Handle<i::String> string = i::Handle<i::String>::cast(key);
+      if (string->AsArrayIndex(&index)) return i::MaybeHandle<i::Map>();
+      keys->set(i, *factory->InternalizeString(string));
+    }
+    for (int j = 0; j < i; j++) {
+      if (keys->get(j) == keys->get(i)) return i::MaybeHandle<i::Map>();
+    }
+  }
+
+  // Let the transition tree find or create the map, starting from the map
+  // that object literals with these keys use.
+  i::Handle<i::Map> map =
+      factory->ObjectLiteralMapFromCache(isolate->native_context(), keys);
+  i::Handle<i::JSObject> boilerplate = factory->NewJSObjectFromMap(map);
+  for (int i = 0; i < length; i++) {
+    i::Handle<i::Name> key(i::Name::cast(keys->get(i)), isolate);
+    i::JSObject::SetOwnPropertyIgnoreAttributes(
+        boilerplate, key, factory->undefined_value(), NONE).Check();
+  }
+  if (!boilerplate->HasFastProperties()) return i::MaybeHandle<i::Map>();
+  map = i::Map::GeneralizeAllFieldRepresentations(
+      i::handle(boilerplate->map(), isolate));
+  if (map->inobject_properties() < length) return i::MaybeHandle<i::Map>();
+  return map;
+}
+
+
+static i::Handle<i::Object> OpenValue(i::Isolate* isolate,
+                                      Handle<Value> value) {
+  if (value.IsEmpty()) return isolate->factory()->undefined_value();
+  return Utils::OpenHandle(*value);
+}
+
+
+static i::Handle<i::JSObject> NewObjectWithProperties(
+    i::Isolate* isolate, i::MaybeHandle<i::Map> maybe_map,
+    i::Handle<i::FixedArray> keys, Handle<Value> values[]) {
+  i::Factory* factory = isolate->factory();
+  int length = keys->length();
+  i::Handle<i::Map> map;
+  if (maybe_map.ToHandle(&map)) {
+    i::Handle<i::JSObject> object = factory->NewJSObjectFromMap(map);
+    for (int i = 0; i < length; i++) {
+      i::Handle<i::Object> value = OpenValue(isolate, values[i]);
+      object->FastPropertyAtPut(i::FieldIndex::ForDescriptor(*map, i), *value);
+    }
+    return object;
+  }
+  i::Handle<i::JSObject> object =
+      factory->NewJSObject(isolate->object_function());
+  for (int i = 0; i < length; i++) {
+    i::Handle<i::Object> key(keys->get(i), isolate);
+    i::Handle<i::Object> value = OpenValue(isolate, values[i]);
+    i::Runtime::DefineObjectProperty(object, key, value, NONE).Check();
+  }
+  return object;
+}
+
+
+static i::Handle<i::FixedArray> KeysFromNames(i::Isolate* isolate,
+                                              Handle<Name> names[],
+                                              int length) {
+  i::Handle<i::FixedArray> keys = isolate->factory()->NewFixedArray(length);
+  for (int i = 0; i < length; i++) keys->set(i, *Utils::OpenHandle(*names[i]));
+  return keys;
+}
+
+
+Local<v8::Object> v8::Object::New(Isolate* isolate, Handle<Name> names[],
+                                  Handle<Value> values[], int length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, "Object::New");
+  ENTER_V8(i_isolate);
+  DCHECK(length >= 0);
+  i::Handle<i::FixedArray> keys = KeysFromNames(i_isolate, names, length);
+  i::Handle<i::JSObject> obj = NewObjectWithProperties(
+      i_isolate, MapForProperties(i_isolate, keys), keys, values);
+  return Utils::ToLocal(obj);
+}
+
+
 Local<v8::Value> v8::NumberObject::New(Isolate* isolate, double value) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, "NumberObject::New");
@@ -5822,6 +6423,31 @@ Local<v8::Array> v8::Array::New(Isolate* isolate, int length) {
 }
 
 
+Local<v8::Array> v8::Array::NewObjects(Isolate* isolate, Handle<Name> names[],
+                                       int property_count,
+                                       Handle<Value> values[],
+                                       int object_count) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  LOG_API(i_isolate, "Array::NewObjects");
+  ENTER_V8(i_isolate);
+  DCHECK(property_count >= 0 && object_count >= 0);
+  i::Factory* factory = i_isolate->factory();
+  i::Handle<i::FixedArray> keys =
+      KeysFromNames(i_isolate, names, property_count);
+  i::MaybeHandle<i::Map> map = MapForProperties(i_isolate, keys);
+  i::Handle<i::FixedArray> elements = factory->NewFixedArray(object_count);
+  for (int i = 0; i < object_count; i++) {
+    i::HandleScope scope(i_isolate);
+    i::Handle<i::JSObject> object = NewObjectWithProperties(
+        i_isolate, map, keys, values + i * property_count);
+    elements->set(i, *object);
+  }
+  i::Handle<i::JSArray> obj =
+      factory->NewJSArrayWithElements(elements, i::FAST_ELEMENTS);
+  return Utils::ToLocal(obj);
+}
+
+
 uint32_t v8::Array::Length() const {
   i::Handle<i::JSArray> obj = Utils::OpenHandle(this);
   i::Object* length = obj->length();
@@ -6006,6 +6632,11 @@ bool v8::ArrayBuffer::IsExternal() const {
 }
 
 
+bool v8::ArrayBuffer::IsShared() const {
+  return Utils::OpenHandle(this)->is_shared();
+}
+
+
 v8::ArrayBuffer::Contents v8::ArrayBuffer::Externalize() {
   i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
   Utils::ApiCheck(!obj->is_external(),
@@ -6020,12 +6651,25 @@ v8::ArrayBuffer::Contents v8::ArrayBuffer::Externalize() {
 }
 
 
+v8::ArrayBuffer::Contents v8::ArrayBuffer::GetContents() {
+  i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
+  size_t byte_length = static_cast<size_t>(obj->byte_length()->Number());
+  Contents contents;
+  contents.data_ = obj->backing_store();
+  contents.byte_length_ = byte_length;
+  return contents;
+}
+
+
 void v8::ArrayBuffer::Neuter() {
   i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
   i::Isolate* isolate = obj->GetIsolate();
   Utils::ApiCheck(obj->is_external(),
                   "v8::ArrayBuffer::Neuter",
                   "Only externalized ArrayBuffers can be neutered");
+  Utils::ApiCheck(!obj->is_shared(),
+                  "v8::ArrayBuffer::Neuter",
+                  "SharedArrayBuffers cannot be neutered");
   LOG_API(obj->GetIsolate(), "v8::ArrayBuffer::Neuter()");
   ENTER_V8(isolate);
   i::Runtime::NeuterArrayBuffer(obj);
@@ -6050,13 +6694,34 @@ Local<ArrayBuffer> v8::ArrayBuffer::New(Isolate* isolate, size_t byte_length) {
 
 
 Local<ArrayBuffer> v8::ArrayBuffer::New(Isolate* isolate, void* data,
-                                        size_t byte_length) {
+                                        size_t byte_length,
+                                        CreationMode mode) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, "v8::ArrayBuffer::New(void*, size_t)");
   ENTER_V8(i_isolate);
   i::Handle<i::JSArrayBuffer> obj =
       i_isolate->factory()->NewJSArrayBuffer();
+  i::Runtime::SetupArrayBuffer(i_isolate, obj, mode == kExternalized, data,
+                               byte_length);
+  if (mode == kInternalized) {
+    isolate->AdjustAmountOfExternalAllocatedMemory(byte_length);
+  }
+  return Utils::ToLocal(obj);
+}
+
+
+Local<ArrayBuffer> v8::ArrayBuffer::NewShared(Isolate* isolate, void* data,
+                                              size_t byte_length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  Utils::ApiCheck(i::FLAG_harmony_atomics,
+                  "v8::ArrayBuffer::NewShared",
+                  "SharedArrayBuffers require --harmony-atomics");
+  LOG_API(i_isolate, "v8::ArrayBuffer::NewShared(void*, size_t)");
+  ENTER_V8(i_isolate);
+  i::Handle<i::JSArrayBuffer> obj =
+      i_isolate->factory()->NewJSSharedArrayBuffer();
   i::Runtime::SetupArrayBuffer(i_isolate, obj, true, data, byte_length);
+  obj->set_is_shared(true);
   return Utils::ToLocal(obj);
 }
 
@@ -6614,9 +7279,12 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
   }
   // TODO(jochen): Once we got rid of Isolate::Current(), we can remove this.
   Isolate::Scope isolate_scope(v8_isolate);
-  if (params.entry_hook || !i::Snapshot::Initialize(isolate)) {
+  if (params.entry_hook || params.enable_serializer ||
+      !i::Snapshot::Initialize(isolate)) {
     // If the isolate has a function entry hook, it needs to re-build all its
     // code stubs with entry hooks embedded, so don't deserialize a snapshot.
+    // An isolate that is going to be serialized is also built from scratch,
+    // since a deserialized heap cannot be serialized again.
     isolate->Init(NULL);
   }
   return v8_isolate;
@@ -6640,6 +7308,17 @@ void Isolate::Enter() {
 }
 
 
+IsolateTemplate::IsolateTemplate(const Isolate::CreateParams& params,
+                                 int pool_size)
+    : impl_(new i::IsolateTemplate(params, pool_size)) {}
+
+
+IsolateTemplate::~IsolateTemplate() { delete impl_; }
+
+
+Isolate* IsolateTemplate::NewIsolate() { return impl_->NewIsolate(); }
+
+
 void Isolate::Exit() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   isolate->Exit();
@@ -6719,6 +7398,210 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
 }
 
 
+bool Isolate::GetGCStatistics(GCStatistics* gc_statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!isolate->IsInitialized()) return false;
+  return isolate->heap()->tracer()->GetStatistics(gc_statistics);
+}
+
+
+size_t Isolate::NumberOfHistogramTimers() {
+  return i::Counters::kNumberOfHistogramTimers;
+}
+
+
+bool Isolate::GetHistogramTimerStatistics(HistogramTimerStatistics* statistics,
+                                          size_t index) {
+  if (index >= i::Counters::kNumberOfHistogramTimers) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::HistogramTimer* timer =
+      isolate->counters()->histogram_timer(static_cast<int>(index));
+  i::HdrHistogram* histogram = timer->native_histogram();
+  statistics->name_ = timer->name();
+  statistics->count_ = histogram->count();
+  statistics->p50_ = histogram->Percentile(50);
+  statistics->p99_ = histogram->Percentile(99);
+  statistics->p999_ = histogram->Percentile(99.9);
+  statistics->max_ = histogram->max();
+  return true;
+}
+
+
+static bool GetBasicBlockProfilerKey(i::Handle<i::JSFunction> function,
+                                     int* script_id, int* position) {
+  i::SharedFunctionInfo* shared = function->shared();
+  if (!shared->script()->IsScript()) return false;
+  *script_id = i::Script::cast(shared->script())->id()->value();
+  *position = shared->start_position();
+  return true;
+}
+
+
+size_t Isolate::GetBasicBlockCounts(Handle<Function> function,
+                                    uint32_t* counts, size_t capacity) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::BasicBlockProfiler* profiler = isolate->basic_block_profiler();
+  int script_id, position;
+  if (profiler == NULL ||
+      !GetBasicBlockProfilerKey(Utils::OpenHandle(*function), &script_id,
+                                &position)) {
+    return 0;
+  }
+  i::BasicBlockProfiler::Data* data = profiler->FindData(script_id, position);
+  if (data == NULL) return 0;
+  size_t n_blocks = data->n_blocks();
+  for (size_t i = 0; i < n_blocks && i < capacity; i++) {
+    counts[i] = data->counts()[i];
+  }
+  return n_blocks;
+}
+
+
+void Isolate::ResetBasicBlockCounts(Handle<Function> function) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::BasicBlockProfiler* profiler = isolate->basic_block_profiler();
+  int script_id, position;
+  if (profiler == NULL ||
+      !GetBasicBlockProfilerKey(Utils::OpenHandle(*function), &script_id,
+                                &position)) {
+    return;
+  }
+  profiler->ResetCounts(script_id, position);
+}
+
+
+void Isolate::SetGCStatisticsCallback(GCStatisticsCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->tracer()->set_statistics_callback(callback);
+}
+
+
+void Isolate::SetNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                       void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetNearHeapLimitCallback(callback, data);
+}
+
+
+namespace {
+
+class ICSiteVisitorAdapter : public i::ICSiteVisitor {
+ public:
+  static const int kStateCount = InlineCacheSiteVisitor::kGeneric + 1;
+
+  // Forwards sites to {visitor} and counts them by state in {counts}, an
+  // array of kStateCount elements. Both can be NULL.
+  ICSiteVisitorAdapter(InlineCacheSiteVisitor* visitor, size_t* counts)
+      : visitor_(visitor), counts_(counts) {}
+
+  virtual void VisitSite(i::SharedFunctionInfo* shared, i::Code* target,
+                         int position) OVERRIDE {
+    InlineCacheSiteVisitor::State state = ToState(target->ic_state());
+    if (counts_ != NULL) counts_[state]++;
+    if (visitor_ == NULL) return;
+    int script_id = v8::UnboundScript::kNoScriptId;
+    if (shared->script()->IsScript()) {
+      script_id = i::Script::cast(shared->script())->id()->value();
+    }
+    visitor_->VisitInlineCacheSite(ToKind(target->kind()), state, script_id,
+                                   position);
+  }
+
+ private:
+  static InlineCacheSiteVisitor::Kind ToKind(i::Code::Kind kind) {
+    switch (kind) {
+      case i::Code::LOAD_IC:
+        return InlineCacheSiteVisitor::kLoad;
+      case i::Code::KEYED_LOAD_IC:
+        return InlineCacheSiteVisitor::kKeyedLoad;
+      case i::Code::STORE_IC:
+        return InlineCacheSiteVisitor::kStore;
+      case i::Code::KEYED_STORE_IC:
+        return InlineCacheSiteVisitor::kKeyedStore;
+      case i::Code::COMPARE_IC:
+      case i::Code::COMPARE_NIL_IC:
+        return InlineCacheSiteVisitor::kCompare;
+      case i::Code::BINARY_OP_IC:
+        return InlineCacheSiteVisitor::kBinaryOperation;
+      default:
+        return InlineCacheSiteVisitor::kOtherKind;
+    }
+  }
+
+  static InlineCacheSiteVisitor::State ToState(i::InlineCacheState state) {
+    switch (state) {
+      case i::UNINITIALIZED:
+        return InlineCacheSiteVisitor::kUninitialized;
+      case i::PREMONOMORPHIC:
+        return InlineCacheSiteVisitor::kPremonomorphic;
+      case i::MONOMORPHIC:
+      case i::PROTOTYPE_FAILURE:
+        return InlineCacheSiteVisitor::kMonomorphic;
+      case i::POLYMORPHIC:
+        return InlineCacheSiteVisitor::kPolymorphic;
+      case i::MEGAMORPHIC:
+        return InlineCacheSiteVisitor::kMegamorphic;
+      case i::GENERIC:
+        return InlineCacheSiteVisitor::kGeneric;
+      case i::DEBUG_STUB:
+      case i::DEFAULT:
+        break;
+    }
+    UNREACHABLE();
+    return InlineCacheSiteVisitor::kUninitialized;
+  }
+
+  InlineCacheSiteVisitor* visitor_;
+  size_t* counts_;
+};
+
+}  // namespace
+
+
+void Isolate::GetInlineCacheStatistics(InlineCacheStatistics* statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  size_t counts[ICSiteVisitorAdapter::kStateCount] = {0};
+  if (isolate->IsInitialized()) {
+    ICSiteVisitorAdapter adapter(NULL, counts);
+    i::IC::VisitSites(isolate, &adapter);
+  }
+  statistics->uninitialized_sites_ =
+      counts[InlineCacheSiteVisitor::kUninitialized];
+  statistics->premonomorphic_sites_ =
+      counts[InlineCacheSiteVisitor::kPremonomorphic];
+  statistics->monomorphic_sites_ = counts[InlineCacheSiteVisitor::kMonomorphic];
+  statistics->polymorphic_sites_ = counts[InlineCacheSiteVisitor::kPolymorphic];
+  statistics->megamorphic_sites_ = counts[InlineCacheSiteVisitor::kMegamorphic];
+  statistics->generic_sites_ = counts[InlineCacheSiteVisitor::kGeneric];
+}
+
+
+void Isolate::VisitRuntimeCallStats(RuntimeCallStatsVisitor* visitor) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::RuntimeCallStats* stats = isolate->counters()->runtime_call_stats();
+  for (int index = 0; index < i::RuntimeCallStats::kMaxCounters; index++) {
+    const i::RuntimeCallStats::Counter* counter = stats->counter(index);
+    if (counter == NULL || counter->count == 0) continue;
+    visitor->VisitRuntimeCallCounter(counter->name, counter->count,
+                                     counter->time.InMicroseconds());
+  }
+}
+
+
+void Isolate::ResetRuntimeCallStats() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->counters()->runtime_call_stats()->Reset();
+}
+
+
+void Isolate::VisitInlineCacheSites(InlineCacheSiteVisitor* visitor) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!isolate->IsInitialized()) return;
+  ICSiteVisitorAdapter adapter(visitor, NULL);
+  i::IC::VisitSites(isolate, &adapter);
+}
+
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
@@ -6755,6 +7638,12 @@ void Isolate::SetPromiseRejectCallback(PromiseRejectCallback callback) {
 }
 
 
+void Isolate::SetDeoptimizationCallback(DeoptimizationCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->set_deoptimization_callback(callback);
+}
+
+
 void Isolate::RunMicrotasks() {
   reinterpret_cast<i::Isolate*>(this)->RunMicrotasks();
 }
@@ -6826,6 +7715,15 @@ bool v8::Isolate::IdleNotification(int idle_time_in_ms) {
 }
 
 
+bool v8::Isolate::IdleNotificationDeadline(double deadline_in_seconds) {
+  // Returning true tells the caller that it need not
+  // continue to call IdleNotification.
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!i::FLAG_use_idle_notification) return true;
+  return isolate->heap()->IdleNotificationDeadline(deadline_in_seconds);
+}
+
+
 void v8::Isolate::LowMemoryNotification() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   {
@@ -6833,6 +7731,7 @@ void v8::Isolate::LowMemoryNotification() {
         isolate->counters()->gc_low_memory_notification());
     isolate->heap()->CollectAllAvailableGarbage("low memory notification");
   }
+  isolate->zone_segment_pool()->ReleaseAll();
 }
 
 
@@ -7206,6 +8105,11 @@ void CpuProfiler::SetSamplingInterval(int us) {
 }
 
 
+void CpuProfiler::SetCpuTimeSampling(bool enable) {
+  reinterpret_cast<i::CpuProfiler*>(this)->set_cpu_time_sampling(enable);
+}
+
+
 void CpuProfiler::StartProfiling(Handle<String> title, bool record_samples) {
   reinterpret_cast<i::CpuProfiler*>(this)->StartProfiling(
       *Utils::OpenHandle(*title), record_samples);
@@ -7229,6 +8133,25 @@ const CpuProfile* CpuProfiler::StopCpuProfiling(Handle<String> title) {
 }
 
 
+void CpuProfiler::StartContinuousProfiling(int max_stacks) {
+  Utils::ApiCheck(max_stacks > 0,
+                  "v8::CpuProfiler::StartContinuousProfiling",
+                  "At least one stack must fit");
+  reinterpret_cast<i::CpuProfiler*>(this)->StartContinuousProfiling(
+      max_stacks);
+}
+
+
+void CpuProfiler::DrainContinuousProfile(ContinuousProfileVisitor* visitor) {
+  reinterpret_cast<i::CpuProfiler*>(this)->DrainContinuousProfile(visitor);
+}
+
+
+void CpuProfiler::StopContinuousProfiling() {
+  reinterpret_cast<i::CpuProfiler*>(this)->StopContinuousProfiling();
+}
+
+
 void CpuProfiler::SetIdle(bool is_idle) {
   i::Isolate* isolate = reinterpret_cast<i::CpuProfiler*>(this)->isolate();
   v8::StateTag state = isolate->current_vm_state();
@@ -7441,6 +8364,18 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
 }
 
 
+bool HeapProfiler::StreamHeapSnapshot(OutputStream* stream,
+                                      Handle<String> title,
+                                      ActivityControl* control,
+                                      ObjectNameResolver* resolver) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapProfiler::StreamHeapSnapshot",
+                  "Invalid stream chunk size");
+  return reinterpret_cast<i::HeapProfiler*>(this)->StreamSnapshot(
+      *Utils::OpenHandle(*title), stream, control, resolver);
+}
+
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -7452,6 +8387,27 @@ void HeapProfiler::StopTrackingHeapObjects() {
 }
 
 
+void HeapProfiler::StartSamplingHeapProfiler(uint64_t sample_interval) {
+  Utils::ApiCheck(sample_interval > 0,
+                  "v8::HeapProfiler::StartSamplingHeapProfiler",
+                  "Sample interval must be positive");
+  reinterpret_cast<i::HeapProfiler*>(this)->StartSamplingHeapProfiler(
+      static_cast<intptr_t>(sample_interval));
+}
+
+
+void HeapProfiler::GetSampledAllocations(SampledAllocationVisitor* visitor) {
+  i::SamplingHeapProfiler* profiler =
+      reinterpret_cast<i::HeapProfiler*>(this)->sampling_heap_profiler();
+  if (profiler != NULL) profiler->VisitSamples(visitor);
+}
+
+
+void HeapProfiler::StopSamplingHeapProfiler() {
+  reinterpret_cast<i::HeapProfiler*>(this)->StopSamplingHeapProfiler();
+}
+
+
 SnapshotObjectId HeapProfiler::GetHeapStats(OutputStream* stream) {
   return reinterpret_cast<i::HeapProfiler*>(this)->PushHeapObjectsStats(stream);
 }
@@ -499,12 +499,12 @@ class HandleScopeImplementer {
         blocks_(0),
         entered_contexts_(0),
         saved_contexts_(0),
-        spare_(NULL),
+        spare_blocks_(0),
         call_depth_(0),
         last_handle_before_deferred_block_(NULL) { }
 
   ~HandleScopeImplementer() {
-    DeleteArray(spare_);
+    DeleteSpareBlocks();
   }
 
   // Threading support for handle data.
@@ -537,21 +537,38 @@ class HandleScopeImplementer {
   inline Context* RestoreContext();
   inline bool HasSavedContexts();
 
+  // True if the current thread has handle blocks, entered or saved contexts
+  // or API calls in progress, i.e. state that has to be archived when the
+  // thread gives up the isolate.
+  bool HasThreadState() const {
+    return !blocks_.is_empty() || !entered_contexts_.is_empty() ||
+           !saved_contexts_.is_empty() || call_depth_ != 0 ||
+           last_handle_before_deferred_block_ != NULL;
+  }
+
   inline List<internal::Object**>* blocks() { return &blocks_; }
   Isolate* isolate() const { return isolate_; }
 
+  // Keeps up to --handle-block-pool-size unused blocks for reuse, so that
+  // scopes that repeatedly grow past a block boundary do not go through
+  // malloc every time.
   void ReturnBlock(Object** block) {
     DCHECK(block != NULL);
-    if (spare_ != NULL) DeleteArray(spare_);
-    spare_ = block;
+    if (spare_blocks_.length() < FLAG_handle_block_pool_size) {
+      spare_blocks_.Add(block);
+    } else {
+      DeleteArray(block);
+    }
   }
 
+  int spare_block_count() const { return spare_blocks_.length(); }
+
  private:
   void ResetAfterArchive() {
     blocks_.Initialize(0);
     entered_contexts_.Initialize(0);
     saved_contexts_.Initialize(0);
-    spare_ = NULL;
+    spare_blocks_.Initialize(0);
     last_handle_before_deferred_block_ = NULL;
     call_depth_ = 0;
   }
@@ -563,13 +580,15 @@ class HandleScopeImplementer {
     blocks_.Free();
     entered_contexts_.Free();
     saved_contexts_.Free();
-    if (spare_ != NULL) {
-      DeleteArray(spare_);
-      spare_ = NULL;
-    }
+    DeleteSpareBlocks();
+    spare_blocks_.Free();
     DCHECK(call_depth_ == 0);
   }
 
+  void DeleteSpareBlocks() {
+    while (!spare_blocks_.is_empty()) DeleteArray(spare_blocks_.RemoveLast());
+  }
+
   void BeginDeferredScope();
   DeferredHandles* Detach(Object** prev_limit);
 
@@ -579,7 +598,7 @@ class HandleScopeImplementer {
   List<Context*> entered_contexts_;
   // Used as a stack to keep track of saved contexts.
   List<Context*> saved_contexts_;
-  Object** spare_;
+  List<internal::Object**> spare_blocks_;
   int call_depth_;
   Object** last_handle_before_deferred_block_;
   // This is only used for threading support.
@@ -637,11 +656,8 @@ Handle<Context> HandleScopeImplementer::LastEnteredContext() {
 
 // If there's a spare block, use it for growing the current scope.
 internal::Object** HandleScopeImplementer::GetSpareOrNewBlock() {
-  internal::Object** block = (spare_ != NULL) ?
-      spare_ :
-      NewArray<internal::Object*>(kHandleBlockSize);
-  spare_ = NULL;
-  return block;
+  if (!spare_blocks_.is_empty()) return spare_blocks_.RemoveLast();
+  return NewArray<internal::Object*>(kHandleBlockSize);
 }
 
 
@@ -649,7 +665,6 @@ void HandleScopeImplementer::DeleteExtensions(internal::Object** prev_limit) {
   while (!blocks_.is_empty()) {
     internal::Object** block_start = blocks_.last();
     internal::Object** block_limit = block_start + kHandleBlockSize;
-#ifdef DEBUG
     // SealHandleScope may make the prev_limit to point inside the block.
     if (block_start <= prev_limit && prev_limit <= block_limit) {
 #ifdef ENABLE_HANDLE_ZAPPING
@@ -657,18 +672,12 @@ void HandleScopeImplementer::DeleteExtensions(internal::Object** prev_limit) {
 #endif
       break;
     }
-#else
-    if (prev_limit == block_limit) break;
-#endif
 
     blocks_.RemoveLast();
 #ifdef ENABLE_HANDLE_ZAPPING
     internal::HandleScope::ZapRange(block_start, block_limit);
 #endif
-    if (spare_ != NULL) {
-      DeleteArray(spare_);
-    }
-    spare_ = block_start;
+    ReturnBlock(block_start);
   }
   DCHECK((blocks_.is_empty() && prev_limit == NULL) ||
          (!blocks_.is_empty() && prev_limit != NULL));
@@ -285,8 +285,10 @@ Object* Name(int args_length, Object** args_object, Isolate* isolate)
 
 #define RUNTIME_FUNCTION_RETURNS_TYPE(Type, Name)                        \
 static INLINE(Type __RT_impl_##Name(Arguments args, Isolate* isolate));  \
+static RuntimeCallCounterId __RT_counter_##Name = {#Name, 0};           \
 Type Name(int args_length, Object** args_object, Isolate* isolate) {     \
   CLOBBER_DOUBLE_REGISTERS();                                            \
+  RuntimeCallTimerScope timer(isolate, &__RT_counter_##Name);            \
   Arguments args(args_length, args_object);                              \
   return __RT_impl_##Name(args, isolate);                                \
 }                                                                        \
@@ -3898,6 +3898,9 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ mov(r1, result_register());
   ParameterCount count(arg_count);
   __ InvokeFunction(r1, count, CALL_FUNCTION, NullCallWrapper());
+  // The return site of an inlined target, see
+  // HOptimizedGraphBuilder::GenerateCallFunction.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
   __ ldr(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
@@ -4713,6 +4716,13 @@ void FullCodeGenerator::EmitLiteralCompareTypeof(Expression* expr,
     __ JumpIfSmi(r0, if_false);
     __ CompareObjectType(r0, r0, r1, SYMBOL_TYPE);
     Split(eq, if_true, if_false, fall_through);
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)   \
+  } else if (String::Equals(check, factory->type##_string())) { \
+    __ JumpIfSmi(r0, if_false);                                 \
+    __ CompareObjectType(r0, r0, r1, TYPE##_TYPE);              \
+    Split(eq, if_true, if_false, fall_through);
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
   } else if (String::Equals(check, factory->boolean_string())) {
     __ CompareRoot(r0, Heap::kTrueValueRootIndex);
     __ b(eq, if_true);
@@ -667,6 +667,25 @@ LInstruction* LChunkBuilder::DoEnvironmentMarker(HEnvironmentMarker* instr) {
 }
 
 
+// Try-catch statements are only optimized on x64.
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoStoreCatchSlot(HStoreCatchSlot* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoDeoptimize(HDeoptimize* instr) {
   return AssignEnvironment(new(zone()) LDeoptimize);
 }
@@ -1232,6 +1251,15 @@ LInstruction* LChunkBuilder::DoCallNewArray(HCallNewArray* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  // Only the x64 backend implements fast API calls, see
+  // HOptimizedGraphBuilder::TryInlineFastApiCall.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoCallFunction(HCallFunction* instr) {
   LOperand* context = UseFixed(instr->context(), cp);
   LOperand* function = UseFixed(instr->function(), r1);
@@ -302,8 +302,6 @@ bool Operand::NeedsRelocation(const Assembler* assembler) const {
 void ConstPool::RecordEntry(intptr_t data,
                             RelocInfo::Mode mode) {
   DCHECK(mode != RelocInfo::COMMENT &&
-         mode != RelocInfo::POSITION &&
-         mode != RelocInfo::STATEMENT_POSITION &&
          mode != RelocInfo::CONST_POOL &&
          mode != RelocInfo::VENEER_POOL &&
          mode != RelocInfo::CODE_AGE_SEQUENCE);
@@ -331,6 +329,18 @@ void ConstPool::RecordEntry(intptr_t data,
 }
 
 
+int ConstPool::EmittedEntryOffset(intptr_t data, RelocInfo::Mode mode) {
+  if (!CanBeShared(mode)) return -1;
+  std::map<uint64_t, int>::const_iterator it =
+      emitted_entries_.find(static_cast<uint64_t>(data));
+  if (it == emitted_entries_.end()) return -1;
+  // Literal loads reach kMaxLoadLiteralRange bytes backwards.
+  int distance = assm_->pc_offset() - it->second;
+  if (distance >= static_cast<int>(kMaxLoadLiteralRange)) return -1;
+  return it->second;
+}
+
+
 int ConstPool::DistanceToFirstUse() {
   DCHECK(first_use_ >= 0);
   return assm_->pc_offset() - first_use_;
@@ -438,6 +448,7 @@ void ConstPool::Clear() {
   shared_entries_.clear();
   shared_entries_count = 0;
   unique_entries_.clear();
+  emitted_entries_.clear();
   first_use_ = -1;
 }
 
@@ -505,6 +516,18 @@ void ConstPool::EmitGuard() {
 void ConstPool::EmitEntries() {
   DCHECK(IsAligned(assm_->pc_offset(), 8));
 
+  // Forget the entries of previous pools which are out of range from here.
+  int min_reachable_offset =
+      assm_->pc_offset() - static_cast<int>(kMaxLoadLiteralRange);
+  std::map<uint64_t, int>::iterator emitted_it = emitted_entries_.begin();
+  while (emitted_it != emitted_entries_.end()) {
+    if (emitted_it->second <= min_reachable_offset) {
+      emitted_entries_.erase(emitted_it++);
+    } else {
+      ++emitted_it;
+    }
+  }
+
   typedef std::multimap<uint64_t, int>::const_iterator SharedEntriesIterator;
   SharedEntriesIterator value_it;
   // Iterate through the keys (constant pool values).
@@ -523,6 +546,7 @@ void ConstPool::EmitEntries() {
       DCHECK(instr->IsLdrLiteral() && instr->ImmLLiteral() == 0);
       instr->SetImmPCOffsetTarget(assm_->pc());
     }
+    emitted_entries_[data] = assm_->pc_offset();
     assm_->dc64(data);
   }
   shared_entries_.clear();
@@ -1715,6 +1739,15 @@ void Assembler::ldr(const CPURegister& rt, const Immediate& imm) {
   // Currently we only support 64-bit literals.
   DCHECK(rt.Is64Bits());
 
+  int entry_offset = constpool_.EmittedEntryOffset(imm.value(), imm.rmode());
+  if (entry_offset >= 0) {
+    // The value is in a pool emitted earlier, load it from there.
+    BlockConstPoolFor(1);
+    WriteRelocInfo(imm.rmode(), imm.value());
+    ldr_pcrel(rt, (entry_offset - pc_offset()) >> kLoadLiteralScaleLog2);
+    return;
+  }
+
   RecordRelocInfo(imm.rmode(), imm.value());
   BlockConstPoolFor(1);
   // The load will be patched when the constpool is emitted, patching code
@@ -2829,8 +2862,6 @@ void Assembler::GrowBuffer() {
 
 
 void Assembler::RecordRelocInfo(RelocInfo::Mode rmode, intptr_t data) {
-  // We do not try to reuse pool constants.
-  RelocInfo rinfo(reinterpret_cast<byte*>(pc_), rmode, data, NULL);
   if (((rmode >= RelocInfo::JS_RETURN) &&
        (rmode <= RelocInfo::DEBUG_BREAK_SLOT)) ||
       (rmode == RelocInfo::CONST_POOL) ||
@@ -2839,7 +2870,6 @@ void Assembler::RecordRelocInfo(RelocInfo::Mode rmode, intptr_t data) {
     DCHECK(RelocInfo::IsDebugBreakSlot(rmode)
            || RelocInfo::IsJSReturn(rmode)
            || RelocInfo::IsComment(rmode)
-           || RelocInfo::IsPosition(rmode)
            || RelocInfo::IsConstPool(rmode)
            || RelocInfo::IsVeneerPool(rmode));
     // These modes do not need an entry in the constant pool.
@@ -2850,6 +2880,12 @@ void Assembler::RecordRelocInfo(RelocInfo::Mode rmode, intptr_t data) {
     BlockConstPoolFor(1);
   }
 
+  WriteRelocInfo(rmode, data);
+}
+
+
+void Assembler::WriteRelocInfo(RelocInfo::Mode rmode, intptr_t data) {
+  RelocInfo rinfo(reinterpret_cast<byte*>(pc_), rmode, data, NULL);
   if (!RelocInfo::IsNone(rmode)) {
     // Don't record external references unless the heap will be serialized.
     if (rmode == RelocInfo::EXTERNAL_REFERENCE &&
@@ -2905,10 +2941,14 @@ void Assembler::CheckConstPool(bool force_emit, bool require_jump) {
   //  * the distance to the first instruction accessing the constant pool is
   //    kApproxMaxDistToConstPool or more.
   //  * the number of entries in the pool is kApproxMaxPoolEntryCount or more.
+  //  * no branch over the pool is needed and the distance to the first use is
+  //    kOpportunityDistToConstPool or more.
   int dist = constpool_.DistanceToFirstUse();
   int count = constpool_.EntryCount();
+  int max_dist = require_jump ? kApproxMaxDistToConstPool
+                              : kOpportunityDistToConstPool;
   if (!force_emit &&
-      (dist < kApproxMaxDistToConstPool) &&
+      (dist < max_dist) &&
       (count < kApproxMaxPoolEntryCount)) {
     return;
   }
@@ -762,6 +762,9 @@ class ConstPool {
         first_use_(-1),
         shared_entries_count(0) {}
   void RecordEntry(intptr_t data, RelocInfo::Mode mode);
+  // Pc offset of the entry holding data in a pool emitted earlier, if a load
+  // at the current pc can reach it and may share it. Otherwise return -1.
+  int EmittedEntryOffset(intptr_t data, RelocInfo::Mode mode);
   int EntryCount() const {
     return shared_entries_count + unique_entries_.size();
   }
@@ -801,6 +804,9 @@ class ConstPool {
   int shared_entries_count;
   // values, pc offset of entries which cannot be shared.
   std::vector<std::pair<uint64_t, int> > unique_entries_;
+  // values, pc offset of the latest emitted slot of entries which can be
+  // shared, for loads following the pool.
+  std::map<uint64_t, int> emitted_entries_;
 };
 
 
@@ -864,6 +870,8 @@ class Assembler : public AssemblerBase {
 
   // Record relocation information for current pc_.
   void RecordRelocInfo(RelocInfo::Mode rmode, intptr_t data = 0);
+  // Write relocation information for current pc_, without a pool entry.
+  void WriteRelocInfo(RelocInfo::Mode rmode, intptr_t data);
 
   // Return the address in the constant pool of the code target address used by
   // the branch/call instruction at pc.
@@ -1886,7 +1894,10 @@ class Assembler : public AssemblerBase {
     DISALLOW_IMPLICIT_CONSTRUCTORS(BlockConstPoolScope);
   };
 
-  // Check if is time to emit a constant pool.
+  // Check if is time to emit a constant pool. Callers which know that no
+  // branch over the pool is needed, i.e. that the current pc cannot be reached
+  // by falling through, pass require_jump == false. Pools are emitted earlier
+  // at such points, which saves the branch.
   void CheckConstPool(bool force_emit, bool require_jump);
 
   // Allocate a constant pool of the correct size for the generated code.
@@ -2119,7 +2130,10 @@ class Assembler : public AssemblerBase {
   //  * the numbers of entries in the pool is above a pre-defined size or
   //  * code generation is finished
   // If a pool needs to be emitted before code generation is finished a branch
-  // over the emitted pool will be inserted.
+  // over the emitted pool will be inserted, unless the pool is emitted after
+  // an unconditional branch.
+  // Entries which can be shared are shared within a pool, and loads after a
+  // pool reuse its entries while they are in range.
 
   // Constants in the pool may be addresses of functions that gets relocated;
   // if so, a relocation info entry is associated to the constant pool entry.
@@ -2134,7 +2148,12 @@ class Assembler : public AssemblerBase {
   // are accessed with pc relative load therefore this cannot be more than
   // 1 * MB. Since constant pool emission checks are interval based this value
   // is an approximation.
-  static const int kApproxMaxDistToConstPool = 64 * KB;
+  static const int kApproxMaxDistToConstPool = 128 * KB;
+
+  // Distance to first use after which a pool is emitted where no branch over
+  // it is needed, e.g. after an unconditional branch. Pools are usually placed
+  // at such points before kApproxMaxDistToConstPool is reached.
+  static const int kOpportunityDistToConstPool = 64 * KB;
 
   // Number of pool entries after which a pool will be emitted. Since constant
   // pool emission checks are interval based this value is an approximation.
@@ -3583,6 +3583,9 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ Mov(x1, x0);
   ParameterCount count(arg_count);
   __ InvokeFunction(x1, count, CALL_FUNCTION, NullCallWrapper());
+  // The return site of an inlined target, see
+  // HOptimizedGraphBuilder::GenerateCallFunction.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
   __ Ldr(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   __ B(&done);
 
@@ -4380,6 +4383,14 @@ void FullCodeGenerator::EmitLiteralCompareTypeof(Expression* expr,
     __ JumpIfSmi(x0, if_false);
     __ CompareObjectType(x0, x0, x1, SYMBOL_TYPE);
     Split(eq, if_true, if_false, fall_through);
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)           \
+  } else if (String::Equals(check, factory->type##_string())) {         \
+    ASM_LOCATION("FullCodeGenerator::EmitLiteralCompareTypeof " #type); \
+    __ JumpIfSmi(x0, if_false);                                         \
+    __ CompareObjectType(x0, x0, x1, TYPE##_TYPE);                      \
+    Split(eq, if_true, if_false, fall_through);
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
   } else if (String::Equals(check, factory->boolean_string())) {
     ASM_LOCATION("FullCodeGenerator::EmitLiteralCompareTypeof boolean_string");
     __ JumpIfRoot(x0, Heap::kTrueValueRootIndex, if_true);
@@ -1050,6 +1050,15 @@ LInstruction* LChunkBuilder::DoCallWithDescriptor(
 }
 
 
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  // Only the x64 backend implements fast API calls, see
+  // HOptimizedGraphBuilder::TryInlineFastApiCall.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoCallFunction(HCallFunction* instr) {
   LOperand* context = UseFixed(instr->context(), cp);
   LOperand* function = UseFixed(instr->function(), x1);
@@ -1484,6 +1493,25 @@ LInstruction* LChunkBuilder::DoEnvironmentMarker(HEnvironmentMarker* instr) {
 }
 
 
+// Try-catch statements are only optimized on x64.
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoStoreCatchSlot(HStoreCatchSlot* instr) {
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoForceRepresentation(
     HForceRepresentation* instr) {
   // All HForceRepresentation instructions should be eliminated in the
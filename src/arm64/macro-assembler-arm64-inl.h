@@ -331,6 +331,7 @@ void MacroAssembler::Asr(const Register& rd,
 void MacroAssembler::B(Label* label) {
   b(label);
   CheckVeneerPool(false, false);
+  CheckConstPool(false, false);
 }
 
 
@@ -1003,6 +1004,7 @@ void MacroAssembler::Ret(const Register& xn) {
   DCHECK(!xn.IsZero());
   ret(xn);
   CheckVeneerPool(false, false);
+  CheckConstPool(false, false);
 }
 
 
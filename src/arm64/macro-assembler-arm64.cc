@@ -185,6 +185,16 @@ void MacroAssembler::Mov(const Register& rd, uint64_t imm) {
   if (!TryOneInstrMoveImmediate(rd, imm)) {
     unsigned reg_size = rd.SizeInBits();
 
+    // An immediate without any 0x0000 or 0xffff halfword takes four move
+    // instructions. A literal load is one instruction and an eight byte pool
+    // entry, which loads of the same value share.
+    if (FLAG_enable_literal_moves && rd.Is64Bits() && !rd.IsSP() &&
+        (CountClearHalfWords(imm, reg_size) == 0) &&
+        (CountClearHalfWords(~imm, reg_size) == 0)) {
+      Ldr(rd, Immediate(imm));
+      return;
+    }
+
     // Generic immediate case. Imm will be represented by
     //   [imm3, imm2, imm1, imm0], where each imm is 16 bits.
     // A move-zero or move-inverted is generated for the first non-zero or
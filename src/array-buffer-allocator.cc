@@ -0,0 +1,162 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/array-buffer-allocator.h"
+
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+namespace internal {
+
+class PooledArrayBufferAllocator::ReleaseTask : public v8::Task {
+ public:
+  explicit ReleaseTask(PooledArrayBufferAllocator* allocator)
+      : allocator_(allocator) {}
+
+  virtual ~ReleaseTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    allocator_->ReleasePendingBlocks();
+    allocator_->release_task_semaphore_.Signal();
+  }
+
+  PooledArrayBufferAllocator* allocator_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReleaseTask);
+};
+
+
+PooledArrayBufferAllocator::PooledArrayBufferAllocator()
+    : release_task_pending_(false),
+      release_tasks_posted_(0),
+      release_task_semaphore_(0) {}
+
+
+PooledArrayBufferAllocator::~PooledArrayBufferAllocator() {
+  for (int i = 0; i < release_tasks_posted_; i++) {
+    release_task_semaphore_.Wait();
+  }
+  ReleasePendingBlocks();
+  for (int i = 0; i < kSizeClasses; i++) {
+    size_t size = MappedSizeFor(kMinPooledSize << i);
+    for (int j = 0; j < free_lists_[i].length(); j++) {
+      base::OS::Free(free_lists_[i][j], size);
+    }
+  }
+}
+
+
+int PooledArrayBufferAllocator::SizeClassFor(size_t length) {
+  DCHECK(length >= kMinPooledSize && length <= kMaxPooledSize);
+  int size_class = 0;
+  while ((kMinPooledSize << size_class) < length) size_class++;
+  return size_class;
+}
+
+
+size_t PooledArrayBufferAllocator::MappedSizeFor(size_t length) {
+  size_t size = length;
+  if (length <= kMaxPooledSize) size = kMinPooledSize << SizeClassFor(length);
+  return RoundUp(size, base::OS::AllocateAlignment());
+}
+
+
+void* PooledArrayBufferAllocator::Allocate(size_t length) {
+  if (length < kMinPooledSize) return calloc(length, 1);
+  return AllocateMapped(length, true);
+}
+
+
+void* PooledArrayBufferAllocator::AllocateUninitialized(size_t length) {
+  if (length < kMinPooledSize) return malloc(length);
+  return AllocateMapped(length, false);
+}
+
+
+void* PooledArrayBufferAllocator::AllocateMapped(size_t length,
+                                                 bool zero_initialize) {
+  size_t size = MappedSizeFor(length);
+  if (length <= kMaxPooledSize) {
+    void* data = NULL;
+    {
+      base::LockGuard<base::Mutex> lock_guard(&mutex_);
+      List<void*>& free_list = free_lists_[SizeClassFor(length)];
+      if (!free_list.is_empty()) data = free_list.RemoveLast();
+    }
+    if (data != NULL) {
+      // Only reused blocks need clearing, fresh mappings are zero already.
+      if (zero_initialize) memset(data, 0, length);
+      return data;
+    }
+  }
+  size_t allocated = 0;
+  void* data = base::OS::Allocate(size, &allocated, false);
+  if (data == NULL) return NULL;
+  DCHECK(allocated == size);
+  return data;
+}
+
+
+void PooledArrayBufferAllocator::Free(void* data, size_t length) {
+  if (length < kMinPooledSize) {
+    free(data);
+    return;
+  }
+  Block block = { data, MappedSizeFor(length) };
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (length <= kMaxPooledSize) {
+    List<void*>& free_list = free_lists_[SizeClassFor(length)];
+    if (free_list.length() * block.size < kMaxPooledBytesPerSizeClass) {
+      free_list.Add(data);
+      return;
+    }
+  }
+  pending_release_.Add(block);
+  PostReleaseTaskIfNeeded();
+}
+
+
+void PooledArrayBufferAllocator::PostReleaseTaskIfNeeded() {
+  if (release_task_pending_) return;
+  // Huge blocks are returned to the OS soon, others wait for a full batch.
+  Block& last = pending_release_.last();
+  if (last.size <= kMaxPooledSize &&
+      pending_release_.length() < kReleaseBatchSize) {
+    return;
+  }
+  release_task_pending_ = true;
+  release_tasks_posted_++;
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new ReleaseTask(this), v8::Platform::kShortRunningTask);
+}
+
+
+void PooledArrayBufferAllocator::ReleasePendingBlocks() {
+  List<Block> blocks;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    blocks.AddAll(pending_release_);
+    pending_release_.Clear();
+    release_task_pending_ = false;
+  }
+  for (int i = 0; i < blocks.length(); i++) {
+    base::OS::Free(blocks[i].data, blocks[i].size);
+  }
+}
+
+
+size_t PooledArrayBufferAllocator::PooledBytes() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  size_t bytes = 0;
+  for (int i = 0; i < kSizeClasses; i++) {
+    bytes += free_lists_[i].length() * MappedSizeFor(kMinPooledSize << i);
+  }
+  return bytes;
+}
+
+} }  // namespace v8::internal
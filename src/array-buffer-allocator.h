@@ -0,0 +1,80 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_ARRAY_BUFFER_ALLOCATOR_H_
+#define V8_ARRAY_BUFFER_ALLOCATOR_H_
+
+#include "include/v8.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+// An ArrayBuffer allocator for embedders that create many short-lived
+// buffers. Small buffers come from malloc. Medium sized buffers are rounded
+// up to a power of two and are mapped directly from the OS so that fresh
+// pages are zeroed lazily by the kernel; freed buffers of each size class
+// are kept for reuse up to a per-class byte budget. Buffers that do not fit
+// the pool are unmapped in batches by a background task, so freeing them
+// from the main thread or from GC weak processing stays cheap.
+//
+// The allocator may be used from any thread. It must outlive the V8
+// platform's background tasks it posted, which the destructor waits for.
+class PooledArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+ public:
+  PooledArrayBufferAllocator();
+  virtual ~PooledArrayBufferAllocator();
+
+  virtual void* Allocate(size_t length) OVERRIDE;
+  virtual void* AllocateUninitialized(size_t length) OVERRIDE;
+  virtual void Free(void* data, size_t length) OVERRIDE;
+
+  // Returns the number of bytes held in the free lists for reuse.
+  size_t PooledBytes();
+
+  // Unmaps the blocks waiting for the background task right away.
+  void ReleasePendingBlocks();
+
+  static const int kMinPooledSizeLog2 = 12;
+  static const int kMaxPooledSizeLog2 = 20;
+  static const size_t kMinPooledSize = static_cast<size_t>(1)
+                                       << kMinPooledSizeLog2;
+  static const size_t kMaxPooledSize = static_cast<size_t>(1)
+                                       << kMaxPooledSizeLog2;
+  // Bytes every size class may keep in its free list.
+  static const size_t kMaxPooledBytesPerSizeClass = 8 * MB;
+  // Number of pending blocks that triggers a background release.
+  static const int kReleaseBatchSize = 16;
+
+ private:
+  class ReleaseTask;
+
+  struct Block {
+    void* data;
+    size_t size;
+  };
+
+  static const int kSizeClasses = kMaxPooledSizeLog2 - kMinPooledSizeLog2 + 1;
+
+  static int SizeClassFor(size_t length);
+  static size_t MappedSizeFor(size_t length);
+
+  void* AllocateMapped(size_t length, bool zero_initialize);
+  void PostReleaseTaskIfNeeded();
+
+  base::Mutex mutex_;
+  List<void*> free_lists_[kSizeClasses];
+  List<Block> pending_release_;
+  bool release_task_pending_;
+  int release_tasks_posted_;
+  base::Semaphore release_task_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(PooledArrayBufferAllocator);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_ARRAY_BUFFER_ALLOCATOR_H_
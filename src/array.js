@@ -834,10 +834,13 @@ function ArraySplice(start, delete_count) {
 function ArraySort(comparefn) {
   CHECK_OBJECT_COERCIBLE(this, "Array.prototype.sort");
 
-  // In-place QuickSort algorithm.
-  // For short (length <= 22) arrays, insertion sort is used for efficiency.
+  // In-place stable TimSort. Ascending runs, and strictly descending runs
+  // reversed in place, are extended to a minimum length by binary insertion
+  // sort and then merged, switching to galloping mode when one run keeps
+  // winning.
 
-  if (!IS_SPEC_FUNCTION(comparefn)) {
+  var has_comparefn = IS_SPEC_FUNCTION(comparefn);
+  if (!has_comparefn) {
     comparefn = function (x, y) {
       if (x === y) return 0;
       if (%_IsSmi(x) && %_IsSmi(y)) {
@@ -851,120 +854,372 @@ function ArraySort(comparefn) {
   }
   var receiver = %GetDefaultReceiver(comparefn);
 
-  var InsertionSort = function InsertionSort(a, from, to) {
-    for (var i = from + 1; i < to; i++) {
+  // Runs shorter than this are sorted by binary insertion sort alone.
+  var kMinMerge = 32;
+  // Number of consecutive wins of one run after which merging gallops.
+  var kMinGallop = 7;
+
+  var min_gallop = kMinGallop;
+  var run_base = new InternalArray();
+  var run_length = new InternalArray();
+  var stack_size = 0;
+
+  var BinaryInsertionSort = function BinaryInsertionSort(a, from, to, start) {
+    // Elements from..start are already sorted.
+    for (var i = start; i < to; i++) {
       var element = a[i];
-      for (var j = i - 1; j >= from; j--) {
-        var tmp = a[j];
-        var order = %_CallFunction(receiver, tmp, element, comparefn);
-        if (order > 0) {
-          a[j + 1] = tmp;
+      var left = from;
+      var right = i;
+      // Find the position after all elements not greater than element.
+      while (left < right) {
+        var mid = left + ((right - left) >> 1);
+        var order = %_CallFunction(receiver, element, a[mid], comparefn);
+        if (order < 0) {
+          right = mid;
         } else {
-          break;
+          left = mid + 1;
         }
       }
-      a[j + 1] = element;
+      for (var j = i; j > left; j--) {
+        a[j] = a[j - 1];
+      }
+      a[left] = element;
+    }
+  };
+
+  // Returns the length of the run starting at from. A strictly descending
+  // run is reversed, which keeps the sort stable.
+  var CountRunAndMakeAscending = function(a, from, to) {
+    var run_end = from + 1;
+    if (run_end == to) return 1;
+    var order = %_CallFunction(receiver, a[run_end], a[from], comparefn);
+    run_end++;
+    if (order < 0) {
+      while (run_end < to &&
+             %_CallFunction(receiver, a[run_end], a[run_end - 1],
+                            comparefn) < 0) {
+        run_end++;
+      }
+      for (var low = from, high = run_end - 1; low < high; low++, high--) {
+        var tmp = a[low];
+        a[low] = a[high];
+        a[high] = tmp;
+      }
+    } else {
+      while (run_end < to &&
+             %_CallFunction(receiver, a[run_end], a[run_end - 1],
+                            comparefn) >= 0) {
+        run_end++;
+      }
+    }
+    return run_end - from;
+  };
+
+  // Returns a run length between kMinMerge / 2 and kMinMerge such that
+  // length divided by it is a power of two or slightly less.
+  var MinRunLength = function(length) {
+    var r = 0;
+    while (length >= kMinMerge) {
+      r |= length & 1;
+      length >>= 1;
     }
+    return length + r;
   };
 
-  var GetThirdIndex = function(a, from, to) {
-    var t_array = [];
-    // Use both 'from' and 'to' to determine the pivot candidates.
-    var increment = 200 + ((to - from) & 15);
-    for (var i = from + 1, j = 0; i < to - 1; i += increment, j++) {
-      t_array[j] = [i, a[i]];
-    }
-    %_CallFunction(t_array, function(a, b) {
-      return %_CallFunction(receiver, a[1], b[1], comparefn);
-    }, ArraySort);
-    var third_index = t_array[t_array.length >> 1][0];
-    return third_index;
-  }
-
-  var QuickSort = function QuickSort(a, from, to) {
-    var third_index = 0;
-    while (true) {
-      // Insertion sort is faster for short arrays.
-      if (to - from <= 10) {
-        InsertionSort(a, from, to);
-        return;
+  // Returns the position in the sorted range a[base..base+length) before
+  // the leftmost element not less than key. The search starts at base+hint
+  // and gallops outwards before falling back to a binary search.
+  var GallopLeft = function(key, a, base, length, hint) {
+    var last_offset = 0;
+    var offset = 1;
+    var max_offset;
+    if (%_CallFunction(receiver, key, a[base + hint], comparefn) > 0) {
+      // a[base + hint] < key, so gallop to the right.
+      max_offset = length - hint;
+      while (offset < max_offset &&
+             %_CallFunction(receiver, key, a[base + hint + offset],
+                            comparefn) > 0) {
+        last_offset = offset;
+        offset = offset * 2 + 1;
+      }
+      if (offset > max_offset) offset = max_offset;
+      last_offset += hint;
+      offset += hint;
+    } else {
+      // key <= a[base + hint], so gallop to the left.
+      max_offset = hint + 1;
+      while (offset < max_offset &&
+             %_CallFunction(receiver, key, a[base + hint - offset],
+                            comparefn) <= 0) {
+        last_offset = offset;
+        offset = offset * 2 + 1;
       }
-      if (to - from > 1000) {
-        third_index = GetThirdIndex(a, from, to);
+      if (offset > max_offset) offset = max_offset;
+      var tmp = last_offset;
+      last_offset = hint - offset;
+      offset = hint - tmp;
+    }
+    // Now a[base + last_offset] < key <= a[base + offset].
+    last_offset++;
+    while (last_offset < offset) {
+      var mid = last_offset + ((offset - last_offset) >> 1);
+      if (%_CallFunction(receiver, key, a[base + mid], comparefn) > 0) {
+        last_offset = mid + 1;
       } else {
-        third_index = from + ((to - from) >> 1);
+        offset = mid;
+      }
+    }
+    return offset;
+  };
+
+  // Like GallopLeft, but returns the position after the rightmost element
+  // not greater than key.
+  var GallopRight = function(key, a, base, length, hint) {
+    var last_offset = 0;
+    var offset = 1;
+    var max_offset;
+    if (%_CallFunction(receiver, key, a[base + hint], comparefn) < 0) {
+      // key < a[base + hint], so gallop to the left.
+      max_offset = hint + 1;
+      while (offset < max_offset &&
+             %_CallFunction(receiver, key, a[base + hint - offset],
+                            comparefn) < 0) {
+        last_offset = offset;
+        offset = offset * 2 + 1;
+      }
+      if (offset > max_offset) offset = max_offset;
+      var tmp = last_offset;
+      last_offset = hint - offset;
+      offset = hint - tmp;
+    } else {
+      // a[base + hint] <= key, so gallop to the right.
+      max_offset = length - hint;
+      while (offset < max_offset &&
+             %_CallFunction(receiver, key, a[base + hint + offset],
+                            comparefn) >= 0) {
+        last_offset = offset;
+        offset = offset * 2 + 1;
       }
-      // Find a pivot as the median of first, last and middle element.
-      var v0 = a[from];
-      var v1 = a[to - 1];
-      var v2 = a[third_index];
-      var c01 = %_CallFunction(receiver, v0, v1, comparefn);
-      if (c01 > 0) {
-        // v1 < v0, so swap them.
-        var tmp = v0;
-        v0 = v1;
-        v1 = tmp;
-      } // v0 <= v1.
-      var c02 = %_CallFunction(receiver, v0, v2, comparefn);
-      if (c02 >= 0) {
-        // v2 <= v0 <= v1.
-        var tmp = v0;
-        v0 = v2;
-        v2 = v1;
-        v1 = tmp;
+      if (offset > max_offset) offset = max_offset;
+      last_offset += hint;
+      offset += hint;
+    }
+    // Now a[base + last_offset] <= key < a[base + offset].
+    last_offset++;
+    while (last_offset < offset) {
+      var mid = last_offset + ((offset - last_offset) >> 1);
+      if (%_CallFunction(receiver, key, a[base + mid], comparefn) < 0) {
+        offset = mid;
       } else {
-        // v0 <= v1 && v0 < v2
-        var c12 = %_CallFunction(receiver, v1, v2, comparefn);
-        if (c12 > 0) {
-          // v0 <= v2 < v1
-          var tmp = v1;
-          v1 = v2;
-          v2 = tmp;
-        }
+        last_offset = mid + 1;
       }
-      // v0 <= v1 <= v2
-      a[from] = v0;
-      a[to - 1] = v2;
-      var pivot = v1;
-      var low_end = from + 1;   // Upper bound of elements lower than pivot.
-      var high_start = to - 1;  // Lower bound of elements greater than pivot.
-      a[third_index] = a[low_end];
-      a[low_end] = pivot;
-
-      // From low_end to i are elements equal to pivot.
-      // From i to high_start are elements that haven't been compared yet.
-      partition: for (var i = low_end + 1; i < high_start; i++) {
-        var element = a[i];
-        var order = %_CallFunction(receiver, element, pivot, comparefn);
+    }
+    return offset;
+  };
+
+  // Merges the adjacent runs a[base1..base1+length1) and
+  // a[base2..base2+length2), where the first element of the second run is
+  // less than the first element of the first run, and the last element of
+  // the first run is greater than all elements of the second run. Only the
+  // shorter first run is copied out. Every element is written exactly once
+  // and never over an element that has not been read yet, so an
+  // inconsistent comparison function can only produce an unsorted result.
+  var MergeLow = function(a, base1, length1, base2, length2) {
+    var tmp = new InternalArray(length1);
+    for (var i = 0; i < length1; i++) {
+      tmp[i] = a[base1 + i];
+    }
+    var cursor1 = 0;
+    var cursor2 = base2;
+    var end2 = base2 + length2;
+    var dest = base1;
+    a[dest++] = a[cursor2++];
+    merge: while (cursor1 < length1 && cursor2 < end2) {
+      var count1 = 0;  // Number of times in a row that run 1 won.
+      var count2 = 0;  // Number of times in a row that run 2 won.
+      do {
+        var order = %_CallFunction(receiver, a[cursor2], tmp[cursor1],
+                                   comparefn);
         if (order < 0) {
-          a[i] = a[low_end];
-          a[low_end] = element;
-          low_end++;
-        } else if (order > 0) {
-          do {
-            high_start--;
-            if (high_start == i) break partition;
-            var top_elem = a[high_start];
-            order = %_CallFunction(receiver, top_elem, pivot, comparefn);
-          } while (order > 0);
-          a[i] = a[high_start];
-          a[high_start] = element;
-          if (order < 0) {
-            element = a[i];
-            a[i] = a[low_end];
-            a[low_end] = element;
-            low_end++;
-          }
+          a[dest++] = a[cursor2++];
+          count2++;
+          count1 = 0;
+          if (cursor2 == end2) break merge;
+        } else {
+          a[dest++] = tmp[cursor1++];
+          count1++;
+          count2 = 0;
+          if (cursor1 == length1) break merge;
         }
+      } while ((count1 | count2) < min_gallop);
+
+      // One run is winning consistently, so gallop until neither does.
+      do {
+        count1 = GallopRight(a[cursor2], tmp, cursor1, length1 - cursor1, 0);
+        for (var i = 0; i < count1; i++) {
+          a[dest++] = tmp[cursor1++];
+        }
+        if (cursor1 == length1) break merge;
+        a[dest++] = a[cursor2++];
+        if (cursor2 == end2) break merge;
+        count2 = GallopLeft(tmp[cursor1], a, cursor2, end2 - cursor2, 0);
+        for (var i = 0; i < count2; i++) {
+          a[dest++] = a[cursor2++];
+        }
+        if (cursor2 == end2) break merge;
+        a[dest++] = tmp[cursor1++];
+        if (cursor1 == length1) break merge;
+        min_gallop--;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      // Penalize leaving galloping mode.
+      if (min_gallop < 0) min_gallop = 0;
+      min_gallop += 2;
+    }
+    // The rest of run 2 is already in place.
+    while (cursor1 < length1) {
+      a[dest++] = tmp[cursor1++];
+    }
+  };
+
+  // Like MergeLow, but copies out the shorter second run and merges from
+  // the end.
+  var MergeHigh = function(a, base1, length1, base2, length2) {
+    var tmp = new InternalArray(length2);
+    for (var i = 0; i < length2; i++) {
+      tmp[i] = a[base2 + i];
+    }
+    var cursor1 = base1 + length1 - 1;
+    var cursor2 = length2 - 1;
+    var dest = base2 + length2 - 1;
+    a[dest--] = a[cursor1--];
+    merge: while (cursor1 >= base1 && cursor2 >= 0) {
+      var count1 = 0;  // Number of times in a row that run 1 won.
+      var count2 = 0;  // Number of times in a row that run 2 won.
+      do {
+        var order = %_CallFunction(receiver, tmp[cursor2], a[cursor1],
+                                   comparefn);
+        if (order < 0) {
+          a[dest--] = a[cursor1--];
+          count1++;
+          count2 = 0;
+          if (cursor1 < base1) break merge;
+        } else {
+          a[dest--] = tmp[cursor2--];
+          count2++;
+          count1 = 0;
+          if (cursor2 < 0) break merge;
+        }
+      } while ((count1 | count2) < min_gallop);
+
+      // One run is winning consistently, so gallop until neither does.
+      do {
+        count1 = cursor1 - base1 + 1 -
+            GallopRight(tmp[cursor2], a, base1, cursor1 - base1 + 1,
+                        cursor1 - base1);
+        for (var i = 0; i < count1; i++) {
+          a[dest--] = a[cursor1--];
+        }
+        if (cursor1 < base1) break merge;
+        a[dest--] = tmp[cursor2--];
+        if (cursor2 < 0) break merge;
+        count2 = cursor2 + 1 -
+            GallopLeft(a[cursor1], tmp, 0, cursor2 + 1, cursor2);
+        for (var i = 0; i < count2; i++) {
+          a[dest--] = tmp[cursor2--];
+        }
+        if (cursor2 < 0) break merge;
+        a[dest--] = a[cursor1--];
+        if (cursor1 < base1) break merge;
+        min_gallop--;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      // Penalize leaving galloping mode.
+      if (min_gallop < 0) min_gallop = 0;
+      min_gallop += 2;
+    }
+    // The rest of run 1 is already in place.
+    while (cursor2 >= 0) {
+      a[dest--] = tmp[cursor2--];
+    }
+  };
+
+  // Merges the runs at stack positions i and i + 1.
+  var MergeAt = function(a, i) {
+    var base1 = run_base[i];
+    var length1 = run_length[i];
+    var base2 = run_base[i + 1];
+    var length2 = run_length[i + 1];
+    run_length[i] = length1 + length2;
+    if (i == stack_size - 3) {
+      run_base[i + 1] = run_base[i + 2];
+      run_length[i + 1] = run_length[i + 2];
+    }
+    stack_size--;
+
+    // Elements of run 1 not greater than the first element of run 2, and
+    // elements of run 2 not less than the last element of run 1, are
+    // already in place.
+    var k = GallopRight(a[base2], a, base1, length1, 0);
+    base1 += k;
+    length1 -= k;
+    if (length1 == 0) return;
+    length2 = GallopLeft(a[base1 + length1 - 1], a, base2, length2,
+                         length2 - 1);
+    if (length2 == 0) return;
+    if (length1 <= length2) {
+      MergeLow(a, base1, length1, base2, length2);
+    } else {
+      MergeHigh(a, base1, length1, base2, length2);
+    }
+  };
+
+  // Merges runs until the run lengths on the stack decrease at least as
+  // fast as the Fibonacci numbers, which bounds the stack depth.
+  var MergeCollapse = function(a) {
+    while (stack_size > 1) {
+      var n = stack_size - 2;
+      if ((n > 0 && run_length[n - 1] <= run_length[n] + run_length[n + 1]) ||
+          (n > 1 && run_length[n - 2] <= run_length[n - 1] + run_length[n])) {
+        if (run_length[n - 1] < run_length[n + 1]) n--;
+      } else if (run_length[n] > run_length[n + 1]) {
+        break;
       }
-      if (to - high_start < low_end - from) {
-        QuickSort(a, high_start, to);
-        to = low_end;
-      } else {
-        QuickSort(a, from, low_end);
-        from = high_start;
-      }
+      MergeAt(a, n);
+    }
+  };
+
+  var MergeForceCollapse = function(a) {
+    while (stack_size > 1) {
+      var n = stack_size - 2;
+      if (n > 0 && run_length[n - 1] < run_length[n + 1]) n--;
+      MergeAt(a, n);
+    }
+  };
+
+  var TimSort = function TimSort(a, from, to) {
+    var remaining = to - from;
+    if (remaining < 2) return;
+    if (remaining < kMinMerge) {
+      var run = CountRunAndMakeAscending(a, from, to);
+      BinaryInsertionSort(a, from, to, from + run);
+      return;
     }
+    var min_run = MinRunLength(remaining);
+    var low = from;
+    do {
+      var run = CountRunAndMakeAscending(a, low, to);
+      if (run < min_run) {
+        var forced = remaining < min_run ? remaining : min_run;
+        BinaryInsertionSort(a, low, low + forced, low + run);
+        run = forced;
+      }
+      run_base[stack_size] = low;
+      run_length[stack_size] = run;
+      stack_size++;
+      MergeCollapse(a);
+      low += run;
+      remaining -= run;
+    } while (remaining != 0);
+    MergeForceCollapse(a);
   };
 
   // Copy elements in the range 0..length from obj's prototype chain
@@ -1107,7 +1362,11 @@ function ArraySort(comparefn) {
     num_non_undefined = SafeRemoveArrayHoles(this);
   }
 
-  QuickSort(this, 0, num_non_undefined);
+  // Smis compared by the default comparison function can be sorted natively,
+  // as no user code would be called.
+  if (has_comparefn || !%SortSmiElements(this, num_non_undefined)) {
+    TimSort(this, 0, num_non_undefined);
+  }
 
   if (!is_array && (num_non_undefined + 1 < max_prototype_element)) {
     // For compatibility with JSC, we shadow any elements in the prototype
@@ -1542,6 +1801,13 @@ function SetUpArray() {
 
   %FinishArrayPrototypeSetup($Array.prototype);
 
+  // Inline the higher-order builtins into optimized callers, so that known
+  // callbacks can be inlined into their loops in turn.
+  %SetInlineBuiltinFlag(ArrayFilter);
+  %SetInlineBuiltinFlag(ArrayForEach);
+  %SetInlineBuiltinFlag(ArrayMap);
+  %SetInlineBuiltinFlag(ArrayReduce);
+
   // The internal Array prototype doesn't need to be fancy, since it's never
   // exposed to user code.
   // Adding only the functions that are actually used.
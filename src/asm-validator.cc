@@ -0,0 +1,334 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/asm-validator.h"
+#include "src/scopes.h"
+
+namespace v8 {
+namespace internal {
+
+AsmValidator::AsmValidator(Zone* zone) : valid_(true) {
+  InitializeAstVisitor(zone);
+}
+
+
+bool AsmValidator::Validate(FunctionLiteral* function, Zone* zone) {
+  Scope* scope = function->scope();
+  if (!scope->asm_function()) return false;
+  if (scope->calls_eval() || scope->arguments() != NULL) return false;
+  AsmValidator validator(zone);
+  if (!validator.ValidateParameterAnnotations(function)) return false;
+  validator.VisitDeclarations(scope->declarations());
+  validator.VisitStatements(function->body());
+  return validator.valid_ && !validator.HasStackOverflow();
+}
+
+
+static bool IsNumberLiteral(Expression* expr) {
+  Literal* literal = expr->AsLiteral();
+  return literal != NULL && literal->raw_value()->IsNumber();
+}
+
+
+static bool IsNumberLiteral(Expression* expr, double value) {
+  return IsNumberLiteral(expr) &&
+         expr->AsLiteral()->raw_value()->AsNumber() == value;
+}
+
+
+static bool IsVariable(Expression* expr, Variable* var) {
+  VariableProxy* proxy = expr->AsVariableProxy();
+  return proxy != NULL && proxy->var() == var;
+}
+
+
+// Each parameter has to be annotated as "p = p|0" (int) or "p = +p"
+// (double), in order, at the start of the function body.
+bool AsmValidator::ValidateParameterAnnotations(FunctionLiteral* function) {
+  Scope* scope = function->scope();
+  ZoneList<Statement*>* body = function->body();
+  if (body->length() < scope->num_parameters()) return false;
+  for (int i = 0; i < scope->num_parameters(); ++i) {
+    Variable* parameter = scope->parameter(i);
+    ExpressionStatement* stmt = body->at(i)->AsExpressionStatement();
+    if (stmt == NULL) return false;
+    Assignment* assignment = stmt->expression()->AsAssignment();
+    if (assignment == NULL || assignment->op() != Token::ASSIGN ||
+        !IsVariable(assignment->target(), parameter)) {
+      return false;
+    }
+    // The parser desugars "+p" into "p*1".
+    BinaryOperation* value = assignment->value()->AsBinaryOperation();
+    if (value == NULL || !IsVariable(value->left(), parameter)) return false;
+    if (!(value->op() == Token::BIT_OR && IsNumberLiteral(value->right(), 0)) &&
+        !(value->op() == Token::MUL && IsNumberLiteral(value->right(), 1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void AsmValidator::VisitVariableDeclaration(VariableDeclaration* decl) {}
+
+
+void AsmValidator::VisitFunctionDeclaration(FunctionDeclaration* decl) {
+  Fail();
+}
+
+
+void AsmValidator::VisitModuleDeclaration(ModuleDeclaration* decl) { Fail(); }
+
+
+void AsmValidator::VisitImportDeclaration(ImportDeclaration* decl) { Fail(); }
+
+
+void AsmValidator::VisitExportDeclaration(ExportDeclaration* decl) { Fail(); }
+
+
+void AsmValidator::VisitModuleLiteral(ModuleLiteral* module) { Fail(); }
+
+
+void AsmValidator::VisitModuleVariable(ModuleVariable* module) { Fail(); }
+
+
+void AsmValidator::VisitModulePath(ModulePath* module) { Fail(); }
+
+
+void AsmValidator::VisitModuleUrl(ModuleUrl* module) { Fail(); }
+
+
+void AsmValidator::VisitBlock(Block* stmt) {
+  VisitStatements(stmt->statements());
+}
+
+
+void AsmValidator::VisitModuleStatement(ModuleStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitExpressionStatement(ExpressionStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void AsmValidator::VisitEmptyStatement(EmptyStatement* stmt) {}
+
+
+void AsmValidator::VisitIfStatement(IfStatement* stmt) {
+  Visit(stmt->condition());
+  Visit(stmt->then_statement());
+  Visit(stmt->else_statement());
+}
+
+
+void AsmValidator::VisitContinueStatement(ContinueStatement* stmt) {}
+
+
+void AsmValidator::VisitBreakStatement(BreakStatement* stmt) {}
+
+
+void AsmValidator::VisitReturnStatement(ReturnStatement* stmt) {
+  // A plain "return;" returns undefined.
+  Expression* value = stmt->expression();
+  if (value->IsUndefinedLiteral(zone()->isolate())) return;
+  Visit(value);
+}
+
+
+void AsmValidator::VisitWithStatement(WithStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitSwitchStatement(SwitchStatement* stmt) {
+  Visit(stmt->tag());
+  ZoneList<CaseClause*>* clauses = stmt->cases();
+  for (int i = 0; i < clauses->length(); ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (!clause->is_default() && !IsNumberLiteral(clause->label())) {
+      return Fail();
+    }
+    VisitStatements(clause->statements());
+  }
+}
+
+
+void AsmValidator::VisitCaseClause(CaseClause* clause) { UNREACHABLE(); }
+
+
+void AsmValidator::VisitDoWhileStatement(DoWhileStatement* stmt) {
+  Visit(stmt->body());
+  Visit(stmt->cond());
+}
+
+
+void AsmValidator::VisitWhileStatement(WhileStatement* stmt) {
+  Visit(stmt->cond());
+  Visit(stmt->body());
+}
+
+
+void AsmValidator::VisitForStatement(ForStatement* stmt) {
+  if (stmt->init() != NULL) Visit(stmt->init());
+  if (stmt->cond() != NULL) Visit(stmt->cond());
+  if (stmt->next() != NULL) Visit(stmt->next());
+  Visit(stmt->body());
+}
+
+
+void AsmValidator::VisitForInStatement(ForInStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitForOfStatement(ForOfStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitTryCatchStatement(TryCatchStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
+  Fail();
+}
+
+
+void AsmValidator::VisitDebuggerStatement(DebuggerStatement* stmt) { Fail(); }
+
+
+void AsmValidator::VisitFunctionLiteral(FunctionLiteral* expr) { Fail(); }
+
+
+void AsmValidator::VisitClassLiteral(ClassLiteral* expr) { Fail(); }
+
+
+void AsmValidator::VisitNativeFunctionLiteral(NativeFunctionLiteral* expr) {
+  Fail();
+}
+
+
+void AsmValidator::VisitConditional(Conditional* expr) {
+  Visit(expr->condition());
+  Visit(expr->then_expression());
+  Visit(expr->else_expression());
+}
+
+
+void AsmValidator::VisitVariableProxy(VariableProxy* expr) {
+  if (expr->var()->is_this() || expr->var()->is_arguments()) Fail();
+}
+
+
+void AsmValidator::VisitLiteral(Literal* expr) {
+  if (!IsNumberLiteral(expr)) Fail();
+}
+
+
+void AsmValidator::VisitRegExpLiteral(RegExpLiteral* expr) { Fail(); }
+
+
+void AsmValidator::VisitObjectLiteral(ObjectLiteral* expr) { Fail(); }
+
+
+void AsmValidator::VisitArrayLiteral(ArrayLiteral* expr) { Fail(); }
+
+
+void AsmValidator::VisitAssignment(Assignment* expr) {
+  // Compound assignments are not part of asm.js.
+  if (expr->op() != Token::ASSIGN && expr->op() != Token::INIT_VAR) {
+    return Fail();
+  }
+  Expression* target = expr->target();
+  if (target->AsVariableProxy() == NULL && target->AsProperty() == NULL) {
+    return Fail();
+  }
+  Visit(target);
+  Visit(expr->value());
+}
+
+
+void AsmValidator::VisitYield(Yield* expr) { Fail(); }
+
+
+void AsmValidator::VisitThrow(Throw* expr) { Fail(); }
+
+
+void AsmValidator::VisitProperty(Property* expr) {
+  Visit(expr->obj());
+  Visit(expr->key());
+}
+
+
+void AsmValidator::VisitCall(Call* expr) {
+  Expression* callee = expr->expression();
+  if (callee->AsVariableProxy() == NULL && callee->AsProperty() == NULL) {
+    return Fail();
+  }
+  Visit(callee);
+  VisitExpressions(expr->arguments());
+}
+
+
+void AsmValidator::VisitCallNew(CallNew* expr) { Fail(); }
+
+
+void AsmValidator::VisitCallRuntime(CallRuntime* expr) { Fail(); }
+
+
+void AsmValidator::VisitUnaryOperation(UnaryOperation* expr) {
+  // Unary plus, minus and bitwise not are desugared into binary operations.
+  if (expr->op() != Token::NOT) return Fail();
+  Visit(expr->expression());
+}
+
+
+void AsmValidator::VisitCountOperation(CountOperation* expr) { Fail(); }
+
+
+void AsmValidator::VisitBinaryOperation(BinaryOperation* expr) {
+  switch (expr->op()) {
+    case Token::COMMA:
+    case Token::BIT_OR:
+    case Token::BIT_XOR:
+    case Token::BIT_AND:
+    case Token::SHL:
+    case Token::SAR:
+    case Token::SHR:
+    case Token::ADD:
+    case Token::SUB:
+    case Token::MUL:
+    case Token::DIV:
+    case Token::MOD:
+      Visit(expr->left());
+      Visit(expr->right());
+      break;
+    default:
+      Fail();
+      break;
+  }
+}
+
+
+void AsmValidator::VisitCompareOperation(CompareOperation* expr) {
+  switch (expr->op()) {
+    case Token::EQ:
+    case Token::NE:
+    case Token::LT:
+    case Token::GT:
+    case Token::LTE:
+    case Token::GTE:
+      Visit(expr->left());
+      Visit(expr->right());
+      break;
+    default:
+      Fail();
+      break;
+  }
+}
+
+
+void AsmValidator::VisitThisFunction(ThisFunction* expr) { Fail(); }
+
+
+void AsmValidator::VisitSuperReference(SuperReference* expr) { Fail(); }
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,45 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_ASM_VALIDATOR_H_
+#define V8_ASM_VALIDATOR_H_
+
+#include "src/allocation.h"
+#include "src/ast.h"
+#include "src/zone.h"
+
+namespace v8 {
+namespace internal {
+
+// Checks that the body of a function inside a "use asm" module stays within
+// the asm.js subset: parameters carry int (x|0) or double (+x) annotations,
+// and only numeric literals, variables, heap accesses, calls and arithmetic
+// appear in the body. Such functions are compiled with TurboFan right away,
+// since the annotations already determine all machine types; functions that
+// fail validation go through the regular tiering instead.
+class AsmValidator : public AstVisitor {
+ public:
+  static bool Validate(FunctionLiteral* function, Zone* zone);
+
+  DEFINE_AST_VISITOR_SUBCLASS_MEMBERS();
+
+ private:
+  explicit AsmValidator(Zone* zone);
+
+  bool ValidateParameterAnnotations(FunctionLiteral* function);
+  void Fail() { valid_ = false; }
+
+#define DECLARE_VISIT(type) virtual void Visit##type(type* node) OVERRIDE;
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  bool valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsmValidator);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_ASM_VALIDATOR_H_
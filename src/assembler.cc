@@ -248,10 +248,12 @@ int Label::pos() const {
 //
 //  2-bit data type tags, used in short_data_record and data_jump long_record:
 //   code_target_with_id: 00
-//   position:            01
-//   statement_position:  10
+//   (unused):            01, 10
 //   comment:             11 (not used in short_data_record)
 //
+//  Source positions are not part of the relocation information. They are
+//  kept in a separate table, see source-position-table.h.
+//
 //  Long record format:
 //    4-bit middle_tag:
 //      0000 - 1100 : Short record for RelocInfo::Mode middle_tag + 2
@@ -319,8 +321,6 @@ const int kLastChunkTag = 1;
 const int kDataJumpExtraTag = kPCJumpExtraTag - 1;
 
 const int kCodeWithIdTag = 0;
-const int kNonstatementPositionTag = 1;
-const int kStatementPositionTag = 2;
 const int kCommentTag = 3;
 
 const int kPoolExtraTag = kPCJumpExtraTag - 2;
@@ -437,22 +437,6 @@ void RelocInfoWriter::Write(const RelocInfo* rinfo) {
       WriteExtraTaggedIntData(id_delta, kCodeWithIdTag);
     }
     last_id_ = static_cast<int>(rinfo->data());
-  } else if (RelocInfo::IsPosition(rmode)) {
-    // Use signed delta-encoding for position.
-    DCHECK(static_cast<int>(rinfo->data()) == rinfo->data());
-    int pos_delta = static_cast<int>(rinfo->data()) - last_position_;
-    int pos_type_tag = (rmode == RelocInfo::POSITION) ? kNonstatementPositionTag
-                                                      : kStatementPositionTag;
-    // Check if delta is small enough to fit in a tagged byte.
-    if (is_intn(pos_delta, kSmallDataBits)) {
-      WriteTaggedPC(pc_delta, kLocatableTag);
-      WriteTaggedData(pos_delta, pos_type_tag);
-    } else {
-      // Otherwise, use costly encoding.
-      WriteExtraTaggedPC(pc_delta, kPCJumpExtraTag);
-      WriteExtraTaggedIntData(pos_delta, pos_type_tag);
-    }
-    last_position_ = static_cast<int>(rinfo->data());
   } else if (RelocInfo::IsComment(rmode)) {
     // Comments are normally not generated, so we use the costly encoding.
     WriteExtraTaggedPC(pc_delta, kPCJumpExtraTag);
@@ -522,16 +506,6 @@ void RelocIterator::AdvanceReadPoolData() {
 }
 
 
-void RelocIterator::AdvanceReadPosition() {
-  int x = 0;
-  for (int i = 0; i < kIntSize; i++) {
-    x |= static_cast<int>(*--pos_) << i * kBitsPerByte;
-  }
-  last_position_ += x;
-  rinfo_.data_ = last_position_;
-}
-
-
 void RelocIterator::AdvanceReadData() {
   intptr_t x = 0;
   for (int i = 0; i < kIntptrSize; i++) {
@@ -570,23 +544,6 @@ inline void RelocIterator::ReadTaggedId() {
 }
 
 
-inline void RelocIterator::ReadTaggedPosition() {
-  int8_t signed_b = *pos_;
-  // Signed right shift is arithmetic shift.  Tested in test-utils.cc.
-  last_position_ += signed_b >> kLocatableTypeTagBits;
-  rinfo_.data_ = last_position_;
-}
-
-
-static inline RelocInfo::Mode GetPositionModeFromTag(int tag) {
-  DCHECK(tag == kNonstatementPositionTag ||
-         tag == kStatementPositionTag);
-  return (tag == kNonstatementPositionTag) ?
-         RelocInfo::POSITION :
-         RelocInfo::STATEMENT_POSITION;
-}
-
-
 void RelocIterator::next() {
   DCHECK(!done());
   // Basically, do the opposite of RelocInfoWriter::Write.
@@ -605,21 +562,11 @@ void RelocIterator::next() {
     } else if (tag == kLocatableTag) {
       ReadTaggedPC();
       Advance();
-      int locatable_tag = GetLocatableTypeTag();
-      if (locatable_tag == kCodeWithIdTag) {
-        if (SetMode(RelocInfo::CODE_TARGET_WITH_ID)) {
-          ReadTaggedId();
-          return;
-        }
-      } else {
-        // Compact encoding is never used for comments,
-        // so it must be a position.
-        DCHECK(locatable_tag == kNonstatementPositionTag ||
-               locatable_tag == kStatementPositionTag);
-        if (mode_mask_ & RelocInfo::kPositionMask) {
-          ReadTaggedPosition();
-          if (SetMode(GetPositionModeFromTag(locatable_tag))) return;
-        }
+      // Compact encoding is never used for comments, so it must be an id.
+      DCHECK(GetLocatableTypeTag() == kCodeWithIdTag);
+      if (SetMode(RelocInfo::CODE_TARGET_WITH_ID)) {
+        ReadTaggedId();
+        return;
       }
     } else {
       DCHECK(tag == kDefaultTag);
@@ -638,15 +585,6 @@ void RelocIterator::next() {
             return;
           }
           Advance(kIntSize);
-        } else if (locatable_tag != kCommentTag) {
-          DCHECK(locatable_tag == kNonstatementPositionTag ||
-                 locatable_tag == kStatementPositionTag);
-          if (mode_mask_ & RelocInfo::kPositionMask) {
-            AdvanceReadPosition();
-            if (SetMode(GetPositionModeFromTag(locatable_tag))) return;
-          } else {
-            Advance(kIntSize);
-          }
         } else {
           DCHECK(locatable_tag == kCommentTag);
           if (SetMode(RelocInfo::COMMENT)) {
@@ -695,7 +633,6 @@ RelocIterator::RelocIterator(Code* code, int mode_mask) {
   done_ = false;
   mode_mask_ = mode_mask;
   last_id_ = 0;
-  last_position_ = 0;
   byte* sequence = code->FindCodeAgeSequence();
   // We get the isolate from the map, because at serialization time
   // the code pointer has been cloned and isn't really in heap space.
@@ -719,7 +656,6 @@ RelocIterator::RelocIterator(const CodeDesc& desc, int mode_mask) {
   done_ = false;
   mode_mask_ = mode_mask;
   last_id_ = 0;
-  last_position_ = 0;
   code_age_sequence_ = NULL;
   if (mode_mask_ == 0) pos_ = end_;
   next();
@@ -770,10 +706,6 @@ const char* RelocInfo::RelocModeName(RelocInfo::Mode rmode) {
       return "js return";
     case RelocInfo::COMMENT:
       return "comment";
-    case RelocInfo::POSITION:
-      return "position";
-    case RelocInfo::STATEMENT_POSITION:
-      return "statement position";
     case RelocInfo::EXTERNAL_REFERENCE:
       return "external reference";
     case RelocInfo::INTERNAL_REFERENCE:
@@ -811,8 +743,6 @@ void RelocInfo::Print(Isolate* isolate, std::ostream& os) {  // NOLINT
     if (rmode_ == CODE_TARGET_WITH_ID) {
       os << " (id=" << static_cast<int>(data_) << ")";
     }
-  } else if (IsPosition(rmode_)) {
-    os << "  (" << data() << ")";
   } else if (IsRuntimeEntry(rmode_) &&
              isolate->deoptimizer_data() != NULL) {
     // Depotimization bailouts are stored as runtime entries.
@@ -854,8 +784,6 @@ void RelocInfo::Verify(Isolate* isolate) {
     case RUNTIME_ENTRY:
     case JS_RETURN:
     case COMMENT:
-    case POSITION:
-    case STATEMENT_POSITION:
     case EXTERNAL_REFERENCE:
     case INTERNAL_REFERENCE:
     case CONST_POOL:
@@ -1550,9 +1478,8 @@ bool PositionsRecorder::WriteRecordedPositions() {
   // Write the statement position if it is different from what was written last
   // time.
   if (state_.current_statement_position != state_.written_statement_position) {
-    EnsureSpace ensure_space(assembler_);
-    assembler_->RecordRelocInfo(RelocInfo::STATEMENT_POSITION,
-                                state_.current_statement_position);
+    table_builder_.AddPosition(assembler_->pc_offset(),
+                               state_.current_statement_position, true);
     state_.written_statement_position = state_.current_statement_position;
     written = true;
   }
@@ -1561,8 +1488,8 @@ bool PositionsRecorder::WriteRecordedPositions() {
   // also different from the written statement position.
   if (state_.current_position != state_.written_position &&
       state_.current_position != state_.written_statement_position) {
-    EnsureSpace ensure_space(assembler_);
-    assembler_->RecordRelocInfo(RelocInfo::POSITION, state_.current_position);
+    table_builder_.AddPosition(assembler_->pc_offset(),
+                               state_.current_position, false);
     state_.written_position = state_.current_position;
     written = true;
   }
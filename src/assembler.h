@@ -42,6 +42,7 @@
 #include "src/gdb-jit.h"
 #include "src/isolate.h"
 #include "src/runtime/runtime.h"
+#include "src/source-position-table.h"
 #include "src/token.h"
 
 namespace v8 {
@@ -306,11 +307,11 @@ enum ICacheFlushMode { FLUSH_ICACHE_IF_NEEDED, SKIP_ICACHE_FLUSH };
 class RelocInfo {
  public:
   // The constant kNoPosition is used with the collecting of source positions
-  // in the relocation information. Two types of source positions are collected
-  // "position" (RelocMode position) and "statement position" (RelocMode
-  // statement_position). The "position" is collected at places in the source
-  // code which are of interest when making stack traces to pin-point the source
-  // location of a stack frame as close as possible. The "statement position" is
+  // in the source position table of the code (see source-position-table.h).
+  // Two types of source positions are collected: "position" and "statement
+  // position". The "position" is collected at places in the source code which
+  // are of interest when making stack traces to pin-point the source location
+  // of a stack frame as close as possible. The "statement position" is
   // collected at the beginning at each statement, and is used to indicate
   // possible break locations. kNoPosition is used to indicate an
   // invalid/uninitialized position value.
@@ -346,8 +347,6 @@ class RelocInfo {
     RUNTIME_ENTRY,
     JS_RETURN,  // Marks start of the ExitJSFrame code.
     COMMENT,
-    POSITION,  // See comment for kNoPosition above.
-    STATEMENT_POSITION,  // See comment for kNoPosition above.
     DEBUG_BREAK_SLOT,  // Additional code inserted for debug break slot.
     EXTERNAL_REFERENCE,  // The address of an external C++ function.
     INTERNAL_REFERENCE,  // An address inside the same function.
@@ -421,12 +420,6 @@ class RelocInfo {
   static inline bool IsVeneerPool(Mode mode) {
     return mode == VENEER_POOL;
   }
-  static inline bool IsPosition(Mode mode) {
-    return mode == POSITION || mode == STATEMENT_POSITION;
-  }
-  static inline bool IsStatementPosition(Mode mode) {
-    return mode == STATEMENT_POSITION;
-  }
   static inline bool IsExternalReference(Mode mode) {
     return mode == EXTERNAL_REFERENCE;
   }
@@ -585,9 +578,7 @@ class RelocInfo {
 #endif
 
   static const int kCodeTargetMask = (1 << (LAST_CODE_ENUM + 1)) - 1;
-  static const int kPositionMask = 1 << POSITION | 1 << STATEMENT_POSITION;
-  static const int kDataMask =
-      (1 << CODE_TARGET_WITH_ID) | kPositionMask | (1 << COMMENT);
+  static const int kDataMask = (1 << CODE_TARGET_WITH_ID) | (1 << COMMENT);
   static const int kApplyMask;  // Modes affected by apply. Depends on arch.
 
  private:
@@ -615,14 +606,8 @@ class RelocInfo {
 // lower addresses.
 class RelocInfoWriter BASE_EMBEDDED {
  public:
-  RelocInfoWriter() : pos_(NULL),
-                      last_pc_(NULL),
-                      last_id_(0),
-                      last_position_(0) {}
-  RelocInfoWriter(byte* pos, byte* pc) : pos_(pos),
-                                         last_pc_(pc),
-                                         last_id_(0),
-                                         last_position_(0) {}
+  RelocInfoWriter() : pos_(NULL), last_pc_(NULL), last_id_(0) {}
+  RelocInfoWriter(byte* pos, byte* pc) : pos_(pos), last_pc_(pc), last_id_(0) {}
 
   byte* pos() const { return pos_; }
   byte* last_pc() const { return last_pc_; }
@@ -656,7 +641,6 @@ class RelocInfoWriter BASE_EMBEDDED {
   byte* pos_;
   byte* last_pc_;
   int last_id_;
-  int last_position_;
   DISALLOW_COPY_AND_ASSIGN(RelocInfoWriter);
 };
 
@@ -700,12 +684,10 @@ class RelocIterator: public Malloced {
   void AdvanceReadPC();
   void AdvanceReadId();
   void AdvanceReadPoolData();
-  void AdvanceReadPosition();
   void AdvanceReadData();
   void AdvanceReadVariableLengthPCJump();
   int GetLocatableTypeTag();
   void ReadTaggedId();
-  void ReadTaggedPosition();
 
   // If the given mode is wanted, set it in rinfo_ and return true.
   // Else return false. Used for efficiently skipping unwanted modes.
@@ -720,7 +702,6 @@ class RelocIterator: public Malloced {
   bool done_;
   int mode_mask_;
   int last_id_;
-  int last_position_;
   DISALLOW_COPY_AND_ASSIGN(RelocIterator);
 };
 
@@ -1027,7 +1008,7 @@ class PositionsRecorder BASE_EMBEDDED {
   // Set current statement position to pos.
   void RecordStatementPosition(int pos);
 
-  // Write recorded positions to relocation information.
+  // Write recorded positions to the source position table.
   bool WriteRecordedPositions();
 
   int current_position() const { return state_.current_position; }
@@ -1036,9 +1017,15 @@ class PositionsRecorder BASE_EMBEDDED {
     return state_.current_statement_position;
   }
 
+  // Returns the source position table for the code generated so far.
+  Handle<ByteArray> ToSourcePositionTable(Isolate* isolate) {
+    return table_builder_.ToSourcePositionTable(isolate);
+  }
+
  private:
   Assembler* assembler_;
   PositionState state_;
+  SourcePositionTableBuilder table_builder_;
 
   // Currently jit_handler_data_ is used to store JITHandler-specific data
   // over the lifetime of a PositionsRecorder
@@ -263,7 +263,7 @@ const AstConsString* AstValueFactory::NewConsString(
   // This Vector will be valid as long as the Collector is alive (meaning that
   // the AstRawString will not be moved).
   AstConsString* new_string = new (zone_) AstConsString(left, right);
-  strings_.Add(new_string);
+  strings_.Add(new_string, zone_);
   if (isolate_) {
     new_string->Internalize(isolate_);
   }
@@ -294,7 +294,7 @@ const AstValue* AstValueFactory::NewString(const AstRawString* string) {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -304,7 +304,7 @@ const AstValue* AstValueFactory::NewSymbol(const char* name) {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -314,7 +314,7 @@ const AstValue* AstValueFactory::NewNumber(double number) {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -325,7 +325,7 @@ const AstValue* AstValueFactory::NewSmi(int number) {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -335,7 +335,7 @@ const AstValue* AstValueFactory::NewBoolean(bool b) {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -346,7 +346,7 @@ const AstValue* AstValueFactory::NewStringList(
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -356,7 +356,7 @@ const AstValue* AstValueFactory::NewNull() {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -366,7 +366,7 @@ const AstValue* AstValueFactory::NewUndefined() {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -376,7 +376,7 @@ const AstValue* AstValueFactory::NewTheHole() {
   if (isolate_) {
     value->Internalize(isolate_);
   }
-  values_.Add(value);
+  values_.Add(value, zone_);
   return value;
 }
 
@@ -388,7 +388,8 @@ const AstRawString* AstValueFactory::GetString(
   // against the AstRawStrings which are in the string_table_. We should not
   // return this AstRawString.
   AstRawString key(is_one_byte, literal_bytes, hash);
-  HashMap::Entry* entry = string_table_.Lookup(&key, hash, true);
+  ZoneHashMap::Entry* entry = string_table_.Lookup(
+      &key, hash, true, ZoneAllocationPolicy(zone_));
   if (entry->value == NULL) {
     // Copy literal contents for later comparison.
     int length = literal_bytes.length();
@@ -397,7 +398,7 @@ const AstRawString* AstValueFactory::GetString(
     AstRawString* new_string = new (zone_) AstRawString(
         is_one_byte, Vector<const byte>(new_literal_bytes, length), hash);
     entry->key = new_string;
-    strings_.Add(new_string);
+    strings_.Add(new_string, zone_);
     if (isolate_) {
       new_string->Internalize(isolate_);
     }
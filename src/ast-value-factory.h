@@ -270,7 +270,11 @@ class AstValue : public ZoneObject {
 class AstValueFactory {
  public:
   AstValueFactory(Zone* zone, uint32_t hash_seed)
-      : string_table_(AstRawString::Compare),
+      : string_table_(AstRawString::Compare,
+                      ZoneHashMap::kDefaultHashMapCapacity,
+                      ZoneAllocationPolicy(zone)),
+        values_(kInitialListCapacity, zone),
+        strings_(kInitialListCapacity, zone),
         zone_(zone),
         isolate_(NULL),
         hash_seed_(hash_seed) {
@@ -323,12 +327,16 @@ class AstValueFactory {
   const AstRawString* GetString(uint32_t hash, bool is_one_byte,
                                 Vector<const byte> literal_bytes);
 
+  static const int kInitialListCapacity = 16;
+
   // All strings are copied here, one after another (no NULLs inbetween).
-  HashMap string_table_;
+  // The bookkeeping lives in the parse zone, so that it is recycled together
+  // with the AST instead of going through malloc for every parse.
+  ZoneHashMap string_table_;
   // For keeping track of all AstValues and AstRawStrings we've created (so that
   // they can be internalized later).
-  List<AstValue*> values_;
-  List<AstString*> strings_;
+  ZoneList<AstValue*> values_;
+  ZoneList<AstString*> strings_;
   Zone* zone_;
   Isolate* isolate_;
 
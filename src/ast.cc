@@ -1098,7 +1098,6 @@ DONT_OPTIMIZE_NODE_WITH_FEEDBACK_SLOTS(Yield)
 
 // TODO(turbofan): Remove the dont_turbofan_reason once this list is empty.
 DONT_TURBOFAN_NODE(ForOfStatement)
-DONT_TURBOFAN_NODE(TryCatchStatement)
 DONT_TURBOFAN_NODE(TryFinallyStatement)
 
 DONT_SELFOPTIMIZE_NODE(DoWhileStatement)
@@ -1119,6 +1118,20 @@ void AstConstructionVisitor::VisitCallRuntime(CallRuntime* node) {
   }
 }
 
+
+void AstConstructionVisitor::VisitTryCatchStatement(TryCatchStatement* node) {
+  increase_node_count();
+  add_flag(kDontSelfOptimize);
+#if V8_TARGET_ARCH_X64
+  // Crankshaft enters the catch block by deoptimizing, see
+  // HOptimizedGraphBuilder::VisitTryCatchStatement. TurboFan does not look
+  // at the reason and rejects all functions with handlers.
+  if (FLAG_optimize_try_catch) return;
+#endif
+  set_dont_crankshaft_reason(kTryCatchStatement);
+  set_dont_turbofan_reason(kTryCatchStatement);
+}
+
 #undef REGULAR_NODE
 #undef DONT_OPTIMIZE_NODE
 #undef DONT_SELFOPTIMIZE_NODE
@@ -19,6 +19,7 @@
 #include "src/small-pointer-list.h"
 #include "src/smart-pointers.h"
 #include "src/token.h"
+#include "src/type-feedback-vector.h"
 #include "src/types.h"
 #include "src/utils.h"
 #include "src/variables.h"
@@ -161,7 +162,11 @@ class AstProperties FINAL BASE_EMBEDDED {
  public:
   class Flags : public EnumSet<AstPropertiesFlag, int> {};
 
-AstProperties() : node_count_(0), feedback_slots_(0) {}
+  // The feedback slots of a function come after the counters at the start
+  // of its type feedback vector.
+  AstProperties()
+      : node_count_(0),
+        feedback_slots_(TypeFeedbackVector::kReservedIndexCount) {}
 
   Flags* flags() { return &flags_; }
   int node_count() { return node_count_; }
@@ -386,7 +391,7 @@ class Expression : public AstNode {
 
   // TODO(rossberg): this should move to its own AST node eventually.
   virtual void RecordToBooleanTypeFeedback(TypeFeedbackOracle* oracle);
-  byte to_boolean_types() const { return to_boolean_types_; }
+  uint16_t to_boolean_types() const { return to_boolean_types_; }
 
   BailoutId id() const { return id_; }
   TypeFeedbackId test_id() const { return test_id_; }
@@ -399,10 +404,10 @@ class Expression : public AstNode {
         bounds_(Bounds::Unbounded(zone)),
         id_(id_gen->GetNextId()),
         test_id_(id_gen->GetNextId()) {}
-  void set_to_boolean_types(byte types) { to_boolean_types_ = types; }
+  void set_to_boolean_types(uint16_t types) { to_boolean_types_ = types; }
 
  private:
-  byte to_boolean_types_;
+  uint16_t to_boolean_types_;
   bool is_parenthesized_ : 1;
   bool is_multi_parenthesized_ : 1;
   Bounds bounds_;
@@ -1293,6 +1298,13 @@ class TryCatchStatement FINAL : public TryStatement {
   Variable* variable() { return variable_; }
   Block* catch_block() const { return catch_block_; }
 
+  // The entry of the try block after the handler has been pushed, the entry
+  // of the catch block with the exception in the result register, and the
+  // point after the whole statement.
+  BailoutId TryId() const { return try_id_; }
+  BailoutId HandlerId() const { return handler_id_; }
+  BailoutId ExitId() const { return exit_id_; }
+
  protected:
   TryCatchStatement(Zone* zone,
                     int index,
@@ -1300,17 +1312,24 @@ class TryCatchStatement FINAL : public TryStatement {
                     Scope* scope,
                     Variable* variable,
                     Block* catch_block,
-                    int pos)
+                    int pos,
+                    IdGen* id_gen)
       : TryStatement(zone, index, try_block, pos),
         scope_(scope),
         variable_(variable),
-        catch_block_(catch_block) {
+        catch_block_(catch_block),
+        try_id_(id_gen->GetNextId()),
+        handler_id_(id_gen->GetNextId()),
+        exit_id_(id_gen->GetNextId()) {
   }
 
  private:
   Scope* scope_;
   Variable* variable_;
   Block* catch_block_;
+  const BailoutId try_id_;
+  const BailoutId handler_id_;
+  const BailoutId exit_id_;
 };
 
 
@@ -1955,6 +1974,9 @@ class CallRuntime FINAL : public Expression {
 
   TypeFeedbackId CallRuntimeFeedbackId() const { return reuse(id()); }
 
+  // Return site of the function invoked by %_CallFunction.
+  BailoutId ReturnId() const { return return_id_; }
+
  protected:
   CallRuntime(Zone* zone, const AstRawString* name,
               const Runtime::Function* function,
@@ -1962,13 +1984,15 @@ class CallRuntime FINAL : public Expression {
       : Expression(zone, pos, id_gen),
         raw_name_(name),
         function_(function),
-        arguments_(arguments) {}
+        arguments_(arguments),
+        return_id_(id_gen->GetNextId()) {}
 
  private:
   const AstRawString* raw_name_;
   const Runtime::Function* function_;
   ZoneList<Expression*>* arguments_;
   int callruntime_feedback_slot_;
+  const BailoutId return_id_;
 };
 
 
@@ -3258,7 +3282,7 @@ class AstNodeFactory FINAL BASE_EMBEDDED {
                                           Block* catch_block,
                                           int pos) {
     TryCatchStatement* stmt = new(zone_) TryCatchStatement(
-        zone_, index, try_block, scope, variable, catch_block, pos);
+        zone_, index, try_block, scope, variable, catch_block, pos, id_gen_);
     VISIT_AND_RETURN(TryCatchStatement, stmt)
   }
 
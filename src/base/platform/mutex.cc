@@ -6,6 +6,8 @@
 
 #include <errno.h>
 
+#include "src/base/platform/platform.h"
+
 namespace v8 {
 namespace base {
 
@@ -23,6 +25,18 @@ static V8_INLINE void InitializeNativeHandle(pthread_mutex_t* mutex) {
   result = pthread_mutex_init(mutex, &attr);
   DCHECK_EQ(0, result);
   result = pthread_mutexattr_destroy(&attr);
+#elif V8_OS_LINUX && V8_LIBC_GLIBC
+  // Use an adaptive mutex, which spins briefly in user space before it
+  // blocks in the kernel. Contended short critical sections then hand over
+  // without a futex wakeup going through the scheduler.
+  pthread_mutexattr_t attr;
+  result = pthread_mutexattr_init(&attr);
+  DCHECK_EQ(0, result);
+  result = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+  DCHECK_EQ(0, result);
+  result = pthread_mutex_init(mutex, &attr);
+  DCHECK_EQ(0, result);
+  result = pthread_mutexattr_destroy(&attr);
 #else
   // Use a fast mutex (default attributes).
   result = pthread_mutex_init(mutex, NULL);
@@ -110,7 +124,7 @@ static V8_INLINE bool TryLockNativeHandle(PCRITICAL_SECTION cs) {
 #endif  // V8_OS_POSIX
 
 
-Mutex::Mutex() {
+Mutex::Mutex() : contention_count_(0) {
   InitializeNativeHandle(&native_handle_);
 #ifdef DEBUG
   level_ = 0;
@@ -125,7 +139,10 @@ Mutex::~Mutex() {
 
 
 void Mutex::Lock() {
-  LockNativeHandle(&native_handle_);
+  if (!TryLockNativeHandle(&native_handle_)) {
+    LockNativeHandle(&native_handle_);
+    contention_count_++;
+  }
   AssertUnheldAndMark();
 }
 
@@ -188,4 +205,22 @@ bool RecursiveMutex::TryLock() {
   return true;
 }
 
+
+void SpinLock::Lock() {
+  // The number of times a waiting thread checks the lock before it yields
+  // its CPU to the owner.
+  static const int kSpinsBeforeYield = 100;
+  int spins = 0;
+  while (!TryLock()) {
+    // Only retry the compare-and-swap once the lock looks free, so waiting
+    // threads do not keep taking the cache line away from the owner.
+    while (NoBarrier_Load(&state_) != kUnlocked) {
+      if (++spins == kSpinsBeforeYield) {
+        Thread::YieldCPU();
+        spins = 0;
+      }
+    }
+  }
+}
+
 } }  // namespace v8::base
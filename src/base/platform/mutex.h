@@ -5,6 +5,7 @@
 #ifndef V8_BASE_PLATFORM_MUTEX_H_
 #define V8_BASE_PLATFORM_MUTEX_H_
 
+#include "src/base/atomicops.h"
 #include "src/base/lazy-instance.h"
 #if V8_OS_WIN
 #include "src/base/win32-headers.h"
@@ -52,6 +53,12 @@ class Mutex FINAL {
   // successfully locked.
   bool TryLock() WARN_UNUSED_RESULT;
 
+  // Returns the number of calls to |Lock()| that found the mutex owned by
+  // another thread and had to wait. The count is updated while the mutex is
+  // held, so it is only exact when read by the owner or after all threads
+  // using the mutex have stopped.
+  int contention_count() const { return contention_count_; }
+
   // The implementation-defined native handle type.
 #if V8_OS_POSIX
   typedef pthread_mutex_t NativeHandle;
@@ -68,6 +75,7 @@ class Mutex FINAL {
 
  private:
   NativeHandle native_handle_;
+  int contention_count_;
 #ifdef DEBUG
   int level_;
 #endif
@@ -188,6 +196,46 @@ typedef LazyStaticInstance<RecursiveMutex,
 #define LAZY_RECURSIVE_MUTEX_INITIALIZER LAZY_STATIC_INSTANCE_INITIALIZER
 
 
+// -----------------------------------------------------------------------------
+// SpinLock
+//
+// This class is a mutex for critical sections of a few instructions. Threads
+// waiting for it spin and eventually yield their CPU instead of blocking in
+// the kernel, so the owner must never block while holding it. A spin lock
+// offers the same exclusive, non-recursive ownership semantics as Mutex, but
+// it cannot be used with ConditionVariable. The SpinLock class is
+// non-copyable.
+
+class SpinLock FINAL {
+ public:
+  SpinLock() : state_(kUnlocked) {}
+  ~SpinLock() { DCHECK_EQ(kUnlocked, state_); }
+
+  // Locks the spin lock, spinning until it is unlocked if another thread
+  // owns it.
+  void Lock();
+
+  // Unlocks the spin lock. It is assumed to be locked and owned by the
+  // calling thread on entrance.
+  void Unlock() {
+    DCHECK_EQ(kLocked, state_);
+    Release_Store(&state_, kUnlocked);
+  }
+
+  // Tries to lock the spin lock. Returns whether it was successfully locked.
+  bool TryLock() WARN_UNUSED_RESULT {
+    return Acquire_CompareAndSwap(&state_, kUnlocked, kLocked) == kUnlocked;
+  }
+
+ private:
+  enum { kUnlocked = 0, kLocked = 1 };
+
+  volatile Atomic32 state_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpinLock);
+};
+
+
 // -----------------------------------------------------------------------------
 // LockGuard
 //
@@ -131,6 +131,28 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+void OS::AdviseHugePages(void* address, const size_t size) {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  // Only ranges that contain a whole aligned huge page can be collapsed, but
+  // the kernel merges adjacent committed ranges with the same advice.
+  madvise(address, size, MADV_HUGEPAGE);
+#else
+  USE(address);
+  USE(size);
+#endif
+}
+
+
+void OS::DiscardSystemPages(void* address, const size_t size) {
+#if defined(MADV_FREE)
+  // MADV_FREE lets the kernel reclaim the pages lazily, but kernels that
+  // predate it reject the advice.
+  if (madvise(address, size, MADV_FREE) == 0) return;
+#endif
+  madvise(address, size, MADV_DONTNEED);
+}
+
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
@@ -551,6 +573,20 @@ void Thread::YieldCPU() {
 }
 
 
+bool Thread::SetCurrentThreadAffinity(int cpu) {
+#if V8_OS_LINUX && defined(CPU_SET)
+  DCHECK(cpu >= 0 && cpu < CPU_SETSIZE);
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  USE(cpu);
+  return false;
+#endif
+}
+
+
 static Thread::LocalStorageKey PthreadKeyToLocalKey(pthread_key_t pthread_key) {
 #if V8_OS_CYGWIN
   // We need to cast pthread_key_t to Thread::LocalStorageKey in two steps
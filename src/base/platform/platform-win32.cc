@@ -817,6 +817,17 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+void OS::AdviseHugePages(void* address, const size_t size) {
+  // Large pages on Windows need a privilege and must be requested when the
+  // memory is allocated, so there is nothing to advise here.
+}
+
+
+void OS::DiscardSystemPages(void* address, const size_t size) {
+  VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+}
+
+
 void OS::Sleep(int milliseconds) {
   ::Sleep(milliseconds);
 }
@@ -864,9 +875,12 @@ class Win32MemoryMappedFile : public OS::MemoryMappedFile {
 };
 
 
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                FileMode mode) {
+  bool read_only = mode == kReadOnly;
   // Open a physical file
-  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE,
+  HANDLE file = CreateFileA(name,
+      read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
   if (file == INVALID_HANDLE_VALUE) return NULL;
 
@@ -874,11 +888,13 @@ OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
 
   // Create a file mapping for the physical file
   HANDLE file_mapping = CreateFileMapping(file, NULL,
-      PAGE_READWRITE, 0, static_cast<DWORD>(size), NULL);
+      read_only ? PAGE_READONLY : PAGE_READWRITE, 0,
+      static_cast<DWORD>(size), NULL);
   if (file_mapping == NULL) return NULL;
 
   // Map a view of the file into memory
-  void* memory = MapViewOfFile(file_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  void* memory = MapViewOfFile(file_mapping,
+      read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, size);
   return new Win32MemoryMappedFile(file, file_mapping, memory, size);
 }
 
@@ -1403,4 +1419,11 @@ void Thread::YieldCPU() {
   Sleep(0);
 }
 
+
+bool Thread::SetCurrentThreadAffinity(int cpu) {
+  DCHECK(cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8));
+  DWORD_PTR mask = static_cast<DWORD_PTR>(1) << cpu;
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
 } }  // namespace v8::base
@@ -220,6 +220,14 @@ class OS {
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Ask the OS to back the given committed range with huge pages where it
+  // supports doing so transparently. This is only a hint.
+  static void AdviseHugePages(void* address, const size_t size);
+
+  // Give the physical pages backing a committed range back to the OS. The
+  // range stays committed; its contents are undefined until next written.
+  static void DiscardSystemPages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
@@ -246,7 +254,11 @@ class OS {
 
   class MemoryMappedFile {
    public:
-    static MemoryMappedFile* open(const char* name);
+    // Read-only mappings of the same file are backed by the page cache and
+    // shared by all processes mapping it.
+    enum FileMode { kReadOnly, kReadWrite };
+
+    static MemoryMappedFile* open(const char* name, FileMode mode);
     static MemoryMappedFile* create(const char* name, int size, void* initial);
     virtual ~MemoryMappedFile() { }
     virtual void* memory() = 0;
@@ -486,6 +498,10 @@ class Thread {
   // A hint to the scheduler to let another thread run.
   static void YieldCPU();
 
+  // Restricts the calling thread to run on the given processor. Returns
+  // false if that is not supported on this platform.
+  static bool SetCurrentThreadAffinity(int cpu);
+
 
   // The thread name length is limited to 16 based on Linux's implementation of
   // prctl().
@@ -10,7 +10,11 @@ namespace v8 {
 namespace internal {
 
 BasicBlockProfiler::Data::Data(size_t n_blocks)
-    : n_blocks_(n_blocks), block_ids_(n_blocks_), counts_(n_blocks_, 0) {}
+    : n_blocks_(n_blocks),
+      script_id_(-1),
+      function_position_(-1),
+      block_ids_(n_blocks_),
+      counts_(n_blocks_, 0) {}
 
 
 BasicBlockProfiler::Data::~Data() {}
@@ -26,6 +30,13 @@ void BasicBlockProfiler::Data::SetCode(std::ostringstream* os) {
 }
 
 
+void BasicBlockProfiler::Data::SetFunction(int script_id,
+                                           int function_position) {
+  script_id_ = script_id;
+  function_position_ = function_position;
+}
+
+
 void BasicBlockProfiler::Data::SetFunctionName(std::ostringstream* os) {
   InsertIntoString(os, &function_name_);
 }
@@ -79,6 +90,29 @@ void BasicBlockProfiler::ResetCounts() {
 }
 
 
+BasicBlockProfiler::Data* BasicBlockProfiler::FindData(int script_id,
+                                                       int function_position) {
+  for (DataList::reverse_iterator i = data_list_.rbegin();
+       i != data_list_.rend(); ++i) {
+    if ((*i)->script_id_ == script_id &&
+        (*i)->function_position_ == function_position) {
+      return *i;
+    }
+  }
+  return NULL;
+}
+
+
+void BasicBlockProfiler::ResetCounts(int script_id, int function_position) {
+  for (DataList::iterator i = data_list_.begin(); i != data_list_.end(); ++i) {
+    if ((*i)->script_id_ == script_id &&
+        (*i)->function_position_ == function_position) {
+      (*i)->ResetCounts();
+    }
+  }
+}
+
+
 std::ostream& operator<<(std::ostream& os, const BasicBlockProfiler& p) {
   os << "---- Start Profiling Data ----" << std::endl;
   typedef BasicBlockProfiler::DataList::const_iterator iterator;
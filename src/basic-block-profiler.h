@@ -23,8 +23,13 @@ class BasicBlockProfiler {
    public:
     size_t n_blocks() const { return n_blocks_; }
     const uint32_t* counts() const { return &counts_[0]; }
+    // The script id and start position of the instrumented function, or -1
+    // for code that is not compiled from JavaScript.
+    int script_id() const { return script_id_; }
+    int function_position() const { return function_position_; }
 
     void SetCode(std::ostringstream* os);
+    void SetFunction(int script_id, int function_position);
     void SetFunctionName(std::ostringstream* os);
     void SetSchedule(std::ostringstream* os);
     void SetBlockId(size_t offset, size_t block_id);
@@ -41,6 +46,8 @@ class BasicBlockProfiler {
     void ResetCounts();
 
     const size_t n_blocks_;
+    int script_id_;
+    int function_position_;
     std::vector<size_t> block_ids_;
     std::vector<uint32_t> counts_;
     std::string function_name_;
@@ -57,6 +64,14 @@ class BasicBlockProfiler {
   Data* NewData(size_t n_blocks);
   void ResetCounts();
 
+  // Returns the data of the most recent instrumented compilation of the
+  // function at the given position, or NULL if there is none.
+  Data* FindData(int script_id, int function_position);
+
+  // Resets the counts of all instrumented compilations of the function at
+  // the given position.
+  void ResetCounts(int script_id, int function_position);
+
   const DataList* data_list() { return &data_list_; }
 
  private:
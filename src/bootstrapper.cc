@@ -38,6 +38,7 @@ Bootstrapper::Bootstrapper(Isolate* isolate)
     : isolate_(isolate),
       nesting_(0),
       extensions_cache_(Script::TYPE_EXTENSION),
+      experimental_natives_cache_(Script::TYPE_NATIVE),
       delete_these_non_arrays_on_tear_down_(NULL),
       delete_these_arrays_on_tear_down_(NULL) {
 }
@@ -69,6 +70,7 @@ Handle<String> Bootstrapper::NativesSourceLookup(int index) {
 
 void Bootstrapper::Initialize(bool create_heap_objects) {
   extensions_cache_.Initialize(isolate_, create_heap_objects);
+  experimental_natives_cache_.Initialize(isolate_, create_heap_objects);
 }
 
 
@@ -149,6 +151,7 @@ void Bootstrapper::TearDown() {
   }
 
   extensions_cache_.Initialize(isolate_, false);  // Yes, symmetrical
+  experimental_natives_cache_.Initialize(isolate_, false);
 }
 
 
@@ -300,7 +303,8 @@ class Genesis BASE_EMBEDDED {
   static bool CompileExperimentalBuiltin(Isolate* isolate, int index);
   static bool CompileNative(Isolate* isolate,
                             Vector<const char> name,
-                            Handle<String> source);
+                            Handle<String> source,
+                            SourceCodeCache* cache);
   static bool CompileScriptCached(Isolate* isolate,
                                   Vector<const char> name,
                                   Handle<String> source,
@@ -329,6 +333,7 @@ class Genesis BASE_EMBEDDED {
 
 void Bootstrapper::Iterate(ObjectVisitor* v) {
   extensions_cache_.Iterate(v);
+  experimental_natives_cache_.Iterate(v);
   v->Synchronize(VisitorSynchronization::kExtensions);
 }
 
@@ -1146,13 +1151,19 @@ void Genesis::InitializeGlobal(Handle<GlobalObject> global_object,
     native_context()->set_data_view_fun(*data_view_fun);
   }
 
-  // -- M a p
-  InstallFunction(global, "Map", JS_MAP_TYPE, JSMap::kSize,
-                  isolate->initial_object_prototype(), Builtins::kIllegal);
+  {  // -- M a p
+    Handle<JSFunction> js_map_fun = InstallFunction(
+        global, "Map", JS_MAP_TYPE, JSMap::kSize,
+        isolate->initial_object_prototype(), Builtins::kIllegal);
+    native_context()->set_js_map_fun(*js_map_fun);
+  }
 
-  // -- S e t
-  InstallFunction(global, "Set", JS_SET_TYPE, JSSet::kSize,
-                  isolate->initial_object_prototype(), Builtins::kIllegal);
+  {  // -- S e t
+    Handle<JSFunction> js_set_fun = InstallFunction(
+        global, "Set", JS_SET_TYPE, JSSet::kSize,
+        isolate->initial_object_prototype(), Builtins::kIllegal);
+    native_context()->set_js_set_fun(*js_set_fun);
+  }
 
   {  // Set up the iterator result object
     STATIC_ASSERT(JSGeneratorObject::kResultPropertyCount == 2);
@@ -1377,25 +1388,36 @@ bool Genesis::CompileBuiltin(Isolate* isolate, int index) {
   Vector<const char> name = Natives::GetScriptName(index);
   Handle<String> source_code =
       isolate->bootstrapper()->NativesSourceLookup(index);
-  return CompileNative(isolate, name, source_code);
+  return CompileNative(isolate, name, source_code, NULL);
 }
 
 
 bool Genesis::CompileExperimentalBuiltin(Isolate* isolate, int index) {
   Vector<const char> name = ExperimentalNatives::GetScriptName(index);
+  // Contexts created after the first one reuse its compiled script and do
+  // not need the source at all. Nothing is cached while building a snapshot.
+  SourceCodeCache* cache =
+      isolate->serializer_enabled()
+          ? NULL
+          : isolate->bootstrapper()->experimental_natives_cache();
+  Handle<SharedFunctionInfo> cached_info;
+  if (cache != NULL && cache->Lookup(name, &cached_info)) {
+    return CompileNative(isolate, name, Handle<String>::null(), cache);
+  }
   Factory* factory = isolate->factory();
   Handle<String> source_code;
   ASSIGN_RETURN_ON_EXCEPTION_VALUE(
       isolate, source_code, factory->NewStringFromAscii(
                                 ExperimentalNatives::GetRawScriptSource(index)),
       false);
-  return CompileNative(isolate, name, source_code);
+  return CompileNative(isolate, name, source_code, cache);
 }
 
 
 bool Genesis::CompileNative(Isolate* isolate,
                             Vector<const char> name,
-                            Handle<String> source) {
+                            Handle<String> source,
+                            SourceCodeCache* cache) {
   HandleScope scope(isolate);
   SuppressDebug compiling_natives(isolate->debug());
   // During genesis, the boilerplate for stack overflow won't work until the
@@ -1407,7 +1429,7 @@ bool Genesis::CompileNative(Isolate* isolate,
   bool result = CompileScriptCached(isolate,
                                     name,
                                     source,
-                                    NULL,
+                                    cache,
                                     NULL,
                                     Handle<Context>(isolate->context()),
                                     true);
@@ -1540,6 +1562,7 @@ void Genesis::InstallNativeFunctions() {
   INSTALL_NATIVE(JSFunction, "PromiseChain", promise_chain);
   INSTALL_NATIVE(JSFunction, "PromiseCatch", promise_catch);
   INSTALL_NATIVE(JSFunction, "PromiseThen", promise_then);
+  INSTALL_NATIVE(JSFunction, "RunMicrotaskBatch", run_microtask_batch);
 
   INSTALL_NATIVE(JSFunction, "NotifyChange", observers_notify_change);
   INSTALL_NATIVE(JSFunction, "EnqueueSpliceRecord", observers_enqueue_splice);
@@ -2106,6 +2129,41 @@ bool Genesis::InstallNatives() {
 
 
 bool Genesis::InstallExperimentalNatives() {
+  if (FLAG_harmony_atomics) {  // -- S h a r e d A r r a y B u f f e r
+    Handle<JSObject> global(native_context()->global_object());
+    Handle<JSFunction> shared_array_buffer_fun =
+        InstallFunction(
+            global, "SharedArrayBuffer", JS_ARRAY_BUFFER_TYPE,
+            JSArrayBuffer::kSizeWithInternalFields,
+            isolate()->initial_object_prototype(),
+            Builtins::kIllegal);
+    native_context()->set_shared_array_buffer_fun(*shared_array_buffer_fun);
+  }
+
+  if (FLAG_harmony_simd) {  // -- S I M D
+    Handle<JSObject> global(native_context()->global_object());
+    Handle<String> name = factory()->InternalizeUtf8String("SIMD");
+    Handle<JSFunction> cons = factory()->NewFunction(name);
+    JSFunction::SetInstancePrototype(cons,
+        Handle<Object>(native_context()->initial_object_prototype(),
+                       isolate()));
+    cons->SetInstanceClassName(*name);
+    Handle<JSObject> simd_object = factory()->NewJSObject(cons, TENURED);
+    JSObject::AddProperty(global, name, simd_object, DONT_ENUM);
+
+    // The wrapper functions of the value types. Their instance class names
+    // make %_ClassOf work on the wrappers created by ToObject.
+#define SIMD128_INSTALL_FUNCTION(TYPE, Type, type, lane_count, lane_type) \
+    Handle<JSFunction> type##_fun = InstallFunction(                      \
+        simd_object, #Type, JS_VALUE_TYPE, JSValue::kSize,                \
+        isolate()->initial_object_prototype(), Builtins::kIllegal);       \
+    type##_fun->shared()->set_instance_class_name(                        \
+        *factory()->InternalizeUtf8String(#Type));                        \
+    native_context()->set_##type##_function(*type##_fun);
+    SIMD128_TYPES(SIMD128_INSTALL_FUNCTION)
+#undef SIMD128_INSTALL_FUNCTION
+  }
+
   for (int i = ExperimentalNatives::GetDebuggerCount();
        i < ExperimentalNatives::GetBuiltinsCount();
        i++) {
@@ -2113,6 +2171,8 @@ bool Genesis::InstallExperimentalNatives() {
     INSTALL_EXPERIMENTAL_NATIVE(i, strings, "harmony-string.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, arrays, "harmony-array.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, classes, "harmony-classes.js")
+    INSTALL_EXPERIMENTAL_NATIVE(i, atomics, "harmony-atomics.js")
+    INSTALL_EXPERIMENTAL_NATIVE(i, simd, "harmony-simd.js")
   }
 
   InstallExperimentalNativeFunctions();
@@ -2217,10 +2277,9 @@ bool Genesis::InstallSpecialObjects(Handle<Context> native_context) {
 
   Handle<JSObject> Error = Handle<JSObject>::cast(
       Object::GetProperty(isolate, global, "Error").ToHandleChecked());
-  Handle<String> name =
-      factory->InternalizeOneByteString(STATIC_CHAR_VECTOR("stackTraceLimit"));
   Handle<Smi> stack_trace_limit(Smi::FromInt(FLAG_stack_trace_limit), isolate);
-  JSObject::AddProperty(Error, name, stack_trace_limit, NONE);
+  JSObject::AddProperty(Error, factory->stack_trace_limit_string(),
+                        stack_trace_limit, NONE);
 
   // Expose the natives in global if a name for it is specified.
   if (FLAG_expose_natives_as != NULL && strlen(FLAG_expose_natives_as) != 0) {
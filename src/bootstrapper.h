@@ -108,11 +108,18 @@ class Bootstrapper FINAL {
 
   SourceCodeCache* extensions_cache() { return &extensions_cache_; }
 
+  // Experimental natives are not part of the snapshot. Their compiled scripts
+  // are kept here and shared by all contexts created by the isolate.
+  SourceCodeCache* experimental_natives_cache() {
+    return &experimental_natives_cache_;
+  }
+
  private:
   Isolate* isolate_;
   typedef int NestingCounterType;
   NestingCounterType nesting_;
   SourceCodeCache extensions_cache_;
+  SourceCodeCache experimental_natives_cache_;
   // This is for delete, not delete[].
   List<char*>* delete_these_non_arrays_on_tear_down_;
   // This is for delete[]
@@ -105,29 +105,35 @@ BUILTIN_LIST_C(DEF_ARG_TYPE)
 
 #ifdef DEBUG
 
-#define BUILTIN(name)                                            \
-  MUST_USE_RESULT static Object* Builtin_Impl_##name(            \
-      name##ArgumentsType args, Isolate* isolate);               \
-  MUST_USE_RESULT static Object* Builtin_##name(                 \
-      int args_length, Object** args_object, Isolate* isolate) { \
-    name##ArgumentsType args(args_length, args_object);          \
-    args.Verify();                                               \
-    return Builtin_Impl_##name(args, isolate);                   \
-  }                                                              \
-  MUST_USE_RESULT static Object* Builtin_Impl_##name(            \
+#define BUILTIN(name)                                                   \
+  MUST_USE_RESULT static Object* Builtin_Impl_##name(                   \
+      name##ArgumentsType args, Isolate* isolate);                      \
+  static RuntimeCallCounterId Builtin_Counter_##name = {"Builtin_" #name, \
+                                                        0};             \
+  MUST_USE_RESULT static Object* Builtin_##name(                        \
+      int args_length, Object** args_object, Isolate* isolate) {        \
+    RuntimeCallTimerScope timer(isolate, &Builtin_Counter_##name);      \
+    name##ArgumentsType args(args_length, args_object);                 \
+    args.Verify();                                                      \
+    return Builtin_Impl_##name(args, isolate);                          \
+  }                                                                     \
+  MUST_USE_RESULT static Object* Builtin_Impl_##name(                   \
       name##ArgumentsType args, Isolate* isolate)
 
 #else  // For release mode.
 
-#define BUILTIN(name)                                            \
-  static Object* Builtin_impl##name(                             \
-      name##ArgumentsType args, Isolate* isolate);               \
-  static Object* Builtin_##name(                                 \
-      int args_length, Object** args_object, Isolate* isolate) { \
-    name##ArgumentsType args(args_length, args_object);          \
-    return Builtin_impl##name(args, isolate);                    \
-  }                                                              \
-  static Object* Builtin_impl##name(                             \
+#define BUILTIN(name)                                                   \
+  static Object* Builtin_impl##name(                                    \
+      name##ArgumentsType args, Isolate* isolate);                      \
+  static RuntimeCallCounterId Builtin_Counter_##name = {"Builtin_" #name, \
+                                                        0};             \
+  static Object* Builtin_##name(                                        \
+      int args_length, Object** args_object, Isolate* isolate) {        \
+    RuntimeCallTimerScope timer(isolate, &Builtin_Counter_##name);      \
+    name##ArgumentsType args(args_length, args_object);                 \
+    return Builtin_impl##name(args, isolate);                           \
+  }                                                                     \
+  static Object* Builtin_impl##name(                                    \
       name##ArgumentsType args, Isolate* isolate)
 #endif
 
@@ -559,6 +565,36 @@ BUILTIN(ArrayUnshift) {
 }
 
 
+// Arrays at least this long are copied by sharing their backing store as
+// a copy-on-write array. For shorter ones the copy is cheap, and the first
+// write to a copy-on-write array leaves the fast paths of ICs and
+// optimized code.
+static const int kMinLengthForCopyOnWriteCopy = 64;
+
+
+// Returns a new array with the elements of {array}, sharing its backing
+// store as a copy-on-write array if possible. Otherwise returns an empty
+// handle. The copy-on-write array is copied by the first write to either
+// array, see JSObject::EnsureWritableFastElements.
+static MaybeHandle<JSArray> ShareCopyOnWriteElements(Isolate* isolate,
+                                                     Handle<JSArray> array,
+                                                     ElementsKind kind) {
+  Heap* heap = isolate->heap();
+  int len = Smi::cast(array->length())->value();
+  if (len < kMinLengthForCopyOnWriteCopy) return MaybeHandle<JSArray>();
+  if (!IsFastSmiOrObjectElementsKind(kind)) return MaybeHandle<JSArray>();
+  Handle<FixedArray> elms(FixedArray::cast(array->elements()), isolate);
+  // Don't keep the slack of the backing store alive in both arrays.
+  if (elms->length() != len) return MaybeHandle<JSArray>();
+  if (elms->map() == heap->fixed_array_map()) {
+    elms->set_map_no_write_barrier(heap->fixed_cow_array_map());
+  } else if (elms->map() != heap->fixed_cow_array_map()) {
+    return MaybeHandle<JSArray>();
+  }
+  return isolate->factory()->NewJSArrayWithElements(elms, kind, len);
+}
+
+
 BUILTIN(ArraySlice) {
   HandleScope scope(isolate);
   Heap* heap = isolate->heap();
@@ -688,6 +724,14 @@ BUILTIN(ArraySlice) {
     }
   }
 
+  if (k == 0 && result_len == len && receiver->IsJSArray()) {
+    Handle<JSArray> shared;
+    if (ShareCopyOnWriteElements(isolate, Handle<JSArray>::cast(receiver),
+                                 kind).ToHandle(&shared)) {
+      return *shared;
+    }
+  }
+
   Handle<JSArray> result_array =
       isolate->factory()->NewJSArray(kind, result_len, result_len);
 
@@ -970,6 +1014,15 @@ BUILTIN(ArrayConcat) {
     if (is_holey) elements_kind = GetHoleyElementsKind(elements_kind);
   }
 
+  // Concatenating a single array copies it.
+  if (n_arguments == 1) {
+    Handle<JSArray> shared;
+    if (ShareCopyOnWriteElements(isolate, args.at<JSArray>(0), elements_kind)
+            .ToHandle(&shared)) {
+      return *shared;
+    }
+  }
+
   // If a double array is concatted into a fast elements array, the fast
   // elements array needs to be initialized to contain proper holes, since
   // boxing doubles may cause incremental marking.
@@ -1004,6 +1057,139 @@ BUILTIN(ArrayConcat) {
 }
 
 
+// Whether strict equality with value can be decided by the search over packed
+// elements below. SIMD values are compared by the generic path.
+static bool IsPackedElementsSearchable(Object* value) {
+  return value->IsNumber() || value->IsString() || value->IsOddball() ||
+         value->IsSymbol() || value->IsSpecObject();
+}
+
+
+// Returns the first index from first towards last, both inclusive, at which
+// the packed elements of array hold a value strictly equal to value, or -1.
+// The loops over Smi and double elements are plain compares on the backing
+// store, which the C++ compiler is free to vectorize.
+static int SearchPackedElements(JSArray* array, Object* value, int first,
+                                int last) {
+  DisallowHeapAllocation no_gc;
+  DCHECK(IsFastPackedElementsKind(array->GetElementsKind()));
+  DCHECK(IsPackedElementsSearchable(value));
+  int step = first <= last ? 1 : -1;
+  int end = last + step;
+  ElementsKind kind = array->GetElementsKind();
+  if (IsFastDoubleElementsKind(kind)) {
+    if (!value->IsNumber()) return -1;
+    // NaN compares unequal to everything, as it does for strict equality.
+    double number = value->Number();
+    FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+    for (int i = first; i != end; i += step) {
+      if (elements->get_scalar(i) == number) return i;
+    }
+    return -1;
+  }
+  FixedArray* elements = FixedArray::cast(array->elements());
+  if (value->IsNumber()) {
+    double number = value->Number();
+    if (IsFastSmiElementsKind(kind)) {
+      // Only a Smi with the same value can match, so compare pointers.
+      if (number == 0) number = 0;  // -0 matches 0.
+      if (!IsInt32Double(number) || !Smi::IsValid(FastD2I(number))) return -1;
+      Object* smi = Smi::FromInt(FastD2I(number));
+      for (int i = first; i != end; i += step) {
+        if (elements->get(i) == smi) return i;
+      }
+      return -1;
+    }
+    for (int i = first; i != end; i += step) {
+      Object* element = elements->get(i);
+      if (element->IsNumber() && element->Number() == number) return i;
+    }
+    return -1;
+  }
+  if (IsFastSmiElementsKind(kind)) return -1;
+  if (value->IsString()) {
+    // Distinct internalized strings are never equal, which String::Equals
+    // checks before comparing contents.
+    String* string = String::cast(value);
+    for (int i = first; i != end; i += step) {
+      Object* element = elements->get(i);
+      if (element == string ||
+          (element->IsString() && String::cast(element)->Equals(string))) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  // Oddballs, symbols and objects are equal only to themselves.
+  for (int i = first; i != end; i += step) {
+    if (elements->get(i) == value) return i;
+  }
+  return -1;
+}
+
+
+// Returns the receiver if indexOf and lastIndexOf can search it without
+// running user code, i.e. for arrays with packed elements and a Smi or
+// undefined start index. Otherwise returns NULL.
+static JSArray* GetPackedArrayToSearch(
+    BuiltinArguments<NO_EXTRA_ARGUMENTS>* args) {
+  Object* receiver = (*args)[0];
+  if (!receiver->IsJSArray()) return NULL;
+  JSArray* array = JSArray::cast(receiver);
+  if (!IsFastPackedElementsKind(array->GetElementsKind())) return NULL;
+  if (args->length() > 1 && !IsPackedElementsSearchable((*args)[1])) {
+    return NULL;
+  }
+  if (args->length() > 2 && !(*args)[2]->IsSmi() &&
+      !(*args)[2]->IsUndefined()) {
+    return NULL;
+  }
+  return array;
+}
+
+
+BUILTIN(ArrayIndexOf) {
+  HandleScope scope(isolate);
+  JSArray* array = GetPackedArrayToSearch(&args);
+  if (array == NULL) return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+
+  DisallowHeapAllocation no_gc;
+  Heap* heap = isolate->heap();
+  int len = Smi::cast(array->length())->value();
+  Object* value = args.length() > 1 ? args[1] : heap->undefined_value();
+  int start = 0;
+  if (args.length() > 2 && args[2]->IsSmi()) {
+    start = Smi::cast(args[2])->value();
+    // A negative start index counts from the end of the array.
+    if (start < 0) start = Max(len + start, 0);
+  }
+  if (start >= len) return Smi::FromInt(-1);
+  return Smi::FromInt(SearchPackedElements(array, value, start, len - 1));
+}
+
+
+BUILTIN(ArrayLastIndexOf) {
+  HandleScope scope(isolate);
+  JSArray* array = GetPackedArrayToSearch(&args);
+  if (array == NULL) return CallJsBuiltin(isolate, "ArrayLastIndexOf", args);
+
+  DisallowHeapAllocation no_gc;
+  Heap* heap = isolate->heap();
+  int len = Smi::cast(array->length())->value();
+  Object* value = args.length() > 1 ? args[1] : heap->undefined_value();
+  int start = len - 1;
+  if (args.length() > 2) {
+    // An undefined start index converts to 0.
+    start = args[2]->IsSmi() ? Smi::cast(args[2])->value() : 0;
+    // A negative start index counts from the end of the array.
+    if (start < 0) start += len;
+    if (start >= len) start = len - 1;
+  }
+  if (start < 0) return Smi::FromInt(-1);
+  return Smi::FromInt(SearchPackedElements(array, value, start, 0));
+}
+
+
 // -----------------------------------------------------------------------------
 // Generator and strict mode poison pills
 
@@ -1615,6 +1801,16 @@ const char* Builtins::Lookup(byte* pc) {
 }
 
 
+intptr_t Builtins::SizeOfCode() {
+  DCHECK(initialized_);
+  intptr_t size = 0;
+  for (int i = 0; i < builtin_count; i++) {
+    size += Code::cast(builtins_[i])->Size();
+  }
+  return size;
+}
+
+
 void Builtins::Generate_InterruptCheck(MacroAssembler* masm) {
   masm->TailCallRuntime(Runtime::kInterrupt, 0, 1);
 }
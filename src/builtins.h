@@ -53,6 +53,8 @@ enum BuiltinExtraArguments {
   V(ArraySlice, NO_EXTRA_ARGUMENTS)                                 \
   V(ArraySplice, NO_EXTRA_ARGUMENTS)                                \
   V(ArrayConcat, NO_EXTRA_ARGUMENTS)                                \
+  V(ArrayIndexOf, NO_EXTRA_ARGUMENTS)                               \
+  V(ArrayLastIndexOf, NO_EXTRA_ARGUMENTS)                           \
                                                                     \
   V(HandleApiCall, NEEDS_CALLED_FUNCTION)                           \
   V(HandleApiCallConstruct, NEEDS_CALLED_FUNCTION)                  \
@@ -213,6 +215,9 @@ class Builtins {
   // Disassembler support.
   const char* Lookup(byte* pc);
 
+  // Returns the total size of the builtins' code objects.
+  intptr_t SizeOfCode();
+
   enum Name {
 #define DEF_ENUM_C(name, ignore) k##name,
 #define DEF_ENUM_A(name, kind, state, extra) k##name,
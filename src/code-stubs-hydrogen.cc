@@ -562,7 +562,10 @@ HLoadNamedField* CodeStubGraphBuilderBase::BuildLoadNamedField(
   HObjectAccess access = index.is_inobject()
       ? HObjectAccess::ForObservableJSObjectOffset(offset, representation)
       : HObjectAccess::ForBackingStoreOffset(offset, representation);
-  if (index.is_double()) {
+  if (index.is_unboxed_double()) {
+    // The double value is stored in the object itself.
+    access = HObjectAccess::ForUnboxedDoubleField(offset);
+  } else if (index.is_double()) {
     // Load the heap number.
     object = Add<HLoadNamedField>(
         object, static_cast<HValue*>(NULL),
@@ -728,7 +731,10 @@ void CodeStubGraphBuilderBase::BuildStoreNamedField(
           ? HObjectAccess::ForObservableJSObjectOffset(offset, representation)
           : HObjectAccess::ForBackingStoreOffset(offset, representation);
 
-  if (representation.IsDouble()) {
+  if (index.is_unboxed_double()) {
+    // Store the raw double, the map is updated separately on transitions.
+    access = HObjectAccess::ForUnboxedDoubleField(offset);
+  } else if (representation.IsDouble()) {
     HObjectAccess heap_number_access =
         access.WithRepresentation(Representation::Tagged());
     if (transition_to_field) {
@@ -18,7 +18,7 @@ namespace internal {
 static const int kScriptGenerations = 5;
 static const int kEvalGlobalGenerations = 2;
 static const int kEvalContextualGenerations = 2;
-static const int kRegExpGenerations = 2;
+// The number of RegExp generations is set by --regexp-cache-generations.
 
 // Initial size of each compilation cache table allocated.
 static const int kInitialCacheSize = 64;
@@ -29,17 +29,24 @@ CompilationCache::CompilationCache(Isolate* isolate)
       script_(isolate, kScriptGenerations),
       eval_global_(isolate, kEvalGlobalGenerations),
       eval_contextual_(isolate, kEvalContextualGenerations),
-      reg_exp_(isolate, kRegExpGenerations),
+      reg_exp_(isolate, Max(1, FLAG_regexp_cache_generations)),
+      parser_data_next_(0),
       enabled_(true) {
   CompilationSubCache* subcaches[kSubCacheCount] =
     {&script_, &eval_global_, &eval_contextual_, &reg_exp_};
   for (int i = 0; i < kSubCacheCount; ++i) {
     subcaches_[i] = subcaches[i];
   }
+  for (int i = 0; i < kParserDataCacheSize; ++i) {
+    parser_data_sources_[i] = NULL;
+    parser_data_[i] = NULL;
+  }
 }
 
 
-CompilationCache::~CompilationCache() {}
+CompilationCache::~CompilationCache() {
+  for (int i = 0; i < kParserDataCacheSize; ++i) delete parser_data_[i];
+}
 
 
 Handle<CompilationCacheTable> CompilationSubCache::GetTable(int generation) {
@@ -388,10 +395,49 @@ void CompilationCache::PutRegExp(Handle<String> source,
 }
 
 
+ScriptData* CompilationCache::LookupParserData(Handle<String> source) {
+  if (!IsEnabled() || !FLAG_cache_parser_data) return NULL;
+
+  for (int i = 0; i < kParserDataCacheSize; i++) {
+    Object* entry = parser_data_sources_[i];
+    if (entry->IsString() && source->Equals(String::cast(entry))) {
+      return parser_data_[i];
+    }
+  }
+  return NULL;
+}
+
+
+void CompilationCache::PutParserData(Handle<String> source,
+                                     ScriptData* data) {
+  if (!IsEnabled() || !FLAG_cache_parser_data) {
+    delete data;
+    return;
+  }
+
+  int index = parser_data_next_;
+  parser_data_next_ = (parser_data_next_ + 1) % kParserDataCacheSize;
+  delete parser_data_[index];
+  parser_data_sources_[index] = *source;
+  parser_data_[index] = data;
+}
+
+
+void CompilationCache::ClearParserData() {
+  for (int i = 0; i < kParserDataCacheSize; i++) {
+    parser_data_sources_[i] = isolate()->heap()->undefined_value();
+    delete parser_data_[i];
+    parser_data_[i] = NULL;
+  }
+  parser_data_next_ = 0;
+}
+
+
 void CompilationCache::Clear() {
   for (int i = 0; i < kSubCacheCount; i++) {
     subcaches_[i]->Clear();
   }
+  ClearParserData();
 }
 
 
@@ -399,6 +445,8 @@ void CompilationCache::Iterate(ObjectVisitor* v) {
   for (int i = 0; i < kSubCacheCount; i++) {
     subcaches_[i]->Iterate(v);
   }
+  v->VisitPointers(&parser_data_sources_[0],
+                   &parser_data_sources_[kParserDataCacheSize]);
 }
 
 
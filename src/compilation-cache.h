@@ -8,6 +8,8 @@
 namespace v8 {
 namespace internal {
 
+class ScriptData;
+
 // The compilation cache consists of several generational sub-caches which uses
 // this class as a base class. A sub-cache contains a compilation cache tables
 // for each generation of the sub-cache. Since the same source code string has
@@ -188,6 +190,15 @@ class CompilationCache {
                  JSRegExp::Flags flags,
                  Handle<FixedArray> data);
 
+  // Returns the preparse data recorded for an earlier compilation of an
+  // equal source string, or NULL. The data stays owned by the cache.
+  ScriptData* LookupParserData(Handle<String> source);
+
+  // Associate the source string with preparse data produced while
+  // compiling it. The cache takes ownership of the data and may evict
+  // older entries to make room.
+  void PutParserData(Handle<String> source, ScriptData* data);
+
   // Clear the cache - also used to initialize the cache at startup.
   void Clear();
 
@@ -217,6 +228,12 @@ class CompilationCache {
   // The number of sub caches covering the different types to cache.
   static const int kSubCacheCount = 4;
 
+  // The number of sources for which preparse data is retained. The sources
+  // are held strongly, so this bounds the memory kept alive by the cache.
+  static const int kParserDataCacheSize = 8;
+
+  void ClearParserData();
+
   bool IsEnabled() { return FLAG_compilation_cache && enabled_; }
 
   Isolate* isolate() { return isolate_; }
@@ -229,6 +246,11 @@ class CompilationCache {
   CompilationCacheRegExp reg_exp_;
   CompilationSubCache* subcaches_[kSubCacheCount];
 
+  // Preparse data keyed by source string, replaced round-robin.
+  Object* parser_data_sources_[kParserDataCacheSize];
+  ScriptData* parser_data_[kParserDataCacheSize];
+  int parser_data_next_;
+
   // Current enable state of the compilation cache.
   bool enabled_;
 
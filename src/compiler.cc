@@ -6,6 +6,7 @@
 
 #include "src/compiler.h"
 
+#include "src/asm-validator.h"
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
@@ -25,6 +26,7 @@
 #include "src/scanner-character-streams.h"
 #include "src/scopeinfo.h"
 #include "src/scopes.h"
+#include "src/type-feedback-vector-inl.h"
 #include "src/typing.h"
 #include "src/vm-state-inl.h"
 
@@ -146,6 +148,7 @@ void CompilationInfo::Initialize(Isolate* isolate,
   global_scope_ = NULL;
   extension_ = NULL;
   cached_data_ = NULL;
+  eager_function_positions_ = NULL;
   compile_options_ = ScriptCompiler::kNoCompileOptions;
   zone_ = zone;
   deferred_handles_ = NULL;
@@ -157,6 +160,7 @@ void CompilationInfo::Initialize(Isolate* isolate,
   for (int i = 0; i < DependentCode::kGroupCount; i++) {
     dependencies_[i] = NULL;
   }
+  field_type_dependencies_ = 0;
   if (mode == STUB) {
     mode_ = STUB;
     return;
@@ -203,6 +207,14 @@ CompilationInfo::~CompilationInfo() {
 
 
 void CompilationInfo::CommitDependencies(Handle<Code> code) {
+  // Let the code only be deoptimized for the fields it actually depends on.
+  // Without deoptimization data it depends on all fields of its owners.
+  if (field_type_dependencies_ != 0 &&
+      code->kind() == Code::OPTIMIZED_FUNCTION &&
+      code->deoptimization_data()->length() != 0) {
+    DeoptimizationInputData::cast(code->deoptimization_data())
+        ->SetFieldTypeDependencies(Smi::FromInt(field_type_dependencies_));
+  }
   for (int i = 0; i < DependentCode::kGroupCount; i++) {
     ZoneList<Handle<HeapObject> >* group_objects = dependencies_[i];
     if (group_objects == NULL) continue;
@@ -287,6 +299,7 @@ void CompilationInfo::PrepareForCompilation(Scope* scope) {
   if (feedback_vector_.is_null()) {
     // Allocate the feedback vector too.
     feedback_vector_ = isolate()->factory()->NewTypeFeedbackVector(length);
+    feedback_vector_->ResetCounters();
   }
   DCHECK(feedback_vector_->length() == length);
 }
@@ -337,7 +350,8 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
   DCHECK(!info()->shared_info()->optimization_disabled());
 
   // Do not use crankshaft if we need to be able to set break points.
-  if (isolate()->DebuggerHasBreakPoints()) {
+  if (isolate()->DebuggerHasBreakPoints() ||
+      info()->shared_info()->HasDebugInfo()) {
     return RetryOptimization(kDebuggerHasBreakPoints);
   }
 
@@ -346,6 +360,7 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
   const int kMaxOptCount =
       FLAG_deopt_every_n_times == 0 ? FLAG_max_opt_count : 1000;
   if (info()->opt_count() > kMaxOptCount) {
+    isolate()->counters()->max_opt_count_reached()->Increment();
     return AbortOptimization(kOptimizedTooManyTimes);
   }
 
@@ -372,6 +387,19 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     return AbortOptimization(kFunctionWithIllegalRedeclaration);
   }
 
+  // Functions of an asm.js module that fail validation lose their asm.js
+  // status and take the regular tiering path based on type feedback.
+  if (FLAG_turbo_asm && info()->shared_info()->asm_function() &&
+      !AsmValidator::Validate(info()->function(), info()->zone())) {
+    if (FLAG_trace_opt) {
+      PrintF("[asm.js validation failed for ");
+      info()->closure()->ShortPrint();
+      PrintF("]\n");
+    }
+    info()->shared_info()->set_asm_function(false);
+    return RetryOptimization(kAsmFunctionValidationFailed);
+  }
+
   // Check the whitelist for Crankshaft.
   if (!info()->closure()->PassesFilter(FLAG_hydrogen_filter)) {
     return AbortOptimization(kHydrogenFilter);
@@ -401,12 +429,11 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
   // Check the whitelist for TurboFan.
   if ((FLAG_turbo_asm && info()->shared_info()->asm_function()) ||
       info()->closure()->PassesFilter(FLAG_turbo_filter)) {
-    compiler::Pipeline pipeline(info());
-    pipeline.GenerateCode();
-    if (!info()->code().is_null()) {
-      if (FLAG_turbo_deoptimization) {
-        info()->context()->native_context()->AddOptimizedCode(*info()->code());
-      }
+    Timer t(this, &time_taken_to_create_graph_);
+    compiler::Pipeline* pipeline =
+        new (info()->zone()) compiler::Pipeline(info());
+    if (pipeline->CreateGraph()) {
+      pipeline_ = pipeline;
       return SetLastStatus(SUCCEEDED);
     }
   }
@@ -451,12 +478,11 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
   DisallowCodeDependencyChange no_dependency_change;
 
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
-    return last_status();
+  Timer t(this, &time_taken_to_optimize_);
+  if (pipeline_ != NULL) {
+    return SetLastStatus(pipeline_->OptimizeGraph() ? SUCCEEDED : BAILED_OUT);
   }
 
-  Timer t(this, &time_taken_to_optimize_);
   DCHECK(graph_ != NULL);
   BailoutReason bailout_reason = kNoReason;
 
@@ -473,10 +499,21 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
 
 OptimizedCompileJob::Status OptimizedCompileJob::GenerateCode() {
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
+  if (pipeline_ != NULL) {
+    {  // Scope for timer.
+      Timer timer(this, &time_taken_to_codegen_);
+      if (pipeline_->FinalizeCode().is_null()) {
+        if (info()->bailout_reason() == kNoReason) {
+          return AbortOptimization(kCodeGenerationFailed);
+        }
+        return SetLastStatus(BAILED_OUT);
+      }
+    }
     RecordOptimizationStats();
-    return last_status();
+    if (FLAG_turbo_deoptimization) {
+      info()->context()->native_context()->AddOptimizedCode(*info()->code());
+    }
+    return SetLastStatus(SUCCEEDED);
   }
 
   DCHECK(!info()->HasAbortedDueToDependencyChange());
@@ -659,6 +696,10 @@ MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
   // Parse and update CompilationInfo with the results.
   if (!Parser::Parse(info)) return MaybeHandle<Code>();
   Handle<SharedFunctionInfo> shared = info->shared_info();
+  if (shared->code_flushed()) {
+    info->isolate()->counters()->code_flushed_recompiled()->Increment();
+    shared->set_code_flushed(false);
+  }
   FunctionLiteral* lit = info->function();
   shared->set_strict_mode(lit->strict_mode());
   SetExpectedNofPropertiesFromEstimate(shared, lit->expected_property_count());
@@ -761,6 +802,7 @@ static bool GetOptimizedCodeNow(CompilationInfo* info) {
 
   // Success!
   DCHECK(!info->isolate()->has_pending_exception());
+  info->isolate()->counters()->optimized_functions()->Increment();
   InsertCodeIntoOptimizedCodeMap(info);
   RecordFunctionCompilation(Logger::LAZY_COMPILE_TAG, info,
                             info->shared_info());
@@ -1198,6 +1240,23 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
     }
     script->set_is_shared_cross_origin(is_shared_cross_origin);
 
+    // Scripts compiled without explicit cache options may still reuse the
+    // preparse data of an earlier compilation of the same source, e.g. when
+    // the script cache missed because of a different origin or context.
+    ScriptData* parser_data = NULL;
+    bool use_parser_data_cache =
+        FLAG_cache_parser_data && extension == NULL &&
+        natives != NATIVES_CODE &&
+        compile_options == ScriptCompiler::kNoCompileOptions &&
+        source_length > FLAG_min_preparse_length;
+    if (use_parser_data_cache) {
+      parser_data = compilation_cache->LookupParserData(source);
+      cached_data = &parser_data;
+      compile_options = parser_data != NULL
+                            ? ScriptCompiler::kConsumeParserCache
+                            : ScriptCompiler::kProduceParserCache;
+    }
+
     // Compile the function and add it to the cache.
     CompilationInfoWithZone info(script);
     info.MarkAsGlobal();
@@ -1225,6 +1284,16 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
       }
     }
 
+    if (use_parser_data_cache &&
+        compile_options == ScriptCompiler::kProduceParserCache &&
+        parser_data != NULL) {
+      if (result.is_null()) {
+        delete parser_data;
+      } else {
+        compilation_cache->PutParserData(source, parser_data);
+      }
+    }
+
     if (result.is_null()) isolate->ReportPendingMessages();
   } else if (result->ic_age() != isolate->heap()->global_ic_age()) {
     result->ResetForNewContext(isolate->heap()->global_ic_age());
@@ -1233,6 +1302,52 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
 }
 
 
+ScriptData* Compiler::SerializeCompiledFunctions(
+    Handle<SharedFunctionInfo> toplevel) {
+  Isolate* isolate = toplevel->GetIsolate();
+  DCHECK(toplevel->is_toplevel());
+  Handle<Script> old_script(Script::cast(toplevel->script()), isolate);
+  Handle<String> source(String::cast(old_script->source()), isolate);
+
+  // Collect the functions of the script that have been compiled so far,
+  // identified by their start position.
+  List<int> positions;
+  {
+    HeapIterator iterator(isolate->heap());
+    for (HeapObject* obj = iterator.next(); obj != NULL;
+         obj = iterator.next()) {
+      if (!obj->IsSharedFunctionInfo()) continue;
+      SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+      if (shared->script() != *old_script || shared->is_toplevel()) continue;
+      if (shared->is_compiled()) positions.Add(shared->start_position());
+    }
+  }
+
+  // Compile a fresh copy of the script in which those functions are compiled
+  // eagerly, with clean ICs and type feedback.
+  Handle<Script> script = isolate->factory()->NewScript(source);
+  script->set_name(old_script->name());
+  script->set_line_offset(old_script->line_offset());
+  script->set_column_offset(old_script->column_offset());
+  script->set_is_shared_cross_origin(old_script->is_shared_cross_origin());
+
+  CompilationInfoWithZone info(script);
+  info.MarkAsGlobal();
+  info.SetContext(isolate->native_context());
+  info.SetEagerFunctionPositions(&positions);
+  info.PrepareForSerializing();
+  if (FLAG_use_strict) info.SetStrictMode(STRICT);
+
+  Handle<SharedFunctionInfo> result = CompileToplevel(&info);
+  if (result.is_null()) {
+    isolate->clear_pending_exception();
+    return NULL;
+  }
+  HistogramTimerScope timer(isolate->counters()->compile_serialize());
+  return CodeSerializer::Serialize(isolate, result, source, true);
+}
+
+
 Handle<SharedFunctionInfo> Compiler::CompileStreamedScript(
     CompilationInfo* info, int source_length) {
   Isolate* isolate = info->isolate();
@@ -1240,9 +1355,35 @@ Handle<SharedFunctionInfo> Compiler::CompileStreamedScript(
   isolate->counters()->total_compile_size()->Increment(source_length);
 
   if (FLAG_use_strict) info->SetStrictMode(STRICT);
+
+  // The source has already been parsed on the background thread while it was
+  // streamed in. If an equal script was compiled before, only the lookup is
+  // left to do on the main thread.
+  Handle<Script> script = info->script();
+  Handle<String> source(String::cast(script->source()), isolate);
+  Handle<Object> script_name;
+  if (!script->name()->IsUndefined()) {
+    script_name = handle(script->name(), isolate);
+  }
+  CompilationCache* compilation_cache = isolate->compilation_cache();
+  Handle<SharedFunctionInfo> result;
+  if (compilation_cache->LookupScript(
+          source, script_name, script->line_offset()->value(),
+          script->column_offset()->value(), script->is_shared_cross_origin(),
+          info->context()).ToHandle(&result)) {
+    if (result->ic_age() != isolate->heap()->global_ic_age()) {
+      result->ResetForNewContext(isolate->heap()->global_ic_age());
+    }
+    return result;
+  }
+
   // TODO(marja): FLAG_serialize_toplevel is not honoured and won't be; when the
   // real code caching lands, streaming needs to be adapted to use it.
-  return CompileToplevel(info);
+  result = CompileToplevel(info);
+  if (!result.is_null() && !result->dont_cache()) {
+    compilation_cache->PutScript(source, info->context(), result);
+  }
+  return result;
 }
 
 
@@ -1380,9 +1521,10 @@ Handle<Code> Compiler::GetConcurrentlyOptimizedCode(OptimizedCompileJob* job) {
       job->RetryOptimization(kOptimizationDisabled);
     } else if (info->HasAbortedDueToDependencyChange()) {
       job->RetryOptimization(kBailedOutDueToDependencyChange);
-    } else if (isolate->DebuggerHasBreakPoints()) {
+    } else if (isolate->DebuggerHasBreakPoints() || shared->HasDebugInfo()) {
       job->RetryOptimization(kDebuggerHasBreakPoints);
     } else if (job->GenerateCode() == OptimizedCompileJob::SUCCEEDED) {
+      isolate->counters()->optimized_functions()->Increment();
       RecordFunctionCompilation(Logger::LAZY_COMPILE_TAG, info.get(), shared);
       if (info->shared_info()->SearchOptimizedCodeMap(
               info->context()->native_context(), info->osr_ast_id()) == -1) {
@@ -1410,7 +1552,8 @@ Handle<Code> Compiler::GetConcurrentlyOptimizedCode(OptimizedCompileJob* job) {
 bool Compiler::DebuggerWantsEagerCompilation(CompilationInfo* info,
                                              bool allow_lazy_without_ctx) {
   return LiveEditFunctionTracker::IsActive(info->isolate()) ||
-         (info->isolate()->DebuggerHasBreakPoints() && !allow_lazy_without_ctx);
+         (info->isolate()->debug()->has_break_points() &&
+          !allow_lazy_without_ctx);
 }
 
 
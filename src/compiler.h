@@ -114,6 +114,9 @@ class CompilationInfo {
   HydrogenCodeStub* code_stub() const {return code_stub_; }
   v8::Extension* extension() const { return extension_; }
   ScriptData** cached_data() const { return cached_data_; }
+  const List<int>* eager_function_positions() const {
+    return eager_function_positions_;
+  }
   ScriptCompiler::CompileOptions compile_options() const {
     return compile_options_;
   }
@@ -213,8 +216,8 @@ class CompilationInfo {
   bool is_toplevel() const { return GetFlag(kToplevel); }
 
   bool IsCodePreAgingActive() const {
-    return FLAG_optimize_for_size && FLAG_age_code && !will_serialize() &&
-           !is_debug();
+    return (FLAG_optimize_for_size || FLAG_pre_age_code) && FLAG_age_code &&
+           !will_serialize() && !is_debug();
   }
 
   void SetParseRestriction(ParseRestriction restriction) {
@@ -256,6 +259,12 @@ class CompilationInfo {
   void SetContext(Handle<Context> context) {
     context_ = context;
   }
+  // Functions starting at one of the given positions are parsed and compiled
+  // eagerly, as if they were parenthesized.
+  void SetEagerFunctionPositions(const List<int>* positions) {
+    DCHECK(!is_lazy());
+    eager_function_positions_ = positions;
+  }
 
   void MarkCompilingForDebugging() { SetFlag(kCompilingForDebugging); }
   bool IsCompilingForDebugging() { return GetFlag(kCompilingForDebugging); }
@@ -314,6 +323,12 @@ class CompilationInfo {
     return dependencies_[group];
   }
 
+  // Records the descriptor index of a field whose type the code relies on,
+  // along with the kFieldTypeGroup dependency on the field owner.
+  void AddFieldTypeDependency(int descriptor) {
+    field_type_dependencies_ |= DependentCode::FieldTypeMaskFor(descriptor);
+  }
+
   void CommitDependencies(Handle<Code> code);
 
   void RollbackDependencies();
@@ -461,6 +476,7 @@ class CompilationInfo {
   v8::Extension* extension_;
   ScriptData** cached_data_;
   ScriptCompiler::CompileOptions compile_options_;
+  const List<int>* eager_function_positions_;  // Not owned.
 
   // The context of the caller for eval code, and the global context for a
   // global script. Will be a null handle otherwise.
@@ -485,6 +501,9 @@ class CompilationInfo {
 
   ZoneList<Handle<HeapObject> >* dependencies_[DependentCode::kGroupCount];
 
+  // Mask of the fields recorded by AddFieldTypeDependency.
+  int field_type_dependencies_;
+
   template<typename T>
   void SaveHandle(Handle<T> *object) {
     if (!object->is_null()) {
@@ -576,8 +595,12 @@ class HGraph;
 class HOptimizedGraphBuilder;
 class LChunk;
 
+namespace compiler {
+class Pipeline;
+}
+
 // A helper class that calls the three compilation phases in
-// Crankshaft and keeps track of its state.  The three phases
+// Crankshaft or TurboFan and keeps track of its state.  The three phases
 // CreateGraph, OptimizeGraph and GenerateAndInstallCode can either
 // fail, bail-out to the full code generator or succeed.  Apart from
 // their return value, the status of the phase last run can be checked
@@ -589,6 +612,7 @@ class OptimizedCompileJob: public ZoneObject {
         graph_builder_(NULL),
         graph_(NULL),
         chunk_(NULL),
+        pipeline_(NULL),
         last_status_(FAILED),
         awaiting_install_(false) { }
 
@@ -626,6 +650,7 @@ class OptimizedCompileJob: public ZoneObject {
   HOptimizedGraphBuilder* graph_builder_;
   HGraph* graph_;
   LChunk* chunk_;
+  compiler::Pipeline* pipeline_;  // Non-NULL if compiled with TurboFan.
   base::TimeDelta time_taken_to_create_graph_;
   base::TimeDelta time_taken_to_optimize_;
   base::TimeDelta time_taken_to_codegen_;
@@ -701,6 +726,13 @@ class Compiler : public AllStatic {
       ScriptCompiler::CompileOptions compile_options,
       NativesFlag is_natives_code);
 
+  // Produce a code cache for the script of |toplevel| that also contains
+  // unoptimized code for all functions of the script compiled so far. The
+  // script is compiled again for this, since the code that ran already has
+  // been patched with context-specific ICs.
+  static ScriptData* SerializeCompiledFunctions(
+      Handle<SharedFunctionInfo> toplevel);
+
   static Handle<SharedFunctionInfo> CompileStreamedScript(CompilationInfo* info,
                                                           int source_length);
 
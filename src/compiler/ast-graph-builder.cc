@@ -9,9 +9,11 @@
 #include "src/compiler/machine-operator.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/node-properties-inl.h"
+#include "src/compiler/osr.h"
 #include "src/full-codegen.h"
 #include "src/parser.h"
 #include "src/scopes.h"
+#include "src/type-info.h"
 
 namespace v8 {
 namespace internal {
@@ -23,11 +25,27 @@ AstGraphBuilder::AstGraphBuilder(CompilationInfo* info, JSGraph* jsgraph)
       jsgraph_(jsgraph),
       globals_(0, info->zone()),
       breakable_(NULL),
-      execution_context_(NULL) {
+      execution_context_(NULL),
+      oracle_(NULL),
+      loop_depth_(0),
+      osr_normal_entry_(NULL),
+      osr_loop_entry_found_(false) {
   InitializeAstVisitor(info->zone());
 }
 
 
+TypeFeedbackOracle* AstGraphBuilder::oracle() {
+  if (oracle_ == NULL) {
+    Handle<JSFunction> closure = info()->closure();
+    oracle_ = new (zone()) TypeFeedbackOracle(
+        handle(closure->shared()->code()),
+        handle(closure->shared()->feedback_vector()),
+        handle(closure->context()->native_context()), zone());
+  }
+  return oracle_;
+}
+
+
 Node* AstGraphBuilder::GetFunctionClosure() {
   if (!function_closure_.is_set()) {
     // Parameter -1 is special for the function closure
@@ -62,6 +80,10 @@ bool AstGraphBuilder::CreateGraph() {
   Environment env(this, scope, graph()->start());
   set_environment(&env);
 
+  // In OSR compilations only the OSR loop entry is reachable, the regular
+  // entry path is merely built to keep the visitor simple and removed below.
+  if (info()->is_osr()) osr_normal_entry_ = NewMerge();
+
   // Build node to initialize local function context.
   Node* closure = GetFunctionClosure();
   Node* outer = GetFunctionContext();
@@ -109,6 +131,12 @@ bool AstGraphBuilder::CreateGraph() {
   environment()->UpdateControlDependency(exit_control());
   graph()->SetEnd(NewNode(common()->End()));
 
+  // Cut off the regular entry path in OSR compilations.
+  if (info()->is_osr()) {
+    if (!osr_loop_entry_found_) return false;
+    return OsrHelper::RemoveNormalEntry(graph(), common(), osr_normal_entry_);
+  }
+
   return true;
 }
 
@@ -232,6 +260,16 @@ Node* AstGraphBuilder::Environment::Checkpoint(
 }
 
 
+void AstGraphBuilder::Environment::PrepareForOsrEntry() {
+  Node* start = graph()->start();
+  UpdateControlDependency(start);
+  UpdateEffectDependency(start);
+  for (int i = 0; i < static_cast<int>(values()->size()); ++i) {
+    values()->at(i) = graph()->NewNode(common()->OsrValue(i), start);
+  }
+}
+
+
 AstGraphBuilder::AstContext::AstContext(AstGraphBuilder* own,
                                         Expression::Context kind)
     : kind_(kind), owner_(own), outer_(own->ast_context()) {
@@ -452,6 +490,11 @@ void AstGraphBuilder::VisitBlock(Block* stmt) {
   if (stmt->scope() == NULL) {
     // Visit statements in the same scope, no declarations.
     VisitStatements(stmt->statements());
+  } else if (stmt->scope()->num_heap_slots() == 0) {
+    // Visit declarations and statements of a block scope whose variables
+    // all live in the stack frame.
+    VisitDeclarations(stmt->scope()->declarations());
+    VisitStatements(stmt->statements());
   } else {
     const Operator* op = javascript()->CreateBlockContext();
     Node* scope_info = jsgraph()->Constant(stmt->scope()->GetScopeInfo());
@@ -580,6 +623,7 @@ void AstGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
 
 void AstGraphBuilder::VisitDoWhileStatement(DoWhileStatement* stmt) {
   LoopBuilder while_loop(this);
+  BuildOsrLoopEntry(stmt);
   while_loop.BeginLoop();
   VisitIterationBody(stmt, &while_loop, 0);
   while_loop.EndBody();
@@ -592,6 +636,7 @@ void AstGraphBuilder::VisitDoWhileStatement(DoWhileStatement* stmt) {
 
 void AstGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
   LoopBuilder while_loop(this);
+  BuildOsrLoopEntry(stmt);
   while_loop.BeginLoop();
   VisitForTest(stmt->cond());
   Node* condition = environment()->Pop();
@@ -605,6 +650,7 @@ void AstGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
 void AstGraphBuilder::VisitForStatement(ForStatement* stmt) {
   LoopBuilder for_loop(this);
   VisitIfNotNull(stmt->init());
+  BuildOsrLoopEntry(stmt);
   for_loop.BeginLoop();
   if (stmt->cond() != NULL) {
     VisitForTest(stmt->cond());
@@ -1297,13 +1343,78 @@ void AstGraphBuilder::VisitCall(Call* expr) {
   }
 
   // Create node to perform the function call.
-  const Operator* call = javascript()->CallFunction(args->length() + 2, flags);
+  ZoneList<Handle<JSFunction> >* targets = NULL;
+  if (FLAG_turbo_inlining && FLAG_polymorphic_inlining && !possibly_eval) {
+    targets = CollectCallTargets(expr, call_type);
+  }
+  const Operator* call =
+      javascript()->CallFunction(args->length() + 2, flags, targets);
   Node* value = ProcessArguments(call, args->length() + 2);
   PrepareFrameState(value, expr->id(), ast_context()->GetStateCombine());
   ast_context()->ProduceValue(value);
 }
 
 
+// Looks up {name} along the prototype chain starting at {map} and returns
+// true if it is found as a constant function.
+static bool LookupConstantFunction(Isolate* isolate, Handle<Map> map,
+                                   Handle<String> name,
+                                   Handle<JSFunction>* target) {
+  while (!map->is_dictionary_map()) {
+    LookupResult lookup(isolate);
+    map->LookupDescriptor(NULL, *name, &lookup);
+    if (lookup.IsFound()) {
+      if (!lookup.IsConstant()) return false;
+      Object* constant = lookup.GetConstantFromMap(*map);
+      if (!constant->IsJSFunction()) return false;
+      *target = handle(JSFunction::cast(constant), isolate);
+      return true;
+    }
+    if (!map->prototype()->IsJSObject()) return false;
+    map = handle(JSObject::cast(map->prototype())->map(), isolate);
+  }
+  return false;
+}
+
+
+ZoneList<Handle<JSFunction> >* AstGraphBuilder::CollectCallTargets(
+    Call* expr, Call::CallType call_type) {
+  if (info()->closure().is_null() ||
+      info()->closure()->shared()->code()->kind() != Code::FUNCTION) {
+    return NULL;
+  }
+  ZoneList<Handle<JSFunction> >* targets =
+      new (zone()) ZoneList<Handle<JSFunction> >(kMaxCallTargets, zone());
+  if (call_type == Call::PROPERTY_CALL) {
+    // Method calls record no call feedback, but the load of the method does
+    // record the receiver maps, from which we look up the methods.
+    Property* property = expr->expression()->AsProperty();
+    if (!property->key()->IsPropertyName()) return NULL;
+    Handle<String> name = property->key()->AsLiteral()->AsPropertyName();
+    SmallMapList maps;
+    oracle()->PropertyReceiverTypes(property->PropertyFeedbackId(), name,
+                                    &maps);
+    for (int i = 0; i < maps.length(); ++i) {
+      Handle<JSFunction> target;
+      if (!LookupConstantFunction(isolate(), maps.at(i), name, &target)) {
+        continue;
+      }
+      bool found = false;
+      for (int j = 0; j < targets->length(); ++j) {
+        if (targets->at(j).is_identical_to(target)) found = true;
+      }
+      if (found) continue;
+      if (targets->length() == kMaxCallTargets) return NULL;
+      targets->Add(target, zone());
+    }
+  } else if (expr->IsUsingCallFeedbackSlot(isolate()) &&
+             oracle()->CallIsMonomorphic(expr->CallFeedbackSlot())) {
+    targets->Add(oracle()->GetCallTarget(expr->CallFeedbackSlot()), zone());
+  }
+  return targets->is_empty() ? NULL : targets;
+}
+
+
 void AstGraphBuilder::VisitCallNew(CallNew* expr) {
   VisitForValue(expr->expression());
 
@@ -1592,7 +1703,9 @@ void AstGraphBuilder::VisitIfNotNull(Statement* stmt) {
 void AstGraphBuilder::VisitIterationBody(IterationStatement* stmt,
                                          LoopBuilder* loop, int drop_extra) {
   BreakableScope scope(this, stmt, loop, drop_extra);
+  loop_depth_++;
   Visit(stmt->body());
+  loop_depth_--;
 }
 
 
@@ -1708,7 +1821,7 @@ Node* AstGraphBuilder::BuildLocalFunctionContext(Node* context, Node* closure) {
   set_current_context(context);
 
   // Allocate a new local context.
-  const Operator* op = javascript()->CreateFunctionContext();
+  const Operator* op = javascript()->CreateFunctionContext(heap_slots);
   Node* local_context = NewNode(op, closure);
   set_current_context(local_context);
 
@@ -2068,7 +2181,7 @@ Node* AstGraphBuilder::BuildStackCheck() {
               jsgraph()->ZeroConstant());
   Node* stack = NewNode(jsgraph()->machine()->LoadStackPointer());
   Node* tag = NewNode(jsgraph()->machine()->UintLessThan(), limit, stack);
-  stack_check.If(tag);
+  stack_check.If(tag, kBranchTrue);
   stack_check.Then();
   stack_check.Else();
   Node* guard = NewNode(javascript()->CallRuntime(Runtime::kStackGuard, 0));
@@ -2077,6 +2190,23 @@ Node* AstGraphBuilder::BuildStackCheck() {
 }
 
 
+void AstGraphBuilder::BuildOsrLoopEntry(IterationStatement* stmt) {
+  if (!info()->is_osr() || stmt->OsrEntryId() != info()->osr_ast_id()) return;
+
+  // TODO(turbofan): Support OSR into nested loops and inner context scopes.
+  // The former needs the outer loops peeled off, the latter would require the
+  // context chain to be reconstructed from the unoptimized frame.
+  if (loop_depth_ != 0 || current_scope() != info()->scope()) return;
+  DCHECK_EQ(0, environment()->stack_height());
+
+  // The OSR entry replaces the environment entirely, the unoptimized code has
+  // already set up the function context and keeps it in its frame.
+  environment()->PrepareForOsrEntry();
+  set_current_context(GetFunctionContext());
+  osr_loop_entry_found_ = true;
+}
+
+
 void AstGraphBuilder::PrepareFrameState(Node* node, BailoutId ast_id,
                                         OutputFrameStateCombine combine) {
   if (OperatorProperties::HasFrameStateInput(node->op())) {
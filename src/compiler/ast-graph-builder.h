@@ -13,6 +13,9 @@
 
 namespace v8 {
 namespace internal {
+
+class TypeFeedbackOracle;
+
 namespace compiler {
 
 class ControlBuilder;
@@ -108,6 +111,10 @@ class AstGraphBuilder : public StructuredGraphBuilder, public AstVisitor {
   // Builder for stack-check guards.
   Node* BuildStackCheck();
 
+  // Builder for the OSR entry into {stmt}, does nothing unless {stmt} is the
+  // loop being compiled for OSR.
+  void BuildOsrLoopEntry(IterationStatement* stmt);
+
 #define DECLARE_VISIT(type) virtual void Visit##type(type* node);
   // Visiting functions for AST nodes make this an AstVisitor.
   AST_NODE_LIST(DECLARE_VISIT)
@@ -134,6 +141,17 @@ class AstGraphBuilder : public StructuredGraphBuilder, public AstVisitor {
   SetOncePointer<Node> function_closure_;
   SetOncePointer<Node> function_context_;
 
+  // Type feedback of the unoptimized code, created on first use.
+  TypeFeedbackOracle* oracle_;
+
+  // Number of iteration statement bodies enclosing the current position.
+  int loop_depth_;
+
+  // Control node all of the regular entry path hangs off in OSR compilations,
+  // and whether the OSR entry into the loop has been built.
+  Node* osr_normal_entry_;
+  bool osr_loop_entry_found_;
+
   CompilationInfo* info() const { return info_; }
   inline StrictMode strict_mode() const;
   JSGraph* jsgraph() { return jsgraph_; }
@@ -143,6 +161,16 @@ class AstGraphBuilder : public StructuredGraphBuilder, public AstVisitor {
   // Current scope during visitation.
   inline Scope* current_scope() const;
 
+  TypeFeedbackOracle* oracle();
+
+  // Maximum number of call targets recorded for a single call site.
+  static const int kMaxCallTargets = 4;
+
+  // Collects the functions that the type feedback saw being called at {expr},
+  // or returns NULL if there is no useful feedback.
+  ZoneList<Handle<JSFunction> >* CollectCallTargets(Call* expr,
+                                                    Call::CallType call_type);
+
   // Process arguments to a call by popping {arity} elements off the operand
   // stack and build a call node using the given call operator.
   Node* ProcessArguments(const Operator* op, int arity);
@@ -266,6 +294,10 @@ class AstGraphBuilder::Environment
   // further mutation of the environment will not affect checkpoints.
   Node* Checkpoint(BailoutId ast_id, OutputFrameStateCombine combine);
 
+  // Turns this environment into the one at the OSR entry: control and effect
+  // start afresh and all values are read from the unoptimized frame.
+  void PrepareForOsrEntry();
+
  protected:
   AstGraphBuilder* builder() const {
     return reinterpret_cast<AstGraphBuilder*>(
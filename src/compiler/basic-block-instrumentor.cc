@@ -25,6 +25,7 @@ static NodeVector::iterator FindInsertionPoint(BasicBlock* block) {
     if (OperatorProperties::IsBasicBlockBegin(op)) continue;
     switch (op->opcode()) {
       case IrOpcode::kParameter:
+      case IrOpcode::kOsrValue:
       case IrOpcode::kPhi:
       case IrOpcode::kEffectPhi:
         continue;
@@ -52,12 +53,18 @@ BasicBlockProfiler::Data* BasicBlockInstrumentor::Instrument(
   size_t n_blocks = static_cast<size_t>(schedule->RpoBlockCount()) - 1;
   BasicBlockProfiler::Data* data =
       info->isolate()->GetOrCreateBasicBlockProfiler()->NewData(n_blocks);
-  // Set the function name.
-  if (!info->shared_info().is_null() &&
-      info->shared_info()->name()->IsString()) {
-    std::ostringstream os;
-    String::cast(info->shared_info()->name())->PrintUC16(os);
-    data->SetFunctionName(&os);
+  // Set the function name and position.
+  if (!info->shared_info().is_null()) {
+    Handle<SharedFunctionInfo> shared = info->shared_info();
+    if (shared->name()->IsString()) {
+      std::ostringstream os;
+      String::cast(shared->name())->PrintUC16(os);
+      data->SetFunctionName(&os);
+    }
+    if (shared->script()->IsScript()) {
+      data->SetFunction(Script::cast(shared->script())->id()->value(),
+                        shared->start_position());
+    }
   }
   // Capture the schedule string before instrumentation.
   {
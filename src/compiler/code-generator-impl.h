@@ -66,7 +66,8 @@ class InstructionOperandConverter {
 
   BasicBlock* InputBlock(int index) {
     int block_id = InputInt32(index);
-    return gen_->schedule()->GetBlockById(BasicBlock::Id::FromInt(block_id));
+    return gen_->GetJumpTarget(
+        gen_->schedule()->GetBlockById(BasicBlock::Id::FromInt(block_id)));
   }
 
   Register OutputRegister(int index = 0) {
@@ -14,6 +14,8 @@ namespace compiler {
 
 CodeGenerator::CodeGenerator(InstructionSequence* code)
     : code_(code),
+      jump_targets_(static_cast<int>(code->schedule()->BasicBlockCount()),
+                    static_cast<BasicBlock*>(NULL), code->zone()),
       current_block_(NULL),
       current_source_position_(SourcePosition::Invalid()),
       masm_(code->zone()->isolate(), NULL, 0),
@@ -22,7 +24,8 @@ CodeGenerator::CodeGenerator(InstructionSequence* code)
       deoptimization_states_(code->zone()),
       deoptimization_literals_(code->zone()),
       translations_(code->zone()),
-      last_lazy_deopt_pc_(0) {}
+      last_lazy_deopt_pc_(0),
+      osr_pc_offset_(-1) {}
 
 
 Handle<Code> CodeGenerator::GenerateCode() {
@@ -41,10 +44,26 @@ Handle<Code> CodeGenerator::GenerateCode() {
   info->set_prologue_offset(masm()->pc_offset());
   AssemblePrologue();
 
-  // Assemble all instructions.
-  for (InstructionSequence::const_iterator i = code()->begin();
-       i != code()->end(); ++i) {
-    AssembleInstruction(*i);
+  ComputeJumpTargets();
+
+  // Assemble all instructions, placing deferred blocks after all the other
+  // blocks so that the slow paths do not dilute the hot code.
+  for (int deferred = 0; deferred < 2; ++deferred) {
+    bool assemble = true;
+    Instruction* last = NULL;
+    for (InstructionSequence::const_iterator i = code()->begin();
+         i != code()->end(); ++i) {
+      Instruction* instr = *i;
+      if (instr->IsBlockStart()) {
+        BasicBlock* block = BlockStartInstruction::cast(instr)->block();
+        assemble = block->deferred() == (deferred == 1) &&
+                   !IsSkippedBlock(block, last);
+      }
+      if (assemble) {
+        AssembleInstruction(instr);
+        last = instr;
+      }
+    }
   }
 
   FinishCode(masm());
@@ -80,6 +99,57 @@ Handle<Code> CodeGenerator::GenerateCode() {
 }
 
 
+void CodeGenerator::ComputeJumpTargets() {
+  BasicBlockVector* blocks = schedule()->rpo_order();
+  for (BasicBlockVectorIter i = blocks->begin(); i != blocks->end(); ++i) {
+    BasicBlock* block = *i;
+    BasicBlock* target = block;
+    if (FLAG_turbo_jump_threading) {
+      // Follow chains of empty blocks, giving up on empty loops.
+      for (size_t steps = 0; steps < blocks->size(); ++steps) {
+        BasicBlock* next = GetEmptyBlockSuccessor(target);
+        if (next == NULL) break;
+        target = next;
+      }
+      if (GetEmptyBlockSuccessor(target) != NULL) target = block;
+    }
+    jump_targets_[block->id().ToSize()] = target;
+  }
+}
+
+
+BasicBlock* CodeGenerator::GetEmptyBlockSuccessor(BasicBlock* block) const {
+  // The start block is entered from the prologue.
+  if (block->rpo_number() == 0) return NULL;
+  if (block->control() != BasicBlock::kGoto) return NULL;
+  int last = block->last_instruction_index();
+  for (int index = block->first_instruction_index(); index < last; ++index) {
+    Instruction* instr = code()->InstructionAt(index);
+    if (instr->IsSourcePosition()) continue;
+    if (!instr->IsGapMoves()) return NULL;
+    GapInstruction* gap = GapInstruction::cast(instr);
+    for (int pos = GapInstruction::FIRST_INNER_POSITION;
+         pos <= GapInstruction::LAST_INNER_POSITION; ++pos) {
+      ParallelMove* moves =
+          gap->GetParallelMove(static_cast<GapInstruction::InnerPosition>(pos));
+      if (moves != NULL && !moves->IsRedundant()) return NULL;
+    }
+  }
+  Instruction* control = code()->InstructionAt(last);
+  ArchOpcode opcode = ArchOpcodeField::decode(control->opcode());
+  if (opcode != kArchJmp && opcode != kArchNop) return NULL;
+  return block->SuccessorAt(0);
+}
+
+
+bool CodeGenerator::IsSkippedBlock(BasicBlock* block, Instruction* last) const {
+  if (GetJumpTarget(block) == block) return false;
+  // A goto to the next block is a nop that falls through.
+  return last == NULL || !last->IsControl() ||
+         ArchOpcodeField::decode(last->opcode()) != kArchNop;
+}
+
+
 void CodeGenerator::RecordSafepoint(PointerMap* pointers, Safepoint::Kind kind,
                                     int arguments,
                                     Safepoint::DeoptMode deopt_mode) {
@@ -179,7 +249,7 @@ void CodeGenerator::AssembleGap(GapInstruction* instr) {
 void CodeGenerator::PopulateDeoptimizationData(Handle<Code> code_object) {
   CompilationInfo* info = linkage()->info();
   int deopt_count = static_cast<int>(deoptimization_states_.size());
-  if (deopt_count == 0) return;
+  if (deopt_count == 0 && !info->is_osr()) return;
   Handle<DeoptimizationInputData> data =
       DeoptimizationInputData::New(isolate(), deopt_count, TENURED);
 
@@ -209,10 +279,15 @@ void CodeGenerator::PopulateDeoptimizationData(Handle<Code> code_object) {
     data->SetLiteralArray(*literals);
   }
 
-  // No OSR in Turbofan yet...
-  BailoutId osr_ast_id = BailoutId::None();
-  data->SetOsrAstId(Smi::FromInt(osr_ast_id.ToInt()));
-  data->SetOsrPcOffset(Smi::FromInt(-1));
+  if (info->is_osr()) {
+    DCHECK(osr_pc_offset_ >= 0);
+    data->SetOsrAstId(Smi::FromInt(info->osr_ast_id().ToInt()));
+    data->SetOsrPcOffset(Smi::FromInt(osr_pc_offset_));
+  } else {
+    BailoutId osr_ast_id = BailoutId::None();
+    data->SetOsrAstId(Smi::FromInt(osr_ast_id.ToInt()));
+    data->SetOsrPcOffset(Smi::FromInt(-1));
+  }
 
   // Populate deoptimization entries.
   for (int i = 0; i < deopt_count; i++) {
@@ -32,6 +32,12 @@ class CodeGenerator FINAL : public GapResolver::Assembler {
   Linkage* linkage() const { return code()->linkage(); }
   Schedule* schedule() const { return code()->schedule(); }
 
+  // Returns the block that a jump to {block} goes to. Jumps to blocks that
+  // consist of nothing but a jump are threaded through to the final target.
+  BasicBlock* GetJumpTarget(BasicBlock* block) const {
+    return jump_targets_[block->id().ToSize()];
+  }
+
  private:
   MacroAssembler* masm() { return &masm_; }
   GapResolver* resolver() { return &resolver_; }
@@ -39,12 +45,22 @@ class CodeGenerator FINAL : public GapResolver::Assembler {
   Zone* zone() const { return code()->zone(); }
 
   // Checks if {block} will appear directly after {current_block_} when
-  // assembling code, in which case, a fall-through can be used.
+  // assembling code, in which case, a fall-through can be used. Deferred
+  // blocks are assembled after all other blocks, see GenerateCode.
   bool IsNextInAssemblyOrder(const BasicBlock* block) const {
     return block->rpo_number() == (current_block_->rpo_number() + 1) &&
            block->deferred() == current_block_->deferred();
   }
 
+  // Computes the jump targets of all blocks, see GetJumpTarget.
+  void ComputeJumpTargets();
+  // Returns the successor of {block} if it consists of nothing but a jump,
+  // or NULL otherwise.
+  BasicBlock* GetEmptyBlockSuccessor(BasicBlock* block) const;
+  // Checks if {block} can be left out of the code because all jumps to it
+  // have been threaded and {last} does not fall through into it.
+  bool IsSkippedBlock(BasicBlock* block, Instruction* last) const;
+
   // Record a safepoint with the given pointer map.
   void RecordSafepoint(PointerMap* pointers, Safepoint::Kind kind,
                        int arguments, Safepoint::DeoptMode deopt_mode);
@@ -120,6 +136,7 @@ class CodeGenerator FINAL : public GapResolver::Assembler {
   };
 
   InstructionSequence* code_;
+  ZoneVector<BasicBlock*> jump_targets_;
   BasicBlock* current_block_;
   SourcePosition current_source_position_;
   MacroAssembler masm_;
@@ -129,6 +146,7 @@ class CodeGenerator FINAL : public GapResolver::Assembler {
   ZoneDeque<Handle<Object> > deoptimization_literals_;
   TranslationBuffer translations_;
   int last_lazy_deopt_pc_;
+  int osr_pc_offset_;
 };
 
 }  // namespace compiler
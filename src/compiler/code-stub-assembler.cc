@@ -0,0 +1,77 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/code-stub-assembler.h"
+
+#include "src/compiler/pipeline.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+CodeStubAssembler::CodeStubAssembler(Graph* graph,
+                                     const CallInterfaceDescriptor& descriptor)
+    : RawMachineAssembler(graph, Linkage::GetStubCallDescriptor(
+                                     descriptor, 0, CallDescriptor::kNoFlags,
+                                     graph->zone())) {}
+
+
+Node* CodeStubAssembler::Context() {
+  return Parameter(parameter_count() - 1);
+}
+
+
+Node* CodeStubAssembler::SmiShiftBitsConstant() {
+  return IntPtrConstant(kSmiShiftSize + kSmiTagSize);
+}
+
+
+Node* CodeStubAssembler::SmiTag(Node* value) {
+  return WordShl(ConvertInt32ToIntPtr(value), SmiShiftBitsConstant());
+}
+
+
+Node* CodeStubAssembler::SmiUntag(Node* value) {
+  return ConvertIntPtrToInt32(WordSar(value, SmiShiftBitsConstant()));
+}
+
+
+Node* CodeStubAssembler::WordIsSmi(Node* object) {
+  return WordEqual(WordAnd(object, IntPtrConstant(kSmiTagMask)),
+                   IntPtrConstant(kSmiTag));
+}
+
+
+Node* CodeStubAssembler::LoadObjectField(Node* object, int offset,
+                                         MachineType rep) {
+  return Load(rep, object, IntPtrConstant(offset - kHeapObjectTag));
+}
+
+
+Node* CodeStubAssembler::LoadMap(Node* object) {
+  return LoadObjectField(object, HeapObject::kMapOffset);
+}
+
+
+Node* CodeStubAssembler::LoadInstanceType(Node* object) {
+  return LoadObjectField(LoadMap(object), Map::kInstanceTypeOffset,
+                         kMachUint8);
+}
+
+
+Node* CodeStubAssembler::LoadHeapNumberValue(Node* object) {
+  return LoadObjectField(object, HeapNumber::kValueOffset, kMachFloat64);
+}
+
+
+Handle<Code> CodeStubAssembler::GenerateCode(CompilationInfo* info) {
+  Schedule* schedule = Export();
+  Linkage linkage(info, call_descriptor());
+  Pipeline pipeline(info);
+  return pipeline.GenerateCodeForMachineGraph(&linkage, graph(), schedule);
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
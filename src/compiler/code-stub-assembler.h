@@ -0,0 +1,52 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_CODE_STUB_ASSEMBLER_H_
+#define V8_COMPILER_CODE_STUB_ASSEMBLER_H_
+
+#include "src/compiler/raw-machine-assembler.h"
+#include "src/interface-descriptors.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Builds the code of a stub that is called with the register convention of
+// a {CallInterfaceDescriptor}, using TurboFan's machine-level backend. The
+// stub is written once against the machine operators and gets the same
+// instruction selection and register allocation on every architecture.
+// The parameters are the descriptor's register parameters, followed by the
+// context.
+class CodeStubAssembler FINAL : public RawMachineAssembler {
+ public:
+  CodeStubAssembler(Graph* graph, const CallInterfaceDescriptor& descriptor);
+
+  // Returns the context parameter that every stub receives last.
+  Node* Context();
+
+  // Smi tagging.
+  Node* SmiShiftBitsConstant();
+  Node* SmiTag(Node* value);
+  Node* SmiUntag(Node* value);
+  Node* WordIsSmi(Node* object);
+
+  // Heap object access.
+  Node* LoadObjectField(Node* object, int offset,
+                        MachineType rep = kMachAnyTagged);
+  Node* LoadMap(Node* object);
+  Node* LoadInstanceType(Node* object);
+  Node* LoadHeapNumberValue(Node* object);
+
+  // Generates the stub's code. The assembler is invalid afterwards.
+  Handle<Code> GenerateCode(CompilationInfo* info);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CodeStubAssembler);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_CODE_STUB_ASSEMBLER_H_
@@ -32,6 +32,37 @@ class ControlOperator : public Operator1<int> {
 }  // namespace
 
 
+std::ostream& operator<<(std::ostream& os, BranchHint hint) {
+  switch (hint) {
+    case kBranchNone:
+      return os << "None";
+    case kBranchTrue:
+      return os << "True";
+    case kBranchFalse:
+      return os << "False";
+  }
+  UNREACHABLE();
+  return os;
+}
+
+
+// Specialization for static parameters of type {BranchHint}.
+template <>
+struct StaticParameterTraits<BranchHint> {
+  static std::ostream& PrintTo(std::ostream& os, BranchHint hint) {
+    return os << hint;
+  }
+  static int HashCode(BranchHint hint) { return static_cast<int>(hint); }
+  static bool Equals(BranchHint lhs, BranchHint rhs) { return lhs == rhs; }
+};
+
+
+BranchHint BranchHintOf(const Operator* const op) {
+  DCHECK_EQ(IrOpcode::kBranch, op->opcode());
+  return OpParameter<BranchHint>(op);
+}
+
+
 // Specialization for static parameters of type {ExternalReference}.
 template <>
 struct StaticParameterTraits<ExternalReference> {
@@ -58,7 +89,6 @@ struct StaticParameterTraits<ExternalReference> {
 #define SHARED_OP_LIST(V)               \
   V(Dead, Operator::kFoldable, 0, 0)    \
   V(End, Operator::kFoldable, 0, 1)     \
-  V(Branch, Operator::kFoldable, 1, 1)  \
   V(IfTrue, Operator::kFoldable, 0, 1)  \
   V(IfFalse, Operator::kFoldable, 0, 1) \
   V(Throw, Operator::kFoldable, 1, 1)   \
@@ -75,6 +105,16 @@ struct CommonOperatorBuilderImpl FINAL {
   Name##Operator k##Name##Operator;
   SHARED_OP_LIST(SHARED)
 #undef SHARED
+
+  template <BranchHint kHint>
+  struct BranchOperator FINAL : public Operator1<BranchHint> {
+    BranchOperator()
+        : Operator1<BranchHint>(IrOpcode::kBranch, Operator::kFoldable, 1, 0,
+                                "Branch", kHint) {}
+  };
+  BranchOperator<kBranchNone> kBranchNoneOperator;
+  BranchOperator<kBranchTrue> kBranchTrueOperator;
+  BranchOperator<kBranchFalse> kBranchFalseOperator;
 };
 
 
@@ -94,6 +134,23 @@ SHARED_OP_LIST(SHARED)
 #undef SHARED
 
 
+const Operator* CommonOperatorBuilder::Branch() { return Branch(kBranchNone); }
+
+
+const Operator* CommonOperatorBuilder::Branch(BranchHint hint) {
+  switch (hint) {
+    case kBranchNone:
+      return &impl_.kBranchNoneOperator;
+    case kBranchTrue:
+      return &impl_.kBranchTrueOperator;
+    case kBranchFalse:
+      return &impl_.kBranchFalseOperator;
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+
 const Operator* CommonOperatorBuilder::Start(int num_formal_parameters) {
   // Outputs are formal parameters, plus context, receiver, and JSFunction.
   const int value_output_count = num_formal_parameters + 3;
@@ -120,6 +177,12 @@ const Operator* CommonOperatorBuilder::Parameter(int index) {
 }
 
 
+const Operator* CommonOperatorBuilder::OsrValue(int index) {
+  return new (zone()) Operator1<int>(IrOpcode::kOsrValue, Operator::kPure, 1,
+                                     1, "OsrValue", index);
+}
+
+
 const Operator* CommonOperatorBuilder::Int32Constant(int32_t value) {
   return new (zone()) Operator1<int32_t>(
       IrOpcode::kInt32Constant, Operator::kPure, 0, 1, "Int32Constant", value);
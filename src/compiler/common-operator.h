@@ -23,6 +23,14 @@ struct CommonOperatorBuilderImpl;
 class Operator;
 
 
+// Prediction hint for branches.
+enum BranchHint { kBranchNone, kBranchTrue, kBranchFalse };
+
+std::ostream& operator<<(std::ostream&, BranchHint);
+
+BranchHint BranchHintOf(const Operator* const);
+
+
 // Flag that describes how to combine the current environment with
 // the output of a node to obtain a framestate for lazy bailout.
 class OutputFrameStateCombine {
@@ -91,6 +99,7 @@ class CommonOperatorBuilder FINAL {
   const Operator* Dead();
   const Operator* End();
   const Operator* Branch();
+  const Operator* Branch(BranchHint hint);
   const Operator* IfTrue();
   const Operator* IfFalse();
   const Operator* Throw();
@@ -100,6 +109,7 @@ class CommonOperatorBuilder FINAL {
   const Operator* Merge(int controls);
   const Operator* Loop(int controls);
   const Operator* Parameter(int index);
+  const Operator* OsrValue(int index);
 
   const Operator* Int32Constant(int32_t);
   const Operator* Int64Constant(int64_t);
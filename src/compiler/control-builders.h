@@ -49,7 +49,7 @@ class IfBuilder : public ControlBuilder {
         else_environment_(NULL) {}
 
   // Primitive control commands.
-  void If(Node* condition);
+  void If(Node* condition, BranchHint hint = kBranchNone);
   void Then();
   void Else();
   void End();
@@ -96,8 +96,8 @@ class StructuredGraphBuilder : public GraphBuilder {
   Node* NewIfFalse() { return NewNode(common()->IfFalse()); }
   Node* NewMerge() { return NewNode(common()->Merge(1)); }
   Node* NewLoop() { return NewNode(common()->Loop(1)); }
-  Node* NewBranch(Node* condition) {
-    return NewNode(common()->Branch(), condition);
+  Node* NewBranch(Node* condition, BranchHint hint = kBranchNone) {
+    return NewNode(common()->Branch(hint), condition);
   }
 
  protected:
@@ -50,6 +50,7 @@ void GraphReplayPrinter::PrintReplayOpCreator(const Operator* op) {
   PrintF("  op = %s.%s(", builder, mnemonic);
   switch (opcode) {
     case IrOpcode::kParameter:
+    case IrOpcode::kOsrValue:
     case IrOpcode::kNumberConstant:
       PrintF("0");
       break;
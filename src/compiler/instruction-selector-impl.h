@@ -43,6 +43,11 @@ class OperandGenerator {
                                      DoubleRegister::ToAllocationIndex(reg)));
   }
 
+  InstructionOperand* DefineAsSlot(Node* node, int index) {
+    return Define(node, new (zone()) UnallocatedOperand(
+                            UnallocatedOperand::FIXED_SLOT, index));
+  }
+
   InstructionOperand* DefineAsConstant(Node* node) {
     selector()->MarkAsDefined(node);
     int virtual_register = sequence()->AddConstant(node, ToConstant(node));
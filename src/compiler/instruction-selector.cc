@@ -7,6 +7,7 @@
 #include "src/compiler/instruction-selector-impl.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties-inl.h"
+#include "src/compiler/osr.h"
 #include "src/compiler/pipeline.h"
 
 namespace v8 {
@@ -467,6 +468,8 @@ void InstructionSelector::VisitNode(Node* node) {
       MarkAsRepresentation(type, node);
       return VisitParameter(node);
     }
+    case IrOpcode::kOsrValue:
+      return MarkAsReference(node), VisitOsrValue(node);
     case IrOpcode::kPhi: {
       MachineType type = OpParameter<MachineType>(node);
       MarkAsRepresentation(type, node);
@@ -834,6 +837,20 @@ void InstructionSelector::VisitParameter(Node* node) {
 }
 
 
+void InstructionSelector::VisitOsrValue(Node* node) {
+  OperandGenerator g(this);
+  OsrHelper osr_helper(linkage()->info());
+  int index = OpParameter<int>(node);
+  if (osr_helper.IsParameterIndex(index)) {
+    Emit(kArchNop, g.DefineAsLocation(node,
+                                      linkage()->GetParameterLocation(index),
+                                      kMachAnyTagged));
+  } else {
+    Emit(kArchNop, g.DefineAsSlot(node, osr_helper.SpillSlotIndexOf(index)));
+  }
+}
+
+
 void InstructionSelector::VisitPhi(Node* node) {
   // TODO(bmeurer): Emit a PhiInstruction here.
   for (InputIter i = node->inputs().begin(); i != node->inputs().end(); ++i) {
@@ -114,7 +114,6 @@ REPLACE_COMPARE_IC_CALL(JSGreaterThanOrEqual, Token::GTE, false)
   }
 REPLACE_RUNTIME_CALL(JSTypeOf, Runtime::kTypeof)
 REPLACE_RUNTIME_CALL(JSCreate, Runtime::kAbort)
-REPLACE_RUNTIME_CALL(JSCreateFunctionContext, Runtime::kNewFunctionContext)
 REPLACE_RUNTIME_CALL(JSCreateCatchContext, Runtime::kPushCatchContext)
 REPLACE_RUNTIME_CALL(JSCreateWithContext, Runtime::kPushWithContext)
 REPLACE_RUNTIME_CALL(JSCreateBlockContext, Runtime::kPushBlockContext)
@@ -326,6 +325,24 @@ void JSGenericLowering::LowerJSInstanceOf(Node* node) {
 }
 
 
+void JSGenericLowering::LowerJSCreateFunctionContext(Node* node) {
+  int slot_count = OpParameter<int>(node);
+  if (slot_count > FastNewContextStub::kMaximumSlots) {
+    ReplaceWithRuntimeCall(node, Runtime::kNewFunctionContext);
+    return;
+  }
+  // Small contexts are allocated inline in new space by the stub, which only
+  // falls back to the runtime when new space is exhausted.
+  FastNewContextStub stub(isolate(), slot_count);
+  CallInterfaceDescriptor d = stub.GetCallInterfaceDescriptor();
+  CallDescriptor* desc =
+      linkage()->GetStubCallDescriptor(d, 0, FlagsForNode(node));
+  Node* stub_code = CodeConstant(stub.GetCode());
+  PatchInsertInput(node, 0, stub_code);
+  PatchOperator(node, common()->Call(desc));
+}
+
+
 void JSGenericLowering::LowerJSLoadContext(Node* node) {
   const ContextAccess& access = ContextAccessOf(node->op());
   for (size_t i = 0; i < access.depth(); ++i) {
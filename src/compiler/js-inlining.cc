@@ -99,8 +99,8 @@ class Inlinee {
   }
 
   // Inline this graph at {call}, use {jsgraph} and its zone to create
-  // any new nodes.
-  void InlineAtCall(JSGraph* jsgraph, Node* call);
+  // any new nodes. Returns the last control node of the inlined graph.
+  Node* InlineAtCall(JSGraph* jsgraph, Node* call);
 
   // Ensure that only a single return reaches the end node.
   static void UnifyReturn(JSGraph* jsgraph);
@@ -230,7 +230,7 @@ class CopyVisitor : public NullNodeVisitor {
 };
 
 
-void Inlinee::InlineAtCall(JSGraph* jsgraph, Node* call) {
+Node* Inlinee::InlineAtCall(JSGraph* jsgraph, Node* call) {
   // The scheduler is smart enough to place our code; we just ensure {control}
   // becomes the control input of the start of the inlinee.
   Node* control = NodeProperties::GetControlInput(call);
@@ -299,8 +299,10 @@ void Inlinee::InlineAtCall(JSGraph* jsgraph, Node* call) {
   }
   call->RemoveAllInputs();
   DCHECK_EQ(0, call->UseCount());
+  Node* control_output = end_block();
   // TODO(sigurds) Remove this once we copy.
   unique_return()->RemoveAllInputs();
+  return control_output;
 }
 
 
@@ -372,11 +374,97 @@ void JSInliner::TryInlineCall(Node* call_node) {
   JSCallFunctionAccessor call(call_node);
 
   HeapObjectMatcher<JSFunction> match(call.jsfunction());
-  if (!match.HasValue()) {
+  if (match.HasValue()) {
+    TryInlineFunction(call_node, match.Value().handle());
     return;
   }
 
-  Handle<JSFunction> function = match.Value().handle();
+  const ZoneList<Handle<JSFunction> >* targets =
+      CallFunctionParametersOf(call_node->op()).targets();
+  if (FLAG_polymorphic_inlining && targets != NULL) {
+    TryInlinePolymorphicCall(call_node, targets);
+  }
+}
+
+
+void JSInliner::TryInlinePolymorphicCall(
+    Node* call_node, const ZoneList<Handle<JSFunction> >* targets) {
+  JSCallFunctionAccessor call(call_node);
+  Graph* graph = jsgraph_->graph();
+  CommonOperatorBuilder* common = jsgraph_->common();
+  SimplifiedOperatorBuilder simplified(jsgraph_->zone());
+
+  ZoneList<Handle<JSFunction> > candidates(targets->length(), info_->zone());
+  for (int i = 0; i < targets->length(); ++i) {
+    if (!targets->at(i)->shared()->native()) {
+      candidates.Add(targets->at(i), info_->zone());
+    }
+  }
+  if (candidates.is_empty()) return;
+  int const count = candidates.length();
+
+  if (FLAG_trace_turbo_inlining) {
+    PrintF("Inlining polymorphic call with %d targets into %s\n", count,
+           info_->shared_info()->DebugName()->ToCString().get());
+  }
+
+  // The uses of the call are redirected to phis at the merge of all cases.
+  // Their inputs are placeholders until the cases are built.
+  Node* const start = graph->start();
+  Node* const undefined = jsgraph_->UndefinedConstant();
+  NodeVector controls(count + 1, start, info_->zone());
+  NodeVector values(count + 1, undefined, info_->zone());
+  NodeVector effects(count + 1, start, info_->zone());
+  Node* merge =
+      graph->NewNode(common->Merge(count + 1), count + 1, &controls.front());
+  values.push_back(merge);
+  effects.push_back(merge);
+  Node* phi = graph->NewNode(common->Phi(kMachAnyTagged, count + 1),
+                             count + 2, &values.front());
+  Node* ephi = graph->NewNode(common->EffectPhi(count + 1), count + 2,
+                              &effects.front());
+  NodeProperties::ReplaceWithValue(call_node, phi, ephi);
+
+  // Compare the callee against each candidate in turn and call the candidate
+  // directly if it matches. The original call handles all other callees.
+  NodeVector inputs(info_->zone());
+  for (InputIter i = call_node->inputs().begin();
+       i != call_node->inputs().end(); ++i) {
+    inputs.push_back(*i);
+  }
+  NodeVector calls(info_->zone());
+  Node* control = NodeProperties::GetControlInput(call_node);
+  for (int i = 0; i < count; ++i) {
+    Node* target = jsgraph_->HeapConstant(candidates.at(i));
+    Node* check = graph->NewNode(simplified.ReferenceEqual(Type::Any()),
+                                 call.jsfunction(), target);
+    Node* branch = graph->NewNode(common->Branch(), check, control);
+    Node* if_true = graph->NewNode(common->IfTrue(), branch);
+    control = graph->NewNode(common->IfFalse(), branch);
+    Node* direct_call = graph->NewNode(
+        call_node->op(), static_cast<int>(inputs.size()), &inputs.front());
+    direct_call->ReplaceInput(0, target);
+    NodeProperties::ReplaceControlInput(direct_call, if_true);
+    merge->ReplaceInput(i, if_true);
+    phi->ReplaceInput(i, direct_call);
+    ephi->ReplaceInput(i, direct_call);
+    calls.push_back(direct_call);
+  }
+  NodeProperties::ReplaceControlInput(call_node, control);
+  merge->ReplaceInput(count, control);
+  phi->ReplaceInput(count, call_node);
+  ephi->ReplaceInput(count, call_node);
+
+  for (int i = 0; i < count; ++i) {
+    Node* control_output = TryInlineFunction(calls[i], candidates.at(i));
+    if (control_output != NULL) merge->ReplaceInput(i, control_output);
+  }
+}
+
+
+Node* JSInliner::TryInlineFunction(Node* call_node,
+                                   Handle<JSFunction> function) {
+  JSCallFunctionAccessor call(call_node);
 
   if (function->shared()->native()) {
     if (FLAG_trace_turbo_inlining) {
@@ -385,7 +473,17 @@ void JSInliner::TryInlineCall(Node* call_node) {
       PrintF("Not Inlining %s into %s because inlinee is native\n", name.get(),
              info_->shared_info()->DebugName()->ToCString().get());
     }
-    return;
+    return NULL;
+  }
+
+  if (function->shared()->HasDebugInfo()) {
+    if (FLAG_trace_turbo_inlining) {
+      SmartArrayPointer<char> name =
+          function->shared()->DebugName()->ToCString();
+      PrintF("Not Inlining %s into %s because inlinee has break points\n",
+             name.get(), info_->shared_info()->DebugName()->ToCString().get());
+    }
+    return NULL;
   }
 
   CompilationInfoWithZone info(function);
@@ -400,8 +498,21 @@ void JSInliner::TryInlineCall(Node* call_node) {
           "array\n",
           name.get(), info_->shared_info()->DebugName()->ToCString().get());
     }
-    return;
+    return NULL;
+  }
+
+  int nodes_added = info.function()->ast_node_count();
+  if (nodes_added > FLAG_max_inlined_nodes ||
+      inlined_nodes_ + nodes_added > FLAG_max_inlined_nodes_cumulative) {
+    if (FLAG_trace_turbo_inlining) {
+      SmartArrayPointer<char> name =
+          function->shared()->DebugName()->ToCString();
+      PrintF("Not Inlining %s into %s because the inlining budget is used up\n",
+             name.get(), info_->shared_info()->DebugName()->ToCString().get());
+    }
+    return NULL;
   }
+  inlined_nodes_ += nodes_added;
 
   if (FLAG_trace_turbo_inlining) {
     SmartArrayPointer<char> name = function->shared()->DebugName()->ToCString();
@@ -439,7 +550,7 @@ void JSInliner::TryInlineCall(Node* call_node) {
     }
   }
 
-  inlinee.InlineAtCall(jsgraph_, call_node);
+  return inlinee.InlineAtCall(jsgraph_, call_node);
 }
 }
 }
@@ -17,7 +17,7 @@ class JSCallFunctionAccessor;
 class JSInliner {
  public:
   JSInliner(CompilationInfo* info, JSGraph* jsgraph)
-      : info_(info), jsgraph_(jsgraph) {}
+      : info_(info), jsgraph_(jsgraph), inlined_nodes_(0) {}
 
   void Inline();
   void TryInlineCall(Node* node);
@@ -26,6 +26,17 @@ class JSInliner {
   friend class InlinerVisitor;
   CompilationInfo* info_;
   JSGraph* jsgraph_;
+  // Cumulative AST node count of all functions inlined so far.
+  int inlined_nodes_;
+
+  // Inlines {function} at {call} and returns the last control node of the
+  // inlined body, or NULL if the function cannot be inlined.
+  Node* TryInlineFunction(Node* call, Handle<JSFunction> function);
+
+  // Dispatches on the callee of {call} and inlines each of {targets} in its
+  // own branch, keeping {call} as the generic fallback.
+  void TryInlinePolymorphicCall(Node* call,
+                                const ZoneList<Handle<JSFunction> >* targets);
 
   Node* CreateArgumentsAdaptorFrameState(JSCallFunctionAccessor* call,
                                          Handle<JSFunction> jsfunction,
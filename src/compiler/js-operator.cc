@@ -128,7 +128,6 @@ struct StaticParameterTraits<Runtime::FunctionId> {
   V(TypeOf, Operator::kPure, 1, 1)                        \
   V(InstanceOf, Operator::kNoProperties, 2, 1)            \
   V(Debugger, Operator::kNoProperties, 0, 0)              \
-  V(CreateFunctionContext, Operator::kNoProperties, 1, 1) \
   V(CreateWithContext, Operator::kNoProperties, 2, 1)     \
   V(CreateBlockContext, Operator::kNoProperties, 2, 1)    \
   V(CreateModuleContext, Operator::kNoProperties, 2, 1)   \
@@ -162,9 +161,18 @@ SHARED_OP_LIST(SHARED)
 #undef SHARED
 
 
-const Operator* JSOperatorBuilder::CallFunction(size_t arity,
-                                                CallFunctionFlags flags) {
-  CallFunctionParameters parameters(arity, flags);
+const Operator* JSOperatorBuilder::CallFunction(
+    size_t arity, CallFunctionFlags flags,
+    const ZoneList<Handle<JSFunction> >* targets) {
+  // Operators outlive the graphs of inlined functions, so keep the targets
+  // in the operator zone.
+  ZoneList<Handle<JSFunction> >* copied_targets = NULL;
+  if (targets != NULL && !targets->is_empty()) {
+    copied_targets =
+        new (zone()) ZoneList<Handle<JSFunction> >(targets->length(), zone());
+    copied_targets->AddAll(*targets, zone());
+  }
+  CallFunctionParameters parameters(arity, flags, copied_targets);
   return new (zone()) Operator1<CallFunctionParameters>(
       IrOpcode::kJSCallFunction, Operator::kNoProperties,
       static_cast<int>(parameters.arity()), 1, "JSCallFunction", parameters);
@@ -239,6 +247,13 @@ const Operator* JSOperatorBuilder::StoreContext(size_t depth, size_t index) {
 }
 
 
+const Operator* JSOperatorBuilder::CreateFunctionContext(int slot_count) {
+  return new (zone()) Operator1<int>(IrOpcode::kJSCreateFunctionContext,
+                                     Operator::kNoProperties, 1, 1,
+                                     "JSCreateFunctionContext", slot_count);
+}
+
+
 const Operator* JSOperatorBuilder::CreateCatchContext(
     const Unique<String>& name) {
   return new (zone()) Operator1<Unique<String> >(
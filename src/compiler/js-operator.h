@@ -18,18 +18,23 @@ struct JSOperatorBuilderImpl;
 
 
 // Defines the arity and the call flags for a JavaScript function call. This is
-// used as a parameter by JSCallFunction operators.
+// used as a parameter by JSCallFunction operators. The optional {targets} are
+// the functions the type feedback saw being called at this site; they are
+// only hints and must be checked against the actual callee before use.
 class CallFunctionParameters FINAL {
  public:
-  CallFunctionParameters(size_t arity, CallFunctionFlags flags)
-      : arity_(arity), flags_(flags) {}
+  CallFunctionParameters(size_t arity, CallFunctionFlags flags,
+                         const ZoneList<Handle<JSFunction> >* targets = NULL)
+      : arity_(arity), flags_(flags), targets_(targets) {}
 
   size_t arity() const { return arity_; }
   CallFunctionFlags flags() const { return flags_; }
+  const ZoneList<Handle<JSFunction> >* targets() const { return targets_; }
 
  private:
   const size_t arity_;
   const CallFunctionFlags flags_;
+  const ZoneList<Handle<JSFunction> >* const targets_;
 };
 
 const CallFunctionParameters& CallFunctionParametersOf(const Operator* op);
@@ -151,7 +156,9 @@ class JSOperatorBuilder FINAL {
 
   const Operator* Create();
 
-  const Operator* CallFunction(size_t arity, CallFunctionFlags flags);
+  const Operator* CallFunction(
+      size_t arity, CallFunctionFlags flags,
+      const ZoneList<Handle<JSFunction> >* targets = NULL);
   const Operator* CallRuntime(Runtime::FunctionId id, size_t arity);
 
   const Operator* CallConstruct(int arguments);
@@ -175,7 +182,7 @@ class JSOperatorBuilder FINAL {
   const Operator* Debugger();
 
   // TODO(titzer): nail down the static parts of each of these context flavors.
-  const Operator* CreateFunctionContext();
+  const Operator* CreateFunctionContext(int slot_count);
   const Operator* CreateCatchContext(const Unique<String>& name);
   const Operator* CreateWithContext();
   const Operator* CreateBlockContext();
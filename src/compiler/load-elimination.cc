@@ -0,0 +1,106 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/load-elimination.h"
+
+#include "src/compiler/node-properties-inl.h"
+#include "src/compiler/simplified-operator.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Returns true if a StoreField with {store_access} cannot modify the field
+// described by {access}, whatever objects both of them refer to.
+bool CannotAlias(const FieldAccess& access, const FieldAccess& store_access) {
+  return access.base_is_tagged == kTaggedBase &&
+         store_access.base_is_tagged == kTaggedBase &&
+         access.offset != store_access.offset;
+}
+
+
+// Returns true if the effect chain may be followed past {effect} without
+// missing a write to the heap.
+bool IsTransparent(Node* effect) {
+  return effect->op()->HasProperty(Operator::kNoWrite) &&
+         OperatorProperties::GetEffectInputCount(effect->op()) == 1;
+}
+
+}  // namespace
+
+
+LoadElimination::~LoadElimination() {}
+
+
+Reduction LoadElimination::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kLoadField:
+      return ReduceLoadField(node);
+    case IrOpcode::kStoreField:
+      return ReduceStoreField(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+
+Reduction LoadElimination::ReduceLoadField(Node* node) {
+  DCHECK_EQ(IrOpcode::kLoadField, node->opcode());
+  FieldAccess const& access = FieldAccessOf(node->op());
+  Node* const object = NodeProperties::GetValueInput(node, 0);
+  for (Node* effect = NodeProperties::GetEffectInput(node);;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    if (effect->opcode() == IrOpcode::kLoadField) {
+      if (object == NodeProperties::GetValueInput(effect, 0) &&
+          access == FieldAccessOf(effect->op())) {
+        Node* const value = effect;
+        NodeProperties::ReplaceWithValue(node, value);
+        return Replace(value);
+      }
+    } else if (effect->opcode() == IrOpcode::kStoreField) {
+      FieldAccess const& store_access = FieldAccessOf(effect->op());
+      if (access == store_access) {
+        if (object != NodeProperties::GetValueInput(effect, 0)) break;
+        Node* const value = NodeProperties::GetValueInput(effect, 1);
+        NodeProperties::ReplaceWithValue(node, value);
+        return Replace(value);
+      }
+      if (!CannotAlias(access, store_access)) break;
+    } else if (!IsTransparent(effect)) {
+      break;
+    }
+  }
+  return NoChange();
+}
+
+
+Reduction LoadElimination::ReduceStoreField(Node* node) {
+  DCHECK_EQ(IrOpcode::kStoreField, node->opcode());
+  FieldAccess const& access = FieldAccessOf(node->op());
+  Node* const object = NodeProperties::GetValueInput(node, 0);
+  // Only look through other field stores; they cannot observe the field, so
+  // an earlier store to it whose sole use is the next store is dead.
+  Node* user = node;
+  for (Node* effect = NodeProperties::GetEffectInput(node);
+       effect->opcode() == IrOpcode::kStoreField && effect->UseCount() == 1;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    FieldAccess const& store_access = FieldAccessOf(effect->op());
+    if (access == store_access &&
+        object == NodeProperties::GetValueInput(effect, 0)) {
+      Node* const previous = NodeProperties::GetEffectInput(effect);
+      NodeProperties::ReplaceEffectInput(user, previous);
+      return Changed(node);
+    }
+    if (!CannotAlias(access, store_access)) break;
+    user = effect;
+  }
+  return NoChange();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
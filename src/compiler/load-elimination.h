@@ -0,0 +1,39 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOAD_ELIMINATION_H_
+#define V8_COMPILER_LOAD_ELIMINATION_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Removes redundant LoadField and StoreField nodes by walking the effect
+// chain backwards from a field access within a single effect path:
+//  - a load of a field that was just loaded or stored on the same object is
+//    replaced by the earlier value;
+//  - a store to a field that is overwritten before anybody observes it is
+//    removed from the effect chain.
+// The walk stops at anything that might write to the heap or that merges
+// effects, so the reducer never needs alias information beyond the field
+// offset.
+class LoadElimination FINAL : public Reducer {
+ public:
+  LoadElimination() {}
+  ~LoadElimination();
+
+  virtual Reduction Reduce(Node* node) OVERRIDE;
+
+ private:
+  Reduction ReduceLoadField(Node* node);
+  Reduction ReduceStoreField(Node* node);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOAD_ELIMINATION_H_
@@ -0,0 +1,156 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-analysis.h"
+
+#include <algorithm>
+
+#include "src/compiler/node-properties-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+bool IdLessThan(Node* a, Node* b) { return a->id() < b->id(); }
+
+
+bool BodyLarger(LoopTree::Loop* a, LoopTree::Loop* b) {
+  if (a->body().size() != b->body().size()) {
+    return a->body().size() > b->body().size();
+  }
+  return a->header()->id() < b->header()->id();
+}
+
+
+bool IsPhiOf(Node* node, Node* header) {
+  return (node->opcode() == IrOpcode::kPhi ||
+          node->opcode() == IrOpcode::kEffectPhi) &&
+         NodeProperties::GetControlInput(node) == header;
+}
+
+}  // namespace
+
+
+bool LoopTree::Loop::Contains(Node* node) const {
+  return std::binary_search(body_.begin(), body_.end(), node, IdLessThan);
+}
+
+
+LoopTree::Loop* LoopTree::ContainingLoop(Node* node) const {
+  // Nested loops have smaller bodies and thus come after their parents.
+  for (ZoneVector<Loop*>::const_reverse_iterator i = loops_.rbegin();
+       i != loops_.rend(); ++i) {
+    if ((*i)->Contains(node)) return *i;
+  }
+  return NULL;
+}
+
+
+LoopTree* LoopFinder::BuildLoopTree(Graph* graph, Zone* zone) {
+  LoopTree* tree = new (zone) LoopTree(zone);
+  size_t const node_count = static_cast<size_t>(graph->NodeCount());
+
+  // Mark the live part of the graph and collect the loop headers in it.
+  BoolVector live(node_count, false, zone);
+  NodeVector headers(zone);
+  NodeVector stack(zone);
+  stack.push_back(graph->end());
+  live[graph->end()->id()] = true;
+  while (!stack.empty()) {
+    Node* node = stack.back();
+    stack.pop_back();
+    if (node->opcode() == IrOpcode::kLoop) headers.push_back(node);
+    for (InputIter i = node->inputs().begin(); i != node->inputs().end();
+         ++i) {
+      Node* input = *i;
+      if (input == NULL || live[input->id()]) continue;
+      live[input->id()] = true;
+      stack.push_back(input);
+    }
+  }
+
+  BoolVector reaches_backedge(node_count, false, zone);
+  BoolVector in_body(node_count, false, zone);
+  for (NodeVectorIter h = headers.begin(); h != headers.end(); ++h) {
+    Node* header = *h;
+    LoopTree::Loop* loop = new (zone) LoopTree::Loop(zone, header);
+    std::fill(reaches_backedge.begin(), reaches_backedge.end(), false);
+    std::fill(in_body.begin(), in_body.end(), false);
+
+    // Walk backwards from the backedges of the header and its phis. The
+    // walk stops at the header, so nodes from outside of the loop are only
+    // reached through loop invariant inputs.
+    DCHECK(stack.empty());
+    reaches_backedge[header->id()] = true;
+    for (int i = 1; i < header->InputCount(); ++i) {
+      stack.push_back(header->InputAt(i));
+    }
+    for (UseIter i = header->uses().begin(); i != header->uses().end(); ++i) {
+      Node* phi = *i;
+      if (!live[phi->id()] || !IsPhiOf(phi, header)) continue;
+      for (int j = 1; j < header->InputCount(); ++j) {
+        stack.push_back(phi->InputAt(j));
+      }
+    }
+    while (!stack.empty()) {
+      Node* node = stack.back();
+      stack.pop_back();
+      if (reaches_backedge[node->id()]) continue;
+      reaches_backedge[node->id()] = true;
+      for (InputIter i = node->inputs().begin(); i != node->inputs().end();
+           ++i) {
+        if (!reaches_backedge[(*i)->id()]) stack.push_back(*i);
+      }
+    }
+
+    // Walk forwards from the header and its phis, staying within nodes that
+    // reach a backedge.
+    in_body[header->id()] = true;
+    loop->body_.push_back(header);
+    stack.push_back(header);
+    while (!stack.empty()) {
+      Node* node = stack.back();
+      stack.pop_back();
+      for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+        Node* use = *i;
+        if (!live[use->id()] || in_body[use->id()]) continue;
+        if (!reaches_backedge[use->id()] && !IsPhiOf(use, header)) continue;
+        in_body[use->id()] = true;
+        loop->body_.push_back(use);
+        stack.push_back(use);
+      }
+    }
+    std::sort(loop->body_.begin(), loop->body_.end(), IdLessThan);
+    tree->loops_.push_back(loop);
+  }
+
+  // A loop nested in another one has a strictly smaller body, so after
+  // sorting the parent of a loop is the last earlier loop containing its
+  // header.
+  std::sort(tree->loops_.begin(), tree->loops_.end(), BodyLarger);
+  for (size_t i = 0; i < tree->loops_.size(); ++i) {
+    LoopTree::Loop* loop = tree->loops_[i];
+    for (size_t j = i; j > 0; --j) {
+      LoopTree::Loop* outer = tree->loops_[j - 1];
+      if (outer->Contains(loop->header())) {
+        loop->parent_ = outer;
+        break;
+      }
+    }
+    if (loop->parent_ == NULL) {
+      loop->depth_ = 1;
+      tree->outer_loops_.push_back(loop);
+    } else {
+      loop->depth_ = loop->parent_->depth_ + 1;
+      loop->parent_->children_.push_back(loop);
+    }
+  }
+  return tree;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,80 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_ANALYSIS_H_
+#define V8_COMPILER_LOOP_ANALYSIS_H_
+
+#include "src/compiler/graph.h"
+#include "src/compiler/node.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// The loops of a graph, nested into a tree. Unlike the loop information the
+// scheduler computes for basic blocks, the tree is built directly on the
+// node graph, so it is available to graph-level phases that run before a
+// schedule exists.
+class LoopTree : public ZoneObject {
+ public:
+  // A loop headed by a Loop node. The body holds the header, the phis
+  // attached to it, and every node that both depends on the header (or one
+  // of its phis) and feeds one of the backedges. Loop invariant nodes are
+  // therefore never part of a body.
+  class Loop : public ZoneObject {
+   public:
+    Loop(Zone* zone, Node* header)
+        : parent_(NULL), depth_(0), header_(header), children_(zone),
+          body_(zone) {}
+
+    Loop* parent() const { return parent_; }
+    int depth() const { return depth_; }
+    Node* header() const { return header_; }
+    const ZoneVector<Loop*>& children() const { return children_; }
+    // Sorted by node id.
+    const NodeVector& body() const { return body_; }
+
+    bool Contains(Node* node) const;
+    bool IsInnermost() const { return children_.empty(); }
+
+   private:
+    friend class LoopFinder;
+
+    Loop* parent_;
+    int depth_;
+    Node* header_;
+    ZoneVector<Loop*> children_;
+    NodeVector body_;
+  };
+
+  explicit LoopTree(Zone* zone) : loops_(zone), outer_loops_(zone) {}
+
+  // All loops, outer loops before the loops nested in them.
+  const ZoneVector<Loop*>& loops() const { return loops_; }
+  const ZoneVector<Loop*>& outer_loops() const { return outer_loops_; }
+
+  // Returns the innermost loop whose body contains {node}, or NULL.
+  Loop* ContainingLoop(Node* node) const;
+
+ private:
+  friend class LoopFinder;
+
+  ZoneVector<Loop*> loops_;
+  ZoneVector<Loop*> outer_loops_;
+};
+
+
+class LoopFinder {
+ public:
+  // Builds the loop tree for the part of {graph} that is reachable from its
+  // end node. The tree and its loops are allocated in {zone}.
+  static LoopTree* BuildLoopTree(Graph* graph, Zone* zone);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_ANALYSIS_H_
@@ -0,0 +1,192 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-peeling.h"
+
+#include "src/compiler/node-properties-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+bool IsPhiOf(Node* node, Node* header) {
+  return (node->opcode() == IrOpcode::kPhi ||
+          node->opcode() == IrOpcode::kEffectPhi) &&
+         NodeProperties::GetControlInput(node) == header;
+}
+
+
+// An input edge of a node outside of the loop body that refers to a node in
+// the body.
+struct OutsideUse {
+  Node* user;
+  int index;
+  bool is_effect;
+  Node* value;
+};
+
+
+// Marks the body of {loop} and returns the single control node outside of
+// the body that uses a body node, or NULL if there is none or more than one.
+Node* MarkBodyAndFindExit(Graph* graph, LoopTree::Loop* loop,
+                          BoolVector* in_body) {
+  in_body->assign(graph->NodeCount(), false);
+  const NodeVector& body = loop->body();
+  for (NodeVectorConstIter i = body.begin(); i != body.end(); ++i) {
+    (*in_body)[(*i)->id()] = true;
+  }
+  Node* exit = NULL;
+  for (NodeVectorConstIter i = body.begin(); i != body.end(); ++i) {
+    for (UseIter j = (*i)->uses().begin(); j != (*i)->uses().end(); ++j) {
+      if ((*in_body)[(*j)->id()]) continue;
+      if (!NodeProperties::IsControlEdge(j.edge())) continue;
+      if (exit != NULL) return NULL;
+      exit = *j;
+    }
+  }
+  return exit;
+}
+
+
+class Peeling {
+ public:
+  Peeling(Graph* graph, LoopTree::Loop* loop, const BoolVector& in_body,
+          Zone* zone)
+      : graph_(graph),
+        in_body_(in_body),
+        copies_(graph->NodeCount(), NULL, zone),
+        inputs_(zone) {
+    Node* header = loop->header();
+    copies_[header->id()] = header->InputAt(0);
+    const NodeVector& body = loop->body();
+    for (NodeVectorConstIter i = body.begin(); i != body.end(); ++i) {
+      if (IsPhiOf(*i, header)) copies_[(*i)->id()] = (*i)->InputAt(0);
+    }
+  }
+
+  // Returns the copy of {node} in the peeled iteration. Nodes outside of the
+  // body are shared by both iterations.
+  Node* Copy(Node* node) {
+    if (!in_body_[node->id()]) return node;
+    Node* copy = copies_[node->id()];
+    if (copy != NULL) return copy;
+    int const input_count = node->InputCount();
+    for (int i = 0; i < input_count; ++i) Copy(node->InputAt(i));
+    // Recursive copies clobber {inputs_}, so only fill it afterwards.
+    inputs_.resize(input_count);
+    for (int i = 0; i < input_count; ++i) {
+      inputs_[i] = Copy(node->InputAt(i));
+    }
+    copy = graph_->NewNode(node->op(), input_count,
+                           input_count == 0 ? NULL : &inputs_.front());
+    copies_[node->id()] = copy;
+    return copy;
+  }
+
+ private:
+  Graph* graph_;
+  const BoolVector& in_body_;
+  NodeVector copies_;
+  NodeVector inputs_;
+};
+
+}  // namespace
+
+
+bool LoopPeeler::CanPeel(Graph* graph, LoopTree::Loop* loop, Zone* tmp_zone) {
+  if (!loop->IsInnermost()) return false;
+  if (loop->header()->InputCount() != 2) return false;
+  if (loop->body().size() > kMaxPeeledNodes) return false;
+  BoolVector in_body(tmp_zone);
+  Node* exit = MarkBodyAndFindExit(graph, loop, &in_body);
+  return exit != NULL && (exit->opcode() == IrOpcode::kIfTrue ||
+                          exit->opcode() == IrOpcode::kIfFalse);
+}
+
+
+void LoopPeeler::Peel(Graph* graph, CommonOperatorBuilder* common,
+                      LoopTree::Loop* loop, Zone* tmp_zone) {
+  DCHECK(CanPeel(graph, loop, tmp_zone));
+  Node* const header = loop->header();
+  BoolVector in_body(tmp_zone);
+  Node* const exit = MarkBodyAndFindExit(graph, loop, &in_body);
+
+  // Collect the uses leaving the body before the graph is changed.
+  ZoneVector<OutsideUse> outside_uses(tmp_zone);
+  NodeVector exit_uses(tmp_zone);
+  const NodeVector& body = loop->body();
+  for (NodeVectorConstIter i = body.begin(); i != body.end(); ++i) {
+    for (UseIter j = (*i)->uses().begin(); j != (*i)->uses().end(); ++j) {
+      if (in_body[(*j)->id()] || *j == exit) continue;
+      OutsideUse use = {*j, j.edge().index(),
+                        NodeProperties::IsEffectEdge(j.edge()), *i};
+      outside_uses.push_back(use);
+    }
+  }
+  for (UseIter i = exit->uses().begin(); i != exit->uses().end(); ++i) {
+    exit_uses.push_back(*i);
+  }
+
+  // Copy the body along the backedge, then enter the loop from the end of
+  // the peeled iteration.
+  Peeling peeling(graph, loop, in_body, tmp_zone);
+  NodeVector phis(tmp_zone);
+  NodeVector backedges(tmp_zone);
+  for (NodeVectorConstIter i = body.begin(); i != body.end(); ++i) {
+    if (IsPhiOf(*i, header)) {
+      phis.push_back(*i);
+      backedges.push_back(peeling.Copy((*i)->InputAt(1)));
+    }
+  }
+  Node* const backedge = peeling.Copy(header->InputAt(1));
+  Node* const exit_copy =
+      graph->NewNode(exit->op(), peeling.Copy(exit->InputAt(0)));
+  header->ReplaceInput(0, backedge);
+  for (size_t i = 0; i < phis.size(); ++i) {
+    phis[i]->ReplaceInput(0, backedges[i]);
+  }
+
+  // Merge both exits and the values that leave the loop through them.
+  Node* const merge = graph->NewNode(common->Merge(2), exit, exit_copy);
+  for (NodeVectorIter i = exit_uses.begin(); i != exit_uses.end(); ++i) {
+    for (int j = 0; j < (*i)->InputCount(); ++j) {
+      if ((*i)->InputAt(j) == exit) (*i)->ReplaceInput(j, merge);
+    }
+  }
+  NodeVector value_phis(graph->NodeCount(), NULL, tmp_zone);
+  NodeVector effect_phis(graph->NodeCount(), NULL, tmp_zone);
+  for (ZoneVector<OutsideUse>::iterator i = outside_uses.begin();
+       i != outside_uses.end(); ++i) {
+    Node* const value = i->value;
+    NodeVector& cache = i->is_effect ? effect_phis : value_phis;
+    Node* phi = cache[value->id()];
+    if (phi == NULL) {
+      const Operator* op = i->is_effect ? common->EffectPhi(2)
+                                        : common->Phi(kMachAnyTagged, 2);
+      phi = graph->NewNode(op, value, peeling.Copy(value), merge);
+      cache[value->id()] = phi;
+    }
+    i->user->ReplaceInput(i->index, phi);
+  }
+}
+
+
+int LoopPeeler::PeelInnerLoops(Graph* graph, CommonOperatorBuilder* common,
+                               LoopTree* loop_tree, Zone* tmp_zone) {
+  int peeled = 0;
+  const ZoneVector<LoopTree::Loop*>& loops = loop_tree->loops();
+  for (ZoneVector<LoopTree::Loop*>::const_iterator i = loops.begin();
+       i != loops.end(); ++i) {
+    if (!CanPeel(graph, *i, tmp_zone)) continue;
+    Peel(graph, common, *i, tmp_zone);
+    peeled++;
+  }
+  return peeled;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,46 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_PEELING_H_
+#define V8_COMPILER_LOOP_PEELING_H_
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/loop-analysis.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Peels off the first iteration of a loop by copying the loop body in front
+// of the loop header. Checks and loads in the remaining loop are then
+// dominated by their copies in the peeled iteration, which lets later
+// reductions remove them and lets the scheduler hoist what has become loop
+// invariant.
+//
+// Only innermost loops with a single backedge and a single exit through an
+// IfTrue or IfFalse projection are peeled. Values that flow out of the loop
+// are merged with their copies by new phis at the exit.
+class LoopPeeler {
+ public:
+  // Loops whose body has more nodes than this are not peeled.
+  static const size_t kMaxPeeledNodes = 1000;
+
+  static bool CanPeel(Graph* graph, LoopTree::Loop* loop, Zone* tmp_zone);
+
+  // Peels {loop}, which must satisfy {CanPeel}. Temporary data structures are
+  // allocated in {tmp_zone}.
+  static void Peel(Graph* graph, CommonOperatorBuilder* common,
+                   LoopTree::Loop* loop, Zone* tmp_zone);
+
+  // Peels all innermost loops in {loop_tree} that can be peeled and returns
+  // their number.
+  static int PeelInnerLoops(Graph* graph, CommonOperatorBuilder* common,
+                            LoopTree* loop_tree, Zone* tmp_zone);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_PEELING_H_
@@ -0,0 +1,203 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/move-optimizer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+MoveOptimizer::MoveOptimizer(Zone* local_zone, InstructionSequence* code)
+    : local_zone_(local_zone), code_(code) {}
+
+
+void MoveOptimizer::Run() {
+  CompressGaps();
+  for (int i = 0; i < code()->BasicBlockCount(); ++i) {
+    MergeIncomingMoves(code()->BlockAt(i));
+  }
+}
+
+
+void MoveOptimizer::CompressMoves(Zone* zone, ParallelMove* left,
+                                  ParallelMove* right) {
+  ZoneList<MoveOperands>* first = left->move_operands();
+  ZoneList<MoveOperands>* second = right->move_operands();
+  for (int i = 0; i < first->length(); ++i) {
+    if (first->at(i).IsRedundant()) first->at(i).Eliminate();
+  }
+  for (int i = 0; i < second->length(); ++i) {
+    if (second->at(i).IsRedundant()) second->at(i).Eliminate();
+  }
+  // A move of {right} reading an operand written by {left} can read the
+  // source of that write directly.
+  for (int i = 0; i < second->length(); ++i) {
+    MoveOperands* move = &second->at(i);
+    if (move->IsEliminated()) continue;
+    for (int j = 0; j < first->length(); ++j) {
+      MoveOperands* other = &first->at(j);
+      if (!other->IsEliminated() &&
+          other->destination()->Equals(move->source())) {
+        move->set_source(other->source());
+        break;
+      }
+    }
+  }
+  // Moves of {left} whose destination is overwritten by {right} are dead.
+  int count = second->length();
+  for (int j = 0; j < first->length(); ++j) {
+    MoveOperands* other = &first->at(j);
+    if (other->IsEliminated()) continue;
+    bool killed = false;
+    for (int i = 0; i < count; ++i) {
+      MoveOperands* move = &second->at(i);
+      if (!move->IsEliminated() &&
+          move->destination()->Equals(other->destination())) {
+        killed = true;
+        break;
+      }
+    }
+    if (!killed) right->AddMove(other->source(), other->destination(), zone);
+  }
+  first->Rewind(0);
+}
+
+
+// Only source position instructions may separate gaps whose moves are
+// folded together; moves are never folded across a block start.
+void MoveOptimizer::CompressGaps() {
+  ParallelMove* pending = NULL;
+  for (InstructionSequence::const_iterator i = code()->begin();
+       i != code()->end(); ++i) {
+    Instruction* instr = *i;
+    if (instr->IsBlockStart()) pending = NULL;
+    if (instr->IsGapMoves()) {
+      GapInstruction* gap = GapInstruction::cast(instr);
+      for (int pos = GapInstruction::FIRST_INNER_POSITION;
+           pos <= GapInstruction::LAST_INNER_POSITION; ++pos) {
+        ParallelMove* moves = gap->GetParallelMove(
+            static_cast<GapInstruction::InnerPosition>(pos));
+        if (moves == NULL) continue;
+        if (pending != NULL) CompressMoves(code_zone(), pending, moves);
+        pending = moves;
+      }
+    } else if (!instr->IsSourcePosition()) {
+      pending = NULL;
+    }
+  }
+}
+
+
+// Returns the parallel move of the gaps at the start of {block}, which holds
+// all their moves after CompressGaps, or NULL if there is none.
+ParallelMove* MoveOptimizer::FirstMovesOf(BasicBlock* block) {
+  for (int index = block->first_instruction_index();
+       index <= block->last_instruction_index(); ++index) {
+    Instruction* instr = code()->InstructionAt(index);
+    if (instr->IsGapMoves()) {
+      GapInstruction* gap = GapInstruction::cast(instr);
+      for (int pos = GapInstruction::FIRST_INNER_POSITION;
+           pos <= GapInstruction::LAST_INNER_POSITION; ++pos) {
+        ParallelMove* moves = gap->GetParallelMove(
+            static_cast<GapInstruction::InnerPosition>(pos));
+        if (moves != NULL && !moves->move_operands()->is_empty()) {
+          return moves;
+        }
+      }
+    } else if (!instr->IsSourcePosition()) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+
+// Returns the parallel move of the gaps before the control instruction
+// ending {block}, or NULL if there is none.
+ParallelMove* MoveOptimizer::LastMovesOf(BasicBlock* block) {
+  int last = block->last_instruction_index();
+  if (!code()->InstructionAt(last)->IsControl()) return NULL;
+  for (int index = last - 1; index >= block->first_instruction_index();
+       --index) {
+    Instruction* instr = code()->InstructionAt(index);
+    if (instr->IsGapMoves()) {
+      GapInstruction* gap = GapInstruction::cast(instr);
+      for (int pos = GapInstruction::LAST_INNER_POSITION;
+           pos >= GapInstruction::FIRST_INNER_POSITION; --pos) {
+        ParallelMove* moves = gap->GetParallelMove(
+            static_cast<GapInstruction::InnerPosition>(pos));
+        if (moves != NULL && !moves->move_operands()->is_empty()) {
+          return moves;
+        }
+      }
+      if (instr->IsBlockStart()) break;
+    } else if (!instr->IsSourcePosition()) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+
+// The moves that every predecessor of {block} performs right before jumping
+// to it are performed once at the start of {block} instead.
+void MoveOptimizer::MergeIncomingMoves(BasicBlock* block) {
+  if (block->PredecessorCount() < 2) return;
+  ZoneVector<ParallelMove*> incoming(local_zone());
+  for (BasicBlock::Predecessors::iterator i = block->predecessors_begin();
+       i != block->predecessors_end(); ++i) {
+    BasicBlock* pred = *i;
+    if (pred == block || pred->control() != BasicBlock::kGoto) return;
+    ParallelMove* moves = LastMovesOf(pred);
+    if (moves == NULL) return;
+    incoming.push_back(moves);
+  }
+
+  ParallelMove* merged = NULL;
+  ZoneList<MoveOperands>* candidates = incoming[0]->move_operands();
+  for (int i = 0; i < candidates->length(); ++i) {
+    MoveOperands candidate = candidates->at(i);
+    if (candidate.IsEliminated()) continue;
+    // The candidate must not read an operand written by the same parallel
+    // move, or performing it later would change its effect.
+    ZoneVector<MoveOperands*> matches(local_zone());
+    for (size_t p = 0; p < incoming.size(); ++p) {
+      ZoneList<MoveOperands>* moves = incoming[p]->move_operands();
+      MoveOperands* match = NULL;
+      bool blocked = false;
+      for (int j = 0; j < moves->length(); ++j) {
+        MoveOperands* move = &moves->at(j);
+        if (move->IsEliminated()) continue;
+        if (move->source()->Equals(candidate.source()) &&
+            move->destination()->Equals(candidate.destination())) {
+          match = move;
+        } else if (move->destination()->Equals(candidate.source())) {
+          blocked = true;
+        }
+      }
+      if (match == NULL || blocked) break;
+      matches.push_back(match);
+    }
+    if (matches.size() != incoming.size()) continue;
+    for (size_t p = 0; p < matches.size(); ++p) matches[p]->Eliminate();
+    if (candidate.IsRedundant()) continue;
+    if (merged == NULL) merged = new (code_zone()) ParallelMove(code_zone());
+    merged->AddMove(candidate.source(), candidate.destination(), code_zone());
+  }
+  if (merged == NULL) return;
+
+  ParallelMove* moves = FirstMovesOf(block);
+  if (moves != NULL) {
+    CompressMoves(code_zone(), merged, moves);
+  } else {
+    GapInstruction* gap = code()->GapAt(block->first_instruction_index());
+    gap->GetOrCreateParallelMove(GapInstruction::START, code_zone())
+        ->move_operands()
+        ->AddAll(*merged->move_operands(), code_zone());
+  }
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,52 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_MOVE_OPTIMIZER_H_
+#define V8_COMPILER_MOVE_OPTIMIZER_H_
+
+#include "src/compiler/instruction.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Reduces the number of gap moves left by the register allocator before they
+// reach the gap resolver. The moves of consecutive gaps are folded into a
+// single parallel move, which drops redundant moves and turns spill-reload
+// pairs into register moves, and moves that all predecessors of a merge
+// perform are done once at the start of the merge block instead.
+class MoveOptimizer FINAL {
+ public:
+  MoveOptimizer(Zone* local_zone, InstructionSequence* code);
+
+  void Run();
+
+  // Folds {left} into {right}, so that performing {right} afterwards has the
+  // same effect as performing {left} followed by {right}. Leaves {left}
+  // empty.
+  static void CompressMoves(Zone* zone, ParallelMove* left,
+                            ParallelMove* right);
+
+ private:
+  Zone* local_zone() const { return local_zone_; }
+  Zone* code_zone() const { return code_->zone(); }
+  InstructionSequence* code() const { return code_; }
+
+  void CompressGaps();
+  void MergeIncomingMoves(BasicBlock* block);
+  ParallelMove* FirstMovesOf(BasicBlock* block);
+  ParallelMove* LastMovesOf(BasicBlock* block);
+
+  Zone* const local_zone_;
+  InstructionSequence* const code_;
+
+  DISALLOW_COPY_AND_ASSIGN(MoveOptimizer);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_MOVE_OPTIMIZER_H_
@@ -14,6 +14,13 @@ const int ScaleFactorMatcher::kMatchedFactors[] = {1, 2, 4, 8};
 
 ScaleFactorMatcher::ScaleFactorMatcher(Node* node)
     : NodeMatcher(node), left_(NULL), power_(0) {
+  if (opcode() == IrOpcode::kWord32Shl) {
+    Int32BinopMatcher m(this->node());
+    if (!m.right().IsInRange(0, 3)) return;
+    power_ = m.right().Value();
+    left_ = m.left().node();
+    return;
+  }
   if (opcode() != IrOpcode::kInt32Mul) return;
   // TODO(dcarney): should test 64 bit ints as well.
   Int32BinopMatcher m(this->node());
@@ -43,6 +50,12 @@ IndexAndDisplacementMatcher::IndexAndDisplacementMatcher(Node* node)
       displacement_ = m.right().Value();
       index_node_ = m.left().node();
     }
+  } else if (opcode() == IrOpcode::kInt32Sub) {
+    Int32BinopMatcher m(this->node());
+    if (m.right().HasValue() && m.right().Value() != kMinInt) {
+      displacement_ = -m.right().Value();
+      index_node_ = m.left().node();
+    }
   }
   // Test scale factor.
   ScaleFactorMatcher scale_matcher(index_node_);
@@ -142,7 +142,8 @@ typedef BinopMatcher<Float64Matcher, Float64Matcher> Float64BinopMatcher;
 
 // Fairly intel-specify node matcher used for matching scale factors in
 // addressing modes.
-// Matches nodes of form [x * N] for N in {1,2,4,8}
+// Matches nodes of form [x * N] for N in {1,2,4,8} and [x << S] for S in
+// {0,1,2,3}
 class ScaleFactorMatcher : public NodeMatcher {
  public:
   static const int kMatchedFactors[4];
@@ -170,9 +171,11 @@ class ScaleFactorMatcher : public NodeMatcher {
 // Matches nodes of form:
 //  [x * N]
 //  [x * N + K]
+//  [x * N - K]
 //  [x + K]
+//  [x - K]
 //  [x] -- fallback case
-// for N in {1,2,4,8} and K int32_t
+// for N in {1,2,4,8} and K int32_t, where x * N may also be a left shift
 class IndexAndDisplacementMatcher : public NodeMatcher {
  public:
   explicit IndexAndDisplacementMatcher(Node* node);
@@ -122,7 +122,9 @@ inline int OperatorProperties::GetControlInputCount(const Operator* op) {
 #define OPCODE_CASE(x) case IrOpcode::k##x:
       CONTROL_OP_LIST(OPCODE_CASE)
 #undef OPCODE_CASE
-      // Control operators are Operator1<int>.
+      // Control operators are Operator1<int>, except for Branch which is
+      // parameterized by its BranchHint.
+      if (op->opcode() == IrOpcode::kBranch) return 1;
       return OpParameter<int>(op);
     default:
       // Operators that have write effects must have a control
@@ -0,0 +1,152 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/osr.h"
+
+#include "src/compiler.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/frame.h"
+#include "src/compiler/node-properties-inl.h"
+#include "src/scopes.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+OsrHelper::OsrHelper(CompilationInfo* info)
+    : parameter_count_(info->scope()->num_parameters() + 1),
+      stack_slot_count_(info->scope()->num_stack_slots()) {}
+
+
+void OsrHelper::SetupFrame(Frame* frame) {
+  DCHECK_EQ(0, frame->GetSpillSlotCount());
+  for (int i = 0; i < stack_slot_count_; i++) {
+    int index = frame->AllocateSpillSlot(false);
+    USE(index);
+    DCHECK_EQ(i, index);
+  }
+}
+
+
+bool OsrHelper::IsSupportedOnTarget() {
+#if V8_TARGET_ARCH_X64
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+namespace {
+
+// Removes the control inputs of {merge} that are not marked in {live} along
+// with the corresponding inputs of the phis attached to it.
+void TrimMerge(CommonOperatorBuilder* common, Node* merge,
+               const BoolVector& live, Zone* zone) {
+  NodeVector phis(zone);
+  for (UseIter i = merge->uses().begin(); i != merge->uses().end(); ++i) {
+    Node* use = *i;
+    if ((use->opcode() == IrOpcode::kPhi ||
+         use->opcode() == IrOpcode::kEffectPhi) &&
+        NodeProperties::GetControlInput(use) == merge) {
+      phis.push_back(use);
+    }
+  }
+  for (int index = merge->InputCount() - 1; index >= 0; index--) {
+    if (live[merge->InputAt(index)->id()]) continue;
+    merge->RemoveInput(index);
+    for (NodeVectorIter i = phis.begin(); i != phis.end(); ++i) {
+      (*i)->RemoveInput(index);
+    }
+  }
+  int count = merge->InputCount();
+  DCHECK_LT(0, count);
+  merge->set_op(merge->opcode() == IrOpcode::kLoop ? common->Loop(count)
+                                                   : common->Merge(count));
+  for (NodeVectorIter i = phis.begin(); i != phis.end(); ++i) {
+    Node* phi = *i;
+    phi->set_op(phi->opcode() == IrOpcode::kPhi
+                    ? common->Phi(OpParameter<MachineType>(phi), count)
+                    : common->EffectPhi(count));
+  }
+}
+
+}  // namespace
+
+
+bool OsrHelper::RemoveNormalEntry(Graph* graph, CommonOperatorBuilder* common,
+                                  Node* normal_entry) {
+  Zone* zone = graph->zone();
+
+  // Mark the control nodes that are reachable from the start without passing
+  // through the regular entry, i.e. the control flow of the OSR path.
+  BoolVector live(graph->NodeCount(), false, zone);
+  NodeVector controls(zone);
+  NodeVector stack(zone);
+  live[graph->start()->id()] = true;
+  stack.push_back(graph->start());
+  while (!stack.empty()) {
+    Node* node = stack.back();
+    stack.pop_back();
+    for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+      Node* use = *i;
+      if (use == normal_entry || live[use->id()]) continue;
+      if (!NodeProperties::IsControlEdge(i.edge())) continue;
+      if (!NodeProperties::IsControl(use)) continue;
+      live[use->id()] = true;
+      controls.push_back(use);
+      stack.push_back(use);
+    }
+  }
+  if (!live[graph->end()->id()]) return false;
+
+  // Disconnect the regular entry path from the merges it flows into.
+  for (NodeVectorIter i = controls.begin(); i != controls.end(); ++i) {
+    Node* control = *i;
+    if (control->opcode() == IrOpcode::kMerge ||
+        control->opcode() == IrOpcode::kLoop) {
+      TrimMerge(common, control, live, zone);
+    }
+  }
+
+  // The OSR path must not use any node of the regular entry path anymore.
+  BoolVector reachable(graph->NodeCount(), false, zone);
+  reachable[graph->end()->id()] = true;
+  stack.push_back(graph->end());
+  while (!stack.empty()) {
+    Node* node = stack.back();
+    stack.pop_back();
+    for (InputIter i = node->inputs().begin(); i != node->inputs().end(); ++i) {
+      Node* input = *i;
+      if (reachable[input->id()]) continue;
+      reachable[input->id()] = true;
+      stack.push_back(input);
+    }
+  }
+  if (reachable[normal_entry->id()]) return false;
+
+  // Unlink everything that depends on the regular entry from the graph.
+  NodeVector dead(zone);
+  BoolVector visited(graph->NodeCount(), false, zone);
+  visited[normal_entry->id()] = true;
+  dead.push_back(normal_entry);
+  for (size_t index = 0; index < dead.size(); index++) {
+    Node* node = dead[index];
+    for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+      Node* use = *i;
+      if (visited[use->id()]) continue;
+      DCHECK(!reachable[use->id()]);
+      visited[use->id()] = true;
+      dead.push_back(use);
+    }
+  }
+  for (NodeVectorIter i = dead.begin(); i != dead.end(); ++i) {
+    (*i)->RemoveAllInputs();
+  }
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,70 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_OSR_H_
+#define V8_COMPILER_OSR_H_
+
+#include "src/compiler/graph.h"
+
+namespace v8 {
+namespace internal {
+
+class CompilationInfo;
+
+namespace compiler {
+
+class CommonOperatorBuilder;
+class Frame;
+
+// TurboFan OSR compiles a function for entry at the back edge of a single
+// loop. The graph builder produces the regular function entry path as well as
+// a second path, starting directly at the OSR loop, whose environment consists
+// of OsrValue nodes that read the values from the unoptimized frame:
+//  - the receiver and the parameters stay in the caller's argument slots;
+//  - local i of the unoptimized frame becomes spill slot i of the optimized
+//    frame, both frames share the same fixed part.
+// The regular entry path is cut off once the graph is complete, the optimized
+// code can only be entered by jumping to the OSR entry from unoptimized code.
+class OsrHelper {
+ public:
+  explicit OsrHelper(CompilationInfo* info);
+
+  // Reserves the spill slots that are occupied by the locals of the
+  // unoptimized frame before the register allocator hands out any others.
+  void SetupFrame(Frame* frame);
+
+  // Returns the number of slots of the unoptimized frame that are subsumed by
+  // the optimized frame on entry.
+  int UnoptimizedFrameSlots() const { return stack_slot_count_; }
+
+  // Maps the environment index of an OsrValue to its location: indices below
+  // the parameter count (including the receiver) denote parameters, all other
+  // indices denote spill slots.
+  bool IsParameterIndex(int index) const { return index < parameter_count_; }
+  int SpillSlotIndexOf(int index) const {
+    DCHECK(!IsParameterIndex(index));
+    return index - parameter_count_;
+  }
+
+  // Removes the regular entry path from the graph: every node that is only
+  // reachable through {normal_entry} is unlinked and the merges and phis that
+  // join it with the OSR path lose the corresponding inputs. Returns false if
+  // the OSR path still depends on the regular entry path somewhere or never
+  // reaches the end of the graph, the graph is unusable in that case.
+  static bool RemoveNormalEntry(Graph* graph, CommonOperatorBuilder* common,
+                                Node* normal_entry);
+
+  // Returns whether the code generator supports OSR entries on this target.
+  static bool IsSupportedOnTarget();
+
+ private:
+  int parameter_count_;
+  int stack_slot_count_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_OSR_H_
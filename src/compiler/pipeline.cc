@@ -19,7 +19,12 @@
 #include "src/compiler/js-generic-lowering.h"
 #include "src/compiler/js-inlining.h"
 #include "src/compiler/js-typed-lowering.h"
+#include "src/compiler/load-elimination.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-peeling.h"
 #include "src/compiler/machine-operator-reducer.h"
+#include "src/compiler/move-optimizer.h"
+#include "src/compiler/osr.h"
 #include "src/compiler/phi-reducer.h"
 #include "src/compiler/register-allocator.h"
 #include "src/compiler/schedule.h"
@@ -46,12 +51,18 @@ class PhaseStats {
         kind_(kind),
         name_(name),
         size_(info->zone()->allocation_size()) {
-    if (FLAG_turbo_stats) {
+    if (FLAG_turbo_stats || FLAG_log_turbo_phases) {
       timer_.Start();
     }
   }
 
   ~PhaseStats() {
+    if (FLAG_log_turbo_phases) {
+      size_t bytes = info_->zone()->allocation_size() - size_;
+      LOG(info_->isolate(),
+          TurboPhaseEvent(info_->optimization_id(), name_,
+                          timer_.Elapsed().InMillisecondsF(), bytes));
+    }
     if (FLAG_turbo_stats) {
       base::TimeDelta delta = timer_.Elapsed();
       size_t bytes = info_->zone()->allocation_size() - size_;
@@ -165,20 +176,70 @@ static void TraceSchedule(Schedule* schedule) {
 }
 
 
+// State that is handed from one phase of the pipeline to the next. It is
+// allocated in the compilation zone and never destructed, so everything it
+// holds must be zone memory as well.
+class Pipeline::Data : public ZoneObject {
+ public:
+  explicit Data(CompilationInfo* info)
+      : graph(info->zone()),
+        source_positions(&graph),
+        typer(info->zone()),
+        common(info->zone()),
+        javascript(info->zone()),
+        jsgraph(&graph, &common, &javascript, &typer, &machine),
+        linkage(info),
+        schedule(NULL),
+        sequence(NULL),
+        profiler_data(NULL) {}
+
+  Graph graph;
+  SourcePositionTable source_positions;
+  // TODO(turbofan): there is no need to type anything during initial graph
+  // construction.  This is currently only needed for the node cache, which the
+  // typer could sweep over later.
+  Typer typer;
+  MachineOperatorBuilder machine;
+  CommonOperatorBuilder common;
+  JSOperatorBuilder javascript;
+  JSGraph jsgraph;
+  Linkage linkage;
+  Schedule* schedule;
+  InstructionSequence* sequence;
+  BasicBlockProfiler::Data* profiler_data;
+};
+
+
 Handle<Code> Pipeline::GenerateCode() {
-  if (info()->function()->dont_optimize_reason() == kTryCatchStatement ||
-      info()->function()->dont_optimize_reason() == kTryFinallyStatement ||
+  if (!CreateGraph() || !OptimizeGraph()) return Handle<Code>::null();
+  return FinalizeCode();
+}
+
+
+bool Pipeline::CreateGraph() {
+  DCHECK_EQ(NULL, data_);
+  // TODO(turbofan): Make try-catch and try-finally work and remove this
+  // bailout.
+  if (info()->function()->handler_count() > 0 ||
       // TODO(turbofan): Make ES6 for-of work and remove this bailout.
       info()->function()->dont_optimize_reason() == kForOfStatement ||
       // TODO(turbofan): Make super work and remove this bailout.
       info()->function()->dont_optimize_reason() == kSuperReference ||
-      // TODO(turbofan): Make OSR work and remove this bailout.
-      info()->is_osr()) {
-    return Handle<Code>::null();
+      // TODO(turbofan): Make OSR work on all targets and remove this bailout.
+      (info()->is_osr() &&
+       !(FLAG_turbo_osr && OsrHelper::IsSupportedOnTarget()))) {
+    return false;
   }
 
   if (FLAG_turbo_stats) isolate()->GetTStatistics()->Initialize(info_);
 
+  if (FLAG_log_turbo_phases) {
+    LOG(isolate(),
+        TurboCompileStartEvent(
+            info()->optimization_id(),
+            info()->function()->debug_name()->ToCString().get()));
+  }
+
   if (FLAG_trace_turbo) {
     OFStream os(stdout);
     os << "---------------------------------------------------\n"
@@ -188,24 +249,19 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   // Build the graph.
-  Graph graph(zone());
-  SourcePositionTable source_positions(&graph);
+  data_ = new (zone()) Data(info());
+  Graph& graph = data_->graph;
+  SourcePositionTable& source_positions = data_->source_positions;
+  Typer& typer = data_->typer;
+  JSGraph& jsgraph = data_->jsgraph;
   source_positions.AddDecorator();
-  // TODO(turbofan): there is no need to type anything during initial graph
-  // construction.  This is currently only needed for the node cache, which the
-  // typer could sweep over later.
-  Typer typer(zone());
-  MachineOperatorBuilder machine;
-  CommonOperatorBuilder common(zone());
-  JSOperatorBuilder javascript(zone());
-  JSGraph jsgraph(&graph, &common, &javascript, &typer, &machine);
   Node* context_node;
   {
     PhaseStats graph_builder_stats(info(), PhaseStats::CREATE_GRAPH,
                                    "graph builder");
     AstGraphBuilderWithPositions graph_builder(info(), &jsgraph,
                                                &source_positions);
-    graph_builder.CreateGraph();
+    if (!graph_builder.CreateGraph()) return false;
     context_node = graph_builder.GetFunctionContext();
   }
   {
@@ -222,7 +278,11 @@ Handle<Code> Pipeline::GenerateCode() {
 
   VerifyAndPrintGraph(&graph, "Initial untyped");
 
-  if (info()->is_context_specializing()) {
+  // The function context parameter holds the innermost context of the
+  // unoptimized frame for OSR, which isn't the context of the closure.
+  if (info()->is_context_specializing() && !info()->is_osr()) {
+    PhaseStats specialization_stats(info(), PhaseStats::CREATE_GRAPH,
+                                    "context specialization");
     SourcePositionTable::Scope pos(&source_positions,
                                    SourcePosition::Unknown());
     // Specialize the code to the context as aggressively as possible.
@@ -232,6 +292,7 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   if (info()->is_inlining_enabled()) {
+    PhaseStats inlining_stats(info(), PhaseStats::CREATE_GRAPH, "inlining");
     SourcePositionTable::Scope pos(&source_positions,
                                    SourcePosition::Unknown());
     JSInliner inliner(info(), &jsgraph);
@@ -245,7 +306,7 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   // Bailout here in case target architecture is not supported.
-  if (!SupportedTarget()) return Handle<Code>::null();
+  if (!SupportedTarget()) return false;
 
   if (info()->is_typing_enabled()) {
     {
@@ -269,6 +330,32 @@ Handle<Code> Pipeline::GenerateCode() {
 
       VerifyAndPrintGraph(&graph, "Lowered typed");
     }
+    if (FLAG_turbo_load_elimination) {
+      // Remove redundant field loads and stores.
+      PhaseStats load_elimination_stats(info(), PhaseStats::OPTIMIZATION,
+                                        "load elimination");
+      SourcePositionTable::Scope pos(&source_positions,
+                                     SourcePosition::Unknown());
+      LoadElimination load_elimination;
+      GraphReducer graph_reducer(&graph);
+      graph_reducer.AddReducer(&load_elimination);
+      graph_reducer.ReduceGraph();
+
+      VerifyAndPrintGraph(&graph, "Load eliminated");
+    }
+    if (FLAG_turbo_loop_peeling) {
+      // Peel the first iteration off innermost loops.
+      PhaseStats peeling_stats(info(), PhaseStats::OPTIMIZATION,
+                               "loop peeling");
+      SourcePositionTable::Scope pos(&source_positions,
+                                     SourcePosition::Unknown());
+      Zone tmp_zone(isolate());
+      LoopTree* loop_tree = LoopFinder::BuildLoopTree(&graph, &tmp_zone);
+      LoopPeeler::PeelInnerLoops(&graph, jsgraph.common(), loop_tree,
+                                 &tmp_zone);
+
+      VerifyAndPrintGraph(&graph, "Loops peeled");
+    }
     {
       // Lower simplified operators and insert changes.
       PhaseStats lowering_stats(info(), PhaseStats::CREATE_GRAPH,
@@ -286,11 +373,10 @@ Handle<Code> Pipeline::GenerateCode() {
                                 "change lowering");
       SourcePositionTable::Scope pos(&source_positions,
                                      SourcePosition::Unknown());
-      Linkage linkage(info());
       // TODO(turbofan): Value numbering disabled for now.
       // ValueNumberingReducer vn_reducer(zone());
       SimplifiedOperatorReducer simple_reducer(&jsgraph);
-      ChangeLowering lowering(&jsgraph, &linkage);
+      ChangeLowering lowering(&jsgraph, &data_->linkage);
       MachineOperatorReducer mach_reducer(&jsgraph);
       GraphReducer graph_reducer(&graph);
       // TODO(titzer): Figure out if we should run all reducers at once here.
@@ -319,18 +405,49 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   source_positions.RemoveDecorator();
+  return true;
+}
+
 
-  Handle<Code> code = Handle<Code>::null();
+bool Pipeline::OptimizeGraph() {
+  DCHECK_NOT_NULL(data_);
+  CHECK(SupportedBackend());
+  data_->schedule = ComputeSchedule(&data_->graph);
+  if (FLAG_turbo_profiling) {
+    data_->profiler_data = BasicBlockInstrumentor::Instrument(
+        info_, &data_->graph, data_->schedule);
+  }
+  data_->sequence = SelectInstructionsAndAllocateRegisters(
+      &data_->linkage, &data_->graph, data_->schedule,
+      &data_->source_positions);
+  return data_->sequence != NULL;
+}
+
+
+Handle<Code> Pipeline::FinalizeCode() {
+  DCHECK_NOT_NULL(data_);
+  DCHECK_NOT_NULL(data_->sequence);
+  Handle<Code> code;
   {
-    // Compute a schedule.
-    Schedule* schedule = ComputeSchedule(&graph);
     // Generate optimized code.
     PhaseStats codegen_stats(info(), PhaseStats::CODEGEN, "codegen");
-    Linkage linkage(info());
-    code = GenerateCode(&linkage, &graph, schedule, &source_positions);
+    CodeGenerator generator(data_->sequence);
+    code = generator.GenerateCode();
+    if (data_->profiler_data != NULL) {
+#if ENABLE_DISASSEMBLER
+      std::ostringstream os;
+      code->Disassemble(NULL, os);
+      data_->profiler_data->SetCode(&os);
+#endif
+    }
     info()->SetCode(code);
   }
 
+  if (FLAG_log_turbo_phases) {
+    LOG(isolate(), TurboCompileEndEvent(info()->optimization_id(),
+                                        info()->zone()->allocation_size()));
+  }
+
   // Print optimized code.
   v8::internal::CodeGenerator::PrintCode(code, info());
 
@@ -391,51 +508,82 @@ Handle<Code> Pipeline::GenerateCode(Linkage* linkage, Graph* graph,
     profiler_data = BasicBlockInstrumentor::Instrument(info_, graph, schedule);
   }
 
-  InstructionSequence sequence(linkage, graph, schedule);
+  InstructionSequence* sequence = SelectInstructionsAndAllocateRegisters(
+      linkage, graph, schedule, source_positions);
+  if (sequence == NULL) return Handle<Code>::null();
+
+  // Generate native sequence.
+  CodeGenerator generator(sequence);
+  Handle<Code> code = generator.GenerateCode();
+  if (profiler_data != NULL) {
+#if ENABLE_DISASSEMBLER
+    std::ostringstream os;
+    code->Disassemble(NULL, os);
+    profiler_data->SetCode(&os);
+#endif
+  }
+  return code;
+}
+
+
+InstructionSequence* Pipeline::SelectInstructionsAndAllocateRegisters(
+    Linkage* linkage, Graph* graph, Schedule* schedule,
+    SourcePositionTable* source_positions) {
+  void* buffer = zone()->New(sizeof(InstructionSequence));
+  InstructionSequence* sequence =
+      new (buffer) InstructionSequence(linkage, graph, schedule);
+
+  // The locals of the unoptimized frame keep their slots when entering OSR
+  // code, make sure the register allocator doesn't hand them out.
+  if (linkage->info()->is_osr()) {
+    OsrHelper osr_helper(linkage->info());
+    osr_helper.SetupFrame(sequence->frame());
+  }
 
   // Select and schedule instructions covering the scheduled graph.
   {
-    InstructionSelector selector(&sequence, source_positions);
+    PhaseStats selection_stats(info(), PhaseStats::CODEGEN,
+                               "instruction selection");
+    InstructionSelector selector(sequence, source_positions);
     selector.SelectInstructions();
   }
 
   if (FLAG_trace_turbo) {
     OFStream os(stdout);
     os << "----- Instruction sequence before register allocation -----\n"
-       << sequence;
+       << *sequence;
   }
 
   // Allocate registers.
   {
+    PhaseStats regalloc_stats(info(), PhaseStats::CODEGEN,
+                              "register allocation");
     int node_count = graph->NodeCount();
     if (node_count > UnallocatedOperand::kMaxVirtualRegisters) {
       linkage->info()->AbortOptimization(kNotEnoughVirtualRegistersForValues);
-      return Handle<Code>::null();
+      return NULL;
     }
-    RegisterAllocator allocator(&sequence);
+    RegisterAllocator allocator(sequence);
     if (!allocator.Allocate()) {
       linkage->info()->AbortOptimization(kNotEnoughVirtualRegistersRegalloc);
-      return Handle<Code>::null();
+      return NULL;
     }
   }
 
+  if (FLAG_turbo_move_optimization) {
+    PhaseStats move_optimization_stats(info(), PhaseStats::CODEGEN,
+                                       "move optimization");
+    Zone local_zone(isolate());
+    MoveOptimizer optimizer(&local_zone, sequence);
+    optimizer.Run();
+  }
+
   if (FLAG_trace_turbo) {
     OFStream os(stdout);
     os << "----- Instruction sequence after register allocation -----\n"
-       << sequence;
-  }
-
-  // Generate native sequence.
-  CodeGenerator generator(&sequence);
-  Handle<Code> code = generator.GenerateCode();
-  if (profiler_data != NULL) {
-#if ENABLE_DISASSEMBLER
-    std::ostringstream os;
-    code->Disassemble(NULL, os);
-    profiler_data->SetCode(&os);
-#endif
+       << *sequence;
   }
-  return code;
+  return sequence;
 }
 
 
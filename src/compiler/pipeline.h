@@ -18,17 +18,29 @@ namespace compiler {
 
 // Clients of this interface shouldn't depend on lots of compiler internals.
 class Graph;
+class InstructionSequence;
 class Schedule;
 class SourcePositionTable;
 class Linkage;
 
-class Pipeline {
+class Pipeline : public ZoneObject {
  public:
-  explicit Pipeline(CompilationInfo* info) : info_(info) {}
+  explicit Pipeline(CompilationInfo* info) : info_(info), data_(NULL) {}
 
   // Run the entire pipeline and generate a handle to a code object.
   Handle<Code> GenerateCode();
 
+  // The phases of GenerateCode, which an OptimizedCompileJob runs one by one.
+  // CreateGraph builds, specializes and lowers the graph and FinalizeCode
+  // generates the code object, both on the main thread. OptimizeGraph
+  // schedules the graph, selects instructions and allocates registers; it
+  // neither allocates on the heap nor dereferences handles and may run on
+  // the concurrent recompilation thread. CreateGraph and OptimizeGraph
+  // return false if compilation bailed out.
+  bool CreateGraph();
+  bool OptimizeGraph();
+  Handle<Code> FinalizeCode();
+
   // Run the pipeline on a machine graph and generate code. If {schedule}
   // is {NULL}, then compute a new schedule for code generation.
   Handle<Code> GenerateCodeForMachineGraph(Linkage* linkage, Graph* graph,
@@ -41,7 +53,10 @@ class Pipeline {
   static void TearDown();
 
  private:
+  class Data;
+
   CompilationInfo* info_;
+  Data* data_;
 
   CompilationInfo* info() const { return info_; }
   Isolate* isolate() { return info_->isolate(); }
@@ -51,6 +66,11 @@ class Pipeline {
   void VerifyAndPrintGraph(Graph* graph, const char* phase);
   Handle<Code> GenerateCode(Linkage* linkage, Graph* graph, Schedule* schedule,
                             SourcePositionTable* source_positions);
+
+  // Returns NULL if register allocation bailed out.
+  InstructionSequence* SelectInstructionsAndAllocateRegisters(
+      Linkage* linkage, Graph* graph, Schedule* schedule,
+      SourcePositionTable* source_positions);
 };
 }
 }
@@ -24,6 +24,29 @@ RawMachineAssembler::RawMachineAssembler(Graph* graph,
       parameters_(NULL),
       exit_label_(schedule()->end()),
       current_block_(schedule()->start()) {
+  InitializeParameters();
+}
+
+
+RawMachineAssembler::RawMachineAssembler(Graph* graph,
+                                         CallDescriptor* call_descriptor,
+                                         MachineType word)
+    : GraphBuilder(graph),
+      schedule_(new (zone()) Schedule(zone())),
+      machine_(word),
+      common_(zone()),
+      machine_sig_(const_cast<MachineSignature*>(
+          call_descriptor->GetMachineSignature())),
+      call_descriptor_(call_descriptor),
+      parameters_(NULL),
+      exit_label_(schedule()->end()),
+      current_block_(schedule()->start()) {
+  InitializeParameters();
+}
+
+
+void RawMachineAssembler::InitializeParameters() {
+  Graph* graph = this->graph();
   int param_count = static_cast<int>(parameter_count());
   Node* s = graph->NewNode(common_.Start(param_count));
   graph->SetStart(s);
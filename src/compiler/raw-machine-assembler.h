@@ -46,6 +46,10 @@ class RawMachineAssembler : public GraphBuilder {
 
   RawMachineAssembler(Graph* graph, MachineSignature* machine_sig,
                       MachineType word = kMachPtr);
+  // Builds code with the incoming linkage given by {call_descriptor}, e.g.
+  // a code stub called with a {CallInterfaceDescriptor}.
+  RawMachineAssembler(Graph* graph, CallDescriptor* call_descriptor,
+                      MachineType word = kMachPtr);
   virtual ~RawMachineAssembler() {}
 
   Isolate* isolate() const { return zone()->isolate(); }
@@ -424,6 +428,7 @@ class RawMachineAssembler : public GraphBuilder {
   }
 
  private:
+  void InitializeParameters();
   BasicBlock* Use(Label* label);
   BasicBlock* EnsureBlock(Label* label);
   BasicBlock* CurrentBlock();
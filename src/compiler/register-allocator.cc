@@ -500,6 +500,62 @@ LifetimePosition LiveRange::FirstIntersection(LiveRange* other) {
 }
 
 
+LiveRangeFinder::LiveRangeFinder(const ZoneList<LiveRange*>* live_ranges,
+                                 Zone* zone)
+    : live_ranges_(live_ranges),
+      zone_(zone),
+      arrays_(zone->NewArray<BoundArray>(live_ranges->length())) {
+  for (int i = 0; i < live_ranges->length(); ++i) {
+    arrays_[i].bounds = NULL;
+    arrays_[i].length = 0;
+  }
+}
+
+
+void LiveRangeFinder::Initialize(BoundArray* array, LiveRange* range) {
+  int length = 0;
+  for (LiveRange* cur = range; cur != NULL; cur = cur->next()) {
+    if (!cur->IsEmpty()) length++;
+  }
+  array->bounds = zone_->NewArray<Bound>(length);
+  array->length = length;
+  Bound* bound = array->bounds;
+  for (LiveRange* cur = range; cur != NULL; cur = cur->next()) {
+    if (cur->IsEmpty()) continue;
+    DCHECK(bound == array->bounds ||
+           (bound - 1)->end.Value() <= cur->Start().Value());
+    bound->start = cur->Start();
+    bound->end = cur->End();
+    bound->range = cur;
+    bound++;
+  }
+}
+
+
+LiveRange* LiveRangeFinder::FindChildCovering(LiveRange* range,
+                                              LifetimePosition position) {
+  DCHECK(range->parent() == NULL);
+  DCHECK(range->id() >= 0 && range->id() < live_ranges_->length());
+  BoundArray* array = &arrays_[range->id()];
+  if (array->bounds == NULL) Initialize(array, range);
+  // Find the last child that starts at or before {position}.
+  int left = 0;
+  int right = array->length;
+  while (left < right) {
+    int middle = left + (right - left) / 2;
+    if (array->bounds[middle].start.Value() <= position.Value()) {
+      left = middle + 1;
+    } else {
+      right = middle;
+    }
+  }
+  if (left == 0) return NULL;
+  Bound* bound = &array->bounds[left - 1];
+  if (position.Value() >= bound->end.Value()) return NULL;
+  return bound->range;
+}
+
+
 RegisterAllocator::RegisterAllocator(InstructionSequence* code)
     : zone_(code->isolate()),
       code_(code),
@@ -513,6 +569,7 @@ RegisterAllocator::RegisterAllocator(InstructionSequence* code)
       reusable_slots_(8, zone()),
       mode_(UNALLOCATED_REGISTERS),
       num_registers_(-1),
+      live_range_finder_(NULL),
       allocation_ok_(true) {}
 
 
@@ -1117,6 +1174,9 @@ bool RegisterAllocator::Allocate() {
   if (!AllocationOk()) return false;
   AllocateDoubleRegisters();
   if (!AllocationOk()) return false;
+  if (FLAG_turbo_live_range_arrays) {
+    live_range_finder_ = new (zone()) LiveRangeFinder(live_ranges(), zone());
+  }
   PopulatePointerMaps();
   ConnectRanges();
   ResolveControlFlow();
@@ -1153,17 +1213,22 @@ void RegisterAllocator::ResolveControlFlow(LiveRange* range, BasicBlock* block,
       LifetimePosition::FromInstructionIndex(block->first_instruction_index());
   LiveRange* pred_cover = NULL;
   LiveRange* cur_cover = NULL;
-  LiveRange* cur_range = range;
-  while (cur_range != NULL && (cur_cover == NULL || pred_cover == NULL)) {
-    if (cur_range->CanCover(cur_start)) {
-      DCHECK(cur_cover == NULL);
-      cur_cover = cur_range;
-    }
-    if (cur_range->CanCover(pred_end)) {
-      DCHECK(pred_cover == NULL);
-      pred_cover = cur_range;
+  if (live_range_finder_ != NULL) {
+    cur_cover = live_range_finder_->FindChildCovering(range, cur_start);
+    pred_cover = live_range_finder_->FindChildCovering(range, pred_end);
+  } else {
+    LiveRange* cur_range = range;
+    while (cur_range != NULL && (cur_cover == NULL || pred_cover == NULL)) {
+      if (cur_range->CanCover(cur_start)) {
+        DCHECK(cur_cover == NULL);
+        cur_cover = cur_range;
+      }
+      if (cur_range->CanCover(pred_end)) {
+        DCHECK(pred_cover == NULL);
+        pred_cover = cur_range;
+      }
+      cur_range = cur_range->next();
     }
-    cur_range = cur_range->next();
   }
 
   if (cur_cover->IsSpilled()) return;
@@ -1473,8 +1538,13 @@ void RegisterAllocator::PopulatePointerMaps() {
       LifetimePosition safe_point_pos =
           LifetimePosition::FromInstructionIndex(safe_point);
       LiveRange* cur = range;
-      while (cur != NULL && !cur->Covers(safe_point_pos)) {
-        cur = cur->next();
+      if (live_range_finder_ != NULL) {
+        cur = live_range_finder_->FindChildCovering(range, safe_point_pos);
+        if (cur != NULL && !cur->Covers(safe_point_pos)) cur = NULL;
+      } else {
+        while (cur != NULL && !cur->Covers(safe_point_pos)) {
+          cur = cur->next();
+        }
       }
       if (cur == NULL) continue;
 
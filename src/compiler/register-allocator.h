@@ -317,6 +317,42 @@ class LiveRange : public ZoneObject {
 };
 
 
+// Keeps the children of each top-level live range in an array sorted by
+// start position. Once allocation has stopped splitting ranges, this finds
+// the child that can cover a position by binary search rather than by
+// walking the chain of children, which becomes quadratic for values that
+// are split many times in large functions.
+class LiveRangeFinder : public ZoneObject {
+ public:
+  LiveRangeFinder(const ZoneList<LiveRange*>* live_ranges, Zone* zone);
+
+  // Returns the child of the top-level {range} for which CanCover(position)
+  // holds, or NULL if there is none.
+  LiveRange* FindChildCovering(LiveRange* range, LifetimePosition position);
+
+ private:
+  struct Bound {
+    LifetimePosition start;
+    LifetimePosition end;
+    LiveRange* range;
+  };
+
+  struct BoundArray {
+    Bound* bounds;
+    int length;
+  };
+
+  // Arrays are built on first use, most ranges are never looked up.
+  void Initialize(BoundArray* array, LiveRange* range);
+
+  const ZoneList<LiveRange*>* live_ranges_;
+  Zone* zone_;
+  BoundArray* arrays_;
+
+  DISALLOW_COPY_AND_ASSIGN(LiveRangeFinder);
+};
+
+
 class RegisterAllocator BASE_EMBEDDED {
  public:
   explicit RegisterAllocator(InstructionSequence* code);
@@ -519,6 +555,9 @@ class RegisterAllocator BASE_EMBEDDED {
   BitVector* assigned_registers_;
   BitVector* assigned_double_registers_;
 
+  // Only set with --turbo-live-range-arrays, after registers are assigned.
+  LiveRangeFinder* live_range_finder_;
+
   // Indicates success or failure during register allocation.
   bool allocation_ok_;
 
@@ -136,6 +136,7 @@ class BasicBlock FINAL : public ZoneObject {
   void set_code_end(int32_t end);
 
   bool deferred() const { return deferred_; }
+  void set_deferred(bool deferred) { deferred_ = deferred; }
 
   // Loop membership helpers.
   inline bool IsLoopHeader() const { return loop_end_ >= 0; }
@@ -179,6 +179,18 @@ class CFGBuilder {
     TraceConnect(branch, branch_block, successor_blocks[0]);
     TraceConnect(branch, branch_block, successor_blocks[1]);
 
+    // The unlikely successor of a hinted branch is the slow path.
+    switch (BranchHintOf(branch->op())) {
+      case kBranchNone:
+        break;
+      case kBranchTrue:
+        successor_blocks[1]->set_deferred(true);
+        break;
+      case kBranchFalse:
+        successor_blocks[0]->set_deferred(true);
+        break;
+    }
+
     schedule_->AddBranch(branch_block, branch, successor_blocks[0],
                          successor_blocks[1]);
   }
@@ -264,7 +276,8 @@ Scheduler::Placement Scheduler::GetPlacement(Node* node) {
   if (data->placement_ == kUnknown) {  // Compute placement, once, on demand.
     switch (node->opcode()) {
       case IrOpcode::kParameter:
-        // Parameters are always fixed to the start node.
+      case IrOpcode::kOsrValue:
+        // Parameters and OSR values are always fixed to the start node.
         data->placement_ = kFixed;
         break;
       case IrOpcode::kPhi:
@@ -347,6 +360,8 @@ void Scheduler::GenerateImmediateDominatorTree() {
       current_rpo->set_dominator(dominator);
       Trace("Block %d's idom is %d\n", current_rpo->id().ToInt(),
             dominator->id().ToInt());
+      // Blocks that are only reachable through a slow path are deferred too.
+      if (dominator->deferred()) current_rpo->set_deferred(true);
     }
   }
 }
@@ -437,7 +452,7 @@ class PrepareUsesVisitor : public NullNodeVisitor {
               node->op()->mnemonic());
         IrOpcode::Value opcode = node->opcode();
         BasicBlock* block =
-            opcode == IrOpcode::kParameter
+            (opcode == IrOpcode::kParameter || opcode == IrOpcode::kOsrValue)
                 ? schedule_->start()
                 : schedule_->block(NodeProperties::GetControlInput(node));
         DCHECK(block != NULL);
@@ -362,7 +362,8 @@ class RepresentationSelector {
       case IrOpcode::kStart:
       case IrOpcode::kDead:
         return VisitLeaf(node, 0);
-      case IrOpcode::kParameter: {
+      case IrOpcode::kParameter:
+      case IrOpcode::kOsrValue: {
         // TODO(titzer): use representation from linkage.
         Type* upper = NodeProperties::GetBounds(node).upper;
         ProcessInput(node, 0, 0);
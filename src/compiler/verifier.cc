@@ -122,7 +122,8 @@ GenericGraphVisit::Control Verifier::Visitor::Pre(Node* node) {
     for (Node::Uses::iterator it = uses.begin(); it != uses.end(); ++it) {
       CHECK(!NodeProperties::IsValueEdge(it.edge()) ||
             (*it)->opcode() == IrOpcode::kProjection ||
-            (*it)->opcode() == IrOpcode::kParameter);
+            (*it)->opcode() == IrOpcode::kParameter ||
+            (*it)->opcode() == IrOpcode::kOsrValue);
     }
   }
 
@@ -180,6 +181,14 @@ GenericGraphVisit::Control Verifier::Visitor::Pre(Node* node) {
       CHECK_GT(OperatorProperties::GetValueOutputCount(input->op()), index + 1);
       break;
     }
+    case IrOpcode::kOsrValue: {
+      // OSR values have the start node as inputs.
+      CHECK_EQ(1, input_count);
+      CHECK_EQ(IrOpcode::kStart,
+               NodeProperties::GetValueInput(node, 0)->opcode());
+      CHECK_LE(0, OpParameter<int>(node));
+      break;
+    }
     case IrOpcode::kInt32Constant:
     case IrOpcode::kInt64Constant:
     case IrOpcode::kFloat64Constant:
@@ -8,6 +8,7 @@
 #include "src/compiler/gap-resolver.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties-inl.h"
+#include "src/compiler/osr.h"
 #include "src/scopes.h"
 #include "src/x64/assembler-x64.h"
 #include "src/x64/macro-assembler-x64.h"
@@ -774,6 +775,22 @@ void CodeGenerator::AssemblePrologue() {
       __ bind(&ok);
     }
 
+    if (info->is_osr()) {
+      // TurboFan OSR-compiled functions cannot be entered directly.
+      __ Abort(kShouldNotDirectlyEnterOsrFunction);
+
+      // Unoptimized code jumps directly to this entrypoint while the
+      // unoptimized frame is still on the stack. The OSR values are read from
+      // that frame, so all that's left to do is to reload the context and
+      // function registers and to allocate the remaining stack slots.
+      osr_pc_offset_ = __ pc_offset();
+      __ movp(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
+      __ movp(rdi, Operand(rbp, JavaScriptFrameConstants::kFunctionOffset));
+      OsrHelper osr_helper(info);
+      DCHECK(stack_slots >= osr_helper.UnoptimizedFrameSlots());
+      stack_slots -= osr_helper.UnoptimizedFrameSlots();
+    }
+
   } else {
     __ StubPrologue();
     frame()->SetRegisterSaveAreaSize(
@@ -180,12 +180,19 @@ enum BindingFlags {
   V(PROMISE_CHAIN_INDEX, JSFunction, promise_chain)                            \
   V(PROMISE_CATCH_INDEX, JSFunction, promise_catch)                            \
   V(PROMISE_THEN_INDEX, JSFunction, promise_then)                              \
+  V(RUN_MICROTASK_BATCH_INDEX, JSFunction, run_microtask_batch)                \
   V(TO_COMPLETE_PROPERTY_DESCRIPTOR_INDEX, JSFunction,                         \
     to_complete_property_descriptor)                                           \
   V(DERIVED_HAS_TRAP_INDEX, JSFunction, derived_has_trap)                      \
   V(DERIVED_GET_TRAP_INDEX, JSFunction, derived_get_trap)                      \
   V(DERIVED_SET_TRAP_INDEX, JSFunction, derived_set_trap)                      \
   V(PROXY_ENUMERATE_INDEX, JSFunction, proxy_enumerate)                        \
+  V(SHARED_ARRAY_BUFFER_FUN_INDEX, JSFunction, shared_array_buffer_fun)        \
+  V(JS_MAP_FUN_INDEX, JSFunction, js_map_fun)                                  \
+  V(JS_SET_FUN_INDEX, JSFunction, js_set_fun)                                  \
+  V(FLOAT32X4_FUNCTION_INDEX, JSFunction, float32x4_function)                  \
+  V(INT32X4_FUNCTION_INDEX, JSFunction, int32x4_function)                      \
+  V(FLOAT64X2_FUNCTION_INDEX, JSFunction, float64x2_function)                  \
   V(OBSERVERS_NOTIFY_CHANGE_INDEX, JSFunction, observers_notify_change)        \
   V(OBSERVERS_ENQUEUE_SPLICE_INDEX, JSFunction, observers_enqueue_splice)      \
   V(OBSERVERS_BEGIN_SPLICE_INDEX, JSFunction, observers_begin_perform_splice)  \
@@ -377,11 +384,18 @@ class Context: public FixedArray {
     PROMISE_CHAIN_INDEX,
     PROMISE_CATCH_INDEX,
     PROMISE_THEN_INDEX,
+    RUN_MICROTASK_BATCH_INDEX,
     TO_COMPLETE_PROPERTY_DESCRIPTOR_INDEX,
     DERIVED_HAS_TRAP_INDEX,
     DERIVED_GET_TRAP_INDEX,
     DERIVED_SET_TRAP_INDEX,
     PROXY_ENUMERATE_INDEX,
+    SHARED_ARRAY_BUFFER_FUN_INDEX,
+    JS_MAP_FUN_INDEX,
+    JS_SET_FUN_INDEX,
+    FLOAT32X4_FUNCTION_INDEX,
+    INT32X4_FUNCTION_INDEX,
+    FLOAT64X2_FUNCTION_INDEX,
     OBSERVERS_NOTIFY_CHANGE_INDEX,
     OBSERVERS_ENQUEUE_SPLICE_INDEX,
     OBSERVERS_BEGIN_SPLICE_INDEX,
@@ -4,6 +4,12 @@
 
 #include "src/v8.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+#include "src/base/bits.h"
 #include "src/base/platform/platform.h"
 #include "src/counters.h"
 #include "src/isolate.h"
@@ -34,9 +40,85 @@ void* Histogram::CreateHistogram() const {
 }
 
 
+int HdrHistogram::BucketIndex(int value) {
+  if (value < 2 * kSubBucketCount) return value;
+  int shift = 31 - base::bits::CountLeadingZeros32(value) - kSubBucketBits;
+  return (shift << kSubBucketBits) + (value >> shift);
+}
+
+
+int HdrHistogram::BucketUpperBound(int index) {
+  if (index < 2 * kSubBucketCount) return index;
+  int shift = (index >> kSubBucketBits) - 1;
+  int sub_bucket = index - (shift << kSubBucketBits);
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+
+void HdrHistogram::AddSample(int sample) {
+  if (sample < 0) sample = 0;
+  base::NoBarrier_AtomicIncrement(&counts_[BucketIndex(sample)], 1);
+  base::Atomic32 max = base::NoBarrier_Load(&max_);
+  while (sample > max) {
+    base::Atomic32 previous =
+        base::NoBarrier_CompareAndSwap(&max_, max, sample);
+    if (previous == max) break;
+    max = previous;
+  }
+}
+
+
+int HdrHistogram::count() const {
+  int count = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    count += base::NoBarrier_Load(&counts_[i]);
+  }
+  return count;
+}
+
+
+int HdrHistogram::Percentile(double percentage) const {
+  int count = this->count();
+  if (count == 0) return 0;
+  double target = Max(1.0, std::ceil(count * percentage / 100));
+  int seen = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    seen += base::NoBarrier_Load(&counts_[i]);
+    if (seen >= target) return Min(BucketUpperBound(i), max());
+  }
+  return max();
+}
+
+
+void HdrHistogram::Reset() {
+  for (int i = 0; i < kBucketCount; i++) {
+    base::NoBarrier_Store(&counts_[i], 0);
+  }
+  base::NoBarrier_Store(&max_, 0);
+}
+
+
+bool HistogramTimer::ShouldTime() {
+  return Enabled() || (FLAG_native_histograms && native_histogram_ != NULL);
+}
+
+
+void HistogramTimer::AddTimedSample(base::TimeDelta elapsed) {
+  if (Enabled()) {
+    // The embedder histograms are in milliseconds.
+    AddSample(static_cast<int>(elapsed.InMilliseconds()));
+  }
+  if (FLAG_native_histograms && native_histogram_ != NULL) {
+    int64_t microseconds = elapsed.InMicroseconds();
+    native_histogram_->AddSample(
+        static_cast<int>(Min(microseconds, static_cast<int64_t>(kMaxInt))));
+  }
+}
+
+
 // Start the timer.
 void HistogramTimer::Start() {
-  if (Enabled()) {
+  if (ShouldTime()) {
     timer_.Start();
   }
   isolate()->event_logger()(name(), Logger::START);
@@ -45,23 +127,111 @@ void HistogramTimer::Start() {
 
 // Stop the timer and record the results.
 void HistogramTimer::Stop() {
-  if (Enabled()) {
-    // Compute the delta between start and stop, in milliseconds.
-    AddSample(static_cast<int>(timer_.Elapsed().InMilliseconds()));
+  if (timer_.IsStarted()) {
+    AddTimedSample(timer_.Elapsed());
     timer_.Stop();
   }
   isolate()->event_logger()(name(), Logger::END);
 }
 
 
+// The number of runtime call counter indices handed out so far, shared by
+// all isolates.
+static base::Atomic32 runtime_call_counter_count = 0;
+
+
+void RuntimeCallStats::Enter(Timer* timer, RuntimeCallCounterId* id) {
+  int index = base::Acquire_Load(&id->index);
+  if (index == 0) {
+    int new_index =
+        base::NoBarrier_AtomicIncrement(&runtime_call_counter_count, 1);
+    // If another thread won the race, its index is used and ours is lost.
+    index = base::Release_CompareAndSwap(&id->index, 0, new_index);
+    if (index == 0) index = new_index;
+  }
+  index--;
+
+  timer->counter_ = NULL;
+  if (index < kMaxCounters) {
+    if (counters_ == NULL) {
+      counters_ = NewArray<Counter>(kMaxCounters);
+      for (int i = 0; i < kMaxCounters; i++) counters_[i].name = NULL;
+      Reset();
+    }
+    timer->counter_ = &counters_[index];
+    timer->counter_->name = id->name;
+    timer->counter_->count++;
+  }
+  timer->parent_ = current_;
+  timer->nested_time_ = base::TimeDelta();
+  timer->elapsed_.Start();
+  current_ = timer;
+}
+
+
+void RuntimeCallStats::Leave(Timer* timer) {
+  DCHECK(current_ == timer);
+  base::TimeDelta elapsed = timer->elapsed_.Elapsed();
+  timer->elapsed_.Stop();
+  if (timer->counter_ != NULL) {
+    timer->counter_->time += elapsed - timer->nested_time_;
+  }
+  current_ = timer->parent_;
+  if (current_ != NULL) current_->nested_time_ += elapsed;
+}
+
+
+void RuntimeCallStats::Reset() {
+  if (counters_ == NULL) return;
+  for (int i = 0; i < kMaxCounters; i++) {
+    counters_[i].count = 0;
+    counters_[i].time = base::TimeDelta();
+  }
+}
+
+
+static bool CompareRuntimeCallCounters(const RuntimeCallStats::Counter* a,
+                                       const RuntimeCallStats::Counter* b) {
+  return a->time > b->time;
+}
+
+
+std::ostream& operator<<(std::ostream& os, const RuntimeCallStats& stats) {
+  std::vector<const RuntimeCallStats::Counter*> counters;
+  for (int i = 0; i < RuntimeCallStats::kMaxCounters; i++) {
+    const RuntimeCallStats::Counter* counter = stats.counter(i);
+    if (counter != NULL && counter->count > 0) counters.push_back(counter);
+  }
+  std::sort(counters.begin(), counters.end(), CompareRuntimeCallCounters);
+  os << std::setw(50) << std::left << "Runtime function/builtin" << std::right
+     << std::setw(12) << "Time (ms)" << std::setw(12) << "Count"
+     << std::endl;
+  for (size_t i = 0; i < counters.size(); i++) {
+    os << std::setw(50) << std::left << counters[i]->name << std::right
+       << std::setw(12) << std::fixed << std::setprecision(3)
+       << counters[i]->time.InMillisecondsF() << std::setw(12)
+       << counters[i]->count << std::endl;
+  }
+  return os;
+}
+
+
+void RuntimeCallTimerScope::Enter(Isolate* isolate,
+                                  RuntimeCallCounterId* id) {
+  stats_ = isolate->counters()->runtime_call_stats();
+  stats_->Enter(&timer_, id);
+}
+
+
 Counters::Counters(Isolate* isolate) {
 #define HR(name, caption, min, max, num_buckets) \
   name##_ = Histogram(#caption, min, max, num_buckets, isolate);
   HISTOGRAM_RANGE_LIST(HR)
 #undef HR
 
-#define HT(name, caption) \
-    name##_ = HistogramTimer(#caption, 0, 10000, 50, isolate);
+#define HT(name, caption)                                       \
+    name##_ = HistogramTimer(#caption, 0, 10000, 50, isolate); \
+    name##_.set_native_histogram(&native_timer_histograms_[k_##name]);
     HISTOGRAM_TIMER_LIST(HT)
 #undef HT
 
@@ -114,6 +284,17 @@ Counters::Counters(Isolate* isolate) {
 }
 
 
+HistogramTimer* Counters::histogram_timer(int index) {
+  DCHECK(0 <= index && index < kNumberOfHistogramTimers);
+  HistogramTimer* timers[] = {
+#define HT(name, caption) &name##_,
+      HISTOGRAM_TIMER_LIST(HT)
+#undef HT
+  };
+  return timers[index];
+}
+
+
 void Counters::ResetCounters() {
 #define SC(name, caption) name##_.Reset();
   STATS_COUNTER_LIST_1(SC)
@@ -7,6 +7,7 @@
 
 #include "include/v8.h"
 #include "src/allocation.h"
+#include "src/base/atomicops.h"
 #include "src/base/platform/elapsed-timer.h"
 #include "src/globals.h"
 #include "src/objects.h"
@@ -164,6 +165,43 @@ class StatsCounter {
   bool lookup_done_;
 };
 
+// A lock-free histogram of non-negative samples. The samples are grouped
+// into power of two ranges that are each split into kSubBucketCount linear
+// sub-buckets, so the reported values are accurate to within
+// 1 / kSubBucketCount of the sample regardless of its magnitude. Samples
+// can be added concurrently from any thread.
+class HdrHistogram {
+ public:
+  HdrHistogram() { Reset(); }
+
+  void AddSample(int sample);
+
+  // Returns the value below which the given percentage of the samples
+  // falls, rounded up to the resolution of the histogram, or 0 if there
+  // are no samples.
+  int Percentile(double percentage) const;
+
+  int count() const;
+  int max() const { return base::NoBarrier_Load(&max_); }
+
+  void Reset();
+
+ private:
+  static const int kSubBucketBits = 4;
+  static const int kSubBucketCount = 1 << kSubBucketBits;
+  // Values below 2 * kSubBucketCount get a bucket each, every power of two
+  // above that gets kSubBucketCount buckets.
+  static const int kBucketCount = (33 - kSubBucketBits) * kSubBucketCount;
+
+  static int BucketIndex(int value);
+  static int BucketUpperBound(int index);
+
+  base::Atomic32 counts_[kBucketCount];
+  base::Atomic32 max_;
+
+  DISALLOW_COPY_AND_ASSIGN(HdrHistogram);
+};
+
 // A Histogram represents a dynamically created histogram in the StatsTable.
 // It will be registered with the histogram system on first use.
 class Histogram {
@@ -195,6 +233,8 @@ class Histogram {
     lookup_done_ = false;
   }
 
+  const char* name() { return name_; }
+
  protected:
   // Returns the handle to the histogram.
   void* GetHistogram() {
@@ -205,7 +245,6 @@ class Histogram {
     return histogram_;
   }
 
-  const char* name() { return name_; }
   Isolate* isolate() const { return isolate_; }
 
  private:
@@ -229,7 +268,8 @@ class HistogramTimer : public Histogram {
                  int max,
                  int num_buckets,
                  Isolate* isolate)
-      : Histogram(name, min, max, num_buckets, isolate) {}
+      : Histogram(name, min, max, num_buckets, isolate),
+        native_histogram_(NULL) {}
 
   // Start the timer.
   void Start();
@@ -239,7 +279,21 @@ class HistogramTimer : public Histogram {
 
   // Returns true if the timer is running.
   bool Running() {
-    return Enabled() && timer_.IsStarted();
+    return timer_.IsStarted();
+  }
+
+  // Returns true if either the embedder or the built-in histogram wants
+  // the samples of this timer.
+  bool ShouldTime();
+
+  // Record an externally measured duration.
+  void AddTimedSample(base::TimeDelta elapsed);
+
+  // The built-in histogram that receives the durations in microseconds
+  // with --native-histograms.
+  HdrHistogram* native_histogram() { return native_histogram_; }
+  void set_native_histogram(HdrHistogram* histogram) {
+    native_histogram_ = histogram;
   }
 
   // TODO(bmeurer): Remove this when HistogramTimerScope is fixed.
@@ -249,6 +303,7 @@ class HistogramTimer : public Histogram {
 
  private:
   base::ElapsedTimer timer_;
+  HdrHistogram* native_histogram_;
 };
 
 // Helper class for scoping a HistogramTimer.
@@ -291,6 +346,105 @@ class HistogramTimerScope BASE_EMBEDDED {
 #endif
 };
 
+// Helper class for timing a HistogramTimer with a timer that lives on the
+// stack. Unlike HistogramTimerScope it can be nested, so it can be used in
+// reentrant code like the IC miss handlers.
+class NestableHistogramTimerScope BASE_EMBEDDED {
+ public:
+  explicit NestableHistogramTimerScope(HistogramTimer* timer)
+      : timer_(timer) {
+    if (timer_->ShouldTime()) elapsed_.Start();
+  }
+  ~NestableHistogramTimerScope() {
+    if (elapsed_.IsStarted()) timer_->AddTimedSample(elapsed_.Elapsed());
+  }
+
+ private:
+  HistogramTimer* timer_;
+  base::ElapsedTimer elapsed_;
+};
+
+// Identifies a C++ runtime function or builtin for RuntimeCallStats. The
+// RUNTIME_FUNCTION and BUILTIN macros define a statically initialized
+// instance per function, which is assigned a process wide index on first
+// use.
+struct RuntimeCallCounterId {
+  const char* name;
+  // One more than the index of the counter, or 0 if none is assigned yet.
+  base::Atomic32 index;
+};
+
+
+// Counts the calls into the C++ runtime functions and builtins of an
+// isolate with --runtime-call-stats, and the time spent in them. The time
+// of nested runtime calls is only attributed to the innermost function.
+class RuntimeCallStats {
+ public:
+  static const int kMaxCounters = 1024;
+
+  struct Counter {
+    const char* name;
+    int64_t count;
+    base::TimeDelta time;
+  };
+
+  class Timer {
+   private:
+    Counter* counter_;
+    Timer* parent_;
+    base::ElapsedTimer elapsed_;
+    base::TimeDelta nested_time_;
+
+    friend class RuntimeCallStats;
+  };
+
+  RuntimeCallStats() : counters_(NULL), current_(NULL) {}
+  ~RuntimeCallStats() { DeleteArray(counters_); }
+
+  // Starts timing a call to the given function.
+  void Enter(Timer* timer, RuntimeCallCounterId* id);
+
+  // Stops timing the innermost call, which must be the given timer.
+  void Leave(Timer* timer);
+
+  // Returns the counter with the given index, or NULL if the corresponding
+  // function has not been called in this isolate.
+  const Counter* counter(int index) const {
+    if (counters_ == NULL || counters_[index].name == NULL) return NULL;
+    return &counters_[index];
+  }
+
+  void Reset();
+
+ private:
+  Counter* counters_;
+  Timer* current_;
+
+  DISALLOW_COPY_AND_ASSIGN(RuntimeCallStats);
+};
+
+std::ostream& operator<<(std::ostream& os, const RuntimeCallStats& stats);
+
+
+// Helper class for timing the body of a runtime function or builtin, see
+// RUNTIME_FUNCTION and BUILTIN.
+class RuntimeCallTimerScope BASE_EMBEDDED {
+ public:
+  RuntimeCallTimerScope(Isolate* isolate, RuntimeCallCounterId* id)
+      : stats_(NULL) {
+    if (FLAG_runtime_call_stats) Enter(isolate, id);
+  }
+  ~RuntimeCallTimerScope() {
+    if (stats_ != NULL) stats_->Leave(&timer_);
+  }
+
+ private:
+  void Enter(Isolate* isolate, RuntimeCallCounterId* id);
+
+  RuntimeCallStats* stats_;
+  RuntimeCallStats::Timer timer_;
+};
+
 #define HISTOGRAM_RANGE_LIST(HR)                                              \
   /* Generic range histograms */                                              \
   HR(gc_idle_time_allotted_in_ms, V8.GCIdleTimeAllottedInMS, 0, 10000, 101)   \
@@ -314,7 +468,9 @@ class HistogramTimerScope BASE_EMBEDDED {
   HT(compile_eval, V8.CompileEval)                           \
   /* Serialization as part of compilation (code caching) */  \
   HT(compile_serialize, V8.CompileSerialize)                 \
-  HT(compile_deserialize, V8.CompileDeserialize)
+  HT(compile_deserialize, V8.CompileDeserialize)             \
+  /* Inline cache misses. */                                 \
+  HT(ic_miss, V8.ICMiss)
 
 
 #define HISTOGRAM_PERCENTAGE_LIST(HP)                                 \
@@ -418,6 +574,12 @@ class HistogramTimerScope BASE_EMBEDDED {
   SC(total_compile_size, V8.TotalCompileSize)                         \
   /* Amount of source code compiled with the full codegen. */         \
   SC(total_full_codegen_source_size, V8.TotalFullCodegenSourceSize)   \
+  /* Number of functions whose unoptimized code was flushed. */       \
+  SC(code_flushed_functions, V8.CodeFlushedFunctions)                 \
+  /* Amount of unoptimized code released by code flushing. */         \
+  SC(code_flushed_size, V8.CodeFlushedSize)                           \
+  /* Number of flushed functions that had to be compiled again. */    \
+  SC(code_flushed_recompiled, V8.CodeFlushedRecompiled)               \
   /* Number of contexts created from scratch. */                      \
   SC(contexts_created_from_scratch, V8.ContextsCreatedFromScratch)    \
   /* Number of contexts created by partial snapshot. */               \
@@ -447,6 +609,10 @@ class HistogramTimerScope BASE_EMBEDDED {
   SC(keyed_load_generic_smi, V8.KeyedLoadGenericSmi)                           \
   SC(keyed_load_generic_symbol, V8.KeyedLoadGenericSymbol)                     \
   SC(keyed_load_generic_lookup_cache, V8.KeyedLoadGenericLookupCache)          \
+  SC(keyed_lookup_cache_hits, V8.KeyedLookupCacheHits)                         \
+  SC(keyed_lookup_cache_misses, V8.KeyedLookupCacheMisses)                     \
+  SC(descriptor_lookup_cache_hits, V8.DescriptorLookupCacheHits)               \
+  SC(descriptor_lookup_cache_misses, V8.DescriptorLookupCacheMisses)           \
   SC(keyed_load_generic_slow, V8.KeyedLoadGenericSlow)                         \
   SC(keyed_load_polymorphic_stubs, V8.KeyedLoadPolymorphicStubs)               \
   SC(keyed_load_external_array_slow, V8.KeyedLoadExternalArraySlow)            \
@@ -484,6 +650,10 @@ class HistogramTimerScope BASE_EMBEDDED {
   SC(megamorphic_stub_cache_probes, V8.MegamorphicStubCacheProbes)             \
   SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)             \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)           \
+  /* Primary stub cache entries displaced by a different (name, map). */       \
+  SC(megamorphic_stub_cache_collisions, V8.MegamorphicStubCacheCollisions)     \
+  /* Displaced entries that overwrote a live secondary entry. */               \
+  SC(megamorphic_stub_cache_evictions, V8.MegamorphicStubCacheEvictions)       \
   SC(array_function_runtime, V8.ArrayFunctionRuntime)                          \
   SC(array_function_native, V8.ArrayFunctionNative)                            \
   SC(for_in, V8.ForIn)                                                         \
@@ -505,10 +675,6 @@ class HistogramTimerScope BASE_EMBEDDED {
   SC(regexp_entry_native, V8.RegExpEntryNative)                                \
   SC(number_to_string_native, V8.NumberToStringNative)                         \
   SC(number_to_string_runtime, V8.NumberToStringRuntime)                       \
-  SC(math_acos, V8.MathAcos)                                                   \
-  SC(math_asin, V8.MathAsin)                                                   \
-  SC(math_atan, V8.MathAtan)                                                   \
-  SC(math_atan2, V8.MathAtan2)                                                 \
   SC(math_exp, V8.MathExp)                                                     \
   SC(math_floor, V8.MathFloor)                                                 \
   SC(math_log, V8.MathLog)                                                     \
@@ -519,9 +685,15 @@ class HistogramTimerScope BASE_EMBEDDED {
   SC(runtime_profiler_ticks, V8.RuntimeProfilerTicks)                          \
   SC(bounds_checks_eliminated, V8.BoundsChecksEliminated)                      \
   SC(bounds_checks_hoisted, V8.BoundsChecksHoisted)                            \
+  SC(allocations_folded, V8.AllocationsFolded)                                 \
   SC(soft_deopts_requested, V8.SoftDeoptsRequested)                            \
   SC(soft_deopts_inserted, V8.SoftDeoptsInserted)                              \
   SC(soft_deopts_executed, V8.SoftDeoptsExecuted)                              \
+  /* Optimized code installed for a function, and deoptimizations. */          \
+  SC(optimized_functions, V8.OptimizedFunctions)                               \
+  SC(deoptimizations, V8.Deoptimizations)                                      \
+  /* Optimizations refused because of --max-opt-count. */                      \
+  SC(max_opt_count_reached, V8.MaxOptCountReached)                             \
   /* Number of write barriers in generated code. */                            \
   SC(write_barriers_dynamic, V8.WriteBarriersDynamic)                          \
   SC(write_barriers_static, V8.WriteBarriersStatic)                            \
@@ -646,6 +818,15 @@ class Counters {
     stats_counter_count
   };
 
+#define HT(name, caption) +1
+  static const int kNumberOfHistogramTimers = 0 HISTOGRAM_TIMER_LIST(HT);
+#undef HT
+
+  // Returns the histogram timers in the order of HISTOGRAM_TIMER_LIST.
+  HistogramTimer* histogram_timer(int index);
+
+  RuntimeCallStats* runtime_call_stats() { return &runtime_call_stats_; }
+
   void ResetCounters();
   void ResetHistograms();
 
@@ -699,6 +880,10 @@ class Counters {
   CODE_AGE_LIST_COMPLETE(SC)
 #undef SC
 
+  HdrHistogram native_timer_histograms_[kNumberOfHistogramTimers];
+
+  RuntimeCallStats runtime_call_stats_;
+
   friend class Isolate;
 
   explicit Counters(Isolate* isolate);
@@ -371,6 +371,7 @@ CpuProfiler::CpuProfiler(Isolate* isolate)
     : isolate_(isolate),
       sampling_interval_(base::TimeDelta::FromMicroseconds(
           FLAG_cpu_profiler_sampling_interval)),
+      cpu_time_sampling_(FLAG_cpu_profiler_cpu_time_sampling),
       profiles_(new CpuProfilesCollection(isolate->heap())),
       generator_(NULL),
       processor_(NULL),
@@ -385,6 +386,7 @@ CpuProfiler::CpuProfiler(Isolate* isolate,
     : isolate_(isolate),
       sampling_interval_(base::TimeDelta::FromMicroseconds(
           FLAG_cpu_profiler_sampling_interval)),
+      cpu_time_sampling_(FLAG_cpu_profiler_cpu_time_sampling),
       profiles_(test_profiles),
       generator_(test_generator),
       processor_(test_processor),
@@ -404,6 +406,12 @@ void CpuProfiler::set_sampling_interval(base::TimeDelta value) {
 }
 
 
+void CpuProfiler::set_cpu_time_sampling(bool value) {
+  DCHECK(!is_profiling_);
+  cpu_time_sampling_ = value;
+}
+
+
 void CpuProfiler::ResetProfiles() {
   delete profiles_;
   profiles_ = new CpuProfilesCollection(isolate()->heap());
@@ -447,6 +455,7 @@ void CpuProfiler::StartProcessorIfNotStarted() {
   // Enable stack sampling.
   sampler->SetHasProcessingThread(true);
   sampler->IncreaseProfilingDepth();
+  if (cpu_time_sampling_) sampler->StartCpuTimeSampling(sampling_interval_);
   processor_->AddCurrentStack(isolate_);
   processor_->StartSynchronously();
 }
@@ -471,8 +480,31 @@ CpuProfile* CpuProfiler::StopProfiling(String* title) {
 }
 
 
+void CpuProfiler::StartContinuousProfiling(int max_stacks) {
+  if (profiles_->StartContinuousProfiling(max_stacks)) {
+    StartProcessorIfNotStarted();
+  }
+}
+
+
+void CpuProfiler::DrainContinuousProfile(
+    v8::ContinuousProfileVisitor* visitor) {
+  profiles_->DrainContinuousProfile(visitor);
+}
+
+
+void CpuProfiler::StopContinuousProfiling() {
+  if (!profiles_->is_continuous_profiling()) return;
+  if (is_profiling_ && !profiles_->HasCurrentProfiles()) StopProcessor();
+  profiles_->StopContinuousProfiling();
+}
+
+
 void CpuProfiler::StopProcessorIfLastProfile(const char* title) {
-  if (profiles_->IsLastProfile(title)) StopProcessor();
+  if (profiles_->IsLastProfile(title) &&
+      !profiles_->is_continuous_profiling()) {
+    StopProcessor();
+  }
 }
 
 
@@ -485,6 +517,7 @@ void CpuProfiler::StopProcessor() {
   delete generator_;
   processor_ = NULL;
   generator_ = NULL;
+  sampler->StopCpuTimeSampling();
   sampler->SetHasProcessingThread(false);
   sampler->DecreaseProfilingDepth();
   logger->is_logging_ = saved_is_logging_;
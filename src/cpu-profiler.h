@@ -201,10 +201,14 @@ class CpuProfiler : public CodeEventListener {
   virtual ~CpuProfiler();
 
   void set_sampling_interval(base::TimeDelta value);
+  void set_cpu_time_sampling(bool value);
   void StartProfiling(const char* title, bool record_samples = false);
   void StartProfiling(String* title, bool record_samples);
   CpuProfile* StopProfiling(const char* title);
   CpuProfile* StopProfiling(String* title);
+  void StartContinuousProfiling(int max_stacks);
+  void DrainContinuousProfile(v8::ContinuousProfileVisitor* visitor);
+  void StopContinuousProfiling();
   int GetProfilesCount();
   CpuProfile* GetProfile(int index);
   void DeleteAllProfiles();
@@ -257,6 +261,7 @@ class CpuProfiler : public CodeEventListener {
 
   Isolate* isolate_;
   base::TimeDelta sampling_interval_;
+  bool cpu_time_sampling_;
   CpuProfilesCollection* profiles_;
   ProfileGenerator* generator_;
   ProfilerEventsProcessor* processor_;
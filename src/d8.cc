@@ -49,6 +49,8 @@
 #include "src/basic-block-profiler.h"
 #include "src/d8-debug.h"
 #include "src/debug.h"
+#include "src/deoptimizer.h"
+#include "src/libplatform/default-platform.h"
 #include "src/natives.h"
 #include "src/v8.h"
 #endif  // !V8_SHARED
@@ -152,6 +154,8 @@ CounterCollection* Shell::counters_ = &local_counters_;
 base::Mutex Shell::context_mutex_;
 const base::TimeTicks Shell::kInitialTicks =
     base::TimeTicks::HighResolutionNow();
+base::Mutex Shell::workers_mutex_;
+i::List<Worker*> Shell::workers_;
 Persistent<Context> Shell::utility_context_;
 #endif  // !V8_SHARED
 
@@ -345,6 +349,253 @@ void Shell::PerformanceNow(const v8::FunctionCallbackInfo<v8::Value>& args) {
     args.GetReturnValue().Set(delta.InMillisecondsF());
   }
 }
+
+
+// Running totals of the garbage collections and compilations of all
+// isolates, for attributing outliers in iteration latency.
+struct PauseTotals {
+  int scavenges;
+  double scavenge_time;
+  int mark_compacts;
+  double mark_compact_time;
+  double incremental_marking_time;
+  int compiles;
+  int optimizations;
+};
+
+static PauseTotals pause_totals;
+static base::LazyMutex pause_totals_mutex = LAZY_MUTEX_INITIALIZER;
+
+
+// The individual collections since the last call of performance.pauses(true),
+// also guarded by pause_totals_mutex. Collections beyond the capacity of the
+// log are only counted.
+struct GCPauseRecord {
+  GCType type;
+  double start_time;
+  double duration;
+  size_t size_after;
+};
+
+static const int kGCPauseLogCapacity = 64 * 1024;
+static GCPauseRecord gc_pause_log[kGCPauseLogCapacity];
+static int gc_pause_log_length = 0;
+static int gc_pause_log_dropped = 0;
+
+
+static void RecordGCPause(Isolate* isolate, const GCStatistics& statistics) {
+  base::LockGuard<base::Mutex> lock(pause_totals_mutex.Pointer());
+  if (statistics.type() == kGCTypeScavenge) {
+    pause_totals.scavenges++;
+    pause_totals.scavenge_time += statistics.duration();
+  } else {
+    pause_totals.mark_compacts++;
+    pause_totals.mark_compact_time += statistics.duration();
+  }
+  pause_totals.incremental_marking_time +=
+      statistics.incremental_marking_duration();
+  if (gc_pause_log_length == kGCPauseLogCapacity) {
+    gc_pause_log_dropped++;
+    return;
+  }
+  GCPauseRecord* record = &gc_pause_log[gc_pause_log_length++];
+  record->type = statistics.type();
+  record->start_time = statistics.start_time();
+  record->duration = statistics.duration();
+  record->size_after = statistics.size_after();
+}
+
+
+static bool StartsWith(const char* str, size_t len, const char* prefix) {
+  size_t prefix_len = strlen(prefix);
+  return len >= prefix_len && strncmp(str, prefix, prefix_len) == 0;
+}
+
+
+// Counts the code objects created for JavaScript functions and scripts, by
+// both the full and the optimizing compilers. Stubs and ICs are not counted.
+// The names of optimized code start with a '*' after the tag.
+static void RecordCompile(const JitCodeEvent* event) {
+  if (event->type != JitCodeEvent::CODE_ADDED) return;
+  static const char* const kTags[] = {"LazyCompile:", "Function:", "Script:",
+                                      "Eval:"};
+  const char* str = event->name.str;
+  size_t len = event->name.len;
+  for (size_t i = 0; i < arraysize(kTags); ++i) {
+    if (!StartsWith(str, len, kTags[i])) continue;
+    size_t tag_len = strlen(kTags[i]);
+    base::LockGuard<base::Mutex> lock(pause_totals_mutex.Pointer());
+    pause_totals.compiles++;
+    if (len > tag_len && str[tag_len] == '*') pause_totals.optimizations++;
+    return;
+  }
+}
+
+
+// The code event handlers of --gdbjit and VTune must not be replaced, in
+// which case compilations are not counted.
+static bool HasCodeEventHandler() {
+#if defined(ENABLE_VTUNE_JIT_INTERFACE)
+  return true;
+#elif defined(ENABLE_GDB_JIT_INTERFACE)
+  return i::FLAG_gdbjit;
+#else
+  return false;
+#endif
+}
+
+
+// Starts counting the pauses and compilations of {isolate}.
+static void InstallPauseCounters(Isolate* isolate) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  if (i_isolate->heap()->tracer()->statistics_callback() == RecordGCPause) {
+    return;
+  }
+  isolate->SetGCStatisticsCallback(RecordGCPause);
+  if (!HasCodeEventHandler()) {
+    isolate->SetJitCodeEventHandler(kJitCodeEventDefault, RecordCompile);
+  }
+}
+
+
+static PauseTotals GetPauseTotals() {
+  base::LockGuard<base::Mutex> lock(pause_totals_mutex.Pointer());
+  return pause_totals;
+}
+
+
+static void SetNumber(Isolate* isolate, Handle<Object> object,
+                      const char* name, double value) {
+  object->Set(String::NewFromUtf8(isolate, name), Number::New(isolate, value));
+}
+
+
+// Returns the resident set size of the process in bytes, or -1 where it is
+// not known.
+static double GetResidentSetSize() {
+#if V8_OS_LINUX
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (file == NULL) return -1;
+  long size = 0;      // NOLINT(runtime/int)
+  long resident = 0;  // NOLINT(runtime/int)
+  int fields = fscanf(file, "%ld %ld", &size, &resident);
+  fclose(file);
+  if (fields != 2) return -1;
+  return static_cast<double>(resident) * sysconf(_SC_PAGESIZE);
+#else
+  return -1;
+#endif
+}
+
+
+// Adds the collections logged since the previous call to {result} as a
+// "collections" array and resets the log.
+static void DrainGCPauseLog(Isolate* isolate, Handle<Object> result) {
+  base::LockGuard<base::Mutex> lock(pause_totals_mutex.Pointer());
+  Handle<Array> collections = Array::New(isolate, gc_pause_log_length);
+  for (int i = 0; i < gc_pause_log_length; ++i) {
+    const GCPauseRecord& record = gc_pause_log[i];
+    Handle<Object> pause = Object::New(isolate);
+    pause->Set(String::NewFromUtf8(isolate, "type"),
+               String::NewFromUtf8(isolate, record.type == kGCTypeScavenge
+                                                ? "scavenge"
+                                                : "mark-compact"));
+    SetNumber(isolate, pause, "start", record.start_time);
+    SetNumber(isolate, pause, "duration", record.duration);
+    SetNumber(isolate, pause, "sizeAfter",
+              static_cast<double>(record.size_after));
+    collections->Set(i, pause);
+  }
+  result->Set(String::NewFromUtf8(isolate, "collections"), collections);
+  SetNumber(isolate, result, "droppedCollections", gc_pause_log_dropped);
+  gc_pause_log_length = 0;
+  gc_pause_log_dropped = 0;
+}
+
+
+// performance.pauses() returns the number and total duration in
+// milliseconds of the scavenges and mark-compacts so far, the time spent
+// in incremental marking, the number of compiled and optimized functions,
+// and the number of deoptimizations of the current isolate. An isolate's
+// pauses and compilations are only counted from its first call on.
+//
+// The result also describes the heap right now: its used and committed
+// size, the old generation limit that triggers the next full collection,
+// the maximum heap size and the resident set size of the process, in bytes.
+//
+// performance.pauses(true) additionally returns the collections since the
+// previous such call in a "collections" array of objects with the type
+// ("scavenge" or "mark-compact"), the start time and duration in
+// milliseconds and the size of the heap objects afterwards in bytes.
+// "droppedCollections" is the number of collections that did not fit into
+// the log.
+void Shell::PerformancePauses(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  InstallPauseCounters(isolate);
+  PauseTotals totals = GetPauseTotals();
+  Handle<Object> result = Object::New(isolate);
+  SetNumber(isolate, result, "scavenges", totals.scavenges);
+  SetNumber(isolate, result, "scavengeTime", totals.scavenge_time);
+  SetNumber(isolate, result, "markCompacts", totals.mark_compacts);
+  SetNumber(isolate, result, "markCompactTime", totals.mark_compact_time);
+  SetNumber(isolate, result, "incrementalMarkingTime",
+            totals.incremental_marking_time);
+  SetNumber(isolate, result, "compiles", totals.compiles);
+  SetNumber(isolate, result, "optimizations", totals.optimizations);
+  SetNumber(isolate, result, "deopts",
+            i::Deoptimizer::GetDeoptimizationCount(
+                reinterpret_cast<i::Isolate*>(isolate)));
+
+  HeapStatistics statistics;
+  isolate->GetHeapStatistics(&statistics);
+  i::Heap* heap = reinterpret_cast<i::Isolate*>(isolate)->heap();
+  SetNumber(isolate, result, "usedHeapSize",
+            static_cast<double>(statistics.used_heap_size()));
+  SetNumber(isolate, result, "totalHeapSize",
+            static_cast<double>(statistics.total_heap_size()));
+  SetNumber(isolate, result, "allocationLimit",
+            static_cast<double>(heap->old_generation_allocation_limit()));
+  SetNumber(isolate, result, "heapSizeLimit",
+            static_cast<double>(statistics.heap_size_limit()));
+  SetNumber(isolate, result, "rss", GetResidentSetSize());
+
+  if (args.Length() > 0 && args[0]->BooleanValue()) {
+    DrainGCPauseLog(isolate, result);
+  }
+  args.GetReturnValue().Set(result);
+}
+
+
+// Runs {source} repeatedly until --warmup-time milliseconds have passed
+// and prints one line per iteration with its start time since the launch
+// of d8, its duration, and the functions compiled, functions optimized and
+// deoptimizations during the iteration. The start of the first iteration
+// is the startup time, its end the time to the first result.
+bool Shell::ExecuteWarmupSeries(Isolate* isolate, Handle<String> source,
+                                Handle<String> name) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  InstallPauseCounters(isolate);
+  base::TimeTicks end =
+      base::TimeTicks::HighResolutionNow() +
+      base::TimeDelta::FromMilliseconds(options.warmup_time);
+  for (int iteration = 0;; ++iteration) {
+    HandleScope handle_scope(isolate);
+    PauseTotals before = GetPauseTotals();
+    int deopts = i::Deoptimizer::GetDeoptimizationCount(i_isolate);
+    base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+    if (!ExecuteString(isolate, source, name, false, true)) return false;
+    base::TimeTicks stop = base::TimeTicks::HighResolutionNow();
+    PauseTotals after = GetPauseTotals();
+    printf(
+        "Iteration %d: start=%.3f duration=%.3f compiles=%d "
+        "optimizations=%d deopts=%d\n",
+        iteration, (start - kInitialTicks).InMillisecondsF(),
+        (stop - start).InMillisecondsF(), after.compiles - before.compiles,
+        after.optimizations - before.optimizations,
+        i::Deoptimizer::GetDeoptimizationCount(i_isolate) - deopts);
+    if (stop >= end) return true;
+  }
+}
 #endif  // !V8_SHARED
 
 
@@ -910,8 +1161,25 @@ Handle<ObjectTemplate> Shell::CreateGlobalTemplate(Isolate* isolate) {
   Handle<ObjectTemplate> performance_template = ObjectTemplate::New(isolate);
   performance_template->Set(String::NewFromUtf8(isolate, "now"),
                             FunctionTemplate::New(isolate, PerformanceNow));
+  performance_template->Set(String::NewFromUtf8(isolate, "pauses"),
+                            FunctionTemplate::New(isolate, PerformancePauses));
   global_template->Set(String::NewFromUtf8(isolate, "performance"),
                        performance_template);
+
+  Handle<FunctionTemplate> worker_fun_template =
+      FunctionTemplate::New(isolate, WorkerNew);
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "terminate"),
+      FunctionTemplate::New(isolate, WorkerTerminate));
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "postMessage"),
+      FunctionTemplate::New(isolate, WorkerPostMessage));
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "getMessage"),
+      FunctionTemplate::New(isolate, WorkerGetMessage));
+  worker_fun_template->InstanceTemplate()->SetInternalFieldCount(1);
+  global_template->Set(String::NewFromUtf8(isolate, "Worker"),
+                       worker_fun_template);
 #endif  // !V8_SHARED
 
   Handle<ObjectTemplate> os_templ = ObjectTemplate::New(isolate);
@@ -1206,6 +1474,15 @@ void SourceGroup::Execute(Isolate* isolate) {
         printf("Error reading '%s'\n", arg);
         Shell::Exit(1);
       }
+#ifndef V8_SHARED
+      if (Shell::options.warmup_time > 0) {
+        if (!Shell::ExecuteWarmupSeries(isolate, source, file_name)) {
+          exception_was_thrown = true;
+          break;
+        }
+        continue;
+      }
+#endif  // !V8_SHARED
       if (!Shell::ExecuteString(isolate, source, file_name, false, true)) {
         exception_was_thrown = true;
         break;
@@ -1291,6 +1568,611 @@ void SourceGroup::WaitForThread() {
     done_semaphore_.Wait();
   }
 }
+
+
+// Runs the scripts of a source group once in a fresh isolate. The isolate
+// and its context are set up before |ready| is signaled, and the scripts
+// only start once |go| is signaled, so that the measured time covers
+// script execution only.
+class ScalingThread : public base::Thread {
+ public:
+  ScalingThread(SourceGroup* group, base::Semaphore* ready,
+                base::Semaphore* go, base::Semaphore* done)
+      : base::Thread(base::Thread::Options("ScalingThread", 2 * MB)),
+        group_(group),
+        ready_(ready),
+        go_(go),
+        done_(done) {}
+
+  virtual void Run() {
+    Isolate* isolate = Isolate::New();
+    {
+      Isolate::Scope iscope(isolate);
+      HandleScope scope(isolate);
+      PerIsolateData data(isolate);
+      Local<Context> context = Shell::CreateEvaluationContext(isolate);
+      Context::Scope cscope(context);
+      PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+      ready_->Signal();
+      go_->Wait();
+      group_->Execute(isolate);
+    }
+    done_->Signal();
+    isolate->Dispose();
+  }
+
+ private:
+  SourceGroup* group_;
+  base::Semaphore* ready_;
+  base::Semaphore* go_;
+  base::Semaphore* done_;
+};
+
+
+// Runs the main scripts concurrently in 1, 2, 4, ... up to
+// --scaling-isolates isolates, each on its own thread, and prints one line
+// per round with its wall time, the throughput in runs per second, the
+// scaling efficiency relative to a single isolate (1.0 means the isolates
+// did not slow each other down), and how often the locks of the platform
+// were contended during the round.
+int Shell::RunScalingSeries(v8::Platform* platform) {
+  platform::DefaultPlatform* default_platform =
+      static_cast<platform::DefaultPlatform*>(platform);
+  double single_time = 0;
+  for (int count = 1;; count = i::Min(2 * count, options.scaling_isolates)) {
+    base::Semaphore ready(0);
+    base::Semaphore go(0);
+    base::Semaphore done(0);
+    ScalingThread** threads = new ScalingThread* [count];
+    for (int i = 0; i < count; ++i) {
+      threads[i] = new ScalingThread(&options.isolate_sources[0], &ready, &go,
+                                     &done);
+      threads[i]->Start();
+    }
+    for (int i = 0; i < count; ++i) ready.Wait();
+    int platform_contentions = default_platform->LockContentionCount();
+    int queue_contentions = default_platform->TaskQueueContentionCount();
+    base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+    for (int i = 0; i < count; ++i) go.Signal();
+    for (int i = 0; i < count; ++i) done.Wait();
+    double time = (base::TimeTicks::HighResolutionNow() - start).InSecondsF();
+    for (int i = 0; i < count; ++i) {
+      threads[i]->Join();
+      delete threads[i];
+    }
+    delete[] threads;
+    if (count == 1) single_time = time;
+    printf(
+        "Isolates: %d time=%.3f throughput=%.2f efficiency=%.3f "
+        "platform-lock-contentions=%d task-queue-contentions=%d\n",
+        count, time * 1000, count / time, single_time / time,
+        default_platform->LockContentionCount() - platform_contentions,
+        default_platform->TaskQueueContentionCount() - queue_contentions);
+    if (count == options.scaling_isolates) return 0;
+  }
+}
+
+
+SerializationData::~SerializationData() {
+  // Backing stores of transferred ArrayBuffers that were never deserialized
+  // are still owned by the message.
+  for (int i = 0; i < backing_stores_.length(); ++i) {
+    const BackingStore& store = backing_stores_[i];
+    if (store.data == NULL) continue;
+    i::V8::ArrayBufferAllocator()->Free(store.data, store.byte_length);
+  }
+}
+
+
+void SerializationData::WriteTag(SerializationTag tag) {
+  data_.Add(static_cast<uint8_t>(tag));
+}
+
+
+void SerializationData::WriteMemory(const void* p, int length) {
+  if (length > 0) {
+    i::Vector<uint8_t> block = data_.AddBlock(0, length);
+    memcpy(&block[0], p, length);
+  }
+}
+
+
+void SerializationData::WriteBackingStore(void* data, size_t byte_length) {
+  BackingStore store = {data, byte_length};
+  Write(backing_stores_.length());
+  backing_stores_.Add(store);
+}
+
+
+SerializationTag SerializationData::ReadTag(int* offset) const {
+  return static_cast<SerializationTag>(Read<uint8_t>(offset));
+}
+
+
+void SerializationData::ReadMemory(void* p, int length, int* offset) const {
+  if (length > 0) {
+    DCHECK_LE(*offset + length, data_.length());
+    memcpy(p, &data_[*offset], length);
+    (*offset) += length;
+  }
+}
+
+
+void SerializationData::ReadBackingStore(int* offset, void** data,
+                                         size_t* byte_length) {
+  int index = Read<int>(offset);
+  DCHECK_LT(index, backing_stores_.length());
+  BackingStore& store = backing_stores_[index];
+  *data = store.data;
+  *byte_length = store.byte_length;
+  store.data = NULL;
+}
+
+
+void SerializationDataQueue::Enqueue(SerializationData* data) {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  data_.Add(data);
+}
+
+
+bool SerializationDataQueue::Dequeue(SerializationData** data) {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (data_.is_empty()) return false;
+  *data = data_.Remove(0);
+  return true;
+}
+
+
+void SerializationDataQueue::Clear() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  for (int i = 0; i < data_.length(); ++i) {
+    delete data_[i];
+  }
+  data_.Clear();
+}
+
+
+Worker::Worker()
+    : in_semaphore_(0),
+      out_semaphore_(0),
+      thread_(NULL),
+      script_(NULL),
+      running_(0) {}
+
+
+Worker::~Worker() {
+  delete thread_;
+  thread_ = NULL;
+  delete[] script_;
+  script_ = NULL;
+  in_queue_.Clear();
+  out_queue_.Clear();
+}
+
+
+void Worker::StartExecuteInThread(const char* script) {
+  base::NoBarrier_Store(&running_, 1);
+  script_ = i::StrDup(script);
+  thread_ = new WorkerThread(this);
+  thread_->Start();
+}
+
+
+void Worker::PostMessage(SerializationData* data) {
+  in_queue_.Enqueue(data);
+  in_semaphore_.Signal();
+}
+
+
+SerializationData* Worker::GetMessage() {
+  SerializationData* data = NULL;
+  while (!out_queue_.Dequeue(&data)) {
+    // The worker signals the semaphore once more when it stops, so a
+    // stopped worker with an empty queue does not block the caller.
+    if (!base::NoBarrier_Load(&running_)) break;
+    out_semaphore_.Wait();
+  }
+  return data;
+}
+
+
+void Worker::Terminate() {
+  if (thread_ == NULL) return;
+  PostMessage(NULL);
+}
+
+
+void Worker::WaitForThread() {
+  if (thread_ == NULL) return;
+  Terminate();
+  thread_->Join();
+}
+
+
+void Worker::ExecuteInThread() {
+  Isolate* isolate = Isolate::New();
+  {
+    Isolate::Scope iscope(isolate);
+    HandleScope scope(isolate);
+    PerIsolateData data(isolate);
+    Local<Context> context = Shell::CreateEvaluationContext(isolate);
+    Context::Scope cscope(context);
+    PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+    Local<Object> global = context->Global();
+    Local<FunctionTemplate> post_message_template = FunctionTemplate::New(
+        isolate, PostMessageOut, External::New(isolate, this));
+    global->Set(String::NewFromUtf8(isolate, "postMessage"),
+                post_message_template->GetFunction());
+
+    Handle<String> file_name = String::NewFromUtf8(isolate, "unnamed");
+    Handle<String> source = String::NewFromUtf8(isolate, script_);
+    if (Shell::ExecuteString(isolate, source, file_name, false, true)) {
+      Handle<Value> onmessage =
+          global->Get(String::NewFromUtf8(isolate, "onmessage"));
+      if (onmessage->IsFunction()) {
+        Handle<Function> onmessage_fun = Handle<Function>::Cast(onmessage);
+        for (;;) {
+          in_semaphore_.Wait();
+          SerializationData* message;
+          if (!in_queue_.Dequeue(&message)) continue;
+          if (message == NULL) break;
+          HandleScope message_scope(isolate);
+          int offset = 0;
+          Handle<Value> argv[] = {
+              Shell::DeserializeValue(isolate, message, &offset)};
+          delete message;
+          TryCatch try_catch;
+          onmessage_fun->Call(global, 1, argv);
+          if (try_catch.HasCaught()) {
+            Shell::ReportException(isolate, &try_catch);
+          }
+        }
+      }
+    }
+  }
+  isolate->Dispose();
+  base::NoBarrier_Store(&running_, 0);
+  out_semaphore_.Signal();
+}
+
+
+// Collects the ArrayBuffers of the transfer list given to postMessage.
+static bool GetTransferList(Isolate* isolate, Handle<Value> value,
+                            Shell::ObjectList* to_transfer) {
+  if (!value->IsArray()) {
+    Throw(isolate, "Transfer list must be an Array");
+    return false;
+  }
+  Handle<Array> array = Handle<Array>::Cast(value);
+  uint32_t length = array->Length();
+  for (uint32_t i = 0; i < length; ++i) {
+    Handle<Value> element = array->Get(i);
+    if (!element->IsArrayBuffer()) {
+      Throw(isolate, "Transfer list elements must be ArrayBuffers");
+      return false;
+    }
+    to_transfer->Add(Handle<Object>::Cast(element));
+  }
+  return true;
+}
+
+
+// Serializes the first argument of a postMessage call, with the second
+// argument as the optional transfer list. Returns NULL if an exception has
+// been thrown.
+static SerializationData* SerializeMessage(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (args.Length() < 1) {
+    Throw(isolate, "Invalid argument");
+    return NULL;
+  }
+  Shell::ObjectList to_transfer;
+  if (args.Length() >= 2 &&
+      !GetTransferList(isolate, args[1], &to_transfer)) {
+    return NULL;
+  }
+  Shell::ObjectList seen_objects;
+  SerializationData* data = new SerializationData;
+  if (!Shell::SerializeValue(isolate, args[0], to_transfer, &seen_objects,
+                             data)) {
+    delete data;
+    return NULL;
+  }
+  return data;
+}
+
+
+void Worker::PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  HandleScope handle_scope(args.GetIsolate());
+  SerializationData* data = SerializeMessage(args);
+  if (data == NULL) return;
+  Worker* worker =
+      static_cast<Worker*>(Handle<External>::Cast(args.Data())->Value());
+  worker->out_queue_.Enqueue(data);
+  worker->out_semaphore_.Signal();
+}
+
+
+static bool FindInObjectList(Handle<Object> object,
+                             const Shell::ObjectList& list) {
+  for (int i = 0; i < list.length(); ++i) {
+    if (list[i]->StrictEquals(object)) return true;
+  }
+  return false;
+}
+
+
+bool Shell::SerializeValue(Isolate* isolate, Handle<Value> value,
+                           const ObjectList& to_transfer,
+                           ObjectList* seen_objects,
+                           SerializationData* out_data) {
+  HandleScope scope(isolate);
+  if (value->IsUndefined()) {
+    out_data->WriteTag(kSerializationTagUndefined);
+  } else if (value->IsNull()) {
+    out_data->WriteTag(kSerializationTagNull);
+  } else if (value->IsTrue()) {
+    out_data->WriteTag(kSerializationTagTrue);
+  } else if (value->IsFalse()) {
+    out_data->WriteTag(kSerializationTagFalse);
+  } else if (value->IsNumber()) {
+    out_data->WriteTag(kSerializationTagNumber);
+    out_data->Write(value->NumberValue());
+  } else if (value->IsString()) {
+    String::Utf8Value str(value);
+    out_data->WriteTag(kSerializationTagString);
+    out_data->Write(str.length());
+    out_data->WriteMemory(*str, str.length());
+  } else if (value->IsFunction() || value->IsSymbol() ||
+             value->IsArrayBufferView()) {
+    Throw(isolate, "Unsupported value type");
+    return false;
+  } else if (value->IsObject()) {
+    Handle<Object> object = Handle<Object>::Cast(value);
+    if (FindInObjectList(object, *seen_objects)) {
+      Throw(isolate, "Duplicated objects not supported");
+      return false;
+    }
+    seen_objects->Add(object);
+    if (value->IsArray()) {
+      Handle<Array> array = Handle<Array>::Cast(value);
+      uint32_t length = array->Length();
+      out_data->WriteTag(kSerializationTagArray);
+      out_data->Write(length);
+      for (uint32_t i = 0; i < length; ++i) {
+        Handle<Value> element = array->Get(i);
+        if (element.IsEmpty()) return false;
+        if (!SerializeValue(isolate, element, to_transfer, seen_objects,
+                            out_data)) {
+          return false;
+        }
+      }
+    } else if (value->IsArrayBuffer()) {
+      Handle<v8::ArrayBuffer> array_buffer =
+          Handle<v8::ArrayBuffer>::Cast(value);
+      if (FindInObjectList(object, to_transfer)) {
+        // Transfer the backing store without copying it. Buffers that are
+        // already external are owned by someone else, so they are copied
+        // into a fresh backing store instead.
+        void* data;
+        size_t byte_length;
+        if (array_buffer->IsExternal()) {
+          v8::ArrayBuffer::Contents contents = array_buffer->GetContents();
+          byte_length = contents.ByteLength();
+          data = i::V8::ArrayBufferAllocator()->AllocateUninitialized(
+              byte_length);
+          memcpy(data, contents.Data(), byte_length);
+        } else {
+          v8::ArrayBuffer::Contents contents = array_buffer->Externalize();
+          data = contents.Data();
+          byte_length = contents.ByteLength();
+          isolate->AdjustAmountOfExternalAllocatedMemory(
+              -static_cast<int64_t>(byte_length));
+        }
+        array_buffer->Neuter();
+        out_data->WriteTag(kSerializationTagTransferredArrayBuffer);
+        out_data->WriteBackingStore(data, byte_length);
+      } else {
+        v8::ArrayBuffer::Contents contents = array_buffer->GetContents();
+        int byte_length = static_cast<int>(contents.ByteLength());
+        out_data->WriteTag(kSerializationTagArrayBuffer);
+        out_data->Write(byte_length);
+        out_data->WriteMemory(contents.Data(), byte_length);
+      }
+    } else {
+      Handle<Array> property_names = object->GetOwnPropertyNames();
+      if (property_names.IsEmpty()) return false;
+      uint32_t length = property_names->Length();
+      out_data->WriteTag(kSerializationTagObject);
+      out_data->Write(length);
+      for (uint32_t i = 0; i < length; ++i) {
+        Handle<Value> name = property_names->Get(i);
+        Handle<Value> property_value = object->Get(name);
+        if (property_value.IsEmpty()) return false;
+        if (!SerializeValue(isolate, name, to_transfer, seen_objects,
+                            out_data) ||
+            !SerializeValue(isolate, property_value, to_transfer,
+                            seen_objects, out_data)) {
+          return false;
+        }
+      }
+    }
+  } else {
+    Throw(isolate, "Unsupported value type");
+    return false;
+  }
+  return true;
+}
+
+
+Handle<Value> Shell::DeserializeValue(Isolate* isolate,
+                                      SerializationData* data, int* offset) {
+  EscapableHandleScope scope(isolate);
+  Local<Value> result;
+  SerializationTag tag = data->ReadTag(offset);
+  switch (tag) {
+    case kSerializationTagUndefined:
+      result = Undefined(isolate);
+      break;
+    case kSerializationTagNull:
+      result = Null(isolate);
+      break;
+    case kSerializationTagTrue:
+      result = True(isolate);
+      break;
+    case kSerializationTagFalse:
+      result = False(isolate);
+      break;
+    case kSerializationTagNumber:
+      result = Number::New(isolate, data->Read<double>(offset));
+      break;
+    case kSerializationTagString: {
+      int length = data->Read<int>(offset);
+      i::ScopedVector<char> buffer(length);
+      data->ReadMemory(buffer.start(), length, offset);
+      result = String::NewFromUtf8(isolate, buffer.start(),
+                                   String::kNormalString, length);
+      break;
+    }
+    case kSerializationTagArray: {
+      uint32_t length = data->Read<uint32_t>(offset);
+      Local<Array> array = Array::New(isolate, length);
+      for (uint32_t i = 0; i < length; ++i) {
+        array->Set(i, DeserializeValue(isolate, data, offset));
+      }
+      result = array;
+      break;
+    }
+    case kSerializationTagObject: {
+      uint32_t length = data->Read<uint32_t>(offset);
+      Local<Object> object = Object::New(isolate);
+      for (uint32_t i = 0; i < length; ++i) {
+        Handle<Value> name = DeserializeValue(isolate, data, offset);
+        object->Set(name, DeserializeValue(isolate, data, offset));
+      }
+      result = object;
+      break;
+    }
+    case kSerializationTagArrayBuffer: {
+      int byte_length = data->Read<int>(offset);
+      Local<v8::ArrayBuffer> array_buffer =
+          v8::ArrayBuffer::New(isolate, byte_length);
+      data->ReadMemory(array_buffer->GetContents().Data(), byte_length,
+                       offset);
+      result = array_buffer;
+      break;
+    }
+    case kSerializationTagTransferredArrayBuffer: {
+      void* backing_store;
+      size_t byte_length;
+      data->ReadBackingStore(offset, &backing_store, &byte_length);
+      result = v8::ArrayBuffer::New(isolate, backing_store, byte_length,
+                                    v8::ArrayBuffer::kInternalized);
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+  return scope.Escape(result);
+}
+
+
+static Worker* GetWorkerFromInternalField(Isolate* isolate,
+                                          Handle<Object> object) {
+  if (object->InternalFieldCount() != 1) {
+    Throw(isolate, "this is not a Worker");
+    return NULL;
+  }
+  Worker* worker =
+      static_cast<Worker*>(object->GetAlignedPointerFromInternalField(0));
+  if (worker == NULL) {
+    Throw(isolate, "Worker is not initialized");
+    return NULL;
+  }
+  return worker;
+}
+
+
+void Shell::WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  if (!args.IsConstructCall()) {
+    Throw(isolate, "Worker must be constructed with new");
+    return;
+  }
+  args.Holder()->SetAlignedPointerInInternalField(0, NULL);
+  if (args.Length() < 1 || !args[0]->IsString()) {
+    Throw(isolate, "1st argument must be string");
+    return;
+  }
+  String::Utf8Value script(args[0]);
+  if (*script == NULL) {
+    Throw(isolate, "Can't get worker script");
+    return;
+  }
+  Worker* worker = new Worker;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&workers_mutex_);
+    workers_.Add(worker);
+  }
+  args.Holder()->SetAlignedPointerInInternalField(0, worker);
+  worker->StartExecuteInThread(*script);
+}
+
+
+void Shell::WorkerPostMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Worker* worker = GetWorkerFromInternalField(isolate, args.Holder());
+  if (worker == NULL) return;
+  SerializationData* data = SerializeMessage(args);
+  if (data != NULL) worker->PostMessage(data);
+}
+
+
+void Shell::WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Worker* worker = GetWorkerFromInternalField(isolate, args.Holder());
+  if (worker == NULL) return;
+  SerializationData* data = worker->GetMessage();
+  if (data != NULL) {
+    int offset = 0;
+    args.GetReturnValue().Set(DeserializeValue(isolate, data, &offset));
+    delete data;
+  }
+}
+
+
+void Shell::WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Worker* worker = GetWorkerFromInternalField(isolate, args.Holder());
+  if (worker == NULL) return;
+  worker->Terminate();
+}
+
+
+// Stops all workers, including the ones that workers created themselves.
+// All of them are asked to stop before any is waited for, so that a worker
+// blocked on a message from a worker created later does not block the rest.
+void Shell::CleanupWorkers() {
+  {
+    base::LockGuard<base::Mutex> lock_guard(&workers_mutex_);
+    for (int i = 0; i < workers_.length(); ++i) workers_[i]->Terminate();
+  }
+  for (;;) {
+    Worker* worker;
+    {
+      base::LockGuard<base::Mutex> lock_guard(&workers_mutex_);
+      if (workers_.is_empty()) break;
+      worker = workers_.RemoveLast();
+    }
+    worker->WaitForThread();
+    delete worker;
+  }
+}
 #endif  // !V8_SHARED
 
 
@@ -1352,6 +2234,22 @@ bool Shell::SetOptions(int argc, char* argv[]) {
 #else
       options.dump_heap_constants = true;
       argv[i] = NULL;
+#endif  // V8_SHARED
+    } else if (strncmp(argv[i], "--warmup-time=", 14) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support warm-up series\n");
+      return false;
+#else
+      options.warmup_time = atoi(argv[i] + 14);
+      argv[i] = NULL;
+#endif  // V8_SHARED
+    } else if (strncmp(argv[i], "--scaling-isolates=", 19) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support scaling series\n");
+      return false;
+#else
+      options.scaling_isolates = atoi(argv[i] + 19);
+      argv[i] = NULL;
 #endif  // V8_SHARED
     } else if (strcmp(argv[i], "--throws") == 0) {
       options.expected_to_throw = true;
@@ -1548,50 +2446,53 @@ class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
 
 
 #ifdef V8_USE_EXTERNAL_STARTUP_DATA
+// The blobs are mapped read-only instead of being read into memory. V8 only
+// reads from them, and parts it never touches, like the sources of natives
+// that are not compiled, are never paged in. The pages are shared with every
+// other process mapping the same files.
 class StartupDataHandler {
  public:
   StartupDataHandler(const char* natives_blob,
-                     const char* snapshot_blob) {
-    Load(natives_blob, &natives_, v8::V8::SetNativesDataBlob);
-    Load(snapshot_blob, &snapshot_, v8::V8::SetSnapshotDataBlob);
+                     const char* snapshot_blob)
+      : natives_file_(NULL), snapshot_file_(NULL) {
+    natives_file_ = Load(natives_blob, &natives_, v8::V8::SetNativesDataBlob);
+    snapshot_file_ =
+        Load(snapshot_blob, &snapshot_, v8::V8::SetSnapshotDataBlob);
   }
 
   ~StartupDataHandler() {
-    delete[] natives_.data;
-    delete[] snapshot_.data;
+    delete natives_file_;
+    delete snapshot_file_;
   }
 
  private:
-  void Load(const char* blob_file,
-            v8::StartupData* startup_data,
-            void (*setter_fn)(v8::StartupData*)) {
+  base::OS::MemoryMappedFile* Load(const char* blob_file,
+                                   v8::StartupData* startup_data,
+                                   void (*setter_fn)(v8::StartupData*)) {
     startup_data->data = NULL;
     startup_data->compressed_size = 0;
     startup_data->raw_size = 0;
 
     if (!blob_file)
-      return;
+      return NULL;
 
-    FILE* file = fopen(blob_file, "rb");
+    base::OS::MemoryMappedFile* file = base::OS::MemoryMappedFile::open(
+        blob_file, base::OS::MemoryMappedFile::kReadOnly);
     if (!file)
-      return;
+      return NULL;
 
-    fseek(file, 0, SEEK_END);
-    startup_data->raw_size = ftell(file);
-    rewind(file);
-
-    startup_data->data = new char[startup_data->raw_size];
-    startup_data->compressed_size = fread(
-        const_cast<char*>(startup_data->data), 1, startup_data->raw_size,
-        file);
-    fclose(file);
-
-    if (startup_data->raw_size == startup_data->compressed_size)
+    startup_data->data = static_cast<const char*>(file->memory());
+    startup_data->raw_size = file->size();
+    startup_data->compressed_size = file->size();
+    if (startup_data->raw_size > 0)
       (*setter_fn)(startup_data);
+    return file;
   }
 
   v8::StartupData natives_;
   v8::StartupData snapshot_;
+  base::OS::MemoryMappedFile* natives_file_;
+  base::OS::MemoryMappedFile* snapshot_file_;
 
   // Disallow copy & assign.
   StartupDataHandler(const StartupDataHandler& other);
@@ -1685,6 +2586,8 @@ int Shell::Main(int argc, char* argv[]) {
         options.last_run = (i == stress_runs - 1);
         result = RunMain(isolate, argc, argv);
       }
+    } else if (options.scaling_isolates > 0) {
+      result = RunScalingSeries(platform);
 #endif
     } else {
       result = RunMain(isolate, argc, argv);
@@ -1702,12 +2605,19 @@ int Shell::Main(int argc, char* argv[]) {
     }
   }
 #ifndef V8_SHARED
+  CleanupWorkers();
   // Dump basic block profiling data.
   if (i::BasicBlockProfiler* profiler =
           reinterpret_cast<i::Isolate*>(isolate)->basic_block_profiler()) {
     i::OFStream os(stdout);
     os << *profiler;
   }
+  if (i::FLAG_runtime_call_stats) {
+    i::OFStream os(stdout);
+    os << *reinterpret_cast<i::Isolate*>(isolate)
+                ->counters()
+                ->runtime_call_stats();
+  }
 #endif  // !V8_SHARED
   isolate->Dispose();
   V8::Dispose();
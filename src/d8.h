@@ -172,6 +172,132 @@ class SourceGroup {
 };
 
 
+#ifndef V8_SHARED
+enum SerializationTag {
+  kSerializationTagUndefined,
+  kSerializationTagNull,
+  kSerializationTagTrue,
+  kSerializationTagFalse,
+  kSerializationTagNumber,
+  kSerializationTagString,
+  kSerializationTagArray,
+  kSerializationTagObject,
+  kSerializationTagArrayBuffer,
+  kSerializationTagTransferredArrayBuffer
+};
+
+
+// A message passed between a worker and the isolate that created it. Values
+// are copied into a flat byte buffer, except for the backing stores of
+// transferred ArrayBuffers, which the message owns until they are
+// deserialized into an ArrayBuffer of the receiving isolate.
+class SerializationData {
+ public:
+  SerializationData() {}
+  ~SerializationData();
+
+  void WriteTag(SerializationTag tag);
+  void WriteMemory(const void* p, int length);
+  // Takes ownership of the backing store of a transferred ArrayBuffer.
+  void WriteBackingStore(void* data, size_t byte_length);
+
+  template <typename T>
+  void Write(const T& data) {
+    WriteMemory(&data, sizeof(data));
+  }
+
+  SerializationTag ReadTag(int* offset) const;
+  void ReadMemory(void* p, int length, int* offset) const;
+
+  // Returns the backing store of a transferred ArrayBuffer. The caller
+  // takes ownership of it.
+  void ReadBackingStore(int* offset, void** data, size_t* byte_length);
+
+  template <typename T>
+  T Read(int* offset) const {
+    T value;
+    ReadMemory(&value, sizeof(value), offset);
+    return value;
+  }
+
+ private:
+  struct BackingStore {
+    void* data;
+    size_t byte_length;
+  };
+
+  i::List<uint8_t> data_;
+  i::List<BackingStore> backing_stores_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializationData);
+};
+
+
+class SerializationDataQueue {
+ public:
+  ~SerializationDataQueue() { Clear(); }
+
+  void Enqueue(SerializationData* data);
+  bool Dequeue(SerializationData** data);
+  void Clear();
+
+ private:
+  base::Mutex mutex_;
+  i::List<SerializationData*> data_;
+};
+
+
+// A script running in its own isolate on its own thread. Messages posted to
+// the worker are delivered to its global onmessage function, and messages
+// the worker posts with its global postMessage function are picked up by
+// the creating isolate with GetMessage().
+class Worker {
+ public:
+  Worker();
+  ~Worker();
+
+  void StartExecuteInThread(const char* script);
+  // Posts a message to the worker, which takes ownership of |data|. A NULL
+  // message asks the worker to stop.
+  void PostMessage(SerializationData* data);
+  // Returns the next message posted by the worker, blocking until there is
+  // one. Returns NULL once the worker has stopped and all of its messages
+  // have been picked up. The caller takes ownership of the message.
+  SerializationData* GetMessage();
+  // Asks the worker to stop once it has finished handling its current
+  // message.
+  void Terminate();
+  void WaitForThread();
+
+ private:
+  class WorkerThread : public base::Thread {
+   public:
+    explicit WorkerThread(Worker* worker)
+        : base::Thread(base::Thread::Options("WorkerThread")),
+          worker_(worker) {}
+
+    virtual void Run() { worker_->ExecuteInThread(); }
+
+   private:
+    Worker* worker_;
+  };
+
+  void ExecuteInThread();
+  static void PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  base::Semaphore in_semaphore_;
+  base::Semaphore out_semaphore_;
+  SerializationDataQueue in_queue_;
+  SerializationDataQueue out_queue_;
+  base::Thread* thread_;
+  char* script_;
+  base::Atomic32 running_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+#endif  // !V8_SHARED
+
+
 class BinaryResource : public v8::String::ExternalOneByteStringResource {
  public:
   BinaryResource(const char* string, int length)
@@ -208,6 +334,8 @@ class ShellOptions {
         expected_to_throw(false),
         mock_arraybuffer_allocator(false),
         num_isolates(1),
+        warmup_time(0),
+        scaling_isolates(0),
         compile_options(v8::ScriptCompiler::kNoCompileOptions),
         isolate_sources(NULL),
         icu_data_file(NULL),
@@ -234,6 +362,8 @@ class ShellOptions {
   bool expected_to_throw;
   bool mock_arraybuffer_allocator;
   int num_isolates;
+  int warmup_time;
+  int scaling_isolates;
   v8::ScriptCompiler::CompileOptions compile_options;
   SourceGroup* isolate_sources;
   const char* icu_data_file;
@@ -256,6 +386,11 @@ class Shell : public i::AllStatic {
                             Handle<Value> name,
                             bool print_result,
                             bool report_exceptions);
+#ifndef V8_SHARED
+  static bool ExecuteWarmupSeries(Isolate* isolate, Handle<String> source,
+                                  Handle<String> name);
+  static int RunScalingSeries(v8::Platform* platform);
+#endif  // !V8_SHARED
   static const char* ToCString(const v8::String::Utf8Value& value);
   static void ReportException(Isolate* isolate, TryCatch* try_catch);
   static Handle<String> ReadFile(Isolate* isolate, const char* name);
@@ -283,6 +418,27 @@ class Shell : public i::AllStatic {
                                                 Handle<String> command);
 
   static void PerformanceNow(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void PerformancePauses(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static void WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerPostMessage(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  typedef i::List<Handle<Object> > ObjectList;
+
+  // Serializes |value| into |out_data|. ArrayBuffers in |to_transfer| are
+  // neutered and their backing stores are moved into |out_data|. Throws and
+  // returns false if the value cannot be serialized.
+  static bool SerializeValue(Isolate* isolate, Handle<Value> value,
+                             const ObjectList& to_transfer,
+                             ObjectList* seen_objects,
+                             SerializationData* out_data);
+  static Handle<Value> DeserializeValue(Isolate* isolate,
+                                        SerializationData* data, int* offset);
+  static void CleanupWorkers();
 #endif  // !V8_SHARED
 
   static void RealmCurrent(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -377,6 +533,9 @@ class Shell : public i::AllStatic {
   static base::Mutex context_mutex_;
   static const base::TimeTicks kInitialTicks;
 
+  static base::Mutex workers_mutex_;
+  static i::List<Worker*> workers_;
+
   static Counter* GetCounter(const char* name, bool is_histogram);
   static void InstallUtilityScript(Isolate* isolate);
 #endif  // !V8_SHARED
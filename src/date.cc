@@ -38,6 +38,10 @@ void DateCache::ResetDateCache() {
   dst_usage_counter_ = 0;
   before_ = &dst_[0];
   after_ = &dst_[1];
+  for (int i = 0; i < kYearTableSize; ++i) {
+    ClearYearTable(&year_tables_[i]);
+  }
+  year_table_usage_counter_ = 0;
   local_offset_ms_ = kInvalidLocalOffsetInMs;
   ymd_valid_ = false;
   base::OS::ClearTimezoneCache(tz_cache_);
@@ -52,6 +56,13 @@ void DateCache::ClearSegment(DST* segment) {
 }
 
 
+void DateCache::ClearYearTable(YearTable* table) {
+  table->year = kMinInt;
+  table->segment_count = 0;
+  table->last_used = 0;
+}
+
+
 void DateCache::YearMonthDayFromDays(
     int days, int* year, int* month, int* day) {
   if (ymd_valid_) {
@@ -220,6 +231,9 @@ int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
     return before_->offset_ms;
   }
 
+  YearTable* table = YearTableFor(time_sec);
+  if (table != NULL) return YearTableOffsetInMs(table, time_sec);
+
   ProbeDST(time_sec);
 
   DCHECK(InvalidSegment(before_) || before_->start_sec <= time_sec);
@@ -307,6 +321,94 @@ int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
 }
 
 
+DateCache::YearTable* DateCache::YearTableFor(int time_sec) {
+  int year, month, day;
+  YearMonthDayFromDays(time_sec / kSecPerDay, &year, &month, &day);
+
+  if (year_table_usage_counter_ >= kMaxInt - 1) {
+    year_table_usage_counter_ = 0;
+    for (int i = 0; i < kYearTableSize; ++i) {
+      year_tables_[i].last_used = 0;
+    }
+  }
+
+  YearTable* least_recently_used = &year_tables_[0];
+  for (int i = 0; i < kYearTableSize; ++i) {
+    YearTable* table = &year_tables_[i];
+    if (table->year == year) {
+      table->last_used = ++year_table_usage_counter_;
+      if (table->segment_count == 0) ComputeYearTable(table);
+      return table;
+    }
+    if (table->last_used < least_recently_used->last_used) {
+      least_recently_used = table;
+    }
+  }
+
+  // Remember the year, its table is computed when it is looked up again.
+  ClearYearTable(least_recently_used);
+  least_recently_used->year = year;
+  least_recently_used->last_used = ++year_table_usage_counter_;
+  return NULL;
+}
+
+
+void DateCache::ComputeYearTable(YearTable* table) {
+  DCHECK_EQ(0, table->segment_count);
+  int start_sec = DaysFromYearMonth(table->year, 0) * kSecPerDay;
+  int64_t end = static_cast<int64_t>(DaysFromYearMonth(table->year + 1, 0)) *
+                kSecPerDay - 1;
+  int last_sec = static_cast<int>(Min<int64_t>(end, kMaxEpochTimeInSec));
+
+  int previous_sec = start_sec;
+  int previous_offset_ms = GetDaylightSavingsOffsetFromOS(start_sec);
+  table->start_sec[0] = start_sec;
+  table->offset_ms[0] = previous_offset_ms;
+  table->segment_count = 1;
+  while (previous_sec < last_sec) {
+    int sample_sec = previous_sec + Min(kDefaultDSTDeltaInSec,
+                                        last_sec - previous_sec);
+    int offset_ms = GetDaylightSavingsOffsetFromOS(sample_sec);
+    if (offset_ms != previous_offset_ms) {
+      // Binary search for the first second with the new offset.
+      int low_sec = previous_sec;
+      int high_sec = sample_sec;
+      while (high_sec - low_sec > 1) {
+        int middle_sec = low_sec + (high_sec - low_sec) / 2;
+        if (GetDaylightSavingsOffsetFromOS(middle_sec) == previous_offset_ms) {
+          low_sec = middle_sec;
+        } else {
+          high_sec = middle_sec;
+        }
+      }
+      DCHECK(table->segment_count < kMaxSegmentsPerYear);
+      table->start_sec[table->segment_count] = high_sec;
+      table->offset_ms[table->segment_count] = offset_ms;
+      table->segment_count++;
+      previous_offset_ms = offset_ms;
+    }
+    previous_sec = sample_sec;
+  }
+}
+
+
+int DateCache::YearTableOffsetInMs(YearTable* table, int time_sec) {
+  DCHECK(table->segment_count > 0);
+  DCHECK(table->start_sec[0] <= time_sec);
+  int low = 0;
+  int high = table->segment_count - 1;
+  while (low < high) {
+    int middle = (low + high + 1) / 2;
+    if (table->start_sec[middle] <= time_sec) {
+      low = middle;
+    } else {
+      high = middle - 1;
+    }
+  }
+  return table->offset_ms[low];
+}
+
+
 void DateCache::ProbeDST(int time_sec) {
   DST* before = NULL;
   DST* after = NULL;
@@ -191,6 +191,12 @@ class DateCache {
   // Size of the Daylight Savings Time cache.
   static const int kDSTSize = 32;
 
+  // Number of years with a cached transition table.
+  static const int kYearTableSize = 16;
+  // Sampling a year every kDefaultDSTDeltaInSec finds at most one offset
+  // change between two samples, so this bounds the segments of a year.
+  static const int kMaxSegmentsPerYear = 32;
+
   // Daylight Savings Time segment stores a segment of time where
   // daylight savings offset does not change.
   struct DST {
@@ -200,6 +206,18 @@ class DateCache {
     int last_used;
   };
 
+  // The daylight savings offsets of a year as a sorted list of segments.
+  // Segment i starts at start_sec[i] and lasts until the next segment or
+  // the end of the year. A table without segments marks a year that has
+  // been looked up only once so far.
+  struct YearTable {
+    int year;
+    int segment_count;
+    int last_used;
+    int start_sec[kMaxSegmentsPerYear];
+    int offset_ms[kMaxSegmentsPerYear];
+  };
+
   // Computes the daylight savings offset for the given time.
   // ECMA 262 - 15.9.1.8
   int DaylightSavingsOffsetInMs(int64_t time_ms);
@@ -226,6 +244,20 @@ class DateCache {
     return segment->start_sec > segment->end_sec;
   }
 
+  // Returns the transition table of the year containing the given time, or
+  // NULL if the year has not been looked up before. Tables are computed
+  // from the OS on the second lookup of their year, so that dates spread
+  // over many years stop calling into the OS once they have been seen.
+  YearTable* YearTableFor(int time_sec);
+
+  // Fills in the segments of the given table.
+  void ComputeYearTable(YearTable* table);
+
+  // Looks up the daylight savings offset in a computed table.
+  static int YearTableOffsetInMs(YearTable* table, int time_sec);
+
+  inline void ClearYearTable(YearTable* table);
+
   Smi* stamp_;
 
   // Daylight Saving Time cache.
@@ -234,6 +266,10 @@ class DateCache {
   DST* before_;
   DST* after_;
 
+  // Per-year transition tables.
+  YearTable year_tables_[kYearTableSize];
+  int year_table_usage_counter_;
+
   int local_offset_ms_;
 
   // Year/Month/Day cache.
@@ -247,9 +247,112 @@ function DatePrintString(date) {
 // Reused output buffer. Used when parsing date strings.
 var parse_buffer = $Array(8);
 
+
+// Returns the value of the count decimal digits at index in string, or -1 if
+// any of them is not a digit.
+function DateParseDigits(string, index, count) {
+  var value = 0;
+  for (var i = index; i < index + count; i++) {
+    var digit = %_StringCharCodeAt(string, i) - 48;
+    if (!(digit >= 0 && digit <= 9)) return -1;
+    value = value * 10 + digit;
+  }
+  return value;
+}
+
+
+// Fast path for date-time strings in the ES5 ISO format with four digit year
+// and an explicit time zone, i.e. YYYY-MM-DDTHH:mm:ss(.sss)(Z|+hh:mm|-hh:mm).
+// Computes the time value without calling into the runtime. Returns undefined
+// for any other string, including out-of-range fields, which are left to the
+// general parser.
+function DateParseISOFast(string) {
+  var length = string.length;
+  if (length != 20 && length != 24 && length != 25 && length != 29) {
+    return UNDEFINED;
+  }
+  if (%_StringCharCodeAt(string, 4) != 45 ||  // '-'
+      %_StringCharCodeAt(string, 7) != 45 ||  // '-'
+      %_StringCharCodeAt(string, 10) != 84 ||  // 'T'
+      %_StringCharCodeAt(string, 13) != 58 ||  // ':'
+      %_StringCharCodeAt(string, 16) != 58) {  // ':'
+    return UNDEFINED;
+  }
+  var year = DateParseDigits(string, 0, 4);
+  var month = DateParseDigits(string, 5, 2);
+  var day = DateParseDigits(string, 8, 2);
+  var hour = DateParseDigits(string, 11, 2);
+  var minute = DateParseDigits(string, 14, 2);
+  var second = DateParseDigits(string, 17, 2);
+  if (year < 0 || month < 1 || month > 12 || day < 1 || hour < 0 ||
+      hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+    return UNDEFINED;
+  }
+  if (day > 28) {
+    var days_in_month;
+    if (month == 2) {
+      var leap = (year % 4 == 0) && (year % 100 != 0 || year % 400 == 0);
+      days_in_month = leap ? 29 : 28;
+    } else {
+      days_in_month = 30 + ((month + (month >> 3)) & 1);
+    }
+    if (day > days_in_month) return UNDEFINED;
+  }
+
+  var ms = 0;
+  var pos = 19;
+  if (%_StringCharCodeAt(string, pos) == 46) {  // '.'
+    ms = DateParseDigits(string, 20, 3);
+    if (ms < 0) return UNDEFINED;
+    pos = 23;
+  }
+
+  var offset = 0;
+  var sign = %_StringCharCodeAt(string, pos);
+  if (sign == 90) {  // 'Z'
+    if (length != pos + 1) return UNDEFINED;
+  } else if (sign == 43 || sign == 45) {  // '+' or '-'
+    if (length != pos + 6 || %_StringCharCodeAt(string, pos + 3) != 58) {
+      return UNDEFINED;
+    }
+    var offset_hour = DateParseDigits(string, pos + 1, 2);
+    var offset_minute = DateParseDigits(string, pos + 4, 2);
+    if (offset_hour < 0 || offset_hour > 23 ||
+        offset_minute < 0 || offset_minute > 59) {
+      return UNDEFINED;
+    }
+    offset = (offset_hour * 60 + offset_minute) * msPerMinute;
+    if (sign == 45) offset = -offset;
+  } else {
+    return UNDEFINED;
+  }
+
+  // Days since the epoch of the proleptic Gregorian date, counting years from
+  // March so that the leap day is the last day of the year.
+  if (month <= 2) {
+    year--;
+    month += 9;
+  } else {
+    month -= 3;
+  }
+  var era = year >= 0 ? (year / 400) | 0 : -1;
+  var year_of_era = year - era * 400;
+  var days = era * 146097 + year_of_era * 365 + ((year_of_era / 4) | 0) -
+      ((year_of_era / 100) | 0) + (((153 * month + 2) / 5) | 0) + day - 1 -
+      719468;
+  // Four digit years are always well within the range of TimeClip.
+  return days * msPerDay + hour * msPerHour + minute * msPerMinute +
+      second * msPerSecond + ms - offset;
+}
+
+
 // ECMA 262 - 15.9.4.2
 function DateParse(string) {
-  var arr = %DateParseString(ToString(string), parse_buffer);
+  string = ToString(string);
+  var fast = DateParseISOFast(string);
+  if (!IS_UNDEFINED(fast)) return fast;
+
+  var arr = %DateParseString(string, parse_buffer);
   if (IS_NULL(arr)) return NAN;
 
   var day = MakeDay(arr[0], arr[1], arr[2]);
@@ -122,6 +122,7 @@ function BreakPoint(source_position, opt_script_break_point) {
   this.active_ = true;
   this.condition_ = null;
   this.ignoreCount_ = 0;
+  this.logExpression_ = null;
 }
 
 
@@ -166,6 +167,14 @@ BreakPoint.prototype.ignoreCount = function() {
 };
 
 
+BreakPoint.prototype.logExpression = function() {
+  if (this.script_break_point() && this.script_break_point().logExpression()) {
+    return this.script_break_point().logExpression();
+  }
+  return this.logExpression_;
+};
+
+
 BreakPoint.prototype.script_break_point = function() {
   return this.script_break_point_;
 };
@@ -191,6 +200,14 @@ BreakPoint.prototype.setIgnoreCount = function(ignoreCount) {
 };
 
 
+// A break point with a log expression is a log point: every time it is hit
+// the expression is evaluated in the top frame, typically to print a value,
+// and execution continues without breaking.
+BreakPoint.prototype.setLogExpression = function(logExpression) {
+  this.logExpression_ = logExpression;
+};
+
+
 BreakPoint.prototype.isTriggered = function(exec_state) {
   // Break point not active - not triggered.
   if (!this.active()) return false;
@@ -222,6 +239,16 @@ BreakPoint.prototype.isTriggered = function(exec_state) {
     return false;
   }
 
+  // A log point evaluates its expression instead of breaking. Exceptions
+  // are ignored, as for the condition.
+  if (this.logExpression()) {
+    try {
+      exec_state.frame(0).evaluate(this.logExpression());
+    } catch (e) {
+    }
+    return false;
+  }
+
   // Break point triggered.
   return true;
 };
@@ -258,6 +285,7 @@ function ScriptBreakPoint(type, script_id_or_name, opt_line, opt_column,
   this.active_ = true;
   this.condition_ = null;
   this.ignoreCount_ = 0;
+  this.logExpression_ = null;
   this.break_points_ = [];
 }
 
@@ -274,6 +302,7 @@ ScriptBreakPoint.prototype.cloneForOtherScript = function (other_script) {
   copy.active_ = this.active_;
   copy.condition_ = this.condition_;
   copy.ignoreCount_ = this.ignoreCount_;
+  copy.logExpression_ = this.logExpression_;
   return copy;
 };
 
@@ -353,6 +382,11 @@ ScriptBreakPoint.prototype.ignoreCount = function() {
 };
 
 
+ScriptBreakPoint.prototype.logExpression = function() {
+  return this.logExpression_;
+};
+
+
 ScriptBreakPoint.prototype.enable = function() {
   this.active_ = true;
 };
@@ -368,6 +402,11 @@ ScriptBreakPoint.prototype.setCondition = function(condition) {
 };
 
 
+ScriptBreakPoint.prototype.setLogExpression = function(logExpression) {
+  this.logExpression_ = logExpression;
+};
+
+
 ScriptBreakPoint.prototype.setIgnoreCount = function(ignoreCount) {
   this.ignoreCount_ = ignoreCount;
 
@@ -723,6 +762,13 @@ Debug.changeBreakPointIgnoreCount = function(break_point_number, ignoreCount) {
 };
 
 
+Debug.changeBreakPointLogExpression = function(break_point_number,
+                                               logExpression) {
+  var break_point = this.findBreakPoint(break_point_number, false);
+  break_point.setLogExpression(logExpression);
+};
+
+
 Debug.clearBreakPoint = function(break_point_number) {
   var break_point = this.findBreakPoint(break_point_number, true);
   if (break_point) {
@@ -1508,6 +1554,7 @@ DebugCommandProcessor.prototype.setBreakPointRequest_ =
       true : request.arguments.enabled;
   var condition = request.arguments.condition;
   var ignoreCount = request.arguments.ignoreCount;
+  var logExpression = request.arguments.logExpression;
   var groupId = request.arguments.groupId;
 
   // Check for legal arguments.
@@ -1576,6 +1623,9 @@ DebugCommandProcessor.prototype.setBreakPointRequest_ =
   if (ignoreCount) {
     Debug.changeBreakPointIgnoreCount(break_point_number, ignoreCount);
   }
+  if (logExpression) {
+    Debug.changeBreakPointLogExpression(break_point_number, logExpression);
+  }
   if (!enabled) {
     Debug.disableBreakPoint(break_point_number);
   }
@@ -1622,6 +1672,7 @@ DebugCommandProcessor.prototype.changeBreakPointRequest_ = function(
   var enabled = request.arguments.enabled;
   var condition = request.arguments.condition;
   var ignoreCount = request.arguments.ignoreCount;
+  var logExpression = request.arguments.logExpression;
 
   // Check for legal arguments.
   if (!break_point) {
@@ -1647,6 +1698,11 @@ DebugCommandProcessor.prototype.changeBreakPointRequest_ = function(
   if (!IS_UNDEFINED(ignoreCount)) {
     Debug.changeBreakPointIgnoreCount(break_point, ignoreCount);
   }
+
+  // Change log expression if supplied
+  if (!IS_UNDEFINED(logExpression)) {
+    Debug.changeBreakPointLogExpression(break_point, logExpression);
+  }
 };
 
 
@@ -1725,6 +1781,7 @@ DebugCommandProcessor.prototype.listBreakpointsRequest_ = function(
       active: break_point.active(),
       condition: break_point.condition(),
       ignoreCount: break_point.ignoreCount(),
+      logExpression: break_point.logExpression(),
       actual_locations: break_point.actual_locations()
     };
 
@@ -39,6 +39,7 @@ Debug::Debug(Isolate* isolate)
       is_suppressed_(false),
       live_edit_enabled_(true),  // TODO(yangguo): set to false by default.
       has_break_points_(false),
+      prepared_for_break_points_(false),
       break_disabled_(false),
       break_on_exception_(false),
       break_on_uncaught_exception_(false),
@@ -65,6 +66,7 @@ BreakLocationIterator::BreakLocationIterator(Handle<DebugInfo> debug_info,
   type_ = type;
   reloc_iterator_ = NULL;
   reloc_iterator_original_ = NULL;
+  position_iterator_ = NULL;
   Reset();  // Initialize the rest of the member variables.
 }
 
@@ -72,8 +74,10 @@ BreakLocationIterator::BreakLocationIterator(Handle<DebugInfo> debug_info,
 BreakLocationIterator::~BreakLocationIterator() {
   DCHECK(reloc_iterator_ != NULL);
   DCHECK(reloc_iterator_original_ != NULL);
+  DCHECK(position_iterator_ != NULL);
   delete reloc_iterator_;
   delete reloc_iterator_original_;
+  delete position_iterator_;
 }
 
 
@@ -107,15 +111,18 @@ void BreakLocationIterator::Next() {
 
     // Whenever a statement position or (plain) position is passed update the
     // current value of these.
-    if (RelocInfo::IsPosition(rmode())) {
-      if (RelocInfo::IsStatementPosition(rmode())) {
-        statement_position_ = static_cast<int>(
-            rinfo()->data() - debug_info_->shared()->start_position());
+    int code_offset = static_cast<int>(pc() - code()->instruction_start());
+    for (; !position_iterator_->done() &&
+               position_iterator_->code_offset() <= code_offset;
+         position_iterator_->Advance()) {
+      int position = position_iterator_->source_position() -
+                     debug_info_->shared()->start_position();
+      if (position_iterator_->is_statement()) {
+        statement_position_ = position;
       }
       // Always update the position as we don't want that to be before the
       // statement position.
-      position_ = static_cast<int>(
-          rinfo()->data() - debug_info_->shared()->start_position());
+      position_ = position;
       DCHECK(position_ >= 0);
       DCHECK(statement_position_ >= 0);
     }
@@ -252,6 +259,9 @@ void BreakLocationIterator::Reset() {
   reloc_iterator_original_ = new RelocIterator(
       debug_info_->original_code(),
       ~RelocInfo::ModeMask(RelocInfo::CODE_AGE_SEQUENCE));
+  if (position_iterator_ != NULL) delete position_iterator_;
+  position_iterator_ = new SourcePositionTableIterator(
+      debug_info_->original_code()->source_position_table());
 
   // Position at the first break point.
   break_point_ = -1;
@@ -1077,10 +1087,9 @@ bool Debug::SetBreakPoint(Handle<JSFunction> function,
                           int* source_position) {
   HandleScope scope(isolate_);
 
-  PrepareForBreakPoints();
-
   // Make sure the function is compiled and has set up the debug info.
   Handle<SharedFunctionInfo> shared(function->shared());
+  PrepareFunctionForBreakPoints(shared);
   if (!EnsureDebugInfo(shared, function)) {
     // Return if retrieving debug info failed.
     return true;
@@ -1108,7 +1117,7 @@ bool Debug::SetBreakPointForScript(Handle<Script> script,
                                    BreakPositionAlignment alignment) {
   HandleScope scope(isolate_);
 
-  PrepareForBreakPoints();
+  if (!FLAG_debug_targeted_break_points) PrepareForBreakPoints();
 
   // Obtain shared function info for the function.
   Object* result = FindSharedFunctionInfoInScript(script, *source_position);
@@ -1116,6 +1125,7 @@ bool Debug::SetBreakPointForScript(Handle<Script> script,
 
   // Make sure the function has set up the debug info.
   Handle<SharedFunctionInfo> shared(SharedFunctionInfo::cast(result));
+  PrepareFunctionForBreakPoints(shared);
   if (!EnsureDebugInfo(shared, Handle<JSFunction>::null())) {
     // Return if retrieving debug info failed.
     return false;
@@ -1896,164 +1906,186 @@ static void RecompileAndRelocateSuspendedGenerators(
 void Debug::PrepareForBreakPoints() {
   // If preparing for the first break point make sure to deoptimize all
   // functions as debugging does not work with optimized code.
-  if (!has_break_points_) {
-    if (isolate_->concurrent_recompilation_enabled()) {
-      isolate_->optimizing_compiler_thread()->Flush();
-    }
+  if (!prepared_for_break_points_) {
+    PrepareCodeForBreakPoints(Handle<SharedFunctionInfo>::null());
+    prepared_for_break_points_ = true;
+  }
+}
 
-    Deoptimizer::DeoptimizeAll(isolate_);
 
-    Handle<Code> lazy_compile = isolate_->builtins()->CompileLazy();
+void Debug::PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared) {
+  if (!FLAG_debug_targeted_break_points) return PrepareForBreakPoints();
+  // Functions that already have break points have been prepared, and after
+  // a full preparation every function is ready.
+  if (prepared_for_break_points_ || HasDebugInfo(shared)) return;
+  PrepareCodeForBreakPoints(shared);
+}
 
-    // There will be at least one break point when we are done.
-    has_break_points_ = true;
 
-    // Keep the list of activated functions in a handlified list as it
-    // is used both in GC and non-GC code.
-    List<Handle<JSFunction> > active_functions(100);
-
-    // A list of all suspended generators.
-    List<Handle<JSGeneratorObject> > suspended_generators;
-
-    // A list of all generator functions.  We need to recompile all functions,
-    // but we don't know until after visiting the whole heap which generator
-    // functions have suspended activations and which do not.  As in the case of
-    // functions with activations on the stack, we need to be careful with
-    // generator functions with suspended activations because although they
-    // should be recompiled, recompilation can fail, and we need to avoid
-    // leaving the heap in an inconsistent state.
-    //
-    // We could perhaps avoid this list and instead re-use the GC metadata
-    // links.
-    List<Handle<JSFunction> > generator_functions;
-
-    {
-      // We are going to iterate heap to find all functions without
-      // debug break slots.
-      Heap* heap = isolate_->heap();
-      heap->CollectAllGarbage(Heap::kMakeHeapIterableMask,
-                              "preparing for breakpoints");
-      HeapIterator iterator(heap);
+void Debug::PrepareCodeForBreakPoints(Handle<SharedFunctionInfo> target) {
+  if (isolate_->concurrent_recompilation_enabled()) {
+    isolate_->optimizing_compiler_thread()->Flush();
+  }
 
-      // Ensure no GC in this scope as we are going to use gc_metadata
-      // field in the Code object to mark active functions.
-      DisallowHeapAllocation no_allocation;
-
-      Object* active_code_marker = heap->the_hole_value();
-
-      CollectActiveFunctionsFromThread(isolate_,
-                                       isolate_->thread_local_top(),
-                                       &active_functions,
-                                       active_code_marker);
-      ActiveFunctionsCollector active_functions_collector(&active_functions,
-                                                          active_code_marker);
-      isolate_->thread_manager()->IterateArchivedThreads(
-          &active_functions_collector);
-
-      // Scan the heap for all non-optimized functions which have no
-      // debug break slots and are not active or inlined into an active
-      // function and mark them for lazy compilation.
-      HeapObject* obj = NULL;
-      while (((obj = iterator.next()) != NULL)) {
-        if (obj->IsJSFunction()) {
-          JSFunction* function = JSFunction::cast(obj);
-          SharedFunctionInfo* shared = function->shared();
+  if (target.is_null()) {
+    Deoptimizer::DeoptimizeAll(isolate_);
+  } else {
+    Deoptimizer::DeoptimizeDependentFunctions(*target);
+  }
 
-          if (!shared->allows_lazy_compilation()) continue;
-          if (!shared->script()->IsScript()) continue;
-          if (function->IsFromNativeScript()) continue;
-          if (shared->code()->gc_metadata() == active_code_marker) continue;
+  Handle<Code> lazy_compile = isolate_->builtins()->CompileLazy();
 
-          if (shared->is_generator()) {
-            generator_functions.Add(Handle<JSFunction>(function, isolate_));
-            continue;
-          }
+  // There will be at least one break point when we are done.
+  has_break_points_ = true;
 
-          Code::Kind kind = function->code()->kind();
-          if (kind == Code::FUNCTION &&
-              !function->code()->has_debug_break_slots()) {
+  // Keep the list of activated functions in a handlified list as it
+  // is used both in GC and non-GC code.
+  List<Handle<JSFunction> > active_functions(100);
+
+  // A list of all suspended generators.
+  List<Handle<JSGeneratorObject> > suspended_generators;
+
+  // A list of all generator functions.  We need to recompile all functions,
+  // but we don't know until after visiting the whole heap which generator
+  // functions have suspended activations and which do not.  As in the case of
+  // functions with activations on the stack, we need to be careful with
+  // generator functions with suspended activations because although they
+  // should be recompiled, recompilation can fail, and we need to avoid
+  // leaving the heap in an inconsistent state.
+  //
+  // We could perhaps avoid this list and instead re-use the GC metadata
+  // links.
+  List<Handle<JSFunction> > generator_functions;
+
+  {
+    // We are going to iterate heap to find all functions without
+    // debug break slots.
+    Heap* heap = isolate_->heap();
+    heap->CollectAllGarbage(Heap::kMakeHeapIterableMask,
+                            "preparing for breakpoints");
+    HeapIterator iterator(heap);
+
+    // Ensure no GC in this scope as we are going to use gc_metadata
+    // field in the Code object to mark active functions.
+    DisallowHeapAllocation no_allocation;
+
+    Object* active_code_marker = heap->the_hole_value();
+
+    CollectActiveFunctionsFromThread(isolate_,
+                                     isolate_->thread_local_top(),
+                                     &active_functions,
+                                     active_code_marker);
+    ActiveFunctionsCollector active_functions_collector(&active_functions,
+                                                        active_code_marker);
+    isolate_->thread_manager()->IterateArchivedThreads(
+        &active_functions_collector);
+
+    // Scan the heap for all non-optimized functions which have no
+    // debug break slots and are not active or inlined into an active
+    // function and mark them for lazy compilation.
+    HeapObject* obj = NULL;
+    while (((obj = iterator.next()) != NULL)) {
+      if (obj->IsJSFunction()) {
+        JSFunction* function = JSFunction::cast(obj);
+        SharedFunctionInfo* shared = function->shared();
+
+        if (!target.is_null() && shared != *target) continue;
+        if (!shared->allows_lazy_compilation()) continue;
+        if (!shared->script()->IsScript()) continue;
+        if (function->IsFromNativeScript()) continue;
+        if (shared->code()->gc_metadata() == active_code_marker) continue;
+
+        if (shared->is_generator()) {
+          generator_functions.Add(Handle<JSFunction>(function, isolate_));
+          continue;
+        }
+
+        Code::Kind kind = function->code()->kind();
+        if (kind == Code::FUNCTION &&
+            !function->code()->has_debug_break_slots()) {
+          function->ReplaceCode(*lazy_compile);
+          function->shared()->ReplaceCode(*lazy_compile);
+        } else if (kind == Code::BUILTIN &&
+            (function->IsInOptimizationQueue() ||
+             function->IsMarkedForOptimization() ||
+             function->IsMarkedForConcurrentOptimization())) {
+          // Abort in-flight compilation.
+          Code* shared_code = function->shared()->code();
+          if (shared_code->kind() == Code::FUNCTION &&
+              shared_code->has_debug_break_slots()) {
+            function->ReplaceCode(shared_code);
+          } else {
             function->ReplaceCode(*lazy_compile);
             function->shared()->ReplaceCode(*lazy_compile);
-          } else if (kind == Code::BUILTIN &&
-              (function->IsInOptimizationQueue() ||
-               function->IsMarkedForOptimization() ||
-               function->IsMarkedForConcurrentOptimization())) {
-            // Abort in-flight compilation.
-            Code* shared_code = function->shared()->code();
-            if (shared_code->kind() == Code::FUNCTION &&
-                shared_code->has_debug_break_slots()) {
-              function->ReplaceCode(shared_code);
-            } else {
-              function->ReplaceCode(*lazy_compile);
-              function->shared()->ReplaceCode(*lazy_compile);
-            }
           }
-        } else if (obj->IsJSGeneratorObject()) {
-          JSGeneratorObject* gen = JSGeneratorObject::cast(obj);
-          if (!gen->is_suspended()) continue;
+        }
+      } else if (obj->IsJSGeneratorObject()) {
+        JSGeneratorObject* gen = JSGeneratorObject::cast(obj);
+        if (!gen->is_suspended()) continue;
 
-          JSFunction* fun = gen->function();
-          DCHECK_EQ(fun->code()->kind(), Code::FUNCTION);
-          if (fun->code()->has_debug_break_slots()) continue;
+        JSFunction* fun = gen->function();
+        if (!target.is_null() && fun->shared() != *target) continue;
+        DCHECK_EQ(fun->code()->kind(), Code::FUNCTION);
+        if (fun->code()->has_debug_break_slots()) continue;
 
-          int pc_offset = gen->continuation();
-          DCHECK_LT(0, pc_offset);
+        int pc_offset = gen->continuation();
+        DCHECK_LT(0, pc_offset);
 
-          int code_offset =
-              ComputeCodeOffsetFromPcOffset(fun->code(), pc_offset);
+        int code_offset =
+            ComputeCodeOffsetFromPcOffset(fun->code(), pc_offset);
 
-          // This will be fixed after we recompile the functions.
-          gen->set_continuation(code_offset);
+        // This will be fixed after we recompile the functions.
+        gen->set_continuation(code_offset);
 
-          suspended_generators.Add(Handle<JSGeneratorObject>(gen, isolate_));
-        }
-      }
-
-      // Clear gc_metadata field.
-      for (int i = 0; i < active_functions.length(); i++) {
-        Handle<JSFunction> function = active_functions[i];
-        function->shared()->code()->set_gc_metadata(Smi::FromInt(0));
+        suspended_generators.Add(Handle<JSGeneratorObject>(gen, isolate_));
       }
     }
 
-    // Recompile generator functions that have suspended activations, and
-    // relocate those activations.
-    RecompileAndRelocateSuspendedGenerators(suspended_generators);
-
-    // Mark generator functions that didn't have suspended activations for lazy
-    // recompilation.  Note that this set does not include any active functions.
-    for (int i = 0; i < generator_functions.length(); i++) {
-      Handle<JSFunction> &function = generator_functions[i];
-      if (function->code()->kind() != Code::FUNCTION) continue;
-      if (function->code()->has_debug_break_slots()) continue;
-      function->ReplaceCode(*lazy_compile);
-      function->shared()->ReplaceCode(*lazy_compile);
-    }
-
-    // Now recompile all functions with activation frames and and
-    // patch the return address to run in the new compiled code.  It could be
-    // that some active functions were recompiled already by the suspended
-    // generator recompilation pass above; a generator with suspended
-    // activations could also have active activations.  That's fine.
+    // Clear gc_metadata field.
     for (int i = 0; i < active_functions.length(); i++) {
       Handle<JSFunction> function = active_functions[i];
-      Handle<SharedFunctionInfo> shared(function->shared());
+      function->shared()->code()->set_gc_metadata(Smi::FromInt(0));
+    }
+  }
 
-      // If recompilation is not possible just skip it.
-      if (shared->is_toplevel()) continue;
-      if (!shared->allows_lazy_compilation()) continue;
-      if (shared->code()->kind() == Code::BUILTIN) continue;
+  // Recompile generator functions that have suspended activations, and
+  // relocate those activations.
+  RecompileAndRelocateSuspendedGenerators(suspended_generators);
 
-      EnsureFunctionHasDebugBreakSlots(function);
-    }
+  // Mark generator functions that didn't have suspended activations for lazy
+  // recompilation.  Note that this set does not include any active functions.
+  for (int i = 0; i < generator_functions.length(); i++) {
+    Handle<JSFunction> &function = generator_functions[i];
+    if (function->code()->kind() != Code::FUNCTION) continue;
+    if (function->code()->has_debug_break_slots()) continue;
+    function->ReplaceCode(*lazy_compile);
+    function->shared()->ReplaceCode(*lazy_compile);
+  }
 
-    RedirectActivationsToRecompiledCodeOnThread(isolate_,
-                                                isolate_->thread_local_top());
+  // Now recompile all functions with activation frames and and
+  // patch the return address to run in the new compiled code.  It could be
+  // that some active functions were recompiled already by the suspended
+  // generator recompilation pass above; a generator with suspended
+  // activations could also have active activations.  That's fine.
+  for (int i = 0; i < active_functions.length(); i++) {
+    Handle<JSFunction> function = active_functions[i];
+    Handle<SharedFunctionInfo> shared(function->shared());
 
-    ActiveFunctionsRedirector active_functions_redirector;
-    isolate_->thread_manager()->IterateArchivedThreads(
-          &active_functions_redirector);
+    // If recompilation is not possible just skip it.
+    if (!target.is_null() && !shared.is_identical_to(target)) continue;
+    if (shared->is_toplevel()) continue;
+    if (!shared->allows_lazy_compilation()) continue;
+    if (shared->code()->kind() == Code::BUILTIN) continue;
+
+    EnsureFunctionHasDebugBreakSlots(function);
   }
+
+  RedirectActivationsToRecompiledCodeOnThread(isolate_,
+                                              isolate_->thread_local_top());
+
+  ActiveFunctionsRedirector active_functions_redirector;
+  isolate_->thread_manager()->IterateArchivedThreads(
+        &active_functions_redirector);
 }
 
 
@@ -2214,6 +2246,7 @@ void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
       // If there are no more debug info objects there are not more break
       // points.
       has_break_points_ = debug_info_list_ != NULL;
+      if (!has_break_points_) prepared_for_break_points_ = false;
 
       return;
     }
@@ -2231,11 +2264,11 @@ void Debug::SetAfterBreakTarget(JavaScriptFrame* frame) {
   if (LiveEdit::SetAfterBreakTarget(this)) return;  // LiveEdit did the job.
 
   HandleScope scope(isolate_);
-  PrepareForBreakPoints();
 
   // Get the executing function in which the debug break occurred.
   Handle<JSFunction> function(JSFunction::cast(frame->function()));
   Handle<SharedFunctionInfo> shared(function->shared());
+  PrepareFunctionForBreakPoints(shared);
   if (!EnsureDebugInfo(shared, function)) {
     // Return if we failed to retrieve the debug info.
     return;
@@ -2325,11 +2358,10 @@ bool Debug::IsBreakAtReturn(JavaScriptFrame* frame) {
     return false;
   }
 
-  PrepareForBreakPoints();
-
   // Get the executing function in which the debug break occurred.
   Handle<JSFunction> function(JSFunction::cast(frame->function()));
   Handle<SharedFunctionInfo> shared(function->shared());
+  PrepareFunctionForBreakPoints(shared);
   if (!EnsureDebugInfo(shared, function)) {
     // Return if we failed to retrieve the debug info.
     return false;
@@ -123,6 +123,7 @@ class BreakLocationIterator {
   Handle<DebugInfo> debug_info_;
   RelocIterator* reloc_iterator_;
   RelocIterator* reloc_iterator_original_;
+  SourcePositionTableIterator* position_iterator_;
 
  private:
   void SetDebugBreak();
@@ -408,6 +409,10 @@ class Debug {
 
   // Purge all code objects that have no debug break slots.
   void PrepareForBreakPoints();
+  // Same as PrepareForBreakPoints, except that with
+  // --debug-targeted-break-points only the code of the given function and
+  // the optimized code it has been inlined into are purged.
+  void PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared);
 
   // Returns whether the operation succeeded. Compilation can only be triggered
   // if a valid closure is passed as the second argument, otherwise the shared
@@ -469,6 +474,11 @@ class Debug {
   inline bool is_active() const { return is_active_; }
   inline bool is_loaded() const { return !debug_context_.is_null(); }
   inline bool has_break_points() const { return has_break_points_; }
+  // Whether all code has been prepared for break points, which rules out
+  // optimization in the whole isolate.
+  inline bool prepared_for_break_points() const {
+    return prepared_for_break_points_;
+  }
   inline bool in_debug_scope() const {
     return thread_local_.current_debug_scope_ != NULL;
   }
@@ -550,6 +560,8 @@ class Debug {
   void InvokeMessageHandler(MessageImpl message);
 
   static bool CompileDebuggerScript(Isolate* isolate, int index);
+  // Purges the code of |target|, or of all functions if it is null.
+  void PrepareCodeForBreakPoints(Handle<SharedFunctionInfo> target);
   void ClearOneShot();
   void ActivateStepIn(StackFrame* frame);
   void ClearStepIn();
@@ -583,6 +595,7 @@ class Debug {
   bool is_suppressed_;
   bool live_edit_enabled_;
   bool has_break_points_;
+  bool prepared_for_break_points_;
   bool break_disabled_;
   bool break_on_exception_;
   bool break_on_uncaught_exception_;
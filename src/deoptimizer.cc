@@ -5,6 +5,7 @@
 #include "src/v8.h"
 
 #include "src/accessors.h"
+#include "src/api.h"
 #include "src/codegen.h"
 #include "src/deoptimizer.h"
 #include "src/disasm.h"
@@ -34,7 +35,8 @@ static MemoryChunk* AllocateCodeChunk(MemoryAllocator* allocator) {
 DeoptimizerData::DeoptimizerData(MemoryAllocator* allocator)
     : allocator_(allocator),
       deoptimized_frame_info_(NULL),
-      current_(NULL) {
+      current_(NULL),
+      deoptimization_count_(0) {
   for (int i = 0; i < Deoptimizer::kBailoutTypesWithCodeEntry; ++i) {
     deopt_entry_code_entries_[i] = -1;
     deopt_entry_code_[i] = AllocateCodeChunk(allocator);
@@ -50,6 +52,35 @@ DeoptimizerData::~DeoptimizerData() {
 }
 
 
+void TranslationCache::Prepare(Heap* heap, Code* code, int deopt_index) {
+  // Comparing the code is only meaningful as long as no GC has moved or
+  // freed it.
+  if (code == code_ && deopt_index == deopt_index_ &&
+      heap->gc_count() == gc_count_) {
+    return;
+  }
+  DeoptimizationInputData* data =
+      DeoptimizationInputData::cast(code->deoptimization_data());
+  code_ = code;
+  deopt_index_ = deopt_index;
+  gc_count_ = heap->gc_count();
+  next_index_ = data->TranslationIndex(deopt_index)->value();
+  values_.Rewind(0);
+}
+
+
+int32_t TranslationCache::ValueAt(int position) {
+  if (position < values_.length()) return values_[position];
+  ByteArray* buffer =
+      DeoptimizationInputData::cast(code_->deoptimization_data())
+          ->TranslationByteArray();
+  while (values_.length() <= position) {
+    values_.Add(TranslationIterator::Decode(buffer, &next_index_));
+  }
+  return values_[position];
+}
+
+
 void DeoptimizerData::Iterate(ObjectVisitor* v) {
   if (deoptimized_frame_info_ != NULL) {
     deoptimized_frame_info_->Iterate(v);
@@ -90,6 +121,8 @@ Deoptimizer* Deoptimizer::New(JSFunction* function,
                                              NULL);
   CHECK(isolate->deoptimizer_data()->current_ == NULL);
   isolate->deoptimizer_data()->current_ = deoptimizer;
+  isolate->deoptimizer_data()->deoptimization_count_++;
+  isolate->counters()->deoptimizations()->Increment();
   return deoptimizer;
 }
 
@@ -489,6 +522,71 @@ void Deoptimizer::DeoptimizeGlobalObject(JSObject* object) {
 }
 
 
+// static
+bool Deoptimizer::IsInlined(JSFunction* function,
+                            SharedFunctionInfo* candidate) {
+  DisallowHeapAllocation no_gc;
+
+  if (function->code()->kind() != Code::OPTIMIZED_FUNCTION) return false;
+
+  DeoptimizationInputData* data =
+      DeoptimizationInputData::cast(function->code()->deoptimization_data());
+
+  if (data == function->GetIsolate()->heap()->empty_fixed_array()) {
+    return false;
+  }
+
+  FixedArray* literals = data->LiteralArray();
+
+  int inlined_count = data->InlinedFunctionCount()->value();
+  for (int i = 0; i < inlined_count; ++i) {
+    JSFunction* inlined = JSFunction::cast(literals->get(i));
+    if (inlined->shared() == candidate) return true;
+  }
+
+  return false;
+}
+
+
+// Marks code that shares the same shared function info or has inlined
+// code that shares the same function info.
+class DependentFunctionMarker: public OptimizedFunctionVisitor {
+ public:
+  SharedFunctionInfo* shared_info_;
+  bool found_;
+
+  explicit DependentFunctionMarker(SharedFunctionInfo* shared_info)
+    : shared_info_(shared_info), found_(false) { }
+
+  virtual void EnterContext(Context* context) { }  // Don't care.
+  virtual void LeaveContext(Context* context)  { }  // Don't care.
+  virtual void VisitFunction(JSFunction* function) {
+    // It should be guaranteed by the iterator that everything is optimized.
+    DCHECK(function->code()->kind() == Code::OPTIMIZED_FUNCTION);
+    if (shared_info_ == function->shared() ||
+        Deoptimizer::IsInlined(function, shared_info_)) {
+      // Mark the code for deoptimization.
+      function->code()->set_marked_for_deoptimization(true);
+      found_ = true;
+    }
+  }
+};
+
+
+void Deoptimizer::DeoptimizeDependentFunctions(
+    SharedFunctionInfo* function_info) {
+  DisallowHeapAllocation no_allocation;
+  DependentFunctionMarker marker(function_info);
+  // TODO(titzer): need to traverse all optimized code to find OSR code here.
+  VisitAllOptimizedFunctions(function_info->GetIsolate(), &marker);
+
+  if (marker.found_) {
+    // Only go through with the deoptimization if something was found.
+    DeoptimizeMarkedCode(function_info->GetIsolate());
+  }
+}
+
+
 void Deoptimizer::MarkAllCodeForContext(Context* context) {
   Object* element = context->OptimizedCodeListHead();
   while (!element->IsUndefined()) {
@@ -567,6 +665,7 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
       deferred_objects_double_values_(0),
       deferred_objects_(0),
       deferred_heap_numbers_(0),
+      next_handler_(NULL),
       jsframe_functions_(0),
       jsframe_has_adapted_arguments_(0),
       materialized_values_(NULL),
@@ -726,6 +825,11 @@ int Deoptimizer::GetOutputInfo(DeoptimizationOutputData* data,
 }
 
 
+int Deoptimizer::GetDeoptimizationCount(Isolate* isolate) {
+  return isolate->deoptimizer_data()->deoptimization_count_;
+}
+
+
 int Deoptimizer::GetDeoptimizedCodeCount(Isolate* isolate) {
   int length = 0;
   // Count all entries in the deoptimizing code list of every context.
@@ -779,12 +883,11 @@ void Deoptimizer::DoComputeOutputFrames() {
   }
 
   BailoutId node_id = input_data->AstId(bailout_id_);
-  ByteArray* translations = input_data->TranslationByteArray();
-  unsigned translation_index =
-      input_data->TranslationIndex(bailout_id_)->value();
+  TranslationCache* cache = &isolate_->deoptimizer_data()->translation_cache_;
+  cache->Prepare(isolate_->heap(), compiled_code_, bailout_id_);
 
   // Do the input frame to output frame(s) translation.
-  TranslationIterator iterator(translations, translation_index);
+  TranslationIterator iterator(cache);
   Translation::Opcode opcode =
       static_cast<Translation::Opcode>(iterator.Next());
   DCHECK(Translation::BEGIN == opcode);
@@ -805,6 +908,15 @@ void Deoptimizer::DoComputeOutputFrames() {
       input_->GetRegister(fp_reg.code()) +
           has_alignment_padding_ * kPointerSize);
 
+  // Unlink the stack handlers of the input frame, the output frames get their
+  // own copies (see TRY_HANDLER_SLOT).
+  StackHandler* handler =
+      StackHandler::FromAddress(Isolate::handler(isolate_->thread_local_top()));
+  while (handler != NULL && handler->address() < stack_fp_) {
+    handler = handler->next();
+  }
+  next_handler_ = handler == NULL ? NULL : handler->address();
+
   // Translate each output frame.
   for (int i = 0; i < count; ++i) {
     // Read the ast node id, function, and frame height for this output frame.
@@ -839,6 +951,7 @@ void Deoptimizer::DoComputeOutputFrames() {
       case Translation::INT32_STACK_SLOT:
       case Translation::UINT32_STACK_SLOT:
       case Translation::DOUBLE_STACK_SLOT:
+      case Translation::TRY_HANDLER_SLOT:
       case Translation::LITERAL:
       case Translation::ARGUMENTS_OBJECT:
       default:
@@ -847,6 +960,10 @@ void Deoptimizer::DoComputeOutputFrames() {
     }
   }
 
+  if (bailout_type_ != DEBUGGER) {
+    *isolate_->handler_address() = next_handler_;
+  }
+
   // Print some helpful diagnostic information.
   if (trace_scope_ != NULL) {
     double ms = timer.Elapsed().InMillisecondsF();
@@ -2026,6 +2143,46 @@ void Deoptimizer::MaterializeHeapObjects(JavaScriptFrameIterator* it) {
 }
 
 
+void Deoptimizer::NotifyDeoptimizationCallback(JavaScriptFrame* frame) {
+  STATIC_ASSERT(static_cast<int>(EAGER) ==
+                static_cast<int>(v8::DeoptimizationEvent::kEager));
+  STATIC_ASSERT(static_cast<int>(LAZY) ==
+                static_cast<int>(v8::DeoptimizationEvent::kLazy));
+  STATIC_ASSERT(static_cast<int>(SOFT) ==
+                static_cast<int>(v8::DeoptimizationEvent::kSoft));
+  STATIC_ASSERT(static_cast<int>(DEBUGGER) ==
+                static_cast<int>(v8::DeoptimizationEvent::kDebugger));
+  HandleScope scope(isolate_);
+  SharedFunctionInfo* shared = function_->shared();
+
+  v8::DeoptimizationEvent event;
+  event.function_ = v8::Utils::ToLocal(function());
+  event.type_ = static_cast<v8::DeoptimizationEvent::Type>(bailout_type_);
+  event.bailout_id_ = bailout_id_;
+  event.reason_ = compiled_code_->GetDeoptLocationComment(bailout_id_);
+  event.opt_count_ = shared->opt_count();
+  event.deopt_count_ = shared->deopt_count();
+  event.optimization_disabled_reason_ =
+      shared->optimization_disabled()
+          ? GetBailoutReason(shared->DisableOptimizationReason())
+          : NULL;
+
+  Code* code = frame->LookupCode();
+  SharedFunctionInfo* frame_shared = frame->function()->shared();
+  event.position_ = code->SourcePosition(frame->pc());
+  event.script_id_ = v8::UnboundScript::kNoScriptId;
+  event.line_number_ = v8::DeoptimizationEvent::kNoLineNumberInfo;
+  if (frame_shared->script()->IsScript()) {
+    Handle<Script> script(Script::cast(frame_shared->script()));
+    event.script_id_ = script->id()->value();
+    event.line_number_ = Script::GetLineNumber(script, event.position_) + 1;
+  }
+
+  isolate_->deoptimization_callback()(reinterpret_cast<v8::Isolate*>(isolate_),
+                                      event);
+}
+
+
 void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
     Address parameters_top,
     uint32_t parameters_size,
@@ -2113,6 +2270,7 @@ void Deoptimizer::DoTranslateObjectAndSkip(TranslationIterator* iterator) {
     case Translation::INT32_STACK_SLOT:
     case Translation::UINT32_STACK_SLOT:
     case Translation::DOUBLE_STACK_SLOT:
+    case Translation::TRY_HANDLER_SLOT:
     case Translation::LITERAL: {
       // The value is not part of any materialized object, so we can ignore it.
       iterator->Skip(Translation::NumberOfOperandsFor(opcode));
@@ -2349,6 +2507,10 @@ void Deoptimizer::DoTranslateObject(TranslationIterator* iterator,
       return;
     }
 
+    case Translation::TRY_HANDLER_SLOT:
+      FATAL("Unexpected try handler slot in a materialized object.");
+      return;
+
     case Translation::LITERAL: {
       Object* literal = ComputeLiteral(iterator->Next());
       if (trace_scope_ != NULL) {
@@ -2634,6 +2796,41 @@ void Deoptimizer::DoTranslateCommand(TranslationIterator* iterator,
       return;
     }
 
+    case Translation::TRY_HANDLER_SLOT: {
+      // The state and the context of a handler are copied from the optimized
+      // frame, the remaining words are rebuilt for the unoptimized frame: the
+      // handlers are relinked in stack order, and the code and frame pointer
+      // refer to the unoptimized code of the output frame.
+      int handler_offset = iterator->Next();
+      int input_slot_index = iterator->Next();
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(input_slot_index);
+      intptr_t value = input_->GetFrameSlot(input_offset);
+      FrameDescription* output_frame = output_[frame_index];
+      if (bailout_type_ == DEBUGGER) {
+        value = kPlaceholder;
+      } else if (handler_offset == StackHandlerConstants::kNextOffset) {
+        value = reinterpret_cast<intptr_t>(next_handler_);
+        next_handler_ =
+            reinterpret_cast<Address>(output_frame->GetTop() + output_offset);
+      } else if (handler_offset == StackHandlerConstants::kCodeOffset) {
+        value = reinterpret_cast<intptr_t>(
+            output_frame->GetFunction()->shared()->code());
+      } else if (handler_offset == StackHandlerConstants::kFPOffset) {
+        value = output_frame->GetFp();
+      }
+      if (trace_scope_ != NULL) {
+        PrintF(trace_scope_->file(),
+               "    0x%08" V8PRIxPTR ": [top + %d] <- 0x%08" V8PRIxPTR
+               " ; try handler [+%d]\n",
+               output_frame->GetTop() + output_offset,
+               output_offset,
+               value,
+               handler_offset);
+      }
+      output_frame->SetFrameSlot(output_offset, value);
+      return;
+    }
+
     case Translation::LITERAL: {
       Object* literal = ComputeLiteral(iterator->Next());
       if (trace_scope_ != NULL) {
@@ -2923,12 +3120,19 @@ void TranslationBuffer::Add(int32_t value, Zone* zone) {
 
 
 int32_t TranslationIterator::Next() {
+  if (cache_ != NULL) return cache_->ValueAt(index_++);
+  DCHECK(HasNext());
+  return Decode(buffer_, &index_);
+}
+
+
+int32_t TranslationIterator::Decode(ByteArray* buffer, int* index) {
   // Run through the bytes until we reach one with a least significant
   // bit of zero (marks the end).
   uint32_t bits = 0;
   for (int i = 0; true; i += 7) {
-    DCHECK(HasNext());
-    uint8_t next = buffer_->get(index_++);
+    DCHECK(*index < buffer->length());
+    uint8_t next = buffer->get((*index)++);
     bits |= (next >> 1) << i;
     if ((next & 1) == 0) break;
   }
@@ -3054,6 +3258,13 @@ void Translation::StoreDoubleStackSlot(int index) {
 }
 
 
+void Translation::StoreTryHandlerSlot(int handler_offset, int index) {
+  buffer_->Add(TRY_HANDLER_SLOT, zone());
+  buffer_->Add(handler_offset, zone());
+  buffer_->Add(index, zone());
+}
+
+
 void Translation::StoreLiteral(int literal_id) {
   buffer_->Add(LITERAL, zone());
   buffer_->Add(literal_id, zone());
@@ -3091,6 +3302,7 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case BEGIN:
     case ARGUMENTS_ADAPTOR_FRAME:
     case CONSTRUCT_STUB_FRAME:
+    case TRY_HANDLER_SLOT:
       return 2;
     case JS_FRAME:
       return 3;
@@ -3177,6 +3389,11 @@ SlotRef SlotRefValueBuilder::ComputeSlotForNextArgument(
       return SlotRef(slot_addr, SlotRef::DOUBLE);
     }
 
+    case Translation::TRY_HANDLER_SLOT:
+      // Handler words are never arguments; they only need to be skipped.
+      iterator->Skip(Translation::NumberOfOperandsFor(opcode));
+      return SlotRef(data->GetIsolate(), data->GetHeap()->undefined_value());
+
     case Translation::LITERAL: {
       int literal_index = iterator->Next();
       return SlotRef(data->GetIsolate(),
@@ -153,6 +153,10 @@ class Deoptimizer : public Malloced {
   // Number of created JS frames. Not all created frames are necessarily JS.
   int jsframe_count() const { return jsframe_count_; }
 
+  // Reports this deoptimization to the embedder's deoptimization callback.
+  // The given frame is the topmost materialized unoptimized frame.
+  void NotifyDeoptimizationCallback(JavaScriptFrame* frame);
+
   static Deoptimizer* New(JSFunction* function,
                           BailoutType type,
                           unsigned bailout_id,
@@ -187,6 +191,14 @@ class Deoptimizer : public Malloced {
   // Deoptimize code associated with the given global object.
   static void DeoptimizeGlobalObject(JSObject* object);
 
+  // Returns true if an instance of candidate were inlined into function's
+  // code.
+  static bool IsInlined(JSFunction* function, SharedFunctionInfo* candidate);
+
+  // Deoptimize all optimized code of the given function, including code that
+  // has an inlined copy of it.
+  static void DeoptimizeDependentFunctions(SharedFunctionInfo* function_info);
+
   // Deoptimizes all optimized code that has been previously marked
   // (via code->set_marked_for_deoptimization) and unlinks all functions that
   // refer to that code.
@@ -244,6 +256,9 @@ class Deoptimizer : public Malloced {
 
   static int GetDeoptimizedCodeCount(Isolate* isolate);
 
+  // Number of times optimized code bailed out to unoptimized code.
+  static int GetDeoptimizationCount(Isolate* isolate);
+
   static const int kNotDeoptimizationEntry = -1;
 
   // Generators for the deoptimization entry code.
@@ -427,6 +442,10 @@ class Deoptimizer : public Malloced {
   List<ObjectMaterializationDescriptor> deferred_objects_;
   List<HeapNumberMaterializationDescriptor<Address> > deferred_heap_numbers_;
 
+  // The stack handlers of the input frame are rebuilt for the unoptimized
+  // code, this is the address of the last one written to the output frames.
+  Address next_handler_;
+
   // Key for lookup of previously materialized objects
   Address stack_fp_;
   Handle<FixedArray> previously_materialized_objects_;
@@ -631,6 +650,36 @@ class FrameDescription {
 };
 
 
+// Holds the decoded translation of the most recently deoptimized point.
+// Lazily deoptimizing a recursive function deoptimizes many frames of the
+// same code at the same deoptimization point one after the other, only the
+// first of them has to decode the translation byte stream. The translation
+// is decoded on demand as far as it is read. The cache refers to the code
+// without keeping it alive and is dropped by the next garbage collection.
+class TranslationCache {
+ public:
+  TranslationCache()
+      : code_(NULL), deopt_index_(-1), gc_count_(0), next_index_(0) {}
+
+  // Makes the cache hold the translation of {deopt_index} in {code}.
+  void Prepare(Heap* heap, Code* code, int deopt_index);
+
+  // Returns the value at {position} of the cached translation.
+  int32_t ValueAt(int position);
+
+ private:
+  Code* code_;
+  int deopt_index_;
+  int gc_count_;
+  // Offset of the first value in the translation byte array that has not
+  // been decoded yet.
+  int next_index_;
+  List<int32_t> values_;
+
+  DISALLOW_COPY_AND_ASSIGN(TranslationCache);
+};
+
+
 class DeoptimizerData {
  public:
   explicit DeoptimizerData(MemoryAllocator* allocator);
@@ -647,6 +696,11 @@ class DeoptimizerData {
 
   Deoptimizer* current_;
 
+  // Number of deoptimizations done so far, see Deoptimizer::New.
+  int deoptimization_count_;
+
+  TranslationCache translation_cache_;
+
   friend class Deoptimizer;
 
   DISALLOW_COPY_AND_ASSIGN(DeoptimizerData);
@@ -670,21 +724,32 @@ class TranslationBuffer BASE_EMBEDDED {
 class TranslationIterator BASE_EMBEDDED {
  public:
   TranslationIterator(ByteArray* buffer, int index)
-      : buffer_(buffer), index_(index) {
+      : buffer_(buffer), index_(index), cache_(NULL) {
     DCHECK(index >= 0 && index < buffer->length());
   }
 
+  // Reads the translation held by a prepared {cache}.
+  explicit TranslationIterator(TranslationCache* cache)
+      : buffer_(NULL), index_(0), cache_(cache) {}
+
   int32_t Next();
 
-  bool HasNext() const { return index_ < buffer_->length(); }
+  bool HasNext() const {
+    return cache_ != NULL || index_ < buffer_->length();
+  }
 
   void Skip(int n) {
     for (int i = 0; i < n; i++) Next();
   }
 
+  // Decodes the value at {*index} in {buffer} and advances {*index} past it.
+  static int32_t Decode(ByteArray* buffer, int* index);
+
  private:
   ByteArray* buffer_;
+  // Offset into {buffer_}, or position in {cache_} when reading the cache.
   int index_;
+  TranslationCache* cache_;
 };
 
 
@@ -707,6 +772,7 @@ class TranslationIterator BASE_EMBEDDED {
   V(INT32_STACK_SLOT)                                                          \
   V(UINT32_STACK_SLOT)                                                         \
   V(DOUBLE_STACK_SLOT)                                                         \
+  V(TRY_HANDLER_SLOT)                                                          \
   V(LITERAL)
 
 
@@ -749,6 +815,7 @@ class Translation BASE_EMBEDDED {
   void StoreInt32StackSlot(int index);
   void StoreUint32StackSlot(int index);
   void StoreDoubleStackSlot(int index);
+  void StoreTryHandlerSlot(int handler_offset, int index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject(bool args_known, int args_index, int args_length);
 
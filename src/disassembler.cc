@@ -80,8 +80,11 @@ static int DecodeIt(Isolate* isolate, std::ostream* os,
   byte* pc = begin;
   disasm::Disassembler d(converter);
   RelocIterator* it = NULL;
+  SourcePositionTableIterator* positions = NULL;
   if (converter.code() != NULL) {
     it = new RelocIterator(converter.code());
+    positions = new SourcePositionTableIterator(
+        converter.code()->source_position_table());
   } else {
     // No relocation information when printing code stubs.
   }
@@ -145,6 +148,19 @@ static int DecodeIt(Isolate* isolate, std::ostream* os,
       DumpBuffer(os, &out);
     }
 
+    // Source positions recorded for this instruction.
+    if (positions != NULL) {
+      int offset =
+          static_cast<int>(pc - converter.code()->instruction_start());
+      for (; !positions->done() && positions->code_offset() < offset;
+           positions->Advance()) {
+        out.AddFormatted("                  ;; debug: %s %d",
+                         positions->is_statement() ? "statement" : "position",
+                         positions->source_position());
+        DumpBuffer(os, &out);
+      }
+    }
+
     // Instruction address and instruction offset.
     out.AddFormatted("%p  %4d  ", prev_pc, prev_pc - begin);
 
@@ -167,13 +183,7 @@ static int DecodeIt(Isolate* isolate, std::ostream* os,
       }
 
       RelocInfo::Mode rmode = relocinfo.rmode();
-      if (RelocInfo::IsPosition(rmode)) {
-        if (RelocInfo::IsStatementPosition(rmode)) {
-          out.AddFormatted("    ;; debug: statement %d", relocinfo.data());
-        } else {
-          out.AddFormatted("    ;; debug: position %d", relocinfo.data());
-        }
-      } else if (rmode == RelocInfo::EMBEDDED_OBJECT) {
+      if (rmode == RelocInfo::EMBEDDED_OBJECT) {
         HeapStringAllocator allocator;
         StringStream accumulator(&allocator);
         relocinfo.target_object()->ShortPrint(&accumulator);
@@ -271,6 +281,7 @@ static int DecodeIt(Isolate* isolate, std::ostream* os,
   }
 
   delete it;
+  delete positions;
   return static_cast<int>(pc - begin);
 }
 
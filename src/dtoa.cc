@@ -30,6 +30,32 @@ static BignumDtoaMode DtoaToBignumDtoaMode(DtoaMode dtoa_mode) {
 }
 
 
+// The shortest representation of an integer that fits into the significand
+// of a double consists of its decimal digits without trailing zeros: all
+// neighboring doubles are at most 1 away.
+static const double kMaxExactDoubleInteger = 9007199254740992.0;  // 2^53
+
+
+static void ShortestIntegerDtoa(uint64_t value, Vector<char> buffer,
+                                int* length, int* point) {
+  DCHECK(value > 0);
+  int digits = 0;
+  while (value > 0) {
+    buffer[digits++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  for (int i = 0, j = digits - 1; i < j; i++, j--) {
+    char tmp = buffer[i];
+    buffer[i] = buffer[j];
+    buffer[j] = tmp;
+  }
+  *point = digits;
+  while (buffer[digits - 1] == '0') digits--;
+  *length = digits;
+  buffer[digits] = '\0';
+}
+
+
 void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
                    Vector<char> buffer, int* sign, int* length, int* point) {
   DCHECK(!Double(v).IsSpecial());
@@ -56,6 +82,12 @@ void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
     return;
   }
 
+  if (mode == DTOA_SHORTEST && v <= kMaxExactDoubleInteger &&
+      static_cast<double>(static_cast<uint64_t>(v)) == v) {
+    ShortestIntegerDtoa(static_cast<uint64_t>(v), buffer, length, point);
+    return;
+  }
+
   bool fast_worked;
   switch (mode) {
     case DTOA_SHORTEST:
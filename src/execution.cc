@@ -334,9 +334,9 @@ void StackGuard::DisableInterrupts() {
 void StackGuard::PushPostponeInterruptsScope(PostponeInterruptsScope* scope) {
   ExecutionAccess access(isolate_);
   // Intercept already requested interrupts.
-  int intercepted = thread_local_.interrupt_flags_ & scope->intercept_mask_;
+  int intercepted = interrupt_flags() & scope->intercept_mask_;
   scope->intercepted_flags_ = intercepted;
-  thread_local_.interrupt_flags_ &= ~intercepted;
+  set_interrupt_flags(access, interrupt_flags() & ~intercepted);
   if (!has_pending_interrupts(access)) reset_limits(access);
   // Add scope to the chain.
   scope->prev_ = thread_local_.postpone_interrupts_;
@@ -348,8 +348,8 @@ void StackGuard::PopPostponeInterruptsScope() {
   ExecutionAccess access(isolate_);
   PostponeInterruptsScope* top = thread_local_.postpone_interrupts_;
   // Make intercepted interrupts active.
-  DCHECK((thread_local_.interrupt_flags_ & top->intercept_mask_) == 0);
-  thread_local_.interrupt_flags_ |= top->intercepted_flags_;
+  DCHECK((interrupt_flags() & top->intercept_mask_) == 0);
+  set_interrupt_flags(access, interrupt_flags() | top->intercepted_flags_);
   if (has_pending_interrupts(access)) set_interrupt_limits(access);
   // Remove scope from chain.
   thread_local_.postpone_interrupts_ = top->prev_;
@@ -357,12 +357,15 @@ void StackGuard::PopPostponeInterruptsScope() {
 
 
 bool StackGuard::CheckInterrupt(InterruptFlag flag) {
-  ExecutionAccess access(isolate_);
-  return thread_local_.interrupt_flags_ & flag;
+  return (interrupt_flags() & flag) != 0;
 }
 
 
 void StackGuard::RequestInterrupt(InterruptFlag flag) {
+  // An interrupt that is already pending has armed the stack limits, and
+  // will be handled before HandleInterrupts clears it again.
+  if ((interrupt_flags() & flag) != 0) return;
+
   ExecutionAccess access(isolate_);
   // Check the chain of PostponeInterruptsScopes for interception.
   if (thread_local_.postpone_interrupts_ &&
@@ -371,7 +374,7 @@ void StackGuard::RequestInterrupt(InterruptFlag flag) {
   }
 
   // Not intercepted.  Set as active interrupt flag.
-  thread_local_.interrupt_flags_ |= flag;
+  set_interrupt_flags(access, interrupt_flags() | flag);
   set_interrupt_limits(access);
 }
 
@@ -386,15 +389,20 @@ void StackGuard::ClearInterrupt(InterruptFlag flag) {
   }
 
   // Clear the interrupt flag from the active interrupt flags.
-  thread_local_.interrupt_flags_ &= ~flag;
+  set_interrupt_flags(access, interrupt_flags() & ~flag);
   if (!has_pending_interrupts(access)) reset_limits(access);
 }
 
 
 bool StackGuard::CheckAndClearInterrupt(InterruptFlag flag) {
+  return FetchAndClearInterrupts(flag) != 0;
+}
+
+
+int StackGuard::FetchAndClearInterrupts(int mask) {
   ExecutionAccess access(isolate_);
-  bool result = (thread_local_.interrupt_flags_ & flag);
-  thread_local_.interrupt_flags_ &= ~flag;
+  int result = interrupt_flags() & mask;
+  set_interrupt_flags(access, interrupt_flags() & ~result);
   if (!has_pending_interrupts(access)) reset_limits(access);
   return result;
 }
@@ -673,28 +681,40 @@ Handle<String> Execution::GetStackTraceLine(Handle<Object> recv,
 
 
 Object* StackGuard::HandleInterrupts() {
-  if (CheckAndClearInterrupt(GC_REQUEST)) {
+  // Debug breaks and commands are cleared by the debugger once it has
+  // handled them, everything else is taken under a single lock.
+  const int kDebugInterrupts = DEBUGBREAK | DEBUGCOMMAND;
+  int interrupts = FetchAndClearInterrupts(ALL_INTERRUPTS & ~kDebugInterrupts);
+
+  if (interrupts & GC_REQUEST) {
     isolate_->heap()->CollectAllGarbage(Heap::kNoGCFlags, "GC interrupt");
   }
 
-  if (CheckDebugBreak() || CheckDebugCommand()) {
+  if (interrupt_flags() & kDebugInterrupts) {
     isolate_->debug()->HandleDebugBreak();
   }
 
-  if (CheckAndClearInterrupt(TERMINATE_EXECUTION)) {
+  if (interrupts & TERMINATE_EXECUTION) {
+    // Leave the interrupts that are not handled yet pending.
+    int remaining =
+        interrupts & (DEOPT_MARKED_ALLOCATION_SITES | INSTALL_CODE |
+                      API_INTERRUPT);
+    for (int flag = 1; flag <= remaining; flag <<= 1) {
+      if (remaining & flag) RequestInterrupt(static_cast<InterruptFlag>(flag));
+    }
     return isolate_->TerminateExecution();
   }
 
-  if (CheckAndClearInterrupt(DEOPT_MARKED_ALLOCATION_SITES)) {
+  if (interrupts & DEOPT_MARKED_ALLOCATION_SITES) {
     isolate_->heap()->DeoptMarkedAllocationSites();
   }
 
-  if (CheckAndClearInterrupt(INSTALL_CODE)) {
+  if (interrupts & INSTALL_CODE) {
     DCHECK(isolate_->concurrent_recompilation_enabled());
     isolate_->optimizing_compiler_thread()->InstallOptimizedFunctions();
   }
 
-  if (CheckAndClearInterrupt(API_INTERRUPT)) {
+  if (interrupts & API_INTERRUPT) {
     // Callback must be invoked outside of ExecusionAccess lock.
     isolate_->InvokeApiInterruptCallback();
   }
@@ -5,6 +5,7 @@
 #ifndef V8_EXECUTION_H_
 #define V8_EXECUTION_H_
 
+#include "src/base/atomicops.h"
 #include "src/handles.h"
 
 namespace v8 {
@@ -146,6 +147,11 @@ class StackGuard FINAL {
   // it has been set up.
   void ClearThread(const ExecutionAccess& lock);
 
+  // You should hold the ExecutionAccess lock when calling this method.
+  bool has_pending_interrupts(const ExecutionAccess& lock) {
+    return interrupt_flags() != 0;
+  }
+
 #define INTERRUPT_LIST(V)                                          \
   V(DEBUGBREAK, DebugBreak, 0)                                     \
   V(DEBUGCOMMAND, DebugCommand, 1)                                 \
@@ -195,21 +201,29 @@ class StackGuard FINAL {
   }
 
   // If the stack guard is triggered, but it is not an actual
-  // stack overflow, then handle the interruption accordingly.
+  // stack overflow, then handle the interruption accordingly. All pending
+  // interrupts are taken in one go and handled in a fixed order.
   Object* HandleInterrupts();
 
  private:
   StackGuard();
 
+  // The interrupt flags are only written with the ExecutionAccess lock held,
+  // but may be read without it, so that checking for an interrupt and
+  // requesting one that is already pending do not contend for the lock.
+  int interrupt_flags() const {
+    return base::Acquire_Load(&thread_local_.interrupt_flags_);
+  }
+  void set_interrupt_flags(const ExecutionAccess& lock, int flags) {
+    base::Release_Store(&thread_local_.interrupt_flags_, flags);
+  }
+
   bool CheckInterrupt(InterruptFlag flag);
   void RequestInterrupt(InterruptFlag flag);
   void ClearInterrupt(InterruptFlag flag);
   bool CheckAndClearInterrupt(InterruptFlag flag);
-
-  // You should hold the ExecutionAccess lock when calling this method.
-  bool has_pending_interrupts(const ExecutionAccess& lock) {
-    return thread_local_.interrupt_flags_ != 0;
-  }
+  // Clears and returns all pending interrupts in |mask|.
+  int FetchAndClearInterrupts(int mask);
 
   // You should hold the ExecutionAccess lock when calling this method.
   inline void set_interrupt_limits(const ExecutionAccess& lock);
@@ -258,7 +272,7 @@ class StackGuard FINAL {
     uintptr_t climit_;
 
     PostponeInterruptsScope* postpone_interrupts_;
-    int interrupt_flags_;
+    base::Atomic32 interrupt_flags_;
   };
 
   // TODO(isolates): Technically this could be calculated directly from a
@@ -250,10 +250,8 @@ MaybeHandle<String> Factory::NewStringFromUtf8(Vector<const char> string,
       String);
   // Copy ASCII portion.
   uint16_t* data = result->GetChars();
-  const char* ascii_data = string.start();
-  for (int i = 0; i < non_ascii_start; i++) {
-    *data++ = *ascii_data++;
-  }
+  CopyChars(data, reinterpret_cast<const uint8_t*>(start), non_ascii_start);
+  data += non_ascii_start;
   // Now write the remainder.
   decoder->WriteUtf16(data, utf16_length);
   return result;
@@ -470,6 +468,15 @@ Handle<String> ConcatStringContent(Handle<StringType> result,
 
 MaybeHandle<String> Factory::NewConsString(Handle<String> left,
                                            Handle<String> right) {
+  // Refer to the flat content of flattened cons strings directly, rather
+  // than keeping their now empty cons wrappers alive in the new tree.
+  if (left->IsConsString() && left->IsFlat()) {
+    left = handle(ConsString::cast(*left)->first(), isolate());
+  }
+  if (right->IsConsString() && right->IsFlat()) {
+    right = handle(ConsString::cast(*right)->first(), isolate());
+  }
+
   int left_length = left->length();
   if (left_length == 0) return right;
   int right_length = right->length();
@@ -851,6 +858,8 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_shared(heap->undefined_value());
   script->set_eval_from_instructions_offset(Smi::FromInt(0));
   script->set_flags(Smi::FromInt(0));
+  script->set_pretenuring_hints(heap->undefined_value());
+  script->set_tiering_hints(heap->undefined_value());
 
   return script;
 }
@@ -1056,6 +1065,17 @@ Handle<HeapNumber> Factory::NewHeapNumber(double value,
 }
 
 
+#define SIMD128_NEW_DEFINITION(TYPE, Type, type, lane_count, lane_type) \
+  Handle<Type> Factory::New##Type(lane_type lanes[lane_count],          \
+                                  PretenureFlag pretenure) {            \
+    CALL_HEAP_FUNCTION(                                                 \
+        isolate(), isolate()->heap()->Allocate##Type(lanes, pretenure), \
+        Type);                                                          \
+  }
+SIMD128_TYPES(SIMD128_NEW_DEFINITION)
+#undef SIMD128_NEW_DEFINITION
+
+
 MaybeHandle<Object> Factory::NewTypeError(const char* message,
                                           Vector<Handle<Object> > args) {
   return NewError("MakeTypeError", message, args);
@@ -1395,6 +1415,7 @@ Handle<JSFunction> Factory::NewFunctionFromSharedFunctionInfo(
       !info->is_toplevel() &&
       info->allows_lazy_compilation() &&
       !info->optimization_disabled() &&
+      !info->HasDebugInfo() &&
       !isolate()->DebuggerHasBreakPoints()) {
     result->MarkForOptimization();
   }
@@ -1457,6 +1478,7 @@ Handle<Code> Factory::NewCode(const CodeDesc& desc,
   code->set_raw_kind_specific_flags2(0);
   code->set_is_crankshafted(crankshafted);
   code->set_deoptimization_data(*empty_fixed_array(), SKIP_WRITE_BARRIER);
+  code->set_source_position_table(*empty_byte_array(), SKIP_WRITE_BARRIER);
   code->set_raw_type_feedback_info(Smi::FromInt(0));
   code->set_next_code_link(*undefined_value());
   code->set_handler_table(*empty_fixed_array(), SKIP_WRITE_BARRIER);
@@ -1498,13 +1520,6 @@ Handle<Code> Factory::CopyCode(Handle<Code> code) {
 }
 
 
-Handle<Code> Factory::CopyCode(Handle<Code> code, Vector<byte> reloc_info) {
-  CALL_HEAP_FUNCTION(isolate(),
-                     isolate()->heap()->CopyCode(*code, reloc_info),
-                     Code);
-}
-
-
 Handle<JSObject> Factory::NewJSObject(Handle<JSFunction> constructor,
                                       PretenureFlag pretenure) {
   JSFunction::EnsureHasInitialMap(constructor);
@@ -1706,6 +1721,35 @@ Handle<JSArrayBuffer> Factory::NewJSArrayBuffer() {
 }
 
 
+Handle<JSArrayBuffer> Factory::NewJSSharedArrayBuffer() {
+  DCHECK(FLAG_harmony_atomics);
+  Handle<JSFunction> shared_array_buffer_fun(
+      isolate()->native_context()->shared_array_buffer_fun());
+  CALL_HEAP_FUNCTION(
+      isolate(),
+      isolate()->heap()->AllocateJSObject(*shared_array_buffer_fun),
+      JSArrayBuffer);
+}
+
+
+Handle<JSMap> Factory::NewJSMap() {
+  Handle<JSFunction> js_map_fun(isolate()->native_context()->js_map_fun());
+  Handle<JSMap> js_map = Handle<JSMap>::cast(NewJSObject(js_map_fun));
+  Handle<OrderedHashMap> table = NewOrderedHashMap();
+  js_map->set_table(*table);
+  return js_map;
+}
+
+
+Handle<JSSet> Factory::NewJSSet() {
+  Handle<JSFunction> js_set_fun(isolate()->native_context()->js_set_fun());
+  Handle<JSSet> js_set = Handle<JSSet>::cast(NewJSObject(js_set_fun));
+  Handle<OrderedHashSet> table = NewOrderedHashSet();
+  js_set->set_table(*table);
+  return js_set;
+}
+
+
 Handle<JSDataView> Factory::NewJSDataView() {
   Handle<JSFunction> data_view_fun(
       isolate()->native_context()->data_view_fun());
@@ -2370,6 +2414,8 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpNfaProgramIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpLeadingCharacterIndex, Smi::FromInt(-1));
   regexp->set_data(*store);
 }
 
@@ -351,6 +351,12 @@ class Factory FINAL {
                                    MutableMode mode = IMMUTABLE,
                                    PretenureFlag pretenure = NOT_TENURED);
 
+#define SIMD128_NEW_DECLARATION(TYPE, Type, type, lane_count, lane_type) \
+  Handle<Type> New##Type(lane_type lanes[lane_count],                    \
+                         PretenureFlag pretenure = NOT_TENURED);
+  SIMD128_TYPES(SIMD128_NEW_DECLARATION)
+#undef SIMD128_NEW_DECLARATION
+
   // These objects are used by the api to create env-independent data
   // structures in the heap.
   inline Handle<JSObject> NewNeanderObject() {
@@ -432,6 +438,13 @@ class Factory FINAL {
 
   Handle<JSArrayBuffer> NewJSArrayBuffer();
 
+  // Requires --harmony-atomics.
+  Handle<JSArrayBuffer> NewJSSharedArrayBuffer();
+
+  // Create empty collections, as if by new Map() and new Set().
+  Handle<JSMap> NewJSMap();
+  Handle<JSSet> NewJSSet();
+
   Handle<JSTypedArray> NewJSTypedArray(ExternalArrayType type);
 
   Handle<JSDataView> NewJSDataView();
@@ -499,8 +512,6 @@ class Factory FINAL {
 
   Handle<Code> CopyCode(Handle<Code> code);
 
-  Handle<Code> CopyCode(Handle<Code> code, Vector<byte> reloc_info);
-
   // Interface for creating error objects.
 
   MaybeHandle<Object> NewError(const char* maker, const char* message,
@@ -39,9 +39,15 @@ inline FieldIndex FieldIndex::ForPropertyIndex(Map* map,
     first_inobject_offset = FixedArray::kHeaderSize;
     property_index -= inobject_properties;
   }
+  // Only Double fields are ever unboxed, so the layout of the map is
+  // authoritative even if the caller didn't know the representation.
+  bool is_unboxed_double =
+      is_inobject && map->IsUnboxedDoubleInObjectProperty(property_index);
+  if (is_unboxed_double) is_double = true;
   return FieldIndex(is_inobject,
                     property_index + first_inobject_offset / kPointerSize,
-                    is_double, inobject_properties, first_inobject_offset);
+                    is_double, inobject_properties, first_inobject_offset,
+                    false, is_unboxed_double);
 }
 
 
@@ -62,8 +68,12 @@ inline FieldIndex FieldIndex::ForLoadByFieldIndex(Map* map, int orig_index) {
     first_inobject_offset = map->GetInObjectPropertyOffset(0);
     field_index += JSObject::kHeaderSize / kPointerSize;
   }
+  bool is_unboxed_double =
+      is_double && is_inobject &&
+      map->IsUnboxedDoubleFieldOffset(field_index * kPointerSize);
   FieldIndex result(is_inobject, field_index, is_double,
-                    map->inobject_properties(), first_inobject_offset);
+                    map->inobject_properties(), first_inobject_offset, false,
+                    is_unboxed_double);
   DCHECK(result.GetLoadByFieldIndex() == orig_index);
   return result;
 }
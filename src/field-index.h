@@ -38,6 +38,12 @@ class FieldIndex FINAL {
     return IsDoubleBits::decode(bit_field_);
   }
 
+  // Double fields that are stored as raw values in the object itself rather
+  // than in a MutableHeapNumber box, see Map::unboxed_double_fields.
+  bool is_unboxed_double() const {
+    return IsUnboxedDoubleBits::decode(bit_field_);
+  }
+
   int offset() const {
     return index() * kPointerSize;
   }
@@ -67,16 +73,19 @@ class FieldIndex FINAL {
 
   int GetFieldAccessStubKey() const {
     return bit_field_ &
-        (IsInObjectBits::kMask | IsDoubleBits::kMask | IndexBits::kMask);
+        (IsInObjectBits::kMask | IsDoubleBits::kMask |
+         IsUnboxedDoubleBits::kMask | IndexBits::kMask);
   }
 
  private:
   FieldIndex(bool is_inobject, int local_index, bool is_double,
              int inobject_properties, int first_inobject_property_offset,
-             bool is_hidden = false) {
+             bool is_hidden = false, bool is_unboxed_double = false) {
     DCHECK((first_inobject_property_offset & (kPointerSize - 1)) == 0);
+    DCHECK(!is_unboxed_double || (is_inobject && is_double));
     bit_field_ = IsInObjectBits::encode(is_inobject) |
       IsDoubleBits::encode(is_double) |
+      IsUnboxedDoubleBits::encode(is_unboxed_double) |
       FirstInobjectPropertyOffsetBits::encode(first_inobject_property_offset) |
       IsHiddenField::encode(is_hidden) |
       IndexBits::encode(local_index) |
@@ -96,9 +105,12 @@ class FieldIndex FINAL {
   class IndexBits: public BitField<int, 0, kIndexBitsSize> {};
   class IsInObjectBits: public BitField<bool, IndexBits::kNext, 1> {};
   class IsDoubleBits: public BitField<bool, IsInObjectBits::kNext, 1> {};
+  class IsUnboxedDoubleBits
+      : public BitField<bool, IsDoubleBits::kNext, 1> {};
   // Number of inobject properties.
   class InObjectPropertyBits
-      : public BitField<int, IsDoubleBits::kNext, kDescriptorIndexBitCount> {};
+      : public BitField<int, IsUnboxedDoubleBits::kNext,
+                        kDescriptorIndexBitCount> {};
   // Offset of first inobject property from beginning of object.
   class FirstInobjectPropertyOffsetBits
       : public BitField<int, InObjectPropertyBits::kNext, 7> {};
@@ -162,6 +162,9 @@ DEFINE_BOOL(harmony_classes, false, "enable harmony classes")
 DEFINE_BOOL(harmony_object_literals, false,
             "enable harmony object literal extensions")
 DEFINE_BOOL(harmony_regexps, false, "enable regexp-related harmony features")
+DEFINE_BOOL(harmony_atomics, false,
+            "enable harmony SharedArrayBuffer and Atomics")
+DEFINE_BOOL(harmony_simd, false, "enable harmony SIMD value types")
 DEFINE_BOOL(harmony, false, "enable all harmony features (except proxies)")
 
 DEFINE_IMPLICATION(harmony, harmony_scoping)
@@ -191,6 +194,9 @@ DEFINE_BOOL(clever_optimizations, true,
 DEFINE_BOOL(pretenuring_call_new, false, "pretenure call new")
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(optimized_array_allocation_tracking, true,
+            "let arrays allocated by optimized code report elements kind "
+            "transitions to their allocation site")
 DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
@@ -205,6 +211,9 @@ DEFINE_IMPLICATION(track_computed_fields, track_fields)
 DEFINE_BOOL(track_field_types, true, "track field types")
 DEFINE_IMPLICATION(track_field_types, track_fields)
 DEFINE_IMPLICATION(track_field_types, track_heap_object_fields)
+DEFINE_BOOL(unbox_double_fields, false,
+            "enable in-object double fields unboxing (64-bit only)")
+DEFINE_IMPLICATION(unbox_double_fields, track_double_fields)
 DEFINE_BOOL(smi_binop, true, "support smi representation in binary operations")
 DEFINE_BOOL(vector_ics, false, "support vector-based ics")
 
@@ -253,6 +262,11 @@ DEFINE_BOOL(trace_inlining, false, "trace inlining decisions")
 DEFINE_BOOL(trace_load_elimination, false, "trace load elimination")
 DEFINE_BOOL(trace_store_elimination, false, "trace store elimination")
 DEFINE_BOOL(trace_alloc, false, "trace register allocator")
+DEFINE_BOOL(lithium_sparse_liveness, false,
+            "store sparse live-in sets in the lithium register allocator")
+DEFINE_INT(lithium_fast_allocation_threshold, 0,
+           "number of lithium instructions above which the register "
+           "allocator trades code quality for speed (0 means never)")
 DEFINE_BOOL(trace_all_uses, false, "trace all use positions")
 DEFINE_BOOL(trace_range, false, "trace range analysis")
 DEFINE_BOOL(trace_gvn, false, "trace global value numbering")
@@ -282,6 +296,9 @@ DEFINE_BOOL(array_bounds_checks_elimination, true,
 DEFINE_BOOL(trace_bce, false, "trace array bounds check elimination")
 DEFINE_BOOL(array_bounds_checks_hoisting, false,
             "perform array bounds checks hoisting")
+DEFINE_BOOL(array_bounds_checks_nested_hoisting, true,
+            "hoist bounds checks on outer * stride + inner indices out of "
+            "nested loops")
 DEFINE_BOOL(array_index_dehoisting, true, "perform array index dehoisting")
 DEFINE_BOOL(analyze_environment_liveness, true,
             "analyze liveness of environment slots and zap dead values")
@@ -303,10 +320,18 @@ DEFINE_BOOL(flush_optimized_code_cache, true,
 DEFINE_BOOL(inline_construct, true, "inline constructor calls")
 DEFINE_BOOL(inline_arguments, true, "inline functions with arguments object")
 DEFINE_BOOL(inline_accessors, true, "inline JavaScript accessors")
+DEFINE_BOOL(inline_call_function, true,
+            "inline known functions called through %_CallFunction")
+DEFINE_BOOL(inline_bound_function_calls, true,
+            "call the target of known bound functions directly")
+DEFINE_BOOL(fast_api_calls, true,
+            "call the fast call handlers of API functions directly")
 DEFINE_INT(escape_analysis_iterations, 2,
            "maximum number of escape analysis fix-point iterations")
 
 DEFINE_BOOL(optimize_for_in, true, "optimize functions containing for-in loops")
+DEFINE_BOOL(optimize_try_catch, false,
+            "optimize functions containing try-catch statements (x64 only)")
 
 DEFINE_BOOL(concurrent_recompilation, true,
             "optimizing hot functions asynchronously on a separate thread")
@@ -316,6 +341,9 @@ DEFINE_INT(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
+DEFINE_INT(concurrent_recompilation_tasks, 0,
+           "number of platform background tasks that run concurrent "
+           "recompilation jobs instead of a dedicated thread (0 = use thread)")
 DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
 DEFINE_BOOL(concurrent_osr, true, "concurrent on-stack replacement")
@@ -333,6 +361,9 @@ DEFINE_BOOL(trace_turbo_scheduler, false, "trace generated TurboFan scheduler")
 DEFINE_BOOL(turbo_asm, false, "enable TurboFan for asm.js code")
 DEFINE_BOOL(turbo_verify, false, "verify TurboFan graphs at each phase")
 DEFINE_BOOL(turbo_stats, false, "print TurboFan statistics")
+DEFINE_BOOL(log_turbo_phases, false,
+            "log the time and zone memory of the phases of every TurboFan "
+            "compilation, see tools/turbo-phases.py")
 DEFINE_BOOL(turbo_types, true, "use typed lowering in TurboFan")
 DEFINE_BOOL(turbo_source_positions, false,
             "track source code positions when building TurboFan IR")
@@ -340,9 +371,21 @@ DEFINE_BOOL(context_specialization, false,
             "enable context specialization in TurboFan")
 DEFINE_BOOL(turbo_deoptimization, false, "enable deoptimization in TurboFan")
 DEFINE_BOOL(turbo_inlining, false, "enable inlining in TurboFan")
+DEFINE_BOOL(turbo_osr, false, "enable on-stack replacement in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
 DEFINE_IMPLICATION(turbo_inlining, turbo_types)
 DEFINE_BOOL(turbo_profiling, false, "enable profiling in TurboFan")
+DEFINE_BOOL(turbo_load_elimination, false,
+            "eliminate redundant field loads and stores in TurboFan")
+DEFINE_BOOL(turbo_loop_peeling, false,
+            "peel the first iteration off innermost loops in TurboFan")
+DEFINE_BOOL(turbo_live_range_arrays, false,
+            "find split live ranges by binary search over sorted arrays in "
+            "the TurboFan register allocator")
+DEFINE_BOOL(turbo_jump_threading, true,
+            "thread jumps through empty blocks in TurboFan")
+DEFINE_BOOL(turbo_move_optimization, true,
+            "fold and merge the gap moves of the TurboFan register allocator")
 
 DEFINE_INT(typed_array_max_size_in_heap, 64,
            "threshold for in-heap typed array")
@@ -357,6 +400,15 @@ DEFINE_INT(type_info_threshold, 25,
 DEFINE_INT(generic_ic_threshold, 30,
            "max percentage of megamorphic/generic ICs to allow optimization")
 DEFINE_INT(self_opt_count, 130, "call count before self-optimization")
+DEFINE_BOOL(counter_based_tier_up, false,
+            "optimize functions based on their exact invocation and back edge "
+            "counts rather than on the profiler ticks")
+DEFINE_INT(tier_up_invocation_count, 1000,
+           "invocations before a function with stable type feedback is "
+           "optimized")
+DEFINE_INT(tier_up_back_edge_count, 10000,
+           "loop iterations before a function with stable type feedback is "
+           "optimized")
 
 DEFINE_BOOL(trace_opt_verbose, false, "extra verbose compilation tracing")
 DEFINE_IMPLICATION(trace_opt_verbose, trace_opt)
@@ -388,6 +440,9 @@ DEFINE_BOOL(enable_32dregs, ENABLE_32DREGS_DEFAULT,
             "enable use of d16-d31 registers on ARM - this requires VFP3")
 DEFINE_BOOL(enable_vldr_imm, false,
             "enable use of constant pools for double immediate (ARM only)")
+DEFINE_BOOL(enable_literal_moves, true,
+            "enable loading 64-bit immediates which need four move "
+            "instructions from the constant pool (ARM64 only)")
 DEFINE_BOOL(force_long_branches, false,
             "force all emitted branches to be in long mode (MIPS only)")
 
@@ -396,6 +451,10 @@ DEFINE_BOOL(enable_always_align_csp, true,
             "enable alignment of csp to 16 bytes on platforms which prefer "
             "the register to always be aligned (ARM64 only)")
 
+// api.cc
+DEFINE_INT(handle_block_pool_size, 4,
+           "maximum number of unused handle blocks kept for reuse")
+
 // bootstrapper.cc
 DEFINE_STRING(expose_natives_as, NULL, "expose natives in global object")
 DEFINE_STRING(expose_debug_as, NULL, "expose debug in global object")
@@ -424,6 +483,9 @@ DEFINE_BOOL(mask_constants_with_cookie, true,
 
 // codegen.cc
 DEFINE_BOOL(lazy, true, "use lazy compilation")
+DEFINE_BOOL(unary_function_hints, true,
+            "parse and compile function expressions preceded by a unary "
+            "operator (e.g. !function(){}()) eagerly")
 DEFINE_BOOL(trace_opt, false, "trace lazy optimization")
 DEFINE_BOOL(trace_opt_stats, false, "trace lazy optimization statistics")
 DEFINE_BOOL(opt, true, "use adaptive optimizations")
@@ -443,14 +505,30 @@ DEFINE_INT(min_preparse_length, 1024,
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
 
+// scopes.cc
+DEFINE_BOOL(stack_allocate_block_locals, false,
+            "allocate block scoped variables that are not captured by a "
+            "closure in the stack frame instead of a block context")
+
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
+DEFINE_BOOL(cache_scripts_across_contexts, false,
+            "share compiled scripts between native contexts")
+DEFINE_INT(regexp_cache_generations, 2,
+           "number of full gcs a regexp stays in the compilation cache without "
+           "being used")
+DEFINE_BOOL(cache_parser_data, true,
+            "reuse preparse data when the same script source is compiled "
+            "again, e.g. in another context")
 
 DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 
 // cpu-profiler.cc
 DEFINE_INT(cpu_profiler_sampling_interval, 1000,
            "CPU profiler sampling interval in microseconds")
+DEFINE_BOOL(cpu_profiler_cpu_time_sampling, false,
+            "take CPU profiler samples on the CPU time of the profiled "
+            "thread instead of signalling it at every interval (Linux only)")
 
 // debug.cc
 DEFINE_BOOL(trace_debug_json, false, "trace debugging JSON request/response")
@@ -463,6 +541,9 @@ DEFINE_BOOL(trace_array_abuse, false,
 DEFINE_IMPLICATION(trace_array_abuse, trace_js_array_abuse)
 DEFINE_IMPLICATION(trace_array_abuse, trace_external_array_abuse)
 DEFINE_BOOL(enable_liveedit, true, "enable liveedit experimental feature")
+DEFINE_BOOL(debug_targeted_break_points, false,
+            "only deoptimize functions with break points instead of all code "
+            "when setting break points")
 DEFINE_BOOL(hard_abort, true, "abort by crashing")
 
 // execution.cc
@@ -486,6 +567,8 @@ DEFINE_INT(max_semi_space_size, 0,
            "semi-spaces")
 DEFINE_INT(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_INT(max_executable_size, 0, "max size of executable memory (in Mbytes)")
+DEFINE_INT(zone_segment_pool_size, 0,
+           "max size of zone segments kept for reuse per isolate (in Kbytes)")
 DEFINE_BOOL(gc_global, false, "always perform global GCs")
 DEFINE_INT(gc_interval, -1, "garbage collect after <n> allocations")
 DEFINE_BOOL(trace_gc, false,
@@ -518,18 +601,57 @@ DEFINE_BOOL(flush_code, true,
             "flush code that we expect not to use again (during full gc)")
 DEFINE_BOOL(flush_code_incrementally, true,
             "flush code that we expect not to use again (incrementally)")
+DEFINE_BOOL(flush_regexp_code, true,
+            "flush regexp code that has not been used for a number of gcs")
 DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_BOOL(pre_age_code, false,
+            "emit code as not yet executed, so that code run only once is "
+            "flushed by the next full gcs (implied by --optimize-for-size)")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_BOOL(incremental_marking_steps, true, "do incremental marking steps")
+DEFINE_BOOL(black_allocation, false,
+            "allocate pointer-free old objects black during incremental "
+            "marking")
+DEFINE_BOOL(parallel_incremental_marking, false,
+            "use background tasks to speed up incremental marking steps")
+DEFINE_BOOL(parallel_scavenge, false,
+            "use background tasks to scan pages marked scan-on-scavenge for "
+            "pointers to new space")
+DEFINE_INT(parallel_scavenge_tasks, 0,
+           "number of background tasks for parallel scavenges "
+           "(0 means one less than the number of cores)")
+DEFINE_BOOL(promote_on_high_survival_rate, false,
+            "promote all survivors of a scavenge directly to old space if "
+            "nearly all of new space survived the previous scavenge")
+DEFINE_BOOL(incremental_large_object_gc, false,
+            "start incremental marking instead of a full GC when large object "
+            "allocations reach the old generation limit")
+DEFINE_BOOL(store_buffer_slot_sets, false,
+            "record old-to-new pointers in per-page slot sets instead of the "
+            "old store buffer")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "ask the OS to back old generation and code pages with "
+            "transparent huge pages")
+DEFINE_BOOL(discard_free_memory, false,
+            "give the physical pages under large free ranges found by the "
+            "sweeper back to the OS")
+DEFINE_BOOL(memory_reducer, false,
+            "use memory-reducing GCs to release committed memory once the "
+            "isolate has gone quiet")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
             "track object counts and memory usage")
 #ifdef VERIFY_HEAP
 DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
+DEFINE_BOOL(parallel_verify_heap, false,
+            "use background tasks to verify the pages of paged spaces")
+DEFINE_INT(verify_heap_sample_pages, 0,
+           "number of pages per paged space to verify at each heap "
+           "verification, rotating through the space (0 means all pages)")
 #endif
 
 
@@ -560,6 +682,18 @@ DEFINE_BOOL(incremental_code_compaction, true,
 DEFINE_BOOL(cleanup_code_caches_at_gc, true,
             "Flush inline caches prior to mark compact collection and "
             "flush code caches in maps during mark compact cycle.")
+DEFINE_BOOL(parallel_marking, false,
+            "use background tasks to mark live objects during the atomic "
+            "pause of full garbage collections")
+DEFINE_INT(parallel_marking_tasks, 0,
+           "number of background tasks for parallel marking "
+           "(0 means one less than the number of cores)")
+DEFINE_BOOL(parallel_pointer_update, false,
+            "use background tasks to update the slots recorded for evacuated "
+            "objects during compaction")
+DEFINE_INT(parallel_pointer_update_tasks, 0,
+           "number of background tasks for parallel pointer updating "
+           "(0 means one less than the number of cores)")
 DEFINE_BOOL(use_marking_progress_bar, true,
             "Use a progress bar to scan large objects in increments when "
             "incremental marking is active.")
@@ -619,6 +753,13 @@ DEFINE_BOOL(profile_deserialization, false,
 
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
+DEFINE_BOOL(regexp_nfa, false,
+            "match regexps without backreferences and lookaheads with a "
+            "non-backtracking engine")
+DEFINE_INT(regexp_backtrack_limit, 0,
+           "maximum number of backtracks in a regexp execution, after which "
+           "the non-backtracking engine is used or an exception is thrown "
+           "(0 for no limit)")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_BOOL(testing_bool_flag, true, "testing_bool_flag")
@@ -648,6 +789,9 @@ DEFINE_STRING(raw_context_file, NULL,
 DEFINE_STRING(startup_blob, NULL,
               "Write V8 startup blob file. "
               "(mksnapshot only)")
+DEFINE_BOOL(lazy_natives_in_snapshot, false,
+            "drop the code of natives functions compiled during bootstrapping "
+            "so that they are compiled on first use (mksnapshot only)")
 
 // code-stubs-hydrogen.cc
 DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
@@ -656,6 +800,13 @@ DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
 DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_osr)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_incremental_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
+DEFINE_NEG_IMPLICATION(predictable, parallel_pointer_update)
+#ifdef VERIFY_HEAP
+DEFINE_NEG_IMPLICATION(predictable, parallel_verify_heap)
+#endif
 
 
 //
@@ -664,6 +815,10 @@ DEFINE_NEG_IMPLICATION(predictable, concurrent_osr)
 
 DEFINE_BOOL(help, false, "Print usage message, including flags, on console")
 DEFINE_BOOL(dump_counters, false, "Dump counters on exit")
+DEFINE_BOOL(native_histograms, false,
+            "Record the histogram timers into built-in histograms")
+DEFINE_BOOL(runtime_call_stats, false,
+            "Count the calls into and time spent in runtime functions")
 
 DEFINE_BOOL(debugger, false, "Enable JavaScript debugger")
 
@@ -786,6 +941,9 @@ DEFINE_BOOL(prof_browser_mode, true,
             "Used with --prof, turns on browser-compatible mode for profiling.")
 DEFINE_BOOL(log_regexp, false, "Log regular expression execution.")
 DEFINE_STRING(logfile, "v8.log", "Specify the name of the log file.")
+DEFINE_BOOL(log_buffered, true,
+            "Buffer the log file instead of flushing it after every event. "
+            "It is flushed every second while profiling, and at exit.")
 DEFINE_BOOL(logfile_per_isolate, true, "Separate log files for each isolate.")
 DEFINE_BOOL(ll_prof, false, "Enable low-level linux profiler.")
 DEFINE_BOOL(perf_basic_prof, false,
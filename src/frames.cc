@@ -665,7 +665,16 @@ void StandardFrame::IterateCompiledFrame(ObjectVisitor* v) const {
   uint8_t* safepoint_bits = safepoint_entry.bits();
   safepoint_bits += kNumSafepointRegisters >> kBitsPerByteLog2;
 
-  // Visit the rest of the parameters.
+  // Visit the rest of the parameters. Optimized code that contains try-catch
+  // statements pushes its stack handlers in this area, which traverse their
+  // own pointers.
+  for (StackHandlerIterator it(this, top_handler()); !it.done(); it.Advance()) {
+    const Address address = it.handler()->address();
+    v->VisitPointers(parameters_base, reinterpret_cast<Object**>(address));
+    parameters_base =
+        reinterpret_cast<Object**>(address + StackHandlerConstants::kSize);
+    it.handler()->Iterate(v, code);
+  }
   v->VisitPointers(parameters_base, parameters_limit);
 
   // Visit pointer spill slots and locals.
@@ -711,9 +720,9 @@ int StubFrame::GetNumberOfIncomingArguments() const {
 
 void OptimizedFrame::Iterate(ObjectVisitor* v) const {
 #ifdef DEBUG
-  // Make sure that optimized frames do not contain any stack handlers.
+  // Make sure that only optimized try-catch statements push stack handlers.
   StackHandlerIterator it(this, top_handler());
-  DCHECK(it.done());
+  DCHECK(it.done() || FLAG_optimize_try_catch);
 #endif
 
   IterateCompiledFrame(v);
@@ -1510,19 +1519,31 @@ InnerPointerToCodeCache::InnerPointerToCodeCacheEntry*
       static_cast<uint32_t>(reinterpret_cast<uintptr_t>(inner_pointer)),
       v8::internal::kZeroHashSeed);
   uint32_t index = hash & (kInnerPointerToCodeCacheSize - 1);
-  InnerPointerToCodeCacheEntry* entry = cache(index);
-  if (entry->inner_pointer == inner_pointer) {
-    isolate_->counters()->pc_to_code_cached()->Increment();
-    DCHECK(entry->code == GcSafeFindCodeForInnerPointer(inner_pointer));
-  } else {
-    // Because this code may be interrupted by a profiling signal that
-    // also queries the cache, we cannot update inner_pointer before the code
-    // has been set. Otherwise, we risk trying to use a cache entry before
-    // the code has been computed.
-    entry->code = GcSafeFindCodeForInnerPointer(inner_pointer);
-    entry->safepoint_entry.Reset();
-    entry->inner_pointer = inner_pointer;
+  InnerPointerToCodeCacheEntry* set = cache(index);
+  for (int i = 0; i < kInnerPointerToCodeCacheWays; i++) {
+    InnerPointerToCodeCacheEntry* entry = &set[i];
+    if (entry->inner_pointer == inner_pointer) {
+      isolate_->counters()->pc_to_code_cached()->Increment();
+      DCHECK(entry->code == GcSafeFindCodeForInnerPointer(inner_pointer));
+      return entry;
+    }
   }
+
+  // Because this code may be interrupted by a profiling signal that also
+  // queries the cache, an entry is cleared before it is overwritten and its
+  // inner_pointer is only set once the rest has been filled in. Otherwise,
+  // we risk using an entry that mixes two inner pointers.
+  for (int i = kInnerPointerToCodeCacheWays - 1; i > 0; i--) {
+    set[i].inner_pointer = NULL;
+    set[i].code = set[i - 1].code;
+    set[i].safepoint_entry = set[i - 1].safepoint_entry;
+    set[i].inner_pointer = set[i - 1].inner_pointer;
+  }
+  InnerPointerToCodeCacheEntry* entry = &set[0];
+  entry->inner_pointer = NULL;
+  entry->code = GcSafeFindCodeForInnerPointer(inner_pointer);
+  entry->safepoint_entry.Reset();
+  entry->inner_pointer = inner_pointer;
   return entry;
 }
 
@@ -55,12 +55,17 @@ class InnerPointerToCodeCache {
   InnerPointerToCodeCacheEntry* GetCacheEntry(Address inner_pointer);
 
  private:
-  InnerPointerToCodeCacheEntry* cache(int index) { return &cache_[index]; }
+  InnerPointerToCodeCacheEntry* cache(int index) { return cache_[index]; }
 
   Isolate* isolate_;
 
+  // The cache is set associative. The entries of a set are ordered from the
+  // most recently filled one, which keeps the PCs of a deep recursion that
+  // collide on a set from evicting each other on every stack walk.
   static const int kInnerPointerToCodeCacheSize = 1024;
-  InnerPointerToCodeCacheEntry cache_[kInnerPointerToCodeCacheSize];
+  static const int kInnerPointerToCodeCacheWays = 2;
+  InnerPointerToCodeCacheEntry
+      cache_[kInnerPointerToCodeCacheSize][kInnerPointerToCodeCacheWays];
 
   DISALLOW_COPY_AND_ASSIGN(InnerPointerToCodeCache);
 };
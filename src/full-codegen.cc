@@ -337,6 +337,8 @@ bool FullCodeGenerator::MakeCode(CompilationInfo* info) {
   code->set_has_deoptimization_support(info->HasDeoptimizationSupport());
   code->set_handler_table(*cgen.handler_table());
   code->set_compiled_optimizable(info->IsOptimizable());
+  code->set_hot_in_previous_run(!info->shared_info().is_null() &&
+                                info->shared_info()->HasTieringHint());
   code->set_allow_osr_at_loop_nesting_level(0);
   code->set_profiler_ticks(0);
   code->set_back_edge_table_offset(table_offset);
@@ -1054,9 +1056,19 @@ void FullCodeGenerator::VisitBlock(Block* stmt) {
   SetStatementPosition(stmt);
 
   Scope* saved_scope = scope();
-  // Push a block context when entering a block with block scoped variables.
+  // Push a block context when entering a block with block scoped variables,
+  // unless all of them live in the stack frame.
+  bool needs_context =
+      stmt->scope() != NULL && stmt->scope()->num_heap_slots() > 0;
   if (stmt->scope() == NULL) {
     PrepareForBailoutForId(stmt->EntryId(), NO_REGISTERS);
+  } else if (!needs_context) {
+    scope_ = stmt->scope();
+    PrepareForBailoutForId(stmt->EntryId(), NO_REGISTERS);
+    { Comment cmnt(masm_, "[ Declarations");
+      VisitDeclarations(scope_->declarations());
+      PrepareForBailoutForId(stmt->DeclsId(), NO_REGISTERS);
+    }
   } else {
     scope_ = stmt->scope();
     DCHECK(!scope_->is_module_scope());
@@ -1081,7 +1093,7 @@ void FullCodeGenerator::VisitBlock(Block* stmt) {
   __ bind(nested_block.break_label());
 
   // Pop block context if necessary.
-  if (stmt->scope() != NULL) {
+  if (needs_context) {
     LoadContextField(context_register(), Context::PREVIOUS_INDEX);
     // Update local stack frame context field.
     StoreToFrameField(StandardFrameConstants::kContextOffset,
@@ -1379,6 +1391,8 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   __ jmp(&try_entry);
   __ bind(&handler_entry);
   handler_table()->set(stmt->index(), Smi::FromInt(handler_entry.pos()));
+  // Optimized code enters the catch block by deoptimizing to this point.
+  PrepareForBailoutForId(stmt->HandlerId(), TOS_REG);
   // Exception handler code, the exception is in the result register.
   // Extend the context before executing the catch block.
   { Comment cmnt(masm_, "[ Extend catch context");
@@ -1405,11 +1419,13 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   // Try block code. Sets up the exception handler chain.
   __ bind(&try_entry);
   __ PushTryHandler(StackHandler::CATCH, stmt->index());
+  PrepareForBailoutForId(stmt->TryId(), NO_REGISTERS);
   { TryCatch try_body(this);
     Visit(stmt->try_block());
   }
   __ PopTryHandler();
   __ bind(&exit);
+  PrepareForBailoutForId(stmt->ExitId(), NO_REGISTERS);
 }
 
 
@@ -1591,6 +1607,18 @@ void FullCodeGenerator::VisitThrow(Throw* expr) {
 }
 
 
+FullCodeGenerator::NestedStatement* FullCodeGenerator::NestedBlock::Exit(
+    int* stack_depth,
+    int* context_length) {
+  // Blocks whose variables all live in the stack frame push no context.
+  Scope* scope = statement()->AsBlock()->scope();
+  if (scope != NULL && scope->num_heap_slots() > 0) {
+    ++(*context_length);
+  }
+  return previous_;
+}
+
+
 FullCodeGenerator::NestedStatement* FullCodeGenerator::TryCatch::Exit(
     int* stack_depth,
     int* context_length) {
@@ -122,6 +122,14 @@ class FullCodeGenerator: public AstVisitor {
 #error Unsupported target architecture.
 #endif
 
+  // Whether the unoptimized code maintains the invocation and back edge
+  // counters of the type feedback vector for --counter-based-tier-up.
+#if V8_TARGET_ARCH_X64
+  static const bool kEmitsFeedbackVectorCounters = true;
+#else
+  static const bool kEmitsFeedbackVectorCounters = false;
+#endif
+
  private:
   class Breakable;
   class Iteration;
@@ -215,12 +223,7 @@ class FullCodeGenerator: public AstVisitor {
     }
     virtual ~NestedBlock() {}
 
-    virtual NestedStatement* Exit(int* stack_depth, int* context_length) {
-      if (statement()->AsBlock()->scope() != NULL) {
-        ++(*context_length);
-      }
-      return previous_;
-    }
+    virtual NestedStatement* Exit(int* stack_depth, int* context_length);
   };
 
   // The try block of a try/catch statement.
@@ -465,6 +468,7 @@ class FullCodeGenerator: public AstVisitor {
 
   void EmitProfilingCounterDecrement(int delta);
   void EmitProfilingCounterReset();
+  void EmitFeedbackVectorCounterIncrement(int index);
 
   // Emit code to pop values from the stack associated with nested statements
   // like try/catch, try/finally, etc, running the finallies and unwinding the
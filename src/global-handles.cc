@@ -36,6 +36,12 @@ class GlobalHandles::Node {
     NEAR_DEATH  // Callback has informed the handle is near death.
   };
 
+  enum WeaknessType {
+    NORMAL_WEAK,                    // Keeps the object alive for the callback.
+    PHANTOM_WEAK,                   // Cleared before the callback.
+    PHANTOM_WEAK_2_INTERNAL_FIELDS  // Also passes two internal fields.
+  };
+
   // Maps handle location (slot) to the containing node.
   static Node* FromLocation(Object** location) {
     DCHECK(OFFSET_OF(Node, object_) == 0);
@@ -87,6 +93,7 @@ class GlobalHandles::Node {
     set_independent(false);
     set_partially_dependent(false);
     set_state(NORMAL);
+    set_weakness_type(NORMAL_WEAK);
     parameter_or_next_free_.parameter = NULL;
     weak_callback_ = NULL;
     IncreaseBlockUses();
@@ -100,6 +107,7 @@ class GlobalHandles::Node {
     class_id_ = v8::HeapProfiler::kPersistentHandleNoClassId;
     set_independent(false);
     set_partially_dependent(false);
+    set_weakness_type(NORMAL_WEAK);
     weak_callback_ = NULL;
     DecreaseBlockUses();
   }
@@ -146,6 +154,17 @@ class GlobalHandles::Node {
     flags_ = IsInNewSpaceList::update(flags_, v);
   }
 
+  WeaknessType weakness_type() const {
+    return NodeWeaknessType::decode(flags_);
+  }
+  void set_weakness_type(WeaknessType weakness_type) {
+    flags_ = NodeWeaknessType::update(flags_, weakness_type);
+  }
+
+  bool IsPendingPhantom() const {
+    return state() == PENDING && weakness_type() != NORMAL_WEAK;
+  }
+
   bool IsNearDeath() const {
     // Check for PENDING to ensure correct answer when processing callbacks.
     return state() == PENDING || state() == NEAR_DEATH;
@@ -209,20 +228,42 @@ class GlobalHandles::Node {
     DCHECK(state() != FREE);
     CHECK(object_ != NULL);
     set_state(WEAK);
+    set_weakness_type(NORMAL_WEAK);
     set_parameter(parameter);
     weak_callback_ = weak_callback;
   }
 
+  void MakeWeak(void* parameter, PhantomCallback phantom_callback,
+                v8::WeakCallbackType type) {
+    DCHECK(phantom_callback != NULL);
+    DCHECK(state() != FREE);
+    CHECK(object_ != NULL);
+    set_state(WEAK);
+    set_weakness_type(type == v8::kWeakCallbackInternalFields
+                          ? PHANTOM_WEAK_2_INTERNAL_FIELDS
+                          : PHANTOM_WEAK);
+    set_parameter(parameter);
+    weak_callback_ = reinterpret_cast<WeakCallback>(phantom_callback);
+  }
+
   void* ClearWeakness() {
     DCHECK(state() != FREE);
     void* p = parameter();
     set_state(NORMAL);
+    set_weakness_type(NORMAL_WEAK);
     set_parameter(NULL);
     return p;
   }
 
+  // Called by the collector instead of visiting a pending phantom handle.
+  // Reads what the callback needs from the dying object and clears the
+  // handle.
+  void CollectPhantomCallbackData(
+      List<PendingPhantomCallback>* pending_phantom_callbacks);
+
   bool PostGarbageCollectionProcessing(Isolate* isolate) {
     if (state() != Node::PENDING) return false;
+    DCHECK(weakness_type() == NORMAL_WEAK);
     if (weak_callback_ == NULL) {
       Release();
       return false;
@@ -276,11 +317,12 @@ class GlobalHandles::Node {
   uint8_t index_;
 
   // This stores three flags (independent, partially_dependent and
-  // in_new_space_list) and a State.
-  class NodeState:            public BitField<State, 0, 4> {};
-  class IsIndependent:        public BitField<bool,  4, 1> {};
-  class IsPartiallyDependent: public BitField<bool,  5, 1> {};
-  class IsInNewSpaceList:     public BitField<bool,  6, 1> {};
+  // in_new_space_list), a State and a WeaknessType.
+  class NodeState:            public BitField<State, 0, 3> {};
+  class IsIndependent:        public BitField<bool,  3, 1> {};
+  class IsPartiallyDependent: public BitField<bool,  4, 1> {};
+  class IsInNewSpaceList:     public BitField<bool,  5, 1> {};
+  class NodeWeaknessType:     public BitField<WeaknessType, 6, 2> {};
 
   uint8_t flags_;
 
@@ -362,6 +404,97 @@ class GlobalHandles::NodeBlock {
 };
 
 
+// The callback of a phantom handle and its arguments, which survive the
+// object they were collected from.
+class GlobalHandles::PendingPhantomCallback {
+ public:
+  typedef v8::WeakCallbackInfo<void> Data;
+
+  PendingPhantomCallback(Node* node, Data::Callback callback, void* parameter,
+                         void** internal_fields)
+      : node_(node), callback_(callback), parameter_(parameter) {
+    for (int i = 0; i < v8::kInternalFieldsInWeakCallback; i++) {
+      internal_fields_[i] = internal_fields[i];
+    }
+  }
+
+  // Calls the first pass, or the second pass once the node is gone.  After
+  // the first pass, callback() is the requested second pass, if any.
+  void Invoke(Isolate* isolate);
+
+  Data::Callback callback() const { return callback_; }
+
+ private:
+  Node* node_;
+  Data::Callback callback_;
+  void* parameter_;
+  void* internal_fields_[v8::kInternalFieldsInWeakCallback];
+};
+
+
+void GlobalHandles::PendingPhantomCallback::Invoke(Isolate* isolate) {
+  Data::Callback* second_pass = node_ != NULL ? &callback_ : NULL;
+  Data data(reinterpret_cast<v8::Isolate*>(isolate), parameter_,
+            internal_fields_, second_pass);
+  Data::Callback callback = callback_;
+  callback_ = NULL;
+  callback(data);
+  if (node_ != NULL) {
+    // Phantom handles cannot be revived, the first pass must reset them.
+    CHECK(node_->state() == Node::FREE);
+    node_ = NULL;
+  }
+}
+
+
+void GlobalHandles::Node::CollectPhantomCallbackData(
+    List<PendingPhantomCallback>* pending_phantom_callbacks) {
+  DCHECK(IsPendingPhantom());
+  void* internal_fields[v8::kInternalFieldsInWeakCallback] = {NULL, NULL};
+  if (weakness_type() == PHANTOM_WEAK_2_INTERNAL_FIELDS &&
+      object_->IsJSObject()) {
+    JSObject* object = JSObject::cast(object_);
+    int field_count = object->GetInternalFieldCount();
+    for (int i = 0; i < v8::kInternalFieldsInWeakCallback; i++) {
+      if (i == field_count) break;
+      // Aligned pointers are stored as they are and look like Smis.
+      Object* field = object->GetInternalField(i);
+      if (field->IsSmi()) internal_fields[i] = reinterpret_cast<void*>(field);
+    }
+  }
+  pending_phantom_callbacks->Add(PendingPhantomCallback(
+      this, reinterpret_cast<PhantomCallback>(weak_callback_), parameter(),
+      internal_fields));
+  set_state(NEAR_DEATH);
+  // Nothing may see the dead object through this handle anymore.
+  object_ = Smi::FromInt(0);
+}
+
+
+// Runs the second passes of phantom callbacks after the garbage collection.
+// The task is owned by the platform and may outlive the global handles, in
+// which case it does nothing.
+class GlobalHandles::PendingPhantomCallbacksSecondPassTask : public v8::Task {
+ public:
+  explicit PendingPhantomCallbacksSecondPassTask(GlobalHandles* global_handles)
+      : global_handles_(global_handles), torn_down_(false) {}
+
+  void NotifyTearDown() { torn_down_ = true; }
+
+  virtual void Run() OVERRIDE {
+    if (torn_down_) return;
+    global_handles_->second_pass_callbacks_task_ = NULL;
+    global_handles_->InvokeSecondPassPhantomCallbacks();
+  }
+
+ private:
+  GlobalHandles* global_handles_;
+  bool torn_down_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingPhantomCallbacksSecondPassTask);
+};
+
+
 GlobalHandles* GlobalHandles::Node::GetGlobalHandles() {
   return FindBlock()->global_handles();
 }
@@ -431,6 +564,7 @@ GlobalHandles::GlobalHandles(Isolate* isolate)
       first_used_block_(NULL),
       first_free_(NULL),
       post_gc_processing_count_(0),
+      second_pass_callbacks_task_(NULL),
       object_group_connections_(kObjectGroupConnectionsCapacity) {}
 
 
@@ -482,6 +616,13 @@ void GlobalHandles::MakeWeak(Object** location,
 }
 
 
+void GlobalHandles::MakeWeak(Object** location, void* parameter,
+                             PhantomCallback phantom_callback,
+                             v8::WeakCallbackType type) {
+  Node::FromLocation(location)->MakeWeak(parameter, phantom_callback, type);
+}
+
+
 void* GlobalHandles::ClearWeakness(Object** location) {
   return Node::FromLocation(location)->ClearWeakness();
 }
@@ -514,7 +655,14 @@ bool GlobalHandles::IsWeak(Object** location) {
 
 void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
   for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeakRetainer()) v->VisitPointer(it.node()->location());
+    Node* node = it.node();
+    if (!node->IsWeakRetainer()) continue;
+    // Phantom handles do not keep their objects alive.
+    if (node->IsPendingPhantom()) {
+      node->CollectPhantomCallbackData(&pending_phantom_callbacks_);
+    } else {
+      v->VisitPointer(node->location());
+    }
   }
 }
 
@@ -559,7 +707,11 @@ void GlobalHandles::IterateNewSpaceWeakIndependentRoots(ObjectVisitor* v) {
     DCHECK(node->is_in_new_space_list());
     if ((node->is_independent() || node->is_partially_dependent()) &&
         node->IsWeakRetainer()) {
-      v->VisitPointer(node->location());
+      if (node->IsPendingPhantom()) {
+        node->CollectPhantomCallbackData(&pending_phantom_callbacks_);
+      } else {
+        v->VisitPointer(node->location());
+      }
     }
   }
 }
@@ -611,14 +763,57 @@ bool GlobalHandles::IterateObjectGroups(ObjectVisitor* v,
 }
 
 
+int GlobalHandles::DispatchPendingPhantomCallbacks(
+    bool synchronous_second_pass) {
+  int freed_nodes = 0;
+  {
+    // The first passes only reset the handles and may not call into V8.
+    DisallowHeapAllocation no_allocation;
+    VMState<EXTERNAL> state(isolate_);
+    for (int i = 0; i < pending_phantom_callbacks_.length(); i++) {
+      PendingPhantomCallback* callback = &pending_phantom_callbacks_[i];
+      callback->Invoke(isolate_);
+      if (callback->callback() != NULL) second_pass_callbacks_.Add(*callback);
+      freed_nodes++;
+    }
+    pending_phantom_callbacks_.Rewind(0);
+  }
+  if (second_pass_callbacks_.is_empty()) return freed_nodes;
+  if (synchronous_second_pass) {
+    InvokeSecondPassPhantomCallbacks();
+  } else if (second_pass_callbacks_task_ == NULL) {
+    second_pass_callbacks_task_ =
+        new PendingPhantomCallbacksSecondPassTask(this);
+    V8::GetCurrentPlatform()->CallOnForegroundThread(
+        reinterpret_cast<v8::Isolate*>(isolate_), second_pass_callbacks_task_);
+  }
+  return freed_nodes;
+}
+
+
+void GlobalHandles::InvokeSecondPassPhantomCallbacks() {
+  VMState<EXTERNAL> state(isolate_);
+  HandleScope handle_scope(isolate_);
+  // The callbacks may trigger collections that add more second passes.
+  while (!second_pass_callbacks_.is_empty()) {
+    PendingPhantomCallback callback = second_pass_callbacks_.RemoveLast();
+    callback.Invoke(isolate_);
+  }
+}
+
+
 int GlobalHandles::PostGarbageCollectionProcessing(
-    GarbageCollector collector) {
+    GarbageCollector collector, const v8::GCCallbackFlags gc_callback_flags) {
   // Process weak global handle callbacks. This must be done after the
   // GC is completely done, because the callbacks may invoke arbitrary
   // API functions.
   DCHECK(isolate_->heap()->gc_state() == Heap::NOT_IN_GC);
+  bool synchronous_second_pass =
+      (gc_callback_flags &
+       (kGCCallbackFlagForced |
+        kGCCallbackFlagSynchronousPhantomCallbackProcessing)) != 0;
+  int freed_nodes = DispatchPendingPhantomCallbacks(synchronous_second_pass);
   const int initial_post_gc_processing_count = ++post_gc_processing_count_;
-  int freed_nodes = 0;
   if (collector == SCAVENGER) {
     for (int i = 0; i < new_space_nodes_.length(); ++i) {
       Node* node = new_space_nodes_[i];
@@ -882,6 +1077,10 @@ void GlobalHandles::RemoveImplicitRefGroups() {
 
 void GlobalHandles::TearDown() {
   // TODO(1428): invoke weak callbacks.
+  if (second_pass_callbacks_task_ != NULL) {
+    second_pass_callbacks_task_->NotifyTearDown();
+    second_pass_callbacks_task_ = NULL;
+  }
 }
 
 
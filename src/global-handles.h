@@ -122,6 +122,17 @@ class GlobalHandles {
                        void* parameter,
                        WeakCallback weak_callback);
 
+  typedef v8::WeakCallbackInfo<void>::Callback PhantomCallback;
+
+  // Make the global handle a phantom handle.  Unlike for regular weak
+  // handles, the collector clears the handle as soon as it finds the object
+  // dead, without keeping it alive for the callback.  The callbacks of all
+  // phantom handles that died in a collection are then dispatched in one
+  // batch, see DispatchPendingPhantomCallbacks.
+  static void MakeWeak(Object** location, void* parameter,
+                       PhantomCallback phantom_callback,
+                       v8::WeakCallbackType type);
+
   void RecordStats(HeapStats* stats);
 
   // Returns the current number of weak handles.
@@ -155,7 +166,8 @@ class GlobalHandles {
 
   // Process pending weak handles.
   // Returns the number of freed nodes.
-  int PostGarbageCollectionProcessing(GarbageCollector collector);
+  int PostGarbageCollectionProcessing(
+      GarbageCollector collector, const v8::GCCallbackFlags gc_callback_flags);
 
   // Iterates over all strong handles.
   void IterateStrongRoots(ObjectVisitor* v);
@@ -265,6 +277,16 @@ class GlobalHandles {
   class Node;
   class NodeBlock;
   class NodeIterator;
+  class PendingPhantomCallback;
+  class PendingPhantomCallbacksSecondPassTask;
+
+  // Calls the first pass of the callbacks of the phantom handles that died
+  // in the last collection and runs or schedules the second passes.
+  // Returns the number of freed nodes.
+  int DispatchPendingPhantomCallbacks(bool synchronous_second_pass);
+
+  // Runs the second passes that the phantom callbacks asked for.
+  void InvokeSecondPassPhantomCallbacks();
 
   Isolate* isolate_;
 
@@ -286,6 +308,12 @@ class GlobalHandles {
 
   int post_gc_processing_count_;
 
+  // Phantom callbacks collected during the current collection, and those
+  // which asked for a second pass that did not run yet.
+  List<PendingPhantomCallback> pending_phantom_callbacks_;
+  List<PendingPhantomCallback> second_pass_callbacks_;
+  PendingPhantomCallbacksSecondPassTask* second_pass_callbacks_task_;
+
   // Object groups and implicit references, public and more efficient
   // representation.
   List<ObjectGroup*> object_groups_;
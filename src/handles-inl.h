@@ -161,8 +161,8 @@ inline SealHandleScope::SealHandleScope(Isolate* isolate) : isolate_(isolate) {
   // handle allocations without an explicit handle scope.
   limit_ = current->limit;
   current->limit = current->next;
-  level_ = current->level;
-  current->level = 0;
+  sealed_level_ = current->sealed_level;
+  current->sealed_level = current->level;
 }
 
 
@@ -170,10 +170,9 @@ inline SealHandleScope::~SealHandleScope() {
   // Restore state in current handle scope to re-enable handle
   // allocations.
   HandleScopeData* current = isolate_->handle_scope_data();
-  DCHECK_EQ(0, current->level);
-  current->level = level_;
   DCHECK_EQ(current->next, current->limit);
   current->limit = limit_;
+  current->sealed_level = sealed_level_;
 }
 
 #endif
@@ -26,8 +26,8 @@ Object** HandleScope::Extend(Isolate* isolate) {
 
   DCHECK(result == current->limit);
   // Make sure there's at least one scope on the stack and that the
-  // top of the scope stack isn't a barrier.
-  if (!Utils::ApiCheck(current->level != 0,
+  // top of the scope stack isn't sealed.
+  if (!Utils::ApiCheck(current->level != current->sealed_level,
                        "v8::HandleScope::CreateHandle()",
                        "Cannot create a handle without a HandleScope")) {
     return NULL;
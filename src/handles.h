@@ -278,18 +278,24 @@ class SealHandleScope BASE_EMBEDDED {
  private:
   Isolate* isolate_;
   Object** limit_;
-  int level_;
+  int sealed_level_;
 #endif
 };
 
+// The layout of the fields up to and including sealed_level is mirrored by
+// v8::internal::Internals (in include/v8.h), which creates local handles
+// inline.
 struct HandleScopeData {
   internal::Object** next;
   internal::Object** limit;
   int level;
+  // Handles cannot be created while level equals sealed_level, see
+  // SealHandleScope.
+  int sealed_level;
 
   void Initialize() {
     next = limit = NULL;
-    level = 0;
+    sealed_level = level = 0;
   }
 };
 
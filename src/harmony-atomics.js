@@ -0,0 +1,189 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+'use strict';
+
+// This file relies on the fact that the following declaration has been made
+// in runtime.js:
+// var $Object = global.Object;
+
+var $SharedArrayBuffer = global.SharedArrayBuffer;
+
+// -------------------------------------------------------------------
+
+function SharedArrayBufferConstructor(length) { // length = 1
+  if (%_IsConstructCall()) {
+    var byteLength = ToPositiveInteger(length, 'invalid_array_buffer_length');
+    %SharedArrayBufferInitialize(this, byteLength);
+  } else {
+    throw MakeTypeError('constructor_not_function', ["SharedArrayBuffer"]);
+  }
+}
+
+function SharedArrayBufferGetByteLen() {
+  if (!IS_SHAREDARRAYBUFFER(this)) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ['SharedArrayBuffer.prototype.byteLength', this]);
+  }
+  return %_ArrayBufferGetByteLength(this);
+}
+
+// -------------------------------------------------------------------
+
+// Instance class name can only be set on functions. That is the only
+// purpose for AtomicsConstructor.
+function AtomicsConstructor() {}
+var $Atomics = new AtomicsConstructor();
+
+// The operations work on the 32-bit integer views of shared buffers only.
+function CheckSharedInt32TypedArray(ia) {
+  var klass = %_ClassOf(ia);
+  if ((klass !== 'Int32Array' && klass !== 'Uint32Array') ||
+      !IS_SHAREDARRAYBUFFER(%_TypedArrayGetBuffer(ia))) {
+    throw MakeTypeError('atomics_not_shared_int32_array', [ia]);
+  }
+}
+
+function ToAtomicIndex(ia, index) {
+  var accessIndex = TO_INTEGER(index);
+  if (accessIndex < 0 || accessIndex >= %_TypedArrayGetLength(ia)) {
+    throw MakeRangeError('invalid_atomic_access_index', []);
+  }
+  return accessIndex;
+}
+
+function AtomicsLoadJS(ia, index) {
+  CheckSharedInt32TypedArray(ia);
+  return %AtomicsLoad(ia, ToAtomicIndex(ia, index));
+}
+
+function AtomicsStoreJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  value = TO_INTEGER(value);
+  %AtomicsStore(ia, index, value);
+  return value;
+}
+
+function AtomicsAddJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsAdd(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsSubJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsSub(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsAndJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsAnd(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsOrJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsOr(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsXorJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsXor(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsExchangeJS(ia, index, value) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  return %AtomicsExchange(ia, index, TO_INTEGER(value));
+}
+
+function AtomicsCompareExchangeJS(ia, index, expected, replacement) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  expected = TO_INTEGER(expected);
+  replacement = TO_INTEGER(replacement);
+  return %AtomicsCompareExchange(ia, index, expected, replacement);
+}
+
+// Blocks until Atomics.wake is called for the same element or |timeout|
+// milliseconds have passed, if the element still holds |value|.
+function AtomicsWaitJS(ia, index, value, timeout) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  value = TO_INTEGER(value);
+  if (IS_UNDEFINED(timeout)) {
+    timeout = INFINITY;
+  } else {
+    timeout = TO_NUMBER_INLINE(timeout);
+    if (NUMBER_IS_NAN(timeout)) {
+      timeout = INFINITY;
+    } else if (timeout < 0) {
+      timeout = 0;
+    }
+  }
+  return %AtomicsWait(ia, index, value, timeout);
+}
+
+function AtomicsWakeJS(ia, index, count) {
+  CheckSharedInt32TypedArray(ia);
+  index = ToAtomicIndex(ia, index);
+  count = IS_UNDEFINED(count) ? INFINITY : MathMax(0, TO_INTEGER(count));
+  return %AtomicsWake(ia, index, count);
+}
+
+// -------------------------------------------------------------------
+
+function SetUpSharedArrayBuffer() {
+  %CheckIsBootstrapping();
+
+  // Set up the SharedArrayBuffer constructor function.
+  %SetCode($SharedArrayBuffer, SharedArrayBufferConstructor);
+  %FunctionSetPrototype($SharedArrayBuffer, new $Object());
+
+  // Set up the constructor property on the SharedArrayBuffer prototype
+  // object.
+  %AddNamedProperty($SharedArrayBuffer.prototype, "constructor",
+                    $SharedArrayBuffer, DONT_ENUM);
+
+  InstallGetter($SharedArrayBuffer.prototype, "byteLength",
+                SharedArrayBufferGetByteLen);
+}
+
+SetUpSharedArrayBuffer();
+
+
+function SetUpAtomics() {
+  %CheckIsBootstrapping();
+
+  %InternalSetPrototype($Atomics, $Object.prototype);
+  %AddNamedProperty(global, "Atomics", $Atomics, DONT_ENUM);
+  %FunctionSetInstanceClassName(AtomicsConstructor, 'Atomics');
+
+  // The results of Atomics.wait.
+  InstallConstants($Atomics, $Array(
+    "OK", 0,
+    "NOTEQUAL", -1,
+    "TIMEDOUT", -2
+  ));
+
+  InstallFunctions($Atomics, DONT_ENUM, $Array(
+    "load", AtomicsLoadJS,
+    "store", AtomicsStoreJS,
+    "add", AtomicsAddJS,
+    "sub", AtomicsSubJS,
+    "and", AtomicsAndJS,
+    "or", AtomicsOrJS,
+    "xor", AtomicsXorJS,
+    "exchange", AtomicsExchangeJS,
+    "compareExchange", AtomicsCompareExchangeJS,
+    "wait", AtomicsWaitJS,
+    "wake", AtomicsWakeJS
+  ));
+}
+
+SetUpAtomics();
@@ -0,0 +1,483 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+'use strict';
+
+// This file relies on the fact that the following declaration has been made
+// in runtime.js:
+// var $Object = global.Object;
+
+var $SIMD = global.SIMD;
+var $Float32x4 = $SIMD.Float32x4;
+var $Int32x4 = $SIMD.Int32x4;
+var $Float64x2 = $SIMD.Float64x2;
+
+// -------------------------------------------------------------------
+
+function CheckFloat32x4(value) {
+  if (!IS_FLOAT32X4(value)) {
+    throw MakeTypeError('simd_wrong_type', [value, "Float32x4"]);
+  }
+}
+
+function CheckInt32x4(value) {
+  if (!IS_INT32X4(value)) {
+    throw MakeTypeError('simd_wrong_type', [value, "Int32x4"]);
+  }
+}
+
+function CheckFloat64x2(value) {
+  if (!IS_FLOAT64X2(value)) {
+    throw MakeTypeError('simd_wrong_type', [value, "Float64x2"]);
+  }
+}
+
+function ToSimdLane(lane, laneCount) {
+  if (!IS_NUMBER(lane) || lane !== TO_INTEGER(lane) ||
+      lane < 0 || lane >= laneCount) {
+    throw MakeRangeError('invalid_simd_lane', []);
+  }
+  return lane;
+}
+
+// The bounds are checked by the runtime functions, which know the element
+// size of the typed array.
+function CheckSimdTypedArray(tarray) {
+  if (!%ArrayBufferIsView(tarray) || IS_DATAVIEW(tarray)) {
+    throw MakeTypeError('not_typed_array', []);
+  }
+}
+
+function SimdToString(prefix, lanes) {
+  return prefix + "(" + %_CallFunction(lanes, ", ", ArrayJoin) + ")";
+}
+
+// -------------------------------------------------------------------
+// Float32x4
+
+function Float32x4Constructor(x, y, z, w) {
+  if (%_IsConstructCall()) {
+    throw MakeTypeError('not_constructor', ["Float32x4"]);
+  }
+  return %CreateFloat32x4(TO_NUMBER_INLINE(x), TO_NUMBER_INLINE(y),
+                          TO_NUMBER_INLINE(z), TO_NUMBER_INLINE(w));
+}
+
+function Float32x4Check(a) {
+  CheckFloat32x4(a);
+  return a;
+}
+
+function Float32x4Splat(s) {
+  s = TO_NUMBER_INLINE(s);
+  return %CreateFloat32x4(s, s, s, s);
+}
+
+function Float32x4ExtractLaneJS(a, lane) {
+  CheckFloat32x4(a);
+  return %Float32x4ExtractLane(a, ToSimdLane(lane, 4));
+}
+
+function Float32x4ReplaceLaneJS(a, lane, value) {
+  CheckFloat32x4(a);
+  lane = ToSimdLane(lane, 4);
+  return %Float32x4ReplaceLane(a, lane, TO_NUMBER_INLINE(value));
+}
+
+function Float32x4AddJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Add(a, b);
+}
+
+function Float32x4SubJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Sub(a, b);
+}
+
+function Float32x4MulJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Mul(a, b);
+}
+
+function Float32x4DivJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Div(a, b);
+}
+
+function Float32x4MinJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Min(a, b);
+}
+
+function Float32x4MaxJS(a, b) {
+  CheckFloat32x4(a);
+  CheckFloat32x4(b);
+  return %Float32x4Max(a, b);
+}
+
+function Float32x4NegJS(a) {
+  CheckFloat32x4(a);
+  return %Float32x4Neg(a);
+}
+
+function Float32x4AbsJS(a) {
+  CheckFloat32x4(a);
+  return %Float32x4Abs(a);
+}
+
+function Float32x4SqrtJS(a) {
+  CheckFloat32x4(a);
+  return %Float32x4Sqrt(a);
+}
+
+function Float32x4FromInt32x4JS(a) {
+  CheckInt32x4(a);
+  return %Float32x4FromInt32x4(a);
+}
+
+function Float32x4LoadJS(tarray, index) {
+  CheckSimdTypedArray(tarray);
+  return %Float32x4Load(tarray, TO_INTEGER(index));
+}
+
+function Float32x4StoreJS(tarray, index, value) {
+  CheckSimdTypedArray(tarray);
+  index = TO_INTEGER(index);
+  CheckFloat32x4(value);
+  return %Float32x4Store(tarray, index, value);
+}
+
+function Float32x4ToString() {
+  if (!(IS_FLOAT32X4(this) || IS_FLOAT32X4_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Float32x4.prototype.toString", this]);
+  }
+  var value = %_ValueOf(this);
+  return SimdToString("Float32x4", [
+      %Float32x4ExtractLane(value, 0), %Float32x4ExtractLane(value, 1),
+      %Float32x4ExtractLane(value, 2), %Float32x4ExtractLane(value, 3)]);
+}
+
+function Float32x4ValueOf() {
+  if (!(IS_FLOAT32X4(this) || IS_FLOAT32X4_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Float32x4.prototype.valueOf", this]);
+  }
+  return %_ValueOf(this);
+}
+
+// -------------------------------------------------------------------
+// Int32x4
+
+function Int32x4Constructor(x, y, z, w) {
+  if (%_IsConstructCall()) {
+    throw MakeTypeError('not_constructor', ["Int32x4"]);
+  }
+  return %CreateInt32x4(TO_NUMBER_INLINE(x), TO_NUMBER_INLINE(y),
+                        TO_NUMBER_INLINE(z), TO_NUMBER_INLINE(w));
+}
+
+function Int32x4Check(a) {
+  CheckInt32x4(a);
+  return a;
+}
+
+function Int32x4Splat(s) {
+  s = TO_NUMBER_INLINE(s);
+  return %CreateInt32x4(s, s, s, s);
+}
+
+function Int32x4ExtractLaneJS(a, lane) {
+  CheckInt32x4(a);
+  return %Int32x4ExtractLane(a, ToSimdLane(lane, 4));
+}
+
+function Int32x4ReplaceLaneJS(a, lane, value) {
+  CheckInt32x4(a);
+  lane = ToSimdLane(lane, 4);
+  return %Int32x4ReplaceLane(a, lane, TO_NUMBER_INLINE(value));
+}
+
+function Int32x4AddJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4Add(a, b);
+}
+
+function Int32x4SubJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4Sub(a, b);
+}
+
+function Int32x4MulJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4Mul(a, b);
+}
+
+function Int32x4AndJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4And(a, b);
+}
+
+function Int32x4OrJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4Or(a, b);
+}
+
+function Int32x4XorJS(a, b) {
+  CheckInt32x4(a);
+  CheckInt32x4(b);
+  return %Int32x4Xor(a, b);
+}
+
+function Int32x4NegJS(a) {
+  CheckInt32x4(a);
+  return %Int32x4Neg(a);
+}
+
+function Int32x4NotJS(a) {
+  CheckInt32x4(a);
+  return %Int32x4Not(a);
+}
+
+function Int32x4FromFloat32x4JS(a) {
+  CheckFloat32x4(a);
+  return %Int32x4FromFloat32x4(a);
+}
+
+function Int32x4LoadJS(tarray, index) {
+  CheckSimdTypedArray(tarray);
+  return %Int32x4Load(tarray, TO_INTEGER(index));
+}
+
+function Int32x4StoreJS(tarray, index, value) {
+  CheckSimdTypedArray(tarray);
+  index = TO_INTEGER(index);
+  CheckInt32x4(value);
+  return %Int32x4Store(tarray, index, value);
+}
+
+function Int32x4ToString() {
+  if (!(IS_INT32X4(this) || IS_INT32X4_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Int32x4.prototype.toString", this]);
+  }
+  var value = %_ValueOf(this);
+  return SimdToString("Int32x4", [
+      %Int32x4ExtractLane(value, 0), %Int32x4ExtractLane(value, 1),
+      %Int32x4ExtractLane(value, 2), %Int32x4ExtractLane(value, 3)]);
+}
+
+function Int32x4ValueOf() {
+  if (!(IS_INT32X4(this) || IS_INT32X4_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Int32x4.prototype.valueOf", this]);
+  }
+  return %_ValueOf(this);
+}
+
+// -------------------------------------------------------------------
+// Float64x2
+
+function Float64x2Constructor(x, y) {
+  if (%_IsConstructCall()) {
+    throw MakeTypeError('not_constructor', ["Float64x2"]);
+  }
+  return %CreateFloat64x2(TO_NUMBER_INLINE(x), TO_NUMBER_INLINE(y));
+}
+
+function Float64x2Check(a) {
+  CheckFloat64x2(a);
+  return a;
+}
+
+function Float64x2Splat(s) {
+  s = TO_NUMBER_INLINE(s);
+  return %CreateFloat64x2(s, s);
+}
+
+function Float64x2ExtractLaneJS(a, lane) {
+  CheckFloat64x2(a);
+  return %Float64x2ExtractLane(a, ToSimdLane(lane, 2));
+}
+
+function Float64x2ReplaceLaneJS(a, lane, value) {
+  CheckFloat64x2(a);
+  lane = ToSimdLane(lane, 2);
+  return %Float64x2ReplaceLane(a, lane, TO_NUMBER_INLINE(value));
+}
+
+function Float64x2AddJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Add(a, b);
+}
+
+function Float64x2SubJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Sub(a, b);
+}
+
+function Float64x2MulJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Mul(a, b);
+}
+
+function Float64x2DivJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Div(a, b);
+}
+
+function Float64x2MinJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Min(a, b);
+}
+
+function Float64x2MaxJS(a, b) {
+  CheckFloat64x2(a);
+  CheckFloat64x2(b);
+  return %Float64x2Max(a, b);
+}
+
+function Float64x2NegJS(a) {
+  CheckFloat64x2(a);
+  return %Float64x2Neg(a);
+}
+
+function Float64x2AbsJS(a) {
+  CheckFloat64x2(a);
+  return %Float64x2Abs(a);
+}
+
+function Float64x2SqrtJS(a) {
+  CheckFloat64x2(a);
+  return %Float64x2Sqrt(a);
+}
+
+function Float64x2LoadJS(tarray, index) {
+  CheckSimdTypedArray(tarray);
+  return %Float64x2Load(tarray, TO_INTEGER(index));
+}
+
+function Float64x2StoreJS(tarray, index, value) {
+  CheckSimdTypedArray(tarray);
+  index = TO_INTEGER(index);
+  CheckFloat64x2(value);
+  return %Float64x2Store(tarray, index, value);
+}
+
+function Float64x2ToString() {
+  if (!(IS_FLOAT64X2(this) || IS_FLOAT64X2_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Float64x2.prototype.toString", this]);
+  }
+  var value = %_ValueOf(this);
+  return SimdToString("Float64x2", [
+      %Float64x2ExtractLane(value, 0), %Float64x2ExtractLane(value, 1)]);
+}
+
+function Float64x2ValueOf() {
+  if (!(IS_FLOAT64X2(this) || IS_FLOAT64X2_WRAPPER(this))) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ["Float64x2.prototype.valueOf", this]);
+  }
+  return %_ValueOf(this);
+}
+
+// -------------------------------------------------------------------
+
+function SetUpSimdType(constructor, code, prototype_functions) {
+  %SetCode(constructor, code);
+  %FunctionSetPrototype(constructor, new $Object());
+  %AddNamedProperty(constructor.prototype, "constructor", constructor,
+                    DONT_ENUM);
+  InstallFunctions(constructor.prototype, DONT_ENUM, prototype_functions);
+}
+
+
+function SetUpSIMD() {
+  %CheckIsBootstrapping();
+
+  SetUpSimdType($Float32x4, Float32x4Constructor, $Array(
+    "toString", Float32x4ToString,
+    "valueOf", Float32x4ValueOf
+  ));
+  InstallFunctions($Float32x4, DONT_ENUM, $Array(
+    "check", Float32x4Check,
+    "splat", Float32x4Splat,
+    "extractLane", Float32x4ExtractLaneJS,
+    "replaceLane", Float32x4ReplaceLaneJS,
+    "add", Float32x4AddJS,
+    "sub", Float32x4SubJS,
+    "mul", Float32x4MulJS,
+    "div", Float32x4DivJS,
+    "min", Float32x4MinJS,
+    "max", Float32x4MaxJS,
+    "neg", Float32x4NegJS,
+    "abs", Float32x4AbsJS,
+    "sqrt", Float32x4SqrtJS,
+    "fromInt32x4", Float32x4FromInt32x4JS,
+    "load", Float32x4LoadJS,
+    "store", Float32x4StoreJS
+  ));
+
+  SetUpSimdType($Int32x4, Int32x4Constructor, $Array(
+    "toString", Int32x4ToString,
+    "valueOf", Int32x4ValueOf
+  ));
+  InstallFunctions($Int32x4, DONT_ENUM, $Array(
+    "check", Int32x4Check,
+    "splat", Int32x4Splat,
+    "extractLane", Int32x4ExtractLaneJS,
+    "replaceLane", Int32x4ReplaceLaneJS,
+    "add", Int32x4AddJS,
+    "sub", Int32x4SubJS,
+    "mul", Int32x4MulJS,
+    "and", Int32x4AndJS,
+    "or", Int32x4OrJS,
+    "xor", Int32x4XorJS,
+    "neg", Int32x4NegJS,
+    "not", Int32x4NotJS,
+    "fromFloat32x4", Int32x4FromFloat32x4JS,
+    "load", Int32x4LoadJS,
+    "store", Int32x4StoreJS
+  ));
+
+  SetUpSimdType($Float64x2, Float64x2Constructor, $Array(
+    "toString", Float64x2ToString,
+    "valueOf", Float64x2ValueOf
+  ));
+  InstallFunctions($Float64x2, DONT_ENUM, $Array(
+    "check", Float64x2Check,
+    "splat", Float64x2Splat,
+    "extractLane", Float64x2ExtractLaneJS,
+    "replaceLane", Float64x2ReplaceLaneJS,
+    "add", Float64x2AddJS,
+    "sub", Float64x2SubJS,
+    "mul", Float64x2MulJS,
+    "div", Float64x2DivJS,
+    "min", Float64x2MinJS,
+    "max", Float64x2MaxJS,
+    "neg", Float64x2NegJS,
+    "abs", Float64x2AbsJS,
+    "sqrt", Float64x2SqrtJS,
+    "load", Float64x2LoadJS,
+    "store", Float64x2StoreJS
+  ));
+}
+
+SetUpSIMD();
@@ -13,6 +13,11 @@
 namespace v8 {
 namespace internal {
 
+// An open addressing hash map with Robin Hood linear probing: the entries
+// of a run of occupied slots are ordered by their initial positions, so a
+// lookup for a missing key stops at the first entry that started out
+// further along than the key would have, instead of at the end of the run.
+// Removal shifts the rest of the run back, so no tombstones are needed.
 template<class AllocationPolicy>
 class TemplateHashMapImpl {
  public:
@@ -88,7 +93,16 @@ class TemplateHashMapImpl {
   uint32_t occupancy_;
 
   Entry* map_end() const { return map_ + capacity_; }
-  Entry* Probe(void* key, uint32_t hash);
+
+  // The number of slots between the entry at |index| and its initial
+  // position.
+  uint32_t ProbeDistance(uint32_t index) const {
+    return (index - map_[index].hash) & (capacity_ - 1);
+  }
+
+  // Returns the entry for |key|, or NULL if there is none. |index| is set to
+  // the slot of the entry, or to the slot where the key belongs.
+  Entry* Probe(void* key, uint32_t hash, uint32_t* index);
   void Initialize(uint32_t capacity, AllocationPolicy allocator);
   void Resize(AllocationPolicy allocator);
 };
@@ -114,13 +128,24 @@ typename TemplateHashMapImpl<AllocationPolicy>::Entry*
 TemplateHashMapImpl<AllocationPolicy>::Lookup(
     void* key, uint32_t hash, bool insert, AllocationPolicy allocator) {
   // Find a matching entry.
-  Entry* p = Probe(key, hash);
-  if (p->key != NULL) {
+  uint32_t index;
+  Entry* p = Probe(key, hash, &index);
+  if (p != NULL) {
     return p;
   }
 
   // No entry found; insert one if necessary.
   if (insert) {
+    // Shift the rest of the run forward by one slot to make room. This keeps
+    // the run ordered by initial position.
+    uint32_t mask = capacity_ - 1;
+    uint32_t last = index;
+    while (map_[last].key != NULL) last = (last + 1) & mask;
+    for (; last != index; last = (last - 1) & mask) {
+      map_[last] = map_[(last - 1) & mask];
+    }
+
+    p = map_ + index;
     p->key = key;
     p->value = NULL;
     p->hash = hash;
@@ -130,7 +155,7 @@ TemplateHashMapImpl<AllocationPolicy>::Lookup(
     // Grow the map if we reached >= 80% occupancy.
     if (occupancy_ + occupancy_/4 >= capacity_) {
       Resize(allocator);
-      p = Probe(key, hash);
+      p = Probe(key, hash, &index);
     }
 
     return p;
@@ -144,60 +169,27 @@ TemplateHashMapImpl<AllocationPolicy>::Lookup(
 template<class AllocationPolicy>
 void* TemplateHashMapImpl<AllocationPolicy>::Remove(void* key, uint32_t hash) {
   // Lookup the entry for the key to remove.
-  Entry* p = Probe(key, hash);
-  if (p->key == NULL) {
+  uint32_t index;
+  Entry* p = Probe(key, hash, &index);
+  if (p == NULL) {
     // Key not found nothing to remove.
     return NULL;
   }
 
   void* value = p->value;
-  // To remove an entry we need to ensure that it does not create an empty
-  // entry that will cause the search for another entry to stop too soon. If all
-  // the entries between the entry to remove and the next empty slot have their
-  // initial position inside this interval, clearing the entry to remove will
-  // not break the search. If, while searching for the next empty entry, an
-  // entry is encountered which does not have its initial position between the
-  // entry to remove and the position looked at, then this entry can be moved to
-  // the place of the entry to remove without breaking the search for it. The
-  // entry made vacant by this move is now the entry to remove and the process
-  // starts over.
-  // Algorithm from http://en.wikipedia.org/wiki/Open_addressing.
-
-  // This guarantees loop termination as there is at least one empty entry so
-  // eventually the removed entry will have an empty entry after it.
-  DCHECK(occupancy_ < capacity_);
-
-  // p is the candidate entry to clear. q is used to scan forwards.
-  Entry* q = p;  // Start at the entry to remove.
-  while (true) {
-    // Move q to the next entry.
-    q = q + 1;
-    if (q == map_end()) {
-      q = map_;
-    }
-
-    // All entries between p and q have their initial position between p and q
-    // and the entry p can be cleared without breaking the search for these
-    // entries.
-    if (q->key == NULL) {
-      break;
-    }
-
-    // Find the initial position for the entry at position q.
-    Entry* r = map_ + (q->hash & (capacity_ - 1));
-
-    // If the entry at position q has its initial position outside the range
-    // between p and q it can be moved forward to position p and will still be
-    // found. There is now a new candidate entry for clearing.
-    if ((q > p && (r <= p || r > q)) ||
-        (q < p && (r <= p && r > q))) {
-      *p = *q;
-      p = q;
-    }
+  // Shift the following entries of the run back by one slot until an empty
+  // slot or an entry at its initial position is reached. The run stays
+  // ordered and no entry ends up before its initial position.
+  uint32_t mask = capacity_ - 1;
+  uint32_t next = (index + 1) & mask;
+  while (map_[next].key != NULL && ProbeDistance(next) != 0) {
+    map_[index] = map_[next];
+    index = next;
+    next = (next + 1) & mask;
   }
 
-  // Clear the entry which is allowed to en emptied.
-  p->key = NULL;
+  // Clear the entry which is allowed to be emptied.
+  map_[index].key = NULL;
   occupancy_--;
   return value;
 }
@@ -237,22 +229,27 @@ typename TemplateHashMapImpl<AllocationPolicy>::Entry*
 
 template<class AllocationPolicy>
 typename TemplateHashMapImpl<AllocationPolicy>::Entry*
-    TemplateHashMapImpl<AllocationPolicy>::Probe(void* key, uint32_t hash) {
+    TemplateHashMapImpl<AllocationPolicy>::Probe(void* key, uint32_t hash,
+                                                 uint32_t* index) {
   DCHECK(key != NULL);
 
   DCHECK(base::bits::IsPowerOfTwo32(capacity_));
-  Entry* p = map_ + (hash & (capacity_ - 1));
-  const Entry* end = map_end();
-  DCHECK(map_ <= p && p < end);
+  uint32_t mask = capacity_ - 1;
+  uint32_t i = hash & mask;
 
   DCHECK(occupancy_ < capacity_);  // Guarantees loop termination.
-  while (p->key != NULL && (hash != p->hash || !match_(key, p->key))) {
-    p++;
-    if (p >= end) {
-      p = map_;
+  Entry* p = NULL;
+  for (uint32_t distance = 0; map_[i].key != NULL; distance++) {
+    if (hash == map_[i].hash && match_(key, map_[i].key)) {
+      p = map_ + i;
+      break;
     }
+    // The entries from here on started out further along than the key.
+    if (ProbeDistance(i) < distance) break;
+    i = (i + 1) & mask;
   }
 
+  *index = i;
   return p;
 }
 
@@ -8,6 +8,7 @@
 
 #include "src/allocation-tracker.h"
 #include "src/heap-snapshot-generator-inl.h"
+#include "src/sampling-heap-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -90,6 +91,25 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
 }
 
 
+bool HeapProfiler::StreamSnapshot(
+    String* name,
+    v8::OutputStream* stream,
+    v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  // The snapshot only lives while it is written, it is not added to the
+  // list of snapshots.
+  HeapSnapshot snapshot(this, names_->GetName(name), next_snapshot_uid_++);
+  bool result;
+  {
+    HeapSnapshotGenerator generator(&snapshot, control, resolver, heap());
+    result = generator.StreamSnapshot(stream);
+  }
+  ids_->RemoveDeadEntries();
+  is_tracking_object_moves_ = true;
+  return result;
+}
+
+
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
   is_tracking_object_moves_ = true;
@@ -115,6 +135,22 @@ void HeapProfiler::StopHeapObjectsTracking() {
 }
 
 
+void HeapProfiler::StartSamplingHeapProfiler(intptr_t sample_interval) {
+  if (is_sampling_allocations()) return;
+  sampling_heap_profiler_.Reset(
+      new SamplingHeapProfiler(heap(), sample_interval));
+  heap()->new_space()->SetBytesUntilAllocationSample(
+      sampling_heap_profiler_->GetNextSampleInterval());
+}
+
+
+void HeapProfiler::StopSamplingHeapProfiler() {
+  if (!is_sampling_allocations()) return;
+  heap()->new_space()->SetBytesUntilAllocationSample(0);
+  sampling_heap_profiler_.Reset(NULL);
+}
+
+
 size_t HeapProfiler::GetMemorySizeUsedByProfiler() {
   size_t size = sizeof(*this);
   size += names_->GetUsedMemorySize();
@@ -160,6 +196,11 @@ void HeapProfiler::AllocationEvent(Address addr, int size) {
 }
 
 
+void HeapProfiler::OldSpaceAllocationEvent(Address addr, int size) {
+  sampling_heap_profiler_->OldSpaceAllocationEvent(addr, size);
+}
+
+
 void HeapProfiler::UpdateObjectSizeEvent(Address addr, int size) {
   ids_->UpdateObjectSize(addr, size);
 }
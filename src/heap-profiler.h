@@ -13,6 +13,7 @@ namespace v8 {
 namespace internal {
 
 class HeapSnapshot;
+class SamplingHeapProfiler;
 
 class HeapProfiler {
  public:
@@ -29,6 +30,11 @@ class HeapProfiler {
       String* name,
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
+  bool StreamSnapshot(
+      String* name,
+      v8::OutputStream* stream,
+      v8::ActivityControl* control,
+      v8::HeapProfiler::ObjectNameResolver* resolver);
 
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
@@ -36,6 +42,13 @@ class HeapProfiler {
     return allocation_tracker_.get();
   }
   HeapObjectsMap* heap_object_map() const { return ids_.get(); }
+
+  void StartSamplingHeapProfiler(intptr_t sample_interval);
+  void StopSamplingHeapProfiler();
+  SamplingHeapProfiler* sampling_heap_profiler() const {
+    return sampling_heap_profiler_.get();
+  }
+
   StringsStorage* names() const { return names_.get(); }
 
   SnapshotObjectId PushHeapObjectsStats(OutputStream* stream);
@@ -48,6 +61,7 @@ class HeapProfiler {
   void ObjectMoveEvent(Address from, Address to, int size);
 
   void AllocationEvent(Address addr, int size);
+  void OldSpaceAllocationEvent(Address addr, int size);
 
   void UpdateObjectSizeEvent(Address addr, int size);
 
@@ -62,6 +76,9 @@ class HeapProfiler {
   bool is_tracking_allocations() const {
     return !allocation_tracker_.is_empty();
   }
+  bool is_sampling_allocations() const {
+    return !sampling_heap_profiler_.is_empty();
+  }
 
   Handle<HeapObject> FindHeapObjectById(SnapshotObjectId id);
   void ClearHeapObjectMap();
@@ -76,6 +93,7 @@ class HeapProfiler {
   unsigned next_snapshot_uid_;
   List<v8::HeapProfiler::WrapperInfoCallback> wrapper_callbacks_;
   SmartPointer<AllocationTracker> allocation_tracker_;
+  SmartPointer<SamplingHeapProfiler> sampling_heap_profiler_;
   bool is_tracking_object_moves_;
 };
 
@@ -6,6 +6,8 @@
 
 #include "src/heap-snapshot-generator-inl.h"
 
+#include <algorithm>
+
 #include "src/allocation-tracker.h"
 #include "src/code-stubs.h"
 #include "src/conversions.h"
@@ -275,6 +277,23 @@ HeapEntry* HeapSnapshot::AddEntry(HeapEntry::Type type,
 }
 
 
+struct HeapGraphEdgeFromLess {
+  bool operator()(const HeapGraphEdge& a, const HeapGraphEdge& b) const {
+    return a.from_index() < b.from_index();
+  }
+};
+
+
+void HeapSnapshot::SortStoredEdges() {
+  DCHECK(children().is_empty());
+  // Keep the order of the edges of each entry.
+  std::stable_sort(edges().begin(), edges().end(), HeapGraphEdgeFromLess());
+  for (int i = 0; i < edges().length(); ++i) {
+    edges()[i].ReplaceToIndexWithEntry(this);
+  }
+}
+
+
 void HeapSnapshot::FillChildren() {
   DCHECK(children().is_empty());
   children().Allocate(edges().length());
@@ -891,13 +910,32 @@ HeapEntry* V8HeapExplorer::AddEntry(Address address,
 }
 
 
+// When a snapshot is streamed, the references of the heap object whose
+// references are being extracted are only counted on the first pass. They
+// are extracted again on the second pass and collected in a small buffer
+// that is written out after each object. All the other references, e.g.
+// those of the synthetic roots and the native objects, are few and are
+// stored in the snapshot on the first pass.
 class SnapshotFiller {
  public:
+  enum Pass { kStoreReferences, kCountReferences, kStreamReferences };
+
   explicit SnapshotFiller(HeapSnapshot* snapshot, HeapEntriesMap* entries)
       : snapshot_(snapshot),
         names_(snapshot->profiler()->names()),
-        entries_(entries) { }
+        entries_(entries),
+        pass_(kStoreReferences),
+        extracted_entry_(HeapEntry::kNoEntry),
+        streamed_edges_(NULL) { }
+  void set_pass(Pass pass, List<HeapGraphEdge>* streamed_edges = NULL) {
+    DCHECK((pass == kStreamReferences) == (streamed_edges != NULL));
+    pass_ = pass;
+    streamed_edges_ = streamed_edges;
+  }
+  bool is_streaming() const { return pass_ != kStoreReferences; }
+  void set_extracted_entry(int entry) { extracted_entry_ = entry; }
   HeapEntry* AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    DCHECK(pass_ != kStreamReferences);
     HeapEntry* entry = allocator->AllocateEntry(ptr);
     entries_->Pair(ptr, entry->index());
     return entry;
@@ -914,38 +952,65 @@ class SnapshotFiller {
                            int parent,
                            int index,
                            HeapEntry* child_entry) {
-    HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    parent_entry->SetIndexedReference(type, index, child_entry);
+    if (!IsExtracted(parent)) {
+      if (pass_ == kStreamReferences) return;
+      HeapEntry* parent_entry = &snapshot_->entries()[parent];
+      parent_entry->SetIndexedReference(type, index, child_entry);
+    } else if (pass_ == kCountReferences) {
+      snapshot_->entries()[parent].CountReference();
+    } else {
+      streamed_edges_->Add(
+          HeapGraphEdge(type, index, parent, child_entry->index()));
+    }
   }
   void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
                                     int parent,
                                     HeapEntry* child_entry) {
-    HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    int index = parent_entry->children_count() + 1;
-    parent_entry->SetIndexedReference(type, index, child_entry);
+    SetIndexedReference(type, parent, NextAutoIndex(parent), child_entry);
   }
   void SetNamedReference(HeapGraphEdge::Type type,
                          int parent,
                          const char* reference_name,
                          HeapEntry* child_entry) {
-    HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    parent_entry->SetNamedReference(type, reference_name, child_entry);
+    if (!IsExtracted(parent)) {
+      if (pass_ == kStreamReferences) return;
+      HeapEntry* parent_entry = &snapshot_->entries()[parent];
+      parent_entry->SetNamedReference(type, reference_name, child_entry);
+    } else if (pass_ == kCountReferences) {
+      snapshot_->entries()[parent].CountReference();
+    } else {
+      streamed_edges_->Add(
+          HeapGraphEdge(type, reference_name, parent, child_entry->index()));
+    }
   }
   void SetNamedAutoIndexReference(HeapGraphEdge::Type type,
                                   int parent,
                                   HeapEntry* child_entry) {
-    HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    int index = parent_entry->children_count() + 1;
-    parent_entry->SetNamedReference(
+    SetNamedReference(
         type,
-        names_->GetName(index),
+        parent,
+        names_->GetName(NextAutoIndex(parent)),
         child_entry);
   }
 
  private:
+  bool IsExtracted(int parent) const {
+    return pass_ != kStoreReferences && parent == extracted_entry_;
+  }
+  int NextAutoIndex(int parent) {
+    if (pass_ == kStreamReferences && IsExtracted(parent)) {
+      return streamed_edges_->length() + 1;
+    }
+    return snapshot_->entries()[parent].children_count() + 1;
+  }
+
   HeapSnapshot* snapshot_;
   StringsStorage* names_;
   HeapEntriesMap* entries_;
+  Pass pass_;
+  // The entry of the heap object whose references are being extracted.
+  int extracted_entry_;
+  List<HeapGraphEdge>* streamed_edges_;
 };
 
 
@@ -1498,6 +1563,10 @@ void V8HeapExplorer::ExtractCodeReferences(int entry, Code* code) {
   SetInternalReference(code, entry,
                        "deoptimization_data", code->deoptimization_data(),
                        Code::kDeoptimizationDataOffset);
+  TagObject(code->source_position_table(), "(code source positions)");
+  SetInternalReference(code, entry,
+                       "source_position_table", code->source_position_table(),
+                       Code::kSourcePositionTableOffset);
   if (code->kind() == Code::FUNCTION) {
     SetInternalReference(code, entry,
                          "type_feedback_info", code->type_feedback_info(),
@@ -1846,6 +1915,18 @@ bool V8HeapExplorer::IterateAndExtractReferences(
     SnapshotFiller* filler) {
   filler_ = filler;
 
+  if (filler->is_streaming()) {
+    // The streamed edges are extracted again in heap order, so create the
+    // entries of all heap objects in that order up front, for the edges to
+    // come in the order of the entries they are from.
+    HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+    for (HeapObject* obj = iterator.next();
+         obj != NULL;
+         obj = iterator.next()) {
+      GetEntry(obj);
+    }
+  }
+
   // Create references to the synthetic roots.
   SetRootGcRootsReference();
   for (int tag = 0; tag < VisitorSynchronization::kNumberOfSyncTags; tag++) {
@@ -1878,6 +1959,21 @@ bool V8HeapExplorer::IterateAndExtractReferences(
 }
 
 
+template<V8HeapExplorer::ExtractReferencesMethod extractor>
+void V8HeapExplorer::ExtractReferences(int entry, HeapObject* obj) {
+  filler_->set_extracted_entry(entry);
+  if ((this->*extractor)(entry, obj)) {
+    SetInternalReference(obj, entry,
+                         "map", obj->map(), HeapObject::kMapOffset);
+    // Extract unvisited fields as hidden references and restore tags
+    // of visited fields.
+    IndexedReferencesExtractor refs_extractor(this, obj, entry);
+    obj->Iterate(&refs_extractor);
+  }
+  filler_->set_extracted_entry(HeapEntry::kNoEntry);
+}
+
+
 template<V8HeapExplorer::ExtractReferencesMethod extractor>
 bool V8HeapExplorer::IterateAndExtractSinglePass() {
   // Now iterate the whole heap.
@@ -1890,15 +1986,7 @@ bool V8HeapExplorer::IterateAndExtractSinglePass() {
     if (interrupted) continue;
 
     HeapEntry* heap_entry = GetEntry(obj);
-    int entry = heap_entry->index();
-    if ((this->*extractor)(entry, obj)) {
-      SetInternalReference(obj, entry,
-                           "map", obj->map(), HeapObject::kMapOffset);
-      // Extract unvisited fields as hidden references and restore tags
-      // of visited fields.
-      IndexedReferencesExtractor refs_extractor(this, obj, entry);
-      obj->Iterate(&refs_extractor);
-    }
+    ExtractReferences<extractor>(heap_entry->index(), obj);
 
     if (!progress_->ProgressReport(false)) interrupted = true;
   }
@@ -1906,6 +1994,18 @@ bool V8HeapExplorer::IterateAndExtractSinglePass() {
 }
 
 
+void V8HeapExplorer::ExtractObjectReferences(SnapshotFiller* filler,
+                                             int entry,
+                                             HeapObject* object) {
+  filler_ = filler;
+  // Both passes have been done for all objects by now, so their results do
+  // not depend on the order of the objects any more.
+  ExtractReferences<&V8HeapExplorer::ExtractReferencesPass1>(entry, object);
+  ExtractReferences<&V8HeapExplorer::ExtractReferencesPass2>(entry, object);
+  filler_ = NULL;
+}
+
+
 bool V8HeapExplorer::IsEssentialObject(Object* object) {
   return object->IsHeapObject()
       && !object->IsOddball()
@@ -2549,6 +2649,85 @@ HeapSnapshotGenerator::HeapSnapshotGenerator(
 
 
 bool HeapSnapshotGenerator::GenerateSnapshot() {
+  SnapshotFiller filler(snapshot_, &entries_);
+  if (!FillSnapshot(&filler)) return false;
+
+  snapshot_->FillChildren();
+  snapshot_->RememberLastJSObjectId();
+
+  progress_counter_ = progress_total_;
+  if (!ProgressReport(true)) return false;
+  return true;
+}
+
+
+bool HeapSnapshotGenerator::StreamSnapshot(v8::OutputStream* stream) {
+  SnapshotFiller filler(snapshot_, &entries_);
+  filler.set_pass(SnapshotFiller::kCountReferences);
+  if (!FillSnapshot(&filler)) return false;
+
+  snapshot_->SortStoredEdges();
+  snapshot_->RememberLastJSObjectId();
+
+  progress_counter_ = progress_total_;
+  if (!ProgressReport(true)) return false;
+
+  HeapSnapshotJSONSerializer serializer(snapshot_, this);
+  serializer.Serialize(stream);
+  return true;
+}
+
+
+void HeapSnapshotGenerator::StreamEdges(
+    HeapSnapshotJSONSerializer* serializer) {
+  SnapshotFiller filler(snapshot_, &entries_);
+  List<HeapGraphEdge> edges;
+  filler.set_pass(SnapshotFiller::kStreamReferences, &edges);
+  int next_stored_edge = 0;
+  bool aborted = false;
+  HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+  // Heap iteration with filtering must be finished in any case.
+  for (HeapObject* obj = iterator.next();
+       obj != NULL;
+       obj = iterator.next()) {
+    if (aborted) continue;
+    int entry = entries_.Map(obj);
+    DCHECK(entry != HeapEntry::kNoEntry);
+    // The stored edges of the synthetic roots come before the edges of the
+    // first object, those of the native objects after the last one.
+    if (!StreamStoredEdges(serializer, &next_stored_edge, entry - 1)) {
+      aborted = true;
+      continue;
+    }
+    edges.Rewind(0);
+    v8_heap_explorer_.ExtractObjectReferences(&filler, entry, obj);
+    for (int i = 0; i < edges.length() && !aborted; i++) {
+      edges[i].ReplaceToIndexWithEntry(snapshot_);
+      aborted = !serializer->StreamEdge(&edges[i]);
+    }
+    if (!aborted) {
+      aborted = !StreamStoredEdges(serializer, &next_stored_edge, entry);
+    }
+  }
+  if (aborted) return;
+  StreamStoredEdges(serializer, &next_stored_edge,
+                    snapshot_->entries().length() - 1);
+}
+
+
+bool HeapSnapshotGenerator::StreamStoredEdges(
+    HeapSnapshotJSONSerializer* serializer, int* next_edge, int last_entry) {
+  List<HeapGraphEdge>& edges = snapshot_->edges();
+  for (; *next_edge < edges.length(); ++*next_edge) {
+    HeapGraphEdge* edge = &edges[*next_edge];
+    if (edge->from_index() > last_entry) break;
+    if (!serializer->StreamEdge(edge)) return false;
+  }
+  return true;
+}
+
+
+bool HeapSnapshotGenerator::FillSnapshot(SnapshotFiller* filler) {
   v8_heap_explorer_.TagGlobalObjects();
 
   // TODO(1562) Profiler assumes that any object that is in the heap after
@@ -2575,14 +2754,7 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   snapshot_->AddSyntheticRootEntries();
 
-  if (!FillReferences()) return false;
-
-  snapshot_->FillChildren();
-  snapshot_->RememberLastJSObjectId();
-
-  progress_counter_ = progress_total_;
-  if (!ProgressReport(true)) return false;
-  return true;
+  return FillReferences(filler);
 }
 
 
@@ -2613,10 +2785,9 @@ void HeapSnapshotGenerator::SetProgressTotal(int iterations_count) {
 }
 
 
-bool HeapSnapshotGenerator::FillReferences() {
-  SnapshotFiller filler(snapshot_, &entries_);
-  return v8_heap_explorer_.IterateAndExtractReferences(&filler)
-      && dom_explorer_.IterateAndExtractReferences(&filler);
+bool HeapSnapshotGenerator::FillReferences(SnapshotFiller* filler) {
+  return v8_heap_explorer_.IterateAndExtractReferences(filler)
+      && dom_explorer_.IterateAndExtractReferences(filler);
 }
 
 
@@ -2845,7 +3016,18 @@ void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
 }
 
 
+bool HeapSnapshotJSONSerializer::StreamEdge(HeapGraphEdge* edge) {
+  DCHECK(generator_ != NULL);
+  SerializeEdge(edge, streamed_edges_count_++ == 0);
+  return !writer_->aborted();
+}
+
+
 void HeapSnapshotJSONSerializer::SerializeEdges() {
+  if (generator_ != NULL) {
+    generator_->StreamEdges(this);
+    return;
+  }
   List<HeapGraphEdge*>& edges = snapshot_->children();
   for (int i = 0; i < edges.length(); ++i) {
     DCHECK(i == 0 ||
@@ -2967,7 +3149,13 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
   writer_->AddString(",\"node_count\":");
   writer_->AddNumber(snapshot_->entries().length());
   writer_->AddString(",\"edge_count\":");
-  writer_->AddNumber(snapshot_->edges().length());
+  // The edges of a streamed snapshot are only counted by the entries.
+  int edge_count = 0;
+  List<HeapEntry>& entries = snapshot_->entries();
+  for (int i = 0; i < entries.length(); ++i) {
+    edge_count += entries[i].children_count();
+  }
+  writer_->AddNumber(edge_count);
   writer_->AddString(",\"trace_function_count\":");
   uint32_t count = 0;
   AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
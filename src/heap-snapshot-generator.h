@@ -14,6 +14,7 @@ class AllocationTracker;
 class AllocationTraceNode;
 class HeapEntry;
 class HeapSnapshot;
+class HeapSnapshotJSONSerializer;
 class SnapshotFiller;
 
 class HeapGraphEdge BASE_EMBEDDED {
@@ -34,6 +35,7 @@ class HeapGraphEdge BASE_EMBEDDED {
   void ReplaceToIndexWithEntry(HeapSnapshot* snapshot);
 
   Type type() const { return static_cast<Type>(type_); }
+  int from_index() const { return from_index_; }
   int index() const {
     DCHECK(type_ == kElement || type_ == kHidden);
     return index_;
@@ -105,6 +107,9 @@ class HeapEntry BASE_EMBEDDED {
   unsigned trace_node_id() const { return trace_node_id_; }
   INLINE(int index() const);
   int children_count() const { return children_count_; }
+  // Counts a reference that is not stored in the snapshot because it is
+  // streamed, see SnapshotFiller.
+  void CountReference() { ++children_count_; }
   INLINE(int set_children_index(int index));
   void add_child(HeapGraphEdge* edge) {
     children_arr()[children_count_++] = edge;
@@ -174,6 +179,9 @@ class HeapSnapshot {
   HeapEntry* GetEntryById(SnapshotObjectId id);
   List<HeapEntry*>* GetSortedEntriesList();
   void FillChildren();
+  // Used instead of FillChildren when the snapshot is streamed: sorts the
+  // few edges that are stored by the entry they come from.
+  void SortStoredEdges();
 
   void Print(int max_depth);
   void PrintEntriesSize();
@@ -335,6 +343,11 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   void AddRootEntries(SnapshotFiller* filler);
   int EstimateObjectsCount(HeapIterator* iterator);
   bool IterateAndExtractReferences(SnapshotFiller* filler);
+  // Extracts the references of a single object again while a snapshot is
+  // streamed.
+  void ExtractObjectReferences(SnapshotFiller* filler,
+                               int entry,
+                               HeapObject* object);
   void TagGlobalObjects();
   void TagCodeObject(Code* code);
   void TagBuiltinCodeObject(Code* code, const char* name);
@@ -358,6 +371,8 @@ class V8HeapExplorer : public HeapEntriesAllocator {
 
   template<V8HeapExplorer::ExtractReferencesMethod extractor>
   bool IterateAndExtractSinglePass();
+  template<V8HeapExplorer::ExtractReferencesMethod extractor>
+  void ExtractReferences(int entry, HeapObject* object);
 
   bool ExtractReferencesPass1(int entry, HeapObject* obj);
   bool ExtractReferencesPass2(int entry, HeapObject* obj);
@@ -532,9 +547,19 @@ class HeapSnapshotGenerator : public SnapshottingProgressReportingInterface {
                         v8::HeapProfiler::ObjectNameResolver* resolver,
                         Heap* heap);
   bool GenerateSnapshot();
+  // Generates the snapshot and writes it to the stream in the JSON format
+  // without keeping the edges in memory: only the entries are built up
+  // front, the references of each heap object are extracted a second time
+  // while the edges are written. Returns false if it was aborted.
+  bool StreamSnapshot(v8::OutputStream* stream);
+  // Called by the serializer of a streamed snapshot to write the edges.
+  void StreamEdges(HeapSnapshotJSONSerializer* serializer);
 
  private:
-  bool FillReferences();
+  bool FillSnapshot(SnapshotFiller* filler);
+  bool FillReferences(SnapshotFiller* filler);
+  bool StreamStoredEdges(HeapSnapshotJSONSerializer* serializer,
+                         int* next_edge, int last_entry);
   void ProgressStep();
   bool ProgressReport(bool force = false);
   void SetProgressTotal(int iterations_count);
@@ -559,12 +584,30 @@ class HeapSnapshotJSONSerializer {
  public:
   explicit HeapSnapshotJSONSerializer(HeapSnapshot* snapshot)
       : snapshot_(snapshot),
+        generator_(NULL),
+        strings_(StringsMatch),
+        next_node_id_(1),
+        next_string_id_(1),
+        streamed_edges_count_(0),
+        writer_(NULL) {
+  }
+  // Serializes a snapshot whose edges are produced by the generator while
+  // they are written, see HeapSnapshotGenerator::StreamSnapshot.
+  HeapSnapshotJSONSerializer(HeapSnapshot* snapshot,
+                             HeapSnapshotGenerator* generator)
+      : snapshot_(snapshot),
+        generator_(generator),
         strings_(StringsMatch),
         next_node_id_(1),
         next_string_id_(1),
+        streamed_edges_count_(0),
         writer_(NULL) {
   }
   void Serialize(v8::OutputStream* stream);
+  // Writes the next edge of a streamed snapshot, the edges have to come in
+  // the order of the entries they are from. Returns false if the stream
+  // was aborted.
+  bool StreamEdge(HeapGraphEdge* edge);
 
  private:
   INLINE(static bool StringsMatch(void* key1, void* key2)) {
@@ -597,9 +640,11 @@ class HeapSnapshotJSONSerializer {
   static const int kNodeFieldsCount;
 
   HeapSnapshot* snapshot_;
+  HeapSnapshotGenerator* generator_;
   HashMap strings_;
   int next_node_id_;
   int next_string_id_;
+  int streamed_edges_count_;
   OutputStreamWriter* writer_;
 
   friend class HeapSnapshotJSONSerializerEnumerator;
@@ -41,20 +41,17 @@ void GCIdleTimeAction::Print() {
 
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
-    size_t idle_time_in_ms, size_t marking_speed_in_bytes_per_ms) {
+    double idle_time_in_ms, size_t marking_speed_in_bytes_per_ms) {
   DCHECK(idle_time_in_ms > 0);
 
   if (marking_speed_in_bytes_per_ms == 0) {
     marking_speed_in_bytes_per_ms = kInitialConservativeMarkingSpeed;
   }
 
-  size_t marking_step_size = marking_speed_in_bytes_per_ms * idle_time_in_ms;
-  if (marking_step_size / marking_speed_in_bytes_per_ms != idle_time_in_ms) {
-    // In the case of an overflow we return maximum marking step size.
-    return kMaximumMarkingStepSize;
-  }
-
-  if (marking_step_size > kMaximumMarkingStepSize)
+  // The product is computed in floating point, so it cannot overflow.
+  double marking_step_size =
+      static_cast<double>(marking_speed_in_bytes_per_ms) * idle_time_in_ms;
+  if (marking_step_size >= kMaximumMarkingStepSize)
     return kMaximumMarkingStepSize;
 
   return static_cast<size_t>(marking_step_size * kConservativeTimeRatio);
@@ -72,7 +69,7 @@ size_t GCIdleTimeHandler::EstimateMarkCompactTime(
 
 
 bool GCIdleTimeHandler::DoScavenge(
-    size_t idle_time_in_ms, size_t new_space_size, size_t used_new_space_size,
+    double idle_time_in_ms, size_t new_space_size, size_t used_new_space_size,
     size_t scavenge_speed_in_bytes_per_ms,
     size_t new_space_allocation_throughput_in_bytes_per_ms) {
   size_t new_space_allocation_limit =
@@ -101,7 +98,8 @@ bool GCIdleTimeHandler::DoScavenge(
   }
 
   if (new_space_allocation_limit <= used_new_space_size) {
-    if (used_new_space_size / scavenge_speed_in_bytes_per_ms <=
+    if (static_cast<double>(used_new_space_size) /
+            scavenge_speed_in_bytes_per_ms <=
         idle_time_in_ms) {
       return true;
     }
@@ -126,7 +124,7 @@ bool GCIdleTimeHandler::DoScavenge(
 // request, we finalize sweeping here.
 // (5) If incremental marking is in progress, we perform a marking step. Note,
 // that this currently may trigger a full garbage collection.
-GCIdleTimeAction GCIdleTimeHandler::Compute(size_t idle_time_in_ms,
+GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
                                             HeapState heap_state) {
   if (DoScavenge(idle_time_in_ms, heap_state.new_space_capacity,
                  heap_state.used_new_space_size,
@@ -143,7 +141,7 @@ GCIdleTimeAction GCIdleTimeHandler::Compute(size_t idle_time_in_ms,
     }
   }
 
-  if (idle_time_in_ms == 0) {
+  if (idle_time_in_ms <= 0) {
     return GCIdleTimeAction::Nothing();
   }
 
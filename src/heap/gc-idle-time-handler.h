@@ -135,7 +135,9 @@ class GCIdleTimeHandler {
       : mark_compacts_since_idle_round_started_(0),
         scavenges_since_last_idle_round_(0) {}
 
-  GCIdleTimeAction Compute(size_t idle_time_in_ms, HeapState heap_state);
+  // The idle time is given in fractional milliseconds, so that deadlines
+  // shorter than a millisecond can still be used for small amounts of work.
+  GCIdleTimeAction Compute(double idle_time_in_ms, HeapState heap_state);
 
   void NotifyIdleMarkCompact() {
     if (mark_compacts_since_idle_round_started_ < kMaxMarkCompactsInIdleRound) {
@@ -149,14 +151,14 @@ class GCIdleTimeHandler {
 
   void NotifyScavenge() { ++scavenges_since_last_idle_round_; }
 
-  static size_t EstimateMarkingStepSize(size_t idle_time_in_ms,
+  static size_t EstimateMarkingStepSize(double idle_time_in_ms,
                                         size_t marking_speed_in_bytes_per_ms);
 
   static size_t EstimateMarkCompactTime(
       size_t size_of_objects, size_t mark_compact_speed_in_bytes_per_ms);
 
   static bool DoScavenge(
-      size_t idle_time_in_ms, size_t new_space_size, size_t used_new_space_size,
+      double idle_time_in_ms, size_t new_space_size, size_t used_new_space_size,
       size_t scavenger_speed_in_bytes_per_ms,
       size_t new_space_allocation_throughput_in_bytes_per_ms);
 
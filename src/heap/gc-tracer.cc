@@ -47,7 +47,12 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      parallel_scavenge_tasks(0),
+      parallel_scavenge_slots(0),
+      parallel_scavenge_max_task_slots(0),
+      promoted_bytes(0),
+      semi_space_copied_bytes(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -88,7 +93,8 @@ GCTracer::GCTracer(Heap* heap)
       longest_incremental_marking_step_(0.0),
       cumulative_marking_duration_(0.0),
       cumulative_sweeping_duration_(0.0),
-      new_space_top_after_gc_(0) {
+      new_space_top_after_gc_(0),
+      statistics_callback_(NULL) {
   current_ = Event(Event::START, NULL, NULL);
   current_.end_time = base::OS::TimeCurrentMillis();
   previous_ = previous_mark_compactor_event_ = current_;
@@ -144,6 +150,8 @@ void GCTracer::Stop() {
   current_.end_holes_size = CountTotalHolesSize(heap_);
   new_space_top_after_gc_ =
       reinterpret_cast<intptr_t>(heap_->new_space()->top());
+  current_.promoted_bytes = heap_->promoted_objects_size_;
+  current_.semi_space_copied_bytes = heap_->semi_space_copied_object_size_;
 
   if (current_.type == Event::SCAVENGER) {
     current_.incremental_marking_steps =
@@ -177,6 +185,13 @@ void GCTracer::Stop() {
     mark_compactor_events_.push_front(current_);
   }
 
+  if (statistics_callback_ != NULL) {
+    v8::GCStatistics statistics;
+    GetStatistics(&statistics);
+    statistics_callback_(reinterpret_cast<v8::Isolate*>(heap_->isolate()),
+                         statistics);
+  }
+
   // TODO(ernstm): move the code below out of GCTracer.
 
   if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
@@ -220,6 +235,68 @@ void GCTracer::AddIncrementalMarkingStep(double duration, intptr_t bytes) {
 }
 
 
+void GCTracer::AddParallelScavengeTask(intptr_t slots) {
+  current_.parallel_scavenge_tasks++;
+  current_.parallel_scavenge_slots += slots;
+  current_.parallel_scavenge_max_task_slots =
+      Max(current_.parallel_scavenge_max_task_slots, slots);
+}
+
+
+bool GCTracer::GetStatistics(v8::GCStatistics* statistics) const {
+  if (current_.type == Event::START) return false;
+  statistics->type_ = current_.type == Event::SCAVENGER
+                          ? kGCTypeScavenge
+                          : kGCTypeMarkSweepCompact;
+  statistics->start_time_ = current_.start_time;
+  statistics->end_time_ = current_.end_time;
+
+  const double* scopes = current_.scopes;
+  double* phases = statistics->phases_;
+  phases[v8::GCStatistics::kExternal] = scopes[Scope::EXTERNAL];
+  phases[v8::GCStatistics::kMark] = scopes[Scope::MC_MARK];
+  // The old space sweeping scopes are nested in MC_SWEEP.
+  phases[v8::GCStatistics::kSweep] =
+      scopes[Scope::MC_SWEEP] + scopes[Scope::MC_SWEEP_NEWSPACE];
+  phases[v8::GCStatistics::kEvacuate] = scopes[Scope::MC_EVACUATE_PAGES];
+  phases[v8::GCStatistics::kUpdatePointers] =
+      scopes[Scope::MC_UPDATE_NEW_TO_NEW_POINTERS] +
+      scopes[Scope::MC_UPDATE_ROOT_TO_NEW_POINTERS] +
+      scopes[Scope::MC_UPDATE_OLD_TO_NEW_POINTERS] +
+      scopes[Scope::MC_UPDATE_POINTERS_TO_EVACUATED] +
+      scopes[Scope::MC_UPDATE_POINTERS_BETWEEN_EVACUATED] +
+      scopes[Scope::MC_UPDATE_MISC_POINTERS];
+  phases[v8::GCStatistics::kWeakCollections] =
+      scopes[Scope::MC_WEAKCOLLECTION_PROCESS] +
+      scopes[Scope::MC_WEAKCOLLECTION_CLEAR] +
+      scopes[Scope::MC_WEAKCOLLECTION_ABORT];
+  phases[v8::GCStatistics::kFlushCode] = scopes[Scope::MC_FLUSH_CODE];
+  phases[v8::GCStatistics::kScavengeRoots] = scopes[Scope::SCAVENGER_ROOTS];
+  phases[v8::GCStatistics::kScavengeOldToNew] =
+      scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS];
+  phases[v8::GCStatistics::kScavengeSemiSpace] =
+      scopes[Scope::SCAVENGER_SEMISPACE];
+
+  statistics->incremental_marking_duration_ =
+      current_.incremental_marking_duration;
+  statistics->mutator_duration_ =
+      Max(current_.start_time - previous_.end_time, 0.0);
+  statistics->size_before_ = static_cast<size_t>(current_.start_object_size);
+  statistics->size_after_ = static_cast<size_t>(current_.end_object_size);
+  statistics->promoted_bytes_ = static_cast<size_t>(current_.promoted_bytes);
+  statistics->semi_space_copied_bytes_ =
+      static_cast<size_t>(current_.semi_space_copied_bytes);
+  statistics->survival_rate_ = 0.0;
+  if (current_.new_space_object_size > 0) {
+    statistics->survival_rate_ =
+        static_cast<double>(current_.promoted_bytes +
+                            current_.semi_space_copied_bytes) /
+        current_.new_space_object_size * 100;
+  }
+  return true;
+}
+
+
 void GCTracer::Print() const {
   PrintPID("%8.0f ms: ", heap_->isolate()->time_millis_since_init());
 
@@ -325,6 +402,16 @@ void GCTracer::PrintNVP() const {
     PrintF("steps_took=%.1f ", current_.incremental_marking_duration);
     PrintF("scavenge_throughput=%" V8_PTR_PREFIX "d ",
            ScavengeSpeedInBytesPerMillisecond());
+    PrintF("scavenge_roots=%.1f ", current_.scopes[Scope::SCAVENGER_ROOTS]);
+    PrintF("scavenge_old_new=%.1f ",
+           current_.scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS]);
+    PrintF("scavenge_semispace=%.1f ",
+           current_.scopes[Scope::SCAVENGER_SEMISPACE]);
+    PrintF("scavenge_tasks=%d ", current_.parallel_scavenge_tasks);
+    PrintF("scavenge_task_slots=%" V8_PTR_PREFIX "d ",
+           current_.parallel_scavenge_slots);
+    PrintF("scavenge_max_task_slots=%" V8_PTR_PREFIX "d ",
+           current_.parallel_scavenge_max_task_slots);
   } else {
     PrintF("steps_count=%d ", current_.incremental_marking_steps);
     PrintF("steps_took=%.1f ", current_.incremental_marking_duration);
@@ -476,5 +563,18 @@ intptr_t GCTracer::NewSpaceAllocationThroughputInBytesPerMillisecond() const {
 
   return static_cast<intptr_t>(bytes / durations);
 }
+
+
+intptr_t GCTracer::CurrentNewSpaceAllocationThroughputInBytesPerMillisecond()
+    const {
+  if (new_space_top_after_gc_ == 0) return 0;
+  double duration = base::OS::TimeCurrentMillis() - current_.end_time;
+  if (duration <= 0.0) return 0;
+  intptr_t bytes = reinterpret_cast<intptr_t>(heap_->new_space()->top()) -
+                   new_space_top_after_gc_;
+  // The allocation top may have moved to an earlier page.
+  if (bytes < 0) return 0;
+  return static_cast<intptr_t>(bytes / duration);
+}
 }
 }  // namespace v8::internal
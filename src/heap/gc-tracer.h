@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_GC_TRACER_H_
 #define V8_HEAP_GC_TRACER_H_
 
+#include "include/v8.h"
 #include "src/base/platform/platform.h"
 
 namespace v8 {
@@ -107,6 +108,9 @@ class GCTracer {
       MC_WEAKCOLLECTION_CLEAR,
       MC_WEAKCOLLECTION_ABORT,
       MC_FLUSH_CODE,
+      SCAVENGER_ROOTS,
+      SCAVENGER_OLD_TO_NEW_POINTERS,
+      SCAVENGER_SEMISPACE,
       NUMBER_OF_SCOPES
     };
 
@@ -231,6 +235,20 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Number of participants in the parallel scan of scan-on-scavenge pages,
+    // including the main thread.
+    int parallel_scavenge_tasks;
+
+    // Slots pointing to new space found by all participants and by the
+    // busiest participant of the parallel scan.
+    intptr_t parallel_scavenge_slots;
+    intptr_t parallel_scavenge_max_task_slots;
+
+    // Bytes promoted to the old generation and copied within the new space,
+    // set in Stop().
+    intptr_t promoted_bytes;
+    intptr_t semi_space_copied_bytes;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -256,6 +274,9 @@ class GCTracer {
   // Log an incremental marking step.
   void AddIncrementalMarkingStep(double duration, intptr_t bytes);
 
+  // Log the work done by one participant of a parallel scavenge.
+  void AddParallelScavengeTask(intptr_t slots);
+
   // Log time spent in marking.
   void AddMarkingTime(double duration) {
     cumulative_marking_duration_ += duration;
@@ -322,6 +343,21 @@ class GCTracer {
   // Returns 0 if no events have been recorded.
   intptr_t NewSpaceAllocationThroughputInBytesPerMillisecond() const;
 
+  // Allocation throughput in the new space in bytes/millisecond since the end
+  // of the last garbage collection.
+  intptr_t CurrentNewSpaceAllocationThroughputInBytesPerMillisecond() const;
+
+  // Fill in the statistics of the last completed garbage collection. Returns
+  // false if there has not been any garbage collection yet.
+  bool GetStatistics(v8::GCStatistics* statistics) const;
+
+  v8::Isolate::GCStatisticsCallback statistics_callback() const {
+    return statistics_callback_;
+  }
+  void set_statistics_callback(v8::Isolate::GCStatisticsCallback callback) {
+    statistics_callback_ = callback;
+  }
+
  private:
   // Print one detailed trace line in name=value format.
   // TODO(ernstm): Move to Heap.
@@ -393,6 +429,10 @@ class GCTracer {
   // collection.
   intptr_t new_space_top_after_gc_;
 
+  // Invoked with the statistics of every garbage collection at the end of
+  // Stop().
+  v8::Isolate::GCStatisticsCallback statistics_callback_;
+
   DISALLOW_COPY_AND_ASSIGN(GCTracer);
 };
 }
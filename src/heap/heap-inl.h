@@ -214,6 +214,18 @@ AllocationResult Heap::AllocateRaw(int size_in_bytes, AllocationSpace space,
   }
   if (allocation.To(&object)) {
     OnAllocationEvent(object, size_in_bytes);
+    // Objects destined for old data space hold no pointers besides their
+    // immortal root map, so they can start out black without hiding anything
+    // from the marker.
+    if (FLAG_black_allocation && retry_space == OLD_DATA_SPACE &&
+        incremental_marking()->IsMarking()) {
+      incremental_marking()->MarkBlackAllocated(object, size_in_bytes);
+    }
+    // New space allocations are sampled by the new space itself.
+    HeapProfiler* profiler = isolate_->heap_profiler();
+    if (profiler->is_sampling_allocations()) {
+      profiler->OldSpaceAllocationEvent(object->address(), size_in_bytes);
+    }
   } else {
     old_gen_exhausted_ = true;
   }
@@ -368,6 +380,7 @@ bool Heap::OldGenerationAllocationLimitReached() {
 
 
 bool Heap::ShouldBePromoted(Address old_address, int object_size) {
+  if (promote_all_survivors_) return true;
   NewSpacePage* page = NewSpacePage::FromAddress(old_address);
   Address age_mark = new_space_.age_mark();
   return page->IsFlagSet(MemoryChunk::NEW_SPACE_BELOW_AGE_MARK) &&
@@ -622,6 +635,11 @@ Isolate* Heap::isolate() {
       __allocation__ = FUNCTION_CALL;                                         \
     }                                                                         \
     RETURN_OBJECT_UNLESS_RETRY(ISOLATE, RETURN_VALUE)                         \
+    if ((ISOLATE)->heap()->InvokeNearHeapLimitCallback()) {                   \
+      AlwaysAllocateScope __scope__(ISOLATE);                                 \
+      __allocation__ = FUNCTION_CALL;                                         \
+    }                                                                         \
+    RETURN_OBJECT_UNLESS_RETRY(ISOLATE, RETURN_VALUE)                         \
     /* TODO(1181417): Fix this. */                                            \
     v8::internal::Heap::FatalProcessOutOfMemory("CALL_AND_RETRY_LAST", true); \
     RETURN_EMPTY;                                                             \
@@ -95,14 +95,20 @@ Heap::Heap()
       allocation_timeout_(0),
 #endif  // DEBUG
       old_generation_allocation_limit_(kMinimumOldGenerationAllocationLimit),
+      old_generation_size_at_last_gc_(0),
+      large_object_size_at_last_gc_(0),
       old_gen_exhausted_(false),
       inline_allocation_disabled_(false),
       store_buffer_rebuilder_(store_buffer()),
       hidden_string_(NULL),
+      near_heap_limit_callback_(NULL),
+      near_heap_limit_callback_data_(NULL),
+      initial_max_old_generation_size_(0),
       gc_safe_size_of_old_object_(NULL),
       total_regexp_code_generated_(0),
       tracer_(this),
       high_survival_rate_period_length_(0),
+      promote_all_survivors_(false),
       promoted_objects_size_(0),
       promotion_rate_(0),
       semi_space_copied_object_size_(0),
@@ -122,6 +128,7 @@ Heap::Heap()
       marking_(this),
       incremental_marking_(this),
       gc_count_at_last_idle_gc_(0),
+      memory_reducer_timer_task_(NULL),
       full_codegen_bytes_generated_(0),
       crankshaft_codegen_bytes_generated_(0),
       gcs_since_last_deopt_(0),
@@ -726,6 +733,9 @@ void Heap::CollectAllGarbage(int flags, const char* gc_reason,
   // Since we are ignoring the return value, the exact choice of space does
   // not matter, so long as we do not specify NEW_SPACE, which would not
   // cause a full GC.
+  if (memory_reducer_.ShouldReduceMemory()) {
+    flags |= kReduceMemoryFootprintMask;
+  }
   mark_compact_collector_.SetFlags(flags);
   CollectGarbage(OLD_POINTER_SPACE, gc_reason, gc_callback_flags);
   mark_compact_collector_.SetFlags(kNoGCFlags);
@@ -824,6 +834,7 @@ bool Heap::CollectGarbage(GarbageCollector collector, const char* gc_reason,
   }
 
   bool next_gc_likely_to_collect_more = false;
+  intptr_t committed_memory_before = CommittedMemory();
 
   {
     tracer()->Start(collector, gc_reason, collector_reason);
@@ -843,6 +854,21 @@ bool Heap::CollectGarbage(GarbageCollector collector, const char* gc_reason,
     tracer()->Stop();
   }
 
+  if (collector == MARK_COMPACTOR) {
+    // If the GC released a good amount of memory, another one will likely
+    // release more.
+    static const intptr_t kMinCommittedMemoryReduction = 1 * MB;
+    NotifyMemoryReducer(
+        MemoryReducer::kMarkCompact,
+        next_gc_likely_to_collect_more ||
+            committed_memory_before - CommittedMemory() >=
+                kMinCommittedMemoryReduction);
+    if (OldGenerationCapacityAvailable() <
+        max_old_generation_size_ / kNearHeapLimitFraction) {
+      InvokeNearHeapLimitCallback();
+    }
+  }
+
   // Start incremental marking for the next cycle. The heap snapshot
   // generator needs incremental marking to stay off after it aborted.
   if (!mark_compact_collector()->abort_incremental_marking() &&
@@ -861,6 +887,7 @@ int Heap::NotifyContextDisposed() {
   }
   flush_monomorphic_ics_ = true;
   AgeInlineCaches();
+  NotifyMemoryReducer(MemoryReducer::kContextDisposed, false);
   return ++contexts_disposed_;
 }
 
@@ -1000,26 +1027,6 @@ void Heap::ClearJSFunctionResultCaches() {
 }
 
 
-void Heap::ClearNormalizedMapCaches() {
-  if (isolate_->bootstrapper()->IsActive() &&
-      !incremental_marking()->IsMarking()) {
-    return;
-  }
-
-  Object* context = native_contexts_list();
-  while (!context->IsUndefined()) {
-    // GC can happen when the context is not fully initialized,
-    // so the cache can be undefined.
-    Object* cache =
-        Context::cast(context)->get(Context::NORMALIZED_MAP_CACHE_INDEX);
-    if (!cache->IsUndefined()) {
-      NormalizedMapCache::cast(cache)->Clear();
-    }
-    context = Context::cast(context)->get(Context::NEXT_CONTEXT_LINK);
-  }
-}
-
-
 void Heap::UpdateSurvivalStatistics(int start_new_space_size) {
   if (start_new_space_size == 0) return;
 
@@ -1105,7 +1112,8 @@ bool Heap::PerformGarbageCollection(
     AllowHeapAllocation allow_allocation;
     GCTracer::Scope scope(tracer(), GCTracer::Scope::EXTERNAL);
     freed_global_handles =
-        isolate_->global_handles()->PostGarbageCollectionProcessing(collector);
+        isolate_->global_handles()->PostGarbageCollectionProcessing(
+            collector, gc_callback_flags);
   }
   gc_post_processing_depth_--;
 
@@ -1120,6 +1128,8 @@ bool Heap::PerformGarbageCollection(
         amount_of_external_allocated_memory_;
     old_generation_allocation_limit_ = OldGenerationAllocationLimit(
         PromotedSpaceSizeOfObjects(), freed_global_handles);
+    old_generation_size_at_last_gc_ = PromotedSpaceSizeOfObjects();
+    large_object_size_at_last_gc_ = lo_space_->SizeOfObjects();
   }
 
   {
@@ -1214,6 +1224,7 @@ void Heap::MarkCompactPrologue() {
   isolate_->descriptor_lookup_cache()->Clear();
   RegExpResultsCache::Clear(string_split_cache());
   RegExpResultsCache::Clear(regexp_multiple_cache());
+  ObjectKeysCache::Clear(object_keys_cache());
 
   isolate_->compilation_cache()->MarkCompactPrologue();
 
@@ -1223,8 +1234,6 @@ void Heap::MarkCompactPrologue() {
   if (FLAG_cleanup_code_caches_at_gc) {
     polymorphic_code_cache()->set_cache(undefined_value());
   }
-
-  ClearNormalizedMapCaches();
 }
 
 
@@ -1429,14 +1438,25 @@ void Heap::Scavenge() {
   // Implements Cheney's copying algorithm
   LOG(isolate_, ResourceEvent("scavenge", "begin"));
 
-  // Clear descriptor cache.
-  isolate_->descriptor_lookup_cache()->Clear();
+  // The descriptor cache is keyed by maps and unique names, which all live
+  // outside new space, so it stays valid across scavenges.
 
   // Used for updating survived_since_last_expansion_ at function end.
   intptr_t survived_watermark = PromotedSpaceSizeOfObjects();
 
   SelectScavengingVisitorsTable();
 
+  // If nearly everything survived the last scavenge, the survivors are most
+  // likely long-lived. Promote them right away instead of copying them
+  // within new space first and into old space on the next scavenge.
+  promote_all_survivors_ = FLAG_promote_on_high_survival_rate &&
+                           IsHighSurvivalRate() &&
+                           OldGenerationSpaceAvailable() > new_space_.Size();
+  if (promote_all_survivors_ && FLAG_trace_gc_verbose) {
+    PrintPID("Scavenge promotes all survivors (survival rate %.1f%%)\n",
+             promotion_rate_ + semi_space_copied_rate_);
+  }
+
   incremental_marking()->PrepareForScavenge();
 
   // Flip the semispaces.  After flipping, to space is empty, from space has
@@ -1470,10 +1490,15 @@ void Heap::Scavenge() {
 
   ScavengeVisitor scavenge_visitor(this);
   // Copy roots.
-  IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+  {
+    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+  }
 
   // Copy objects reachable from the old generation.
   {
+    GCTracer::Scope gc_scope(tracer(),
+                             GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
     StoreBufferRebuildScope scope(this, store_buffer(),
                                   &ScavengeStoreBufferCallback);
     store_buffer()->IteratePointersToNewSpace(&ScavengeObject);
@@ -1515,7 +1540,10 @@ void Heap::Scavenge() {
     collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
   }
 
-  new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+  {
+    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
+    new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+  }
 
   while (isolate()->global_handles()->IterateObjectGroups(
       &scavenge_visitor, &IsUnscavengedHeapObject)) {
@@ -1542,6 +1570,8 @@ void Heap::Scavenge() {
 
   DCHECK(new_space_front == new_space_.top());
 
+  promote_all_survivors_ = false;
+
   // Set age mark.
   new_space_.set_age_mark(new_space_.top());
 
@@ -1772,8 +1802,7 @@ Address Heap::DoScavenge(ObjectVisitor* scavenge_visitor,
         // for pointers to from semispace instead of looking for pointers
         // to new space.
         DCHECK(!target->IsMap());
-        IterateAndMarkPointersToFromSpace(
-            target->address(), target->address() + size, &ScavengeObject);
+        IteratePointersToFromSpace(target, size, &ScavengeObject);
       }
     }
 
@@ -2288,6 +2317,7 @@ AllocationResult Heap::AllocatePartialMap(InstanceType instance_type,
   int bit_field3 = Map::EnumLengthBits::encode(kInvalidEnumCacheSentinel) |
                    Map::OwnsDescriptors::encode(true);
   reinterpret_cast<Map*>(result)->set_bit_field3(bit_field3);
+  reinterpret_cast<Map*>(result)->set_unboxed_double_fields(0);
   return result;
 }
 
@@ -2321,6 +2351,7 @@ AllocationResult Heap::AllocateMap(InstanceType instance_type,
                    Map::OwnsDescriptors::encode(true);
   map->set_bit_field3(bit_field3);
   map->set_elements_kind(elements_kind);
+  map->set_unboxed_double_fields(0);
 
   return map;
 }
@@ -2498,6 +2529,10 @@ bool Heap::CreateInitialMaps() {
     ALLOCATE_MAP(HEAP_NUMBER_TYPE, HeapNumber::kSize, heap_number)
     ALLOCATE_MAP(MUTABLE_HEAP_NUMBER_TYPE, HeapNumber::kSize,
                  mutable_heap_number)
+#define ALLOCATE_SIMD128_MAP(TYPE, Type, type, lane_count, lane_type) \
+    ALLOCATE_MAP(TYPE##_TYPE, Simd128Value::kSize, type)
+    SIMD128_TYPES(ALLOCATE_SIMD128_MAP)
+#undef ALLOCATE_SIMD128_MAP
     ALLOCATE_MAP(SYMBOL_TYPE, Symbol::kSize, symbol)
     ALLOCATE_MAP(FOREIGN_TYPE, Foreign::kSize, foreign)
 
@@ -2650,6 +2685,32 @@ AllocationResult Heap::AllocateHeapNumber(double value, MutableMode mode,
 }
 
 
+#define SIMD_ALLOCATE_DEFINITION(TYPE, Type, type, lane_count, lane_type) \
+  AllocationResult Heap::Allocate##Type(lane_type lanes[lane_count],      \
+                                        PretenureFlag pretenure) {        \
+    int size = Type::kSize;                                               \
+    STATIC_ASSERT(Type::kSize <= Page::kMaxRegularHeapObjectSize);        \
+                                                                          \
+    AllocationSpace space = SelectSpace(size, OLD_DATA_SPACE, pretenure); \
+                                                                          \
+    HeapObject* result;                                                   \
+    {                                                                     \
+      AllocationResult allocation =                                       \
+          AllocateRaw(size, space, OLD_DATA_SPACE);                       \
+      if (!allocation.To(&result)) return allocation;                     \
+    }                                                                     \
+                                                                          \
+    result->set_map_no_write_barrier(type##_map());                       \
+    Type* instance = Type::cast(result);                                  \
+    for (int i = 0; i < lane_count; i++) {                                \
+      instance->set_lane(i, lanes[i]);                                    \
+    }                                                                     \
+    return result;                                                        \
+  }
+SIMD128_TYPES(SIMD_ALLOCATE_DEFINITION)
+#undef SIMD_ALLOCATE_DEFINITION
+
+
 AllocationResult Heap::AllocateCell(Object* value) {
   int size = Cell::kSize;
   STATIC_ASSERT(Cell::kSize <= Page::kMaxRegularHeapObjectSize);
@@ -2867,6 +2928,10 @@ void Heap::CreateInitialObjects() {
   set_regexp_multiple_cache(*factory->NewFixedArray(
       RegExpResultsCache::kRegExpResultsCacheSize, TENURED));
 
+  // Allocate cache for Object.keys results.
+  set_object_keys_cache(*factory->NewFixedArray(
+      ObjectKeysCache::kObjectKeysCacheSize, TENURED));
+
   // Allocate cache for external strings pointing to native source code.
   set_natives_source_cache(
       *factory->NewFixedArray(Natives::GetBuiltinsCount()));
@@ -2946,10 +3011,30 @@ bool Heap::RootCanBeTreatedAsConstant(RootListIndex root_index) {
 }
 
 
+intptr_t Heap::SizeOfConstantRoots() {
+  intptr_t size = 0;
+  for (int i = 0; i < kStrongRootListLength; i++) {
+    RootListIndex index = static_cast<RootListIndex>(i);
+    Object* root = roots_array_start()[index];
+    if (!root->IsHeapObject() || !RootCanBeTreatedAsConstant(index)) continue;
+    size += HeapObject::cast(root)->Size();
+  }
+  return size;
+}
+
+
+bool RegExpResultsCache::IsCacheableSubject(String* subject,
+                                            ResultsCacheType type) {
+  // Splits are keyed by the identity of the subject, so any string will do.
+  // Subjects of regexp results need to be internalized.
+  return type == STRING_SPLIT_SUBSTRINGS || subject->IsInternalizedString();
+}
+
+
 Object* RegExpResultsCache::Lookup(Heap* heap, String* key_string,
                                    Object* key_pattern, ResultsCacheType type) {
   FixedArray* cache;
-  if (!key_string->IsInternalizedString()) return Smi::FromInt(0);
+  if (!IsCacheableSubject(key_string, type)) return Smi::FromInt(0);
   if (type == STRING_SPLIT_SUBSTRINGS) {
     DCHECK(key_pattern->IsString());
     if (!key_pattern->IsInternalizedString()) return Smi::FromInt(0);
@@ -2983,7 +3068,7 @@ void RegExpResultsCache::Enter(Isolate* isolate, Handle<String> key_string,
                                ResultsCacheType type) {
   Factory* factory = isolate->factory();
   Handle<FixedArray> cache;
-  if (!key_string->IsInternalizedString()) return;
+  if (!IsCacheableSubject(*key_string, type)) return;
   if (type == STRING_SPLIT_SUBSTRINGS) {
     DCHECK(key_pattern->IsString());
     if (!key_pattern->IsInternalizedString()) return;
@@ -3017,9 +3102,10 @@ void RegExpResultsCache::Enter(Isolate* isolate, Handle<String> key_string,
       cache->set(index + kArrayOffset, *value_array);
     }
   }
-  // If the array is a reasonably short list of substrings, convert it into a
-  // list of internalized strings.
-  if (type == STRING_SPLIT_SUBSTRINGS && value_array->length() < 100) {
+  // If the array is a reasonably short list of substrings of a literal,
+  // convert it into a list of internalized strings.
+  if (type == STRING_SPLIT_SUBSTRINGS && key_string->IsInternalizedString() &&
+      value_array->length() < 100) {
     for (int i = 0; i < value_array->length(); i++) {
       Handle<String> str(String::cast(value_array->get(i)), isolate);
       Handle<String> internalized_str = factory->InternalizeString(str);
@@ -3038,6 +3124,51 @@ void RegExpResultsCache::Clear(FixedArray* cache) {
 }
 
 
+bool ObjectKeysCache::IsCacheable(JSObject* object) {
+  Map* map = object->map();
+  return map->instance_type() == JS_OBJECT_TYPE && !map->is_dictionary_map() &&
+         !map->is_access_check_needed() && !map->has_named_interceptor() &&
+         !map->has_indexed_interceptor() && object->elements()->length() == 0;
+}
+
+
+int ObjectKeysCache::EntryIndex(Map* map) {
+  uint32_t hash = ComputePointerHash(map);
+  return (hash & (kObjectKeysCacheSize / kEntrySize - 1)) * kEntrySize;
+}
+
+
+Object* ObjectKeysCache::Lookup(Heap* heap, JSObject* object) {
+  if (!IsCacheable(object)) return Smi::FromInt(0);
+  FixedArray* cache = heap->object_keys_cache();
+  Map* map = object->map();
+  int index = EntryIndex(map);
+  if (cache->get(index + kMapOffset) != map) return Smi::FromInt(0);
+  return cache->get(index + kKeysOffset);
+}
+
+
+void ObjectKeysCache::Enter(Isolate* isolate, Handle<JSObject> object,
+                            Handle<FixedArray> keys) {
+  // The empty fixed array is shared and must not be turned into a COW-array.
+  if (keys->length() == 0 || !IsCacheable(*object)) return;
+  Factory* factory = isolate->factory();
+  Handle<FixedArray> cache = factory->object_keys_cache();
+  int index = EntryIndex(object->map());
+  cache->set(index + kMapOffset, object->map());
+  cache->set(index + kKeysOffset, *keys);
+  // Convert backing store to a copy-on-write array.
+  keys->set_map_no_write_barrier(*factory->fixed_cow_array_map());
+}
+
+
+void ObjectKeysCache::Clear(FixedArray* cache) {
+  for (int i = 0; i < kObjectKeysCacheSize; i++) {
+    cache->set(i, Smi::FromInt(0));
+  }
+}
+
+
 int Heap::FullSizeNumberStringCacheLength() {
   // Compute the size of the number string cache based on the max newspace size.
   // The number string cache has a minimum size based on twice the initial cache
@@ -3501,68 +3632,6 @@ AllocationResult Heap::CopyCode(Code* code) {
 }
 
 
-AllocationResult Heap::CopyCode(Code* code, Vector<byte> reloc_info) {
-  // Allocate ByteArray and ConstantPoolArray before the Code object, so that we
-  // do not risk leaving uninitialized Code object (and breaking the heap).
-  ByteArray* reloc_info_array;
-  {
-    AllocationResult allocation =
-        AllocateByteArray(reloc_info.length(), TENURED);
-    if (!allocation.To(&reloc_info_array)) return allocation;
-  }
-  HeapObject* new_constant_pool;
-  if (FLAG_enable_ool_constant_pool &&
-      code->constant_pool() != empty_constant_pool_array()) {
-    // Copy the constant pool, since edits to the copied code may modify
-    // the constant pool.
-    AllocationResult allocation = CopyConstantPoolArray(code->constant_pool());
-    if (!allocation.To(&new_constant_pool)) return allocation;
-  } else {
-    new_constant_pool = empty_constant_pool_array();
-  }
-
-  int new_body_size = RoundUp(code->instruction_size(), kObjectAlignment);
-
-  int new_obj_size = Code::SizeFor(new_body_size);
-
-  Address old_addr = code->address();
-
-  size_t relocation_offset =
-      static_cast<size_t>(code->instruction_end() - old_addr);
-
-  HeapObject* result;
-  AllocationResult allocation =
-      AllocateRaw(new_obj_size, CODE_SPACE, CODE_SPACE);
-  if (!allocation.To(&result)) return allocation;
-
-  // Copy code object.
-  Address new_addr = result->address();
-
-  // Copy header and instructions.
-  CopyBytes(new_addr, old_addr, relocation_offset);
-
-  Code* new_code = Code::cast(result);
-  new_code->set_relocation_info(reloc_info_array);
-
-  // Update constant pool.
-  new_code->set_constant_pool(new_constant_pool);
-
-  // Copy patched rinfo.
-  CopyBytes(new_code->relocation_start(), reloc_info.start(),
-            static_cast<size_t>(reloc_info.length()));
-
-  // Relocate the copy.
-  DCHECK(isolate_->code_range() == NULL || !isolate_->code_range()->valid() ||
-         isolate_->code_range()->contains(code->address()));
-  new_code->Relocate(new_addr - old_addr);
-
-#ifdef VERIFY_HEAP
-  if (FLAG_verify_heap) code->ObjectVerify();
-#endif
-  return new_code;
-}
-
-
 void Heap::InitializeAllocationMemento(AllocationMemento* memento,
                                        AllocationSite* allocation_site) {
   memento->set_map_no_write_barrier(allocation_memento_map());
@@ -3713,8 +3782,20 @@ AllocationResult Heap::CopyJSObject(JSObject* source, AllocationSite* site) {
     Address clone_address = clone->address();
     CopyBlock(clone_address, source->address(), object_size);
     // Update write barrier for all fields that lie beyond the header.
-    RecordWrites(clone_address, JSObject::kHeaderSize,
-                 (object_size - JSObject::kHeaderSize) / kPointerSize);
+    if (map->HasUnboxedDoubleFields()) {
+      int offset = JSObject::kHeaderSize;
+      while (offset < object_size) {
+        int end_offset;
+        if (map->IsTaggedRun(offset, object_size, &end_offset)) {
+          RecordWrites(clone_address, offset,
+                       (end_offset - offset) / kPointerSize);
+        }
+        offset = end_offset;
+      }
+    } else {
+      RecordWrites(clone_address, JSObject::kHeaderSize,
+                   (object_size - JSObject::kHeaderSize) / kPointerSize);
+    }
   } else {
     wb_mode = SKIP_WRITE_BARRIER;
 
@@ -4267,9 +4348,38 @@ void Heap::MakeHeapIterable() {
 }
 
 
-void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size) {
-  incremental_marking()->Step(step_size,
-                              IncrementalMarking::NO_GC_VIA_STACK_GUARD, true);
+// Returns a high resolution monotonic time stamp for idle time accounting.
+static double IdleTimeNowInMs() {
+  return (base::TimeTicks::HighResolutionNow() - base::TimeTicks())
+      .InMillisecondsF();
+}
+
+
+void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size,
+                                         double deadline_in_ms) {
+  // The step size is a conservative estimate. Marking is done in slices and
+  // continues as long as another slice is expected to fit before the
+  // deadline, so that the idle period is not cut short by the estimate.
+  static const intptr_t kMinIdleMarkingSliceSize = 64 * KB;
+  static const int kIdleMarkingSlicesPerStep = 4;
+  intptr_t slice_size =
+      Max(step_size / kIdleMarkingSlicesPerStep, kMinIdleMarkingSliceSize);
+  intptr_t bytes_marked = 0;
+  double now = IdleTimeNowInMs();
+  double slice_duration = 0.0;
+  do {
+    double slice_start = now;
+    incremental_marking()->Step(
+        slice_size, IncrementalMarking::NO_GC_VIA_STACK_GUARD, true);
+    bytes_marked += slice_size;
+    now = IdleTimeNowInMs();
+    slice_duration = now - slice_start;
+    // Steps that make no progress (e.g. while waiting for sweeping) must not
+    // spin until the deadline.
+  } while (!incremental_marking()->IsComplete() &&
+           !incremental_marking()->IsStopped() &&
+           bytes_marked < 2 * step_size &&
+           now + slice_duration <= deadline_in_ms);
 
   if (incremental_marking()->IsComplete()) {
     bool uncommit = false;
@@ -4290,6 +4400,77 @@ void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size) {
 }
 
 
+void Heap::NotifyMemoryReducer(MemoryReducer::EventType type,
+                               bool next_gc_likely_to_collect_more) {
+  if (!FLAG_memory_reducer) return;
+  MemoryReducer::Event event;
+  event.type = type;
+  event.time_ms = base::OS::TimeCurrentMillis();
+  event.low_allocation_rate =
+      static_cast<size_t>(
+          tracer()->CurrentNewSpaceAllocationThroughputInBytesPerMillisecond()) <=
+      MemoryReducer::kLowAllocationThroughput;
+  event.can_start_incremental_marking =
+      incremental_marking()->IsStopped() &&
+      incremental_marking()->WorthActivating();
+  event.next_gc_likely_to_collect_more = next_gc_likely_to_collect_more;
+
+  bool was_reducing_memory = memory_reducer_.ShouldReduceMemory();
+  if (memory_reducer_.NotifyEvent(event)) {
+    if (FLAG_trace_gc_verbose) {
+      PrintF("Memory reducer: starting GC #%d\n",
+             memory_reducer_.state().started_gcs);
+    }
+    // Evacuation candidates are selected when marking starts, so the
+    // memory-reducing flag has to be set at this point already.
+    mark_compact_collector()->SetFlags(kReduceMemoryFootprintMask);
+    incremental_marking()->Start();
+    mark_compact_collector()->SetFlags(kNoGCFlags);
+  } else if (was_reducing_memory && type == MemoryReducer::kMarkCompact) {
+    new_space_.Shrink();
+    UncommitFromSpace();
+  }
+  if (memory_reducer_.state().action == MemoryReducer::kWait) {
+    ScheduleMemoryReducerTimer();
+  }
+}
+
+
+// Sends a timer event to the memory reducer. The task is owned by the
+// platform and may outlive the heap, in which case it does nothing.
+class Heap::MemoryReducerTimerTask : public v8::Task {
+ public:
+  explicit MemoryReducerTimerTask(Heap* heap)
+      : heap_(heap), heap_is_torn_down_(false) {}
+
+  void NotifyHeapTearDown() { heap_is_torn_down_ = true; }
+
+  virtual void Run() OVERRIDE {
+    if (heap_is_torn_down_) return;
+    heap_->memory_reducer_timer_task_ = NULL;
+    HandleScope scope(heap_->isolate());
+    heap_->NotifyMemoryReducer(MemoryReducer::kTimer, false);
+  }
+
+ private:
+  Heap* heap_;
+  bool heap_is_torn_down_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryReducerTimerTask);
+};
+
+
+void Heap::ScheduleMemoryReducerTimer() {
+  if (memory_reducer_timer_task_ != NULL) return;
+  double delay_ms =
+      memory_reducer_.state().next_gc_start_ms - base::OS::TimeCurrentMillis();
+  memory_reducer_timer_task_ = new MemoryReducerTimerTask(this);
+  V8::GetCurrentPlatform()->CallDelayedOnForegroundThread(
+      reinterpret_cast<v8::Isolate*>(isolate()), memory_reducer_timer_task_,
+      Max(delay_ms, 0.0) / base::Time::kMillisecondsPerSecond);
+}
+
+
 bool Heap::WorthActivatingIncrementalMarking() {
   return incremental_marking()->IsStopped() &&
          incremental_marking()->WorthActivating() && NextGCIsLikelyToBeFull();
@@ -4297,12 +4478,35 @@ bool Heap::WorthActivatingIncrementalMarking() {
 
 
 bool Heap::IdleNotification(int idle_time_in_ms) {
+  return PerformIdleTimeAction(static_cast<double>(idle_time_in_ms));
+}
+
+
+bool Heap::IdleNotificationDeadline(double deadline_in_seconds) {
+  double idle_time_in_seconds =
+      deadline_in_seconds -
+      V8::GetCurrentPlatform()->MonotonicallyIncreasingTime();
+  return PerformIdleTimeAction(
+      Max(idle_time_in_seconds, 0.0) *
+      static_cast<double>(base::Time::kMillisecondsPerSecond));
+}
+
+
+void Heap::PostBlockingBackgroundTask(v8::Task* task) {
+  V8::GetCurrentPlatform()->CallOnBackgroundThreadWithPriority(
+      reinterpret_cast<v8::Isolate*>(isolate()), task,
+      v8::Platform::kShortRunningTask, v8::Platform::kUserBlockingPriority);
+}
+
+
+bool Heap::PerformIdleTimeAction(double idle_time_in_ms) {
   // If incremental marking is off, we do not perform idle notification.
   if (!FLAG_incremental_marking) return true;
-  base::ElapsedTimer timer;
-  timer.Start();
+  NotifyMemoryReducer(MemoryReducer::kTimer, false);
+  double start_time = IdleTimeNowInMs();
+  double deadline_in_ms = start_time + idle_time_in_ms;
   isolate()->counters()->gc_idle_time_allotted_in_ms()->AddSample(
-      idle_time_in_ms);
+      static_cast<int>(idle_time_in_ms));
   HistogramTimerScope idle_notification_scope(
       isolate_->counters()->gc_idle_notification());
 
@@ -4329,6 +4533,16 @@ bool Heap::IdleNotification(int idle_time_in_ms) {
 
   GCIdleTimeAction action =
       gc_idle_time_handler_.Compute(idle_time_in_ms, heap_state);
+  // A memory-reducing GC is not part of the idle round, so keep marking even
+  // if the idle round is over.
+  if ((action.type == DONE || action.type == DO_NOTHING) &&
+      idle_time_in_ms > 0 && memory_reducer_.ShouldReduceMemory() &&
+      !heap_state.incremental_marking_stopped) {
+    action = GCIdleTimeAction::IncrementalMarking(
+        GCIdleTimeHandler::EstimateMarkingStepSize(
+            idle_time_in_ms,
+            heap_state.incremental_marking_speed_in_bytes_per_ms));
+  }
 
   bool result = false;
   switch (action.type) {
@@ -4339,7 +4553,7 @@ bool Heap::IdleNotification(int idle_time_in_ms) {
       if (incremental_marking()->IsStopped()) {
         incremental_marking()->Start();
       }
-      AdvanceIdleIncrementalMarking(action.parameter);
+      AdvanceIdleIncrementalMarking(action.parameter, deadline_in_ms);
       break;
     case DO_FULL_GC: {
       HistogramTimerScope scope(isolate_->counters()->gc_context());
@@ -4360,20 +4574,21 @@ bool Heap::IdleNotification(int idle_time_in_ms) {
       break;
   }
 
-  int actual_time_ms = static_cast<int>(timer.Elapsed().InMilliseconds());
+  double actual_time_ms = IdleTimeNowInMs() - start_time;
   if (actual_time_ms <= idle_time_in_ms) {
     if (action.type != DONE && action.type != DO_NOTHING) {
       isolate()->counters()->gc_idle_time_limit_undershot()->AddSample(
-          idle_time_in_ms - actual_time_ms);
+          static_cast<int>(idle_time_in_ms - actual_time_ms));
     }
   } else {
     isolate()->counters()->gc_idle_time_limit_overshot()->AddSample(
-        actual_time_ms - idle_time_in_ms);
+        static_cast<int>(actual_time_ms - idle_time_in_ms));
   }
 
   if (FLAG_trace_idle_notification) {
-    PrintF("Idle notification: requested idle time %d ms, actual time %d ms [",
-           idle_time_in_ms, actual_time_ms);
+    PrintF(
+        "Idle notification: requested idle time %.2f ms, actual time %.2f ms [",
+        idle_time_in_ms, actual_time_ms);
     action.Print();
     PrintF("]\n");
   }
@@ -4540,9 +4755,9 @@ void Heap::ZapFromSpace() {
 }
 
 
-void Heap::IterateAndMarkPointersToFromSpace(Address start, Address end,
-                                             ObjectSlotCallback callback) {
-  Address slot_address = start;
+void Heap::IteratePointersToFromSpace(HeapObject* target, int size,
+                                      ObjectSlotCallback callback) {
+  Address obj_address = target->address();
 
   // We are not collecting slots on new space objects during mutation
   // thus we have to scan for pointers to evacuation candidates when we
@@ -4552,10 +4767,35 @@ void Heap::IterateAndMarkPointersToFromSpace(Address start, Address end,
   // it would be a violation of the invariant to record it's slots.
   bool record_slots = false;
   if (incremental_marking()->IsCompacting()) {
-    MarkBit mark_bit = Marking::MarkBitFrom(HeapObject::FromAddress(start));
+    MarkBit mark_bit = Marking::MarkBitFrom(target);
     record_slots = Marking::IsBlack(mark_bit);
   }
 
+  // Unboxed double fields of promoted objects must not be mistaken for
+  // pointers, only the runs of tagged slots are iterated.
+  Map* map = target->map();
+  if (!map->HasUnboxedDoubleFields()) {
+    IterateAndMarkPointersToFromSpace(record_slots, obj_address,
+                                      obj_address + size, callback);
+    return;
+  }
+  int offset = 0;
+  while (offset < size) {
+    int end_offset;
+    if (map->IsTaggedRun(offset, size, &end_offset)) {
+      IterateAndMarkPointersToFromSpace(record_slots, obj_address + offset,
+                                        obj_address + end_offset, callback);
+    }
+    offset = end_offset;
+  }
+}
+
+
+void Heap::IterateAndMarkPointersToFromSpace(bool record_slots, Address start,
+                                             Address end,
+                                             ObjectSlotCallback callback) {
+  Address slot_address = start;
+
   while (slot_address < end) {
     Object** slot = reinterpret_cast<Object**>(slot_address);
     Object* object = *slot;
@@ -4912,6 +5152,7 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
   max_old_generation_size_ =
       Max(static_cast<intptr_t>(paged_space_count * Page::kPageSize),
           max_old_generation_size_);
+  initial_max_old_generation_size_ = max_old_generation_size_;
 
   // We rely on being able to allocate new arrays in paged spaces.
   DCHECK(Page::kMaxRegularHeapObjectSize >=
@@ -4984,6 +5225,36 @@ int64_t Heap::PromotedExternalMemorySize() {
 }
 
 
+bool Heap::StartIncrementalMarkingForLargeObjectAllocation(int object_size) {
+  if (!FLAG_incremental_large_object_gc) return false;
+  if (!incremental_marking()->IsStopped() ||
+      !incremental_marking()->WorthActivating()) {
+    return false;
+  }
+  intptr_t old_generation_growth =
+      PromotedSpaceSizeOfObjects() - old_generation_size_at_last_gc_;
+  intptr_t large_object_growth =
+      lo_space_->SizeOfObjects() - large_object_size_at_last_gc_;
+  if (large_object_growth * 2 < old_generation_growth) return false;
+  // Marking runs concurrently with further allocation, so allow at most
+  // another growth step beyond the limit before falling back to a full GC.
+  intptr_t slack = Max(old_generation_allocation_limit_ -
+                           old_generation_size_at_last_gc_,
+                       kMinimumOldGenerationAllocationLimit);
+  if (OldGenerationSpaceAvailable() + slack < object_size ||
+      OldGenerationCapacityAvailable() < object_size) {
+    return false;
+  }
+  if (FLAG_trace_incremental_marking) {
+    PrintF("[IncrementalMarking] Start (large object allocation of %d bytes, "
+           "%" V8_PTR_PREFIX "d KB of large objects since last GC)\n",
+           object_size, large_object_growth / KB);
+  }
+  incremental_marking()->Start(IncrementalMarking::PREVENT_COMPACTION);
+  return !incremental_marking()->IsStopped();
+}
+
+
 intptr_t Heap::OldGenerationAllocationLimit(intptr_t old_gen_size,
                                             int freed_global_handles) {
   const int kMaxHandles = 1000;
@@ -5294,6 +5565,11 @@ void Heap::TearDown() {
   store_buffer()->TearDown();
   incremental_marking()->TearDown();
 
+  if (memory_reducer_timer_task_ != NULL) {
+    memory_reducer_timer_task_->NotifyHeapTearDown();
+    memory_reducer_timer_task_ = NULL;
+  }
+
   isolate_->memory_allocator()->TearDown();
 }
 
@@ -5340,6 +5616,36 @@ void Heap::RemoveGCEpilogueCallback(v8::Isolate::GCEpilogueCallback callback) {
 }
 
 
+void Heap::SetNearHeapLimitCallback(v8::Isolate::NearHeapLimitCallback callback,
+                                    void* data) {
+  near_heap_limit_callback_ = callback;
+  near_heap_limit_callback_data_ = data;
+}
+
+
+bool Heap::InvokeNearHeapLimitCallback() {
+  if (near_heap_limit_callback_ == NULL) return false;
+  HandleScope scope(isolate());
+  size_t heap_limit = near_heap_limit_callback_(
+      near_heap_limit_callback_data_,
+      static_cast<size_t>(max_old_generation_size_),
+      static_cast<size_t>(initial_max_old_generation_size_));
+  if (heap_limit <= static_cast<size_t>(max_old_generation_size_)) {
+    return false;
+  }
+  max_old_generation_size_ = static_cast<intptr_t>(heap_limit);
+  PagedSpaces spaces(this);
+  for (PagedSpace* space = spaces.next(); space != NULL;
+       space = spaces.next()) {
+    space->SetMaxCapacity(max_old_generation_size_);
+  }
+  lo_space_->set_max_capacity(max_old_generation_size_);
+  old_generation_allocation_limit_ =
+      OldGenerationAllocationLimit(PromotedSpaceSizeOfObjects(), 0);
+  return true;
+}
+
+
 // TODO(ishell): Find a better place for this.
 void Heap::AddWeakObjectToCodeDependency(Handle<Object> obj,
                                          Handle<DependentCode> dep) {
@@ -5908,13 +6214,16 @@ int KeyedLookupCache::Hash(Handle<Map> map, Handle<Name> name) {
 
 int KeyedLookupCache::Lookup(Handle<Map> map, Handle<Name> name) {
   DisallowHeapAllocation no_gc;
+  Counters* counters = map->GetIsolate()->counters();
   int index = (Hash(map, name) & kHashMask);
   for (int i = 0; i < kEntriesPerBucket; i++) {
     Key& key = keys_[index + i];
     if ((key.map == *map) && key.name->Equals(*name)) {
+      counters->keyed_lookup_cache_hits()->Increment();
       return field_offsets_[index + i];
     }
   }
+  counters->keyed_lookup_cache_misses()->Increment();
   return kNotFound;
 }
 
@@ -5936,7 +6245,7 @@ void KeyedLookupCache::Update(Handle<Map> map, Handle<Name> name,
   // After a GC there will be free slots, so we use them in order (this may
   // help to get the most frequently used one in position 0).
   for (int i = 0; i < kEntriesPerBucket; i++) {
-    Key& key = keys_[index];
+    Key& key = keys_[index + i];
     Object* free_entry_indicator = NULL;
     if (key.map == free_entry_indicator) {
       key.map = *map;
@@ -15,6 +15,7 @@
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact.h"
+#include "src/heap/memory-reducer.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/spaces.h"
 #include "src/heap/store-buffer.h"
@@ -22,6 +23,9 @@
 #include "src/splay-tree-inl.h"
 
 namespace v8 {
+
+class Task;
+
 namespace internal {
 
 // Defines all the roots in Heap.
@@ -45,6 +49,9 @@ namespace internal {
   V(Map, meta_map, MetaMap)                                                    \
   V(Map, heap_number_map, HeapNumberMap)                                       \
   V(Map, mutable_heap_number_map, MutableHeapNumberMap)                        \
+  V(Map, float32x4_map, Float32x4Map)                                          \
+  V(Map, int32x4_map, Int32x4Map)                                              \
+  V(Map, float64x2_map, Float64x2Map)                                          \
   V(Map, native_context_map, NativeContextMap)                                 \
   V(Map, fixed_array_map, FixedArrayMap)                                       \
   V(Map, code_map, CodeMap)                                                    \
@@ -180,7 +187,8 @@ namespace internal {
     EmptySlowElementDictionary)                                                \
   V(FixedArray, materialized_objects, MaterializedObjects)                     \
   V(FixedArray, allocation_sites_scratchpad, AllocationSitesScratchpad)        \
-  V(FixedArray, microtask_queue, MicrotaskQueue)
+  V(FixedArray, microtask_queue, MicrotaskQueue)                               \
+  V(FixedArray, object_keys_cache, ObjectKeysCache)
 
 // Entries in this list are limited to Smis and are not visited during GC.
 #define SMI_ROOT_LIST(V)                                                   \
@@ -216,6 +224,9 @@ namespace internal {
   V(meta_map)                           \
   V(heap_number_map)                    \
   V(mutable_heap_number_map)            \
+  V(float32x4_map)                      \
+  V(int32x4_map)                        \
+  V(float64x2_map)                      \
   V(native_context_map)                 \
   V(fixed_array_map)                    \
   V(code_map)                           \
@@ -287,6 +298,9 @@ namespace internal {
   V(String_string, "String")                               \
   V(symbol_string, "symbol")                               \
   V(Symbol_string, "Symbol")                               \
+  V(float32x4_string, "float32x4")                         \
+  V(int32x4_string, "int32x4")                             \
+  V(float64x2_string, "float64x2")                         \
   V(Map_string, "Map")                                     \
   V(Set_string, "Set")                                     \
   V(WeakMap_string, "WeakMap")                             \
@@ -301,6 +315,8 @@ namespace internal {
   V(undefined_string, "undefined")                         \
   V(value_of_string, "valueOf")                            \
   V(stack_string, "stack")                                 \
+  V(stack_trace_limit_string, "stackTraceLimit")           \
+  V(builtins_error_string, "$Error")                       \
   V(toJSON_string, "toJSON")                               \
   V(KeyedLoadMonomorphic_string, "KeyedLoadMonomorphic")   \
   V(KeyedStoreMonomorphic_string, "KeyedStoreMonomorphic") \
@@ -322,7 +338,12 @@ namespace internal {
   V(value_string, "value")                                 \
   V(next_string, "next")                                   \
   V(byte_length_string, "byteLength")                      \
-  V(byte_offset_string, "byteOffset")
+  V(byte_offset_string, "byteOffset")                      \
+  V(get_string, "get")                                     \
+  V(set_string, "set")                                     \
+  V(has_string, "has")                                     \
+  V(add_string, "add")                                     \
+  V(update_string, "update")
 
 #define PRIVATE_SYMBOL_LIST(V)      \
   V(frozen_symbol)                  \
@@ -558,6 +579,10 @@ class Heap {
   int ReservedSemiSpaceSize() { return reserved_semispace_size_; }
   int InitialSemiSpaceSize() { return initial_semispace_size_; }
   intptr_t MaxOldGenerationSize() { return max_old_generation_size_; }
+  // The size of the old generation at which the next full GC is started.
+  intptr_t old_generation_allocation_limit() const {
+    return old_generation_allocation_limit_;
+  }
   intptr_t MaxExecutableSize() { return max_executable_size_; }
 
   // Returns the capacity of the heap in bytes w/o growing. Heap grows when
@@ -765,6 +790,13 @@ class Heap {
                              GCType gc_type_filter, bool pass_isolate = true);
   void RemoveGCEpilogueCallback(v8::Isolate::GCEpilogueCallback callback);
 
+  void SetNearHeapLimitCallback(v8::Isolate::NearHeapLimitCallback callback,
+                                void* data);
+
+  // Asks the embedder for a larger old generation limit and adopts it.
+  // Returns true if the limit was raised.
+  bool InvokeNearHeapLimitCallback();
+
 // Heap root getters.  We have versions with and without type::cast() here.
 // You can't use type::cast during GC because the assert fails.
 // TODO(1490): Try removing the unchecked accessors, now that GC marking does
@@ -835,9 +867,15 @@ class Heap {
   // Iterates over all the other roots in the heap.
   void IterateWeakRoots(ObjectVisitor* v, VisitMode mode);
 
+  // Iterate pointers to from semispace of new space found in the promoted
+  // object |target| of the given size.
+  void IteratePointersToFromSpace(HeapObject* target, int size,
+                                  ObjectSlotCallback callback);
+
   // Iterate pointers to from semispace of new space found in memory interval
-  // from start to end.
-  void IterateAndMarkPointersToFromSpace(Address start, Address end,
+  // from start to end within an object.
+  void IterateAndMarkPointersToFromSpace(bool record_slots, Address start,
+                                         Address end,
                                          ObjectSlotCallback callback);
 
   // Returns whether the object resides in new space.
@@ -1060,6 +1098,15 @@ class Heap {
   // Implements the corresponding V8 API function.
   bool IdleNotification(int idle_time_in_ms);
 
+  // Same as above, but the end of the idle period is given as a deadline on
+  // the platform's monotonic clock.
+  bool IdleNotificationDeadline(double deadline_in_seconds);
+
+  // Posts a background task that the main thread is going to wait for, e.g.
+  // a parallel GC phase, with the highest priority so that it does not
+  // queue behind other isolates' compile jobs.
+  void PostBlockingBackgroundTask(v8::Task* task);
+
   // Declare all the root indices.  This defines the root list order.
   enum RootListIndex {
 #define ROOT_INDEX_DECLARATION(type, name, camel_name) k##camel_name##RootIndex,
@@ -1101,6 +1148,12 @@ class Heap {
   // Generated code can treat direct references to this root as constant.
   bool RootCanBeTreatedAsConstant(RootListIndex root_index);
 
+  // Returns the size of the objects that the constant roots point to
+  // directly (oddballs, maps, internalized strings of the root list, ...).
+  // Each isolate holds its own copy of them, so this is an estimate of the
+  // memory a read-only space shared between isolates could save.
+  intptr_t SizeOfConstantRoots();
+
   Map* MapForFixedTypedArray(ExternalArrayType array_type);
   RootListIndex RootIndexForFixedTypedArray(ExternalArrayType array_type);
 
@@ -1175,8 +1228,6 @@ class Heap {
 
   void ClearJSFunctionResultCaches();
 
-  void ClearNormalizedMapCaches();
-
   GCTracer* tracer() { return &tracer_; }
 
   // Returns the size of objects residing in non new spaces.
@@ -1232,6 +1283,13 @@ class Heap {
 
   inline bool OldGenerationAllocationLimitReached();
 
+  // Called when a large object allocation of the given size hits the old
+  // generation allocation limit. If large objects account for most of the
+  // old generation growth since the last mark-compact, an incremental marking
+  // cycle is started to reclaim the dead ones and true is returned, so the
+  // allocation can proceed instead of forcing an atomic full GC.
+  bool StartIncrementalMarkingForLargeObjectAllocation(int object_size);
+
   inline void DoScavengeObject(Map* map, HeapObject** slot, HeapObject* obj) {
     scavenging_visitors_table_.GetVisitor(map)(map, slot, obj);
   }
@@ -1408,15 +1466,17 @@ class Heap {
       AllocateHeapNumber(double value, MutableMode mode = IMMUTABLE,
                          PretenureFlag pretenure = NOT_TENURED);
 
+  // Allocates a SIMD value with the given lanes.
+#define SIMD_ALLOCATE_DECLARATION(TYPE, Type, type, lane_count, lane_type) \
+  MUST_USE_RESULT AllocationResult Allocate##Type(                         \
+      lane_type lanes[lane_count], PretenureFlag pretenure = NOT_TENURED);
+  SIMD128_TYPES(SIMD_ALLOCATE_DECLARATION)
+#undef SIMD_ALLOCATE_DECLARATION
+
   // Allocate a byte array of the specified length
   MUST_USE_RESULT AllocationResult
       AllocateByteArray(int length, PretenureFlag pretenure = NOT_TENURED);
 
-  // Copy the code and scope info part of the code object, but insert
-  // the provided data as the relocation information.
-  MUST_USE_RESULT AllocationResult
-      CopyCode(Code* code, Vector<byte> reloc_info);
-
   MUST_USE_RESULT AllocationResult CopyCode(Code* code);
 
   // Allocates a fixed array initialized with undefined values
@@ -1526,6 +1586,11 @@ class Heap {
   // generation and on every allocation in large object space.
   intptr_t old_generation_allocation_limit_;
 
+  // Size of the old generation and of the large object space right after the
+  // last mark-compact.
+  intptr_t old_generation_size_at_last_gc_;
+  intptr_t large_object_size_at_last_gc_;
+
   // Indicates that an allocation has failed in the old generation since the
   // last GC.
   bool old_gen_exhausted_;
@@ -1607,6 +1672,16 @@ class Heap {
   };
   List<GCEpilogueCallbackPair> gc_epilogue_callbacks_;
 
+  v8::Isolate::NearHeapLimitCallback near_heap_limit_callback_;
+  void* near_heap_limit_callback_data_;
+
+  // The old generation limit before any near heap limit callback raised it.
+  intptr_t initial_max_old_generation_size_;
+
+  // A full GC that leaves less than this fraction of the old generation limit
+  // free gives the near heap limit callback a chance to run.
+  static const int kNearHeapLimitFraction = 8;
+
   // Support for computing object sizes during GC.
   HeapObjectCallback gc_safe_size_of_old_object_;
   static int GcSafeSizeOfOldObject(HeapObject* object);
@@ -1920,6 +1995,9 @@ class Heap {
   static const int kOldSurvivalRateLowThreshold = 10;
 
   int high_survival_rate_period_length_;
+  // Set during a scavenge that promotes every surviving object directly,
+  // because nearly all of new space survived the previous one.
+  bool promote_all_survivors_;
   intptr_t promoted_objects_size_;
   double promotion_rate_;
   intptr_t semi_space_copied_object_size_;
@@ -1940,7 +2018,24 @@ class Heap {
 
   void SelectScavengingVisitorsTable();
 
-  void AdvanceIdleIncrementalMarking(intptr_t step_size);
+  void AdvanceIdleIncrementalMarking(intptr_t step_size,
+                                     double deadline_in_ms);
+
+  // Performs the garbage collection work chosen by the idle time handler for
+  // the given amount of idle time.
+  bool PerformIdleTimeAction(double idle_time_in_ms);
+
+  // Sends an event to the memory reducer and starts incremental marking in
+  // memory-reducing mode if it asks for a GC.
+  void NotifyMemoryReducer(MemoryReducer::EventType type,
+                           bool next_gc_likely_to_collect_more);
+
+  // Posts a delayed task that sends the memory reducer a timer event once
+  // it is due to start its next GC, so that it does not depend on the
+  // embedder sending idle notifications.
+  void ScheduleMemoryReducerTimer();
+
+  class MemoryReducerTimerTask;
 
   bool WorthActivatingIncrementalMarking();
 
@@ -1998,6 +2093,9 @@ class Heap {
   GCIdleTimeHandler gc_idle_time_handler_;
   unsigned int gc_count_at_last_idle_gc_;
 
+  MemoryReducer memory_reducer_;
+  MemoryReducerTimerTask* memory_reducer_timer_task_;
+
   // These two counters are monotomically increasing and never reset.
   size_t full_codegen_bytes_generated_;
   size_t crankshaft_codegen_bytes_generated_;
@@ -2263,7 +2361,7 @@ class KeyedLookupCache {
   // Clear the cache.
   void Clear();
 
-  static const int kLength = 256;
+  static const int kLength = 512;
   static const int kCapacityMask = kLength - 1;
   static const int kMapHashShift = 5;
   static const int kHashMask = -4;  // Zero the last two bits.
@@ -2313,7 +2411,10 @@ class KeyedLookupCache {
 // Cache for mapping (map, property name) into descriptor index.
 // The cache contains both positive and negative results.
 // Descriptor index equals kNotFound means the property is absent.
-// Cleared at startup and prior to any gc.
+// The cache is set associative; the entries of a bucket are kept in most
+// recently used order. Maps and unique names are never allocated in new
+// space, so the cache survives scavenges and is cleared at startup and
+// prior to any mark-compact gc.
 class DescriptorLookupCache {
  public:
   // Lookup descriptor index for (map, name).
@@ -2321,16 +2422,30 @@ class DescriptorLookupCache {
   int Lookup(Map* source, Name* name) {
     if (!name->IsUniqueName()) return kAbsent;
     int index = Hash(source, name);
-    Key& key = keys_[index];
-    if ((key.source == source) && (key.name == name)) return results_[index];
+    for (int i = 0; i < kEntriesPerBucket; i++) {
+      Key& key = keys_[index + i];
+      if ((key.source == source) && (key.name == name)) {
+        int result = results_[index + i];
+        if (i > 0) {
+          // Move the entry to the front of its bucket.
+          MoveDown(index, i);
+          keys_[index].source = source;
+          keys_[index].name = name;
+          results_[index] = result;
+        }
+        return result;
+      }
+    }
     return kAbsent;
   }
 
-  // Update an element in the cache.
+  // Update an element in the cache. The least recently used entry of the
+  // bucket is evicted.
   void Update(Map* source, Name* name, int result) {
     DCHECK(result != kAbsent);
     if (name->IsUniqueName()) {
       int index = Hash(source, name);
+      MoveDown(index, kEntriesPerBucket - 1);
       Key& key = keys_[index];
       key.source = source;
       key.name = name;
@@ -2360,10 +2475,21 @@ class DescriptorLookupCache {
     uint32_t name_hash =
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name)) >>
         kPointerSizeLog2;
-    return (source_hash ^ name_hash) % kLength;
+    return ((source_hash ^ name_hash) * kEntriesPerBucket) % kLength;
   }
 
-  static const int kLength = 64;
+  // Moves the first |count| entries of the bucket at |index| down by one,
+  // overwriting the entry at position |count|.
+  void MoveDown(int index, int count) {
+    for (int i = index + count; i > index; i--) {
+      keys_[i] = keys_[i - 1];
+      results_[i] = results_[i - 1];
+    }
+  }
+
+  static const int kLength = 256;
+  static const int kEntriesPerBucket = 4;
+  STATIC_ASSERT(kLength % kEntriesPerBucket == 0);
   struct Key {
     Map* source;
     Name* name;
@@ -2394,6 +2520,8 @@ class RegExpResultsCache {
   static const int kRegExpResultsCacheSize = 0x100;
 
  private:
+  static bool IsCacheableSubject(String* subject, ResultsCacheType type);
+
   static const int kArrayEntriesPerCacheEntry = 4;
   static const int kStringOffset = 0;
   static const int kPatternOffset = 1;
@@ -2401,6 +2529,31 @@ class RegExpResultsCache {
 };
 
 
+// Cache for the result of Object.keys on fast-mode objects without elements,
+// whose own enumerable keys only depend on their map. Lets all objects of a
+// map share one copy-on-write keys array. Cleared at every mark-compact.
+class ObjectKeysCache {
+ public:
+  // Attempt to retrieve the cached keys of {object}. On failure, 0 is
+  // returned as a Smi. On success, the result is a COW-array.
+  static Object* Lookup(Heap* heap, JSObject* object);
+  // Attempt to cache {keys} for the map of {object}. On success, {keys} is
+  // turned into a COW-array.
+  static void Enter(Isolate* isolate, Handle<JSObject> object,
+                    Handle<FixedArray> keys);
+  static void Clear(FixedArray* cache);
+  static const int kObjectKeysCacheSize = 0x100;
+
+ private:
+  static bool IsCacheable(JSObject* object);
+  static int EntryIndex(Map* map);
+
+  static const int kEntrySize = 2;
+  static const int kMapOffset = 0;
+  static const int kKeysOffset = 1;
+};
+
+
 // Abstract base class for checking whether a weak object should be retained.
 class WeakObjectRetainer {
  public:
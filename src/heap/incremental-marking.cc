@@ -28,7 +28,8 @@ IncrementalMarking::IncrementalMarking(Heap* heap)
       marking_speed_(0),
       allocated_(0),
       no_marking_scope_depth_(0),
-      unscanned_bytes_of_large_object_(0) {}
+      unscanned_bytes_of_large_object_(0),
+      pending_marking_tasks_semaphore_(0) {}
 
 
 void IncrementalMarking::TearDown() { delete marking_deque_memory_; }
@@ -313,6 +314,14 @@ void IncrementalMarking::Initialize() {
 }
 
 
+void IncrementalMarking::MarkBlackAllocated(HeapObject* obj, int size) {
+  DCHECK(IsMarking());
+  MarkBit mark_bit = Marking::MarkBitFrom(obj);
+  DCHECK(Marking::IsWhite(mark_bit));
+  MarkBlackOrKeepGrey(obj, mark_bit, size);
+}
+
+
 void IncrementalMarking::SetOldSpacePageFlags(MemoryChunk* chunk,
                                               bool is_marking,
                                               bool is_compacting) {
@@ -691,6 +700,9 @@ intptr_t IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process) {
 
 
 void IncrementalMarking::ProcessMarkingDeque() {
+  while (UseParallelMarking(kMaxInt)) {
+    ProcessMarkingDequeInParallel(kMaxInt);
+  }
   Map* filler_map = heap_->one_pointer_filler_map();
   while (!marking_deque_.IsEmpty()) {
     HeapObject* obj = marking_deque_.Pop();
@@ -705,6 +717,249 @@ void IncrementalMarking::ProcessMarkingDeque() {
 }
 
 
+// State shared by the participants of a parallel incremental marking step.
+class IncrementalMarking::ParallelStep {
+ public:
+  explicit ParallelStep(intptr_t bytes_to_process)
+      : bytes_to_process_(bytes_to_process), bytes_processed_(0) {}
+
+  ParallelMarkingDeque* deque() { return &deque_; }
+
+  // Accounts for bytes processed by a participant. Returns false once the
+  // budget of the step is used up.
+  bool AccountForProcessedBytes(intptr_t bytes) {
+    return base::NoBarrier_AtomicIncrement(&bytes_processed_, bytes) <
+           bytes_to_process_;
+  }
+
+  bool HasBudget() {
+    return base::NoBarrier_Load(&bytes_processed_) < bytes_to_process_;
+  }
+
+  intptr_t bytes_processed() { return base::NoBarrier_Load(&bytes_processed_); }
+
+ private:
+  ParallelMarkingDeque deque_;
+  const intptr_t bytes_to_process_;
+  base::AtomicWord bytes_processed_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelStep);
+};
+
+
+// Incremental marking visitor used by the parallel markers. Like its
+// mark-compact counterpart it only handles objects with plain bodies and
+// defers everything else, including large objects scanned with a progress
+// bar and objects with slots to record, to the main thread. Deferred objects
+// stay grey until the main thread visits them.
+class IncrementalParallelMarkingVisitor {
+ public:
+  IncrementalParallelMarkingVisitor(Heap* heap,
+                                    IncrementalMarking::ParallelStep* step)
+      : step_(step),
+        segment_(new ParallelMarkingDeque::Segment()),
+        filler_map_(heap->one_pointer_filler_map()),
+        is_compacting_(heap->incremental_marking()->IsCompacting()),
+        unaccounted_bytes_(0) {}
+
+  ~IncrementalParallelMarkingVisitor() { delete segment_; }
+
+  void Run() {
+    ParallelMarkingDeque* deque = step_->deque();
+    while (true) {
+      while (!segment_->IsEmpty()) {
+        if (unaccounted_bytes_ >= kAccountingGranularity && !FlushBytes()) {
+          // Out of budget, give the remaining work back.
+          deque->Publish(segment_);
+          segment_ = new ParallelMarkingDeque::Segment();
+          deque->Leave();
+          deque->AddDeferred(deferred_);
+          return;
+        }
+        VisitObject(segment_->Pop());
+      }
+      FlushBytes();
+      ParallelMarkingDeque::Segment* stolen = deque->Steal();
+      if (stolen == NULL) break;
+      delete segment_;
+      segment_ = stolen;
+    }
+    deque->AddDeferred(deferred_);
+  }
+
+ private:
+  static const intptr_t kAccountingGranularity = 16 * KB;
+
+  bool FlushBytes() {
+    bool has_budget = step_->AccountForProcessedBytes(unaccounted_bytes_);
+    unaccounted_bytes_ = 0;
+    return has_budget;
+  }
+
+  void VisitObject(HeapObject* object) {
+    // Explicitly skip one word fillers. Incremental markbit patterns are
+    // correct only for objects that occupy at least two words.
+    Map* map = object->map();
+    if (map == filler_map_) return;
+
+    MarkBit mark_bit = Marking::MarkBitFrom(object);
+    MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+    int start_offset, end_offset;
+    if (!Marking::IsGrey(mark_bit) || chunk->owner()->identity() == LO_SPACE ||
+        !ParallelMarkingDeque::GetPlainBody(map, object, &start_offset,
+                                            &end_offset)) {
+      MarkGrey(map);
+      deferred_.Add(object);
+      return;
+    }
+
+    MarkGrey(map);
+    Object** start = HeapObject::RawField(object, start_offset);
+    Object** end = HeapObject::RawField(object, end_offset);
+    bool needs_slot_recording = false;
+    for (Object** p = start; p < end; p++) {
+      Object* value = *p;
+      if (!value->IsHeapObject()) continue;
+      if (is_compacting_ &&
+          MarkCompactCollector::IsOnEvacuationCandidate(value) &&
+          !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(start)) {
+        needs_slot_recording = true;
+      }
+      MarkGrey(HeapObject::cast(value));
+    }
+    if (needs_slot_recording) {
+      // Slots buffers are not thread-safe, the main thread visits the object
+      // again to record its slots.
+      deferred_.Add(object);
+      return;
+    }
+
+    int size = object->SizeFromMap(map);
+    mark_bit.Next().ClearAtomic();
+    MemoryChunk::IncrementLiveBytesFromGCAtomically(object->address(), size);
+    unaccounted_bytes_ += size;
+  }
+
+  void MarkGrey(HeapObject* object) {
+    MarkBit mark_bit = Marking::MarkBitFrom(object);
+    if (mark_bit.data_only()) {
+      // Data objects are marked black right away, see MarkBlackOrKeepGrey.
+      if (mark_bit.SetAtomic()) {
+        MemoryChunk::IncrementLiveBytesFromGCAtomically(object->address(),
+                                                        object->Size());
+      }
+      return;
+    }
+    // The first mark bit decides which marker turns the object grey.
+    if (!mark_bit.SetAtomic()) return;
+    mark_bit.Next().SetAtomic();
+    if (segment_->IsFull()) {
+      step_->deque()->Publish(segment_);
+      segment_ = new ParallelMarkingDeque::Segment();
+    }
+    segment_->Push(object);
+  }
+
+  IncrementalMarking::ParallelStep* step_;
+  ParallelMarkingDeque::Segment* segment_;
+  Map* filler_map_;
+  bool is_compacting_;
+  intptr_t unaccounted_bytes_;
+  List<HeapObject*> deferred_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalParallelMarkingVisitor);
+};
+
+
+class IncrementalMarking::MarkingTask : public v8::Task {
+ public:
+  MarkingTask(Heap* heap, ParallelStep* step) : heap_(heap), step_(step) {}
+
+  virtual ~MarkingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    heap_->incremental_marking()->MarkInParallel(step_);
+    heap_->incremental_marking()->pending_marking_tasks_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  ParallelStep* step_;
+
+  DISALLOW_COPY_AND_ASSIGN(MarkingTask);
+};
+
+
+void IncrementalMarking::MarkInParallel(ParallelStep* step) {
+  // Tasks that start after the step has finished have nothing to do.
+  if (!step->deque()->Join()) return;
+  IncrementalParallelMarkingVisitor visitor(heap_, step);
+  visitor.Run();
+}
+
+
+bool IncrementalMarking::UseParallelMarking(intptr_t bytes_to_process) {
+  // Starting tasks does not pay off for small steps.
+  static const intptr_t kMinBytesForParallelStep = 256 * KB;
+  static const int kMinObjectsForParallelStep =
+      2 * ParallelMarkingDeque::Segment::kCapacity;
+  if (!FLAG_parallel_incremental_marking || FLAG_track_gc_object_stats) {
+    return false;
+  }
+  int objects = (marking_deque_.top() - marking_deque_.bottom()) &
+                marking_deque_.mask();
+  return bytes_to_process >= kMinBytesForParallelStep &&
+         objects >= kMinObjectsForParallelStep;
+}
+
+
+intptr_t IncrementalMarking::ProcessMarkingDequeInParallel(
+    intptr_t bytes_to_process) {
+  ParallelStep step(bytes_to_process);
+  ParallelMarkingDeque* deque = step.deque();
+  ParallelMarkingDeque::Segment* segment = new ParallelMarkingDeque::Segment();
+  while (!marking_deque_.IsEmpty()) {
+    if (segment->IsFull()) {
+      deque->Publish(segment);
+      segment = new ParallelMarkingDeque::Segment();
+    }
+    segment->Push(marking_deque_.Pop());
+  }
+  deque->Publish(segment);
+
+  int tasks = MarkCompactCollector::NumberOfParallelMarkingTasks();
+  for (int i = 0; i < tasks; i++) {
+    heap_->PostBlockingBackgroundTask(new MarkingTask(heap_, &step));
+  }
+  MarkInParallel(&step);
+  for (int i = 0; i < tasks; i++) {
+    pending_marking_tasks_semaphore_.Wait();
+  }
+
+  // Work left over because the budget was used up goes back to the marking
+  // deque. All of these objects are grey.
+  while ((segment = deque->TryTake()) != NULL) {
+    while (!segment->IsEmpty()) {
+      marking_deque_.PushGrey(segment->Pop());
+    }
+    delete segment;
+  }
+
+  intptr_t bytes_processed = step.bytes_processed();
+  List<HeapObject*>* deferred = deque->deferred();
+  for (int i = 0; i < deferred->length(); i++) {
+    HeapObject* obj = deferred->at(i);
+    Map* map = obj->map();
+    int size = obj->SizeFromMap(map);
+    unscanned_bytes_of_large_object_ = 0;
+    VisitObject(map, obj, size);
+    bytes_processed += size - unscanned_bytes_of_large_object_;
+  }
+  return bytes_processed;
+}
+
+
 void IncrementalMarking::Hurry() {
   if (state() == MARKING) {
     double start = 0.0;
@@ -942,7 +1197,11 @@ void IncrementalMarking::Step(intptr_t allocated_bytes, CompletionAction action,
         StartMarking(PREVENT_COMPACTION);
       }
     } else if (state_ == MARKING) {
-      bytes_processed = ProcessMarkingDeque(bytes_to_process);
+      if (UseParallelMarking(bytes_to_process)) {
+        bytes_processed = ProcessMarkingDequeInParallel(bytes_to_process);
+      } else {
+        bytes_processed = ProcessMarkingDeque(bytes_to_process);
+      }
       if (marking_deque_.IsEmpty()) MarkingComplete(action);
     }
 
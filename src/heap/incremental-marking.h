@@ -127,6 +127,10 @@ class IncrementalMarking {
 
   inline void WhiteToGreyAndPush(HeapObject* obj, MarkBit mark_bit);
 
+  // Marks an object allocated by the runtime during marking as live, so that
+  // the marker never has to visit it.
+  void MarkBlackAllocated(HeapObject* obj, int size);
+
   inline void SetOldSpacePageFlags(MemoryChunk* chunk) {
     SetOldSpacePageFlags(chunk, IsMarking(), IsCompacting());
   }
@@ -165,7 +169,16 @@ class IncrementalMarking {
     unscanned_bytes_of_large_object_ = unscanned_bytes;
   }
 
+  class ParallelStep;
+
+  // Marks objects published to the deque of the given step until the deque
+  // is exhausted or the step's budget is used up. Runs on the main thread as
+  // well as on the parallel marking tasks.
+  void MarkInParallel(ParallelStep* step);
+
  private:
+  class MarkingTask;
+
   int64_t SpaceLeftInOldSpace();
 
   void SpeedUp();
@@ -193,6 +206,14 @@ class IncrementalMarking {
 
   INLINE(intptr_t ProcessMarkingDeque(intptr_t bytes_to_process));
 
+  // Parallel version of ProcessMarkingDeque. The main thread and background
+  // tasks drain the marking deque together while the mutator is stopped.
+  // Objects the parallel markers cannot handle are visited on the main thread
+  // afterwards. Returns the number of bytes processed.
+  intptr_t ProcessMarkingDequeInParallel(intptr_t bytes_to_process);
+
+  bool UseParallelMarking(intptr_t bytes_to_process);
+
   INLINE(void VisitObject(Map* map, HeapObject* obj, int size));
 
   Heap* heap_;
@@ -218,6 +239,8 @@ class IncrementalMarking {
 
   int unscanned_bytes_of_large_object_;
 
+  base::Semaphore pending_marking_tasks_semaphore_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(IncrementalMarking);
 };
 }
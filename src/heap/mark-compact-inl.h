@@ -32,6 +32,7 @@ void MarkCompactCollector::MarkObject(HeapObject* obj, MarkBit mark_bit) {
   if (!mark_bit.Get()) {
     mark_bit.Set();
     MemoryChunk::IncrementLiveBytesFromGC(obj->address(), obj->Size());
+    if (!pending_ephemerons_.is_empty()) pending_ephemerons_.KeyMarked(obj);
     DCHECK(IsMarked(obj));
     DCHECK(obj->GetIsolate()->heap()->Contains(obj));
     marking_deque_.PushBlack(obj);
@@ -44,6 +45,7 @@ void MarkCompactCollector::SetMark(HeapObject* obj, MarkBit mark_bit) {
   DCHECK(Marking::MarkBitFrom(obj) == mark_bit);
   mark_bit.Set();
   MemoryChunk::IncrementLiveBytesFromGC(obj->address(), obj->Size());
+  if (!pending_ephemerons_.is_empty()) pending_ephemerons_.KeyMarked(obj);
 }
 
 
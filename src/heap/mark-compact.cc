@@ -6,6 +6,7 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/bits.h"
+#include "src/base/sys-info.h"
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
 #include "src/cpu-profiler.h"
@@ -47,8 +48,11 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       was_marked_incrementally_(false),
       sweeping_in_progress_(false),
       pending_sweeper_jobs_semaphore_(0),
+      pending_marking_tasks_semaphore_(0),
+      pending_pointers_updating_tasks_semaphore_(0),
       sequential_sweeping_(false),
       migration_slots_buffer_(NULL),
+      scanned_weak_collections_(Smi::FromInt(0)),
       heap_(heap),
       code_flusher_(NULL),
       have_code_to_deoptimize_(false) {
@@ -286,6 +290,9 @@ class VerifyNativeContextSeparationVisitor : public ObjectVisitor {
           case FIXED_DOUBLE_ARRAY_TYPE:
           case HEAP_NUMBER_TYPE:
           case MUTABLE_HEAP_NUMBER_TYPE:
+          case FLOAT32X4_TYPE:
+          case INT32X4_TYPE:
+          case FLOAT64X2_TYPE:
           case INTERCEPTOR_INFO_TYPE:
           case ODDBALL_TYPE:
           case SCRIPT_TYPE:
@@ -556,12 +563,10 @@ void MarkCompactCollector::StartSweeperThreads() {
   DCHECK(free_list_old_pointer_space_.get()->IsEmpty());
   DCHECK(free_list_old_data_space_.get()->IsEmpty());
   sweeping_in_progress_ = true;
-  V8::GetCurrentPlatform()->CallOnBackgroundThread(
-      new SweeperTask(heap(), heap()->old_data_space()),
-      v8::Platform::kShortRunningTask);
-  V8::GetCurrentPlatform()->CallOnBackgroundThread(
-      new SweeperTask(heap(), heap()->old_pointer_space()),
-      v8::Platform::kShortRunningTask);
+  heap()->PostBlockingBackgroundTask(
+      new SweeperTask(heap(), heap()->old_data_space()));
+  heap()->PostBlockingBackgroundTask(
+      new SweeperTask(heap(), heap()->old_pointer_space()));
 }
 
 
@@ -1016,6 +1021,7 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
         shared->ShortPrint();
         PrintF(" - age: %d]\n", code->GetAge());
       }
+      RecordFlushedCode(shared);
       shared->set_code(lazy_compile);
       candidate->set_code(lazy_compile);
     } else {
@@ -1058,6 +1064,7 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
         candidate->ShortPrint();
         PrintF(" - age: %d]\n", code->GetAge());
       }
+      RecordFlushedCode(candidate);
       candidate->set_code(lazy_compile);
     }
 
@@ -1073,6 +1080,15 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::RecordFlushedCode(SharedFunctionInfo* shared) {
+  if (!shared->is_compiled()) return;
+  Counters* counters = isolate_->counters();
+  counters->code_flushed_functions()->Increment();
+  counters->code_flushed_size()->Increment(shared->code()->Size());
+  shared->set_code_flushed(true);
+}
+
+
 void CodeFlusher::ProcessOptimizedCodeMaps() {
   STATIC_ASSERT(SharedFunctionInfo::kEntryLength == 4);
 
@@ -1489,7 +1505,7 @@ class MarkCompactMarkingVisitor
   static void VisitRegExpAndFlushCode(Map* map, HeapObject* object) {
     Heap* heap = map->GetHeap();
     MarkCompactCollector* collector = heap->mark_compact_collector();
-    if (!collector->is_code_flushing_enabled()) {
+    if (!collector->is_code_flushing_enabled() || !FLAG_flush_regexp_code) {
       VisitJSRegExp(map, object);
       return;
     }
@@ -1765,6 +1781,12 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkBit mark_bit = Marking::MarkBitFrom(object);
     if (mark_bit.Get()) return;
 
+    if (collector_->UseParallelMarking()) {
+      // Leave the transitive closure to the parallel markers.
+      collector_->MarkObject(object, mark_bit);
+      return;
+    }
+
     Map* map = object->map();
     // Mark the object.
     collector_->SetMark(object, mark_bit);
@@ -2105,6 +2127,10 @@ void MarkCompactCollector::MarkWeakObjectToCodeTable() {
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
 void MarkCompactCollector::EmptyMarkingDeque() {
+  if (UseParallelMarking()) {
+    EmptyMarkingDequeInParallel();
+    return;
+  }
   while (!marking_deque_.IsEmpty()) {
     HeapObject* object = marking_deque_.Pop();
     DCHECK(object->IsHeapObject());
@@ -2120,6 +2146,319 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 }
 
 
+ParallelMarkingDeque::~ParallelMarkingDeque() {
+  while (pool_ != NULL) {
+    Segment* next = pool_->next();
+    delete pool_;
+    pool_ = next;
+  }
+}
+
+
+bool ParallelMarkingDeque::Join() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (done_) return false;
+  participants_++;
+  return true;
+}
+
+
+void ParallelMarkingDeque::Publish(Segment* segment) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  DCHECK(!done_);
+  segment->set_next(pool_);
+  pool_ = segment;
+  work_available_.NotifyOne();
+}
+
+
+void ParallelMarkingDeque::Leave() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  participants_--;
+  if (pool_ == NULL && idle_participants_ == participants_) {
+    done_ = true;
+    work_available_.NotifyAll();
+  }
+}
+
+
+ParallelMarkingDeque::Segment* ParallelMarkingDeque::Steal() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  idle_participants_++;
+  while (pool_ == NULL && !done_) {
+    if (idle_participants_ == participants_) {
+      done_ = true;
+      work_available_.NotifyAll();
+      break;
+    }
+    work_available_.Wait(&mutex_);
+  }
+  idle_participants_--;
+  if (pool_ == NULL) return NULL;
+  Segment* segment = pool_;
+  pool_ = segment->next();
+  return segment;
+}
+
+
+ParallelMarkingDeque::Segment* ParallelMarkingDeque::TryTake() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (pool_ == NULL) return NULL;
+  Segment* segment = pool_;
+  pool_ = segment->next();
+  return segment;
+}
+
+
+bool ParallelMarkingDeque::GetPlainBody(Map* map, HeapObject* object,
+                                        int* start_offset, int* end_offset) {
+  int id = map->visitor_id();
+  switch (id) {
+    case StaticVisitorBase::kVisitSeqOneByteString:
+    case StaticVisitorBase::kVisitSeqTwoByteString:
+    case StaticVisitorBase::kVisitByteArray:
+    case StaticVisitorBase::kVisitFreeSpace:
+    case StaticVisitorBase::kVisitFixedDoubleArray:
+    case StaticVisitorBase::kVisitFixedTypedArray:
+    case StaticVisitorBase::kVisitFixedFloat64Array:
+      *start_offset = *end_offset = 0;
+      return true;
+    case StaticVisitorBase::kVisitShortcutCandidate:
+    case StaticVisitorBase::kVisitConsString:
+      *start_offset = ConsString::BodyDescriptor::kStartOffset;
+      *end_offset = ConsString::BodyDescriptor::kEndOffset;
+      return true;
+    case StaticVisitorBase::kVisitSlicedString:
+      *start_offset = SlicedString::BodyDescriptor::kStartOffset;
+      *end_offset = SlicedString::BodyDescriptor::kEndOffset;
+      return true;
+    case StaticVisitorBase::kVisitSymbol:
+      *start_offset = Symbol::BodyDescriptor::kStartOffset;
+      *end_offset = Symbol::BodyDescriptor::kEndOffset;
+      return true;
+    case StaticVisitorBase::kVisitOddball:
+      *start_offset = Oddball::BodyDescriptor::kStartOffset;
+      *end_offset = Oddball::BodyDescriptor::kEndOffset;
+      return true;
+    case StaticVisitorBase::kVisitCell:
+      *start_offset = Cell::BodyDescriptor::kStartOffset;
+      *end_offset = Cell::BodyDescriptor::kEndOffset;
+      return true;
+    case StaticVisitorBase::kVisitFixedArray:
+      *start_offset = FixedArray::BodyDescriptor::kStartOffset;
+      *end_offset = FixedArray::BodyDescriptor::SizeOf(map, object);
+      return true;
+    default:
+      break;
+  }
+  if (id >= StaticVisitorBase::kVisitDataObject &&
+      id <= StaticVisitorBase::kVisitDataObjectGeneric) {
+    *start_offset = *end_offset = 0;
+    return true;
+  }
+  if (id >= StaticVisitorBase::kVisitJSObject &&
+      id <= StaticVisitorBase::kVisitJSObjectGeneric) {
+    if (map->HasUnboxedDoubleFields()) return false;
+    *start_offset = JSObject::BodyDescriptor::kStartOffset;
+    *end_offset = JSObject::BodyDescriptor::SizeOf(map, object);
+    return true;
+  }
+  if (id >= StaticVisitorBase::kVisitStruct &&
+      id <= StaticVisitorBase::kVisitStructGeneric) {
+    *start_offset = StructBodyDescriptor::kStartOffset;
+    *end_offset = StructBodyDescriptor::SizeOf(map, object);
+    return true;
+  }
+  return false;
+}
+
+
+void ParallelMarkingDeque::AddDeferred(const List<HeapObject*>& objects) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  deferred_.AddAll(objects);
+}
+
+
+// Marking visitor used by the parallel markers. It only handles objects whose
+// body consists of strong tagged fields and nothing else, which can be visited
+// with atomic mark bit updates alone. Everything else (maps, code, functions,
+// weak collections, ...) and every object holding a slot that has to be
+// recorded for compaction is deferred to the main thread, which visits it with
+// the regular marking visitor after the parallel phase.
+class ParallelMarkingVisitor {
+ public:
+  ParallelMarkingVisitor(MarkCompactCollector* collector,
+                         ParallelMarkingDeque* deque)
+      : collector_(collector),
+        deque_(deque),
+        segment_(new ParallelMarkingDeque::Segment()) {}
+
+  ~ParallelMarkingVisitor() {
+    DCHECK(segment_->IsEmpty());
+    delete segment_;
+  }
+
+  void Run() {
+    while (true) {
+      while (!segment_->IsEmpty()) {
+        VisitObject(segment_->Pop());
+      }
+      ParallelMarkingDeque::Segment* stolen = deque_->Steal();
+      if (stolen == NULL) break;
+      delete segment_;
+      segment_ = stolen;
+    }
+    deque_->AddDeferred(deferred_);
+  }
+
+ private:
+  void VisitObject(HeapObject* object) {
+    DCHECK(Marking::IsBlack(Marking::MarkBitFrom(object)));
+    Map* map = object->map();
+    MarkObject(map);
+    int start_offset, end_offset;
+    if (!ParallelMarkingDeque::GetPlainBody(map, object, &start_offset,
+                                            &end_offset)) {
+      deferred_.Add(object);
+      return;
+    }
+    VisitPointers(object, HeapObject::RawField(object, start_offset),
+                  HeapObject::RawField(object, end_offset));
+  }
+
+  void VisitPointers(HeapObject* host, Object** start, Object** end) {
+    bool needs_slot_recording = false;
+    for (Object** p = start; p < end; p++) {
+      if (!(*p)->IsHeapObject()) continue;
+      HeapObject* object = ShortCircuitConsString(p);
+      if (collector_->is_compacting() &&
+          MarkCompactCollector::IsOnEvacuationCandidate(object) &&
+          !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(start)) {
+        // Slots buffers are not thread-safe, let the main thread revisit
+        // the host and record its slots.
+        needs_slot_recording = true;
+      }
+      MarkObject(object);
+    }
+    if (needs_slot_recording) deferred_.Add(host);
+  }
+
+  void MarkObject(HeapObject* object) {
+    MarkBit mark_bit = Marking::MarkBitFrom(object);
+    // White objects become black by setting the first mark bit. Grey objects
+    // are overflowed and will be rediscovered by RefillMarkingDeque.
+    if (!mark_bit.SetAtomic()) return;
+    MemoryChunk::IncrementLiveBytesFromGCAtomically(object->address(),
+                                                    object->Size());
+    if (segment_->IsFull()) {
+      deque_->Publish(segment_);
+      segment_ = new ParallelMarkingDeque::Segment();
+    }
+    segment_->Push(object);
+  }
+
+  MarkCompactCollector* collector_;
+  ParallelMarkingDeque* deque_;
+  ParallelMarkingDeque::Segment* segment_;
+  List<HeapObject*> deferred_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingVisitor);
+};
+
+
+class MarkCompactCollector::MarkingTask : public v8::Task {
+ public:
+  MarkingTask(Heap* heap, ParallelMarkingDeque* deque)
+      : heap_(heap), deque_(deque) {}
+
+  virtual ~MarkingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    heap_->mark_compact_collector()->MarkInParallel(deque_);
+    heap_->mark_compact_collector()->pending_marking_tasks_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  ParallelMarkingDeque* deque_;
+
+  DISALLOW_COPY_AND_ASSIGN(MarkingTask);
+};
+
+
+bool MarkCompactCollector::UseParallelMarking() const {
+  // Object statistics are collected by the main thread marking visitor, and
+  // keys of pending ephemerons have to be looked up when they are marked.
+  return FLAG_parallel_marking && !FLAG_track_gc_object_stats &&
+         pending_ephemerons_.is_empty();
+}
+
+
+int MarkCompactCollector::NumberOfParallelMarkingTasks() {
+  if (FLAG_parallel_marking_tasks > 0) return FLAG_parallel_marking_tasks;
+  return Max(1, base::SysInfo::NumberOfProcessors() - 1);
+}
+
+
+void MarkCompactCollector::MarkInParallel(ParallelMarkingDeque* deque) {
+  // Tasks that start after marking has terminated have nothing to do.
+  if (!deque->Join()) return;
+  ParallelMarkingVisitor visitor(this, deque);
+  visitor.Run();
+}
+
+
+void MarkCompactCollector::EmptyMarkingDequeInParallel() {
+  // Starting tasks does not pay off for a handful of objects.
+  static const int kMinObjectsForParallelMarkingTasks =
+      2 * ParallelMarkingDeque::Segment::kCapacity;
+  while (!marking_deque_.IsEmpty()) {
+    ParallelMarkingDeque deque;
+    int objects = 0;
+    ParallelMarkingDeque::Segment* segment =
+        new ParallelMarkingDeque::Segment();
+    while (!marking_deque_.IsEmpty()) {
+      if (segment->IsFull()) {
+        deque.Publish(segment);
+        segment = new ParallelMarkingDeque::Segment();
+      }
+      HeapObject* object = marking_deque_.Pop();
+      DCHECK(Marking::IsBlack(Marking::MarkBitFrom(object)));
+      segment->Push(object);
+      objects++;
+    }
+    deque.Publish(segment);
+
+    int tasks = objects >= kMinObjectsForParallelMarkingTasks
+                    ? NumberOfParallelMarkingTasks()
+                    : 0;
+    for (int i = 0; i < tasks; i++) {
+      heap()->PostBlockingBackgroundTask(new MarkingTask(heap(), &deque));
+    }
+    MarkInParallel(&deque);
+    for (int i = 0; i < tasks; i++) {
+      pending_marking_tasks_semaphore_.Wait();
+    }
+
+    // Visit the deferred objects with the regular marking visitor. Objects
+    // discovered by this go to the marking deque and start the next round.
+    List<HeapObject*>* deferred = deque.deferred();
+    for (int i = 0; i < deferred->length(); i++) {
+      HeapObject* object = deferred->at(i);
+      DCHECK(heap()->Contains(object));
+      DCHECK(Marking::IsBlack(Marking::MarkBitFrom(object)));
+
+      Map* map = object->map();
+      MarkBit map_mark = Marking::MarkBitFrom(map);
+      MarkObject(map, map_mark);
+
+      MarkCompactMarkingVisitor::IterateBody(map, object);
+    }
+  }
+}
+
+
 // Sweep the heap for overflowed objects, clear their overflow bits, and
 // push them on the marking stack.  Stop early if the marking stack fills
 // before sweeping completes.  If sweeping completes, there are no remaining
@@ -2165,8 +2504,9 @@ void MarkCompactCollector::RefillMarkingDeque() {
 // objects in the heap.
 void MarkCompactCollector::ProcessMarkingDeque() {
   EmptyMarkingDeque();
-  while (marking_deque_.overflowed()) {
-    RefillMarkingDeque();
+  while (marking_deque_.overflowed() || pending_ephemerons_.HasResolved()) {
+    if (marking_deque_.overflowed()) RefillMarkingDeque();
+    MarkResolvedEphemerons();
     EmptyMarkingDeque();
   }
 }
@@ -2182,7 +2522,8 @@ void MarkCompactCollector::ProcessEphemeralMarking(ObjectVisitor* visitor) {
         visitor, &IsUnmarkedHeapObjectWithHeap);
     MarkImplicitRefGroups();
     ProcessWeakCollections();
-    work_to_do = !marking_deque_.IsEmpty();
+    work_to_do =
+        !marking_deque_.IsEmpty() || pending_ephemerons_.HasResolved();
     ProcessMarkingDeque();
   }
 }
@@ -2255,6 +2596,7 @@ void MarkCompactCollector::MarkLiveObjects() {
   }
 
   PrepareForCodeFlushing();
+  MarkNormalizedMapCaches();
 
   if (was_marked_incrementally_) {
     // There is no write barrier on cells so we have to scan them now at the end
@@ -2304,10 +2646,7 @@ void MarkCompactCollector::MarkLiveObjects() {
       &IsUnmarkedHeapObject);
   // Then we mark the objects and process the transitive closure.
   heap()->isolate()->global_handles()->IterateWeakRoots(&root_visitor);
-  while (marking_deque_.overflowed()) {
-    RefillMarkingDeque();
-    EmptyMarkingDeque();
-  }
+  ProcessMarkingDeque();
 
   // Repeat host application specific and Harmony weak maps marking to
   // mark unmarked objects reachable from the weak roots.
@@ -2327,6 +2666,7 @@ void MarkCompactCollector::AfterMarking() {
   // marked. Mark the keys for the alive values before we process the
   // string table.
   ProcessMapCaches();
+  ProcessNormalizedMapCaches();
 
   // Prune the string table removing all strings only pointed to by the
   // string table.  Cannot use string_table() here because the string
@@ -2364,6 +2704,45 @@ void MarkCompactCollector::AfterMarking() {
 }
 
 
+void MarkCompactCollector::MarkNormalizedMapCaches() {
+  // The incremental marker has already marked the caches without visiting
+  // their entries, see VisitNativeContextIncremental.
+  Object* context = heap()->native_contexts_list();
+  while (!context->IsUndefined()) {
+    // GC can happen when the context is not fully initialized,
+    // so the cache can be undefined.
+    Object* cache =
+        Context::cast(context)->get(Context::NORMALIZED_MAP_CACHE_INDEX);
+    if (!cache->IsUndefined()) {
+      HeapObject* object = HeapObject::cast(cache);
+      MarkBit mark_bit = Marking::MarkBitFrom(object);
+      if (!mark_bit.Get()) SetMark(object, mark_bit);
+    }
+    context = Context::cast(context)->get(Context::NEXT_CONTEXT_LINK);
+  }
+}
+
+
+void MarkCompactCollector::ProcessNormalizedMapCaches() {
+  Object* context = heap()->native_contexts_list();
+  while (!context->IsUndefined()) {
+    Object* cache =
+        Context::cast(context)->get(Context::NORMALIZED_MAP_CACHE_INDEX);
+    if (!cache->IsUndefined()) {
+      // Not NormalizedMapCache::cast, whose verifier would visit dead maps.
+      FixedArray* entries = FixedArray::cast(cache);
+      for (int i = 0; i < entries->length(); i++) {
+        Object* entry = entries->get(i);
+        if (entry->IsHeapObject() && !IsMarked(entry)) {
+          entries->set_undefined(i);
+        }
+      }
+    }
+    context = Context::cast(context)->get(Context::NEXT_CONTEXT_LINK);
+  }
+}
+
+
 void MarkCompactCollector::ProcessMapCaches() {
   Object* raw_context = heap()->native_contexts_list();
   while (raw_context != heap()->undefined_value()) {
@@ -2596,7 +2975,12 @@ void MarkCompactCollector::ClearMapTransitions(Map* map) {
   // If there are no transitions to be cleared, return.
   // TODO(verwaest) Should be an assert, otherwise back pointers are not
   // properly cleared.
-  if (transition_index == t->number_of_transitions()) return;
+  if (transition_index == t->number_of_transitions()) {
+    if (transition_index == 0 && !t->HasPrototypeTransitions()) {
+      map->RemoveEmptyTransitionArray();
+    }
+    return;
+  }
 
   int number_of_own_descriptors = map->NumberOfOwnDescriptors();
 
@@ -2610,10 +2994,14 @@ void MarkCompactCollector::ClearMapTransitions(Map* map) {
     }
   }
 
-  // Note that we never eliminate a transition array, though we might right-trim
-  // such that number_of_transitions() == 0. If this assumption changes,
-  // TransitionArray::CopyInsert() will need to deal with the case that a
-  // transition array disappeared during GC.
+  // A transition array that is left without transitions or prototype
+  // transitions is replaced by the back pointer it holds. CopyInsert() and
+  // ExtendToFullTransitionArray() expect the array to disappear during GC.
+  if (transition_index == 0 && !t->HasPrototypeTransitions()) {
+    map->RemoveEmptyTransitionArray();
+    return;
+  }
+
   int trim = t->number_of_transitions() - transition_index;
   if (trim > 0) {
     heap_->RightTrimFixedArray<Heap::FROM_GC>(
@@ -2764,26 +3152,70 @@ void MarkCompactCollector::ClearNonLiveDependentCode(DependentCode* entries) {
 }
 
 
+void PendingEphemerons::Add(HeapObject* key, ObjectHashTable* table,
+                            int entry) {
+  HashMap::Entry* head = keys_.Lookup(key, ComputePointerHash(key), true);
+  Ephemeron ephemeron;
+  ephemeron.table = table;
+  ephemeron.entry = entry;
+  ephemeron.next = head->value == NULL
+                       ? -1
+                       : static_cast<int>(reinterpret_cast<intptr_t>(
+                             head->value)) - 1;
+  ephemerons_.Add(ephemeron);
+  head->value = reinterpret_cast<void*>(
+      static_cast<intptr_t>(ephemerons_.length()));
+}
+
+
+void PendingEphemerons::KeyMarked(HeapObject* key) {
+  void* head = keys_.Remove(key, ComputePointerHash(key));
+  if (head == NULL) return;
+  resolved_.Add(static_cast<int>(reinterpret_cast<intptr_t>(head)) - 1);
+}
+
+
+bool PendingEphemerons::PopResolved(ObjectHashTable** table, int* entry) {
+  if (resolved_.is_empty()) return false;
+  Ephemeron& ephemeron = ephemerons_[resolved_.last()];
+  *table = ephemeron.table;
+  *entry = ephemeron.entry;
+  if (ephemeron.next == -1) {
+    resolved_.RemoveLast();
+  } else {
+    resolved_.last() = ephemeron.next;
+  }
+  return true;
+}
+
+
+void PendingEphemerons::Clear() {
+  keys_.Clear();
+  ephemerons_.Clear();
+  resolved_.Clear();
+}
+
+
 void MarkCompactCollector::ProcessWeakCollections() {
   GCTracer::Scope gc_scope(heap()->tracer(),
                            GCTracer::Scope::MC_WEAKCOLLECTION_PROCESS);
+  // Newly encountered collections are prepended to the list, so only the
+  // part up to the previously scanned head has to be looked at.
   Object* weak_collection_obj = heap()->encountered_weak_collections();
-  while (weak_collection_obj != Smi::FromInt(0)) {
+  Object* scanned = scanned_weak_collections_;
+  scanned_weak_collections_ = weak_collection_obj;
+  while (weak_collection_obj != scanned) {
     JSWeakCollection* weak_collection =
         reinterpret_cast<JSWeakCollection*>(weak_collection_obj);
     DCHECK(MarkCompactCollector::IsMarked(weak_collection));
     if (weak_collection->table()->IsHashTable()) {
       ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
-      Object** anchor = reinterpret_cast<Object**>(table->address());
       for (int i = 0; i < table->Capacity(); i++) {
-        if (MarkCompactCollector::IsMarked(HeapObject::cast(table->KeyAt(i)))) {
-          Object** key_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(i));
-          RecordSlot(anchor, key_slot, *key_slot);
-          Object** value_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(i));
-          MarkCompactMarkingVisitor::MarkObjectByPointer(this, anchor,
-                                                         value_slot);
+        HeapObject* key = HeapObject::cast(table->KeyAt(i));
+        if (MarkCompactCollector::IsMarked(key)) {
+          MarkEphemeronValue(table, i);
+        } else {
+          pending_ephemerons_.Add(key, table, i);
         }
       }
     }
@@ -2792,6 +3224,28 @@ void MarkCompactCollector::ProcessWeakCollections() {
 }
 
 
+void MarkCompactCollector::MarkResolvedEphemerons() {
+  ObjectHashTable* table;
+  int entry;
+  // Marking a value may resolve further entries.
+  while (pending_ephemerons_.PopResolved(&table, &entry)) {
+    MarkEphemeronValue(table, entry);
+  }
+}
+
+
+void MarkCompactCollector::MarkEphemeronValue(ObjectHashTable* table,
+                                              int entry) {
+  Object** anchor = reinterpret_cast<Object**>(table->address());
+  Object** key_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(entry));
+  RecordSlot(anchor, key_slot, *key_slot);
+  Object** value_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(entry));
+  MarkCompactMarkingVisitor::MarkObjectByPointer(this, anchor, value_slot);
+}
+
+
 void MarkCompactCollector::ClearWeakCollections() {
   GCTracer::Scope gc_scope(heap()->tracer(),
                            GCTracer::Scope::MC_WEAKCOLLECTION_CLEAR);
@@ -2813,6 +3267,8 @@ void MarkCompactCollector::ClearWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  pending_ephemerons_.Clear();
+  scanned_weak_collections_ = Smi::FromInt(0);
 }
 
 
@@ -2827,6 +3283,8 @@ void MarkCompactCollector::AbortWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  pending_ephemerons_.Clear();
+  scanned_weak_collections_ = Smi::FromInt(0);
 }
 
 
@@ -2866,12 +3324,15 @@ void MarkCompactCollector::MigrateObject(HeapObject* dst, HeapObject* src,
     Address dst_slot = dst_addr;
     DCHECK(IsAligned(size, kPointerSize));
 
-    for (int remaining = size / kPointerSize; remaining > 0; remaining--) {
+    // Unboxed double fields are copied but never recorded.
+    Map* map = src->map();
+    bool may_contain_raw_values = src->MayContainRawValues();
+    for (int offset = 0; offset < size; offset += kPointerSize) {
       Object* value = Memory::Object_at(src_slot);
 
       Memory::Object_at(dst_slot) = value;
 
-      if (!src->MayContainRawValues()) {
+      if (!may_contain_raw_values && !map->IsUnboxedDoubleFieldOffset(offset)) {
         RecordMigratedSlot(value, dst_slot);
       }
 
@@ -3289,6 +3750,7 @@ static int Sweep(PagedSpace* space, FreeList* free_list, Page* p,
 
   intptr_t freed_bytes = 0;
   intptr_t max_freed_bytes = 0;
+  p->ResetDiscardedMemory();
 
   for (MarkBitCellIterator it(p); !it.Done(); it.Advance()) {
     Address cell_base = it.CurrentCellBase();
@@ -3304,6 +3766,7 @@ static int Sweep(PagedSpace* space, FreeList* free_list, Page* p,
         }
         freed_bytes = Free<parallelism>(space, free_list, free_start, size);
         max_freed_bytes = Max(freed_bytes, max_freed_bytes);
+        if (FLAG_discard_free_memory) p->DiscardFreeMemory(free_start, size);
 #ifdef ENABLE_GDB_JIT_INTERFACE
         if (FLAG_gdbjit && space->identity() == CODE_SPACE) {
           GDBJITInterface::RemoveCodeRange(free_start, free_end);
@@ -3338,6 +3801,7 @@ static int Sweep(PagedSpace* space, FreeList* free_list, Page* p,
     }
     freed_bytes = Free<parallelism>(space, free_list, free_start, size);
     max_freed_bytes = Max(freed_bytes, max_freed_bytes);
+    if (FLAG_discard_free_memory) p->DiscardFreeMemory(free_start, size);
 #ifdef ENABLE_GDB_JIT_INTERFACE
     if (FLAG_gdbjit && space->identity() == CODE_SPACE) {
       GDBJITInterface::RemoveCodeRange(free_start, p->area_end());
@@ -3531,8 +3995,12 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
   {
     GCTracer::Scope gc_scope(heap()->tracer(),
                              GCTracer::Scope::MC_UPDATE_POINTERS_TO_EVACUATED);
-    SlotsBuffer::UpdateSlotsRecordedIn(heap_, migration_slots_buffer_,
-                                       code_slots_filtering_required);
+    List<SlotsBuffer*> buffers;
+    for (SlotsBuffer* buffer = migration_slots_buffer_; buffer != NULL;
+         buffer = buffer->next()) {
+      buffers.Add(buffer);
+    }
+    UpdateSlotsRecordedInBuffers(buffers, code_slots_filtering_required);
     if (FLAG_trace_fragmentation) {
       PrintF("  migration slots buffer: %d\n",
              SlotsBuffer::SizeOfChain(migration_slots_buffer_));
@@ -3560,14 +4028,23 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
     GCTracer::Scope gc_scope(
         heap()->tracer(),
         GCTracer::Scope::MC_UPDATE_POINTERS_BETWEEN_EVACUATED);
+    List<SlotsBuffer*> buffers;
+    for (int i = 0; i < npages; i++) {
+      Page* p = evacuation_candidates_[i];
+      if (!p->IsEvacuationCandidate()) continue;
+      for (SlotsBuffer* buffer = p->slots_buffer(); buffer != NULL;
+           buffer = buffer->next()) {
+        buffers.Add(buffer);
+      }
+    }
+    UpdateSlotsRecordedInBuffers(buffers, code_slots_filtering_required);
+
     for (int i = 0; i < npages; i++) {
       Page* p = evacuation_candidates_[i];
       DCHECK(p->IsEvacuationCandidate() ||
              p->IsFlagSet(Page::RESCAN_ON_EVACUATION));
 
       if (p->IsEvacuationCandidate()) {
-        SlotsBuffer::UpdateSlotsRecordedIn(heap_, p->slots_buffer(),
-                                           code_slots_filtering_required);
         if (FLAG_trace_fragmentation) {
           PrintF("  page %p slots buffer: %d\n", reinterpret_cast<void*>(p),
                  SlotsBuffer::SizeOfChain(p->slots_buffer()));
@@ -3664,6 +4141,93 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
 }
 
 
+// Hands out slots buffers to the participants of a parallel pointer update.
+// Updating an untyped slot only replaces a forwarded pointer by its forwarding
+// address, so a slot that is recorded in several buffers may be updated
+// concurrently.
+class ParallelSlotsUpdater {
+ public:
+  ParallelSlotsUpdater(Heap* heap, const List<SlotsBuffer*>& buffers,
+                       bool code_slots_filtering_required)
+      : heap_(heap),
+        buffers_(buffers),
+        code_slots_filtering_required_(code_slots_filtering_required),
+        next_buffer_(0) {}
+
+  void Run() {
+    while (true) {
+      int index = base::NoBarrier_AtomicIncrement(&next_buffer_, 1) - 1;
+      if (index >= buffers_.length()) return;
+      buffers_[index]->UpdateUntypedSlots(heap_,
+                                          code_slots_filtering_required_);
+    }
+  }
+
+ private:
+  Heap* heap_;
+  const List<SlotsBuffer*>& buffers_;
+  bool code_slots_filtering_required_;
+  base::Atomic32 next_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelSlotsUpdater);
+};
+
+
+class MarkCompactCollector::PointersUpdatingTask : public v8::Task {
+ public:
+  PointersUpdatingTask(Heap* heap, ParallelSlotsUpdater* updater)
+      : heap_(heap), updater_(updater) {}
+
+  virtual ~PointersUpdatingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    updater_->Run();
+    heap_->mark_compact_collector()
+        ->pending_pointers_updating_tasks_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  ParallelSlotsUpdater* updater_;
+
+  DISALLOW_COPY_AND_ASSIGN(PointersUpdatingTask);
+};
+
+
+void MarkCompactCollector::UpdateSlotsRecordedInBuffers(
+    const List<SlotsBuffer*>& buffers, bool code_slots_filtering_required) {
+  if (!FLAG_parallel_pointer_update || buffers.length() < 2) {
+    for (int i = 0; i < buffers.length(); i++) {
+      if (code_slots_filtering_required) {
+        buffers[i]->UpdateSlotsWithFilter(heap());
+      } else {
+        buffers[i]->UpdateSlots(heap());
+      }
+    }
+    return;
+  }
+
+  int tasks = FLAG_parallel_pointer_update_tasks > 0
+                  ? FLAG_parallel_pointer_update_tasks
+                  : Max(1, base::SysInfo::NumberOfProcessors() - 1);
+  // Every participant should get at least one buffer.
+  tasks = Min(tasks, buffers.length() - 1);
+  ParallelSlotsUpdater updater(heap(), buffers, code_slots_filtering_required);
+  for (int i = 0; i < tasks; i++) {
+    heap()->PostBlockingBackgroundTask(
+        new PointersUpdatingTask(heap(), &updater));
+  }
+  updater.Run();
+  for (int i = 0; i < tasks; i++) {
+    pending_pointers_updating_tasks_semaphore_.Wait();
+  }
+  for (int i = 0; i < buffers.length(); i++) {
+    buffers[i]->UpdateTypedSlots(heap(), code_slots_filtering_required);
+  }
+}
+
+
 void MarkCompactCollector::MoveEvacuationCandidatesToEndOfPagesList() {
   int npages = evacuation_candidates_.length();
   for (int i = 0; i < npages; i++) {
@@ -4491,6 +5055,41 @@ void SlotsBuffer::UpdateSlotsWithFilter(Heap* heap) {
 }
 
 
+void SlotsBuffer::UpdateUntypedSlots(Heap* heap,
+                                     bool code_slots_filtering_required) {
+  for (int slot_idx = 0; slot_idx < idx_; ++slot_idx) {
+    ObjectSlot slot = slots_[slot_idx];
+    if (!IsTypedSlot(slot)) {
+      if (!code_slots_filtering_required ||
+          !IsOnInvalidatedCodeObject(reinterpret_cast<Address>(slot))) {
+        PointersUpdatingVisitor::UpdateSlot(heap, slot);
+      }
+    } else {
+      ++slot_idx;
+      DCHECK(slot_idx < idx_);
+    }
+  }
+}
+
+
+void SlotsBuffer::UpdateTypedSlots(Heap* heap,
+                                   bool code_slots_filtering_required) {
+  PointersUpdatingVisitor v(heap);
+
+  for (int slot_idx = 0; slot_idx < idx_; ++slot_idx) {
+    ObjectSlot slot = slots_[slot_idx];
+    if (IsTypedSlot(slot)) {
+      ++slot_idx;
+      DCHECK(slot_idx < idx_);
+      Address pc = reinterpret_cast<Address>(slots_[slot_idx]);
+      if (!code_slots_filtering_required || !IsOnInvalidatedCodeObject(pc)) {
+        UpdateSlot(heap->isolate(), &v, DecodeSlotType(slot), pc);
+      }
+    }
+  }
+}
+
+
 SlotsBuffer* SlotsBufferAllocator::AllocateBuffer(SlotsBuffer* next_buffer) {
   return new SlotsBuffer(next_buffer);
 }
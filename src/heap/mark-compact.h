@@ -6,6 +6,8 @@
 #define V8_HEAP_MARK_COMPACT_H_
 
 #include "src/base/bits.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/hashmap.h"
 #include "src/heap/spaces.h"
 
 namespace v8 {
@@ -226,6 +228,91 @@ class MarkingDeque {
 };
 
 
+// ----------------------------------------------------------------------------
+// Marking deque shared by the main thread and the parallel marking tasks.
+// Every participant pushes to and pops from a private segment and only
+// synchronizes when it publishes a full segment or steals a published one.
+// Marking has terminated when all participants are idle and the pool of
+// published segments is empty.
+class ParallelMarkingDeque {
+ public:
+  class Segment : public Malloced {
+   public:
+    static const int kCapacity = 64;
+
+    Segment() : next_(NULL), size_(0) {}
+
+    bool IsEmpty() const { return size_ == 0; }
+    bool IsFull() const { return size_ == kCapacity; }
+
+    void Push(HeapObject* object) {
+      DCHECK(!IsFull());
+      objects_[size_++] = object;
+    }
+
+    HeapObject* Pop() {
+      DCHECK(!IsEmpty());
+      return objects_[--size_];
+    }
+
+    Segment* next() const { return next_; }
+    void set_next(Segment* next) { next_ = next; }
+
+   private:
+    Segment* next_;
+    int size_;
+    HeapObject* objects_[kCapacity];
+  };
+
+  ParallelMarkingDeque()
+      : pool_(NULL), participants_(0), idle_participants_(0), done_(false) {}
+  ~ParallelMarkingDeque();
+
+  // Registers the calling thread as a participant. Returns false if marking
+  // has already terminated.
+  bool Join();
+
+  // Makes the segment available to other participants. The deque takes
+  // ownership of the segment.
+  void Publish(Segment* segment);
+
+  // Unregisters a participant that stops marking before the work is done,
+  // e.g. because its marking budget is exhausted. Its remaining work has to
+  // be published before.
+  void Leave();
+
+  // Takes a published segment, blocking while there is none but some other
+  // participant is still busy. Returns NULL once marking has terminated.
+  Segment* Steal();
+
+  // Takes a published segment without blocking. Returns NULL if there is
+  // none. Used to collect the remaining work after marking was stopped.
+  Segment* TryTake();
+
+  // Returns true if the main thread marking visitor does nothing for the
+  // object besides marking the objects referenced from the tagged fields in
+  // [*start_offset, *end_offset). Such objects can be visited by the parallel
+  // markers with atomic mark bit updates alone.
+  static bool GetPlainBody(Map* map, HeapObject* object, int* start_offset,
+                           int* end_offset);
+
+  // Objects that have to be visited by the main thread after the parallel
+  // phase because the parallel visitor cannot handle them.
+  void AddDeferred(const List<HeapObject*>& objects);
+  List<HeapObject*>* deferred() { return &deferred_; }
+
+ private:
+  base::Mutex mutex_;
+  base::ConditionVariable work_available_;
+  Segment* pool_;
+  int participants_;
+  int idle_participants_;
+  bool done_;
+  List<HeapObject*> deferred_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingDeque);
+};
+
 class SlotsBufferAllocator {
  public:
   SlotsBuffer* AllocateBuffer(SlotsBuffer* next_buffer);
@@ -299,6 +386,13 @@ class SlotsBuffer {
 
   void UpdateSlotsWithFilter(Heap* heap);
 
+  // Split versions of the above for the parallel pointer update. Untyped
+  // slots are tagged words and may be updated from any thread. Typed slots
+  // patch code and are updated on the main thread only.
+  void UpdateUntypedSlots(Heap* heap, bool code_slots_filtering_required);
+
+  void UpdateTypedSlots(Heap* heap, bool code_slots_filtering_required);
+
   SlotsBuffer* next() { return next_; }
 
   static int SizeOfChain(SlotsBuffer* buffer) {
@@ -425,6 +519,7 @@ class CodeFlusher {
   void ProcessOptimizedCodeMaps();
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void RecordFlushedCode(SharedFunctionInfo* shared);
   void EvictOptimizedCodeMaps();
   void EvictJSFunctionCandidates();
   void EvictSharedFunctionInfoCandidates();
@@ -489,6 +584,47 @@ class CodeFlusher {
 };
 
 
+// Entries of weak collections whose keys were not marked when their tables
+// were scanned, indexed by key. Once a key gets marked its entries move to a
+// worklist of entries whose values have to be marked. This way every entry
+// is looked at a bounded number of times instead of once per round of
+// ephemeron marking.
+class PendingEphemerons {
+ public:
+  PendingEphemerons() : keys_(HashMap::PointersMatch) {}
+
+  bool is_empty() const { return keys_.occupancy() == 0; }
+
+  void Add(HeapObject* key, ObjectHashTable* table, int entry);
+
+  // Moves the entries of the key to the worklist, if it has any.
+  void KeyMarked(HeapObject* key);
+
+  bool HasResolved() const { return !resolved_.is_empty(); }
+
+  // Takes an entry whose key was marked off the worklist.
+  bool PopResolved(ObjectHashTable** table, int* entry);
+
+  void Clear();
+
+ private:
+  struct Ephemeron {
+    ObjectHashTable* table;
+    int entry;
+    // Index of the next entry with the same key, or -1.
+    int next;
+  };
+
+  // Maps keys to the index of their first entry in ephemerons_.
+  HashMap keys_;
+  List<Ephemeron> ephemerons_;
+  // Indices of the first entries of chains whose key was marked.
+  List<int> resolved_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingEphemerons);
+};
+
+
 // Defined in isolate.h.
 class ThreadLocalTop;
 
@@ -657,7 +793,21 @@ class MarkCompactCollector {
   // to artificially keep AllocationSites alive for a time.
   void MarkAllocationSite(AllocationSite* site);
 
+  // True if the transitive closure of the marking deque is computed by
+  // several threads during the atomic pause.
+  bool UseParallelMarking() const;
+
+  // Returns the number of background tasks to start for parallel marking.
+  static int NumberOfParallelMarkingTasks();
+
+  // Computes the transitive closure of the objects published to the deque
+  // as far as possible without the main thread marking visitor. Runs on the
+  // main thread as well as on the parallel marking tasks.
+  void MarkInParallel(ParallelMarkingDeque* deque);
+
  private:
+  class MarkingTask;
+  class PointersUpdatingTask;
   class SweeperTask;
 
   explicit MarkCompactCollector(Heap* heap);
@@ -702,12 +852,23 @@ class MarkCompactCollector {
 
   base::Semaphore pending_sweeper_jobs_semaphore_;
 
+  base::Semaphore pending_marking_tasks_semaphore_;
+
+  base::Semaphore pending_pointers_updating_tasks_semaphore_;
+
   bool sequential_sweeping_;
 
   SlotsBufferAllocator slots_buffer_allocator_;
 
   SlotsBuffer* migration_slots_buffer_;
 
+  // Entries of the encountered weak collections whose keys are not marked.
+  PendingEphemerons pending_ephemerons_;
+
+  // Head of the list of encountered weak collections when it was last
+  // scanned. All collections from there on are tracked already.
+  Object* scanned_weak_collections_;
+
   // Finishes GC, performs heap verification if enabled.
   void Finish();
 
@@ -732,6 +893,10 @@ class MarkCompactCollector {
 
   void PrepareForCodeFlushing();
 
+  // Normalized map caches hold their maps weakly. Marks the caches up front so
+  // that the marker never visits their entries.
+  void MarkNormalizedMapCaches();
+
   // Marking operations for objects reachable from roots.
   void MarkLiveObjects();
 
@@ -779,6 +944,11 @@ class MarkCompactCollector {
   // overflow flag will be set.
   void EmptyMarkingDeque();
 
+  // Parallel version of EmptyMarkingDeque. Objects that are not handled by
+  // the parallel visitor are visited on the main thread in between rounds of
+  // parallel marking.
+  void EmptyMarkingDequeInParallel();
+
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
@@ -788,6 +958,9 @@ class MarkCompactCollector {
   // literal map caches removing unmarked entries.
   void ProcessMapCaches();
 
+  // Clears the entries of normalized map caches whose maps were not marked.
+  void ProcessNormalizedMapCaches();
+
   // Callback function for telling whether the object *p is an unmarked
   // heap object.
   static bool IsUnmarkedHeapObject(Object** p);
@@ -811,10 +984,17 @@ class MarkCompactCollector {
                                        int start, int end, int new_start);
 
   // Mark all values associated with reachable keys in weak collections
-  // encountered so far.  This might push new object or even new weak maps onto
-  // the marking stack.
+  // encountered since the last call. Entries with unreachable keys become
+  // pending until their key gets marked.  This might push new object or even
+  // new weak maps onto the marking stack.
   void ProcessWeakCollections();
 
+  // Mark the values of pending weak collection entries whose keys have been
+  // marked since.
+  void MarkResolvedEphemerons();
+
+  void MarkEphemeronValue(ObjectHashTable* table, int entry);
+
   // After all reachable objects have been marked those weak map entries
   // with an unreachable key are removed from all encountered weak maps.
   // The linked list of all encountered weak maps is destroyed.
@@ -851,6 +1031,12 @@ class MarkCompactCollector {
 
   void EvacuateNewSpaceAndCandidates();
 
+  // Updates the slots recorded in the given buffers, splitting the buffers
+  // between the main thread and background tasks if
+  // --parallel-pointer-update is on.
+  void UpdateSlotsRecordedInBuffers(const List<SlotsBuffer*>& buffers,
+                                    bool code_slots_filtering_required);
+
   void ReleaseEvacuationCandidates();
 
   // Moves the pages of the evacuation_candidates_ list to the end of their
@@ -0,0 +1,49 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/memory-reducer.h"
+
+namespace v8 {
+namespace internal {
+
+MemoryReducer::State MemoryReducer::Step(const State& state,
+                                         const Event& event) {
+  switch (state.action) {
+    case kDone:
+      if (event.type == kTimer) return state;
+      // A mark-compact or a context disposal may leave committed but mostly
+      // empty pages behind. Check again once the isolate had time to calm
+      // down.
+      return State(kWait, 0, event.time_ms + kLongDelayMs);
+    case kWait:
+      switch (event.type) {
+        case kContextDisposed:
+          return state;
+        case kMarkCompact:
+          // Somebody else collected garbage, postpone our GC.
+          return State(kWait, state.started_gcs,
+                       event.time_ms + kLongDelayMs);
+        case kTimer:
+          if (event.time_ms < state.next_gc_start_ms) return state;
+          if (event.low_allocation_rate &&
+              event.can_start_incremental_marking) {
+            return State(kRun, state.started_gcs + 1, 0.0);
+          }
+          return State(kWait, state.started_gcs,
+                       event.time_ms + kLongDelayMs);
+      }
+      break;
+    case kRun:
+      if (event.type != kMarkCompact) return state;
+      if (state.started_gcs < kMaxNumberOfGCs &&
+          event.next_gc_likely_to_collect_more) {
+        return State(kWait, state.started_gcs, event.time_ms + kShortDelayMs);
+      }
+      return State(kDone, 0, 0.0);
+  }
+  UNREACHABLE();
+  return State(kDone, 0, 0.0);
+}
+}
+}  // namespace v8::internal
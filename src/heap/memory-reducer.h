@@ -0,0 +1,91 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_MEMORY_REDUCER_H_
+#define V8_HEAP_MEMORY_REDUCER_H_
+
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+// The memory reducer releases memory that an isolate kept committed after a
+// phase of high allocation. It waits until the isolate has gone quiet and
+// then asks for a few memory-reducing garbage collections, i.e. incremental
+// marking followed by an aggressively compacting full GC.
+//
+// The controller is a state machine with three states:
+// - kDone: nothing to do until the next mark-compact or context disposal.
+// - kWait: wait until next_gc_start_ms, then start a GC if the allocation
+//   rate is low, otherwise keep waiting.
+// - kRun: a memory-reducing GC is in progress. After it finishes we either
+//   wait a little and start another one, or we are done.
+// The heap feeds it with timer events (sent on idle notifications and by a
+// delayed foreground task scheduled while it waits), finished
+// mark-compacts and context disposals.
+class MemoryReducer {
+ public:
+  enum Action { kDone, kWait, kRun };
+
+  struct State {
+    State(Action action, int started_gcs, double next_gc_start_ms)
+        : action(action),
+          started_gcs(started_gcs),
+          next_gc_start_ms(next_gc_start_ms) {}
+    Action action;
+    int started_gcs;
+    double next_gc_start_ms;
+  };
+
+  enum EventType { kTimer, kMarkCompact, kContextDisposed };
+
+  struct Event {
+    EventType type;
+    double time_ms;
+    bool low_allocation_rate;
+    bool can_start_incremental_marking;
+    bool next_gc_likely_to_collect_more;
+  };
+
+  // Delay before the first memory-reducing GC after an ordinary
+  // mark-compact.
+  static const int kLongDelayMs = 8000;
+
+  // Delay between two consecutive memory-reducing GCs.
+  static const int kShortDelayMs = 500;
+
+  // Maximum number of memory-reducing GCs per round.
+  static const int kMaxNumberOfGCs = 3;
+
+  // New space allocation throughput in bytes/ms at or below which the
+  // isolate is considered quiet.
+  static const size_t kLowAllocationThroughput = 1 * KB;
+
+  MemoryReducer() : state_(kDone, 0, 0.0) {}
+
+  // Advances the state machine. Returns true if a memory-reducing GC should
+  // be started now.
+  bool NotifyEvent(const Event& event) {
+    Action old_action = state_.action;
+    state_ = Step(state_, event);
+    return old_action != kRun && state_.action == kRun;
+  }
+
+  // True while a memory-reducing GC is in progress.
+  bool ShouldReduceMemory() const { return state_.action == kRun; }
+
+  const State& state() const { return state_; }
+
+  static State Step(const State& state, const Event& event);
+
+ private:
+  State state_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryReducer);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_MEMORY_REDUCER_H_
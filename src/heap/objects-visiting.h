@@ -229,6 +229,46 @@ class FixedBodyVisitor : public BodyVisitorBase<StaticVisitor> {
 };
 
 
+// Visits the body of a JSObject, skipping the in-object slots that hold
+// unboxed double values.
+template <typename StaticVisitor, typename ReturnType>
+class JSObjectBodyVisitor : public BodyVisitorBase<StaticVisitor> {
+ public:
+  INLINE(static ReturnType Visit(Map* map, HeapObject* object)) {
+    int object_size = JSObject::BodyDescriptor::SizeOf(map, object);
+    IterateBody(map, object, object_size);
+    return static_cast<ReturnType>(object_size);
+  }
+
+  template <int object_size>
+  static inline ReturnType VisitSpecialized(Map* map, HeapObject* object) {
+    DCHECK(JSObject::BodyDescriptor::SizeOf(map, object) == object_size);
+    IterateBody(map, object, object_size);
+    return static_cast<ReturnType>(object_size);
+  }
+
+ private:
+  INLINE(static void IterateBody(Map* map, HeapObject* object,
+                                 int object_size)) {
+    Heap* heap = map->GetHeap();
+    int offset = JSObject::BodyDescriptor::kStartOffset;
+    if (!map->HasUnboxedDoubleFields()) {
+      BodyVisitorBase<StaticVisitor>::IteratePointers(heap, object, offset,
+                                                      object_size);
+      return;
+    }
+    while (offset < object_size) {
+      int end_offset;
+      if (map->IsTaggedRun(offset, object_size, &end_offset)) {
+        BodyVisitorBase<StaticVisitor>::IteratePointers(heap, object, offset,
+                                                        end_offset);
+      }
+      offset = end_offset;
+    }
+  }
+};
+
+
 // Base class for visitors used for a linear new space iteration.
 // IterateBody returns size of visited object.
 // Certain types of objects (i.e. Code objects) are not handled
@@ -324,8 +364,7 @@ class StaticNewSpaceVisitor : public StaticVisitorBase {
   typedef FlexibleBodyVisitor<StaticVisitor, StructBodyDescriptor, int>
       StructVisitor;
 
-  typedef FlexibleBodyVisitor<StaticVisitor, JSObject::BodyDescriptor, int>
-      JSObjectVisitor;
+  typedef JSObjectBodyVisitor<StaticVisitor, int> JSObjectVisitor;
 
   typedef int (*Callback)(Map* map, HeapObject* object);
 
@@ -419,8 +458,7 @@ class StaticMarkingVisitor : public StaticVisitorBase {
   typedef FlexibleBodyVisitor<StaticVisitor, FixedArray::BodyDescriptor, void>
       FixedArrayVisitor;
 
-  typedef FlexibleBodyVisitor<StaticVisitor, JSObject::BodyDescriptor, void>
-      JSObjectVisitor;
+  typedef JSObjectBodyVisitor<StaticVisitor, void> JSObjectVisitor;
 
   typedef FlexibleBodyVisitor<StaticVisitor, StructBodyDescriptor, void>
       StructObjectVisitor;
@@ -0,0 +1,128 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_SLOT_SET_H_
+#define V8_HEAP_SLOT_SET_H_
+
+#include "src/allocation.h"
+#include "src/base/bits.h"
+#include "src/globals.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+// A set of pointer-sized slots of a memory chunk, implemented as a bitmap
+// with one bit per slot. The bitmap is split into buckets that are allocated
+// on the first insertion into the memory they cover, so chunks with few
+// recorded slots stay cheap. Inserting is constant time and never creates
+// duplicates. Not thread-safe.
+class SlotSet : public Malloced {
+ public:
+  SlotSet(Address start, size_t size)
+      : start_(start),
+        num_buckets_(static_cast<int>(
+            (size + kBucketSizeInBytes - 1) / kBucketSizeInBytes)),
+        buckets_(NewArray<uint32_t*>(num_buckets_)) {
+    for (int i = 0; i < num_buckets_; i++) buckets_[i] = NULL;
+  }
+
+  ~SlotSet() {
+    for (int i = 0; i < num_buckets_; i++) ReleaseBucket(i);
+    DeleteArray(buckets_);
+  }
+
+  void Insert(Address slot) {
+    int slot_index = SlotIndex(slot);
+    int bucket_index = slot_index >> kSlotsPerBucketLog2;
+    uint32_t* bucket = buckets_[bucket_index];
+    if (bucket == NULL) bucket = AllocateBucket(bucket_index);
+    int cell_index = (slot_index >> kBitsPerCellLog2) & (kCellsPerBucket - 1);
+    bucket[cell_index] |= 1u << (slot_index & (kBitsPerCell - 1));
+  }
+
+  bool Contains(Address slot) const {
+    int slot_index = SlotIndex(slot);
+    uint32_t* bucket = buckets_[slot_index >> kSlotsPerBucketLog2];
+    if (bucket == NULL) return false;
+    int cell_index = (slot_index >> kBitsPerCellLog2) & (kCellsPerBucket - 1);
+    return (bucket[cell_index] & (1u << (slot_index & (kBitsPerCell - 1)))) !=
+           0;
+  }
+
+  // Removes all slots and calls visitor->VisitSlot(slot) for each of them.
+  // The visitor may insert slots again, including the one it is visiting;
+  // those are kept. Buckets that end up empty are released. Returns the
+  // number of visited slots.
+  template <typename Visitor>
+  int Iterate(Visitor* visitor) {
+    int visited = 0;
+    for (int bucket_index = 0; bucket_index < num_buckets_; bucket_index++) {
+      if (buckets_[bucket_index] == NULL) continue;
+      for (int cell_index = 0; cell_index < kCellsPerBucket; cell_index++) {
+        uint32_t cell = buckets_[bucket_index][cell_index];
+        if (cell == 0) continue;
+        buckets_[bucket_index][cell_index] = 0;
+        int base = (bucket_index << kSlotsPerBucketLog2) +
+                   (cell_index << kBitsPerCellLog2);
+        while (cell != 0) {
+          int bit = static_cast<int>(base::bits::CountTrailingZeros32(cell));
+          cell &= cell - 1;
+          visitor->VisitSlot(start_ + ((base + bit) << kPointerSizeLog2));
+          visited++;
+        }
+      }
+      if (IsBucketEmpty(bucket_index)) {
+        ReleaseBucket(bucket_index);
+      }
+    }
+    return visited;
+  }
+
+  // Bytes of memory covered by one bucket.
+  static const int kBucketSizeInBytes = 1024 * kPointerSize;
+
+ private:
+  static const int kBitsPerCellLog2 = 5;
+  static const int kBitsPerCell = 1 << kBitsPerCellLog2;
+  static const int kSlotsPerBucketLog2 = 10;
+  static const int kCellsPerBucket =
+      (1 << kSlotsPerBucketLog2) >> kBitsPerCellLog2;
+
+  int SlotIndex(Address slot) const {
+    DCHECK(slot >= start_);
+    int index = static_cast<int>((slot - start_) >> kPointerSizeLog2);
+    DCHECK(index < (num_buckets_ << kSlotsPerBucketLog2));
+    return index;
+  }
+
+  uint32_t* AllocateBucket(int bucket_index) {
+    uint32_t* bucket = NewArray<uint32_t>(kCellsPerBucket);
+    for (int i = 0; i < kCellsPerBucket; i++) bucket[i] = 0;
+    buckets_[bucket_index] = bucket;
+    return bucket;
+  }
+
+  void ReleaseBucket(int bucket_index) {
+    DeleteArray(buckets_[bucket_index]);
+    buckets_[bucket_index] = NULL;
+  }
+
+  bool IsBucketEmpty(int bucket_index) const {
+    for (int i = 0; i < kCellsPerBucket; i++) {
+      if (buckets_[bucket_index][i] != 0) return false;
+    }
+    return true;
+  }
+
+  Address start_;
+  int num_buckets_;
+  uint32_t** buckets_;
+
+  DISALLOW_COPY_AND_ASSIGN(SlotSet);
+};
+}
+}  // namespace v8::internal
+
+#endif  // V8_HEAP_SLOT_SET_H_
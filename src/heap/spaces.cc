@@ -6,10 +6,15 @@
 
 #include "src/base/bits.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/sys-info.h"
 #include "src/full-codegen.h"
+#include "src/heap-profiler.h"
 #include "src/heap/mark-compact.h"
+#include "src/heap/slot-set.h"
 #include "src/macro-assembler.h"
 #include "src/msan.h"
+#include "src/sampling-heap-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -148,6 +153,16 @@ bool CodeRange::SetUp(size_t requested) {
 }
 
 
+// Size of the chunk that holds a regular code page.
+static size_t CodePageChunkSize() {
+  return RoundUp(static_cast<intptr_t>(
+                     MemoryAllocator::CodePageAreaStartOffset() +
+                     MemoryAllocator::CodePageAreaSize()),
+                 base::OS::CommitPageSize()) +
+         MemoryAllocator::CodePageGuardSize();
+}
+
+
 int CodeRange::CompareFreeBlockAddress(const FreeBlock* left,
                                        const FreeBlock* right) {
   // The entire point of CodeRange is that the difference between two
@@ -289,6 +304,14 @@ bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable) {
 void MemoryAllocator::TearDown() {
   // Check that spaces were torn down before MemoryAllocator.
   DCHECK(size_ == 0);
+  CodeRange* code_range = isolate_->code_range();
+  for (int i = 0; i < pooled_code_pages_.length(); i++) {
+    if (code_range != NULL && code_range->valid() &&
+        code_range->contains(pooled_code_pages_[i])) {
+      code_range->FreeRawMemory(pooled_code_pages_[i], CodePageChunkSize());
+    }
+  }
+  pooled_code_pages_.Clear();
   // TODO(gc) this will be true again when we fix FreeMemory.
   // DCHECK(size_executable_ == 0);
   capacity_ = 0;
@@ -458,9 +481,12 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
   chunk->InitializeReservedMemory();
   chunk->slots_buffer_ = NULL;
   chunk->skip_list_ = NULL;
+  chunk->slot_set_ = NULL;
+  chunk->store_buffer_counter_ = 0;
   chunk->write_barrier_counter_ = kWriteBarrierCounterGranularity;
   chunk->progress_bar_ = 0;
   chunk->high_water_mark_ = static_cast<int>(area_start - base);
+  chunk->ResetDiscardedMemory();
   chunk->set_parallel_sweeping(SWEEPING_DONE);
   chunk->available_in_small_free_list_ = 0;
   chunk->available_in_medium_free_list_ = 0;
@@ -487,6 +513,28 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
 }
 
 
+void MemoryChunk::DiscardFreeMemory(Address start, int size) {
+  if (size < kMinDiscardSize) return;
+  intptr_t page_size = base::OS::CommitPageSize();
+  // The map, size and next fields of the free list node must survive.
+  Address discard_start =
+      RoundUp(start + FreeSpace::kHeaderSize + kPointerSize, page_size);
+  Address discard_end = RoundDown(start + size, page_size);
+  if (discard_start >= discard_end) return;
+  base::OS::DiscardSystemPages(
+      discard_start, static_cast<size_t>(discard_end - discard_start));
+  // Memory above the high water mark was never counted as resident.
+  Address high_water_mark = address() + high_water_mark_;
+  if (discard_end > high_water_mark) discard_end = high_water_mark;
+  if (discard_start < discard_end) {
+    base::NoBarrier_Store(
+        &discarded_memory_,
+        base::NoBarrier_Load(&discarded_memory_) +
+            static_cast<intptr_t>(discard_end - discard_start));
+  }
+}
+
+
 // Commit MemoryChunk area to the requested size.
 bool MemoryChunk::CommitArea(size_t requested) {
   size_t guard_size =
@@ -517,6 +565,11 @@ bool MemoryChunk::CommitArea(size_t requested) {
       if (!code_range->CommitRawMemory(start, length)) return false;
     }
 
+    // Committing replaces the mapping, which drops any earlier advice.
+    if (FLAG_transparent_huge_pages) {
+      base::OS::AdviseHugePages(start, length);
+    }
+
     if (Heap::ShouldZapGarbage()) {
       heap_->isolate()->memory_allocator()->ZapBlock(start, length);
     }
@@ -540,6 +593,19 @@ bool MemoryChunk::CommitArea(size_t requested) {
 }
 
 
+SlotSet* MemoryChunk::AllocateSlotSet() {
+  DCHECK(slot_set_ == NULL);
+  slot_set_ = new SlotSet(address(), size());
+  return slot_set_;
+}
+
+
+void MemoryChunk::ReleaseSlotSet() {
+  delete slot_set_;
+  slot_set_ = NULL;
+}
+
+
 void MemoryChunk::InsertAfter(MemoryChunk* other) {
   MemoryChunk* other_next = other->next_chunk();
 
@@ -568,6 +634,7 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
 
   size_t chunk_size;
   Heap* heap = isolate_->heap();
+  size_t commit_size;
   Address base = NULL;
   base::VirtualMemory reservation;
   Address area_start = NULL;
@@ -616,13 +683,16 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
     }
 
     // Size of header (not executable) plus area (executable).
-    size_t commit_size = RoundUp(CodePageGuardStartOffset() + commit_area_size,
+    commit_size = RoundUp(CodePageGuardStartOffset() + commit_area_size,
                                  base::OS::CommitPageSize());
     // Allocate executable memory either from code range or from the
     // OS.
     if (isolate_->code_range() != NULL && isolate_->code_range()->valid()) {
-      base = isolate_->code_range()->AllocateRawMemory(chunk_size, commit_size,
-                                                       &chunk_size);
+      base = TakePooledCodePage(reserve_area_size, commit_area_size);
+      if (base == NULL) {
+        base = isolate_->code_range()->AllocateRawMemory(
+            chunk_size, commit_size, &chunk_size);
+      }
       DCHECK(
           IsAligned(reinterpret_cast<intptr_t>(base), MemoryChunk::kAlignment));
       if (base == NULL) return NULL;
@@ -648,7 +718,7 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
   } else {
     chunk_size = RoundUp(MemoryChunk::kObjectStartOffset + reserve_area_size,
                          base::OS::CommitPageSize());
-    size_t commit_size =
+    commit_size =
         RoundUp(MemoryChunk::kObjectStartOffset + commit_area_size,
                 base::OS::CommitPageSize());
     base =
@@ -665,6 +735,10 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
     area_end = area_start + commit_area_size;
   }
 
+  if (FLAG_transparent_huge_pages) {
+    base::OS::AdviseHugePages(base, commit_size);
+  }
+
   // Use chunk_size for statistics and callbacks because we assume that they
   // treat reserved but not-yet committed memory regions of chunks as allocated.
   isolate_->counters()->memory_allocated()->Increment(
@@ -725,6 +799,9 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
 
   delete chunk->slots_buffer();
   delete chunk->skip_list();
+  chunk->ReleaseSlotSet();
+
+  if (PoolCodePage(chunk)) return;
 
   base::VirtualMemory* reservation = chunk->reserved_memory();
   if (reservation->IsReserved()) {
@@ -735,6 +812,42 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
 }
 
 
+bool MemoryAllocator::PoolCodePage(MemoryChunk* chunk) {
+  CodeRange* code_range = isolate_->code_range();
+  if (chunk->executable() != EXECUTABLE || code_range == NULL ||
+      !code_range->valid() || chunk->reserved_memory()->IsReserved() ||
+      chunk->size() != CodePageChunkSize() ||
+      chunk->area_size() != CodePageAreaSize() ||
+      pooled_code_pages_.length() >= kMaxPooledCodePages) {
+    return false;
+  }
+  DCHECK(code_range->contains(chunk->address()));
+  size_t size = chunk->size();
+  DCHECK(size_ >= size && size_executable_ >= size);
+  size_ -= size;
+  size_executable_ -= size;
+  isolate_->counters()->memory_allocated()->Decrement(static_cast<int>(size));
+  pooled_code_pages_.Add(chunk->address());
+  return true;
+}
+
+
+Address MemoryAllocator::TakePooledCodePage(intptr_t reserve_area_size,
+                                            intptr_t commit_area_size) {
+  if (reserve_area_size != CodePageAreaSize() ||
+      commit_area_size != CodePageAreaSize()) {
+    return NULL;
+  }
+  CodeRange* code_range = isolate_->code_range();
+  while (!pooled_code_pages_.is_empty()) {
+    Address base = pooled_code_pages_.RemoveLast();
+    // The code range may have been replaced since the page was pooled.
+    if (code_range->contains(base)) return base;
+  }
+  return NULL;
+}
+
+
 bool MemoryAllocator::CommitBlock(Address start, size_t size,
                                   Executability executable) {
   if (!CommitMemory(start, size, executable)) return false;
@@ -899,13 +1012,15 @@ PagedSpace::PagedSpace(Heap* heap, intptr_t max_capacity, AllocationSpace id,
       unswept_free_bytes_(0),
       end_of_unswept_pages_(NULL),
       emergency_memory_(NULL) {
+#ifdef VERIFY_HEAP
+  next_page_to_verify_ = 0;
+#endif
   if (id == CODE_SPACE) {
     area_size_ = heap->isolate()->memory_allocator()->CodePageAreaSize();
   } else {
     area_size_ = Page::kPageSize - Page::kObjectStartOffset;
   }
-  max_capacity_ =
-      (RoundDown(max_capacity, Page::kPageSize) / Page::kPageSize) * AreaSize();
+  SetMaxCapacity(max_capacity);
   accounting_stats_.Clear();
 
   allocation_info_.set_top(NULL);
@@ -918,6 +1033,13 @@ PagedSpace::PagedSpace(Heap* heap, intptr_t max_capacity, AllocationSpace id,
 bool PagedSpace::SetUp() { return true; }
 
 
+void PagedSpace::SetMaxCapacity(intptr_t max_capacity) {
+  max_capacity_ =
+      (RoundDown(max_capacity, Page::kPageSize) / Page::kPageSize) * AreaSize();
+  max_capacity_ = Max(max_capacity_, Capacity());
+}
+
+
 bool PagedSpace::HasBeenSetUp() { return true; }
 
 
@@ -1137,9 +1259,42 @@ void PagedSpace::Print() {}
 #endif
 
 #ifdef VERIFY_HEAP
+class PageVerifierTask : public v8::Task {
+ public:
+  PageVerifierTask(PagedSpace* space, List<Page*>* pages, int first,
+                   int stride, ObjectVisitor* visitor,
+                   base::Semaphore* semaphore)
+      : space_(space),
+        pages_(pages),
+        first_(first),
+        stride_(stride),
+        visitor_(visitor),
+        semaphore_(semaphore) {}
+
+  virtual ~PageVerifierTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    space_->VerifyPages(pages_, first_, stride_, visitor_);
+    semaphore_->Signal();
+  }
+
+  PagedSpace* space_;
+  List<Page*>* pages_;
+  int first_;
+  int stride_;
+  ObjectVisitor* visitor_;
+  base::Semaphore* semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(PageVerifierTask);
+};
+
+
 void PagedSpace::Verify(ObjectVisitor* visitor) {
   bool allocation_pointer_found_in_space =
       (allocation_info_.top() == allocation_info_.limit());
+  List<Page*> all_pages;
   PageIterator page_iterator(this);
   while (page_iterator.has_next()) {
     Page* page = page_iterator.next();
@@ -1148,38 +1303,83 @@ void PagedSpace::Verify(ObjectVisitor* visitor) {
       allocation_pointer_found_in_space = true;
     }
     CHECK(page->WasSwept());
-    HeapObjectIterator it(page, NULL);
-    Address end_of_previous_object = page->area_start();
-    Address top = page->area_end();
-    int black_size = 0;
-    for (HeapObject* object = it.Next(); object != NULL; object = it.Next()) {
-      CHECK(end_of_previous_object <= object->address());
+    all_pages.Add(page);
+  }
+  CHECK(allocation_pointer_found_in_space);
+  if (all_pages.is_empty()) return;
+
+  // In sampled mode consecutive verifications walk the space in turns, so
+  // every page is still looked at regularly.
+  List<Page*> sampled_pages;
+  List<Page*>* pages = &all_pages;
+  int sample = FLAG_verify_heap_sample_pages;
+  if (sample > 0 && sample < all_pages.length()) {
+    int start = next_page_to_verify_ % all_pages.length();
+    for (int i = 0; i < sample; i++) {
+      sampled_pages.Add(all_pages[(start + i) % all_pages.length()]);
+    }
+    next_page_to_verify_ = (start + sample) % all_pages.length();
+    pages = &sampled_pages;
+  }
 
-      // The first word should be a map, and we expect all map pointers to
-      // be in map space.
-      Map* map = object->map();
-      CHECK(map->IsMap());
-      CHECK(heap()->map_space()->Contains(map));
+  // The main thread verifies its share of the pages while the background
+  // tasks do theirs. The heap is not mutated until all of them are done.
+  int tasks = 0;
+  if (FLAG_parallel_verify_heap) {
+    tasks = Min(pages->length() - 1,
+                Max(1, base::SysInfo::NumberOfProcessors() - 1));
+  }
+  base::Semaphore pending_tasks(0);
+  for (int i = 0; i < tasks; i++) {
+    heap()->PostBlockingBackgroundTask(new PageVerifierTask(
+        this, pages, i + 1, tasks + 1, visitor, &pending_tasks));
+  }
+  VerifyPages(pages, 0, tasks + 1, visitor);
+  for (int i = 0; i < tasks; i++) {
+    pending_tasks.Wait();
+  }
+}
 
-      // Perform space-specific object verification.
-      VerifyObject(object);
 
-      // The object itself should look OK.
-      object->ObjectVerify();
+void PagedSpace::VerifyPages(List<Page*>* pages, int first, int stride,
+                             ObjectVisitor* visitor) {
+  for (int i = first; i < pages->length(); i += stride) {
+    VerifyPage(pages->at(i), visitor);
+  }
+}
 
-      // All the interior pointers should be contained in the heap.
-      int size = object->Size();
-      object->IterateBody(map->instance_type(), size, visitor);
-      if (Marking::IsBlack(Marking::MarkBitFrom(object))) {
-        black_size += size;
-      }
 
-      CHECK(object->address() + size <= top);
-      end_of_previous_object = object->address() + size;
+void PagedSpace::VerifyPage(Page* page, ObjectVisitor* visitor) {
+  HeapObjectIterator it(page, NULL);
+  Address end_of_previous_object = page->area_start();
+  Address top = page->area_end();
+  int black_size = 0;
+  for (HeapObject* object = it.Next(); object != NULL; object = it.Next()) {
+    CHECK(end_of_previous_object <= object->address());
+
+    // The first word should be a map, and we expect all map pointers to
+    // be in map space.
+    Map* map = object->map();
+    CHECK(map->IsMap());
+    CHECK(heap()->map_space()->Contains(map));
+
+    // Perform space-specific object verification.
+    VerifyObject(object);
+
+    // The object itself should look OK.
+    object->ObjectVerify();
+
+    // All the interior pointers should be contained in the heap.
+    int size = object->Size();
+    object->IterateBody(map->instance_type(), size, visitor);
+    if (Marking::IsBlack(Marking::MarkBitFrom(object))) {
+      black_size += size;
     }
-    CHECK_LE(black_size, page->LiveBytes());
+
+    CHECK(object->address() + size <= top);
+    end_of_previous_object = object->address() + size;
   }
-  CHECK(allocation_pointer_found_in_space);
+  CHECK_LE(black_size, page->LiveBytes());
 }
 #endif  // VERIFY_HEAP
 
@@ -1341,20 +1541,50 @@ void NewSpace::UpdateInlineAllocationLimit(int size_in_bytes) {
     Address high = to_space_.page_high();
     Address new_top = allocation_info_.top() + size_in_bytes;
     allocation_info_.set_limit(Min(new_top, high));
-  } else if (inline_allocation_limit_step() == 0) {
+  } else if (InlineAllocationStep() == 0) {
     // Normal limit is the end of the current page.
     allocation_info_.set_limit(to_space_.page_high());
   } else {
-    // Lower limit during incremental marking.
+    // Lower limit during incremental marking or allocation sampling.
     Address high = to_space_.page_high();
     Address new_top = allocation_info_.top() + size_in_bytes;
-    Address new_limit = new_top + inline_allocation_limit_step_;
+    Address new_limit = new_top + InlineAllocationStep();
     allocation_info_.set_limit(Min(new_limit, high));
   }
   DCHECK_SEMISPACE_ALLOCATION_INFO(allocation_info_, to_space_);
 }
 
 
+intptr_t NewSpace::InlineAllocationStep() {
+  intptr_t step = inline_allocation_limit_step_;
+  if (bytes_until_allocation_sample_ > 0 &&
+      (step == 0 || bytes_until_allocation_sample_ < step)) {
+    step = bytes_until_allocation_sample_;
+  }
+  return step;
+}
+
+
+bool NewSpace::AllocationSampleStep(int bytes_allocated) {
+  if (bytes_until_allocation_sample_ == 0) return false;
+  bytes_until_allocation_sample_ -= bytes_allocated;
+  if (bytes_until_allocation_sample_ > 0) return false;
+  bytes_until_allocation_sample_ =
+      heap()->isolate()->heap_profiler()->sampling_heap_profiler()
+          ->GetNextSampleInterval();
+  return true;
+}
+
+
+void NewSpace::SampleAllocation(AllocationResult allocation,
+                                int size_in_bytes) {
+  HeapObject* object;
+  if (!allocation.To(&object)) return;
+  heap()->isolate()->heap_profiler()->sampling_heap_profiler()->SampleObject(
+      object->address(), size_in_bytes);
+}
+
+
 bool NewSpace::AddFreshPage() {
   Address top = allocation_info_.top();
   if (NewSpacePage::IsAtStart(top)) {
@@ -1390,23 +1620,31 @@ AllocationResult NewSpace::SlowAllocateRaw(int size_in_bytes) {
   Address old_top = allocation_info_.top();
   Address high = to_space_.page_high();
   if (allocation_info_.limit() < high) {
-    // Either the limit has been lowered because linear allocation was disabled
-    // or because incremental marking wants to get a chance to do a step. Set
-    // the new limit accordingly.
+    // Either the limit has been lowered because linear allocation was
+    // disabled, because incremental marking wants to get a chance to do a
+    // step or because an allocation sample is due. Set the new limit
+    // accordingly.
     Address new_top = old_top + size_in_bytes;
     int bytes_allocated = static_cast<int>(new_top - top_on_previous_step_);
     heap()->incremental_marking()->Step(bytes_allocated,
                                         IncrementalMarking::GC_VIA_STACK_GUARD);
+    bool sample = AllocationSampleStep(bytes_allocated);
     UpdateInlineAllocationLimit(size_in_bytes);
     top_on_previous_step_ = new_top;
-    return AllocateRaw(size_in_bytes);
+    AllocationResult allocation = AllocateRaw(size_in_bytes);
+    if (sample) SampleAllocation(allocation, size_in_bytes);
+    return allocation;
   } else if (AddFreshPage()) {
     // Switched to new page. Try allocating again.
     int bytes_allocated = static_cast<int>(old_top - top_on_previous_step_);
     heap()->incremental_marking()->Step(bytes_allocated,
                                         IncrementalMarking::GC_VIA_STACK_GUARD);
+    bool sample = AllocationSampleStep(bytes_allocated);
+    UpdateInlineAllocationLimit(0);
     top_on_previous_step_ = to_space_.page_low();
-    return AllocateRaw(size_in_bytes);
+    AllocationResult allocation = AllocateRaw(size_in_bytes);
+    if (sample) SampleAllocation(allocation, size_in_bytes);
+    return allocation;
   } else {
     return AllocationResult::Retry();
   }
@@ -2173,19 +2411,31 @@ FreeList::FreeList(PagedSpace* owner) : owner_(owner), heap_(owner->heap()) {
 
 intptr_t FreeList::Concatenate(FreeList* free_list) {
   intptr_t free_bytes = 0;
-  free_bytes += small_list_.Concatenate(free_list->small_list());
-  free_bytes += medium_list_.Concatenate(free_list->medium_list());
-  free_bytes += large_list_.Concatenate(free_list->large_list());
-  free_bytes += huge_list_.Concatenate(free_list->huge_list());
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    free_bytes += size_classes_[i].Concatenate(free_list->size_class(i));
+  }
   return free_bytes;
 }
 
 
 void FreeList::Reset() {
-  small_list_.Reset();
-  medium_list_.Reset();
-  large_list_.Reset();
-  huge_list_.Reset();
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    size_classes_[i].Reset();
+  }
+}
+
+
+// The page statistics are kept per category rather than per size class.
+void FreeList::UpdatePageStatistics(Page* page, int index, int size_in_bytes) {
+  if (index <= kLastSmallSizeClass) {
+    page->add_available_in_small_free_list(size_in_bytes);
+  } else if (index <= kLastMediumSizeClass) {
+    page->add_available_in_medium_free_list(size_in_bytes);
+  } else if (index <= kLastLargeSizeClass) {
+    page->add_available_in_large_free_list(size_in_bytes);
+  } else {
+    page->add_available_in_huge_free_list(size_in_bytes);
+  }
 }
 
 
@@ -2202,66 +2452,42 @@ int FreeList::Free(Address start, int size_in_bytes) {
     return size_in_bytes;
   }
 
-  // Insert other blocks at the head of a free list of the appropriate
-  // magnitude.
-  if (size_in_bytes <= kSmallListMax) {
-    small_list_.Free(node, size_in_bytes);
-    page->add_available_in_small_free_list(size_in_bytes);
-  } else if (size_in_bytes <= kMediumListMax) {
-    medium_list_.Free(node, size_in_bytes);
-    page->add_available_in_medium_free_list(size_in_bytes);
-  } else if (size_in_bytes <= kLargeListMax) {
-    large_list_.Free(node, size_in_bytes);
-    page->add_available_in_large_free_list(size_in_bytes);
-  } else {
-    huge_list_.Free(node, size_in_bytes);
-    page->add_available_in_huge_free_list(size_in_bytes);
-  }
+  // Insert other blocks at the head of the list of their size class.
+  int index = SizeClassFor(size_in_bytes);
+  size_classes_[index].Free(node, size_in_bytes);
+  UpdatePageStatistics(page, index, size_in_bytes);
 
   DCHECK(IsVeryLong() || available() == SumFreeLists());
   return 0;
 }
 
 
-FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
-  FreeListNode* node = NULL;
-  Page* page = NULL;
-
-  if (size_in_bytes <= kSmallAllocationMax) {
-    node = small_list_.PickNodeFromList(node_size);
-    if (node != NULL) {
-      DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_small_free_list(-(*node_size));
-      DCHECK(IsVeryLong() || available() == SumFreeLists());
-      return node;
-    }
-  }
-
-  if (size_in_bytes <= kMediumAllocationMax) {
-    node = medium_list_.PickNodeFromList(node_size);
+// Takes the first node from the non-empty size classes between first and
+// last, trying larger classes first so that the new linear allocation area
+// is as large as possible.
+FreeListNode* FreeList::PickNodeFromSizeClasses(int first, int last,
+                                                int* node_size) {
+  for (int index = last; index >= first; index--) {
+    if (size_classes_[index].IsEmpty()) continue;
+    FreeListNode* node = size_classes_[index].PickNodeFromList(node_size);
     if (node != NULL) {
-      DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_medium_free_list(-(*node_size));
+      UpdatePageStatistics(Page::FromAddress(node->address()), index,
+                           -(*node_size));
       DCHECK(IsVeryLong() || available() == SumFreeLists());
       return node;
     }
   }
+  return NULL;
+}
 
-  if (size_in_bytes <= kLargeAllocationMax) {
-    node = large_list_.PickNodeFromList(node_size);
-    if (node != NULL) {
-      DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_large_free_list(-(*node_size));
-      DCHECK(IsVeryLong() || available() == SumFreeLists());
-      return node;
-    }
-  }
 
-  int huge_list_available = huge_list_.available();
-  FreeListNode* top_node = huge_list_.top();
+FreeListNode* FreeList::FindNodeInHugeSizeClass(int size_in_bytes,
+                                                int* node_size) {
+  FreeListCategory* huge_list = &size_classes_[kHugeSizeClass];
+  FreeListNode* node = NULL;
+  Page* page = NULL;
+  int huge_list_available = huge_list->available();
+  FreeListNode* top_node = huge_list->top();
   for (FreeListNode** cur = &top_node; *cur != NULL;
        cur = (*cur)->next_address()) {
     FreeListNode* cur_node = *cur;
@@ -2276,7 +2502,7 @@ FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
 
     *cur = cur_node;
     if (cur_node == NULL) {
-      huge_list_.set_end(NULL);
+      huge_list->set_end(NULL);
       break;
     }
 
@@ -2295,37 +2521,60 @@ FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
     }
   }
 
-  huge_list_.set_top(top_node);
-  if (huge_list_.top() == NULL) {
-    huge_list_.set_end(NULL);
+  huge_list->set_top(top_node);
+  if (huge_list->top() == NULL) {
+    huge_list->set_end(NULL);
   }
-  huge_list_.set_available(huge_list_available);
+  huge_list->set_available(huge_list_available);
+  return node;
+}
 
+
+FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
+  // Every node in the size classes from first_fit on is large enough.
+  int containing = 0;
+  int first_fit = 0;
+  if (size_in_bytes > kSmallListMin) {
+    containing = SizeClassFor(size_in_bytes);
+    first_fit = containing;
+    if (SizeClassMin(containing) < size_in_bytes) first_fit++;
+  }
+
+  // As before size classes were introduced, prefer the small, then the
+  // medium, then the large category.
+  FreeListNode* node;
+  if (first_fit <= kLastSmallSizeClass) {
+    node = PickNodeFromSizeClasses(first_fit, kLastSmallSizeClass, node_size);
+    if (node != NULL) return node;
+  }
+  if (first_fit <= kLastMediumSizeClass) {
+    node = PickNodeFromSizeClasses(
+        Max(first_fit, kLastSmallSizeClass + 1), kLastMediumSizeClass,
+        node_size);
+    if (node != NULL) return node;
+  }
+  if (first_fit <= kLastLargeSizeClass) {
+    node = PickNodeFromSizeClasses(
+        Max(first_fit, kLastMediumSizeClass + 1), kLastLargeSizeClass,
+        node_size);
+    if (node != NULL) return node;
+  }
+
+  node = FindNodeInHugeSizeClass(size_in_bytes, node_size);
   if (node != NULL) {
     DCHECK(IsVeryLong() || available() == SumFreeLists());
     return node;
   }
 
-  if (size_in_bytes <= kSmallListMax) {
-    node = small_list_.PickNodeFromList(size_in_bytes, node_size);
-    if (node != NULL) {
-      DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_small_free_list(-(*node_size));
-    }
-  } else if (size_in_bytes <= kMediumListMax) {
-    node = medium_list_.PickNodeFromList(size_in_bytes, node_size);
+  // Only the size class that contains size_in_bytes is left. Its nodes may
+  // or may not be large enough, so only try the first one.
+  if (containing != first_fit && containing != kHugeSizeClass) {
+    node = size_classes_[containing].PickNodeFromList(size_in_bytes,
+                                                      node_size);
     if (node != NULL) {
       DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_medium_free_list(-(*node_size));
-    }
-  } else if (size_in_bytes <= kLargeListMax) {
-    node = large_list_.PickNodeFromList(size_in_bytes, node_size);
-    if (node != NULL) {
-      DCHECK(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_large_free_list(-(*node_size));
+      UpdatePageStatistics(Page::FromAddress(node->address()), containing,
+                           -(*node_size));
     }
   }
 
@@ -2414,13 +2663,13 @@ HeapObject* FreeList::Allocate(int size_in_bytes) {
 
 
 intptr_t FreeList::EvictFreeListItems(Page* p) {
-  intptr_t sum = huge_list_.EvictFreeListItemsInList(p);
+  intptr_t sum = size_classes_[kHugeSizeClass].EvictFreeListItemsInList(p);
   p->set_available_in_huge_free_list(0);
 
   if (sum < p->area_size()) {
-    sum += small_list_.EvictFreeListItemsInList(p) +
-           medium_list_.EvictFreeListItemsInList(p) +
-           large_list_.EvictFreeListItemsInList(p);
+    for (int i = 0; i < kHugeSizeClass; i++) {
+      sum += size_classes_[i].EvictFreeListItemsInList(p);
+    }
     p->set_available_in_small_free_list(0);
     p->set_available_in_medium_free_list(0);
     p->set_available_in_large_free_list(0);
@@ -2431,18 +2680,17 @@ intptr_t FreeList::EvictFreeListItems(Page* p) {
 
 
 bool FreeList::ContainsPageFreeListItems(Page* p) {
-  return huge_list_.EvictFreeListItemsInList(p) ||
-         small_list_.EvictFreeListItemsInList(p) ||
-         medium_list_.EvictFreeListItemsInList(p) ||
-         large_list_.EvictFreeListItemsInList(p);
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    if (size_classes_[i].ContainsPageFreeListItemsInList(p)) return true;
+  }
+  return false;
 }
 
 
 void FreeList::RepairLists(Heap* heap) {
-  small_list_.RepairFreeList(heap);
-  medium_list_.RepairFreeList(heap);
-  large_list_.RepairFreeList(heap);
-  huge_list_.RepairFreeList(heap);
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    size_classes_[i].RepairFreeList(heap);
+  }
 }
 
 
@@ -2476,10 +2724,9 @@ int FreeListCategory::FreeListLength() {
 
 
 bool FreeList::IsVeryLong() {
-  if (small_list_.FreeListLength() == kVeryLongFreeList) return true;
-  if (medium_list_.FreeListLength() == kVeryLongFreeList) return true;
-  if (large_list_.FreeListLength() == kVeryLongFreeList) return true;
-  if (huge_list_.FreeListLength() == kVeryLongFreeList) return true;
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    if (size_classes_[i].FreeListLength() == kVeryLongFreeList) return true;
+  }
   return false;
 }
 
@@ -2488,10 +2735,10 @@ bool FreeList::IsVeryLong() {
 // on the free list, so it should not be called if FreeListLength returns
 // kVeryLongFreeList.
 intptr_t FreeList::SumFreeLists() {
-  intptr_t sum = small_list_.SumFreeList();
-  sum += medium_list_.SumFreeList();
-  sum += large_list_.SumFreeList();
-  sum += huge_list_.SumFreeList();
+  intptr_t sum = 0;
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    sum += size_classes_[i].SumFreeList();
+  }
   return sum;
 }
 #endif
@@ -2851,7 +3098,8 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
   // Check if we want to force a GC before growing the old space further.
   // If so, fail the allocation.
   if (!heap()->always_allocate() &&
-      heap()->OldGenerationAllocationLimitReached()) {
+      heap()->OldGenerationAllocationLimitReached() &&
+      !heap()->StartIncrementalMarkingForLargeObjectAllocation(object_size)) {
     return AllocationResult::Retry(identity());
   }
 
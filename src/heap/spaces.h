@@ -118,6 +118,33 @@ class MarkBit {
   inline bool Get() { return (*cell_ & mask_) != 0; }
   inline void Clear() { *cell_ &= ~mask_; }
 
+  // Sets the bit with an atomic read-modify-write of the cell so that other
+  // bits in the same cell can be set concurrently by other threads. Returns
+  // false if the bit was already set.
+  inline bool SetAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if ((old_value & mask) != 0) return false;
+    } while (base::NoBarrier_CompareAndSwap(cell, old_value,
+                                            old_value | mask) != old_value);
+    return true;
+  }
+
+  // Atomic counterpart of Clear, see SetAtomic.
+  inline void ClearAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if ((old_value & mask) == 0) return;
+    } while (base::NoBarrier_CompareAndSwap(cell, old_value,
+                                            old_value & ~mask) != old_value);
+  }
+
   inline bool data_only() { return data_only_; }
 
   inline MarkBit Next() {
@@ -264,6 +291,7 @@ class Bitmap {
 
 
 class SkipList;
+class SlotSet;
 class SlotsBuffer;
 
 // MemoryChunk represents a memory region owned by a specific space.
@@ -477,6 +505,12 @@ class MemoryChunk {
     live_byte_count_ += by;
     DCHECK_LE(static_cast<unsigned>(live_byte_count_), size_);
   }
+  // Version of IncrementLiveBytes that can be used while other threads are
+  // updating the live byte count of the same chunk, e.g. by parallel markers.
+  void IncrementLiveBytesAtomically(int by) {
+    base::NoBarrier_AtomicIncrement(
+        reinterpret_cast<base::Atomic32*>(&live_byte_count_), by);
+  }
   int LiveBytes() {
     DCHECK(static_cast<unsigned>(live_byte_count_) <= size_);
     return live_byte_count_;
@@ -518,6 +552,10 @@ class MemoryChunk {
     MemoryChunk::FromAddress(address)->IncrementLiveBytes(by);
   }
 
+  static void IncrementLiveBytesFromGCAtomically(Address address, int by) {
+    MemoryChunk::FromAddress(address)->IncrementLiveBytesAtomically(by);
+  }
+
   static void IncrementLiveBytesFromMutator(Address address, int by);
 
   static const intptr_t kAlignment =
@@ -538,7 +576,12 @@ class MemoryChunk {
 
   static const size_t kHeaderSize =
       kWriteBarrierCounterOffset + kPointerSize + kIntSize + kIntSize +
-      kPointerSize + 5 * kPointerSize + kPointerSize + kPointerSize;
+      kPointerSize + 5 * kPointerSize + kPointerSize + kPointerSize +
+      kPointerSize + kPointerSize;
+
+  // Free ranges at least this large are given back to the OS by the sweeper
+  // when --discard-free-memory is on.
+  static const int kMinDiscardSize = 16 * KB;
 
   static const int kBodyOffset =
       CODE_POINTER_ALIGN(kHeaderSize + Bitmap::kSize);
@@ -618,6 +661,11 @@ class MemoryChunk {
 
   inline SlotsBuffer** slots_buffer_address() { return &slots_buffer_; }
 
+  // Old-to-new slots recorded by the store buffer in slot set mode, or NULL.
+  inline SlotSet* slot_set() { return slot_set_; }
+  SlotSet* AllocateSlotSet();
+  void ReleaseSlotSet();
+
   void MarkEvacuationCandidate() {
     DCHECK(slots_buffer_ == NULL);
     SetFlag(EVACUATION_CANDIDATE);
@@ -634,7 +682,17 @@ class MemoryChunk {
   bool CommitArea(size_t requested);
 
   // Approximate amount of physical memory committed for this chunk.
-  size_t CommittedPhysicalMemory() { return high_water_mark_; }
+  size_t CommittedPhysicalMemory() {
+    return high_water_mark_ - base::NoBarrier_Load(&discarded_memory_);
+  }
+
+  // Discards the OS pages that lie entirely inside the free range starting
+  // at start, keeping its free list node header intact.
+  void DiscardFreeMemory(Address start, int size);
+
+  // Called when the page is swept again. Memory discarded by the previous
+  // sweep may have been handed out by the free list in the meantime.
+  void ResetDiscardedMemory() { base::NoBarrier_Store(&discarded_memory_, 0); }
 
   static inline void UpdateHighWaterMark(Address mark);
 
@@ -667,6 +725,9 @@ class MemoryChunk {
   // Assuming the initial allocation on a page is sequential,
   // count highest number of bytes ever allocated on the page.
   int high_water_mark_;
+  // Bytes below the high water mark that the last sweep gave back to the OS.
+  // Only the thread sweeping the page writes it.
+  base::AtomicWord discarded_memory_;
 
   base::AtomicWord parallel_sweeping_;
 
@@ -677,6 +738,8 @@ class MemoryChunk {
   intptr_t available_in_huge_free_list_;
   intptr_t non_available_small_blocks_;
 
+  SlotSet* slot_set_;
+
   static MemoryChunk* Initialize(Heap* heap, Address base, size_t size,
                                  Address area_start, Address area_end,
                                  Executability executable, Space* owner);
@@ -1108,7 +1171,19 @@ class MemoryAllocator {
                                               Address start, size_t commit_size,
                                               size_t reserved_size);
 
+  // Regular code pages freed from the code range are kept committed, guard
+  // pages included, so that the next code page does not have to commit
+  // and protect them again. Pages are usually freed and reallocated in
+  // bursts around compacting GCs.
+  static const int kMaxPooledCodePages = 4;
+
+  int PooledCodePageCount() { return pooled_code_pages_.length(); }
+
  private:
+  bool PoolCodePage(MemoryChunk* chunk);
+  Address TakePooledCodePage(intptr_t reserve_area_size,
+                             intptr_t commit_area_size);
+
   Isolate* isolate_;
 
   // Maximum space size in bytes.
@@ -1142,6 +1217,9 @@ class MemoryAllocator {
   // A List of callback that are triggered when memory is allocated or free'd
   List<MemoryAllocationCallbackRegistration> memory_allocation_callbacks_;
 
+  // Committed code pages inside the code range that are ready for reuse.
+  List<Address> pooled_code_pages_;
+
   // Initializes pages in a chunk. Returns the first page address.
   // This function and GetChunkId() are provided for the mark-compact
   // collector to rebuild page headers in the from space, which is
@@ -1497,7 +1575,10 @@ class FreeListCategory {
 // is divided up into rough categories to cut down on waste.  Having finer
 // categories would scatter allocation more.
 
-// The old space free list is organized in categories.
+// The old space free list is organized in categories, each of which is split
+// into size classes of a quarter of a power of two (32-39 words, 40-47 words,
+// 48-55 words, 56-63 words, 64-79 words, and so on) so that blocks of a given
+// size can be found without walking the lists.
 // 1-31 words:  Such small free areas are discarded for efficiency reasons.
 //     They can be reclaimed by the compactor.  However the distance between top
 //     and limit may be this small.
@@ -1523,8 +1604,11 @@ class FreeList {
 
   // Return the number of bytes available on the free list.
   intptr_t available() {
-    return small_list_.available() + medium_list_.available() +
-           large_list_.available() + huge_list_.available();
+    intptr_t sum = 0;
+    for (int i = 0; i < kNumberOfSizeClasses; i++) {
+      sum += size_classes_[i].available();
+    }
+    return sum;
   }
 
   // Place a node on the free list.  The block of size 'size_in_bytes'
@@ -1557,8 +1641,10 @@ class FreeList {
   MUST_USE_RESULT HeapObject* Allocate(int size_in_bytes);
 
   bool IsEmpty() {
-    return small_list_.IsEmpty() && medium_list_.IsEmpty() &&
-           large_list_.IsEmpty() && huge_list_.IsEmpty();
+    for (int i = 0; i < kNumberOfSizeClasses; i++) {
+      if (!size_classes_[i].IsEmpty()) return false;
+    }
+    return true;
   }
 
 #ifdef DEBUG
@@ -1573,17 +1659,48 @@ class FreeList {
   intptr_t EvictFreeListItems(Page* p);
   bool ContainsPageFreeListItems(Page* p);
 
-  FreeListCategory* small_list() { return &small_list_; }
-  FreeListCategory* medium_list() { return &medium_list_; }
-  FreeListCategory* large_list() { return &large_list_; }
-  FreeListCategory* huge_list() { return &huge_list_; }
+  FreeListCategory* size_class(int index) { return &size_classes_[index]; }
+
+  // Size classes below kHugeSizeClass hold blocks of at least
+  // SizeClassMin(index) bytes, up to the minimum of the next class.
+  static const int kSizeClassesPerDoubling = 4;
+  static const int kNumberOfSizeClasses = 9 * kSizeClassesPerDoubling + 1;
+  static const int kHugeSizeClass = kNumberOfSizeClasses - 1;
+
+  static int SizeClassFor(int size_in_bytes) {
+    DCHECK(size_in_bytes >= kSmallListMin);
+    if (size_in_bytes > kLargeListMax) return kHugeSizeClass;
+    uint32_t words = size_in_bytes >> kPointerSizeLog2;
+    int log2 = 31 - base::bits::CountLeadingZeros32(words);
+    int quarter = (words >> (log2 - 2)) & (kSizeClassesPerDoubling - 1);
+    return (log2 - kMinSizeClassLog2) * kSizeClassesPerDoubling + quarter;
+  }
+
+  static int SizeClassMin(int index) {
+    DCHECK(index >= 0 && index < kNumberOfSizeClasses);
+    if (index == kHugeSizeClass) return kLargeListMax + kPointerSize;
+    int log2 = index / kSizeClassesPerDoubling + kMinSizeClassLog2;
+    int quarter = index % kSizeClassesPerDoubling;
+    return ((kSizeClassesPerDoubling + quarter) << (log2 - 2)) * kPointerSize;
+  }
 
  private:
   // The size range of blocks, in bytes.
   static const int kMinBlockSize = 3 * kPointerSize;
   static const int kMaxBlockSize = Page::kMaxRegularHeapObjectSize;
 
+  // Log2 of the size in words of the smallest size class.
+  static const int kMinSizeClassLog2 = 5;
+
+  // Last size classes of the small, medium and large categories.
+  static const int kLastSmallSizeClass = 3 * kSizeClassesPerDoubling - 1;
+  static const int kLastMediumSizeClass = 6 * kSizeClassesPerDoubling - 1;
+  static const int kLastLargeSizeClass = 9 * kSizeClassesPerDoubling - 1;
+
   FreeListNode* FindNodeFor(int size_in_bytes, int* node_size);
+  FreeListNode* PickNodeFromSizeClasses(int first, int last, int* node_size);
+  FreeListNode* FindNodeInHugeSizeClass(int size_in_bytes, int* node_size);
+  static void UpdatePageStatistics(Page* page, int index, int size_in_bytes);
 
   PagedSpace* owner_;
   Heap* heap_;
@@ -1595,10 +1712,7 @@ class FreeList {
   static const int kSmallAllocationMax = kSmallListMin - kPointerSize;
   static const int kMediumAllocationMax = kSmallListMax;
   static const int kLargeAllocationMax = kMediumListMax;
-  FreeListCategory small_list_;
-  FreeListCategory medium_list_;
-  FreeListCategory large_list_;
-  FreeListCategory huge_list_;
+  FreeListCategory size_classes_[kNumberOfSizeClasses];
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(FreeList);
 };
@@ -1659,6 +1773,10 @@ class PagedSpace : public Space {
   // fresh chunk will be allocated.
   bool SetUp();
 
+  // Changes the limit the space may grow to. It never drops below the
+  // current capacity.
+  void SetMaxCapacity(intptr_t max_capacity);
+
   // Returns true if the space has been successfully set up and not
   // subsequently torn down.
   bool HasBeenSetUp();
@@ -1805,9 +1923,16 @@ class PagedSpace : public Space {
   Page* anchor() { return &anchor_; }
 
 #ifdef VERIFY_HEAP
-  // Verify integrity of this space.
+  // Verify integrity of this space. With --verify-heap-sample-pages only a
+  // rotating subset of the pages is verified, and with --parallel-verify-heap
+  // the pages are verified by background tasks, so the visitor must then be
+  // safe to use from several threads at once.
   virtual void Verify(ObjectVisitor* visitor);
 
+  // Verifies every stride-th page of the list, starting at the first one.
+  void VerifyPages(List<Page*>* pages, int first, int stride,
+                   ObjectVisitor* visitor);
+
   // Overridden by subclasses to verify space-specific object
   // properties (e.g., only maps or free-list nodes are in map space).
   virtual void VerifyObject(HeapObject* obj) {}
@@ -1915,6 +2040,13 @@ class PagedSpace : public Space {
   // If not used, the emergency memory is released after compaction.
   MemoryChunk* emergency_memory_;
 
+#ifdef VERIFY_HEAP
+  // Index of the page at which the next sampled verification starts.
+  int next_page_to_verify_;
+
+  void VerifyPage(Page* page, ObjectVisitor* visitor);
+#endif
+
   // Expands the space by allocating a fixed number of pages. Returns false if
   // it cannot allocate requested number of pages from OS, or if the hard heap
   // size limit has been hit.
@@ -2320,7 +2452,8 @@ class NewSpace : public Space {
         to_space_(heap, kToSpace),
         from_space_(heap, kFromSpace),
         reservation_(),
-        inline_allocation_limit_step_(0) {}
+        inline_allocation_limit_step_(0),
+        bytes_until_allocation_sample_(0) {}
 
   // Sets up the new space using the given chunk.
   bool SetUp(int reserved_semispace_size_, int max_semi_space_size);
@@ -2476,6 +2609,15 @@ class NewSpace : public Space {
     top_on_previous_step_ = allocation_info_.top();
   }
 
+  // Lowers the limit so that the slow path is taken once the given number
+  // of bytes has been allocated, to let the sampling heap profiler take a
+  // sample. Zero stops sampling.
+  void SetBytesUntilAllocationSample(intptr_t bytes) {
+    bytes_until_allocation_sample_ = bytes;
+    UpdateInlineAllocationLimit(0);
+    top_on_previous_step_ = allocation_info_.top();
+  }
+
   // Get the extent of the inactive semispace (for use as a marking stack,
   // or to zap it). Notice: space-addresses are not necessarily on the
   // same page, so FromSpaceStart() might be above FromSpaceEnd().
@@ -2576,6 +2718,10 @@ class NewSpace : public Space {
   // when all allocation is performed from inlined generated code.
   intptr_t inline_allocation_limit_step_;
 
+  // The same mechanism is used by the sampling heap profiler, the limit is
+  // lowered to whichever of the two comes first.
+  intptr_t bytes_until_allocation_sample_;
+
   Address top_on_previous_step_;
 
   HistogramInfo* allocated_histogram_;
@@ -2583,6 +2729,16 @@ class NewSpace : public Space {
 
   MUST_USE_RESULT AllocationResult SlowAllocateRaw(int size_in_bytes);
 
+  // Returns the number of bytes to allocate before the limit has to be hit
+  // again, or zero if the limit does not need to be lowered.
+  intptr_t InlineAllocationStep();
+
+  // Counts the bytes allocated since the previous step towards the next
+  // allocation sample. Returns true if the allocation in progress has to be
+  // sampled.
+  bool AllocationSampleStep(int bytes_allocated);
+  void SampleAllocation(AllocationResult allocation, int size_in_bytes);
+
   friend class SemiSpaceIterator;
 
  public:
@@ -2734,6 +2890,8 @@ class LargeObjectSpace : public Space {
 
   bool CanAllocateSize(int size) { return Size() + size <= max_capacity_; }
 
+  void set_max_capacity(intptr_t max_capacity) { max_capacity_ = max_capacity; }
+
   // Available bytes for objects in this space.
   inline intptr_t Available();
 
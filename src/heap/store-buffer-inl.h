@@ -5,6 +5,7 @@
 #ifndef V8_STORE_BUFFER_INL_H_
 #define V8_STORE_BUFFER_INL_H_
 
+#include "src/heap/slot-set.h"
 #include "src/heap/store-buffer.h"
 
 namespace v8 {
@@ -31,12 +32,32 @@ void StoreBuffer::Mark(Address addr) {
 }
 
 
+MemoryChunk* StoreBuffer::ChunkForSlot(Address slot_address) {
+  MemoryChunk* chunk = MemoryChunk::FromAddress(slot_address);
+  if (chunk->owner() != NULL) return chunk;
+  // Slots past the first page of a large object.
+  return heap_->lo_space()->FindPage(slot_address);
+}
+
+
+void StoreBuffer::InsertIntoSlotSet(MemoryChunk* chunk, Address slot_address) {
+  SlotSet* slot_set = chunk->slot_set();
+  if (slot_set == NULL) slot_set = chunk->AllocateSlotSet();
+  slot_set->Insert(slot_address);
+}
+
+
 void StoreBuffer::EnterDirectlyIntoStoreBuffer(Address addr) {
   if (store_buffer_rebuilding_enabled_) {
     SLOW_DCHECK(!heap_->cell_space()->Contains(addr) &&
                 !heap_->code_space()->Contains(addr) &&
                 !heap_->old_data_space()->Contains(addr) &&
                 !heap_->new_space()->Contains(addr));
+    if (use_slot_sets_) {
+      // Slot sets cannot overflow, so the callback is never notified.
+      InsertIntoSlotSet(ChunkForSlot(addr), addr);
+      return;
+    }
     Address* top = old_top_;
     *top++ = addr;
     old_top_ = top;
@@ -7,6 +7,7 @@
 #include "src/v8.h"
 
 #include "src/base/atomicops.h"
+#include "src/base/sys-info.h"
 #include "src/counters.h"
 #include "src/heap/store-buffer-inl.h"
 
@@ -23,17 +24,20 @@ StoreBuffer::StoreBuffer(Heap* heap)
       old_reserved_limit_(NULL),
       old_buffer_is_sorted_(false),
       old_buffer_is_filtered_(false),
+      use_slot_sets_(false),
       during_gc_(false),
       store_buffer_rebuilding_enabled_(false),
       callback_(NULL),
       may_move_store_buffer_entries_(true),
       virtual_memory_(NULL),
+      pending_scan_pages_tasks_semaphore_(0),
       hash_set_1_(NULL),
       hash_set_2_(NULL),
       hash_sets_are_empty_(true) {}
 
 
 void StoreBuffer::SetUp() {
+  use_slot_sets_ = FLAG_store_buffer_slot_sets;
   virtual_memory_ = new base::VirtualMemory(kStoreBufferSize * 3);
   uintptr_t start_as_int =
       reinterpret_cast<uintptr_t>(virtual_memory_->address());
@@ -213,6 +217,7 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
 
 
 void StoreBuffer::Filter(int flag) {
+  if (use_slot_sets_) ReleaseSlotSets(flag);
   Address* new_top = old_start_;
   MemoryChunk* previous_chunk = NULL;
   for (Address* p = old_start_; p < old_top_; p++) {
@@ -304,6 +309,10 @@ bool StoreBuffer::CellIsInStoreBuffer(Address cell_address) {
       return true;
     }
   }
+  if (use_slot_sets_) {
+    SlotSet* slot_set = ChunkForSlot(cell_address)->slot_set();
+    return slot_set != NULL && slot_set->Contains(cell_address);
+  }
   return false;
 }
 #endif
@@ -367,27 +376,34 @@ void StoreBuffer::GCEpilogue() {
 }
 
 
+void StoreBuffer::ProcessPointerToNewSpace(Address slot_address,
+                                           ObjectSlotCallback slot_callback,
+                                           bool clear_maps) {
+  Object** slot = reinterpret_cast<Object**>(slot_address);
+  Object* object = reinterpret_cast<Object*>(
+      base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+  if (heap_->InNewSpace(object)) {
+    HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
+    DCHECK(heap_object->IsHeapObject());
+    // The new space object was not promoted if it still contains a map
+    // pointer. Clear the map field now lazily.
+    if (clear_maps) ClearDeadObject(heap_object);
+    slot_callback(reinterpret_cast<HeapObject**>(slot), heap_object);
+    object = reinterpret_cast<Object*>(
+        base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+    if (heap_->InNewSpace(object)) {
+      EnterDirectlyIntoStoreBuffer(slot_address);
+    }
+  }
+}
+
+
 void StoreBuffer::FindPointersToNewSpaceInRegion(
     Address start, Address end, ObjectSlotCallback slot_callback,
     bool clear_maps) {
   for (Address slot_address = start; slot_address < end;
        slot_address += kPointerSize) {
-    Object** slot = reinterpret_cast<Object**>(slot_address);
-    Object* object = reinterpret_cast<Object*>(
-        base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
-    if (heap_->InNewSpace(object)) {
-      HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
-      DCHECK(heap_object->IsHeapObject());
-      // The new space object was not promoted if it still contains a map
-      // pointer. Clear the map field now lazily.
-      if (clear_maps) ClearDeadObject(heap_object);
-      slot_callback(reinterpret_cast<HeapObject**>(slot), heap_object);
-      object = reinterpret_cast<Object*>(
-          base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
-      if (heap_->InNewSpace(object)) {
-        EnterDirectlyIntoStoreBuffer(slot_address);
-      }
-    }
+    ProcessPointerToNewSpace(slot_address, slot_callback, clear_maps);
   }
 }
 
@@ -423,6 +439,84 @@ void StoreBuffer::IteratePointersInStoreBuffer(ObjectSlotCallback slot_callback,
 }
 
 
+class StoreBuffer::SlotSetVisitor {
+ public:
+  SlotSetVisitor(StoreBuffer* store_buffer, ObjectSlotCallback slot_callback,
+                 bool clear_maps)
+      : store_buffer_(store_buffer),
+        heap_(store_buffer->heap_),
+        slot_callback_(slot_callback),
+        clear_maps_(clear_maps) {}
+
+  // The slot has already been removed from its slot set; it is entered again
+  // if it still points to new space afterwards.
+  void VisitSlot(Address slot_address) {
+    Object** slot = reinterpret_cast<Object**>(slot_address);
+    Object* object = reinterpret_cast<Object*>(
+        base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+    if (heap_->InFromSpace(object)) {
+      HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
+      // The new space object was not promoted if it still contains a map
+      // pointer. Clear the map field now lazily.
+      if (clear_maps_) store_buffer_->ClearDeadObject(heap_object);
+      slot_callback_(reinterpret_cast<HeapObject**>(slot), heap_object);
+      object = reinterpret_cast<Object*>(
+          base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+    }
+    if (heap_->InNewSpace(object)) {
+      store_buffer_->EnterDirectlyIntoStoreBuffer(slot_address);
+    }
+  }
+
+ private:
+  StoreBuffer* store_buffer_;
+  Heap* heap_;
+  ObjectSlotCallback slot_callback_;
+  bool clear_maps_;
+};
+
+
+void StoreBuffer::IteratePointersInSlotSets(ObjectSlotCallback slot_callback,
+                                            bool clear_maps) {
+  DCHECK(old_top_ == old_start_);
+  SlotSetVisitor visitor(this, slot_callback, clear_maps);
+  PointerChunkIterator it(heap_);
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != NULL) {
+    SlotSet* slot_set = chunk->slot_set();
+    if (slot_set != NULL) slot_set->Iterate(&visitor);
+  }
+}
+
+
+void StoreBuffer::ReleaseSlotSets(int flag) {
+  PointerChunkIterator it(heap_);
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != NULL) {
+    if (chunk->IsFlagSet(flag)) chunk->ReleaseSlotSet();
+  }
+}
+
+
+void StoreBuffer::CompactIntoSlotSets(Address* top) {
+  MemoryChunk* chunk = NULL;
+  for (Address* current = start_; current < top; current++) {
+    Address slot_address = *current;
+    DCHECK(!heap_->cell_space()->Contains(slot_address));
+    DCHECK(!heap_->code_space()->Contains(slot_address));
+    DCHECK(!heap_->old_data_space()->Contains(slot_address));
+    // Consecutive entries usually belong to the same chunk.
+    if (chunk == NULL || !chunk->Contains(slot_address)) {
+      chunk = ChunkForSlot(slot_address);
+    }
+    // Chunks about to be freed are filtered anyway, see
+    // Heap::FreeQueuedChunks. Their slot set field may not even be valid.
+    if (chunk->IsFlagSet(MemoryChunk::ABOUT_TO_BE_FREED)) continue;
+    InsertIntoSlotSet(chunk, slot_address);
+  }
+}
+
+
 void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback) {
   IteratePointersToNewSpace(slot_callback, false);
 }
@@ -444,7 +538,11 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
   // TODO(gc): we want to skip slots on evacuation candidates
   // but we can't simply figure that out from slot address
   // because slot can belong to a large object.
-  IteratePointersInStoreBuffer(slot_callback, clear_maps);
+  if (use_slot_sets_) {
+    IteratePointersInSlotSets(slot_callback, clear_maps);
+  } else {
+    IteratePointersInStoreBuffer(slot_callback, clear_maps);
+  }
 
   // We are done scanning all the pointers that were in the store buffer, but
   // there may be some pages marked scan_on_scavenge that have pointers to new
@@ -459,67 +557,271 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
     if (callback_ != NULL) {
       (*callback_)(heap_, NULL, kStoreBufferStartScanningPagesEvent);
     }
-    PointerChunkIterator it(heap_);
-    MemoryChunk* chunk;
-    while ((chunk = it.next()) != NULL) {
-      if (chunk->scan_on_scavenge()) {
-        chunk->set_scan_on_scavenge(false);
-        if (callback_ != NULL) {
-          (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
+    if (FLAG_parallel_scavenge && !clear_maps) {
+      IteratePointersOnScanOnScavengePagesInParallel(slot_callback);
+    } else {
+      IteratePointersOnScanOnScavengePages(slot_callback, clear_maps);
+    }
+    if (callback_ != NULL) {
+      (*callback_)(heap_, NULL, kStoreBufferScanningPageEvent);
+    }
+  }
+}
+
+
+void StoreBuffer::EnsurePageIsSwept(Page* page) {
+  PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
+  if (owner == heap_->map_space()) return;
+  if (!page->SweepingCompleted()) {
+    heap_->mark_compact_collector()->SweepInParallel(page, owner);
+    if (!page->SweepingCompleted()) {
+      // We were not able to sweep that page, i.e., a concurrent
+      // sweeper thread currently owns this page.
+      // TODO(hpayer): This may introduce a huge pause here. We
+      // just care about finish sweeping of the scan on scavenge page.
+      heap_->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+  }
+}
+
+
+template <typename RegionVisitor>
+void StoreBuffer::VisitPointerRegionsOnChunk(MemoryChunk* chunk,
+                                             RegionVisitor* visitor) {
+  if (chunk->owner() == heap_->lo_space()) {
+    LargePage* large_page = reinterpret_cast<LargePage*>(chunk);
+    HeapObject* array = large_page->GetObject();
+    DCHECK(array->IsFixedArray());
+    Address start = array->address();
+    Address end = start + array->Size();
+    visitor->VisitRegion(start, end);
+  } else {
+    Page* page = reinterpret_cast<Page*>(chunk);
+    PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
+    if (owner == heap_->map_space()) {
+      DCHECK(page->WasSwept());
+      HeapObjectIterator iterator(page, NULL);
+      for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
+           heap_object = iterator.Next()) {
+        // We skip free space objects.
+        if (!heap_object->IsFiller()) {
+          DCHECK(heap_object->IsMap());
+          visitor->VisitRegion(
+              heap_object->address() + Map::kPointerFieldsBeginOffset,
+              heap_object->address() + Map::kPointerFieldsEndOffset);
+        }
+      }
+    } else {
+      DCHECK(page->SweepingCompleted());
+      CHECK(page->owner() == heap_->old_pointer_space());
+      HeapObjectIterator iterator(page, NULL);
+      for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
+           heap_object = iterator.Next()) {
+        // We iterate over objects that contain new space pointers only.
+        if (heap_object->MayContainRawValues()) continue;
+        Address obj_address = heap_object->address();
+        Map* map = heap_object->map();
+        int size = heap_object->SizeFromMap(map);
+        if (!map->HasUnboxedDoubleFields()) {
+          visitor->VisitRegion(obj_address + HeapObject::kHeaderSize,
+                               obj_address + size);
+          continue;
         }
-        if (chunk->owner() == heap_->lo_space()) {
-          LargePage* large_page = reinterpret_cast<LargePage*>(chunk);
-          HeapObject* array = large_page->GetObject();
-          DCHECK(array->IsFixedArray());
-          Address start = array->address();
-          Address end = start + array->Size();
-          FindPointersToNewSpaceInRegion(start, end, slot_callback, clear_maps);
-        } else {
-          Page* page = reinterpret_cast<Page*>(chunk);
-          PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
-          if (owner == heap_->map_space()) {
-            DCHECK(page->WasSwept());
-            HeapObjectIterator iterator(page, NULL);
-            for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
-                 heap_object = iterator.Next()) {
-              // We skip free space objects.
-              if (!heap_object->IsFiller()) {
-                DCHECK(heap_object->IsMap());
-                FindPointersToNewSpaceInRegion(
-                    heap_object->address() + Map::kPointerFieldsBeginOffset,
-                    heap_object->address() + Map::kPointerFieldsEndOffset,
-                    slot_callback, clear_maps);
-              }
-            }
-          } else {
-            if (!page->SweepingCompleted()) {
-              heap_->mark_compact_collector()->SweepInParallel(page, owner);
-              if (!page->SweepingCompleted()) {
-                // We were not able to sweep that page, i.e., a concurrent
-                // sweeper thread currently owns this page.
-                // TODO(hpayer): This may introduce a huge pause here. We
-                // just care about finish sweeping of the scan on scavenge page.
-                heap_->mark_compact_collector()->EnsureSweepingCompleted();
-              }
-            }
-            CHECK(page->owner() == heap_->old_pointer_space());
-            HeapObjectIterator iterator(page, NULL);
-            for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
-                 heap_object = iterator.Next()) {
-              // We iterate over objects that contain new space pointers only.
-              if (!heap_object->MayContainRawValues()) {
-                FindPointersToNewSpaceInRegion(
-                    heap_object->address() + HeapObject::kHeaderSize,
-                    heap_object->address() + heap_object->Size(), slot_callback,
-                    clear_maps);
-              }
-            }
+        // Skip the unboxed double fields of JSObjects.
+        int offset = HeapObject::kHeaderSize;
+        while (offset < size) {
+          int end_offset;
+          if (map->IsTaggedRun(offset, size, &end_offset)) {
+            visitor->VisitRegion(obj_address + offset,
+                                 obj_address + end_offset);
           }
+          offset = end_offset;
         }
       }
     }
+  }
+}
+
+
+class StoreBuffer::UpdatePointersVisitor {
+ public:
+  UpdatePointersVisitor(StoreBuffer* store_buffer,
+                        ObjectSlotCallback slot_callback, bool clear_maps)
+      : store_buffer_(store_buffer),
+        slot_callback_(slot_callback),
+        clear_maps_(clear_maps) {}
+
+  void VisitRegion(Address start, Address end) {
+    store_buffer_->FindPointersToNewSpaceInRegion(start, end, slot_callback_,
+                                                  clear_maps_);
+  }
+
+ private:
+  StoreBuffer* store_buffer_;
+  ObjectSlotCallback slot_callback_;
+  bool clear_maps_;
+};
+
+
+void StoreBuffer::IteratePointersOnScanOnScavengePages(
+    ObjectSlotCallback slot_callback, bool clear_maps) {
+  UpdatePointersVisitor visitor(this, slot_callback, clear_maps);
+  PointerChunkIterator it(heap_);
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != NULL) {
+    if (chunk->scan_on_scavenge()) {
+      chunk->set_scan_on_scavenge(false);
+      if (callback_ != NULL) {
+        (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
+      }
+      if (chunk->owner() != heap_->lo_space()) {
+        EnsurePageIsSwept(reinterpret_cast<Page*>(chunk));
+      }
+      VisitPointerRegionsOnChunk(chunk, &visitor);
+    }
+  }
+}
+
+
+// Shared state of a parallel scan of the scan-on-scavenge chunks. Chunks are
+// handed out one at a time. The slots found on a chunk are stored in a list
+// owned by that chunk's index, so no two participants ever write to the same
+// list.
+class StoreBuffer::PageScanner {
+ public:
+  PageScanner(StoreBuffer* store_buffer, const List<MemoryChunk*>& chunks)
+      : store_buffer_(store_buffer),
+        chunks_(chunks),
+        slots_(new List<Address>[chunks.length()]),
+        next_chunk_(0) {}
+
+  ~PageScanner() { delete[] slots_; }
+
+  // Scans chunks until all of them have been claimed. Returns the number of
+  // slots found by the caller. Only reads the heap, so it may run on any
+  // thread while the main thread is waiting.
+  intptr_t ScanChunks() {
+    intptr_t found = 0;
+    while (true) {
+      int index = base::NoBarrier_AtomicIncrement(&next_chunk_, 1) - 1;
+      if (index >= chunks_.length()) return found;
+      CollectPointersVisitor visitor(store_buffer_->heap_, &slots_[index]);
+      store_buffer_->VisitPointerRegionsOnChunk(chunks_[index], &visitor);
+      found += slots_[index].length();
+    }
+  }
+
+  int length() const { return chunks_.length(); }
+  MemoryChunk* chunk(int index) const { return chunks_[index]; }
+  const List<Address>& slots(int index) const { return slots_[index]; }
+
+ private:
+  class CollectPointersVisitor {
+   public:
+    CollectPointersVisitor(Heap* heap, List<Address>* slots)
+        : heap_(heap), slots_(slots) {}
+
+    void VisitRegion(Address start, Address end) {
+      for (Address slot_address = start; slot_address < end;
+           slot_address += kPointerSize) {
+        Object* object = reinterpret_cast<Object*>(base::NoBarrier_Load(
+            reinterpret_cast<base::AtomicWord*>(slot_address)));
+        if (heap_->InNewSpace(object)) slots_->Add(slot_address);
+      }
+    }
+
+   private:
+    Heap* heap_;
+    List<Address>* slots_;
+  };
+
+  StoreBuffer* store_buffer_;
+  const List<MemoryChunk*>& chunks_;
+  List<Address>* slots_;
+  base::Atomic32 next_chunk_;
+
+  DISALLOW_COPY_AND_ASSIGN(PageScanner);
+};
+
+
+class StoreBuffer::ScanPagesTask : public v8::Task {
+ public:
+  ScanPagesTask(StoreBuffer* store_buffer, PageScanner* scanner,
+                intptr_t* found)
+      : store_buffer_(store_buffer), scanner_(scanner), found_(found) {}
+
+  virtual ~ScanPagesTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    *found_ = scanner_->ScanChunks();
+    store_buffer_->pending_scan_pages_tasks_semaphore_.Signal();
+  }
+
+  StoreBuffer* store_buffer_;
+  PageScanner* scanner_;
+  intptr_t* found_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScanPagesTask);
+};
+
+
+int StoreBuffer::NumberOfParallelScanTasks() {
+  if (FLAG_parallel_scavenge_tasks > 0) return FLAG_parallel_scavenge_tasks;
+  return Max(1, base::SysInfo::NumberOfProcessors() - 1);
+}
+
+
+void StoreBuffer::IteratePointersOnScanOnScavengePagesInParallel(
+    ObjectSlotCallback slot_callback) {
+  // Sweeping may free memory and is not thread-safe with respect to the
+  // scan, so all pages are made iterable before any task is started.
+  List<MemoryChunk*> chunks;
+  PointerChunkIterator it(heap_);
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != NULL) {
+    if (chunk->scan_on_scavenge()) {
+      if (chunk->owner() != heap_->lo_space()) {
+        EnsurePageIsSwept(reinterpret_cast<Page*>(chunk));
+      }
+      chunks.Add(chunk);
+    }
+  }
+
+  // Scanning a single page is not worth the task overhead.
+  static const int kMinChunksPerTask = 2;
+  int tasks = Min(NumberOfParallelScanTasks(),
+                  chunks.length() / kMinChunksPerTask - 1);
+  tasks = Max(tasks, 0);
+
+  PageScanner scanner(this, chunks);
+  List<intptr_t> found(tasks + 1);
+  found.AddBlock(0, tasks + 1);
+  for (int i = 0; i < tasks; i++) {
+    heap_->PostBlockingBackgroundTask(
+        new ScanPagesTask(this, &scanner, &found[i + 1]));
+  }
+  found[0] = scanner.ScanChunks();
+  for (int i = 0; i < tasks; i++) {
+    pending_scan_pages_tasks_semaphore_.Wait();
+  }
+  for (int i = 0; i <= tasks; i++) {
+    heap_->tracer()->AddParallelScavengeTask(found[i]);
+  }
+
+  // The callbacks promote objects and rebuild the store buffer, so they stay
+  // on the main thread and see the pages in the same order as the sequential
+  // scan.
+  for (int i = 0; i < scanner.length(); i++) {
+    chunk = scanner.chunk(i);
+    chunk->set_scan_on_scavenge(false);
     if (callback_ != NULL) {
-      (*callback_)(heap_, NULL, kStoreBufferScanningPageEvent);
+      (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
+    }
+    const List<Address>& slots = scanner.slots(i);
+    for (int j = 0; j < slots.length(); j++) {
+      ProcessPointerToNewSpace(slots[j], slot_callback, false);
     }
   }
 }
@@ -534,6 +836,11 @@ void StoreBuffer::Compact() {
   // the worst case (compaction doesn't eliminate any pointers).
   DCHECK(top <= limit_);
   heap_->public_set_store_buffer_top(start_);
+  if (use_slot_sets_) {
+    CompactIntoSlotSets(top);
+    heap_->isolate()->counters()->store_buffer_compactions()->Increment();
+    return;
+  }
   EnsureSpace(top - start_);
   DCHECK(may_move_store_buffer_entries_);
   // Goes through the addresses in the store buffer attempting to remove
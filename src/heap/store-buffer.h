@@ -8,6 +8,7 @@
 #include "src/allocation.h"
 #include "src/base/logging.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/globals.h"
 
 namespace v8 {
@@ -97,6 +98,10 @@ class StoreBuffer {
 
   bool PrepareForIteration();
 
+  // Returns the number of background tasks used to scan pages marked
+  // scan-on-scavenge for pointers to new space.
+  static int NumberOfParallelScanTasks();
+
 #ifdef DEBUG
   void Clean();
   // Slow, for asserts only.
@@ -122,6 +127,9 @@ class StoreBuffer {
 
   bool old_buffer_is_sorted_;
   bool old_buffer_is_filtered_;
+  // In slot set mode the entries of the new buffer are moved into the slot
+  // sets of their memory chunks instead of the old buffer, which stays empty.
+  bool use_slot_sets_;
   bool during_gc_;
   // The garbage collector iterates over many pointers to new space that are not
   // handled by the store buffer.  This flag indicates whether the pointers
@@ -132,6 +140,8 @@ class StoreBuffer {
 
   base::VirtualMemory* virtual_memory_;
 
+  base::Semaphore pending_scan_pages_tasks_semaphore_;
+
   // Two hash sets used for filtering.
   // If address is in the hash set then it is guaranteed to be in the
   // old part of the store buffer.
@@ -154,6 +164,33 @@ class StoreBuffer {
                                       ObjectSlotCallback slot_callback,
                                       bool clear_maps);
 
+  // Calls the slot callback for a single slot that pointed to new space when
+  // it was found and reenters the slot if it still points to new space.
+  inline void ProcessPointerToNewSpace(Address slot_address,
+                                       ObjectSlotCallback slot_callback,
+                                       bool clear_maps);
+
+  // Finishes sweeping of the given scan-on-scavenge page, which has to be
+  // iterable before we can look for pointers to new space on it.
+  void EnsurePageIsSwept(Page* page);
+
+  // Calls visitor->VisitRegion(start, end) for every region of a
+  // scan-on-scavenge chunk that may contain pointers to new space.
+  template <typename RegionVisitor>
+  void VisitPointerRegionsOnChunk(MemoryChunk* chunk, RegionVisitor* visitor);
+
+  // Scans the pages marked scan-on-scavenge. The parallel version first
+  // collects candidate slots on background tasks and then processes them on
+  // the main thread in the same page order as the sequential version.
+  void IteratePointersOnScanOnScavengePages(ObjectSlotCallback slot_callback,
+                                            bool clear_maps);
+  void IteratePointersOnScanOnScavengePagesInParallel(
+      ObjectSlotCallback slot_callback);
+
+  class PageScanner;
+  class ScanPagesTask;
+  class UpdatePointersVisitor;
+
   // For each region of pointers on a page in use from an old space call
   // visit_pointer_region callback.
   // If either visit_pointer_region or callback can cause an allocation
@@ -166,6 +203,16 @@ class StoreBuffer {
   void IteratePointersInStoreBuffer(ObjectSlotCallback slot_callback,
                                     bool clear_maps);
 
+  // Returns the chunk whose slot set records the given slot.
+  inline MemoryChunk* ChunkForSlot(Address slot_address);
+  inline void InsertIntoSlotSet(MemoryChunk* chunk, Address slot_address);
+  void CompactIntoSlotSets(Address* top);
+  void IteratePointersInSlotSets(ObjectSlotCallback slot_callback,
+                                 bool clear_maps);
+  void ReleaseSlotSets(int flag);
+
+  class SlotSetVisitor;
+
 #ifdef VERIFY_HEAP
   void VerifyPointers(LargeObjectSpace* space);
 #endif
@@ -0,0 +1,132 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/hydrogen-allocation-folding.h"
+#include "src/hydrogen-flow-engine.h"
+#include "src/hydrogen-instructions.h"
+
+namespace v8 {
+namespace internal {
+
+static bool MayTriggerGC(HInstruction* instr) {
+  // Allocation folding must not be done across the OSR entry either, the
+  // dominating allocation has not been executed on the OSR path.
+  return instr->ChangesFlags().Contains(kNewSpacePromotion) ||
+         instr->ChangesFlags().Contains(kOsrEntries);
+}
+
+
+// The state of the analysis is the allocation that new allocations can be
+// folded into, i.e. the last allocation on every path to the current
+// instruction without a possible GC in between, or NULL if there is none.
+class HAllocationFoldingState : public ZoneObject {
+ public:
+  HAllocationFoldingState() : dominator_(NULL) { }
+
+  HAllocationFoldingState* Process(HInstruction* instr, Zone* zone) {
+    if (instr->IsAllocate()) {
+      HAllocate* allocate = HAllocate::cast(instr);
+      if (dominator_ != NULL &&
+          allocate->HandleSideEffectDominator(kNewSpacePromotion,
+                                              dominator_)) {
+        // The allocation became part of the dominator, which stays the
+        // target for the following allocations.
+        return this;
+      }
+      dominator_ = allocate;
+    } else if (MayTriggerGC(instr)) {
+      dominator_ = NULL;
+    }
+    return this;
+  }
+
+  static HAllocationFoldingState* Merge(HAllocationFoldingState* succ_state,
+                                        HBasicBlock* succ_block,
+                                        HAllocationFoldingState* pred_state,
+                                        HBasicBlock* pred_block,
+                                        Zone* zone) {
+    DCHECK(pred_state != NULL);
+    if (succ_state == NULL) return pred_state->Copy(zone);
+    // Only an allocation that is the last one on all incoming paths
+    // dominates the merge without a GC in between.
+    if (succ_state->dominator_ != pred_state->dominator_) {
+      succ_state->dominator_ = NULL;
+    }
+    return succ_state;
+  }
+
+  static HAllocationFoldingState* Finish(HAllocationFoldingState* state,
+                                         HBasicBlock* block,
+                                         Zone* zone) {
+    DCHECK(state != NULL);
+    return state;
+  }
+
+ private:
+  friend class HAllocationFoldingEffects;
+
+  HAllocationFoldingState* Copy(Zone* zone) {
+    HAllocationFoldingState* copy = new(zone) HAllocationFoldingState();
+    copy->dominator_ = dominator_;
+    return copy;
+  }
+
+  HAllocate* dominator_;
+};
+
+
+// Loop effects: an allocation in the loop header can't be folded into an
+// allocation before the loop if anything in the loop may trigger a GC.
+class HAllocationFoldingEffects : public ZoneObject {
+ public:
+  explicit HAllocationFoldingEffects(Zone* zone) : may_trigger_gc_(false) { }
+
+  inline bool Disabled() {
+    return false;
+  }
+
+  void Process(HInstruction* instr, Zone* zone) {
+    if (instr->IsAllocate() || MayTriggerGC(instr)) may_trigger_gc_ = true;
+  }
+
+  void Apply(HAllocationFoldingState* state) {
+    if (may_trigger_gc_) state->dominator_ = NULL;
+  }
+
+  void Union(HAllocationFoldingEffects* that, Zone* zone) {
+    may_trigger_gc_ |= that->may_trigger_gc_;
+  }
+
+ private:
+  bool may_trigger_gc_;
+};
+
+
+int HAllocationFoldingPhase::CountAllocations() {
+  int count = 0;
+  for (int i = 0; i < graph()->blocks()->length(); i++) {
+    HBasicBlock* block = graph()->blocks()->at(i);
+    for (HInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsAllocate()) count++;
+    }
+  }
+  return count;
+}
+
+
+void HAllocationFoldingPhase::Run() {
+  int allocations = FLAG_trace_allocation_folding ? CountAllocations() : 0;
+
+  HFlowEngine<HAllocationFoldingState, HAllocationFoldingEffects>
+      engine(graph(), zone());
+  HAllocationFoldingState* state = new(zone()) HAllocationFoldingState();
+  engine.AnalyzeDominatedBlocks(graph()->blocks()->at(0), state);
+
+  if (FLAG_trace_allocation_folding) {
+    PrintF("Folded %d of %d allocations\n",
+           allocations - CountAllocations(), allocations);
+  }
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,31 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HYDROGEN_ALLOCATION_FOLDING_H_
+#define V8_HYDROGEN_ALLOCATION_FOLDING_H_
+
+#include "src/hydrogen.h"
+
+namespace v8 {
+namespace internal {
+
+// Folds allocations into the allocation that dominates them, as long as no
+// instruction on any path in between can trigger a GC. Unlike the folding
+// done by GVN this also works for allocations behind control flow merges,
+// e.g. for the object trees built by conditional expressions.
+class HAllocationFoldingPhase : public HPhase {
+ public:
+  explicit HAllocationFoldingPhase(HGraph* graph)
+      : HPhase("H_Allocation folding", graph) { }
+
+  void Run();
+
+ private:
+  int CountAllocations();
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_HYDROGEN_ALLOCATION_FOLDING_H_
@@ -7,6 +7,35 @@
 namespace v8 {
 namespace internal {
 
+/*
+ * A bounds check on a linearized two-dimensional index of the form
+ * "outer * stride + inner", where "outer" and "inner" are the induction
+ * variables of two nested loops.
+ * Since both variables start at a non-negative constant and only grow, and
+ * inside the inner loop body "inner < stride" and "outer < outer_limit" hold,
+ * the index always stays within [0, outer_limit * stride). A single check of
+ * that symbolic upper bound in the preheader of the outer loop therefore
+ * covers all the iterations of both loops.
+ */
+struct NestedLoopCheck : public ZoneObject {
+  NestedLoopCheck(HBoundsCheck* check, InductionVariableData* outer,
+                  HValue* stride, InductionVariableData* inner)
+      : check(check), outer(outer), stride(stride), inner(inner),
+        processed(false) {}
+
+  bool IsRelatedTo(NestedLoopCheck* other) {
+    return outer == other->outer && stride == other->stride &&
+        inner == other->inner && check->length() == other->check->length();
+  }
+
+  HBoundsCheck* check;
+  InductionVariableData* outer;
+  HValue* stride;
+  InductionVariableData* inner;
+  bool processed;
+};
+
+
 /*
  * This class is a table with one element for eack basic block.
  *
@@ -174,9 +203,17 @@ class InductionVariableBlocksTable BASE_EMBEDDED {
     return unsafe ? OPTIMISTICALLY_HOISTABLE : HOISTABLE;
   }
 
+  bool IsHoistable() {
+    Hoistability hoistability = CheckHoistability();
+    return hoistability == HOISTABLE ||
+        (hoistability == OPTIMISTICALLY_HOISTABLE &&
+         graph()->use_optimistic_licm());
+  }
+
   explicit InductionVariableBlocksTable(HGraph* graph)
     : graph_(graph), loop_header_(NULL),
-      elements_(graph->blocks()->length(), graph->zone()) {
+      elements_(graph->blocks()->length(), graph->zone()),
+      nested_checks_(4, graph->zone()) {
     for (int i = 0; i < graph->blocks()->length(); i++) {
       Element element;
       element.set_block(graph->blocks()->at(i));
@@ -225,12 +262,7 @@ class InductionVariableBlocksTable BASE_EMBEDDED {
     }
 
     // Check that we will not cause unwanted deoptimizations.
-    Hoistability hoistability = CheckHoistability();
-    if (hoistability == NOT_HOISTABLE ||
-        (hoistability == OPTIMISTICALLY_HOISTABLE &&
-         !graph()->use_optimistic_licm())) {
-      return;
-    }
+    if (!IsHoistable()) return;
 
     // We will do the hoisting, but we must see if the limit is "limit" or if
     // all checks are done on constants: if all check are done against the same
@@ -296,6 +328,11 @@ class InductionVariableBlocksTable BASE_EMBEDDED {
     for (HInstruction* i = bb->first(); i != NULL; i = i->next()) {
       if (!i->IsBoundsCheck()) continue;
       HBoundsCheck* check = HBoundsCheck::cast(i);
+      if (FLAG_array_bounds_checks_nested_hoisting &&
+          CollectNestedLoopCheck(check)) {
+        continue;
+      }
+      if (!FLAG_array_bounds_checks_hoisting) continue;
       InductionVariableData::BitwiseDecompositionResult decomposition;
       InductionVariableData::DecomposeBitwise(check->index(), &decomposition);
       if (!decomposition.base->IsPhi()) continue;
@@ -360,10 +397,202 @@ class InductionVariableBlocksTable BASE_EMBEDDED {
     }
   }
 
+  void HoistNestedLoopChecks() {
+    for (int i = 0; i < nested_checks_.length(); i++) {
+      if (nested_checks_[i]->processed) continue;
+      ProcessNestedLoopChecks(i);
+    }
+  }
+
  private:
+  static HBasicBlock* PreHeaderOf(InductionVariableData* data) {
+    return data->phi()->block()->current_loop()->loop_header()->
+        predecessors()->at(0);
+  }
+
+  // Returns whether {value} is available at the end of {block}.
+  static bool IsDefinedIn(HValue* value, HBasicBlock* block) {
+    return value->IsInteger32Constant() || value->block() == block ||
+        value->block()->Dominates(block);
+  }
+
+  // Returns the induction variable data of {value} if it is known to range
+  // over [non-negative base, limit) wherever {check} is executed.
+  static InductionVariableData* GetGrowingInductionVariable(
+      HValue* value, HBoundsCheck* check) {
+    if (!value->IsPhi()) return NULL;
+    HPhi* phi = HPhi::cast(value);
+    if (!phi->IsLimitedInductionVariable()) return NULL;
+    InductionVariableData* data = phi->induction_variable_data();
+    if (data->increment() <= 0) return NULL;
+    if (data->limit_included()) return NULL;
+    if (!data->LowerLimitIsNonNegativeConstant()) return NULL;
+    if (data->limit_validity() != check->block() &&
+        !data->limit_validity()->Dominates(check->block())) {
+      return NULL;
+    }
+    if (!phi->block()->current_loop()->IsNestedInThisLoop(
+            check->block()->current_loop())) {
+      return NULL;
+    }
+    return data;
+  }
+
+  // Records {check} if its index has the form "outer * stride + inner" and
+  // the symbolic bound outer_limit * stride can be computed in the preheader
+  // of the outer loop.
+  bool CollectNestedLoopCheck(HBoundsCheck* check) {
+    HValue* length = check->length();
+    if (!check->representation().IsInteger32() ||
+        !length->representation().IsInteger32()) {
+      return false;
+    }
+
+    HValue* index = check->index();
+    if (!index->IsAdd() || !index->representation().IsInteger32()) {
+      return false;
+    }
+    HAdd* add = HAdd::cast(index);
+    HValue* product = add->left();
+    HValue* inner_value = add->right();
+    if (!product->IsMul()) {
+      product = add->right();
+      inner_value = add->left();
+    }
+    if (!product->IsMul() || !product->representation().IsInteger32()) {
+      return false;
+    }
+    HMul* mul = HMul::cast(product);
+    HValue* outer_value = mul->left();
+    HValue* stride = mul->right();
+    if (!outer_value->IsPhi()) {
+      outer_value = mul->right();
+      stride = mul->left();
+    }
+
+    InductionVariableData* outer =
+        GetGrowingInductionVariable(outer_value, check);
+    InductionVariableData* inner =
+        GetGrowingInductionVariable(inner_value, check);
+    if (outer == NULL || inner == NULL || outer == inner) return false;
+    HLoopInformation* outer_loop = outer->phi()->block()->current_loop();
+    HLoopInformation* inner_loop = inner->phi()->block()->current_loop();
+    if (outer_loop == inner_loop ||
+        !outer_loop->IsNestedInThisLoop(inner_loop)) {
+      return false;
+    }
+
+    // The inner variable must stay below the stride.
+    HValue* inner_limit = inner->limit();
+    if (inner_limit != stride &&
+        !(inner_limit->IsInteger32Constant() &&
+          stride->IsInteger32Constant() &&
+          inner_limit->GetInteger32Constant() <=
+              stride->GetInteger32Constant())) {
+      return false;
+    }
+
+    // The operands of the hoisted check must be available before the outer
+    // loop is entered.
+    HBasicBlock* pre_header = PreHeaderOf(outer);
+    HValue* outer_limit = outer->limit();
+    if (!IsDefinedIn(outer_limit, pre_header) ||
+        !IsDefinedIn(stride, pre_header) ||
+        !IsDefinedIn(length, pre_header)) {
+      return false;
+    }
+    if (!outer_limit->representation().IsInteger32() &&
+        !outer_limit->IsInteger32Constant()) {
+      return false;
+    }
+    if (!stride->representation().IsInteger32() &&
+        !stride->IsInteger32Constant()) {
+      return false;
+    }
+
+    nested_checks_.Add(new(graph()->zone())
+        NestedLoopCheck(check, outer, stride, inner), graph()->zone());
+    return true;
+  }
+
+  // Makes {value} available at the end of {pre_header}, rematerializing
+  // constants that are defined elsewhere.
+  HValue* DefineInPreHeader(HValue* value, HBasicBlock* pre_header) {
+    if (value->IsInteger32Constant() && value->block() != pre_header &&
+        !value->block()->Dominates(pre_header)) {
+      HConstant* constant = HConstant::New(graph()->zone(),
+                                           graph()->GetInvalidContext(),
+                                           value->GetInteger32Constant());
+      constant->InsertBefore(pre_header->end());
+      return constant;
+    }
+    return value;
+  }
+
+  // Tries to replace the checks related to nested_checks_[first] with a
+  // single check in the preheader of their outer loop.
+  void ProcessNestedLoopChecks(int first) {
+    NestedLoopCheck* check = nested_checks_[first];
+
+    // Every iteration of the inner loop must meet one of the checks...
+    InitializeLoop(check->inner);
+    for (int i = first; i < nested_checks_.length(); i++) {
+      NestedLoopCheck* current_check = nested_checks_[i];
+      if (!current_check->IsRelatedTo(check)) continue;
+      AddCheckAt(current_check->check->block());
+      current_check->processed = true;
+    }
+    if (!IsHoistable()) return;
+
+    // ...and every iteration of the outer loop must enter the inner loop.
+    HBasicBlock* inner_pre_header = PreHeaderOf(check->inner);
+    InitializeLoop(check->outer);
+    AddCheckAt(inner_pre_header);
+    if (!IsHoistable()) return;
+
+    // Compute the symbolic bound outer_limit * stride in the preheader. The
+    // multiplication deoptimizes on overflow, the bound is not representable
+    // then and hoisting would be unsound otherwise.
+    Zone* zone = graph()->zone();
+    HValue* context = graph()->GetInvalidContext();
+    HBasicBlock* pre_header = PreHeaderOf(check->outer);
+    HValue* outer_limit = check->outer->limit();
+    HValue* stride = check->stride;
+    HInstruction* bound;
+    if (outer_limit->IsInteger32Constant() && stride->IsInteger32Constant()) {
+      int64_t value =
+          static_cast<int64_t>(outer_limit->GetInteger32Constant()) *
+          stride->GetInteger32Constant();
+      if (value < 0 || value > kMaxInt) return;
+      bound = HConstant::New(zone, context, static_cast<int32_t>(value));
+    } else {
+      bound = HMul::New(zone, context,
+                        DefineInPreHeader(outer_limit, pre_header),
+                        DefineInPreHeader(stride, pre_header));
+      DCHECK(bound->IsMul());
+      bound->AssumeRepresentation(Representation::Integer32());
+    }
+    bound->InsertBefore(pre_header->end());
+
+    for (int i = first; i < nested_checks_.length(); i++) {
+      NestedLoopCheck* current_check = nested_checks_[i];
+      if (!current_check->IsRelatedTo(check)) continue;
+      counters()->bounds_checks_eliminated()->Increment();
+      current_check->check->set_skip_check();
+    }
+
+    HBoundsCheck* hoisted_check =
+        HBoundsCheck::New(zone, context, bound, check->check->length());
+    hoisted_check->AssumeRepresentation(Representation::Integer32());
+    hoisted_check->set_allow_equality(true);
+    hoisted_check->InsertBefore(pre_header->end());
+    counters()->bounds_checks_hoisted()->Increment();
+  }
+
   HGraph* graph_;
   HBasicBlock* loop_header_;
   ZoneList<Element> elements_;
+  ZoneList<NestedLoopCheck*> nested_checks_;
 };
 
 
@@ -373,6 +602,7 @@ void HBoundsCheckHoistingPhase::HoistRedundantBoundsChecks() {
   for (int i = 0; i < graph()->blocks()->length(); i++) {
     table.EliminateRedundantBoundsChecks(graph()->blocks()->at(i));
   }
+  table.HoistNestedLoopChecks();
 }
 
 } }  // namespace v8::internal
@@ -813,6 +813,7 @@ bool HInstruction::CanDeoptimize() {
     case HValue::kDoubleBits:
     case HValue::kDummyUse:
     case HValue::kEnterInlined:
+    case HValue::kEnterTry:
     case HValue::kEnvironmentMarker:
     case HValue::kForceRepresentation:
     case HValue::kGetCachedArrayIndex:
@@ -828,6 +829,7 @@ bool HInstruction::CanDeoptimize() {
     case HValue::kIsStringAndBranch:
     case HValue::kIsUndetectableAndBranch:
     case HValue::kLeaveInlined:
+    case HValue::kLeaveTry:
     case HValue::kLoadFieldByIndex:
     case HValue::kLoadGlobalGeneric:
     case HValue::kLoadNamedField:
@@ -841,6 +843,7 @@ bool HInstruction::CanDeoptimize() {
     case HValue::kRegExpLiteral:
     case HValue::kReturn:
     case HValue::kSeqStringGetChar:
+    case HValue::kStoreCatchSlot:
     case HValue::kStoreCodeEntry:
     case HValue::kStoreFrameContext:
     case HValue::kStoreKeyed:
@@ -861,6 +864,7 @@ bool HInstruction::CanDeoptimize() {
     case HValue::kBitwise:
     case HValue::kBoundsCheck:
     case HValue::kBranch:
+    case HValue::kCallFastApiFunction:
     case HValue::kCallJSFunction:
     case HValue::kCallRuntime:
     case HValue::kChange:
@@ -1090,8 +1094,18 @@ std::ostream& HCallWithDescriptor::PrintDataTo(
 }
 
 
+std::ostream& HCallFastApiFunction::PrintDataTo(
+    std::ostream& os) const {  // NOLINT
+  for (int i = 0; i < OperandCount(); i++) {
+    os << NameOf(OperandAt(i)) << " ";
+  }
+  return os << "@" << static_cast<void*>(function_);
+}
+
+
 std::ostream& HCallNewArray::PrintDataTo(std::ostream& os) const {  // NOLINT
   os << ElementsKindToString(elements_kind()) << " ";
+  if (override_mode() == DONT_OVERRIDE) os << "[tracking] ";
   return HBinaryCall::PrintDataTo(os);
 }
 
@@ -1159,7 +1173,8 @@ Representation HBranch::observed_input_representation(int index) {
       ToBooleanStub::NULL_TYPE |
       ToBooleanStub::SPEC_OBJECT |
       ToBooleanStub::STRING |
-      ToBooleanStub::SYMBOL);
+      ToBooleanStub::SYMBOL |
+      ToBooleanStub::SIMD_VALUE);
   if (expected_input_types_.ContainsAnyOf(tagged_types)) {
     return Representation::Tagged();
   }
@@ -1325,6 +1340,11 @@ static String* TypeOfString(HConstant* constant, Isolate* isolate) {
     }
     case SYMBOL_TYPE:
       return heap->symbol_string();
+#define SIMD128_TYPE_CASE(TYPE, Type, type, lane_count, lane_type) \
+    case TYPE##_TYPE:                                              \
+      return heap->type##_string();
+    SIMD128_TYPES(SIMD128_TYPE_CASE)
+#undef SIMD128_TYPE_CASE
     case JS_FUNCTION_TYPE:
     case JS_FUNCTION_PROXY_TYPE:
       return heap->function_string();
@@ -2667,6 +2687,34 @@ std::ostream& HEnterInlined::PrintDataTo(std::ostream& os) const {  // NOLINT
 }
 
 
+void HEnterTry::AddCatchSlot(int env_index, HValue* value) {
+  env_indices_.Add(env_index, zone_);
+  catch_slots_->AddInput(value);
+}
+
+
+int HEnterTry::CatchSlotFor(int env_index) const {
+  for (int i = 0; i < env_indices_.length(); i++) {
+    if (env_indices_[i] == env_index) return i;
+  }
+  UNREACHABLE();
+  return -1;
+}
+
+
+std::ostream& HEnterTry::PrintDataTo(std::ostream& os) const {  // NOLINT
+  os << "handler " << index() << " " << NameOf(context());
+  if (outer() != NULL) os << " outer " << outer()->id();
+  return os << " catch slots " << catch_slot_count();
+}
+
+
+std::ostream& HStoreCatchSlot::PrintDataTo(std::ostream& os) const {  // NOLINT
+  return os << "handler " << entry()->index() << " slot " << slot() << " = "
+            << NameOf(value());
+}
+
+
 static bool IsInteger32(double value) {
   double roundtrip_value = static_cast<double>(static_cast<int32_t>(value));
   return bit_cast<int64_t>(roundtrip_value) == bit_cast<int64_t>(value);
@@ -3879,6 +3927,8 @@ bool HAllocate::HandleSideEffectDominator(GVNFlag side_effect,
                                  type());
   dominated_allocate_instr->InsertBefore(this);
   DeleteAndReplaceWith(dominated_allocate_instr);
+  dominator_allocate->block()->graph()->isolate()->counters()->
+      allocations_folded()->Increment();
   if (FLAG_trace_allocation_folding) {
     PrintF("#%d (%s) folded into #%d (%s)\n",
         id(), Mnemonic(), dominator_allocate->id(),
@@ -4620,6 +4670,9 @@ HObjectAccess HObjectAccess::ForMapAndOffset(Handle<Map> map, int offset,
   if (!map.is_null()) {
     existing_inobject_property = (offset <
         map->instance_size() - map->unused_property_fields() * kPointerSize);
+    if (representation.IsDouble() && map->IsUnboxedDoubleFieldOffset(offset)) {
+      portion = kDouble;
+    }
   }
   return HObjectAccess(portion, offset, representation, Handle<String>::null(),
                        false, existing_inobject_property);
@@ -4686,6 +4739,9 @@ HObjectAccess HObjectAccess::ForField(Handle<Map> map, int index,
     // Negative property indices are in-object properties, indexed
     // from the end of the fixed part of the object.
     int offset = (index * kPointerSize) + map->instance_size();
+    if (representation.IsDouble() && map->IsUnboxedDoubleFieldOffset(offset)) {
+      return HObjectAccess(kDouble, offset, representation, name, false, true);
+    }
     return HObjectAccess(kInobject, offset, representation, name, false, true);
   } else {
     // Non-negative property indices are in the properties array.
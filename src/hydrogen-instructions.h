@@ -61,6 +61,7 @@ class LChunkBuilder;
   V(BoundsCheckBaseIndexInformation)          \
   V(Branch)                                   \
   V(CallWithDescriptor)                       \
+  V(CallFastApiFunction)                      \
   V(CallJSFunction)                           \
   V(CallFunction)                             \
   V(CallNew)                                  \
@@ -94,6 +95,7 @@ class LChunkBuilder;
   V(DoubleBits)                               \
   V(DummyUse)                                 \
   V(EnterInlined)                             \
+  V(EnterTry)                                 \
   V(EnvironmentMarker)                        \
   V(ForceRepresentation)                      \
   V(ForInCacheArray)                          \
@@ -113,6 +115,7 @@ class LChunkBuilder;
   V(IsSmiAndBranch)                           \
   V(IsUndetectableAndBranch)                  \
   V(LeaveInlined)                             \
+  V(LeaveTry)                                 \
   V(LoadContextSlot)                          \
   V(LoadFieldByIndex)                         \
   V(LoadFunctionPrototype)                    \
@@ -142,6 +145,7 @@ class LChunkBuilder;
   V(Shr)                                      \
   V(Simulate)                                 \
   V(StackCheck)                               \
+  V(StoreCatchSlot)                           \
   V(StoreCodeEntry)                           \
   V(StoreContextSlot)                         \
   V(StoreFrameContext)                        \
@@ -1991,7 +1995,8 @@ enum InliningKind {
   NORMAL_RETURN,          // Drop the function from the environment on return.
   CONSTRUCT_CALL_RETURN,  // Either use allocated receiver or return value.
   GETTER_CALL_RETURN,     // Returning from a getter, need to restore context.
-  SETTER_CALL_RETURN      // Use the RHS of the assignment as the return value.
+  SETTER_CALL_RETURN,     // Use the RHS of the assignment as the return value.
+  CALL_FUNCTION_RETURN    // %_CallFunction, the function is not on the stack.
 };
 
 
@@ -2088,6 +2093,100 @@ class HLeaveInlined FINAL : public HTemplateInstruction<0> {
 };
 
 
+class HPushArguments;
+
+
+// Pushes the stack handler of a try block. Optimized code never contains the
+// catch block, the handler deoptimizes to HandlerId in the environment of the
+// HEnterTry instead. All non-constant values of that environment are copied
+// to the catch slots pushed right before the handler, and the locals assigned
+// in the try block keep them up to date with HStoreCatchSlot, so the catch
+// environment only refers to the frame. The environments of the try block
+// contain the HEnterTry itself as a placeholder for the handler words.
+class HEnterTry FINAL : public HTemplateInstruction<1> {
+ public:
+  static HEnterTry* New(Zone* zone, HValue* context, int index,
+                        HEnterTry* outer, HPushArguments* catch_slots) {
+    return new(zone) HEnterTry(context, index, outer, catch_slots, zone);
+  }
+
+  HValue* context() const { return OperandAt(0); }
+  int index() const { return index_; }
+  HEnterTry* outer() const { return outer_; }
+  HPushArguments* catch_slots() const { return catch_slots_; }
+
+  int catch_slot_count() const { return env_indices_.length(); }
+  int catch_slot_env_index(int slot) const { return env_indices_[slot]; }
+
+  // Adds a catch slot for the environment value at env_index.
+  void AddCatchSlot(int env_index, HValue* value);
+  int CatchSlotFor(int env_index) const;
+
+  // The number of words pushed on top of the spill slots below the catch
+  // slots and below the handler words.
+  int stack_index() const {
+    return outer_ == NULL ? 0 : outer_->handler_stack_index() +
+                                StackHandlerConstants::kSlotCount;
+  }
+  int handler_stack_index() const {
+    return stack_index() + catch_slot_count();
+  }
+
+  virtual int argument_delta() const OVERRIDE {
+    return StackHandlerConstants::kSlotCount;
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) OVERRIDE {
+    return Representation::Tagged();
+  }
+
+  virtual std::ostream& PrintDataTo(std::ostream& os) const OVERRIDE;  // NOLINT
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry)
+
+ private:
+  HEnterTry(HValue* context, int index, HEnterTry* outer,
+            HPushArguments* catch_slots, Zone* zone)
+      : index_(index),
+        outer_(outer),
+        catch_slots_(catch_slots),
+        env_indices_(4, zone),
+        zone_(zone) {
+    SetOperandAt(0, context);
+  }
+
+  int index_;
+  HEnterTry* outer_;
+  HPushArguments* catch_slots_;
+  ZoneList<int> env_indices_;
+  Zone* zone_;
+};
+
+
+// Pops the stack handler and the catch slots of a try block.
+class HLeaveTry FINAL : public HTemplateInstruction<0> {
+ public:
+  DECLARE_INSTRUCTION_FACTORY_P1(HLeaveTry, HEnterTry*);
+
+  HEnterTry* entry() const { return entry_; }
+
+  virtual int argument_delta() const OVERRIDE {
+    return -(entry_->catch_slot_count() + StackHandlerConstants::kSlotCount);
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) OVERRIDE {
+    return Representation::None();
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry)
+
+ private:
+  explicit HLeaveTry(HEnterTry* entry) : entry_(entry) { }
+
+  HEnterTry* entry_;
+};
+
+
 class HPushArguments FINAL : public HInstruction {
  public:
   static HPushArguments* New(Zone* zone, HValue* context) {
@@ -2156,6 +2255,38 @@ class HPushArguments FINAL : public HInstruction {
 };
 
 
+// Updates a catch slot of a try block after the local it belongs to has been
+// assigned in the try block.
+class HStoreCatchSlot FINAL : public HTemplateInstruction<1> {
+ public:
+  DECLARE_INSTRUCTION_FACTORY_P3(HStoreCatchSlot, HEnterTry*, int, HValue*);
+
+  HEnterTry* entry() const { return entry_; }
+  int slot() const { return slot_; }
+  HValue* value() const { return OperandAt(0); }
+
+  // The number of words pushed on top of the spill slots below the slot.
+  int stack_index() const { return entry_->stack_index() + slot_; }
+
+  virtual Representation RequiredInputRepresentation(int index) OVERRIDE {
+    return Representation::Tagged();
+  }
+
+  virtual std::ostream& PrintDataTo(std::ostream& os) const OVERRIDE;  // NOLINT
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreCatchSlot)
+
+ private:
+  HStoreCatchSlot(HEnterTry* entry, int slot, HValue* value)
+      : entry_(entry), slot_(slot) {
+    SetOperandAt(0, value);
+  }
+
+  HEnterTry* entry_;
+  int slot_;
+};
+
+
 class HThisFunction FINAL : public HTemplateInstruction<0> {
  public:
   DECLARE_INSTRUCTION_FACTORY_P0(HThisFunction);
@@ -2402,6 +2533,100 @@ class HCallWithDescriptor FINAL : public HInstruction {
 };
 
 
+// Calls the fast call handler of an API function with unboxed arguments,
+// see v8::FunctionTemplate::SetFastCallHandler().  The signature is encoded
+// as in FunctionTemplateInfo::fast_call_signature.
+class HCallFastApiFunction FINAL : public HInstruction {
+ public:
+  static HCallFastApiFunction* New(Zone* zone, HValue* context,
+                                   Address function, int signature,
+                                   const Vector<HValue*>& operands) {
+    return new (zone)
+        HCallFastApiFunction(function, signature, operands, zone);
+  }
+
+  virtual int OperandCount() const FINAL OVERRIDE {
+    return values_.length();
+  }
+  virtual HValue* OperandAt(int index) const FINAL OVERRIDE {
+    return values_[index];
+  }
+
+  virtual Representation RequiredInputRepresentation(
+      int index) FINAL OVERRIDE {
+    return RepresentationFor(parameter_type(index));
+  }
+
+  virtual HType CalculateInferredType() FINAL OVERRIDE {
+    switch (return_type()) {
+      case v8::kFastCallInt32:
+      case v8::kFastCallDouble:
+        return HType::TaggedNumber();
+      case v8::kFastCallBool:
+        return HType::Boolean();
+      default:
+        return HType::Tagged();
+    }
+  }
+
+  Address function() const { return function_; }
+  v8::FastCallType return_type() const {
+    return static_cast<v8::FastCallType>(
+        FunctionTemplateInfo::FastCallReturnTypeBits::decode(signature_));
+  }
+  v8::FastCallType parameter_type(int index) const {
+    return FunctionTemplateInfo::FastCallParameterType(signature_, index);
+  }
+
+  virtual std::ostream& PrintDataTo(std::ostream& os) const OVERRIDE;  // NOLINT
+
+  DECLARE_CONCRETE_INSTRUCTION(CallFastApiFunction)
+
+ private:
+  HCallFastApiFunction(Address function, int signature,
+                       const Vector<HValue*>& operands, Zone* zone)
+      : function_(function),
+        signature_(signature),
+        values_(operands.length(), zone) {
+    for (int i = 0; i < operands.length(); i++) {
+      values_.Add(NULL, zone);
+      SetOperandAt(i, operands[i]);
+    }
+    // Booleans are converted to true or false by the call itself.
+    v8::FastCallType type = return_type();
+    set_representation(type == v8::kFastCallBool
+                           ? Representation::Tagged()
+                           : RepresentationFor(type));
+    SetAllSideEffects();
+  }
+
+  // Booleans are passed as the integers 0 and 1.
+  static Representation RepresentationFor(v8::FastCallType type) {
+    switch (type) {
+      case v8::kFastCallInt32:
+      case v8::kFastCallBool:
+        return Representation::Integer32();
+      case v8::kFastCallDouble:
+        return Representation::Double();
+      case v8::kFastCallHolder:
+        return Representation::External();
+      case v8::kFastCallVoid:
+        break;
+    }
+    return Representation::Tagged();
+  }
+
+  virtual void InternalSetOperandAt(int index,
+                                    HValue* value) FINAL OVERRIDE {
+    values_[index] = value;
+  }
+
+  Address function_;
+  int signature_;
+  ZoneList<HValue*> values_;
+};
+
+
 class HInvokeFunction FINAL : public HBinaryCall {
  public:
   DECLARE_INSTRUCTION_WITH_CONTEXT_FACTORY_P2(HInvokeFunction, HValue*, int);
@@ -2493,10 +2718,12 @@ class HCallNew FINAL : public HBinaryCall {
 
 class HCallNewArray FINAL : public HBinaryCall {
  public:
-  DECLARE_INSTRUCTION_WITH_CONTEXT_FACTORY_P3(HCallNewArray,
+  DECLARE_INSTRUCTION_WITH_CONTEXT_FACTORY_P5(HCallNewArray,
                                               HValue*,
                                               int,
-                                              ElementsKind);
+                                              ElementsKind,
+                                              Handle<AllocationSite>,
+                                              AllocationSiteOverrideMode);
 
   HValue* context() { return first(); }
   HValue* constructor() { return second(); }
@@ -2504,16 +2731,23 @@ class HCallNewArray FINAL : public HBinaryCall {
   virtual std::ostream& PrintDataTo(std::ostream& os) const OVERRIDE;  // NOLINT
 
   ElementsKind elements_kind() const { return elements_kind_; }
+  Handle<AllocationSite> site() const { return site_; }
+  AllocationSiteOverrideMode override_mode() const { return override_mode_; }
 
   DECLARE_CONCRETE_INSTRUCTION(CallNewArray)
 
  private:
   HCallNewArray(HValue* context, HValue* constructor, int argument_count,
-                ElementsKind elements_kind)
+                ElementsKind elements_kind, Handle<AllocationSite> site,
+                AllocationSiteOverrideMode override_mode)
       : HBinaryCall(context, constructor, argument_count),
-        elements_kind_(elements_kind) {}
+        elements_kind_(elements_kind),
+        site_(site),
+        override_mode_(override_mode) {}
 
   ElementsKind elements_kind_;
+  Handle<AllocationSite> site_;
+  AllocationSiteOverrideMode override_mode_;
 };
 
 
@@ -5991,6 +6225,12 @@ class HObjectAccess FINAL {
     return portion() == kMaps;
   }
 
+  // For a resolved field access, returns true if the field holds its double
+  // value directly in the object instead of pointing to a HeapNumber box.
+  inline bool IsUnboxedDouble() const {
+    return portion() == kDouble;
+  }
+
   inline int offset() const {
     return OffsetField::decode(value_);
   }
@@ -6023,6 +6263,11 @@ class HObjectAccess FINAL {
         kDouble, HeapNumber::kValueOffset, Representation::Double());
   }
 
+  // Create an access to a Double field that is stored unboxed in-object.
+  static HObjectAccess ForUnboxedDoubleField(int offset) {
+    return HObjectAccess(kDouble, offset, Representation::Double());
+  }
+
   static HObjectAccess ForHeapNumberValueLowestBits() {
     return HObjectAccess(kDouble,
                          HeapNumber::kValueOffset,
@@ -6278,6 +6523,11 @@ class HObjectAccess FINAL {
         JSArrayBufferView::kByteLengthOffset);
   }
 
+  static HObjectAccess ForJSCollectionTable() {
+    return HObjectAccess::ForObservableJSObjectOffset(
+        JSCollection::kTableOffset);
+  }
+
   static HObjectAccess ForGlobalObjectNativeContext() {
     return HObjectAccess(kInobject, GlobalObject::kNativeContextOffset);
   }
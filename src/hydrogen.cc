@@ -10,6 +10,7 @@
 
 #include "src/allocation-site-scopes.h"
 #include "src/full-codegen.h"
+#include "src/hydrogen-allocation-folding.h"
 #include "src/hydrogen-bce.h"
 #include "src/hydrogen-bch.h"
 #include "src/hydrogen-canonicalize.h"
@@ -1630,8 +1631,14 @@ HValue* HGraphBuilder::BuildKeyedLookupCacheHash(HValue* object,
 
 HValue* HGraphBuilder::BuildElementIndexHash(HValue* index) {
   int32_t seed_value = static_cast<uint32_t>(isolate()->heap()->HashSeed());
+  return BuildIntegerHash(index, seed_value);
+}
+
+
+// Computes ComputeIntegerHash(value, seed) without the final mask.
+HValue* HGraphBuilder::BuildIntegerHash(HValue* value, int32_t seed_value) {
   HValue* seed = Add<HConstant>(seed_value);
-  HValue* hash = AddUncasted<HBitwise>(Token::BIT_XOR, index, seed);
+  HValue* hash = AddUncasted<HBitwise>(Token::BIT_XOR, value, seed);
 
   // hash = ~hash + (hash << 15);
   HValue* shifted_hash = AddUncasted<HShl>(hash, Add<HConstant>(15));
@@ -3944,6 +3951,7 @@ FunctionState::FunctionState(HOptimizedGraphBuilder* owner,
       function_return_(NULL),
       test_context_(NULL),
       entry_(NULL),
+      try_entry_(NULL),
       arguments_object_(NULL),
       arguments_elements_(NULL),
       inlining_id_(inlining_id),
@@ -4040,7 +4048,8 @@ void ValueContext::ReturnValue(HValue* value) {
   // The value is tracked in the bailout environment, and communicated
   // through the environment as the result of the expression.
   if (!arguments_allowed() && value->CheckFlag(HValue::kIsArguments)) {
-    owner()->Bailout(kBadValueContextForArgumentsValue);
+    owner()->BailoutOnEscapingArguments(value,
+                                        kBadValueContextForArgumentsValue);
   }
   owner()->Push(value);
 }
@@ -4092,7 +4101,8 @@ void EffectContext::ReturnContinuation(HIfContinuation* continuation,
 void ValueContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
   DCHECK(!instr->IsControlInstruction());
   if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
-    return owner()->Bailout(kBadValueContextForArgumentsObjectValue);
+    return owner()->BailoutOnEscapingArguments(
+        instr, kBadValueContextForArgumentsObjectValue);
   }
   owner()->AddInstruction(instr);
   owner()->Push(instr);
@@ -4105,7 +4115,8 @@ void ValueContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
 void ValueContext::ReturnControl(HControlInstruction* instr, BailoutId ast_id) {
   DCHECK(!instr->HasObservableSideEffects());
   if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
-    return owner()->Bailout(kBadValueContextForArgumentsObjectValue);
+    return owner()->BailoutOnEscapingArguments(
+        instr, kBadValueContextForArgumentsObjectValue);
   }
   HBasicBlock* materialize_false = owner()->graph()->CreateBasicBlock();
   HBasicBlock* materialize_true = owner()->graph()->CreateBasicBlock();
@@ -4230,6 +4241,19 @@ void HOptimizedGraphBuilder::Bailout(BailoutReason reason) {
 }
 
 
+void HOptimizedGraphBuilder::BailoutOnEscapingArguments(
+    HValue* value, BailoutReason reason) {
+  Handle<SharedFunctionInfo> shared = current_info()->shared_info();
+  if (value != graph()->GetArgumentsObject() || !CanMaterializeArguments() ||
+      shared->materialize_arguments()) {
+    return Bailout(reason);
+  }
+  shared->set_materialize_arguments(true);
+  current_info()->RetryOptimization(reason);
+  SetStackOverflow();
+}
+
+
 void HOptimizedGraphBuilder::VisitForEffect(Expression* expr) {
   EffectContext for_effect(this);
   Visit(expr);
@@ -4308,6 +4332,15 @@ bool HOptimizedGraphBuilder::BuildGraph() {
   if (scope->is_function_scope() && scope->function() != NULL) {
     VisitVariableDeclaration(scope->function());
   }
+  // An arguments object that escapes is allocated up front, so that all
+  // uses see the same object. Other arguments objects are only kept on the
+  // stack.
+  if (scope->arguments() != NULL &&
+      current_info()->shared_info()->materialize_arguments() &&
+      CanMaterializeArguments()) {
+    environment()->Bind(scope->arguments(), BuildArgumentsObject());
+  }
+
   VisitDeclarations(scope->declarations());
   Add<HSimulate>(BailoutId::Declarations());
 
@@ -4357,7 +4390,8 @@ bool HGraph::Optimize(BailoutReason* bailout_reason) {
   Verify(true);
 #endif
 
-  if (FLAG_analyze_environment_liveness && maximum_environment_size() != 0) {
+  if (FLAG_analyze_environment_liveness && maximum_environment_size() != 0 &&
+      info()->function()->handler_count() == 0) {
     Run<HEnvironmentLivenessAnalysisPhase>();
   }
 
@@ -4403,6 +4437,8 @@ bool HGraph::Optimize(BailoutReason* bailout_reason) {
 
   if (FLAG_use_canonicalizing) Run<HCanonicalizePhase>();
 
+  if (FLAG_use_allocation_folding) Run<HAllocationFoldingPhase>();
+
   if (FLAG_use_gvn) Run<HGlobalValueNumberingPhase>();
 
   if (FLAG_check_elimination) Run<HCheckEliminationPhase>();
@@ -4417,7 +4453,10 @@ bool HGraph::Optimize(BailoutReason* bailout_reason) {
   Run<HStackCheckEliminationPhase>();
 
   if (FLAG_array_bounds_checks_elimination) Run<HBoundsCheckEliminationPhase>();
-  if (FLAG_array_bounds_checks_hoisting) Run<HBoundsCheckHoistingPhase>();
+  if (FLAG_array_bounds_checks_hoisting ||
+      FLAG_array_bounds_checks_nested_hoisting) {
+    Run<HBoundsCheckHoistingPhase>();
+  }
   if (FLAG_array_index_dehoisting) Run<HDehoistIndexComputationsPhase>();
   if (FLAG_dead_code_elimination) Run<HDeadCodeEliminationPhase>();
 
@@ -4525,6 +4564,65 @@ void HOptimizedGraphBuilder::SetUpScope(Scope* scope) {
 }
 
 
+bool HOptimizedGraphBuilder::CanMaterializeArguments() {
+  // Sloppy mode arguments objects alias the parameters. Without parameters
+  // they are plain copies of the actual arguments as well.
+  Scope* scope = current_info()->scope();
+  return scope->arguments() != NULL &&
+         scope->arguments()->IsStackAllocated() &&
+         (current_info()->strict_mode() == STRICT ||
+          scope->num_parameters() == 0);
+}
+
+
+HValue* HOptimizedGraphBuilder::BuildArgumentsObject() {
+  DCHECK(CanMaterializeArguments());
+  HInstruction* elements = Add<HArgumentsElements>(false);
+  HInstruction* length = Add<HArgumentsLength>(elements);
+
+  HValue* backing_store =
+      BuildAllocateAndInitializeArray(FAST_ELEMENTS, length);
+  {
+    LoopBuilder builder(this, context(), LoopBuilder::kPostIncrement);
+    HValue* key = builder.BeginBody(graph()->GetConstant0(), length, Token::LT);
+    HInstruction* argument = Add<HAccessArgumentsAt>(elements, length, key);
+    Add<HStoreKeyed>(backing_store, key, argument, FAST_ELEMENTS);
+    builder.EndBody();
+  }
+
+  bool is_strict = current_info()->strict_mode() == STRICT;
+  int size = is_strict ? Heap::kStrictArgumentsObjectSize
+                       : Heap::kSloppyArgumentsObjectSize;
+  int map_index = is_strict ? Context::STRICT_ARGUMENTS_MAP_INDEX
+                            : Context::SLOPPY_ARGUMENTS_MAP_INDEX;
+  HValue* map = Add<HLoadNamedField>(
+      BuildGetNativeContext(), static_cast<HValue*>(NULL),
+      HObjectAccess::ForContextSlot(map_index));
+  HAllocate* object = Add<HAllocate>(Add<HConstant>(size), HType::JSObject(),
+                                     NOT_TENURED, JS_OBJECT_TYPE);
+  Add<HStoreNamedField>(object, HObjectAccess::ForMap(), map);
+  Add<HStoreNamedField>(
+      object, HObjectAccess::ForPropertiesPointer(),
+      Add<HConstant>(isolate()->factory()->empty_fixed_array()));
+  Add<HStoreNamedField>(object, HObjectAccess::ForElementsPointer(),
+                        backing_store);
+  Add<HStoreNamedField>(
+      object,
+      HObjectAccess::ForObservableJSObjectOffset(
+          JSObject::kHeaderSize + Heap::kArgumentsLengthIndex * kPointerSize,
+          Representation::Smi()),
+      length);
+  if (!is_strict) {
+    Add<HStoreNamedField>(
+        object,
+        HObjectAccess::ForObservableJSObjectOffset(
+            JSObject::kHeaderSize + Heap::kArgumentsCalleeIndex * kPointerSize),
+        Add<HThisFunction>());
+  }
+  return object;
+}
+
+
 Type* HOptimizedGraphBuilder::ToType(Handle<Map> map) {
   return IC::MapToType<Type>(map, zone());
 }
@@ -4548,8 +4646,14 @@ void HOptimizedGraphBuilder::VisitBlock(Block* stmt) {
   Scope* scope = stmt->scope();
   BreakAndContinueInfo break_info(stmt, outer_scope);
 
+  // Blocks whose variables all live in the stack frame need no context.
+  bool needs_context = scope != NULL && scope->num_heap_slots() > 0;
   { BreakAndContinueScope push(&break_info, this);
-    if (scope != NULL) {
+    if (scope != NULL && !needs_context) {
+      set_scope(scope);
+      VisitDeclarations(scope->declarations());
+      AddSimulate(stmt->DeclsId(), REMOVABLE_SIMULATE);
+    } else if (scope != NULL) {
       // Load the function object.
       Scope* declaration_scope = scope->DeclarationScope();
       HInstruction* function;
@@ -4577,7 +4681,7 @@ void HOptimizedGraphBuilder::VisitBlock(Block* stmt) {
     CHECK_BAILOUT(VisitStatements(stmt->statements()));
   }
   set_scope(outer_scope);
-  if (scope != NULL && current_block() != NULL) {
+  if (needs_context && current_block() != NULL) {
     HValue* inner_context = environment()->context();
     HValue* outer_context = Add<HLoadNamedField>(
         inner_context, static_cast<HValue*>(NULL),
@@ -4657,7 +4761,8 @@ HBasicBlock* HOptimizedGraphBuilder::BreakAndContinueScope::Get(
     BreakableStatement* stmt,
     BreakType type,
     Scope** scope,
-    int* drop_extra) {
+    int* drop_extra,
+    HEnterTry** try_entry) {
   *drop_extra = 0;
   BreakAndContinueScope* current = this;
   while (current != NULL && current->info()->target() != stmt) {
@@ -4666,6 +4771,7 @@ HBasicBlock* HOptimizedGraphBuilder::BreakAndContinueScope::Get(
   }
   DCHECK(current != NULL);  // Always found (unless stack is malformed).
   *scope = current->info()->scope();
+  *try_entry = current->try_entry_;
 
   if (type == BREAK) {
     *drop_extra += current->info()->drop_extra();
@@ -4702,10 +4808,12 @@ void HOptimizedGraphBuilder::VisitContinueStatement(
   Scope* outer_scope = NULL;
   Scope* inner_scope = scope();
   int drop_extra = 0;
+  HEnterTry* try_entry = NULL;
   HBasicBlock* continue_block = break_scope()->Get(
       stmt->target(), BreakAndContinueScope::CONTINUE,
-      &outer_scope, &drop_extra);
+      &outer_scope, &drop_extra, &try_entry);
   HValue* context = environment()->context();
+  drop_extra += LeaveTryBlocks(try_entry);
   Drop(drop_extra);
   int context_pop_count = inner_scope->ContextChainLength(outer_scope);
   if (context_pop_count > 0) {
@@ -4734,10 +4842,12 @@ void HOptimizedGraphBuilder::VisitBreakStatement(BreakStatement* stmt) {
   Scope* outer_scope = NULL;
   Scope* inner_scope = scope();
   int drop_extra = 0;
+  HEnterTry* try_entry = NULL;
   HBasicBlock* break_block = break_scope()->Get(
       stmt->target(), BreakAndContinueScope::BREAK,
-      &outer_scope, &drop_extra);
+      &outer_scope, &drop_extra, &try_entry);
   HValue* context = environment()->context();
+  drop_extra += LeaveTryBlocks(try_entry);
   Drop(drop_extra);
   int context_pop_count = inner_scope->ContextChainLength(outer_scope);
   if (context_pop_count > 0) {
@@ -4768,6 +4878,7 @@ void HOptimizedGraphBuilder::VisitReturnStatement(ReturnStatement* stmt) {
     // Not an inlined return, so an actual one.
     CHECK_ALIVE(VisitForValue(stmt->expression()));
     HValue* result = environment()->Pop();
+    LeaveTryBlocks(NULL);
     Add<HReturn>(result);
   } else if (state->inlining_kind() == CONSTRUCT_CALL_RETURN) {
     // Return from an inlined construct call. In a test context the return value
@@ -4857,40 +4968,63 @@ void HOptimizedGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
   HValue* tag_value = Top();
   Type* tag_type = stmt->tag()->bounds().lower;
 
-  // 1. Build all the tests, with dangling true branches
-  BailoutId default_id = BailoutId::None();
-  for (int i = 0; i < clause_count; ++i) {
-    CaseClause* clause = clauses->at(i);
-    if (clause->is_default()) {
-      body_blocks.Add(NULL, zone());
-      if (default_id.IsNone()) default_id = clause->EntryId();
-      continue;
+  // 1. Build all the tests, with dangling true branches. Switches over many
+  // Smi literals use a binary search instead of a chain of tests; a tag that
+  // is not a Smi deoptimizes back to the chain in unoptimized code.
+  ZoneList<SmiSwitchCase> smi_cases(clause_count, zone());
+  if (CollectSmiSwitchCases(stmt, &smi_cases)) {
+    HValue* tag =
+        AddUncasted<HForceRepresentation>(tag_value, Representation::Smi());
+    for (int i = 0; i < clause_count; ++i) {
+      HBasicBlock* body_block =
+          clauses->at(i)->is_default() ? NULL : graph()->CreateBasicBlock();
+      body_blocks.Add(body_block, zone());
+    }
+    HBasicBlock* miss_block = graph()->CreateBasicBlock();
+    BuildSmiSwitchSearch(tag, &smi_cases, 0, smi_cases.length(), &body_blocks,
+                         miss_block);
+    for (int i = 0; i < clause_count; ++i) {
+      if (body_blocks[i] == NULL) continue;
+      set_current_block(body_blocks[i]);
+      Drop(1);  // tag_value
     }
+    miss_block->SetJoinId(stmt->EntryId());
+    set_current_block(miss_block);
+  } else {
+    BailoutId default_id = BailoutId::None();
+    for (int i = 0; i < clause_count; ++i) {
+      CaseClause* clause = clauses->at(i);
+      if (clause->is_default()) {
+        body_blocks.Add(NULL, zone());
+        if (default_id.IsNone()) default_id = clause->EntryId();
+        continue;
+      }
 
-    // Generate a compare and branch.
-    CHECK_ALIVE(VisitForValue(clause->label()));
-    HValue* label_value = Pop();
-
-    Type* label_type = clause->label()->bounds().lower;
-    Type* combined_type = clause->compare_type();
-    HControlInstruction* compare = BuildCompareInstruction(
-        Token::EQ_STRICT, tag_value, label_value, tag_type, label_type,
-        combined_type,
-        ScriptPositionToSourcePosition(stmt->tag()->position()),
-        ScriptPositionToSourcePosition(clause->label()->position()),
-        PUSH_BEFORE_SIMULATE, clause->id());
-
-    HBasicBlock* next_test_block = graph()->CreateBasicBlock();
-    HBasicBlock* body_block = graph()->CreateBasicBlock();
-    body_blocks.Add(body_block, zone());
-    compare->SetSuccessorAt(0, body_block);
-    compare->SetSuccessorAt(1, next_test_block);
-    FinishCurrentBlock(compare);
+      // Generate a compare and branch.
+      CHECK_ALIVE(VisitForValue(clause->label()));
+      HValue* label_value = Pop();
+
+      Type* label_type = clause->label()->bounds().lower;
+      Type* combined_type = clause->compare_type();
+      HControlInstruction* compare = BuildCompareInstruction(
+          Token::EQ_STRICT, tag_value, label_value, tag_type, label_type,
+          combined_type,
+          ScriptPositionToSourcePosition(stmt->tag()->position()),
+          ScriptPositionToSourcePosition(clause->label()->position()),
+          PUSH_BEFORE_SIMULATE, clause->id());
 
-    set_current_block(body_block);
-    Drop(1);  // tag_value
+      HBasicBlock* next_test_block = graph()->CreateBasicBlock();
+      HBasicBlock* body_block = graph()->CreateBasicBlock();
+      body_blocks.Add(body_block, zone());
+      compare->SetSuccessorAt(0, body_block);
+      compare->SetSuccessorAt(1, next_test_block);
+      FinishCurrentBlock(compare);
 
-    set_current_block(next_test_block);
+      set_current_block(body_block);
+      Drop(1);  // tag_value
+
+      set_current_block(next_test_block);
+    }
   }
 
   // Save the current block to use for the default or to join with the
@@ -4948,6 +5082,81 @@ void HOptimizedGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
 }
 
 
+int HOptimizedGraphBuilder::CompareSmiSwitchCases(const SmiSwitchCase* a,
+                                                  const SmiSwitchCase* b) {
+  if (a->value < b->value) return -1;
+  return a->value > b->value ? 1 : 0;
+}
+
+
+bool HOptimizedGraphBuilder::CollectSmiSwitchCases(
+    SwitchStatement* stmt, ZoneList<SmiSwitchCase>* cases) {
+  static const int kMinCasesForBinarySearch = 8;
+  ZoneList<CaseClause*>* clauses = stmt->cases();
+  if (clauses->length() < kMinCasesForBinarySearch) return false;
+  bool first_test = true;
+  for (int i = 0; i < clauses->length(); ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (clause->is_default()) continue;
+    Literal* literal = clause->label()->AsLiteral();
+    if (literal == NULL || !literal->value()->IsSmi()) break;
+    // Every execution of the switch passes the first test, so its feedback
+    // covers all tags seen so far.
+    if (first_test && !clause->compare_type()->Is(Type::SignedSmall())) break;
+    first_test = false;
+    SmiSwitchCase smi_case = {Smi::cast(*literal->value())->value(), i};
+    cases->Add(smi_case, zone());
+  }
+  bool qualifies = cases->length() >= kMinCasesForBinarySearch &&
+                   cases->length() + 1 >= clauses->length();
+  if (qualifies) {
+    cases->Sort(CompareSmiSwitchCases);
+    for (int i = 1; i < cases->length(); ++i) {
+      if (cases->at(i - 1).value == cases->at(i).value) qualifies = false;
+    }
+  }
+  if (!qualifies) cases->Clear();
+  return qualifies;
+}
+
+
+void HOptimizedGraphBuilder::BuildSmiSwitchSearch(
+    HValue* tag, ZoneList<SmiSwitchCase>* cases, int from, int to,
+    ZoneList<HBasicBlock*>* body_blocks, HBasicBlock* miss_block) {
+  static const int kMaxLinearTests = 3;
+  if (to - from <= kMaxLinearTests) {
+    for (int i = from; i < to; ++i) {
+      HCompareNumericAndBranch* compare = New<HCompareNumericAndBranch>(
+          tag, Add<HConstant>(cases->at(i).value), Token::EQ_STRICT);
+      compare->set_observed_input_representation(Representation::Smi(),
+                                                 Representation::Smi());
+      HBasicBlock* next_test_block = graph()->CreateBasicBlock();
+      compare->SetSuccessorAt(0, body_blocks->at(cases->at(i).index));
+      compare->SetSuccessorAt(1, next_test_block);
+      FinishCurrentBlock(compare);
+      set_current_block(next_test_block);
+    }
+    Goto(miss_block);
+    set_current_block(NULL);
+    return;
+  }
+  int middle = from + (to - from) / 2;
+  HCompareNumericAndBranch* compare = New<HCompareNumericAndBranch>(
+      tag, Add<HConstant>(cases->at(middle).value), Token::LT);
+  compare->set_observed_input_representation(Representation::Smi(),
+                                             Representation::Smi());
+  HBasicBlock* lower_block = graph()->CreateBasicBlock();
+  HBasicBlock* upper_block = graph()->CreateBasicBlock();
+  compare->SetSuccessorAt(0, lower_block);
+  compare->SetSuccessorAt(1, upper_block);
+  FinishCurrentBlock(compare);
+  set_current_block(lower_block);
+  BuildSmiSwitchSearch(tag, cases, from, middle, body_blocks, miss_block);
+  set_current_block(upper_block);
+  BuildSmiSwitchSearch(tag, cases, middle, to, body_blocks, miss_block);
+}
+
+
 void HOptimizedGraphBuilder::VisitLoopBody(IterationStatement* stmt,
                                            HBasicBlock* loop_entry) {
   Add<HSimulate>(stmt->StackCheckId());
@@ -5210,11 +5419,70 @@ void HOptimizedGraphBuilder::VisitForOfStatement(ForOfStatement* stmt) {
 }
 
 
+void HOptimizedGraphBuilder::UpdateCatchSlots(int index, HValue* value) {
+  for (HEnterTry* entry = function_state()->try_entry(); entry != NULL;
+       entry = entry->outer()) {
+    Add<HStoreCatchSlot>(entry, entry->CatchSlotFor(index), value);
+  }
+}
+
+
+int HOptimizedGraphBuilder::LeaveTryBlocks(HEnterTry* target) {
+  int drop_count = 0;
+  for (HEnterTry* entry = function_state()->try_entry(); entry != target;
+       entry = entry->outer()) {
+    Add<HLeaveTry>(entry);
+    drop_count += StackHandlerConstants::kSlotCount;
+  }
+  return drop_count;
+}
+
+
 void HOptimizedGraphBuilder::VisitTryCatchStatement(TryCatchStatement* stmt) {
   DCHECK(!HasStackOverflow());
   DCHECK(current_block() != NULL);
   DCHECK(current_block()->HasPredecessor());
+#if V8_TARGET_ARCH_X64
+  if (!FLAG_optimize_try_catch) return Bailout(kTryCatchStatement);
+#else
   return Bailout(kTryCatchStatement);
+#endif
+  DCHECK(function_state()->outer() == NULL);
+  if (current_info()->is_osr()) {
+    // The OSR entry does not rebuild the handlers of the unoptimized frame.
+    current_info()->RetryOptimization(kTryCatchStatement);
+    return SetStackOverflow();
+  }
+
+  // The catch block is entered by deoptimizing to HandlerId with the
+  // environment of the try statement and the exception on top. The handler
+  // is entered with garbage in all registers, so every value of that
+  // environment is copied to a catch slot on the stack before the handler is
+  // pushed.
+  HPushArguments* catch_slots = Add<HPushArguments>();
+  HEnterTry* entry =
+      New<HEnterTry>(stmt->index(), function_state()->try_entry(), catch_slots);
+  for (int i = 0; i < environment()->length(); i++) {
+    HValue* value = environment()->Lookup(i);
+    if (value->IsEnterTry()) continue;
+    if (value->IsArgumentsObject()) return Bailout(kTryCatchStatement);
+    entry->AddCatchSlot(i, value);
+  }
+  Push(graph()->GetConstantUndefined());
+  Add<HSimulate>(stmt->HandlerId(), FIXED_SIMULATE);
+  Drop(1);
+  AddInstruction(entry);
+  for (int i = 0; i < StackHandlerConstants::kSlotCount; i++) Push(entry);
+  Add<HSimulate>(stmt->TryId(), FIXED_SIMULATE);
+
+  function_state()->set_try_entry(entry);
+  CHECK_BAILOUT(Visit(stmt->try_block()));
+  function_state()->set_try_entry(entry->outer());
+  if (current_block() != NULL) {
+    Add<HLeaveTry>(entry);
+    Drop(StackHandlerConstants::kSlotCount);
+    Add<HSimulate>(stmt->ExitId(), FIXED_SIMULATE);
+  }
 }
 
 
@@ -5484,6 +5752,22 @@ static bool CanInlinePropertyAccess(Type* type) {
 }
 
 
+// Properties of the object itself can be accessed directly despite a named
+// interceptor if the interceptor is non-masking.
+static bool HasNonMaskingInterceptor(Type* type) {
+  if (!type->IsClass()) return false;
+  Handle<Map> map = type->AsClass()->Map();
+  if (!map->IsJSObjectMap() || map->is_dictionary_map() ||
+      !map->has_named_interceptor()) {
+    return false;
+  }
+  JSFunction* constructor = JSFunction::cast(map->constructor());
+  Object* interceptor =
+      constructor->shared()->get_api_func_data()->named_property_handler();
+  return InterceptorInfo::cast(interceptor)->non_masking();
+}
+
+
 // Determines whether the given array or object literal boilerplate satisfies
 // all limits to be considered for fast deep-copying and computes the total
 // size of all objects that are part of the graph.
@@ -5534,6 +5818,9 @@ static bool IsFastLiteral(Handle<JSObject> boilerplate,
       if (details.type() != FIELD) continue;
       int index = descriptors->GetFieldIndex(i);
       if ((*max_properties)-- == 0) return false;
+      FieldIndex field_index =
+          FieldIndex::ForDescriptor(boilerplate->map(), i);
+      if (boilerplate->IsUnboxedDoubleField(field_index)) continue;
       Handle<Object> value(boilerplate->InObjectPropertyAt(index), isolate);
       if (value->IsJSObject()) {
         Handle<JSObject> value_object = Handle<JSObject>::cast(value);
@@ -5835,7 +6122,7 @@ HInstruction* HOptimizedGraphBuilder::BuildLoadNamedField(
   }
 
   HObjectAccess access = info->access();
-  if (access.representation().IsDouble()) {
+  if (access.representation().IsDouble() && !access.IsUnboxedDouble()) {
     // Load the heap number.
     checked_object = Add<HLoadNamedField>(
         checked_object, static_cast<HValue*>(NULL),
@@ -5867,7 +6154,25 @@ HInstruction* HOptimizedGraphBuilder::BuildStoreNamedField(
   HObjectAccess field_access = info->access();
 
   HStoreNamedField *instr;
-  if (field_access.representation().IsDouble()) {
+  if (field_access.IsUnboxedDouble()) {
+    // The double value lives in the object itself. A double store can't
+    // carry the map transition, so install the new map separately, right
+    // after the field has been written.
+    instr = New<HStoreNamedField>(
+        checked_object->ActualValue(), field_access, value,
+        transition_to_field ? INITIALIZING_STORE : STORE_TO_INITIALIZED_ENTRY);
+    if (transition_to_field) {
+      Handle<Map> transition(info->transition());
+      DCHECK(!transition->is_deprecated());
+      AddInstruction(instr);
+      Map::AddDependentCompilationInfo(
+          transition, DependentCode::kTransitionGroup, top_info());
+      instr = New<HStoreNamedField>(checked_object->ActualValue(),
+                                    HObjectAccess::ForMap(),
+                                    Add<HConstant>(transition));
+    }
+    return instr;
+  } else if (field_access.representation().IsDouble()) {
     HObjectAccess heap_number_access =
         field_access.WithRepresentation(Representation::Tagged());
     if (transition_to_field) {
@@ -5968,6 +6273,9 @@ bool HOptimizedGraphBuilder::PropertyAccessInfo::IsCompatible(
   }
   if (info->access_.offset() != access_.offset()) return false;
   if (info->access_.IsInobject() != access_.IsInobject()) return false;
+  if (info->access_.IsUnboxedDouble() != access_.IsUnboxedDouble()) {
+    return false;
+  }
   if (IsLoad()) {
     if (field_maps_.is_empty()) {
       info->field_maps_.Clear();
@@ -6072,6 +6380,7 @@ void HOptimizedGraphBuilder::PropertyAccessInfo::LoadFieldMaps(
   // Add dependency on the map that introduced the field.
   Map::AddDependentCompilationInfo(GetFieldOwnerFromMap(map),
                                    DependentCode::kFieldTypeGroup, top_info());
+  top_info()->AddFieldTypeDependency(lookup_.GetDescriptorIndex());
 }
 
 
@@ -6097,7 +6406,12 @@ bool HOptimizedGraphBuilder::PropertyAccessInfo::LookupInPrototypes() {
 
 
 bool HOptimizedGraphBuilder::PropertyAccessInfo::CanAccessMonomorphic() {
-  if (!CanInlinePropertyAccess(type_)) return false;
+  if (!CanInlinePropertyAccess(type_)) {
+    // Anything but a property of the receiver goes through the interceptor.
+    if (!HasNonMaskingInterceptor(type_)) return false;
+    if (!LookupDescriptor() || !IsFound()) return false;
+    return IsLoad() || !IsReadOnly();
+  }
   if (IsJSObjectFieldAccessor()) return IsLoad();
   if (this->map()->function_with_prototype() &&
       !this->map()->has_non_instance_prototype() &&
@@ -6121,7 +6435,9 @@ bool HOptimizedGraphBuilder::PropertyAccessInfo::CanAccessMonomorphic() {
     PropertyDetails details =
         transition()->instance_descriptors()->GetDetails(descriptor);
     Representation representation = details.representation();
-    access_ = HObjectAccess::ForField(map, index, representation, name_);
+    // The field layout of the new property is defined by the transition.
+    access_ = HObjectAccess::ForField(transition(), index, representation,
+                                      name_);
 
     // Load field map for heap objects.
     LoadFieldMaps(transition());
@@ -7849,6 +8165,10 @@ bool HOptimizedGraphBuilder::TryInline(Handle<JSFunction> target,
     TraceInline(target, caller, "target contains unsupported syntax [late]");
     return false;
   }
+  if (function->handler_count() > 0) {
+    TraceInline(target, caller, "target contains try statements");
+    return false;
+  }
 
   // If the function uses the arguments object check that inlining of functions
   // with arguments object is enabled and the arguments-variable is
@@ -7865,6 +8185,11 @@ bool HOptimizedGraphBuilder::TryInline(Handle<JSFunction> target,
                   "target uses non-stackallocated arguments object");
       return false;
     }
+
+    if (target_shared->materialize_arguments()) {
+      TraceInline(target, caller, "target arguments object escapes");
+      return false;
+    }
   }
 
   // All declarations must be inlineable.
@@ -8058,6 +8383,78 @@ bool HOptimizedGraphBuilder::TryInlineCall(Call* expr) {
 }
 
 
+// Calls to a known bound function skip the bound function itself: its
+// bindings are immutable, so the target is called directly with the bound
+// receiver and the bound arguments pushed in front of the call arguments.
+bool HOptimizedGraphBuilder::TryCallBoundFunction(Call* expr) {
+  if (!FLAG_inline_bound_function_calls) return false;
+  Handle<JSFunction> bound_function = expr->target();
+  if (!bound_function->shared()->bound()) return false;
+  Handle<FixedArray> bindings(bound_function->function_bindings());
+  Handle<Object> target_object(
+      bindings->get(JSFunction::kBoundFunctionIndex), isolate());
+  if (!target_object->IsJSFunction()) return false;
+  Handle<JSFunction> target = Handle<JSFunction>::cast(target_object);
+  DCHECK(!target->shared()->bound());
+
+  // Sloppy mode targets expect the receiver conversion the runtime would do
+  // on every call. Primitive receivers are wrapped into a fresh object each
+  // time, which is left to the generic path.
+  Handle<Object> bound_this(bindings->get(JSFunction::kBoundThisIndex),
+                            isolate());
+  SharedFunctionInfo* shared = target->shared();
+  bool converts_receiver = shared->strict_mode() == SLOPPY &&
+                           !shared->native();
+  HValue* receiver;
+  if (bound_this->IsJSReceiver() || !converts_receiver) {
+    receiver = Add<HConstant>(bound_this);
+  } else if (bound_this->IsUndefined() || bound_this->IsNull()) {
+    if (isolate()->serializer_enabled()) return false;
+    receiver = ImplicitReceiverFor(NULL, target);
+  } else {
+    return false;
+  }
+
+  // Rebuild the expression stack as function, receiver, bound arguments and
+  // call arguments, mirroring what the bound function would push.
+  int argument_count = expr->arguments()->length();
+  int bound_argc = bindings->length() - JSFunction::kBoundArgumentsStartIndex;
+  ZoneList<HValue*> arguments(argument_count, zone());
+  for (int i = 0; i < argument_count; i++) arguments.Add(Pop(), zone());
+  Drop(2);  // Receiver and bound function.
+  Push(Add<HConstant>(target));
+  Push(receiver);
+  for (int i = 0; i < bound_argc; i++) {
+    Handle<Object> argument(
+        bindings->get(JSFunction::kBoundArgumentsStartIndex + i), isolate());
+    Push(Add<HConstant>(argument));
+  }
+  for (int i = argument_count - 1; i >= 0; i--) Push(arguments[i]);
+
+  int total_argc = bound_argc + argument_count;
+  if (FLAG_trace_inlining) {
+    PrintF("Calling target of bound function ");
+    bound_function->ShortPrint();
+    PrintF(" directly\n");
+  }
+  if (TryInline(target,
+                total_argc,
+                NULL,
+                expr->id(),
+                expr->ReturnId(),
+                NORMAL_RETURN,
+                ScriptPositionToSourcePosition(expr->position()))) {
+    return true;
+  }
+
+  PushArgumentsFromEnvironment(total_argc + 1);  // Plus receiver.
+  HInstruction* call = BuildCallConstantFunction(target, total_argc + 1);
+  Drop(1);  // Function.
+  ast_context()->ReturnInstruction(call, expr->id());
+  return true;
+}
+
+
 bool HOptimizedGraphBuilder::TryInlineConstruct(CallNew* expr,
                                                 HValue* implicit_return_value) {
   return TryInline(expr->target(),
@@ -8113,6 +8510,29 @@ bool HOptimizedGraphBuilder::TryInlineApply(Handle<JSFunction> function,
 }
 
 
+bool HOptimizedGraphBuilder::TryInlineCallFunction(CallRuntime* call,
+                                                   HValue* function,
+                                                   int arguments_count) {
+  if (!FLAG_inline_call_function || !function->IsConstant()) return false;
+  Handle<Object> object = HConstant::cast(function)->handle(isolate());
+  if (!object->IsJSFunction()) return false;
+  Handle<JSFunction> target = Handle<JSFunction>::cast(object);
+  if (InliningAstSize(target) == kNotInlinable) return false;
+
+  // The inlined target does not convert its receiver on entry.
+  HValue* receiver = environment()->ExpressionStackAt(arguments_count);
+  environment()->SetExpressionStackAt(arguments_count,
+                                      BuildWrapReceiver(receiver, function));
+  return TryInline(target,
+                   arguments_count,
+                   NULL,
+                   call->id(),
+                   call->ReturnId(),
+                   CALL_FUNCTION_RETURN,
+                   ScriptPositionToSourcePosition(call->position()));
+}
+
+
 bool HOptimizedGraphBuilder::TryInlineBuiltinFunctionCall(Call* expr) {
   if (!expr->target()->shared()->HasBuiltinFunctionId()) return false;
   BuiltinFunctionId id = expr->target()->shared()->builtin_function_id();
@@ -8631,8 +9051,18 @@ bool HOptimizedGraphBuilder::TryInlineApiCall(Handle<JSFunction> function,
       // Need to ensure the chain between receiver and api_holder is intact.
       if (holder_lookup == CallOptimization::kHolderFound) {
         AddCheckPrototypeMaps(api_holder, receiver_maps->first());
+        SmallMapList holder_maps(1, zone());
+        holder_maps.Add(handle(api_holder->map()), zone());
+        if (TryInlineFastApiCall(function, Add<HConstant>(api_holder),
+                                 &holder_maps, argc, ast_id)) {
+          return true;
+        }
       } else {
         DCHECK_EQ(holder_lookup, CallOptimization::kHolderIsReceiver);
+        if (TryInlineFastApiCall(function, receiver, receiver_maps, argc,
+                                 ast_id)) {
+          return true;
+        }
       }
       // Includes receiver.
       PushArgumentsFromEnvironment(argc + 1);
@@ -8708,6 +9138,91 @@ bool HOptimizedGraphBuilder::TryInlineApiCall(Handle<JSFunction> function,
 }
 
 
+bool HOptimizedGraphBuilder::TryInlineFastApiCall(Handle<JSFunction> function,
+                                                  HValue* holder,
+                                                  SmallMapList* holder_maps,
+                                                  int argc,
+                                                  BailoutId ast_id) {
+#if V8_TARGET_ARCH_X64
+  if (!FLAG_fast_api_calls) return false;
+  FunctionTemplateInfo* info = function->shared()->get_api_func_data();
+  if (info->fast_call_handler()->IsUndefined()) return false;
+  int signature = Smi::cast(info->fast_call_signature())->value();
+  int parameter_count =
+      FunctionTemplateInfo::FastCallParameterCountBits::decode(signature);
+  bool takes_holder =
+      parameter_count > 0 &&
+      FunctionTemplateInfo::FastCallParameterType(signature, 0) ==
+          v8::kFastCallHolder;
+  int first_argument = takes_holder ? 1 : 0;
+  if (parameter_count - first_argument != argc) return false;
+
+  if (takes_holder) {
+    // The internal fields of plain API objects follow the JSObject header,
+    // the holder must have at least one of them.
+    for (int i = 0; i < holder_maps->length(); i++) {
+      Handle<Map> map = holder_maps->at(i);
+      if (map->instance_type() != JS_OBJECT_TYPE) return false;
+      int internal_fields =
+          (map->instance_size() - JSObject::kHeaderSize) / kPointerSize -
+          map->inobject_properties();
+      if (internal_fields < 1) return false;
+    }
+  }
+
+  if (FLAG_trace_inlining) {
+    PrintF("Calling fast handler of api function ");
+    function->ShortPrint();
+    PrintF("\n");
+  }
+
+  HValue* operands[v8::FunctionTemplate::kMaxFastCallParameters];
+  for (int i = parameter_count - 1; i >= first_argument; i--) {
+    operands[i] = Pop();
+  }
+  Drop(2);  // Receiver and function.
+  if (takes_holder) {
+    operands[0] = Add<HLoadNamedField>(
+        holder, static_cast<HValue*>(NULL),
+        HObjectAccess::ForObservableJSObjectOffset(
+            JSObject::kHeaderSize, Representation::External()));
+  }
+  for (int i = first_argument; i < parameter_count; i++) {
+    if (FunctionTemplateInfo::FastCallParameterType(signature, i) !=
+        v8::kFastCallBool) {
+      continue;
+    }
+    // Booleans are passed as 0 or 1, other values are not converted.
+    IfBuilder if_true(this);
+    if_true.If<HCompareObjectEqAndBranch>(operands[i],
+                                          graph()->GetConstantTrue());
+    if_true.Then();
+    Push(graph()->GetConstant1());
+    if_true.Else();
+    {
+      IfBuilder if_false(this);
+      if_false.If<HCompareObjectEqAndBranch>(operands[i],
+                                             graph()->GetConstantFalse());
+      if_false.Then();
+      if_false.ElseDeopt("argument of fast api call is not a boolean");
+    }
+    Push(graph()->GetConstant0());
+    if_true.End();
+    operands[i] = Pop();
+  }
+
+  Address handler = v8::ToCData<Address>(info->fast_call_handler());
+  HInstruction* call = New<HCallFastApiFunction>(
+      handler, signature, Vector<HValue*>(operands, parameter_count));
+  ast_context()->ReturnInstruction(call, ast_id);
+  return true;
+#else
+  // The C calling convention is only implemented by the x64 backend.
+  return false;
+#endif
+}
+
+
 bool HOptimizedGraphBuilder::TryCallApply(Call* expr) {
   DCHECK(expr->expression()->IsProperty());
 
@@ -8796,6 +9311,19 @@ HValue* HOptimizedGraphBuilder::ImplicitReceiverFor(HValue* function,
 }
 
 
+// Arrays allocated by optimized code carry allocation mementos while their
+// site can still learn a more general elements kind, so that the site
+// learns from transitions of these arrays too.
+static AllocationSiteOverrideMode ArrayAllocationSiteOverrideMode(
+    ElementsKind kind) {
+  if (FLAG_optimized_array_allocation_tracking &&
+      AllocationSite::GetMode(kind) == TRACK_ALLOCATION_SITE) {
+    return DONT_OVERRIDE;
+  }
+  return DISABLE_ALLOCATION_SITES;
+}
+
+
 void HOptimizedGraphBuilder::BuildArrayCall(Expression* expression,
                                             int arguments_count,
                                             HValue* function,
@@ -8807,8 +9335,16 @@ void HOptimizedGraphBuilder::BuildArrayCall(Expression* expression,
     return;
   }
 
+  ElementsKind kind = site->GetElementsKind();
+  AllocationSiteOverrideMode override_mode =
+      ArrayAllocationSiteOverrideMode(kind);
+  if (override_mode == DONT_OVERRIDE) {
+    // Deoptimize if an allocation memento leads to a transition of the site.
+    AllocationSite::AddDependentCompilationInfo(
+        site, AllocationSite::TRANSITIONS, top_info());
+  }
   HInstruction* call = PreProcessCall(New<HCallNewArray>(
-      function, arguments_count + 1, site->GetElementsKind()));
+      function, arguments_count + 1, kind, site, override_mode));
   if (expression->IsCall()) {
     Drop(1);
   }
@@ -9067,7 +9603,7 @@ void HOptimizedGraphBuilder::VisitCall(Call* expr) {
         // HWrapReceiver.
         call = New<HCallFunction>(
             function, argument_count, WRAP_AND_CALL);
-      } else if (TryInlineCall(expr)) {
+      } else if (TryCallBoundFunction(expr) || TryInlineCall(expr)) {
         return;
       } else {
         call = BuildCallConstantFunction(known_function, argument_count);
@@ -9126,6 +9662,7 @@ void HOptimizedGraphBuilder::VisitCall(Call* expr) {
         }
         if (TryInlineApiFunctionCall(expr, receiver)) return;
         if (TryHandleArrayCall(expr, function)) return;
+        if (TryCallBoundFunction(expr)) return;
         if (TryInlineCall(expr)) return;
 
         PushArgumentsFromEnvironment(argument_count);
@@ -9156,6 +9693,7 @@ void HOptimizedGraphBuilder::VisitCall(Call* expr) {
         return;
       }
       if (TryInlineApiFunctionCall(expr, receiver)) return;
+      if (TryCallBoundFunction(expr)) return;
 
       if (TryInlineCall(expr)) return;
 
@@ -9206,12 +9744,13 @@ void HOptimizedGraphBuilder::BuildInlinedCallArray(
     }
   }
 
-  // Build the array.
+  // Build the array. The dependency above deoptimizes the code if the
+  // allocation memento of an array leads to a transition of the site.
   JSArrayBuilder array_builder(this,
                                kind,
                                site_instruction,
                                constructor,
-                               DISABLE_ALLOCATION_SITES);
+                               ArrayAllocationSiteOverrideMode(kind));
   HValue* new_object = argument_count == 0
       ? array_builder.AllocateEmptyArray()
       : BuildAllocateArrayFromLength(&array_builder, Top());
@@ -9790,6 +10329,36 @@ void HOptimizedGraphBuilder::GenerateTypedArrayGetLength(
 }
 
 
+void HOptimizedGraphBuilder::GenerateTypedArrayGetBuffer(
+    CallRuntime* expr) {
+  DCHECK(expr->arguments()->length() == 1);
+  CHECK_ALIVE(VisitForValue(expr->arguments()->at(0)));
+  HValue* typed_array = Pop();
+  HValue* buffer = Add<HLoadNamedField>(
+      typed_array, static_cast<HValue*>(NULL),
+      HObjectAccess::ForJSArrayBufferViewBuffer());
+
+  // Typed arrays with on-heap elements store Smi zero until their buffer is
+  // requested for the first time. Materializing it in the runtime is
+  // idempotent, so it is safe to repeat after a deopt.
+  NoObservableSideEffectsScope scope(this);
+  IfBuilder if_materialized(this);
+  if_materialized.IfNot<HIsSmiAndBranch>(buffer);
+  if_materialized.Then();
+  {
+    Push(buffer);
+  }
+  if_materialized.Else();
+  {
+    Push(typed_array);
+    PushArgumentsFromEnvironment(1);
+    Push(Add<HCallRuntime>(expr->name(), expr->function(), 1));
+  }
+  if_materialized.End();
+  return ast_context()->ReturnValue(Pop());
+}
+
+
 void HOptimizedGraphBuilder::VisitCallRuntime(CallRuntime* expr) {
   DCHECK(!HasStackOverflow());
   DCHECK(current_block() != NULL);
@@ -11085,6 +11654,16 @@ void HOptimizedGraphBuilder::BuildEmitInObjectProperties(
     int index = descriptors->GetFieldIndex(i);
     int property_offset = boilerplate_object->GetInObjectPropertyOffset(index);
     Handle<Name> name(descriptors->GetKey(i));
+    FieldIndex field_index = FieldIndex::ForDescriptor(*boilerplate_map, i);
+    if (boilerplate_object->IsUnboxedDoubleField(field_index)) {
+      // The boilerplate holds the raw double, copy it over unboxed.
+      HObjectAccess access = HObjectAccess::ForMapAndOffset(
+          boilerplate_map, property_offset, Representation::Double());
+      HValue* double_value = Add<HConstant>(
+          boilerplate_object->RawFastDoublePropertyAt(field_index));
+      Add<HStoreNamedField>(object, access, double_value);
+      continue;
+    }
     Handle<Object> value =
         Handle<Object>(boilerplate_object->InObjectPropertyAt(index),
         isolate());
@@ -11271,7 +11850,7 @@ void HOptimizedGraphBuilder::VisitVariableDeclaration(
     case Variable::LOCAL:
       if (hole_init) {
         HValue* value = graph()->GetConstantHole();
-        environment()->Bind(variable, value);
+        Bind(variable, value);
       }
       break;
     case Variable::CONTEXT:
@@ -11806,6 +12385,8 @@ void HOptimizedGraphBuilder::GenerateCallFunction(CallRuntime* call) {
   CHECK_ALIVE(VisitExpressions(call->arguments()));
   // The function is the last argument
   HValue* function = Pop();
+  // Inline known callbacks, e.g. of an inlined Array.prototype.forEach.
+  if (TryInlineCallFunction(call, function, arg_count - 1)) return;
   // Push the arguments to the stack
   PushArgumentsFromEnvironment(arg_count);
 
@@ -11873,6 +12454,206 @@ void HOptimizedGraphBuilder::GenerateMathSqrtRT(CallRuntime* call) {
 }
 
 
+// Looks up Smi and internalized string keys in the table of a JSMap or JSSet
+// by identity, which works because OrderedHashSet::Add and
+// OrderedHashMap::Put store keys in that form. Other keys are looked up by
+// calling the runtime function {fallback}. Returns the value of the entry
+// or undefined if {load_value} is true, and whether the key was found
+// otherwise.
+template <class Table>
+HValue* HOptimizedGraphBuilder::BuildOrderedHashTableLookup(
+    HValue* receiver, HValue* key, bool load_value,
+    Runtime::FunctionId fallback) {
+  NoObservableSideEffectsScope no_effects(this);
+
+  // Compute the hash of the key, or -1 if it has to be looked up in the
+  // runtime. See Object::GetHash.
+  IfBuilder if_smi(this);
+  HValue* smi_check = if_smi.If<HIsSmiAndBranch>(key);
+  if_smi.Then();
+  {
+    HValue* smi_key =
+        AddUncasted<HForceRepresentation>(key, Representation::Smi());
+    Push(BuildIntegerHash(smi_key, 0));
+  }
+  if_smi.Else();
+  {
+    HValue* map = AddLoadMap(key, smi_check);
+    HValue* instance_type = Add<HLoadNamedField>(
+        map, static_cast<HValue*>(NULL), HObjectAccess::ForMapInstanceType());
+    HValue* not_internalized_string = AddUncasted<HBitwise>(
+        Token::BIT_AND, instance_type,
+        Add<HConstant>(static_cast<int>(kIsNotStringMask |
+                                        kIsNotInternalizedMask)));
+    IfBuilder if_internalized(this);
+    STATIC_ASSERT((kStringTag | kInternalizedTag) == 0);
+    if_internalized.If<HCompareNumericAndBranch>(
+        not_internalized_string, graph()->GetConstant0(), Token::EQ);
+    if_internalized.Then();
+    {
+      HValue* hash_field = Add<HLoadNamedField>(
+          key, smi_check, HObjectAccess::ForNameHashField());
+      Push(AddUncasted<HShr>(hash_field, Add<HConstant>(Name::kHashShift)));
+    }
+    if_internalized.Else();
+    {
+      Push(graph()->GetConstantMinus1());
+    }
+    if_internalized.End();
+  }
+  if_smi.End();
+  HValue* hash = Pop();
+
+  IfBuilder if_inline(this);
+  if_inline.If<HCompareNumericAndBranch>(hash, graph()->GetConstantMinus1(),
+                                         Token::NE);
+  if_inline.Then();
+  {
+    HValue* table = Add<HLoadNamedField>(receiver, static_cast<HValue*>(NULL),
+                                         HObjectAccess::ForJSCollectionTable());
+    HValue* num_buckets = Add<HLoadKeyed>(
+        table, Add<HConstant>(Table::kNumberOfBucketsIndex),
+        static_cast<HValue*>(NULL), FAST_SMI_ELEMENTS);
+    HValue* mask = AddUncasted<HSub>(num_buckets, graph()->GetConstant1());
+    mask->ChangeRepresentation(Representation::Integer32());
+    mask->ClearFlag(HValue::kCanOverflow);
+    HValue* bucket = AddUncasted<HBitwise>(Token::BIT_AND, hash, mask);
+    HValue* bucket_index =
+        AddUncasted<HAdd>(bucket, Add<HConstant>(Table::kHashTableStartIndex));
+    bucket_index->ClearFlag(HValue::kCanOverflow);
+    HValue* first_entry = Add<HLoadKeyed>(
+        table, bucket_index, static_cast<HValue*>(NULL), FAST_SMI_ELEMENTS);
+    HValue* entries_start = AddUncasted<HAdd>(
+        num_buckets, Add<HConstant>(Table::kHashTableStartIndex));
+    entries_start->ClearFlag(HValue::kCanOverflow);
+
+    // Walk the chain of the bucket until the key or the end of the chain
+    // (kNotFound) is found.
+    Push(first_entry);
+    HIfContinuation done_or_loop_continuation(graph()->CreateBasicBlock(),
+                                              graph()->CreateBasicBlock());
+    LoopBuilder chain_loop(this);
+    chain_loop.BeginBody(1);  // Drop the entry from the last environment.
+
+    HValue* entry = Pop();
+    IfBuilder if_end(this);
+    if_end.If<HCompareNumericAndBranch>(
+        entry, Add<HConstant>(Table::kNotFound), Token::EQ);
+    if_end.Then();
+    {
+      Push(entry);
+    }
+    if_end.Else();
+    {
+      HValue* entry_offset =
+          AddUncasted<HMul>(entry, Add<HConstant>(Table::kEntrySize));
+      entry_offset->ClearFlag(HValue::kCanOverflow);
+      HValue* key_index = AddUncasted<HAdd>(entries_start, entry_offset);
+      key_index->ClearFlag(HValue::kCanOverflow);
+      HValue* candidate = Add<HLoadKeyed>(
+          table, key_index, static_cast<HValue*>(NULL), FAST_ELEMENTS);
+      IfBuilder if_match(this);
+      if_match.If<HCompareObjectEqAndBranch>(candidate, key);
+      if_match.Then();
+      {
+        Push(entry);
+      }
+      if_match.Else();
+      if_match.JoinContinuation(&done_or_loop_continuation);
+    }
+    if_end.JoinContinuation(&done_or_loop_continuation);
+
+    IfBuilder done_or_loop(this, &done_or_loop_continuation);
+    done_or_loop.Then();
+    chain_loop.Break();
+
+    done_or_loop.Else();
+    HValue* entry_offset =
+        AddUncasted<HMul>(entry, Add<HConstant>(Table::kEntrySize));
+    entry_offset->ClearFlag(HValue::kCanOverflow);
+    HValue* chain_offset = AddUncasted<HAdd>(
+        entry_offset, Add<HConstant>(Table::kChainOffset));
+    chain_offset->ClearFlag(HValue::kCanOverflow);
+    HValue* chain_index = AddUncasted<HAdd>(entries_start, chain_offset);
+    chain_index->ClearFlag(HValue::kCanOverflow);
+    Push(Add<HLoadKeyed>(table, chain_index, static_cast<HValue*>(NULL),
+                         FAST_SMI_ELEMENTS));
+
+    chain_loop.EndBody();
+
+    done_or_loop.End();
+
+    entry = Pop();
+    IfBuilder if_found(this);
+    if_found.If<HCompareNumericAndBranch>(
+        entry, Add<HConstant>(Table::kNotFound), Token::NE);
+    if_found.Then();
+    if (load_value) {
+      HValue* entry_offset =
+          AddUncasted<HMul>(entry, Add<HConstant>(Table::kEntrySize));
+      entry_offset->ClearFlag(HValue::kCanOverflow);
+      HValue* value_offset = AddUncasted<HAdd>(
+          entry_offset, Add<HConstant>(OrderedHashMap::kValueOffset));
+      value_offset->ClearFlag(HValue::kCanOverflow);
+      HValue* value_index = AddUncasted<HAdd>(entries_start, value_offset);
+      value_index->ClearFlag(HValue::kCanOverflow);
+      Push(Add<HLoadKeyed>(table, value_index, static_cast<HValue*>(NULL),
+                           FAST_ELEMENTS));
+    } else {
+      Push(graph()->GetConstantTrue());
+    }
+    if_found.Else();
+    Push(load_value ? graph()->GetConstantUndefined()
+                    : graph()->GetConstantFalse());
+    if_found.End();
+  }
+  if_inline.Else();
+  {
+    Add<HPushArguments>(receiver, key);
+    Push(Add<HCallRuntime>(isolate()->factory()->empty_string(),
+                           Runtime::FunctionForId(fallback), 2));
+  }
+  if_inline.End();
+  return Pop();
+}
+
+
+void HOptimizedGraphBuilder::GenerateMapGet(CallRuntime* call) {
+  DCHECK(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* receiver = Pop();
+  HValue* result = BuildOrderedHashTableLookup<OrderedHashMap>(
+      receiver, key, true, Runtime::kMapGet);
+  return ast_context()->ReturnValue(result);
+}
+
+
+void HOptimizedGraphBuilder::GenerateMapHas(CallRuntime* call) {
+  DCHECK(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* receiver = Pop();
+  HValue* result = BuildOrderedHashTableLookup<OrderedHashMap>(
+      receiver, key, false, Runtime::kMapHas);
+  return ast_context()->ReturnValue(result);
+}
+
+
+void HOptimizedGraphBuilder::GenerateSetHas(CallRuntime* call) {
+  DCHECK(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* receiver = Pop();
+  HValue* result = BuildOrderedHashTableLookup<OrderedHashSet>(
+      receiver, key, false, Runtime::kSetHas);
+  return ast_context()->ReturnValue(result);
+}
+
+
 void HOptimizedGraphBuilder::GenerateGetCachedArrayIndex(CallRuntime* call) {
   DCHECK(call->arguments()->length() == 1);
   CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
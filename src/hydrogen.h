@@ -912,6 +912,11 @@ class FunctionState FINAL {
   HEnterInlined* entry() { return entry_; }
   void set_entry(HEnterInlined* entry) { entry_ = entry; }
 
+  // The innermost try block around the current statement. Inlined functions
+  // never contain try blocks.
+  HEnterTry* try_entry() { return try_entry_; }
+  void set_try_entry(HEnterTry* try_entry) { try_entry_ = try_entry; }
+
   HArgumentsObject* arguments_object() { return arguments_object_; }
   void set_arguments_object(HArgumentsObject* arguments_object) {
     arguments_object_ = arguments_object;
@@ -952,6 +957,8 @@ class FunctionState FINAL {
   // entry.
   HEnterInlined* entry_;
 
+  HEnterTry* try_entry_;
+
   HArgumentsObject* arguments_object_;
   HArgumentsElements* arguments_elements_;
 
@@ -1861,6 +1868,7 @@ class HGraphBuilder {
                                          ElementsKind kind);
 
   HValue* BuildElementIndexHash(HValue* index);
+  HValue* BuildIntegerHash(HValue* value, int32_t seed);
 
   void BuildCompareNil(
       HValue* value,
@@ -2082,7 +2090,10 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
    public:
     BreakAndContinueScope(BreakAndContinueInfo* info,
                           HOptimizedGraphBuilder* owner)
-        : info_(info), owner_(owner), next_(owner->break_scope()) {
+        : info_(info),
+          owner_(owner),
+          try_entry_(owner->function_state()->try_entry()),
+          next_(owner->break_scope()) {
       owner->set_break_scope(this);
     }
 
@@ -2092,14 +2103,16 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
     HOptimizedGraphBuilder* owner() { return owner_; }
     BreakAndContinueScope* next() { return next_; }
 
-    // Search the break stack for a break or continue target.
+    // Search the break stack for a break or continue target. The innermost try
+    // block around the target is returned in try_entry.
     enum BreakType { BREAK, CONTINUE };
     HBasicBlock* Get(BreakableStatement* stmt, BreakType type,
-                     Scope** scope, int* drop_extra);
+                     Scope** scope, int* drop_extra, HEnterTry** try_entry);
 
    private:
     BreakAndContinueInfo* info_;
     HOptimizedGraphBuilder* owner_;
+    HEnterTry* try_entry_;
     BreakAndContinueScope* next_;
   };
 
@@ -2117,14 +2130,50 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
 
   void Bailout(BailoutReason reason);
 
+  // Bails out because the value, which is an arguments object that is only
+  // kept on the stack, is used in a context where it escapes. If it is the
+  // arguments object of the function itself, optimization is retried later
+  // with an allocated arguments object instead.
+  void BailoutOnEscapingArguments(HValue* value, BailoutReason reason);
+
   HBasicBlock* CreateJoin(HBasicBlock* first,
                           HBasicBlock* second,
                           BailoutId join_id);
 
+  // A switch clause with a Smi literal label.
+  struct SmiSwitchCase {
+    int value;
+    int index;
+  };
+  static int CompareSmiSwitchCases(const SmiSwitchCase* a,
+                                   const SmiSwitchCase* b);
+
+  // Collects the clauses of a switch whose tag has only been seen as a Smi
+  // and whose labels are all distinct Smi literals, sorted by label value.
+  // Returns false if the switch does not qualify for binary search.
+  bool CollectSmiSwitchCases(SwitchStatement* stmt,
+                             ZoneList<SmiSwitchCase>* cases);
+
+  // Branches from the current block to the body blocks of cases[from, to) by
+  // binary search on the Smi tag, and to miss_block if no case matches.
+  void BuildSmiSwitchSearch(HValue* tag, ZoneList<SmiSwitchCase>* cases,
+                            int from, int to,
+                            ZoneList<HBasicBlock*>* body_blocks,
+                            HBasicBlock* miss_block);
+
   FunctionState* function_state() const { return function_state_; }
 
   void VisitDeclarations(ZoneList<Declaration*>* declarations);
 
+  // Keeps the catch slots of the try blocks around the current statement in
+  // sync with the environment value at index.
+  void UpdateCatchSlots(int index, HValue* value);
+
+  // Pops the handlers of the try blocks that are left when jumping to a
+  // statement whose innermost try block is target, and returns the number of
+  // handler placeholders that have to be dropped from the environment.
+  int LeaveTryBlocks(HEnterTry* target);
+
   void* operator new(size_t size, Zone* zone) {
     return zone->New(static_cast<int>(size));
   }
@@ -2229,12 +2278,20 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
 
   HValue* Top() const { return environment()->Top(); }
   void Drop(int n) { environment()->Drop(n); }
-  void Bind(Variable* var, HValue* value) { environment()->Bind(var, value); }
+  void Bind(Variable* var, HValue* value) {
+    environment()->Bind(var, value);
+    if (function_state()->try_entry() != NULL) {
+      UpdateCatchSlots(environment()->IndexFor(var), value);
+    }
+  }
   bool IsEligibleForEnvironmentLivenessAnalysis(Variable* var,
                                                 int index,
                                                 HValue* value,
                                                 HEnvironment* env) {
     if (!FLAG_analyze_environment_liveness) return false;
+    // The catch blocks are not part of the graph, the values they use must
+    // survive until they are entered by deoptimization.
+    if (top_info()->function()->handler_count() > 0) return false;
     // |this| and |arguments| are always live; zapping parameters isn't
     // safe because function.arguments can inspect them at any time.
     return !var->is_this() &&
@@ -2246,6 +2303,7 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
     HEnvironment* env = environment();
     int index = env->IndexFor(var);
     env->Bind(index, value);
+    if (function_state()->try_entry() != NULL) UpdateCatchSlots(index, value);
     if (IsEligibleForEnvironmentLivenessAnalysis(var, index, value, env)) {
       HEnvironmentMarker* bind =
           Add<HEnvironmentMarker>(HEnvironmentMarker::BIND, index);
@@ -2291,6 +2349,12 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
   void PushArgumentsFromEnvironment(int count);
 
   void SetUpScope(Scope* scope);
+
+  // Whether the arguments object of the function can be built from the
+  // actual arguments, which requires that it is not mapped to parameters.
+  bool CanMaterializeArguments();
+  HValue* BuildArgumentsObject();
+
   virtual void VisitStatements(ZoneList<Statement*>* statements) OVERRIDE;
 
 #define DECLARE_VISIT(type) virtual void Visit##type(type* node) OVERRIDE;
@@ -2338,6 +2402,7 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
                  HSourcePosition position);
 
   bool TryInlineCall(Call* expr);
+  bool TryCallBoundFunction(Call* expr);
   bool TryInlineConstruct(CallNew* expr, HValue* implicit_return_value);
   bool TryInlineGetter(Handle<JSFunction> getter,
                        Handle<Map> receiver_map,
@@ -2351,6 +2416,9 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
   bool TryInlineApply(Handle<JSFunction> function,
                       Call* expr,
                       int arguments_count);
+  bool TryInlineCallFunction(CallRuntime* call,
+                             HValue* function,
+                             int arguments_count);
   bool TryInlineBuiltinMethodCall(Call* expr,
                                   HValue* receiver,
                                   Handle<Map> receiver_map);
@@ -2377,6 +2445,11 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
                          int argc,
                          BailoutId ast_id,
                          ApiCallType call_type);
+  bool TryInlineFastApiCall(Handle<JSFunction> function,
+                            HValue* holder,
+                            SmallMapList* holder_maps,
+                            int argc,
+                            BailoutId ast_id);
 
   // If --trace-inlining, print a line of the inlining trace.  Inlining
   // succeeded if the reason string is NULL and failed if there is a
@@ -2400,6 +2473,11 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
                                          SmallMapList* types,
                                          Handle<String> name);
 
+  template <class Table>
+  HValue* BuildOrderedHashTableLookup(HValue* receiver, HValue* key,
+                                      bool load_value,
+                                      Runtime::FunctionId fallback);
+
   HValue* BuildAllocateExternalElements(
       ExternalArrayType array_type,
       bool is_zero_byte_offset,
@@ -127,6 +127,16 @@ function GetLanguageSingletonRE() {
   return LANGUAGE_SINGLETON_RE;
 }
 
+/**
+ * Caches ICU collator, number and date format objects, keyed by service,
+ * requested locale and the options passed to ICU, so that Intl objects with
+ * the same settings share them. The cache is dropped once it holds
+ * ICU_SERVICE_CACHE_LIMIT entries.
+ */
+var ICU_SERVICE_CACHE_LIMIT = 64;
+var icuServiceCache = {__proto__: null};
+var icuServiceCacheSize = 0;
+
 /**
  * Matches valid IANA time zone names.
  */
@@ -574,6 +584,54 @@ function setOptions(inOptions, extensionMap, keyValues, getOption, outOptions) {
 }
 
 
+/**
+ * Returns the ICU service cache key for the given service, requested locale
+ * and internal options. The values of internal options are all primitives.
+ */
+function icuServiceCacheKey(service, requestedLocale, internalOptions) {
+  var key = service + '|' + requestedLocale;
+  var names = ObjectGetOwnPropertyNames(internalOptions);
+  for (var i = 0; i < names.length; i++) {
+    key += '|' + names[i] + '=' + internalOptions[names[i]];
+  }
+  return key;
+}
+
+
+/**
+ * Returns the cached ICU service object for key and fills in the resolved
+ * values ICU reported when it was created, or undefined if there is none.
+ */
+function getCachedICUService(key, resolved) {
+  var entry = icuServiceCache[key];
+  if (entry === undefined) return undefined;
+  var names = ObjectGetOwnPropertyNames(entry.resolved);
+  for (var i = 0; i < names.length; i++) {
+    resolved[names[i]] = entry.resolved[names[i]];
+  }
+  return entry.service;
+}
+
+
+/**
+ * Caches the ICU service object for key, along with a copy of the resolved
+ * values ICU filled in.
+ */
+function setCachedICUService(key, service, resolved) {
+  if (icuServiceCacheSize >= ICU_SERVICE_CACHE_LIMIT) {
+    icuServiceCache = {__proto__: null};
+    icuServiceCacheSize = 0;
+  }
+  var copy = {__proto__: null};
+  var names = ObjectGetOwnPropertyNames(resolved);
+  for (var i = 0; i < names.length; i++) {
+    copy[names[i]] = resolved[names[i]];
+  }
+  icuServiceCache[key] = {__proto__: null, service: service, resolved: copy};
+  icuServiceCacheSize++;
+}
+
+
 /**
  * Converts all OwnProperties into
  * configurable: false, writable: false, enumerable: true.
@@ -924,9 +982,15 @@ function initializeCollator(collator, locales, options) {
     usage: {value: internalOptions.usage, writable: true}
   });
 
-  var internalCollator = %CreateCollator(requestedLocale,
-                                         internalOptions,
-                                         resolved);
+  var cacheKey = icuServiceCacheKey('collator', requestedLocale,
+                                    internalOptions);
+  var internalCollator = getCachedICUService(cacheKey, resolved);
+  if (internalCollator === undefined) {
+    internalCollator = %CreateCollator(requestedLocale,
+                                       internalOptions,
+                                       resolved);
+    setCachedICUService(cacheKey, internalCollator, resolved);
+  }
 
   // Writable, configurable and enumerable are set to false by default.
   %MarkAsInitializedIntlObjectOfType(collator, 'collator', internalCollator);
@@ -1145,9 +1209,15 @@ function initializeNumberFormat(numberFormat, locales, options) {
   if (internalOptions.hasOwnProperty('maximumSignificantDigits')) {
     defineWEProperty(resolved, 'maximumSignificantDigits', undefined);
   }
-  var formatter = %CreateNumberFormat(requestedLocale,
-                                      internalOptions,
-                                      resolved);
+  var cacheKey = icuServiceCacheKey('numberformat', requestedLocale,
+                                    internalOptions);
+  var formatter = getCachedICUService(cacheKey, resolved);
+  if (formatter === undefined) {
+    formatter = %CreateNumberFormat(requestedLocale,
+                                    internalOptions,
+                                    resolved);
+    setCachedICUService(cacheKey, formatter, resolved);
+  }
 
   // We can't get information about number or currency style from ICU, so we
   // assume user request was fulfilled.
@@ -1542,8 +1612,15 @@ function initializeDateTimeFormat(dateFormat, locales, options) {
     year: {writable: true}
   });
 
-  var formatter = %CreateDateTimeFormat(
-    requestedLocale, {skeleton: ldmlString, timeZone: tz}, resolved);
+  var formatterOptions = {skeleton: ldmlString, timeZone: tz};
+  var cacheKey = icuServiceCacheKey('dateformat', requestedLocale,
+                                    formatterOptions);
+  var formatter = getCachedICUService(cacheKey, resolved);
+  if (formatter === undefined) {
+    formatter = %CreateDateTimeFormat(
+      requestedLocale, formatterOptions, resolved);
+    setCachedICUService(cacheKey, formatter, resolved);
+  }
 
   if (tz !== undefined && tz !== resolved.timeZone) {
     throw new $RangeError('Unsupported time zone specified ' + tz);
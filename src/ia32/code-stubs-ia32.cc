@@ -1371,7 +1371,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(eax, NativeRegExpMacroAssembler::FAILURE);
   __ j(equal, &failure);
   __ cmp(eax, NativeRegExpMacroAssembler::EXCEPTION);
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or an exceeded backtrack limit.
+  // Handle that in the runtime system.
   __ j(not_equal, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
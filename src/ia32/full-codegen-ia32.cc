@@ -3815,6 +3815,9 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ mov(edi, result_register());
   ParameterCount count(arg_count);
   __ InvokeFunction(edi, count, CALL_FUNCTION, NullCallWrapper());
+  // The return site of an inlined target, see
+  // HOptimizedGraphBuilder::GenerateCallFunction.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
   __ mov(esi, Operand(ebp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
@@ -4673,6 +4676,13 @@ void FullCodeGenerator::EmitLiteralCompareTypeof(Expression* expr,
     __ JumpIfSmi(eax, if_false);
     __ CmpObjectType(eax, SYMBOL_TYPE, edx);
     Split(equal, if_true, if_false, fall_through);
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)   \
+  } else if (String::Equals(check, factory->type##_string())) { \
+    __ JumpIfSmi(eax, if_false);                                \
+    __ CmpObjectType(eax, TYPE##_TYPE, edx);                    \
+    Split(equal, if_true, if_false, fall_through);
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
   } else if (String::Equals(check, factory->boolean_string())) {
     __ cmp(eax, isolate()->factory()->true_value());
     __ j(equal, if_true);
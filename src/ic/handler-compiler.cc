@@ -102,6 +102,21 @@ Register NamedLoadHandlerCompiler::FrontendHeader(Register object_reg,
     function_index = Context::BOOLEAN_FUNCTION_INDEX;
   } else {
     check_type = SKIP_RECEIVER;
+    // SIMD values load their properties from the prototypes of their
+    // wrapper functions, like the other primitives.
+    if (type()->IsClass()) {
+      switch (type()->AsClass()->Map()->instance_type()) {
+#define SIMD128_FUNCTION_INDEX(TYPE, Type, type, lane_count, lane_type) \
+        case TYPE##_TYPE:                                               \
+          function_index = Context::TYPE##_FUNCTION_INDEX;              \
+          check_type = CHECK_ALL_MAPS;                                  \
+          break;
+        SIMD128_TYPES(SIMD128_FUNCTION_INDEX)
+#undef SIMD128_FUNCTION_INDEX
+        default:
+          break;
+      }
+    }
   }
 
   if (check_type == CHECK_ALL_MAPS) {
@@ -508,6 +508,35 @@ void IC::Clear(Isolate* isolate, Address address,
 }
 
 
+void IC::VisitSites(Isolate* isolate, ICSiteVisitor* visitor) {
+  Heap* heap = isolate->heap();
+  // Making the whole heap iterable would take a full GC, which resets all
+  // polymorphic and megamorphic ICs. Shared function infos are always
+  // allocated in old pointer space, so that is the only space we look at.
+  if (heap->mark_compact_collector()->sweeping_in_progress()) {
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+  }
+  DisallowHeapAllocation no_allocation;
+  HeapObjectIterator iterator(heap->old_pointer_space());
+  int mask = RelocInfo::ModeMask(RelocInfo::CODE_TARGET) |
+             RelocInfo::ModeMask(RelocInfo::CODE_TARGET_WITH_ID);
+  for (HeapObject* obj = iterator.Next(); obj != NULL; obj = iterator.Next()) {
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    Code* code = shared->code();
+    if (code->kind() != Code::FUNCTION) continue;
+    for (RelocIterator it(code, mask); !it.done(); it.next()) {
+      RelocInfo* info = it.rinfo();
+      Code* target = Code::GetCodeFromTargetAddress(info->target_address());
+      if (!target->is_inline_cache_stub()) continue;
+      State state = target->ic_state();
+      if (state == DEBUG_STUB || state == DEFAULT) continue;
+      visitor->VisitSite(shared, target, code->SourcePosition(info->pc()));
+    }
+  }
+}
+
+
 void KeyedLoadIC::Clear(Isolate* isolate, Address address, Code* target,
                         ConstantPoolArray* constant_pool) {
   if (IsCleared(target)) return;
@@ -1620,10 +1649,16 @@ Handle<Code> KeyedStoreIC::StoreElementStub(Handle<JSObject> receiver,
   }
 
   if (!map_added) {
-    // If the miss wasn't due to an unseen map, a polymorphic stub
-    // won't help, use the generic stub.
-    TRACE_GENERIC_IC(isolate(), "KeyedStoreIC", "same map added twice");
-    return generic_stub();
+    // A polymorphic IC built for standard stores can still switch to a
+    // version that grows, handles OOB accesses or copies COW arrays for all
+    // of its maps, like the MONOMORPHIC case above. Otherwise the miss
+    // wasn't due to an unseen map, a polymorphic stub won't help, use the
+    // generic stub.
+    if (old_store_mode != STANDARD_STORE ||
+        GetNonTransitioningStoreMode(store_mode) == STANDARD_STORE) {
+      TRACE_GENERIC_IC(isolate(), "KeyedStoreIC", "same map added twice");
+      return generic_stub();
+    }
   }
 
   // If the maximum number of receiver maps has been exceeded, use the generic
@@ -2011,6 +2046,7 @@ void CallIC::HandleMiss(Handle<Object> receiver, Handle<Object> function,
 // Used from ic-<arch>.cc.
 RUNTIME_FUNCTION(CallIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
   CallIC ic(isolate);
@@ -2025,6 +2061,7 @@ RUNTIME_FUNCTION(CallIC_Miss) {
 
 RUNTIME_FUNCTION(CallIC_Customization_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
   // A miss on a custom call ic always results in going megamorphic.
@@ -2040,6 +2077,7 @@ RUNTIME_FUNCTION(CallIC_Customization_Miss) {
 // Used from ic-<arch>.cc.
 RUNTIME_FUNCTION(LoadIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 2);
   LoadIC ic(IC::NO_EXTRA_FRAME, isolate);
@@ -2055,6 +2093,7 @@ RUNTIME_FUNCTION(LoadIC_Miss) {
 // Used from ic-<arch>.cc
 RUNTIME_FUNCTION(KeyedLoadIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 2);
   KeyedLoadIC ic(IC::NO_EXTRA_FRAME, isolate);
@@ -2069,6 +2108,7 @@ RUNTIME_FUNCTION(KeyedLoadIC_Miss) {
 
 RUNTIME_FUNCTION(KeyedLoadIC_MissFromStubFailure) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 2);
   KeyedLoadIC ic(IC::EXTRA_CALL_FRAME, isolate);
@@ -2084,6 +2124,7 @@ RUNTIME_FUNCTION(KeyedLoadIC_MissFromStubFailure) {
 // Used from ic-<arch>.cc.
 RUNTIME_FUNCTION(StoreIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
   StoreIC ic(IC::NO_EXTRA_FRAME, isolate);
@@ -2099,6 +2140,7 @@ RUNTIME_FUNCTION(StoreIC_Miss) {
 
 RUNTIME_FUNCTION(StoreIC_MissFromStubFailure) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 3 || args.length() == 4);
   StoreIC ic(IC::EXTRA_CALL_FRAME, isolate);
@@ -2115,6 +2157,7 @@ RUNTIME_FUNCTION(StoreIC_MissFromStubFailure) {
 // Used from ic-<arch>.cc.
 RUNTIME_FUNCTION(KeyedStoreIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
   KeyedStoreIC ic(IC::NO_EXTRA_FRAME, isolate);
@@ -2130,6 +2173,7 @@ RUNTIME_FUNCTION(KeyedStoreIC_Miss) {
 
 RUNTIME_FUNCTION(KeyedStoreIC_MissFromStubFailure) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
   KeyedStoreIC ic(IC::EXTRA_CALL_FRAME, isolate);
@@ -2177,6 +2221,7 @@ RUNTIME_FUNCTION(KeyedStoreIC_Slow) {
 
 RUNTIME_FUNCTION(ElementsTransitionAndStoreIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
   KeyedStoreIC ic(IC::EXTRA_CALL_FRAME, isolate);
@@ -2266,6 +2311,7 @@ MaybeHandle<Object> BinaryOpIC::Transition(
 
 RUNTIME_FUNCTION(BinaryOpIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK_EQ(2, args.length());
   Handle<Object> left = args.at<Object>(BinaryOpICStub::kLeft);
@@ -2281,6 +2327,7 @@ RUNTIME_FUNCTION(BinaryOpIC_Miss) {
 
 RUNTIME_FUNCTION(BinaryOpIC_MissWithAllocationSite) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK_EQ(3, args.length());
   Handle<AllocationSite> allocation_site =
@@ -2357,6 +2404,7 @@ Code* CompareIC::UpdateCaches(Handle<Object> x, Handle<Object> y) {
 // Used from CompareICStub::GenerateMiss in code-stubs-<arch>.cc.
 RUNTIME_FUNCTION(CompareIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
   CompareIC ic(isolate, static_cast<Token::Value>(args.smi_at(2)));
@@ -2419,6 +2467,7 @@ Handle<Object> CompareNilIC::CompareNil(Handle<Object> object) {
 
 RUNTIME_FUNCTION(CompareNilIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   HandleScope scope(isolate);
   Handle<Object> object = args.at<Object>(0);
   CompareNilIC ic(isolate);
@@ -2485,6 +2534,7 @@ Handle<Object> ToBooleanIC::ToBoolean(Handle<Object> object) {
 
 RUNTIME_FUNCTION(ToBooleanIC_Miss) {
   TimerEventScope<TimerEventIcMiss> timer(isolate);
+  NestableHistogramTimerScope histogram_timer(isolate->counters()->ic_miss());
   DCHECK(args.length() == 1);
   HandleScope scope(isolate);
   Handle<Object> object = args.at<Object>(0);
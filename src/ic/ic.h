@@ -34,6 +34,17 @@ namespace internal {
   ICU(CompareNilIC_Miss)               \
   ICU(Unreachable)                     \
   ICU(ToBooleanIC_Miss)
+// Interface for IC::VisitSites.
+class ICSiteVisitor {
+ public:
+  virtual ~ICSiteVisitor() {}
+  // Called for an IC call site at source {position} of the unoptimized code
+  // of {shared}, which currently calls {target}.
+  virtual void VisitSite(SharedFunctionInfo* shared, Code* target,
+                         int position) = 0;
+};
+
+
 //
 // IC is the base class for LoadIC, StoreIC, KeyedLoadIC, and KeyedStoreIC.
 //
@@ -86,6 +97,14 @@ class IC {
   static void Clear(Isolate* isolate, Address address,
                     ConstantPoolArray* constant_pool);
 
+  // Calls {visitor} for every IC call site of the unoptimized code of all
+  // functions in the heap whose state is kept in the patched call target.
+  // Sites that are being debugged or keep their state in a type feedback
+  // vector are skipped. Iterates old pointer space without a GC, so it may
+  // include functions that are already dead. Slow, but needs no bookkeeping
+  // while ICs run.
+  static void VisitSites(Isolate* isolate, ICSiteVisitor* visitor);
+
 #ifdef DEBUG
   bool IsLoadStub() const {
     return target()->is_load_stub() || target()->is_keyed_load_stub();
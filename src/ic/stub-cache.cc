@@ -55,13 +55,20 @@ Code* StubCache::Set(Name* name, Map* map, Code* code) {
 
   // If the primary entry has useful data in it, we retire it to the
   // secondary cache before overwriting it.
-  if (old_code != isolate_->builtins()->builtin(Builtins::kIllegal)) {
+  Code* empty = isolate_->builtins()->builtin(Builtins::kIllegal);
+  if (old_code != empty) {
     Map* old_map = primary->map;
     Code::Flags old_flags =
         Code::RemoveTypeAndHolderFromFlags(old_code->flags());
     int seed = PrimaryOffset(primary->key, old_flags, old_map);
     int secondary_offset = SecondaryOffset(primary->key, old_flags, seed);
     Entry* secondary = entry(secondary_, secondary_offset);
+    if (primary->key != name || primary->map != map) {
+      isolate()->counters()->megamorphic_stub_cache_collisions()->Increment();
+      if (secondary->value != empty) {
+        isolate()->counters()->megamorphic_stub_cache_evictions()->Increment();
+      }
+    }
     *secondary = *primary;
   }
 
@@ -7,6 +7,16 @@
 
 #include "src/macro-assembler.h"
 
+// The table sizes are baked into the probing code of every port and into
+// the snapshot, so they are selected at build time.
+#ifndef V8_STUB_CACHE_PRIMARY_TABLE_BITS
+#define V8_STUB_CACHE_PRIMARY_TABLE_BITS 11
+#endif
+
+#ifndef V8_STUB_CACHE_SECONDARY_TABLE_BITS
+#define V8_STUB_CACHE_SECONDARY_TABLE_BITS 9
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -150,10 +160,14 @@ class StubCache {
                                     offset * multiplier);
   }
 
-  static const int kPrimaryTableBits = 11;
+  static const int kPrimaryTableBits = V8_STUB_CACHE_PRIMARY_TABLE_BITS;
   static const int kPrimaryTableSize = (1 << kPrimaryTableBits);
-  static const int kSecondaryTableBits = 9;
+  static const int kSecondaryTableBits = V8_STUB_CACHE_SECONDARY_TABLE_BITS;
   static const int kSecondaryTableSize = (1 << kSecondaryTableBits);
+  // The scaled offsets have to fit into the 32-bit hash computations and
+  // immediates of the generated probes.
+  STATIC_ASSERT(kPrimaryTableBits >= 1 && kPrimaryTableBits <= 20);
+  STATIC_ASSERT(kSecondaryTableBits >= 1 && kSecondaryTableBits <= 20);
 
  private:
   Entry primary_[kPrimaryTableSize];
@@ -170,6 +170,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
   int* backtrack_stack_base = backtrack_stack.data();
   int* backtrack_sp = backtrack_stack_base;
   int backtrack_stack_space = backtrack_stack.max_size();
+  int backtracks_left = FLAG_regexp_backtrack_limit;
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     PrintF("\n\nStart bytecode interpreter\n\n");
@@ -236,6 +237,9 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         pc += BC_POP_CP_LENGTH;
         break;
       BYTECODE(POP_BT)
+        if (FLAG_regexp_backtrack_limit > 0 && --backtracks_left < 0) {
+          return RegExpImpl::RE_BACKTRACK_LIMIT_EXCEEDED;
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
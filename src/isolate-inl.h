@@ -26,7 +26,11 @@ SaveContext::SaveContext(Isolate* isolate)
 
 
 bool Isolate::DebuggerHasBreakPoints() {
-  return debug()->has_break_points();
+  // Targeted break points only keep their own functions from being
+  // optimized, see SharedFunctionInfo::HasDebugInfo().
+  return debug()->has_break_points() &&
+         (!FLAG_debug_targeted_break_points ||
+          debug()->prepared_for_break_points());
 }
 
 
@@ -0,0 +1,99 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/isolate-template.h"
+
+namespace v8 {
+namespace internal {
+
+class IsolateTemplate::PrepareIsolateTask : public v8::Task {
+ public:
+  explicit PrepareIsolateTask(IsolateTemplate* templ) : templ_(templ) {}
+
+  virtual void Run() OVERRIDE { templ_->PrepareIsolate(); }
+
+ private:
+  IsolateTemplate* templ_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrepareIsolateTask);
+};
+
+
+IsolateTemplate::IsolateTemplate(const v8::Isolate::CreateParams& params,
+                                 int pool_size)
+    : params_(params),
+      pool_size_(pool_size),
+      prepared_(pool_size),
+      pending_(0),
+      tearing_down_(false) {
+  DCHECK(pool_size >= 0);
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  Refill();
+}
+
+
+IsolateTemplate::~IsolateTemplate() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  tearing_down_ = true;
+  while (pending_ > 0) pending_done_.Wait(&mutex_);
+  for (int i = 0; i < prepared_.length(); i++) prepared_[i]->Dispose();
+  prepared_.Clear();
+}
+
+
+void IsolateTemplate::Refill() {
+  while (!tearing_down_ && prepared_.length() + pending_ < pool_size_) {
+    pending_++;
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new PrepareIsolateTask(this), v8::Platform::kShortRunningTask);
+  }
+}
+
+
+void IsolateTemplate::PrepareIsolate() {
+  bool tearing_down;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    tearing_down = tearing_down_;
+  }
+  // The lock is not held here, so that several isolates can be created in
+  // parallel and NewIsolate() does not wait for them.
+  v8::Isolate* isolate = tearing_down ? NULL : v8::Isolate::New(params_);
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (isolate != NULL) prepared_.Add(isolate);
+  pending_--;
+  // Notify with the lock held, the destructor may run as soon as it sees
+  // that no task is pending.
+  pending_done_.NotifyAll();
+}
+
+
+void IsolateTemplate::BindToCurrentThread(v8::Isolate* v8_isolate) {
+  Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+  ExecutionAccess access(isolate);
+  StackGuard* stack_guard = isolate->stack_guard();
+  stack_guard->ClearThread(access);
+  stack_guard->InitThread(access);
+  if (params_.constraints.stack_limit() != NULL) {
+    stack_guard->SetStackLimit(
+        reinterpret_cast<uintptr_t>(params_.constraints.stack_limit()));
+  }
+}
+
+
+v8::Isolate* IsolateTemplate::NewIsolate() {
+  v8::Isolate* isolate = NULL;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    if (!prepared_.is_empty()) isolate = prepared_.RemoveLast();
+    Refill();
+  }
+  if (isolate == NULL) return v8::Isolate::New(params_);
+  BindToCurrentThread(isolate);
+  return isolate;
+}
+
+} }  // namespace v8::internal
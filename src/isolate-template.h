@@ -0,0 +1,53 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_ISOLATE_TEMPLATE_H_
+#define V8_ISOLATE_TEMPLATE_H_
+
+#include "include/v8.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+// Internal implementation of v8::IsolateTemplate. Keeps a pool of isolates
+// that background tasks create with the template's parameters.
+class IsolateTemplate {
+ public:
+  IsolateTemplate(const v8::Isolate::CreateParams& params, int pool_size);
+  ~IsolateTemplate();
+
+  v8::Isolate* NewIsolate();
+
+ private:
+  class PrepareIsolateTask;
+
+  // Posts tasks until the prepared and pending isolates fill the pool. The
+  // mutex has to be held.
+  void Refill();
+
+  // Called by the tasks on a background thread.
+  void PrepareIsolate();
+
+  // Makes the stack limits of an isolate created on another thread valid
+  // for the calling thread.
+  void BindToCurrentThread(v8::Isolate* isolate);
+
+  v8::Isolate::CreateParams params_;
+  int pool_size_;
+
+  base::Mutex mutex_;
+  base::ConditionVariable pending_done_;
+  List<v8::Isolate*> prepared_;
+  int pending_;
+  bool tearing_down_;
+
+  DISALLOW_COPY_AND_ASSIGN(IsolateTemplate);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_ISOLATE_TEMPLATE_H_
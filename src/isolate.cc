@@ -331,22 +331,42 @@ static bool IsVisibleInStackTrace(JSFunction* fun,
 }
 
 
+// Gets the number of frames to capture for the given error object. The
+// constructor of the error can override Error.stackTraceLimit with a
+// stackTraceLimit property of its own, so that for example errors of a class
+// that is thrown and caught for control flow capture no frames at all.
+// Returns false if neither has a numeric limit.
+static bool GetStackTraceLimit(Isolate* isolate, Handle<JSObject> error_object,
+                               int* limit) {
+  Factory* factory = isolate->factory();
+  Handle<Object> error = JSObject::GetDataProperty(
+      isolate->js_builtins_object(), factory->builtins_error_string());
+  if (!error->IsJSObject()) return false;
+
+  Handle<Object> stack_trace_limit = factory->undefined_value();
+  Object* constructor = error_object->map()->constructor();
+  if (constructor != *error && constructor->IsJSFunction()) {
+    stack_trace_limit =
+        JSObject::GetDataProperty(handle(JSFunction::cast(constructor)),
+                                  factory->stack_trace_limit_string());
+  }
+  if (!stack_trace_limit->IsNumber()) {
+    stack_trace_limit = JSObject::GetDataProperty(
+        Handle<JSObject>::cast(error), factory->stack_trace_limit_string());
+  }
+  if (!stack_trace_limit->IsNumber()) return false;
+  // Ensure that limit is not negative.
+  *limit = Max(FastD2IChecked(stack_trace_limit->Number()), 0);
+  return true;
+}
+
+
 Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
                                                 Handle<Object> caller) {
-  // Get stack trace limit.
-  Handle<Object> error = Object::GetProperty(
-      this, js_builtins_object(), "$Error").ToHandleChecked();
-  if (!error->IsJSObject()) return factory()->undefined_value();
-
-  Handle<String> stackTraceLimit =
-      factory()->InternalizeUtf8String("stackTraceLimit");
-  DCHECK(!stackTraceLimit.is_null());
-  Handle<Object> stack_trace_limit =
-      JSObject::GetDataProperty(Handle<JSObject>::cast(error),
-                                stackTraceLimit);
-  if (!stack_trace_limit->IsNumber()) return factory()->undefined_value();
-  int limit = FastD2IChecked(stack_trace_limit->Number());
-  limit = Max(limit, 0);  // Ensure that limit is not negative.
+  int limit;
+  if (!GetStackTraceLimit(this, error_object, &limit)) {
+    return factory()->undefined_value();
+  }
 
   int initial_size = Min(limit, 10);
   Handle<FixedArray> elements =
@@ -360,13 +380,14 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
   int frames_seen = 0;
   int sloppy_frames = 0;
   bool encountered_strict_function = false;
+  // Set initial size to the maximum inlining level + 1 for the outermost
+  // function. The list is reused for all frames.
+  List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   for (JavaScriptFrameIterator iter(this);
        !iter.done() && frames_seen < limit;
        iter.Advance()) {
     JavaScriptFrame* frame = iter.frame();
-    // Set initial size to the maximum inlining level + 1 for the outermost
-    // function.
-    List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
+    frames.Rewind(0);
     frame->Summarize(&frames);
     for (int i = frames.length() - 1; i >= 0; i--) {
       Handle<JSFunction> fun = frames[i].function();
@@ -1493,6 +1514,8 @@ Isolate::Isolate()
       descriptor_lookup_cache_(NULL),
       handle_scope_implementer_(NULL),
       unicode_cache_(NULL),
+      zone_segment_pool_(static_cast<size_t>(FLAG_zone_segment_pool_size) *
+                         KB),
       runtime_zone_(this),
       inner_pointer_to_code_cache_(NULL),
       write_iterator_(NULL),
@@ -1938,11 +1961,14 @@ bool Isolate::Init(Deserializer* des) {
         Max(Min(base::SysInfo::NumberOfProcessors(), 4), 1);
   }
 
-  if (FLAG_trace_hydrogen || FLAG_trace_hydrogen_stubs) {
+  if (FLAG_trace_hydrogen || FLAG_trace_hydrogen_stubs || FLAG_trace_turbo ||
+      FLAG_turbo_profiling) {
     PrintF("Concurrent recompilation has been disabled for tracing.\n");
   } else if (OptimizingCompilerThread::Enabled(max_available_threads_)) {
     optimizing_compiler_thread_ = new OptimizingCompilerThread(this);
-    optimizing_compiler_thread_->Start();
+    if (!optimizing_compiler_thread_->job_based()) {
+      optimizing_compiler_thread_->Start();
+    }
   }
 
   // If we are deserializing, read the state into the now-empty heap.
@@ -1980,6 +2006,10 @@ bool Isolate::Init(Deserializer* des) {
 
   CHECK_EQ(static_cast<int>(OFFSET_OF(Isolate, embedder_data_)),
            Internals::kIsolateEmbedderDataOffset);
+  CHECK_EQ(static_cast<int>(OFFSET_OF(Isolate, handle_scope_data_.next)),
+           Internals::kIsolateHandleScopeNextOffset);
+  CHECK_EQ(static_cast<int>(OFFSET_OF(Isolate, handle_scope_data_.limit)),
+           Internals::kIsolateHandleScopeLimitOffset);
   CHECK_EQ(static_cast<int>(OFFSET_OF(Isolate, heap_.roots_)),
            Internals::kIsolateRootsOffset);
   CHECK_EQ(static_cast<int>(
@@ -2278,7 +2308,8 @@ void Isolate::ReportPromiseReject(Handle<JSObject> promise,
 
 
 void Isolate::EnqueueMicrotask(Handle<Object> microtask) {
-  DCHECK(microtask->IsJSFunction() || microtask->IsCallHandlerInfo());
+  DCHECK(microtask->IsJSFunction() || microtask->IsJSArray() ||
+         microtask->IsCallHandlerInfo());
   Handle<FixedArray> queue(heap()->microtask_queue(), this);
   int num_tasks = pending_microtask_count();
   DCHECK(num_tasks <= queue->length());
@@ -2315,33 +2346,52 @@ void Isolate::RunMicrotasks() {
     set_pending_microtask_count(0);
     heap()->set_microtask_queue(heap()->empty_fixed_array());
 
-    for (int i = 0; i < num_tasks; i++) {
+    int i = 0;
+    while (i < num_tasks) {
       HandleScope scope(this);
       Handle<Object> microtask(queue->get(i), this);
-      if (microtask->IsJSFunction()) {
-        Handle<JSFunction> microtask_function =
-            Handle<JSFunction>::cast(microtask);
-        SaveContext save(this);
-        set_context(microtask_function->context()->native_context());
-        MaybeHandle<Object> maybe_exception;
-        MaybeHandle<Object> result =
-            Execution::TryCall(microtask_function, factory()->undefined_value(),
-                               0, NULL, &maybe_exception);
-        // If execution is terminating, just bail out.
-        Handle<Object> exception;
-        if (result.is_null() && maybe_exception.is_null()) {
-          // Clear out any remaining callbacks in the queue.
-          heap()->set_microtask_queue(heap()->empty_fixed_array());
-          set_pending_microtask_count(0);
-          return;
-        }
-      } else {
+      if (microtask->IsCallHandlerInfo()) {
         Handle<CallHandlerInfo> callback_info =
             Handle<CallHandlerInfo>::cast(microtask);
         v8::MicrotaskCallback callback =
             v8::ToCData<v8::MicrotaskCallback>(callback_info->callback());
         void* data = v8::ToCData<void*>(callback_info->data());
         callback(data);
+        i++;
+        continue;
+      }
+
+      // Microtask functions and promise reaction jobs that follow each other
+      // and belong to the same native context are run by a single call to
+      // RunMicrotaskBatch, which saves entering JavaScript for every one.
+      Handle<Context> native_context(
+          JSObject::cast(*microtask)->GetCreationContext(), this);
+      int end = i + 1;
+      while (end < num_tasks && !queue->get(end)->IsCallHandlerInfo() &&
+             JSObject::cast(queue->get(end))->GetCreationContext() ==
+                 *native_context) {
+        end++;
+      }
+      Handle<FixedArray> batch = factory()->NewFixedArray(end - i);
+      for (int j = 0; j < batch->length(); j++) {
+        batch->set(j, queue->get(i + j));
+      }
+      i = end;
+
+      SaveContext save(this);
+      set_context(*native_context);
+      Handle<JSFunction> runner(native_context->run_microtask_batch(), this);
+      Handle<Object> argv[] = { factory()->NewJSArrayWithElements(batch) };
+      MaybeHandle<Object> maybe_exception;
+      MaybeHandle<Object> result =
+          Execution::TryCall(runner, factory()->undefined_value(),
+                             arraysize(argv), argv, &maybe_exception);
+      // If execution is terminating, just bail out.
+      if (result.is_null() && maybe_exception.is_null()) {
+        // Clear out any remaining callbacks in the queue.
+        heap()->set_microtask_queue(heap()->empty_fixed_array());
+        set_pending_microtask_count(0);
+        return;
       }
     }
   }
@@ -386,6 +386,7 @@ typedef List<HeapObject*> DebugObjectCache;
   V(InterruptCallback, api_interrupt_callback, NULL)                           \
   V(void*, api_interrupt_callback_data, NULL)                                  \
   V(PromiseRejectCallback, promise_reject_callback, NULL)                      \
+  V(DeoptimizationCallback, deoptimization_callback, NULL)                     \
   ISOLATE_INIT_SIMULATOR_LIST(V)
 
 #define THREAD_LOCAL_TOP_ACCESSOR(type, name)                        \
@@ -904,6 +905,7 @@ class Isolate {
     return handle_scope_implementer_;
   }
   Zone* runtime_zone() { return &runtime_zone_; }
+  ZoneSegmentPool* zone_segment_pool() { return &zone_segment_pool_; }
 
   UnicodeCache* unicode_cache() {
     return unicode_cache_;
@@ -1125,6 +1127,7 @@ class Isolate {
   // with v8::internal::Internals (in include/v8.h) constants. This is also
   // verified in Isolate::Init() using runtime checks.
   void* embedder_data_[Internals::kNumIsolateDataSlots];
+  HandleScopeData handle_scope_data_;
   Heap heap_;
   State state_;  // Will be padded to kApiPointerSize.
 
@@ -1247,9 +1250,10 @@ class Isolate {
   KeyedLookupCache* keyed_lookup_cache_;
   ContextSlotCache* context_slot_cache_;
   DescriptorLookupCache* descriptor_lookup_cache_;
-  HandleScopeData handle_scope_data_;
   HandleScopeImplementer* handle_scope_implementer_;
   UnicodeCache* unicode_cache_;
+  // Declared before any zone so that it outlives them.
+  ZoneSegmentPool zone_segment_pool_;
   Zone runtime_zone_;
   InnerPointerToCodeCache* inner_pointer_to_code_cache_;
   ConsStringIteratorOp* write_iterator_;
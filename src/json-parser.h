@@ -16,6 +16,43 @@
 namespace v8 {
 namespace internal {
 
+inline bool IsJsonStringSpecialChar(uint8_t c) {
+  return c == '"' || c == '\\' || c < 0x20;
+}
+
+
+// Returns the first position in [start, end) of {chars} that holds a '"', a
+// backslash or a control character, or {end} if there is none. The bulk of
+// the string is checked a word at a time: a byte is flagged when it is zero
+// after xor-ing with '"' or '\\', or when it is below 0x20. The word tests
+// can have false positives only after a true hit in the same word, which the
+// byte-wise tail then finds.
+inline int FindJsonStringSpecialChar(const uint8_t* chars, int start,
+                                     int end) {
+  static const uintptr_t kOnes = ~static_cast<uintptr_t>(0) / 0xFF;
+  static const uintptr_t kHighBits = kOnes * 0x80;
+  static const int kWordSize = static_cast<int>(sizeof(uintptr_t));
+  int pos = start;
+  while (pos < end && !IsAligned(reinterpret_cast<intptr_t>(chars + pos),
+                                 sizeof(uintptr_t))) {
+    if (IsJsonStringSpecialChar(chars[pos])) return pos;
+    pos++;
+  }
+  while (pos + kWordSize <= end) {
+    uintptr_t word = *reinterpret_cast<const uintptr_t*>(chars + pos);
+    uintptr_t quote = word ^ (kOnes * '"');
+    uintptr_t backslash = word ^ (kOnes * '\\');
+    uintptr_t special = ((quote - kOnes) & ~quote) |
+                        ((backslash - kOnes) & ~backslash) |
+                        ((word - kOnes * 0x20) & ~word);
+    if ((special & kHighBits) != 0) break;
+    pos += kWordSize;
+  }
+  while (pos < end && !IsJsonStringSpecialChar(chars[pos])) pos++;
+  return pos;
+}
+
+
 // A simple json parser.
 template <bool seq_one_byte>
 class JsonParser BASE_EMBEDDED {
@@ -35,6 +72,8 @@ class JsonParser BASE_EMBEDDED {
         zone_(isolate_),
         object_constructor_(isolate_->native_context()->object_function(),
                             isolate_),
+        object_shapes_(factory_->NewFixedArray(kMaxObjectShapeDepth)),
+        object_depth_(0),
         position_(-1) {
     source_ = String::Flatten(source_);
     pretenure_ = (source_length_ >= kPretenureTreshold) ? TENURED : NOT_TENURED;
@@ -157,6 +196,11 @@ class JsonParser BASE_EMBEDDED {
   // JavaScript array.
   Handle<Object> ParseJsonObject();
 
+  // Returns the key of the next property if the object being parsed at the
+  // current nesting depth, whose map is {map}, has the same shape as the last
+  // object completed at that depth, or a null handle if there is no such key.
+  Handle<String> ExpectedShapeKey(Handle<Map> map);
+
   // Parses a JSON array literal (grammar production JSONArray). An array
   // literal is a square-bracketed and comma separated sequence (possibly empty)
   // of JSON values.
@@ -177,6 +221,10 @@ class JsonParser BASE_EMBEDDED {
 
   static const int kInitialSpecialStringLength = 1024;
   static const int kPretenureTreshold = 100 * 1024;
+  // Integers with at most this many digits have an exact double value.
+  static const int kMaxExactIntegerDigits = 15;
+  // Objects nested deeper than this do not remember their shapes.
+  static const int kMaxObjectShapeDepth = 16;
 
 
  private:
@@ -191,6 +239,12 @@ class JsonParser BASE_EMBEDDED {
   Factory* factory_;
   Zone zone_;
   Handle<JSFunction> object_constructor_;
+  // The map of the last object completed at each nesting depth. Arrays of
+  // records usually repeat the same keys in the same order, so these maps
+  // predict the keys of the next object even where its map has more than one
+  // transition.
+  Handle<FixedArray> object_shapes_;
+  int object_depth_;
   uc32 c0_;
   int position_;
 };
@@ -303,6 +357,9 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
   Handle<Map> map(json_object->map());
   ZoneList<Handle<Object> > properties(8, zone());
   DCHECK_EQ(c0_, '{');
+  // The depth is not restored when parsing fails, the whole parse is aborted
+  // in that case.
+  int depth = object_depth_++;
 
   bool transitioning = true;
 
@@ -366,7 +423,18 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
         // If the expected transition hits, follow it.
         if (follow_expected) {
           target = Map::ExpectedTransitionTarget(map);
-        } else {
+        } else if (seq_one_byte && depth < kMaxObjectShapeDepth) {
+          // Otherwise try the key of the last object at this depth.
+          Handle<String> expected = ExpectedShapeKey(map);
+          if (!expected.is_null() && (key.is_null() || *expected != *key) &&
+              ParseJsonString(expected)) {
+            key = expected;
+            target = Map::FindTransitionToField(map, key);
+            transitioning = !target.is_null();
+            follow_expected = true;
+          }
+        }
+        if (!follow_expected) {
           // If the expected transition failed, parse an internalized string and
           // try to find a matching transition.
           key = ParseJsonInternalizedString();
@@ -442,11 +510,29 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
         json_object->FastPropertyAtPut(index, *value);
       }
     }
+    if (depth < kMaxObjectShapeDepth && json_object->HasFastProperties()) {
+      object_shapes_->set(depth, json_object->map());
+    }
   }
+  object_depth_--;
   AdvanceSkipWhitespace();
   return scope.CloseAndEscape(json_object);
 }
 
+
+template <bool seq_one_byte>
+Handle<String> JsonParser<seq_one_byte>::ExpectedShapeKey(Handle<Map> map) {
+  Object* shape = object_shapes_->get(object_depth_ - 1);
+  if (!shape->IsMap()) return Handle<String>::null();
+  int descriptor = map->NumberOfOwnDescriptors();
+  if (Map::cast(shape)->NumberOfOwnDescriptors() <= descriptor) {
+    return Handle<String>::null();
+  }
+  Name* name = Map::cast(shape)->instance_descriptors()->GetKey(descriptor);
+  if (!name->IsString()) return Handle<String>::null();
+  return handle(String::cast(name), isolate());
+}
+
 // Parse a JSON array. Position must be right at '['.
 template <bool seq_one_byte>
 Handle<Object> JsonParser<seq_one_byte>::ParseJsonArray() {
@@ -491,18 +577,32 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonNumber() {
     // Prefix zero is only allowed if it's the only digit before
     // a decimal point or exponent.
     if ('0' <= c0_ && c0_ <= '9') return ReportUnexpectedCharacter();
+    if (c0_ != '.' && c0_ != 'e' && c0_ != 'E') {
+      SkipWhitespace();
+      if (negative) return factory()->NewNumber(-0.0, pretenure_);
+      return Handle<Smi>(Smi::FromInt(0), isolate());
+    }
   } else {
-    int i = 0;
+    int64_t i = 0;
     int digits = 0;
     if (c0_ < '1' || c0_ > '9') return ReportUnexpectedCharacter();
     do {
-      i = i * 10 + c0_ - '0';
+      if (digits < kMaxExactIntegerDigits) i = i * 10 + c0_ - '0';
       digits++;
       Advance();
     } while (c0_ >= '0' && c0_ <= '9');
-    if (c0_ != '.' && c0_ != 'e' && c0_ != 'E' && digits < 10) {
+    if (c0_ != '.' && c0_ != 'e' && c0_ != 'E' &&
+        digits <= kMaxExactIntegerDigits) {
       SkipWhitespace();
-      return Handle<Smi>(Smi::FromInt((negative ? -i : i)), isolate());
+      if (digits < 10) {
+        int value = static_cast<int>(i);
+        return Handle<Smi>(Smi::FromInt(negative ? -value : value),
+                           isolate());
+      }
+      // Integers of this size are exactly representable as doubles, no
+      // need to go through StringToDouble.
+      double value = static_cast<double>(i);
+      return factory()->NewNumber(negative ? -value : value, pretenure_);
     }
   }
   if (c0_ == '.') {
@@ -719,11 +819,14 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
       c0 = seq_source_->SeqOneByteStringGet(position);
     } while (c0 != '"');
     int length = position - position_;
-    uint32_t hash = (length <= String::kMaxHashCalcLength)
-                        ? StringHasher::GetHashCore(running_hash)
-                        : static_cast<uint32_t>(length);
     Vector<const uint8_t> string_vector(
         seq_source_->GetChars() + position_, length);
+    uint32_t hash = (length <= String::kMaxHashCalcLength)
+                        ? StringHasher::GetHashCore(running_hash)
+                        : StringHasher::HashSequentialString(
+                              string_vector.start(), length,
+                              isolate()->heap()->HashSeed()) >>
+                              String::kHashShift;
     StringTable* string_table = isolate()->heap()->string_table();
     uint32_t capacity = string_table->Capacity();
     uint32_t entry = StringTable::FirstProbe(hash, capacity);
@@ -757,24 +860,41 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
   }
 
   int beg_pos = position_;
-  // Fast case for Latin1 only without escape characters.
-  do {
-    // Check for control character (0x00-0x1f) or unterminated string (<0).
+  if (seq_one_byte) {
+    // Fast case for sequential one-byte sources: skip to the closing quote,
+    // the first escape or an invalid character in one go.
+    position_ = FindJsonStringSpecialChar(seq_source_->GetChars(), position_,
+                                          source_length_);
+    if (position_ >= source_length_) {
+      c0_ = kEndOfString;
+      return Handle<String>::null();
+    }
+    c0_ = seq_source_->SeqOneByteStringGet(position_);
+    if (c0_ == '\\') {
+      return SlowScanJsonString<SeqOneByteString, uint8_t>(source_, beg_pos,
+                                                           position_);
+    }
     if (c0_ < 0x20) return Handle<String>::null();
-    if (c0_ != '\\') {
-      if (seq_one_byte || c0_ <= String::kMaxOneByteCharCode) {
-        Advance();
+  } else {
+    // Fast case for Latin1 only without escape characters.
+    do {
+      // Check for control character (0x00-0x1f) or unterminated string (<0).
+      if (c0_ < 0x20) return Handle<String>::null();
+      if (c0_ != '\\') {
+        if (c0_ <= String::kMaxOneByteCharCode) {
+          Advance();
+        } else {
+          return SlowScanJsonString<SeqTwoByteString, uc16>(source_,
+                                                            beg_pos,
+                                                            position_);
+        }
       } else {
-        return SlowScanJsonString<SeqTwoByteString, uc16>(source_,
-                                                          beg_pos,
-                                                          position_);
+        return SlowScanJsonString<SeqOneByteString, uint8_t>(source_,
+                                                             beg_pos,
+                                                             position_);
       }
-    } else {
-      return SlowScanJsonString<SeqOneByteString, uint8_t>(source_,
-                                                           beg_pos,
-                                                           position_);
-    }
-  } while (c0_ != '"');
+    } while (c0_ != '"');
+  }
   int length = position_ - beg_pos;
   Handle<String> result =
       factory()->NewRawOneByteString(length, pretenure_).ToHandleChecked();
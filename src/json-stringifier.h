@@ -7,6 +7,7 @@
 
 #include "src/v8.h"
 
+#include "include/v8-profiler.h"
 #include "src/conversions.h"
 #include "src/utils.h"
 
@@ -19,6 +20,14 @@ class BasicJsonStringifier BASE_EMBEDDED {
 
   MUST_USE_RESULT MaybeHandle<Object> Stringify(Handle<Object> object);
 
+  // Serializes {object} and writes the result to {stream} in UTF-8 encoded
+  // chunks whenever a string part has been filled, instead of accumulating
+  // the parts. Returns an empty handle if an exception has been thrown, the
+  // false value if {object} has no JSON representation or the stream aborted
+  // writing, and the true value otherwise.
+  MUST_USE_RESULT MaybeHandle<Object> StringifyToStream(
+      Handle<Object> object, v8::OutputStream* stream);
+
   MUST_USE_RESULT INLINE(static MaybeHandle<Object> StringifyString(
       Isolate* isolate,
       Handle<String> object));
@@ -27,11 +36,17 @@ class BasicJsonStringifier BASE_EMBEDDED {
   static const int kInitialPartLength = 32;
   static const int kMaxPartLength = 16 * 1024;
   static const int kPartLengthGrowthFactor = 2;
+  static const int kKeyPrefixCacheSize = 4;
 
   enum Result { UNCHANGED, SUCCESS, EXCEPTION };
 
   void Accumulate();
 
+  // Encodes {string} into the chunk buffer and writes every full chunk to
+  // the output stream.
+  void WriteToStream(Handle<String> string);
+  void WriteChunk();
+
   void Extend();
 
   void ChangeEncoding();
@@ -108,6 +123,22 @@ class BasicJsonStringifier BASE_EMBEDDED {
     Append(':');
   }
 
+  // Returns the escaped '"key":' prefixes of the own descriptors of {map},
+  // computing them on the first request for the map. An entry is undefined
+  // if the key is not serialized as a one-byte string. Returns a null handle
+  // for deprecated maps.
+  Handle<FixedArray> GetKeyPrefixes(Handle<Map> map);
+
+  // Copies a cached key prefix into the current part.
+  void AppendKeyPrefix(bool deferred_comma, Handle<String> prefix);
+
+  // Serializes Smi and number fields without materializing the property.
+  // Returns false if the field holds any other value.
+  bool SerializeNumberField(Handle<JSObject> object,
+                            FieldIndex field_index,
+                            bool deferred_comma,
+                            Handle<String> prefix);
+
   Result SerializeSmi(Smi* object);
 
   Result SerializeDouble(double number);
@@ -157,10 +188,20 @@ class BasicJsonStringifier BASE_EMBEDDED {
   Handle<String> current_part_;
   Handle<String> tojson_string_;
   Handle<JSArray> stack_;
+  // Pairs of maps and their key prefixes, replaced in a round robin fashion.
+  Handle<FixedArray> key_prefix_cache_;
+  int key_prefix_cache_next_;
   int current_index_;
   int part_length_;
   bool is_one_byte_;
   bool overflowed_;
+  // Streaming output state, only used by StringifyToStream.
+  v8::OutputStream* stream_;
+  Vector<char> chunk_;
+  int chunk_size_;
+  int chunk_index_;
+  int previous_char_;
+  bool aborted_;
 
   static const int kJsonEscapeTableEntrySize = 8;
   static const char* const JsonEscapeTable;
@@ -238,9 +279,15 @@ const char* const BasicJsonStringifier::JsonEscapeTable =
 
 BasicJsonStringifier::BasicJsonStringifier(Isolate* isolate)
     : isolate_(isolate),
+      key_prefix_cache_next_(0),
       current_index_(0),
       is_one_byte_(true),
-      overflowed_(false) {
+      overflowed_(false),
+      stream_(NULL),
+      chunk_size_(0),
+      chunk_index_(0),
+      previous_char_(unibrow::Utf16::kNoPreviousCharacter),
+      aborted_(false) {
   factory_ = isolate_->factory();
   accumulator_store_ = Handle<JSValue>::cast(
       Object::ToObject(isolate, factory_->empty_string()).ToHandleChecked());
@@ -248,6 +295,7 @@ BasicJsonStringifier::BasicJsonStringifier(Isolate* isolate)
   current_part_ = factory_->NewRawOneByteString(part_length_).ToHandleChecked();
   tojson_string_ = factory_->toJSON_string();
   stack_ = factory_->NewJSArray(8);
+  key_prefix_cache_ = factory_->NewFixedArray(2 * kKeyPrefixCacheSize);
 }
 
 
@@ -267,6 +315,61 @@ MaybeHandle<Object> BasicJsonStringifier::Stringify(Handle<Object> object) {
 }
 
 
+MaybeHandle<Object> BasicJsonStringifier::StringifyToStream(
+    Handle<Object> object, v8::OutputStream* stream) {
+  stream_ = stream;
+  chunk_size_ = Max(stream->GetChunkSize(), 1);
+  // The encoding of a lead surrogate is kept in the buffer beyond the chunk
+  // size until the trail surrogate has been combined with it in place.
+  ScopedVector<char> chunk(chunk_size_ + 2 * unibrow::Utf8::kMaxEncodedSize);
+  chunk_ = chunk;
+  Result result = SerializeObject(object);
+  if (result == EXCEPTION) return MaybeHandle<Object>();
+  if (result == UNCHANGED) return factory_->false_value();
+  ShrinkCurrentPart();
+  Accumulate();
+  if (chunk_index_ > 0) WriteChunk();
+  if (aborted_) return factory_->false_value();
+  stream->EndOfStream();
+  return factory_->true_value();
+}
+
+
+void BasicJsonStringifier::WriteToStream(Handle<String> string) {
+  string = String::Flatten(string);
+  DisallowHeapAllocation no_gc;
+  String::FlatContent flat = string->GetFlatContent();
+  int length = string->length();
+  for (int i = 0; i < length && !aborted_; i++) {
+    uc16 c = flat.Get(i);
+    chunk_index_ += unibrow::Utf8::Encode(chunk_.start() + chunk_index_, c,
+                                          previous_char_);
+    previous_char_ = c;
+    if (chunk_index_ >= chunk_size_ &&
+        (!unibrow::Utf16::IsLeadSurrogate(c) ||
+         chunk_index_ >=
+             chunk_size_ + static_cast<int>(unibrow::Utf8::kMaxEncodedSize))) {
+      WriteChunk();
+    }
+  }
+}
+
+
+void BasicJsonStringifier::WriteChunk() {
+  // Characters written out can no longer be combined with a trail surrogate.
+  previous_char_ = unibrow::Utf16::kNoPreviousCharacter;
+  int size = Min(chunk_index_, chunk_size_);
+  if (stream_->WriteAsciiChunk(chunk_.start(), size) ==
+      v8::OutputStream::kAbort) {
+    aborted_ = true;
+    chunk_index_ = 0;
+    return;
+  }
+  chunk_index_ -= size;
+  MemMove(chunk_.start(), chunk_.start() + size, chunk_index_);
+}
+
+
 MaybeHandle<Object> BasicJsonStringifier::StringifyString(
     Isolate* isolate,  Handle<String> object) {
   static const int kJsonQuoteWorstCaseBlowup = 6;
@@ -482,6 +585,10 @@ BasicJsonStringifier::Result BasicJsonStringifier::SerializeGeneric(
   ShrinkCurrentPart();  // Shrink.
   part_length_ = kInitialPartLength;  // Allocate conservatively.
   Extend();             // Attach current part and allocate new part.
+  if (stream_ != NULL) {
+    if (!aborted_) WriteToStream(result_string);
+    return SUCCESS;
+  }
   // Attach result string to the accumulator.
   Handle<String> cons;
   ASSIGN_RETURN_ON_EXCEPTION_VALUE(
@@ -643,6 +750,7 @@ BasicJsonStringifier::Result BasicJsonStringifier::SerializeJSObject(
       !object->HasNamedInterceptor() &&
       object->elements()->length() == 0) {
     Handle<Map> map(object->map());
+    Handle<FixedArray> key_prefixes = GetKeyPrefixes(map);
     for (int i = 0; i < map->NumberOfOwnDescriptors(); i++) {
       Handle<Name> name(map->instance_descriptors()->GetKey(i), isolate_);
       // TODO(rossberg): Should this throw?
@@ -652,8 +760,21 @@ BasicJsonStringifier::Result BasicJsonStringifier::SerializeJSObject(
       if (details.IsDontEnum()) continue;
       Handle<Object> property;
       if (details.type() == FIELD && *map == object->map()) {
-        property = Handle<Object>(object->RawFastPropertyAt(
-            FieldIndex::ForDescriptor(*map, i)), isolate_);
+        FieldIndex field_index = FieldIndex::ForDescriptor(*map, i);
+        if (!key_prefixes.is_null() && key_prefixes->get(i)->IsString()) {
+          Handle<String> prefix(String::cast(key_prefixes->get(i)), isolate_);
+          if (SerializeNumberField(object, field_index, comma, prefix)) {
+            comma = true;
+            continue;
+          }
+        }
+        if (field_index.is_unboxed_double()) {
+          property = factory_->NewHeapNumber(
+              object->RawFastDoublePropertyAt(field_index));
+        } else {
+          property = Handle<Object>(object->RawFastPropertyAt(field_index),
+                                    isolate_);
+        }
       } else {
         ASSIGN_RETURN_ON_EXCEPTION_VALUE(
             isolate_, property,
@@ -707,6 +828,99 @@ BasicJsonStringifier::Result BasicJsonStringifier::SerializeJSObject(
 }
 
 
+Handle<FixedArray> BasicJsonStringifier::GetKeyPrefixes(Handle<Map> map) {
+  if (map->is_deprecated()) return Handle<FixedArray>::null();
+  for (int i = 0; i < kKeyPrefixCacheSize; i++) {
+    if (key_prefix_cache_->get(2 * i) == *map) {
+      return handle(FixedArray::cast(key_prefix_cache_->get(2 * i + 1)));
+    }
+  }
+
+  static const int kJsonQuoteWorstCaseBlowup = 6;
+  int count = map->NumberOfOwnDescriptors();
+  Handle<FixedArray> prefixes = factory_->NewFixedArray(count);
+  Handle<DescriptorArray> descriptors(map->instance_descriptors(), isolate_);
+  for (int i = 0; i < count; i++) {
+    if (descriptors->GetDetails(i).IsDontEnum()) continue;
+    if (!descriptors->GetKey(i)->IsString()) continue;
+    Handle<String> key(String::cast(descriptors->GetKey(i)), isolate_);
+    key = String::Flatten(key);
+    if (!key->IsOneByteRepresentationUnderneath()) continue;
+    Handle<SeqOneByteString> prefix = factory_->NewRawOneByteString(
+        key->length() * kJsonQuoteWorstCaseBlowup + 3).ToHandleChecked();
+    int length = 0;
+    {
+      DisallowHeapAllocation no_gc;
+      Vector<const uint8_t> chars = key->GetFlatContent().ToOneByteVector();
+      uint8_t* dest = prefix->GetChars();
+      dest[length++] = '"';
+      length += SerializeStringUnchecked_(chars.start(), dest + length,
+                                          chars.length());
+      dest[length++] = '"';
+      dest[length++] = ':';
+    }
+    prefixes->set(i, *SeqString::Truncate(prefix, length));
+  }
+
+  int entry = key_prefix_cache_next_;
+  key_prefix_cache_next_ = (entry + 1) % kKeyPrefixCacheSize;
+  key_prefix_cache_->set(2 * entry, *map);
+  key_prefix_cache_->set(2 * entry + 1, *prefixes);
+  return prefixes;
+}
+
+
+void BasicJsonStringifier::AppendKeyPrefix(bool deferred_comma,
+                                           Handle<String> prefix) {
+  if (deferred_comma) Append(',');
+  int length = prefix->length();
+  if (part_length_ - current_index_ > length) {
+    DisallowHeapAllocation no_gc;
+    const uint8_t* chars = SeqOneByteString::cast(*prefix)->GetChars();
+    if (is_one_byte_) {
+      CopyChars(
+          SeqOneByteString::cast(*current_part_)->GetChars() + current_index_,
+          chars, length);
+    } else {
+      CopyChars(
+          SeqTwoByteString::cast(*current_part_)->GetChars() + current_index_,
+          chars, length);
+    }
+    current_index_ += length;
+  } else {
+    for (int i = 0; i < length; i++) {
+      Append(SeqOneByteString::cast(*prefix)->SeqOneByteStringGet(i));
+    }
+  }
+}
+
+
+bool BasicJsonStringifier::SerializeNumberField(Handle<JSObject> object,
+                                                FieldIndex field_index,
+                                                bool deferred_comma,
+                                                Handle<String> prefix) {
+  if (field_index.is_unboxed_double()) {
+    double value = object->RawFastDoublePropertyAt(field_index);
+    AppendKeyPrefix(deferred_comma, prefix);
+    SerializeDouble(value);
+    return true;
+  }
+  Object* value = object->RawFastPropertyAt(field_index);
+  if (value->IsSmi()) {
+    AppendKeyPrefix(deferred_comma, prefix);
+    SerializeSmi(Smi::cast(value));
+    return true;
+  }
+  if (value->IsHeapNumber() || value->IsMutableHeapNumber()) {
+    double number = HeapNumber::cast(value)->value();
+    AppendKeyPrefix(deferred_comma, prefix);
+    SerializeDouble(number);
+    return true;
+  }
+  return false;
+}
+
+
 void BasicJsonStringifier::ShrinkCurrentPart() {
   DCHECK(current_index_ < part_length_);
   current_part_ = SeqString::Truncate(Handle<SeqString>::cast(current_part_),
@@ -715,6 +929,11 @@ void BasicJsonStringifier::ShrinkCurrentPart() {
 
 
 void BasicJsonStringifier::Accumulate() {
+  if (stream_ != NULL) {
+    // Nothing is accumulated when streaming, the parts are written out.
+    if (!aborted_) WriteToStream(current_part_);
+    return;
+  }
   if (accumulator()->length() + current_part_->length() > String::kMaxLength) {
     // Screw it.  Simply set the flag and carry on.  Throw exception at the end.
     set_accumulator(factory_->empty_string());
@@ -17,6 +17,7 @@
 #include "src/regexp-macro-assembler.h"
 #include "src/regexp-macro-assembler-irregexp.h"
 #include "src/regexp-macro-assembler-tracer.h"
+#include "src/regexp-nfa.h"
 #include "src/regexp-stack.h"
 #include "src/runtime/runtime.h"
 #include "src/string-search.h"
@@ -150,6 +151,55 @@ static bool HasFewDifferentCharacters(Handle<String> pattern) {
 }
 
 
+// Returns the character every match of the tree starts with, or -1 if there
+// is no such character.
+static int LeadingCharacter(RegExpTree* tree) {
+  if (tree->min_match() == 0) return -1;
+  if (tree->IsAtom()) return tree->AsAtom()->data()[0];
+  if (tree->IsText()) {
+    TextElement element = tree->AsText()->elements()->at(0);
+    if (element.text_type() != TextElement::ATOM) return -1;
+    return LeadingCharacter(element.atom());
+  }
+  if (tree->IsCapture()) return LeadingCharacter(tree->AsCapture()->body());
+  if (tree->IsQuantifier()) {
+    return LeadingCharacter(tree->AsQuantifier()->body());
+  }
+  if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      // Assertions and lookaheads do not move the start of the match.
+      if (nodes->at(i)->max_match() == 0) continue;
+      return LeadingCharacter(nodes->at(i));
+    }
+    return -1;
+  }
+  if (tree->IsDisjunction()) {
+    ZoneList<RegExpTree*>* alternatives = tree->AsDisjunction()->alternatives();
+    int c = LeadingCharacter(alternatives->at(0));
+    for (int i = 1; i < alternatives->length() && c != -1; i++) {
+      if (LeadingCharacter(alternatives->at(i)) != c) return -1;
+    }
+    return c;
+  }
+  return -1;
+}
+
+
+// Returns the first index at or after the given one where the character
+// occurs in the subject, or -1 if it does not occur. The search is done with
+// memchr, which scans many characters at a time.
+static int FindLeadingCharacter(Handle<String> subject, uc16 c, int index) {
+  DisallowHeapAllocation no_gc;
+  Vector<const uc16> pattern(&c, 1);
+  String::FlatContent content = subject->GetFlatContent();
+  if (content.IsOneByte()) {
+    return FindFirstCharacter(pattern, content.ToOneByteVector(), index);
+  }
+  return FindFirstCharacter(pattern, content.ToUC16Vector(), index);
+}
+
+
 // Generic RegExp methods. Dispatches to implementation specific methods.
 
 
@@ -211,6 +261,19 @@ MaybeHandle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
   }
   if (!has_been_compiled) {
     IrregexpInitialize(re, pattern, flags, parse_result.capture_count);
+    if (FLAG_regexp_optimization && !flags.is_ignore_case() &&
+        !flags.is_sticky()) {
+      FixedArray::cast(re->data())
+          ->set(JSRegExp::kIrregexpLeadingCharacterIndex,
+                Smi::FromInt(LeadingCharacter(parse_result.tree)));
+    }
+    Handle<ByteArray> program;
+    if (FLAG_regexp_nfa &&
+        RegExpNfa::Compile(isolate, &parse_result, flags, &zone)
+            .ToHandle(&program)) {
+      FixedArray::cast(re->data())
+          ->set(JSRegExp::kIrregexpNfaProgramIndex, *program);
+    }
   }
   DCHECK(re->data()->IsFixedArray());
   // Compilation succeeded so the data is set on the regexp
@@ -487,6 +550,18 @@ Code* RegExpImpl::IrregexpNativeCode(FixedArray* re, bool is_one_byte) {
 }
 
 
+Object* RegExpImpl::IrregexpNfaProgram(FixedArray* re) {
+  return re->get(JSRegExp::kIrregexpNfaProgramIndex);
+}
+
+
+int RegExpImpl::IrregexpLeadingCharacter(FixedArray* re) {
+  return Smi::cast(re->get(JSRegExp::kIrregexpLeadingCharacterIndex))->value();
+}
+
+
+
+
 void RegExpImpl::IrregexpInitialize(Handle<JSRegExp> re,
                                     Handle<String> pattern,
                                     JSRegExp::Flags flags,
@@ -504,6 +579,11 @@ int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
                                 Handle<String> subject) {
   subject = String::Flatten(subject);
 
+  // The non-backtracking matcher only needs room to output captures.
+  if (IrregexpNfaProgram(FixedArray::cast(regexp->data()))->IsByteArray()) {
+    return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
+  }
+
   // Check representation of the underlying storage.
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
   if (!EnsureCompiledIrregexp(regexp, subject, is_one_byte)) return -1;
@@ -523,6 +603,38 @@ int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
 }
 
 
+// Called when a match gave up after --regexp-backtrack-limit backtracks. If
+// the non-backtracking matcher supports the pattern, the regexp switches to it
+// for this and all later executions, otherwise a RangeError is thrown.
+static RegExpImpl::IrregexpResult BacktrackLimitExceeded(
+    Handle<JSRegExp> regexp, Handle<String> subject, int index,
+    int32_t* output) {
+  Isolate* isolate = regexp->GetIsolate();
+  Handle<String> pattern = String::Flatten(handle(regexp->Pattern(), isolate));
+  JSRegExp::Flags flags = regexp->GetFlags();
+  Zone zone(isolate);
+  RegExpCompileData compile_data;
+  FlatStringReader reader(isolate, pattern);
+  Handle<ByteArray> program;
+  if (RegExpParser::ParseRegExp(&reader, flags.is_multiline(), &compile_data,
+                                &zone) &&
+      RegExpNfa::Compile(isolate, &compile_data, flags, &zone)
+          .ToHandle(&program)) {
+    FixedArray::cast(regexp->data())
+        ->set(JSRegExp::kIrregexpNfaProgramIndex, *program);
+    return RegExpNfa::Match(program, subject, output, index);
+  }
+  Handle<Object> error;
+  if (isolate->factory()
+          ->NewRangeError("regexp_backtrack_limit",
+                          HandleVector<Object>(NULL, 0))
+          .ToHandle(&error)) {
+    isolate->Throw(*error);
+  }
+  return RegExpImpl::RE_EXCEPTION;
+}
+
+
 int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                 Handle<String> subject,
                                 int index,
@@ -536,6 +648,20 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
   DCHECK(index <= subject->length());
   DCHECK(subject->IsFlat());
 
+  // No match can start before the first occurrence of the leading character.
+  int leading_character = IrregexpLeadingCharacter(*irregexp);
+  if (leading_character != -1) {
+    index = FindLeadingCharacter(subject, leading_character, index);
+    if (index == -1) return RE_FAILURE;
+  }
+
+  Object* program = IrregexpNfaProgram(*irregexp);
+  if (program->IsByteArray()) {
+    DCHECK(output_size >= (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
+    return RegExpNfa::Match(handle(ByteArray::cast(program), isolate),
+                            subject, output, index);
+  }
+
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
 
 #ifndef V8_INTERPRETED_REGEXP
@@ -554,6 +680,9 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                           output_size,
                                           index,
                                           isolate);
+    if (res == NativeRegExpMacroAssembler::BACKTRACK_LIMIT_EXCEEDED) {
+      return BacktrackLimitExceeded(regexp, subject, index, output);
+    }
     if (res != NativeRegExpMacroAssembler::RETRY) {
       DCHECK(res != NativeRegExpMacroAssembler::EXCEPTION ||
              isolate->has_pending_exception());
@@ -598,6 +727,9 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                                      subject,
                                                      raw_output,
                                                      index);
+  if (result == RE_BACKTRACK_LIMIT_EXCEEDED) {
+    return BacktrackLimitExceeded(regexp, subject, index, output);
+  }
   if (result == RE_SUCCESS) {
     // Copy capture results to the start of the registers array.
     MemCopy(output, raw_output, number_of_capture_registers * sizeof(int32_t));
@@ -84,7 +84,14 @@ class RegExpImpl {
                                  int index,
                                  Handle<JSArray> lastMatchInfo);
 
-  enum IrregexpResult { RE_FAILURE = 0, RE_SUCCESS = 1, RE_EXCEPTION = -1 };
+  // RE_BACKTRACK_LIMIT_EXCEEDED is only returned by the matchers themselves,
+  // IrregexpExecRaw turns it into one of the other results.
+  enum IrregexpResult {
+    RE_BACKTRACK_LIMIT_EXCEEDED = -3,
+    RE_FAILURE = 0,
+    RE_SUCCESS = 1,
+    RE_EXCEPTION = -1
+  };
 
   // Prepare a RegExp for being executed one or more times (using
   // IrregexpExecOnce) on the subject.
@@ -206,6 +213,8 @@ class RegExpImpl {
   static int IrregexpNumberOfRegisters(FixedArray* re);
   static ByteArray* IrregexpByteCode(FixedArray* re, bool is_one_byte);
   static Code* IrregexpNativeCode(FixedArray* re, bool is_one_byte);
+  static Object* IrregexpNfaProgram(FixedArray* re);
+  static int IrregexpLeadingCharacter(FixedArray* re);
 
   // Limit the space regexps take up on the heap.  In order to limit this we
   // would like to keep track of the amount of regexp code on the heap.  This
@@ -17,9 +17,11 @@ namespace v8 {
 namespace platform {
 
 
-v8::Platform* CreateDefaultPlatform(int thread_pool_size) {
+v8::Platform* CreateDefaultPlatform(int thread_pool_size,
+                                    bool idle_task_support) {
   DefaultPlatform* platform = new DefaultPlatform();
   platform->SetThreadPoolSize(thread_pool_size);
+  platform->SetIdleTaskSupport(idle_task_support);
   platform->EnsureInitialized();
   return platform;
 }
@@ -30,21 +32,33 @@ bool PumpMessageLoop(v8::Platform* platform, v8::Isolate* isolate) {
 }
 
 
+void RunIdleTasks(v8::Platform* platform, v8::Isolate* isolate,
+                  double idle_time_in_seconds) {
+  reinterpret_cast<DefaultPlatform*>(platform)->RunIdleTasks(
+      isolate, idle_time_in_seconds);
+}
+
+
 const int DefaultPlatform::kMaxThreadPoolSize = 4;
 
 
 DefaultPlatform::DefaultPlatform()
-    : initialized_(false), thread_pool_size_(0) {}
+    : initialized_(false),
+      thread_pool_size_(0),
+      pin_threads_(false),
+      idle_task_support_(false),
+      queue_(NULL) {}
 
 
 DefaultPlatform::~DefaultPlatform() {
   base::LockGuard<base::Mutex> guard(&lock_);
-  queue_.Terminate();
   if (initialized_) {
+    queue_->Terminate();
     for (std::vector<WorkerThread*>::iterator i = thread_pool_.begin();
          i != thread_pool_.end(); ++i) {
       delete *i;
     }
+    delete queue_;
   }
   for (std::map<v8::Isolate*, std::queue<Task*> >::iterator i =
            main_thread_queue_.begin();
@@ -54,6 +68,22 @@ DefaultPlatform::~DefaultPlatform() {
       i->second.pop();
     }
   }
+  for (std::map<v8::Isolate*, DelayedTaskQueue>::iterator i =
+           main_thread_delayed_queue_.begin();
+       i != main_thread_delayed_queue_.end(); ++i) {
+    while (!i->second.empty()) {
+      delete i->second.top().second;
+      i->second.pop();
+    }
+  }
+  for (std::map<v8::Isolate*, std::queue<IdleTask*> >::iterator i =
+           main_thread_idle_queue_.begin();
+       i != main_thread_idle_queue_.end(); ++i) {
+    while (!i->second.empty()) {
+      delete i->second.front();
+      i->second.pop();
+    }
+  }
 }
 
 
@@ -68,13 +98,69 @@ void DefaultPlatform::SetThreadPoolSize(int thread_pool_size) {
 }
 
 
+void DefaultPlatform::SetThreadPoolAffinity(bool pin_threads) {
+  base::LockGuard<base::Mutex> guard(&lock_);
+  DCHECK(!initialized_);
+  pin_threads_ = pin_threads;
+}
+
+
+void DefaultPlatform::SetIdleTaskSupport(bool idle_task_support) {
+  base::LockGuard<base::Mutex> guard(&lock_);
+  idle_task_support_ = idle_task_support;
+}
+
+
 void DefaultPlatform::EnsureInitialized() {
   base::LockGuard<base::Mutex> guard(&lock_);
   if (initialized_) return;
   initialized_ = true;
 
-  for (int i = 0; i < thread_pool_size_; ++i)
-    thread_pool_.push_back(new WorkerThread(&queue_));
+  queue_ = new TaskQueue(std::max(thread_pool_size_, 1));
+  int processors = base::SysInfo::NumberOfProcessors();
+  for (int i = 0; i < thread_pool_size_; ++i) {
+    int cpu = pin_threads_ && processors > 0 ? i % processors : -1;
+    thread_pool_.push_back(new WorkerThread(queue_, i, cpu));
+  }
+}
+
+
+Task* DefaultPlatform::PopTaskInMainThreadQueue(v8::Isolate* isolate) {
+  std::map<v8::Isolate*, std::queue<Task*> >::iterator it =
+      main_thread_queue_.find(isolate);
+  if (it == main_thread_queue_.end() || it->second.empty()) {
+    return NULL;
+  }
+  Task* task = it->second.front();
+  it->second.pop();
+  return task;
+}
+
+
+Task* DefaultPlatform::PopTaskInMainThreadDelayedQueue(v8::Isolate* isolate) {
+  std::map<v8::Isolate*, DelayedTaskQueue>::iterator it =
+      main_thread_delayed_queue_.find(isolate);
+  if (it == main_thread_delayed_queue_.end() || it->second.empty()) {
+    return NULL;
+  }
+  double now = MonotonicallyIncreasingTime();
+  const DelayedEntry& entry = it->second.top();
+  if (entry.first > now) return NULL;
+  Task* task = entry.second;
+  it->second.pop();
+  return task;
+}
+
+
+IdleTask* DefaultPlatform::PopTaskInMainThreadIdleQueue(v8::Isolate* isolate) {
+  std::map<v8::Isolate*, std::queue<IdleTask*> >::iterator it =
+      main_thread_idle_queue_.find(isolate);
+  if (it == main_thread_idle_queue_.end() || it->second.empty()) {
+    return NULL;
+  }
+  IdleTask* task = it->second.front();
+  it->second.pop();
+  return task;
 }
 
 
@@ -82,23 +168,56 @@ bool DefaultPlatform::PumpMessageLoop(v8::Isolate* isolate) {
   Task* task = NULL;
   {
     base::LockGuard<base::Mutex> guard(&lock_);
-    std::map<v8::Isolate*, std::queue<Task*> >::iterator it =
-        main_thread_queue_.find(isolate);
-    if (it == main_thread_queue_.end() || it->second.empty()) {
-      return false;
+
+    // Move delayed tasks that hit their deadline to the main queue.
+    Task* delayed = PopTaskInMainThreadDelayedQueue(isolate);
+    while (delayed != NULL) {
+      main_thread_queue_[isolate].push(delayed);
+      delayed = PopTaskInMainThreadDelayedQueue(isolate);
     }
-    task = it->second.front();
-    it->second.pop();
+
+    task = PopTaskInMainThreadQueue(isolate);
+    if (task == NULL) return false;
   }
   task->Run();
   delete task;
   return true;
 }
 
+
+int DefaultPlatform::TaskQueueContentionCount() const {
+  return queue_ == NULL ? 0 : queue_->LockContentionCount();
+}
+
+
+void DefaultPlatform::RunIdleTasks(v8::Isolate* isolate,
+                                   double idle_time_in_seconds) {
+  double deadline_in_seconds =
+      MonotonicallyIncreasingTime() + idle_time_in_seconds;
+  while (deadline_in_seconds > MonotonicallyIncreasingTime()) {
+    IdleTask* task;
+    {
+      base::LockGuard<base::Mutex> guard(&lock_);
+      task = PopTaskInMainThreadIdleQueue(isolate);
+    }
+    if (task == NULL) return;
+    task->Run(deadline_in_seconds);
+    delete task;
+  }
+}
+
 void DefaultPlatform::CallOnBackgroundThread(Task *task,
                                              ExpectedRuntime expected_runtime) {
   EnsureInitialized();
-  queue_.Append(task);
+  queue_->Append(task, expected_runtime);
+}
+
+
+void DefaultPlatform::CallOnBackgroundThreadWithPriority(
+    v8::Isolate* isolate, Task* task, ExpectedRuntime expected_runtime,
+    TaskPriority priority) {
+  EnsureInitialized();
+  queue_->Append(task, expected_runtime, priority, isolate);
 }
 
 
@@ -108,6 +227,29 @@ void DefaultPlatform::CallOnForegroundThread(v8::Isolate* isolate, Task* task) {
 }
 
 
+void DefaultPlatform::CallDelayedOnForegroundThread(Isolate* isolate,
+                                                    Task* task,
+                                                    double delay_in_seconds) {
+  base::LockGuard<base::Mutex> guard(&lock_);
+  double deadline = MonotonicallyIncreasingTime() + delay_in_seconds;
+  main_thread_delayed_queue_[isolate].push(std::make_pair(deadline, task));
+}
+
+
+void DefaultPlatform::CallIdleOnForegroundThread(Isolate* isolate,
+                                                 IdleTask* task) {
+  base::LockGuard<base::Mutex> guard(&lock_);
+  DCHECK(idle_task_support_);
+  main_thread_idle_queue_[isolate].push(task);
+}
+
+
+bool DefaultPlatform::IdleTasksEnabled(Isolate* isolate) {
+  base::LockGuard<base::Mutex> guard(&lock_);
+  return idle_task_support_;
+}
+
+
 double DefaultPlatform::MonotonicallyIncreasingTime() {
   return base::TimeTicks::HighResolutionNow().ToInternalValue() /
          static_cast<double>(base::Time::kMicrosecondsPerSecond);
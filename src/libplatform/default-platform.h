@@ -5,8 +5,10 @@
 #ifndef V8_LIBPLATFORM_DEFAULT_PLATFORM_H_
 #define V8_LIBPLATFORM_DEFAULT_PLATFORM_H_
 
+#include <functional>
 #include <map>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "include/v8-platform.h"
@@ -28,26 +30,62 @@ class DefaultPlatform : public Platform {
 
   void SetThreadPoolSize(int thread_pool_size);
 
+  // Pins each worker thread to its own processor. Has to be called before
+  // the platform is initialized.
+  void SetThreadPoolAffinity(bool pin_threads);
+
   void EnsureInitialized();
 
+  // Enables CallIdleOnForegroundThread(). The embedder has to call
+  // RunIdleTasks() when it has idle time for an isolate.
+  void SetIdleTaskSupport(bool idle_task_support);
+
   bool PumpMessageLoop(v8::Isolate* isolate);
 
+  void RunIdleTasks(v8::Isolate* isolate, double idle_time_in_seconds);
+
+  // Returns how often the lock guarding the foreground task queues, and the
+  // locks of the background task queue, were found held by another thread.
+  int LockContentionCount() const { return lock_.contention_count(); }
+  int TaskQueueContentionCount() const;
+
   // v8::Platform implementation.
   virtual void CallOnBackgroundThread(
       Task* task, ExpectedRuntime expected_runtime) OVERRIDE;
+  virtual void CallOnBackgroundThreadWithPriority(
+      v8::Isolate* isolate, Task* task, ExpectedRuntime expected_runtime,
+      TaskPriority priority) OVERRIDE;
   virtual void CallOnForegroundThread(v8::Isolate* isolate,
                                       Task* task) OVERRIDE;
+  virtual void CallDelayedOnForegroundThread(v8::Isolate* isolate, Task* task,
+                                             double delay_in_seconds) OVERRIDE;
+  virtual void CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                          IdleTask* task) OVERRIDE;
+  virtual bool IdleTasksEnabled(v8::Isolate* isolate) OVERRIDE;
   virtual double MonotonicallyIncreasingTime() OVERRIDE;
 
  private:
   static const int kMaxThreadPoolSize;
 
+  // Delayed tasks ordered by their deadline, earliest first.
+  typedef std::pair<double, Task*> DelayedEntry;
+  typedef std::priority_queue<DelayedEntry, std::vector<DelayedEntry>,
+                              std::greater<DelayedEntry> > DelayedTaskQueue;
+
+  Task* PopTaskInMainThreadQueue(v8::Isolate* isolate);
+  Task* PopTaskInMainThreadDelayedQueue(v8::Isolate* isolate);
+  IdleTask* PopTaskInMainThreadIdleQueue(v8::Isolate* isolate);
+
   base::Mutex lock_;
   bool initialized_;
   int thread_pool_size_;
+  bool pin_threads_;
+  bool idle_task_support_;
   std::vector<WorkerThread*> thread_pool_;
-  TaskQueue queue_;
+  TaskQueue* queue_;
   std::map<v8::Isolate*, std::queue<Task*> > main_thread_queue_;
+  std::map<v8::Isolate*, DelayedTaskQueue> main_thread_delayed_queue_;
+  std::map<v8::Isolate*, std::queue<IdleTask*> > main_thread_idle_queue_;
 
   DISALLOW_COPY_AND_ASSIGN(DefaultPlatform);
 };
@@ -9,48 +9,161 @@
 namespace v8 {
 namespace platform {
 
-TaskQueue::TaskQueue() : process_queue_semaphore_(0), terminated_(false) {}
+TaskQueue::TaskQueue(int lanes)
+    : lane_count_(lanes),
+      lanes_(new Lane[lanes]),
+      next_lane_(0),
+      terminated_(0) {
+  DCHECK(lanes > 0);
+}
 
 
 TaskQueue::~TaskQueue() {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(terminated_);
-  DCHECK(task_queue_.empty());
+  DCHECK(base::NoBarrier_Load(&terminated_));
+  for (int i = 0; i < lane_count_; ++i) {
+    base::LockGuard<base::Mutex> guard(&lanes_[i].lock);
+    for (int priority = 0; priority < kPriorities; ++priority) {
+      DCHECK(lanes_[i].short_tasks[priority].empty());
+      DCHECK(lanes_[i].long_tasks[priority].empty());
+    }
+  }
+  delete[] lanes_;
+}
+
+
+void TaskQueue::FairQueue::Push(Isolate* isolate, Task* task) {
+  tasks_[isolate].push_back(task);
+}
+
+
+Task* TaskQueue::FairQueue::Pop() {
+  if (tasks_.empty()) return NULL;
+  // Continue with the isolate after the one that was served last.
+  TaskMap::iterator it = has_last_isolate_ ? tasks_.upper_bound(last_isolate_)
+                                           : tasks_.begin();
+  if (it == tasks_.end()) it = tasks_.begin();
+  Task* result = it->second.front();
+  it->second.pop_front();
+  has_last_isolate_ = true;
+  last_isolate_ = it->first;
+  if (it->second.empty()) tasks_.erase(it);
+  return result;
+}
+
+
+int TaskQueue::SelectLane(Platform::ExpectedRuntime expected_runtime) {
+  uint32_t next = static_cast<uint32_t>(
+      base::NoBarrier_AtomicIncrement(&next_lane_, 1) - 1);
+  if (expected_runtime == Platform::kLongRunningTask && lane_count_ > 1) {
+    return 1 + static_cast<int>(next % (lane_count_ - 1));
+  }
+  return static_cast<int>(next % lane_count_);
+}
+
+
+void TaskQueue::Append(Task* task, Platform::ExpectedRuntime expected_runtime,
+                       Platform::TaskPriority priority, Isolate* isolate) {
+  DCHECK(!base::NoBarrier_Load(&terminated_));
+  DCHECK(priority >= 0 && priority < kPriorities);
+  int target = SelectLane(expected_runtime);
+  {
+    Lane* lane = &lanes_[target];
+    base::LockGuard<base::Mutex> guard(&lane->lock);
+    if (expected_runtime == Platform::kLongRunningTask) {
+      lane->long_tasks[priority].Push(isolate, task);
+    } else {
+      lane->short_tasks[priority].Push(isolate, task);
+    }
+  }
+  lanes_[target].semaphore.Signal();
+  if (lane_count_ == 1) return;
+
+  // If the target lane's worker is busy, wake up an idle one to steal the
+  // task. The barrier pairs with the one in GetNext: either the idle worker
+  // sees the task when it rechecks the lanes, or we see it idle here.
+  base::MemoryBarrier();
+  if (base::NoBarrier_Load(&lanes_[target].idle)) return;
+  for (int i = 1; i < lane_count_; ++i) {
+    int victim = (target + i) % lane_count_;
+    if (expected_runtime == Platform::kLongRunningTask && victim == 0) {
+      continue;
+    }
+    if (base::NoBarrier_Load(&lanes_[victim].idle)) {
+      lanes_[victim].semaphore.Signal();
+      return;
+    }
+  }
 }
 
 
-void TaskQueue::Append(Task* task) {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(!terminated_);
-  task_queue_.push(task);
-  process_queue_semaphore_.Signal();
+Task* TaskQueue::TryTake(int lane, int priority, bool include_long_tasks) {
+  Lane* l = &lanes_[lane];
+  base::LockGuard<base::Mutex> guard(&l->lock);
+  Task* result = l->short_tasks[priority].Pop();
+  if (result == NULL && include_long_tasks) {
+    result = l->long_tasks[priority].Pop();
+  }
+  return result;
 }
 
 
-Task* TaskQueue::GetNext() {
+Task* TaskQueue::TryGetNext(int lane) {
+  bool take_long_tasks = lane != 0 || lane_count_ == 1;
+  for (int priority = 0; priority < kPriorities; ++priority) {
+    Task* result = TryTake(lane, priority, take_long_tasks);
+    if (result != NULL) return result;
+    // Steal short tasks first, long running ones only if there are no short
+    // tasks of this priority left anywhere.
+    for (int i = 1; i < lane_count_; ++i) {
+      result = TryTake((lane + i) % lane_count_, priority, false);
+      if (result != NULL) return result;
+    }
+    if (!take_long_tasks) continue;
+    for (int i = 1; i < lane_count_; ++i) {
+      result = TryTake((lane + i) % lane_count_, priority, true);
+      if (result != NULL) return result;
+    }
+  }
+  return NULL;
+}
+
+
+Task* TaskQueue::GetNext(int lane) {
+  DCHECK(lane >= 0 && lane < lane_count_);
+  Lane* l = &lanes_[lane];
   for (;;) {
-    {
-      base::LockGuard<base::Mutex> guard(&lock_);
-      if (!task_queue_.empty()) {
-        Task* result = task_queue_.front();
-        task_queue_.pop();
-        return result;
-      }
-      if (terminated_) {
-        process_queue_semaphore_.Signal();
-        return NULL;
-      }
+    Task* result = TryGetNext(lane);
+    if (result != NULL) return result;
+    if (base::Acquire_Load(&terminated_)) {
+      // Pass the wake-up on to the other workers serving this lane.
+      l->semaphore.Signal();
+      return NULL;
+    }
+    base::NoBarrier_Store(&l->idle, 1);
+    base::MemoryBarrier();
+    result = TryGetNext(lane);
+    if (result == NULL && !base::Acquire_Load(&terminated_)) {
+      l->semaphore.Wait();
     }
-    process_queue_semaphore_.Wait();
+    base::NoBarrier_Store(&l->idle, 0);
+    if (result != NULL) return result;
   }
 }
 
 
 void TaskQueue::Terminate() {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(!terminated_);
-  terminated_ = true;
-  process_queue_semaphore_.Signal();
+  DCHECK(!base::NoBarrier_Load(&terminated_));
+  base::Release_Store(&terminated_, 1);
+  for (int i = 0; i < lane_count_; ++i) lanes_[i].semaphore.Signal();
+}
+
+
+int TaskQueue::LockContentionCount() const {
+  int count = 0;
+  for (int i = 0; i < lane_count_; ++i) {
+    count += lanes_[i].lock.contention_count();
+  }
+  return count;
 }
 
 } }  // namespace v8::platform
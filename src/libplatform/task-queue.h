@@ -5,38 +5,98 @@
 #ifndef V8_LIBPLATFORM_TASK_QUEUE_H_
 #define V8_LIBPLATFORM_TASK_QUEUE_H_
 
-#include <queue>
+#include <deque>
+#include <map>
 
+#include "include/v8-platform.h"
+#include "src/base/atomicops.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
 
 namespace v8 {
 
+class Isolate;
 class Task;
 
 namespace platform {
 
+// A task queue with one lane per worker thread. Tasks are distributed over
+// the lanes round-robin, and a worker whose own lane is empty steals the
+// oldest task from another lane before going to sleep, so that a burst of
+// tasks landing on a busy lane does not wait for that lane's worker. Each
+// lane is guarded by its own lock, so workers only contend when stealing.
+//
+// Workers always pick the most urgent task available, looking at all lanes
+// before moving on to a lower priority. Within a priority, the isolates
+// that posted tasks take turns, so that one isolate flooding the queue
+// cannot starve the others.
+//
+// Long running tasks never go to lane 0 (unless it is the only lane) and
+// are stolen last, to keep at least one worker available for short tasks.
 class TaskQueue {
  public:
-  TaskQueue();
+  explicit TaskQueue(int lanes = 1);
   ~TaskQueue();
 
+  int lanes() const { return lane_count_; }
+
   // Appends a task to the queue. The queue takes ownership of |task|.
-  void Append(Task* task);
+  void Append(Task* task, Platform::ExpectedRuntime expected_runtime =
+                              Platform::kShortRunningTask,
+              Platform::TaskPriority priority = Platform::kUserVisiblePriority,
+              Isolate* isolate = NULL);
 
-  // Returns the next task to process. Blocks if no task is available. Returns
-  // NULL if the queue is terminated.
-  Task* GetNext();
+  // Returns the next task to process for the worker serving |lane|. Blocks if
+  // no task is available. Returns NULL if the queue is terminated.
+  Task* GetNext(int lane = 0);
 
   // Terminate the queue.
   void Terminate();
 
+  // Returns how often a lane lock was found held by another thread.
+  int LockContentionCount() const;
+
  private:
-  base::Mutex lock_;
-  base::Semaphore process_queue_semaphore_;
-  std::queue<Task*> task_queue_;
-  bool terminated_;
+  static const int kPriorities = Platform::kBestEffortPriority + 1;
+
+  // Tasks of one priority class, served round-robin per isolate.
+  class FairQueue {
+   public:
+    FairQueue() : has_last_isolate_(false), last_isolate_(NULL) {}
+
+    bool empty() const { return tasks_.empty(); }
+    void Push(Isolate* isolate, Task* task);
+    Task* Pop();
+
+   private:
+    typedef std::map<Isolate*, std::deque<Task*> > TaskMap;
+
+    TaskMap tasks_;
+    bool has_last_isolate_;
+    Isolate* last_isolate_;
+  };
+
+  struct Lane {
+    Lane() : semaphore(0), idle(0) {}
+
+    base::Mutex lock;
+    FairQueue short_tasks[kPriorities];
+    FairQueue long_tasks[kPriorities];
+    base::Semaphore semaphore;
+    base::Atomic32 idle;
+  };
+
+  // Takes a task of the given priority from the given lane, or returns NULL
+  // if it has none.
+  Task* TryTake(int lane, int priority, bool include_long_tasks);
+  Task* TryGetNext(int lane);
+  int SelectLane(Platform::ExpectedRuntime expected_runtime);
+
+  int lane_count_;
+  Lane* lanes_;
+  base::Atomic32 next_lane_;
+  base::Atomic32 terminated_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueue);
 };
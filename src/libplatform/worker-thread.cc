@@ -10,8 +10,11 @@
 namespace v8 {
 namespace platform {
 
-WorkerThread::WorkerThread(TaskQueue* queue)
-    : Thread(Options("V8 WorkerThread")), queue_(queue) {
+WorkerThread::WorkerThread(TaskQueue* queue, int lane, int cpu)
+    : Thread(Options("V8 WorkerThread")),
+      queue_(queue),
+      lane_(lane),
+      cpu_(cpu) {
   Start();
 }
 
@@ -22,7 +25,8 @@ WorkerThread::~WorkerThread() {
 
 
 void WorkerThread::Run() {
-  while (Task* task = queue_->GetNext()) {
+  if (cpu_ >= 0) base::Thread::SetCurrentThreadAffinity(cpu_);
+  while (Task* task = queue_->GetNext(lane_)) {
     task->Run();
     delete task;
   }
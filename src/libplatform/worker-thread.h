@@ -18,7 +18,9 @@ class TaskQueue;
 
 class WorkerThread : public base::Thread {
  public:
-  explicit WorkerThread(TaskQueue* queue);
+  // Serves |lane| of |queue|. If |cpu| is not negative, the thread is pinned
+  // to that processor where the OS supports it.
+  WorkerThread(TaskQueue* queue, int lane = 0, int cpu = -1);
   virtual ~WorkerThread();
 
   // Thread implementation.
@@ -28,6 +30,8 @@ class WorkerThread : public base::Thread {
   friend class QuitTask;
 
   TaskQueue* queue_;
+  int lane_;
+  int cpu_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkerThread);
 };
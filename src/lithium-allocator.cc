@@ -510,10 +510,53 @@ LifetimePosition LiveRange::FirstIntersection(LiveRange* other) {
 }
 
 
+SparseLiveSet* SparseLiveSet::New(BitVector* live, Zone* zone) {
+  int length = live->Count();
+  int* members = zone->NewArray<int>(length);
+  int index = 0;
+  for (BitVector::Iterator it(live); !it.Done(); it.Advance()) {
+    members[index++] = it.Current();
+  }
+  DCHECK_EQ(length, index);
+  return new(zone) SparseLiveSet(length, members);
+}
+
+
+SparseLiveSet* SparseLiveSet::Union(SparseLiveSet* other, Zone* zone) {
+  if (other->length_ == 0) return this;
+  if (length_ == 0) return other;
+  int* members = zone->NewArray<int>(length_ + other->length_);
+  int length = 0;
+  int i = 0;
+  int j = 0;
+  while (i < length_ && j < other->length_) {
+    if (members_[i] < other->members_[j]) {
+      members[length++] = members_[i++];
+    } else if (other->members_[j] < members_[i]) {
+      members[length++] = other->members_[j++];
+    } else {
+      members[length++] = members_[i++];
+      j++;
+    }
+  }
+  while (i < length_) members[length++] = members_[i++];
+  while (j < other->length_) members[length++] = other->members_[j++];
+  return new(zone) SparseLiveSet(length, members);
+}
+
+
+void SparseLiveSet::AddTo(BitVector* live) const {
+  for (int i = 0; i < length_; i++) live->Add(members_[i]);
+}
+
+
 LAllocator::LAllocator(int num_values, HGraph* graph)
     : zone_(graph->isolate()),
       chunk_(NULL),
       live_in_sets_(graph->blocks()->length(), zone()),
+      sparse_live_in_sets_(0, zone()),
+      live_scratch_(NULL),
+      phi_hints_(0, zone()),
       live_ranges_(num_values * 2, zone()),
       fixed_live_ranges_(NULL),
       fixed_double_live_ranges_(NULL),
@@ -527,29 +570,61 @@ LAllocator::LAllocator(int num_values, HGraph* graph)
       num_registers_(-1),
       graph_(graph),
       has_osr_entry_(false),
+      fast_allocation_(false),
       allocation_ok_(true) {}
 
 
 void LAllocator::InitializeLivenessAnalysis() {
   // Initialize the live_in sets for each block to NULL.
   int block_count = graph_->blocks()->length();
-  live_in_sets_.Initialize(block_count, zone());
-  live_in_sets_.AddBlock(NULL, block_count, zone());
+  if (FLAG_lithium_sparse_liveness) {
+    sparse_live_in_sets_.Initialize(block_count, zone());
+    sparse_live_in_sets_.AddBlock(NULL, block_count, zone());
+    live_scratch_ = new(zone()) BitVector(next_virtual_register_, zone());
+  } else {
+    live_in_sets_.Initialize(block_count, zone());
+    live_in_sets_.AddBlock(NULL, block_count, zone());
+  }
+}
+
+
+void LAllocator::AddLiveIn(HBasicBlock* block, BitVector* live) {
+  if (FLAG_lithium_sparse_liveness) {
+    SparseLiveSet* live_in = sparse_live_in_sets_[block->block_id()];
+    if (live_in != NULL) live_in->AddTo(live);
+  } else {
+    BitVector* live_in = live_in_sets_[block->block_id()];
+    if (live_in != NULL) live->Union(*live_in);
+  }
+}
+
+
+BitVector* LAllocator::LiveInFor(HBasicBlock* block) {
+  if (!FLAG_lithium_sparse_liveness) return live_in_sets_[block->block_id()];
+  live_scratch_->Clear();
+  sparse_live_in_sets_[block->block_id()]->AddTo(live_scratch_);
+  return live_scratch_;
 }
 
 
 BitVector* LAllocator::ComputeLiveOut(HBasicBlock* block) {
   // Compute live out for the given block, except not including backward
-  // successor edges.
-  BitVector* live_out = new(zone()) BitVector(next_virtual_register_, zone());
+  // successor edges. The sparse liveness analysis reuses a single vector for
+  // all the blocks and only keeps a compact copy of each live_in set.
+  BitVector* live_out;
+  if (FLAG_lithium_sparse_liveness) {
+    live_out = live_scratch_;
+    live_out->Clear();
+  } else {
+    live_out = new(zone()) BitVector(next_virtual_register_, zone());
+  }
 
   // Process all successor blocks.
   for (HSuccessorIterator it(block->end()); !it.Done(); it.Advance()) {
     // Add values live on entry to the successor. Note the successor's
     // live_in will not be computed yet for backwards edges.
     HBasicBlock* successor = it.Current();
-    BitVector* live_in = live_in_sets_[successor->block_id()];
-    if (live_in != NULL) live_out->Union(*live_in);
+    AddLiveIn(successor, live_out);
 
     // All phi input operands corresponding to this successor edge are live
     // out from this block.
@@ -1037,6 +1112,7 @@ void LAllocator::ResolvePhis(HBasicBlock* block) {
       chunk_->AddGapMove(cur_block->last_instruction_index() - 1,
                          operand,
                          phi_operand);
+      if (j == 0) phi_hints_[phi->id()] = LMoveOperands(operand, phi_operand);
 
       // We are going to insert a move before the branch instruction.
       // Some branch instructions (e.g. loops' back edges)
@@ -1075,6 +1151,8 @@ bool LAllocator::Allocate(LChunk* chunk) {
   assigned_double_registers_ =
       new(chunk->zone()) BitVector(DoubleRegister::NumAllocatableRegisters(),
                                    chunk->zone());
+  fast_allocation_ = FLAG_lithium_fast_allocation_threshold > 0 &&
+      chunk->instructions()->length() > FLAG_lithium_fast_allocation_threshold;
   MeetRegisterConstraints();
   if (!AllocationOk()) return false;
   ResolvePhis();
@@ -1103,6 +1181,9 @@ void LAllocator::MeetRegisterConstraints() {
 
 void LAllocator::ResolvePhis() {
   LAllocatorPhase phase("L_Resolve phis", this);
+  phi_hints_.Initialize(first_artificial_register_, zone());
+  phi_hints_.AddBlock(LMoveOperands(NULL, NULL), first_artificial_register_,
+                      zone());
 
   // Process the blocks in reverse order.
   const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
@@ -1242,7 +1323,7 @@ void LAllocator::ResolveControlFlow() {
   for (int block_id = 1; block_id < blocks->length(); ++block_id) {
     HBasicBlock* block = blocks->at(block_id);
     if (CanEagerlyResolveControlFlow(block)) continue;
-    BitVector* live = live_in_sets_[block->block_id()];
+    BitVector* live = LiveInFor(block);
     BitVector::Iterator iterator(live);
     while (!iterator.Done()) {
       int operand_index = iterator.Current();
@@ -1280,20 +1361,8 @@ void LAllocator::BuildLiveRanges() {
       HPhi* phi = phis->at(i);
       live->Remove(phi->id());
 
-      LOperand* hint = NULL;
-      LOperand* phi_operand = NULL;
-      LGap* gap = GetLastGap(phi->block()->predecessors()->at(0));
-      LParallelMove* move = gap->GetOrCreateParallelMove(LGap::START,
-                                                         chunk()->zone());
-      for (int j = 0; j < move->move_operands()->length(); ++j) {
-        LOperand* to = move->move_operands()->at(j).destination();
-        if (to->IsUnallocated() &&
-            LUnallocated::cast(to)->virtual_register() == phi->id()) {
-          hint = move->move_operands()->at(j).source();
-          phi_operand = to;
-          break;
-        }
-      }
+      LOperand* hint = phi_hints_[phi->id()].source();
+      LOperand* phi_operand = phi_hints_[phi->id()].destination();
       DCHECK(hint != NULL);
 
       LifetimePosition block_start = LifetimePosition::FromInstructionIndex(
@@ -1303,7 +1372,11 @@ void LAllocator::BuildLiveRanges() {
 
     // Now live is live_in for this block except not including values live
     // out on backward successor edges.
-    live_in_sets_[block_id] = live;
+    if (FLAG_lithium_sparse_liveness) {
+      sparse_live_in_sets_[block_id] = SparseLiveSet::New(live, zone());
+    } else {
+      live_in_sets_[block_id] = live;
+    }
 
     // If this block is a loop header go back and patch up the necessary
     // predecessor blocks.
@@ -1325,8 +1398,16 @@ void LAllocator::BuildLiveRanges() {
         iterator.Advance();
       }
 
-      for (int i = block->block_id() + 1; i <= back_edge->block_id(); ++i) {
-        live_in_sets_[i]->Union(*live);
+      if (FLAG_lithium_sparse_liveness) {
+        SparseLiveSet* loop_live_in = sparse_live_in_sets_[block_id];
+        for (int i = block->block_id() + 1; i <= back_edge->block_id(); ++i) {
+          sparse_live_in_sets_[i] =
+              sparse_live_in_sets_[i]->Union(loop_live_in, zone());
+        }
+      } else {
+        for (int i = block->block_id() + 1; i <= back_edge->block_id(); ++i) {
+          live_in_sets_[i]->Union(*live);
+        }
       }
     }
 
@@ -1850,6 +1931,14 @@ void LAllocator::AllocateBlockedReg(LiveRange* current) {
     return;
   }
 
+  LifetimePosition next_pos = current->Start().NextInstruction();
+  if (fast_allocation_ && register_use->pos().Value() > next_pos.Value()) {
+    // Do not evict other live ranges before the current one actually needs a
+    // register, splitting and spilling them is what makes allocation slow.
+    SpillBetween(current, current->Start(), register_use->pos());
+    return;
+  }
+
 
   LifetimePosition use_pos[DoubleRegister::kMaxNumAllocatableRegisters];
   LifetimePosition block_pos[DoubleRegister::kMaxNumAllocatableRegisters];
@@ -1931,6 +2020,8 @@ void LAllocator::AllocateBlockedReg(LiveRange* current) {
 
 LifetimePosition LAllocator::FindOptimalSpillingPos(LiveRange* range,
                                                     LifetimePosition pos) {
+  if (fast_allocation_) return pos;
+
   HBasicBlock* block = GetBlock(pos.InstructionStart());
   HBasicBlock* loop_header =
       block->IsLoopHeader() ? block : block->parent_loop_header();
@@ -2061,6 +2152,9 @@ LifetimePosition LAllocator::FindOptimalSplitPos(LifetimePosition start,
   // We have no choice
   if (start_instr == end_instr) return end;
 
+  // Do not look for a better position outside of loops in fast mode.
+  if (fast_allocation_) return end;
+
   HBasicBlock* start_block = GetBlock(start);
   HBasicBlock* end_block = GetBlock(end);
 
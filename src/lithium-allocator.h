@@ -324,6 +324,33 @@ class LiveRange: public ZoneObject {
 };
 
 
+// The virtual registers that are live on entry to a block, in ascending
+// order. Used instead of one BitVector per block with
+// --lithium-sparse-liveness: its size is proportional to the number of live
+// values rather than to the number of virtual registers.
+class SparseLiveSet : public ZoneObject {
+ public:
+  static SparseLiveSet* New(BitVector* live, Zone* zone);
+
+  // Returns the union of this set and {other}.
+  SparseLiveSet* Union(SparseLiveSet* other, Zone* zone);
+
+  // Adds the members of this set to {live}.
+  void AddTo(BitVector* live) const;
+
+  int length() const { return length_; }
+
+ private:
+  SparseLiveSet(int length, int* members)
+      : length_(length), members_(members) {}
+
+  int length_;
+  int* members_;
+
+  DISALLOW_COPY_AND_ASSIGN(SparseLiveSet);
+};
+
+
 class LAllocator BASE_EMBEDDED {
  public:
   LAllocator(int first_virtual_register, HGraph* graph);
@@ -396,6 +423,8 @@ class LAllocator BASE_EMBEDDED {
   // Liveness analysis support.
   void InitializeLivenessAnalysis();
   BitVector* ComputeLiveOut(HBasicBlock* block);
+  void AddLiveIn(HBasicBlock* block, BitVector* live);
+  BitVector* LiveInFor(HBasicBlock* block);
   void AddInitialIntervals(HBasicBlock* block, BitVector* live_out);
   void ProcessInstructions(HBasicBlock* block, BitVector* live);
   void MeetRegisterConstraints(HBasicBlock* block);
@@ -517,6 +546,14 @@ class LAllocator BASE_EMBEDDED {
   // During liveness analysis keep a mapping from block id to live_in sets
   // for blocks already analyzed.
   ZoneList<BitVector*> live_in_sets_;
+  ZoneList<SparseLiveSet*> sparse_live_in_sets_;
+
+  // The live set of the block being analyzed with --lithium-sparse-liveness.
+  BitVector* live_scratch_;
+
+  // For each phi, the gap move on its first incoming edge. The source of the
+  // move is the allocation hint for the phi.
+  ZoneList<LMoveOperands> phi_hints_;
 
   // Liveness analysis results.
   ZoneList<LiveRange*> live_ranges_;
@@ -546,6 +583,10 @@ class LAllocator BASE_EMBEDDED {
 
   bool has_osr_entry_;
 
+  // Whether the chunk is large enough to trade code quality for allocation
+  // speed, see --lithium-fast-allocation-threshold.
+  bool fast_allocation_;
+
   // Indicates success or failure during register allocation.
   bool allocation_ok_;
 
@@ -124,6 +124,16 @@ void LOperand::PrintTo(StringStream* stream) {
       }
       break;
     }
+    case TRY_SLOT: {
+      LTrySlot* slot = LTrySlot::cast(this);
+      if (slot->is_handler_word()) {
+        stream->Add("[handler:%d+%d]", slot->stack_index(),
+                    slot->handler_offset());
+      } else {
+        stream->Add("[catch:%d]", slot->stack_index());
+      }
+      break;
+    }
   }
 }
 
@@ -551,6 +561,7 @@ LEnvironment* LChunkBuilderBase::CreateEnvironment(
                                hydrogen_env->entry(),
                                zone());
   int argument_index = *argument_index_accumulator;
+  int handler_word = 0;
 
   // Store the environment description into the environment
   // (with holes for nested objects)
@@ -564,6 +575,14 @@ LEnvironment* LChunkBuilderBase::CreateEnvironment(
     CHECK(!value->IsPushArguments());  // Do not deopt outgoing arguments
     if (value->IsArgumentsObject() || value->IsCapturedObject()) {
       op = LEnvironment::materialization_marker();
+    } else if (value->IsEnterTry()) {
+      // The handler words are pushed starting with the last field.
+      HEnterTry* entry = HEnterTry::cast(value);
+      bool same_handler = i > 0 && hydrogen_env->values()->at(i - 1) == value;
+      handler_word = same_handler ? handler_word + 1 : 0;
+      op = LTrySlot::HandlerWord(
+          entry->handler_stack_index() + handler_word,
+          StackHandlerConstants::kSlotCount - 1 - handler_word, zone());
     } else {
       op = UseAny(value);
     }
@@ -32,7 +32,8 @@ class LOperand : public ZoneObject {
     STACK_SLOT,
     DOUBLE_STACK_SLOT,
     REGISTER,
-    DOUBLE_REGISTER
+    DOUBLE_REGISTER,
+    TRY_SLOT
   };
 
   LOperand() : value_(KindField::encode(INVALID)) { }
@@ -44,6 +45,7 @@ class LOperand : public ZoneObject {
   LITHIUM_OPERAND_LIST(LITHIUM_OPERAND_PREDICATE)
   LITHIUM_OPERAND_PREDICATE(Unallocated, UNALLOCATED, 0)
   LITHIUM_OPERAND_PREDICATE(Ignored, INVALID, 0)
+  LITHIUM_OPERAND_PREDICATE(TrySlot, TRY_SLOT, 0)
 #undef LITHIUM_OPERAND_PREDICATE
   bool Equals(LOperand* other) const { return value_ == other->value_; }
 
@@ -333,6 +335,44 @@ LITHIUM_OPERAND_LIST(LITHIUM_TYPEDEF_SUBKIND_OPERAND_CLASS)
 #undef LITHIUM_TYPEDEF_SUBKIND_OPERAND_CLASS
 
 
+// A word pushed on top of the spill slots while a try block is active, either
+// a catch slot or a field of the stack handler (see HEnterTry). The stack
+// index counts the pushed words from the spill slots on. Only used in
+// environments, never seen by the register allocator.
+class LTrySlot FINAL : public LOperand {
+ public:
+  static LTrySlot* CatchSlot(int stack_index, Zone* zone) {
+    return new(zone) LTrySlot(stack_index, kCatchSlot);
+  }
+  static LTrySlot* HandlerWord(int stack_index, int field, Zone* zone) {
+    DCHECK(field >= 0 && field < kCatchSlot);
+    return new(zone) LTrySlot(stack_index, field);
+  }
+
+  int stack_index() const { return index() >> kFieldBits; }
+  bool is_handler_word() const { return field() != kCatchSlot; }
+  // The offset of the field in the stack handler.
+  int handler_offset() const {
+    DCHECK(is_handler_word());
+    return field() * kPointerSize;
+  }
+
+  static LTrySlot* cast(LOperand* op) {
+    DCHECK(op->IsTrySlot());
+    return reinterpret_cast<LTrySlot*>(op);
+  }
+
+ private:
+  static const int kFieldBits = 3;
+  static const int kCatchSlot = (1 << kFieldBits) - 1;
+
+  LTrySlot(int stack_index, int field)
+      : LOperand(TRY_SLOT, (stack_index << kFieldBits) | field) { }
+
+  int field() const { return index() & kCatchSlot; }
+};
+
+
 class LParallelMove FINAL : public ZoneObject {
  public:
   explicit LParallelMove(Zone* zone) : move_operands_(4, zone) { }
@@ -424,6 +464,9 @@ class LEnvironment FINAL : public ZoneObject {
   int parameter_count() const { return parameter_count_; }
   int pc_offset() const { return pc_offset_; }
   const ZoneList<LOperand*>* values() const { return &values_; }
+  void ReplaceValueAt(int index, LOperand* operand) {
+    values_[index] = operand;
+  }
   LEnvironment* outer() const { return outer_; }
   HEnterInlined* entry() { return entry_; }
   Zone* zone() const { return zone_; }
@@ -562,7 +605,7 @@ class ShallowIterator FINAL BASE_EMBEDDED {
 
  private:
   bool ShouldSkip(LOperand* op) {
-    return op == NULL || op->IsConstantOperand();
+    return op == NULL || op->IsConstantOperand() || op->IsTrySlot();
   }
 
   // Skip until something interesting, beginning with and including current_.
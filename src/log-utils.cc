@@ -17,6 +17,7 @@ const char* const Log::kLogToConsole = "-";
 
 Log::Log(Logger* logger)
   : is_stopped_(false),
+    is_buffered_(false),
     output_handle_(NULL),
     message_buffer_(NULL),
     logger_(logger) {
@@ -49,6 +50,13 @@ void Log::Initialize(const char* log_file_name) {
     } else {
       OpenFile(log_file_name);
     }
+    // Console output stays unbuffered so that it interleaves with other
+    // output as before.
+    if (FLAG_log_buffered && output_handle_ != NULL &&
+        output_handle_ != stdout) {
+      setvbuf(output_handle_, NULL, _IOFBF, kOutputBufferSize);
+      is_buffered_ = true;
+    }
   }
 }
 
@@ -71,12 +79,19 @@ void Log::OpenFile(const char* name) {
 }
 
 
+void Log::Flush() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (output_handle_ != NULL) fflush(output_handle_);
+}
+
+
 FILE* Log::Close() {
   FILE* result = NULL;
   if (output_handle_ != NULL) {
     if (strcmp(FLAG_logfile, kLogToTemporaryFile) != 0) {
       fclose(output_handle_);
     } else {
+      fflush(output_handle_);
       result = output_handle_;
     }
   }
@@ -86,6 +101,7 @@ FILE* Log::Close() {
   message_buffer_ = NULL;
 
   is_stopped_ = false;
+  is_buffered_ = false;
   return result;
 }
 
@@ -154,7 +170,19 @@ void Log::MessageBuilder::Append(String* str) {
 
 
 void Log::MessageBuilder::AppendAddress(Address addr) {
-  Append("0x%" V8PRIxPTR, addr);
+  // Addresses are the bulk of tick events, so they are formatted by hand
+  // rather than with VSNPrintF. The result is the same as for
+  // "0x%" V8PRIxPTR.
+  char buffer[2 + 2 * sizeof(addr)];
+  uintptr_t value = reinterpret_cast<uintptr_t>(addr);
+  int pos = arraysize(buffer);
+  do {
+    buffer[--pos] = "0123456789abcdef"[value & 0xf];
+    value >>= 4;
+  } while (value != 0);
+  buffer[--pos] = 'x';
+  buffer[--pos] = '0';
+  AppendStringPart(buffer + pos, arraysize(buffer) - pos);
 }
 
 
@@ -25,7 +25,7 @@ class Log {
     return FLAG_log || FLAG_log_api || FLAG_log_code || FLAG_log_gc
         || FLAG_log_handles || FLAG_log_suspect || FLAG_log_regexp
         || FLAG_ll_prof || FLAG_perf_basic_prof || FLAG_perf_jit_prof
-        || FLAG_log_internal_timer_events;
+        || FLAG_log_internal_timer_events || FLAG_log_turbo_phases;
   }
 
   // Frees all resources acquired in Initialize and Open... functions.
@@ -38,9 +38,15 @@ class Log {
     return !is_stopped_ && output_handle_ != NULL;
   }
 
+  // Writes out the buffered part of the log with --log-buffered.
+  void Flush();
+
   // Size of buffer used for formatting log messages.
   static const int kMessageBufferSize = 2048;
 
+  // Size of the file buffer with --log-buffered.
+  static const int kOutputBufferSize = 64 * KB;
+
   // This mode is only used in tests, as temporary files are automatically
   // deleted on close and thus can't be accessed afterwards.
   static const char* const kLogToTemporaryFile;
@@ -107,13 +113,16 @@ class Log {
     size_t rv = fwrite(msg, 1, length, output_handle_);
     DCHECK(static_cast<size_t>(length) == rv);
     USE(rv);
-    fflush(output_handle_);
+    if (!is_buffered_) fflush(output_handle_);
     return length;
   }
 
   // Whether logging is stopped (e.g. due to insufficient resources).
   bool is_stopped_;
 
+  // Whether output_handle_ is only flushed by Flush and Close.
+  bool is_buffered_;
+
   // When logging is active output_handle_ is used to store a pointer to log
   // destination.  mutex_ should be acquired before using output_handle_.
   FILE* output_handle_;
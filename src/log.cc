@@ -751,10 +751,19 @@ void Profiler::Disengage() {
 
 
 void Profiler::Run() {
+  // With --log-buffered the profiler thread, which writes the ticks, also
+  // takes care of flushing the log now and then.
+  const base::TimeDelta kFlushInterval = base::TimeDelta::FromSeconds(1);
+  base::ElapsedTimer flush_timer;
+  flush_timer.Start();
   TickSample sample;
   bool overflow = Remove(&sample);
   while (running_) {
     LOG(isolate_, TickEvent(&sample, overflow));
+    if (FLAG_log_buffered && flush_timer.HasExpired(kFlushInterval)) {
+      isolate_->logger()->log_->Flush();
+      flush_timer.Restart();
+    }
     overflow = Remove(&sample);
   }
 }
@@ -938,6 +947,32 @@ void Logger::TimerEvent(Logger::StartEnd se, const char* name) {
 }
 
 
+void Logger::TurboCompileStartEvent(int id, const char* function_name) {
+  if (!log_->IsEnabled() || !FLAG_log_turbo_phases) return;
+  Log::MessageBuilder msg(log_);
+  msg.Append("turbo-compile-start,%d,\"%s\"", id, function_name);
+  msg.WriteToLogFile();
+}
+
+
+void Logger::TurboPhaseEvent(int id, const char* phase, double ms,
+                             size_t bytes) {
+  if (!log_->IsEnabled() || !FLAG_log_turbo_phases) return;
+  Log::MessageBuilder msg(log_);
+  msg.Append("turbo-phase,%d,\"%s\",%.3f,%d", id, phase, ms,
+             static_cast<int>(bytes));
+  msg.WriteToLogFile();
+}
+
+
+void Logger::TurboCompileEndEvent(int id, size_t zone_bytes) {
+  if (!log_->IsEnabled() || !FLAG_log_turbo_phases) return;
+  Log::MessageBuilder msg(log_);
+  msg.Append("turbo-compile-end,%d,%d", id, static_cast<int>(zone_bytes));
+  msg.WriteToLogFile();
+}
+
+
 void Logger::EnterExternal(Isolate* isolate) {
   LOG(isolate, TimerEvent(START, TimerEventExternal::name()));
   DCHECK(isolate->current_vm_state() == JS);
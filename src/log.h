@@ -297,6 +297,13 @@ class Logger {
 
   void TimerEvent(StartEnd se, const char* name);
 
+  // Emits the events of a TurboFan compilation with --log-turbo-phases: its
+  // start, the time in milliseconds and the zone memory of every phase, and
+  // its end with the final size of the compilation zone.
+  void TurboCompileStartEvent(int id, const char* function_name);
+  void TurboPhaseEvent(int id, const char* phase, double ms, size_t bytes);
+  void TurboCompileEndEvent(int id, size_t zone_bytes);
+
   static void EnterExternal(Isolate* isolate);
   static void LeaveExternal(Isolate* isolate);
 
@@ -42,35 +42,17 @@ LookupIterator::State LookupIterator::LookupInHolder(Map* map,
     // Fall through.
     case ACCESS_CHECK:
       if (check_interceptor() && map->has_named_interceptor()) {
-        return INTERCEPTOR;
+        // A non-masking interceptor is only consulted for names that are not
+        // properties of the holder itself.
+        if (!JSObject::cast(holder)->GetNamedInterceptor()->non_masking()) {
+          return INTERCEPTOR;
+        }
+        State state = LookupPropertyInHolder(map, holder);
+        return state == NOT_FOUND ? INTERCEPTOR : state;
       }
     // Fall through.
     case INTERCEPTOR:
-      if (map->is_dictionary_map()) {
-        NameDictionary* dict = JSObject::cast(holder)->property_dictionary();
-        number_ = dict->FindEntry(name_);
-        if (number_ == NameDictionary::kNotFound) return NOT_FOUND;
-        property_details_ = dict->DetailsAt(number_);
-        if (holder->IsGlobalObject()) {
-          if (property_details_.IsDeleted()) return NOT_FOUND;
-          PropertyCell* cell = PropertyCell::cast(dict->ValueAt(number_));
-          if (cell->value()->IsTheHole()) return NOT_FOUND;
-        }
-      } else {
-        DescriptorArray* descriptors = map->instance_descriptors();
-        number_ = descriptors->SearchWithCache(*name_, map);
-        if (number_ == DescriptorArray::kNotFound) return NOT_FOUND;
-        property_details_ = descriptors->GetDetails(number_);
-      }
-      has_property_ = true;
-      switch (property_details_.type()) {
-        case v8::internal::CONSTANT:
-        case v8::internal::FIELD:
-        case v8::internal::NORMAL:
-          return DATA;
-        case v8::internal::CALLBACKS:
-          return ACCESSOR;
-      }
+      return LookupPropertyInHolder(map, holder);
     case ACCESSOR:
     case DATA:
       return NOT_FOUND;
@@ -81,6 +63,39 @@ LookupIterator::State LookupIterator::LookupInHolder(Map* map,
   UNREACHABLE();
   return state_;
 }
+
+
+LookupIterator::State LookupIterator::LookupPropertyInHolder(
+    Map* map, JSReceiver* holder) {
+  DisallowHeapAllocation no_gc;
+  if (map->is_dictionary_map()) {
+    NameDictionary* dict = JSObject::cast(holder)->property_dictionary();
+    number_ = dict->FindEntry(name_);
+    if (number_ == NameDictionary::kNotFound) return NOT_FOUND;
+    property_details_ = dict->DetailsAt(number_);
+    if (holder->IsGlobalObject()) {
+      if (property_details_.IsDeleted()) return NOT_FOUND;
+      PropertyCell* cell = PropertyCell::cast(dict->ValueAt(number_));
+      if (cell->value()->IsTheHole()) return NOT_FOUND;
+    }
+  } else {
+    DescriptorArray* descriptors = map->instance_descriptors();
+    number_ = descriptors->SearchWithCache(*name_, map);
+    if (number_ == DescriptorArray::kNotFound) return NOT_FOUND;
+    property_details_ = descriptors->GetDetails(number_);
+  }
+  has_property_ = true;
+  switch (property_details_.type()) {
+    case v8::internal::CONSTANT:
+    case v8::internal::FIELD:
+    case v8::internal::NORMAL:
+      return DATA;
+    case v8::internal::CALLBACKS:
+      return ACCESSOR;
+  }
+  UNREACHABLE();
+  return state_;
+}
 }
 }  // namespace v8::internal
 
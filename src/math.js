@@ -29,28 +29,6 @@ function MathAbs(x) {
   return x > 0 ? x : -x;
 }
 
-// ECMA 262 - 15.8.2.2
-function MathAcosJS(x) {
-  return %MathAcos(TO_NUMBER_INLINE(x));
-}
-
-// ECMA 262 - 15.8.2.3
-function MathAsinJS(x) {
-  return %MathAsin(TO_NUMBER_INLINE(x));
-}
-
-// ECMA 262 - 15.8.2.4
-function MathAtanJS(x) {
-  return %MathAtan(TO_NUMBER_INLINE(x));
-}
-
-// ECMA 262 - 15.8.2.5
-// The naming of y and x matches the spec, as does the order in which
-// ToNumber (valueOf) is called.
-function MathAtan2JS(y, x) {
-  return %MathAtan2(TO_NUMBER_INLINE(y), TO_NUMBER_INLINE(x));
-}
-
 // ECMA 262 - 15.8.2.6
 function MathCeil(x) {
   return -MathFloor(-x);
@@ -342,9 +320,9 @@ function SetUpMath() {
   InstallFunctions($Math, DONT_ENUM, $Array(
     "random", MathRandom,
     "abs", MathAbs,
-    "acos", MathAcosJS,
-    "asin", MathAsinJS,
-    "atan", MathAtanJS,
+    "acos", MathAcos,     // implemented by third_party/fdlibm
+    "asin", MathAsin,     // implemented by third_party/fdlibm
+    "atan", MathAtan,     // implemented by third_party/fdlibm
     "ceil", MathCeil,
     "cos", MathCos,       // implemented by third_party/fdlibm
     "exp", MathExp,
@@ -354,7 +332,7 @@ function SetUpMath() {
     "sin", MathSin,       // implemented by third_party/fdlibm
     "sqrt", MathSqrt,
     "tan", MathTan,       // implemented by third_party/fdlibm
-    "atan2", MathAtan2JS,
+    "atan2", MathAtan2,   // implemented by third_party/fdlibm
     "pow", MathPow,
     "max", MathMax,
     "min", MathMin,
@@ -381,6 +359,11 @@ function SetUpMath() {
   %SetInlineBuiltinFlag(MathRandom);
   %SetInlineBuiltinFlag(MathSin);
   %SetInlineBuiltinFlag(MathCos);
+  %SetInlineBuiltinFlag(MathTan);
+  %SetInlineBuiltinFlag(MathAsin);
+  %SetInlineBuiltinFlag(MathAcos);
+  %SetInlineBuiltinFlag(MathAtan);
+  %SetInlineBuiltinFlag(MathAtan2);
 }
 
 SetUpMath();
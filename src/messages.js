@@ -11,6 +11,8 @@ var kMessages = {
   constructor_special_method:    ["Class constructor may not be an accessor"],
   generator_running:             ["Generator is already running"],
   generator_finished:            ["Generator has already finished"],
+  data_clone_error:              ["%0", " could not be cloned."],
+  data_clone_deserialization_error: ["Unable to deserialize cloned data."],
   // TypeError
   unexpected_token:              ["Unexpected token ", "%0"],
   unexpected_token_number:       ["Unexpected number"],
@@ -87,6 +89,8 @@ var kMessages = {
   not_typed_array:               ["this is not a typed array."],
   invalid_argument:              ["invalid_argument"],
   data_view_not_array_buffer:    ["First argument to DataView constructor must be an ArrayBuffer"],
+  atomics_not_shared_int32_array: ["%0", " is not an Int32Array or Uint32Array on a SharedArrayBuffer"],
+  simd_wrong_type:               ["%0", " is not a ", "%1"],
   constructor_not_function:      ["Constructor ", "%0", " requires 'new'"],
   not_a_symbol:                  ["%0", " is not a symbol"],
   not_a_promise:                 ["%0", " is not a promise"],
@@ -105,6 +109,9 @@ var kMessages = {
   invalid_string_length:         ["Invalid string length"],
   invalid_typed_array_offset:    ["Start offset is too large:"],
   invalid_typed_array_length:    ["Invalid typed array length"],
+  invalid_atomic_access_index:   ["Invalid atomic access index"],
+  invalid_simd_lane:             ["Invalid SIMD lane index"],
+  invalid_simd_access_index:     ["Invalid SIMD access index"],
   invalid_typed_array_alignment: ["%0", " of ", "%1", " should be a multiple of ", "%2"],
   typed_array_set_source_too_large:
                                  ["Source is too large"],
@@ -116,6 +123,7 @@ var kMessages = {
                                  ["Offset is outside the bounds of the DataView"],
 
   stack_overflow:                ["Maximum call stack size exceeded"],
+  regexp_backtrack_limit:        ["Maximum regular expression backtracking exceeded"],
   invalid_time_value:            ["Invalid time value"],
   invalid_count_value:           ["Invalid count value"],
   invalid_code_point:            ["Invalid code point ", "%0"],
@@ -3897,6 +3897,9 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ mov(a1, result_register());
   ParameterCount count(arg_count);
   __ InvokeFunction(a1, count, CALL_FUNCTION, NullCallWrapper());
+  // The return site of an inlined target, see
+  // HOptimizedGraphBuilder::GenerateCallFunction.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
   __ ld(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
@@ -4721,6 +4724,13 @@ void FullCodeGenerator::EmitLiteralCompareTypeof(Expression* expr,
     __ JumpIfSmi(v0, if_false);
     __ GetObjectType(v0, v0, a1);
     Split(eq, a1, Operand(SYMBOL_TYPE), if_true, if_false, fall_through);
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)   \
+  } else if (String::Equals(check, factory->type##_string())) { \
+    __ JumpIfSmi(v0, if_false);                                 \
+    __ GetObjectType(v0, v0, a1);                               \
+    Split(eq, a1, Operand(TYPE##_TYPE), if_true, if_false, fall_through);
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
   } else if (String::Equals(check, factory->boolean_string())) {
     __ LoadRoot(at, Heap::kTrueValueRootIndex);
     __ Branch(if_true, eq, v0, Operand(at));
@@ -19,6 +19,7 @@
 #include "src/list.h"
 #include "src/natives.h"
 #include "src/serialize.h"
+#include "src/snapshot.h"
 
 
 using namespace v8;
@@ -81,28 +82,12 @@ class SnapshotWriter {
     if (!startup_blob_file_)
       return;
 
-    i::List<i::byte> startup_blob;
-    i::ListSnapshotSink sink(&startup_blob);
-
-    int spaces[] = {i::NEW_SPACE,           i::OLD_POINTER_SPACE,
-                    i::OLD_DATA_SPACE,      i::CODE_SPACE,
-                    i::MAP_SPACE,           i::CELL_SPACE,
-                    i::PROPERTY_CELL_SPACE, i::LO_SPACE};
-
-    i::byte* snapshot_bytes = snapshot_data.begin();
-    sink.PutBlob(snapshot_bytes, snapshot_data.length(), "snapshot");
-    for (size_t i = 0; i < arraysize(spaces); ++i)
-      sink.PutInt(serializer.CurrentAllocationAddress(spaces[i]), "spaces");
-
-    i::byte* context_bytes = context_snapshot_data.begin();
-    sink.PutBlob(context_bytes, context_snapshot_data.length(), "context");
-    for (size_t i = 0; i < arraysize(spaces); ++i)
-      sink.PutInt(context_serializer.CurrentAllocationAddress(spaces[i]),
-                  "spaces");
-
-    size_t written = fwrite(startup_blob.begin(), 1, startup_blob.length(),
+    v8::StartupData startup_blob = i::CreateSnapshotBlob(
+        snapshot_data, serializer, context_snapshot_data, context_serializer);
+    size_t written = fwrite(startup_blob.data, 1, startup_blob.raw_size,
                             startup_blob_file_);
-    if (written != (size_t)startup_blob.length()) {
+    i::DeleteArray(startup_blob.data);
+    if (written != static_cast<size_t>(startup_blob.raw_size)) {
       i::PrintF("Writing snapshot file failed.. Aborting.\n");
       exit(1);
     }
@@ -303,6 +288,36 @@ void DumpException(Handle<Message> message) {
 }
 
 
+// Resets natives functions that were compiled while bootstrapping the
+// snapshot to the lazy compile builtin. Isolates created from the snapshot
+// then compile only the natives they actually call, from the natives source,
+// instead of deserializing code for all of them.
+static void FlushNativesCode(i::Isolate* isolate) {
+  i::Code* lazy = isolate->builtins()->builtin(i::Builtins::kCompileLazy);
+  i::HeapIterator iterator(isolate->heap());
+  for (i::HeapObject* obj = iterator.next(); obj != NULL;
+       obj = iterator.next()) {
+    if (!obj->IsJSFunction()) continue;
+    i::JSFunction* function = i::JSFunction::cast(obj);
+    i::SharedFunctionInfo* shared = function->shared();
+    if (function->code()->kind() != i::Code::FUNCTION) continue;
+    if (!shared->script()->IsScript() ||
+        i::Script::cast(shared->script())->type()->value() !=
+            i::Script::TYPE_NATIVE) {
+      continue;
+    }
+    if (shared->code() == function->code() &&
+        shared->allows_lazy_compilation() && !shared->is_toplevel() &&
+        !shared->is_generator() && !shared->dont_flush() &&
+        !shared->function_data()->IsFunctionTemplateInfo()) {
+      shared->set_code(lazy);
+    }
+    // Other closures of an already flushed function follow.
+    if (shared->code() == lazy) function->set_code(lazy);
+  }
+}
+
+
 int main(int argc, char** argv) {
   // By default, log code create information in the snapshot.
   i::FLAG_log_code = true;
@@ -397,6 +412,7 @@ int main(int argc, char** argv) {
         internal_isolate->bootstrapper()->NativesSourceLookup(i);
       }
     }
+    if (i::FLAG_lazy_natives_in_snapshot) FlushNativesCode(internal_isolate);
     // If we don't do this then we end up with a stray root pointing at the
     // context even after we have disposed of the context.
     internal_isolate->heap()->CollectAllGarbage(
@@ -200,6 +200,7 @@ function ObjectInfoGetOrCreate(object) {
     objectInfo = {
       object: object,
       changeObservers: null,
+      acceptTypes: null,
       notifier: null,
       performing: null,
       performingCount: 0,
@@ -253,6 +254,7 @@ function ObjectInfoNormalizeChangeObservers(objectInfo) {
 function ObjectInfoAddObserver(objectInfo, callback, acceptList) {
   var callbackInfo = CallbackInfoGetOrCreate(callback);
   var observer = ObserverCreate(callback, acceptList);
+  objectInfo.acceptTypes = null;
 
   if (!objectInfo.changeObservers) {
     objectInfo.changeObservers = observer;
@@ -268,6 +270,8 @@ function ObjectInfoRemoveObserver(objectInfo, callback) {
   if (!objectInfo.changeObservers)
     return;
 
+  objectInfo.acceptTypes = null;
+
   if (ChangeObserversIsOptimized(objectInfo.changeObservers)) {
     if (callback === ObserverGetCallback(objectInfo.changeObservers))
       objectInfo.changeObservers = null;
@@ -295,6 +299,38 @@ function ObjectInfoHasActiveObservers(objectInfo) {
   return false;
 }
 
+// The union of the accept types of all observers of an object. Changes of
+// other types are dropped before their change record is allocated. It is
+// computed when needed and reset whenever an observer is added or removed.
+function ObjectInfoGetAcceptTypes(objectInfo) {
+  if (!IS_NULL(objectInfo.acceptTypes))
+    return objectInfo.acceptTypes;
+
+  var changeObservers = objectInfo.changeObservers;
+  var acceptTypes;
+  if (ChangeObserversIsOptimized(changeObservers)) {
+    acceptTypes = ObserverGetAcceptTypes(changeObservers);
+  } else {
+    acceptTypes = TypeMapCreate();
+    for (var priority in changeObservers) {
+      var observer = changeObservers[priority];
+      if (IS_NULL(observer)) continue;
+      var observerTypes = ObserverGetAcceptTypes(observer);
+      for (var type in observerTypes) {
+        if (TypeMapHasType(observerTypes, type))
+          TypeMapAddType(acceptTypes, type, true);
+      }
+    }
+  }
+  objectInfo.acceptTypes = acceptTypes;
+  return acceptTypes;
+}
+
+function ObjectInfoHasActiveObserversForType(objectInfo, type) {
+  return ObjectInfoHasActiveObservers(objectInfo) &&
+         TypeMapHasType(ObjectInfoGetAcceptTypes(objectInfo), type);
+}
+
 function ObjectInfoAddPerformingType(objectInfo, type) {
   objectInfo.performing = objectInfo.performing || TypeMapCreate();
   TypeMapAddType(objectInfo.performing, type);
@@ -326,7 +362,8 @@ function ConvertAcceptListToTypeMap(arg) {
 
 // CallbackInfo's optimized state is just a number which represents its global
 // priority. When a change record must be enqueued for the callback, it
-// normalizes. When delivery clears any pending change records, it re-optimizes.
+// normalizes. Delivery empties the list of pending change records but keeps
+// it, so that later changes do not allocate a new one.
 function CallbackInfoGet(callback) {
   return GetCallbackInfoMap().get(callback);
 }
@@ -490,7 +527,7 @@ function EndPerformSplice(array) {
 
 function EnqueueSpliceRecord(array, index, removed, addedCount) {
   var objectInfo = ObjectInfoGet(array);
-  if (!ObjectInfoHasActiveObservers(objectInfo))
+  if (!ObjectInfoHasActiveObserversForType(objectInfo, 'splice'))
     return;
 
   var changeRecord = {
@@ -508,7 +545,7 @@ function EnqueueSpliceRecord(array, index, removed, addedCount) {
 
 function NotifyChange(type, object, name, oldValue) {
   var objectInfo = ObjectInfoGet(object);
-  if (!ObjectInfoHasActiveObservers(objectInfo))
+  if (!ObjectInfoHasActiveObserversForType(objectInfo, type))
     return;
 
   var changeRecord;
@@ -595,14 +632,14 @@ function NativeObjectGetNotifier(object) {
 
 function CallbackDeliverPending(callback) {
   var callbackInfo = GetCallbackInfoMap().get(callback);
-  if (IS_UNDEFINED(callbackInfo) || IS_NUMBER(callbackInfo))
+  if (IS_UNDEFINED(callbackInfo) || IS_NUMBER(callbackInfo) ||
+      callbackInfo.length == 0) {
     return false;
+  }
 
-  // Clear the pending change records from callback and return it to its
-  // "optimized" state.
+  // Move the pending change records out of the list, which stays with the
+  // callback for the next changes.
   var priority = callbackInfo.priority;
-  GetCallbackInfoMap().set(callback, priority);
-
   if (GetPendingObservers())
     delete GetPendingObservers()[priority];
 
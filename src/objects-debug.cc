@@ -58,6 +58,11 @@ void HeapObject::HeapObjectVerify() {
     case MUTABLE_HEAP_NUMBER_TYPE:
       HeapNumber::cast(this)->HeapNumberVerify();
       break;
+    case FLOAT32X4_TYPE:
+    case INT32X4_TYPE:
+    case FLOAT64X2_TYPE:
+      Simd128Value::cast(this)->Simd128ValueVerify();
+      break;
     case FIXED_ARRAY_TYPE:
       FixedArray::cast(this)->FixedArrayVerify();
       break;
@@ -211,6 +216,11 @@ void HeapNumber::HeapNumberVerify() {
 }
 
 
+void Simd128Value::Simd128ValueVerify() {
+  CHECK(IsSimd128Value());
+}
+
+
 void ByteArray::ByteArrayVerify() {
   CHECK(IsByteArray());
 }
@@ -264,6 +274,10 @@ void JSObject::JSObjectVerify() {
       if (descriptors->GetDetails(i).type() == FIELD) {
         Representation r = descriptors->GetDetails(i).representation();
         FieldIndex index = FieldIndex::ForDescriptor(map(), i);
+        if (index.is_unboxed_double()) {
+          DCHECK(r.IsDouble());
+          continue;
+        }
         Object* value = RawFastPropertyAt(index);
         if (r.IsDouble()) DCHECK(value->IsMutableHeapNumber());
         if (value->IsUninitialized()) continue;
@@ -403,6 +417,7 @@ void JSGeneratorObject::JSGeneratorObjectVerify() {
   VerifyObjectField(kOperandStackOffset);
   VerifyObjectField(kContinuationOffset);
   VerifyObjectField(kStackHandlerIndexOffset);
+  VerifyObjectField(kSpareOperandStackOffset);
 }
 
 
@@ -773,6 +788,9 @@ void JSRegExp::JSRegExpVerify() {
 
       CHECK(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
       CHECK(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
+      Object* nfa_program = arr->get(JSRegExp::kIrregexpNfaProgramIndex);
+      CHECK(nfa_program->IsSmi() || nfa_program->IsByteArray());
+      CHECK(arr->get(JSRegExp::kIrregexpLeadingCharacterIndex)->IsSmi());
       break;
     }
     default:
@@ -904,6 +922,7 @@ void InterceptorInfo::InterceptorInfoVerify() {
   VerifyPointer(deleter());
   VerifyPointer(enumerator());
   VerifyPointer(data());
+  VerifySmiField(kFlagOffset);
 }
 
 
@@ -933,6 +952,8 @@ void FunctionTemplateInfo::FunctionTemplateInfoVerify() {
   VerifyPointer(instance_template());
   VerifyPointer(signature());
   VerifyPointer(access_check_info());
+  VerifyPointer(fast_call_handler());
+  CHECK(fast_call_handler()->IsUndefined() || fast_call_signature()->IsSmi());
 }
 
 
@@ -979,6 +1000,8 @@ void Script::ScriptVerify() {
   type()->SmiVerify();
   VerifyPointer(line_ends());
   VerifyPointer(id());
+  VerifyPointer(pretenuring_hints());
+  VerifyPointer(tiering_hints());
 }
 
 
@@ -169,6 +169,9 @@ bool Object::IsHeapObject() const {
 
 TYPE_CHECKER(HeapNumber, HEAP_NUMBER_TYPE)
 TYPE_CHECKER(MutableHeapNumber, MUTABLE_HEAP_NUMBER_TYPE)
+TYPE_CHECKER(Float32x4, FLOAT32X4_TYPE)
+TYPE_CHECKER(Int32x4, INT32X4_TYPE)
+TYPE_CHECKER(Float64x2, FLOAT64X2_TYPE)
 TYPE_CHECKER(Symbol, SYMBOL_TYPE)
 
 
@@ -632,6 +635,15 @@ bool Object::IsFiller() const {
 }
 
 
+bool Object::IsSimd128Value() const {
+  if (!Object::IsHeapObject()) return false;
+  InstanceType instance_type =
+      HeapObject::cast(this)->map()->instance_type();
+  return (instance_type >= FIRST_SIMD128_VALUE_TYPE &&
+          instance_type <= LAST_SIMD128_VALUE_TYPE);
+}
+
+
 bool Object::IsExternalArray() const {
   if (!Object::IsHeapObject())
     return false;
@@ -1294,6 +1306,12 @@ Maybe<bool> JSProxy::HasElementWithHandler(Handle<JSProxy> proxy,
 #define WRITE_INT32_FIELD(p, offset, value) \
   (*reinterpret_cast<int32_t*>(FIELD_ADDR(p, offset)) = value)
 
+#define READ_FLOAT_FIELD(p, offset) \
+  (*reinterpret_cast<const float*>(FIELD_ADDR_CONST(p, offset)))
+
+#define WRITE_FLOAT_FIELD(p, offset, value) \
+  (*reinterpret_cast<float*>(FIELD_ADDR(p, offset)) = value)
+
 #define READ_INT64_FIELD(p, offset) \
   (*reinterpret_cast<const int64_t*>(FIELD_ADDR_CONST(p, offset)))
 
@@ -1546,6 +1564,52 @@ int HeapNumber::get_sign() {
 }
 
 
+uint32_t Simd128Value::Hash() const {
+  uint32_t hash = 0;
+  for (int offset = 0; offset < kSimd128Size; offset += kInt32Size) {
+    hash = ComputeIntegerHash(
+        READ_UINT32_FIELD(this, kValueOffset + offset) ^ hash, 0);
+  }
+  return hash;
+}
+
+
+float Float32x4::get_lane(int lane) const {
+  DCHECK(lane >= 0 && lane < kLanes);
+  return READ_FLOAT_FIELD(this, kValueOffset + lane * kFloatSize);
+}
+
+
+void Float32x4::set_lane(int lane, float value) {
+  DCHECK(lane >= 0 && lane < kLanes);
+  WRITE_FLOAT_FIELD(this, kValueOffset + lane * kFloatSize, value);
+}
+
+
+int32_t Int32x4::get_lane(int lane) const {
+  DCHECK(lane >= 0 && lane < kLanes);
+  return READ_INT32_FIELD(this, kValueOffset + lane * kInt32Size);
+}
+
+
+void Int32x4::set_lane(int lane, int32_t value) {
+  DCHECK(lane >= 0 && lane < kLanes);
+  WRITE_INT32_FIELD(this, kValueOffset + lane * kInt32Size, value);
+}
+
+
+double Float64x2::get_lane(int lane) const {
+  DCHECK(lane >= 0 && lane < kLanes);
+  return READ_DOUBLE_FIELD(this, kValueOffset + lane * kDoubleSize);
+}
+
+
+void Float64x2::set_lane(int lane, double value) {
+  DCHECK(lane >= 0 && lane < kLanes);
+  WRITE_DOUBLE_FIELD(this, kValueOffset + lane * kDoubleSize, value);
+}
+
+
 ACCESSORS(JSObject, properties, FixedArray, kPropertiesOffset)
 
 
@@ -2036,6 +2100,7 @@ void JSObject::SetInternalField(int index, Smi* value) {
 // is needed to correctly distinguish between properties stored in-object and
 // properties stored in the properties array.
 Object* JSObject::RawFastPropertyAt(FieldIndex index) {
+  DCHECK(!IsUnboxedDoubleField(index));
   if (index.is_inobject()) {
     return READ_FIELD(this, index.offset());
   } else {
@@ -2044,7 +2109,9 @@ Object* JSObject::RawFastPropertyAt(FieldIndex index) {
 }
 
 
-void JSObject::FastPropertyAtPut(FieldIndex index, Object* value) {
+// The raw setters do not look at the layout of the current map, which lets
+// migrations fill in the fields of an instance before they install its map.
+void JSObject::RawFastPropertyAtPut(FieldIndex index, Object* value) {
   if (index.is_inobject()) {
     int offset = index.offset();
     WRITE_FIELD(this, offset, value);
@@ -2055,6 +2122,37 @@ void JSObject::FastPropertyAtPut(FieldIndex index, Object* value) {
 }
 
 
+// Unlike the raw accessors this one also accepts unboxed double fields, the
+// number is stored unboxed in that case, no matter if |value| is a box.
+void JSObject::FastPropertyAtPut(FieldIndex index, Object* value) {
+  if (IsUnboxedDoubleField(index)) {
+    double number = value->IsMutableHeapNumber()
+                        ? HeapNumber::cast(value)->value()
+                        : value->Number();
+    RawFastDoublePropertyAtPut(index, number);
+  } else {
+    RawFastPropertyAtPut(index, value);
+  }
+}
+
+
+bool JSObject::IsUnboxedDoubleField(FieldIndex index) {
+  return map()->IsUnboxedDoubleField(index);
+}
+
+
+double JSObject::RawFastDoublePropertyAt(FieldIndex index) {
+  DCHECK(IsUnboxedDoubleField(index));
+  return READ_DOUBLE_FIELD(this, index.offset());
+}
+
+
+void JSObject::RawFastDoublePropertyAtPut(FieldIndex index, double value) {
+  DCHECK(index.is_inobject());
+  WRITE_DOUBLE_FIELD(this, index.offset(), value);
+}
+
+
 int JSObject::GetInObjectPropertyOffset(int index) {
   return map()->GetInObjectPropertyOffset(index);
 }
@@ -2869,8 +2967,11 @@ int DescriptorArray::SearchWithCache(Name* name, Map* map) {
   int number = cache->Lookup(map, name);
 
   if (number == DescriptorLookupCache::kAbsent) {
+    GetIsolate()->counters()->descriptor_lookup_cache_misses()->Increment();
     number = Search(name, number_of_own_descriptors);
     cache->Update(map, name, number);
+  } else {
+    GetIsolate()->counters()->descriptor_lookup_cache_hits()->Increment();
   }
 
   return number;
@@ -3198,10 +3299,13 @@ CAST_ACCESSOR(FixedArray)
 CAST_ACCESSOR(FixedArrayBase)
 CAST_ACCESSOR(FixedDoubleArray)
 CAST_ACCESSOR(FixedTypedArrayBase)
+CAST_ACCESSOR(Float32x4)
+CAST_ACCESSOR(Float64x2)
 CAST_ACCESSOR(Foreign)
 CAST_ACCESSOR(FreeSpace)
 CAST_ACCESSOR(GlobalObject)
 CAST_ACCESSOR(HeapObject)
+CAST_ACCESSOR(Int32x4)
 CAST_ACCESSOR(JSArray)
 CAST_ACCESSOR(JSArrayBuffer)
 CAST_ACCESSOR(JSArrayBufferView)
@@ -3246,6 +3350,7 @@ CAST_ACCESSOR(SeqOneByteString)
 CAST_ACCESSOR(SeqString)
 CAST_ACCESSOR(SeqTwoByteString)
 CAST_ACCESSOR(SharedFunctionInfo)
+CAST_ACCESSOR(Simd128Value)
 CAST_ACCESSOR(SlicedString)
 CAST_ACCESSOR(Smi)
 CAST_ACCESSOR(String)
@@ -4773,6 +4878,21 @@ void Code::set_compiled_optimizable(bool value) {
 }
 
 
+bool Code::hot_in_previous_run() {
+  DCHECK_EQ(FUNCTION, kind());
+  byte flags = READ_BYTE_FIELD(this, kFullCodeFlags);
+  return FullCodeFlagsHotInPreviousRunField::decode(flags);
+}
+
+
+void Code::set_hot_in_previous_run(bool value) {
+  DCHECK_EQ(FUNCTION, kind());
+  byte flags = READ_BYTE_FIELD(this, kFullCodeFlags);
+  flags = FullCodeFlagsHotInPreviousRunField::update(flags, value);
+  WRITE_BYTE_FIELD(this, kFullCodeFlags, flags);
+}
+
+
 int Code::allow_osr_at_loop_nesting_level() {
   DCHECK_EQ(FUNCTION, kind());
   int fields = READ_UINT32_FIELD(this, kKindSpecificFlags2Offset);
@@ -4871,7 +4991,7 @@ bool Code::back_edges_patched_for_osr() {
 }
 
 
-byte Code::to_boolean_state() {
+uint16_t Code::to_boolean_state() {
   return extra_ic_state();
 }
 
@@ -5170,6 +5290,17 @@ bool Map::HasTransitionArray() const {
 }
 
 
+void Map::RemoveEmptyTransitionArray() {
+  TransitionArray* transitions = this->transitions();
+  DCHECK(transitions->number_of_transitions() == 0);
+  DCHECK(!transitions->HasPrototypeTransitions());
+  // The back pointer is a map or undefined, neither of which is moved by the
+  // collector, so the slot does not need to be recorded.
+  WRITE_FIELD(this, kTransitionsOrBackPointerOffset,
+              transitions->back_pointer_storage());
+}
+
+
 Map* Map::elements_transition_map() {
   int index = transitions()->Search(GetHeap()->elements_transition_symbol());
   return transitions()->GetTarget(index);
@@ -5284,6 +5415,63 @@ ACCESSORS(Map, code_cache, Object, kCodeCacheOffset)
 ACCESSORS(Map, dependent_code, DependentCode, kDependentCodeOffset)
 ACCESSORS(Map, constructor, Object, kConstructorOffset)
 
+
+int Map::unboxed_double_fields() {
+#if V8_DOUBLE_FIELDS_UNBOXING
+  return Smi::cast(READ_FIELD(this, kUnboxedDoubleFieldsOffset))->value();
+#else
+  return 0;
+#endif
+}
+
+
+void Map::set_unboxed_double_fields(int value) {
+#if V8_DOUBLE_FIELDS_UNBOXING
+  DCHECK(value >= 0 && value < (1 << kMaxUnboxedDoubleFields));
+  WRITE_FIELD(this, kUnboxedDoubleFieldsOffset, Smi::FromInt(value));
+#else
+  DCHECK_EQ(0, value);
+#endif
+}
+
+
+bool Map::HasUnboxedDoubleFields() {
+  return V8_DOUBLE_FIELDS_UNBOXING && unboxed_double_fields() != 0;
+}
+
+
+bool Map::IsUnboxedDoubleInObjectProperty(int index) {
+  if (index < 0 || index >= kMaxUnboxedDoubleFields) return false;
+  return (unboxed_double_fields() & (1 << index)) != 0;
+}
+
+
+bool Map::IsUnboxedDoubleFieldOffset(int offset) {
+  if (!HasUnboxedDoubleFields()) return false;
+  int first_offset = GetInObjectPropertyOffset(0);
+  if (offset < first_offset) return false;
+  return IsUnboxedDoubleInObjectProperty((offset - first_offset) /
+                                         kPointerSize);
+}
+
+
+bool Map::IsUnboxedDoubleField(FieldIndex index) {
+  if (!index.is_inobject()) return false;
+  return IsUnboxedDoubleFieldOffset(index.offset());
+}
+
+
+bool Map::IsTaggedRun(int offset, int end_offset, int* run_end) {
+  DCHECK(offset < end_offset);
+  bool tagged = !IsUnboxedDoubleFieldOffset(offset);
+  int end = offset + kPointerSize;
+  while (end < end_offset && IsUnboxedDoubleFieldOffset(end) != tagged) {
+    end += kPointerSize;
+  }
+  *run_end = end;
+  return tagged;
+}
+
 ACCESSORS(JSFunction, shared, SharedFunctionInfo, kSharedFunctionInfoOffset)
 ACCESSORS(JSFunction, literals_or_bindings, FixedArray, kLiteralsOffset)
 ACCESSORS(JSFunction, next_function_link, Object, kNextFunctionLinkOffset)
@@ -5326,6 +5514,7 @@ ACCESSORS(InterceptorInfo, query, Object, kQueryOffset)
 ACCESSORS(InterceptorInfo, deleter, Object, kDeleterOffset)
 ACCESSORS(InterceptorInfo, enumerator, Object, kEnumeratorOffset)
 ACCESSORS(InterceptorInfo, data, Object, kDataOffset)
+ACCESSORS_TO_SMI(InterceptorInfo, flag, kFlagOffset)
 
 ACCESSORS(CallHandlerInfo, callback, Object, kCallbackOffset)
 ACCESSORS(CallHandlerInfo, data, Object, kDataOffset)
@@ -5352,6 +5541,10 @@ ACCESSORS(FunctionTemplateInfo, instance_call_handler, Object,
 ACCESSORS(FunctionTemplateInfo, access_check_info, Object,
           kAccessCheckInfoOffset)
 ACCESSORS_TO_SMI(FunctionTemplateInfo, flag, kFlagOffset)
+ACCESSORS(FunctionTemplateInfo, fast_call_handler, Object,
+          kFastCallHandlerOffset)
+ACCESSORS(FunctionTemplateInfo, fast_call_signature, Object,
+          kFastCallSignatureOffset)
 
 ACCESSORS(ObjectTemplateInfo, constructor, Object, kConstructorOffset)
 ACCESSORS(ObjectTemplateInfo, internal_field_count, Object,
@@ -5388,6 +5581,8 @@ ACCESSORS_TO_SMI(Script, flags, kFlagsOffset)
 BOOL_ACCESSORS(Script, flags, is_shared_cross_origin, kIsSharedCrossOriginBit)
 ACCESSORS(Script, source_url, Object, kSourceUrlOffset)
 ACCESSORS(Script, source_mapping_url, Object, kSourceMappingUrlOffset)
+ACCESSORS(Script, pretenuring_hints, Object, kPretenuringHintsOffset)
+ACCESSORS(Script, tiering_hints, Object, kTieringHintsOffset)
 
 Script::CompilationType Script::compilation_type() {
   return BooleanBit::get(flags(), kCompilationTypeBit) ?
@@ -5443,6 +5638,7 @@ BOOL_ACCESSORS(FunctionTemplateInfo, flag, remove_prototype,
                kRemovePrototypeBit)
 BOOL_ACCESSORS(FunctionTemplateInfo, flag, do_not_cache,
                kDoNotCacheBit)
+BOOL_ACCESSORS(InterceptorInfo, flag, non_masking, kNonMaskingBit)
 BOOL_ACCESSORS(SharedFunctionInfo, start_position_and_type, is_expression,
                kIsExpressionBit)
 BOOL_ACCESSORS(SharedFunctionInfo, start_position_and_type, is_toplevel,
@@ -5610,6 +5806,9 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_anonymous, kIsAnonymous)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_function, kIsFunction)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_cache, kDontCache)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_flush, kDontFlush)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, code_flushed, kCodeFlushed)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, materialize_arguments,
+               kMaterializeArguments)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_arrow, kIsArrow)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_generator, kIsGenerator)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_concise_method,
@@ -5703,6 +5902,11 @@ bool SharedFunctionInfo::IsApiFunction() {
 }
 
 
+bool SharedFunctionInfo::HasDebugInfo() {
+  return debug_info()->IsDebugInfo();
+}
+
+
 FunctionTemplateInfo* SharedFunctionInfo::get_api_func_data() {
   DCHECK(IsApiFunction());
   return FunctionTemplateInfo::cast(function_data());
@@ -6090,6 +6294,8 @@ ACCESSORS(JSGeneratorObject, receiver, Object, kReceiverOffset)
 SMI_ACCESSORS(JSGeneratorObject, continuation, kContinuationOffset)
 ACCESSORS(JSGeneratorObject, operand_stack, FixedArray, kOperandStackOffset)
 SMI_ACCESSORS(JSGeneratorObject, stack_handler_index, kStackHandlerIndexOffset)
+ACCESSORS(JSGeneratorObject, spare_operand_stack, FixedArray,
+          kSpareOperandStackOffset)
 
 bool JSGeneratorObject::is_suspended() {
   DCHECK_LT(kGeneratorExecuting, kGeneratorClosed);
@@ -6148,6 +6354,7 @@ INT_ACCESSORS(Code, prologue_offset, kPrologueOffset)
 ACCESSORS(Code, relocation_info, ByteArray, kRelocationInfoOffset)
 ACCESSORS(Code, handler_table, FixedArray, kHandlerTableOffset)
 ACCESSORS(Code, deoptimization_data, FixedArray, kDeoptimizationDataOffset)
+ACCESSORS(Code, source_position_table, ByteArray, kSourcePositionTableOffset)
 ACCESSORS(Code, raw_type_feedback_info, Object, kTypeFeedbackInfoOffset)
 ACCESSORS(Code, next_code_link, Object, kNextCodeLinkOffset)
 
@@ -6156,6 +6363,7 @@ void Code::WipeOutHeader() {
   WRITE_FIELD(this, kRelocationInfoOffset, NULL);
   WRITE_FIELD(this, kHandlerTableOffset, NULL);
   WRITE_FIELD(this, kDeoptimizationDataOffset, NULL);
+  WRITE_FIELD(this, kSourcePositionTableOffset, NULL);
   WRITE_FIELD(this, kConstantPoolOffset, NULL);
   // Do not wipe out major/minor keys on a code stub or IC
   if (!READ_FIELD(this, kTypeFeedbackInfoOffset)->IsSmi()) {
@@ -6274,6 +6482,16 @@ void JSArrayBuffer::set_should_be_freed(bool value) {
 }
 
 
+bool JSArrayBuffer::is_shared() {
+  return BooleanBit::get(flag(), kIsShared);
+}
+
+
+void JSArrayBuffer::set_is_shared(bool value) {
+  set_flag(BooleanBit::set(flag(), kIsShared, value));
+}
+
+
 ACCESSORS(JSArrayBuffer, weak_next, Object, kWeakNextOffset)
 ACCESSORS(JSArrayBuffer, weak_first_view, Object, kWeakFirstViewOffset)
 
@@ -6499,19 +6717,18 @@ bool Name::IsOwn() {
 
 StringHasher::StringHasher(int length, uint32_t seed)
   : length_(length),
+    added_length_(0),
     raw_running_hash_(seed),
     array_index_(0),
     is_array_index_(0 < length_ && length_ <= String::kMaxArrayIndexSize),
-    is_first_char_(true) {
+    is_first_char_(true),
+    long_running_hash_(seed),
+    long_block_(0),
+    long_block_length_(0) {
   DCHECK(FLAG_randomize_hashes || raw_running_hash_ == 0);
 }
 
 
-bool StringHasher::has_trivial_hash() {
-  return length_ > String::kMaxHashCalcLength;
-}
-
-
 uint32_t StringHasher::AddCharacterCore(uint32_t running_hash, uint16_t c) {
   running_hash += c;
   running_hash += (running_hash << 10);
@@ -6561,12 +6778,53 @@ bool StringHasher::UpdateIndex(uint16_t c) {
 }
 
 
+uint64_t StringHasher::AddLongBlock(uint64_t running_hash, uint64_t block) {
+  // The block mixing step of MurmurHash3.
+  block *= V8_2PART_UINT64_C(0x87c37b91, 114253d5);
+  block = (block << 31) | (block >> 33);
+  block *= V8_2PART_UINT64_C(0x4cf5ad43, 2745937f);
+  running_hash ^= block;
+  running_hash = (running_hash << 27) | (running_hash >> 37);
+  return running_hash * 5 + 0x52dce729;
+}
+
+
+void StringHasher::AddLongCharacter(uint16_t c) {
+  long_block_ |= static_cast<uint64_t>(c) << (16 * long_block_length_);
+  if (++long_block_length_ == kLongBlockLength) {
+    long_running_hash_ = AddLongBlock(long_running_hash_, long_block_);
+    long_block_ = 0;
+    long_block_length_ = 0;
+  }
+}
+
+
+template<typename Char>
+inline void StringHasher::AddLongCharacters(const Char* chars, int length) {
+  int i = 0;
+  // Blocks do not depend on how the string is split into parts, so first
+  // complete the one a previous part left unfinished.
+  while (long_block_length_ != 0 && i < length) AddLongCharacter(chars[i++]);
+  for (; i + kLongBlockLength <= length; i += kLongBlockLength) {
+    uint64_t block = static_cast<uint64_t>(chars[i]) |
+                     (static_cast<uint64_t>(chars[i + 1]) << 16) |
+                     (static_cast<uint64_t>(chars[i + 2]) << 32) |
+                     (static_cast<uint64_t>(chars[i + 3]) << 48);
+    long_running_hash_ = AddLongBlock(long_running_hash_, block);
+  }
+  for (; i < length; i++) AddLongCharacter(chars[i]);
+}
+
+
 template<typename Char>
 inline void StringHasher::AddCharacters(const Char* chars, int length) {
   DCHECK(sizeof(Char) == 1 || sizeof(Char) == 2);
+  int prefix_length =
+      Max(0, Min(length, String::kMaxHashCalcLength - added_length_));
+  added_length_ += length;
   int i = 0;
   if (is_array_index_) {
-    for (; i < length; i++) {
+    for (; i < prefix_length; i++) {
       AddCharacter(chars[i]);
       if (!UpdateIndex(chars[i])) {
         i++;
@@ -6574,10 +6832,11 @@ inline void StringHasher::AddCharacters(const Char* chars, int length) {
       }
     }
   }
-  for (; i < length; i++) {
+  for (; i < prefix_length; i++) {
     DCHECK(!is_array_index_);
     AddCharacter(chars[i]);
   }
+  if (i < length) AddLongCharacters(chars + i, length - i);
 }
 
 
@@ -6586,15 +6845,13 @@ uint32_t StringHasher::HashSequentialString(const schar* chars,
                                             int length,
                                             uint32_t seed) {
   StringHasher hasher(length, seed);
-  if (!hasher.has_trivial_hash()) hasher.AddCharacters(chars, length);
+  hasher.AddCharacters(chars, length);
   return hasher.GetHashField();
 }
 
 
 uint32_t IteratingStringHasher::Hash(String* string, uint32_t seed) {
   IteratingStringHasher hasher(string->length(), seed);
-  // Nothing to do.
-  if (hasher.has_trivial_hash()) return hasher.GetHashField();
   ConsString* cons_string = String::VisitFlat(&hasher, string);
   // The string was flat.
   if (cons_string == NULL) return hasher.GetHashField();
@@ -7254,6 +7511,8 @@ Object* JSMapIterator::CurrentValue() {
 #undef WRITE_INTPTR_FIELD
 #undef READ_UINT32_FIELD
 #undef WRITE_UINT32_FIELD
+#undef READ_FLOAT_FIELD
+#undef WRITE_FLOAT_FIELD
 #undef READ_SHORT_FIELD
 #undef WRITE_SHORT_FIELD
 #undef READ_BYTE_FIELD
@@ -77,6 +77,11 @@ MaybeHandle<JSReceiver> Object::ToObject(Isolate* isolate,
     constructor = handle(native_context->string_function(), isolate);
   } else if (object->IsSymbol()) {
     constructor = handle(native_context->symbol_function(), isolate);
+#define SIMD128_CONSTRUCTOR(TYPE, Type, type, lane_count, lane_type) \
+  } else if (object->Is##Type()) {                                   \
+    constructor = handle(native_context->type##_function(), isolate);
+  SIMD128_TYPES(SIMD128_CONSTRUCTOR)
+#undef SIMD128_CONSTRUCTOR
   } else {
     return MaybeHandle<JSReceiver>();
   }
@@ -405,8 +410,8 @@ MaybeHandle<Object> JSProxy::GetPropertyWithHandler(Handle<JSProxy> proxy,
   if (name->IsSymbol()) return isolate->factory()->undefined_value();
 
   Handle<Object> args[] = { receiver, name };
-  return CallTrap(
-      proxy, "get",  isolate->derived_get_trap(), arraysize(args), args);
+  return CallTrap(proxy, isolate->factory()->get_string(),
+                  isolate->derived_get_trap(), arraysize(args), args);
 }
 
 
@@ -830,6 +835,12 @@ Map* Object::GetRootMap(Isolate* isolate) {
   if (heap_object->IsBoolean()) {
     return context->boolean_function()->initial_map();
   }
+#define SIMD128_ROOT_MAP(TYPE, Type, type, lane_count, lane_type) \
+  if (heap_object->Is##Type()) {                                  \
+    return context->type##_function()->initial_map();            \
+  }
+  SIMD128_TYPES(SIMD128_ROOT_MAP)
+#undef SIMD128_ROOT_MAP
   return isolate->heap()->null_value()->map();
 }
 
@@ -837,8 +848,21 @@ Map* Object::GetRootMap(Isolate* isolate) {
 Object* Object::GetHash() {
   // The object is either a number, a name, an odd-ball,
   // a real JS object, or a Harmony proxy.
-  if (IsNumber()) {
-    uint32_t hash = ComputeLongHash(double_to_uint64(Number()));
+  // Numbers with an int32 value (and -0) hash like that integer, so that
+  // optimized code can compute the hash of Smi keys, see
+  // HOptimizedGraphBuilder::BuildOrderedHashTableLookup.
+  if (IsSmi()) {
+    uint32_t hash = ComputeIntegerHash(Smi::cast(this)->value(), 0);
+    return Smi::FromInt(hash & Smi::kMaxValue);
+  }
+  if (IsHeapNumber()) {
+    double value = HeapNumber::cast(this)->value();
+    uint32_t hash;
+    if (value == 0 || IsInt32Double(value)) {
+      hash = ComputeIntegerHash(static_cast<int32_t>(value), 0);
+    } else {
+      hash = ComputeLongHash(double_to_uint64(value));
+    }
     return Smi::FromInt(hash & Smi::kMaxValue);
   }
   if (IsName()) {
@@ -849,6 +873,10 @@ Object* Object::GetHash() {
     uint32_t hash = Oddball::cast(this)->to_string()->Hash();
     return Smi::FromInt(hash);
   }
+  if (IsSimd128Value()) {
+    uint32_t hash = Simd128Value::cast(this)->Hash();
+    return Smi::FromInt(hash & Smi::kMaxValue);
+  }
 
   DCHECK(IsJSReceiver());
   return JSReceiver::cast(this)->GetIdentityHash();
@@ -1496,6 +1524,14 @@ void HeapObject::HeapObjectShortPrint(std::ostream& os) {  // NOLINT
       os << '>';
       break;
     }
+    case FLOAT32X4_TYPE:
+    case INT32X4_TYPE:
+    case FLOAT64X2_TYPE: {
+      os << "<";
+      Simd128Value::cast(this)->Simd128ValuePrint(os);
+      os << ">";
+      break;
+    }
     case JS_PROXY_TYPE:
       os << "<JSProxy>";
       break;
@@ -1574,6 +1610,8 @@ void HeapObject::IterateBody(InstanceType type, int object_size,
     case FIXED_DOUBLE_ARRAY_TYPE:
       break;
     case JS_OBJECT_TYPE:
+      reinterpret_cast<JSObject*>(this)->JSObjectIterateBody(object_size, v);
+      break;
     case JS_CONTEXT_EXTENSION_OBJECT_TYPE:
     case JS_GENERATOR_OBJECT_TYPE:
     case JS_MODULE_TYPE:
@@ -1630,6 +1668,9 @@ void HeapObject::IterateBody(InstanceType type, int object_size,
 
     case HEAP_NUMBER_TYPE:
     case MUTABLE_HEAP_NUMBER_TYPE:
+    case FLOAT32X4_TYPE:
+    case INT32X4_TYPE:
+    case FLOAT64X2_TYPE:
     case FILLER_TYPE:
     case BYTE_ARRAY_TYPE:
     case FREE_SPACE_TYPE:
@@ -1675,6 +1716,24 @@ void HeapNumber::HeapNumberPrint(std::ostream& os) {  // NOLINT
 }
 
 
+void Simd128Value::Simd128ValuePrint(std::ostream& os) {  // NOLINT
+#define PRINT_SIMD128_VALUE(TYPE, Type, type, lane_count, lane_type) \
+  if (Is##Type()) {                                                  \
+    Type* value = Type::cast(this);                                  \
+    os << #Type "(";                                                 \
+    for (int i = 0; i < lane_count; i++) {                           \
+      if (i > 0) os << ", ";                                         \
+      os << value->get_lane(i);                                      \
+    }                                                                \
+    os << ")";                                                       \
+    return;                                                          \
+  }
+  SIMD128_TYPES(PRINT_SIMD128_VALUE)
+#undef PRINT_SIMD128_VALUE
+  UNREACHABLE();
+}
+
+
 String* JSReceiver::class_name() {
   if (IsJSFunction() || IsJSFunctionProxy()) {
     return GetHeap()->Function_string();
@@ -1812,11 +1871,21 @@ void JSObject::EnqueueChangeRecord(Handle<JSObject> object,
                                    const char* type_str,
                                    Handle<Name> name,
                                    Handle<Object> old_value) {
+  Isolate* isolate = object->GetIsolate();
+  HandleScope scope(isolate);
+  Handle<String> type = isolate->factory()->InternalizeUtf8String(type_str);
+  EnqueueChangeRecord(object, type, name, old_value);
+}
+
+
+void JSObject::EnqueueChangeRecord(Handle<JSObject> object,
+                                   Handle<String> type,
+                                   Handle<Name> name,
+                                   Handle<Object> old_value) {
   DCHECK(!object->IsJSGlobalProxy());
   DCHECK(!object->IsJSGlobalObject());
   Isolate* isolate = object->GetIsolate();
   HandleScope scope(isolate);
-  Handle<String> type = isolate->factory()->InternalizeUtf8String(type_str);
   Handle<Object> args[] = { type, object, name, old_value };
   int argc = name.is_null() ? 2 : old_value->IsTheHole() ? 3 : 4;
 
@@ -1862,6 +1931,9 @@ bool Map::InstancesNeedRewriting(Map* target, int target_number_of_fields,
     }
   }
 
+  // If double fields switched between boxed and unboxed storage, rewrite.
+  if (unboxed_double_fields() != target->unboxed_double_fields()) return true;
+
   // If no fields were added, and no inobject properties were removed, setting
   // the map is sufficient.
   if (target_inobject == inobject_properties()) return false;
@@ -1914,6 +1986,25 @@ void JSObject::MigrateToMap(Handle<JSObject> object, Handle<Map> new_map) {
 }
 
 
+// Returns whether new double fields are stored unboxed.
+static inline bool UnboxDoubleFields() {
+  return V8_DOUBLE_FIELDS_UNBOXING && FLAG_unbox_double_fields;
+}
+
+
+// The store buffer and the slots buffers of an ongoing compaction may still
+// record in-object slots of |object| that are going to hold raw double
+// values. Make the GC forget about them: the page of the object is rescanned
+// (layout aware) on the next scavenge instead of consulting the recorded
+// slots, and the ongoing compaction is given up.
+static void InvalidateRecordedSlots(Heap* heap, JSObject* object) {
+  if (heap->InNewSpace(object)) return;
+  Page::FromAddress(object->address())->set_scan_on_scavenge(true);
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  if (collector->is_compacting()) collector->AbortCompaction();
+}
+
+
 // To migrate a fast instance to a fast map:
 // - First check whether the instance needs to be rewritten. If not, simply
 //   change the map.
@@ -1954,10 +2045,15 @@ void JSObject::MigrateFastToFast(Handle<JSObject> object, Handle<Map> new_map) {
 
     if (old_map->unused_property_fields() > 0) {
       if (details.representation().IsDouble()) {
-        Handle<Object> value = isolate->factory()->NewHeapNumber(0, MUTABLE);
         FieldIndex index =
             FieldIndex::ForDescriptor(*new_map, new_map->LastAdded());
-        object->FastPropertyAtPut(index, *value);
+        if (index.is_unboxed_double()) {
+          object->RawFastDoublePropertyAtPut(index, 0);
+        } else {
+          Handle<Object> value =
+              isolate->factory()->NewHeapNumber(0, MUTABLE);
+          object->RawFastPropertyAtPut(index, *value);
+        }
       }
       object->synchronized_set_map(*new_map);
       return;
@@ -2011,10 +2107,18 @@ void JSObject::MigrateFastToFast(Handle<JSObject> object, Handle<Map> new_map) {
     }
     DCHECK(old_details.type() == CONSTANT ||
            old_details.type() == FIELD);
-    Object* raw_value = old_details.type() == CONSTANT
-        ? old_descriptors->GetValue(i)
-        : object->RawFastPropertyAt(FieldIndex::ForDescriptor(*old_map, i));
-    Handle<Object> value(raw_value, isolate);
+    Handle<Object> value;
+    if (old_details.type() == CONSTANT) {
+      value = handle(old_descriptors->GetValue(i), isolate);
+    } else {
+      FieldIndex old_index = FieldIndex::ForDescriptor(*old_map, i);
+      if (old_index.is_unboxed_double()) {
+        value = isolate->factory()->NewHeapNumber(
+            object->RawFastDoublePropertyAt(old_index), MUTABLE);
+      } else {
+        value = handle(object->RawFastPropertyAt(old_index), isolate);
+      }
+    }
     if (!old_details.representation().IsDouble() &&
         details.representation().IsDouble()) {
       if (old_details.representation().IsNone()) {
@@ -2049,14 +2153,24 @@ void JSObject::MigrateFastToFast(Handle<JSObject> object, Handle<Map> new_map) {
   DisallowHeapAllocation no_allocation;
 
   // Copy (real) inobject properties. If necessary, stop at number_of_fields to
-  // avoid overwriting |one_pointer_filler_map|.
+  // avoid overwriting |one_pointer_filler_map|. The fields are laid out as
+  // described by the new map, which is installed afterwards.
+  Heap* heap = isolate->heap();
+  bool unboxes_fields = false;
   int limit = Min(inobject, number_of_fields);
   for (int i = 0; i < limit; i++) {
     FieldIndex index = FieldIndex::ForPropertyIndex(*new_map, i);
-    object->FastPropertyAtPut(index, array->get(external + i));
+    Object* value = array->get(external + i);
+    if (new_map->IsUnboxedDoubleField(index)) {
+      DCHECK(value->IsMutableHeapNumber());
+      if (!old_map->IsUnboxedDoubleField(index)) unboxes_fields = true;
+      object->RawFastDoublePropertyAtPut(index,
+                                         HeapNumber::cast(value)->value());
+    } else {
+      object->RawFastPropertyAtPut(index, value);
+    }
   }
-
-  Heap* heap = isolate->heap();
+  if (unboxes_fields) InvalidateRecordedSlots(heap, *object);
 
   // If there are properties in the new backing store, trim it to the correct
   // size and install the backing store into the object.
@@ -2120,6 +2234,7 @@ Handle<Map> Map::CopyGeneralizeAllRepresentations(Handle<Map> map,
       descriptors->SetValue(i, HeapType::Any());
     }
   }
+  new_map->set_unboxed_double_fields(0);
 
   // Unless the instance is being migrated, ensure that modify_index is a field.
   PropertyDetails details = descriptors->GetDetails(modify_index);
@@ -2344,8 +2459,8 @@ void Map::GeneralizeFieldType(Handle<Map> map,
   PropertyDetails details = descriptors->GetDetails(modify_index);
   Handle<Name> name(descriptors->GetKey(modify_index));
   field_owner->UpdateFieldType(modify_index, name, new_field_type);
-  field_owner->dependent_code()->DeoptimizeDependentCodeGroup(
-      isolate, DependentCode::kFieldTypeGroup);
+  field_owner->dependent_code()->DeoptimizeDependentFieldTypeCode(
+      isolate, modify_index);
 
   if (FLAG_trace_generalization) {
     map->PrintGeneralization(
@@ -2957,8 +3072,8 @@ Handle<Object> Object::SetDataProperty(LookupIterator* it,
 
   // Send the change record if there are observers.
   if (is_observed && !value->SameValue(*maybe_old.ToHandleChecked())) {
-    JSObject::EnqueueChangeRecord(receiver, "update", it->name(),
-                                  maybe_old.ToHandleChecked());
+    JSObject::EnqueueChangeRecord(receiver, it->factory()->update_string(),
+                                  it->name(), maybe_old.ToHandleChecked());
   }
 
   return value;
@@ -3009,8 +3124,8 @@ MaybeHandle<Object> Object::AddDataProperty(LookupIterator* it,
   // Send the change record if there are observers.
   if (receiver->map()->is_observed() &&
       !it->name().is_identical_to(it->factory()->hidden_string())) {
-    JSObject::EnqueueChangeRecord(receiver, "add", it->name(),
-                                  it->factory()->the_hole_value());
+    JSObject::EnqueueChangeRecord(receiver, it->factory()->add_string(),
+                                  it->name(), it->factory()->the_hole_value());
   }
 
   return value;
@@ -3399,8 +3514,9 @@ Maybe<bool> JSProxy::HasPropertyWithHandler(Handle<JSProxy> proxy,
   Handle<Object> args[] = { name };
   Handle<Object> result;
   ASSIGN_RETURN_ON_EXCEPTION_VALUE(
-      isolate, result, CallTrap(proxy, "has", isolate->derived_has_trap(),
-                                arraysize(args), args),
+      isolate, result,
+      CallTrap(proxy, isolate->factory()->has_string(),
+               isolate->derived_has_trap(), arraysize(args), args),
       Maybe<bool>());
 
   return maybe(result->BooleanValue());
@@ -3421,7 +3537,7 @@ MaybeHandle<Object> JSProxy::SetPropertyWithHandler(Handle<JSProxy> proxy,
   RETURN_ON_EXCEPTION(
       isolate,
       CallTrap(proxy,
-               "set",
+               isolate->factory()->set_string(),
                isolate->derived_set_trap(),
                arraysize(args),
                args),
@@ -3674,20 +3790,62 @@ void JSProxy::Fix(Handle<JSProxy> proxy) {
 }
 
 
+// Handlers usually have their traps as methods on themselves or on their
+// prototypes, i.e. as constants in the descriptors of their maps. Finds
+// such a trap through the descriptor lookup cache, which caches the lookup
+// per map, without setting up a LookupIterator. Returns NULL if the generic
+// lookup is needed, e.g. for accessors, interceptors and dictionary maps.
+static Object* FindConstantTrap(Object* handler, String* trap_name) {
+  DisallowHeapAllocation no_gc;
+  Object* current = handler;
+  while (!current->IsNull()) {
+    if (!current->IsJSObject() || current->IsJSGlobalProxy()) return NULL;
+    Map* map = JSObject::cast(current)->map();
+    if (map->is_dictionary_map() || map->is_access_check_needed() ||
+        map->has_named_interceptor()) {
+      return NULL;
+    }
+    DescriptorArray* descriptors = map->instance_descriptors();
+    int number = descriptors->SearchWithCache(trap_name, map);
+    if (number != DescriptorArray::kNotFound) {
+      if (descriptors->GetDetails(number).type() != CONSTANT) return NULL;
+      return descriptors->GetConstant(number);
+    }
+    current = map->prototype();
+  }
+  return trap_name->GetHeap()->undefined_value();
+}
+
+
 MaybeHandle<Object> JSProxy::CallTrap(Handle<JSProxy> proxy,
                                       const char* name,
                                       Handle<Object> derived,
                                       int argc,
                                       Handle<Object> argv[]) {
   Isolate* isolate = proxy->GetIsolate();
+  Handle<String> trap_name = isolate->factory()->InternalizeUtf8String(name);
+  return CallTrap(proxy, trap_name, derived, argc, argv);
+}
+
+
+MaybeHandle<Object> JSProxy::CallTrap(Handle<JSProxy> proxy,
+                                      Handle<String> trap_name,
+                                      Handle<Object> derived,
+                                      int argc,
+                                      Handle<Object> argv[]) {
+  Isolate* isolate = proxy->GetIsolate();
   Handle<Object> handler(proxy->handler(), isolate);
 
-  Handle<String> trap_name = isolate->factory()->InternalizeUtf8String(name);
   Handle<Object> trap;
-  ASSIGN_RETURN_ON_EXCEPTION(
-      isolate, trap,
-      Object::GetPropertyOrElement(handler, trap_name),
-      Object);
+  Object* constant_trap = FindConstantTrap(*handler, *trap_name);
+  if (constant_trap != NULL) {
+    trap = handle(constant_trap, isolate);
+  } else {
+    ASSIGN_RETURN_ON_EXCEPTION(
+        isolate, trap,
+        Object::GetPropertyOrElement(handler, trap_name),
+        Object);
+  }
 
   if (trap->IsUndefined()) {
     if (derived.is_null()) {
@@ -3765,6 +3923,10 @@ void JSObject::WriteToField(int descriptor, Object* value) {
   if (details.representation().IsDouble()) {
     // Nothing more to be done.
     if (value->IsUninitialized()) return;
+    if (index.is_unboxed_double()) {
+      RawFastDoublePropertyAtPut(index, value->Number());
+      return;
+    }
     HeapNumber* box = HeapNumber::cast(RawFastPropertyAt(index));
     DCHECK(box->IsMutableHeapNumber());
     box->set_value(value->Number());
@@ -4204,12 +4366,17 @@ void JSObject::MigrateFastToSlow(Handle<JSObject> object,
       case FIELD: {
         Handle<Name> key(descs->GetKey(i));
         FieldIndex index = FieldIndex::ForDescriptor(*map, i);
-        Handle<Object> value(
-            object->RawFastPropertyAt(index), isolate);
-        if (details.representation().IsDouble()) {
-          DCHECK(value->IsMutableHeapNumber());
-          Handle<HeapNumber> old = Handle<HeapNumber>::cast(value);
-          value = isolate->factory()->NewHeapNumber(old->value());
+        Handle<Object> value;
+        if (index.is_unboxed_double()) {
+          value = isolate->factory()->NewHeapNumber(
+              object->RawFastDoublePropertyAt(index));
+        } else {
+          value = handle(object->RawFastPropertyAt(index), isolate);
+          if (details.representation().IsDouble()) {
+            DCHECK(value->IsMutableHeapNumber());
+            Handle<HeapNumber> old = Handle<HeapNumber>::cast(value);
+            value = isolate->factory()->NewHeapNumber(old->value());
+          }
         }
         PropertyDetails d =
             PropertyDetails(details.attributes(), NORMAL, i + 1);
@@ -4236,6 +4403,18 @@ void JSObject::MigrateFastToSlow(Handle<JSObject> object,
   // From here on we cannot fail and we shouldn't GC anymore.
   DisallowHeapAllocation no_allocation;
 
+  // The dictionary map treats all in-object slots as tagged, clear the ones
+  // that hold raw double values.
+  if (map->HasUnboxedDoubleFields()) {
+    for (int i = 0; i < real_size; i++) {
+      if (descs->GetType(i) != FIELD) continue;
+      FieldIndex index = FieldIndex::ForDescriptor(*map, i);
+      if (index.is_unboxed_double()) {
+        object->RawFastPropertyAtPut(index, Smi::FromInt(0));
+      }
+    }
+  }
+
   // Resize the object in the heap if necessary.
   int new_instance_size = new_map->instance_size();
   int instance_size_delta = map->instance_size() - new_instance_size;
@@ -4311,6 +4490,9 @@ void JSObject::MigrateSlowToFast(Handle<JSObject> object,
   if (instance_descriptor_length == 0) {
     DisallowHeapAllocation no_gc;
     DCHECK_LE(unused_property_fields, inobject_props);
+    if (UnboxDoubleFields() && inobject_props > 0) {
+      InvalidateRecordedSlots(isolate->heap(), *object);
+    }
     // Transform the object.
     new_map->set_unused_property_fields(inobject_props);
     object->synchronized_set_map(*new_map);
@@ -4393,6 +4575,13 @@ void JSObject::MigrateSlowToFast(Handle<JSObject> object,
   new_map->InitializeDescriptors(*descriptors);
   new_map->set_unused_property_fields(unused_property_fields);
 
+  // Unused in-object slots may still hold stale values and thus be recorded
+  // by the GC. Make sure the GC forgets about them before a later transition
+  // stores an unboxed double field into one of them.
+  if (UnboxDoubleFields() && number_of_fields < inobject_props) {
+    InvalidateRecordedSlots(isolate->heap(), *object);
+  }
+
   // Transform the object.
   object->synchronized_set_map(*new_map);
 
@@ -5354,6 +5543,11 @@ Handle<Object> JSObject::FastPropertyAt(Handle<JSObject> object,
                                         Representation representation,
                                         FieldIndex index) {
   Isolate* isolate = object->GetIsolate();
+  if (index.is_unboxed_double()) {
+    DCHECK(representation.IsDouble());
+    return isolate->factory()->NewHeapNumber(
+        object->RawFastDoublePropertyAt(index));
+  }
   Handle<Object> raw_value(object->RawFastPropertyAt(index), isolate);
   return Object::WrapForRead(isolate, raw_value, representation);
 }
@@ -5444,6 +5638,8 @@ MaybeHandle<JSObject> JSObjectWalkVisitor<ContextObject>::StructureWalk(
         PropertyDetails details = descriptors->GetDetails(i);
         if (details.type() != FIELD) continue;
         FieldIndex index = FieldIndex::ForDescriptor(copy->map(), i);
+        // Unboxed doubles have already been copied along with the object.
+        if (index.is_unboxed_double()) continue;
         Handle<Object> value(object->RawFastPropertyAt(index), isolate);
         if (value->IsJSObject()) {
           ASSIGN_RETURN_ON_EXCEPTION(
@@ -6340,8 +6536,15 @@ Object* JSObject::SlowReverseLookup(Object* value) {
     DescriptorArray* descs = map()->instance_descriptors();
     for (int i = 0; i < number_of_own_descriptors; i++) {
       if (descs->GetType(i) == FIELD) {
-        Object* property =
-            RawFastPropertyAt(FieldIndex::ForDescriptor(map(), i));
+        FieldIndex field_index = FieldIndex::ForDescriptor(map(), i);
+        if (field_index.is_unboxed_double()) {
+          if (value->IsNumber() &&
+              RawFastDoublePropertyAt(field_index) == value->Number()) {
+            return descs->GetKey(i);
+          }
+          continue;
+        }
+        Object* property = RawFastPropertyAt(field_index);
         if (descs->GetDetails(i).representation().IsDouble()) {
           DCHECK(property->IsMutableHeapNumber());
           if (value->IsNumber() && property->Number() == value->Number()) {
@@ -6471,6 +6674,46 @@ Handle<Map> Map::CopyDropDescriptors(Handle<Map> map) {
 }
 
 
+// Returns whether descriptor |descriptor| of |descriptors| and the descriptor
+// with the same index in |map| both describe the same double field.
+static bool DescribesSameDoubleField(Map* map, DescriptorArray* descriptors,
+                                     int descriptor) {
+  if (descriptor >= map->NumberOfOwnDescriptors()) return false;
+  PropertyDetails details = descriptors->GetDetails(descriptor);
+  PropertyDetails map_details =
+      map->instance_descriptors()->GetDetails(descriptor);
+  return details.type() == FIELD && details.representation().IsDouble() &&
+         map_details.type() == FIELD &&
+         map_details.representation().IsDouble() &&
+         details.field_index() == map_details.field_index();
+}
+
+
+void Map::UpdateUnboxedDoubleFields(Map* parent) {
+  if (!V8_DOUBLE_FIELDS_UNBOXING) return;
+  int bits = 0;
+  if (instance_type() == JS_OBJECT_TYPE && !is_dictionary_map()) {
+    DescriptorArray* descriptors = instance_descriptors();
+    int limit = Min(inobject_properties(), kMaxUnboxedDoubleFields);
+    int number_of_own_descriptors = NumberOfOwnDescriptors();
+    for (int i = 0; i < number_of_own_descriptors; i++) {
+      PropertyDetails details = descriptors->GetDetails(i);
+      if (details.type() != FIELD || !details.representation().IsDouble()) {
+        continue;
+      }
+      int field_index = details.field_index();
+      if (field_index >= limit) continue;
+      bool unboxed =
+          DescribesSameDoubleField(parent, descriptors, i)
+              ? parent->IsUnboxedDoubleInObjectProperty(field_index)
+              : UnboxDoubleFields();
+      if (unboxed) bits |= 1 << field_index;
+    }
+  }
+  set_unboxed_double_fields(bits);
+}
+
+
 Handle<Map> Map::ShareDescriptor(Handle<Map> map,
                                  Handle<DescriptorArray> descriptors,
                                  Descriptor* descriptor) {
@@ -6498,6 +6741,7 @@ Handle<Map> Map::ShareDescriptor(Handle<Map> map,
     DisallowHeapAllocation no_gc;
     descriptors->Append(descriptor);
     result->InitializeDescriptors(*descriptors);
+    result->UpdateUnboxedDoubleFields(*map);
   }
 
   DCHECK(result->NumberOfOwnDescriptors() == map->NumberOfOwnDescriptors() + 1);
@@ -6539,6 +6783,13 @@ Handle<Map> Map::CopyReplaceDescriptors(Handle<Map> map,
     } else {
       int length = descriptors->number_of_descriptors();
       for (int i = 0; i < length; i++) {
+        // Unboxed double fields keep their representation, so that the
+        // layout of the instances does not change.
+        if (DescribesSameDoubleField(*map, *descriptors, i) &&
+            map->IsUnboxedDoubleInObjectProperty(
+                descriptors->GetFieldIndex(i))) {
+          continue;
+        }
         descriptors->SetRepresentation(i, Representation::Tagged());
         if (descriptors->GetDetails(i).type() == FIELD) {
           descriptors->SetValue(i, HeapType::Any());
@@ -6546,6 +6797,7 @@ Handle<Map> Map::CopyReplaceDescriptors(Handle<Map> map,
       }
     }
   }
+  result->UpdateUnboxedDoubleFields(*map);
 
   return result;
 }
@@ -6562,6 +6814,7 @@ Handle<Map> Map::CopyInstallDescriptors(Handle<Map> map,
 
   result->InitializeDescriptors(*descriptors);
   result->SetNumberOfOwnDescriptors(new_descriptor + 1);
+  result->UpdateUnboxedDoubleFields(*map);
 
   int unused_property_fields = map->unused_property_fields();
   if (descriptors->GetDetails(new_descriptor).type() == FIELD) {
@@ -6607,6 +6860,7 @@ Handle<Map> Map::CopyAsElementsKind(Handle<Map> map, ElementsKind kind,
 
     new_map->set_elements_kind(kind);
     new_map->InitializeDescriptors(map->instance_descriptors());
+    new_map->UpdateUnboxedDoubleFields(*map);
     return new_map;
   }
 
@@ -6643,6 +6897,7 @@ Handle<Map> Map::CopyForObserved(Handle<Map> map) {
   new_map->set_is_observed();
   if (map->owns_descriptors()) {
     new_map->InitializeDescriptors(map->instance_descriptors());
+    new_map->UpdateUnboxedDoubleFields(*map);
   }
 
   Handle<Name> name = isolate->factory()->observed_symbol();
@@ -8939,11 +9194,27 @@ uint32_t StringHasher::GetHashField() {
     return (GetHashCore(raw_running_hash_) << String::kHashShift) |
            String::kIsNotArrayIndexMask;
   } else {
-    return (length_ << String::kHashShift) | String::kIsNotArrayIndexMask;
+    return (GetLongHash() << String::kHashShift) |
+           String::kIsNotArrayIndexMask;
   }
 }
 
 
+uint32_t StringHasher::GetLongHash() {
+  uint64_t hash = long_running_hash_;
+  if (long_block_length_ != 0) hash = AddLongBlock(hash, long_block_);
+  hash ^= (static_cast<uint64_t>(raw_running_hash_) << 32) |
+          static_cast<uint32_t>(length_);
+  // The finalization step of MurmurHash3.
+  hash ^= hash >> 33;
+  hash *= V8_2PART_UINT64_C(0xff51afd7, ed558ccd);
+  hash ^= hash >> 33;
+  hash *= V8_2PART_UINT64_C(0xc4ceb9fe, 1a85ec53);
+  hash ^= hash >> 33;
+  return GetHashCore(static_cast<uint32_t>(hash));
+}
+
+
 uint32_t StringHasher::ComputeUtf8Hash(Vector<const char> chars,
                                        uint32_t seed,
                                        int* utf16_length_out) {
@@ -8972,8 +9243,19 @@ uint32_t StringHasher::ComputeUtf8Hash(Vector<const char> chars,
     remaining -= consumed;
     bool is_two_characters = c > unibrow::Utf16::kMaxNonSurrogateCharCode;
     utf16_length += is_two_characters ? 2 : 1;
-    // No need to keep hashing. But we do need to calculate utf16_length.
-    if (utf16_length > String::kMaxHashCalcLength) continue;
+    // Past the prefix neither the index nor the one-at-a-time hash change.
+    if (utf16_length > String::kMaxHashCalcLength) {
+      if (is_two_characters) {
+        uint16_t pair[] = { unibrow::Utf16::LeadSurrogate(c),
+                            unibrow::Utf16::TrailSurrogate(c) };
+        hasher.AddCharacters(pair, 2);
+      } else {
+        uint16_t single = static_cast<uint16_t>(c);
+        hasher.AddCharacters(&single, 1);
+      }
+      continue;
+    }
+    hasher.added_length_ = utf16_length;
     if (is_two_characters) {
       uint16_t c1 = unibrow::Utf16::LeadSurrogate(c);
       uint16_t c2 = unibrow::Utf16::TrailSurrogate(c);
@@ -9093,6 +9375,23 @@ void ConstantPoolArray::ClearPtrEntries(Isolate* isolate) {
 }
 
 
+void JSObject::JSObjectIterateBody(int object_size, ObjectVisitor* v) {
+  Map* map = this->map();
+  if (!map->HasUnboxedDoubleFields()) {
+    JSObject::BodyDescriptor::IterateBody(this, object_size, v);
+    return;
+  }
+  int offset = JSObject::BodyDescriptor::kStartOffset;
+  while (offset < object_size) {
+    int end_offset;
+    if (map->IsTaggedRun(offset, object_size, &end_offset)) {
+      IteratePointers(v, offset, end_offset);
+    }
+    offset = end_offset;
+  }
+}
+
+
 void JSFunction::JSFunctionIterateBody(int object_size, ObjectVisitor* v) {
   // Iterate over all fields in the body but take care in dealing with
   // the code entry.
@@ -9782,12 +10081,27 @@ bool SharedFunctionInfo::IsInlineable() {
   // Check that the function has a script associated with it.
   if (!script()->IsScript()) return false;
   if (optimization_disabled()) return false;
+  // Break points have to be hit in unoptimized code.
+  if (HasDebugInfo()) return false;
   // If we never ran this (unlikely) then lets try to optimize it.
   if (code()->kind() != Code::FUNCTION) return true;
   return code()->optimizable();
 }
 
 
+bool SharedFunctionInfo::HasTieringHint() {
+  if (!script()->IsScript()) return false;
+  Object* hints = Script::cast(script())->tiering_hints();
+  if (!hints->IsFixedArray()) return false;
+  FixedArray* positions = FixedArray::cast(hints);
+  Smi* position = Smi::FromInt(start_position());
+  for (int i = 0; i < positions->length(); i++) {
+    if (positions->get(i) == position) return true;
+  }
+  return false;
+}
+
+
 int SharedFunctionInfo::SourceSize() {
   return end_position() - start_position();
 }
@@ -10177,34 +10491,23 @@ void Code::CopyFrom(const CodeDesc& desc) {
 
 
 // Locate the source position which is closest to the address in the code. This
-// is using the source position information embedded in the relocation info.
-// The position returned is relative to the beginning of the script where the
-// source for this function is found.
+// is using the source position table of the code. The position returned is
+// relative to the beginning of the script where the source for this function
+// is found.
 int Code::SourcePosition(Address pc) {
-  int distance = kMaxInt;
   int position = RelocInfo::kNoPosition;  // Initially no position found.
-  // Run through all the relocation info to find the best matching source
-  // position. All the code needs to be considered as the sequence of the
-  // instructions in the code does not necessarily follow the same order as the
-  // source.
-  RelocIterator it(this, RelocInfo::kPositionMask);
-  while (!it.done()) {
-    // Only look at positions after the current pc.
-    if (it.rinfo()->pc() < pc) {
-      // Get position and distance.
-
-      int dist = static_cast<int>(pc - it.rinfo()->pc());
-      int pos = static_cast<int>(it.rinfo()->data());
-      // If this position is closer than the current candidate or if it has the
-      // same distance as the current candidate and the position is higher then
-      // this position is the new candidate.
-      if ((dist < distance) ||
-          (dist == distance && pos > position)) {
-        position = pos;
-        distance = dist;
-      }
+  int position_offset = -1;
+  int code_offset = static_cast<int>(pc - instruction_start());
+  // The table is sorted by code offset, so the closest position before the pc
+  // is the last one read. If there are several at that offset, the highest
+  // position is the one to use.
+  for (SourcePositionTableIterator it(source_position_table());
+       !it.done() && it.code_offset() < code_offset; it.Advance()) {
+    if (it.code_offset() > position_offset ||
+        it.source_position() > position) {
+      position = it.source_position();
+      position_offset = it.code_offset();
     }
-    it.next();
   }
   return position;
 }
@@ -10216,17 +10519,18 @@ int Code::SourceStatementPosition(Address pc) {
   // First find the position as close as possible using all position
   // information.
   int position = SourcePosition(pc);
-  // Now find the closest statement position before the position.
+  // Now find the closest statement position before the position. All of the
+  // code needs to be considered as the sequence of the instructions in the
+  // code does not necessarily follow the same order as the source.
   int statement_position = 0;
-  RelocIterator it(this, RelocInfo::kPositionMask);
-  while (!it.done()) {
-    if (RelocInfo::IsStatementPosition(it.rinfo()->rmode())) {
-      int p = static_cast<int>(it.rinfo()->data());
+  for (SourcePositionTableIterator it(source_position_table()); !it.done();
+       it.Advance()) {
+    if (it.is_statement()) {
+      int p = it.source_position();
       if (statement_position < p && p <= position) {
         statement_position = p;
       }
     }
-    it.next();
   }
   return statement_position;
 }
@@ -10578,6 +10882,12 @@ Code* Code::GetCodeAgeStub(Isolate* isolate, Age age, MarkingParity parity) {
 
 
 void Code::PrintDeoptLocation(FILE* out, int bailout_id) {
+  const char* comment = GetDeoptLocationComment(bailout_id);
+  if (comment != NULL) PrintF(out, "            %s\n", comment);
+}
+
+
+const char* Code::GetDeoptLocationComment(int bailout_id) {
   const char* last_comment = NULL;
   int mask = RelocInfo::ModeMask(RelocInfo::COMMENT)
       | RelocInfo::ModeMask(RelocInfo::RUNTIME_ENTRY);
@@ -10593,11 +10903,11 @@ void Code::PrintDeoptLocation(FILE* out, int bailout_id) {
           (bailout_id == Deoptimizer::GetDeoptimizationId(
               GetIsolate(), info->target_address(), Deoptimizer::LAZY))) {
         CHECK(RelocInfo::IsRuntimeEntry(info->rmode()));
-        PrintF(out, "            %s\n", last_comment);
-        return;
+        return last_comment;
       }
     }
   }
+  return NULL;
 }
 
 
@@ -10765,6 +11075,14 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(
           break;
         }
 
+        case Translation::TRY_HANDLER_SLOT: {
+          int handler_offset = iterator.Next();
+          int input_slot_index = iterator.Next();
+          os << "{handler_offset=" << handler_offset
+             << ", input=" << input_slot_index << "}";
+          break;
+        }
+
         case Translation::LITERAL: {
           unsigned literal_index = iterator.Next();
           os << "{literal_id=" << literal_index << "}";
@@ -11583,6 +11901,73 @@ void DependentCode::DeoptimizeDependentCodeGroup(
 }
 
 
+static bool CodeDependsOnFieldType(Code* code, int descriptor) {
+  FixedArray* data = code->deoptimization_data();
+  if (data->length() == 0) return true;
+  Object* mask =
+      DeoptimizationInputData::cast(data)->FieldTypeDependencies();
+  if (!mask->IsSmi()) return true;
+  return (Smi::cast(mask)->value() &
+          DependentCode::FieldTypeMaskFor(descriptor)) != 0;
+}
+
+
+bool DependentCode::MarkFieldTypeCodeForDeoptimization(Isolate* isolate,
+                                                       int descriptor) {
+  DisallowHeapAllocation no_allocation_scope;
+  DependentCode::GroupStartIndexes starts(this);
+  int start = starts.at(kFieldTypeGroup);
+  int end = starts.at(kFieldTypeGroup + 1);
+  int code_entries = starts.number_of_entries();
+  if (start == end) return false;
+
+  // Mark the code that depends on the field and keep the rest of the group
+  // at its start. Compilations in flight do not know their fields yet and
+  // are always aborted.
+  bool marked = false;
+  int kept = start;
+  for (int i = start; i < end; i++) {
+    if (is_code_at(i)) {
+      Code* code = code_at(i);
+      if (!CodeDependsOnFieldType(code, descriptor)) {
+        if (kept != i) copy(i, kept);
+        kept++;
+        continue;
+      }
+      if (!code->marked_for_deoptimization()) {
+        SetMarkedForDeoptimization(code, kFieldTypeGroup);
+        marked = true;
+      }
+    } else {
+      CompilationInfo* info = compilation_info_at(i);
+      info->AbortDueToDependencyChange();
+    }
+  }
+  int removed = end - kept;
+  if (removed == 0) return marked;
+  // Compact the array by moving all subsequent groups to fill in the new holes.
+  for (int src = end, dst = kept; src < code_entries; src++, dst++) {
+    copy(src, dst);
+  }
+  // Now the holes are at the end of the array, zap them for heap-verifier.
+  for (int i = code_entries - removed; i < code_entries; i++) {
+    clear_at(i);
+  }
+  set_number_of_entries(kFieldTypeGroup, kept - start);
+  return marked;
+}
+
+
+void DependentCode::DeoptimizeDependentFieldTypeCode(Isolate* isolate,
+                                                     int descriptor) {
+  DCHECK(AllowCodeDependencyChange::IsAllowed());
+  DisallowHeapAllocation no_allocation_scope;
+  bool marked = MarkFieldTypeCodeForDeoptimization(isolate, descriptor);
+
+  if (marked) Deoptimizer::DeoptimizeMarkedCode(isolate);
+}
+
+
 void DependentCode::AddToDependentICList(Handle<Code> stub) {
   DisallowHeapAllocation no_heap_allocation;
   GroupStartIndexes starts(this);
@@ -13553,10 +13938,13 @@ int JSObject::GetEnumElementKeys(FixedArray* storage) {
 
 
 // StringSharedKeys are used as keys in the eval cache.
+// StringSharedKey used for the script and eval compilation caches. The
+// outer shared function info is undefined for scripts that are shared
+// across contexts.
 class StringSharedKey : public HashTableKey {
  public:
   StringSharedKey(Handle<String> source,
-                  Handle<SharedFunctionInfo> shared,
+                  Handle<Object> shared,
                   StrictMode strict_mode,
                   int scope_position)
       : source_(source),
@@ -13568,8 +13956,7 @@ class StringSharedKey : public HashTableKey {
     DisallowHeapAllocation no_allocation;
     if (!other->IsFixedArray()) return false;
     FixedArray* other_array = FixedArray::cast(other);
-    SharedFunctionInfo* shared = SharedFunctionInfo::cast(other_array->get(0));
-    if (shared != *shared_) return false;
+    if (other_array->get(0) != *shared_) return false;
     int strict_unchecked = Smi::cast(other_array->get(2))->value();
     DCHECK(strict_unchecked == SLOPPY || strict_unchecked == STRICT);
     StrictMode strict_mode = static_cast<StrictMode>(strict_unchecked);
@@ -13581,17 +13968,19 @@ class StringSharedKey : public HashTableKey {
   }
 
   static uint32_t StringSharedHashHelper(String* source,
-                                         SharedFunctionInfo* shared,
+                                         Object* shared,
                                          StrictMode strict_mode,
                                          int scope_position) {
     uint32_t hash = source->Hash();
-    if (shared->HasSourceCode()) {
+    if (shared->IsSharedFunctionInfo() &&
+        SharedFunctionInfo::cast(shared)->HasSourceCode()) {
       // Instead of using the SharedFunctionInfo pointer in the hash
       // code computation, we use a combination of the hash of the
       // script source code and the start position of the calling scope.
       // We do this to ensure that the cache entries can survive garbage
       // collection.
-      Script* script(Script::cast(shared->script()));
+      Script* script(
+          Script::cast(SharedFunctionInfo::cast(shared)->script()));
       hash ^= String::cast(script->source())->Hash();
       if (strict_mode == STRICT) hash ^= 0x8000;
       hash += scope_position;
@@ -13607,7 +13996,7 @@ class StringSharedKey : public HashTableKey {
   uint32_t HashForObject(Object* obj) OVERRIDE {
     DisallowHeapAllocation no_allocation;
     FixedArray* other_array = FixedArray::cast(obj);
-    SharedFunctionInfo* shared = SharedFunctionInfo::cast(other_array->get(0));
+    Object* shared = other_array->get(0);
     String* source = String::cast(other_array->get(1));
     int strict_unchecked = Smi::cast(other_array->get(2))->value();
     DCHECK(strict_unchecked == SLOPPY || strict_unchecked == STRICT);
@@ -13629,7 +14018,7 @@ class StringSharedKey : public HashTableKey {
 
  private:
   Handle<String> source_;
-  Handle<SharedFunctionInfo> shared_;
+  Handle<Object> shared_;
   StrictMode strict_mode_;
   int scope_position_;
 };
@@ -14721,6 +15110,12 @@ Handle<String> StringTable::LookupKey(Isolate* isolate, HashTableKey* key) {
     return handle(String::cast(table->KeyAt(entry)), isolate);
   }
 
+  // Strings are only ever removed from the table by the garbage collector.
+  // Shrink the table if it removed most of them.
+  if (table->NumberOfDeletedElements() > 0) {
+    table = StringTable::Shrink(table, key);
+  }
+
   // Adding new string. Grow table if needed.
   table = StringTable::EnsureCapacity(table, 1, key);
 
@@ -14740,10 +15135,21 @@ Handle<String> StringTable::LookupKey(Isolate* isolate, HashTableKey* key) {
 }
 
 
+// Top-level script code does not depend on the native context it was
+// compiled in, so scripts may optionally be shared between all contexts.
+static Handle<Object> ScriptCacheOuterKey(Isolate* isolate,
+                                          Handle<Context> context) {
+  if (FLAG_cache_scripts_across_contexts) {
+    return isolate->factory()->undefined_value();
+  }
+  return handle(context->closure()->shared(), isolate);
+}
+
+
 Handle<Object> CompilationCacheTable::Lookup(Handle<String> src,
                                              Handle<Context> context) {
   Isolate* isolate = GetIsolate();
-  Handle<SharedFunctionInfo> shared(context->closure()->shared());
+  Handle<Object> shared = ScriptCacheOuterKey(isolate, context);
   StringSharedKey key(src, shared, FLAG_use_strict ? STRICT : SLOPPY,
                       RelocInfo::kNoPosition);
   int entry = FindEntry(&key);
@@ -14780,7 +15186,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::Put(
     Handle<CompilationCacheTable> cache, Handle<String> src,
     Handle<Context> context, Handle<Object> value) {
   Isolate* isolate = cache->GetIsolate();
-  Handle<SharedFunctionInfo> shared(context->closure()->shared());
+  Handle<Object> shared = ScriptCacheOuterKey(isolate, context);
   StringSharedKey key(src, shared, FLAG_use_strict ? STRICT : SLOPPY,
                       RelocInfo::kNoPosition);
   cache = EnsureCapacity(cache, 1, &key);
@@ -15233,6 +15639,28 @@ void NameDictionary::CopyEnumKeysTo(FixedArray* storage) {
      }
   }
   CHECK_EQ(length, properties);
+  // Enumeration indices are unique and only get sparse through deletions.
+  // If they are dense enough, order the entries by placing them directly at
+  // their enumeration index instead of sorting them.
+  int index_range = NextEnumerationIndex() - PropertyDetails::kInitialIndex;
+  if (index_range <= kMaxEnumIndexSpread * Max(length, 1)) {
+    ScopedVector<int> entries(index_range);
+    for (int i = 0; i < index_range; i++) entries[i] = kNotFound;
+    for (int i = 0; i < length; i++) {
+      int entry = Smi::cast(storage->get(i))->value();
+      int slot =
+          DetailsAt(entry).dictionary_index() - PropertyDetails::kInitialIndex;
+      DCHECK(0 <= slot && slot < index_range);
+      DCHECK_EQ(kNotFound, entries[slot]);
+      entries[slot] = entry;
+    }
+    int pos = 0;
+    for (int i = 0; i < index_range; i++) {
+      if (entries[i] != kNotFound) storage->set(pos++, KeyAt(entries[i]));
+    }
+    DCHECK_EQ(length, pos);
+    return;
+  }
   EnumIndexComparator cmp(this);
   Smi** start = reinterpret_cast<Smi**>(storage->GetFirstElementAddress());
   std::sort(start, start + length, cmp);
@@ -15661,6 +16089,23 @@ template void
 OrderedHashTable<OrderedHashMap, JSMapIterator, 2>::RemoveEntry(int entry);
 
 
+// Keys are stored in a canonical form: numbers with a Smi value are Smis
+// and strings are internalized. This lets optimized code look up Smi and
+// internalized string keys by identity.
+static Handle<Object> CanonicalOrderedHashTableKey(Isolate* isolate,
+                                                   Handle<Object> key) {
+  if (key->IsHeapNumber()) {
+    double value = HeapNumber::cast(*key)->value();
+    if (value == 0 || IsSmiDouble(value)) {
+      return handle(Smi::FromInt(static_cast<int>(value)), isolate);
+    }
+  } else if (key->IsString() && !key->IsInternalizedString()) {
+    return isolate->factory()->InternalizeString(Handle<String>::cast(key));
+  }
+  return key;
+}
+
+
 bool OrderedHashSet::Contains(Handle<Object> key) {
   return FindEntry(key) != kNotFound;
 }
@@ -15668,9 +16113,11 @@ bool OrderedHashSet::Contains(Handle<Object> key) {
 
 Handle<OrderedHashSet> OrderedHashSet::Add(Handle<OrderedHashSet> table,
                                            Handle<Object> key) {
-  int hash = GetOrCreateHash(table->GetIsolate(), key)->value();
+  Isolate* isolate = table->GetIsolate();
+  int hash = GetOrCreateHash(isolate, key)->value();
   if (table->FindEntry(key, hash) != kNotFound) return table;
 
+  key = CanonicalOrderedHashTableKey(isolate, key);
   table = EnsureGrowable(table);
 
   int index = table->AddEntry(hash);
@@ -15692,7 +16139,8 @@ Handle<OrderedHashMap> OrderedHashMap::Put(Handle<OrderedHashMap> table,
                                            Handle<Object> value) {
   DCHECK(!key->IsTheHole());
 
-  int hash = GetOrCreateHash(table->GetIsolate(), key)->value();
+  Isolate* isolate = table->GetIsolate();
+  int hash = GetOrCreateHash(isolate, key)->value();
   int entry = table->FindEntry(key, hash);
 
   if (entry != kNotFound) {
@@ -15700,6 +16148,7 @@ Handle<OrderedHashMap> OrderedHashMap::Put(Handle<OrderedHashMap> table,
     return table;
   }
 
+  key = CanonicalOrderedHashTableKey(isolate, key);
   table = EnsureGrowable(table);
 
   int index = table->AddEntry(hash);
@@ -116,6 +116,10 @@
 //             - ExternalTwoByteInternalizedString
 //       - Symbol
 //     - HeapNumber
+//     - Simd128Value
+//       - Float32x4
+//       - Int32x4
+//       - Float64x2
 //     - Cell
 //       - PropertyCell
 //     - Code
@@ -369,6 +373,9 @@ const int kStubMinorKeyBits = kSmiValueSize - kStubMajorKeyBits - 1;
                                                                 \
   V(HEAP_NUMBER_TYPE)                                           \
   V(MUTABLE_HEAP_NUMBER_TYPE)                                   \
+  V(FLOAT32X4_TYPE)                                             \
+  V(INT32X4_TYPE)                                               \
+  V(FLOAT64X2_TYPE)                                             \
   V(FOREIGN_TYPE)                                               \
   V(BYTE_ARRAY_TYPE)                                            \
   V(FREE_SPACE_TYPE)                                            \
@@ -668,6 +675,9 @@ enum InstanceType {
   // objects.
   HEAP_NUMBER_TYPE,
   MUTABLE_HEAP_NUMBER_TYPE,
+  FLOAT32X4_TYPE,  // FIRST_SIMD128_VALUE_TYPE
+  INT32X4_TYPE,
+  FLOAT64X2_TYPE,  // LAST_SIMD128_VALUE_TYPE
   FOREIGN_TYPE,
   BYTE_ARRAY_TYPE,
   FREE_SPACE_TYPE,
@@ -756,6 +766,9 @@ enum InstanceType {
   FIRST_UNIQUE_NAME_TYPE = INTERNALIZED_STRING_TYPE,
   LAST_UNIQUE_NAME_TYPE = SYMBOL_TYPE,
   FIRST_NONSTRING_TYPE = SYMBOL_TYPE,
+  // Boundaries for testing for a SIMD value.
+  FIRST_SIMD128_VALUE_TYPE = FLOAT32X4_TYPE,
+  LAST_SIMD128_VALUE_TYPE = FLOAT64X2_TYPE,
   // Boundaries for testing for an external array.
   FIRST_EXTERNAL_ARRAY_TYPE = EXTERNAL_INT8_ARRAY_TYPE,
   LAST_EXTERNAL_ARRAY_TYPE = EXTERNAL_UINT8_CLAMPED_ARRAY_TYPE,
@@ -883,6 +896,10 @@ template <class C> inline bool Is(Object* obj);
 #define HEAP_OBJECT_TYPE_LIST(V)   \
   V(HeapNumber)                    \
   V(MutableHeapNumber)             \
+  V(Simd128Value)                  \
+  V(Float32x4)                     \
+  V(Int32x4)                       \
+  V(Float64x2)                     \
   V(Name)                          \
   V(UniqueName)                    \
   V(String)                        \
@@ -1539,6 +1556,78 @@ class HeapNumber: public HeapObject {
 };
 
 
+// The SIMD value types, with the constant and name prefixes, the number of
+// lanes and the C++ type of a lane.
+#define SIMD128_TYPES(V)                          \
+  V(FLOAT32X4, Float32x4, float32x4, 4, float)    \
+  V(INT32X4, Int32x4, int32x4, 4, int32_t)        \
+  V(FLOAT64X2, Float64x2, float64x2, 2, double)
+
+
+// The 128-bit values of the SIMD.js types. Like heap numbers they are
+// immutable and compared by identity.
+class Simd128Value : public HeapObject {
+ public:
+  DECLARE_CAST(Simd128Value)
+
+  // A hash of the lanes. Values are compared by identity, so identical
+  // values trivially have the same hash.
+  inline uint32_t Hash() const;
+
+  void Simd128ValuePrint(std::ostream& os);  // NOLINT
+  DECLARE_VERIFIER(Simd128Value)
+
+  // Layout description.
+  static const int kValueOffset = HeapObject::kHeaderSize;
+  static const int kSize = kValueOffset + kSimd128Size;
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(Simd128Value);
+};
+
+
+class Float32x4 : public Simd128Value {
+ public:
+  static const int kLanes = 4;
+
+  inline float get_lane(int lane) const;
+  inline void set_lane(int lane, float value);
+
+  DECLARE_CAST(Float32x4)
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(Float32x4);
+};
+
+
+class Int32x4 : public Simd128Value {
+ public:
+  static const int kLanes = 4;
+
+  inline int32_t get_lane(int lane) const;
+  inline void set_lane(int lane, int32_t value);
+
+  DECLARE_CAST(Int32x4)
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(Int32x4);
+};
+
+
+class Float64x2 : public Simd128Value {
+ public:
+  static const int kLanes = 2;
+
+  inline double get_lane(int lane) const;
+  inline void set_lane(int lane, double value);
+
+  DECLARE_CAST(Float64x2)
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(Float64x2);
+};
+
+
 enum EnsureElementsMode {
   DONT_ALLOW_DOUBLE_ELEMENTS,
   ALLOW_COPIED_DOUBLE_ELEMENTS,
@@ -2056,7 +2145,13 @@ class JSObject: public JSReceiver {
                                        Representation representation,
                                        FieldIndex index);
   inline Object* RawFastPropertyAt(FieldIndex index);
+  inline void RawFastPropertyAtPut(FieldIndex index, Object* value);
   inline void FastPropertyAtPut(FieldIndex index, Object* value);
+
+  // Access to unboxed double fields, see Map::unboxed_double_fields.
+  inline bool IsUnboxedDoubleField(FieldIndex index);
+  inline double RawFastDoublePropertyAt(FieldIndex index);
+  inline void RawFastDoublePropertyAtPut(FieldIndex index, double value);
   void WriteToField(int descriptor, Object* value);
 
   // Access to in object properties.
@@ -2111,6 +2206,9 @@ class JSObject: public JSReceiver {
 
   DECLARE_CAST(JSObject)
 
+  // Iterates the tagged fields of the object, skipping unboxed doubles.
+  void JSObjectIterateBody(int object_size, ObjectVisitor* v);
+
   // Dispatched behavior.
   void JSObjectShortPrint(StringStream* accumulator);
   DECLARE_PRINTER(JSObject)
@@ -2211,6 +2309,10 @@ class JSObject: public JSReceiver {
                                   const char* type,
                                   Handle<Name> name,
                                   Handle<Object> old_value);
+  static void EnqueueChangeRecord(Handle<JSObject> object,
+                                  Handle<String> type,
+                                  Handle<Name> name,
+                                  Handle<Object> old_value);
 
  private:
   friend class DictionaryElementsAccessor;
@@ -3627,6 +3729,9 @@ class NameDictionary: public Dictionary<NameDictionary,
 
   // Copies enumerable keys to preallocated fixed array.
   void CopyEnumKeysTo(FixedArray* storage);
+  // Keys are ordered without sorting if the range of enumeration indices is
+  // at most this many times the number of keys.
+  static const int kMaxEnumIndexSpread = 4;
   inline static void DoGenerateNewEnumerationIndices(
       Handle<NameDictionary> dictionary);
 
@@ -3906,6 +4011,15 @@ class OrderedHashTable: public FixedArray {
   static const int kNotFound = -1;
   static const int kMinCapacity = 4;
 
+  // Layout of the table, used by optimized code to look up keys inline.
+  static const int kNumberOfBucketsIndex = 0;
+  static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
+  static const int kNumberOfDeletedElementsIndex = kNumberOfElementsIndex + 1;
+  static const int kHashTableStartIndex = kNumberOfDeletedElementsIndex + 1;
+
+  static const int kEntrySize = entrysize + 1;
+  static const int kChainOffset = entrysize;
+
  private:
   static Handle<Derived> Rehash(Handle<Derived> table, int new_capacity);
 
@@ -3947,17 +4061,9 @@ class OrderedHashTable: public FixedArray {
     return set(kRemovedHolesIndex + index, Smi::FromInt(removed_index));
   }
 
-  static const int kNumberOfBucketsIndex = 0;
-  static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
-  static const int kNumberOfDeletedElementsIndex = kNumberOfElementsIndex + 1;
-  static const int kHashTableStartIndex = kNumberOfDeletedElementsIndex + 1;
-
   static const int kNextTableIndex = kNumberOfElementsIndex;
   static const int kRemovedHolesIndex = kHashTableStartIndex;
 
-  static const int kEntrySize = entrysize + 1;
-  static const int kChainOffset = entrysize;
-
   static const int kLoadFactor = 2;
   static const int kMaxCapacity =
       (FixedArray::kMaxLength - kHashTableStartIndex)
@@ -3997,7 +4103,6 @@ class OrderedHashMap:public OrderedHashTable<
     return get(EntryToIndex(entry) + kValueOffset);
   }
 
- private:
   static const int kValueOffset = 1;
 };
 
@@ -4124,6 +4229,10 @@ class ScopeInfo : public FixedArray {
   //  2. One stack slot for the function name if it is stack allocated.
   int StackSlotCount();
 
+  // Return the frame slot of the first stack local. This is 0 except for
+  // block scopes whose locals live in the frame of the enclosing function.
+  int StackLocalFirstSlot();
+
   // Return the number of context slots for code if a context is allocated. This
   // number consists of three parts:
   //  1. Size of fixed header for every context: Context::MIN_CONTEXT_SLOTS
@@ -4261,28 +4370,31 @@ class ScopeInfo : public FixedArray {
   //    slot is used per parameter, so in total this part occupies
   //    ParameterCount() slots in the array. For other scopes than function
   //    scopes ParameterCount() is 0.
-  // 2. StackLocalEntries:
+  // 2. StackLocalFirstSlot:
+  //    The frame slot of the first stack local. It always occupies one slot.
+  // 3. StackLocalEntries:
   //    Contains the names of local variables that are allocated on the stack,
   //    in increasing order of the stack slot index. One slot is used per stack
   //    local, so in total this part occupies StackLocalCount() slots in the
   //    array.
-  // 3. ContextLocalNameEntries:
+  // 4. ContextLocalNameEntries:
   //    Contains the names of local variables and parameters that are allocated
   //    in the context. They are stored in increasing order of the context slot
   //    index starting with Context::MIN_CONTEXT_SLOTS. One slot is used per
   //    context local, so in total this part occupies ContextLocalCount() slots
   //    in the array.
-  // 4. ContextLocalInfoEntries:
+  // 5. ContextLocalInfoEntries:
   //    Contains the variable modes and initialization flags corresponding to
   //    the context locals in ContextLocalNameEntries. One slot is used per
   //    context local, so in total this part occupies ContextLocalCount()
   //    slots in the array.
-  // 5. FunctionNameEntryIndex:
+  // 6. FunctionNameEntryIndex:
   //    If the scope belongs to a named function expression this part contains
   //    information about the function variable. It always occupies two array
   //    slots:  a. The name of the function variable.
   //            b. The context or stack slot index for the variable.
   int ParameterEntriesIndex();
+  int StackLocalFirstSlotIndex();
   int StackLocalEntriesIndex();
   int ContextLocalNameEntriesIndex();
   int ContextLocalInfoEntriesIndex();
@@ -4800,7 +4912,8 @@ class DeoptimizationInputData: public FixedArray {
   static const int kOsrPcOffsetIndex = 4;
   static const int kOptimizationIdIndex = 5;
   static const int kSharedFunctionInfoIndex = 6;
-  static const int kFirstDeoptEntryIndex = 7;
+  static const int kFieldTypeDependenciesIndex = 7;
+  static const int kFirstDeoptEntryIndex = 8;
 
   // Offsets of deopt entry elements relative to the start of the entry.
   static const int kAstIdRawOffset = 0;
@@ -4825,6 +4938,9 @@ class DeoptimizationInputData: public FixedArray {
   DEFINE_ELEMENT_ACCESSORS(OsrPcOffset, Smi)
   DEFINE_ELEMENT_ACCESSORS(OptimizationId, Smi)
   DEFINE_ELEMENT_ACCESSORS(SharedFunctionInfo, Object)
+  // Smi mask of the fields the code depends on, see
+  // DependentCode::FieldTypeMaskFor. Undefined means all fields.
+  DEFINE_ELEMENT_ACCESSORS(FieldTypeDependencies, Object)
 
 #undef DEFINE_ELEMENT_ACCESSORS
 
@@ -4995,6 +5111,10 @@ class Code: public HeapObject {
   // [deoptimization_data]: Array containing data for deopt.
   DECL_ACCESSORS(deoptimization_data, FixedArray)
 
+  // [source_position_table]: Byte array mapping code offsets to source
+  // positions, see source-position-table.h.
+  DECL_ACCESSORS(source_position_table, ByteArray)
+
   // [raw_type_feedback_info]: This field stores various things, depending on
   // the kind of the code object.
   //   FUNCTION           => type feedback information.
@@ -5104,6 +5224,12 @@ class Code: public HeapObject {
   inline bool is_compiled_optimizable();
   inline void set_compiled_optimizable(bool value);
 
+  // [hot_in_previous_run]: For FUNCTION kind, tells if the function got
+  // optimized in a previous run according to the tiering hints of its
+  // script. The runtime profiler optimizes such functions earlier.
+  inline bool hot_in_previous_run();
+  inline void set_hot_in_previous_run(bool value);
+
   // [allow_osr_at_loop_nesting_level]: For FUNCTION kind, tells for
   // how long the function has been marked for OSR and therefore which
   // level of loop nesting we are willing to do on-stack replacement
@@ -5138,7 +5264,7 @@ class Code: public HeapObject {
   inline bool back_edges_patched_for_osr();
 
   // [to_boolean_foo]: For kind TO_BOOLEAN_IC tells what state the stub is in.
-  inline byte to_boolean_state();
+  inline uint16_t to_boolean_state();
 
   // [has_function_cache]: For kind STUB tells whether there is a function
   // cache is passed to the stub.
@@ -5321,6 +5447,9 @@ class Code: public HeapObject {
   }
 
   void PrintDeoptLocation(FILE* out, int bailout_id);
+  // Returns the code comment describing the given deoptimization point, or
+  // NULL if the code was compiled without --code-comments.
+  const char* GetDeoptLocationComment(int bailout_id);
   bool CanDeoptAt(Address pc);
 
 #ifdef VERIFY_HEAP
@@ -5350,9 +5479,11 @@ class Code: public HeapObject {
   static const int kHandlerTableOffset = kRelocationInfoOffset + kPointerSize;
   static const int kDeoptimizationDataOffset =
       kHandlerTableOffset + kPointerSize;
+  static const int kSourcePositionTableOffset =
+      kDeoptimizationDataOffset + kPointerSize;
   // For FUNCTION kind, we store the type feedback info here.
   static const int kTypeFeedbackInfoOffset =
-      kDeoptimizationDataOffset + kPointerSize;
+      kSourcePositionTableOffset + kPointerSize;
   static const int kNextCodeLinkOffset = kTypeFeedbackInfoOffset + kPointerSize;
   static const int kGCMetadataOffset = kNextCodeLinkOffset + kPointerSize;
   static const int kICAgeOffset =
@@ -5380,6 +5511,7 @@ class Code: public HeapObject {
       public BitField<bool, 0, 1> {};  // NOLINT
   class FullCodeFlagsHasDebugBreakSlotsField: public BitField<bool, 1, 1> {};
   class FullCodeFlagsIsCompiledOptimizable: public BitField<bool, 2, 1> {};
+  class FullCodeFlagsHotInPreviousRunField: public BitField<bool, 3, 1> {};
 
   static const int kProfilerTicksOffset = kFullCodeFlags + 1;
 
@@ -5559,6 +5691,19 @@ class DependentCode: public FixedArray {
 
   bool MarkCodeForDeoptimization(Isolate* isolate,
                                  DependentCode::DependencyGroup group);
+
+  // Code in the kFieldTypeGroup records the fields it relies on as a mask of
+  // descriptor indices in its deoptimization data. Generalizing the type of
+  // one field only deoptimizes the code whose mask covers that field; the
+  // mask wraps around, so large descriptor indices may share a bit.
+  static const int kFieldTypeMaskBits = 30;
+  static int FieldTypeMaskFor(int descriptor) {
+    return 1 << (descriptor % kFieldTypeMaskBits);
+  }
+
+  void DeoptimizeDependentFieldTypeCode(Isolate* isolate, int descriptor);
+
+  bool MarkFieldTypeCodeForDeoptimization(Isolate* isolate, int descriptor);
   void AddToDependentICList(Handle<Code> stub);
 
   // The following low-level accessors should only be used by this class
@@ -5781,6 +5926,9 @@ class Map: public HeapObject {
   bool DictionaryElementsInPrototypeChainOnly();
 
   inline bool HasTransitionArray() const;
+  // Stores the back pointer in place of a transition array that has neither
+  // transitions nor prototype transitions left. Only used by the GC.
+  inline void RemoveEmptyTransitionArray();
   inline bool HasElementsTransition();
   inline Map* elements_transition_map();
 
@@ -5877,6 +6025,28 @@ class Map: public HeapObject {
   // [dependent code]: list of optimized codes that weakly embed this map.
   DECL_ACCESSORS(dependent_code, DependentCode)
 
+  // [unboxed double fields]: bitmap of the in-object properties that hold a
+  // raw double value instead of a tagged pointer, bit i stands for in-object
+  // property i. Always empty unless V8_DOUBLE_FIELDS_UNBOXING is enabled.
+  inline int unboxed_double_fields();
+  inline void set_unboxed_double_fields(int value);
+  inline bool HasUnboxedDoubleFields();
+  inline bool IsUnboxedDoubleField(FieldIndex index);
+  inline bool IsUnboxedDoubleInObjectProperty(int index);
+  inline bool IsUnboxedDoubleFieldOffset(int offset);
+
+  // Returns whether the slot at |offset| of an instance of this map holds a
+  // tagged value and stores in |run_end| the end offset (bounded by
+  // |end_offset|) of the run of slots starting at |offset| that are all
+  // tagged or all raw. Used by the GC to visit only the tagged slots.
+  inline bool IsTaggedRun(int offset, int end_offset, int* run_end);
+
+  // Computes the unboxed double fields bitmap after the own descriptors of
+  // this map have been installed. Fields that |parent| already describes with
+  // the same field index keep their layout, so instances can transition from
+  // |parent| to this map by just swapping the map.
+  void UpdateUnboxedDoubleFields(Map* parent);
+
   // [back pointer]: points back to the parent map from which a transition
   // leads to this map. The field overlaps with prototype transitions and the
   // back pointer will be moved into the prototype transitions array if
@@ -6182,6 +6352,9 @@ class Map: public HeapObject {
 
   static const int kMaxPreAllocatedPropertyFields = 255;
 
+  // The unboxed double fields bitmap is a Smi.
+  static const int kMaxUnboxedDoubleFields = 31;
+
   // Layout description.
   static const int kInstanceSizesOffset = HeapObject::kHeaderSize;
   static const int kInstanceAttributesOffset = kInstanceSizesOffset + kIntSize;
@@ -6198,7 +6371,13 @@ class Map: public HeapObject {
       kTransitionsOrBackPointerOffset + kPointerSize;
   static const int kCodeCacheOffset = kDescriptorsOffset + kPointerSize;
   static const int kDependentCodeOffset = kCodeCacheOffset + kPointerSize;
+#if V8_DOUBLE_FIELDS_UNBOXING
+  static const int kUnboxedDoubleFieldsOffset =
+      kDependentCodeOffset + kPointerSize;
+  static const int kSize = kUnboxedDoubleFieldsOffset + kPointerSize;
+#else
   static const int kSize = kDependentCodeOffset + kPointerSize;
+#endif
 
   // Layout of pointer fields. Heap iteration code relies on them
   // being continuously allocated.
@@ -6456,6 +6635,15 @@ class Script: public Struct {
   // [source_url]: sourceMappingURL magic comment
   DECL_ACCESSORS(source_mapping_url, Object)
 
+  // [pretenuring_hints]: pretenuring decisions preloaded from a code cache,
+  // or undefined. See CodeSerializer::DeserializePretenuringDecisions.
+  DECL_ACCESSORS(pretenuring_hints, Object)
+
+  // [tiering_hints]: start positions of the functions that got optimized in
+  // a previous run, preloaded from a code cache, or undefined. See
+  // CodeSerializer::DeserializeTieringHints.
+  DECL_ACCESSORS(tiering_hints, Object)
+
   // [compilation_type]: how the the script was compiled. Encoded in the
   // 'flags' field.
   inline CompilationType compilation_type();
@@ -6515,7 +6703,11 @@ class Script: public Struct {
       kEvalFrominstructionsOffsetOffset + kPointerSize;
   static const int kSourceUrlOffset = kFlagsOffset + kPointerSize;
   static const int kSourceMappingUrlOffset = kSourceUrlOffset + kPointerSize;
-  static const int kSize = kSourceMappingUrlOffset + kPointerSize;
+  static const int kPretenuringHintsOffset =
+      kSourceMappingUrlOffset + kPointerSize;
+  static const int kTieringHintsOffset =
+      kPretenuringHintsOffset + kPointerSize;
+  static const int kSize = kTieringHintsOffset + kPointerSize;
 
  private:
   int GetLineNumberWithArray(int code_pos);
@@ -6671,6 +6863,8 @@ class SharedFunctionInfo: public HeapObject {
   DECL_ACCESSORS(function_data, Object)
 
   inline bool IsApiFunction();
+  // Whether the debugger has set up break points in the function.
+  inline bool HasDebugInfo();
   inline FunctionTemplateInfo* get_api_func_data();
   inline bool HasBuiltinFunctionId();
   inline BuiltinFunctionId builtin_function_id();
@@ -6796,6 +6990,15 @@ class SharedFunctionInfo: public HeapObject {
   // Indicates that code for this function cannot be flushed.
   DECL_BOOLEAN_ACCESSORS(dont_flush)
 
+  // Indicates that the code of this function was flushed and has not been
+  // compiled again since.
+  DECL_BOOLEAN_ACCESSORS(code_flushed)
+
+  // Indicates that the arguments object of this function escapes, so that
+  // optimized code has to allocate it instead of keeping the arguments on
+  // the stack.
+  DECL_BOOLEAN_ACCESSORS(materialize_arguments)
+
   // Indicates that this function is a generator.
   DECL_BOOLEAN_ACCESSORS(is_generator)
 
@@ -6866,6 +7069,9 @@ class SharedFunctionInfo: public HeapObject {
   // Check whether or not this function is inlineable.
   bool IsInlineable();
 
+  // Whether the tiering hints of the script name this function.
+  bool HasTieringHint();
+
   // Source size of this function.
   int SourceSize();
 
@@ -7040,6 +7246,8 @@ class SharedFunctionInfo: public HeapObject {
     kIsGenerator,
     kIsConciseMethod,
     kIsAsmFunction,
+    kCodeFlushed,
+    kMaterializeArguments,
     kCompilerHintsCount  // Pseudo entry
   };
 
@@ -7139,6 +7347,10 @@ class JSGeneratorObject: public JSObject {
   inline int stack_handler_index() const;
   inline void set_stack_handler_index(int stack_handler_index);
 
+  // [spare_operand_stack]: Operand stack array of the previous suspension,
+  // cleared and kept for reuse by the next suspension of the same height.
+  DECL_ACCESSORS(spare_operand_stack, FixedArray)
+
   DECLARE_CAST(JSGeneratorObject)
 
   // Dispatched behavior.
@@ -7157,7 +7369,9 @@ class JSGeneratorObject: public JSObject {
   static const int kOperandStackOffset = kContinuationOffset + kPointerSize;
   static const int kStackHandlerIndexOffset =
       kOperandStackOffset + kPointerSize;
-  static const int kSize = kStackHandlerIndexOffset + kPointerSize;
+  static const int kSpareOperandStackOffset =
+      kStackHandlerIndexOffset + kPointerSize;
+  static const int kSize = kSpareOperandStackOffset + kPointerSize;
 
   // Resume mode, for use by runtime functions.
   enum ResumeMode { NEXT, THROW };
@@ -7834,8 +8048,14 @@ class JSRegExp: public JSObject {
   static const int kIrregexpMaxRegisterCountIndex = kDataIndex + 4;
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 5;
+  // Program for the non-backtracking matcher (see regexp-nfa.h) as a
+  // ByteArray, or a Smi if the regexp is matched by Irregexp.
+  static const int kIrregexpNfaProgramIndex = kDataIndex + 6;
+  // The character every match starts with, or -1 if that is not known. Used
+  // to skip ahead in the subject before running the matcher.
+  static const int kIrregexpLeadingCharacterIndex = kDataIndex + 7;
 
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  static const int kIrregexpDataSize = kIrregexpLeadingCharacterIndex + 1;
 
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
@@ -8400,24 +8620,37 @@ class StringHasher {
   // Returns the value to store in the hash field of a string with
   // the given length and contents.
   uint32_t GetHashField();
-  // Returns true if the hash of this string can be computed without
-  // looking at the contents.
-  inline bool has_trivial_hash();
   // Adds a block of characters to the hash.
   template<typename Char>
   inline void AddCharacters(const Char* chars, int len);
 
  private:
+  // Characters past the first String::kMaxHashCalcLength ones are hashed
+  // a block of this many at a time, which is much cheaper per character
+  // than the one-at-a-time hash used for the prefix.
+  static const int kLongBlockLength = 4;
+
   // Add a character to the hash.
   inline void AddCharacter(uint16_t c);
   // Update index. Returns true if string is still an index.
   inline bool UpdateIndex(uint16_t c);
+  // Add characters that follow the first String::kMaxHashCalcLength ones.
+  template<typename Char>
+  inline void AddLongCharacters(const Char* chars, int len);
+  inline void AddLongCharacter(uint16_t c);
+  static inline uint64_t AddLongBlock(uint64_t running_hash, uint64_t block);
+  // Combines the hash of the prefix with the hash of the remaining blocks.
+  uint32_t GetLongHash();
 
   int length_;
+  int added_length_;
   uint32_t raw_running_hash_;
   uint32_t array_index_;
   bool is_array_index_;
   bool is_first_char_;
+  uint64_t long_running_hash_;
+  uint64_t long_block_;
+  int long_block_length_;
   DISALLOW_COPY_AND_ASSIGN(StringHasher);
 };
 
@@ -9598,6 +9831,12 @@ class JSProxy: public JSReceiver {
       Handle<Object> derived_trap,
       int argc,
       Handle<Object> args[]);
+  MUST_USE_RESULT static MaybeHandle<Object> CallTrap(
+      Handle<JSProxy> proxy,
+      Handle<String> trap_name,
+      Handle<Object> derived_trap,
+      int argc,
+      Handle<Object> args[]);
 
   // Dispatched behavior.
   DECLARE_PRINTER(JSProxy)
@@ -9893,6 +10132,11 @@ class JSArrayBuffer: public JSObject {
   inline bool should_be_freed();
   inline void set_should_be_freed(bool value);
 
+  // A shared buffer may be in use by several isolates at once, so it is
+  // never neutered.
+  inline bool is_shared();
+  inline void set_is_shared(bool value);
+
   // [weak_next]: linked list of array buffers.
   DECL_ACCESSORS(weak_next, Object)
 
@@ -9922,6 +10166,7 @@ class JSArrayBuffer: public JSObject {
   // Bit position in a flag
   static const int kIsExternalBit = 0;
   static const int kShouldBeFreed = 1;
+  static const int kIsShared = 2;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSArrayBuffer);
 };
@@ -10420,6 +10665,12 @@ class InterceptorInfo: public Struct {
   DECL_ACCESSORS(deleter, Object)
   DECL_ACCESSORS(enumerator, Object)
   DECL_ACCESSORS(data, Object)
+  DECL_ACCESSORS(flag, Smi)
+
+  // Following properties use flag bits.
+  // If the bit is set, the interceptor is not called for names that are
+  // properties of the holder itself.
+  DECL_BOOLEAN_ACCESSORS(non_masking)
 
   DECLARE_CAST(InterceptorInfo)
 
@@ -10433,9 +10684,13 @@ class InterceptorInfo: public Struct {
   static const int kDeleterOffset = kQueryOffset + kPointerSize;
   static const int kEnumeratorOffset = kDeleterOffset + kPointerSize;
   static const int kDataOffset = kEnumeratorOffset + kPointerSize;
-  static const int kSize = kDataOffset + kPointerSize;
+  static const int kFlagOffset = kDataOffset + kPointerSize;
+  static const int kSize = kFlagOffset + kPointerSize;
 
  private:
+  // Bit position in the flag, from least significant bit position.
+  static const int kNonMaskingBit = 0;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(InterceptorInfo);
 };
 
@@ -10493,6 +10748,10 @@ class FunctionTemplateInfo: public TemplateInfo {
   DECL_ACCESSORS(instance_call_handler, Object)
   DECL_ACCESSORS(access_check_info, Object)
   DECL_ACCESSORS(flag, Smi)
+  // A Foreign wrapping the v8::FastCallHandler, if one was set, and the
+  // encoded types of its parameters and return value.
+  DECL_ACCESSORS(fast_call_handler, Object)
+  DECL_ACCESSORS(fast_call_signature, Object)
 
   inline int length() const;
   inline void set_length(int value);
@@ -10532,12 +10791,40 @@ class FunctionTemplateInfo: public TemplateInfo {
       kInstanceCallHandlerOffset + kPointerSize;
   static const int kFlagOffset = kAccessCheckInfoOffset + kPointerSize;
   static const int kLengthOffset = kFlagOffset + kPointerSize;
-  static const int kSize = kLengthOffset + kPointerSize;
+  static const int kFastCallHandlerOffset = kLengthOffset + kPointerSize;
+  static const int kFastCallSignatureOffset =
+      kFastCallHandlerOffset + kPointerSize;
+  static const int kSize = kFastCallSignatureOffset + kPointerSize;
 
   // Returns true if |object| is an instance of this function template.
   bool IsTemplateFor(Object* object);
   bool IsTemplateFor(Map* map);
 
+  // The fast call signature holds the return type, the number of
+  // parameters and the type of each parameter in consecutive bit fields.
+  class FastCallReturnTypeBits : public BitField<int, 0, 3> {};
+  class FastCallParameterCountBits : public BitField<int, 3, 3> {};
+  static const int kFastCallParameterTypeShift = 6;
+  static const int kFastCallParameterTypeBits = 3;
+
+  static int EncodeFastCallSignature(int return_type, int parameter_count,
+                                     const v8::FastCallType* parameter_types) {
+    int signature = FastCallReturnTypeBits::encode(return_type) |
+                    FastCallParameterCountBits::encode(parameter_count);
+    for (int i = 0; i < parameter_count; i++) {
+      signature |= parameter_types[i] << (kFastCallParameterTypeShift +
+                                          i * kFastCallParameterTypeBits);
+    }
+    return signature;
+  }
+
+  static v8::FastCallType FastCallParameterType(int signature, int index) {
+    int shift =
+        kFastCallParameterTypeShift + index * kFastCallParameterTypeBits;
+    return static_cast<v8::FastCallType>(
+        (signature >> shift) & ((1 << kFastCallParameterTypeBits) - 1));
+  }
+
  private:
   // Bit position in the flag, from least significant bit position.
   static const int kHiddenPrototypeBit   = 0;
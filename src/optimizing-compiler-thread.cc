@@ -18,6 +18,7 @@ namespace internal {
 OptimizingCompilerThread::~OptimizingCompilerThread() {
   DCHECK_EQ(0, input_queue_length_);
   DeleteArray(input_queue_);
+  DeleteArray(input_queue_priorities_);
   if (FLAG_concurrent_osr) {
 #ifdef DEBUG
     for (int i = 0; i < osr_buffer_capacity_; i++) {
@@ -29,6 +30,37 @@ OptimizingCompilerThread::~OptimizingCompilerThread() {
 }
 
 
+class OptimizingCompilerThread::CompileTask : public v8::Task {
+ public:
+  explicit CompileTask(Isolate* isolate) : isolate_(isolate) {}
+
+  virtual ~CompileTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() OVERRIDE {
+    Isolate::SetIsolateThreadLocals(isolate_, NULL);
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+
+    OptimizingCompilerThread* thread = isolate_->optimizing_compiler_thread();
+    OptimizedCompileJob* job;
+    while ((job = thread->NextInputForTask()) != NULL) {
+      TimerEventScope<TimerEventRecompileConcurrent> timer(isolate_);
+      if (FLAG_concurrent_recompilation_delay != 0) {
+        base::OS::Sleep(FLAG_concurrent_recompilation_delay);
+      }
+      thread->CompileNext(job);
+    }
+  }
+
+  Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompileTask);
+};
+
+
 void OptimizingCompilerThread::Run() {
 #ifdef DEBUG
   { base::LockGuard<base::Mutex> lock_guard(&thread_id_mutex_);
@@ -75,7 +107,7 @@ void OptimizingCompilerThread::Run() {
     base::ElapsedTimer compiling_timer;
     if (FLAG_trace_concurrent_recompilation) compiling_timer.Start();
 
-    CompileNext();
+    CompileNext(NextInput());
 
     if (FLAG_trace_concurrent_recompilation) {
       time_spent_compiling_ += compiling_timer.Elapsed();
@@ -95,8 +127,45 @@ OptimizedCompileJob* OptimizingCompilerThread::NextInput() {
 }
 
 
-void OptimizingCompilerThread::CompileNext() {
-  OptimizedCompileJob* job = NextInput();
+OptimizedCompileJob* OptimizingCompilerThread::NextInputForTask() {
+  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+  if (input_queue_length_ == 0 ||
+      static_cast<StopFlag>(base::Acquire_Load(&stop_thread_)) != CONTINUE) {
+    // Retire under the same lock QueueForOptimization holds while deciding
+    // whether to post a task, so that no queued job is left behind.
+    DCHECK_LT(0, running_tasks_);
+    if (--running_tasks_ == 0) tasks_retired_.NotifyAll();
+    return NULL;
+  }
+  OptimizedCompileJob* job = input_queue_[InputQueueIndex(0)];
+  DCHECK_NE(NULL, job);
+  input_queue_shift_ = InputQueueIndex(1);
+  input_queue_length_--;
+  return job;
+}
+
+
+void OptimizingCompilerThread::PostCompileTaskIfNeeded() {
+  DCHECK(job_based());
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    if (running_tasks_ >= max_tasks_) return;
+    running_tasks_++;
+  }
+  V8::GetCurrentPlatform()->CallOnBackgroundThreadWithPriority(
+      reinterpret_cast<v8::Isolate*>(isolate_), new CompileTask(isolate_),
+      v8::Platform::kShortRunningTask, v8::Platform::kUserVisiblePriority);
+}
+
+
+void OptimizingCompilerThread::WaitForCompileTasks() {
+  DCHECK(job_based());
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  while (running_tasks_ > 0) tasks_retired_.Wait(&input_queue_mutex_);
+}
+
+
+void OptimizingCompilerThread::CompileNext(OptimizedCompileJob* job) {
   DCHECK_NE(NULL, job);
 
   // The function may have already been optimized by OSR.  Simply continue.
@@ -105,8 +174,7 @@ void OptimizingCompilerThread::CompileNext() {
   DCHECK(status != OptimizedCompileJob::FAILED);
 
   // The function may have already been optimized by OSR.  Simply continue.
-  // Use a mutex to make sure that functions marked for install
-  // are always also queued.
+  // The output queue takes jobs from all compile tasks without locking.
   output_queue_.Enqueue(job);
   isolate_->stack_guard()->RequestInstallCode();
 }
@@ -138,7 +206,7 @@ void OptimizingCompilerThread::FlushInputQueue(bool restore_function_code) {
   while ((job = NextInput())) {
     // This should not block, since we have one signal on the input queue
     // semaphore corresponding to each element in the input queue.
-    input_queue_semaphore_.Wait();
+    if (!job_based()) input_queue_semaphore_.Wait();
     // OSR jobs are dealt with separately.
     if (!job->info()->is_osr()) {
       DisposeOptimizedCompileJob(job, restore_function_code);
@@ -172,8 +240,16 @@ void OptimizingCompilerThread::Flush() {
   DCHECK(!IsOptimizerThread());
   base::Release_Store(&stop_thread_, static_cast<base::AtomicWord>(FLUSH));
   if (FLAG_block_concurrent_recompilation) Unblock();
-  input_queue_semaphore_.Signal();
-  stop_semaphore_.Wait();
+  if (job_based()) {
+    // Running tasks finish their current job and retire.
+    WaitForCompileTasks();
+    FlushInputQueue(true);
+    base::Release_Store(&stop_thread_,
+                        static_cast<base::AtomicWord>(CONTINUE));
+  } else {
+    input_queue_semaphore_.Signal();
+    stop_semaphore_.Wait();
+  }
   FlushOutputQueue(true);
   if (FLAG_concurrent_osr) FlushOsrBuffer(true);
   if (FLAG_trace_concurrent_recompilation) {
@@ -186,13 +262,17 @@ void OptimizingCompilerThread::Stop() {
   DCHECK(!IsOptimizerThread());
   base::Release_Store(&stop_thread_, static_cast<base::AtomicWord>(STOP));
   if (FLAG_block_concurrent_recompilation) Unblock();
-  input_queue_semaphore_.Signal();
-  stop_semaphore_.Wait();
+  if (job_based()) {
+    WaitForCompileTasks();
+  } else {
+    input_queue_semaphore_.Signal();
+    stop_semaphore_.Wait();
+  }
 
   if (FLAG_concurrent_recompilation_delay != 0) {
     // At this point the optimizing compiler thread's event loop has stopped.
     // There is no need for a mutex when reading input_queue_length_.
-    while (input_queue_length_ > 0) CompileNext();
+    while (input_queue_length_ > 0) CompileNext(NextInput());
     InstallOptimizedFunctions();
   } else {
     FlushInputQueue(false);
@@ -201,7 +281,7 @@ void OptimizingCompilerThread::Stop() {
 
   if (FLAG_concurrent_osr) FlushOsrBuffer(false);
 
-  if (FLAG_trace_concurrent_recompilation) {
+  if (FLAG_trace_concurrent_recompilation && !job_based()) {
     double percentage = time_spent_compiling_.PercentOf(time_spent_total_);
     PrintF("  ** Compiler thread did %.2f%% useful work\n", percentage);
   }
@@ -211,7 +291,7 @@ void OptimizingCompilerThread::Stop() {
     PrintF("[COSR hit rate %d / %d]\n", osr_hits_, osr_attempts_);
   }
 
-  Join();
+  if (!job_based()) Join();
 }
 
 
@@ -266,16 +346,30 @@ void OptimizingCompilerThread::QueueForOptimization(OptimizedCompileJob* job) {
     // Move shift_ back by one.
     input_queue_shift_ = InputQueueIndex(input_queue_capacity_ - 1);
     input_queue_[InputQueueIndex(0)] = job;
+    input_queue_priorities_[InputQueueIndex(0)] = kMaxInt;
     input_queue_length_++;
   } else {
-    // Add job to the back of the input queue.
+    // Insert job behind all jobs for functions that are at least as hot, so
+    // that the hottest functions get optimized first during warm-up.
+    int priority = info->shared_info()->profiler_ticks();
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
+    int i = input_queue_length_;
+    while (i > 0 &&
+           input_queue_priorities_[InputQueueIndex(i - 1)] < priority) {
+      input_queue_[InputQueueIndex(i)] = input_queue_[InputQueueIndex(i - 1)];
+      input_queue_priorities_[InputQueueIndex(i)] =
+          input_queue_priorities_[InputQueueIndex(i - 1)];
+      i--;
+    }
+    input_queue_[InputQueueIndex(i)] = job;
+    input_queue_priorities_[InputQueueIndex(i)] = priority;
     input_queue_length_++;
   }
   if (FLAG_block_concurrent_recompilation) {
     blocked_jobs_++;
+  } else if (job_based()) {
+    PostCompileTaskIfNeeded();
   } else {
     input_queue_semaphore_.Signal();
   }
@@ -285,7 +379,11 @@ void OptimizingCompilerThread::QueueForOptimization(OptimizedCompileJob* job) {
 void OptimizingCompilerThread::Unblock() {
   DCHECK(!IsOptimizerThread());
   while (blocked_jobs_ > 0) {
-    input_queue_semaphore_.Signal();
+    if (job_based()) {
+      PostCompileTaskIfNeeded();
+    } else {
+      input_queue_semaphore_.Signal();
+    }
     blocked_jobs_--;
   }
 }
@@ -6,6 +6,7 @@
 #define V8_OPTIMIZING_COMPILER_THREAD_H_
 
 #include "src/base/atomicops.h"
+#include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
@@ -37,10 +38,13 @@ class OptimizingCompilerThread : public base::Thread {
         osr_buffer_cursor_(0),
         osr_hits_(0),
         osr_attempts_(0),
-        blocked_jobs_(0) {
+        blocked_jobs_(0),
+        max_tasks_(FLAG_concurrent_recompilation_tasks),
+        running_tasks_(0) {
     base::NoBarrier_Store(&stop_thread_,
                           static_cast<base::AtomicWord>(CONTINUE));
     input_queue_ = NewArray<OptimizedCompileJob*>(input_queue_capacity_);
+    input_queue_priorities_ = NewArray<int>(input_queue_capacity_);
     if (FLAG_concurrent_osr) {
       // Allocate and mark OSR buffer slots as empty.
       osr_buffer_ = NewArray<OptimizedCompileJob*>(osr_buffer_capacity_);
@@ -78,20 +82,37 @@ class OptimizingCompilerThread : public base::Thread {
     return (FLAG_concurrent_recompilation && max_available > 1);
   }
 
+  // True if recompilation jobs are run by platform background tasks instead
+  // of this thread. The thread is not started in that case.
+  bool job_based() const { return max_tasks_ > 0; }
+
 #ifdef DEBUG
+  // Only recognizes the dedicated thread, not background tasks.
   static bool IsOptimizerThread(Isolate* isolate);
   bool IsOptimizerThread();
 #endif
 
  private:
+  class CompileTask;
+
   enum StopFlag { CONTINUE, STOP, FLUSH };
 
   void FlushInputQueue(bool restore_function_code);
   void FlushOutputQueue(bool restore_function_code);
   void FlushOsrBuffer(bool restore_function_code);
-  void CompileNext();
+  void CompileNext(OptimizedCompileJob* job);
   OptimizedCompileJob* NextInput();
 
+  // Used by compile tasks. Returns NULL and retires the calling task if the
+  // input queue is empty or the queues are being stopped or flushed.
+  OptimizedCompileJob* NextInputForTask();
+
+  // Posts another compile task unless max_tasks_ tasks are already running.
+  void PostCompileTaskIfNeeded();
+
+  // Blocks until all posted compile tasks have retired.
+  void WaitForCompileTasks();
+
   // Add a recompilation task for OSR to the cyclic buffer, awaiting OSR entry.
   // Tasks evicted from the cyclic buffer are discarded.
   void AddToOsrBuffer(OptimizedCompileJob* compiler);
@@ -112,8 +133,11 @@ class OptimizingCompilerThread : public base::Thread {
   base::Semaphore stop_semaphore_;
   base::Semaphore input_queue_semaphore_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
+  // Circular queue of incoming recompilation tasks (including OSR). OSR
+  // tasks are at the front, the others are ordered by the profiler ticks of
+  // their function at the time they were queued, hottest first.
   OptimizedCompileJob** input_queue_;
+  int* input_queue_priorities_;
   int input_queue_capacity_;
   int input_queue_length_;
   int input_queue_shift_;
@@ -135,6 +159,15 @@ class OptimizingCompilerThread : public base::Thread {
   int osr_attempts_;
 
   int blocked_jobs_;
+
+  // Upper bound on concurrently running compile tasks, 0 if the dedicated
+  // thread is used.
+  int max_tasks_;
+
+  // Number of posted compile tasks that have not retired yet. Guarded by
+  // input_queue_mutex_.
+  int running_tasks_;
+  base::ConditionVariable tasks_retired_;
 };
 
 } }  // namespace v8::internal
@@ -27,6 +27,8 @@
 
 #include "src/perf-jit.h"
 
+#include "src/assembler.h"
+
 #if V8_OS_LINUX
 #include <fcntl.h>
 #include <unistd.h>
@@ -43,8 +45,19 @@ const char PerfJitLogger::kFilenameFormatString[] = "perfjit-%d.dump";
 // Extra padding for the PID in the filename
 const int PerfJitLogger::kFilenameBufferPadding = 16;
 
+// An entry of a JIT_CODE_DEBUG_INFO record as perf reads it. It is followed
+// by the null terminated name of the source file.
+struct jr_debug_entry {
+  uint64_t addr;
+  int lineno;
+  int discrim;
+};
+
 
-PerfJitLogger::PerfJitLogger() : perf_output_handle_(NULL), code_index_(0) {
+PerfJitLogger::PerfJitLogger()
+    : perf_output_handle_(NULL),
+      code_index_(0),
+      loaded_code_(AddressesMatch) {
   if (!base::TimeTicks::KernelTimestampAvailable()) {
     FATAL("Cannot profile with perf JIT - kernel timestamps not available.");
   }
@@ -65,6 +78,10 @@ PerfJitLogger::PerfJitLogger() : perf_output_handle_(NULL), code_index_(0) {
 
 
 PerfJitLogger::~PerfJitLogger() {
+  for (HashMap::Entry* p = loaded_code_.Start(); p != NULL;
+       p = loaded_code_.Next(p)) {
+    delete reinterpret_cast<LoadedCode*>(p->value);
+  }
   fclose(perf_output_handle_);
   perf_output_handle_ = NULL;
 }
@@ -76,7 +93,7 @@ uint64_t PerfJitLogger::GetTimestamp() {
 }
 
 
-void PerfJitLogger::LogRecordedBuffer(Code* code, SharedFunctionInfo*,
+void PerfJitLogger::LogRecordedBuffer(Code* code, SharedFunctionInfo* shared,
                                       const char* name, int length) {
   DCHECK(code->instruction_start() == code->address() + Code::kHeaderSize);
   DCHECK(perf_output_handle_ != NULL);
@@ -88,6 +105,9 @@ void PerfJitLogger::LogRecordedBuffer(Code* code, SharedFunctionInfo*,
 
   static const char string_terminator[] = "\0";
 
+  // perf expects the debug info of code to precede its load record.
+  if (shared != NULL) LogWriteDebugInfo(code, shared);
+
   jr_code_load code_load;
   code_load.p.id = JIT_CODE_LOAD;
   code_load.p.total_size = sizeof(code_load) + length + 1 + code_size;
@@ -99,6 +119,13 @@ void PerfJitLogger::LogRecordedBuffer(Code* code, SharedFunctionInfo*,
   code_load.code_size = code_size;
   code_load.code_index = code_index_;
 
+  HashMap::Entry* entry = loaded_code_.Lookup(
+      code_pointer, AddressHash(code_pointer), true);
+  if (entry->value == NULL) entry->value = new LoadedCode();
+  LoadedCode* loaded = reinterpret_cast<LoadedCode*>(entry->value);
+  loaded->code_size = code_size;
+  loaded->code_index = code_index_;
+
   code_index_++;
 
   LogWriteBytes(reinterpret_cast<const char*>(&code_load), sizeof(code_load));
@@ -108,9 +135,86 @@ void PerfJitLogger::LogRecordedBuffer(Code* code, SharedFunctionInfo*,
 }
 
 
+void PerfJitLogger::LogWriteDebugInfo(Code* code,
+                                      SharedFunctionInfo* shared) {
+  DisallowHeapAllocation no_allocation;
+  if (!shared->script()->IsScript()) return;
+  Script* script = Script::cast(shared->script());
+  // Line numbers are only looked up when the line ends of the script have
+  // been computed. Scanning the source for every position is too slow.
+  if (script->line_ends()->IsUndefined()) return;
+
+  List<jr_debug_entry> entries;
+  int last_line = -1;
+  for (SourcePositionTableIterator it(code->source_position_table());
+       !it.done(); it.Advance()) {
+    int line = script->GetLineNumber(it.source_position());
+    if (line < 0 || line == last_line) continue;
+    jr_debug_entry entry;
+    entry.addr = reinterpret_cast<uint64_t>(code->instruction_start() +
+                                            it.code_offset());
+    entry.lineno = line + 1;
+    entry.discrim = 0;
+    entries.Add(entry);
+    last_line = line;
+  }
+  if (entries.is_empty()) return;
+
+  SmartArrayPointer<char> file_name;
+  int file_name_length = 0;
+  if (script->name()->IsString()) {
+    file_name = String::cast(script->name())->ToCString(
+        DISALLOW_NULLS, ROBUST_STRING_TRAVERSAL, &file_name_length);
+  }
+  const char* file = file_name.get() != NULL ? file_name.get() : "";
+
+  jr_code_debug_info debug_info;
+  debug_info.p.id = JIT_CODE_DEBUG_INFO;
+  debug_info.p.total_size = sizeof(debug_info) +
+      entries.length() * (sizeof(jr_debug_entry) + file_name_length + 1);
+  debug_info.p.timestamp = GetTimestamp();
+  debug_info.code_addr = reinterpret_cast<uint64_t>(code->instruction_start());
+  debug_info.nr_entry = entries.length();
+
+  static const char string_terminator[] = "\0";
+  LogWriteBytes(reinterpret_cast<const char*>(&debug_info),
+                sizeof(debug_info));
+  for (int i = 0; i < entries.length(); i++) {
+    LogWriteBytes(reinterpret_cast<const char*>(&entries[i]),
+                  sizeof(jr_debug_entry));
+    LogWriteBytes(file, file_name_length);
+    LogWriteBytes(string_terminator, 1);
+  }
+}
+
+
 void PerfJitLogger::CodeMoveEvent(Address from, Address to) {
-  // Code relocation not supported.
-  UNREACHABLE();
+  // The events are about code objects, load records about their
+  // instructions.
+  Address old_code_addr = from + Code::kHeaderSize;
+  Address new_code_addr = to + Code::kHeaderSize;
+  HashMap::Entry* entry = loaded_code_.Lookup(
+      old_code_addr, AddressHash(old_code_addr), false);
+  if (entry == NULL) return;
+  LoadedCode* loaded = reinterpret_cast<LoadedCode*>(entry->value);
+  loaded_code_.Remove(old_code_addr, AddressHash(old_code_addr));
+
+  jr_code_move code_move;
+  code_move.p.id = JIT_CODE_MOVE;
+  code_move.p.total_size = sizeof(code_move);
+  code_move.p.timestamp = GetTimestamp();
+  code_move.pid = static_cast<uint32_t>(base::OS::GetCurrentProcessId());
+  code_move.tid = static_cast<uint32_t>(base::OS::GetCurrentThreadId());
+  code_move.vma = 0x0;  //  Our addresses are absolute.
+  code_move.old_code_addr = reinterpret_cast<uint64_t>(old_code_addr);
+  code_move.new_code_addr = reinterpret_cast<uint64_t>(new_code_addr);
+  code_move.code_size = loaded->code_size;
+  code_move.code_index = loaded->code_index;
+  LogWriteBytes(reinterpret_cast<const char*>(&code_move), sizeof(code_move));
+
+  entry = loaded_code_.Lookup(new_code_addr, AddressHash(new_code_addr), true);
+  delete reinterpret_cast<LoadedCode*>(entry->value);
+  entry->value = loaded;
 }
 
 
@@ -68,6 +68,18 @@ class PerfJitLogger : public CodeEventLogger {
 
   void LogWriteBytes(const char* bytes, int size);
   void LogWriteHeader();
+  void LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared);
+
+  // The size and index of the code loaded at an address, which code move
+  // records have to repeat.
+  struct LoadedCode {
+    uint64_t code_size;
+    uint64_t code_index;
+  };
+  static bool AddressesMatch(void* key1, void* key2) { return key1 == key2; }
+  static uint32_t AddressHash(Address addr) {
+    return ComputePointerHash(addr);
+  }
 
   static const uint32_t kElfMachIA32 = 3;
   static const uint32_t kElfMachX64 = 62;
@@ -91,6 +103,7 @@ class PerfJitLogger : public CodeEventLogger {
 
   FILE* perf_output_handle_;
   uint64_t code_index_;
+  HashMap loaded_code_;
 };
 
 #else
@@ -87,6 +87,7 @@ class ParserBase : public Traits {
         allow_natives_syntax_(false),
         allow_arrow_functions_(false),
         allow_harmony_object_literals_(false),
+        allow_unary_function_hints_(false),
         zone_(zone),
         ast_node_id_gen_(ast_node_id_gen) {}
 
@@ -104,6 +105,9 @@ class ParserBase : public Traits {
   bool allow_harmony_object_literals() const {
     return allow_harmony_object_literals_;
   }
+  bool allow_unary_function_hints() const {
+    return allow_unary_function_hints_;
+  }
 
   // Setters that determine whether certain syntactical constructs are
   // allowed to be parsed by this instance of the parser.
@@ -121,6 +125,9 @@ class ParserBase : public Traits {
   void set_allow_harmony_object_literals(bool allow) {
     allow_harmony_object_literals_ = allow;
   }
+  void set_allow_unary_function_hints(bool allow) {
+    allow_unary_function_hints_ = allow;
+  }
 
  protected:
   friend class Traits::Checkpoint;
@@ -590,6 +597,7 @@ class ParserBase : public Traits {
   bool allow_natives_syntax_;
   bool allow_arrow_functions_;
   bool allow_harmony_object_literals_;
+  bool allow_unary_function_hints_;
 
   typename Traits::Type::Zone* zone_;  // Only used by Parser.
   AstNode::IdGen* ast_node_id_gen_;
@@ -2342,6 +2350,12 @@ ParserBase<Traits>::ParseUnaryExpression(bool* ok) {
   if (Token::IsUnaryOp(op)) {
     op = Next();
     int pos = position();
+    // Minifiers emit immediately called functions as '!function(){...}()'
+    // (or with '+', '-', '~' and 'void'); treat them like parenthesized ones.
+    if (allow_unary_function_hints() && op != Token::DELETE &&
+        op != Token::TYPEOF && peek() == Token::FUNCTION) {
+      parenthesized_function_ = true;
+    }
     ExpressionT expression = ParseUnaryExpression(CHECK_OK);
 
     // "delete identifier" is a syntax error in strict mode.
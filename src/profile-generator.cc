@@ -351,8 +351,14 @@ CodeEntry* const CodeMap::kSharedFunctionCodeEntry = NULL;
 const CodeMap::CodeTreeConfig::Key CodeMap::CodeTreeConfig::kNoKey = NULL;
 
 
+void CodeMap::FlushCache() {
+  memset(cache_, 0, sizeof(cache_));
+}
+
+
 void CodeMap::AddCode(Address addr, CodeEntry* entry, unsigned size) {
   DeleteAllCoveredCode(addr, addr + size);
+  FlushCache();
   CodeTree::Locator locator;
   tree_.Insert(addr, &locator);
   locator.set_value(CodeEntryInfo(entry, size));
@@ -374,6 +380,11 @@ void CodeMap::DeleteAllCoveredCode(Address start, Address end) {
 
 
 CodeEntry* CodeMap::FindEntry(Address addr, Address* start) {
+  CacheEntry* cached = &cache_[CacheIndex(addr)];
+  if (cached->start <= addr && addr < cached->end) {
+    if (start) *start = cached->start;
+    return cached->entry;
+  }
   CodeTree::Locator locator;
   if (tree_.FindGreatestLessThan(addr, &locator)) {
     // locator.key() <= addr. Need to check that addr is within entry.
@@ -382,6 +393,9 @@ CodeEntry* CodeMap::FindEntry(Address addr, Address* start) {
       if (start) {
         *start = locator.key();
       }
+      cached->start = locator.key();
+      cached->end = locator.key() + entry.size;
+      cached->entry = entry.entry;
       return entry.entry;
     }
   }
@@ -397,6 +411,7 @@ int CodeMap::GetSharedId(Address addr) {
     DCHECK(entry.entry == kSharedFunctionCodeEntry);
     return entry.size;
   } else {
+    FlushCache();
     tree_.Insert(addr, &locator);
     int id = next_shared_id_++;
     locator.set_value(CodeEntryInfo(kSharedFunctionCodeEntry, id));
@@ -411,6 +426,7 @@ void CodeMap::MoveCode(Address from, Address to) {
   if (!tree_.Find(from, &locator)) return;
   CodeEntryInfo entry = locator.value();
   tree_.Remove(from);
+  FlushCache();
   AddCode(to, entry.entry, entry.size);
 }
 
@@ -432,8 +448,86 @@ void CodeMap::Print() {
 }
 
 
+ContinuousProfile::ContinuousProfile(int max_stacks)
+    : max_stacks_(max_stacks),
+      stacks_(StacksMatch),
+      dropped_samples_(0) {
+}
+
+
+ContinuousProfile::~ContinuousProfile() {
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    Stack* stack = reinterpret_cast<Stack*>(p->key);
+    DeleteArray(stack->frames);
+    delete stack;
+  }
+}
+
+
+bool ContinuousProfile::StacksMatch(void* key1, void* key2) {
+  Stack* stack1 = reinterpret_cast<Stack*>(key1);
+  Stack* stack2 = reinterpret_cast<Stack*>(key2);
+  if (stack1->depth != stack2->depth) return false;
+  for (int i = 0; i < stack1->depth; i++) {
+    if (stack1->frames[i] != stack2->frames[i]) return false;
+  }
+  return true;
+}
+
+
+void ContinuousProfile::AddPath(const Vector<CodeEntry*>& path) {
+  ScopedVector<CodeEntry*> frames(path.length());
+  Stack key = { 0, 0, 0, frames.start() };
+  uint32_t hash = 0;
+  for (int i = 0; i < path.length(); i++) {
+    if (path[i] == NULL) continue;
+    frames[key.depth++] = path[i];
+    hash = hash * 31 + ComputePointerHash(path[i]);
+  }
+  HashMap::Entry* entry = stacks_.Lookup(&key, hash, false);
+  if (entry == NULL) {
+    if (static_cast<int>(stacks_.occupancy()) >= max_stacks_) {
+      dropped_samples_++;
+      return;
+    }
+    Stack* stack = new Stack(key);
+    stack->id = stacks_.occupancy() + 1;
+    stack->frames = NewArray<CodeEntry*>(key.depth);
+    for (int i = 0; i < key.depth; i++) stack->frames[i] = frames[i];
+    entry = stacks_.Lookup(stack, hash, true);
+  }
+  reinterpret_cast<Stack*>(entry->key)->sample_count++;
+}
+
+
+void ContinuousProfile::Drain(v8::ContinuousProfileVisitor* visitor) {
+  List<v8::CpuProfileFrame> frames;
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    Stack* stack = reinterpret_cast<Stack*>(p->key);
+    if (stack->sample_count == 0) continue;
+    frames.Rewind(0);
+    for (int i = 0; i < stack->depth; i++) {
+      CodeEntry* entry = stack->frames[i];
+      v8::CpuProfileFrame frame = {
+        entry->name(), entry->resource_name(), entry->script_id(),
+        entry->line_number(), entry->column_number()
+      };
+      frames.Add(frame);
+    }
+    visitor->VisitStack(stack->id, stack->sample_count, frames.begin(),
+                        frames.length());
+    stack->sample_count = 0;
+  }
+  if (dropped_samples_ != 0) {
+    visitor->VisitDroppedSamples(dropped_samples_);
+    dropped_samples_ = 0;
+  }
+}
+
+
 CpuProfilesCollection::CpuProfilesCollection(Heap* heap)
     : function_and_resource_names_(heap),
+      continuous_profile_(NULL),
       current_profiles_semaphore_(1) {
 }
 
@@ -452,6 +546,7 @@ CpuProfilesCollection::~CpuProfilesCollection() {
   finished_profiles_.Iterate(DeleteCpuProfile);
   current_profiles_.Iterate(DeleteCpuProfile);
   code_entries_.Iterate(DeleteCodeEntry);
+  delete continuous_profile_;
 }
 
 
@@ -516,6 +611,35 @@ void CpuProfilesCollection::RemoveProfile(CpuProfile* profile) {
 }
 
 
+bool CpuProfilesCollection::StartContinuousProfiling(int max_stacks) {
+  // Only the VM thread sets up the continuous profile, so it can be
+  // checked without locking.
+  if (continuous_profile_ != NULL) return false;
+  ContinuousProfile* profile = new ContinuousProfile(max_stacks);
+  current_profiles_semaphore_.Wait();
+  continuous_profile_ = profile;
+  current_profiles_semaphore_.Signal();
+  return true;
+}
+
+
+void CpuProfilesCollection::StopContinuousProfiling() {
+  current_profiles_semaphore_.Wait();
+  ContinuousProfile* profile = continuous_profile_;
+  continuous_profile_ = NULL;
+  current_profiles_semaphore_.Signal();
+  delete profile;
+}
+
+
+void CpuProfilesCollection::DrainContinuousProfile(
+    v8::ContinuousProfileVisitor* visitor) {
+  current_profiles_semaphore_.Wait();
+  if (continuous_profile_ != NULL) continuous_profile_->Drain(visitor);
+  current_profiles_semaphore_.Signal();
+}
+
+
 void CpuProfilesCollection::AddPathToCurrentProfiles(
     base::TimeTicks timestamp, const Vector<CodeEntry*>& path) {
   // As starting / stopping profiles is rare relatively to this
@@ -525,6 +649,7 @@ void CpuProfilesCollection::AddPathToCurrentProfiles(
   for (int i = 0; i < current_profiles_.length(); ++i) {
     current_profiles_[i]->AddPath(timestamp, path);
   }
+  if (continuous_profile_ != NULL) continuous_profile_->AddPath(path);
   current_profiles_semaphore_.Signal();
 }
 
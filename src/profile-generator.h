@@ -207,9 +207,38 @@ class CpuProfile {
 };
 
 
+// Aggregates samples by their stack in the continuous profiling mode. Each
+// distinct stack is stored once and further samples only increment its
+// count, so the memory used is bounded by the maximum number of stacks.
+class ContinuousProfile {
+ public:
+  explicit ContinuousProfile(int max_stacks);
+  ~ContinuousProfile();
+
+  void AddPath(const Vector<CodeEntry*>& path);
+  void Drain(v8::ContinuousProfileVisitor* visitor);
+
+ private:
+  struct Stack {
+    unsigned id;
+    unsigned sample_count;
+    int depth;
+    CodeEntry** frames;
+  };
+
+  static bool StacksMatch(void* key1, void* key2);
+
+  int max_stacks_;
+  HashMap stacks_;
+  unsigned dropped_samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfile);
+};
+
+
 class CodeMap {
  public:
-  CodeMap() : next_shared_id_(1) { }
+  CodeMap() : next_shared_id_(1) { FlushCache(); }
   void AddCode(Address addr, CodeEntry* entry, unsigned size);
   void MoveCode(Address from, Address to);
   CodeEntry* FindEntry(Address addr, Address* start = NULL);
@@ -241,6 +270,23 @@ class CodeMap {
     void Call(const Address& key, const CodeEntryInfo& value);
   };
 
+  // Samples mostly hit the same few code objects, so the code found for an
+  // address is cached in front of the tree. Each slot covers a small range
+  // of addresses and holds the bounds of the code found there last. The
+  // cache is flushed whenever the tree changes.
+  struct CacheEntry {
+    Address start;
+    Address end;
+    CodeEntry* entry;
+  };
+  static const int kCacheSize = 256;
+  static const int kCacheSlotSizeLog2 = 5;
+
+  static int CacheIndex(Address addr) {
+    return static_cast<int>(reinterpret_cast<uintptr_t>(addr) >>
+                            kCacheSlotSizeLog2) & (kCacheSize - 1);
+  }
+  void FlushCache();
   void DeleteAllCoveredCode(Address start, Address end);
 
   // Fake CodeEntry pointer to distinguish shared function entries.
@@ -248,6 +294,7 @@ class CodeMap {
 
   CodeTree tree_;
   int next_shared_id_;
+  CacheEntry cache_[kCacheSize];
 
   DISALLOW_COPY_AND_ASSIGN(CodeMap);
 };
@@ -274,8 +321,14 @@ class CpuProfilesCollection {
     return function_and_resource_names_.GetFunctionName(name);
   }
   bool IsLastProfile(const char* title);
+  bool HasCurrentProfiles() const { return !current_profiles_.is_empty(); }
   void RemoveProfile(CpuProfile* profile);
 
+  bool StartContinuousProfiling(int max_stacks);
+  void StopContinuousProfiling();
+  bool is_continuous_profiling() const { return continuous_profile_ != NULL; }
+  void DrainContinuousProfile(v8::ContinuousProfileVisitor* visitor);
+
   CodeEntry* NewCodeEntry(
       Logger::LogEventsAndTags tag,
       const char* name,
@@ -298,6 +351,7 @@ class CpuProfilesCollection {
 
   // Accessed by VM thread and profile generator thread.
   List<CpuProfile*> current_profiles_;
+  ContinuousProfile* continuous_profile_;
   base::Semaphore current_profiles_semaphore_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfilesCollection);
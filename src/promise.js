@@ -20,6 +20,7 @@ var PromiseCatch;
 var PromiseThen;
 var PromiseHasRejectHandler;
 var PromiseHasUserDefinedRejectHandler;
+var RunMicrotaskBatch;
 
 // mirror-debugger.js currently uses builtins.promiseStatus. It would be nice
 // if we could move these property names into the closure below.
@@ -117,7 +118,53 @@ var lastMicrotaskId = 0;
     }
   }
 
+  // A reaction job is the list of (handler, deferred) pairs of the settled
+  // promise followed by its value. It is enqueued as a microtask as is, so
+  // that no closure has to be allocated for it.
+  function PromiseReactionJob(job) {
+    var last = job.length - 1;
+    var value = job[last];
+    for (var i = 0; i < last; i += 2) {
+      PromiseHandle(value, job[i], job[i + 1]);
+    }
+  }
+
+  function RunMicrotask(microtask) {
+    try {
+      microtask();
+    } catch (e) {
+      // Exceptions thrown by microtasks are dropped, see
+      // Isolate::RunMicrotasks.
+    }
+  }
+
+  // Runs a batch of microtasks of this native context, given as an array of
+  // functions and reaction jobs.
+  RunMicrotaskBatch = function RunMicrotaskBatch(microtasks) {
+    for (var i = 0; i < microtasks.length; i++) {
+      var microtask = microtasks[i];
+      if (IS_FUNCTION(microtask)) {
+        RunMicrotask(microtask);
+      } else {
+        PromiseReactionJob(microtask);
+      }
+    }
+  }
+
+  function PromiseTasks(handler, deferred) {
+    var tasks = new InternalArray;
+    tasks.push(handler, deferred);
+    return tasks;
+  }
+
   function PromiseEnqueue(value, tasks, status) {
+    if (!DEBUG_IS_ACTIVE) {
+      // The task list is not used anymore by the promise, so it becomes the
+      // reaction job.
+      tasks.push(value);
+      %EnqueueMicrotask(tasks);
+      return;
+    }
     var id, name, instrumenting = DEBUG_IS_ACTIVE;
     %EnqueueMicrotask(function() {
       if (instrumenting) {
@@ -231,7 +278,7 @@ var lastMicrotaskId = 0;
         break;
       case +1:  // Resolved
         PromiseEnqueue(GET_PRIVATE(this, promiseValue),
-                       [onResolve, deferred],
+                       PromiseTasks(onResolve, deferred),
                        +1);
         break;
       case -1:  // Rejected
@@ -241,7 +288,7 @@ var lastMicrotaskId = 0;
           %PromiseRevokeReject(this);
         }
         PromiseEnqueue(GET_PRIVATE(this, promiseValue),
-                       [onReject, deferred],
+                       PromiseTasks(onReject, deferred),
                        -1);
         break;
     }
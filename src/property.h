@@ -226,6 +226,12 @@ class LookupResult FINAL BASE_EMBEDDED {
     return map->instance_descriptors()->GetFieldType(number_);
   }
 
+  int GetDescriptorIndex() const {
+    DCHECK(lookup_type_ == DESCRIPTOR_TYPE ||
+           lookup_type_ == TRANSITION_TYPE);
+    return number_;
+  }
+
   Map* GetFieldOwnerFromMap(Map* map) const {
     DCHECK(lookup_type_ == DESCRIPTOR_TYPE ||
            lookup_type_ == TRANSITION_TYPE);
@@ -147,7 +147,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
                                           stack_base,
                                           direct_call,
                                           isolate);
-  DCHECK(result >= RETRY);
+  DCHECK(result >= BACKTRACK_LIMIT_EXCEEDED);
 
   if (result == EXCEPTION && !isolate->has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
@@ -182,7 +182,15 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  // BACKTRACK_LIMIT_EXCEEDED: Matching was aborted after backtracking more
+  //        often than --regexp-backtrack-limit allows.
+  enum Result {
+    BACKTRACK_LIMIT_EXCEEDED = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   explicit NativeRegExpMacroAssembler(Zone* zone);
   virtual ~NativeRegExpMacroAssembler();
@@ -0,0 +1,614 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/ast.h"
+#include "src/char-predicates-inl.h"
+#include "src/jsregexp.h"
+#include "src/regexp-nfa.h"
+
+namespace v8 {
+namespace internal {
+
+// The program is an array of ints. A header is followed by the
+// instructions, each an opcode followed by its operands. Jump targets are
+// indices into the instructions.
+enum NfaOpcode {
+  NFA_CHAR,    // character
+  NFA_CLASS,   // range count, then (from, to) for every range
+  NFA_SPLIT,   // preferred target, other target
+  NFA_JUMP,    // target
+  NFA_SAVE,    // register
+  NFA_CLEAR,   // first register, last register
+  NFA_ASSERT,  // RegExpAssertion::AssertionType
+  NFA_MATCH
+};
+
+
+static const int kNfaRegisterCountOffset = 0;
+static const int kNfaThreadCapacityOffset = 1;
+static const int kNfaStickyOffset = 2;
+static const int kNfaHeaderSize = 3;
+
+// Limits on the size of the program, in ints, and on the memory needed for
+// the thread lists. Patterns exceeding them are left to Irregexp.
+static const int kNfaMaxProgramSize = 16 * KB;
+static const int kNfaMaxThreadRegisters = 256 * KB;
+
+
+class NfaCompiler : public RegExpVisitor {
+ public:
+  NfaCompiler(int capture_count, bool ignore_case, Zone* zone)
+      : code_(64, zone),
+        zone_(zone),
+        ignore_case_(ignore_case),
+        thread_capacity_(0),
+        failed_(false) {
+    register_count_ = (capture_count + 1) * 2;
+  }
+
+  bool Compile(RegExpTree* tree) {
+    Emit(NFA_SAVE);
+    Emit(0);
+    tree->Accept(this, NULL);
+    Emit(NFA_SAVE);
+    Emit(1);
+    EmitLeaf(NFA_MATCH);
+    if (thread_capacity_ * register_count_ > kNfaMaxThreadRegisters) {
+      failed_ = true;
+    }
+    return !failed_;
+  }
+
+  ZoneList<int>* code() { return &code_; }
+  int register_count() { return register_count_; }
+  int thread_capacity() { return thread_capacity_; }
+
+#define DECLARE_VISIT(Name) \
+  virtual void* Visit##Name(RegExp##Name* node, void* data) OVERRIDE;
+  FOR_EACH_REG_EXP_TREE_TYPE(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+ private:
+  int pc() { return code_.length(); }
+
+  void Emit(int value) {
+    if (code_.length() >= kNfaMaxProgramSize) {
+      failed_ = true;
+      return;
+    }
+    code_.Add(value, zone_);
+  }
+
+  // Instructions that consume a character or end the match are the only
+  // ones that make up threads.
+  void EmitLeaf(int opcode) {
+    thread_capacity_++;
+    Emit(opcode);
+  }
+
+  void Patch(int position, int value) {
+    if (position < code_.length()) code_[position] = value;
+  }
+
+  void EmitSplit(int* split) {
+    Emit(NFA_SPLIT);
+    *split = pc();
+    Emit(0);
+    Emit(0);
+  }
+
+  void PatchSplit(int split, int body, int exit, bool greedy) {
+    Patch(split, greedy ? body : exit);
+    Patch(split + 1, greedy ? exit : body);
+  }
+
+  void EmitRanges(ZoneList<CharacterRange>* ranges, bool is_negated);
+  void EmitIteration(RegExpTree* body, Interval captures);
+
+  ZoneList<int> code_;
+  Zone* zone_;
+  bool ignore_case_;
+  int register_count_;
+  int thread_capacity_;
+  bool failed_;
+};
+
+
+void NfaCompiler::EmitRanges(ZoneList<CharacterRange>* ranges,
+                             bool is_negated) {
+  CharacterRange::Canonicalize(ranges);
+  if (is_negated) {
+    ZoneList<CharacterRange>* negated =
+        new (zone_) ZoneList<CharacterRange>(ranges->length() + 1, zone_);
+    CharacterRange::Negate(ranges, negated, zone_);
+    ranges = negated;
+  }
+  if (ranges->length() == 1 && ranges->at(0).IsSingleton()) {
+    EmitLeaf(NFA_CHAR);
+    Emit(ranges->at(0).from());
+    return;
+  }
+  EmitLeaf(NFA_CLASS);
+  Emit(ranges->length());
+  for (int i = 0; i < ranges->length(); i++) {
+    Emit(ranges->at(i).from());
+    Emit(ranges->at(i).to());
+  }
+}
+
+
+void NfaCompiler::EmitIteration(RegExpTree* body, Interval captures) {
+  // Every iteration starts with the captures of the body reset.
+  if (!captures.is_empty()) {
+    Emit(NFA_CLEAR);
+    Emit(captures.from());
+    Emit(captures.to());
+  }
+  body->Accept(this, NULL);
+}
+
+
+void* NfaCompiler::VisitDisjunction(RegExpDisjunction* node, void* data) {
+  ZoneList<RegExpTree*>* alternatives = node->alternatives();
+  int count = alternatives->length();
+  ZoneList<int> exits(count, zone_);
+  for (int i = 0; i < count && !failed_; i++) {
+    if (i == count - 1) {
+      alternatives->at(i)->Accept(this, NULL);
+      break;
+    }
+    int split;
+    EmitSplit(&split);
+    int body = pc();
+    alternatives->at(i)->Accept(this, NULL);
+    Emit(NFA_JUMP);
+    exits.Add(pc(), zone_);
+    Emit(0);
+    PatchSplit(split, body, pc(), true);
+  }
+  for (int i = 0; i < exits.length(); i++) Patch(exits[i], pc());
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitAlternative(RegExpAlternative* node, void* data) {
+  ZoneList<RegExpTree*>* nodes = node->nodes();
+  for (int i = 0; i < nodes->length() && !failed_; i++) {
+    nodes->at(i)->Accept(this, NULL);
+  }
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitAssertion(RegExpAssertion* node, void* data) {
+  Emit(NFA_ASSERT);
+  Emit(node->assertion_type());
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitCharacterClass(RegExpCharacterClass* node,
+                                       void* data) {
+  ZoneList<CharacterRange>* ranges =
+      new (zone_) ZoneList<CharacterRange>(2, zone_);
+  ranges->AddAll(*node->ranges(zone_), zone_);
+  // Like Irregexp, the standard character classes are the same in the case
+  // independent case.
+  if (ignore_case_ && !node->is_standard(zone_)) {
+    int range_count = ranges->length();
+    for (int i = 0; i < range_count; i++) {
+      ranges->at(i).AddCaseEquivalents(ranges, false, zone_);
+    }
+  }
+  EmitRanges(ranges, node->is_negated());
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitAtom(RegExpAtom* node, void* data) {
+  Vector<const uc16> chars = node->data();
+  for (int i = 0; i < chars.length() && !failed_; i++) {
+    if (!ignore_case_) {
+      EmitLeaf(NFA_CHAR);
+      Emit(chars[i]);
+      continue;
+    }
+    ZoneList<CharacterRange>* ranges =
+        new (zone_) ZoneList<CharacterRange>(2, zone_);
+    ranges->Add(CharacterRange::Singleton(chars[i]), zone_);
+    ranges->at(0).AddCaseEquivalents(ranges, false, zone_);
+    EmitRanges(ranges, false);
+  }
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitText(RegExpText* node, void* data) {
+  ZoneList<TextElement>* elements = node->elements();
+  for (int i = 0; i < elements->length() && !failed_; i++) {
+    TextElement element = elements->at(i);
+    if (element.text_type() == TextElement::ATOM) {
+      VisitAtom(element.atom(), NULL);
+    } else {
+      VisitCharacterClass(element.char_class(), NULL);
+    }
+  }
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitQuantifier(RegExpQuantifier* node, void* data) {
+  RegExpTree* body = node->body();
+  Interval captures = body->CaptureRegisters();
+  bool greedy = node->is_greedy();
+  if (node->is_possessive()) {
+    failed_ = true;
+    return NULL;
+  }
+  for (int i = 0; i < node->min() && !failed_; i++) {
+    EmitIteration(body, captures);
+  }
+  if (node->max() == RegExpTree::kInfinity) {
+    // An iteration that matches the empty string gets back to the loop at
+    // the same position, where the thread is dropped because the loop has
+    // already been visited. This is the empty check of the specification.
+    int loop = pc();
+    int split;
+    EmitSplit(&split);
+    int iteration = pc();
+    EmitIteration(body, captures);
+    Emit(NFA_JUMP);
+    Emit(loop);
+    PatchSplit(split, iteration, pc(), greedy);
+    return NULL;
+  }
+  if (node->max() > node->min() && body->min_match() == 0) {
+    // Unrolled optional iterations would accept empty iterations.
+    failed_ = true;
+    return NULL;
+  }
+  ZoneList<int> splits(2, zone_);
+  ZoneList<int> iterations(2, zone_);
+  for (int i = node->min(); i < node->max() && !failed_; i++) {
+    int split;
+    EmitSplit(&split);
+    splits.Add(split, zone_);
+    iterations.Add(pc(), zone_);
+    EmitIteration(body, captures);
+  }
+  for (int i = 0; i < splits.length(); i++) {
+    PatchSplit(splits[i], iterations[i], pc(), greedy);
+  }
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitCapture(RegExpCapture* node, void* data) {
+  Emit(NFA_SAVE);
+  Emit(RegExpCapture::StartRegister(node->index()));
+  node->body()->Accept(this, NULL);
+  Emit(NFA_SAVE);
+  Emit(RegExpCapture::EndRegister(node->index()));
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitLookahead(RegExpLookahead* node, void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitBackReference(RegExpBackReference* node,
+                                      void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* NfaCompiler::VisitEmpty(RegExpEmpty* node, void* data) {
+  return NULL;
+}
+
+
+MaybeHandle<ByteArray> RegExpNfa::Compile(Isolate* isolate,
+                                          RegExpCompileData* data,
+                                          JSRegExp::Flags flags, Zone* zone) {
+  NfaCompiler compiler(data->capture_count, flags.is_ignore_case(), zone);
+  if (!compiler.Compile(data->tree)) return MaybeHandle<ByteArray>();
+
+  ZoneList<int>* code = compiler.code();
+  int length = kNfaHeaderSize + code->length();
+  Handle<ByteArray> program =
+      isolate->factory()->NewByteArray(length * kIntSize, TENURED);
+  int* words = reinterpret_cast<int*>(program->GetDataStartAddress());
+  words[kNfaRegisterCountOffset] = compiler.register_count();
+  words[kNfaThreadCapacityOffset] = compiler.thread_capacity();
+  words[kNfaStickyOffset] = flags.is_sticky() ? 1 : 0;
+  MemCopy(words + kNfaHeaderSize, code->ToConstVector().start(),
+          code->length() * kIntSize);
+  return program;
+}
+
+
+// The threads that are alive at one position of the subject, in priority
+// order. Every thread has its own copy of the registers.
+class NfaThreadList {
+ public:
+  NfaThreadList(int capacity, int register_count)
+      : pcs_(NewArray<int>(capacity)),
+        registers_(NewArray<int>(capacity * register_count)),
+        length_(0),
+        register_count_(register_count) {}
+
+  ~NfaThreadList() {
+    DeleteArray(pcs_);
+    DeleteArray(registers_);
+  }
+
+  void Clear() { length_ = 0; }
+  bool is_empty() { return length_ == 0; }
+  int length() { return length_; }
+  int pc(int index) { return pcs_[index]; }
+  int* registers(int index) { return &registers_[index * register_count_]; }
+
+  void Add(int pc, const int* registers) {
+    pcs_[length_] = pc;
+    MemCopy(this->registers(length_), registers, register_count_ * kIntSize);
+    length_++;
+  }
+
+ private:
+  int* pcs_;
+  int* registers_;
+  int length_;
+  int register_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(NfaThreadList);
+};
+
+
+static inline bool IsNfaLineTerminator(int c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+
+class NfaMatcher {
+ public:
+  NfaMatcher(const int* code, int code_length, int register_count,
+             int thread_capacity, bool sticky)
+      : code_(code),
+        register_count_(register_count),
+        sticky_(sticky),
+        first_(thread_capacity, register_count),
+        second_(thread_capacity, register_count),
+        visited_(NewArray<int>(code_length)),
+        work_(NewArray<int>(register_count)),
+        stack_(16) {
+    for (int i = 0; i < code_length; i++) visited_[i] = -1;
+  }
+
+  ~NfaMatcher() {
+    DeleteArray(visited_);
+    DeleteArray(work_);
+  }
+
+  template <typename Char>
+  bool Match(Vector<const Char> subject, int start_position, int* captures);
+
+ private:
+  // Adds the threads reachable from pc without consuming a character to the
+  // list, starting with the registers in work_. The registers are restored
+  // before returning.
+  template <typename Char>
+  void AddThreads(NfaThreadList* list, int pc, int position,
+                  Vector<const Char> subject);
+
+  template <typename Char>
+  static bool CheckAssertion(int type, Vector<const Char> subject,
+                             int position);
+
+  bool Consumes(int pc, int c, int* next_pc);
+
+  const int* code_;
+  int register_count_;
+  bool sticky_;
+  NfaThreadList first_;
+  NfaThreadList second_;
+  // The last position at which an instruction was visited, so that every
+  // instruction is visited once per position.
+  int* visited_;
+  int* work_;
+  // Pairs of (pc, 0) for instructions to visit and (-register - 1, value)
+  // for registers to restore.
+  List<int> stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(NfaMatcher);
+};
+
+
+template <typename Char>
+bool NfaMatcher::CheckAssertion(int type, Vector<const Char> subject,
+                                int position) {
+  int length = subject.length();
+  switch (type) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::END_OF_INPUT:
+      return position == length;
+    case RegExpAssertion::START_OF_LINE:
+      return position == 0 || IsNfaLineTerminator(subject[position - 1]);
+    case RegExpAssertion::END_OF_LINE:
+      return position == length || IsNfaLineTerminator(subject[position]);
+    case RegExpAssertion::BOUNDARY:
+    case RegExpAssertion::NON_BOUNDARY: {
+      // Only the uc16 overload of IsRegExpWord is defined.
+      bool word_before = position > 0 &&
+                         IsRegExpWord(static_cast<uc16>(subject[position - 1]));
+      bool word_after = position < length &&
+                        IsRegExpWord(static_cast<uc16>(subject[position]));
+      return (word_before != word_after) ==
+             (type == RegExpAssertion::BOUNDARY);
+    }
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+bool NfaMatcher::Consumes(int pc, int c, int* next_pc) {
+  if (code_[pc] == NFA_CHAR) {
+    *next_pc = pc + 2;
+    return code_[pc + 1] == c;
+  }
+  DCHECK_EQ(NFA_CLASS, code_[pc]);
+  int range_count = code_[pc + 1];
+  *next_pc = pc + 2 + range_count * 2;
+  // The ranges are sorted.
+  for (int i = 0; i < range_count; i++) {
+    int from = code_[pc + 2 + i * 2];
+    if (c < from) return false;
+    if (c <= code_[pc + 3 + i * 2]) return true;
+  }
+  return false;
+}
+
+
+template <typename Char>
+void NfaMatcher::AddThreads(NfaThreadList* list, int pc, int position,
+                            Vector<const Char> subject) {
+  DCHECK(stack_.is_empty());
+  stack_.Add(pc);
+  stack_.Add(0);
+  while (!stack_.is_empty()) {
+    int value = stack_.RemoveLast();
+    int target = stack_.RemoveLast();
+    if (target < 0) {
+      work_[-target - 1] = value;
+      continue;
+    }
+    pc = target;
+    bool alive = true;
+    while (alive && visited_[pc] != position) {
+      visited_[pc] = position;
+      switch (code_[pc]) {
+        case NFA_CHAR:
+        case NFA_CLASS:
+        case NFA_MATCH:
+          list->Add(pc, work_);
+          alive = false;
+          break;
+        case NFA_SPLIT:
+          stack_.Add(code_[pc + 2]);
+          stack_.Add(0);
+          pc = code_[pc + 1];
+          break;
+        case NFA_JUMP:
+          pc = code_[pc + 1];
+          break;
+        case NFA_SAVE: {
+          int reg = code_[pc + 1];
+          stack_.Add(-reg - 1);
+          stack_.Add(work_[reg]);
+          work_[reg] = position;
+          pc += 2;
+          break;
+        }
+        case NFA_CLEAR:
+          for (int reg = code_[pc + 1]; reg <= code_[pc + 2]; reg++) {
+            if (work_[reg] == -1) continue;
+            stack_.Add(-reg - 1);
+            stack_.Add(work_[reg]);
+            work_[reg] = -1;
+          }
+          pc += 3;
+          break;
+        case NFA_ASSERT:
+          alive = CheckAssertion(code_[pc + 1], subject, position);
+          pc += 2;
+          break;
+        default:
+          UNREACHABLE();
+      }
+    }
+  }
+}
+
+
+template <typename Char>
+bool NfaMatcher::Match(Vector<const Char> subject, int start_position,
+                       int* captures) {
+  NfaThreadList* current = &first_;
+  NfaThreadList* next = &second_;
+  bool matched = false;
+  for (int position = start_position; position <= subject.length();
+       position++) {
+    // Unless a match has been found, a new attempt starts at every
+    // position, with lower priority than the ones already running.
+    if (!matched && (!sticky_ || position == start_position)) {
+      for (int i = 0; i < register_count_; i++) work_[i] = -1;
+      AddThreads(current, 0, position, subject);
+    }
+    if (current->is_empty()) {
+      if (matched || sticky_) break;
+      continue;
+    }
+    next->Clear();
+    for (int i = 0; i < current->length(); i++) {
+      int pc = current->pc(i);
+      int* registers = current->registers(i);
+      if (code_[pc] == NFA_MATCH) {
+        // Threads with lower priority than the match are cut off. The ones
+        // with higher priority that are still running may find a better
+        // match.
+        MemCopy(captures, registers, register_count_ * kIntSize);
+        matched = true;
+        break;
+      }
+      int next_pc;
+      if (position < subject.length() &&
+          Consumes(pc, subject[position], &next_pc)) {
+        MemCopy(work_, registers, register_count_ * kIntSize);
+        AddThreads(next, next_pc, position + 1, subject);
+      }
+    }
+    NfaThreadList* tmp = current;
+    current = next;
+    next = tmp;
+  }
+  return matched;
+}
+
+
+RegExpImpl::IrregexpResult RegExpNfa::Match(Handle<ByteArray> program,
+                                            Handle<String> subject,
+                                            int* captures,
+                                            int start_position) {
+  DCHECK(subject->IsFlat());
+  DisallowHeapAllocation no_gc;
+  const int* words = reinterpret_cast<int*>(program->GetDataStartAddress());
+  int code_length = program->length() / kIntSize - kNfaHeaderSize;
+  int register_count = words[kNfaRegisterCountOffset];
+
+  // Registers are only written on success, so a failed match leaves the
+  // previous captures in place.
+  SmartArrayPointer<int> result(NewArray<int>(register_count));
+  NfaMatcher matcher(words + kNfaHeaderSize, code_length, register_count,
+                     words[kNfaThreadCapacityOffset],
+                     words[kNfaStickyOffset] != 0);
+  String::FlatContent content = subject->GetFlatContent();
+  bool matched =
+      content.IsOneByte()
+          ? matcher.Match(content.ToOneByteVector(), start_position,
+                          result.get())
+          : matcher.Match(content.ToUC16Vector(), start_position,
+                          result.get());
+  if (!matched) return RegExpImpl::RE_FAILURE;
+  MemCopy(captures, result.get(), register_count * kIntSize);
+  return RegExpImpl::RE_SUCCESS;
+}
+
+} }  // namespace v8::internal
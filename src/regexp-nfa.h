@@ -0,0 +1,37 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_NFA_H_
+#define V8_REGEXP_NFA_H_
+
+namespace v8 {
+namespace internal {
+
+// A non-backtracking matcher for the regexps that do not need backtracking
+// to be matched, i.e. those without backreferences and lookaheads. The
+// parsed pattern is compiled into a small program that is simulated as a
+// Pike VM: all alternatives are advanced in lock step over the subject, so
+// matching takes time linear in the length of the subject, however the
+// pattern is nested. Threads are kept in priority order, which gives the
+// same captures as the backtracking semantics of ECMA-262.
+class RegExpNfa : public AllStatic {
+ public:
+  // Returns an empty handle if the pattern uses features the matcher does
+  // not support or if the program would grow too large. Irregexp is used
+  // for those patterns.
+  static MaybeHandle<ByteArray> Compile(Isolate* isolate,
+                                        RegExpCompileData* data,
+                                        JSRegExp::Flags flags, Zone* zone);
+
+  // Matches the program against the flat subject, starting at the given
+  // index. On success the capture registers are written to the captures
+  // array, otherwise it is left untouched.
+  static RegExpImpl::IrregexpResult Match(Handle<ByteArray> program,
+                                          Handle<String> subject,
+                                          int* captures, int start_position);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_REGEXP_NFA_H_
@@ -17,6 +17,7 @@
 #include "src/heap/mark-compact.h"
 #include "src/isolate-inl.h"
 #include "src/scopeinfo.h"
+#include "src/type-feedback-vector-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -25,6 +26,9 @@ namespace internal {
 // Number of times a function has to be seen on the stack before it is
 // optimized.
 static const int kProfilerTicksBeforeOptimization = 2;
+// Functions that got optimized in a previous run of the same script only have
+// to be seen on the stack this number of times with stable type feedback.
+static const int kProfilerTicksBeforeOptimizationWhenHot = 1;
 // If the function optimization was disabled due to high deoptimization count,
 // but the function is hot and has been seen on the stack this number of times,
 // then we try to reenable optimization for this function.
@@ -33,6 +37,10 @@ static const int kProfilerTicksBeforeReenablingOptimization = 250;
 // FLAG_type_info_threshold), but has seen a huge number of ticks,
 // optimize it as it is.
 static const int kTicksWhenNotEnoughTypeInfo = 100;
+// With counter based tier-up, functions that keep changing their type
+// feedback are optimized anyway once they are this many times over the
+// thresholds.
+static const int kCountsWhenNotEnoughTypeInfo = 4;
 // We only have one byte to store the number of ticks.
 STATIC_ASSERT(kProfilerTicksBeforeOptimization < 256);
 STATIC_ASSERT(kProfilerTicksBeforeReenablingOptimization < 256);
@@ -152,6 +160,53 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
 }
 
 
+void RuntimeProfiler::OptimizeIfHot(JSFunction* function, Code* shared_code) {
+  TypeFeedbackVector* vector = function->shared()->feedback_vector();
+  int invocations = vector->invocation_count();
+  int back_edges = vector->back_edge_count();
+  // Patching an IC resets the ticks, so they count the ticks for which the
+  // type feedback of the function stayed the same.
+  int ticks = shared_code->profiler_ticks();
+  if (ticks < 255) shared_code->set_profiler_ticks(ticks + 1);
+
+  if (!shared_code->hot_in_previous_run() &&
+      invocations < FLAG_tier_up_invocation_count &&
+      back_edges < FLAG_tier_up_back_edge_count) {
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", not hot enough: %d invocations, %d back edges]\n",
+             invocations, back_edges);
+    }
+    return;
+  }
+
+  int typeinfo, generic, total, type_percentage, generic_percentage;
+  GetICCounts(shared_code, &typeinfo, &generic, &total, &type_percentage,
+              &generic_percentage);
+  if (ticks > 0 && type_percentage >= FLAG_type_info_threshold &&
+      generic_percentage <= FLAG_generic_ic_threshold) {
+    Optimize(function, "hot and stable");
+  } else if (invocations >= kCountsWhenNotEnoughTypeInfo *
+                                FLAG_tier_up_invocation_count ||
+             back_edges >= kCountsWhenNotEnoughTypeInfo *
+                               FLAG_tier_up_back_edge_count) {
+    Optimize(function, "not much type info but very hot");
+  } else {
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", type feedback not stable: %d/%d (%d%%)]\n", typeinfo, total,
+             type_percentage);
+    }
+    return;
+  }
+  // Should the optimized code be thrown away, count afresh before trying
+  // again.
+  vector->ResetCounters();
+}
+
+
 void RuntimeProfiler::OptimizeNow() {
   HandleScope scope(isolate_);
 
@@ -185,6 +240,8 @@ void RuntimeProfiler::OptimizeNow() {
 
     if (shared_code->kind() != Code::FUNCTION) continue;
     if (function->IsInOptimizationQueue()) continue;
+    // Functions with break points have to keep running unoptimized code.
+    if (shared->HasDebugInfo()) continue;
 
     if (FLAG_always_osr) {
       AttemptOnStackReplacement(function, Code::kMaxLoopNestingMarker);
@@ -232,9 +289,19 @@ void RuntimeProfiler::OptimizeNow() {
     }
     if (!function->IsOptimizable()) continue;
 
+    if (FLAG_counter_based_tier_up &&
+        FullCodeGenerator::kEmitsFeedbackVectorCounters) {
+      OptimizeIfHot(function, shared_code);
+      continue;
+    }
+
     int ticks = shared_code->profiler_ticks();
+    int ticks_before_optimization =
+        shared_code->hot_in_previous_run()
+            ? kProfilerTicksBeforeOptimizationWhenHot
+            : kProfilerTicksBeforeOptimization;
 
-    if (ticks >= kProfilerTicksBeforeOptimization) {
+    if (ticks >= ticks_before_optimization) {
       int typeinfo, generic, total, type_percentage, generic_percentage;
       GetICCounts(shared_code, &typeinfo, &generic, &total, &type_percentage,
                   &generic_percentage);
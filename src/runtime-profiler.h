@@ -31,6 +31,8 @@ class RuntimeProfiler {
 
  private:
   void Optimize(JSFunction* function, const char* reason);
+  // Tier-up decision of --counter-based-tier-up.
+  void OptimizeIfHot(JSFunction* function, Code* shared_code);
 
   bool CodeSizeOKForOSR(Code* shared_code);
 
@@ -552,6 +552,8 @@ function ToObject(x) {
   if (IS_NULL_OR_UNDEFINED(x) && !IS_UNDETECTABLE(x)) {
     throw %MakeTypeError('undefined_or_null_to_object', []);
   }
+  // The only other primitives are SIMD values.
+  if (!IS_SPEC_OBJECT(x)) return %NewSimd128Wrapper(x);
   return x;
 }
 
@@ -0,0 +1,306 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <limits>
+
+#include "src/v8.h"
+
+#include "src/arguments.h"
+#include "src/base/atomicops.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/time.h"
+#include "src/runtime/runtime.h"
+#include "src/runtime/runtime-utils.h"
+
+// The Atomics operations are only implemented for Int32Array and Uint32Array
+// views of SharedArrayBuffers. harmony-atomics.js checks the arguments and
+// converts them to numbers before calling into the runtime, so the checks
+// here only guard against calls with the natives syntax.
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+bool IsSharedInt32Array(JSTypedArray* array) {
+  if (array->type() != kExternalInt32Array &&
+      array->type() != kExternalUint32Array) {
+    return false;
+  }
+  return array->buffer()->IsJSArrayBuffer() &&
+         JSArrayBuffer::cast(array->buffer())->is_shared();
+}
+
+
+volatile base::Atomic32* AtomicCell(JSTypedArray* array, size_t index) {
+  base::Atomic32* elements = static_cast<base::Atomic32*>(
+      ExternalArray::cast(array->elements())->external_pointer());
+  return elements + index;
+}
+
+
+Object* AtomicValue(Isolate* isolate, bool is_unsigned,
+                    base::Atomic32 value) {
+  if (is_unsigned) {
+    return *isolate->factory()->NewNumberFromUint(
+        static_cast<uint32_t>(value));
+  }
+  return *isolate->factory()->NewNumberFromInt(value);
+}
+
+
+// The operations are sequentially consistent, so every access is fenced on
+// both sides.
+base::Atomic32 SequentiallyConsistentLoad(volatile base::Atomic32* cell) {
+  base::MemoryBarrier();
+  base::Atomic32 value = base::NoBarrier_Load(cell);
+  base::MemoryBarrier();
+  return value;
+}
+
+
+void SequentiallyConsistentStore(volatile base::Atomic32* cell,
+                                 base::Atomic32 value) {
+  base::MemoryBarrier();
+  base::NoBarrier_Store(cell, value);
+  base::MemoryBarrier();
+}
+
+
+base::Atomic32 SequentiallyConsistentCompareAndSwap(
+    volatile base::Atomic32* cell, base::Atomic32 expected,
+    base::Atomic32 replacement) {
+  base::MemoryBarrier();
+  base::Atomic32 old_value =
+      base::NoBarrier_CompareAndSwap(cell, expected, replacement);
+  base::MemoryBarrier();
+  return old_value;
+}
+
+
+// The arithmetic is done on unsigned values, which wrap around instead of
+// overflowing.
+base::Atomic32 Add(base::Atomic32 a, base::Atomic32 b) {
+  return static_cast<base::Atomic32>(static_cast<uint32_t>(a) +
+                                     static_cast<uint32_t>(b));
+}
+
+
+base::Atomic32 Sub(base::Atomic32 a, base::Atomic32 b) {
+  return static_cast<base::Atomic32>(static_cast<uint32_t>(a) -
+                                     static_cast<uint32_t>(b));
+}
+
+
+base::Atomic32 And(base::Atomic32 a, base::Atomic32 b) { return a & b; }
+base::Atomic32 Or(base::Atomic32 a, base::Atomic32 b) { return a | b; }
+base::Atomic32 Xor(base::Atomic32 a, base::Atomic32 b) { return a ^ b; }
+base::Atomic32 Exchange(base::Atomic32 a, base::Atomic32 b) { return b; }
+
+
+typedef base::Atomic32 (*AtomicOperation)(base::Atomic32, base::Atomic32);
+
+
+// Replaces the value of |cell| with |operation| applied to it and |operand|
+// and returns the old value.
+base::Atomic32 FetchAndApply(volatile base::Atomic32* cell,
+                             AtomicOperation operation,
+                             base::Atomic32 operand) {
+  base::MemoryBarrier();
+  base::Atomic32 old_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+  } while (base::NoBarrier_CompareAndSwap(cell, old_value,
+                                          operation(old_value, operand)) !=
+           old_value);
+  base::MemoryBarrier();
+  return old_value;
+}
+
+
+// The threads that wait in Atomics.wait, in the order in which they started
+// waiting. The list is shared by all isolates, since the memory they wait on
+// may be shared by several isolates.
+class FutexWaiter {
+ public:
+  explicit FutexWaiter(volatile base::Atomic32* cell)
+      : cell_(cell), woken_(false), next_(NULL) {}
+
+  volatile base::Atomic32* cell_;
+  bool woken_;
+  FutexWaiter* next_;
+  base::ConditionVariable condition_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FutexWaiter);
+};
+
+
+base::LazyMutex futex_mutex = LAZY_MUTEX_INITIALIZER;
+FutexWaiter* futex_waiters = NULL;
+
+
+void AddFutexWaiter(FutexWaiter* waiter) {
+  FutexWaiter** link = &futex_waiters;
+  while (*link != NULL) link = &(*link)->next_;
+  *link = waiter;
+}
+
+
+void RemoveFutexWaiter(FutexWaiter* waiter) {
+  for (FutexWaiter** link = &futex_waiters; *link != NULL;
+       link = &(*link)->next_) {
+    if (*link == waiter) {
+      *link = waiter->next_;
+      return;
+    }
+  }
+}
+
+
+// The results of Atomics.wait, see Atomics.OK etc. in harmony-atomics.js.
+const int kFutexOk = 0;
+const int kFutexNotEqual = -1;
+const int kFutexTimedOut = -2;
+
+}  // namespace
+
+
+#define CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned)                        \
+  CONVERT_ARG_CHECKED(JSTypedArray, cell##_array, 0);                         \
+  RUNTIME_ASSERT(IsSharedInt32Array(cell##_array));                           \
+  size_t cell##_index = 0;                                                    \
+  RUNTIME_ASSERT(args[1]->IsNumber() &&                                       \
+                 TryNumberToSize(isolate, args[1], &cell##_index));           \
+  RUNTIME_ASSERT(cell##_index <                                               \
+                 NumberToSize(isolate, cell##_array->length()));              \
+  volatile base::Atomic32* cell = AtomicCell(cell##_array, cell##_index);     \
+  bool is_unsigned = cell##_array->type() == kExternalUint32Array;
+
+
+RUNTIME_FUNCTION(Runtime_AtomicsLoad) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);
+  return AtomicValue(isolate, is_unsigned, SequentiallyConsistentLoad(cell));
+}
+
+
+RUNTIME_FUNCTION(Runtime_AtomicsStore) {
+  SealHandleScope shs(isolate);
+  DCHECK(args.length() == 3);
+  CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);
+  USE(is_unsigned);
+  CONVERT_NUMBER_CHECKED(int32_t, value, Int32, args[2]);
+  SequentiallyConsistentStore(cell, value);
+  return isolate->heap()->undefined_value();
+}
+
+
+#define ATOMIC_OPERATION_FUNCTION(Name)                                       \
+  RUNTIME_FUNCTION(Runtime_Atomics##Name) {                                   \
+    HandleScope scope(isolate);                                               \
+    DCHECK(args.length() == 3);                                               \
+    CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);                           \
+    CONVERT_NUMBER_CHECKED(int32_t, operand, Int32, args[2]);                 \
+    return AtomicValue(isolate, is_unsigned,                                  \
+                       FetchAndApply(cell, Name, operand));                   \
+  }
+
+ATOMIC_OPERATION_FUNCTION(Add)
+ATOMIC_OPERATION_FUNCTION(Sub)
+ATOMIC_OPERATION_FUNCTION(And)
+ATOMIC_OPERATION_FUNCTION(Or)
+ATOMIC_OPERATION_FUNCTION(Xor)
+ATOMIC_OPERATION_FUNCTION(Exchange)
+
+#undef ATOMIC_OPERATION_FUNCTION
+
+
+RUNTIME_FUNCTION(Runtime_AtomicsCompareExchange) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 4);
+  CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);
+  CONVERT_NUMBER_CHECKED(int32_t, expected, Int32, args[2]);
+  CONVERT_NUMBER_CHECKED(int32_t, replacement, Int32, args[3]);
+  return AtomicValue(
+      isolate, is_unsigned,
+      SequentiallyConsistentCompareAndSwap(cell, expected, replacement));
+}
+
+
+// Blocks the thread until another thread wakes it for the same cell or the
+// timeout, in milliseconds, has passed. Waiting cannot be interrupted.
+RUNTIME_FUNCTION(Runtime_AtomicsWait) {
+  SealHandleScope shs(isolate);
+  DCHECK(args.length() == 4);
+  CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);
+  USE(is_unsigned);
+  CONVERT_NUMBER_CHECKED(int32_t, value, Int32, args[2]);
+  CONVERT_DOUBLE_ARG_CHECKED(timeout, 3);
+  RUNTIME_ASSERT(timeout >= 0);
+
+  base::Mutex* mutex = futex_mutex.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(mutex);
+  if (base::NoBarrier_Load(cell) != value) {
+    return Smi::FromInt(kFutexNotEqual);
+  }
+
+  FutexWaiter waiter(cell);
+  AddFutexWaiter(&waiter);
+  double timeout_us = timeout * base::Time::kMicrosecondsPerMillisecond;
+  if (timeout_us >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+    while (!waiter.woken_) waiter.condition_.Wait(mutex);
+    return Smi::FromInt(kFutexOk);
+  }
+
+  base::TimeTicks end = base::TimeTicks::Now() +
+                        base::TimeDelta::FromMicroseconds(
+                            static_cast<int64_t>(timeout_us));
+  while (!waiter.woken_) {
+    base::TimeDelta remaining = end - base::TimeTicks::Now();
+    if (remaining <= base::TimeDelta()) {
+      RemoveFutexWaiter(&waiter);
+      return Smi::FromInt(kFutexTimedOut);
+    }
+    // Spurious wakeups are handled by the loop.
+    bool notified = waiter.condition_.WaitFor(mutex, remaining);
+    USE(notified);
+  }
+  return Smi::FromInt(kFutexOk);
+}
+
+
+// Wakes up to |count| of the threads that wait for the cell, in the order in
+// which they started waiting, and returns how many were woken.
+RUNTIME_FUNCTION(Runtime_AtomicsWake) {
+  SealHandleScope shs(isolate);
+  DCHECK(args.length() == 3);
+  CONVERT_ATOMIC_ARGS_CHECKED(cell, is_unsigned);
+  USE(is_unsigned);
+  CONVERT_DOUBLE_ARG_CHECKED(count, 2);
+  RUNTIME_ASSERT(count >= 0);
+
+  base::LockGuard<base::Mutex> lock_guard(futex_mutex.Pointer());
+  int woken = 0;
+  FutexWaiter** link = &futex_waiters;
+  while (*link != NULL && woken < count) {
+    FutexWaiter* waiter = *link;
+    if (waiter->cell_ == cell) {
+      *link = waiter->next_;
+      waiter->woken_ = true;
+      waiter->condition_.NotifyOne();
+      woken++;
+    } else {
+      link = &waiter->next_;
+    }
+  }
+  return Smi::FromInt(woken);
+}
+
+#undef CONVERT_ATOMIC_ARGS_CHECKED
+
+}  // namespace internal
+}  // namespace v8
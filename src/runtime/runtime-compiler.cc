@@ -52,6 +52,7 @@ RUNTIME_FUNCTION(Runtime_CompileOptimized) {
   Handle<Code> unoptimized(function->shared()->code());
   if (!isolate->use_crankshaft() ||
       function->shared()->optimization_disabled() ||
+      function->shared()->HasDebugInfo() ||
       isolate->DebuggerHasBreakPoints()) {
     // If the function is not optimizable or debugger is active continue
     // using the code from the full compiler.
@@ -132,6 +133,9 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
   // Make sure to materialize objects before causing any allocation.
   JavaScriptFrameIterator it(isolate);
   deoptimizer->MaterializeHeapObjects(&it);
+  if (isolate->deoptimization_callback() != NULL) {
+    deoptimizer->NotifyDeoptimizationCallback(it.frame());
+  }
   delete deoptimizer;
 
   JavaScriptFrame* frame = it.frame();
@@ -1017,21 +1017,41 @@ static bool SetCatchVariableValue(Isolate* isolate, Handle<Context> context,
 
 
 // Create a plain JSObject which materializes the block scope for the specified
-// block context.
+// block context. Block scoped variables that live in the stack frame are read
+// from |frame| if it is given; |context| is null if the block has no context.
 MUST_USE_RESULT static MaybeHandle<JSObject> MaterializeBlockScope(
-    Isolate* isolate, Handle<Context> context) {
-  DCHECK(context->IsBlockContext());
-  Handle<ScopeInfo> scope_info(ScopeInfo::cast(context->extension()));
-
-  // Allocate and initialize a JSObject with all the arguments, stack locals
-  // heap locals and extension properties of the debugged function.
+    Isolate* isolate, Handle<ScopeInfo> scope_info, Handle<Context> context,
+    JavaScriptFrame* frame, int inlined_jsframe_index) {
+  // Allocate and initialize a JSObject with all the stack locals and heap
+  // locals of the block.
   Handle<JSObject> block_scope =
       isolate->factory()->NewJSObject(isolate->object_function());
 
+  // Fill all stack locals.
+  if (frame != NULL && scope_info->StackLocalCount() > 0) {
+    FrameInspector frame_inspector(frame, inlined_jsframe_index, isolate);
+    int first_slot = scope_info->StackLocalFirstSlot();
+    for (int i = 0; i < scope_info->StackLocalCount(); ++i) {
+      if (scope_info->LocalIsSynthetic(i)) continue;
+      Handle<String> name(scope_info->StackLocalName(i));
+      Handle<Object> value(frame_inspector.GetExpression(first_slot + i),
+                           isolate);
+      if (value->IsTheHole()) continue;
+
+      RETURN_ON_EXCEPTION(isolate, Runtime::SetObjectProperty(
+                                       isolate, block_scope, name, value,
+                                       SLOPPY),
+                          JSObject);
+    }
+  }
+
   // Fill all context locals.
-  if (!ScopeInfo::CopyContextLocalsToScopeObject(scope_info, context,
-                                                 block_scope)) {
-    return MaybeHandle<JSObject>();
+  if (!context.is_null()) {
+    DCHECK(context->IsBlockContext());
+    if (!ScopeInfo::CopyContextLocalsToScopeObject(scope_info, context,
+                                                   block_scope)) {
+      return MaybeHandle<JSObject>();
+    }
   }
 
   return block_scope;
@@ -1274,8 +1294,14 @@ class ScopeIterator {
       case ScopeIterator::ScopeTypeClosure:
         // Materialize the content of the closure scope into a JSObject.
         return MaterializeClosure(isolate_, CurrentContext());
-      case ScopeIterator::ScopeTypeBlock:
-        return MaterializeBlockScope(isolate_, CurrentContext());
+      case ScopeIterator::ScopeTypeBlock: {
+        // Only the nested scopes of the current function have their stack
+        // locals in its frame.
+        JavaScriptFrame* frame = nested_scope_chain_.is_empty() ? NULL : frame_;
+        return MaterializeBlockScope(isolate_, CurrentScopeInfo(),
+                                     CurrentContext(), frame,
+                                     inlined_jsframe_index_);
+      }
       case ScopeIterator::ScopeTypeModule:
         return MaterializeModuleScope(isolate_, CurrentContext());
     }
@@ -2535,21 +2561,20 @@ RUNTIME_FUNCTION(Runtime_GetFunctionCodePositionFromSource) {
     return isolate->heap()->undefined_value();
   }
 
-  RelocIterator it(*code, RelocInfo::ModeMask(RelocInfo::STATEMENT_POSITION));
   int closest_pc = 0;
   int distance = kMaxInt;
-  while (!it.done()) {
-    int statement_position = static_cast<int>(it.rinfo()->data());
+  for (SourcePositionTableIterator it(code->source_position_table());
+       !it.done(); it.Advance()) {
+    if (!it.is_statement()) continue;
+    int statement_position = it.source_position();
     // Check if this break point is closer that what was previously found.
     if (source_position <= statement_position &&
         statement_position - source_position < distance) {
-      closest_pc =
-          static_cast<int>(it.rinfo()->pc() - code->instruction_start());
+      closest_pc = it.code_offset();
       distance = statement_position - source_position;
       // Check whether we can't get any closer.
       if (distance == 0) break;
     }
-    it.next();
   }
 
   return Smi::FromInt(closest_pc);
@@ -33,6 +33,7 @@ RUNTIME_FUNCTION(Runtime_CreateJSGeneratorObject) {
   generator->set_continuation(0);
   generator->set_operand_stack(isolate->heap()->empty_fixed_array());
   generator->set_stack_handler_index(-1);
+  generator->set_spare_operand_stack(isolate->heap()->empty_fixed_array());
 
   return *generator;
 }
@@ -69,9 +70,16 @@ RUNTIME_FUNCTION(Runtime_SuspendJSGeneratorObject) {
     // active either.
     DCHECK(!frame->HasHandler());
   } else {
+    // Yields at the same point of a loop save the same number of operands,
+    // so reuse the array of the previous suspension if it fits.
     int stack_handler_index = -1;
-    Handle<FixedArray> operand_stack =
-        isolate->factory()->NewFixedArray(operands_count);
+    Handle<FixedArray> operand_stack(generator_object->spare_operand_stack());
+    if (operand_stack->length() == operands_count) {
+      generator_object->set_spare_operand_stack(
+          isolate->heap()->empty_fixed_array());
+    } else {
+      operand_stack = isolate->factory()->NewFixedArray(operands_count);
+    }
     frame->SaveOperandStack(*operand_stack, &stack_handler_index);
     generator_object->set_operand_stack(*operand_stack);
     generator_object->set_stack_handler_index(stack_handler_index);
@@ -120,6 +128,11 @@ RUNTIME_FUNCTION(Runtime_ResumeJSGeneratorObject) {
                                generator_object->stack_handler_index());
     generator_object->set_operand_stack(isolate->heap()->empty_fixed_array());
     generator_object->set_stack_handler_index(-1);
+    // Keep the array for the next suspension, without holding on to the
+    // operands that are now back on the stack.
+    MemsetPointer(operand_stack->data_start(),
+                  isolate->heap()->undefined_value(), operands_count);
+    generator_object->set_spare_operand_stack(operand_stack);
   }
 
   JSGeneratorObject::ResumeMode resume_mode =
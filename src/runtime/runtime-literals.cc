@@ -7,6 +7,7 @@
 #include "src/allocation-site-scopes.h"
 #include "src/arguments.h"
 #include "src/ast.h"
+#include "src/frames-inl.h"
 #include "src/parser.h"
 #include "src/runtime/runtime.h"
 #include "src/runtime/runtime-utils.h"
@@ -267,6 +268,44 @@ MUST_USE_RESULT static MaybeHandle<Object> CreateLiteralBoilerplate(
 }
 
 
+// Applies a pretenuring decision preloaded from a code cache to a freshly
+// created literal allocation site. The decisions are keyed by the start
+// position of the function owning the literals array and the literal index.
+static void ApplyPreloadedPretenuringDecision(Isolate* isolate,
+                                              Handle<FixedArray> literals,
+                                              int literals_index,
+                                              Handle<AllocationSite> site) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  JavaScriptFrameIterator it(isolate);
+  if (it.done()) return;
+  JSFunction* function = it.frame()->function();
+  // Literals of inlined functions cannot be attributed without a deopt
+  // lookup; they simply learn their decision again.
+  if (function->literals() != *literals) return;
+  Object* script = function->shared()->script();
+  if (!script->IsScript()) return;
+  Object* hints = Script::cast(script)->pretenuring_hints();
+  if (!hints->IsFixedArray()) return;
+  FixedArray* array = FixedArray::cast(hints);
+  Smi* position = Smi::FromInt(function->shared()->start_position());
+  Smi* index = Smi::FromInt(literals_index);
+  for (int i = 0; i + 1 < array->length(); i += 2) {
+    if (array->get(i) != position || array->get(i + 1) != index) continue;
+    Object* current = *site;
+    while (current->IsAllocationSite()) {
+      AllocationSite* nested = AllocationSite::cast(current);
+      nested->set_pretenure_decision(AllocationSite::kTenure);
+      current = nested->nested_site();
+    }
+    if (FLAG_trace_pretenuring) {
+      PrintF("[Preloaded pretenuring decision for site %p]\n",
+             static_cast<void*>(*site));
+    }
+    return;
+  }
+}
+
+
 RUNTIME_FUNCTION(Runtime_CreateObjectLiteral) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
@@ -297,6 +336,7 @@ RUNTIME_FUNCTION(Runtime_CreateObjectLiteral) {
     RETURN_FAILURE_ON_EXCEPTION(
         isolate, JSObject::DeepWalk(boilerplate, &creation_context));
     creation_context.ExitScope(site, boilerplate);
+    ApplyPreloadedPretenuringDecision(isolate, literals, literals_index, site);
 
     // Update the functions literal and return the boilerplate.
     literals->set(literals_index, *site);
@@ -338,6 +378,7 @@ MUST_USE_RESULT static MaybeHandle<AllocationSite> GetLiteralAllocationSite(
       return Handle<AllocationSite>::null();
     }
     creation_context.ExitScope(site, Handle<JSObject>::cast(boilerplate));
+    ApplyPreloadedPretenuringDecision(isolate, literals, literals_index, site);
 
     literals->set(literals_index, *site);
   } else {
@@ -39,7 +39,8 @@ RUNTIME_FUNCTION(Runtime_SetIsObserved) {
 RUNTIME_FUNCTION(Runtime_EnqueueMicrotask) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
-  CONVERT_ARG_HANDLE_CHECKED(JSFunction, microtask, 0);
+  CONVERT_ARG_HANDLE_CHECKED(JSObject, microtask, 0);
+  RUNTIME_ASSERT(microtask->IsJSFunction() || microtask->IsJSArray());
   isolate->EnqueueMicrotask(microtask);
   return isolate->heap()->undefined_value();
 }
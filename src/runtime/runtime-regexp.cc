@@ -303,13 +303,17 @@ void FindTwoByteStringIndices(const Vector<const uc16> subject, uc16 pattern,
                               ZoneList<int>* indices, unsigned int limit,
                               Zone* zone) {
   DCHECK(limit > 0);
-  const uc16* subject_start = subject.start();
-  const uc16* subject_end = subject_start + subject.length();
-  for (const uc16* pos = subject_start; pos < subject_end && limit > 0; pos++) {
-    if (*pos == pattern) {
-      indices->Add(static_cast<int>(pos - subject_start), zone);
-      limit--;
-    }
+  // Collect indices of pattern in subject using memchr, see
+  // FindFirstCharacter.
+  // Stop after finding at most limit values.
+  Vector<const uc16> pattern_vector(&pattern, 1);
+  int index = 0;
+  while (limit > 0) {
+    index = FindFirstCharacter(pattern_vector, subject, index);
+    if (index < 0) return;
+    indices->Add(index, zone);
+    index++;
+    limit--;
   }
 }
 
@@ -465,6 +469,94 @@ MUST_USE_RESULT static Object* StringReplaceGlobalAtomRegExpWithString(
 }
 
 
+// Replaces all matches of an irregexp with a replacement that has no $
+// substitutions. The match boundaries are collected first so that the result
+// can be allocated with its final length and written directly, without any
+// intermediate objects per match.
+template <typename ResultSeqString>
+MUST_USE_RESULT static Object* StringReplaceGlobalRegExpWithLiteral(
+    Isolate* isolate, Handle<String> subject, Handle<JSRegExp> regexp,
+    Handle<String> replacement, Handle<JSArray> last_match_info, Zone* zone) {
+  DCHECK(subject->IsFlat());
+  DCHECK(replacement->IsFlat());
+
+  RegExpImpl::GlobalCache global_cache(regexp, subject, true, isolate);
+  if (global_cache.HasException()) return isolate->heap()->exception();
+
+  int32_t* current_match = global_cache.FetchNext();
+  if (current_match == NULL) {
+    if (global_cache.HasException()) return isolate->heap()->exception();
+    return *subject;
+  }
+
+  // Start and end of every match.
+  ZoneList<int> bounds(16, zone);
+  int64_t matched_length = 0;
+  do {
+    bounds.Add(current_match[0], zone);
+    bounds.Add(current_match[1], zone);
+    matched_length += current_match[1] - current_match[0];
+    current_match = global_cache.FetchNext();
+  } while (current_match != NULL);
+
+  if (global_cache.HasException()) return isolate->heap()->exception();
+
+  int subject_len = subject->length();
+  int replacement_len = replacement->length();
+  int matches = bounds.length() / 2;
+
+  // Detect integer overflow.
+  int64_t result_len_64 =
+      static_cast<int64_t>(replacement_len) * static_cast<int64_t>(matches) -
+      matched_length + static_cast<int64_t>(subject_len);
+  int result_len;
+  if (result_len_64 > static_cast<int64_t>(String::kMaxLength)) {
+    STATIC_ASSERT(String::kMaxLength < kMaxInt);
+    result_len = kMaxInt;  // Provoke exception.
+  } else {
+    result_len = static_cast<int>(result_len_64);
+  }
+
+  MaybeHandle<SeqString> maybe_res;
+  if (ResultSeqString::kHasOneByteEncoding) {
+    maybe_res = isolate->factory()->NewRawOneByteString(result_len);
+  } else {
+    maybe_res = isolate->factory()->NewRawTwoByteString(result_len);
+  }
+  Handle<SeqString> untyped_res;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(isolate, untyped_res, maybe_res);
+  Handle<ResultSeqString> result = Handle<ResultSeqString>::cast(untyped_res);
+
+  DisallowHeapAllocation no_gc;
+  int subject_pos = 0;
+  int result_pos = 0;
+  for (int i = 0; i < matches; i++) {
+    int start = bounds[i * 2];
+    // Copy non-matched subject content.
+    if (subject_pos < start) {
+      String::WriteToFlat(*subject, result->GetChars() + result_pos,
+                          subject_pos, start);
+      result_pos += start - subject_pos;
+    }
+    // Replace match.
+    String::WriteToFlat(*replacement, result->GetChars() + result_pos, 0,
+                        replacement_len);
+    result_pos += replacement_len;
+    subject_pos = bounds[i * 2 + 1];
+  }
+  // Add remaining subject content at the end.
+  if (subject_pos < subject_len) {
+    String::WriteToFlat(*subject, result->GetChars() + result_pos, subject_pos,
+                        subject_len);
+  }
+
+  RegExpImpl::SetLastMatchInfo(last_match_info, subject, regexp->CaptureCount(),
+                               global_cache.LastSuccessfulMatch());
+
+  return *result;
+}
+
+
 MUST_USE_RESULT static Object* StringReplaceGlobalRegExpWithString(
     Isolate* isolate, Handle<String> subject, Handle<JSRegExp> regexp,
     Handle<String> replacement, Handle<JSArray> last_match_info) {
@@ -491,6 +583,18 @@ MUST_USE_RESULT static Object* StringReplaceGlobalRegExpWithString(
     }
   }
 
+  if (simple_replace) {
+    if (subject->HasOnlyOneByteChars() && replacement->HasOnlyOneByteChars()) {
+      return StringReplaceGlobalRegExpWithLiteral<SeqOneByteString>(
+          isolate, subject, regexp, replacement, last_match_info,
+          zone_scope.zone());
+    } else {
+      return StringReplaceGlobalRegExpWithLiteral<SeqTwoByteString>(
+          isolate, subject, regexp, replacement, last_match_info,
+          zone_scope.zone());
+    }
+  }
+
   RegExpImpl::GlobalCache global_cache(regexp, subject, true, isolate);
   if (global_cache.HasException()) return isolate->heap()->exception();
 
@@ -523,11 +627,7 @@ MUST_USE_RESULT static Object* StringReplaceGlobalRegExpWithString(
       builder.AddSubjectSlice(prev, start);
     }
 
-    if (simple_replace) {
-      builder.AddString(replacement);
-    } else {
-      compiled_replacement.Apply(&builder, start, end, current_match);
-    }
+    compiled_replacement.Apply(&builder, start, end, current_match);
     prev = end;
 
     current_match = global_cache.FetchNext();
@@ -687,6 +787,10 @@ RUNTIME_FUNCTION(Runtime_StringSplit) {
   int pattern_length = pattern->length();
   RUNTIME_ASSERT(pattern_length > 0);
 
+  // The split cache is keyed by the identity of the flat subject.
+  subject = String::Flatten(subject);
+  pattern = String::Flatten(pattern);
+
   if (limit == 0xffffffffu) {
     Handle<Object> cached_answer(
         RegExpResultsCache::Lookup(isolate->heap(), *subject, *pattern,
@@ -704,9 +808,6 @@ RUNTIME_FUNCTION(Runtime_StringSplit) {
   // isn't empty, we can never create more parts than ~half the length
   // of the subject.
 
-  subject = String::Flatten(subject);
-  pattern = String::Flatten(pattern);
-
   static const int kMaxInitialListCapacity = 16;
 
   ZoneScope zone_scope(isolate->runtime_zone());
@@ -0,0 +1,352 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cmath>
+#include <limits>
+
+#include "src/v8.h"
+
+#include "src/arguments.h"
+#include "src/conversions-inl.h"
+#include "src/runtime/runtime.h"
+#include "src/runtime/runtime-utils.h"
+
+// The operations of the SIMD.js value types. harmony-simd.js checks the
+// arguments and converts the lanes to numbers, so the checks here only guard
+// against calls with the natives syntax. The operations are not inlined by
+// the optimizing compilers yet. SIMD values can only be created with
+// --harmony-simd, which sets up their wrapper functions.
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+template <class T>
+struct SimdTraits {};
+
+#define SIMD128_TRAITS(TYPE, Type, type, lane_count, lane_type)   \
+  template <>                                                     \
+  struct SimdTraits<Type> {                                       \
+    typedef lane_type LaneType;                                   \
+    static Handle<Type> New(Isolate* isolate, lane_type* lanes) { \
+      return isolate->factory()->New##Type(lanes);                \
+    }                                                             \
+  };
+SIMD128_TYPES(SIMD128_TRAITS)
+#undef SIMD128_TRAITS
+
+
+// Numbers are converted to lanes like they are stored into the elements of
+// the typed array with the same lane type.
+template <typename LaneType>
+LaneType NumberToLane(Object* number);
+
+
+template <>
+float NumberToLane<float>(Object* number) {
+  return DoubleToFloat32(number->Number());
+}
+
+
+template <>
+int32_t NumberToLane<int32_t>(Object* number) {
+  return NumberToInt32(number);
+}
+
+
+template <>
+double NumberToLane<double>(Object* number) {
+  return number->Number();
+}
+
+
+// The integer arithmetic wraps around instead of overflowing.
+template <typename LaneType>
+LaneType Add(LaneType a, LaneType b) { return a + b; }
+
+
+template <typename LaneType>
+LaneType Sub(LaneType a, LaneType b) { return a - b; }
+
+
+template <typename LaneType>
+LaneType Mul(LaneType a, LaneType b) { return a * b; }
+
+
+template <typename LaneType>
+LaneType Neg(LaneType a) { return -a; }
+
+
+template <>
+int32_t Add<int32_t>(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) +
+                              static_cast<uint32_t>(b));
+}
+
+
+template <>
+int32_t Sub<int32_t>(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) -
+                              static_cast<uint32_t>(b));
+}
+
+
+template <>
+int32_t Mul<int32_t>(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) *
+                              static_cast<uint32_t>(b));
+}
+
+
+template <>
+int32_t Neg<int32_t>(int32_t a) {
+  return static_cast<int32_t>(0u - static_cast<uint32_t>(a));
+}
+
+
+template <typename LaneType>
+LaneType Div(LaneType a, LaneType b) { return a / b; }
+
+
+// Like Math.min and Math.max, NaN lanes propagate and -0 is less than 0.
+template <typename LaneType>
+LaneType SimdMin(LaneType a, LaneType b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::numeric_limits<LaneType>::quiet_NaN();
+  }
+  if (a == b) return std::signbit(a) ? a : b;
+  return a < b ? a : b;
+}
+
+
+template <typename LaneType>
+LaneType SimdMax(LaneType a, LaneType b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::numeric_limits<LaneType>::quiet_NaN();
+  }
+  if (a == b) return std::signbit(a) ? b : a;
+  return a > b ? a : b;
+}
+
+
+template <typename LaneType>
+LaneType SimdAbs(LaneType a) { return std::fabs(a); }
+
+
+template <typename LaneType>
+LaneType Sqrt(LaneType a) { return std::sqrt(a); }
+
+
+int32_t And(int32_t a, int32_t b) { return a & b; }
+int32_t Or(int32_t a, int32_t b) { return a | b; }
+int32_t Xor(int32_t a, int32_t b) { return a ^ b; }
+int32_t Not(int32_t a) { return ~a; }
+
+
+template <class T>
+Handle<T> UnaryOperation(
+    Isolate* isolate, Handle<T> a,
+    typename SimdTraits<T>::LaneType (*operation)(
+        typename SimdTraits<T>::LaneType)) {
+  typename SimdTraits<T>::LaneType lanes[T::kLanes];
+  for (int i = 0; i < T::kLanes; i++) lanes[i] = operation(a->get_lane(i));
+  return SimdTraits<T>::New(isolate, lanes);
+}
+
+
+template <class T>
+Handle<T> BinaryOperation(
+    Isolate* isolate, Handle<T> a, Handle<T> b,
+    typename SimdTraits<T>::LaneType (*operation)(
+        typename SimdTraits<T>::LaneType, typename SimdTraits<T>::LaneType)) {
+  typename SimdTraits<T>::LaneType lanes[T::kLanes];
+  for (int i = 0; i < T::kLanes; i++) {
+    lanes[i] = operation(a->get_lane(i), b->get_lane(i));
+  }
+  return SimdTraits<T>::New(isolate, lanes);
+}
+
+
+// Returns the address of the kSimd128Size bytes at element |index| of
+// |array|, or NULL if they are not all within the array.
+void* SimdElementAddress(Isolate* isolate, Handle<JSTypedArray> array,
+                         double index) {
+  size_t length = NumberToSize(isolate, array->length());
+  size_t byte_length = NumberToSize(isolate, array->byte_length());
+  if (length == 0 || index < 0) return NULL;
+  size_t element_size = byte_length / length;
+  double byte_index = index * element_size;
+  if (byte_index + kSimd128Size > byte_length) return NULL;
+  Handle<JSArrayBuffer> buffer = array->GetBuffer();
+  size_t byte_offset = NumberToSize(isolate, array->byte_offset());
+  return static_cast<uint8_t*>(buffer->backing_store()) + byte_offset +
+         static_cast<size_t>(byte_index);
+}
+
+}  // namespace
+
+
+RUNTIME_FUNCTION(Runtime_NewSimd128Wrapper) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(Simd128Value, value, 0);
+  return *Object::ToObject(isolate, value).ToHandleChecked();
+}
+
+
+#define SIMD128_FUNCTIONS(TYPE, Type, type, lane_count, lane_type)          \
+  RUNTIME_FUNCTION(Runtime_Create##Type) {                                  \
+    HandleScope scope(isolate);                                             \
+    DCHECK(args.length() == lane_count);                                    \
+    RUNTIME_ASSERT(FLAG_harmony_simd);                                      \
+    lane_type lanes[lane_count];                                            \
+    for (int i = 0; i < lane_count; i++) {                                  \
+      RUNTIME_ASSERT(args[i]->IsNumber());                                  \
+      lanes[i] = NumberToLane<lane_type>(args[i]);                          \
+    }                                                                       \
+    return *isolate->factory()->New##Type(lanes);                           \
+  }                                                                         \
+                                                                            \
+                                                                            \
+  RUNTIME_FUNCTION(Runtime_##Type##ExtractLane) {                           \
+    HandleScope scope(isolate);                                             \
+    DCHECK(args.length() == 2);                                             \
+    CONVERT_ARG_HANDLE_CHECKED(Type, a, 0);                                 \
+    CONVERT_INT32_ARG_CHECKED(lane, 1);                                     \
+    RUNTIME_ASSERT(lane >= 0 && lane < lane_count);                         \
+    return *isolate->factory()->NewNumber(a->get_lane(lane));               \
+  }                                                                         \
+                                                                            \
+                                                                            \
+  RUNTIME_FUNCTION(Runtime_##Type##ReplaceLane) {                           \
+    HandleScope scope(isolate);                                             \
+    DCHECK(args.length() == 3);                                             \
+    CONVERT_ARG_HANDLE_CHECKED(Type, a, 0);                                 \
+    CONVERT_INT32_ARG_CHECKED(lane, 1);                                     \
+    RUNTIME_ASSERT(lane >= 0 && lane < lane_count);                         \
+    RUNTIME_ASSERT(args[2]->IsNumber());                                    \
+    lane_type lanes[lane_count];                                            \
+    for (int i = 0; i < lane_count; i++) lanes[i] = a->get_lane(i);         \
+    lanes[lane] = NumberToLane<lane_type>(args[2]);                         \
+    return *isolate->factory()->New##Type(lanes);                           \
+  }                                                                         \
+                                                                            \
+                                                                            \
+  RUNTIME_FUNCTION(Runtime_##Type##Load) {                                  \
+    HandleScope scope(isolate);                                             \
+    DCHECK(args.length() == 2);                                             \
+    RUNTIME_ASSERT(FLAG_harmony_simd);                                      \
+    CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);                     \
+    CONVERT_DOUBLE_ARG_CHECKED(index, 1);                                   \
+    void* address = SimdElementAddress(isolate, array, index);              \
+    if (address == NULL) {                                                  \
+      THROW_NEW_ERROR_RETURN_FAILURE(                                       \
+          isolate, NewRangeError("invalid_simd_access_index",               \
+                                 HandleVector<Object>(NULL, 0)));           \
+    }                                                                       \
+    lane_type lanes[lane_count];                                            \
+    MemCopy(lanes, address, kSimd128Size);                                  \
+    return *isolate->factory()->New##Type(lanes);                           \
+  }                                                                         \
+                                                                            \
+                                                                            \
+  RUNTIME_FUNCTION(Runtime_##Type##Store) {                                 \
+    HandleScope scope(isolate);                                             \
+    DCHECK(args.length() == 3);                                             \
+    CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);                     \
+    CONVERT_DOUBLE_ARG_CHECKED(index, 1);                                   \
+    CONVERT_ARG_HANDLE_CHECKED(Type, value, 2);                             \
+    void* address = SimdElementAddress(isolate, array, index);              \
+    if (address == NULL) {                                                  \
+      THROW_NEW_ERROR_RETURN_FAILURE(                                       \
+          isolate, NewRangeError("invalid_simd_access_index",               \
+                                 HandleVector<Object>(NULL, 0)));           \
+    }                                                                       \
+    lane_type lanes[lane_count];                                            \
+    for (int i = 0; i < lane_count; i++) lanes[i] = value->get_lane(i);     \
+    MemCopy(address, lanes, kSimd128Size);                                  \
+    return *value;                                                          \
+  }
+
+SIMD128_TYPES(SIMD128_FUNCTIONS)
+#undef SIMD128_FUNCTIONS
+
+
+#define SIMD128_UNARY_FUNCTION(Type, Name, operation)         \
+  RUNTIME_FUNCTION(Runtime_##Type##Name) {                    \
+    HandleScope scope(isolate);                               \
+    DCHECK(args.length() == 1);                               \
+    CONVERT_ARG_HANDLE_CHECKED(Type, a, 0);                   \
+    return *UnaryOperation<Type>(isolate, a, operation);      \
+  }
+
+#define SIMD128_BINARY_FUNCTION(Type, Name, operation)        \
+  RUNTIME_FUNCTION(Runtime_##Type##Name) {                    \
+    HandleScope scope(isolate);                               \
+    DCHECK(args.length() == 2);                               \
+    CONVERT_ARG_HANDLE_CHECKED(Type, a, 0);                   \
+    CONVERT_ARG_HANDLE_CHECKED(Type, b, 1);                   \
+    return *BinaryOperation<Type>(isolate, a, b, operation);  \
+  }
+
+SIMD128_BINARY_FUNCTION(Float32x4, Add, Add<float>)
+SIMD128_BINARY_FUNCTION(Float32x4, Sub, Sub<float>)
+SIMD128_BINARY_FUNCTION(Float32x4, Mul, Mul<float>)
+SIMD128_BINARY_FUNCTION(Float32x4, Div, Div<float>)
+SIMD128_BINARY_FUNCTION(Float32x4, Min, SimdMin<float>)
+SIMD128_BINARY_FUNCTION(Float32x4, Max, SimdMax<float>)
+SIMD128_UNARY_FUNCTION(Float32x4, Neg, Neg<float>)
+SIMD128_UNARY_FUNCTION(Float32x4, Abs, SimdAbs<float>)
+SIMD128_UNARY_FUNCTION(Float32x4, Sqrt, Sqrt<float>)
+
+SIMD128_BINARY_FUNCTION(Int32x4, Add, Add<int32_t>)
+SIMD128_BINARY_FUNCTION(Int32x4, Sub, Sub<int32_t>)
+SIMD128_BINARY_FUNCTION(Int32x4, Mul, Mul<int32_t>)
+SIMD128_BINARY_FUNCTION(Int32x4, And, And)
+SIMD128_BINARY_FUNCTION(Int32x4, Or, Or)
+SIMD128_BINARY_FUNCTION(Int32x4, Xor, Xor)
+SIMD128_UNARY_FUNCTION(Int32x4, Neg, Neg<int32_t>)
+SIMD128_UNARY_FUNCTION(Int32x4, Not, Not)
+
+SIMD128_BINARY_FUNCTION(Float64x2, Add, Add<double>)
+SIMD128_BINARY_FUNCTION(Float64x2, Sub, Sub<double>)
+SIMD128_BINARY_FUNCTION(Float64x2, Mul, Mul<double>)
+SIMD128_BINARY_FUNCTION(Float64x2, Div, Div<double>)
+SIMD128_BINARY_FUNCTION(Float64x2, Min, SimdMin<double>)
+SIMD128_BINARY_FUNCTION(Float64x2, Max, SimdMax<double>)
+SIMD128_UNARY_FUNCTION(Float64x2, Neg, Neg<double>)
+SIMD128_UNARY_FUNCTION(Float64x2, Abs, SimdAbs<double>)
+SIMD128_UNARY_FUNCTION(Float64x2, Sqrt, Sqrt<double>)
+
+#undef SIMD128_UNARY_FUNCTION
+#undef SIMD128_BINARY_FUNCTION
+
+
+RUNTIME_FUNCTION(Runtime_Float32x4FromInt32x4) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(Int32x4, a, 0);
+  float lanes[Float32x4::kLanes];
+  for (int i = 0; i < Float32x4::kLanes; i++) {
+    lanes[i] = static_cast<float>(a->get_lane(i));
+  }
+  return *isolate->factory()->NewFloat32x4(lanes);
+}
+
+
+// The lanes are converted like ToInt32, so they wrap around.
+RUNTIME_FUNCTION(Runtime_Int32x4FromFloat32x4) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(Float32x4, a, 0);
+  int32_t lanes[Int32x4::kLanes];
+  for (int i = 0; i < Int32x4::kLanes; i++) {
+    lanes[i] = DoubleToInt32(a->get_lane(i));
+  }
+  return *isolate->factory()->NewInt32x4(lanes);
+}
+
+}  // namespace internal
+}  // namespace v8
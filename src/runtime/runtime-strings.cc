@@ -349,15 +349,25 @@ RUNTIME_FUNCTION(Runtime_StringCharCodeAtRT) {
   CONVERT_ARG_HANDLE_CHECKED(String, subject, 0);
   CONVERT_NUMBER_CHECKED(uint32_t, i, Uint32, args[1]);
 
-  // Flatten the string.  If someone wants to get a char at an index
-  // in a cons string, it is likely that more indices will be
-  // accessed.
-  subject = String::Flatten(subject);
-
   if (i >= static_cast<uint32_t>(subject->length())) {
     return isolate->heap()->nan_value();
   }
 
+  // Flatten the string.  If someone wants to get a char at an index
+  // in a cons string, it is likely that more indices will be
+  // accessed. Only do so on the second access to the same cons string
+  // though: a string that is built up by concatenation and read between
+  // appends is a new cons string each time, and copying it for every read
+  // is quadratic.
+  if (subject->IsConsString() && !subject->IsFlat()) {
+    RuntimeState* state = isolate->runtime_state();
+    if (state->last_unflattened_cons_string() != subject->address()) {
+      state->set_last_unflattened_cons_string(subject->address());
+      return Smi::FromInt(subject->Get(i));
+    }
+  }
+  subject = String::Flatten(subject);
+
   return Smi::FromInt(subject->Get(i));
 }
 
@@ -514,6 +524,40 @@ RUNTIME_FUNCTION(Runtime_StringBuilderConcat) {
 }
 
 
+// Writes the strings in {elements}, separated by {separator}, to {buffer},
+// which must have exactly the right length.
+template <typename Char>
+static void JoinFlatArrayWithSeparator(FixedArray* elements,
+                                       int elements_length,
+                                       String* separator,
+                                       Vector<Char> buffer) {
+  DisallowHeapAllocation no_gc;
+  int separator_length = separator->length();
+  Char* sink = buffer.start();
+#ifdef DEBUG
+  Char* end = sink + buffer.length();
+#endif
+
+  String* first = String::cast(elements->get(0));
+  int first_length = first->length();
+  String::WriteToFlat(first, sink, 0, first_length);
+  sink += first_length;
+
+  for (int i = 1; i < elements_length; i++) {
+    DCHECK(sink + separator_length <= end);
+    String::WriteToFlat(separator, sink, 0, separator_length);
+    sink += separator_length;
+
+    String* element = String::cast(elements->get(i));
+    int element_length = element->length();
+    DCHECK(sink + element_length <= end);
+    String::WriteToFlat(element, sink, 0, element_length);
+    sink += element_length;
+  }
+  DCHECK(sink == end);
+}
+
+
 RUNTIME_FUNCTION(Runtime_StringBuilderJoin) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
@@ -546,7 +590,10 @@ RUNTIME_FUNCTION(Runtime_StringBuilderJoin) {
   if (max_nof_separators < (array_length - 1)) {
     THROW_NEW_ERROR_RETURN_FAILURE(isolate, NewInvalidStringLengthError());
   }
+  // The first pass computes the length and representation of the result,
+  // so that the second pass can write it into a string of the right size.
   int length = (array_length - 1) * separator_length;
+  bool one_byte = separator->IsOneByteRepresentation();
   for (int i = 0; i < array_length; i++) {
     Object* element_obj = fixed_array->get(i);
     RUNTIME_ASSERT(element_obj->IsString());
@@ -558,42 +605,25 @@ RUNTIME_FUNCTION(Runtime_StringBuilderJoin) {
       break;
     }
     length += increment;
+    one_byte = one_byte && element->IsOneByteRepresentation();
+  }
+
+  // %_FastOneByteArrayJoin handles sequential one-byte elements, but cons
+  // strings and external strings still end up here.
+  if (one_byte) {
+    Handle<SeqOneByteString> answer;
+    ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+        isolate, answer, isolate->factory()->NewRawOneByteString(length));
+    JoinFlatArrayWithSeparator(*fixed_array, array_length, *separator,
+                               Vector<uint8_t>(answer->GetChars(), length));
+    return *answer;
   }
 
   Handle<SeqTwoByteString> answer;
   ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
       isolate, answer, isolate->factory()->NewRawTwoByteString(length));
-
-  DisallowHeapAllocation no_gc;
-
-  uc16* sink = answer->GetChars();
-#ifdef DEBUG
-  uc16* end = sink + length;
-#endif
-
-  RUNTIME_ASSERT(fixed_array->get(0)->IsString());
-  String* first = String::cast(fixed_array->get(0));
-  String* separator_raw = *separator;
-  int first_length = first->length();
-  String::WriteToFlat(first, sink, 0, first_length);
-  sink += first_length;
-
-  for (int i = 1; i < array_length; i++) {
-    DCHECK(sink + separator_length <= end);
-    String::WriteToFlat(separator_raw, sink, 0, separator_length);
-    sink += separator_length;
-
-    RUNTIME_ASSERT(fixed_array->get(i)->IsString());
-    String* element = String::cast(fixed_array->get(i));
-    int element_length = element->length();
-    DCHECK(sink + element_length <= end);
-    String::WriteToFlat(element, sink, 0, element_length);
-    sink += element_length;
-  }
-  DCHECK(sink == end);
-
-  // Use %_FastOneByteArrayJoin instead.
-  DCHECK(!answer->IsOneByteRepresentation());
+  JoinFlatArrayWithSeparator(*fixed_array, array_length, *separator,
+                             Vector<uc16>(answer->GetChars(), length));
   return *answer;
 }
 
@@ -126,6 +126,28 @@ RUNTIME_FUNCTION(Runtime_ArrayBufferInitialize) {
 }
 
 
+RUNTIME_FUNCTION(Runtime_SharedArrayBufferInitialize) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSArrayBuffer, holder, 0);
+  CONVERT_NUMBER_ARG_HANDLE_CHECKED(byteLength, 1);
+  if (!holder->byte_length()->IsUndefined()) {
+    // SharedArrayBuffer is already initialized; probably a fuzz test.
+    return *holder;
+  }
+  size_t allocated_length = 0;
+  if (!TryNumberToSize(isolate, *byteLength, &allocated_length) ||
+      !Runtime::SetupArrayBufferAllocatingData(isolate, holder,
+                                               allocated_length)) {
+    THROW_NEW_ERROR_RETURN_FAILURE(
+        isolate, NewRangeError("invalid_array_buffer_length",
+                               HandleVector<Object>(NULL, 0)));
+  }
+  holder->set_is_shared(true);
+  return *holder;
+}
+
+
 RUNTIME_FUNCTION(Runtime_ArrayBufferGetByteLength) {
   SealHandleScope shs(isolate);
   DCHECK(args.length() == 1);
@@ -174,6 +196,7 @@ RUNTIME_FUNCTION(Runtime_ArrayBufferNeuter) {
     return isolate->heap()->undefined_value();
   }
   DCHECK(!array_buffer->is_external());
+  RUNTIME_ASSERT(!array_buffer->is_shared());
   void* backing_store = array_buffer->backing_store();
   size_t byte_length = NumberToSize(isolate, array_buffer->byte_length());
   array_buffer->set_is_external(true);
@@ -292,6 +315,134 @@ RUNTIME_FUNCTION(Runtime_TypedArrayInitialize) {
 // initializes backing store using memove.
 //
 // Returns true if backing store was initialized or false otherwise.
+// Converts a single typed array element the way an element store of the
+// loaded value would. Integer sources wrap or widen, floating point sources
+// go through ToInt32 for integer targets.
+template <typename Target, typename Source>
+struct TypedArrayElementConverter {
+  static Target Convert(Source value) { return static_cast<Target>(value); }
+};
+
+template <typename Target>
+struct TypedArrayElementConverter<Target, double> {
+  static Target Convert(double value) {
+    return static_cast<Target>(DoubleToInt32(value));
+  }
+};
+
+template <typename Target>
+struct TypedArrayElementConverter<Target, float> {
+  static Target Convert(float value) {
+    return static_cast<Target>(DoubleToInt32(value));
+  }
+};
+
+template <>
+struct TypedArrayElementConverter<float, double> {
+  static float Convert(double value) { return static_cast<float>(value); }
+};
+
+template <>
+struct TypedArrayElementConverter<double, double> {
+  static double Convert(double value) { return value; }
+};
+
+template <>
+struct TypedArrayElementConverter<float, float> {
+  static float Convert(float value) { return value; }
+};
+
+template <>
+struct TypedArrayElementConverter<double, float> {
+  static double Convert(float value) { return value; }
+};
+
+
+// Clamps a typed array element for a Uint8ClampedArray target.
+template <typename Source>
+struct TypedArrayElementClamper {
+  static uint8_t Convert(Source value) {
+    if (!(value > 0)) return 0;
+    if (value > 255) return 255;
+    return static_cast<uint8_t>(value);
+  }
+};
+
+template <>
+struct TypedArrayElementClamper<double> {
+  static uint8_t Convert(double value) {
+    if (!(value > 0)) return 0;  // NaN and less than zero clamp to zero.
+    if (value > 255) return 255;
+    return static_cast<uint8_t>(lrint(value));
+  }
+};
+
+template <>
+struct TypedArrayElementClamper<float> {
+  static uint8_t Convert(float value) {
+    return TypedArrayElementClamper<double>::Convert(value);
+  }
+};
+
+
+// The loops below work on plain arrays of the element types without any
+// aliasing between source and target, which lets the C++ compiler
+// vectorize them for the target architecture.
+template <ExternalArrayType kTargetType, typename Target, typename Source>
+static void ConvertTypedArrayElements(void* target, const void* source,
+                                      size_t length) {
+  Target* dst = static_cast<Target*>(target);
+  const Source* src = static_cast<const Source*>(source);
+  if (kTargetType == kExternalUint8ClampedArray) {
+    for (size_t i = 0; i < length; i++) {
+      dst[i] = TypedArrayElementClamper<Source>::Convert(src[i]);
+    }
+  } else {
+    for (size_t i = 0; i < length; i++) {
+      dst[i] = TypedArrayElementConverter<Target, Source>::Convert(src[i]);
+    }
+  }
+}
+
+
+template <typename Source>
+static void ConvertTypedArrayElementsFrom(ExternalArrayType target_type,
+                                          void* target, const void* source,
+                                          size_t length) {
+  switch (target_type) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                    \
+  case kExternal##Type##Array:                                           \
+    ConvertTypedArrayElements<kExternal##Type##Array, ctype, Source>(    \
+        target, source, length);                                         \
+    return;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  UNREACHABLE();
+}
+
+
+// Copies {length} elements of type {source_type} at {source} to {target},
+// converting them to {target_type}. The two ranges must not overlap.
+static void ConvertTypedArrayElements(ExternalArrayType target_type,
+                                      void* target,
+                                      ExternalArrayType source_type,
+                                      const void* source, size_t length) {
+  switch (source_type) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                     \
+  case kExternal##Type##Array:                                            \
+    ConvertTypedArrayElementsFrom<ctype>(target_type, target, source,     \
+                                         length);                         \
+    return;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  UNREACHABLE();
+}
+
+
 RUNTIME_FUNCTION(Runtime_TypedArrayInitializeFromArrayLike) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
@@ -314,8 +465,7 @@ RUNTIME_FUNCTION(Runtime_TypedArrayInitializeFromArrayLike) {
   RUNTIME_ASSERT(holder->map()->elements_kind() == fixed_elements_kind);
 
   Handle<JSArrayBuffer> buffer = isolate->factory()->NewJSArrayBuffer();
-  if (source->IsJSTypedArray() &&
-      JSTypedArray::cast(*source)->type() == array_type) {
+  if (source->IsJSTypedArray()) {
     length_obj = Handle<Object>(JSTypedArray::cast(*source)->length(), isolate);
   }
   size_t length = 0;
@@ -376,16 +526,20 @@ RUNTIME_FUNCTION(Runtime_TypedArrayInitializeFromArrayLike) {
 
   if (source->IsJSTypedArray()) {
     Handle<JSTypedArray> typed_array(JSTypedArray::cast(*source));
-
+    uint8_t* backing_store =
+        static_cast<uint8_t*>(typed_array->GetBuffer()->backing_store());
+    size_t source_byte_offset =
+        NumberToSize(isolate, typed_array->byte_offset());
+    // The new buffer cannot overlap with the source.
     if (typed_array->type() == holder->type()) {
-      uint8_t* backing_store =
-          static_cast<uint8_t*>(typed_array->GetBuffer()->backing_store());
-      size_t source_byte_offset =
-          NumberToSize(isolate, typed_array->byte_offset());
       memcpy(buffer->backing_store(), backing_store + source_byte_offset,
              byte_length);
-      return isolate->heap()->true_value();
+    } else {
+      ConvertTypedArrayElements(holder->type(), buffer->backing_store(),
+                                typed_array->type(),
+                                backing_store + source_byte_offset, length);
     }
+    return isolate->heap()->true_value();
   }
 
   return isolate->heap()->false_value();
@@ -418,15 +572,11 @@ RUNTIME_FUNCTION(Runtime_TypedArrayGetBuffer) {
 // Return codes for Runtime_TypedArraySetFastCases.
 // Should be synchronized with typedarray.js natives.
 enum TypedArraySetResultCodes {
-  // Set from typed array of the same type.
+  // Set from typed array of any type.
   // This is processed by TypedArraySetFastCases
-  TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE = 0,
-  // Set from typed array of the different type, overlapping in memory.
-  TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING = 1,
-  // Set from typed array of the different type, non-overlapping.
-  TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING = 2,
+  TYPED_ARRAY_SET_TYPED_ARRAY = 0,
   // Set from non-typed array.
-  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 3
+  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 1
 };
 
 
@@ -474,10 +624,12 @@ RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
   if (target->type() == source->type()) {
     memmove(target_base + offset * target->element_size(), source_base,
             source_byte_length);
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE);
+    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY);
   }
 
-  // Typed arrays of different types over the same backing store
+  // Typed arrays of different types over the same backing store: convert
+  // from a copy of the source so that no element is overwritten before it
+  // is read.
   if ((source_base <= target_base &&
        source_base + source_byte_length > target_base) ||
       (target_base <= source_base &&
@@ -485,10 +637,17 @@ RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
     // We do not support overlapping ArrayBuffers
     DCHECK(target->GetBuffer()->backing_store() ==
            source->GetBuffer()->backing_store());
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING);
+    ScopedVector<uint8_t> copy(static_cast<int>(source_byte_length));
+    CopyBytes(copy.start(), source_base, source_byte_length);
+    ConvertTypedArrayElements(
+        target->type(), target_base + offset * target->element_size(),
+        source->type(), copy.start(), source_length);
   } else {  // Non-overlapping typed arrays
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING);
+    ConvertTypedArrayElements(
+        target->type(), target_base + offset * target->element_size(),
+        source->type(), source_base, source_length);
   }
+  return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY);
 }
 
 
@@ -277,6 +277,355 @@ MaybeHandle<String> URIEscape::Escape(Isolate* isolate, Handle<String> string) {
 }
 
 
+// Implements encodeURI, encodeURIComponent, decodeURI and decodeURIComponent
+// (ECMA-262, section 15.1.3). A first pass over the input validates it and
+// computes the length of the result, which is then written directly into a
+// sequential string of that length.
+class URICoding : public AllStatic {
+ public:
+  template <typename Char>
+  MUST_USE_RESULT static MaybeHandle<String> Encode(Isolate* isolate,
+                                                    Handle<String> string,
+                                                    bool component);
+
+  template <typename Char>
+  MUST_USE_RESULT static MaybeHandle<String> Decode(Isolate* isolate,
+                                                    Handle<String> string,
+                                                    bool component);
+
+ private:
+  // Classes of ASCII characters. Reserved characters are neither escaped by
+  // encodeURI nor unescaped by decodeURI, unreserved characters are never
+  // escaped.
+  enum CharClass { kEscaped = 0, kReserved = 1, kUnreserved = 2 };
+
+  static const char kHexChars[17];
+  static const char kCharClass[128];
+
+  static bool IsUnescaped(uc16 c, bool component) {
+    if (c >= arraysize(kCharClass)) return false;
+    return kCharClass[c] == kUnreserved ||
+           (!component && kCharClass[c] == kReserved);
+  }
+
+  static bool IsKeptEscaped(int c, bool component) {
+    return !component && c < static_cast<int>(arraysize(kCharClass)) &&
+           kCharClass[c] == kReserved;
+  }
+
+  static inline int HexValue(uc16 c);
+
+  template <typename Char>
+  static inline int DecodeOctet(Vector<const Char> vector, int i);
+
+  template <typename Char>
+  static int DecodeSequence(Vector<const Char> vector, int i, int* step);
+
+  template <typename Char, typename SinkChar>
+  static void DecodeInto(Vector<const Char> vector, bool component,
+                         SinkChar* dest);
+
+  static uint8_t* WriteEscaped(uint8_t* dest, uc32 code);
+
+  MUST_USE_RESULT static MaybeHandle<String> ThrowMalformed(Isolate* isolate);
+};
+
+
+const char URICoding::kHexChars[] = "0123456789ABCDEF";
+
+
+// kCharClass is generated by the following:
+//
+// #!/bin/perl
+// for (my $i = 0; $i < 128; $i++) {
+//   my $c = chr($i);
+//   my $class = 0;
+//   $class = 1 if $c =~ m@[;/?:\@&=+\$,#]@;
+//   $class = 2 if $c =~ m@[A-Za-z0-9\-_.!~*'()]@;
+//   print "$class, ";
+// }
+
+const char URICoding::kCharClass[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 1, 0, 1, 2, 2, 2, 2, 1, 1, 2, 2, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 0, 1, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 2,
+    0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 0, 0, 0, 2, 0};
+
+
+int URICoding::HexValue(uc16 c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+
+// Returns the octet escaped as "%XY" at index i, or -1 if there is none.
+template <typename Char>
+int URICoding::DecodeOctet(Vector<const Char> vector, int i) {
+  if (vector[i] != '%') return -1;
+  int hi = HexValue(vector[i + 1]);
+  int lo = HexValue(vector[i + 2]);
+  if (hi < 0 || lo < 0) return -1;
+  return (hi << 4) | lo;
+}
+
+
+// Decodes the UTF-8 sequence of escaped octets starting with the '%' at
+// index i. Returns the code point and sets step to the number of characters
+// it spans, or returns -1 if the sequence is malformed.
+template <typename Char>
+int URICoding::DecodeSequence(Vector<const Char> vector, int i, int* step) {
+  DCHECK_EQ('%', vector[i]);
+  int length = vector.length();
+  if (i + 3 > length) return -1;
+  int octet = DecodeOctet(vector, i);
+  if (octet < 0) return -1;
+  *step = 3;
+  if (octet < 0x80) return octet;
+
+  int count;
+  int value;
+  int min_value;
+  if (octet < 0xc2) {
+    return -1;
+  } else if (octet < 0xe0) {
+    count = 2;
+    value = octet & 0x1f;
+    min_value = 0x80;
+  } else if (octet < 0xf0) {
+    count = 3;
+    value = octet & 0x0f;
+    min_value = 0x800;
+  } else if (octet < 0xf8) {
+    count = 4;
+    value = octet & 0x07;
+    min_value = 0x10000;
+  } else {
+    return -1;
+  }
+  if (i + 3 * count > length) return -1;
+  for (int k = 1; k < count; k++) {
+    octet = DecodeOctet(vector, i + 3 * k);
+    if (octet < 0x80 || octet > 0xbf) return -1;
+    value = (value << 6) | (octet & 0x3f);
+  }
+  if (value < min_value || value > 0x10ffff) return -1;
+  if (unibrow::Utf16::IsLeadSurrogate(value) ||
+      unibrow::Utf16::IsTrailSurrogate(value)) {
+    return -1;
+  }
+  *step = 3 * count;
+  return value;
+}
+
+
+// Writes the decoded input to dest, which must have room for the length
+// computed by Decode.
+template <typename Char, typename SinkChar>
+void URICoding::DecodeInto(Vector<const Char> vector, bool component,
+                           SinkChar* dest) {
+  int length = vector.length();
+  for (int i = 0; i < length;) {
+    Char c = vector[i];
+    if (c != '%') {
+      *dest++ = static_cast<SinkChar>(c);
+      i++;
+      continue;
+    }
+    int step;
+    int value = DecodeSequence(vector, i, &step);
+    DCHECK(value >= 0);
+    if (IsKeptEscaped(value, component)) {
+      dest[0] = static_cast<SinkChar>(vector[i]);
+      dest[1] = static_cast<SinkChar>(vector[i + 1]);
+      dest[2] = static_cast<SinkChar>(vector[i + 2]);
+      dest += 3;
+    } else if (value >
+               static_cast<int>(unibrow::Utf16::kMaxNonSurrogateCharCode)) {
+      *dest++ = static_cast<SinkChar>(unibrow::Utf16::LeadSurrogate(value));
+      *dest++ = static_cast<SinkChar>(unibrow::Utf16::TrailSurrogate(value));
+    } else {
+      *dest++ = static_cast<SinkChar>(value);
+    }
+    i += step;
+  }
+}
+
+
+// Writes the UTF-8 encoding of code as escaped octets.
+uint8_t* URICoding::WriteEscaped(uint8_t* dest, uc32 code) {
+  uint8_t octets[4];
+  int count;
+  if (code < 0x80) {
+    octets[0] = code;
+    count = 1;
+  } else if (code < 0x800) {
+    octets[0] = 0xc0 | (code >> 6);
+    octets[1] = 0x80 | (code & 0x3f);
+    count = 2;
+  } else if (code < 0x10000) {
+    octets[0] = 0xe0 | (code >> 12);
+    octets[1] = 0x80 | ((code >> 6) & 0x3f);
+    octets[2] = 0x80 | (code & 0x3f);
+    count = 3;
+  } else {
+    octets[0] = 0xf0 | (code >> 18);
+    octets[1] = 0x80 | ((code >> 12) & 0x3f);
+    octets[2] = 0x80 | ((code >> 6) & 0x3f);
+    octets[3] = 0x80 | (code & 0x3f);
+    count = 4;
+  }
+  for (int i = 0; i < count; i++) {
+    *dest++ = '%';
+    *dest++ = kHexChars[octets[i] >> 4];
+    *dest++ = kHexChars[octets[i] & 0xf];
+  }
+  return dest;
+}
+
+
+MaybeHandle<String> URICoding::ThrowMalformed(Isolate* isolate) {
+  Handle<String> message =
+      isolate->factory()->NewStringFromStaticChars("URI malformed");
+  THROW_NEW_ERROR(isolate, NewError("$URIError", message), String);
+}
+
+
+template <typename Char>
+MaybeHandle<String> URICoding::Encode(Isolate* isolate, Handle<String> string,
+                                      bool component) {
+  DCHECK(string->IsFlat());
+  int length = string->length();
+  int encoded_length = 0;
+  bool malformed = false;
+  {
+    DisallowHeapAllocation no_allocation;
+    Vector<const Char> vector = GetCharVector<Char>(string);
+    for (int i = 0; i < length; i++) {
+      uc16 c = vector[i];
+      if (IsUnescaped(c, component)) {
+        encoded_length++;
+      } else if (c < 0x80) {
+        encoded_length += 3;
+      } else if (c < 0x800) {
+        encoded_length += 6;
+      } else if (unibrow::Utf16::IsLeadSurrogate(c)) {
+        if (i + 1 == length ||
+            !unibrow::Utf16::IsTrailSurrogate(vector[i + 1])) {
+          malformed = true;
+          break;
+        }
+        encoded_length += 12;
+        i++;
+      } else if (unibrow::Utf16::IsTrailSurrogate(c)) {
+        malformed = true;
+        break;
+      } else {
+        encoded_length += 9;
+      }
+
+      // We don't allow strings that are longer than a maximal length.
+      DCHECK(String::kMaxLength < 0x7fffffff - 12);    // Cannot overflow.
+      if (encoded_length > String::kMaxLength) break;  // Provoke exception.
+    }
+  }
+  if (malformed) return ThrowMalformed(isolate);
+
+  // No length change implies no change.  Return original string if no change.
+  if (encoded_length == length) return string;
+
+  Handle<SeqOneByteString> dest;
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate, dest, isolate->factory()->NewRawOneByteString(encoded_length),
+      String);
+
+  {
+    DisallowHeapAllocation no_allocation;
+    Vector<const Char> vector = GetCharVector<Char>(string);
+    uint8_t* chars = dest->GetChars();
+    for (int i = 0; i < length; i++) {
+      uc16 c = vector[i];
+      if (IsUnescaped(c, component)) {
+        *chars++ = static_cast<uint8_t>(c);
+      } else if (unibrow::Utf16::IsLeadSurrogate(c)) {
+        i++;
+        chars = WriteEscaped(
+            chars, unibrow::Utf16::CombineSurrogatePair(c, vector[i]));
+      } else {
+        chars = WriteEscaped(chars, c);
+      }
+    }
+    DCHECK_EQ(dest->GetChars() + encoded_length, chars);
+  }
+  return dest;
+}
+
+
+template <typename Char>
+MaybeHandle<String> URICoding::Decode(Isolate* isolate, Handle<String> string,
+                                      bool component) {
+  DCHECK(string->IsFlat());
+  int length = string->length();
+  int decoded_length = 0;
+  bool one_byte = true;
+  bool malformed = false;
+  {
+    DisallowHeapAllocation no_allocation;
+    Vector<const Char> vector = GetCharVector<Char>(string);
+    for (int i = 0; i < length;) {
+      uc16 c = vector[i];
+      if (c != '%') {
+        if (c > String::kMaxOneByteCharCode) one_byte = false;
+        decoded_length++;
+        i++;
+        continue;
+      }
+      int step;
+      int value = DecodeSequence(vector, i, &step);
+      if (value < 0) {
+        malformed = true;
+        break;
+      }
+      if (IsKeptEscaped(value, component)) {
+        decoded_length += 3;
+      } else if (value >
+                 static_cast<int>(unibrow::Utf16::kMaxNonSurrogateCharCode)) {
+        decoded_length += 2;
+        one_byte = false;
+      } else {
+        if (value > String::kMaxOneByteCharCode) one_byte = false;
+        decoded_length++;
+      }
+      i += step;
+    }
+  }
+  if (malformed) return ThrowMalformed(isolate);
+
+  // Only escapes that are kept as they are leave the length unchanged.
+  if (decoded_length == length) return string;
+
+  if (one_byte) {
+    Handle<SeqOneByteString> dest;
+    ASSIGN_RETURN_ON_EXCEPTION(
+        isolate, dest, isolate->factory()->NewRawOneByteString(decoded_length),
+        String);
+    DisallowHeapAllocation no_allocation;
+    DecodeInto(GetCharVector<Char>(string), component, dest->GetChars());
+    return dest;
+  }
+  Handle<SeqTwoByteString> dest;
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate, dest, isolate->factory()->NewRawTwoByteString(decoded_length),
+      String);
+  DisallowHeapAllocation no_allocation;
+  DecodeInto(GetCharVector<Char>(string), component, dest->GetChars());
+  return dest;
+}
+
+
 RUNTIME_FUNCTION(Runtime_URIEscape) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
@@ -305,5 +654,37 @@ RUNTIME_FUNCTION(Runtime_URIUnescape) {
                            : URIUnescape::Unescape<uc16>(isolate, source));
   return *result;
 }
+
+
+RUNTIME_FUNCTION(Runtime_URIEncode) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  Handle<String> string = String::Flatten(source);
+  Handle<String> result;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+      isolate, result,
+      string->IsOneByteRepresentationUnderneath()
+          ? URICoding::Encode<uint8_t>(isolate, string, component)
+          : URICoding::Encode<uc16>(isolate, string, component));
+  return *result;
+}
+
+
+RUNTIME_FUNCTION(Runtime_URIDecode) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  Handle<String> string = String::Flatten(source);
+  Handle<String> result;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+      isolate, result,
+      string->IsOneByteRepresentationUnderneath()
+          ? URICoding::Decode<uint8_t>(isolate, string, component)
+          : URICoding::Decode<uc16>(isolate, string, component));
+  return *result;
+}
 }
 }  // namespace v8::internal
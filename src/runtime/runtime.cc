@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <stdlib.h>
+#include <algorithm>
 #include <limits>
 
 #include "src/v8.h"
@@ -403,6 +404,8 @@ RUNTIME_FUNCTION(Runtime_SpecialArrayFunctions) {
   InstallBuiltin(isolate, holder, "slice", Builtins::kArraySlice);
   InstallBuiltin(isolate, holder, "splice", Builtins::kArraySplice);
   InstallBuiltin(isolate, holder, "concat", Builtins::kArrayConcat);
+  InstallBuiltin(isolate, holder, "indexOf", Builtins::kArrayIndexOf);
+  InstallBuiltin(isolate, holder, "lastIndexOf", Builtins::kArrayLastIndexOf);
 
   return *holder;
 }
@@ -1466,6 +1469,13 @@ RUNTIME_FUNCTION(Runtime_OwnKeys) {
     object = Handle<JSObject>::cast(PrototypeIterator::GetCurrent(iter));
   }
 
+  // Objects of the same map without elements share a copy-on-write array.
+  Object* cached = ObjectKeysCache::Lookup(isolate->heap(), *object);
+  if (cached->IsFixedArray()) {
+    return *isolate->factory()->NewJSArrayWithElements(
+        handle(FixedArray::cast(cached), isolate));
+  }
+
   Handle<FixedArray> contents;
   ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
       isolate, contents, JSReceiver::GetKeys(object, JSReceiver::OWN_ONLY));
@@ -1488,6 +1498,7 @@ RUNTIME_FUNCTION(Runtime_OwnKeys) {
       copy->set(i, *entry_str);
     }
   }
+  ObjectKeysCache::Enter(isolate, object, copy);
   return *isolate->factory()->NewJSArrayWithElements(copy);
 }
 
@@ -1543,6 +1554,11 @@ RUNTIME_FUNCTION(Runtime_Typeof) {
       return isolate->heap()->undefined_string();
     case SYMBOL_TYPE:
       return isolate->heap()->symbol_string();
+#define SIMD128_TYPE_CASE(TYPE, Type, type, lane_count, lane_type) \
+    case TYPE##_TYPE:                                              \
+      return isolate->heap()->type##_string();
+    SIMD128_TYPES(SIMD128_TYPE_CASE)
+#undef SIMD128_TYPE_CASE
     case JS_FUNCTION_TYPE:
     case JS_FUNCTION_PROXY_TYPE:
       return isolate->heap()->function_string();
@@ -2573,6 +2589,46 @@ RUNTIME_FUNCTION(Runtime_RemoveArrayHoles) {
 }
 
 
+struct SmiLexicographicLess {
+  bool operator()(Smi* x, Smi* y) const {
+    return Runtime::SmiLexicographicCompare(x->value(), y->value()) == LESS;
+  }
+};
+
+
+// Sorts the first limit elements of an object with fast Smi elements in
+// the order Array.prototype.sort uses without a comparison function. Equal
+// Smis are indistinguishable, so this needs no stable sort. Returns false if
+// the elements cannot be sorted here, in which case they are left untouched.
+RUNTIME_FUNCTION(Runtime_SortSmiElements) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(Object, receiver, 0);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[1]);
+  if (!receiver->IsJSObject()) return isolate->heap()->false_value();
+  Handle<JSObject> object = Handle<JSObject>::cast(receiver);
+  // Stores into observed objects have to be reported.
+  if (!object->HasFastSmiElements() || object->map()->is_observed()) {
+    return isolate->heap()->false_value();
+  }
+  JSObject::EnsureWritableFastElements(object);
+
+  DisallowHeapAllocation no_gc;
+  FixedArray* elements = FixedArray::cast(object->elements());
+  if (limit > static_cast<uint32_t>(elements->length())) {
+    return isolate->heap()->false_value();
+  }
+  // Holey Smi arrays have their holes moved to the end by
+  // %RemoveArrayHoles, but check anyway.
+  for (uint32_t i = 0; i < limit; i++) {
+    if (!elements->get(i)->IsSmi()) return isolate->heap()->false_value();
+  }
+  Smi** start = reinterpret_cast<Smi**>(elements->GetFirstElementAddress());
+  std::sort(start, start + limit, SmiLexicographicLess());
+  return isolate->heap()->true_value();
+}
+
+
 // Move contents of argument 0 (an array) to argument 1 (an array)
 RUNTIME_FUNCTION(Runtime_MoveArrayContents) {
   HandleScope scope(isolate);
@@ -2731,6 +2787,10 @@ RUNTIME_FUNCTION(Runtime_LoadMutableDouble) {
     RUNTIME_ASSERT(field_index.outobject_array_index() <
                    object->properties()->length());
   }
+  if (field_index.is_unboxed_double()) {
+    return *isolate->factory()->NewHeapNumber(
+        object->RawFastDoublePropertyAt(field_index));
+  }
   Handle<Object> raw_value(object->RawFastPropertyAt(field_index), isolate);
   RUNTIME_ASSERT(raw_value->IsMutableHeapNumber());
   return *Object::WrapForRead(isolate, raw_value, Representation::Double());
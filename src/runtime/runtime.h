@@ -108,6 +108,8 @@ namespace internal {
   F(CharFromCode, 1, 1)                                    \
   F(URIEscape, 1, 1)                                       \
   F(URIUnescape, 1, 1)                                     \
+  F(URIEncode, 2, 1)                                       \
+  F(URIDecode, 2, 1)                                       \
                                                            \
   F(NumberToInteger, 1, 1)                                 \
   F(NumberToIntegerMapMinusZero, 1, 1)                     \
@@ -144,11 +146,7 @@ namespace internal {
   F(SmiLexicographicCompare, 2, 1)                         \
                                                            \
   /* Math */                                               \
-  F(MathAcos, 1, 1)                                        \
-  F(MathAsin, 1, 1)                                        \
-  F(MathAtan, 1, 1)                                        \
   F(MathFloorRT, 1, 1)                                     \
-  F(MathAtan2, 2, 1)                                       \
   F(MathExpRT, 1, 1)                                       \
   F(RoundNumber, 1, 1)                                     \
   F(MathFround, 1, 1)                                      \
@@ -260,6 +258,7 @@ namespace internal {
                                                        \
   /* Arrays */                                         \
   F(RemoveArrayHoles, 2, 1)                            \
+  F(SortSmiElements, 2, 1)                             \
   F(GetArrayKeys, 2, 1)                                \
   F(MoveArrayContents, 2, 1)                           \
   F(EstimateNumberOfElements, 1, 1)                    \
@@ -297,7 +296,6 @@ namespace internal {
   /* Harmony sets */                                   \
   F(SetInitialize, 1, 1)                               \
   F(SetAdd, 2, 1)                                      \
-  F(SetHas, 2, 1)                                      \
   F(SetDelete, 2, 1)                                   \
   F(SetClear, 1, 1)                                    \
   F(SetGetSize, 1, 1)                                  \
@@ -307,8 +305,6 @@ namespace internal {
                                                        \
   /* Harmony maps */                                   \
   F(MapInitialize, 1, 1)                               \
-  F(MapGet, 2, 1)                                      \
-  F(MapHas, 2, 1)                                      \
   F(MapDelete, 2, 1)                                   \
   F(MapClear, 1, 1)                                    \
   F(MapSet, 3, 1)                                      \
@@ -347,9 +343,9 @@ namespace internal {
   F(ArrayBufferSliceImpl, 3, 1)                        \
   F(ArrayBufferIsView, 1, 1)                           \
   F(ArrayBufferNeuter, 1, 1)                           \
+  F(SharedArrayBufferInitialize, 2, 1)                 \
                                                        \
   F(TypedArrayInitializeFromArrayLike, 4, 1)           \
-  F(TypedArrayGetBuffer, 1, 1)                         \
   F(TypedArraySetFastCases, 3, 1)                      \
                                                        \
   F(DataViewGetBuffer, 1, 1)                           \
@@ -371,6 +367,65 @@ namespace internal {
   F(DataViewSetFloat32, 4, 1)                          \
   F(DataViewSetFloat64, 4, 1)                          \
                                                        \
+  /* Harmony atomics */                                \
+  F(AtomicsLoad, 2, 1)                                 \
+  F(AtomicsStore, 3, 1)                                \
+  F(AtomicsAdd, 3, 1)                                  \
+  F(AtomicsSub, 3, 1)                                  \
+  F(AtomicsAnd, 3, 1)                                  \
+  F(AtomicsOr, 3, 1)                                   \
+  F(AtomicsXor, 3, 1)                                  \
+  F(AtomicsExchange, 3, 1)                             \
+  F(AtomicsCompareExchange, 4, 1)                      \
+  F(AtomicsWait, 4, 1)                                 \
+  F(AtomicsWake, 3, 1)                                 \
+                                                       \
+  /* Harmony SIMD */                                   \
+  F(NewSimd128Wrapper, 1, 1)                           \
+  F(CreateFloat32x4, 4, 1)                             \
+  F(Float32x4ExtractLane, 2, 1)                        \
+  F(Float32x4ReplaceLane, 3, 1)                        \
+  F(Float32x4Load, 2, 1)                               \
+  F(Float32x4Store, 3, 1)                              \
+  F(Float32x4Add, 2, 1)                                \
+  F(Float32x4Sub, 2, 1)                                \
+  F(Float32x4Mul, 2, 1)                                \
+  F(Float32x4Div, 2, 1)                                \
+  F(Float32x4Min, 2, 1)                                \
+  F(Float32x4Max, 2, 1)                                \
+  F(Float32x4Neg, 1, 1)                                \
+  F(Float32x4Abs, 1, 1)                                \
+  F(Float32x4Sqrt, 1, 1)                               \
+  F(Float32x4FromInt32x4, 1, 1)                        \
+  F(CreateInt32x4, 4, 1)                               \
+  F(Int32x4ExtractLane, 2, 1)                          \
+  F(Int32x4ReplaceLane, 3, 1)                          \
+  F(Int32x4Load, 2, 1)                                 \
+  F(Int32x4Store, 3, 1)                                \
+  F(Int32x4Add, 2, 1)                                  \
+  F(Int32x4Sub, 2, 1)                                  \
+  F(Int32x4Mul, 2, 1)                                  \
+  F(Int32x4And, 2, 1)                                  \
+  F(Int32x4Or, 2, 1)                                   \
+  F(Int32x4Xor, 2, 1)                                  \
+  F(Int32x4Neg, 1, 1)                                  \
+  F(Int32x4Not, 1, 1)                                  \
+  F(Int32x4FromFloat32x4, 1, 1)                        \
+  F(CreateFloat64x2, 2, 1)                             \
+  F(Float64x2ExtractLane, 2, 1)                        \
+  F(Float64x2ReplaceLane, 3, 1)                        \
+  F(Float64x2Load, 2, 1)                               \
+  F(Float64x2Store, 3, 1)                              \
+  F(Float64x2Add, 2, 1)                                \
+  F(Float64x2Sub, 2, 1)                                \
+  F(Float64x2Mul, 2, 1)                                \
+  F(Float64x2Div, 2, 1)                                \
+  F(Float64x2Min, 2, 1)                                \
+  F(Float64x2Max, 2, 1)                                \
+  F(Float64x2Neg, 1, 1)                                \
+  F(Float64x2Abs, 1, 1)                                \
+  F(Float64x2Sqrt, 1, 1)                               \
+                                                       \
   /* Statements */                                     \
   F(NewObjectFromBound, 1, 1)                          \
                                                        \
@@ -717,6 +772,7 @@ namespace internal {
   F(ArrayBufferViewGetByteLength, 1, 1)   \
   F(ArrayBufferViewGetByteOffset, 1, 1)   \
   F(TypedArrayGetLength, 1, 1)            \
+  F(TypedArrayGetBuffer, 1, 1)            \
   /* ArrayBuffer */                       \
   F(ArrayBufferGetByteLength, 1, 1)       \
   /* Maths */                             \
@@ -724,7 +780,11 @@ namespace internal {
   F(DoubleHi, 1, 1)                       \
   F(DoubleLo, 1, 1)                       \
   F(MathSqrtRT, 1, 1)                     \
-  F(MathLogRT, 1, 1)
+  F(MathLogRT, 1, 1)                      \
+  /* ES6 collections */                   \
+  F(MapGet, 2, 1)                         \
+  F(MapHas, 2, 1)                         \
+  F(SetHas, 2, 1)
 
 
 //---------------------------------------------------------------------------
@@ -753,9 +813,17 @@ class RuntimeState {
   ConsStringIteratorOp* string_locale_compare_it2() {
     return &string_locale_compare_it2_;
   }
+  // The last cons string that a character was read from without flattening
+  // it. Only compared by address, never dereferenced.
+  Address last_unflattened_cons_string() {
+    return last_unflattened_cons_string_;
+  }
+  void set_last_unflattened_cons_string(Address address) {
+    last_unflattened_cons_string_ = address;
+  }
 
  private:
-  RuntimeState() {}
+  RuntimeState() : last_unflattened_cons_string_(NULL) {}
   // Non-reentrant string buffer for efficient general use in the runtime.
   StaticResource<ConsStringIteratorOp> string_iterator_;
   unibrow::Mapping<unibrow::ToUppercase, 128> to_upper_mapping_;
@@ -764,6 +832,7 @@ class RuntimeState {
   ConsStringIteratorOp string_iterator_compare_y_;
   ConsStringIteratorOp string_locale_compare_it1_;
   ConsStringIteratorOp string_locale_compare_it2_;
+  Address last_unflattened_cons_string_;
 
   friend class Isolate;
   friend class Runtime;
@@ -827,6 +896,10 @@ class Runtime : public AllStatic {
   static int StringMatch(Isolate* isolate, Handle<String> sub,
                          Handle<String> pat, int index);
 
+  // Compares two integers as if they were converted to strings and then
+  // compared lexicographically. Returns LESS, EQUAL or GREATER.
+  static int SmiLexicographicCompare(int x_value, int y_value);
+
   // TODO(1240886): Some of the following methods are *not* handle safe, but
   // accept handle arguments. This seems fragile.
 
@@ -13,6 +13,13 @@
 #include <signal.h>
 #include <sys/time.h>
 
+#if V8_OS_LINUX && !V8_OS_ANDROID && !V8_OS_NACL
+// Threads can be sampled from a timer on their CPU time clock, which the
+// kernel fires on the profiled thread itself.
+#define USE_CPU_TIME_TIMER
+#include <time.h>
+#endif
+
 #if !V8_OS_QNX && !V8_OS_NACL
 #include <sys/syscall.h>  // NOLINT
 #endif
@@ -181,11 +188,32 @@ class PlatformDataCommon : public Malloced {
 
 class Sampler::PlatformData : public PlatformDataCommon {
  public:
-  PlatformData() : vm_tid_(pthread_self()) {}
+  PlatformData() : vm_tid_(pthread_self()) {
+#if defined(USE_CPU_TIME_TIMER)
+    vm_kernel_tid_ = static_cast<pid_t>(syscall(SYS_gettid));
+    has_cpu_time_timer_ = false;
+#endif
+  }
   pthread_t vm_tid() const { return vm_tid_; }
 
+#if defined(USE_CPU_TIME_TIMER)
+  pid_t vm_kernel_tid() const { return vm_kernel_tid_; }
+  bool has_cpu_time_timer() const { return has_cpu_time_timer_; }
+  timer_t cpu_time_timer() const { return cpu_time_timer_; }
+  void set_cpu_time_timer(timer_t timer) {
+    cpu_time_timer_ = timer;
+    has_cpu_time_timer_ = true;
+  }
+  void clear_cpu_time_timer() { has_cpu_time_timer_ = false; }
+#endif
+
  private:
   pthread_t vm_tid_;
+#if defined(USE_CPU_TIME_TIMER)
+  pid_t vm_kernel_tid_;
+  bool has_cpu_time_timer_;
+  timer_t cpu_time_timer_;
+#endif
 };
 
 #elif V8_OS_WIN || V8_OS_CYGWIN
@@ -653,6 +681,7 @@ Sampler::Sampler(Isolate* isolate, int interval)
       profiling_(false),
       has_processing_thread_(false),
       active_(false),
+      cpu_time_sampling_(false),
       is_counting_samples_(false),
       js_and_external_sample_count_(0) {
   data_ = new PlatformData;
@@ -712,10 +741,72 @@ void Sampler::SampleStack(const v8::RegisterState& state) {
 }
 
 
+#if defined(USE_CPU_TIME_TIMER)
+
+bool Sampler::StartCpuTimeSampling(base::TimeDelta period) {
+  DCHECK(!IsCpuTimeSampling());
+  if (!SignalHandler::Installed()) return false;
+  clockid_t clock;
+  if (pthread_getcpuclockid(platform_data()->vm_tid(), &clock) != 0) {
+    return false;
+  }
+  // Deliver SIGPROF to the profiled thread only, rather than to any thread
+  // of the process.
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+#if defined(sigev_notify_thread_id)
+  event.sigev_notify_thread_id = platform_data()->vm_kernel_tid();
+#else
+  event._sigev_un._tid = platform_data()->vm_kernel_tid();
+#endif
+  timer_t timer;
+  if (timer_create(clock, &event, &timer) != 0) return false;
+  int64_t period_us = period.InMicroseconds();
+  if (period_us < 1) period_us = 1;
+  struct itimerspec spec;
+  spec.it_interval.tv_sec =
+      static_cast<time_t>(period_us / base::Time::kMicrosecondsPerSecond);
+  spec.it_interval.tv_nsec = static_cast<long>(  // NOLINT(runtime/int)
+      (period_us % base::Time::kMicrosecondsPerSecond) *
+      base::Time::kNanosecondsPerMicrosecond);
+  spec.it_value = spec.it_interval;
+  if (timer_settime(timer, 0, &spec, NULL) != 0) {
+    timer_delete(timer);
+    return false;
+  }
+  platform_data()->set_cpu_time_timer(timer);
+  base::NoBarrier_Store(&cpu_time_sampling_, true);
+  return true;
+}
+
+
+void Sampler::StopCpuTimeSampling() {
+  if (!IsCpuTimeSampling()) return;
+  base::NoBarrier_Store(&cpu_time_sampling_, false);
+  timer_delete(platform_data()->cpu_time_timer());
+  platform_data()->clear_cpu_time_timer();
+}
+
+#else
+
+bool Sampler::StartCpuTimeSampling(base::TimeDelta period) {
+  return false;
+}
+
+
+void Sampler::StopCpuTimeSampling() {}
+
+#endif  // USE_CPU_TIME_TIMER
+
+
 #if defined(USE_SIGNALS)
 
 void Sampler::DoSample() {
   if (!SignalHandler::Installed()) return;
+  // The timer on the CPU time of the thread does the signalling.
+  if (IsCpuTimeSampling()) return;
   pthread_kill(platform_data()->vm_tid(), SIGPROF);
 }
 
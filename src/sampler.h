@@ -83,6 +83,17 @@ class Sampler {
   bool IsActive() const { return base::NoBarrier_Load(&active_); }
 
   void DoSample();
+
+  // Takes the samples from a timer on the CPU time of the profiled thread
+  // instead of signalling the thread from DoSample(). A thread that is
+  // blocked, e.g. in a system call, is then neither sampled nor interrupted.
+  // Returns false if the platform does not support this, in which case the
+  // sampling goes on as before.
+  bool StartCpuTimeSampling(base::TimeDelta period);
+  void StopCpuTimeSampling();
+  bool IsCpuTimeSampling() const {
+    return base::NoBarrier_Load(&cpu_time_sampling_);
+  }
   // If true next sample must be initiated on the profiler event processor
   // thread right after latest sample is processed.
   void SetHasProcessingThread(bool value) {
@@ -114,6 +125,7 @@ class Sampler {
   base::Atomic32 profiling_;
   base::Atomic32 has_processing_thread_;
   base::Atomic32 active_;
+  base::Atomic32 cpu_time_sampling_;
   PlatformData* data_;  // Platform specific data.
   bool is_counting_samples_;
   // Counts stack samples taken in JS VM state.
@@ -0,0 +1,165 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/sampling-heap-profiler.h"
+
+#include <cmath>
+
+#include "src/base/utils/random-number-generator.h"
+#include "src/frames-inl.h"
+#include "src/global-handles.h"
+#include "src/isolate-inl.h"
+
+namespace v8 {
+namespace internal {
+
+SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap,
+                                           intptr_t sample_interval)
+    : heap_(heap),
+      names_(heap),
+      sample_interval_(sample_interval),
+      stacks_(StacksMatch),
+      samples_(HashMap::PointersMatch) {
+  DCHECK(sample_interval > 0);
+  bytes_until_sample_ = GetNextSampleInterval();
+}
+
+
+SamplingHeapProfiler::~SamplingHeapProfiler() {
+  for (HashMap::Entry* p = samples_.Start(); p != NULL; p = samples_.Next(p)) {
+    Sample* sample = reinterpret_cast<Sample*>(p->key);
+    GlobalHandles::Destroy(sample->global.location());
+    delete sample;
+  }
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    Stack* stack = reinterpret_cast<Stack*>(p->key);
+    DeleteArray(stack->frames);
+    delete stack;
+  }
+}
+
+
+intptr_t SamplingHeapProfiler::GetNextSampleInterval() {
+  double u = heap_->isolate()->random_number_generator()->NextDouble();
+  double interval = -std::log(1.0 - u) * sample_interval_;
+  // Round up so that the next allocation is sampled for tiny intervals.
+  return static_cast<intptr_t>(interval) + 1;
+}
+
+
+static uint32_t FrameHash(const v8::SampledAllocationFrame& frame) {
+  uint32_t hash = ComputePointerHash(const_cast<char*>(frame.function_name));
+  hash = hash * 31 +
+         ComputePointerHash(const_cast<char*>(frame.resource_name));
+  return hash * 31 + static_cast<uint32_t>(frame.line_number);
+}
+
+
+bool SamplingHeapProfiler::StacksMatch(void* key1, void* key2) {
+  Stack* stack1 = reinterpret_cast<Stack*>(key1);
+  Stack* stack2 = reinterpret_cast<Stack*>(key2);
+  if (stack1->depth != stack2->depth) return false;
+  for (int i = 0; i < stack1->depth; i++) {
+    // The names are interned in the strings storage, so comparing the
+    // pointers is enough.
+    const v8::SampledAllocationFrame& frame1 = stack1->frames[i];
+    const v8::SampledAllocationFrame& frame2 = stack2->frames[i];
+    if (frame1.function_name != frame2.function_name ||
+        frame1.resource_name != frame2.resource_name ||
+        frame1.script_id != frame2.script_id ||
+        frame1.line_number != frame2.line_number) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+SamplingHeapProfiler::Stack* SamplingHeapProfiler::FindOrAddStack(
+    const v8::SampledAllocationFrame* frames, int depth) {
+  Stack key = { depth, const_cast<v8::SampledAllocationFrame*>(frames), 0, 0 };
+  uint32_t hash = 0;
+  for (int i = 0; i < depth; i++) hash = hash * 31 + FrameHash(frames[i]);
+  HashMap::Entry* entry = stacks_.Lookup(&key, hash, false);
+  if (entry == NULL) {
+    Stack* stack = new Stack(key);
+    stack->frames = NewArray<v8::SampledAllocationFrame>(depth);
+    for (int i = 0; i < depth; i++) stack->frames[i] = frames[i];
+    entry = stacks_.Lookup(stack, hash, true);
+  }
+  return reinterpret_cast<Stack*>(entry->key);
+}
+
+
+void SamplingHeapProfiler::SampleObject(Address soon_object, int size) {
+  DisallowHeapAllocation no_allocation;
+
+  // Make sure the heap is iterable while we are capturing the stack trace,
+  // the caller initializes the object afterwards.
+  heap_->CreateFillerObjectAt(soon_object, size);
+
+  Isolate* isolate = heap_->isolate();
+  v8::SampledAllocationFrame frames[kMaxStackDepth];
+  int depth = 0;
+  for (StackTraceFrameIterator it(isolate);
+       !it.done() && depth < kMaxStackDepth; it.Advance()) {
+    SharedFunctionInfo* shared = it.frame()->function()->shared();
+    v8::SampledAllocationFrame& frame = frames[depth++];
+    frame.function_name = names_.GetFunctionName(shared->DebugName());
+    frame.resource_name = "";
+    frame.script_id = v8::UnboundScript::kNoScriptId;
+    frame.line_number = v8::SampledAllocationFrame::kNoLineNumberInfo;
+    if (shared->script()->IsScript()) {
+      Script* script = Script::cast(shared->script());
+      if (script->name()->IsName()) {
+        frame.resource_name = names_.GetName(Name::cast(script->name()));
+      }
+      frame.script_id = script->id()->value();
+      // Unlike the variant taking a handle, this does not compute the line
+      // ends and does not allocate.
+      frame.line_number = script->GetLineNumber(shared->start_position()) + 1;
+    }
+  }
+
+  Sample* sample = new Sample();
+  sample->profiler = this;
+  sample->stack = FindOrAddStack(frames, depth);
+  sample->size = size;
+  sample->global =
+      isolate->global_handles()->Create(HeapObject::FromAddress(soon_object));
+  // The sample must not keep the object alive, not even across scavenges.
+  GlobalHandles::MakeWeak(sample->global.location(), sample, &OnWeakCallback);
+  GlobalHandles::MarkIndependent(sample->global.location());
+  samples_.Lookup(sample, ComputePointerHash(sample), true);
+
+  sample->stack->live_count++;
+  sample->stack->live_size += size;
+}
+
+
+void SamplingHeapProfiler::OnWeakCallback(
+    const v8::WeakCallbackData<v8::Value, void>& data) {
+  Sample* sample = reinterpret_cast<Sample*>(data.GetParameter());
+  sample->stack->live_count--;
+  sample->stack->live_size -= sample->size;
+  sample->profiler->samples_.Remove(sample, ComputePointerHash(sample));
+  GlobalHandles::Destroy(sample->global.location());
+  delete sample;
+}
+
+
+void SamplingHeapProfiler::VisitSamples(
+    v8::SampledAllocationVisitor* visitor) {
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    Stack* stack = reinterpret_cast<Stack*>(p->key);
+    if (stack->live_count == 0) continue;
+    visitor->VisitStack(stack->frames, stack->depth, stack->live_count,
+                        stack->live_size);
+  }
+}
+
+
+} }  // namespace v8::internal
@@ -0,0 +1,79 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SAMPLING_HEAP_PROFILER_H_
+#define V8_SAMPLING_HEAP_PROFILER_H_
+
+#include "include/v8-profiler.h"
+#include "src/hashmap.h"
+#include "src/profile-generator.h"
+
+namespace v8 {
+namespace internal {
+
+// Takes a stack trace for a small random subset of the allocations and
+// keeps track of the sampled objects that are still alive. The intervals
+// between samples are exponentially distributed over the allocated bytes,
+// so that the samples form a Poisson process: an object of size s is
+// sampled with probability 1 - exp(-s / sample_interval) regardless of how
+// the allocations around it are laid out.
+class SamplingHeapProfiler {
+ public:
+  SamplingHeapProfiler(Heap* heap, intptr_t sample_interval);
+  ~SamplingHeapProfiler();
+
+  // Returns the number of bytes to allocate before the next sample is taken.
+  intptr_t GetNextSampleInterval();
+
+  // Counts an allocation outside of the new space against the interval. New
+  // space allocations are counted by the new space itself, which lowers its
+  // inline allocation limit to take the slow path when a sample is due.
+  void OldSpaceAllocationEvent(Address addr, int size) {
+    bytes_until_sample_ -= size;
+    if (bytes_until_sample_ > 0) return;
+    bytes_until_sample_ = GetNextSampleInterval();
+    SampleObject(addr, size);
+  }
+
+  // Records a sample for the object that has just been allocated at the
+  // given address. The object does not need to be initialized yet.
+  void SampleObject(Address soon_object, int size);
+
+  // Reports the live sampled objects aggregated per allocation stack.
+  void VisitSamples(v8::SampledAllocationVisitor* visitor);
+
+ private:
+  struct Stack {
+    int depth;
+    v8::SampledAllocationFrame* frames;
+    unsigned live_count;
+    size_t live_size;
+  };
+
+  struct Sample {
+    SamplingHeapProfiler* profiler;
+    Stack* stack;
+    int size;
+    Handle<Object> global;
+  };
+
+  static const int kMaxStackDepth = 32;
+
+  Stack* FindOrAddStack(const v8::SampledAllocationFrame* frames, int depth);
+  static bool StacksMatch(void* key1, void* key2);
+  static void OnWeakCallback(const v8::WeakCallbackData<v8::Value, void>& data);
+
+  Heap* heap_;
+  StringsStorage names_;
+  intptr_t sample_interval_;
+  intptr_t bytes_until_sample_;
+  HashMap stacks_;
+  HashMap samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingHeapProfiler);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_SAMPLING_HEAP_PROFILER_H_
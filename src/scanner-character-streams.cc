@@ -157,6 +157,42 @@ unsigned GenericStringUtf16CharacterStream::FillBuffer(unsigned from_pos) {
 }
 
 
+// ----------------------------------------------------------------------------
+// ExternalOneByteStringUtf16CharacterStream
+
+
+ExternalOneByteStringUtf16CharacterStream::
+    ExternalOneByteStringUtf16CharacterStream(
+        Handle<ExternalOneByteString> data, unsigned start_position,
+        unsigned end_position)
+    : source_(data), raw_data_(data->GetChars()), length_(end_position) {
+  DCHECK(end_position >= start_position);
+  pos_ = start_position;
+}
+
+
+ExternalOneByteStringUtf16CharacterStream::
+    ~ExternalOneByteStringUtf16CharacterStream() { }
+
+
+unsigned ExternalOneByteStringUtf16CharacterStream::BufferSeekForward(
+    unsigned delta) {
+  unsigned old_pos = pos_;
+  pos_ = Min(pos_ + delta, length_);
+  ReadBlock();
+  return pos_ - old_pos;
+}
+
+
+unsigned ExternalOneByteStringUtf16CharacterStream::FillBuffer(
+    unsigned from_pos) {
+  if (from_pos >= length_) return 0;
+  unsigned length = Min(kBufferSize, length_ - from_pos);
+  CopyChars(buffer_, raw_data_ + from_pos, length);
+  return length;
+}
+
+
 // ----------------------------------------------------------------------------
 // Utf8ToUtf16CharacterStream
 Utf8ToUtf16CharacterStream::Utf8ToUtf16CharacterStream(const byte* data,
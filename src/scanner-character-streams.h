@@ -53,6 +53,27 @@ class GenericStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
 };
 
 
+// Stream over the characters of an external one-byte string. The characters
+// do not move, so blocks are widened straight from the external data instead
+// of going through the generic String accessors.
+class ExternalOneByteStringUtf16CharacterStream
+    : public BufferedUtf16CharacterStream {
+ public:
+  ExternalOneByteStringUtf16CharacterStream(Handle<ExternalOneByteString> data,
+                                            unsigned start_position,
+                                            unsigned end_position);
+  virtual ~ExternalOneByteStringUtf16CharacterStream();
+
+ protected:
+  virtual unsigned BufferSeekForward(unsigned delta);
+  virtual unsigned FillBuffer(unsigned position);
+
+  Handle<ExternalOneByteString> source_;
+  const uint8_t* raw_data_;  // Pointer to the actual array of characters.
+  unsigned length_;
+};
+
+
 // Utf16 stream based on a literal UTF-8 string.
 class Utf8ToUtf16CharacterStream: public BufferedUtf16CharacterStream {
  public:
@@ -46,7 +46,7 @@ Handle<ScopeInfo> ScopeInfo::Create(Scope* scope, Zone* zone) {
   const bool has_function_name = function_name_info != NONE;
   const int parameter_count = scope->num_parameters();
   const int length = kVariablePartIndex
-      + parameter_count + stack_local_count + 2 * context_local_count
+      + parameter_count + 1 + stack_local_count + 2 * context_local_count
       + (has_function_name ? 2 : 0);
 
   Factory* factory = zone->isolate()->factory();
@@ -72,12 +72,17 @@ Handle<ScopeInfo> ScopeInfo::Create(Scope* scope, Zone* zone) {
     scope_info->set(index++, *scope->parameter(i)->name());
   }
 
+  // Add the frame slot of the first stack local.
+  DCHECK(index == scope_info->StackLocalFirstSlotIndex());
+  const int first_slot = scope->stack_slot_base();
+  scope_info->set(index++, Smi::FromInt(first_slot));
+
   // Add stack locals' names. We are assuming that the stack locals'
   // slots are allocated in increasing order, so we can simply add
   // them to the ScopeInfo object.
   DCHECK(index == scope_info->StackLocalEntriesIndex());
   for (int i = 0; i < stack_local_count; ++i) {
-    DCHECK(stack_locals[i]->index() == i);
+    DCHECK(stack_locals[i]->index() == first_slot + i);
     scope_info->set(index++, *stack_locals[i]->name());
   }
 
@@ -121,7 +126,8 @@ Handle<ScopeInfo> ScopeInfo::Create(Scope* scope, Zone* zone) {
 
   DCHECK(index == scope_info->length());
   DCHECK(scope->num_parameters() == scope_info->ParameterCount());
-  DCHECK(scope->num_stack_slots() == scope_info->StackSlotCount());
+  DCHECK(scope->num_stack_slots() ==
+         scope_info->StackSlotCount() + scope->num_block_stack_slots());
   DCHECK(scope->num_heap_slots() == scope_info->ContextLength() ||
          (scope->num_heap_slots() == kVariablePartIndex &&
           scope_info->ContextLength() == 0));
@@ -165,6 +171,14 @@ int ScopeInfo::StackSlotCount() {
 }
 
 
+int ScopeInfo::StackLocalFirstSlot() {
+  if (length() > 0) {
+    return Smi::cast(get(StackLocalFirstSlotIndex()))->value();
+  }
+  return 0;
+}
+
+
 int ScopeInfo::ContextLength() {
   if (length() > 0) {
     int context_locals = ContextLocalCount();
@@ -285,7 +299,7 @@ int ScopeInfo::StackSlotIndex(String* name) {
     int end = StackLocalEntriesIndex() + StackLocalCount();
     for (int i = start; i < end; ++i) {
       if (name == get(i)) {
-        return i - start;
+        return StackLocalFirstSlot() + (i - start);
       }
     }
   }
@@ -399,11 +413,16 @@ int ScopeInfo::ParameterEntriesIndex() {
 }
 
 
-int ScopeInfo::StackLocalEntriesIndex() {
+int ScopeInfo::StackLocalFirstSlotIndex() {
   return ParameterEntriesIndex() + ParameterCount();
 }
 
 
+int ScopeInfo::StackLocalEntriesIndex() {
+  return StackLocalFirstSlotIndex() + 1;
+}
+
+
 int ScopeInfo::ContextLocalNameEntriesIndex() {
   return StackLocalEntriesIndex() + StackLocalCount();
 }
@@ -528,7 +547,7 @@ void ScopeInfo::Print() {
             ParameterEntriesIndex(),
             ParameterEntriesIndex() + ParameterCount(),
             this);
-  PrintList("stack slots", 0,
+  PrintList("stack slots", StackLocalFirstSlot(),
             StackLocalEntriesIndex(),
             StackLocalEntriesIndex() + StackLocalCount(),
             this);
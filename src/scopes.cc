@@ -172,6 +172,8 @@ void Scope::SetDefaults(ScopeType scope_type,
   num_var_or_const_ = 0;
   num_stack_slots_ = 0;
   num_heap_slots_ = 0;
+  num_block_stack_slots_ = 0;
+  stack_slot_base_ = 0;
   num_modules_ = 0;
   module_var_ = NULL,
   scope_info_ = scope_info;
@@ -891,6 +893,10 @@ void Scope::Print(int n) {
   if (inner_scope_calls_eval_) Indent(n1, "// inner scope calls 'eval'\n");
   if (num_stack_slots_ > 0) { Indent(n1, "// ");
   PrintF("%d stack slots\n", num_stack_slots_); }
+  if (num_block_stack_slots_ > 0) { Indent(n1, "// ");
+  PrintF("%d stack slots for inner blocks\n", num_block_stack_slots_); }
+  if (stack_slot_base_ > 0) { Indent(n1, "// ");
+  PrintF("stack locals start at slot %d\n", stack_slot_base_); }
   if (num_heap_slots_ > 0) { Indent(n1, "// ");
   PrintF("%d heap slots\n", num_heap_slots_); }
 
@@ -1206,11 +1212,19 @@ bool Scope::MustAllocateInContext(Variable* var) {
   // Exceptions: If the scope as a whole has forced context allocation, all
   // variables will have context allocation, even temporaries.  Otherwise
   // temporary variables are always stack-allocated.  Catch-bound variables are
-  // always context-allocated.
+  // always context-allocated.  Block-scoped variables are context-allocated
+  // too, unless --stack-allocate-block-locals is on and the block is inside a
+  // function: function bodies are parsed eagerly, so every closure that
+  // captures the variable has forced its context allocation already.
   if (has_forced_context_allocation()) return true;
   if (var->mode() == TEMPORARY) return false;
   if (var->mode() == INTERNAL) return true;
-  if (is_catch_scope() || is_block_scope() || is_module_scope()) return true;
+  if (is_catch_scope() || is_module_scope()) return true;
+  if (is_block_scope() &&
+      (!FLAG_stack_allocate_block_locals ||
+       !DeclarationScope()->is_function_scope())) {
+    return true;
+  }
   if (is_global_scope() && IsLexicalVariableMode(var->mode())) return true;
   return var->has_forced_context_allocation() ||
       scope_calls_eval_ ||
@@ -1374,11 +1388,55 @@ void Scope::AllocateVariablesRecursively() {
     num_heap_slots_ = 0;
   }
 
+  // The stack locals of inner blocks live in the frame of the declaration
+  // scope, after its own locals.
+  if (is_declaration_scope()) {
+    int frame_slots = AllocateBlockStackSlots(num_stack_slots_);
+    num_block_stack_slots_ = frame_slots - num_stack_slots_;
+    num_stack_slots_ = frame_slots;
+  }
+
   // Allocation done.
   DCHECK(num_heap_slots_ == 0 || num_heap_slots_ >= Context::MIN_CONTEXT_SLOTS);
 }
 
 
+void Scope::RebaseStackSlots(int base) {
+  DCHECK(!is_declaration_scope());
+  for (int i = 0; i < temps_.length(); i++) {
+    Variable* var = temps_[i];
+    if (var->IsStackLocal()) {
+      var->AllocateTo(Variable::LOCAL, base + var->index());
+    }
+  }
+  for (VariableMap::Entry* p = variables_.Start();
+       p != NULL;
+       p = variables_.Next(p)) {
+    Variable* var = reinterpret_cast<Variable*>(p->value);
+    if (var->IsStackLocal()) {
+      var->AllocateTo(Variable::LOCAL, base + var->index());
+    }
+  }
+  stack_slot_base_ = base;
+}
+
+
+int Scope::AllocateBlockStackSlots(int base) {
+  // Blocks that are not nested in each other are never live at the same
+  // time, so siblings share their slots and the frame only needs room for
+  // the deepest nesting.
+  int extent = base;
+  for (int i = 0; i < inner_scopes_.length(); i++) {
+    Scope* inner = inner_scopes_[i];
+    if (inner->is_declaration_scope()) continue;
+    if (inner->num_stack_slots_ > 0) inner->RebaseStackSlots(base);
+    int inner_base = base + inner->num_stack_slots_;
+    extent = Max(extent, inner->AllocateBlockStackSlots(inner_base));
+  }
+  return extent;
+}
+
+
 void Scope::AllocateModulesRecursively(Scope* host_scope) {
   if (already_resolved()) return;
   if (is_module_scope()) {
@@ -1397,7 +1455,7 @@ void Scope::AllocateModulesRecursively(Scope* host_scope) {
 
 
 int Scope::StackLocalCount() const {
-  return num_stack_slots() -
+  return num_stack_slots() - num_block_stack_slots() -
       (function_ != NULL && function_->proxy()->var()->IsStackLocal() ? 1 : 0);
 }
 
@@ -351,6 +351,12 @@ class Scope: public ZoneObject {
   int num_stack_slots() const { return num_stack_slots_; }
   int num_heap_slots() const { return num_heap_slots_; }
 
+  // For declaration scopes, the number of stack slots (included in
+  // num_stack_slots()) that hold the locals of inner block scopes. For block
+  // scopes, the frame slot of the first stack local of the block.
+  int num_block_stack_slots() const { return num_block_stack_slots_; }
+  int stack_slot_base() const { return stack_slot_base_; }
+
   int StackLocalCount() const;
   int ContextLocalCount() const;
 
@@ -494,6 +500,8 @@ class Scope: public ZoneObject {
   // Computed via AllocateVariables; function, block and catch scopes only.
   int num_stack_slots_;
   int num_heap_slots_;
+  int num_block_stack_slots_;
+  int stack_slot_base_;
 
   // The number of modules (including nested ones).
   int num_modules_;
@@ -586,6 +594,8 @@ class Scope: public ZoneObject {
   void AllocateNonParameterLocals();
   void AllocateVariablesRecursively();
   void AllocateModulesRecursively(Scope* host_scope);
+  void RebaseStackSlots(int base);
+  int AllocateBlockStackSlots(int base);
 
   // Resolve and fill in the allocation information for all variables
   // in this scopes. Must be called *after* all scopes have been
@@ -596,6 +596,7 @@ Deserializer::Deserializer(SnapshotByteSource* source)
     : isolate_(NULL),
       attached_objects_(NULL),
       source_(source),
+      code_space_start_(NULL),
       external_reference_decoder_(NULL),
       deserialized_large_objects_(0) {
   for (int i = 0; i < kNumberOfSpaces; i++) {
@@ -605,10 +606,17 @@ Deserializer::Deserializer(SnapshotByteSource* source)
 
 
 void Deserializer::FlushICacheForNewCodeObjects() {
-  PageIterator it(isolate_->heap()->code_space());
-  while (it.has_next()) {
-    Page* p = it.next();
-    CpuFeatures::FlushICache(p->area_start(), p->area_end() - p->area_start());
+  // Only the reserved chunk needs flushing, not all of code space, which may
+  // be large when deserializing code caches into a running isolate.
+  if (code_space_start_ != NULL) {
+    CpuFeatures::FlushICache(code_space_start_,
+                             high_water_[CODE_SPACE] - code_space_start_);
+  }
+  for (int i = 0; i < deserialized_large_objects_.length(); i++) {
+    HeapObject* obj = deserialized_large_objects_[i];
+    if (obj->IsCode()) {
+      CpuFeatures::FlushICache(obj->address(), obj->Size());
+    }
   }
 }
 
@@ -617,6 +625,8 @@ void Deserializer::Deserialize(Isolate* isolate) {
   isolate_ = isolate;
   DCHECK(isolate_ != NULL);
   isolate_->heap()->ReserveSpace(reservations_, high_water_);
+  code_space_start_ =
+      reservations_[CODE_SPACE] > 0 ? high_water_[CODE_SPACE] : NULL;
   // No active threads.
   DCHECK_EQ(NULL, isolate_->thread_manager()->FirstThreadStateInUse());
   // No active handles.
@@ -665,6 +675,8 @@ void Deserializer::DeserializePartial(Isolate* isolate, Object** root) {
   }
   Heap* heap = isolate->heap();
   heap->ReserveSpace(reservations_, high_water_);
+  code_space_start_ =
+      reservations_[CODE_SPACE] > 0 ? high_water_[CODE_SPACE] : NULL;
   if (external_reference_decoder_ == NULL) {
     external_reference_decoder_ = new ExternalReferenceDecoder(isolate);
   }
@@ -1905,9 +1917,38 @@ void Serializer::InitializeCodeAddressMap() {
 }
 
 
+v8::StartupData CreateSnapshotBlob(const List<byte>& snapshot_data,
+                                   const Serializer& serializer,
+                                   const List<byte>& context_data,
+                                   const Serializer& context_serializer) {
+  static const int spaces[] = {NEW_SPACE,           OLD_POINTER_SPACE,
+                               OLD_DATA_SPACE,      CODE_SPACE,
+                               MAP_SPACE,           CELL_SPACE,
+                               PROPERTY_CELL_SPACE, LO_SPACE};
+
+  List<byte> blob;
+  ListSnapshotSink sink(&blob);
+  sink.PutBlob(snapshot_data.begin(), snapshot_data.length(), "snapshot");
+  for (size_t i = 0; i < arraysize(spaces); ++i) {
+    sink.PutInt(serializer.CurrentAllocationAddress(spaces[i]), "spaces");
+  }
+  sink.PutBlob(context_data.begin(), context_data.length(), "context");
+  for (size_t i = 0; i < arraysize(spaces); ++i) {
+    sink.PutInt(context_serializer.CurrentAllocationAddress(spaces[i]),
+                "spaces");
+  }
+
+  char* data = NewArray<char>(blob.length());
+  CopyBytes(data, reinterpret_cast<char*>(blob.begin()), blob.length());
+  v8::StartupData result = {data, blob.length(), blob.length()};
+  return result;
+}
+
+
 ScriptData* CodeSerializer::Serialize(Isolate* isolate,
                                       Handle<SharedFunctionInfo> info,
-                                      Handle<String> source) {
+                                      Handle<String> source,
+                                      bool include_inner_code) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
@@ -1918,7 +1959,8 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
   SnapshotByteSink* sink = FLAG_trace_code_serializer
                                ? static_cast<SnapshotByteSink*>(&debug_sink)
                                : static_cast<SnapshotByteSink*>(&list_sink);
-  CodeSerializer cs(isolate, sink, *source, info->code());
+  CodeSerializer cs(isolate, sink, *source, info->code(),
+                    include_inner_code);
   DisallowHeapAllocation no_gc;
   Object** location = Handle<Object>::cast(info).location();
   cs.VisitPointer(location);
@@ -1984,10 +2026,11 @@ void CodeSerializer::SerializeObject(Object* o, HowToCode how_to_code,
         return;
       // TODO(yangguo): add special handling to canonicalize ICs.
       case Code::FUNCTION:
-        // Only serialize the code for the toplevel function. Replace code
-        // of included function literals by the lazy compile builtin.
+        // Only serialize the code for the toplevel function, unless asked
+        // to include inner functions. Replace code of included function
+        // literals by the lazy compile builtin otherwise.
         // This is safe, as checked in Compiler::BuildFunctionInfo.
-        if (code_object != main_code_) {
+        if (code_object != main_code_ && !include_inner_code_) {
           Code* lazy = *isolate()->builtins()->CompileLazy();
           SerializeBuiltin(lazy, how_to_code, where_to_point);
         } else {
@@ -2143,6 +2186,269 @@ Handle<SharedFunctionInfo> CodeSerializer::Deserialize(Isolate* isolate,
 }
 
 
+// The pretenuring data consists of int-sized entries:
+// [0] magic number
+// [1] version hash, see Version::Hash
+// [2] source hash, see FeedbackDataSourceHash
+// [3] number of decisions
+// followed by (function start position, literals index) pairs for the
+// allocation sites that should be created with a tenure decision.
+static const int kPretenuringDataMagic = 0x7072e7e1;
+static const int kPretenuringDataMagicOffset = 0;
+static const int kPretenuringDataVersionHashOffset = 1;
+static const int kPretenuringDataSourceHashOffset = 2;
+static const int kPretenuringDataLengthOffset = 3;
+static const int kPretenuringDataHeaderEntries = 4;
+
+
+// Unlike SerializedCodeData::CheckSum, which only hashes the source in debug
+// builds, this always hashes the whole source. The data learned from running
+// a script is small and only produced once, so the cost does not matter.
+static int FeedbackDataSourceHash(String* source) {
+  uint32_t seed = static_cast<uint32_t>(Version::Hash());
+  return static_cast<int>(IteratingStringHasher::Hash(source, seed));
+}
+
+
+static bool ContainsPretenuringHint(const List<int>& hints, int position,
+                                    int index) {
+  for (int i = 0; i < hints.length(); i += 2) {
+    if (hints[i] == position && hints[i + 1] == index) return true;
+  }
+  return false;
+}
+
+
+static bool HasTenuredAllocationSites(Heap* heap) {
+  Object* current = heap->allocation_sites_list();
+  while (current->IsAllocationSite()) {
+    AllocationSite* site = AllocationSite::cast(current);
+    if (site->pretenure_decision() == AllocationSite::kTenure) return true;
+    current = site->weak_next();
+  }
+  return false;
+}
+
+
+ScriptData* CodeSerializer::SerializePretenuringDecisions(
+    Isolate* isolate, Handle<SharedFunctionInfo> info) {
+  Handle<Script> script(Script::cast(info->script()), isolate);
+  List<int> hints;
+
+  // Keep decisions that were preloaded but whose sites were not created yet.
+  if (script->pretenuring_hints()->IsFixedArray()) {
+    FixedArray* preloaded = FixedArray::cast(script->pretenuring_hints());
+    for (int i = 0; i + 1 < preloaded->length(); i += 2) {
+      hints.Add(Smi::cast(preloaded->get(i))->value());
+      hints.Add(Smi::cast(preloaded->get(i + 1))->value());
+    }
+  }
+
+  if (HasTenuredAllocationSites(isolate->heap())) {
+    HeapIterator iterator(isolate->heap());
+    DisallowHeapAllocation no_gc;
+    for (HeapObject* obj = iterator.next(); obj != NULL;
+         obj = iterator.next()) {
+      if (!obj->IsJSFunction()) continue;
+      JSFunction* function = JSFunction::cast(obj);
+      if (function->shared()->script() != *script) continue;
+      FixedArray* literals = function->literals();
+      int position = function->shared()->start_position();
+      for (int i = JSFunction::kLiteralsPrefixSize; i < literals->length();
+           i++) {
+        Object* literal = literals->get(i);
+        if (!literal->IsAllocationSite()) continue;
+        if (AllocationSite::cast(literal)->pretenure_decision() !=
+            AllocationSite::kTenure) {
+          continue;
+        }
+        if (ContainsPretenuringHint(hints, position, i)) continue;
+        hints.Add(position);
+        hints.Add(i);
+      }
+    }
+  }
+
+  int length = (kPretenuringDataHeaderEntries + hints.length()) * kIntSize;
+  byte* data = NewArray<byte>(length);
+  DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
+  int* entries = reinterpret_cast<int*>(data);
+  entries[kPretenuringDataMagicOffset] = kPretenuringDataMagic;
+  entries[kPretenuringDataVersionHashOffset] = Version::Hash();
+  entries[kPretenuringDataSourceHashOffset] =
+      FeedbackDataSourceHash(String::cast(script->source()));
+  entries[kPretenuringDataLengthOffset] = hints.length() / 2;
+  for (int i = 0; i < hints.length(); i++) {
+    entries[kPretenuringDataHeaderEntries + i] = hints[i];
+  }
+
+  if (FLAG_trace_pretenuring) {
+    PrintF("[Serialized %d pretenuring decisions for script %d]\n",
+           hints.length() / 2, script->id()->value());
+  }
+
+  ScriptData* script_data = new ScriptData(data, length);
+  script_data->AcquireDataOwnership();
+  return script_data;
+}
+
+
+bool CodeSerializer::DeserializePretenuringDecisions(
+    Isolate* isolate, ScriptData* data, Handle<SharedFunctionInfo> info) {
+  Handle<Script> script(Script::cast(info->script()), isolate);
+  int header_size = kPretenuringDataHeaderEntries * kIntSize;
+  if (data->length() < header_size) return false;
+  const int* entries = reinterpret_cast<const int*>(data->data());
+  if (entries[kPretenuringDataMagicOffset] != kPretenuringDataMagic ||
+      entries[kPretenuringDataVersionHashOffset] != Version::Hash() ||
+      entries[kPretenuringDataSourceHashOffset] !=
+          FeedbackDataSourceHash(String::cast(script->source()))) {
+    return false;
+  }
+  int count = entries[kPretenuringDataLengthOffset];
+  if (count < 0 || count > (data->length() - header_size) / (2 * kIntSize) ||
+      data->length() != header_size + count * 2 * kIntSize) {
+    return false;
+  }
+  for (int i = 0; i < 2 * count; i++) {
+    if (!Smi::IsValid(entries[kPretenuringDataHeaderEntries + i])) {
+      return false;
+    }
+  }
+
+  Handle<FixedArray> hints =
+      isolate->factory()->NewFixedArray(2 * count, TENURED);
+  for (int i = 0; i < 2 * count; i++) {
+    hints->set(i, Smi::FromInt(entries[kPretenuringDataHeaderEntries + i]));
+  }
+  script->set_pretenuring_hints(*hints);
+
+  if (FLAG_trace_pretenuring) {
+    PrintF("[Preloaded %d pretenuring decisions for script %d]\n", count,
+           script->id()->value());
+  }
+  return true;
+}
+
+
+// The tiering data consists of int-sized entries:
+// [0] magic number
+// [1] version hash, see Version::Hash
+// [2] source hash, see FeedbackDataSourceHash
+// [3] number of hints
+// followed by the start positions of the functions that got optimized.
+static const int kTieringDataMagic = 0x71e7e1a1;
+static const int kTieringDataMagicOffset = 0;
+static const int kTieringDataVersionHashOffset = 1;
+static const int kTieringDataSourceHashOffset = 2;
+static const int kTieringDataLengthOffset = 3;
+static const int kTieringDataHeaderEntries = 4;
+
+
+ScriptData* CodeSerializer::SerializeTieringHints(
+    Isolate* isolate, Handle<SharedFunctionInfo> info) {
+  Handle<Script> script(Script::cast(info->script()), isolate);
+  List<int> hints;
+
+  // Keep hints that were preloaded but did not lead to optimization yet.
+  if (script->tiering_hints()->IsFixedArray()) {
+    FixedArray* preloaded = FixedArray::cast(script->tiering_hints());
+    for (int i = 0; i < preloaded->length(); i++) {
+      hints.Add(Smi::cast(preloaded->get(i))->value());
+    }
+  }
+
+  {
+    HeapIterator iterator(isolate->heap());
+    DisallowHeapAllocation no_gc;
+    for (HeapObject* obj = iterator.next(); obj != NULL;
+         obj = iterator.next()) {
+      if (!obj->IsSharedFunctionInfo()) continue;
+      SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+      if (shared->script() != *script) continue;
+      if (shared->is_toplevel() || shared->optimization_disabled()) continue;
+      if (shared->opt_count() == 0) continue;
+      int position = shared->start_position();
+      if (!hints.Contains(position)) hints.Add(position);
+    }
+  }
+
+  int length = (kTieringDataHeaderEntries + hints.length()) * kIntSize;
+  byte* data = NewArray<byte>(length);
+  DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
+  int* entries = reinterpret_cast<int*>(data);
+  entries[kTieringDataMagicOffset] = kTieringDataMagic;
+  entries[kTieringDataVersionHashOffset] = Version::Hash();
+  entries[kTieringDataSourceHashOffset] =
+      FeedbackDataSourceHash(String::cast(script->source()));
+  entries[kTieringDataLengthOffset] = hints.length();
+  for (int i = 0; i < hints.length(); i++) {
+    entries[kTieringDataHeaderEntries + i] = hints[i];
+  }
+
+  if (FLAG_trace_opt) {
+    PrintF("[Serialized %d tiering hints for script %d]\n", hints.length(),
+           script->id()->value());
+  }
+
+  ScriptData* script_data = new ScriptData(data, length);
+  script_data->AcquireDataOwnership();
+  return script_data;
+}
+
+
+bool CodeSerializer::DeserializeTieringHints(Isolate* isolate,
+                                             ScriptData* data,
+                                             Handle<SharedFunctionInfo> info) {
+  Handle<Script> script(Script::cast(info->script()), isolate);
+  int header_size = kTieringDataHeaderEntries * kIntSize;
+  if (data->length() < header_size) return false;
+  const int* entries = reinterpret_cast<const int*>(data->data());
+  if (entries[kTieringDataMagicOffset] != kTieringDataMagic ||
+      entries[kTieringDataVersionHashOffset] != Version::Hash() ||
+      entries[kTieringDataSourceHashOffset] !=
+          FeedbackDataSourceHash(String::cast(script->source()))) {
+    return false;
+  }
+  int count = entries[kTieringDataLengthOffset];
+  if (count < 0 || count > (data->length() - header_size) / kIntSize ||
+      data->length() != header_size + count * kIntSize) {
+    return false;
+  }
+  for (int i = 0; i < count; i++) {
+    if (!Smi::IsValid(entries[kTieringDataHeaderEntries + i])) return false;
+  }
+
+  Handle<FixedArray> hints = isolate->factory()->NewFixedArray(count, TENURED);
+  for (int i = 0; i < count; i++) {
+    hints->set(i, Smi::FromInt(entries[kTieringDataHeaderEntries + i]));
+  }
+  script->set_tiering_hints(*hints);
+
+  // Functions compiled lazily from now on pick the hints up in the full code
+  // generator. Mark those that were already compiled, e.g. eagerly.
+  {
+    HeapIterator iterator(isolate->heap());
+    DisallowHeapAllocation no_gc;
+    for (HeapObject* obj = iterator.next(); obj != NULL;
+         obj = iterator.next()) {
+      if (!obj->IsSharedFunctionInfo()) continue;
+      SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+      if (shared->script() != *script) continue;
+      if (shared->code()->kind() != Code::FUNCTION) continue;
+      if (!shared->HasTieringHint()) continue;
+      shared->code()->set_hot_in_previous_run(true);
+    }
+  }
+
+  if (FLAG_trace_opt) {
+    PrintF("[Preloaded %d tiering hints for script %d]\n", count,
+           script->id()->value());
+  }
+  return true;
+}
+
+
 SerializedCodeData::SerializedCodeData(List<byte>* payload, CodeSerializer* cs)
     : owns_script_data_(true) {
   DisallowHeapAllocation no_gc;
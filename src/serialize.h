@@ -257,6 +257,8 @@ class Deserializer: public SerializerDeserializer {
     reservations_[space_number] = reservation;
   }
 
+  // Flushes the instruction cache for the code objects deserialized so far,
+  // i.e. the reserved part of code space and large code objects.
   void FlushICacheForNewCodeObjects();
 
   // Serialized user code reference certain objects that are provided in a list
@@ -312,6 +314,8 @@ class Deserializer: public SerializerDeserializer {
   // This is the address of the next object that will be allocated in each
   // space.  It is used to calculate the addresses of back-references.
   Address high_water_[kNumberOfPreallocatedSpaces];
+  // Start of the reserved code space chunk.
+  Address code_space_start_;
 
   int reservations_[kNumberOfSpaces];
   static const intptr_t kUninitializedReservation = -1;
@@ -581,14 +585,41 @@ class StartupSerializer : public Serializer {
 
 class CodeSerializer : public Serializer {
  public:
+  // Unless |include_inner_code| is set, the code of inner functions is
+  // replaced by the lazy compile builtin.
   static ScriptData* Serialize(Isolate* isolate,
                                Handle<SharedFunctionInfo> info,
-                               Handle<String> source);
+                               Handle<String> source,
+                               bool include_inner_code = false);
 
   static Handle<SharedFunctionInfo> Deserialize(Isolate* isolate,
                                                 ScriptData* data,
                                                 Handle<String> source);
 
+  // Pretenuring decisions learned for the literal allocation sites of the
+  // script of |info| are serialized separately from the code, since they only
+  // become available after the script ran for a while. The data is keyed by
+  // the V8 version and a hash of the script source. Deserializing attaches
+  // the decisions to the script, so that the allocation sites are created
+  // with the right decision. Returns false if the data does not match.
+  static ScriptData* SerializePretenuringDecisions(
+      Isolate* isolate, Handle<SharedFunctionInfo> info);
+  static bool DeserializePretenuringDecisions(Isolate* isolate,
+                                              ScriptData* data,
+                                              Handle<SharedFunctionInfo> info);
+
+  // Tiering hints name the functions of the script of |info| that got
+  // optimized, by start position. Like the pretenuring decisions they are
+  // keyed by the V8 version and a hash of the script source, and serialized
+  // separately from the code.
+  // Deserializing attaches them to the script, and the runtime profiler
+  // optimizes the named functions as soon as their type feedback is stable.
+  // Returns false if the data does not match.
+  static ScriptData* SerializeTieringHints(Isolate* isolate,
+                                           Handle<SharedFunctionInfo> info);
+  static bool DeserializeTieringHints(Isolate* isolate, ScriptData* data,
+                                      Handle<SharedFunctionInfo> info);
+
   static const int kSourceObjectIndex = 0;
   static const int kCodeStubsBaseIndex = 1;
 
@@ -601,8 +632,11 @@ class CodeSerializer : public Serializer {
 
  private:
   CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source,
-                 Code* main_code)
-      : Serializer(isolate, sink), source_(source), main_code_(main_code) {
+                 Code* main_code, bool include_inner_code)
+      : Serializer(isolate, sink),
+        source_(source),
+        main_code_(main_code),
+        include_inner_code_(include_inner_code) {
     set_root_index_wave_front(Heap::kStrongRootListLength);
     InitializeCodeAddressMap();
   }
@@ -623,6 +657,7 @@ class CodeSerializer : public Serializer {
   DisallowHeapAllocation no_gc_;
   String* source_;
   Code* main_code_;
+  bool include_inner_code_;
   List<uint32_t> stub_keys_;
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
@@ -676,6 +711,8 @@ class SerializedCodeData {
     return GetHeaderValue(kReservationsOffset + space);
   }
 
+  static int CheckSum(String* source);
+
  private:
   void SetHeaderValue(int offset, int value) {
     reinterpret_cast<int*>(const_cast<byte*>(script_data_->data()))[offset] =
@@ -688,8 +725,6 @@ class SerializedCodeData {
 
   bool IsSane(String* source);
 
-  int CheckSum(String* source);
-
   // The data header consists of int-sized entries:
   // [0] version hash
   // [1] number of code stub keys
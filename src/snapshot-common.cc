@@ -39,6 +39,11 @@ bool Snapshot::Initialize(Isolate* isolate) {
     if (FLAG_profile_deserialization) {
       double ms = timer.Elapsed().InMillisecondsF();
       PrintF("[Snapshot loading and deserialization took %0.3f ms]\n", ms);
+      // These are duplicated in every isolate of the process.
+      PrintF("[Constant roots take %" V8_PTR_PREFIX "d bytes, builtins %"
+             V8_PTR_PREFIX "d bytes]\n",
+             isolate->heap()->SizeOfConstantRoots(),
+             isolate->builtins()->SizeOfCode());
     }
     return success;
   }
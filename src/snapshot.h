@@ -10,6 +10,8 @@
 namespace v8 {
 namespace internal {
 
+class Serializer;
+
 class Snapshot {
  public:
   // Initialize the Isolate from the internal snapshot. Returns false if no
@@ -71,6 +73,14 @@ class Snapshot {
 void SetSnapshotFromFile(StartupData* snapshot_blob);
 #endif
 
+// Writes the data of a startup serializer and a partial (context) serializer
+// into a startup blob in the format read by SetSnapshotFromFile. The caller
+// owns the data of the result.
+v8::StartupData CreateSnapshotBlob(const List<byte>& snapshot_data,
+                                   const Serializer& serializer,
+                                   const List<byte>& context_data,
+                                   const Serializer& context_serializer);
+
 } }  // namespace v8::internal
 
 #endif  // V8_SNAPSHOT_H_
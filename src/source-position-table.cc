@@ -0,0 +1,95 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/source-position-table.h"
+
+namespace v8 {
+namespace internal {
+
+static const int kChunkBits = 7;
+static const int kChunkMask = (1 << kChunkBits) - 1;
+static const int kMoreBit = 1 << kChunkBits;
+
+
+void SourcePositionTableBuilder::AddPosition(int code_offset,
+                                             int source_position,
+                                             bool is_statement) {
+  DCHECK(code_offset >= previous_code_offset_);
+  DCHECK(source_position >= 0);
+  uint32_t code_delta =
+      static_cast<uint32_t>(code_offset - previous_code_offset_);
+  DCHECK(code_delta <= (kMaxUInt32 >> 1));
+  WriteUnsigned((code_delta << 1) | (is_statement ? 1 : 0));
+  // Zig-zag encode the position delta, which may be negative.
+  int position_delta = source_position - previous_source_position_;
+  WriteUnsigned((static_cast<uint32_t>(position_delta) << 1) ^
+                static_cast<uint32_t>(position_delta >> 31));
+  previous_code_offset_ = code_offset;
+  previous_source_position_ = source_position;
+}
+
+
+Handle<ByteArray> SourcePositionTableBuilder::ToSourcePositionTable(
+    Isolate* isolate) {
+  Factory* factory = isolate->factory();
+  if (bytes_.is_empty()) return factory->empty_byte_array();
+  Handle<ByteArray> table = factory->NewByteArray(bytes_.length(), TENURED);
+  MemCopy(table->GetDataStartAddress(), bytes_.ToVector().start(),
+          bytes_.length());
+  return table;
+}
+
+
+void SourcePositionTableBuilder::WriteUnsigned(uint32_t value) {
+  while (value > static_cast<uint32_t>(kChunkMask)) {
+    bytes_.Add(static_cast<byte>((value & kChunkMask) | kMoreBit));
+    value >>= kChunkBits;
+  }
+  bytes_.Add(static_cast<byte>(value));
+}
+
+
+SourcePositionTableIterator::SourcePositionTableIterator(ByteArray* table)
+    : table_(table),
+      index_(0),
+      code_offset_(0),
+      source_position_(0),
+      is_statement_(false),
+      done_(false) {
+  Advance();
+}
+
+
+void SourcePositionTableIterator::Advance() {
+  DCHECK(!done());
+  if (index_ >= table_->length()) {
+    done_ = true;
+    return;
+  }
+  uint32_t code_value = ReadUnsigned();
+  code_offset_ += static_cast<int>(code_value >> 1);
+  is_statement_ = (code_value & 1) != 0;
+  uint32_t position_value = ReadUnsigned();
+  int position_delta = static_cast<int>(position_value >> 1);
+  if (position_value & 1) position_delta = ~position_delta;
+  source_position_ += position_delta;
+}
+
+
+uint32_t SourcePositionTableIterator::ReadUnsigned() {
+  uint32_t value = 0;
+  int shift = 0;
+  byte current;
+  do {
+    DCHECK(index_ < table_->length());
+    current = table_->get(index_++);
+    value |= static_cast<uint32_t>(current & kChunkMask) << shift;
+    shift += kChunkBits;
+  } while (current & kMoreBit);
+  return value;
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,88 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SOURCE_POSITION_TABLE_H_
+#define V8_SOURCE_POSITION_TABLE_H_
+
+#include "src/allocation.h"
+#include "src/globals.h"
+#include "src/handles.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+class ByteArray;
+class Isolate;
+
+// A source position table maps code offsets to source positions. It lives in
+// a byte array next to the code object instead of in its relocation info, so
+// that the GC never has to read position entries when iterating relocations.
+//
+// Entries are ordered by code offset. Each one is written as two variable
+// length integers: the code offset delta to the previous entry shifted left
+// by one, with the lowest bit set for statement positions, followed by the
+// zig-zag encoded source position delta. Every byte holds 7 bits of data, and
+// the top bit is set on all but the last byte of a value.
+class SourcePositionTableBuilder BASE_EMBEDDED {
+ public:
+  SourcePositionTableBuilder()
+      : previous_code_offset_(0), previous_source_position_(0) {}
+
+  void AddPosition(int code_offset, int source_position, bool is_statement);
+
+  // Returns the table written so far. The empty byte array stands for a
+  // table without entries.
+  Handle<ByteArray> ToSourcePositionTable(Isolate* isolate);
+
+ private:
+  void WriteUnsigned(uint32_t value);
+
+  List<byte> bytes_;
+  int previous_code_offset_;
+  int previous_source_position_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourcePositionTableBuilder);
+};
+
+
+// Iterates the entries of a source position table in code offset order.
+// Like RelocIterator, it holds a raw pointer to the table and must not be
+// used across a GC.
+class SourcePositionTableIterator : public Malloced {
+ public:
+  explicit SourcePositionTableIterator(ByteArray* table);
+
+  bool done() const { return done_; }
+  void Advance();
+
+  int code_offset() const {
+    DCHECK(!done());
+    return code_offset_;
+  }
+  int source_position() const {
+    DCHECK(!done());
+    return source_position_;
+  }
+  bool is_statement() const {
+    DCHECK(!done());
+    return is_statement_;
+  }
+
+ private:
+  uint32_t ReadUnsigned();
+
+  ByteArray* table_;
+  int index_;
+  int code_offset_;
+  int source_position_;
+  bool is_statement_;
+  bool done_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourcePositionTableIterator);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_SOURCE_POSITION_TABLE_H_
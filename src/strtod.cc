@@ -21,6 +21,8 @@ namespace internal {
 // Any integer with at most 15 decimal digits will hence fit into a double
 // (which has a 53bit significand) without loss of precision.
 static const int kMaxExactDoubleIntegerDecimalDigits = 15;
+static const uint64_t kMaxExactDoubleInteger =
+    V8_2PART_UINT64_C(0x00200000, 00000000);
 // 2^64 = 18446744073709551616 > 10^19
 static const int kMaxUint64DecimalDigits = 19;
 
@@ -201,6 +203,23 @@ static bool DoubleStrtod(Vector<const char> trimmed,
       *result *= exact_powers_of_ten[exponent - remaining_digits];
       return true;
     }
+  } else if (trimmed.length() <= kMaxUint64DecimalDigits &&
+             -kExactPowersOfTenSize < exponent &&
+             exponent < kExactPowersOfTenSize) {
+    // Longer inputs, as they come from printing doubles with 16 or 17
+    // digits, still fit into a double if their value is small enough.
+    int read_digits;
+    uint64_t digits = ReadUint64(trimmed, &read_digits);
+    DCHECK(read_digits == trimmed.length());
+    if (digits <= kMaxExactDoubleInteger) {
+      *result = static_cast<double>(digits);
+      if (exponent < 0) {
+        *result /= exact_powers_of_ten[-exponent];
+      } else {
+        *result *= exact_powers_of_ten[exponent];
+      }
+      return true;
+    }
   }
   return false;
 }
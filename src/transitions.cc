@@ -67,10 +67,13 @@ Handle<TransitionArray> TransitionArray::ExtendToFullTransitionArray(
   DCHECK(!containing_map->transitions()->IsFullTransitionArray());
   int nof = containing_map->transitions()->number_of_transitions();
 
-  // A transition array may shrink during GC.
+  // A transition array may shrink during GC, or be dropped altogether once
+  // it has no transitions left.
   Handle<TransitionArray> result = Allocate(containing_map->GetIsolate(), nof);
   DisallowHeapAllocation no_gc;
-  int new_nof = containing_map->transitions()->number_of_transitions();
+  int new_nof = containing_map->HasTransitionArray()
+                    ? containing_map->transitions()->number_of_transitions()
+                    : 0;
   if (new_nof != nof) {
     DCHECK(new_nof == 0);
     result->Shrink(ToKeyIndex(0));
@@ -79,8 +82,7 @@ Handle<TransitionArray> TransitionArray::ExtendToFullTransitionArray(
         containing_map->transitions(), kSimpleTransitionIndex, 0);
   }
 
-  result->set_back_pointer_storage(
-      containing_map->transitions()->back_pointer_storage());
+  result->set_back_pointer_storage(containing_map->GetBackPointer());
   return result;
 }
 
@@ -101,11 +103,17 @@ Handle<TransitionArray> TransitionArray::CopyInsert(Handle<Map> map,
 
   Handle<TransitionArray> result = Allocate(map->GetIsolate(), new_size);
 
-  // The map's transition array may grown smaller during the allocation above as
-  // it was weakly traversed, though it is guaranteed not to disappear. Trim the
+  // The map's transition array may grow smaller during the allocation above as
+  // it was weakly traversed. If none of its transitions survived, the GC drops
+  // the array and the result only holds the new transition. Otherwise trim the
   // result copy if needed, and recompute variables.
-  DCHECK(map->HasTransitionArray());
   DisallowHeapAllocation no_gc;
+  if (!map->HasTransitionArray()) {
+    result->Shrink(ToKeyIndex(1));
+    result->NoIncrementalWriteBarrierSet(0, *name, *target);
+    result->set_back_pointer_storage(map->GetBackPointer());
+    return result;
+  }
   TransitionArray* array = map->transitions();
   if (array->number_of_transitions() != number_of_transitions) {
     DCHECK(array->number_of_transitions() < number_of_transitions);
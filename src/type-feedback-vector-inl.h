@@ -39,6 +39,25 @@ Handle<Object> TypeFeedbackVector::MonomorphicArraySentinel(
 Object* TypeFeedbackVector::RawUninitializedSentinel(Heap* heap) {
   return heap->uninitialized_symbol();
 }
+
+
+int TypeFeedbackVector::invocation_count() {
+  DCHECK(length() >= kReservedIndexCount);
+  return Smi::cast(get(kInvocationCountIndex))->value();
+}
+
+
+int TypeFeedbackVector::back_edge_count() {
+  DCHECK(length() >= kReservedIndexCount);
+  return Smi::cast(get(kBackEdgeCountIndex))->value();
+}
+
+
+void TypeFeedbackVector::ResetCounters() {
+  DCHECK(length() >= kReservedIndexCount);
+  set(kInvocationCountIndex, Smi::FromInt(0));
+  set(kBackEdgeCountIndex, Smi::FromInt(0));
+}
 }
 }  // namespace v8::internal
 
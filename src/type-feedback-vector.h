@@ -25,6 +25,17 @@ class TypeFeedbackVector : public FixedArray {
   static Handle<TypeFeedbackVector> Copy(Isolate* isolate,
                                          Handle<TypeFeedbackVector> vector);
 
+  // Vectors of functions start with exact invocation and back edge counters
+  // maintained by the unoptimized code, the feedback slots follow them. The
+  // counters are Smis, so clearing the feedback leaves them intact.
+  static const int kInvocationCountIndex = 0;
+  static const int kBackEdgeCountIndex = 1;
+  static const int kReservedIndexCount = 2;
+
+  inline int invocation_count();
+  inline int back_edge_count();
+  inline void ResetCounters();
+
   // The object that indicates an uninitialized cache.
   static inline Handle<Object> UninitializedSentinel(Isolate* isolate);
 
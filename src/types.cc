@@ -202,6 +202,12 @@ TypeImpl<Config>::BitsetType::Lub(i::Map* map) {
     }
     case HEAP_NUMBER_TYPE:
       return kNumber & kTaggedPtr;
+    case FLOAT32X4_TYPE:
+    case INT32X4_TYPE:
+    case FLOAT64X2_TYPE:
+      // There is no bitset for SIMD values yet, so the optimizing compilers
+      // treat them as opaque.
+      return kInternal & kTaggedPtr;
     case JS_VALUE_TYPE:
     case JS_DATE_TYPE:
     case JS_OBJECT_TYPE:
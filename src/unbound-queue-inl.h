@@ -13,67 +13,65 @@ namespace internal {
 template<typename Record>
 struct UnboundQueue<Record>::Node: public Malloced {
   explicit Node(const Record& value)
-      : value(value), next(NULL) {
+      : value(value), next(0) {
   }
 
   Record value;
-  Node* next;
+  base::AtomicWord next;  // Node*
 };
 
 
 template<typename Record>
 UnboundQueue<Record>::UnboundQueue() {
   first_ = new Node(Record());
-  divider_ = last_ = reinterpret_cast<base::AtomicWord>(first_);
+  last_ = reinterpret_cast<base::AtomicWord>(first_);
 }
 
 
 template<typename Record>
 UnboundQueue<Record>::~UnboundQueue() {
-  while (first_ != NULL) DeleteFirst();
-}
-
-
-template<typename Record>
-void UnboundQueue<Record>::DeleteFirst() {
-  Node* tmp = first_;
-  first_ = tmp->next;
-  delete tmp;
+  while (first_ != NULL) {
+    Node* tmp = first_;
+    first_ = reinterpret_cast<Node*>(tmp->next);
+    delete tmp;
+  }
 }
 
 
 template<typename Record>
 bool UnboundQueue<Record>::Dequeue(Record* rec) {
-  if (divider_ == base::Acquire_Load(&last_)) return false;
-  Node* next = reinterpret_cast<Node*>(divider_)->next;
+  Node* next = reinterpret_cast<Node*>(base::Acquire_Load(&first_->next));
+  if (next == NULL) return false;
   *rec = next->value;
-  base::Release_Store(&divider_, reinterpret_cast<base::AtomicWord>(next));
+  delete first_;
+  first_ = next;
   return true;
 }
 
 
 template<typename Record>
 void UnboundQueue<Record>::Enqueue(const Record& rec) {
-  Node*& next = reinterpret_cast<Node*>(last_)->next;
-  next = new Node(rec);
-  base::Release_Store(&last_, reinterpret_cast<base::AtomicWord>(next));
-
-  while (first_ != reinterpret_cast<Node*>(base::Acquire_Load(&divider_))) {
-    DeleteFirst();
-  }
+  Node* node = new Node(rec);
+  // The node must be initialized before other producers can link to it.
+  base::MemoryBarrier();
+  // Claim the place after the current last node. Until the link below is
+  // stored, the consumer sees the queue end at the previous node.
+  Node* prev = reinterpret_cast<Node*>(base::NoBarrier_AtomicExchange(
+      &last_, reinterpret_cast<base::AtomicWord>(node)));
+  base::Release_Store(&prev->next, reinterpret_cast<base::AtomicWord>(node));
 }
 
 
 template<typename Record>
 bool UnboundQueue<Record>::IsEmpty() const {
-  return base::NoBarrier_Load(&divider_) == base::NoBarrier_Load(&last_);
+  return base::NoBarrier_Load(&first_->next) == 0;
 }
 
 
 template<typename Record>
 Record* UnboundQueue<Record>::Peek() const {
-  if (divider_ == base::Acquire_Load(&last_)) return NULL;
-  Node* next = reinterpret_cast<Node*>(divider_)->next;
+  Node* next = reinterpret_cast<Node*>(base::Acquire_Load(&first_->next));
+  if (next == NULL) return NULL;
   return &next->value;
 }
 
@@ -13,11 +13,13 @@ namespace internal {
 
 
 // Lock-free unbound queue for small records.  Intended for
-// transferring small records between a Single producer and a Single
+// transferring small records from any number of producers to a single
 // consumer. Doesn't have restrictions on the number of queued
-// elements, so producer never blocks.  Implemented after Herb
-// Sutter's article:
-// http://www.ddj.com/high-performance-computing/210604448
+// elements, so producers never block.  Enqueue may be called from any
+// thread, the other operations only from the consumer thread.
+// Producers link their nodes in with a single atomic exchange of the
+// last node, after Dmitry Vyukov's intrusive MPSC node-based queue:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
 template<typename Record>
 class UnboundQueue BASE_EMBEDDED {
  public:
@@ -30,13 +32,12 @@ class UnboundQueue BASE_EMBEDDED {
   INLINE(Record* Peek() const);
 
  private:
-  INLINE(void DeleteFirst());
-
   struct Node;
 
+  // The node whose successor is dequeued next. Only the consumer
+  // touches it.
   Node* first_;
-  base::AtomicWord divider_;  // Node*
-  base::AtomicWord last_;     // Node*
+  base::AtomicWord last_;  // Node*
 
   DISALLOW_COPY_AND_ASSIGN(UnboundQueue);
 };
@@ -269,6 +269,17 @@ void Utf8DecoderBase::Reset(uint16_t* buffer,
   // Loop until stream is read, writing to buffer as long as buffer has space.
   unsigned utf16_length = 0;
   while (stream_length != 0) {
+    if (!writing_to_buffer) {
+      // Past the buffer only the length is needed. Each ASCII byte is one
+      // UTF-16 code unit, so runs of them are counted without decoding.
+      const uint8_t* ascii_start = stream;
+      while (stream_length != 0 && *stream <= Utf8::kMaxOneByteChar) {
+        stream++;
+        stream_length--;
+      }
+      utf16_length += static_cast<unsigned>(stream - ascii_start);
+      if (stream_length == 0) break;
+    }
     unsigned cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, stream_length, &cursor);
     DCHECK(cursor > 0 && cursor <= stream_length);
@@ -309,6 +320,12 @@ void Utf8DecoderBase::WriteUtf16Slow(const uint8_t* stream,
                                      uint16_t* data,
                                      unsigned data_length) {
   while (data_length != 0) {
+    // The stream was validated in Reset, so ASCII bytes are widened as is.
+    if (*stream <= Utf8::kMaxOneByteChar) {
+      *data++ = *stream++;
+      data_length--;
+      continue;
+    }
     unsigned cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, Utf8::kMaxEncodedSize, &cursor);
     // There's a total lack of bounds checking for stream
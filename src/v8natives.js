@@ -1776,6 +1776,9 @@ function FunctionBind(this_arg) { // Length is 1.
   if (!IS_SPEC_FUNCTION(this)) {
     throw new $TypeError('Bind must be called on a function');
   }
+  // The bindings never change once the bound function has been created, so
+  // they are read once below instead of on every call.
+  var bindings, target, bound_this, bound_argc, call_directly;
   var boundFunction = function () {
     // Poison .arguments and .caller, but is otherwise not detectable.
     "use strict";
@@ -1784,16 +1787,29 @@ function FunctionBind(this_arg) { // Length is 1.
     if (%_IsConstructCall()) {
       return %NewObjectFromBound(boundFunction);
     }
-    var bindings = %BoundFunctionGetBindings(boundFunction);
 
     var argc = %_ArgumentsLength();
+    if (call_directly) {
+      // Calls without bound arguments pass their own arguments through.
+      switch (argc) {
+        case 0:
+          return %_CallFunction(bound_this, target);
+        case 1:
+          return %_CallFunction(bound_this, %_Arguments(0), target);
+        case 2:
+          return %_CallFunction(bound_this, %_Arguments(0), %_Arguments(1),
+                                target);
+        case 3:
+          return %_CallFunction(bound_this, %_Arguments(0), %_Arguments(1),
+                                %_Arguments(2), target);
+      }
+    }
     if (argc == 0) {
-      return %Apply(bindings[0], bindings[1], bindings, 2, bindings.length - 2);
+      return %Apply(target, bound_this, bindings, 2, bound_argc);
     }
-    if (bindings.length === 2) {
-      return %Apply(bindings[0], bindings[1], arguments, 0, argc);
+    if (bound_argc === 0) {
+      return %Apply(target, bound_this, arguments, 0, argc);
     }
-    var bound_argc = bindings.length - 2;
     var argv = new InternalArray(bound_argc + argc);
     for (var i = 0; i < bound_argc; i++) {
       argv[i] = bindings[i + 2];
@@ -1801,7 +1817,7 @@ function FunctionBind(this_arg) { // Length is 1.
     for (var j = 0; j < argc; j++) {
       argv[i++] = %_Arguments(j);
     }
-    return %Apply(bindings[0], bindings[1], argv, 0, bound_argc + argc);
+    return %Apply(target, bound_this, argv, 0, bound_argc + argc);
   };
 
   var new_length = 0;
@@ -1818,6 +1834,14 @@ function FunctionBind(this_arg) { // Length is 1.
   // so we don't pass the arguments object.
   var result = %FunctionBindArguments(boundFunction, this,
                                       this_arg, new_length);
+  bindings = %BoundFunctionGetBindings(result);
+  target = bindings[0];
+  bound_this = bindings[1];
+  bound_argc = bindings.length - 2;
+  // %_CallFunction leaves receiver conversion to the callee, which only
+  // replaces an undefined receiver, so other primitives take the %Apply path.
+  call_directly = bound_argc === 0 && IS_FUNCTION(target) &&
+                  (IS_SPEC_OBJECT(bound_this) || IS_UNDEFINED(bound_this));
 
   // We already have caller and arguments properties on functions,
   // which are non-configurable. It therefore makes no sence to
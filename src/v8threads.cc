@@ -47,9 +47,7 @@ void Locker::Initialize(v8::Isolate* isolate) {
     if (isolate_->thread_manager()->RestoreThread()) {
       top_level_ = false;
     } else {
-      internal::ExecutionAccess access(isolate_);
-      isolate_->stack_guard()->ClearThread(access);
-      isolate_->stack_guard()->InitThread(access);
+      isolate_->thread_manager()->InitThread();
     }
   }
   DCHECK(isolate_->thread_manager()->IsLockedByCurrentThread());
@@ -85,7 +83,12 @@ void Unlocker::Initialize(v8::Isolate* isolate) {
   DCHECK(isolate != NULL);
   isolate_ = reinterpret_cast<i::Isolate*>(isolate);
   DCHECK(isolate_->thread_manager()->IsLockedByCurrentThread());
-  isolate_->thread_manager()->ArchiveThread();
+  if (isolate_->thread_manager()->CanReleaseWithoutArchiving()) {
+    // Only the stack limit has to be remembered for this thread.
+    isolate_->stack_guard()->FreeThreadResources();
+  } else {
+    isolate_->thread_manager()->ArchiveThread();
+  }
   isolate_->thread_manager()->Unlock();
 }
 
@@ -93,7 +96,9 @@ void Unlocker::Initialize(v8::Isolate* isolate) {
 Unlocker::~Unlocker() {
   DCHECK(!isolate_->thread_manager()->IsLockedByCurrentThread());
   isolate_->thread_manager()->Lock();
-  isolate_->thread_manager()->RestoreThread();
+  if (!isolate_->thread_manager()->RestoreThread()) {
+    isolate_->thread_manager()->InitThread();
+  }
 }
 
 
@@ -155,6 +160,47 @@ bool ThreadManager::RestoreThread() {
 }
 
 
+bool ThreadManager::CanReleaseWithoutArchiving() {
+  DCHECK(IsLockedByCurrentThread());
+  ThreadLocalTop* top = isolate_->thread_local_top();
+  if (Isolate::c_entry_fp(top) != NULL || isolate_->js_entry_sp() != NULL) {
+    return false;
+  }
+  if (isolate_->try_catch_handler() != NULL ||
+      isolate_->has_pending_exception() ||
+      isolate_->has_scheduled_exception() ||
+      isolate_->external_caught_exception() || top->has_pending_message_) {
+    return false;
+  }
+  if (isolate_->context() != NULL || isolate_->save_context() != NULL ||
+      isolate_->relocatable_top() != NULL) {
+    return false;
+  }
+  if (isolate_->handle_scope_implementer()->HasThreadState() ||
+      isolate_->handle_scope_data()->level != 0) {
+    return false;
+  }
+  if (isolate_->debug()->is_active() || isolate_->bootstrapper()->IsActive()) {
+    return false;
+  }
+  ExecutionAccess access(isolate_);
+  return !isolate_->stack_guard()->has_pending_interrupts(access);
+}
+
+
+void ThreadManager::InitThread() {
+  DCHECK(IsLockedByCurrentThread());
+  ExecutionAccess access(isolate_);
+  isolate_->stack_guard()->ClearThread(access);
+  isolate_->stack_guard()->InitThread(access);
+  // The thread-local top may have been used by other threads in between.
+  isolate_->set_thread_id(ThreadId::Current());
+#ifdef USE_SIMULATOR
+  isolate_->thread_local_top()->simulator_ = Simulator::current(isolate_);
+#endif
+}
+
+
 void ThreadManager::Lock() {
   mutex_.Lock();
   mutex_owner_ = ThreadId::Current();
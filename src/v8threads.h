@@ -74,6 +74,16 @@ class ThreadManager {
   void FreeThreadResources();
   bool IsArchived();
 
+  // Returns true if the current thread has nothing to archive: no JS frames,
+  // handle scopes, entered contexts, pending exceptions or interrupts. Such a
+  // thread can give up the lock like a thread that leaves its top-level
+  // Locker, and later take it again like a thread that never had it.
+  bool CanReleaseWithoutArchiving();
+
+  // Sets up the thread-local state of a thread that takes the lock without
+  // an archived state to restore.
+  void InitThread();
+
   void Iterate(ObjectVisitor* v);
   void IterateArchivedThreads(ThreadVisitor* v);
   bool IsLockedByCurrentThread() {
@@ -0,0 +1,998 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/value-serializer.h"
+
+#include "src/api.h"
+#include "src/execution.h"
+#include "src/field-index-inl.h"
+#include "src/global-handles.h"
+#include "src/runtime/runtime.h"
+
+namespace v8 {
+namespace internal {
+
+// The version of the wire format, written by WriteHeader. It has to be
+// increased whenever the format changes.
+static const uint32_t kLatestVersion = 1;
+
+// Every value starts with one of these tags.
+enum SerializationTag {
+  kVersionTag = 0xFF,
+  kUndefinedTag = '_',
+  kNullTag = '0',
+  kTrueTag = 'T',
+  kFalseTag = 'F',
+  // ZigZag encoded varint.
+  kInt32Tag = 'I',
+  // Raw IEEE 754 double.
+  kDoubleTag = 'N',
+  // Varint byte length, then the characters.
+  kOneByteStringValueTag = '"',
+  kTwoByteStringValueTag = 'c',
+  // Varint id of an object written before by the same WriteValue call.
+  kObjectReferenceTag = '^',
+  // Key value pairs, then the end tag and a varint number of properties.
+  kBeginJSObjectTag = 'o',
+  kEndJSObjectTag = '{',
+  // Varint length and the elements, of which holes are written as
+  // kTheHoleTag. Then the other properties as for objects, their number
+  // and the length again.
+  kBeginDenseJSArrayTag = 'A',
+  kEndDenseJSArrayTag = '$',
+  // Varint length and all properties as for objects, their number and the
+  // length again.
+  kBeginSparseJSArrayTag = 'a',
+  kEndSparseJSArrayTag = '@',
+  kTheHoleTag = '-',
+  // The time value as a raw double.
+  kDateTag = 'D',
+  // Keys and values, then the end tag and a varint number of keys and
+  // values.
+  kBeginJSMapTag = ';',
+  kEndJSMapTag = ':',
+  // Keys, then the end tag and a varint number of keys.
+  kBeginJSSetTag = '\'',
+  kEndJSSetTag = ',',
+  // Varint byte length, then the contents.
+  kArrayBufferTag = 'B',
+  // Varint transfer id.
+  kArrayBufferTransferTag = 't',
+  // Follows the buffer of a view. One of the view tags below, then a
+  // varint byte offset and a varint length (byte length for DataViews).
+  kArrayBufferViewTag = 'V',
+  // Whatever the delegate writes.
+  kHostObjectTag = '\\'
+};
+
+
+enum ArrayBufferViewTag {
+  kInt8ArrayTag = 'b',
+  kUint8ArrayTag = 'B',
+  kUint8ClampedArrayTag = 'C',
+  kInt16ArrayTag = 'w',
+  kUint16ArrayTag = 'W',
+  kInt32ArrayTag = 'd',
+  kUint32ArrayTag = 'D',
+  kFloat32ArrayTag = 'f',
+  kFloat64ArrayTag = 'F',
+  kDataViewTag = '?'
+};
+
+
+ValueSerializer::ValueSerializer(Isolate* isolate,
+                                 v8::ValueSerializer::Delegate* delegate)
+    : isolate_(isolate), delegate_(delegate), next_id_(0) {}
+
+
+ValueSerializer::~ValueSerializer() {
+  for (int i = 0; i < array_buffer_transfers_.length(); i++) {
+    GlobalHandles::Destroy(
+        Handle<Object>::cast(array_buffer_transfers_[i].array_buffer)
+            .location());
+  }
+}
+
+
+void ValueSerializer::WriteHeader() {
+  WriteTag(kVersionTag);
+  WriteVarint(kLatestVersion);
+}
+
+
+bool ValueSerializer::WriteValue(Handle<Object> object) {
+  id_map_ = ObjectHashTable::New(isolate_, 16);
+  next_id_ = 0;
+  bool result = WriteObject(object);
+  id_map_ = Handle<ObjectHashTable>();
+  return result;
+}
+
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Handle<JSArrayBuffer> array_buffer) {
+  ArrayBufferTransfer transfer;
+  transfer.transfer_id = transfer_id;
+  transfer.array_buffer = Handle<JSArrayBuffer>::cast(
+      isolate_->global_handles()->Create(*array_buffer));
+  array_buffer_transfers_.Add(transfer);
+}
+
+
+void ValueSerializer::WriteRawBytes(const void* source, size_t length) {
+  if (length == 0) return;
+  CHECK_LE(length, static_cast<size_t>(kMaxInt));
+  Vector<uint8_t> block = buffer_.AddBlock(0, static_cast<int>(length));
+  MemCopy(block.start(), source, length);
+}
+
+
+void ValueSerializer::WriteVarint(uint32_t value) {
+  // Seven bits at a time, least significant first. All bytes but the last
+  // have the high bit set.
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer_.Add(byte);
+  } while (value != 0);
+}
+
+
+void ValueSerializer::WriteZigZag(int32_t value) {
+  // Maps small negative numbers to small unsigned numbers.
+  WriteVarint((static_cast<uint32_t>(value) << 1) ^
+              static_cast<uint32_t>(value >> 31));
+}
+
+
+void ValueSerializer::WriteDouble(double value) {
+  WriteRawBytes(&value, sizeof(value));
+}
+
+
+void ValueSerializer::WriteString(Handle<String> string) {
+  string = String::Flatten(string);
+  DisallowHeapAllocation no_gc;
+  String::FlatContent flat = string->GetFlatContent();
+  DCHECK(flat.IsFlat());
+  if (flat.IsOneByte()) {
+    Vector<const uint8_t> chars = flat.ToOneByteVector();
+    WriteTag(kOneByteStringValueTag);
+    WriteVarint(chars.length());
+    WriteRawBytes(chars.start(), chars.length());
+  } else {
+    Vector<const uc16> chars = flat.ToUC16Vector();
+    uint32_t byte_length = chars.length() * sizeof(uc16);
+    WriteTag(kTwoByteStringValueTag);
+    WriteVarint(byte_length);
+    WriteRawBytes(chars.start(), byte_length);
+  }
+}
+
+
+bool ValueSerializer::WriteObject(Handle<Object> object) {
+  if (object->IsSmi()) {
+    WriteTag(kInt32Tag);
+    WriteZigZag(Smi::cast(*object)->value());
+    return true;
+  }
+  if (object->IsHeapNumber()) {
+    WriteTag(kDoubleTag);
+    WriteDouble(HeapNumber::cast(*object)->value());
+    return true;
+  }
+  if (object->IsUndefined()) {
+    WriteTag(kUndefinedTag);
+  } else if (object->IsNull()) {
+    WriteTag(kNullTag);
+  } else if (object->IsTrue()) {
+    WriteTag(kTrueTag);
+  } else if (object->IsFalse()) {
+    WriteTag(kFalseTag);
+  } else if (object->IsString()) {
+    WriteString(Handle<String>::cast(object));
+  } else if (object->IsJSReceiver()) {
+    return WriteJSReceiver(Handle<JSReceiver>::cast(object));
+  } else {
+    return ThrowDataCloneError(object);
+  }
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSReceiver(Handle<JSReceiver> receiver) {
+  // Objects that have been written before are written as references, which
+  // also takes care of cycles.
+  Object* id = id_map_->Lookup(receiver);
+  if (id->IsSmi()) {
+    WriteTag(kObjectReferenceTag);
+    WriteVarint(Smi::cast(id)->value());
+    return true;
+  }
+
+  StackLimitCheck stack_check(isolate_);
+  if (stack_check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return false;
+  }
+
+  // Views are written after their buffer and get their id after it.
+  if (receiver->IsJSArrayBufferView()) {
+    return WriteJSArrayBufferView(Handle<JSArrayBufferView>::cast(receiver));
+  }
+
+  id_map_ = ObjectHashTable::Put(
+      id_map_, receiver, handle(Smi::FromInt(next_id_++), isolate_));
+
+  switch (receiver->map()->instance_type()) {
+    case JS_OBJECT_TYPE: {
+      Handle<JSObject> object = Handle<JSObject>::cast(receiver);
+      if (object->IsAccessCheckNeeded()) return ThrowDataCloneError(object);
+      if (object->GetInternalFieldCount() > 0) return WriteHostObject(object);
+      return WriteJSObject(object);
+    }
+    case JS_ARRAY_TYPE:
+      return WriteJSArray(Handle<JSArray>::cast(receiver));
+    case JS_DATE_TYPE:
+      WriteTag(kDateTag);
+      WriteDouble(JSDate::cast(*receiver)->value()->Number());
+      return true;
+    case JS_MAP_TYPE:
+      return WriteJSMap(Handle<JSMap>::cast(receiver));
+    case JS_SET_TYPE:
+      return WriteJSSet(Handle<JSSet>::cast(receiver));
+    case JS_ARRAY_BUFFER_TYPE:
+      return WriteJSArrayBuffer(Handle<JSArrayBuffer>::cast(receiver));
+    default:
+      return ThrowDataCloneError(receiver);
+  }
+}
+
+
+bool ValueSerializer::WriteJSObject(Handle<JSObject> object) {
+  WriteTag(kBeginJSObjectTag);
+  uint32_t properties_written;
+  if (!WriteJSObjectProperties(object, true, &properties_written)) {
+    return false;
+  }
+  WriteTag(kEndJSObjectTag);
+  WriteVarint(properties_written);
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSArray(Handle<JSArray> array) {
+  uint32_t length = 0;
+  CHECK(array->length()->ToArrayIndex(&length));
+  uint32_t properties_written;
+
+  if (!array->HasFastSmiOrObjectElements() &&
+      !array->HasFastDoubleElements()) {
+    WriteTag(kBeginSparseJSArrayTag);
+    WriteVarint(length);
+    if (!WriteJSObjectProperties(array, true, &properties_written)) {
+      return false;
+    }
+    WriteTag(kEndSparseJSArrayTag);
+    WriteVarint(properties_written);
+    WriteVarint(length);
+    return true;
+  }
+
+  WriteTag(kBeginDenseJSArrayTag);
+  WriteVarint(length);
+  for (uint32_t i = 0; i < length; i++) {
+    // Writing an element may run accessors that change the array, so its
+    // elements are checked again for every element.
+    Handle<Object> element;
+    bool in_bounds =
+        i < static_cast<uint32_t>(array->elements()->length());
+    if (in_bounds && array->HasFastDoubleElements()) {
+      FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+      if (elements->is_the_hole(i)) {
+        WriteTag(kTheHoleTag);
+        continue;
+      }
+      element = isolate_->factory()->NewNumber(elements->get_scalar(i));
+    } else if (in_bounds && array->HasFastSmiOrObjectElements()) {
+      Object* raw_element = FixedArray::cast(array->elements())->get(i);
+      if (raw_element->IsTheHole()) {
+        WriteTag(kTheHoleTag);
+        continue;
+      }
+      element = handle(raw_element, isolate_);
+    } else {
+      ASSIGN_RETURN_ON_EXCEPTION_VALUE(
+          isolate_, element, Object::GetElement(isolate_, array, i), false);
+    }
+    if (!WriteObject(element)) return false;
+  }
+  if (!WriteJSObjectProperties(array, false, &properties_written)) {
+    return false;
+  }
+  WriteTag(kEndDenseJSArrayTag);
+  WriteVarint(properties_written);
+  WriteVarint(length);
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSMap(Handle<JSMap> map) {
+  // The entries are copied first, since writing them may run accessors that
+  // change the map.
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()), isolate_);
+  int length = table->NumberOfElements() * 2;
+  Handle<FixedArray> entries = isolate_->factory()->NewFixedArray(length);
+  {
+    DisallowHeapAllocation no_gc;
+    int capacity = table->UsedCapacity();
+    int result_index = 0;
+    for (int i = 0; i < capacity; i++) {
+      Object* key = table->KeyAt(i);
+      if (key->IsTheHole()) continue;
+      entries->set(result_index++, key);
+      entries->set(result_index++, table->ValueAt(i));
+    }
+    DCHECK_EQ(length, result_index);
+  }
+
+  WriteTag(kBeginJSMapTag);
+  if (!WriteEntries(entries)) return false;
+  WriteTag(kEndJSMapTag);
+  WriteVarint(length);
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSSet(Handle<JSSet> set) {
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()), isolate_);
+  int length = table->NumberOfElements();
+  Handle<FixedArray> entries = isolate_->factory()->NewFixedArray(length);
+  {
+    DisallowHeapAllocation no_gc;
+    int capacity = table->UsedCapacity();
+    int result_index = 0;
+    for (int i = 0; i < capacity; i++) {
+      Object* key = table->KeyAt(i);
+      if (key->IsTheHole()) continue;
+      entries->set(result_index++, key);
+    }
+    DCHECK_EQ(length, result_index);
+  }
+
+  WriteTag(kBeginJSSetTag);
+  if (!WriteEntries(entries)) return false;
+  WriteTag(kEndJSSetTag);
+  WriteVarint(length);
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSArrayBuffer(Handle<JSArrayBuffer> array_buffer) {
+  for (int i = 0; i < array_buffer_transfers_.length(); i++) {
+    if (*array_buffer_transfers_[i].array_buffer == *array_buffer) {
+      WriteTag(kArrayBufferTransferTag);
+      WriteVarint(array_buffer_transfers_[i].transfer_id);
+      return true;
+    }
+  }
+
+  // Copying the contents of a shared buffer would lose the sharing, so
+  // shared buffers have to be transferred.
+  if (array_buffer->is_shared()) return ThrowDataCloneError(array_buffer);
+  size_t byte_length = NumberToSize(isolate_, array_buffer->byte_length());
+  if (byte_length > static_cast<size_t>(kMaxInt)) {
+    return ThrowDataCloneError(array_buffer);
+  }
+  WriteTag(kArrayBufferTag);
+  WriteVarint(static_cast<uint32_t>(byte_length));
+  WriteRawBytes(array_buffer->backing_store(), byte_length);
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSArrayBufferView(Handle<JSArrayBufferView> view) {
+  uint8_t tag = kDataViewTag;
+  Handle<JSArrayBuffer> array_buffer;
+  Handle<Object> length(view->byte_length(), isolate_);
+  if (view->IsJSTypedArray()) {
+    Handle<JSTypedArray> typed_array = Handle<JSTypedArray>::cast(view);
+    switch (typed_array->type()) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size) \
+      case kExternal##Type##Array:                      \
+        tag = k##Type##ArrayTag;                        \
+        break;
+
+      TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+    }
+    array_buffer = typed_array->GetBuffer();
+    length = handle(typed_array->length(), isolate_);
+  } else {
+    array_buffer = handle(JSArrayBuffer::cast(view->buffer()), isolate_);
+  }
+
+  if (!WriteJSReceiver(array_buffer)) return false;
+  id_map_ = ObjectHashTable::Put(
+      id_map_, view, handle(Smi::FromInt(next_id_++), isolate_));
+  WriteTag(kArrayBufferViewTag);
+  WriteTag(tag);
+  WriteVarint(NumberToUint32(view->byte_offset()));
+  WriteVarint(NumberToUint32(*length));
+  return true;
+}
+
+
+bool ValueSerializer::WriteHostObject(Handle<JSObject> object) {
+  if (delegate_ == NULL) return ThrowDataCloneError(object);
+  WriteTag(kHostObjectTag);
+  if (delegate_->WriteHostObject(reinterpret_cast<v8::Isolate*>(isolate_),
+                                 Utils::ToLocal(object))) {
+    return true;
+  }
+  // The delegate may have thrown an exception of its own.
+  if (isolate_->has_scheduled_exception()) {
+    isolate_->PromoteScheduledException();
+    return false;
+  }
+  if (isolate_->has_pending_exception()) return false;
+  return ThrowDataCloneError(object);
+}
+
+
+bool ValueSerializer::WriteJSObjectProperties(Handle<JSObject> object,
+                                              bool include_elements,
+                                              uint32_t* properties_written) {
+  *properties_written = 0;
+
+  if (object->HasFastProperties() &&
+      !object->HasIndexedInterceptor() &&
+      !object->HasNamedInterceptor() &&
+      (!include_elements || object->elements()->length() == 0)) {
+    // Walk the descriptors instead of collecting the keys. Fields are read
+    // directly unless accessors have changed the map.
+    Handle<Map> map(object->map(), isolate_);
+    for (int i = 0; i < map->NumberOfOwnDescriptors(); i++) {
+      Handle<Name> name(map->instance_descriptors()->GetKey(i), isolate_);
+      if (!name->IsString()) continue;
+      PropertyDetails details = map->instance_descriptors()->GetDetails(i);
+      if (details.IsDontEnum()) continue;
+      Handle<Object> value;
+      if (details.type() == FIELD && *map == object->map()) {
+        value = JSObject::FastPropertyAt(object, details.representation(),
+                                         FieldIndex::ForDescriptor(*map, i));
+      } else {
+        ASSIGN_RETURN_ON_EXCEPTION_VALUE(
+            isolate_, value, Object::GetProperty(object, name), false);
+      }
+      if (!WriteProperty(name, value)) return false;
+      (*properties_written)++;
+    }
+    return true;
+  }
+
+  Handle<FixedArray> keys;
+  ASSIGN_RETURN_ON_EXCEPTION_VALUE(
+      isolate_, keys, JSReceiver::GetKeys(object, JSReceiver::OWN_ONLY),
+      false);
+  for (int i = 0; i < keys->length(); i++) {
+    Handle<Object> key(keys->get(i), isolate_);
+    // Element keys are numbers.
+    if (!include_elements && key->IsNumber()) continue;
+    Handle<Object> value;
+    ASSIGN_RETURN_ON_EXCEPTION_VALUE(
+        isolate_, value, Runtime::GetObjectProperty(isolate_, object, key),
+        false);
+    if (!WriteProperty(key, value)) return false;
+    (*properties_written)++;
+  }
+  return true;
+}
+
+
+bool ValueSerializer::WriteProperty(Handle<Object> key, Handle<Object> value) {
+  DCHECK(key->IsString() || key->IsNumber());
+  return WriteObject(key) && WriteObject(value);
+}
+
+
+bool ValueSerializer::WriteEntries(Handle<FixedArray> entries) {
+  for (int i = 0; i < entries->length(); i++) {
+    if (!WriteObject(handle(entries->get(i), isolate_))) return false;
+  }
+  return true;
+}
+
+
+bool ValueSerializer::ThrowDataCloneError(Handle<Object> object) {
+  Handle<Object> error;
+  if (isolate_->factory()
+          ->NewError("data_clone_error", HandleVector(&object, 1))
+          .ToHandle(&error)) {
+    isolate_->Throw(*error);
+  }
+  return false;
+}
+
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate,
+                                     Vector<const uint8_t> data,
+                                     v8::ValueDeserializer::Delegate* delegate)
+    : isolate_(isolate),
+      delegate_(delegate),
+      position_(data.start()),
+      end_(data.start() + data.length()) {}
+
+
+ValueDeserializer::~ValueDeserializer() {
+  for (int i = 0; i < array_buffer_transfers_.length(); i++) {
+    GlobalHandles::Destroy(
+        Handle<Object>::cast(array_buffer_transfers_[i].array_buffer)
+            .location());
+  }
+}
+
+
+bool ValueDeserializer::ReadHeader() {
+  uint8_t tag;
+  uint32_t version;
+  if (!ReadTag(&tag) || tag != kVersionTag || !ReadVarint(&version) ||
+      version == 0 || version > kLatestVersion) {
+    ThrowDeserializationError<Object>();
+    return false;
+  }
+  return true;
+}
+
+
+MaybeHandle<Object> ValueDeserializer::ReadValue() {
+  id_list_.Clear();
+  MaybeHandle<Object> result = ReadObject();
+  id_list_.Clear();
+  return result;
+}
+
+
+void ValueDeserializer::TransferArrayBuffer(
+    uint32_t transfer_id, Handle<JSArrayBuffer> array_buffer) {
+  ArrayBufferTransfer transfer;
+  transfer.transfer_id = transfer_id;
+  transfer.array_buffer = Handle<JSArrayBuffer>::cast(
+      isolate_->global_handles()->Create(*array_buffer));
+  array_buffer_transfers_.Add(transfer);
+}
+
+
+bool ValueDeserializer::ReadRawBytes(size_t length, const void** data) {
+  if (static_cast<size_t>(end_ - position_) < length) return false;
+  *data = position_;
+  position_ += length;
+  return true;
+}
+
+
+bool ValueDeserializer::PeekTag(uint8_t* tag) const {
+  if (position_ >= end_) return false;
+  *tag = *position_;
+  return true;
+}
+
+
+bool ValueDeserializer::ReadTag(uint8_t* tag) {
+  if (!PeekTag(tag)) return false;
+  position_++;
+  return true;
+}
+
+
+bool ValueDeserializer::ReadVarint(uint32_t* value) {
+  uint32_t result = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (position_ >= end_) return false;
+    uint8_t byte = *position_++;
+    result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool ValueDeserializer::ReadZigZag(int32_t* value) {
+  uint32_t unsigned_value;
+  if (!ReadVarint(&unsigned_value)) return false;
+  *value = static_cast<int32_t>((unsigned_value >> 1) ^
+                                (0u - (unsigned_value & 1)));
+  return true;
+}
+
+
+bool ValueDeserializer::ReadDouble(double* value) {
+  const void* bytes;
+  if (!ReadRawBytes(sizeof(*value), &bytes)) return false;
+  MemCopy(value, bytes, sizeof(*value));
+  return true;
+}
+
+
+MaybeHandle<String> ValueDeserializer::ReadString(uint8_t tag) {
+  uint32_t byte_length;
+  const void* bytes;
+  if (!ReadVarint(&byte_length) || !ReadRawBytes(byte_length, &bytes)) {
+    return ThrowDeserializationError<String>();
+  }
+  if (tag == kOneByteStringValueTag) {
+    return isolate_->factory()->NewStringFromOneByte(Vector<const uint8_t>(
+        static_cast<const uint8_t*>(bytes), static_cast<int>(byte_length)));
+  }
+  if (byte_length % sizeof(uc16) != 0) {
+    return ThrowDeserializationError<String>();
+  }
+  // The characters need not be aligned in the data, so they are copied
+  // bytewise.
+  Handle<SeqTwoByteString> string;
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate_, string,
+      isolate_->factory()->NewRawTwoByteString(
+          static_cast<int>(byte_length / sizeof(uc16))),
+      String);
+  MemCopy(string->GetChars(), bytes, byte_length);
+  return string;
+}
+
+
+MaybeHandle<Object> ValueDeserializer::ReadObject() {
+  StackLimitCheck stack_check(isolate_);
+  if (stack_check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return MaybeHandle<Object>();
+  }
+
+  Handle<Object> result;
+  if (!ReadObjectInternal().ToHandle(&result)) return MaybeHandle<Object>();
+
+  // Views follow their buffer.
+  uint8_t tag;
+  if (result->IsJSArrayBuffer() && PeekTag(&tag) &&
+      tag == kArrayBufferViewTag) {
+    ReadTag(&tag);
+    return ReadJSArrayBufferView(Handle<JSArrayBuffer>::cast(result));
+  }
+  return result;
+}
+
+
+MaybeHandle<Object> ValueDeserializer::ReadObjectInternal() {
+  Factory* factory = isolate_->factory();
+  uint8_t tag;
+  if (!ReadTag(&tag)) return ThrowDeserializationError<Object>();
+  switch (tag) {
+    case kUndefinedTag:
+      return factory->undefined_value();
+    case kNullTag:
+      return factory->null_value();
+    case kTrueTag:
+      return factory->true_value();
+    case kFalseTag:
+      return factory->false_value();
+    case kInt32Tag: {
+      int32_t value;
+      if (!ReadZigZag(&value)) return ThrowDeserializationError<Object>();
+      return factory->NewNumberFromInt(value);
+    }
+    case kDoubleTag: {
+      double value;
+      if (!ReadDouble(&value)) return ThrowDeserializationError<Object>();
+      return factory->NewNumber(value);
+    }
+    case kOneByteStringValueTag:
+    case kTwoByteStringValueTag:
+      return ReadString(tag);
+    case kObjectReferenceTag:
+      return ReadObjectReference();
+    case kBeginJSObjectTag:
+      return ReadJSObject();
+    case kBeginDenseJSArrayTag:
+      return ReadDenseJSArray();
+    case kBeginSparseJSArrayTag:
+      return ReadSparseJSArray();
+    case kDateTag: {
+      double value;
+      if (!ReadDouble(&value)) return ThrowDeserializationError<Object>();
+      Handle<Object> date;
+      ASSIGN_RETURN_ON_EXCEPTION(
+          isolate_, date, Execution::NewDate(isolate_, value), Object);
+      AddObjectWithId(Handle<JSReceiver>::cast(date));
+      return date;
+    }
+    case kBeginJSMapTag:
+      return ReadJSMap();
+    case kBeginJSSetTag:
+      return ReadJSSet();
+    case kArrayBufferTag:
+      return ReadJSArrayBuffer();
+    case kArrayBufferTransferTag:
+      return ReadTransferredJSArrayBuffer();
+    case kHostObjectTag:
+      return ReadHostObject();
+    default:
+      return ThrowDeserializationError<Object>();
+  }
+}
+
+
+MaybeHandle<JSObject> ValueDeserializer::ReadJSObject() {
+  Handle<JSObject> object =
+      isolate_->factory()->NewJSObject(isolate_->object_function());
+  AddObjectWithId(object);
+  if (!ReadJSObjectProperties(object, kEndJSObjectTag)) {
+    return MaybeHandle<JSObject>();
+  }
+  return object;
+}
+
+
+MaybeHandle<JSArray> ValueDeserializer::ReadDenseJSArray() {
+  uint32_t length;
+  // Every element takes at least one byte, which bounds the allocation.
+  if (!ReadVarint(&length) ||
+      length > static_cast<uint32_t>(end_ - position_) ||
+      length > static_cast<uint32_t>(FixedArray::kMaxLength)) {
+    return ThrowDeserializationError<JSArray>();
+  }
+  Handle<JSArray> array = isolate_->factory()->NewJSArray(
+      FAST_HOLEY_ELEMENTS, length, length,
+      INITIALIZE_ARRAY_ELEMENTS_WITH_HOLE);
+  AddObjectWithId(array);
+  Handle<FixedArray> elements(FixedArray::cast(array->elements()), isolate_);
+  for (uint32_t i = 0; i < length; i++) {
+    uint8_t tag;
+    if (PeekTag(&tag) && tag == kTheHoleTag) {
+      ReadTag(&tag);
+      continue;
+    }
+    Handle<Object> element;
+    if (!ReadObject().ToHandle(&element)) return MaybeHandle<JSArray>();
+    elements->set(i, *element);
+  }
+
+  uint32_t end_length;
+  if (!ReadJSObjectProperties(array, kEndDenseJSArrayTag)) {
+    return MaybeHandle<JSArray>();
+  }
+  if (!ReadVarint(&end_length) || end_length != length) {
+    return ThrowDeserializationError<JSArray>();
+  }
+  return array;
+}
+
+
+MaybeHandle<JSArray> ValueDeserializer::ReadSparseJSArray() {
+  uint32_t length;
+  if (!ReadVarint(&length)) return ThrowDeserializationError<JSArray>();
+  Handle<JSArray> array = isolate_->factory()->NewJSArray(FAST_ELEMENTS);
+  JSObject::NormalizeElements(array);
+  RETURN_ON_EXCEPTION(
+      isolate_,
+      JSArray::SetElementsLength(
+          array, isolate_->factory()->NewNumberFromUint(length)),
+      JSArray);
+  AddObjectWithId(array);
+
+  uint32_t end_length;
+  if (!ReadJSObjectProperties(array, kEndSparseJSArrayTag)) {
+    return MaybeHandle<JSArray>();
+  }
+  if (!ReadVarint(&end_length) || end_length != length) {
+    return ThrowDeserializationError<JSArray>();
+  }
+  return array;
+}
+
+
+MaybeHandle<JSMap> ValueDeserializer::ReadJSMap() {
+  Handle<JSMap> map = isolate_->factory()->NewJSMap();
+  AddObjectWithId(map);
+  uint32_t length = 0;
+  uint8_t tag;
+  while (PeekTag(&tag) && tag != kEndJSMapTag) {
+    Handle<Object> key;
+    Handle<Object> value;
+    if (!ReadObject().ToHandle(&key) || !ReadObject().ToHandle(&value)) {
+      return MaybeHandle<JSMap>();
+    }
+    Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()));
+    table = OrderedHashMap::Put(table, key, value);
+    map->set_table(*table);
+    length += 2;
+  }
+
+  uint32_t expected_length;
+  if (!ReadTag(&tag) || !ReadVarint(&expected_length) ||
+      expected_length != length) {
+    return ThrowDeserializationError<JSMap>();
+  }
+  return map;
+}
+
+
+MaybeHandle<JSSet> ValueDeserializer::ReadJSSet() {
+  Handle<JSSet> set = isolate_->factory()->NewJSSet();
+  AddObjectWithId(set);
+  uint32_t length = 0;
+  uint8_t tag;
+  while (PeekTag(&tag) && tag != kEndJSSetTag) {
+    Handle<Object> key;
+    if (!ReadObject().ToHandle(&key)) return MaybeHandle<JSSet>();
+    Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()));
+    table = OrderedHashSet::Add(table, key);
+    set->set_table(*table);
+    length++;
+  }
+
+  uint32_t expected_length;
+  if (!ReadTag(&tag) || !ReadVarint(&expected_length) ||
+      expected_length != length) {
+    return ThrowDeserializationError<JSSet>();
+  }
+  return set;
+}
+
+
+MaybeHandle<JSArrayBuffer> ValueDeserializer::ReadJSArrayBuffer() {
+  uint32_t byte_length;
+  const void* bytes;
+  if (!ReadVarint(&byte_length) || !ReadRawBytes(byte_length, &bytes)) {
+    return ThrowDeserializationError<JSArrayBuffer>();
+  }
+  Handle<JSArrayBuffer> array_buffer =
+      isolate_->factory()->NewJSArrayBuffer();
+  if (!Runtime::SetupArrayBufferAllocatingData(isolate_, array_buffer,
+                                               byte_length, false)) {
+    THROW_NEW_ERROR(isolate_,
+                    NewRangeError("invalid_array_buffer_length",
+                                  HandleVector<Object>(NULL, 0)),
+                    JSArrayBuffer);
+  }
+  if (byte_length > 0) {
+    MemCopy(array_buffer->backing_store(), bytes, byte_length);
+  }
+  AddObjectWithId(array_buffer);
+  return array_buffer;
+}
+
+
+MaybeHandle<JSArrayBuffer> ValueDeserializer::ReadTransferredJSArrayBuffer() {
+  uint32_t transfer_id;
+  if (!ReadVarint(&transfer_id)) {
+    return ThrowDeserializationError<JSArrayBuffer>();
+  }
+  for (int i = 0; i < array_buffer_transfers_.length(); i++) {
+    if (array_buffer_transfers_[i].transfer_id == transfer_id) {
+      Handle<JSArrayBuffer> array_buffer(
+          *array_buffer_transfers_[i].array_buffer, isolate_);
+      AddObjectWithId(array_buffer);
+      return array_buffer;
+    }
+  }
+  return ThrowDeserializationError<JSArrayBuffer>();
+}
+
+
+MaybeHandle<JSArrayBufferView> ValueDeserializer::ReadJSArrayBufferView(
+    Handle<JSArrayBuffer> array_buffer) {
+  uint8_t tag;
+  uint32_t byte_offset;
+  uint32_t length;
+  if (!ReadTag(&tag) || !ReadVarint(&byte_offset) || !ReadVarint(&length)) {
+    return ThrowDeserializationError<JSArrayBufferView>();
+  }
+
+  Handle<Context> native_context = isolate_->native_context();
+  Handle<JSFunction> constructor;
+  switch (tag) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                \
+    case k##Type##ArrayTag:                                            \
+      constructor = handle(native_context->type##_array_fun(), isolate_); \
+      break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+    case kDataViewTag:
+      constructor = handle(native_context->data_view_fun(), isolate_);
+      break;
+    default:
+      return ThrowDeserializationError<JSArrayBufferView>();
+  }
+
+  // The constructor checks that the view fits into the buffer.
+  Handle<Object> argv[] = {
+    array_buffer,
+    isolate_->factory()->NewNumberFromUint(byte_offset),
+    isolate_->factory()->NewNumberFromUint(length)
+  };
+  Handle<Object> view;
+  ASSIGN_RETURN_ON_EXCEPTION(
+      isolate_, view, Execution::New(constructor, arraysize(argv), argv),
+      JSArrayBufferView);
+  AddObjectWithId(Handle<JSReceiver>::cast(view));
+  return Handle<JSArrayBufferView>::cast(view);
+}
+
+
+MaybeHandle<JSObject> ValueDeserializer::ReadHostObject() {
+  if (delegate_ == NULL) return ThrowDeserializationError<JSObject>();
+  v8::Local<v8::Object> object =
+      delegate_->ReadHostObject(reinterpret_cast<v8::Isolate*>(isolate_));
+  if (object.IsEmpty()) {
+    // The delegate may have thrown an exception of its own.
+    if (isolate_->has_scheduled_exception()) {
+      isolate_->PromoteScheduledException();
+      return MaybeHandle<JSObject>();
+    }
+    if (isolate_->has_pending_exception()) return MaybeHandle<JSObject>();
+    return ThrowDeserializationError<JSObject>();
+  }
+  Handle<JSObject> js_object = Utils::OpenHandle(*object);
+  AddObjectWithId(js_object);
+  return js_object;
+}
+
+
+MaybeHandle<JSReceiver> ValueDeserializer::ReadObjectReference() {
+  uint32_t id;
+  if (!ReadVarint(&id) || id >= static_cast<uint32_t>(id_list_.length())) {
+    return ThrowDeserializationError<JSReceiver>();
+  }
+  return id_list_[id];
+}
+
+
+bool ValueDeserializer::ReadJSObjectProperties(Handle<JSObject> object,
+                                               uint8_t end_tag) {
+  uint32_t properties_read = 0;
+  uint8_t tag;
+  while (PeekTag(&tag) && tag != end_tag) {
+    Handle<Object> key;
+    Handle<Object> value;
+    if (!ReadObject().ToHandle(&key)) return false;
+    if (key->IsString()) {
+      key = isolate_->factory()->InternalizeString(Handle<String>::cast(key));
+    } else if (!key->IsNumber()) {
+      ThrowDeserializationError<Object>();
+      return false;
+    }
+    if (!ReadObject().ToHandle(&value)) return false;
+    if (Runtime::DefineObjectProperty(object, key, value, NONE).is_null()) {
+      return false;
+    }
+    properties_read++;
+  }
+
+  uint32_t expected_properties;
+  if (!ReadTag(&tag) || !ReadVarint(&expected_properties) ||
+      expected_properties != properties_read) {
+    ThrowDeserializationError<Object>();
+    return false;
+  }
+  return true;
+}
+
+
+template <typename T>
+MaybeHandle<T> ValueDeserializer::ThrowDeserializationError() {
+  Handle<Object> error;
+  if (isolate_->factory()
+          ->NewError("data_clone_deserialization_error",
+                     HandleVector<Object>(NULL, 0))
+          .ToHandle(&error)) {
+    isolate_->Throw(*error);
+  }
+  return MaybeHandle<T>();
+}
+
+} }  // namespace v8::internal
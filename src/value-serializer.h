@@ -0,0 +1,160 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_VALUE_SERIALIZER_H_
+#define V8_VALUE_SERIALIZER_H_
+
+#include "src/v8.h"
+
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+// An ArrayBuffer that is passed by reference instead of being copied. The
+// buffer is held by a global handle.
+struct ArrayBufferTransfer {
+  uint32_t transfer_id;
+  Handle<JSArrayBuffer> array_buffer;
+};
+
+
+// Writes values in the format that ValueDeserializer reads, walking maps,
+// descriptors and elements directly. Object identity and cycles are
+// preserved within one value. See include/v8.h for the API on top of it.
+class ValueSerializer {
+ public:
+  ValueSerializer(Isolate* isolate, v8::ValueSerializer::Delegate* delegate);
+  ~ValueSerializer();
+
+  Isolate* isolate() const { return isolate_; }
+
+  void WriteHeader();
+
+  // Returns false if an exception has been thrown.
+  MUST_USE_RESULT bool WriteValue(Handle<Object> object);
+
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  void WriteUint32(uint32_t value) { WriteVarint(value); }
+  void WriteRawBytes(const void* source, size_t length);
+
+  const uint8_t* data() const { return buffer_.begin(); }
+  size_t size() const { return static_cast<size_t>(buffer_.length()); }
+
+ private:
+  void WriteTag(uint8_t tag) { buffer_.Add(tag); }
+  void WriteVarint(uint32_t value);
+  void WriteZigZag(int32_t value);
+  void WriteDouble(double value);
+  void WriteString(Handle<String> string);
+
+  MUST_USE_RESULT bool WriteObject(Handle<Object> object);
+  MUST_USE_RESULT bool WriteJSReceiver(Handle<JSReceiver> receiver);
+  MUST_USE_RESULT bool WriteJSObject(Handle<JSObject> object);
+  MUST_USE_RESULT bool WriteJSArray(Handle<JSArray> array);
+  MUST_USE_RESULT bool WriteJSMap(Handle<JSMap> map);
+  MUST_USE_RESULT bool WriteJSSet(Handle<JSSet> set);
+  MUST_USE_RESULT bool WriteJSArrayBuffer(Handle<JSArrayBuffer> array_buffer);
+  MUST_USE_RESULT bool WriteJSArrayBufferView(Handle<JSArrayBufferView> view);
+  MUST_USE_RESULT bool WriteHostObject(Handle<JSObject> object);
+
+  // Writes the enumerable own properties of |object| as key value pairs and
+  // sets |properties_written| to their number. Elements are left out unless
+  // |include_elements| is set.
+  MUST_USE_RESULT bool WriteJSObjectProperties(Handle<JSObject> object,
+                                               bool include_elements,
+                                               uint32_t* properties_written);
+  MUST_USE_RESULT bool WriteProperty(Handle<Object> key,
+                                     Handle<Object> value);
+
+  // Writes every value of |entries| and returns false on exceptions.
+  MUST_USE_RESULT bool WriteEntries(Handle<FixedArray> entries);
+
+  // Throws the error for values that cannot be serialized.
+  bool ThrowDataCloneError(Handle<Object> object);
+
+  Isolate* isolate_;
+  v8::ValueSerializer::Delegate* delegate_;
+  List<uint8_t> buffer_;
+  List<ArrayBufferTransfer> array_buffer_transfers_;
+
+  // The objects that have been written by the current WriteValue call,
+  // mapped to their ids.
+  Handle<ObjectHashTable> id_map_;
+  uint32_t next_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueSerializer);
+};
+
+
+// Reads values written by ValueSerializer. Malformed data makes the reads
+// throw instead of crashing, so the data does not have to be trusted.
+class ValueDeserializer {
+ public:
+  ValueDeserializer(Isolate* isolate, Vector<const uint8_t> data,
+                    v8::ValueDeserializer::Delegate* delegate);
+  ~ValueDeserializer();
+
+  Isolate* isolate() const { return isolate_; }
+
+  // Return false or an empty handle if an exception has been thrown.
+  MUST_USE_RESULT bool ReadHeader();
+  MUST_USE_RESULT MaybeHandle<Object> ReadValue();
+
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  bool ReadUint32(uint32_t* value) { return ReadVarint(value); }
+  bool ReadRawBytes(size_t length, const void** data);
+
+ private:
+  bool PeekTag(uint8_t* tag) const;
+  bool ReadTag(uint8_t* tag);
+  bool ReadVarint(uint32_t* value);
+  bool ReadZigZag(int32_t* value);
+  bool ReadDouble(double* value);
+  MaybeHandle<String> ReadString(uint8_t tag);
+
+  MaybeHandle<Object> ReadObject();
+  MaybeHandle<Object> ReadObjectInternal();
+  MaybeHandle<JSObject> ReadJSObject();
+  MaybeHandle<JSArray> ReadDenseJSArray();
+  MaybeHandle<JSArray> ReadSparseJSArray();
+  MaybeHandle<JSMap> ReadJSMap();
+  MaybeHandle<JSSet> ReadJSSet();
+  MaybeHandle<JSArrayBuffer> ReadJSArrayBuffer();
+  MaybeHandle<JSArrayBuffer> ReadTransferredJSArrayBuffer();
+  MaybeHandle<JSArrayBufferView> ReadJSArrayBufferView(
+      Handle<JSArrayBuffer> array_buffer);
+  MaybeHandle<JSObject> ReadHostObject();
+  MaybeHandle<JSReceiver> ReadObjectReference();
+
+  // Reads key value pairs into |object| until |end_tag| and checks that
+  // their number is the one written after the tag.
+  bool ReadJSObjectProperties(Handle<JSObject> object, uint8_t end_tag);
+
+  void AddObjectWithId(Handle<JSReceiver> object) { id_list_.Add(object); }
+
+  // Throws the error for malformed data and returns an empty handle.
+  template <typename T>
+  MaybeHandle<T> ThrowDeserializationError();
+
+  Isolate* isolate_;
+  v8::ValueDeserializer::Delegate* delegate_;
+  const uint8_t* position_;
+  const uint8_t* end_;
+  List<ArrayBufferTransfer> array_buffer_transfers_;
+
+  // The objects that have been read by the current ReadValue call, indexed
+  // by their ids.
+  List<Handle<JSReceiver> > id_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueDeserializer);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_VALUE_SERIALIZER_H_
@@ -1251,7 +1251,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::EXCEPTION));
   __ j(equal, &exception);
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::FAILURE));
-  // If none of the above, it can only be retry.
+  // If none of the above, it can only be retry or an exceeded backtrack
+  // limit.
   // Handle that in the runtime system.
   __ j(not_equal, &runtime);
 
@@ -138,6 +138,10 @@ void FullCodeGenerator::Generate() {
 
   info->set_prologue_offset(masm_->pc_offset());
   __ Prologue(info->IsCodePreAgingActive());
+  if (FLAG_counter_based_tier_up) {
+    EmitFeedbackVectorCounterIncrement(
+        TypeFeedbackVector::kInvocationCountIndex);
+  }
   info->AddNoFrameRange(0, masm_->pc_offset());
 
   { Comment cmnt(masm_, "[ Allocate locals");
@@ -330,6 +334,15 @@ void FullCodeGenerator::EmitProfilingCounterDecrement(int delta) {
 }
 
 
+void FullCodeGenerator::EmitFeedbackVectorCounterIncrement(int index) {
+  DCHECK(FeedbackVector()->length() >= TypeFeedbackVector::kReservedIndexCount);
+  __ Move(kScratchRegister, FeedbackVector());
+  __ SmiAddConstant(
+      FieldOperand(kScratchRegister, FixedArray::OffsetOfElementAt(index)),
+      Smi::FromInt(1));
+}
+
+
 void FullCodeGenerator::EmitProfilingCounterReset() {
   int reset_value = FLAG_interrupt_budget;
   __ Move(rbx, profiling_counter_, RelocInfo::EMBEDDED_OBJECT);
@@ -350,6 +363,9 @@ void FullCodeGenerator::EmitBackEdgeBookkeeping(IterationStatement* stmt,
   int distance = masm_->SizeOfCodeGeneratedSince(back_edge_target);
   int weight = Min(kMaxBackEdgeWeight,
                    Max(1, distance / kCodeSizeMultiplier));
+  if (FLAG_counter_based_tier_up) {
+    EmitFeedbackVectorCounterIncrement(TypeFeedbackVector::kBackEdgeCountIndex);
+  }
   EmitProfilingCounterDecrement(weight);
 
   __ j(positive, &ok, Label::kNear);
@@ -3802,6 +3818,9 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ movp(rdi, result_register());
   ParameterCount count(arg_count);
   __ InvokeFunction(rdi, count, CALL_FUNCTION, NullCallWrapper());
+  // The return site of an inlined target, see
+  // HOptimizedGraphBuilder::GenerateCallFunction.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
   __ movp(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
@@ -4683,6 +4702,13 @@ void FullCodeGenerator::EmitLiteralCompareTypeof(Expression* expr,
     __ JumpIfSmi(rax, if_false);
     __ CmpObjectType(rax, SYMBOL_TYPE, rdx);
     Split(equal, if_true, if_false, fall_through);
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)   \
+  } else if (String::Equals(check, factory->type##_string())) { \
+    __ JumpIfSmi(rax, if_false);                                \
+    __ CmpObjectType(rax, TYPE##_TYPE, rdx);                    \
+    Split(equal, if_true, if_false, fall_through);
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
   } else if (String::Equals(check, factory->boolean_string())) {
     __ CompareRoot(rax, Heap::kTrueValueRootIndex);
     __ j(equal, if_true);
@@ -69,6 +69,19 @@ void LCodeGen::FinishCode(Handle<Code> code) {
   code->set_safepoint_table_offset(safepoints_.GetCodeOffset());
   if (code->is_optimized_code()) RegisterWeakObjectsInOptimizedCode(code);
   PopulateDeoptimizationData(code);
+  if (!catch_entries_.is_empty()) PopulateHandlerTable(code);
+}
+
+
+void LCodeGen::PopulateHandlerTable(Handle<Code> code) {
+  Handle<FixedArray> handler_table =
+      factory()->NewFixedArray(info()->function()->handler_count(), TENURED);
+  for (int i = 0; i < catch_entries_.length(); i++) {
+    LDeferredCode* catch_entry = catch_entries_[i];
+    int index = LEnterTry::cast(catch_entry->instr())->hydrogen()->index();
+    handler_table->set(index, Smi::FromInt(catch_entry->entry()->pos()));
+  }
+  code->set_handler_table(*handler_table);
 }
 
 
@@ -613,6 +626,15 @@ void LCodeGen::AddToTranslation(LEnvironment* environment,
     HConstant* constant = chunk()->LookupConstant(LConstantOperand::cast(op));
     int src_index = DefineDeoptimizationLiteral(constant->handle(isolate()));
     translation->StoreLiteral(src_index);
+  } else if (op->IsTrySlot()) {
+    // The words pushed by a try block follow the spill slots.
+    LTrySlot* slot = LTrySlot::cast(op);
+    int index = GetStackSlotCount() + slot->stack_index();
+    if (slot->is_handler_word()) {
+      translation->StoreTryHandlerSlot(slot->handler_offset(), index);
+    } else {
+      translation->StoreStackSlot(index);
+    }
   } else {
     UNREACHABLE();
   }
@@ -2210,6 +2232,16 @@ void LCodeGen::DoBranch(LBranch* instr) {
         __ j(equal, instr->TrueLabel(chunk_));
       }
 
+      if (expected.Contains(ToBooleanStub::SIMD_VALUE)) {
+        // SIMD value -> true.
+        Label not_simd;
+        __ CmpInstanceType(map, FIRST_SIMD128_VALUE_TYPE);
+        __ j(below, &not_simd, Label::kNear);
+        __ CmpInstanceType(map, LAST_SIMD128_VALUE_TYPE);
+        __ j(below_equal, instr->TrueLabel(chunk_));
+        __ bind(&not_simd);
+      }
+
       if (expected.Contains(ToBooleanStub::HEAP_NUMBER)) {
         // heap number -> false iff +0, -0, or NaN.
         Label not_heap_number;
@@ -3575,6 +3607,48 @@ void LCodeGen::DoCallWithDescriptor(LCallWithDescriptor* instr) {
 }
 
 
+void LCodeGen::DoCallFastApiFunction(LCallFastApiFunction* instr) {
+  HCallFastApiFunction* hinstr = instr->hydrogen();
+  int parameter_count = instr->InputCount();
+  __ PrepareCallCFunction(parameter_count);
+  // The double parameters were allocated one register above the one the
+  // calling convention expects, see LChunkBuilder::DoCallFastApiFunction.
+  for (int i = 0; i < parameter_count; i++) {
+    if (instr->InputAt(i)->IsDoubleRegister()) {
+      XMMRegister input = ToDoubleRegister(instr->InputAt(i));
+      __ movaps(XMMRegister::from_code(input.code() - 1), input);
+    }
+  }
+  ApiFunction function(hinstr->function());
+  __ CallCFunction(ExternalReference(&function, ExternalReference::BUILTIN_CALL,
+                                     isolate()),
+                   parameter_count);
+  switch (hinstr->return_type()) {
+    case v8::kFastCallVoid:
+      __ LoadRoot(rax, Heap::kUndefinedValueRootIndex);
+      break;
+    case v8::kFastCallInt32:
+      __ movsxlq(rax, rax);
+      break;
+    case v8::kFastCallDouble:
+      __ movaps(ToDoubleRegister(instr->result()), xmm0);
+      break;
+    case v8::kFastCallBool: {
+      // Only the low byte of a bool return value is defined.
+      Label done;
+      __ testb(rax, rax);
+      __ LoadRoot(rax, Heap::kTrueValueRootIndex);
+      __ j(not_zero, &done, Label::kNear);
+      __ LoadRoot(rax, Heap::kFalseValueRootIndex);
+      __ bind(&done);
+      break;
+    }
+    case v8::kFastCallHolder:
+      UNREACHABLE();
+  }
+}
+
+
 void LCodeGen::DoCallJSFunction(LCallJSFunction* instr) {
   DCHECK(ToRegister(instr->function()).is(rdi));
   DCHECK(ToRegister(instr->result()).is(rax));
@@ -4026,12 +4100,10 @@ void LCodeGen::DoCallNewArray(LCallNewArray* instr) {
   DCHECK(ToRegister(instr->result()).is(rax));
 
   __ Set(rax, instr->arity());
-  __ LoadRoot(rbx, Heap::kUndefinedValueRootIndex);
+  __ Move(rbx, instr->hydrogen()->site());
   ElementsKind kind = instr->hydrogen()->elements_kind();
   AllocationSiteOverrideMode override_mode =
-      (AllocationSite::GetMode(kind) == TRACK_ALLOCATION_SITE)
-          ? DISABLE_ALLOCATION_SITES
-          : DONT_OVERRIDE;
+      instr->hydrogen()->override_mode();
 
   if (instr->arity() == 0) {
     ArrayNoArgumentConstructorStub stub(isolate(), kind, override_mode);
@@ -5542,6 +5614,14 @@ Condition LCodeGen::EmitTypeofIs(LTypeofIsAndBranch* instr, Register input) {
     __ CmpObjectType(input, SYMBOL_TYPE, input);
     final_branch_condition = equal;
 
+#define SIMD128_TYPE(TYPE, Type, type, lane_count, lane_type)       \
+  } else if (String::Equals(type_name, factory->type##_string())) { \
+    __ JumpIfSmi(input, false_label, false_distance);               \
+    __ CmpObjectType(input, TYPE##_TYPE, input);                    \
+    final_branch_condition = equal;
+  SIMD128_TYPES(SIMD128_TYPE)
+#undef SIMD128_TYPE
+
   } else if (String::Equals(type_name, factory->boolean_string())) {
     __ CompareRoot(input, Heap::kTrueValueRootIndex);
     __ j(equal, true_label, true_distance);
@@ -5873,6 +5953,49 @@ void LCodeGen::DoStoreFrameContext(LStoreFrameContext* instr) {
 }
 
 
+void LCodeGen::DoEnterTry(LEnterTry* instr) {
+  class DeferredCatch FINAL : public LDeferredCode {
+   public:
+    DeferredCatch(LCodeGen* codegen, LEnterTry* instr)
+        : LDeferredCode(codegen), instr_(instr) { }
+    virtual void Generate() OVERRIDE {
+      codegen()->DoDeferredCatch(instr_);
+    }
+    virtual LInstruction* instr() OVERRIDE { return instr_; }
+   private:
+    LEnterTry* instr_;
+  };
+
+  DCHECK(ToRegister(instr->context()).is(rsi));
+  DeferredCatch* deferred = new(zone()) DeferredCatch(this, instr);
+  catch_entries_.Add(deferred, zone());
+  __ PushTryHandler(StackHandler::CATCH, instr->hydrogen()->index());
+}
+
+
+void LCodeGen::DoDeferredCatch(LEnterTry* instr) {
+  // The handler has been unlinked and the exception is in rax. The catch block
+  // only exists in the unoptimized code, deoptimize to its entry.
+  LEnvironment* environment = instr->environment();
+  environment->ReplaceValueAt(
+      environment->translation_size() - 1,
+      LRegister::Create(Register::ToAllocationIndex(rax), zone()));
+  DeoptimizeIf(no_condition, instr, "exception");
+}
+
+
+void LCodeGen::DoLeaveTry(LLeaveTry* instr) {
+  __ PopTryHandler();
+  __ Drop(instr->hydrogen()->entry()->catch_slot_count());
+}
+
+
+void LCodeGen::DoStoreCatchSlot(LStoreCatchSlot* instr) {
+  int index = GetStackSlotCount() + instr->hydrogen()->stack_index();
+  __ movp(Operand(rbp, StackSlotOffset(index)), ToRegister(instr->value()));
+}
+
+
 void LCodeGen::DoAllocateBlockContext(LAllocateBlockContext* instr) {
   Handle<ScopeInfo> scope_info = instr->scope_info();
   __ Push(scope_info);
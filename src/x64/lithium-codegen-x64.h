@@ -33,6 +33,7 @@ class LCodeGen: public LCodeGenBase {
         scope_(info->scope()),
         translations_(info->zone()),
         deferred_(8, info->zone()),
+        catch_entries_(0, info->zone()),
         osr_pc_offset_(-1),
         frame_is_built_(false),
         safepoints_(info->zone()),
@@ -104,6 +105,7 @@ class LCodeGen: public LCodeGenBase {
   void DoDeferredLoadMutableDouble(LLoadFieldByIndex* instr,
                                    Register object,
                                    Register index);
+  void DoDeferredCatch(LEnterTry* instr);
 
 // Parallel move support.
   void DoParallelMove(LParallelMove* move);
@@ -222,6 +224,7 @@ class LCodeGen: public LCodeGenBase {
                         int* object_index_pointer,
                         int* dematerialized_index_pointer);
   void PopulateDeoptimizationData(Handle<Code> code);
+  void PopulateHandlerTable(Handle<Code> code);
   int DefineDeoptimizationLiteral(Handle<Object> literal);
 
   void PopulateDeoptimizationLiteralsWithInlinedFunctions();
@@ -327,6 +330,9 @@ class LCodeGen: public LCodeGenBase {
   Scope* const scope_;
   TranslationBuffer translations_;
   ZoneList<LDeferredCode*> deferred_;
+  // The deferred code of the LEnterTry instructions, which is registered as
+  // the handler entry of their try blocks.
+  ZoneList<LDeferredCode*> catch_entries_;
   int osr_pc_offset_;
   bool frame_is_built_;
 
@@ -1111,6 +1111,41 @@ LInstruction* LChunkBuilder::DoCallWithDescriptor(
 }
 
 
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  static const Register kIntegerRegisters[] = {arg_reg_1, arg_reg_2,
+                                               arg_reg_3, arg_reg_4};
+  ZoneList<LOperand*> ops(instr->OperandCount(), zone());
+  int integer_count = 0;
+  int double_count = 0;
+  for (int i = 0; i < instr->OperandCount(); i++) {
+    HValue* value = instr->OperandAt(i);
+    bool is_double = instr->RequiredInputRepresentation(i).IsDouble();
+#ifdef _WIN64
+    // Parameters take the register of their position.
+    int index = i;
+#else
+    int index = is_double ? double_count : integer_count;
+#endif
+    if (is_double) {
+      // xmm0 is not allocatable, the code generator moves every double
+      // parameter one register down before the call.
+      ops.Add(UseFixedDouble(value, XMMRegister::from_code(index + 1)),
+              zone());
+      double_count++;
+    } else {
+      ops.Add(UseFixed(value, kIntegerRegisters[index]), zone());
+      integer_count++;
+    }
+  }
+  LCallFastApiFunction* result = new(zone()) LCallFastApiFunction(ops, zone());
+  if (instr->representation().IsDouble()) {
+    return MarkAsCall(DefineFixedDouble(result, xmm1), instr);
+  }
+  return MarkAsCall(DefineFixed(result, rax), instr);
+}
+
+
 LInstruction* LChunkBuilder::DoTailCallThroughMegamorphicCache(
     HTailCallThroughMegamorphicCache* instr) {
   LOperand* context = UseFixed(instr->context(), rsi);
@@ -2599,6 +2634,32 @@ LInstruction* LChunkBuilder::DoStackCheck(HStackCheck* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  DCHECK_EQ(instr->handler_stack_index(), argument_count_);
+  LOperand* context = UseFixed(instr->context(), rsi);
+  LInstruction* result = AssignEnvironment(new(zone()) LEnterTry(context));
+  // The catch block takes the values of its environment from the catch slots,
+  // the registers are lost when the handler is entered.
+  LEnvironment* environment = result->environment();
+  for (int i = 0; i < instr->catch_slot_count(); i++) {
+    environment->ReplaceValueAt(
+        instr->catch_slot_env_index(i),
+        LTrySlot::CatchSlot(instr->stack_index() + i, zone()));
+  }
+  return result;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  return new(zone()) LLeaveTry;
+}
+
+
+LInstruction* LChunkBuilder::DoStoreCatchSlot(HStoreCatchSlot* instr) {
+  return new(zone()) LStoreCatchSlot(UseRegisterAtStart(instr->value()));
+}
+
+
 LInstruction* LChunkBuilder::DoEnterInlined(HEnterInlined* instr) {
   HEnvironment* outer = current_block_->last_environment();
   outer->set_ast_id(instr->ReturnId());
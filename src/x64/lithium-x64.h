@@ -30,6 +30,7 @@ class LCodeGen;
   V(BitI)                                    \
   V(BoundsCheck)                             \
   V(Branch)                                  \
+  V(CallFastApiFunction)                     \
   V(CallJSFunction)                          \
   V(CallWithDescriptor)                      \
   V(CallFunction)                            \
@@ -73,6 +74,7 @@ class LCodeGen;
   V(Drop)                                    \
   V(DummyUse)                                \
   V(Dummy)                                   \
+  V(EnterTry)                                \
   V(FlooringDivByConstI)                     \
   V(FlooringDivByPowerOf2I)                  \
   V(FlooringDivI)                            \
@@ -96,6 +98,7 @@ class LCodeGen;
   V(IsUndetectableAndBranch)                 \
   V(Label)                                   \
   V(LazyBailout)                             \
+  V(LeaveTry)                                \
   V(LoadContextSlot)                         \
   V(LoadRoot)                                \
   V(LoadFieldByIndex)                        \
@@ -137,6 +140,7 @@ class LCodeGen;
   V(SmiTag)                                  \
   V(SmiUntag)                                \
   V(StackCheck)                              \
+  V(StoreCatchSlot)                          \
   V(StoreCodeEntry)                          \
   V(StoreContextSlot)                        \
   V(StoreFrameContext)                       \
@@ -1928,6 +1932,27 @@ class LCallWithDescriptor FINAL : public LTemplateResultInstruction<1> {
 };
 
 
+class LCallFastApiFunction FINAL : public LTemplateResultInstruction<1> {
+ public:
+  LCallFastApiFunction(const ZoneList<LOperand*>& operands, Zone* zone)
+      : inputs_(operands.length(), zone) {
+    inputs_.AddAll(operands, zone);
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(CallFastApiFunction, "call-fast-api-function")
+  DECLARE_HYDROGEN_ACCESSOR(CallFastApiFunction)
+
+  virtual int InputCount() FINAL OVERRIDE { return inputs_.length(); }
+  virtual LOperand* InputAt(int i) FINAL OVERRIDE { return inputs_[i]; }
+
+  virtual int TempCount() FINAL OVERRIDE { return 0; }
+  virtual LOperand* TempAt(int i) FINAL OVERRIDE { return NULL; }
+
+ private:
+  ZoneList<LOperand*> inputs_;
+};
+
+
 class LInvokeFunction FINAL : public LTemplateInstruction<1, 2, 0> {
  public:
   LInvokeFunction(LOperand* context, LOperand* function) {
@@ -2710,6 +2735,39 @@ class LStoreFrameContext: public LTemplateInstruction<0, 1, 0> {
 };
 
 
+class LEnterTry FINAL : public LTemplateInstruction<0, 1, 0> {
+ public:
+  explicit LEnterTry(LOperand* context) {
+    inputs_[0] = context;
+  }
+
+  LOperand* context() { return inputs_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry, "enter-try")
+  DECLARE_HYDROGEN_ACCESSOR(EnterTry)
+};
+
+
+class LLeaveTry FINAL : public LTemplateInstruction<0, 0, 0> {
+ public:
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry, "leave-try")
+  DECLARE_HYDROGEN_ACCESSOR(LeaveTry)
+};
+
+
+class LStoreCatchSlot FINAL : public LTemplateInstruction<0, 1, 0> {
+ public:
+  explicit LStoreCatchSlot(LOperand* value) {
+    inputs_[0] = value;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreCatchSlot, "store-catch-slot")
+  DECLARE_HYDROGEN_ACCESSOR(StoreCatchSlot)
+};
+
+
 class LAllocateBlockContext: public LTemplateInstruction<1, 2, 0> {
  public:
   LAllocateBlockContext(LOperand* context, LOperand* function) {
@@ -68,6 +68,7 @@ namespace internal {
  *    - success counter      (only useful for global regexp to count matches)
  *    - Offset of location before start of input (effectively character
  *      position -1).  Used to initialize capture registers to a non-position.
+ *    - backtrack counter    (compared against --regexp-backtrack-limit)
  *    - At start of string (if 1, we are starting at the start of the
  *      string, otherwise 0)
  *    - register 0  rbp[-n]   (Only positions must be stored in the first
@@ -124,6 +125,7 @@ RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -150,6 +152,12 @@ void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX64::Backtrack() {
   CheckPreemption();
+  if (FLAG_regexp_backtrack_limit > 0) {
+    __ incp(Operand(rbp, kBacktrackCount));
+    __ cmpp(Operand(rbp, kBacktrackCount),
+            Immediate(FLAG_regexp_backtrack_limit));
+    __ j(above, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(rbx);
   __ addp(rbx, code_object_pointer());
@@ -687,6 +695,7 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
 
   __ Push(Immediate(0));  // Number of successful matches in a global regexp.
   __ Push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ Push(Immediate(0));  // Number of backtracks so far.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -971,6 +980,12 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
     __ jmp(&return_rax);
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ Set(rax, BACKTRACK_LIMIT_EXCEEDED);
+    __ jmp(&return_rax);
+  }
+
   FixupCodeRelativePositions();
 
   CodeDesc code_desc;
@@ -44,6 +44,80 @@ class Segment {
 };
 
 
+ZoneSegmentPool::ZoneSegmentPool(size_t max_pooled_bytes)
+    : pooled_bytes_(0), max_pooled_bytes_(max_pooled_bytes) {
+  for (int i = 0; i < kNumberOfSizeClasses; i++) free_lists_[i] = NULL;
+}
+
+
+ZoneSegmentPool::~ZoneSegmentPool() { ReleaseAll(); }
+
+
+int ZoneSegmentPool::SizeClassIndex(int size) {
+  if (size < (1 << kMinimumSizeClassLog2) ||
+      size > (1 << kMaximumSizeClassLog2) ||
+      !base::bits::IsPowerOfTwo32(static_cast<uint32_t>(size))) {
+    return -1;
+  }
+  return WhichPowerOf2(static_cast<uint32_t>(size)) - kMinimumSizeClassLog2;
+}
+
+
+size_t ZoneSegmentPool::RoundUpToSizeClass(size_t size) {
+  if (size > static_cast<size_t>(1 << kMaximumSizeClassLog2)) return size;
+  return base::bits::RoundUpToPowerOfTwo32(static_cast<uint32_t>(size));
+}
+
+
+Segment* ZoneSegmentPool::Get(int size) {
+  int index = SizeClassIndex(size);
+  if (index < 0) return NULL;
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  Segment* result = free_lists_[index];
+  if (result != NULL) {
+    free_lists_[index] = result->next();
+    pooled_bytes_ -= size;
+  }
+  return result;
+}
+
+
+bool ZoneSegmentPool::Put(Segment* segment, int size) {
+  if (!enabled()) return false;
+  int index = SizeClassIndex(size);
+  if (index < 0) return false;
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (pooled_bytes_ + size > max_pooled_bytes_) return false;
+  // The previous owner may have left red zones behind.
+  ASAN_UNPOISON_MEMORY_REGION(segment, size);
+  segment->Initialize(free_lists_[index], size);
+  free_lists_[index] = segment;
+  pooled_bytes_ += size;
+  return true;
+}
+
+
+void ZoneSegmentPool::ReleaseAll() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    Segment* current = free_lists_[i];
+    while (current != NULL) {
+      Segment* next = current->next();
+      Malloced::Delete(current);
+      current = next;
+    }
+    free_lists_[i] = NULL;
+  }
+  pooled_bytes_ = 0;
+}
+
+
+size_t ZoneSegmentPool::pooled_bytes() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  return pooled_bytes_;
+}
+
+
 Zone::Zone(Isolate* isolate)
     : allocation_size_(0),
       segment_bytes_allocated_(0),
@@ -181,7 +255,10 @@ void Zone::DeleteKeptSegment() {
 // Creates a new segment, sets it size, and pushes it to the front
 // of the segment chain. Returns the new segment.
 Segment* Zone::NewSegment(int size) {
-  Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
+  Segment* result = isolate_->zone_segment_pool()->Get(size);
+  if (result == NULL) {
+    result = reinterpret_cast<Segment*>(Malloced::New(size));
+  }
   adjust_segment_bytes_allocated(size);
   if (result != NULL) {
     result->Initialize(segment_head_, size);
@@ -194,7 +271,9 @@ Segment* Zone::NewSegment(int size) {
 // Deletes the given segment. Does not touch the segment chain.
 void Zone::DeleteSegment(Segment* segment, int size) {
   adjust_segment_bytes_allocated(-size);
-  Malloced::Delete(segment);
+  if (!isolate_->zone_segment_pool()->Put(segment, size)) {
+    Malloced::Delete(segment);
+  }
 }
 
 
@@ -229,6 +308,14 @@ Address Zone::NewExpand(int size) {
     // requested size.
     new_size = Max(min_new_size, static_cast<size_t>(kMaximumSegmentSize));
   }
+  STATIC_ASSERT((1 << ZoneSegmentPool::kMinimumSizeClassLog2) ==
+                kMinimumSegmentSize);
+  STATIC_ASSERT((1 << ZoneSegmentPool::kMaximumSizeClassLog2) ==
+                kMaximumSegmentSize);
+  if (isolate_->zone_segment_pool()->enabled()) {
+    // Pooled segments are only handed out for requests of their exact size.
+    new_size = ZoneSegmentPool::RoundUpToSizeClass(new_size);
+  }
   if (new_size > INT_MAX) {
     V8::FatalProcessOutOfMemory("Zone");
     return NULL;
@@ -9,6 +9,7 @@
 
 #include "src/allocation.h"
 #include "src/base/logging.h"
+#include "src/base/platform/mutex.h"
 #include "src/globals.h"
 #include "src/hashmap.h"
 #include "src/list.h"
@@ -21,6 +22,58 @@ namespace internal {
 class Segment;
 class Isolate;
 
+// A per-isolate cache of zone segments. Zones take segments from the pool
+// and return them there instead of going through malloc() and free(), which
+// matters when many compilations (possibly on several threads) create and
+// destroy large zones in quick succession. Segments are kept in power-of-two
+// size classes, and at most max_pooled_bytes of them are retained. A pool
+// with a limit of zero is disabled. Thread-safe.
+class ZoneSegmentPool {
+ public:
+  explicit ZoneSegmentPool(size_t max_pooled_bytes);
+  ~ZoneSegmentPool();
+
+  bool enabled() const { return max_pooled_bytes_ > 0; }
+
+  // Should only be called before any zone of the isolate is used.
+  void set_max_pooled_bytes(size_t bytes) { max_pooled_bytes_ = bytes; }
+
+  // Returns a pooled segment of exactly {size} bytes, or NULL.
+  Segment* Get(int size);
+
+  // Keeps the segment for reuse. Returns false if the segment cannot be
+  // pooled, in which case the caller has to free it.
+  bool Put(Segment* segment, int size);
+
+  // Frees all pooled segments.
+  void ReleaseAll();
+
+  size_t pooled_bytes();
+
+  // Returns the size of segments that requests for {size} bytes should be
+  // rounded up to so that their segments can be pooled.
+  static size_t RoundUpToSizeClass(size_t size);
+
+  // The size classes cover the range of regular segment sizes of a Zone.
+  static const int kMinimumSizeClassLog2 = 13;  // 8 KB.
+  static const int kMaximumSizeClassLog2 = 20;  // 1 MB.
+
+ private:
+  static const int kNumberOfSizeClasses =
+      kMaximumSizeClassLog2 - kMinimumSizeClassLog2 + 1;
+
+  // Returns -1 if segments of {size} bytes are not pooled.
+  static int SizeClassIndex(int size);
+
+  base::Mutex mutex_;
+  Segment* free_lists_[kNumberOfSizeClasses];
+  size_t pooled_bytes_;
+  size_t max_pooled_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ZoneSegmentPool);
+};
+
+
 // The Zone supports very fast allocation of small chunks of
 // memory. The chunks cannot be deallocated individually, but instead
 // the Zone supports deallocating all chunks in one fast
@@ -56,6 +56,7 @@
         'compiler/test-basic-block-profiler.cc',
         'compiler/test-branch-combine.cc',
         'compiler/test-changes-lowering.cc',
+        'compiler/test-code-stub-assembler.cc',
         'compiler/test-codegen-deopt.cc',
         'compiler/test-gap-resolver.cc',
         'compiler/test-graph-reducer.cc',
@@ -71,6 +72,7 @@
         'compiler/test-operator.cc',
         'compiler/test-phi-reducer.cc',
         'compiler/test-pipeline.cc',
+        'compiler/test-register-allocator.cc',
         'compiler/test-representation-change.cc',
         'compiler/test-run-deopt.cc',
         'compiler/test-run-inlining.cc',
@@ -80,6 +82,7 @@
         'compiler/test-run-jsexceptions.cc',
         'compiler/test-run-jsops.cc',
         'compiler/test-run-machops.cc',
+        'compiler/test-run-osr.cc',
         'compiler/test-run-properties.cc',
         'compiler/test-run-stackcheck.cc',
         'compiler/test-run-variables.cc',
@@ -95,6 +98,8 @@
         'test-accessors.cc',
         'test-alloc.cc',
         'test-api.cc',
+        'test-array-buffer-allocator.cc',
+        'test-asm-validator.cc',
         'test-ast.cc',
         'test-atomicops.cc',
         'test-bignum.cc',
@@ -104,6 +109,7 @@
         'test-compiler.cc',
         'test-constantpool.cc',
         'test-conversions.cc',
+        'test-counters.cc',
         'test-cpu-profiler.cc',
         'test-dataflow.cc',
         'test-date.cc',
@@ -141,10 +147,10 @@
         'test-profile-generator.cc',
         'test-random-number-generator.cc',
         'test-regexp.cc',
-        'test-reloc-info.cc',
         'test-representation.cc',
         'test-sampler-api.cc',
         'test-serialize.cc',
+        'test-source-position-table.cc',
         'test-spaces.cc',
         'test-strings.cc',
         'test-symbols.cc',
@@ -156,6 +162,7 @@
         'test-unique.cc',
         'test-unscopables-hidden-prototype.cc',
         'test-utils.cc',
+        'test-value-serializer.cc',
         'test-version.cc',
         'test-weakmaps.cc',
         'test-weaksets.cc',
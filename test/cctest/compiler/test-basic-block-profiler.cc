@@ -4,10 +4,12 @@
 
 #include "src/v8.h"
 
+#include "src/api.h"
 #include "src/basic-block-profiler.h"
 #include "src/compiler/generic-node-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/codegen-tester.h"
+#include "test/cctest/compiler/function-tester.h"
 
 #if V8_TURBOFAN_TARGET
 
@@ -112,4 +114,35 @@ TEST(ProfileLoop) {
   }
 }
 
+
+TEST(ProfileJSFunction) {
+  FLAG_turbo_profiling = true;
+  FunctionTester T("(function(a, b) { return a ? b : 0; })");
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::Local<v8::Function> function = v8::Utils::ToLocal(T.function);
+
+  uint32_t counts[16];
+  size_t n_blocks = isolate->GetBasicBlockCounts(function, counts, 16);
+  CHECK_NE(0, static_cast<int>(n_blocks));
+  CHECK(n_blocks <= 16);
+  CHECK_EQ(0, static_cast<int>(counts[0]));
+
+  for (int i = 0; i < 3; i++) {
+    T.CheckCall(T.Val(7), T.true_value(), T.Val(7));
+  }
+  size_t n_blocks_after_calls =
+      isolate->GetBasicBlockCounts(function, counts, 16);
+  CHECK_EQ(static_cast<int>(n_blocks), static_cast<int>(n_blocks_after_calls));
+  CHECK_EQ(3, static_cast<int>(counts[0]));
+
+  // Only the counts of this function are reset.
+  BasicBlockProfiler::Data* other =
+      CcTest::i_isolate()->GetOrCreateBasicBlockProfiler()->NewData(1);
+  *other->GetCounterAddress(0) = 5;
+  isolate->ResetBasicBlockCounts(function);
+  isolate->GetBasicBlockCounts(function, counts, 16);
+  CHECK_EQ(0, static_cast<int>(counts[0]));
+  CHECK_EQ(5, static_cast<int>(other->counts()[0]));
+}
+
 #endif  // V8_TURBOFAN_TARGET
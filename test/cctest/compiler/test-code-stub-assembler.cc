@@ -0,0 +1,66 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/compiler/code-stub-assembler.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/compiler/codegen-tester.h"
+
+using namespace v8::internal;
+using namespace v8::internal::compiler;
+
+#if V8_TURBOFAN_TARGET
+
+// Builds a stub with the ToNumber calling convention that returns Smis
+// incremented by one and the instance type of any other object as a Smi.
+static Handle<Code> BuildTestStub(Isolate* isolate, Zone* zone) {
+  ToNumberDescriptor descriptor(isolate);
+  Graph graph(zone);
+  CodeStubAssembler m(&graph, descriptor);
+  Node* value = m.Parameter(0);
+  RawMachineAssembler::Label if_smi, if_heap_object;
+  m.Branch(m.WordIsSmi(value), &if_smi, &if_heap_object);
+  m.Bind(&if_smi);
+  m.Return(m.SmiTag(m.Int32Add(m.SmiUntag(value), m.Int32Constant(1))));
+  m.Bind(&if_heap_object);
+  m.Return(m.SmiTag(m.LoadInstanceType(value)));
+  CompilationInfo info(isolate, zone);
+  return m.GenerateCode(&info);
+}
+
+
+static Object* CallTestStub(Handle<Code> code, Handle<Object> value) {
+  Isolate* isolate = code->GetIsolate();
+  ToNumberDescriptor descriptor(isolate);
+  RawMachineAssemblerTester<Object*> m;
+  CallDescriptor* desc = Linkage::GetStubCallDescriptor(
+      descriptor, 0, CallDescriptor::kNoFlags, m.zone());
+  Handle<Context> context(isolate->native_context());
+  m.Return(m.NewNode(m.common()->Call(desc), m.HeapConstant(code),
+                     m.HeapConstant(value), m.HeapConstant(context)));
+  return m.Call();
+}
+
+
+TEST(CodeStubAssemblerSmiAndHeapObject) {
+  HandleAndZoneScope scope;
+  Isolate* isolate = scope.main_isolate();
+  Handle<Code> code = BuildTestStub(isolate, scope.main_zone());
+  CHECK(!code.is_null());
+  CHECK_EQ(Code::STUB, code->kind());
+  CHECK(code->is_turbofanned());
+
+  Factory* factory = isolate->factory();
+  CHECK_EQ(Smi::FromInt(43),
+           CallTestStub(code, handle(Smi::FromInt(42), isolate)));
+  CHECK_EQ(Smi::FromInt(-6),
+           CallTestStub(code, handle(Smi::FromInt(-7), isolate)));
+  CHECK_EQ(Smi::FromInt(HEAP_NUMBER_TYPE),
+           CallTestStub(code, factory->NewHeapNumber(1.5)));
+  CHECK_EQ(Smi::FromInt(ODDBALL_TYPE),
+           CallTestStub(code, factory->undefined_value()));
+}
+
+#endif  // V8_TURBOFAN_TARGET
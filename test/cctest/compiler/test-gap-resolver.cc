@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/compiler/gap-resolver.h"
+#include "src/compiler/move-optimizer.h"
 
 #include "src/base/utils/random-number-generator.h"
 #include "test/cctest/cctest.h"
@@ -172,3 +173,27 @@ TEST(FuzzResolver) {
     }
   }
 }
+
+
+TEST(FuzzCompressMoves) {
+  ParallelMoveCreator pmc;
+  for (int size = 0; size < 20; ++size) {
+    for (int repeat = 0; repeat < 50; ++repeat) {
+      ParallelMove* left = pmc.Create(size);
+      ParallelMove* right = pmc.Create(size);
+
+      MoveInterpreter mi1;
+      mi1.AssembleParallelMove(left);
+      mi1.AssembleParallelMove(right);
+
+      MoveOptimizer::CompressMoves(pmc.main_zone(), left, right);
+      CHECK(left->move_operands()->is_empty());
+
+      MoveInterpreter mi2;
+      GapResolver resolver(&mi2);
+      resolver.Resolve(right);
+
+      CHECK(mi1.state() == mi2.state());
+    }
+  }
+}
@@ -0,0 +1,65 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+
+#include "src/v8.h"
+
+#include "src/base/platform/elapsed-timer.h"
+#include "test/cctest/compiler/function-tester.h"
+
+using namespace v8::internal;
+using namespace v8::internal::compiler;
+
+#if V8_TURBOFAN_TARGET
+
+// Builds a function that keeps more values alive across a loop with many
+// branches than there are registers, so that live ranges get split and
+// spilled a lot.
+static std::string LargeFunctionSource(int values) {
+  std::ostringstream os;
+  os << "(function(a, b) {\n";
+  for (int i = 0; i < values; i++) {
+    os << "  var v" << i << " = a + " << i << ";\n";
+  }
+  os << "  for (var i = 0; i < b; i++) {\n";
+  for (int i = 0; i < values; i++) {
+    os << "    if (i & " << (1 << (i % 8)) << ") v" << i << " = v" << i
+       << " + v" << ((i + 1) % values) << "; else v" << i << " = v" << i
+       << " - 1;\n";
+  }
+  os << "  }\n  return 0";
+  for (int i = 0; i < values; i++) os << " + v" << i;
+  os << ";\n})";
+  return os.str();
+}
+
+
+TEST(RegisterAllocatorLiveRangeArrays) {
+  static const int kValues = 80;
+  std::string source = LargeFunctionSource(kValues);
+  Handle<Code> codes[2];
+  double results[2];
+  for (int i = 0; i < 2; i++) {
+    FLAG_turbo_live_range_arrays = (i == 1);
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    FunctionTester T(source.c_str());
+    double ms = timer.Elapsed().InMillisecondsF();
+    codes[i] = handle(T.function->code());
+    results[i] = T.Call(T.Val(1), T.Val(10)).ToHandleChecked()->Number();
+    PrintF("live range arrays %s: compiled in %.3f ms, %d spill slots\n",
+           i == 1 ? "on" : "off", ms,
+           static_cast<int>(codes[i]->stack_slots()));
+  }
+  FLAG_turbo_live_range_arrays = false;
+
+  // Both modes must make the same allocation decisions.
+  CHECK_EQ(static_cast<int>(codes[0]->stack_slots()),
+           static_cast<int>(codes[1]->stack_slots()));
+  CHECK_EQ(codes[0]->instruction_size(), codes[1]->instruction_size());
+  CHECK_EQ(results[0], results[1]);
+}
+
+#endif  // V8_TURBOFAN_TARGET
@@ -127,6 +127,28 @@ TEST(RunBranch) {
 }
 
 
+TEST(RunBranchThroughEmptyBlocks) {
+  RawMachineAssemblerTester<int32_t> m(kMachInt32);
+  int constant = 987654;
+
+  MLabel blocka, blockb, blockc, blockd, end;
+  m.Branch(m.Parameter(0), &blocka, &blockb);
+  m.Bind(&blocka);
+  m.Goto(&blockc);
+  m.Bind(&blockb);
+  m.Goto(&blockd);
+  m.Bind(&blockc);
+  m.Goto(&end);
+  m.Bind(&blockd);
+  m.Return(m.Int32Constant(constant));
+  m.Bind(&end);
+  m.Return(m.Int32Constant(0 - constant));
+
+  CHECK_EQ(0 - constant, m.Call(1));
+  CHECK_EQ(constant, m.Call(0));
+}
+
+
 TEST(RunRedundantBranch1) {
   RawMachineAssemblerTester<int32_t> m;
   int constant = 944777;
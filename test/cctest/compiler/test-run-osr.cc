@@ -0,0 +1,91 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/frames-inl.h"
+#include "test/cctest/cctest.h"
+
+using namespace v8;
+using namespace v8::internal;
+
+#if V8_TURBOFAN_TARGET && V8_TARGET_ARCH_X64
+
+static void IsTurboFanned(const FunctionCallbackInfo<v8::Value>& args) {
+  JavaScriptFrameIterator it(CcTest::i_isolate());
+  JavaScriptFrame* frame = it.frame();
+  args.GetReturnValue().Set(frame->is_optimized() &&
+                            frame->LookupCode()->is_turbofanned());
+}
+
+
+static void InitializeTurboOsr() {
+  FLAG_allow_natives_syntax = true;
+  FLAG_use_osr = true;
+  FLAG_concurrent_osr = false;
+  FLAG_turbo_osr = true;
+  FLAG_turbo_filter = "*";
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Local<v8::Context> context = isolate->GetCurrentContext();
+  Local<v8::FunctionTemplate> t = FunctionTemplate::New(isolate, IsTurboFanned);
+  context->Global()->Set(v8_str("IsTurboFanned"), t->GetFunction());
+}
+
+
+TEST(TurboOsrSimpleLoop) {
+  InitializeTurboOsr();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Value> result = CompileRun(
+      "function f(n) {"
+      "  var sum = 0;"
+      "  for (var i = 0; i < n; i++) {"
+      "    if (i == 10) %OptimizeFunctionOnNextCall(f, 'osr');"
+      "    sum += i;"
+      "  }"
+      "  return IsTurboFanned() ? sum : -1;"
+      "}"
+      "f(100);");
+  CHECK_EQ(4950, result->Int32Value());
+}
+
+
+TEST(TurboOsrAfterEarlyReturn) {
+  InitializeTurboOsr();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Value> result = CompileRun(
+      "function f(a, b) {"
+      "  if (a < 0) return 0;"
+      "  var x = a, y = 1;"
+      "  while (x > 0) {"
+      "    if (x == 50) %OptimizeFunctionOnNextCall(f, 'osr');"
+      "    y = (y + b) % 1000;"
+      "    x--;"
+      "  }"
+      "  return IsTurboFanned() ? y : -1;"
+      "}"
+      "f(100, 7);");
+  CHECK_EQ(701, result->Int32Value());
+}
+
+
+TEST(TurboOsrNestedLoopFallsBack) {
+  InitializeTurboOsr();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Value> result = CompileRun(
+      "function f(n) {"
+      "  var sum = 0;"
+      "  for (var i = 0; i < n; i++) {"
+      "    for (var j = 0; j < n; j++) {"
+      "      if (i == 5 && j == 5) %OptimizeFunctionOnNextCall(f, 'osr');"
+      "      sum += j;"
+      "    }"
+      "  }"
+      "  return sum;"
+      "}"
+      "f(10);");
+  CHECK_EQ(450, result->Int32Value());
+}
+
+#endif  // V8_TURBOFAN_TARGET && V8_TARGET_ARCH_X64
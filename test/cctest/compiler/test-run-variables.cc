@@ -119,3 +119,20 @@ TEST(SelfReferenceVariable) {
   CompileRun("var self = 'not a function'");
   T.CheckCall(T.function);
 }
+
+
+TEST(LargeContextVariables) {
+  // More context slots than the inline-allocating stub handles.
+  static const int kVariables = 70;
+  EmbeddedVector<char, 2048> buffer;
+  int pos = SNPrintF(buffer, "(function(a) { var v0 = a");
+  for (int i = 1; i < kVariables; i++) {
+    pos += SNPrintF(buffer + pos, ", v%d = a + %d", i, i);
+  }
+  SNPrintF(buffer + pos, "; function f() { return v0 + v%d; } return f(); })",
+           kVariables - 1);
+  FunctionTester T(buffer.start());
+
+  T.CheckCall(T.Val(2 + 2 + kVariables - 1), T.Val(2));
+  T.CheckCall(T.Val(kVariables - 1), T.Val(0.0));
+}
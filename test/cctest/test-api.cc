@@ -834,6 +834,86 @@ THREADED_TEST(ScavengeExternalOneByteString) {
 }
 
 
+static void CountExternalRelease(const char* data, size_t length,
+                                 void* parameter) {
+  ++*static_cast<int*>(parameter);
+}
+
+
+THREADED_TEST(NewExternalWithReleaseCallback) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  const char* payload = "GET /index.html HTTP/1.1";
+  int release_count = 0;
+  {
+    v8::HandleScope scope(isolate);
+    Local<String> path = String::NewExternal(
+        isolate, payload + 4, 11, CountExternalRelease, &release_count);
+    CHECK(path->IsExternalOneByte());
+    CHECK_EQ(payload + 4, path->GetExternalOneByteStringResource()->data());
+    CHECK_EQ("/index.html", *String::Utf8Value(path));
+    CcTest::heap()->CollectAllAvailableGarbage();
+    CHECK_EQ(0, release_count);
+  }
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(1, release_count);
+
+  // Empty strings do not refer to the data at all.
+  {
+    v8::HandleScope scope(isolate);
+    Local<String> empty = String::NewExternal(
+        isolate, payload, 0, CountExternalRelease, &release_count);
+    CHECK_EQ(0, empty->Length());
+    CHECK_EQ(2, release_count);
+  }
+}
+
+
+struct FlagAndArrayBuffer {
+  bool flag;
+  v8::Persistent<v8::ArrayBuffer> handle;
+};
+
+
+static void DisposeArrayBufferAndSetFlag(
+    const v8::WeakCallbackData<v8::ArrayBuffer, FlagAndArrayBuffer>& data) {
+  data.GetParameter()->handle.Reset();
+  data.GetParameter()->flag = true;
+}
+
+
+THREADED_TEST(NewExternalFromArrayBuffer) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  FlagAndArrayBuffer weak_buffer;
+  weak_buffer.flag = false;
+  {
+    v8::HandleScope scope(isolate);
+    Local<v8::ArrayBuffer> ab = Local<v8::ArrayBuffer>::Cast(CompileRun(
+        "var ab = new ArrayBuffer(8);"
+        "var u8 = new Uint8Array(ab);"
+        "for (var i = 0; i < 8; i++) u8[i] = 'abcdefgh'.charCodeAt(i);"
+        "ab"));
+    weak_buffer.handle.Reset(isolate, ab);
+    weak_buffer.handle.SetWeak(&weak_buffer, &DisposeArrayBufferAndSetFlag);
+    Local<String> str = String::NewExternal(isolate, ab, 2, 4);
+    CHECK(str->IsExternalOneByte());
+    CHECK_EQ("cdef", *String::Utf8Value(str));
+    env->Global()->Set(v8_str("str"), str);
+    CompileRun("ab = u8 = undefined;");
+  }
+  // The string keeps the buffer alive.
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK(!weak_buffer.flag);
+  CHECK_EQ("cdefcdef", *String::Utf8Value(CompileRun("str + str")));
+
+  CompileRun("str = undefined;");
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK(weak_buffer.flag);
+}
+
+
 class TestOneByteResourceWithDisposeControl : public TestOneByteResource {
  public:
   // Only used by non-threaded tests, so it can use static fields.
@@ -3280,6 +3360,74 @@ THREADED_TEST(ArrayBuffer_External) {
 }
 
 
+THREADED_TEST(ArrayBuffer_Internalized) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  void* data = i::V8::ArrayBufferAllocator()->Allocate(100);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(
+      isolate, data, 100, v8::ArrayBuffer::kInternalized);
+  CheckInternalFieldsAreZero(ab);
+  CHECK_EQ(100, static_cast<int>(ab->ByteLength()));
+  CHECK(!ab->IsExternal());
+  v8::ArrayBuffer::Contents contents = ab->GetContents();
+  CHECK_EQ(data, contents.Data());
+  CHECK_EQ(100, static_cast<int>(contents.ByteLength()));
+  CHECK(!ab->IsExternal());
+
+  env->Global()->Set(v8_str("ab"), ab);
+  v8::Handle<v8::Value> result =
+      CompileRun("var u8 = new Uint8Array(ab); u8[0] = 0xBB; u8.length");
+  CHECK_EQ(100, result->Int32Value());
+  CHECK_EQ(0xBB, static_cast<uint8_t*>(data)[0]);
+}
+
+
+static void AddToSharedArrayBuffer(v8::Isolate* isolate, int32_t* data,
+                                   int32_t value) {
+  v8::HandleScope handle_scope(isolate);
+  LocalContext env(isolate);
+  Local<v8::ArrayBuffer> sab =
+      v8::ArrayBuffer::NewShared(isolate, data, 4 * sizeof(*data));
+  CHECK(sab->IsShared());
+  CHECK(sab->IsExternal());
+  CHECK_EQ(data, sab->GetContents().Data());
+  env->Global()->Set(v8_str("sab"), sab);
+  env->Global()->Set(v8_str("value"), v8::Integer::New(isolate, value));
+  v8::Handle<v8::Value> result = CompileRun(
+      "var ia = new Int32Array(sab);"
+      "Atomics.add(ia, 1, value);");
+  CHECK_EQ(data[1] - value, result->Int32Value());
+  CHECK(CompileRun("sab instanceof SharedArrayBuffer")->IsTrue());
+}
+
+
+TEST(SharedArrayBuffer_AcrossIsolates) {
+  i::FLAG_harmony_atomics = true;
+  int32_t data[4] = {0, 10, 0, 0};
+
+  // The memory block is shared by buffers in two isolates.
+  AddToSharedArrayBuffer(CcTest::isolate(), data, 5);
+  v8::Isolate* isolate = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    AddToSharedArrayBuffer(isolate, data, 7);
+  }
+  isolate->Dispose();
+  CHECK_EQ(22, data[1]);
+
+  // Buffers created by JavaScript are shared as well.
+  v8::HandleScope handle_scope(CcTest::isolate());
+  LocalContext env;
+  Local<v8::ArrayBuffer> sab = Local<v8::ArrayBuffer>::Cast(
+      CompileRun("new SharedArrayBuffer(8)"));
+  CHECK(sab->IsShared());
+  CHECK(!sab->IsExternal());
+  CHECK(!v8::ArrayBuffer::New(CcTest::isolate(), 8)->IsShared());
+}
+
+
 static void CheckDataViewIsNeutered(v8::Handle<v8::DataView> dv) {
   CHECK_EQ(0, static_cast<int>(dv->ByteLength()));
   CHECK_EQ(0, static_cast<int>(dv->ByteOffset()));
@@ -4650,6 +4798,71 @@ THREADED_TEST(Array) {
 }
 
 
+THREADED_TEST(ObjectNewWithProperties) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<v8::Name> names[] = {v8_str("a"), v8_str("b"), v8_str("c")};
+  Local<Value> values[] = {v8_num(1), v8_str("two"), v8::Object::New(isolate)};
+  Local<v8::Object> obj1 = v8::Object::New(isolate, names, values, 3);
+  Local<v8::Object> obj2 = v8::Object::New(isolate, names, values, 3);
+  CHECK_EQ(1, obj1->Get(v8_str("a"))->Int32Value());
+  CHECK(obj1->Get(v8_str("b"))->Equals(v8_str("two")));
+  CHECK(obj1->Get(v8_str("c"))->StrictEquals(values[2]));
+  CHECK(v8::Utils::OpenHandle(*obj1)->HasFastProperties());
+  CHECK_EQ(v8::Utils::OpenHandle(*obj1)->map(),
+           v8::Utils::OpenHandle(*obj2)->map());
+  context->Global()->Set(v8_str("obj"), obj1);
+  CHECK_EQ(3, CompileRun("Object.keys(obj).length")->Int32Value());
+  CHECK(CompileRun("obj.b = 2; obj.b === 2")->BooleanValue());
+
+  // A missing value reads as undefined.
+  Local<Value> holes[] = {v8_num(1), Local<Value>(), v8_num(3)};
+  Local<v8::Object> obj3 = v8::Object::New(isolate, names, holes, 3);
+  CHECK(obj3->Has(v8_str("b")));
+  CHECK(obj3->Get(v8_str("b"))->IsUndefined());
+
+  // Duplicate names and array indices take the generic path; the last value
+  // of a duplicated name wins.
+  Local<v8::Name> odd_names[] = {v8_str("x"), v8_str("0"), v8_str("x")};
+  Local<v8::Object> obj4 = v8::Object::New(isolate, odd_names, values, 3);
+  CHECK_EQ(2, obj4->GetOwnPropertyNames()->Length());
+  CHECK(obj4->Get(0)->Equals(v8_str("two")));
+  CHECK(obj4->Get(v8_str("x"))->StrictEquals(values[2]));
+}
+
+
+THREADED_TEST(ArrayNewObjects) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<v8::Name> names[] = {v8_str("id"), v8_str("name")};
+  const int kObjects = 100;
+  Local<Value> values[2 * kObjects];
+  for (int i = 0; i < kObjects; i++) {
+    values[2 * i] = v8_num(i);
+    values[2 * i + 1] = v8_str("row");
+  }
+  Local<v8::Array> array =
+      v8::Array::NewObjects(isolate, names, 2, values, kObjects);
+  CHECK_EQ(kObjects, static_cast<int>(array->Length()));
+  i::Map* map = v8::Utils::OpenHandle(*array->Get(0).As<v8::Object>())->map();
+  for (int i = 0; i < kObjects; i++) {
+    Local<v8::Object> obj = array->Get(i).As<v8::Object>();
+    CHECK_EQ(i, obj->Get(v8_str("id"))->Int32Value());
+    CHECK(obj->Get(v8_str("name"))->Equals(v8_str("row")));
+    CHECK_EQ(map, v8::Utils::OpenHandle(*obj)->map());
+  }
+  context->Global()->Set(v8_str("rows"), array);
+  CHECK_EQ(kObjects * (kObjects - 1) / 2,
+           CompileRun("rows.reduce(function(s, r) { return s + r.id; }, 0)")
+               ->Int32Value());
+
+  array = v8::Array::NewObjects(isolate, names, 2, values, 0);
+  CHECK_EQ(0, static_cast<int>(array->Length()));
+}
+
+
 void HandleF(const v8::FunctionCallbackInfo<v8::Value>& args) {
   v8::EscapableHandleScope scope(args.GetIsolate());
   ApiTestFuzzer::Fuzz();
@@ -6717,6 +6930,28 @@ THREADED_TEST(FunctionPrototypeAcrossContexts) {
 }
 
 
+TEST(ExperimentalNativesAcrossContexts) {
+  // Contexts share the compiled experimental natives, but each one gets its
+  // own functions.
+  i::FLAG_harmony_proxies = true;
+  v8::HandleScope scope(CcTest::isolate());
+
+  LocalContext env0;
+  v8::Handle<v8::Function> create0 = CompileRun("Proxy.create").As<Function>();
+  CompileRun("Proxy.custom = 1234");
+
+  LocalContext env1;
+  v8::Handle<v8::Function> create1 = CompileRun("Proxy.create").As<Function>();
+  CHECK(CompileRun("Proxy.custom")->IsUndefined());
+  CHECK(CompileRun("typeof Proxy.create({}) === 'object'")->IsTrue());
+
+  i::Handle<i::JSFunction> function0 = v8::Utils::OpenHandle(*create0);
+  i::Handle<i::JSFunction> function1 = v8::Utils::OpenHandle(*create1);
+  CHECK(!function0.is_identical_to(function1));
+  CHECK_EQ(function0->shared(), function1->shared());
+}
+
+
 THREADED_TEST(Regress892105) {
   // Make sure that object and array literals created by cloning
   // boilerplates cannot communicate through their __proto__
@@ -7491,6 +7726,77 @@ THREADED_TEST(IndependentWeakHandle) {
 }
 
 
+struct PhantomData {
+  int first_pass_calls;
+  int second_pass_calls;
+  void* internal_field;
+  v8::Persistent<v8::Object> handle;
+};
+
+
+static void PhantomSecondPass(const v8::WeakCallbackInfo<PhantomData>& data) {
+  // Unlike the first pass, the second pass may call into V8.
+  v8::HandleScope scope(data.GetIsolate());
+  v8::Object::New(data.GetIsolate());
+  data.GetParameter()->second_pass_calls++;
+}
+
+
+static void PhantomFirstPass(const v8::WeakCallbackInfo<PhantomData>& data) {
+  PhantomData* phantom = data.GetParameter();
+  CHECK(phantom->handle.IsNearDeath());
+  phantom->first_pass_calls++;
+  phantom->internal_field = data.GetInternalField(0);
+  phantom->handle.Reset();
+  data.SetSecondPassCallback(PhantomSecondPass);
+}
+
+
+TEST(PhantomHandles) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<ObjectTemplate> templ = ObjectTemplate::New(isolate);
+  templ->SetInternalFieldCount(2);
+
+  const int kHandles = 100;
+  int native = 0;
+  PhantomData phantoms[kHandles];
+  for (int i = 0; i < kHandles; i++) {
+    v8::HandleScope handle_scope(isolate);
+    Local<v8::Object> object = templ->NewInstance();
+    object->SetAlignedPointerInInternalField(0, &native);
+    PhantomData* phantom = &phantoms[i];
+    phantom->first_pass_calls = 0;
+    phantom->second_pass_calls = 0;
+    phantom->internal_field = NULL;
+    phantom->handle.Reset(isolate, object);
+    phantom->handle.SetWeak(phantom, PhantomFirstPass,
+                            i % 2 == 0 ? v8::kWeakCallbackInternalFields
+                                       : v8::kWeakCallbackParameter);
+  }
+
+  // The first passes run right after the collection, the second passes are
+  // left to a task.
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  for (int i = 0; i < kHandles; i++) {
+    CHECK(phantoms[i].handle.IsEmpty());
+    CHECK_EQ(1, phantoms[i].first_pass_calls);
+    CHECK_EQ(0, phantoms[i].second_pass_calls);
+    CHECK_EQ(i % 2 == 0 ? &native : NULL, phantoms[i].internal_field);
+  }
+
+  // A synchronous collection also runs the pending second passes.
+  CcTest::heap()->CollectAllGarbage(
+      i::Heap::kNoGCFlags, "test",
+      v8::kGCCallbackFlagSynchronousPhantomCallbackProcessing);
+  for (int i = 0; i < kHandles; i++) {
+    CHECK_EQ(1, phantoms[i].first_pass_calls);
+    CHECK_EQ(1, phantoms[i].second_pass_calls);
+  }
+}
+
+
 static void InvokeScavenge() {
   CcTest::heap()->CollectGarbage(i::NEW_SPACE);
 }
@@ -8213,6 +8519,76 @@ THREADED_TEST(StringWrite) {
 }
 
 
+THREADED_TEST(StringUtf8AsciiRuns) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // Long ASCII runs with two, three and four byte sequences in between, so
+  // that the input also extends past the buffer of the UTF-8 decoder.
+  const int kRuns = 1000;
+  i::ScopedVector<char> utf8(kRuns * 6);
+  i::ScopedVector<uint16_t> utf16(kRuns * 3);
+  int utf8_length = 0;
+  int utf16_length = 0;
+  for (int k = 0; k < kRuns; k++) {
+    char c = 'a' + k % 26;
+    utf8[utf8_length++] = c;
+    utf16[utf16_length++] = c;
+    if (k % 97 == 0) {
+      utf8[utf8_length++] = '\xc3';
+      utf8[utf8_length++] = '\xa9';
+      utf16[utf16_length++] = 0xe9;
+    }
+    if (k % 131 == 0) {
+      utf8[utf8_length++] = '\xe2';
+      utf8[utf8_length++] = '\x82';
+      utf8[utf8_length++] = '\xac';
+      utf16[utf16_length++] = 0x20ac;
+    }
+    if (k % 251 == 0) {
+      utf8[utf8_length++] = '\xf0';
+      utf8[utf8_length++] = '\x9f';
+      utf8[utf8_length++] = '\x98';
+      utf8[utf8_length++] = '\x80';
+      utf16[utf16_length++] = 0xd83d;
+      utf16[utf16_length++] = 0xde00;
+    }
+  }
+
+  Local<String> str = String::NewFromUtf8(isolate, utf8.start(),
+                                          String::kNormalString, utf8_length);
+  CHECK_EQ(utf16_length, str->Length());
+  i::ScopedVector<uint16_t> wbuf(utf16_length);
+  CHECK_EQ(utf16_length, str->Write(wbuf.start(), 0, utf16_length,
+                                    String::NO_NULL_TERMINATION));
+  for (int k = 0; k < utf16_length; k++) CHECK_EQ(utf16[k], wbuf[k]);
+
+  i::ScopedVector<char> out(utf8_length + 1);
+  int charlen;
+  CHECK_EQ(utf8_length + 1, str->WriteUtf8(out.start(), utf8_length + 1,
+                                           &charlen));
+  CHECK_EQ(utf16_length, charlen);
+  CHECK_EQ(0, memcmp(utf8.start(), out.start(), utf8_length));
+  CHECK_EQ(utf8_length, str->Utf8Length());
+
+  // One-byte strings with Latin-1 characters between the ASCII runs.
+  const uint8_t latin1[] = "abcdefgh\xe9ijklmnopqrstuvwxyz\xff";
+  Local<String> one_byte = String::NewFromOneByte(isolate, latin1);
+  char latin1_out[40];
+  CHECK_EQ(31, one_byte->WriteUtf8(latin1_out, sizeof(latin1_out), &charlen));
+  CHECK_EQ(28, charlen);
+  CHECK_EQ(0, strcmp("abcdefgh\xc3\xa9ijklmnopqrstuvwxyz\xc3\xbf",
+                     latin1_out));
+  // A two byte sequence that does not fit is not written.
+  memset(latin1_out, 0x1, sizeof(latin1_out));
+  CHECK_EQ(8, one_byte->WriteUtf8(latin1_out, 9, &charlen));
+  CHECK_EQ(8, charlen);
+  CHECK_EQ(0, strncmp("abcdefgh", latin1_out, 8));
+  CHECK_EQ(0x1, latin1_out[8]);
+}
+
+
 static void Utf16Helper(
     LocalContext& context,  // NOLINT
     const char* name,
@@ -11438,6 +11814,59 @@ THREADED_TEST(HandleIteration) {
 }
 
 
+TEST(HandleBlockPool) {
+  // Each scope spans several handle blocks.
+  static const int kHandles = 8 * i::kHandleBlockSize;
+  i::FLAG_handle_block_pool_size = 3;
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  i::HandleScopeImplementer* impl =
+      reinterpret_cast<i::Isolate*>(isolate)->handle_scope_implementer();
+  v8::HandleScope scope0(isolate);
+  for (int round = 0; round < 3; round++) {
+    {
+      v8::HandleScope scope1(isolate);
+      for (int i = 0; i < kHandles; i++) {
+        Local<v8::Number> n(v8::Integer::New(isolate, i));
+      }
+      CHECK_EQ(kHandles, v8::HandleScope::NumberOfHandles(isolate));
+      CHECK_EQ(0, impl->spare_block_count());
+    }
+    CHECK_EQ(0, v8::HandleScope::NumberOfHandles(isolate));
+    CHECK_EQ(i::FLAG_handle_block_pool_size, impl->spare_block_count());
+  }
+}
+
+
+TEST(SealHandleScope) {
+  static const int kHandles = 2 * i::kHandleBlockSize;
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope0(isolate);
+  Local<v8::Number> outer(v8::Integer::New(isolate, 1));
+  int handles = v8::HandleScope::NumberOfHandles(isolate);
+  {
+    v8::SealHandleScope seal(isolate);
+    // Handles can still be created in scopes that are opened inside the
+    // sealed one, also when they need more blocks.
+    for (int round = 0; round < 2; round++) {
+      v8::HandleScope scope1(isolate);
+      for (int i = 0; i < kHandles; i++) {
+        Local<v8::Number> n(v8::Integer::New(isolate, i));
+        CHECK_EQ(i, n->Int32Value());
+      }
+      CHECK_EQ(handles + kHandles, v8::HandleScope::NumberOfHandles(isolate));
+    }
+    CHECK_EQ(handles, v8::HandleScope::NumberOfHandles(isolate));
+  }
+  // Handles of the outer scope are intact and it can grow again.
+  CHECK_EQ(1, outer->Int32Value());
+  Local<v8::Number> after(v8::Integer::New(isolate, 2));
+  CHECK_EQ(handles + 1, v8::HandleScope::NumberOfHandles(isolate));
+  CHECK_EQ(2, after->Int32Value());
+}
+
+
 static void InterceptorHasOwnPropertyGetter(
     Local<String> name,
     const v8::PropertyCallbackInfo<v8::Value>& info) {
@@ -11758,6 +12187,54 @@ THREADED_TEST(InterceptorLoadICWithCallbackOnHolder) {
 }
 
 
+static int non_masking_interceptor_calls = 0;
+
+
+static void NonMaskingInterceptorGetter(
+    Local<String> name,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  ApiTestFuzzer::Fuzz();
+  non_masking_interceptor_calls++;
+  info.GetReturnValue().Set(v8::Integer::New(info.GetIsolate(), 42));
+}
+
+
+TEST(NonMaskingInterceptorSkipsOwnProperties) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::ObjectTemplate> templ = ObjectTemplate::New(isolate);
+  templ->SetNamedPropertyHandler(NonMaskingInterceptorGetter, 0, 0, 0, 0,
+                                 v8::Handle<v8::Value>(),
+                                 v8::kNonMaskingNamedPropertyHandler);
+  templ->SetAccessor(v8_str("y"), Return239Callback);
+  LocalContext context;
+  context->Global()->Set(v8_str("o"), templ->NewInstance());
+  non_masking_interceptor_calls = 0;
+
+  // Own accessors and fields do not call the interceptor.
+  v8::Handle<Value> value = CompileRun(
+      "o.z = 1;"
+      "var result = 0;"
+      "for (var i = 0; i < 1000; i++) {"
+      "  result += o.y + o.z;"
+      "}"
+      "result;");
+  CHECK_EQ(240000, value->Int32Value());
+  CHECK_EQ(0, non_masking_interceptor_calls);
+
+  // Other names still do, also when the holder is in the prototype chain.
+  value = CompileRun(
+      "var r = { __proto__: o };"
+      "var result = 0;"
+      "for (var i = 0; i < 10; i++) {"
+      "  result += o.x + r.x + r.y;"
+      "}"
+      "result;");
+  CHECK_EQ(10 * (42 + 42 + 239), value->Int32Value());
+  CHECK_EQ(20, non_masking_interceptor_calls);
+}
+
+
 THREADED_TEST(InterceptorLoadICWithCallbackOnProto) {
   v8::Isolate* isolate = CcTest::isolate();
   v8::HandleScope scope(isolate);
@@ -18187,6 +18664,29 @@ TEST(IdleNotificationWithLargeHint) {
 }
 
 
+// Test that idle notification with a deadline eventually collects garbage.
+TEST(IdleNotificationDeadline) {
+  const intptr_t MB = 1024 * 1024;
+  const double IdlePauseInSeconds = 0.9005;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  intptr_t initial_size = CcTest::heap()->SizeOfObjects();
+  CreateGarbageInOldSpace();
+  intptr_t size_with_garbage = CcTest::heap()->SizeOfObjects();
+  CHECK_GT(size_with_garbage, initial_size + MB);
+  bool finished = false;
+  for (int i = 0; i < 200 && !finished; i++) {
+    double deadline =
+        v8::internal::V8::GetCurrentPlatform()->MonotonicallyIncreasingTime() +
+        IdlePauseInSeconds;
+    finished = env->GetIsolate()->IdleNotificationDeadline(deadline);
+  }
+  intptr_t final_size = CcTest::heap()->SizeOfObjects();
+  CHECK(finished);
+  CHECK_LT(final_size, initial_size + 1);
+}
+
+
 TEST(Regress2107) {
   const intptr_t MB = 1024 * 1024;
   const int kIdlePauseInMs = 1000;
@@ -18313,6 +18813,62 @@ THREADED_TEST(GetHeapStatistics) {
 }
 
 
+class InlineCacheSiteVisitorImpl : public v8::InlineCacheSiteVisitor {
+ public:
+  explicit InlineCacheSiteVisitorImpl(int script_id)
+      : script_id_(script_id), megamorphic_loads_(0), position_(-1) {}
+
+  virtual void VisitInlineCacheSite(Kind kind, State state, int script_id,
+                                    int position) {
+    if (script_id != script_id_) return;
+    if (kind == kLoad && state == kMegamorphic) {
+      megamorphic_loads_++;
+      position_ = position;
+    }
+  }
+
+  int megamorphic_loads() const { return megamorphic_loads_; }
+  int position() const { return position_; }
+
+ private:
+  int script_id_;
+  int megamorphic_loads_;
+  int position_;
+};
+
+
+TEST(InlineCacheSites) {
+  i::FLAG_always_opt = false;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  const char* source =
+      "function get(o) { return o.x; }\n"
+      "for (var i = 0; i < 10; i++) {\n"
+      "  var o = { x: i };\n"
+      "  o['p' + i] = i;\n"
+      "  get(o);\n"
+      "}\n";
+  v8::Local<v8::Script> script = v8_compile(source);
+  int script_id = script->GetUnboundScript()->GetId();
+  script->Run();
+
+  v8::InlineCacheStatistics statistics;
+  CHECK_EQ(0, static_cast<int>(statistics.megamorphic_sites()));
+  isolate->GetInlineCacheStatistics(&statistics);
+  CHECK_LE(1, static_cast<int>(statistics.megamorphic_sites()));
+
+  InlineCacheSiteVisitorImpl visitor(script_id);
+  isolate->VisitInlineCacheSites(&visitor);
+  CHECK_EQ(1, visitor.megamorphic_loads());
+  // The site is the o.x load in get().
+  CHECK_LT(static_cast<int>(strlen("function get(o) { return")),
+           visitor.position());
+  CHECK_GT(static_cast<int>(strlen("function get(o) { return o.x;")),
+           visitor.position());
+}
+
+
 class VisitorImpl : public v8::ExternalResourceVisitor {
  public:
   explicit VisitorImpl(TestResource** resource) {
@@ -19693,6 +20249,33 @@ TEST(IsolateNewDispose) {
 }
 
 
+TEST(IsolateTemplate) {
+  v8::Isolate::CreateParams params;
+  v8::IsolateTemplate* isolate_template = new v8::IsolateTemplate(params, 2);
+  // Take more isolates than the pool holds, some of them may have been
+  // prepared on a background thread, others are created right away.
+  for (int i = 0; i < 3; i++) {
+    v8::Isolate* isolate = isolate_template->NewIsolate();
+    CHECK(isolate != NULL);
+    CHECK(isolate != CcTest::isolate());
+    {
+      v8::Isolate::Scope i_scope(isolate);
+      v8::HandleScope scope(isolate);
+      LocalContext context(isolate);
+      ExpectInt32("function f(n) { return n == 0 ? 0 : f(n - 1) + 1; }"
+                  "f(1000)", 1000);
+      // The stack limit has to be valid for this thread.
+      ExpectTrue(
+          "try { (function g() { g(); })(); false; }"
+          "catch (e) { e instanceof RangeError; }");
+    }
+    isolate->Dispose();
+  }
+  // Disposes the isolates that were not handed out.
+  delete isolate_template;
+}
+
+
 UNINITIALIZED_TEST(DisposeIsolateWhenInUse) {
   v8::Isolate* isolate = v8::Isolate::New();
   {
@@ -21975,6 +22558,76 @@ THREADED_TEST(JSONParseNumber) {
 }
 
 
+class JSONStringifyStream : public v8::OutputStream {
+ public:
+  JSONStringifyStream(int chunk_size, int abort_after)
+      : chunk_size_(chunk_size),
+        abort_after_(abort_after),
+        chunks_(0),
+        eos_signaled_(false) {}
+  virtual void EndOfStream() { eos_signaled_ = true; }
+  virtual int GetChunkSize() { return chunk_size_; }
+  virtual WriteResult WriteAsciiChunk(char* data, int size) {
+    CHECK(!eos_signaled_);
+    CHECK_GT(size, 0);
+    CHECK_LE(size, chunk_size_);
+    if (++chunks_ == abort_after_) return kAbort;
+    output_.append(data, size);
+    return kContinue;
+  }
+  const std::string& output() const { return output_; }
+  int chunks() const { return chunks_; }
+  bool eos_signaled() const { return eos_signaled_; }
+
+ private:
+  int chunk_size_;
+  int abort_after_;
+  int chunks_;
+  bool eos_signaled_;
+  std::string output_;
+};
+
+
+THREADED_TEST(JSONStringifyToStream) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+  const char* source =
+      "var rows = [];"
+      "for (var i = 0; i < 1000; i++) {"
+      "  rows.push({ id: i, name: 'row ' + i, d: i / 8 });"
+      "}"
+      "rows.push({ s: '\\u00e9\\u1234\\ud83d\\ude00', n: new Number(1) });"
+      "rows";
+  Local<Value> rows = CompileRun(source);
+  Local<Value> expected = CompileRun("JSON.stringify(rows)");
+  v8::String::Utf8Value expected_utf8(expected);
+  int sizes[] = { 1, 3, 1024 };
+  for (size_t i = 0; i < arraysize(sizes); i++) {
+    JSONStringifyStream stream(sizes[i], -1);
+    CHECK(v8::JSON::Stringify(rows, &stream));
+    CHECK(stream.eos_signaled());
+    CHECK_EQ(*expected_utf8, stream.output().c_str());
+  }
+
+  JSONStringifyStream aborted(16, 3);
+  CHECK(!v8::JSON::Stringify(rows, &aborted));
+  CHECK(!aborted.eos_signaled());
+  CHECK_EQ(3, aborted.chunks());
+
+  JSONStringifyStream unchanged(16, -1);
+  CHECK(!v8::JSON::Stringify(v8::Undefined(context->GetIsolate()),
+                             &unchanged));
+  CHECK(!unchanged.eos_signaled());
+
+  v8::TryCatch try_catch;
+  Local<Value> circular = CompileRun("var c = {}; c.c = c; c");
+  JSONStringifyStream failed(16, -1);
+  CHECK(!v8::JSON::Stringify(circular, &failed));
+  CHECK(try_catch.HasCaught());
+  CHECK(!failed.eos_signaled());
+}
+
+
 #if V8_OS_POSIX && !V8_OS_NACL
 class ThreadInterruptTest {
  public:
@@ -22656,6 +23309,37 @@ TEST(ClearInterruptFromAnotherThread) {
 }
 
 
+TEST(PendingInterruptsAreHandledTogether) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  i::StackGuard* stack_guard = CcTest::i_isolate()->stack_guard();
+  uintptr_t real_jslimit = stack_guard->real_jslimit();
+
+  // Requesting an interrupt that is already pending does nothing.
+  stack_guard->RequestGC();
+  stack_guard->RequestGC();
+  stack_guard->RequestDeoptMarkedAllocationSites();
+  CHECK(stack_guard->CheckGC());
+  CHECK(stack_guard->jslimit() != real_jslimit);
+
+  // A single stack check handles all of them.
+  CompileRun("(function() { return 1; })()");
+  CHECK(!stack_guard->CheckGC());
+  CHECK(!stack_guard->CheckDeoptMarkedAllocationSites());
+  CHECK(stack_guard->jslimit() == real_jslimit);
+
+  // Interrupts that come after a termination stay pending.
+  stack_guard->RequestDeoptMarkedAllocationSites();
+  stack_guard->RequestTerminateExecution();
+  CompileRun("(function() { return 1; })()");
+  CHECK(stack_guard->CheckDeoptMarkedAllocationSites());
+  v8::V8::CancelTerminateExecution(isolate);
+  CompileRun("(function() { return 1; })()");
+  CHECK(!stack_guard->CheckDeoptMarkedAllocationSites());
+}
+
+
 static Local<Value> function_new_expected_env;
 static void FunctionNewCallback(const v8::FunctionCallbackInfo<Value>& info) {
   CHECK_EQ(function_new_expected_env, info.Data());
@@ -22924,6 +23608,72 @@ TEST(TestFunctionCallOptimization) {
 }
 
 
+static int fast_api_slow_calls = 0;
+static int fast_api_fast_calls = 0;
+
+
+static double FastApiScale(void* holder, int32_t a, double b, bool negate) {
+  fast_api_fast_calls++;
+  double result = (*static_cast<int32_t*>(holder) + a) * b;
+  return negate ? -result : result;
+}
+
+
+static void SlowApiScale(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  fast_api_slow_calls++;
+  void* holder = info.Holder()->GetAlignedPointerFromInternalField(0);
+  double result =
+      (*static_cast<int32_t*>(holder) + info[0]->Int32Value()) *
+      info[1]->NumberValue();
+  info.GetReturnValue().Set(info[2]->BooleanValue() ? -result : result);
+}
+
+
+TEST(FastApiCall) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<v8::FunctionTemplate> scale =
+      v8::FunctionTemplate::New(isolate, SlowApiScale);
+  v8::FastCallType types[] = {v8::kFastCallHolder, v8::kFastCallInt32,
+                              v8::kFastCallDouble, v8::kFastCallBool};
+  scale->SetFastCallHandler(
+      reinterpret_cast<v8::FastCallHandler>(FastApiScale),
+      v8::kFastCallDouble, 4, types);
+  Local<ObjectTemplate> templ = ObjectTemplate::New(isolate);
+  templ->SetInternalFieldCount(1);
+  templ->Set(v8_str("scale"), scale);
+  Local<v8::Object> obj = templ->NewInstance();
+  int32_t offset = 10;
+  obj->SetAlignedPointerInInternalField(0, &offset);
+  context->Global()->Set(v8_str("obj"), obj);
+
+  CompileRun(
+      "function f(a, b, negate) { return obj.scale(a, b, negate); }"
+      "f(1, 2, false);"
+      "f(1, 2, false);"
+      "%OptimizeFunctionOnNextCall(f);");
+  fast_api_slow_calls = 0;
+  fast_api_fast_calls = 0;
+  CHECK_EQ(33, CompileRun("f(1, 3, false)")->Int32Value());
+  CHECK_EQ(-5.5, CompileRun("f(1, 0.5, true)")->NumberValue());
+  CHECK_EQ(2, fast_api_slow_calls + fast_api_fast_calls);
+#if V8_TARGET_ARCH_X64
+  if (CcTest::i_isolate()->use_crankshaft() && !i::FLAG_always_opt) {
+    CHECK_EQ(2, fast_api_fast_calls);
+  }
+#endif
+
+  // Arguments of other types take the regular call handler.
+  fast_api_slow_calls = 0;
+  CHECK_EQ(-22, CompileRun("f(1, 2, 1)")->Int32Value());
+  CHECK_EQ(1, fast_api_slow_calls);
+  CHECK_EQ(0, CompileRun("f('1', 0, 0)")->Int32Value());
+  CHECK_EQ(2, fast_api_slow_calls);
+}
+
+
 static const char* last_event_message;
 static int last_event_status;
 void StoringEventLoggerCallback(const char* message, int status) {
@@ -23689,6 +24439,43 @@ TEST(StreamingProducesParserCache) {
 }
 
 
+TEST(StreamingScriptUsesCompilationCache) {
+  const char* chunks[] = {"function foo() { ret", "urn 13; } f", "oo(); ",
+                          NULL};
+
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::ScriptOrigin origin(v8_str("http://foo.com"));
+  char* full_source = TestSourceStream::FullSourceString(chunks);
+
+  v8::Handle<v8::UnboundScript> streamed[2];
+  for (int i = 0; i < 2; i++) {
+    v8::ScriptCompiler::StreamedSource source(
+        new TestSourceStream(chunks),
+        v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+    v8::ScriptCompiler::ScriptStreamingTask* task =
+        v8::ScriptCompiler::StartStreamingScript(isolate, &source);
+    task->Run();
+    delete task;
+    v8::Handle<Script> script = v8::ScriptCompiler::Compile(
+        isolate, &source, v8_str(full_source), origin);
+    CHECK_EQ(13, script->Run()->Int32Value());
+    streamed[i] = script->GetUnboundScript();
+  }
+  CHECK(v8::Utils::OpenHandle(*streamed[0])
+            .is_identical_to(v8::Utils::OpenHandle(*streamed[1])));
+
+  // A regular compilation of the same source finds the streamed script too.
+  v8::ScriptCompiler::Source plain_source(v8_str(full_source), origin);
+  v8::Local<v8::UnboundScript> plain =
+      v8::ScriptCompiler::CompileUnbound(isolate, &plain_source);
+  CHECK(v8::Utils::OpenHandle(*plain)
+            .is_identical_to(v8::Utils::OpenHandle(*streamed[0])));
+  delete[] full_source;
+}
+
+
 TEST(StreamingScriptWithInvalidUtf8) {
   // Regression test for a crash: test that invalid UTF-8 bytes in the end of a
   // chunk don't produce a crash.
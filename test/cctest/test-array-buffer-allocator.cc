@@ -0,0 +1,89 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/array-buffer-allocator.h"
+#include "test/cctest/cctest.h"
+
+using v8::internal::PooledArrayBufferAllocator;
+
+
+static bool IsZeroed(void* data, size_t length) {
+  uint8_t* bytes = static_cast<uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    if (bytes[i] != 0) return false;
+  }
+  return true;
+}
+
+
+TEST(PooledArrayBufferAllocatorSmallBlocks) {
+  PooledArrayBufferAllocator allocator;
+  const size_t kLength = PooledArrayBufferAllocator::kMinPooledSize - 1;
+  void* data = allocator.Allocate(kLength);
+  CHECK(data != NULL);
+  CHECK(IsZeroed(data, kLength));
+  allocator.Free(data, kLength);
+  CHECK_EQ(0, static_cast<int>(allocator.PooledBytes()));
+}
+
+
+TEST(PooledArrayBufferAllocatorReuse) {
+  PooledArrayBufferAllocator allocator;
+  const size_t kLength = 64 * i::KB - 100;
+  void* data = allocator.Allocate(kLength);
+  CHECK(data != NULL);
+  CHECK(IsZeroed(data, kLength));
+  memset(data, 0xab, kLength);
+  allocator.Free(data, kLength);
+  CHECK_EQ(64 * i::KB, static_cast<int>(allocator.PooledBytes()));
+
+  // A block of the same size class is reused and cleared again.
+  void* reused = allocator.Allocate(64 * i::KB);
+  CHECK_EQ(data, reused);
+  CHECK(IsZeroed(reused, 64 * i::KB));
+  CHECK_EQ(0, static_cast<int>(allocator.PooledBytes()));
+  memset(reused, 0xab, 64 * i::KB);
+  allocator.Free(reused, 64 * i::KB);
+
+  // Uninitialized allocations skip the clearing.
+  void* uninitialized = allocator.AllocateUninitialized(kLength);
+  CHECK_EQ(data, uninitialized);
+  allocator.Free(uninitialized, kLength);
+}
+
+
+TEST(PooledArrayBufferAllocatorPoolLimit) {
+  PooledArrayBufferAllocator allocator;
+  const size_t kLength = PooledArrayBufferAllocator::kMaxPooledSize;
+  const int kBlocks = static_cast<int>(
+      PooledArrayBufferAllocator::kMaxPooledBytesPerSizeClass / kLength);
+  void* blocks[kBlocks + 1];
+  for (int i = 0; i <= kBlocks; i++) {
+    blocks[i] = allocator.AllocateUninitialized(kLength);
+    CHECK(blocks[i] != NULL);
+  }
+  for (int i = 0; i <= kBlocks; i++) allocator.Free(blocks[i], kLength);
+  // The block over the budget is released instead of being pooled.
+  CHECK_EQ(
+      static_cast<int>(PooledArrayBufferAllocator::kMaxPooledBytesPerSizeClass),
+      static_cast<int>(allocator.PooledBytes()));
+  allocator.ReleasePendingBlocks();
+}
+
+
+TEST(PooledArrayBufferAllocatorHugeBlocks) {
+  PooledArrayBufferAllocator allocator;
+  const size_t kLength = 4 * PooledArrayBufferAllocator::kMaxPooledSize + 1;
+  for (int i = 0; i < 8; i++) {
+    void* data = allocator.Allocate(kLength);
+    CHECK(data != NULL);
+    CHECK(IsZeroed(data, kLength));
+    memset(data, 0xab, kLength);
+    // Huge blocks are unmapped by a background task, never pooled.
+    allocator.Free(data, kLength);
+    CHECK_EQ(0, static_cast<int>(allocator.PooledBytes()));
+  }
+}
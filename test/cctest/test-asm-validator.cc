@@ -0,0 +1,80 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/asm-validator.h"
+#include "src/compiler.h"
+#include "src/parser.h"
+#include "src/rewriter.h"
+#include "src/scopes.h"
+#include "test/cctest/cctest.h"
+
+using namespace v8::internal;
+
+// Runs the validator on the function {f} of an asm.js module whose body is
+// given by {source}.
+static bool ValidateAsm(const char* source) {
+  i::ScopedVector<char> program(1024);
+  i::SNPrintF(program,
+              "(function Module(stdlib, foreign, heap) {"
+              "  'use asm';"
+              "  var H = new stdlib.Int32Array(heap);"
+              "  function g(x) { x = x|0; return x|0; }"
+              "  %s"
+              "  return f;"
+              "})(this, {}, new ArrayBuffer(4096));",
+              source);
+  v8::Local<v8::Function> result =
+      v8::Local<v8::Function>::Cast(CompileRun(program.start()));
+  Handle<JSFunction> function = v8::Utils::OpenHandle(*result);
+  CompilationInfoWithZone info(function);
+  CHECK(Parser::Parse(&info));
+  CHECK(Rewriter::Rewrite(&info));
+  CHECK(Scope::Analyze(&info));
+  return AsmValidator::Validate(info.function(), info.zone());
+}
+
+
+TEST(AsmValidatorAcceptsAnnotatedFunctions) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CHECK(ValidateAsm("function f() { return; }"));
+  CHECK(ValidateAsm("function f(a, b) { a = a|0; b = +b; return +(b + a); }"));
+  CHECK(ValidateAsm(
+      "function f(n) {"
+      "  n = n|0;"
+      "  var i = 0, s = 0;"
+      "  for (i = 0; (i|0) < (n|0); i = (i + 1)|0) {"
+      "    s = (s + (H[(i << 2) >> 2]|0))|0;"
+      "    if ((s|0) > 100) break;"
+      "  }"
+      "  switch (s|0) { case -1: return 0; case 2: s = g(s)|0; default: }"
+      "  while (!(s|0)) s = 1;"
+      "  return ((s|0) == 1 ? 1 : 2)|0;"
+      "}"));
+}
+
+
+TEST(AsmValidatorRejectsMissingAnnotations) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CHECK(!ValidateAsm("function f(a) { return a|0; }"));
+  CHECK(!ValidateAsm("function f(a, b) { b = b|0; a = a|0; return 0; }"));
+  CHECK(!ValidateAsm("function f(a) { a = a|1; return 0; }"));
+}
+
+
+TEST(AsmValidatorRejectsNonAsmConstructs) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CHECK(!ValidateAsm("function f() { return 'str'; }"));
+  CHECK(!ValidateAsm("function f() { var o = {}; return 0; }"));
+  CHECK(!ValidateAsm("function f() { try { g(1); } catch (e) {} return 0; }"));
+  CHECK(!ValidateAsm("function f() { var x = 0; x++; return x|0; }"));
+  CHECK(!ValidateAsm("function f() { var x = 0; x += 1; return x|0; }"));
+  CHECK(!ValidateAsm("function f() { return arguments.length|0; }"));
+  CHECK(!ValidateAsm("function f() { var h = function() {}; return 0; }"));
+  CHECK(!ValidateAsm("function f() { return (this.x|0); }"));
+}
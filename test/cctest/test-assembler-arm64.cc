@@ -3486,6 +3486,31 @@ TEST(ldr_literal_range_6) {
 }
 #endif
 
+
+TEST(ldr_literal_shared_across_pools) {
+  INIT_V8();
+  SETUP();
+
+  START();
+  __ Ldr(x0, Immediate(0x1234567890abcdefUL));
+  __ CheckConstPool(true, true);
+  // The value is still within load literal range of the pool emitted above,
+  // so neither load adds a new pool entry.
+  __ Ldr(x1, Immediate(0x1234567890abcdefUL));
+  __ Mov(x2, 0x1234567890abcdefUL);
+  CHECK(masm.IsConstPoolEmpty());
+  END();
+
+  RUN();
+
+  CHECK_EQUAL_64(0x1234567890abcdefUL, x0);
+  CHECK_EQUAL_64(0x1234567890abcdefUL, x1);
+  CHECK_EQUAL_64(0x1234567890abcdefUL, x2);
+
+  TEARDOWN();
+}
+
+
 TEST(add_sub_imm) {
   INIT_V8();
   SETUP();
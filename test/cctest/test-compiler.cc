@@ -32,7 +32,9 @@
 
 #include "src/compiler.h"
 #include "src/disasm.h"
+#include "src/full-codegen.h"
 #include "src/parser.h"
+#include "src/type-feedback-vector-inl.h"
 #include "test/cctest/cctest.h"
 
 using namespace v8::internal;
@@ -309,7 +311,8 @@ TEST(FeedbackVectorPreservedAcrossRecompiles) {
   Handle<FixedArray> feedback_vector(f->shared()->feedback_vector());
 
   // Verify that we gathered feedback.
-  int expected_count = FLAG_vector_ics ? 2 : 1;
+  int expected_count = TypeFeedbackVector::kReservedIndexCount +
+                       (FLAG_vector_ics ? 2 : 1);
   CHECK_EQ(expected_count, feedback_vector->length());
   CHECK(feedback_vector->get(expected_count - 1)->IsJSFunction());
 
@@ -346,7 +349,8 @@ TEST(FeedbackVectorUnaffectedByScopeChanges) {
           *v8::Handle<v8::Function>::Cast(
               CcTest::global()->Get(v8_str("morphing_call"))));
 
-  int expected_count = FLAG_vector_ics ? 2 : 1;
+  int expected_count = TypeFeedbackVector::kReservedIndexCount +
+                       (FLAG_vector_ics ? 2 : 1);
   CHECK_EQ(expected_count, f->shared()->feedback_vector()->length());
   // And yet it's not compiled.
   CHECK(!f->shared()->is_compiled());
@@ -359,6 +363,32 @@ TEST(FeedbackVectorUnaffectedByScopeChanges) {
 }
 
 
+TEST(FeedbackVectorCounters) {
+  if (!FullCodeGenerator::kEmitsFeedbackVectorCounters) return;
+  if (i::FLAG_always_opt) return;
+  i::FLAG_counter_based_tier_up = true;
+  // Keep the counts from being reset by optimizing the function.
+  i::FLAG_tier_up_invocation_count = 1000000;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun("function f(n) { for (var i = 0; i < n; i++) {} }"
+             "for (var j = 0; j < 5; j++) f(3);");
+
+  Handle<JSFunction> f =
+      v8::Utils::OpenHandle(
+          *v8::Handle<v8::Function>::Cast(
+              CcTest::global()->Get(v8_str("f"))));
+  TypeFeedbackVector* vector = f->shared()->feedback_vector();
+  CHECK_EQ(5, vector->invocation_count());
+  CHECK_EQ(15, vector->back_edge_count());
+
+  // Clearing the type feedback leaves the counters alone.
+  f->shared()->ClearTypeFeedbackInfo();
+  CHECK_EQ(5, vector->invocation_count());
+}
+
+
 // Test that optimized code for different closures is actually shared
 // immediately by the FastNewClosureStub when run in the same context.
 TEST(OptimizedCodeSharing) {
@@ -395,6 +425,58 @@ TEST(OptimizedCodeSharing) {
 }
 
 
+// Test that the same script compiled in different contexts shares its
+// shared function info when --cache-scripts-across-contexts is on.
+TEST(ScriptSharingAcrossContexts) {
+  FLAG_cache_scripts_across_contexts = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source =
+      "function get() { return x; }"
+      "get() + 1;";
+  Handle<SharedFunctionInfo> first;
+  for (int i = 0; i < 3; i++) {
+    LocalContext env;
+    env->Global()->Set(v8_str("x"), v8::Integer::New(CcTest::isolate(), i));
+    v8::Local<v8::Script> script = v8_compile(source);
+    CHECK_EQ(i + 1, script->Run()->Int32Value());
+    Handle<SharedFunctionInfo> shared =
+        v8::Utils::OpenHandle(*script->GetUnboundScript());
+    if (i == 0) {
+      first = shared;
+    } else {
+      CHECK(shared.is_identical_to(first));
+    }
+  }
+}
+
+
+TEST(RegExpCodeSharedAcrossContexts) {
+  FLAG_flush_regexp_code = false;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Handle<FixedArray> first;
+  for (int i = 0; i < 3; i++) {
+    LocalContext env;
+    v8::Local<v8::Value> result =
+        CompileRun("var re = /(\\d+)-(\\w+)/; re.exec('12-ab'); re");
+    Handle<JSRegExp> re =
+        Handle<JSRegExp>::cast(v8::Utils::OpenHandle(*result));
+    Handle<FixedArray> data(FixedArray::cast(re->data()));
+    CHECK(data->get(JSRegExp::code_index(true))->IsCode() ||
+          data->get(JSRegExp::code_index(true))->IsByteArray());
+    if (i == 0) {
+      first = data;
+    } else {
+      CHECK(data.is_identical_to(first));
+    }
+    // Without flushing, the code survives full gcs.
+    CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+    CHECK(!first->get(JSRegExp::code_index(true))->IsSmi());
+  }
+}
+
+
 #ifdef ENABLE_DISASSEMBLER
 static Handle<JSFunction> GetJSFunction(v8::Handle<v8::Object> obj,
                                  const char* property_name) {
@@ -0,0 +1,143 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/counters.h"
+#include "test/cctest/cctest.h"
+
+using namespace v8::internal;
+
+TEST(HdrHistogramEmpty) {
+  HdrHistogram histogram;
+  CHECK_EQ(0, histogram.count());
+  CHECK_EQ(0, histogram.max());
+  CHECK_EQ(0, histogram.Percentile(50));
+  CHECK_EQ(0, histogram.Percentile(100));
+}
+
+
+TEST(HdrHistogramSmallValuesAreExact) {
+  HdrHistogram histogram;
+  for (int i = 1; i <= 20; i++) histogram.AddSample(i);
+  CHECK_EQ(20, histogram.count());
+  CHECK_EQ(20, histogram.max());
+  CHECK_EQ(10, histogram.Percentile(50));
+  CHECK_EQ(1, histogram.Percentile(0));
+  CHECK_EQ(19, histogram.Percentile(95));
+  CHECK_EQ(20, histogram.Percentile(100));
+}
+
+
+TEST(HdrHistogramRelativeError) {
+  HdrHistogram histogram;
+  const int kSamples[] = {100, 1000, 12345, 1000000, 123456789, kMaxInt};
+  for (size_t i = 0; i < arraysize(kSamples); i++) {
+    histogram.Reset();
+    histogram.AddSample(kSamples[i]);
+    histogram.AddSample(0);
+    // The median is the upper bound of the bucket of the larger sample.
+    int value = histogram.Percentile(100);
+    CHECK_EQ(kSamples[i], value);
+    histogram.AddSample(kSamples[i] - 1);
+    value = histogram.Percentile(66);
+    CHECK(value >= kSamples[i] - 1);
+    CHECK(value - (kSamples[i] - 1) <= (kSamples[i] - 1) / 16);
+  }
+}
+
+
+TEST(HdrHistogramPercentiles) {
+  HdrHistogram histogram;
+  for (int i = 0; i < 1000; i++) histogram.AddSample(100);
+  histogram.AddSample(100000);
+  CHECK_EQ(1001, histogram.count());
+  CHECK_EQ(100, histogram.Percentile(50));
+  CHECK_EQ(100, histogram.Percentile(99));
+  CHECK_EQ(100000, histogram.Percentile(99.99));
+  CHECK_EQ(100000, histogram.max());
+  histogram.AddSample(-5);
+  CHECK_EQ(0, histogram.Percentile(0));
+}
+
+
+TEST(NativeHistogramTimers) {
+  FLAG_native_histograms = true;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  CompileRun("function f(o) { return o.x; } f({x: 1}); f({y: 2, x: 3});");
+  CcTest::heap()->CollectGarbage(NEW_SPACE);
+
+  bool found_compile = false;
+  bool found_scavenger = false;
+  bool found_ic_miss = false;
+  for (size_t i = 0; i < isolate->NumberOfHistogramTimers(); i++) {
+    v8::HistogramTimerStatistics statistics;
+    CHECK(isolate->GetHistogramTimerStatistics(&statistics, i));
+    CHECK(statistics.p50() <= statistics.p99());
+    CHECK(statistics.p99() <= statistics.p999());
+    CHECK(statistics.p999() <= statistics.max());
+    if (strcmp(statistics.name(), "V8.Compile") == 0) {
+      found_compile = statistics.count() > 0;
+    } else if (strcmp(statistics.name(), "V8.GCScavenger") == 0) {
+      found_scavenger = statistics.count() > 0;
+    } else if (strcmp(statistics.name(), "V8.ICMiss") == 0) {
+      found_ic_miss = statistics.count() > 0;
+    }
+  }
+  CHECK(found_compile);
+  CHECK(found_scavenger);
+  CHECK(found_ic_miss);
+
+  v8::HistogramTimerStatistics statistics;
+  CHECK(!isolate->GetHistogramTimerStatistics(
+      &statistics, isolate->NumberOfHistogramTimers()));
+}
+
+
+class CountingRuntimeCallStatsVisitor : public v8::RuntimeCallStatsVisitor {
+ public:
+  CountingRuntimeCallStatsVisitor()
+      : functions_(0), object_literal_calls_(0) {}
+
+  virtual void VisitRuntimeCallCounter(const char* name, int64_t count,
+                                       int64_t time_in_microseconds) {
+    CHECK(count > 0);
+    CHECK(time_in_microseconds >= 0);
+    functions_++;
+    if (strcmp(name, "Runtime_CreateObjectLiteral") == 0) {
+      object_literal_calls_ += count;
+    }
+  }
+
+  int functions_;
+  int64_t object_literal_calls_;
+};
+
+
+TEST(RuntimeCallStats) {
+  FLAG_runtime_call_stats = true;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  isolate->ResetRuntimeCallStats();
+
+  // The first evaluation of the literal creates its boilerplate in the
+  // runtime.
+  CompileRun(
+      "var a = [];"
+      "for (var i = 0; i < 10; i++) a.push({x: i});");
+
+  CountingRuntimeCallStatsVisitor visitor;
+  isolate->VisitRuntimeCallStats(&visitor);
+  CHECK(visitor.functions_ > 0);
+  CHECK(visitor.object_literal_calls_ >= 1);
+
+  isolate->ResetRuntimeCallStats();
+  CountingRuntimeCallStatsVisitor after_reset;
+  isolate->VisitRuntimeCallStats(&after_reset);
+  CHECK_EQ(0, after_reset.functions_);
+  FLAG_runtime_call_stats = false;
+}
@@ -245,6 +245,107 @@ TEST(TickEvents) {
 }
 
 
+namespace {
+
+class TestContinuousProfileVisitor : public v8::ContinuousProfileVisitor {
+ public:
+  TestContinuousProfileVisitor() : dropped_samples_(0) {}
+
+  virtual void VisitStack(unsigned stack_id, unsigned sample_count,
+                          const v8::CpuProfileFrame* frames,
+                          int frame_count) {
+    i::EmbeddedVector<char, 256> stack;
+    int length = 0;
+    for (int i = 0; i < frame_count; i++) {
+      length += i::SNPrintF(stack + length, "%s%s", i == 0 ? "" : " ",
+                            frames[i].function_name);
+    }
+    i::EmbeddedVector<char, 256> line;
+    i::SNPrintF(line, "%u:%s", sample_count, stack.start());
+    stacks_.Add(i::StrDup(line.start()));
+  }
+
+  virtual void VisitDroppedSamples(unsigned sample_count) {
+    dropped_samples_ += sample_count;
+  }
+
+  ~TestContinuousProfileVisitor() {
+    for (int i = 0; i < stacks_.length(); i++) i::DeleteArray(stacks_[i]);
+  }
+
+  bool HasStack(const char* line) {
+    for (int i = 0; i < stacks_.length(); i++) {
+      if (strcmp(stacks_[i], line) == 0) return true;
+    }
+    return false;
+  }
+
+  int stacks_count() const { return stacks_.length(); }
+  unsigned dropped_samples() const { return dropped_samples_; }
+
+ private:
+  i::List<char*> stacks_;
+  unsigned dropped_samples_;
+};
+
+}  // namespace
+
+
+TEST(ContinuousProfileTickEvents) {
+  TestSetup test_setup;
+  LocalContext env;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::HandleScope scope(isolate);
+
+  i::Code* frame1_code = CreateCode(&env);
+  i::Code* frame2_code = CreateCode(&env);
+  i::Code* frame3_code = CreateCode(&env);
+
+  CpuProfilesCollection* profiles = new CpuProfilesCollection(isolate->heap());
+  CHECK(profiles->StartContinuousProfiling(2));
+  CHECK(!profiles->StartContinuousProfiling(2));
+  ProfileGenerator generator(profiles);
+  SmartPointer<ProfilerEventsProcessor> processor(new ProfilerEventsProcessor(
+          &generator, NULL, v8::base::TimeDelta::FromMicroseconds(100)));
+  processor->Start();
+  CpuProfiler profiler(isolate, profiles, &generator, processor.get());
+
+  profiler.CodeCreateEvent(i::Logger::BUILTIN_TAG, frame1_code, "bbb");
+  profiler.CodeCreateEvent(i::Logger::STUB_TAG, frame2_code, 5);
+  profiler.CodeCreateEvent(i::Logger::BUILTIN_TAG, frame3_code, "ddd");
+
+  EnqueueTickSampleEvent(processor.get(), frame1_code->instruction_start());
+  EnqueueTickSampleEvent(
+      processor.get(),
+      frame2_code->instruction_start() + frame2_code->ExecutableSize() / 2,
+      frame1_code->instruction_start() + frame2_code->ExecutableSize() / 2);
+  EnqueueTickSampleEvent(processor.get(), frame1_code->instruction_end() - 1);
+  // A third distinct stack does not fit.
+  EnqueueTickSampleEvent(
+      processor.get(),
+      frame3_code->instruction_end() - 1,
+      frame2_code->instruction_end() - 1,
+      frame1_code->instruction_end() - 1);
+
+  processor->StopSynchronously();
+
+  TestContinuousProfileVisitor visitor;
+  profiles->DrainContinuousProfile(&visitor);
+  CHECK_EQ(2, visitor.stacks_count());
+  CHECK(visitor.HasStack("2:bbb"));
+  CHECK(visitor.HasStack("1:5 bbb"));
+  CHECK_EQ(1, visitor.dropped_samples());
+
+  // Draining resets the counts.
+  TestContinuousProfileVisitor second_visitor;
+  profiles->DrainContinuousProfile(&second_visitor);
+  CHECK_EQ(0, second_visitor.stacks_count());
+  CHECK_EQ(0, second_visitor.dropped_samples());
+  profiles->StopContinuousProfiling();
+  CHECK(!profiles->is_continuous_profiling());
+}
+
+
 // http://crbug/51594
 // This test must not crash.
 TEST(CrashIfStoppingLastNonExistentProfile) {
@@ -587,6 +688,46 @@ TEST(CollectCpuProfile) {
 }
 
 
+TEST(ContinuousProfiling) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::CpuProfiler* cpu_profiler = isolate->GetCpuProfiler();
+  i::CpuProfiler* iprofiler = reinterpret_cast<i::CpuProfiler*>(cpu_profiler);
+
+  v8::Script::Compile(v8::String::NewFromUtf8(isolate,
+                                              cpu_profiler_test_source))->Run();
+  v8::Local<v8::Function> function = v8::Local<v8::Function>::Cast(
+      env->Global()->Get(v8::String::NewFromUtf8(isolate, "start")));
+  v8::Handle<v8::Value> args[] = { v8::Integer::New(isolate, 50) };
+
+  cpu_profiler->StartContinuousProfiling(100);
+  CHECK(iprofiler->is_profiling());
+
+  // A regular profile can be taken meanwhile and stopping it keeps the
+  // continuous mode running.
+  v8::Local<v8::String> profile_name = v8::String::NewFromUtf8(isolate, "p");
+  cpu_profiler->StartProfiling(profile_name);
+  cpu_profiler->StopProfiling(profile_name)->Delete();
+  CHECK(iprofiler->is_profiling());
+
+  i::Sampler* sampler =
+      reinterpret_cast<i::Isolate*>(isolate)->logger()->sampler();
+  sampler->StartCountingSamples();
+  do {
+    function->Call(env->Global(), arraysize(args), args);
+  } while (sampler->js_and_external_sample_count() < 20);
+
+  TestContinuousProfileVisitor visitor;
+  cpu_profiler->DrainContinuousProfile(&visitor);
+  CHECK_GT(visitor.stacks_count(), 0);
+  CHECK(iprofiler->is_profiling());
+
+  cpu_profiler->StopContinuousProfiling();
+  CHECK(!iprofiler->is_profiling());
+}
+
+
 static const char* hot_deopt_no_frame_entry_test_source =
 "function foo(a, b) {\n"
 "    try {\n"
@@ -685,6 +826,38 @@ TEST(CollectCpuProfileSamples) {
 }
 
 
+TEST(CollectCpuProfileWithCpuTimeSampling) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  v8::Script::Compile(v8::String::NewFromUtf8(env->GetIsolate(),
+                                              cpu_profiler_test_source))->Run();
+  v8::Local<v8::Function> function = v8::Local<v8::Function>::Cast(
+      env->Global()->Get(v8::String::NewFromUtf8(env->GetIsolate(), "start")));
+
+  v8::CpuProfiler* cpu_profiler = env->GetIsolate()->GetCpuProfiler();
+  cpu_profiler->SetCpuTimeSampling(true);
+  int32_t profiling_interval_ms = 200;
+  v8::Handle<v8::Value> args[] = {
+    v8::Integer::New(env->GetIsolate(), profiling_interval_ms)
+  };
+  v8::CpuProfile* profile =
+      RunProfiler(env.local(), function, args, arraysize(args), 100);
+  cpu_profiler->SetCpuTimeSampling(false);
+
+  i::Sampler* sampler =
+      reinterpret_cast<i::Isolate*>(env->GetIsolate())->logger()->sampler();
+  CHECK(!sampler->IsCpuTimeSampling());
+
+  const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+  const v8::CpuProfileNode* start_node =
+      GetChild(env->GetIsolate(), root, "start");
+  GetChild(env->GetIsolate(), start_node, "foo");
+
+  profile->Delete();
+}
+
+
 static const char* cpu_profiler_test_source2 = "function loop() {}\n"
 "function delay() { loop(); }\n"
 "function start(count) {\n"
@@ -40,10 +40,16 @@ class DateCacheMock: public DateCache {
   };
 
   DateCacheMock(int local_offset, Rule* rules, int rules_count)
-      : local_offset_(local_offset), rules_(rules), rules_count_(rules_count) {}
+      : local_offset_(local_offset),
+        rules_(rules),
+        rules_count_(rules_count),
+        os_calls_(0) {}
+
+  int os_calls() const { return os_calls_; }
 
  protected:
   virtual int GetDaylightSavingsOffsetFromOS(int64_t time_sec) {
+    os_calls_++;
     int days = DaysFromTime(time_sec * 1000);
     int time_in_day_sec = TimeInDay(time_sec * 1000, days) / 1000;
     int year, month, day;
@@ -97,6 +103,7 @@ class DateCacheMock: public DateCache {
   int local_offset_;
   Rule* rules_;
   int rules_count_;
+  int os_calls_;
 };
 
 static int64_t TimeFromYearMonthDay(DateCache* date_cache,
@@ -169,6 +176,44 @@ TEST(DaylightSavingsTime) {
 }
 
 
+TEST(DaylightSavingsTimeYearTables) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  DateCacheMock::Rule rules[] = {
+    {0, 2, 0, 10, 0, 3600},  // DST from March to November in any year.
+  };
+  DateCacheMock* mock = new DateCacheMock(0, rules, arraysize(rules));
+  reinterpret_cast<Isolate*>(isolate)->set_date_cache(mock);
+  DateCache* date_cache = mock;
+
+  // Visit a few days of ten years in turn, so that every lookup misses the
+  // segment cache.
+  int64_t expected[10][12];
+  for (int month = 0; month < 12; month++) {
+    for (int year = 0; year < 10; year++) {
+      int64_t time = TimeFromYearMonthDay(date_cache, 2000 + year, month, 1) +
+                     2 * 3600 * 1000;
+      expected[year][month] =
+          time + date_cache->GetDaylightSavingsOffsetFromOS(time / 1000);
+      CHECK_EQ(expected[year][month], date_cache->ToLocal(time));
+    }
+  }
+
+  // Every year has a transition table now, none of the lookups queries the
+  // OS anymore.
+  int os_calls = mock->os_calls();
+  for (int month = 11; month >= 0; month--) {
+    for (int year = 9; year >= 0; year--) {
+      int64_t time = TimeFromYearMonthDay(date_cache, 2000 + year, month, 1) +
+                     2 * 3600 * 1000;
+      CHECK_EQ(expected[year][month], date_cache->ToLocal(time));
+    }
+  }
+  CHECK_EQ(os_calls, mock->os_calls());
+}
+
+
 TEST(DateCacheVersion) {
   FLAG_allow_natives_syntax = true;
   v8::Isolate* isolate = CcTest::isolate();
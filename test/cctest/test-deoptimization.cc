@@ -38,12 +38,16 @@
 #include "test/cctest/cctest.h"
 
 using ::v8::base::OS;
+using ::v8::internal::DeoptimizationInputData;
 using ::v8::internal::Deoptimizer;
+using ::v8::internal::DependentCode;
 using ::v8::internal::EmbeddedVector;
 using ::v8::internal::Handle;
 using ::v8::internal::Isolate;
 using ::v8::internal::JSFunction;
+using ::v8::internal::Map;
 using ::v8::internal::Object;
+using ::v8::internal::Smi;
 
 // Size of temp buffer for formatting small strings.
 #define SMALL_STRING_BUFFER_SIZE 80
@@ -789,3 +793,98 @@ UNINITIALIZED_TEST(DeoptimizeLoadICStoreICNested) {
   isolate->Exit();
   isolate->Dispose();
 }
+
+
+static int deopt_event_count = 0;
+static v8::DeoptimizationEvent::Type deopt_event_type;
+static int deopt_event_line_number = 0;
+static int deopt_event_deopt_count = 0;
+static bool deopt_event_function_is_f = false;
+
+
+static void OnDeoptimization(v8::Isolate* isolate,
+                             const v8::DeoptimizationEvent& event) {
+  deopt_event_count++;
+  deopt_event_type = event.type();
+  deopt_event_line_number = event.line_number();
+  deopt_event_deopt_count = event.deopt_count();
+  deopt_event_function_is_f = event.function()->GetName()->Equals(v8_str("f"));
+}
+
+
+TEST(DeoptimizationCallback) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  if (!CcTest::i_isolate()->use_crankshaft()) return;
+  env->GetIsolate()->SetDeoptimizationCallback(OnDeoptimization);
+
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f(x) {\n"
+        "  return x + 1;\n"
+        "}\n"
+        "f(1); f(2);\n"
+        "%OptimizeFunctionOnNextCall(f);\n"
+        "f(3);\n"
+        "f('a');\n");
+  }
+
+  CHECK_EQ(1, deopt_event_count);
+  CHECK_EQ(v8::DeoptimizationEvent::kEager, deopt_event_type);
+  CHECK_EQ(2, deopt_event_line_number);
+  CHECK_EQ(1, deopt_event_deopt_count);
+  CHECK(deopt_event_function_is_f);
+  CHECK(!GetJSFunction(env->Global(), "f")->IsOptimized());
+
+  env->GetIsolate()->SetDeoptimizationCallback(NULL);
+}
+
+
+static void SetFieldTypeDependencies(Handle<JSFunction> function,
+                                     int descriptor) {
+  DeoptimizationInputData* data = DeoptimizationInputData::cast(
+      function->code()->deoptimization_data());
+  data->SetFieldTypeDependencies(
+      Smi::FromInt(DependentCode::FieldTypeMaskFor(descriptor)));
+}
+
+
+TEST(DeoptimizeFieldTypeDependentCodePerField) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  i::Isolate* isolate = CcTest::i_isolate();
+  if (!isolate->use_crankshaft()) return;
+
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f(x) { return x + 1; }\n"
+        "function g(x) { return x + 2; }\n"
+        "f(1); f(2); g(1); g(2);\n"
+        "%OptimizeFunctionOnNextCall(f);\n"
+        "%OptimizeFunctionOnNextCall(g);\n"
+        "f(3); g(3);\n");
+  }
+  Handle<JSFunction> f = GetJSFunction(env->Global(), "f");
+  Handle<JSFunction> g = GetJSFunction(env->Global(), "g");
+  CHECK(f->IsOptimized());
+  CHECK(g->IsOptimized());
+
+  SetFieldTypeDependencies(f, 0);
+  SetFieldTypeDependencies(g, 1);
+  Handle<Map> map = Map::Create(isolate, 0);
+  Map::AddDependentCode(map, DependentCode::kFieldTypeGroup,
+                        i::handle(f->code()));
+  Map::AddDependentCode(map, DependentCode::kFieldTypeGroup,
+                        i::handle(g->code()));
+
+  map->dependent_code()->DeoptimizeDependentFieldTypeCode(isolate, 1);
+  CHECK(f->IsOptimized());
+  CHECK(!g->IsOptimized());
+  CHECK(map->dependent_code()->Contains(DependentCode::kFieldTypeGroup,
+                                        f->code()));
+
+  map->dependent_code()->DeoptimizeDependentFieldTypeCode(isolate, 0);
+  CHECK(!f->IsOptimized());
+}
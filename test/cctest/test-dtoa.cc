@@ -264,6 +264,46 @@ TEST(DtoaVariousDoubles) {
 }
 
 
+TEST(DtoaShortestIntegers) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  int sign;
+  int length;
+  int point;
+
+  DoubleToAscii(7.0, DTOA_SHORTEST, 0, buffer, &sign, &length, &point);
+  CHECK_EQ("7", buffer.start());
+  CHECK_EQ(1, length);
+  CHECK_EQ(1, point);
+
+  DoubleToAscii(-1200.0, DTOA_SHORTEST, 0, buffer, &sign, &length, &point);
+  CHECK_EQ(1, sign);
+  CHECK_EQ("12", buffer.start());
+  CHECK_EQ(2, length);
+  CHECK_EQ(4, point);
+
+  DoubleToAscii(1234567890123.0, DTOA_SHORTEST, 0, buffer, &sign, &length,
+                &point);
+  CHECK_EQ("1234567890123", buffer.start());
+  CHECK_EQ(13, point);
+
+  DoubleToAscii(9007199254740991.0, DTOA_SHORTEST, 0, buffer, &sign, &length,
+                &point);
+  CHECK_EQ("9007199254740991", buffer.start());
+  CHECK_EQ(16, point);
+
+  DoubleToAscii(9007199254740992.0, DTOA_SHORTEST, 0, buffer, &sign, &length,
+                &point);
+  CHECK_EQ("9007199254740992", buffer.start());
+  CHECK_EQ(16, point);
+
+  // Larger integers are handled by FastDtoa.
+  DoubleToAscii(1e21, DTOA_SHORTEST, 0, buffer, &sign, &length, &point);
+  CHECK_EQ("1", buffer.start());
+  CHECK_EQ(22, point);
+}
+
+
 TEST(DtoaGayShortest) {
   char buffer_container[kBufferSize];
   Vector<char> buffer(buffer_container, kBufferSize);
@@ -123,3 +123,49 @@ TEST(RingBufferPushFront) {
   }
   CHECK_EQ(i, 8);  // one past last element.
 }
+
+
+static int gc_statistics_callback_count = 0;
+static v8::GCType gc_statistics_callback_type = v8::kGCTypeAll;
+
+
+static void OnGCStatistics(v8::Isolate* isolate,
+                           const v8::GCStatistics& statistics) {
+  gc_statistics_callback_count++;
+  gc_statistics_callback_type = statistics.type();
+}
+
+
+TEST(GCStatistics) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  isolate->SetGCStatisticsCallback(OnGCStatistics);
+
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(1, gc_statistics_callback_count);
+  CHECK_EQ(v8::kGCTypeScavenge, gc_statistics_callback_type);
+  v8::GCStatistics statistics;
+  CHECK(isolate->GetGCStatistics(&statistics));
+  CHECK_EQ(v8::kGCTypeScavenge, statistics.type());
+  CHECK(statistics.duration() >= 0);
+  CHECK(statistics.phase_duration(v8::GCStatistics::kScavengeRoots) <=
+        statistics.duration());
+  CHECK_EQ(0.0, statistics.phase_duration(v8::GCStatistics::kMark));
+  CHECK(statistics.survival_rate() >= 0);
+  CHECK(statistics.mutator_utilization() >= 0);
+  CHECK(statistics.mutator_utilization() <= 1);
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_EQ(2, gc_statistics_callback_count);
+  CHECK_EQ(v8::kGCTypeMarkSweepCompact, gc_statistics_callback_type);
+  CHECK(isolate->GetGCStatistics(&statistics));
+  CHECK_EQ(v8::kGCTypeMarkSweepCompact, statistics.type());
+  CHECK(statistics.phase_duration(v8::GCStatistics::kMark) <=
+        statistics.duration());
+  CHECK(statistics.freed_bytes() <= statistics.size_before());
+
+  isolate->SetGCStatisticsCallback(NULL);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(2, gc_statistics_callback_count);
+}
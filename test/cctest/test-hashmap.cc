@@ -175,3 +175,46 @@ TEST(Set) {
   TestSet(Hash, 100);
   TestSet(CollisionHash, 50);
 }
+
+
+static uint32_t IdentityHash(uint32_t key) { return key; }
+
+
+void TestInterleaved(IntKeyHash hash) {
+  // Insert and remove values out of order, so that runs of entries are
+  // repeatedly shifted forward on insertion and back on removal.
+  IntSet set(hash);
+  const int n = 64;
+  for (int round = 1; round <= 3; round++) {
+    for (int x = 1; x <= n; x++) set.Insert(x * round);
+    for (int x = 1; x <= n; x += 2) set.Remove(x * round);
+    for (int x = 1; x <= n; x++) {
+      CHECK_EQ(x % 2 == 0, set.Present(x * round));
+    }
+    CHECK_EQ(n / 2, static_cast<int>(set.occupancy()));
+    for (int x = 2; x <= n; x += 2) set.Remove(x * round);
+    CHECK_EQ(0, set.occupancy());
+  }
+}
+
+
+TEST(InterleavedInsertRemove) {
+  TestInterleaved(Hash);
+  TestInterleaved(CollisionHash);
+  TestInterleaved(IdentityHash);
+}
+
+
+TEST(InsertionOrder) {
+  HashMap map(DefaultMatchFun);
+  const int n = 100;
+  for (int i = 1; i <= n; i++) {
+    HashMap::Entry* p =
+        map.Lookup(reinterpret_cast<void*>(i), CollisionHash(i), true);
+    CHECK_EQ(i - 1, p->order);
+  }
+  for (HashMap::Entry* p = map.Start(); p != NULL; p = map.Next(p)) {
+    int key = static_cast<int>(reinterpret_cast<intptr_t>(p->key));
+    CHECK_EQ(key - 1, p->order);
+  }
+}
@@ -996,6 +996,78 @@ TEST(HeapSnapshotJSONSerialization) {
 }
 
 
+TEST(HeapSnapshotStreaming) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('streamed string');\n"
+      "var b = new B(a);");
+  int snapshots_count = heap_profiler->GetSnapshotCount();
+  TestJSONStream stream;
+  CHECK(heap_profiler->StreamHeapSnapshot(&stream, v8_str("streamed")));
+  CHECK_EQ(snapshots_count, heap_profiler->GetSnapshotCount());
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternal(env->GetIsolate(), json_res);
+  env->Global()->Set(v8_str("json_snapshot"), json_string);
+  CompileRun(
+      "var parsed = JSON.parse(json_snapshot);\n"
+      "var meta = parsed.snapshot.meta;\n"
+      "var node_fields_count = meta.node_fields.length;\n"
+      "var edge_fields_count = meta.edge_fields.length;\n"
+      "var edge_count_offset = meta.node_fields.indexOf('edge_count');\n"
+      "var edge_name_offset = meta.edge_fields.indexOf('name_or_index');\n"
+      "var edge_to_node_offset = meta.edge_fields.indexOf('to_node');\n"
+      "var node_count = parsed.nodes.length / node_fields_count;\n"
+      "var first_edge_indexes = [];\n"
+      "for (var i = 0, first_edge_index = 0; i < node_count; ++i) {\n"
+      "  first_edge_indexes[i] = first_edge_index;\n"
+      "  first_edge_index += edge_fields_count *\n"
+      "      parsed.nodes[i * node_fields_count + edge_count_offset];\n"
+      "}\n"
+      "first_edge_indexes[node_count] = first_edge_index;\n"
+      "function GetChild(pos, name) {\n"
+      "  var node_ordinal = pos / node_fields_count;\n"
+      "  for (var i = first_edge_indexes[node_ordinal];\n"
+      "       i < first_edge_indexes[node_ordinal + 1];\n"
+      "       i += edge_fields_count) {\n"
+      "    var edges = parsed.edges;\n"
+      "    if (parsed.strings[edges[i + edge_name_offset]] === name)\n"
+      "      return edges[i + edge_to_node_offset];\n"
+      "  }\n"
+      "  return null;\n"
+      "}\n");
+  // The edges that are only counted while the entries are created have to
+  // match the edges written afterwards.
+  CHECK(CompileRun("node_count === parsed.snapshot.node_count")->IsTrue());
+  CHECK(CompileRun(
+      "first_edge_index === parsed.edges.length &&\n"
+      "first_edge_index === parsed.snapshot.edge_count * edge_fields_count")
+      ->IsTrue());
+  CHECK(CompileRun(
+      "parsed.edges.every(function(value, i) {\n"
+      "  return i % edge_fields_count != edge_to_node_offset ||\n"
+      "      (value % node_fields_count == 0 &&\n"
+      "       value < parsed.nodes.length);\n"
+      "})")->IsTrue());
+  // <root> -> <global>.b.x.s
+  v8::Local<v8::Value> string_name = CompileRun(
+      "var global = parsed.edges[edge_fields_count + edge_to_node_offset];\n"
+      "var s = GetChild(GetChild(GetChild(global, 'b'), 'x'), 's');\n"
+      "parsed.strings[parsed.nodes[s + 1]];");
+  CHECK_EQ("streamed string", *v8::String::Utf8Value(string_name));
+}
+
+
 TEST(HeapSnapshotJSONSerializationAborting) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -2804,3 +2876,79 @@ TEST(AddressToTraceMap) {
   CHECK_EQ(0, static_cast<int>(map.size()));
   CHECK_EQ(0, map.GetTraceNodeId(ToAddress(0x400)));
 }
+
+
+class SampledAllocationCounter : public v8::SampledAllocationVisitor {
+ public:
+  explicit SampledAllocationCounter(const char* function_name)
+      : function_name_(function_name), live_count_(0), live_size_(0) {}
+
+  virtual void VisitStack(const v8::SampledAllocationFrame* frames,
+                          int frame_count, unsigned live_count,
+                          size_t live_size) {
+    for (int i = 0; i < frame_count; i++) {
+      if (strcmp(frames[i].function_name, function_name_) != 0) continue;
+      CHECK_GT(frames[i].line_number, 0);
+      live_count_ += live_count;
+      live_size_ += live_size;
+      return;
+    }
+  }
+
+  unsigned live_count() const { return live_count_; }
+  size_t live_size() const { return live_size_; }
+
+ private:
+  const char* function_name_;
+  unsigned live_count_;
+  size_t live_size_;
+};
+
+
+static const char* sampled_allocation_source =
+"function Point(x, y) {\n"
+"  this.x = x;\n"
+"  this.y = y;\n"
+"}\n"
+"function allocatePoints() {\n"
+"  var points = [];\n"
+"  for (var i = 0; i < 100000; i++) points.push(new Point(i, i));\n"
+"  return points;\n"
+"}\n"
+"var points = allocatePoints();\n";
+
+
+TEST(SamplingHeapProfiler) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  heap_profiler->StartSamplingHeapProfiler(1024);
+  CHECK(reinterpret_cast<i::HeapProfiler*>(heap_profiler)
+            ->is_sampling_allocations());
+
+  CompileRun(sampled_allocation_source);
+
+  {
+    SampledAllocationCounter counter("allocatePoints");
+    heap_profiler->GetSampledAllocations(&counter);
+    CHECK_GT(counter.live_count(), 0);
+    CHECK_GE(counter.live_size(), counter.live_count() * i::kPointerSize);
+  }
+
+  // The samples go away with the objects.
+  CompileRun("points = null;");
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  {
+    SampledAllocationCounter counter("allocatePoints");
+    heap_profiler->GetSampledAllocations(&counter);
+    CHECK_EQ(0, counter.live_count());
+  }
+
+  heap_profiler->StopSamplingHeapProfiler();
+  CHECK(!reinterpret_cast<i::HeapProfiler*>(heap_profiler)
+             ->is_sampling_allocations());
+  SampledAllocationCounter counter("allocatePoints");
+  heap_profiler->GetSampledAllocations(&counter);
+  CHECK_EQ(0, counter.live_count());
+}
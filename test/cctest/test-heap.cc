@@ -34,6 +34,7 @@
 #include "src/execution.h"
 #include "src/factory.h"
 #include "src/global-handles.h"
+#include "src/heap/slot-set.h"
 #include "src/ic/ic.h"
 #include "src/macro-assembler.h"
 #include "test/cctest/cctest.h"
@@ -597,6 +598,39 @@ TEST(StringTable) {
 }
 
 
+TEST(StringTableShrinksAfterGC) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  v8::HandleScope sc(CcTest::isolate());
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  int initial_capacity = heap->string_table()->Capacity();
+
+  const int kStrings = 100000;
+  {
+    HandleScope scope(isolate);
+    for (int i = 0; i < kStrings; i++) {
+      HandleScope inner_scope(isolate);
+      EmbeddedVector<char, 32> buffer;
+      SNPrintF(buffer, "transient-%d", i);
+      factory->InternalizeUtf8String(buffer.start());
+    }
+  }
+  int grown_capacity = heap->string_table()->Capacity();
+  CHECK_GT(grown_capacity, initial_capacity);
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_GT(heap->string_table()->NumberOfDeletedElements(), 0);
+  Handle<String> string = factory->InternalizeUtf8String("after-gc");
+  CHECK(string->IsInternalizedString());
+  CHECK_LT(heap->string_table()->Capacity(), grown_capacity);
+  CHECK_EQ(0, heap->string_table()->NumberOfDeletedElements());
+  CHECK_EQ(*string, *factory->InternalizeUtf8String("after-gc"));
+  CheckInternalizedStrings(not_so_random_string_table);
+}
+
+
 TEST(FunctionAllocation) {
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
@@ -1172,6 +1206,51 @@ TEST(TestCodeFlushingPreAged) {
 }
 
 
+TEST(TestCodeFlushingPreAgedWithoutOptimizeForSize) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_optimize_for_size = false;
+  i::FLAG_pre_age_code = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source = "function foo() {"
+                       "  var x = 42;"
+                       "  var y = 42;"
+                       "  var z = x + y;"
+                       "};"
+                       "foo()";
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+  { v8::HandleScope scope(CcTest::isolate());
+    CompileRun(source);
+  }
+
+  Handle<Object> func_value =
+      Object::GetProperty(isolate->global_object(), foo_name).ToHandleChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+  CHECK(function->shared()->is_compiled());
+
+  // Code run only once is gone after two GCs.
+  CcTest::heap()->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(function->shared()->is_compiled());
+  CHECK(!function->shared()->code_flushed());
+  CcTest::heap()->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  if (function->IsOptimized()) return;
+  CHECK(!function->shared()->is_compiled());
+  CHECK(function->shared()->code_flushed());
+
+  // Call foo to get it recompiled.
+  CompileRun("foo()");
+  CHECK(function->shared()->is_compiled());
+  CHECK(function->is_compiled());
+  CHECK(!function->shared()->code_flushed());
+}
+
+
 TEST(TestCodeFlushingIncremental) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code || !FLAG_flush_code_incrementally) return;
@@ -2898,6 +2977,30 @@ TEST(TransitionArraySimpleToFull) {
 #endif  // DEBUG
 
 
+TEST(EmptyTransitionArrayIsDropped) {
+  i::FLAG_stress_compaction = false;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CompileRun("function F() {}");
+  CompileRun("var o = new F; o.a = 1; o.b = 2;");
+  CompileRun("var root = new F;");
+  Handle<JSObject> root = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Object>::Cast(CcTest::global()->Get(v8_str("root"))));
+  Handle<Map> map(root->map());
+  CHECK_EQ(1, CountMapTransitions(*map));
+
+  // Once the only transition target dies, the map keeps its back pointer
+  // instead of an empty transition array.
+  CompileRun("o = null;");
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK(!map->HasTransitionArray());
+  CHECK(map->GetBackPointer()->IsUndefined());
+
+  CompileRun("root.c = 3;");
+  CHECK_EQ(1, CountMapTransitions(*map));
+}
+
+
 TEST(Regress2143a) {
   i::FLAG_collect_maps = true;
   i::FLAG_incremental_marking = true;
@@ -3147,10 +3250,11 @@ TEST(IncrementalMarkingClearsTypeFeedbackInfo) {
 
   Handle<TypeFeedbackVector> feedback_vector(f->shared()->feedback_vector());
 
-  int expected_length = FLAG_vector_ics ? 4 : 2;
+  const int kFirstSlot = TypeFeedbackVector::kReservedIndexCount;
+  int expected_length = kFirstSlot + (FLAG_vector_ics ? 4 : 2);
   CHECK_EQ(expected_length, feedback_vector->length());
-  for (int i = 0; i < expected_length; i++) {
-    if ((i % 2) == 1) {
+  for (int i = kFirstSlot; i < expected_length; i++) {
+    if (((i - kFirstSlot) % 2) == 1) {
       CHECK(feedback_vector->get(i)->IsJSFunction());
     }
   }
@@ -3159,7 +3263,7 @@ TEST(IncrementalMarkingClearsTypeFeedbackInfo) {
   CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
 
   CHECK_EQ(expected_length, feedback_vector->length());
-  for (int i = 0; i < expected_length; i++) {
+  for (int i = kFirstSlot; i < expected_length; i++) {
     CHECK_EQ(feedback_vector->get(i),
              *TypeFeedbackVector::UninitializedSentinel(CcTest::i_isolate()));
   }
@@ -3814,6 +3918,250 @@ TEST(IncrementalMarkingStepMakesBigProgressWithLargeObjects) {
 }
 
 
+TEST(ParallelIncrementalMarking) {
+  i::FLAG_parallel_incremental_marking = true;
+  i::FLAG_parallel_marking_tasks = 3;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CompileRun(
+      "var roots = [];"
+      "for (var i = 0; i < 500; i++) {"
+      "  var list = null;"
+      "  for (var j = 0; j < 50; j++) {"
+      "    list = { next: list, value: 'v' + j, data: [j, j + 0.5] };"
+      "  }"
+      "  roots.push(list);"
+      "}");
+  SimulateIncrementalMarking(CcTest::heap());
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  v8::Local<v8::Value> result = CompileRun(
+      "var sum = 0;"
+      "for (var i = 0; i < roots.length; i++) {"
+      "  for (var list = roots[i]; list; list = list.next) {"
+      "    sum += list.data[1];"
+      "  }"
+      "}"
+      "sum;");
+  CHECK_EQ(500.0 * (49 * 50 / 2 + 25), result->NumberValue());
+}
+
+
+TEST(BlackAllocation) {
+  i::FLAG_black_allocation = true;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  if (collector->sweeping_in_progress()) {
+    collector->EnsureSweepingCompleted();
+  }
+  IncrementalMarking* marking = heap->incremental_marking();
+  if (marking->IsStopped()) marking->Start();
+  CHECK(marking->IsMarking());
+
+  // Pointer-free objects start out black, in paged and large object space.
+  Handle<ByteArray> small = factory->NewByteArray(100, TENURED);
+  CHECK(Marking::IsBlack(Marking::MarkBitFrom(*small)));
+  Handle<ByteArray> large =
+      factory->NewByteArray(Page::kMaxRegularHeapObjectSize + KB, TENURED);
+  CHECK(heap->lo_space()->Contains(*large));
+  CHECK(Marking::IsBlack(Marking::MarkBitFrom(*large)));
+
+  // Objects with pointers are left to the marker.
+  Handle<FixedArray> pointers = factory->NewFixedArray(100, TENURED);
+  CHECK(Marking::IsWhite(Marking::MarkBitFrom(*pointers)));
+
+  SimulateIncrementalMarking(heap);
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_EQ(100, small->length());
+  CHECK_EQ(Page::kMaxRegularHeapObjectSize + KB, large->length());
+}
+
+
+static int near_heap_limit_callback_count = 0;
+
+
+static size_t RaiseHeapLimit(void* data, size_t current_heap_limit,
+                             size_t initial_heap_limit) {
+  CHECK_EQ(&near_heap_limit_callback_count, data);
+  CHECK(current_heap_limit >= initial_heap_limit);
+  near_heap_limit_callback_count++;
+  return current_heap_limit + 8 * MB;
+}
+
+
+UNINITIALIZED_TEST(NearHeapLimitCallback) {
+  v8::Isolate::CreateParams create_params;
+  create_params.constraints.set_max_old_space_size(8);
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    Factory* factory = i_isolate->factory();
+    intptr_t initial_limit = heap->MaxOldGenerationSize();
+    isolate->SetNearHeapLimitCallback(RaiseHeapLimit,
+                                      &near_heap_limit_callback_count);
+
+    // Keep twice the initial limit alive.
+    static const int kArrayLength = 8 * KB;
+    int arrays = static_cast<int>(
+        2 * initial_limit / FixedArray::SizeFor(kArrayLength));
+    Handle<FixedArray> holder = factory->NewFixedArray(arrays, TENURED);
+    for (int i = 0; i < arrays; i++) {
+      Handle<FixedArray> array = factory->NewFixedArray(kArrayLength, TENURED);
+      holder->set(i, *array);
+    }
+    CHECK(near_heap_limit_callback_count > 0);
+    CHECK(heap->MaxOldGenerationSize() > initial_limit);
+
+    v8::HeapStatistics statistics;
+    isolate->GetHeapStatistics(&statistics);
+    CHECK(statistics.heap_size_limit() >
+          static_cast<size_t>(heap->MaxOldGenerationSize()));
+    isolate->SetNearHeapLimitCallback(NULL, NULL);
+  }
+  isolate->Dispose();
+}
+
+
+TEST(ParallelScavenge) {
+  i::FLAG_parallel_scavenge = true;
+  i::FLAG_parallel_scavenge_tasks = 3;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Spread old-to-new pointers over several pages and force all of them to
+  // be scanned instead of using the store buffer.
+  static const int kArrays = 400;
+  static const int kArrayLength = 1000;
+  Handle<FixedArray> arrays[kArrays];
+  for (int i = 0; i < kArrays; i++) {
+    arrays[i] = factory->NewFixedArray(kArrayLength, TENURED);
+    arrays[i]->set(i % kArrayLength, *factory->NewHeapNumber(i));
+  }
+  for (int i = 0; i < kArrays; i++) {
+    MemoryChunk::FromAddress(arrays[i]->address())->set_scan_on_scavenge(true);
+  }
+  heap->CollectGarbage(NEW_SPACE);
+
+  for (int i = 0; i < kArrays; i++) {
+    Object* number = arrays[i]->get(i % kArrayLength);
+    CHECK(!heap->InFromSpace(number));
+    CHECK_EQ(static_cast<double>(i), number->Number());
+  }
+}
+
+
+TEST(StoreBufferSlotSets) {
+  i::FLAG_store_buffer_slot_sets = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Record enough old-to-new pointers to overflow the store buffer several
+  // times, including slots past the first page of a large object.
+  static const int kArrays = 20;
+  static const int kArrayLength = 1000;
+  static const int kLargeArrayLength = 200000;
+  Handle<FixedArray> arrays[kArrays];
+  for (int i = 0; i < kArrays; i++) {
+    arrays[i] = factory->NewFixedArray(kArrayLength, TENURED);
+  }
+  Handle<FixedArray> large = factory->NewFixedArray(kLargeArrayLength, TENURED);
+  CHECK(heap->lo_space()->Contains(*large));
+  for (int i = 0; i < kArrays; i++) {
+    for (int j = 0; j < kArrayLength; j++) {
+      arrays[i]->set(j, *factory->NewHeapNumber(i * kArrayLength + j));
+    }
+  }
+  for (int j = 0; j < kLargeArrayLength; j += 100) {
+    large->set(j, *factory->NewHeapNumber(j));
+  }
+
+  heap->CollectGarbage(NEW_SPACE);
+  // Survivors stay in new space after their first scavenge, so their slots
+  // must still be recorded.
+  Object** last_slot = large->data_start() + kLargeArrayLength - 100;
+  if (heap->InNewSpace(*last_slot)) {
+    SlotSet* slot_set = MemoryChunk::FromAddress(large->address())->slot_set();
+    CHECK(slot_set != NULL);
+    CHECK(slot_set->Contains(reinterpret_cast<Address>(last_slot)));
+  }
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+
+  for (int i = 0; i < kArrays; i++) {
+    for (int j = 0; j < kArrayLength; j++) {
+      Object* number = arrays[i]->get(j);
+      CHECK(!heap->InFromSpace(number));
+      CHECK_EQ(static_cast<double>(i * kArrayLength + j), number->Number());
+    }
+  }
+  for (int j = 0; j < kLargeArrayLength; j += 100) {
+    CHECK_EQ(static_cast<double>(j), large->get(j)->Number());
+  }
+}
+
+
+TEST(IncrementalLargeObjectGC) {
+  i::FLAG_incremental_large_object_gc = true;
+  CcTest::InitializeVM();
+  if (!i::FLAG_incremental_marking) return;
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  int ms_count = static_cast<int>(heap->ms_count());
+
+  // Allocate large garbage until the old generation limit is hit. Reaching
+  // it must start incremental marking instead of an atomic full GC.
+  static const int kLength = 1 * MB;
+  for (int i = 0; i < 1000 && heap->incremental_marking()->IsStopped(); i++) {
+    v8::HandleScope scope(CcTest::isolate());
+    factory->NewRawOneByteString(kLength).ToHandleChecked();
+  }
+  CHECK(!heap->incremental_marking()->IsStopped());
+  CHECK_EQ(ms_count, static_cast<int>(heap->ms_count()));
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK(heap->incremental_marking()->IsStopped());
+}
+
+
+TEST(PromoteOnHighSurvivalRate) {
+  i::FLAG_promote_on_high_survival_rate = true;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+
+  // Everything allocated in new space survives the first scavenge, so the
+  // second one promotes its survivors without copying them to to-space.
+  static const int kLength = 1000;
+  Handle<FixedArray> first = factory->NewFixedArray(kLength, TENURED);
+  for (int i = 0; i < kLength; i++) first->set(i, *factory->NewFixedArray(8));
+  heap->CollectGarbage(NEW_SPACE);
+
+  Handle<FixedArray> second = factory->NewFixedArray(kLength, TENURED);
+  for (int i = 0; i < kLength; i++) second->set(i, *factory->NewFixedArray(8));
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) {
+    CHECK(!heap->InNewSpace(second->get(i)));
+    CHECK_EQ(8, FixedArray::cast(second->get(i))->length());
+  }
+}
+
+
 TEST(DisableInlineAllocation) {
   i::FLAG_allow_natives_syntax = true;
   CcTest::InitializeVM();
@@ -4502,6 +4850,63 @@ TEST(Regress388880) {
 }
 
 
+TEST(DescriptorLookupCacheSurvivesScavenge) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  DescriptorLookupCache* cache = isolate->descriptor_lookup_cache();
+
+  Handle<String> name = factory->InternalizeUtf8String("foo");
+  Handle<Map> map =
+      Map::CopyWithField(Map::Create(isolate, 1), name, HeapType::Any(isolate),
+                         NONE, Representation::Tagged(),
+                         OMIT_TRANSITION).ToHandleChecked();
+  CHECK_EQ(0, map->instance_descriptors()->SearchWithCache(*name, *map));
+  CHECK_EQ(0, cache->Lookup(*map, *name));
+
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(0, cache->Lookup(*map, *name));
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_EQ(DescriptorLookupCache::kAbsent, cache->Lookup(*map, *name));
+}
+
+
+#ifdef VERIFY_HEAP
+TEST(ParallelAndSampledHeapVerification) {
+  i::FLAG_verify_heap = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+
+  // Spread live objects over several old space pages.
+  Handle<FixedArray> holder = factory->NewFixedArray(64, TENURED);
+  for (int i = 0; i < holder->length(); i++) {
+    holder->set(i, *factory->NewFixedArray(4 * KB, TENURED));
+  }
+  CHECK_LT(2, heap->old_pointer_space()->CountTotalPages());
+
+  i::FLAG_parallel_verify_heap = true;
+  heap->Verify();
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+
+  i::FLAG_verify_heap_sample_pages = 1;
+  for (int i = 0; i < 4; i++) {
+    heap->Verify();
+    heap->CollectGarbage(NEW_SPACE);
+  }
+
+  i::FLAG_parallel_verify_heap = false;
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  i::FLAG_verify_heap_sample_pages = 0;
+}
+#endif  // VERIFY_HEAP
+
+
 #ifdef DEBUG
 TEST(PathTracer) {
   CcTest::InitializeVM();
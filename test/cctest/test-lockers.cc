@@ -416,6 +416,33 @@ TEST(LockerUnlocker) {
   isolate->Dispose();
 }
 
+// An Unlocker only archives the thread's state if there is any.
+TEST(UnlockWithoutArchiving) {
+  v8::Isolate* isolate = v8::Isolate::New();
+  i::ThreadManager* thread_manager =
+      reinterpret_cast<i::Isolate*>(isolate)->thread_manager();
+  {
+    v8::Locker locker(isolate);
+    {
+      v8::Unlocker unlocker(isolate);
+      CHECK(!thread_manager->IsArchived());
+    }
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    CalcFibAndCheck();
+    {
+      v8::Unlocker unlocker(isolate);
+      CHECK(thread_manager->IsArchived());
+    }
+    CHECK(!thread_manager->IsArchived());
+    CalcFibAndCheck();
+  }
+  isolate->Dispose();
+}
+
+
 class LockTwiceAndUnlockThread : public JoinableThread {
  public:
   explicit LockTwiceAndUnlockThread(v8::Isolate* isolate)
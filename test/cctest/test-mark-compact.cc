@@ -200,6 +200,71 @@ TEST(MarkCompactCollector) {
 }
 
 
+TEST(ParallelMarking) {
+  FLAG_parallel_marking = true;
+  FLAG_parallel_marking_tasks = 3;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Build a graph that mixes objects handled by the parallel markers with
+  // objects that are deferred to the main thread.
+  CompileRun(
+      "var roots = [];"
+      "for (var i = 0; i < 200; i++) {"
+      "  var list = null;"
+      "  for (var j = 0; j < 100; j++) {"
+      "    list = { next: list, value: 'v' + i + '_' + j, f: function() {} };"
+      "  }"
+      "  roots.push([list, new Array(50), i * 0.5]);"
+      "}");
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  // Compacting collections make the parallel markers defer slot recording.
+  FLAG_always_compact = true;
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+
+  v8::Local<v8::Value> result = CompileRun(
+      "var count = 0;"
+      "for (var i = 0; i < roots.length; i++) {"
+      "  for (var list = roots[i][0]; list; list = list.next) {"
+      "    if (typeof list.f === 'function') count++;"
+      "  }"
+      "}"
+      "count + roots[199][2];");
+  CHECK_EQ(200 * 100 + 99.5, result->NumberValue());
+}
+
+
+TEST(ParallelPointerUpdate) {
+  if (FLAG_never_compact) return;
+  FLAG_parallel_pointer_update = true;
+  FLAG_parallel_pointer_update_tasks = 3;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Fragment old space so that compaction evacuates pages whose objects are
+  // referenced from many other pages.
+  CompileRun(
+      "var keep = [];"
+      "var drop = [];"
+      "for (var i = 0; i < 20000; i++) {"
+      "  var o = { index: i, name: 'o' + i };"
+      "  if (i % 4 == 0) keep.push(o); else drop.push(o);"
+      "}");
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  CompileRun("drop = null;");
+  FLAG_always_compact = true;
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+
+  v8::Local<v8::Value> result = CompileRun(
+      "var sum = 0;"
+      "for (var i = 0; i < keep.length; i++) {"
+      "  if (keep[i].name === 'o' + keep[i].index) sum += keep[i].index;"
+      "}"
+      "sum;");
+  CHECK_EQ(4.0 * (4999 * 5000 / 2), result->NumberValue());
+}
+
+
 // TODO(1600): compaction of map space is temporary removed from GC.
 #if 0
 static Handle<Map> CreateMap(Isolate* isolate) {
@@ -176,4 +176,42 @@ TEST(Map) {
 }
 
 
+TEST(CanonicalKeys) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+
+  // Integral numbers hash like the equal Smi.
+  Handle<Object> smi(Smi::FromInt(42), isolate);
+  Handle<Object> number = factory->NewHeapNumber(42);
+  Handle<Object> zero(Smi::FromInt(0), isolate);
+  Handle<Object> minus_zero = factory->NewHeapNumber(-0.0);
+  CHECK(number->IsHeapNumber());
+  CHECK_EQ(smi->GetHash(), number->GetHash());
+  CHECK_EQ(zero->GetHash(), minus_zero->GetHash());
+
+  // Such numbers are stored as Smis, and strings are internalized.
+  Handle<OrderedHashMap> ordered_map = factory->NewOrderedHashMap();
+  Handle<String> string = factory->NewStringFromAsciiChecked("key");
+  CHECK(!string->IsInternalizedString());
+  ordered_map = OrderedHashMap::Put(ordered_map, number, string);
+  ordered_map = OrderedHashMap::Put(ordered_map, string, number);
+  CHECK(ordered_map->KeyAt(0)->IsSmi());
+  CHECK(ordered_map->KeyAt(1)->IsInternalizedString());
+  CHECK(ordered_map->Lookup(smi)->SameValue(*string));
+  CHECK(ordered_map->Lookup(factory->InternalizeUtf8String("key"))
+            ->SameValue(*number));
+  CHECK(ordered_map->Lookup(string)->SameValue(*number));
+
+  Handle<OrderedHashSet> ordered_set = factory->NewOrderedHashSet();
+  ordered_set = OrderedHashSet::Add(ordered_set, minus_zero);
+  ordered_set = OrderedHashSet::Add(ordered_set, string);
+  CHECK_EQ(Smi::FromInt(0), ordered_set->KeyAt(0));
+  CHECK(ordered_set->KeyAt(1)->IsInternalizedString());
+  CHECK(ordered_set->Contains(zero));
+  CHECK(ordered_set->Contains(string));
+}
+
+
 }
@@ -32,6 +32,7 @@
 #include "src/v8.h"
 
 #include "src/ast-value-factory.h"
+#include "src/compilation-cache.h"
 #include "src/compiler.h"
 #include "src/execution.h"
 #include "src/isolate.h"
@@ -239,6 +240,41 @@ TEST(UsingCachedData) {
 }
 
 
+TEST(ParserDataCacheAcrossContexts) {
+  i::FLAG_min_preparse_length = 0;
+  i::FLAG_cache_parser_data = true;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  i::CompilationCache* compilation_cache =
+      CcTest::i_isolate()->compilation_cache();
+
+  const char* source =
+      "function lazy(a) { return function inner(b) { return a + b; }; }"
+      "function other() { return lazy(40)(2); }"
+      "other();";
+  i::Handle<i::String> i_source =
+      CcTest::i_isolate()->factory()->NewStringFromAsciiChecked(source);
+  CHECK(compilation_cache->LookupParserData(i_source) == NULL);
+
+  // Different script names keep the script cache from sharing the compiled
+  // code, so the second compilation parses again using the cached data.
+  const char* names[] = {"first.js", "second.js"};
+  for (int i = 0; i < 2; i++) {
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::ScriptOrigin origin(v8_str(names[i]));
+    v8::ScriptCompiler::Source script_source(v8_str(source), origin);
+    v8::Local<v8::Script> script =
+        v8::ScriptCompiler::Compile(isolate, &script_source);
+    CHECK_EQ(42, script->Run()->Int32Value());
+    CHECK(compilation_cache->LookupParserData(i_source) != NULL);
+  }
+
+  compilation_cache->Clear();
+  CHECK(compilation_cache->LookupParserData(i_source) == NULL);
+}
+
+
 TEST(PreparseFunctionDataIsUsed) {
   // This tests that we actually do use the function data generated by the
   // preparser.
@@ -547,6 +583,12 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
       i::Handle<i::ExternalTwoByteString>::cast(uc16_string), start, end);
   i::GenericStringUtf16CharacterStream string_stream(one_byte_string, start,
                                                      end);
+  ScriptResource one_byte_resource(one_byte_source, length);
+  i::Handle<i::String> external_string(
+      factory->NewExternalStringFromOneByte(&one_byte_resource)
+          .ToHandleChecked());
+  i::ExternalOneByteStringUtf16CharacterStream external_stream(
+      i::Handle<i::ExternalOneByteString>::cast(external_string), start, end);
   i::Utf8ToUtf16CharacterStream utf8_stream(
       reinterpret_cast<const i::byte*>(one_byte_source), end);
   utf8_stream.SeekForward(start);
@@ -556,17 +598,21 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
+    int32_t c4 = external_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
+    CHECK_EQ(c0, c4);
     CHECK_EQ(c0, c3);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
   while (i > start + sub_length / 4) {
@@ -574,64 +620,80 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     int32_t c0 = one_byte_source[i - 1];
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
+    external_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
+    int32_t c4 = external_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
+    CHECK_EQ(c0, c4);
     CHECK_EQ(c0, c3);
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
+    external_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
   unsigned halfway = start + sub_length / 2;
   uc16_stream.SeekForward(halfway - i);
   string_stream.SeekForward(halfway - i);
+  external_stream.SeekForward(halfway - i);
   utf8_stream.SeekForward(halfway - i);
   i = halfway;
   CHECK_EQU(i, uc16_stream.pos());
   CHECK_EQU(i, string_stream.pos());
+  CHECK_EQU(i, external_stream.pos());
   CHECK_EQU(i, utf8_stream.pos());
 
   while (i < end) {
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
+    int32_t c4 = external_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
+    CHECK_EQ(c0, c4);
     CHECK_EQ(c0, c3);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, external_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
 
   int32_t c1 = uc16_stream.Advance();
   int32_t c2 = string_stream.Advance();
+  int32_t c4 = external_stream.Advance();
   int32_t c3 = utf8_stream.Advance();
   CHECK_LT(c1, 0);
   CHECK_LT(c2, 0);
+  CHECK_LT(c4, 0);
   CHECK_LT(c3, 0);
 }
 
@@ -4087,3 +4149,44 @@ TEST(ObjectLiteralPropertyShorthandYieldInGeneratorError) {
   RunParserSyncTest(context_data, name_data, kError, NULL, 0,
                     always_flags, arraysize(always_flags));
 }
+
+
+TEST(UnaryFunctionHints) {
+  // Function expressions behind a unary operator are most likely called right
+  // away and are parsed eagerly, like parenthesized ones.
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::Factory* factory = isolate->factory();
+  i::HandleScope scope(isolate);
+  LocalContext env;
+
+  struct { const char* source; bool eager; } tests[] = {
+    { "(function f() { function g() {} })();", true },
+    { "!function f() { function g() {} }();", true },
+    { "+function f() { function g() {} }();", true },
+    { "void function f() { function g() {} }();", true },
+    { "var x = function f() { function g() {} };", false },
+    { "typeof function f() { function g() {} };", false },
+    { "!x, function f() { function g() {} };", false },
+  };
+
+  for (unsigned i = 0; i < arraysize(tests); ++i) {
+    i::Handle<i::String> source =
+        factory->InternalizeUtf8String(tests[i].source);
+    i::Handle<i::Script> script = factory->NewScript(source);
+    i::CompilationInfoWithZone info(script);
+    i::Parser::ParseInfo parse_info = {
+        isolate->stack_guard()->real_climit(),
+        isolate->heap()->HashSeed(), isolate->unicode_cache()};
+    i::Parser parser(&info, &parse_info);
+    parser.set_allow_lazy(true);
+    parser.set_allow_unary_function_hints(true);
+    CHECK(parser.Parse());
+    CHECK(info.function() != NULL);
+
+    // Only an eagerly parsed f has seen the scope of g.
+    i::Scope* scope = info.function()->scope();
+    CHECK_EQ(1, scope->inner_scopes()->length());
+    i::Scope* function_scope = scope->inner_scopes()->at(0);
+    CHECK_EQ(tests[i].eager ? 1 : 0, function_scope->inner_scopes()->length());
+  }
+}
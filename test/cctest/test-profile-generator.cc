@@ -380,6 +380,29 @@ TEST(CodeMapMoveAndDeleteCode) {
 }
 
 
+TEST(CodeMapCachedLookups) {
+  CodeMap code_map;
+  CodeEntry entry1(i::Logger::FUNCTION_TAG, "aaa");
+  CodeEntry entry2(i::Logger::FUNCTION_TAG, "bbb");
+  code_map.AddCode(ToAddress(0x1500), &entry1, 0x200);
+  for (int i = 0; i < 3; i++) {
+    i::Address start = NULL;
+    CHECK_EQ(&entry1, code_map.FindEntry(ToAddress(0x1510), &start));
+    CHECK_EQ(ToAddress(0x1500), start);
+  }
+  // Nearby addresses outside of the code are not cached as hits.
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1500 - 1)));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1700)));
+  // Code replacing cached code is found at once.
+  code_map.AddCode(ToAddress(0x1508), &entry2, 0x10);
+  CHECK_EQ(&entry2, code_map.FindEntry(ToAddress(0x1510)));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1500)));
+  code_map.MoveCode(ToAddress(0x1508), ToAddress(0x1600));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1510)));
+  CHECK_EQ(&entry2, code_map.FindEntry(ToAddress(0x1600)));
+}
+
+
 namespace {
 
 class TestSetup {
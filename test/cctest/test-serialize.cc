@@ -228,6 +228,27 @@ UNINITIALIZED_TEST(SerializeTwice) {
 }
 
 
+// Test that a startup blob can be created for a context running custom code.
+UNINITIALIZED_TEST(CreateSnapshotDataBlob) {
+  v8::StartupData data = v8::V8::CreateSnapshotDataBlob(
+      "var framework = { version: 42, f: function() { return 1; } };");
+  CHECK(data.data != NULL);
+  CHECK_LT(0, data.raw_size);
+  CHECK_EQ(data.raw_size, data.compressed_size);
+
+  v8::StartupData plain = v8::V8::CreateSnapshotDataBlob();
+  CHECK(plain.data != NULL);
+  CHECK_LT(plain.raw_size, data.raw_size);
+  DeleteArray(plain.data);
+  DeleteArray(data.data);
+
+  // Scripts that throw do not produce a blob.
+  v8::StartupData failed = v8::V8::CreateSnapshotDataBlob("throw 1;");
+  CHECK(failed.data == NULL);
+  CHECK_EQ(0, failed.raw_size);
+}
+
+
 //----------------------------------------------------------------------------
 // Tests that the heap can be deserialized.
 
@@ -1162,3 +1183,226 @@ TEST(SerializeToplevelIsolates) {
   }
   isolate2->Dispose();
 }
+
+
+static AllocationSite* FirstLiteralAllocationSite(
+    v8::Local<v8::Context> context, const char* name) {
+  Handle<JSFunction> f = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*context->Global()->Get(v8_str(name))));
+  FixedArray* literals = f->literals();
+  for (int i = JSFunction::kLiteralsPrefixSize; i < literals->length(); i++) {
+    if (literals->get(i)->IsAllocationSite()) {
+      return AllocationSite::cast(literals->get(i));
+    }
+  }
+  return NULL;
+}
+
+
+TEST(SerializePretenuringDecisions) {
+  FLAG_serialize_toplevel = true;
+  FLAG_allocation_site_pretenuring = true;
+
+  const char* source = "function f() { return [1, 2, {}]; }; f();";
+  v8::ScriptCompiler::CachedData* cache;
+  v8::ScriptCompiler::CachedData* pretenuring_data;
+
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate1, &source, v8::ScriptCompiler::kProduceCodeCache);
+    const v8::ScriptCompiler::CachedData* data = source.GetCachedData();
+    uint8_t* buffer = NewArray<uint8_t>(data->length);
+    MemCopy(buffer, data->data, data->length);
+    cache = new v8::ScriptCompiler::CachedData(
+        buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+
+    script->BindToCurrentContext()->Run();
+    AllocationSite* site = FirstLiteralAllocationSite(context, "f");
+    CHECK(site != NULL);
+    // Pretend the feedback told us to tenure the literal.
+    site->set_pretenure_decision(AllocationSite::kTenure);
+    pretenuring_data = v8::ScriptCompiler::CreatePretenuringData(script);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache);
+    CHECK(v8::ScriptCompiler::ConsumePretenuringData(script,
+                                                     pretenuring_data));
+
+    // Truncated data is rejected.
+    v8::ScriptCompiler::CachedData truncated(pretenuring_data->data,
+                                             pretenuring_data->length - 1);
+    CHECK(!v8::ScriptCompiler::ConsumePretenuringData(script, &truncated));
+
+    // So is data produced by a different V8 version. The version hash is the
+    // second entry.
+    uint8_t* buffer = NewArray<uint8_t>(pretenuring_data->length);
+    MemCopy(buffer, pretenuring_data->data, pretenuring_data->length);
+    reinterpret_cast<int*>(buffer)[1]++;
+    v8::ScriptCompiler::CachedData other_version(
+        buffer, pretenuring_data->length,
+        v8::ScriptCompiler::CachedData::BufferOwned);
+    CHECK(!v8::ScriptCompiler::ConsumePretenuringData(script, &other_version));
+
+    script->BindToCurrentContext()->Run();
+    AllocationSite* site = FirstLiteralAllocationSite(context, "f");
+    CHECK(site != NULL);
+    CHECK_EQ(AllocationSite::kTenure, site->pretenure_decision());
+  }
+  isolate2->Dispose();
+  delete pretenuring_data;
+}
+
+
+static Handle<SharedFunctionInfo> GlobalFunctionInfo(
+    v8::Local<v8::Context> context, const char* name) {
+  Handle<JSFunction> function = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*context->Global()->Get(v8_str(name))));
+  return Handle<SharedFunctionInfo>(function->shared());
+}
+
+
+TEST(SerializeTieringHints) {
+  FLAG_serialize_toplevel = true;
+
+  const char* source =
+      "function f(x) { return x + 1; }"
+      "function g(x) { return x - 1; }"
+      "f(1) + g(1);";
+  v8::ScriptCompiler::CachedData* cache;
+  v8::ScriptCompiler::CachedData* tiering_data;
+
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate1, &source, v8::ScriptCompiler::kProduceCodeCache);
+    const v8::ScriptCompiler::CachedData* data = source.GetCachedData();
+    uint8_t* buffer = NewArray<uint8_t>(data->length);
+    MemCopy(buffer, data->data, data->length);
+    cache = new v8::ScriptCompiler::CachedData(
+        buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+
+    script->BindToCurrentContext()->Run();
+    Handle<SharedFunctionInfo> f = GlobalFunctionInfo(context, "f");
+    CHECK(!f->code()->hot_in_previous_run());
+    // Pretend the runtime profiler optimized f.
+    f->set_opt_count(1);
+    tiering_data = v8::ScriptCompiler::CreateTieringData(script);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache);
+    CHECK(v8::ScriptCompiler::ConsumeTieringData(script, tiering_data));
+
+    // Truncated data is rejected.
+    v8::ScriptCompiler::CachedData truncated(tiering_data->data,
+                                             tiering_data->length - 1);
+    CHECK(!v8::ScriptCompiler::ConsumeTieringData(script, &truncated));
+
+    script->BindToCurrentContext()->Run();
+    Handle<SharedFunctionInfo> f = GlobalFunctionInfo(context, "f");
+    Handle<SharedFunctionInfo> g = GlobalFunctionInfo(context, "g");
+    CHECK(f->HasTieringHint());
+    CHECK(!g->HasTieringHint());
+    CHECK(f->code()->hot_in_previous_run());
+    CHECK(!g->code()->hot_in_previous_run());
+  }
+  isolate2->Dispose();
+  delete tiering_data;
+}
+
+
+TEST(SerializeToplevelCompiledFunctions) {
+  FLAG_serialize_toplevel = true;
+
+  const char* source =
+      "function f() { return g() + 'c'; }"
+      "function g() { return 'ab'; }"
+      "function h() { return 'unused'; }"
+      "f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache;
+
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnbound(isolate1, &source);
+    v8::Local<v8::Value> result = script->BindToCurrentContext()->Run();
+    CHECK(result->ToString()->Equals(v8_str("abcdef")));
+    cache = v8::ScriptCompiler::CreateCodeCache(script);
+    CHECK(cache != NULL);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::Value> result;
+    {
+      // Neither the script nor the functions it calls need to be compiled.
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+          isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache);
+      result = script->BindToCurrentContext()->Run();
+    }
+    CHECK(result->ToString()->Equals(v8_str("abcdef")));
+
+    Handle<JSFunction> h = Handle<JSFunction>::cast(
+        v8::Utils::OpenHandle(*context->Global()->Get(v8_str("h"))));
+    CHECK(!h->shared()->is_compiled());
+  }
+  isolate2->Dispose();
+}
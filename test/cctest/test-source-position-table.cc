@@ -0,0 +1,88 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/source-position-table.h"
+#include "test/cctest/cctest.h"
+
+using namespace v8::internal;
+
+
+static int CodeOffsetFor(int i) { return i * (i + 1) / 2; }
+
+
+static int SourcePositionFor(int i) {
+  // Move back and forth, with some large jumps, to exercise negative deltas
+  // and multi-byte values.
+  int position = 1000 + (i % 7) * 300 - (i % 3) * 1000;
+  if (i % 10 == 0) position += 100000;
+  return position;
+}
+
+
+TEST(EncodeDecode) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+
+  const int kEntries = 100;
+  SourcePositionTableBuilder builder;
+  for (int i = 0; i < kEntries; i++) {
+    builder.AddPosition(CodeOffsetFor(i), SourcePositionFor(i), i % 2 == 0);
+  }
+  Handle<ByteArray> table = builder.ToSourcePositionTable(isolate);
+
+  SourcePositionTableIterator it(*table);
+  for (int i = 0; i < kEntries; i++) {
+    CHECK(!it.done());
+    CHECK_EQ(CodeOffsetFor(i), it.code_offset());
+    CHECK_EQ(SourcePositionFor(i), it.source_position());
+    CHECK_EQ(i % 2 == 0, it.is_statement());
+    it.Advance();
+  }
+  CHECK(it.done());
+}
+
+
+TEST(EmptyTable) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+
+  SourcePositionTableBuilder builder;
+  Handle<ByteArray> table = builder.ToSourcePositionTable(isolate);
+  CHECK(table.is_identical_to(isolate->factory()->empty_byte_array()));
+  SourcePositionTableIterator it(*table);
+  CHECK(it.done());
+}
+
+
+TEST(CompiledCodeHasTable) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source =
+      "function f(a) {\n"
+      "  var b = a + 1;\n"
+      "  return b * 2;\n"
+      "}\n"
+      "f(1);\n";
+  CompileRun(source);
+  Handle<JSFunction> f = v8::Utils::OpenHandle(*v8::Handle<v8::Function>::Cast(
+      CcTest::global()->Get(v8_str("f"))));
+  Code* code = f->shared()->code();
+  ByteArray* table = code->source_position_table();
+  CHECK_NE(isolate->heap()->empty_byte_array(), table);
+
+  int length = static_cast<int>(strlen(source));
+  int statements = 0;
+  for (SourcePositionTableIterator it(table); !it.done(); it.Advance()) {
+    CHECK_LE(it.code_offset(), code->instruction_size());
+    CHECK_LE(it.source_position(), length);
+    if (it.is_statement()) statements++;
+  }
+  CHECK_LT(0, statements);
+}
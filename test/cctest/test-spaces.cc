@@ -236,6 +236,48 @@ TEST(Regress3540) {
 }
 
 
+TEST(CodePagePooling) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(
+      memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize()));
+  TestMemoryAllocatorScope test_allocator_scope(isolate, memory_allocator);
+  CodeRange* code_range = new CodeRange(isolate);
+  if (!code_range->SetUp(8 * MB)) {
+    delete code_range;
+    memory_allocator->TearDown();
+    delete memory_allocator;
+    return;
+  }
+  TestCodeRangeScope test_code_range_scope(isolate, code_range);
+
+  OldSpace faked_space(heap, heap->MaxReserved(), CODE_SPACE, EXECUTABLE);
+  Page* page = memory_allocator->AllocatePage(faked_space.AreaSize(),
+                                              &faked_space, EXECUTABLE);
+  CHECK(page != NULL);
+  Address address = page->address();
+  intptr_t size = memory_allocator->Size();
+  memory_allocator->Free(page);
+  CHECK_EQ(1, memory_allocator->PooledCodePageCount());
+  CHECK_EQ(0, static_cast<int>(memory_allocator->SizeExecutable()));
+
+  // The next regular code page reuses the pooled one.
+  page = memory_allocator->AllocatePage(faked_space.AreaSize(), &faked_space,
+                                        EXECUTABLE);
+  CHECK(page != NULL);
+  CHECK_EQ(address, page->address());
+  CHECK_EQ(size, memory_allocator->Size());
+  CHECK_EQ(0, memory_allocator->PooledCodePageCount());
+
+  memory_allocator->Free(page);
+  memory_allocator->TearDown();
+  CHECK_EQ(0, memory_allocator->PooledCodePageCount());
+  delete memory_allocator;
+  delete code_range;
+}
+
+
 static unsigned int Pseudorandom() {
   static uint32_t lo = 2345;
   lo = 18273 * (lo & 0xFFFFF) + (lo >> 16);
@@ -456,3 +498,24 @@ TEST(SizeOfFirstPageIsLargeEnough) {
   // No large objects required to perform the above steps.
   CHECK(isolate->heap()->lo_space()->IsEmpty());
 }
+
+
+TEST(FreeListSizeClasses) {
+  // Size classes cover the sizes kept on the free list without gaps.
+  int min_size = FreeList::SizeClassMin(0);
+  CHECK_EQ(0x20 * kPointerSize, min_size);
+  for (int i = 1; i < FreeList::kNumberOfSizeClasses; i++) {
+    CHECK_LT(FreeList::SizeClassMin(i - 1), FreeList::SizeClassMin(i));
+  }
+  for (int size = min_size; size < 0x8000 * kPointerSize;
+       size += kPointerSize) {
+    int index = FreeList::SizeClassFor(size);
+    CHECK_LE(FreeList::SizeClassMin(index), size);
+    if (index < FreeList::kHugeSizeClass) {
+      CHECK_LT(size, FreeList::SizeClassMin(index + 1));
+    }
+  }
+  CHECK_EQ(FreeList::kHugeSizeClass,
+           FreeList::SizeClassFor(Page::kMaxRegularHeapObjectSize));
+}
+
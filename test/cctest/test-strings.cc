@@ -1095,6 +1095,61 @@ TEST(CachedHashOverflow) {
 }
 
 
+TEST(LongStringHash) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope handle_scope(CcTest::isolate());
+
+  // Long enough to be hashed in blocks past the prefix, with a partial
+  // block at the end.
+  const int kLength = String::kMaxHashCalcLength + 1001;
+  i::ScopedVector<uint8_t> buffer(kLength);
+  Vector<const uint8_t> chars(buffer.start(), kLength);
+  for (int i = 0; i < kLength; i++) buffer[i] = 'a' + i % 26;
+  Handle<String> one_byte =
+      factory->NewStringFromOneByte(chars).ToHandleChecked();
+  buffer[kLength - 1] = '!';
+  Handle<String> last_differs =
+      factory->NewStringFromOneByte(chars).ToHandleChecked();
+  buffer[kLength - 1] = 'a' + (kLength - 1) % 26;
+  CHECK(one_byte->Hash() != last_differs->Hash());
+
+  // The hash does not depend on the representation.
+  Handle<SeqTwoByteString> two_byte =
+      factory->NewRawTwoByteString(kLength).ToHandleChecked();
+  CopyChars(two_byte->GetChars(), chars.start(), kLength);
+  CHECK(one_byte->Hash() == two_byte->Hash());
+  int splits[] = { 100, String::kMaxHashCalcLength,
+                   String::kMaxHashCalcLength + 3 };
+  for (size_t i = 0; i < arraysize(splits); i++) {
+    Handle<String> first = factory->NewSubString(one_byte, 0, splits[i]);
+    Handle<String> second =
+        factory->NewSubString(two_byte, splits[i], kLength);
+    Handle<String> cons =
+        factory->NewConsString(first, second).ToHandleChecked();
+    CHECK(one_byte->Hash() == cons->Hash());
+  }
+
+  // UTF-8 input is hashed the same, also with a surrogate pair across the
+  // end of the prefix.
+  const int kPrefix = String::kMaxHashCalcLength - 1;
+  i::ScopedVector<char> utf8_buffer(kPrefix + 4 + 100);
+  Vector<const char> utf8(utf8_buffer.start(), utf8_buffer.length());
+  for (int i = 0; i < kPrefix; i++) utf8_buffer[i] = 'x';
+  utf8_buffer[kPrefix] = '\xf0';
+  utf8_buffer[kPrefix + 1] = '\x9f';
+  utf8_buffer[kPrefix + 2] = '\x98';
+  utf8_buffer[kPrefix + 3] = '\x80';
+  for (int i = kPrefix + 4; i < utf8.length(); i++) utf8_buffer[i] = 'y';
+  Handle<String> decoded = factory->NewStringFromUtf8(utf8).ToHandleChecked();
+  Handle<String> internalized = factory->InternalizeUtf8String(utf8);
+  CHECK_EQ(kPrefix + 2 + 100, internalized->length());
+  CHECK(decoded->Hash() == internalized->Hash());
+  CHECK(String::Equals(decoded, internalized));
+}
+
+
 TEST(SliceFromCons) {
   FLAG_string_slices = true;
   CcTest::InitializeVM();
@@ -372,6 +372,21 @@ TEST(Strtod) {
 }
 
 
+TEST(StrtodLongExactInputs) {
+  // Up to 19 digits whose value fits into the significand of a double.
+  CHECK_EQ(1234567890123.456, StrtodChar("1234567890123456", -3));
+  CHECK_EQ(9007199254740992.0, StrtodChar("9007199254740992", 0));
+  CHECK_EQ(9.007199254740992e-7, StrtodChar("9007199254740992", -22));
+  CHECK_EQ(9.007199254740992e37, StrtodChar("9007199254740992", 22));
+  CHECK_EQ(17976931348.62315, StrtodChar("1797693134862315", -5));
+  CHECK_EQ(0.1, StrtodChar("1000000000000000000", -19));
+  // Values too large for the significand.
+  CHECK_EQ(123456789012.34567, StrtodChar("12345678901234567", -5));
+  CHECK_EQ(9007199254740992.0, StrtodChar("9007199254740993", 0));
+  CHECK_EQ(9007199254740996.0, StrtodChar("9007199254740995", 0));
+}
+
+
 static int CompareBignumToDiyFp(const Bignum& bignum_digits,
                                 int bignum_exponent,
                                 DiyFp diy_fp) {
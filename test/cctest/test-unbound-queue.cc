@@ -75,3 +75,61 @@ TEST(MultipleRecords) {
   }
   CHECK(cq.IsEmpty());
 }
+
+
+namespace {
+
+typedef int Record;
+
+class UnboundQueueProducer : public v8::base::Thread {
+ public:
+  UnboundQueueProducer(UnboundQueue<Record>* queue, Record first, int count)
+      : Thread(Options("producer")),
+        queue_(queue),
+        first_(first),
+        count_(count) {}
+
+  virtual void Run() {
+    for (Record i = first_; i < first_ + count_; ++i) queue_->Enqueue(i);
+  }
+
+ private:
+  UnboundQueue<Record>* queue_;
+  Record first_;
+  int count_;
+};
+
+}  // namespace
+
+
+TEST(MultipleProducers) {
+  // Several producers enqueue concurrently while the main thread consumes.
+  // The records of each producer have to arrive in order, none lost.
+  const int kProducers = 4;
+  const int kRecordsPerProducer = 10000;
+  UnboundQueue<Record> cq;
+  UnboundQueueProducer* producers[kProducers];
+  Record expected[kProducers];
+  for (int i = 0; i < kProducers; ++i) {
+    expected[i] = i * kRecordsPerProducer;
+    producers[i] = new UnboundQueueProducer(&cq, expected[i],
+                                            kRecordsPerProducer);
+  }
+  for (int i = 0; i < kProducers; ++i) producers[i]->Start();
+
+  int received = 0;
+  while (received < kProducers * kRecordsPerProducer) {
+    Record rec;
+    if (!cq.Dequeue(&rec)) continue;
+    int producer = rec / kRecordsPerProducer;
+    CHECK_EQ(expected[producer], rec);
+    expected[producer]++;
+    received++;
+  }
+  CHECK(cq.IsEmpty());
+
+  for (int i = 0; i < kProducers; ++i) {
+    producers[i]->Join();
+    delete producers[i];
+  }
+}
@@ -254,3 +254,41 @@ TEST(CPlusPlus11Features) {
     j += 11;
   }
 }
+
+
+TEST(ZoneSegmentPool) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  ZoneSegmentPool* pool = isolate->zone_segment_pool();
+  pool->ReleaseAll();
+  pool->set_max_pooled_bytes(4 * MB);
+
+  static const int kAllocationSize = 100 * KB;
+  {
+    Zone zone(isolate);
+    zone.New(kAllocationSize);
+  }
+  size_t pooled = pool->pooled_bytes();
+  CHECK(pooled >= static_cast<size_t>(kAllocationSize));
+
+  {
+    // A zone of the same shape is served from the pool.
+    Zone zone(isolate);
+    zone.New(kAllocationSize);
+    CHECK(pool->pooled_bytes() < pooled);
+  }
+  CHECK_EQ(static_cast<int>(pooled), static_cast<int>(pool->pooled_bytes()));
+
+  // Nothing beyond the limit is retained.
+  pool->ReleaseAll();
+  pool->set_max_pooled_bytes(16 * KB);
+  {
+    Zone zone(isolate);
+    zone.New(kAllocationSize);
+  }
+  CHECK(pool->pooled_bytes() <= static_cast<size_t>(16 * KB));
+
+  pool->ReleaseAll();
+  CHECK_EQ(0, static_cast<int>(pool->pooled_bytes()));
+  pool->set_max_pooled_bytes(0);
+}
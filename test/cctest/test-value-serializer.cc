@@ -0,0 +1,305 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/v8.h"
+
+#include "test/cctest/cctest.h"
+
+
+static std::vector<uint8_t> Serialize(
+    v8::Handle<v8::Value> value,
+    v8::ValueSerializer::Delegate* delegate = NULL) {
+  v8::ValueSerializer serializer(CcTest::isolate(), delegate);
+  serializer.WriteHeader();
+  CHECK(serializer.WriteValue(value));
+  return std::vector<uint8_t>(serializer.Data(),
+                              serializer.Data() + serializer.Size());
+}
+
+
+static v8::Local<v8::Value> Deserialize(
+    const std::vector<uint8_t>& data,
+    v8::ValueDeserializer::Delegate* delegate = NULL) {
+  v8::ValueDeserializer deserializer(CcTest::isolate(), &data[0], data.size(),
+                                     delegate);
+  CHECK(deserializer.ReadHeader());
+  return deserializer.ReadValue();
+}
+
+
+// Serializes the result of |source|, stores the copy as |result| and checks
+// that |expectation| evaluates to true.
+static void CheckRoundTrip(const char* source, const char* expectation) {
+  v8::Local<v8::Value> copy = Deserialize(Serialize(CompileRun(source)));
+  CHECK(!copy.IsEmpty());
+  CcTest::global()->Set(v8_str("result"), copy);
+  CHECK(CompileRun(expectation)->BooleanValue());
+}
+
+
+TEST(ValueSerializerPrimitives) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("undefined", "result === undefined");
+  CheckRoundTrip("null", "result === null");
+  CheckRoundTrip("true", "result === true");
+  CheckRoundTrip("false", "result === false");
+  CheckRoundTrip("-42", "result === -42");
+  CheckRoundTrip("0x7fffffff", "result === 0x7fffffff");
+  CheckRoundTrip("-0", "1 / result === -Infinity");
+  CheckRoundTrip("0.5", "result === 0.5");
+  CheckRoundTrip("NaN", "isNaN(result)");
+  CheckRoundTrip("'abc'", "result === 'abc'");
+  CheckRoundTrip("''", "result === ''");
+  CheckRoundTrip("'\\u00e9\\u20ac'", "result === '\\u00e9\\u20ac'");
+  CheckRoundTrip("new Array(101).join('bc')",
+                 "result === new Array(101).join('bc')");
+}
+
+
+TEST(ValueSerializerObjects) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("({ a: 1, b: 'x', c: { d: [true] } })",
+                 "result.a === 1 && result.b === 'x' &&"
+                 "result.c.d.length === 1 && result.c.d[0] === true");
+  CheckRoundTrip("({ 1: 'one', a: 'a' })",
+                 "JSON.stringify(result) === '{\"1\":\"one\",\"a\":\"a\"}'");
+  CheckRoundTrip("var o = {}; Object.defineProperty(o, 'x', { value: 1 }); o",
+                 "!('x' in result)");
+  CheckRoundTrip("({ get a() { return 3; } })",
+                 "Object.getOwnPropertyDescriptor(result, 'a').value === 3");
+  CheckRoundTrip("new Date(1e12)",
+                 "result instanceof Date && result.getTime() === 1e12");
+}
+
+
+TEST(ValueSerializerArrays) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("[1, 2.5, 'three']",
+                 "result.length === 3 && result[1] === 2.5 &&"
+                 "result[2] === 'three'");
+  CheckRoundTrip("[1, , 3]", "result.length === 3 && !(1 in result)");
+  CheckRoundTrip("var a = [1]; a.x = 'y'; a",
+                 "result.length === 1 && result.x === 'y'");
+  CheckRoundTrip("var a = []; a[1000000] = 1; a",
+                 "result.length === 1000001 && result[1000000] === 1 &&"
+                 "Object.keys(result).length === 1");
+}
+
+
+TEST(ValueSerializerIdentity) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("var o = {}; o.self = o; o", "result.self === result");
+  CheckRoundTrip("var o = {}; [o, o]", "result[0] === result[1]");
+  CheckRoundTrip("var a = []; a.push(a); a", "result[0] === result");
+}
+
+
+TEST(ValueSerializerMapsAndSets) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("var m = new Map(); m.set(1, 'a'); m.set('b', {}); m",
+                 "result instanceof Map && result.size === 2 &&"
+                 "result.get(1) === 'a' &&"
+                 "typeof result.get('b') === 'object'");
+  CheckRoundTrip("var m = new Map(); m.set(m, m); m",
+                 "result.get(result) === result");
+  CheckRoundTrip("new Set([3, 'x', 3])",
+                 "result instanceof Set && result.size === 2 &&"
+                 "result.has(3) && result.has('x')");
+}
+
+
+TEST(ValueSerializerArrayBuffers) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("new Uint8Array([1, 2, 3]).buffer",
+                 "result instanceof ArrayBuffer && result.byteLength === 3 &&"
+                 "new Uint8Array(result)[2] === 3");
+  CheckRoundTrip("new Int16Array([-1, 2, 3]).subarray(1)",
+                 "result instanceof Int16Array && result.length === 2 &&"
+                 "result[0] === 2 && result.buffer.byteLength === 6");
+  CheckRoundTrip("var b = new ArrayBuffer(8); [new Uint8Array(b), "
+                 "new DataView(b, 4)]",
+                 "result[0].buffer === result[1].buffer &&"
+                 "result[1] instanceof DataView && result[1].byteOffset === 4");
+  CheckRoundTrip("var v = new Float64Array([0.5]); [v, v]",
+                 "result[0] === result[1] && result[0][0] === 0.5");
+}
+
+
+TEST(ValueSerializerTransferArrayBuffer) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Value> value = CompileRun(
+      "var buffer = new ArrayBuffer(4); new Uint8Array(buffer, 1)");
+  v8::Local<v8::ArrayBuffer> buffer =
+      CcTest::global()->Get(v8_str("buffer")).As<v8::ArrayBuffer>();
+
+  v8::ValueSerializer serializer(isolate);
+  serializer.WriteHeader();
+  serializer.TransferArrayBuffer(7, buffer);
+  CHECK(serializer.WriteValue(value));
+
+  // The data refers to the buffer by id, so it does not hold its contents.
+  CHECK_LT(static_cast<int>(serializer.Size()), 16);
+
+  v8::Local<v8::ArrayBuffer> other = v8::ArrayBuffer::New(isolate, 4);
+  v8::ValueDeserializer deserializer(isolate, serializer.Data(),
+                                     serializer.Size());
+  CHECK(deserializer.ReadHeader());
+  deserializer.TransferArrayBuffer(7, other);
+  v8::Local<v8::Value> copy = deserializer.ReadValue();
+  CHECK(copy->IsUint8Array());
+  CHECK(copy.As<v8::Uint8Array>()->Buffer() == other);
+  CHECK_EQ(1, static_cast<int>(copy.As<v8::Uint8Array>()->ByteOffset()));
+}
+
+
+class HostObjectDelegate : public v8::ValueSerializer::Delegate,
+                           public v8::ValueDeserializer::Delegate {
+ public:
+  explicit HostObjectDelegate(v8::Handle<v8::ObjectTemplate> templ)
+      : templ_(templ), serializer_(NULL), deserializer_(NULL) {}
+
+  void set_deserializer(v8::ValueDeserializer* deserializer) {
+    deserializer_ = deserializer;
+  }
+
+  void set_serializer(v8::ValueSerializer* serializer) {
+    serializer_ = serializer;
+  }
+
+  virtual bool WriteHostObject(v8::Isolate* isolate,
+                               v8::Local<v8::Object> object) {
+    serializer_->WriteUint32(object->GetInternalField(0)->Uint32Value());
+    return true;
+  }
+
+  virtual v8::Local<v8::Object> ReadHostObject(v8::Isolate* isolate) {
+    uint32_t value;
+    if (!deserializer_->ReadUint32(&value)) return v8::Local<v8::Object>();
+    v8::Local<v8::Object> object = templ_->NewInstance();
+    object->SetInternalField(0, v8::Integer::NewFromUnsigned(isolate, value));
+    return object;
+  }
+
+ private:
+  v8::Handle<v8::ObjectTemplate> templ_;
+  v8::ValueSerializer* serializer_;
+  v8::ValueDeserializer* deserializer_;
+};
+
+
+TEST(ValueSerializerHostObjects) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::ObjectTemplate> templ = v8::ObjectTemplate::New(isolate);
+  templ->SetInternalFieldCount(1);
+  v8::Local<v8::Object> host = templ->NewInstance();
+  host->SetInternalField(0, v8::Integer::New(isolate, 42));
+  CcTest::global()->Set(v8_str("host"), host);
+  v8::Local<v8::Value> value = CompileRun("({ a: host, b: host })");
+
+  HostObjectDelegate delegate(templ);
+  v8::ValueSerializer serializer(isolate, &delegate);
+  delegate.set_serializer(&serializer);
+  serializer.WriteHeader();
+  CHECK(serializer.WriteValue(value));
+
+  v8::ValueDeserializer deserializer(isolate, serializer.Data(),
+                                     serializer.Size(), &delegate);
+  delegate.set_deserializer(&deserializer);
+  CHECK(deserializer.ReadHeader());
+  v8::Local<v8::Object> copy = deserializer.ReadValue().As<v8::Object>();
+  v8::Local<v8::Object> copied_host = copy->Get(v8_str("a")).As<v8::Object>();
+  CHECK(copied_host != host);
+  CHECK(copied_host == copy->Get(v8_str("b")));
+  CHECK_EQ(42, copied_host->GetInternalField(0)->Int32Value());
+
+  // Without a delegate host objects cannot be written.
+  v8::TryCatch try_catch;
+  v8::ValueSerializer plain_serializer(isolate);
+  CHECK(!plain_serializer.WriteValue(host));
+  CHECK(try_catch.HasCaught());
+}
+
+
+TEST(ValueSerializerDataCloneError) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  const char* sources[] = {
+    "(function() {})", "Symbol()", "/x/", "new Number(1)",
+    "({ a: [function() {}] })", "new WeakMap()",
+  };
+  for (size_t i = 0; i < arraysize(sources); i++) {
+    v8::TryCatch try_catch;
+    v8::ValueSerializer serializer(isolate);
+    CHECK(!serializer.WriteValue(CompileRun(sources[i])));
+    CHECK(try_catch.HasCaught());
+  }
+
+  // Exceptions thrown by getters are passed on.
+  v8::TryCatch try_catch;
+  v8::ValueSerializer serializer(isolate);
+  CHECK(!serializer.WriteValue(
+      CompileRun("({ get a() { throw 'in getter'; } })")));
+  CHECK(try_catch.HasCaught());
+  CHECK(try_catch.Exception()->Equals(v8_str("in getter")));
+}
+
+
+TEST(ValueDeserializerMalformedData) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  std::vector<uint8_t> data =
+      Serialize(CompileRun("({ a: [1, 'two', new Map([[3, {}]])] })"));
+
+  // Every truncation of the data is rejected.
+  for (size_t length = 0; length < data.size(); length++) {
+    v8::TryCatch try_catch;
+    std::vector<uint8_t> truncated(data.begin(), data.begin() + length);
+    truncated.push_back(0);
+    v8::ValueDeserializer deserializer(isolate, &truncated[0], length);
+    CHECK(!deserializer.ReadHeader() || deserializer.ReadValue().IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+
+  // Unknown versions, tags and object references are rejected.
+  const uint8_t bad_version[] = { 0xFF, 0x7F, '_' };
+  const uint8_t bad_tag[] = { 0xFF, 0x01, 'z' };
+  const uint8_t bad_reference[] = { 0xFF, 0x01, 'o', '"', 0x01, 'a', '^',
+                                    0x05, '{', 0x01 };
+  {
+    v8::TryCatch try_catch;
+    v8::ValueDeserializer deserializer(isolate, bad_version,
+                                       sizeof(bad_version));
+    CHECK(!deserializer.ReadHeader());
+    CHECK(try_catch.HasCaught());
+  }
+  {
+    v8::TryCatch try_catch;
+    v8::ValueDeserializer deserializer(isolate, bad_tag, sizeof(bad_tag));
+    CHECK(deserializer.ReadHeader());
+    CHECK(deserializer.ReadValue().IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+  {
+    v8::TryCatch try_catch;
+    v8::ValueDeserializer deserializer(isolate, bad_reference,
+                                       sizeof(bad_reference));
+    CHECK(deserializer.ReadHeader());
+    CHECK(deserializer.ReadValue().IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+}
@@ -272,3 +272,46 @@ TEST(Regress399527) {
   // marking bits which makes the weak map garbage.
   heap->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
 }
+
+
+// Test that entries whose keys only become reachable through the values of
+// other entries, possibly in other weak maps, are kept alive.
+TEST(EphemeronChains) {
+  FLAG_incremental_marking = false;
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  Handle<JSWeakMap> weakmap1 = AllocateJSWeakMap(isolate);
+  Handle<JSWeakMap> weakmap2 = AllocateJSWeakMap(isolate);
+  GlobalHandles* global_handles = isolate->global_handles();
+
+  // Build a chain key[0] -> key[1] -> ... where each link lives in one of the
+  // two weak maps. Only the first key is held strongly.
+  const int kLength = 100;
+  Handle<Object> first;
+  {
+    HandleScope scope(isolate);
+    Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    Handle<JSObject> key = factory->NewJSObjectFromMap(map);
+    first = global_handles->Create(*key);
+    for (int i = 0; i < kLength; i++) {
+      Handle<JSObject> next = factory->NewJSObjectFromMap(map);
+      PutIntoWeakMap(i % 2 == 0 ? weakmap1 : weakmap2, key, next);
+      key = next;
+    }
+  }
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_EQ(kLength / 2,
+           ObjectHashTable::cast(weakmap1->table())->NumberOfElements());
+  CHECK_EQ(kLength / 2,
+           ObjectHashTable::cast(weakmap2->table())->NumberOfElements());
+
+  // Once the first key is gone the whole chain is garbage.
+  GlobalHandles::Destroy(first.location());
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_EQ(0, ObjectHashTable::cast(weakmap1->table())->NumberOfElements());
+  CHECK_EQ(0, ObjectHashTable::cast(weakmap2->table())->NumberOfElements());
+}
@@ -0,0 +1,44 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Intl objects with the same settings share ICU objects, but each keeps its
+// own resolved options.
+
+var nf1 = new Intl.NumberFormat('en-US', {style: 'percent'});
+var nf2 = new Intl.NumberFormat('en-US', {style: 'percent'});
+var nf3 = new Intl.NumberFormat('en-US', {maximumFractionDigits: 1});
+assertEquals('50%', nf1.format(0.5));
+assertEquals('50%', nf2.format(0.5));
+assertEquals('0.5', nf3.format(0.5));
+assertEquals(nf1.resolvedOptions().locale, nf2.resolvedOptions().locale);
+assertEquals('percent', nf2.resolvedOptions().style);
+nf1.resolved.locale = 'xx';
+assertFalse(nf2.resolvedOptions().locale === 'xx');
+assertFalse(new Intl.NumberFormat('en-US', {style: 'percent'})
+    .resolvedOptions().locale === 'xx');
+
+var c1 = new Intl.Collator('en', {sensitivity: 'base'});
+var c2 = new Intl.Collator('en', {sensitivity: 'base'});
+assertEquals(0, c1.compare('a', 'A'));
+assertEquals(0, c2.compare('a', 'A'));
+assertEquals(0, 'a'.localeCompare('A', 'en', {sensitivity: 'base'}));
+assertFalse('a'.localeCompare('A', 'en', {sensitivity: 'variant'}) === 0);
+
+var d = new Date(Date.UTC(2014, 0, 2, 3, 4, 5));
+var df1 = new Intl.DateTimeFormat('en-US', {timeZone: 'UTC', hour: 'numeric'});
+var df2 = new Intl.DateTimeFormat('en-US', {timeZone: 'UTC', hour: 'numeric'});
+assertEquals(df1.format(d), df2.format(d));
+assertEquals('UTC', df2.resolvedOptions().timeZone);
+assertEquals(df1.format(d), d.toLocaleString('en-US',
+                                             {timeZone: 'UTC',
+                                              hour: 'numeric'}));
+
+// More settings than the cache holds.
+for (var i = 0; i < 100; i++) {
+  var nf = new Intl.NumberFormat('en-US', {minimumIntegerDigits: i % 21 + 1,
+                                           maximumFractionDigits: i % 3});
+  assertEquals(i % 21 + 1, nf.resolvedOptions().minimumIntegerDigits);
+  assertEquals(i % 21 + 1, (1).toLocaleString('en-US', {
+      minimumIntegerDigits: i % 21 + 1, useGrouping: false}).length);
+}
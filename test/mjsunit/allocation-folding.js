@@ -113,3 +113,44 @@ function boom() {
 boom(); boom(); boom();
 %OptimizeFunctionOnNextCall(boom);
 boom();
+
+// Test folding of object trees built across branches.
+
+function tree(cond) {
+  var o = { a: cond ? [1, 2] : { x: 3 }, b: { y: 4 } };
+  gc_maybe(cond);
+  return o;
+}
+
+function gc_maybe(cond) {
+  if (!cond) gc();
+}
+
+tree(true); tree(false);
+%OptimizeFunctionOnNextCall(tree);
+var t1 = tree(true);
+var t2 = tree(false);
+gc();
+assertEquals([1, 2], t1.a);
+assertEquals(4, t1.b.y);
+assertEquals(3, t2.a.x);
+assertEquals(4, t2.b.y);
+
+// Test that an allocation after a merge with a call on one path is not folded.
+
+function merge_with_call(cond) {
+  var a = [0.5];
+  if (cond) gc();
+  var b = [1.5];
+  return [a, b];
+}
+
+merge_with_call(true); merge_with_call(false);
+%OptimizeFunctionOnNextCall(merge_with_call);
+var m1 = merge_with_call(true);
+var m2 = merge_with_call(false);
+gc();
+assertEquals(0.5, m1[0][0]);
+assertEquals(1.5, m1[1][0]);
+assertEquals(0.5, m2[0][0]);
+assertEquals(1.5, m2[1][0]);
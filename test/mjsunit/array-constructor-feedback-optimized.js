@@ -0,0 +1,42 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --noalways-opt
+// Flags: --optimized-array-allocation-tracking
+
+// Arrays allocated by optimized code report elements kind transitions to
+// their allocation site, so that later arrays are born with the more
+// general kind.
+
+function TestFeedback(create, value, hasKind) {
+  create(10);
+  create(10);
+  %OptimizeFunctionOnNextCall(create);
+  var a = create(10);
+  assertTrue(%HasFastSmiElements(a));
+  a[0] = value;
+  assertTrue(hasKind(a));
+
+  // The site learned the transition, and the optimized code was dropped.
+  var b = create(10);
+  assertTrue(hasKind(b));
+  b[1] = value;
+  assertTrue(hasKind(b));
+
+  %OptimizeFunctionOnNextCall(create);
+  var c = create(10);
+  assertTrue(hasKind(c));
+}
+
+function HasDoubles(a) { return %HasFastDoubleElements(a); }
+function HasObjects(a) { return %HasFastObjectElements(a); }
+
+// Calls through the array constructor stub.
+TestFeedback(function(n) { return new Array(n); }, 1.5, HasDoubles);
+TestFeedback(function(n) { return new Array(n); }, "x", HasObjects);
+TestFeedback(function(n) { return Array(n); }, 1.5, HasDoubles);
+
+// Inlined allocations.
+TestFeedback(function(n) { return new Array(); }, 1.5, HasDoubles);
+TestFeedback(function(n) { return new Array(10); }, {}, HasObjects);
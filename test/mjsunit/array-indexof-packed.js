@@ -0,0 +1,95 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Test indexOf and lastIndexOf on arrays with packed elements, which are
+// searched natively, and that the other cases still take the generic path.
+
+var smis = [1, 2, 3, 2, 1];
+assertTrue(%HasFastSmiElements(smis));
+assertFalse(%HasFastHoleyElements(smis));
+assertEquals(1, smis.indexOf(2));
+assertEquals(3, smis.lastIndexOf(2));
+assertEquals(0, smis.indexOf(1.0));
+assertEquals(-1, smis.indexOf(1.5));
+assertEquals(-1, smis.indexOf("1"));
+assertEquals(-1, smis.indexOf(undefined));
+assertEquals(-1, smis.indexOf());
+assertEquals(-1, smis.indexOf(Math.pow(2, 40)));
+assertEquals(0, [0, 0, 0].indexOf(-0));
+assertEquals(1, [-0, 0].lastIndexOf(0));
+
+// Start indices.
+assertEquals(3, smis.indexOf(2, 2));
+assertEquals(3, smis.indexOf(2, -2));
+assertEquals(1, smis.indexOf(2, -100));
+assertEquals(-1, smis.indexOf(2, 5));
+assertEquals(1, smis.indexOf(2, undefined));
+assertEquals(3, smis.indexOf(2, 1.5 + 0.5));
+assertEquals(1, smis.lastIndexOf(2, 2));
+assertEquals(1, smis.lastIndexOf(2, -3));
+assertEquals(-1, smis.lastIndexOf(2, -100));
+assertEquals(3, smis.lastIndexOf(2, 100));
+assertEquals(-1, smis.lastIndexOf(2, undefined));
+assertEquals(0, smis.lastIndexOf(1, undefined));
+assertEquals(-1, [].indexOf(1));
+assertEquals(-1, [].lastIndexOf(1));
+var calls = 0;
+var index = { valueOf: function() { calls++; return 2; } };
+assertEquals(3, smis.indexOf(2, index));
+assertEquals(1, smis.lastIndexOf(2, index));
+assertEquals(2, calls);
+
+var doubles = [1.5, NaN, 2.5, -0, 1.5];
+assertTrue(%HasFastDoubleElements(doubles));
+assertFalse(%HasFastHoleyElements(doubles));
+assertEquals(0, doubles.indexOf(1.5));
+assertEquals(4, doubles.lastIndexOf(1.5));
+assertEquals(-1, doubles.indexOf(NaN));
+assertEquals(-1, doubles.lastIndexOf(NaN));
+assertEquals(3, doubles.indexOf(0));
+assertEquals(3, doubles.indexOf(-0));
+assertEquals(-1, doubles.indexOf("1.5"));
+assertEquals(-1, doubles.indexOf(undefined));
+
+var o = {};
+var s = "a" + Math.random();
+var objects = [1, 1.5, "abc", o, null, undefined, true, s, Symbol.iterator];
+assertTrue(%HasFastObjectElements(objects));
+assertFalse(%HasFastHoleyElements(objects));
+assertEquals(0, objects.indexOf(1));
+assertEquals(1, objects.indexOf(1.5));
+assertEquals(2, objects.indexOf("abc"));
+assertEquals(2, objects.indexOf("ab" + String.fromCharCode(99)));
+assertEquals(3, objects.indexOf(o));
+assertEquals(-1, objects.indexOf({}));
+assertEquals(4, objects.indexOf(null));
+assertEquals(5, objects.indexOf(undefined));
+assertEquals(5, objects.indexOf());
+assertEquals(6, objects.indexOf(true));
+assertEquals(-1, objects.indexOf(false));
+assertEquals(7, objects.indexOf(s.substring(0)));
+assertEquals(7, objects.lastIndexOf(s.split("").join("")));
+assertEquals(8, objects.indexOf(Symbol.iterator));
+assertEquals(-1, objects.indexOf(Symbol.unscopables));
+assertEquals(-1, objects.indexOf(NaN));
+assertEquals(0, objects.lastIndexOf(1, 7));
+
+// Holey arrays search the prototype chain, which the generic path does.
+var holey = [1, , 3];
+assertTrue(%HasFastHoleyElements(holey));
+assertEquals(-1, holey.indexOf(undefined));
+Array.prototype[1] = 2;
+assertEquals(1, holey.indexOf(2));
+assertEquals(1, holey.lastIndexOf(2));
+delete Array.prototype[1];
+assertEquals(-1, holey.indexOf(2));
+
+// Generic receivers.
+var array_like = { length: 3, 0: "a", 1: "b", 2: "a" };
+assertEquals(1, Array.prototype.indexOf.call(array_like, "b"));
+assertEquals(2, Array.prototype.lastIndexOf.call(array_like, "a"));
+assertThrows(function() { Array.prototype.indexOf.call(null, 1); },
+             TypeError);
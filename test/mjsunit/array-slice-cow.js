@@ -0,0 +1,87 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Copies of whole arrays made by slice and concat may share their backing
+// store with the original; they must still behave like independent arrays.
+
+function MakeArray(length, f) {
+  var result = [];
+  for (var i = 0; i < length; i++) result.push(f(i));
+  return result;
+}
+
+function TestCopy(copy_function, f) {
+  var original = MakeArray(100, f);
+  var expected = MakeArray(100, f);
+  var copy = copy_function(original);
+  var copy2 = copy_function(original);
+  assertEquals(expected, copy);
+  assertFalse(copy === original);
+
+  copy[0] = "changed";
+  assertEquals(expected, original);
+  assertEquals("changed", copy[0]);
+  assertEquals(expected, copy2);
+
+  original[1] = "changed too";
+  assertEquals(f(1), copy[1]);
+  assertEquals(f(1), copy2[1]);
+  original[1] = f(1);
+
+  copy2.push(f(100));
+  assertEquals(100, original.length);
+  assertEquals(101, copy2.length);
+
+  var copy3 = copy_function(original);
+  copy3.sort(function(a, b) { return a < b ? 1 : -1; });
+  assertEquals(expected, original);
+
+  var copy4 = copy_function(original);
+  copy4.length = 10;
+  assertEquals(100, original.length);
+  assertEquals(f(99), original[99]);
+  original.length = 50;
+  assertEquals(10, copy4.length);
+  assertEquals(f(9), copy4[9]);
+
+  var copy5 = copy_function(copy_function(MakeArray(100, f)));
+  copy5.pop();
+  copy5.shift();
+  assertEquals(98, copy5.length);
+  assertEquals(f(1), copy5[0]);
+}
+
+var copies = [
+  function(a) { return a.slice(); },
+  function(a) { return a.slice(0); },
+  function(a) { return a.slice(0, a.length); },
+  function(a) { return a.concat(); }
+];
+var elements = [
+  function(i) { return i; },
+  function(i) { return "s" + i; },
+  function(i) { return (i & 1) ? { x: i } : i; }
+];
+for (var i = 0; i < copies.length; i++) {
+  for (var j = 0; j < elements.length; j++) {
+    TestCopy(copies[i], elements[j]);
+  }
+}
+
+// Holey arrays keep their holes.
+var holey = MakeArray(100, function(i) { return i; });
+delete holey[5];
+var holey_copy = holey.slice();
+assertFalse(5 in holey_copy);
+holey_copy[5] = 5;
+assertFalse(5 in holey);
+
+// Double arrays and partial copies.
+var doubles = MakeArray(100, function(i) { return i + 0.5; });
+var doubles_copy = doubles.slice();
+doubles_copy[0] = 42;
+assertEquals(0.5, doubles[0]);
+var tail = holey_copy.slice(1);
+tail[0] = "x";
+assertEquals(1, holey_copy[1]);
@@ -420,7 +420,7 @@ function TestSortDoesNotDependOnObjectPrototypeHasOwnProperty() {
 TestSortDoesNotDependOnObjectPrototypeHasOwnProperty();
 
 function TestSortDoesNotDependOnArrayPrototypePush() {
-  // InsertionSort is used for arrays which length <= 22
+  // Binary insertion sort alone is used for short arrays.
   var arr = [];
   for (var i = 0; i < 22; i++) arr[i] = {};
   Array.prototype.push = function() {
@@ -428,8 +428,7 @@ function TestSortDoesNotDependOnArrayPrototypePush() {
   };
   arr.sort();
 
-  // Quicksort is used for arrays which length > 22
-  // Arrays which length > 1000 guarantee GetThirdIndex is executed
+  // Longer arrays are sorted in runs that are then merged.
   arr = [];
   for (var i = 0; i < 2000; ++i) arr[i] = {};
   arr.sort();
@@ -448,3 +447,69 @@ function TestSortDoesNotDependOnArrayPrototypeSort() {
 }
 
 TestSortDoesNotDependOnArrayPrototypeSort();
+
+function TestSortIsStable() {
+  var records = [];
+  for (var i = 0; i < 5000; i++) {
+    // Mix long ascending and descending runs with random stretches, so that
+    // both merging directions and galloping are used.
+    var key = (i % 1000 < 300) ? (i >> 4) :
+              (i % 1000 < 600) ? (5000 - i) >> 4 : (i * 7919) % 61;
+    records.push({ key: key, index: i });
+  }
+  records.sort(function(a, b) { return a.key - b.key; });
+  for (var i = 1; i < records.length; i++) {
+    var previous = records[i - 1];
+    var current = records[i];
+    assertTrue(previous.key <= current.key);
+    if (previous.key == current.key) {
+      assertTrue(previous.index < current.index);
+    }
+  }
+}
+
+TestSortIsStable();
+
+function TestSortWithInconsistentComparator() {
+  var arr = [];
+  for (var i = 0; i < 3000; i++) arr[i] = i;
+  var calls = 0;
+  arr.sort(function() { return (calls++ % 3) - 1; });
+  assertEquals(3000, arr.length);
+  var seen = [];
+  for (var i = 0; i < arr.length; i++) {
+    assertFalse(seen[arr[i]] === true);
+    seen[arr[i]] = true;
+  }
+}
+
+TestSortWithInconsistentComparator();
+
+function TestSmiSortWithoutComparator() {
+  // Smis are sorted natively by their string representation.
+  var arr = [10, -1, 9, 0, 100, -20, 2, 1, -3, 1000000000, -1073741824];
+  arr.sort();
+  assertArrayEquals(
+      [-1, -1073741824, -20, -3, 0, 1, 10, 100, 1000000000, 2, 9], arr);
+
+  var holey = [3, , 1, , 2, undefined, 11];
+  holey.sort();
+  assertEquals(7, holey.length);
+  assertArrayEquals([1, 11, 2, 3, undefined], holey.slice(0, 5));
+  assertFalse(5 in holey);
+  assertFalse(6 in holey);
+
+  // Sorting a copy-on-write literal must not change its boilerplate.
+  function literal() { return [3, 2, 1]; }
+  assertArrayEquals([1, 2, 3], literal().sort());
+  assertArrayEquals([3, 2, 1], literal());
+
+  // Array-like objects with Smi elements.
+  var obj = { 0: 20, 1: 3, 2: 100, length: 3 };
+  Array.prototype.sort.call(obj);
+  assertEquals(100, obj[0]);
+  assertEquals(20, obj[1]);
+  assertEquals(3, obj[2]);
+}
+
+TestSmiSortWithoutComparator();
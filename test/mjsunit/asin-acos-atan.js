@@ -0,0 +1,105 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Test Math.asin, Math.acos, Math.atan and Math.atan2.
+
+function assertSameNumber(expected, actual) {
+  assertTrue(Object.is(expected, actual), expected + " vs " + actual);
+}
+
+// Special cases.
+[NaN, 1.000001, -1.000001, Infinity, -Infinity, "abc"].forEach(function(x) {
+  assertTrue(isNaN(Math.asin(x)));
+  assertTrue(isNaN(Math.acos(x)));
+});
+assertSameNumber(0, Math.asin(0));
+assertSameNumber(-0, Math.asin(-0));
+assertSameNumber(Math.PI / 2, Math.asin(1));
+assertSameNumber(-Math.PI / 2, Math.asin(-1));
+assertSameNumber(0, Math.acos(1));
+assertSameNumber(Math.PI, Math.acos(-1));
+assertSameNumber(Math.PI / 2, Math.acos(0));
+assertSameNumber(Math.PI / 2, Math.acos(-0));
+
+assertTrue(isNaN(Math.atan(NaN)));
+assertSameNumber(0, Math.atan(0));
+assertSameNumber(-0, Math.atan(-0));
+assertSameNumber(Math.PI / 4, Math.atan(1));
+assertSameNumber(-Math.PI / 4, Math.atan(-1));
+assertSameNumber(Math.PI / 2, Math.atan(Infinity));
+assertSameNumber(-Math.PI / 2, Math.atan(-Infinity));
+assertSameNumber(1e-300, Math.atan(1e-300));
+assertSameNumber(Math.PI / 2, Math.atan(1e300));
+
+assertTrue(isNaN(Math.atan2(NaN, 1)));
+assertTrue(isNaN(Math.atan2(1, NaN)));
+assertSameNumber(0, Math.atan2(0, 1));
+assertSameNumber(-0, Math.atan2(-0, 1));
+assertSameNumber(0, Math.atan2(0, 0));
+assertSameNumber(-0, Math.atan2(-0, 0));
+assertSameNumber(Math.PI, Math.atan2(0, -0));
+assertSameNumber(-Math.PI, Math.atan2(-0, -0));
+assertSameNumber(Math.PI, Math.atan2(0, -1));
+assertSameNumber(-Math.PI, Math.atan2(-0, -1));
+assertSameNumber(Math.PI / 2, Math.atan2(1, 0));
+assertSameNumber(-Math.PI / 2, Math.atan2(-1, -0));
+assertSameNumber(Math.PI / 4, Math.atan2(Infinity, Infinity));
+assertSameNumber(-Math.PI / 4, Math.atan2(-Infinity, Infinity));
+assertSameNumber(3 * Math.PI / 4, Math.atan2(Infinity, -Infinity));
+assertSameNumber(-3 * Math.PI / 4, Math.atan2(-Infinity, -Infinity));
+assertSameNumber(0, Math.atan2(1, Infinity));
+assertSameNumber(-0, Math.atan2(-1, Infinity));
+assertSameNumber(Math.PI, Math.atan2(1, -Infinity));
+assertSameNumber(-Math.PI, Math.atan2(-1, -Infinity));
+assertSameNumber(Math.PI / 2, Math.atan2(Infinity, 1));
+assertSameNumber(-Math.PI / 2, Math.atan2(-Infinity, -1));
+assertSameNumber(Math.PI / 2, Math.atan2(1e300, 1e-300));
+assertSameNumber(Math.PI, Math.atan2(1e-300, -1e300));
+assertSameNumber(Math.atan(0.5), Math.atan2(1, 2));
+assertSameNumber(Math.atan(3), Math.atan2(3, 1));
+
+// Known values, exercising each argument reduction interval.
+assertEqualsDelta(Math.PI / 6, Math.asin(0.5), 1e-15);
+assertEqualsDelta(Math.PI / 3, Math.acos(0.5), 1e-15);
+assertEqualsDelta(2 * Math.PI / 3, Math.acos(-0.5), 1e-15);
+assertSameNumber(Math.PI / 4, Math.atan2(1, 1));
+assertSameNumber(-3 * Math.PI / 4, Math.atan2(-1, -1));
+assertEqualsDelta(Math.PI / 3, Math.atan(Math.sqrt(3)), 1e-15);
+assertEqualsDelta(Math.PI / 6, Math.atan(1 / Math.sqrt(3)), 1e-15);
+assertEqualsDelta(Math.PI / 4, Math.asin(Math.SQRT1_2), 1e-15);
+assertEqualsDelta(Math.PI / 4, Math.acos(Math.SQRT1_2), 1e-15);
+
+// The results are inverse to sin, cos and tan.
+for (var x = -1; x <= 1; x += 1 / 64) {
+  assertEqualsDelta(x, Math.sin(Math.asin(x)), 1e-15);
+  assertEqualsDelta(x, Math.cos(Math.acos(x)), 1e-15);
+  assertEqualsDelta(Math.PI / 2, Math.asin(x) + Math.acos(x), 1e-15);
+}
+for (var x = -30; x <= 30; x += 0.125) {
+  assertEqualsDelta(x, Math.tan(Math.atan(x)), 1e-13 * Math.max(1, x * x));
+  assertSameNumber(Math.atan(x), Math.atan2(x, 1));
+}
+
+// The order in which the arguments of atan2 are converted to numbers.
+var log = [];
+var y = { valueOf: function() { log.push("y"); return 1; } };
+var x = { valueOf: function() { log.push("x"); return 2; } };
+assertSameNumber(Math.atan(0.5), Math.atan2(y, x));
+assertEquals(["y", "x"], log);
+
+// Optimized code computes the same results.
+function inverse(x) {
+  return [Math.asin(x), Math.acos(x), Math.atan(x), Math.atan2(x, 0.75)];
+}
+var inputs = [0.1, -0.3, 0.6, -0.9, 0.99, -0];
+var expected = inputs.map(inverse);
+%OptimizeFunctionOnNextCall(inverse);
+for (var i = 0; i < inputs.length; i++) {
+  var actual = inverse(inputs[i]);
+  for (var j = 0; j < actual.length; j++) {
+    assertSameNumber(expected[i][j], actual[j]);
+  }
+}
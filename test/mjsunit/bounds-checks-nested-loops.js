@@ -0,0 +1,70 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --array-bounds-checks-nested-hoisting
+
+function sum(a, rows, columns) {
+  var result = 0;
+  for (var i = 0; i < rows; i++) {
+    for (var j = 0; j < columns; j++) {
+      result += a[i * columns + j];
+    }
+  }
+  return result;
+}
+
+function scale(a, rows, columns, factor) {
+  for (var i = 0; i < rows; i++) {
+    for (var j = 0; j < columns; j++) {
+      a[columns * i + j] *= factor;
+    }
+  }
+}
+
+function matrix(rows, columns) {
+  var a = new Int32Array(rows * columns);
+  for (var i = 0; i < a.length; i++) a[i] = i;
+  return a;
+}
+
+var a = matrix(4, 5);
+assertEquals(190, sum(a, 4, 5));
+assertEquals(190, sum(a, 4, 5));
+%OptimizeFunctionOnNextCall(sum);
+assertEquals(190, sum(a, 4, 5));
+assertEquals(190, sum(a, 2, 10));
+assertEquals(0, sum(a, 0, 5));
+
+// The hoisted check fails when the loops run past the end of the matrix.
+assertEquals(NaN, sum(a, 5, 5));
+assertEquals(NaN, sum(a, 4, 6));
+assertEquals(190, sum(a, 4, 5));
+
+var b = matrix(3, 3);
+scale(b, 3, 3, 2);
+scale(b, 3, 3, 2);
+%OptimizeFunctionOnNextCall(scale);
+scale(b, 3, 3, 2);
+assertEquals([0, 8, 16, 24, 32, 40, 48, 56, 64], Array.prototype.slice.call(b));
+scale(b, 4, 3, 2);
+assertEquals(128, b[8]);
+
+// Constant sizes, the hoisted bound is folded.
+function total(a) {
+  var result = 0;
+  for (var i = 0; i < 3; i++) {
+    for (var j = 0; j < 3; j++) {
+      result += a[i * 3 + j];
+    }
+  }
+  return result;
+}
+
+var c = matrix(3, 3);
+assertEquals(36, total(c));
+assertEquals(36, total(c));
+%OptimizeFunctionOnNextCall(total);
+assertEquals(36, total(c));
+assertEquals(0, total(new Int32Array(9)));
+assertEquals(NaN, total(new Int32Array(4)));
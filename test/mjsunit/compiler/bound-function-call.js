@@ -0,0 +1,95 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+var global = this;
+
+function sloppyThis() { return this; }
+function strictThis() { "use strict"; return this; }
+function collect() {
+  return [this].concat(Array.prototype.slice.call(arguments));
+}
+
+// Calls through the bound function in unoptimized and optimized callers.
+function test(caller, check) {
+  for (var i = 0; i < 3; i++) check(caller());
+  %OptimizeFunctionOnNextCall(caller);
+  check(caller());
+}
+
+// Receivers are converted like in any other call to the target.
+var receiver = {};
+var boundSloppy = sloppyThis.bind(receiver);
+test(function() { return boundSloppy(); },
+     function(result) { assertSame(receiver, result); });
+var boundUndefined = sloppyThis.bind(undefined);
+test(function() { return boundUndefined(); },
+     function(result) { assertSame(global, result); });
+var boundNull = sloppyThis.bind(null);
+test(function() { return boundNull(); },
+     function(result) { assertSame(global, result); });
+var boundNumber = sloppyThis.bind(1);
+test(function() { return boundNumber(); },
+     function(result) {
+       assertEquals("object", typeof result);
+       assertEquals(1, result.valueOf());
+     });
+var boundStrict = strictThis.bind(1);
+test(function() { return boundStrict(); },
+     function(result) { assertSame(1, result); });
+var boundStrictUndefined = strictThis.bind(undefined);
+test(function() { return boundStrictUndefined(); },
+     function(result) { assertSame(undefined, result); });
+
+// Bound arguments go in front of the call arguments, for every arity.
+var boundNone = collect.bind(receiver);
+var boundTwo = collect.bind(receiver, 1, 2);
+test(function() { return boundNone(); },
+     function(result) { assertEquals([receiver], result); });
+test(function() { return boundNone(3, 4, 5); },
+     function(result) { assertEquals([receiver, 3, 4, 5], result); });
+test(function() { return boundNone(3, 4, 5, 6, 7); },
+     function(result) { assertEquals([receiver, 3, 4, 5, 6, 7], result); });
+test(function() { return boundTwo(); },
+     function(result) { assertEquals([receiver, 1, 2], result); });
+test(function() { return boundTwo(3, 4); },
+     function(result) { assertEquals([receiver, 1, 2, 3, 4], result); });
+
+// Rebinding keeps the first receiver and appends the new arguments.
+var rebound = boundTwo.bind({}, 3);
+test(function() { return rebound(4); },
+     function(result) { assertEquals([receiver, 1, 2, 3, 4], result); });
+
+// Known bound functions called as methods and through globals.
+function add(a, b) { return this.base + a + b; }
+var holder = { base: 10 };
+holder.add = add.bind(holder, 1);
+test(function() { return holder.add(2); },
+     function(result) { assertEquals(13, result); });
+
+// Bound builtins get their receiver unconverted.
+var boundPush = Array.prototype.push.bind([], 1);
+test(function() { return boundPush(2); },
+     function(result) { assertTrue(result >= 2); });
+
+// Construct calls through bound functions are unaffected.
+function Point(x, y) { this.x = x; this.y = y; }
+var BoundPoint = Point.bind(null, 1);
+test(function() { return new BoundPoint(2); },
+     function(result) {
+       assertTrue(result instanceof Point);
+       assertEquals(1, result.x);
+       assertEquals(2, result.y);
+     });
+
+// Deoptimizing inside the inlined target resumes in the caller.
+function maybeDeopt(x) { return x + 1; }
+var boundDeopt = maybeDeopt.bind(null);
+function callDeopt(x) { return boundDeopt(x); }
+callDeopt(1);
+callDeopt(2);
+%OptimizeFunctionOnNextCall(callDeopt);
+assertEquals(3, callDeopt(2));
+assertEquals("a1", callDeopt("a"));
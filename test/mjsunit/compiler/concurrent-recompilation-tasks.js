@@ -0,0 +1,35 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --concurrent-recompilation-tasks=2
+// Flags: --concurrent-recompilation --block-concurrent-recompilation
+
+if (!%IsConcurrentRecompilationSupported()) {
+  print("Concurrent recompilation is disabled. Skipping this test.");
+  quit();
+}
+
+function f(x) { return x + 1; }
+function g(x) { return x * 2; }
+function h(x) { return x - 3; }
+
+var functions = [f, g, h];
+for (var i = 0; i < functions.length; i++) {
+  var fun = functions[i];
+  fun(1);
+  fun(2);
+  %OptimizeFunctionOnNextCall(fun, "concurrent");
+  // Kick off recompilation.
+  fun(3);
+  assertUnoptimized(fun, "no sync");
+}
+
+// Let the compile tasks pick up all three jobs.
+%UnblockConcurrentRecompilation();
+assertOptimized(f, "sync");
+assertOptimized(g, "sync");
+assertOptimized(h, "sync");
+assertEquals(2, f(1));
+assertEquals(4, g(2));
+assertEquals(0, h(3));
@@ -0,0 +1,28 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=*
+// Flags: --concurrent-recompilation --block-concurrent-recompilation
+
+if (!%IsConcurrentRecompilationSupported()) {
+  print("Concurrent recompilation is disabled. Skipping this test.");
+  quit();
+}
+
+function f(a, b) {
+  var sum = 0;
+  for (var i = 0; i < a; i++) sum += b;
+  return sum;
+}
+
+assertEquals(6, f(3, 2));
+assertEquals(6, f(2, 3));
+%OptimizeFunctionOnNextCall(f, "concurrent");
+// Kick off recompilation. The graph is built now, scheduling and register
+// allocation happen on the background thread.
+assertEquals(8, f(4, 2));
+assertUnoptimized(f, "no sync");
+%UnblockConcurrentRecompilation();
+assertOptimized(f, "sync");
+assertEquals(12, f(4, 3));
@@ -0,0 +1,57 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Optimizes f, which bails out once when its arguments object escapes and
+// allocates the arguments object on the next attempt.
+function optimize(f, args) {
+  for (var i = 0; i < 3; i++) {
+    f.apply(null, args);
+    %OptimizeFunctionOnNextCall(f);
+  }
+  f.apply(null, args);
+}
+
+function strictSlice() {
+  "use strict";
+  return Array.prototype.slice.call(arguments);
+}
+optimize(strictSlice, [1, 2, 3]);
+assertEquals([1, 2, 3], strictSlice(1, 2, 3));
+assertEquals([], strictSlice());
+assertOptimized(strictSlice);
+
+// Every use of arguments sees the same object.
+function sloppyIdentity() {
+  var first = arguments;
+  return first === arguments && arguments.callee === sloppyIdentity;
+}
+optimize(sloppyIdentity, []);
+assertTrue(sloppyIdentity(1, 2));
+assertOptimized(sloppyIdentity);
+
+// Changes made by callees are visible through arguments.
+function clobber(args) {
+  args[0] = "changed";
+  args.length = 1;
+}
+function strictClobber(a, b) {
+  "use strict";
+  clobber(arguments);
+  return [a, arguments[0], arguments.length];
+}
+optimize(strictClobber, [1, 2]);
+assertEquals([1, "changed", 1], strictClobber(1, 2));
+assertOptimized(strictClobber);
+
+// Sloppy mode functions with parameters alias them with the arguments
+// object, so the arguments object cannot be built from the actual
+// arguments.
+function sloppyAlias(a) {
+  clobber(arguments);
+  return a;
+}
+optimize(sloppyAlias, [1]);
+assertEquals("changed", sloppyAlias(1));
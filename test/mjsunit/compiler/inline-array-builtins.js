@@ -0,0 +1,55 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Array.prototype.forEach, map, filter and reduce are inlined into optimized
+// code along with their callbacks if those are known functions.
+
+function double(x) { return x * 2; }
+function isOdd(x) { return (x & 1) == 1; }
+function add(a, b) { return a + b; }
+
+var sum = 0;
+function accumulate(x, i) { sum += x * i; }
+
+function run(a) {
+  sum = 0;
+  a.forEach(accumulate);
+  return [a.map(double), a.filter(isOdd), a.reduce(add), a.reduce(add, 10),
+          sum];
+}
+
+var a = [1, 2, 3, 4, 5];
+var expected = [[2, 4, 6, 8, 10], [1, 3, 5], 15, 25, 40];
+assertEquals(expected, run(a));
+assertEquals(expected, run(a));
+%OptimizeFunctionOnNextCall(run);
+assertEquals(expected, run(a));
+
+// Holes, doubles and deoptimization inside an inlined callback.
+assertEquals([[2, , 7], [1, 3.5], 4.5, 14.5, 7], run([1, , 3.5]));
+assertEquals([[NaN, 4], [], "a2", "10a2", NaN], run(["a", 2]));
+
+// Exceptions thrown by the inlined builtin and by the callback.
+assertThrows(function() { run(null); }, TypeError);
+assertThrows(function() { run([]); }, TypeError);
+sum = { valueOf: function() { throw "callback"; } };
+accumulate = function(x) { sum += x; };
+assertThrows(function() { [1].forEach(accumulate); });
+
+// Sloppy callbacks see the global receiver, strict ones undefined.
+function sloppyReceiver() { return this; }
+function strictReceiver() { "use strict"; return this; }
+function receivers(a) {
+  return [a.map(sloppyReceiver)[0], a.map(strictReceiver)[0],
+          a.map(strictReceiver, 5)[0]];
+}
+receivers([0]);
+receivers([0]);
+%OptimizeFunctionOnNextCall(receivers);
+var result = receivers([0]);
+assertSame(this, result[0]);
+assertSame(undefined, result[1]);
+assertSame(5, result[2]);
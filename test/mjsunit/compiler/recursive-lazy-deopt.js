@@ -0,0 +1,30 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --escape-analysis --expose-gc
+
+// Lazily deoptimizes many frames of the same code at the same call site,
+// each of them with a captured object to materialize. The frames share one
+// decoded translation, a GC in between must not leave it stale.
+
+function deopt(n) {
+  if (n == 0 && trigger) {
+    %DeoptimizeFunction(f);
+    gc();
+  }
+}
+
+function f(n) {
+  var o = { a: n, b: n + 0.5 };
+  if (n > 0) f(n - 1);
+  deopt(n);
+  return o.a + o.b;
+}
+
+var trigger = false;
+for (var i = 0; i < 5; i++) f(10);
+%OptimizeFunctionOnNextCall(f);
+assertEquals(20.5, f(10));
+trigger = true;
+assertEquals(40.5, f(20));
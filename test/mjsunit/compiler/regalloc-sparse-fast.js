@@ -0,0 +1,38 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --lithium-sparse-liveness
+// Flags: --lithium-fast-allocation-threshold=1
+
+// Keeps more values alive across nested loops than there are registers, so
+// that the allocator has to split and spill in its fast mode.
+function kernel(n, x) {
+  var a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8;
+  var p = 0.5, q = 1.5, r = 2.5, s = 3.5;
+  for (var i = 0; i < n; i++) {
+    for (var j = 0; j < n; j++) {
+      a = (a + b * j) | 0;
+      b = (b ^ c) + i;
+      c = (c + d) & 0xffff;
+      d = (d * 3 + e) & 0xffff;
+      e = (e + f + x) | 0;
+      f = (f - g) | 0;
+      g = (g + h) & 0xff;
+      h = (h + a) & 0xfff;
+      p = p * q + r;
+      q = q + s * 0.25;
+      if (p > 1e6) p = p - 1e6;
+      if (q > 1e3) q = q - 1e3;
+    }
+    r = r + p * 0.125;
+    s = s - q * 0.0625;
+  }
+  return [a, b, c, d, e, f, g, h, p, q, r, s].join(",");
+}
+
+var expected1 = kernel(20, 3);
+var expected2 = kernel(7, 11);
+%OptimizeFunctionOnNextCall(kernel);
+assertEquals(expected1, kernel(20, 3));
+assertEquals(expected2, kernel(7, 11));
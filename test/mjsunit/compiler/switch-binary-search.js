@@ -0,0 +1,52 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+function dispatch(x) {
+  var r = "";
+  switch (x) {
+    case 7: r += "a";
+    case 3: r += "b"; break;
+    case 15: return "c";
+    case -4: return "d";
+    case 0: return "e";
+    default: r += "f";
+    case 11: return r + "g";
+    case 1: return "h";
+    case 100: return "i";
+    case 9: return "j";
+    case 2: return "k";
+  }
+  return r;
+}
+
+function check() {
+  assertEquals("ab", dispatch(7));
+  assertEquals("b", dispatch(3));
+  assertEquals("c", dispatch(15));
+  assertEquals("d", dispatch(-4));
+  assertEquals("e", dispatch(0));
+  assertEquals("g", dispatch(11));
+  assertEquals("h", dispatch(1));
+  assertEquals("i", dispatch(100));
+  assertEquals("j", dispatch(9));
+  assertEquals("k", dispatch(2));
+  assertEquals("fg", dispatch(5));
+  assertEquals("fg", dispatch(-100));
+  assertEquals("fg", dispatch(1000));
+}
+
+check();
+check();
+%OptimizeFunctionOnNextCall(dispatch);
+check();
+
+// Tags that are not Smis still compare strictly.
+assertEquals("b", dispatch(1.5 * 2));
+assertEquals("e", dispatch(-0));
+assertEquals("fg", dispatch("3"));
+assertEquals("fg", dispatch(undefined));
+assertEquals("fg", dispatch(3.5));
+check();
@@ -0,0 +1,126 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --optimize-try-catch
+
+function thrower(x) {
+  if (x < 0) throw "negative";
+  return x;
+}
+
+
+// Catching an exception thrown by a callee.
+function simple(x) {
+  try {
+    return thrower(x) + 1;
+  } catch (e) {
+    return e;
+  }
+}
+
+assertEquals(2, simple(1));
+assertEquals("negative", simple(-1));
+%OptimizeFunctionOnNextCall(simple);
+assertEquals(3, simple(2));
+assertEquals("negative", simple(-1));
+assertEquals(4, simple(3));
+
+
+// Locals assigned inside the try block are visible in the catch block.
+function locals(n) {
+  var last = -1;
+  var sum = 0;
+  try {
+    for (var i = 0; i < n; i++) {
+      last = i;
+      sum += thrower(5 - i);
+    }
+  } catch (e) {
+    return [e, last, sum, i];
+  }
+  return [last, sum];
+}
+
+assertEquals([2, 12], locals(3));
+%OptimizeFunctionOnNextCall(locals);
+assertEquals([2, 12], locals(3));
+assertEquals(["negative", 6, 15, 6], locals(10));
+assertEquals([-1, 0], locals(0));
+
+
+// Nested try statements.
+function nested(x, y) {
+  var log = "";
+  try {
+    log += "a";
+    try {
+      log += "b";
+      thrower(x);
+      log += "c";
+    } catch (e) {
+      log += "d";
+    }
+    thrower(y);
+    log += "e";
+  } catch (e) {
+    log += "f";
+  }
+  return log;
+}
+
+assertEquals("abce", nested(1, 1));
+%OptimizeFunctionOnNextCall(nested);
+assertEquals("abce", nested(1, 1));
+assertEquals("abde", nested(-1, 1));
+%OptimizeFunctionOnNextCall(nested);
+assertEquals("abcf", nested(1, -1));
+%OptimizeFunctionOnNextCall(nested);
+assertEquals("abdf", nested(-1, -1));
+
+
+// Leaving the try block by return, break and continue.
+function jumps(n) {
+  var result = 0;
+  for (var i = 0; i < n; i++) {
+    try {
+      if (i == 1) continue;
+      if (i == 5) break;
+      if (i == 3) {
+        try {
+          if (n == 4) return -1;
+        } catch (e) {
+          return -2;
+        }
+      }
+      result += thrower(i);
+    } catch (e) {
+      return -3;
+    }
+  }
+  return result;
+}
+
+assertEquals(9, jumps(10));
+%OptimizeFunctionOnNextCall(jumps);
+assertEquals(9, jumps(10));
+assertEquals(-1, jumps(4));
+assertEquals(2, jumps(3));
+
+
+// Deoptimization inside the try block keeps the handlers intact.
+function deopt(o) {
+  try {
+    var x = o.x;
+    return thrower(x);
+  } catch (e) {
+    return "caught " + e;
+  }
+}
+
+assertEquals(1, deopt({x: 1}));
+%OptimizeFunctionOnNextCall(deopt);
+assertEquals(1, deopt({x: 1}));
+assertEquals(2, deopt({y: 0, x: 2}));
+assertEquals("caught negative", deopt({x: -1}));
+assertEquals("caught negative", deopt({z: 0, x: -1}));
@@ -0,0 +1,39 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=* --turbo-inlining
+
+function A() {}
+A.prototype.handle = function(x) { return x + 1; };
+
+function B() {}
+B.prototype.handle = function(x) { return x * 2; };
+
+function C() {}
+C.prototype.handle = function(x) { return x - 3; };
+
+function dispatch(o, x) {
+  return o.handle(x);
+}
+
+var a = new A();
+var b = new B();
+var c = new C();
+
+// Make the call site polymorphic between A and B only.
+for (var i = 0; i < 10; i++) {
+  assertEquals(5, dispatch(a, 4));
+  assertEquals(8, dispatch(b, 4));
+}
+%OptimizeFunctionOnNextCall(dispatch);
+assertEquals(5, dispatch(a, 4));
+assertEquals(8, dispatch(b, 4));
+
+// Callees that were never seen go through the generic call.
+assertEquals(1, dispatch(c, 4));
+assertEquals(42, dispatch({ handle: function(x) { return 42; } }, 4));
+
+// Replacing a method after optimization must not call the stale target.
+A.prototype.handle = function(x) { return x + 100; };
+assertEquals(104, dispatch(a, 4));
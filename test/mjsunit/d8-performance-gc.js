@@ -0,0 +1,36 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-gc
+
+// Test the collection log and heap sizes of performance.pauses() in d8.
+// This test only makes sense with d8.
+
+if (this.performance && performance.pauses) {
+  // The first call starts the recording.
+  performance.pauses(true);
+  gc();
+  var pauses = performance.pauses(true);
+  assertTrue(pauses.collections.length >= 1);
+  assertEquals(0, pauses.droppedCollections);
+  var last = pauses.collections[pauses.collections.length - 1];
+  assertEquals("mark-compact", last.type);
+  assertTrue(last.duration >= 0);
+  assertTrue(last.start > 0);
+  assertTrue(last.sizeAfter > 0);
+  assertTrue(pauses.markCompacts >= 1);
+
+  // The log is cleared by every draining call, and only drained on request.
+  assertEquals(0, performance.pauses(true).collections.length);
+  gc();
+  assertEquals(undefined, performance.pauses().collections);
+  assertEquals(1, performance.pauses(true).collections.length);
+
+  var stats = performance.pauses();
+  assertTrue(stats.usedHeapSize > 0);
+  assertTrue(stats.totalHeapSize >= stats.usedHeapSize);
+  assertTrue(stats.allocationLimit > 0);
+  assertTrue(stats.heapSizeLimit >= stats.totalHeapSize);
+  assertTrue(stats.rss == -1 || stats.rss > 0);
+}
@@ -0,0 +1,82 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Test the Worker API of d8.  This test only makes sense with d8.
+
+if (this.Worker) {
+  function f() {
+    postMessage("Starting worker");
+    // Set a global variable; should not be visible outside of the worker's
+    // context.
+    foo = 100;
+
+    onmessage = function(m) {
+      switch (m.kind) {
+        case "echo":
+          postMessage(m.value);
+          break;
+        case "sum": {
+          var view = new Uint8Array(m.buffer);
+          var sum = 0;
+          for (var i = 0; i < view.length; ++i) sum += view[i];
+          postMessage(sum);
+          break;
+        }
+        case "fill": {
+          var ab = new ArrayBuffer(m.length);
+          var view = new Uint8Array(ab);
+          for (var i = 0; i < view.length; ++i) view[i] = i & 0xff;
+          postMessage(ab, [ab]);
+          postMessage(ab.byteLength);
+          break;
+        }
+      }
+    };
+  }
+
+  var w = new Worker("(" + f.toString() + ")()");
+  assertEquals("Starting worker", w.getMessage());
+  assertEquals("undefined", typeof foo);
+
+  // Values are copied.
+  var values = [undefined, null, true, false, 42, -0.5, "a string",
+                [1, "two", [3]], {a: 1, b: {c: "d"}, 0: "zero"}];
+  for (var i = 0; i < values.length; ++i) {
+    w.postMessage({kind: "echo", value: values[i]});
+    assertEquals(values[i], w.getMessage());
+  }
+
+  // A copied ArrayBuffer stays usable in the sender.
+  var ab = new ArrayBuffer(16);
+  var view = new Uint8Array(ab);
+  for (var i = 0; i < view.length; ++i) view[i] = i;
+  w.postMessage({kind: "sum", buffer: ab});
+  assertEquals(120, w.getMessage());
+  assertEquals(16, ab.byteLength);
+
+  // A transferred ArrayBuffer is neutered in the sender.
+  w.postMessage({kind: "sum", buffer: ab}, [ab]);
+  assertEquals(120, w.getMessage());
+  assertEquals(0, ab.byteLength);
+  assertEquals(0, view.length);
+
+  // ArrayBuffers are transferred from the worker, too.
+  w.postMessage({kind: "fill", length: 1024});
+  var result = w.getMessage();
+  assertEquals(1024, result.byteLength);
+  assertEquals(255, new Uint8Array(result)[255]);
+  assertEquals(0, w.getMessage());
+
+  // Values that cannot be serialized throw.
+  assertThrows(function() { w.postMessage(function() {}); });
+  var cyclic = {};
+  cyclic.self = cyclic;
+  assertThrows(function() { w.postMessage(cyclic); });
+  assertThrows(function() { w.postMessage(1, [{}]); });
+  assertThrows(function() { Worker.prototype.postMessage.call({}, 1); });
+
+  // Once the worker has stopped, getMessage returns undefined.
+  w.terminate();
+  assertEquals(undefined, w.getMessage());
+}
@@ -0,0 +1,46 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Strings handled by the fast path for the ES5 ISO date-time format.
+assertEquals(Date.UTC(2014, 10, 25, 12, 34, 56),
+             Date.parse("2014-11-25T12:34:56Z"));
+assertEquals(Date.UTC(2014, 10, 25, 12, 34, 56, 789),
+             Date.parse("2014-11-25T12:34:56.789Z"));
+assertEquals(Date.UTC(2014, 10, 25, 10, 4, 56),
+             Date.parse("2014-11-25T12:34:56+02:30"));
+assertEquals(Date.UTC(2014, 10, 26, 0, 34, 56, 1),
+             Date.parse("2014-11-25T12:34:56.001-12:00"));
+assertEquals(0, Date.parse("1970-01-01T00:00:00Z"));
+assertEquals(-1, Date.parse("1969-12-31T23:59:59.999Z"));
+assertEquals(Date.UTC(2000, 1, 29, 23), Date.parse("2000-02-29T23:00:00Z"));
+assertEquals(Date.UTC(2400, 11, 31), Date.parse("2400-12-31T00:00:00Z"));
+assertEquals(-62167219200000, Date.parse("0000-01-01T00:00:00Z"));
+assertEquals(-62162121600000, Date.parse("0000-02-29T00:00:00Z"));
+assertEquals(Date.UTC(9999, 11, 31, 23, 59, 59, 999),
+             Date.parse("9999-12-31T23:59:59.999Z"));
+assertEquals(Date.UTC(2014, 0, 31), new Date("2014-01-31T00:00:00Z").getTime());
+
+// Every day of a leap and a common year.
+for (var year = 1999; year <= 2000; year++) {
+  for (var t = Date.UTC(year, 0, 1); t < Date.UTC(year + 1, 0, 1);
+       t += 86400000 + 1234) {
+    var s = new Date(t).toISOString();
+    assertEquals(t, Date.parse(s), s);
+  }
+}
+
+// Strings that are left to the general parser.
+assertEquals(NaN, Date.parse("2014-13-25T12:34:56Z"));
+assertEquals(NaN, Date.parse("2014-11-25T25:34:56Z"));
+assertEquals(NaN, Date.parse("2014-11-25T12:60:56Z"));
+assertEquals(NaN, Date.parse("2014-11-25T12:34:56+2:300"));
+assertEquals(NaN, Date.parse("2014-11-25X12:34:56Z"));
+assertEquals(NaN, Date.parse("2014-11-25T12:34:56ZZ"));
+assertEquals(Date.UTC(2014, 10, 25, 12, 34, 56, 780),
+             Date.parse("2014-11-25T12:34:56.78Z"));
+assertEquals(Date.UTC(2014, 10, 25, 12, 34, 56),
+             Date.parse("+002014-11-25T12:34:56Z"));
+assertEquals(Date.UTC(2014, 10, 25, 12, 34, 56),
+             Date.parse({ toString: function() {
+               return "2014-11-25T12:34:56Z"; } }));
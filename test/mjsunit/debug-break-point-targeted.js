@@ -0,0 +1,97 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-debug-as debug --allow-natives-syntax
+// Flags: --debug-targeted-break-points
+
+// Setting a break point only deoptimizes the function that has it, and the
+// functions it has been inlined into.
+
+var Debug = debug.Debug;
+var break_count = 0;
+var exception = null;
+
+function listener(event, exec_state, event_data, data) {
+  if (event != Debug.DebugEvent.Break) return;
+  try {
+    break_count++;
+  } catch (e) {
+    exception = e;
+  }
+}
+
+Debug.setListener(listener);
+
+function hot(x) {
+  return x * 2 + 1;
+}
+
+function inner(x) {
+  return x + 1;
+}
+
+function outer(x) {
+  return inner(x) * 2;
+}
+
+hot(1);
+hot(2);
+%OptimizeFunctionOnNextCall(hot);
+hot(3);
+outer(1);
+outer(2);
+%OptimizeFunctionOnNextCall(outer);
+outer(3);
+assertOptimized(hot);
+
+var bp = Debug.setBreakPoint(inner, 1, 0);
+assertOptimized(hot);
+
+// The break point is hit, also from optimized callers.
+assertEquals(10, outer(4));
+assertEquals(1, break_count);
+%OptimizeFunctionOnNextCall(outer);
+assertEquals(12, outer(5));
+assertEquals(2, break_count);
+
+// The function with the break point itself is not optimized.
+%OptimizeFunctionOnNextCall(inner);
+assertEquals(7, inner(6));
+assertEquals(3, break_count);
+assertUnoptimized(inner);
+
+// Hitting the break point did not deoptimize anything else.
+assertEquals(9, hot(4));
+assertOptimized(hot);
+
+Debug.clearBreakPoint(bp);
+assertEquals(8, inner(7));
+assertEquals(3, break_count);
+
+
+// A log point evaluates its expression and does not break.
+var log = [];
+
+function logged(x) {
+  var y = x * 3;
+  return y;
+}
+
+var lp = Debug.setBreakPoint(logged, 2, 0);
+Debug.changeBreakPointLogExpression(lp, "log.push(y)");
+assertEquals(3, logged(1));
+assertEquals(6, logged(2));
+assertEquals(3, break_count);
+assertEquals([3, 6], log);
+assertEquals(2, Debug.findBreakPoint(lp).hit_count());
+assertOptimized(hot);
+
+// Errors in the log expression are ignored.
+Debug.changeBreakPointLogExpression(lp, "undefined_variable.foo");
+assertEquals(9, logged(3));
+assertEquals(3, break_count);
+
+Debug.clearBreakPoint(lp);
+Debug.setListener(null);
+assertNull(exception);
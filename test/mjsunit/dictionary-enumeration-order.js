@@ -0,0 +1,51 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Enumeration order of objects in dictionary mode, after deletions and
+// re-additions have left gaps in the enumeration indices.
+
+function Keys(object) {
+  var result = [];
+  for (var key in object) result.push(key);
+  return result;
+}
+
+var object = {};
+var expected = [];
+for (var i = 0; i < 200; i++) {
+  object["k" + i] = i;
+  expected.push("k" + i);
+}
+assertEquals(expected, Object.keys(object));
+assertEquals(expected, Keys(object));
+
+// Sparse deletions.
+for (var i = 0; i < 200; i += 3) delete object["k" + i];
+expected = expected.filter(function(key, i) { return i % 3 != 0; });
+assertEquals(expected, Object.keys(object));
+assertEquals(expected, Keys(object));
+
+// Re-added keys go to the end, overwritten ones keep their place.
+object.k0 = 0;
+object.k1 = "one";
+expected.push("k0");
+assertEquals(expected, Object.keys(object));
+
+// Delete almost everything so that the indices become very sparse.
+for (var i = 5; i < 200; i++) delete object["k" + i];
+object.last = true;
+assertEquals(["k1", "k2", "k4", "k0", "last"], Object.keys(object));
+assertEquals(["k1", "k2", "k4", "k0", "last"], Keys(object));
+
+// Non-enumerable properties are skipped.
+Object.defineProperty(object, "k2", { enumerable: false });
+assertEquals(["k1", "k4", "k0", "last"], Object.keys(object));
+
+// Delete everything.
+var keys = Object.keys(object);
+for (var i = 0; i < keys.length; i++) delete object[keys[i]];
+delete object.k2;
+assertEquals([], Object.keys(object));
+object.again = 1;
+assertEquals(["again"], Keys(object));
@@ -0,0 +1,30 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --discard-free-memory --expose-gc
+
+// Memory the sweeper gives back to the OS is reused by later allocations.
+function fill(n) {
+  var result = [];
+  for (var i = 0; i < n; i++) result.push({ index: i, name: "x" + i });
+  return result;
+}
+
+var keep = [];
+for (var round = 0; round < 5; round++) {
+  var garbage = fill(50000);
+  keep.push(fill(100));
+  garbage = null;
+  gc();
+  var reused = fill(50000);
+  for (var i = 0; i < reused.length; i += 997) {
+    assertEquals(i, reused[i].index);
+    assertEquals("x" + i, reused[i].name);
+  }
+}
+
+gc();
+for (var round = 0; round < keep.length; round++) {
+  for (var i = 0; i < 100; i++) assertEquals("x" + i, keep[round][i].name);
+}
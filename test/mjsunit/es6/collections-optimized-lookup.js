@@ -0,0 +1,86 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Map and Set lookups in optimized code, which handles Smi and internalized
+// string keys inline.
+
+var map = new Map();
+var set = new Set();
+var object = {};
+var keys = [0, 1, -1, 42, 1 << 30, -(1 << 30), 0x7fffffff, 1.5, NaN,
+            "a", "b", "", "1", object, null, undefined, true, Symbol()];
+for (var i = 0; i < keys.length; i++) {
+  map.set(keys[i], i);
+  set.add(keys[i]);
+}
+for (var i = 0; i < 100; i++) {
+  map.set("k" + i, i);
+  set.add(i * 3);
+}
+
+function get(key) { return map.get(key); }
+function has(key) { return map.has(key); }
+function setHas(key) { return set.has(key); }
+
+function Test() {
+  for (var i = 0; i < keys.length; i++) {
+    assertEquals(i, get(keys[i]));
+    assertTrue(has(keys[i]));
+    assertTrue(setHas(keys[i]));
+  }
+  for (var i = 0; i < 100; i++) {
+    assertEquals(i, get("k" + i));
+    assertTrue(has("k" + i));
+    assertTrue(setHas(i * 3));
+    assertEquals(i % 3 == 0 || i == 1 || i == 42, setHas(i));
+  }
+  // Keys equal to stored ones but of a different representation.
+  assertEquals(0, get(-0));
+  assertEquals(3, get(21 + 21));
+  assertEquals(3, get(84 / 2));
+  assertEquals(3, get(parseFloat("42")));
+  assertEquals(9, get(String.fromCharCode(97)));
+  assertEquals(12, get(String(1)));
+  assertTrue(setHas(1.5 * 2));
+  // Missing keys.
+  assertEquals(undefined, get(2));
+  assertEquals(undefined, get("c"));
+  assertEquals(undefined, get({}));
+  assertEquals(undefined, get(43.5));
+  assertFalse(has("k100"));
+  assertFalse(setHas(1000));
+  assertFalse(setHas("0"));
+}
+
+Test();
+Test();
+%OptimizeFunctionOnNextCall(get);
+%OptimizeFunctionOnNextCall(has);
+%OptimizeFunctionOnNextCall(setHas);
+Test();
+
+// Keys stored as heap numbers or non-internalized strings.
+var computed = new Map();
+computed.set(1.5 * 4, "six");
+computed.set(("com" + "puted_").substring(0, 8), "string");
+function computedGet(key) { return computed.get(key); }
+computedGet(6);
+%OptimizeFunctionOnNextCall(computedGet);
+assertEquals("six", computedGet(6));
+assertEquals("string", computedGet("computed"));
+assertEquals(undefined, computedGet(7));
+
+// Deleted entries.
+map.delete("a");
+set.delete(42);
+assertEquals(undefined, get("a"));
+assertFalse(has("a"));
+assertFalse(setHas(42));
+map.set("a", "again");
+assertEquals("again", get("a"));
+map.clear();
+assertEquals(undefined, get(0));
+assertFalse(has("b"));
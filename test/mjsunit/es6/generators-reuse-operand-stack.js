@@ -0,0 +1,64 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Suspensions with operands or handlers on the stack reuse the array saved
+// by the previous suspension of the same height.
+
+function* nested(n) {
+  for (var i = 0; i < n; i++) {
+    try {
+      var x = [i, (yield i), i * 2];
+      if (x[1] !== "sent " + i) throw "bad";
+      yield (1 + (yield x[2]));
+    } finally {
+      yield -i;
+    }
+  }
+}
+
+var g = nested(100);
+for (var i = 0; i < 100; i++) {
+  assertEquals({ value: i, done: false }, g.next());
+  assertEquals({ value: i * 2, done: false }, g.next("sent " + i));
+  assertEquals({ value: 1 + i, done: false }, g.next(i));
+  assertEquals({ value: -i, done: false }, g.next());
+}
+assertEquals({ value: undefined, done: true }, g.next());
+
+// Different operand stack heights in turn.
+function* heights() {
+  while (true) {
+    var a = 1 + (yield 1);
+    var b = 1 + (2 + (yield 2));
+    var c = 1 + (2 + (3 + (yield 3)));
+    yield a + b + c;
+  }
+}
+
+g = heights();
+g.next();
+for (var i = 0; i < 50; i++) {
+  g.next(i);
+  g.next(i);
+  assertEquals(3 * i + 10, g.next(i).value);
+  assertEquals(1, g.next().value);
+}
+
+// Throwing into a generator suspended inside a try block.
+function* catcher() {
+  while (true) {
+    try {
+      yield 1;
+    } catch (e) {
+      yield "caught " + e;
+    }
+  }
+}
+
+g = catcher();
+g.next();
+for (var i = 0; i < 50; i++) {
+  assertEquals("caught " + i, g.throw(i).value);
+  assertEquals(1, g.next().value);
+}
@@ -0,0 +1,46 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Reaction jobs of resolved promises, reactions of pending promises and
+// Object.observe deliveries keep their relative order when run as a batch.
+var log = [];
+var resolved = Promise.resolve("resolved");
+var resolve;
+var pending = new Promise(function(r) { resolve = r; });
+var observed = {};
+Object.observe(observed, function() { log.push("observe"); });
+
+pending.then(function(v) { log.push("pending 1 " + v); });
+resolved.then(function(v) { log.push("resolved 1 " + v); });
+observed.x = 1;
+pending.then(function(v) { log.push("pending 2 " + v); });
+resolve("value");
+resolved.then(function(v) {
+  log.push("resolved 2 " + v);
+  throw "dropped";
+}).then(undefined, function(e) { log.push("caught " + e); });
+resolved.then(function() { log.push("resolved 3"); });
+%RunMicrotasks();
+assertEquals(["resolved 1 resolved", "observe", "pending 1 value",
+              "pending 2 value", "resolved 2 resolved", "resolved 3",
+              "caught dropped"], log);
+
+// Exceptions escaping a microtask do not stop the rest of the batch.
+log = [];
+%EnqueueMicrotask(function() { log.push(1); throw "lost"; });
+%EnqueueMicrotask(function() { log.push(2); });
+%RunMicrotasks();
+assertEquals([1, 2], log);
+
+// Jobs enqueued while a batch runs are run afterwards, in order.
+log = [];
+var chain = Promise.resolve(0);
+for (var i = 1; i <= 5; i++) {
+  chain = chain.then(function(v) { log.push(v); return v + 1; });
+}
+Promise.resolve().then(function() { log.push("other"); });
+%RunMicrotasks();
+assertEquals([0, "other", 1, 2, 3, 4], log);
@@ -0,0 +1,74 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Changes are only delivered to observers that accept their type, also when
+// the set of observers changes between changes.
+
+function recordTypes(records) {
+  return records.map(function(record) { return record.type; });
+}
+
+var records1 = [];
+var records2 = [];
+function observer1(records) { records1.push(recordTypes(records)); }
+function observer2(records) { records2.push(recordTypes(records)); }
+
+var obj = { a: 1 };
+Object.observe(obj, observer1, ['delete']);
+obj.a = 2;
+obj.b = 3;
+delete obj.a;
+Object.deliverChangeRecords(observer1);
+assertEquals([['delete']], records1);
+
+// A second observer widens the accepted types.
+Object.observe(obj, observer2, ['add', 'update']);
+obj.b = 4;
+obj.c = 5;
+delete obj.b;
+Object.deliverChangeRecords(observer1);
+Object.deliverChangeRecords(observer2);
+assertEquals([['delete'], ['delete']], records1);
+assertEquals([['update', 'add']], records2);
+
+// Removing it narrows them again.
+Object.unobserve(obj, observer2);
+obj.c = 6;
+delete obj.c;
+Object.deliverChangeRecords(observer1);
+Object.deliverChangeRecords(observer2);
+assertEquals([['delete'], ['delete'], ['delete']], records1);
+assertEquals([['update', 'add']], records2);
+
+// Observing again with the same callback replaces its accept types.
+Object.observe(obj, observer1, ['add']);
+obj.d = 7;
+delete obj.d;
+Object.deliverChangeRecords(observer1);
+assertEquals(['add'], records1[3]);
+
+// Splices are filtered like the other changes.
+var arr = [0];
+var splices = [];
+function spliceObserver(records) { splices.push(recordTypes(records)); }
+Object.observe(arr, spliceObserver, ['splice']);
+arr[0] = 1;
+Object.deliverChangeRecords(spliceObserver);
+assertEquals([], splices);
+arr.push(2);
+Object.deliverChangeRecords(spliceObserver);
+assertEquals([['splice']], splices);
+
+// The list of pending records of a callback is reused across deliveries.
+var deliveries = 0;
+function counter(records) { deliveries += records.length; }
+var counted = {};
+Object.observe(counted, counter);
+for (var i = 0; i < 3; i++) {
+  counted.x = i;
+  Object.deliverChangeRecords(counter);
+  assertEquals(i + 1, deliveries);
+}
+Object.deliverChangeRecords(counter);
+assertEquals(3, deliveries);
@@ -0,0 +1,81 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-atomics
+
+// SharedArrayBuffer.
+var sab = new SharedArrayBuffer(16);
+assertEquals(16, sab.byteLength);
+assertEquals("[object SharedArrayBuffer]", Object.prototype.toString.call(sab));
+assertThrows(function() { SharedArrayBuffer(16); }, TypeError);
+assertThrows(function() {
+  ArrayBuffer.prototype.slice.call(sab, 0);
+}, TypeError);
+
+var ia = new Int32Array(sab);
+var ua = new Uint32Array(sab, 8);
+assertEquals(4, ia.length);
+assertEquals(2, ua.length);
+assertSame(sab, ia.buffer);
+assertEquals(16, new DataView(sab).byteLength);
+
+// Load and store.
+assertEquals(0, Atomics.load(ia, 0));
+assertEquals(42, Atomics.store(ia, 0, 42));
+assertEquals(42, Atomics.load(ia, 0));
+assertEquals(42, ia[0]);
+assertEquals(7, Atomics.store(ia, "1", "7"));
+assertEquals(7, Atomics.load(ia, 1.5));
+
+// Read-modify-write operations return the old value.
+Atomics.store(ia, 0, 10);
+assertEquals(10, Atomics.add(ia, 0, 5));
+assertEquals(15, Atomics.sub(ia, 0, 20));
+assertEquals(-5, Atomics.load(ia, 0));
+Atomics.store(ia, 0, 0xc);
+assertEquals(0xc, Atomics.and(ia, 0, 0xa));
+assertEquals(0x8, Atomics.or(ia, 0, 0x3));
+assertEquals(0xb, Atomics.xor(ia, 0, 0x6));
+assertEquals(0xd, Atomics.exchange(ia, 0, 1));
+assertEquals(1, Atomics.load(ia, 0));
+
+// The arithmetic wraps around.
+Atomics.store(ia, 0, 0x7fffffff);
+assertEquals(0x7fffffff, Atomics.add(ia, 0, 1));
+assertEquals(-0x80000000, Atomics.load(ia, 0));
+assertEquals(0, Atomics.load(ua, 0));
+assertEquals(0, Atomics.sub(ua, 0, 1));
+assertEquals(0xffffffff, Atomics.load(ua, 0));
+assertEquals(-1, ia[2]);
+
+// Compare and exchange.
+Atomics.store(ia, 3, 1);
+assertEquals(1, Atomics.compareExchange(ia, 3, 2, 3));
+assertEquals(1, Atomics.load(ia, 3));
+assertEquals(1, Atomics.compareExchange(ia, 3, 1, 3));
+assertEquals(3, Atomics.load(ia, 3));
+
+// Only 32-bit integer views of shared buffers are accepted.
+assertThrows(function() { Atomics.load(new Int32Array(4), 0); }, TypeError);
+assertThrows(function() { Atomics.load(new Int8Array(sab), 0); }, TypeError);
+assertThrows(function() {
+  Atomics.load(new Float32Array(sab), 0);
+}, TypeError);
+assertThrows(function() { Atomics.load([1, 2], 0); }, TypeError);
+assertThrows(function() { Atomics.load(ia, -1); }, RangeError);
+assertThrows(function() { Atomics.load(ia, 4); }, RangeError);
+assertThrows(function() { Atomics.store(ua, 2, 0); }, RangeError);
+
+// Waiting. There is no other thread, so waits either fail right away or
+// time out.
+assertEquals(0, Atomics.OK);
+assertEquals(-1, Atomics.NOTEQUAL);
+assertEquals(-2, Atomics.TIMEDOUT);
+Atomics.store(ia, 0, 0);
+assertEquals(Atomics.NOTEQUAL, Atomics.wait(ia, 0, 1));
+assertEquals(Atomics.TIMEDOUT, Atomics.wait(ia, 0, 0, 0));
+assertEquals(Atomics.TIMEDOUT, Atomics.wait(ia, 0, 0, 10));
+assertEquals(Atomics.TIMEDOUT, Atomics.wait(ia, 0, 0, -10));
+assertEquals(0, Atomics.wake(ia, 0));
+assertEquals(0, Atomics.wake(ia, 0, 1));
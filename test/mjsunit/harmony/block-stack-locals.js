@@ -0,0 +1,133 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-scoping --stack-allocate-block-locals --allow-natives-syntax
+// Flags: --expose-debug-as debug
+
+"use strict";
+
+// Block scoped variables that no closure captures live in the stack frame of
+// the function; the others stay in a block context.
+
+function inLoop(n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    let square = i * i;
+    sum += square;
+  }
+  return sum;
+}
+
+function nested(x) {
+  let result = 0;
+  {
+    let a = x + 1;
+    {
+      let b = a * 2;
+      result += b;
+    }
+    {
+      // A sibling of the block above, which may share its slot.
+      let c = a * 3;
+      result += c;
+    }
+  }
+  {
+    let d = x - 1;
+    result += d;
+  }
+  return result;
+}
+
+function captured(n) {
+  let closures = [];
+  for (let i = 0; i < n; i++) {
+    let kept = i * 10;
+    let dropped = i + 1;
+    closures.push(function() { return kept; });
+    kept += dropped;
+  }
+  let total = 0;
+  for (let j = 0; j < closures.length; j++) total += closures[j]();
+  return total;
+}
+
+function breakAndContinue(n) {
+  let count = 0;
+  outer: for (let i = 0; i < n; i++) {
+    {
+      let skip = i % 2 == 0;
+      if (skip) continue outer;
+      {
+        let stop = i > 7;
+        if (stop) break outer;
+      }
+    }
+    count++;
+  }
+  return count;
+}
+
+function temporalDeadZone() {
+  {
+    try {
+      x;
+      return "no error";
+    } catch (e) {
+      assertInstanceof(e, ReferenceError);
+    }
+    let x = 1;
+    return x;
+  }
+}
+
+function check() {
+  assertEquals(285, inLoop(10));
+  assertEquals(34, nested(5));
+  assertEquals(505, captured(10));
+  assertEquals(4, breakAndContinue(20));
+  assertEquals(1, temporalDeadZone());
+}
+
+check();
+check();
+%OptimizeFunctionOnNextCall(inLoop);
+%OptimizeFunctionOnNextCall(nested);
+%OptimizeFunctionOnNextCall(captured);
+%OptimizeFunctionOnNextCall(breakAndContinue);
+check();
+
+
+// The debugger sees the block locals in the frame.
+var Debug = debug.Debug;
+var exception = null;
+var block_scope = null;
+
+function listener(event, exec_state, event_data, data) {
+  if (event != Debug.DebugEvent.Break) return;
+  try {
+    var frame = exec_state.frame(0);
+    assertEquals(debug.ScopeType.Block, frame.scope(0).scopeType());
+    block_scope = frame.scope(0).scopeObject().value();
+  } catch (e) {
+    exception = e;
+  }
+}
+
+Debug.setListener(listener);
+
+function inspected(x) {
+  let outside = 1;
+  {
+    let inside = x * 2;
+    debugger;
+    return inside + outside;
+  }
+}
+
+assertEquals(7, inspected(3));
+Debug.setListener(null);
+assertNull(exception);
+assertEquals(6, block_scope.inside);
+assertFalse("outside" in block_scope);
@@ -0,0 +1,67 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-proxies
+
+// Traps are found wherever the handler has them, and changes to the
+// handler are seen by the next operation.
+
+function Handler() {}
+Handler.prototype.get = function(receiver, name) { return "proto " + name; };
+Handler.prototype.has = function(name) { return name == "x"; };
+
+var handler = new Handler();
+var proxy = Proxy.create(handler);
+
+for (var i = 0; i < 3; i++) {
+  assertEquals("proto x", proxy.x);
+  assertTrue("x" in proxy);
+  assertFalse("y" in proxy);
+}
+
+// An own trap shadows the one on the prototype.
+handler.get = function(receiver, name) { return "own " + name; };
+assertEquals("own x", proxy.x);
+
+// Replacing the trap is seen right away.
+handler.get = function(receiver, name) { return "new " + name; };
+assertEquals("new x", proxy.x);
+
+// Traps can be accessors.
+var getter_calls = 0;
+Object.defineProperty(handler, "get", {
+  get: function() {
+    getter_calls++;
+    return function(receiver, name) { return "accessor " + name; };
+  },
+  configurable: true
+});
+assertEquals("accessor x", proxy.x);
+assertEquals("accessor y", proxy.y);
+assertEquals(2, getter_calls);
+
+// Without a get trap the derived trap uses getPropertyDescriptor.
+delete handler.get;
+delete Handler.prototype.get;
+handler.getPropertyDescriptor = function(name) {
+  return { value: "derived " + name, configurable: true };
+};
+assertEquals("derived x", proxy.x);
+
+// The set trap.
+var stored = {};
+handler.set = function(receiver, name, value) {
+  stored[name] = value;
+  return true;
+};
+proxy.z = 42;
+assertEquals(42, stored.z);
+
+// Handlers in dictionary mode.
+var dictionary_handler = {
+  get: function(receiver, name) { return "dictionary " + name; }
+};
+for (var i = 0; i < 100; i++) dictionary_handler["p" + i] = i;
+delete dictionary_handler.p0;
+assertEquals("dictionary x", Proxy.create(dictionary_handler).x);
@@ -0,0 +1,132 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-simd --allow-natives-syntax
+
+// Creation, typeof and lanes.
+var f4 = SIMD.Float32x4(1, 2.5, -3, 4);
+assertEquals("float32x4", typeof f4);
+assertTrue(typeof f4 === "float32x4");
+assertFalse(typeof f4 === "object");
+assertEquals(1, SIMD.Float32x4.extractLane(f4, 0));
+assertEquals(2.5, SIMD.Float32x4.extractLane(f4, 1));
+assertEquals(-3, SIMD.Float32x4.extractLane(f4, 2));
+assertEquals(4, SIMD.Float32x4.extractLane(f4, 3));
+assertEquals(Math.fround(0.1),
+             SIMD.Float32x4.extractLane(SIMD.Float32x4.splat(0.1), 2));
+assertSame(f4, SIMD.Float32x4.check(f4));
+assertThrows(function() { new SIMD.Float32x4(1, 2, 3, 4); }, TypeError);
+assertThrows(function() { SIMD.Float32x4.check(1); }, TypeError);
+assertThrows(function() { SIMD.Float32x4.extractLane(f4, 4); }, RangeError);
+assertThrows(function() { SIMD.Float32x4.extractLane(f4, 0.5); }, RangeError);
+assertThrows(function() { SIMD.Float32x4.extractLane(f4, "0"); }, RangeError);
+
+var i4 = SIMD.Int32x4(1, -2, 3.7, 0x100000001);
+assertEquals("int32x4", typeof i4);
+assertEquals(3, SIMD.Int32x4.extractLane(i4, 2));
+assertEquals(1, SIMD.Int32x4.extractLane(i4, 3));
+
+var d2 = SIMD.Float64x2(0.1, -0.2);
+assertEquals("float64x2", typeof d2);
+assertEquals(0.1, SIMD.Float64x2.extractLane(d2, 0));
+assertThrows(function() { SIMD.Float64x2.extractLane(d2, 2); }, RangeError);
+
+// Replacing a lane creates a new value.
+var r4 = SIMD.Float32x4.replaceLane(f4, 0, 10);
+assertEquals(10, SIMD.Float32x4.extractLane(r4, 0));
+assertEquals(1, SIMD.Float32x4.extractLane(f4, 0));
+
+// toString, valueOf and wrappers.
+assertEquals("Float32x4(1, 2.5, -3, 4)", f4.toString());
+assertEquals("Int32x4(1, -2, 3, 1)", String(i4));
+assertEquals("Float64x2(0.1, -0.2)", "" + d2);
+var wrapper = Object(f4);
+assertEquals("object", typeof wrapper);
+assertEquals("[object Float32x4]", Object.prototype.toString.call(wrapper));
+assertSame(f4, wrapper.valueOf());
+assertSame(SIMD.Float32x4.prototype, Object.getPrototypeOf(wrapper));
+
+// SIMD values are always true.
+assertTrue(!!SIMD.Float32x4(0, 0, 0, 0));
+assertTrue(!!SIMD.Int32x4(0, 0, 0, 0));
+function truthy(value) { return value ? true : false; }
+for (var i = 0; i < 3; i++) {
+  assertTrue(truthy(SIMD.Float64x2(0, 0)));
+  assertFalse(truthy(0));
+}
+%OptimizeFunctionOnNextCall(truthy);
+assertTrue(truthy(SIMD.Float64x2(0, 0)));
+assertTrue(truthy(SIMD.Int32x4(0, 0, 0, 0)));
+
+// Typeof comparisons in optimized code.
+function isInt32x4(value) { return typeof value === "int32x4"; }
+assertTrue(isInt32x4(i4));
+assertFalse(isInt32x4(f4));
+%OptimizeFunctionOnNextCall(isInt32x4);
+assertTrue(isInt32x4(i4));
+assertFalse(isInt32x4(d2));
+assertFalse(isInt32x4({}));
+
+// Arithmetic.
+var sum = SIMD.Float32x4.add(f4, SIMD.Float32x4.splat(1));
+assertEquals("Float32x4(2, 3.5, -2, 5)", sum.toString());
+var quotient = SIMD.Float64x2.div(SIMD.Float64x2(1, -1),
+                                  SIMD.Float64x2.splat(0));
+assertEquals(Infinity, SIMD.Float64x2.extractLane(quotient, 0));
+assertEquals(-Infinity, SIMD.Float64x2.extractLane(quotient, 1));
+assertEquals("Float32x4(1, 2.5, 3, 4)", SIMD.Float32x4.abs(f4).toString());
+assertEquals("Float64x2(3, 4)",
+             SIMD.Float64x2.sqrt(SIMD.Float64x2(9, 16)).toString());
+assertThrows(function() { SIMD.Float32x4.add(f4, i4); }, TypeError);
+
+// Integer lanes wrap around.
+var max = SIMD.Int32x4.splat(0x7fffffff);
+var wrapped = SIMD.Int32x4.add(max, SIMD.Int32x4.splat(1));
+assertEquals(-0x80000000, SIMD.Int32x4.extractLane(wrapped, 0));
+assertEquals(-0x80000000,
+             SIMD.Int32x4.extractLane(SIMD.Int32x4.neg(wrapped), 1));
+assertEquals(1, SIMD.Int32x4.extractLane(SIMD.Int32x4.mul(max, max), 2));
+assertEquals("Int32x4(-2, 1, -4, -2)", SIMD.Int32x4.not(i4).toString());
+assertEquals(2, SIMD.Int32x4.extractLane(
+    SIMD.Int32x4.xor(SIMD.Int32x4.splat(3), SIMD.Int32x4.splat(1)), 0));
+
+// Min and max propagate NaN and order -0 before 0.
+var nan = SIMD.Float32x4.min(SIMD.Float32x4(NaN, 1, -0, 0),
+                             SIMD.Float32x4(1, 2, 0, -0));
+assertTrue(isNaN(SIMD.Float32x4.extractLane(nan, 0)));
+assertEquals(1, SIMD.Float32x4.extractLane(nan, 1));
+assertEquals(-Infinity, 1 / SIMD.Float32x4.extractLane(nan, 2));
+assertEquals(-Infinity, 1 / SIMD.Float32x4.extractLane(nan, 3));
+var big = SIMD.Float64x2.max(SIMD.Float64x2(-0, 3), SIMD.Float64x2(0, NaN));
+assertEquals(Infinity, 1 / SIMD.Float64x2.extractLane(big, 0));
+assertTrue(isNaN(SIMD.Float64x2.extractLane(big, 1)));
+
+// Conversions.
+assertEquals("Float32x4(1, -2, 3, 1)",
+             SIMD.Float32x4.fromInt32x4(i4).toString());
+assertEquals("Int32x4(1, 2, -3, 4)",
+             SIMD.Int32x4.fromFloat32x4(f4).toString());
+
+// Loads and stores go through typed arrays, indexed by their elements.
+var fa = new Float32Array(8);
+for (var i = 0; i < fa.length; i++) fa[i] = i;
+var loaded = SIMD.Float32x4.load(fa, 3);
+assertEquals("Float32x4(3, 4, 5, 6)", loaded.toString());
+SIMD.Float32x4.store(fa, 4, f4);
+assertEquals(2.5, fa[5]);
+assertEquals(4, fa[7]);
+var ia = new Int32Array(fa.buffer);
+assertEquals("Int32x4(0, 1065353216, 1073741824, 1077936128)",
+             SIMD.Int32x4.load(ia, 0).toString());
+var ba = new Uint8Array(32);
+SIMD.Float64x2.store(ba, 16, SIMD.Float64x2(1, 2));
+assertEquals(2, new Float64Array(ba.buffer)[3]);
+assertThrows(function() { SIMD.Float32x4.load(fa, 5); }, RangeError);
+assertThrows(function() { SIMD.Float32x4.load(fa, -1); }, RangeError);
+assertThrows(function() { SIMD.Float64x2.store(ba, 17, d2); }, RangeError);
+assertThrows(function() { SIMD.Float32x4.load([1, 2, 3, 4], 0); }, TypeError);
+assertThrows(function() {
+  SIMD.Float32x4.load(new DataView(fa.buffer), 0);
+}, TypeError);
+assertThrows(function() { SIMD.Float32x4.store(fa, 0, i4); }, TypeError);
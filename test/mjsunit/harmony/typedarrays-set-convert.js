@@ -0,0 +1,80 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Conversions between typed arrays of different element types, both through
+// TypedArray.prototype.set and through the typed array constructors.
+
+var values = [0, 1, -1, 127, 128, 255, 256, -129, 32767, 32768, 65535,
+              65536, 2147483647, 2147483648, 4294967295, 4294967296,
+              0.5, 1.5, 2.5, -0.5, 254.5, 255.5, -1.5, 1e20, -1e20,
+              NaN, Infinity, -Infinity];
+
+var types = [Int8Array, Uint8Array, Uint8ClampedArray, Int16Array,
+             Uint16Array, Int32Array, Uint32Array, Float32Array,
+             Float64Array];
+
+// Reference conversion through the ordinary element store.
+function Expected(TargetType, source) {
+  var result = new TargetType(source.length);
+  for (var i = 0; i < source.length; i++) result[i] = source[i];
+  return result;
+}
+
+function AssertSameElements(expected, actual) {
+  assertEquals(expected.length, actual.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals(expected[i], actual[i], "index " + i);
+  }
+}
+
+function TestSetConversion(SourceType, TargetType) {
+  var source = new SourceType(values);
+  var expected = Expected(TargetType, source);
+
+  var target = new TargetType(source.length);
+  target.set(source);
+  AssertSameElements(expected, target);
+
+  var shifted = new TargetType(source.length + 3);
+  shifted.set(source, 3);
+  for (var i = 0; i < 3; i++) assertEquals(0, shifted[i]);
+  AssertSameElements(expected, shifted.subarray(3));
+
+  AssertSameElements(expected, new TargetType(source));
+}
+
+for (var i = 0; i < types.length; i++) {
+  for (var j = 0; j < types.length; j++) {
+    TestSetConversion(types[i], types[j]);
+  }
+}
+
+// Clamping rounds to even and maps NaN to zero.
+var clamped = new Uint8ClampedArray(new Float64Array(
+    [NaN, -1, 0.5, 1.5, 2.5, 254.5, 255.5, 300, Infinity]));
+AssertSameElements([0, 0, 0, 2, 2, 254, 255, 255, 255], clamped);
+clamped.set(new Int32Array([-5, 5, 500]));
+AssertSameElements([0, 5, 255], clamped.subarray(0, 3));
+
+// Overlapping arrays of different types over the same buffer.
+function TestOverlapping(SourceType, sourceOffset, sourceLength,
+                         TargetType, targetOffset, offset) {
+  var buffer = new ArrayBuffer(64);
+  var bytes = new Uint8Array(buffer);
+  for (var i = 0; i < bytes.length; i++) bytes[i] = i * 7 + 3;
+  var source = new SourceType(buffer, sourceOffset, sourceLength);
+  var target = new TargetType(buffer, targetOffset);
+  var expected = Expected(TargetType, source);
+  target.set(source, offset);
+  AssertSameElements(expected,
+                     target.subarray(offset, offset + sourceLength));
+}
+
+TestOverlapping(Uint8Array, 0, 16, Int16Array, 0, 0);
+TestOverlapping(Uint8Array, 16, 16, Int16Array, 0, 0);
+TestOverlapping(Int16Array, 0, 8, Uint8Array, 8, 0);
+TestOverlapping(Int16Array, 16, 8, Uint8Array, 0, 4);
+TestOverlapping(Float64Array, 0, 4, Int32Array, 8, 1);
+TestOverlapping(Int32Array, 16, 4, Float64Array, 0, 2);
+TestOverlapping(Float32Array, 4, 8, Uint8ClampedArray, 0, 8);
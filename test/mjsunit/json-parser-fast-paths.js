@@ -0,0 +1,65 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Strings: quotes, escapes and control characters at every offset relative
+// to word boundaries.
+var padding = "";
+for (var i = 0; i < 40; i++) {
+  assertEquals(padding, JSON.parse('"' + padding + '"'));
+  assertEquals(padding + "\"x", JSON.parse('"' + padding + '\\"x"'));
+  assertEquals(padding + "\\", JSON.parse('"' + padding + '\\\\"'));
+  assertEquals(padding + "\u00e9\u00ff",
+               JSON.parse('"' + padding + '\u00e9\u00ff"'));
+  assertEquals(["a" + padding, padding],
+               JSON.parse('["a' + padding + '","' + padding + '"]'));
+  assertThrows(function() { JSON.parse('"' + padding + '\n"'); });
+  assertThrows(function() { JSON.parse('"' + padding + '\x1f"'); });
+  assertThrows(function() { JSON.parse('"' + padding + '\x00"'); });
+  assertThrows(function() { JSON.parse('"' + padding); });
+  padding += String.fromCharCode(0x20 + (i * 37) % 0x5e);
+  padding = padding.replace(/["\\]/g, "_");
+}
+assertEquals("\x7f\x80", JSON.parse('"\x7f\x80"'));
+assertEquals({ key: "value" }, JSON.parse('{"key":"value"}'));
+
+// Numbers.
+assertEquals(0, JSON.parse("0"));
+assertEquals(-Infinity, 1 / JSON.parse("-0"));
+assertEquals(Infinity, 1 / JSON.parse("0"));
+assertEquals(123456789, JSON.parse("123456789"));
+assertEquals(-123456789, JSON.parse("-123456789"));
+assertEquals(1234567890, JSON.parse("1234567890"));
+assertEquals(-2147483648, JSON.parse("-2147483648"));
+assertEquals(4294967296, JSON.parse("4294967296"));
+assertEquals(999999999999999, JSON.parse("999999999999999"));
+assertEquals(-999999999999999, JSON.parse("-999999999999999"));
+assertEquals(9007199254740993, JSON.parse("9007199254740993"));
+assertEquals(12345678901234567890, JSON.parse("12345678901234567890"));
+assertEquals(1e300, JSON.parse("1" + new Array(301).join("0")));
+assertEquals(1.5, JSON.parse("1.5"));
+assertEquals(-0.5, JSON.parse("-0.5"));
+assertEquals(1e10, JSON.parse("1e10"));
+assertEquals([10000000000, -1, 0], JSON.parse("[10000000000 , -1,0]"));
+assertThrows(function() { JSON.parse("01"); });
+assertThrows(function() { JSON.parse("-"); });
+assertThrows(function() { JSON.parse("1."); });
+
+// Objects following the shape of their predecessors at the same depth.
+var records = JSON.parse(
+    '[{"a":1,"b":{"x":1,"y":2}},{"a":2,"b":{"x":3,"y":4}},' +
+    '{"a":3,"c":5},{"b":{"y":6,"x":7},"a":4},{"a":5,"b":{"x":8,"z":9}},' +
+    '{"a":"s","b":{"x":8.5,"y":null}}, {"a":6}]');
+assertEquals([{ a: 1, b: { x: 1, y: 2 } }, { a: 2, b: { x: 3, y: 4 } },
+              { a: 3, c: 5 }, { b: { y: 6, x: 7 }, a: 4 },
+              { a: 5, b: { x: 8, z: 9 } }, { a: "s", b: { x: 8.5, y: null } },
+              { a: 6 }], records);
+assertEquals(["b", "a"], Object.keys(records[3]));
+assertEquals(["y", "x"], Object.keys(records[3].b));
+assertTrue(%HaveSameMap(records[0], records[1]));
+assertTrue(%HaveSameMap(records[0].b, records[1].b));
+// Keys that only share a prefix with the predicted key.
+assertEquals([{ ab: 1 }, { a: 2 }, { abc: 3 }],
+             JSON.parse('[{"ab":1},{"a":2},{"abc":3}]'));
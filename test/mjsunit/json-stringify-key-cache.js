@@ -0,0 +1,48 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Rows of the same shape share their serialized key prefixes.
+var rows = [];
+for (var i = 0; i < 100; i++) {
+  rows.push({ id: i, "quo\"te": i / 4, "\n": "x" + i, u: undefined });
+}
+var expected = "[";
+for (var i = 0; i < 100; i++) {
+  if (i > 0) expected += ",";
+  expected += '{"id":' + i + ',"quo\\"te":' + (i / 4) +
+              ',"\\n":"x' + i + '"}';
+}
+expected += "]";
+assertEquals(expected, JSON.stringify(rows));
+
+// A skipped first property must not leave a leading comma.
+var skipped = [{ a: undefined, b: 1 }, { a: function() {}, b: 2.5 }];
+assertEquals('[{"b":1},{"b":2.5}]', JSON.stringify(skipped));
+
+// Non-finite doubles in number fields.
+var doubles = [{ d: 0.5 }, { d: NaN }, { d: Infinity }, { d: -0 }];
+assertEquals('[{"d":0.5},{"d":null},{"d":null},{"d":0}]',
+             JSON.stringify(doubles));
+
+// Fields that change representation deprecate the map of earlier rows.
+var a = { x: 1, y: 2 };
+var b = { x: 1, y: 2 };
+b.x = 1.5;
+b.x = "s";
+assertEquals('[{"x":1,"y":2},{"x":"s","y":2}]', JSON.stringify([a, b]));
+assertEquals('[{"x":1,"y":2},{"x":"s","y":2}]', JSON.stringify([a, b]));
+
+// The output switches to two-byte in the middle of cached prefixes.
+var mixed = [];
+for (var i = 0; i < 20; i++) mixed.push({ k: i, v: i == 10 ? "ሴ" : "" });
+var result = JSON.parse(JSON.stringify(mixed));
+assertEquals(20, result.length);
+assertEquals(19, result[19].k);
+assertEquals("ሴ", result[10].v);
+
+// Two-byte keys, and holders of number fields that define toJSON.
+assertEquals('[{"ሴ":1},{"ሴ":2}]',
+             JSON.stringify([{ "ሴ": 1 }, { "ሴ": 2 }]));
+var p = { n: 1, toJSON: function() { return 7; } };
+assertEquals('[7,{"n":1}]', JSON.stringify([p, { n: 1 }]));
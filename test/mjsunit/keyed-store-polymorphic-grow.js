@@ -0,0 +1,60 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// A polymorphic keyed store site over smi and double arrays that starts to
+// grow its receivers afterwards.
+
+function store(a, i, v) {
+  a[i] = v;
+}
+
+function load(a, i) {
+  return a[i];
+}
+
+var smis = [1, 2, 3];
+var doubles = [1.5, 2.5, 3.5];
+var objects = [{}, {}, {}];
+
+for (var i = 0; i < 3; i++) {
+  store(smis, i, i);
+  store(doubles, i, i + 0.5);
+  store(objects, i, "x");
+}
+
+// Grow all of them at the end.
+for (var i = 3; i < 10; i++) {
+  store(smis, i, i);
+  store(doubles, i, i + 0.5);
+  store(objects, i, "y");
+}
+
+for (var i = 0; i < 10; i++) {
+  assertEquals(i, load(smis, i));
+  assertEquals(i + 0.5, load(doubles, i));
+  assertEquals(i < 3 ? "x" : "y", load(objects, i));
+}
+assertEquals(10, smis.length);
+assertEquals(10, doubles.length);
+assertEquals(10, objects.length);
+
+// Copy-on-write literals at the same site.
+function cow() { return [1, 2, 3]; }
+var c1 = cow();
+var c2 = cow();
+store(c1, 0, 42);
+assertEquals(42, c1[0]);
+assertEquals(1, c2[0]);
+assertEquals(1, cow()[0]);
+
+%OptimizeFunctionOnNextCall(store);
+store(smis, 10, 10);
+store(doubles, 10, 10.5);
+store(objects, 10, "z");
+assertEquals(10, smis[10]);
+assertEquals(10.5, doubles[10]);
+assertEquals("z", objects[10]);
+assertEquals(11, smis.length);
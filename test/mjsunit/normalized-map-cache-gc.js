@@ -0,0 +1,27 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc
+
+// Normalized maps that are still in use stay in the cache across GCs, so
+// objects normalized before and after a GC share their map.
+function make() {
+  var o = { a: 1, b: 2 };
+  delete o.a;
+  return o;
+}
+
+var first = make();
+assertFalse(%HasFastProperties(first));
+gc();
+var second = make();
+assertTrue(%HaveSameMap(first, second));
+assertEquals(2, second.b);
+
+// Dropping every object with the normalized map lets the cache forget it.
+first = second = null;
+gc();
+var third = make();
+assertFalse(%HasFastProperties(third));
+assertEquals(undefined, third.a);
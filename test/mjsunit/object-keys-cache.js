@@ -0,0 +1,55 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-gc
+
+// Object.keys results of objects with the same map may share their backing
+// store; they must still behave like independent arrays.
+
+function Point(x, y) { this.x = x; this.y = y; }
+
+var a = new Point(1, 2);
+var b = new Point(3, 4);
+var keys_a = Object.keys(a);
+var keys_b = Object.keys(b);
+assertEquals(["x", "y"], keys_a);
+assertEquals(["x", "y"], keys_b);
+assertFalse(keys_a === keys_b);
+
+keys_a.push("z");
+keys_a[0] = "changed";
+assertEquals(["changed", "y", "z"], keys_a);
+assertEquals(["x", "y"], keys_b);
+assertEquals(["x", "y"], Object.keys(new Point(5, 6)));
+
+keys_b.sort(function(l, r) { return l < r ? 1 : -1; });
+assertEquals(["y", "x"], keys_b);
+assertEquals(["x", "y"], Object.keys(a));
+
+keys_b.length = 0;
+assertEquals(["x", "y"], Object.keys(b));
+
+// Adding elements does not change the map, but adds keys.
+var c = new Point(7, 8);
+c[0] = "element";
+assertEquals(["0", "x", "y"], Object.keys(c));
+assertEquals(["x", "y"], Object.keys(new Point(9, 10)));
+
+// Adding, deleting or hiding properties changes the keys.
+var d = new Point(1, 1);
+d.z = 3;
+assertEquals(["x", "y", "z"], Object.keys(d));
+delete d.x;
+assertEquals(["y", "z"], Object.keys(d));
+var e = new Point(1, 1);
+Object.defineProperty(e, "x", { enumerable: false });
+assertEquals(["y"], Object.keys(e));
+assertEquals(["x", "y"], Object.keys(new Point(2, 2)));
+
+// Keys survive garbage collections.
+var f = new Point(0, 0);
+Object.keys(f);
+gc();
+assertEquals(["x", "y"], Object.keys(f));
+assertEquals([], Object.keys({}));
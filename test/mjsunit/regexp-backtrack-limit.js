@@ -0,0 +1,30 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-backtrack-limit=100000
+
+var subject = new Array(40).join("a") + "c";
+
+// Regexps that backtrack little are not affected.
+assertEquals(["aab", "aa"], /(a+)b/.exec("xaab"));
+assertEquals(null, /(a+)b/.exec(subject));
+assertEquals(["a", "a"], "aa".match(/a/g));
+
+// Patterns without backreferences or lookaheads are matched again with the
+// non-backtracking engine once they exceed the limit.
+var re = /(a+)+b/;
+assertEquals(null, re.exec(subject));
+assertEquals(null, re.exec(subject));
+assertEquals(["aab", "aa"], re.exec("xaab"));
+assertEquals(["aaab", "a"], /(a|aa)+b/.exec("aaab"));
+assertEquals(null, /(a|aa)+b/.exec(subject));
+assertEquals("-c", subject.replace(/(a+)+/g, "-"));
+
+// Other patterns throw an exception that can be caught.
+var backreference = /(a+)+\1b/;
+assertThrows(function() { backreference.exec(subject); }, RangeError);
+assertEquals(["aab", "a"], backreference.exec("aab"));
+var lookahead = /(a+)+(?=b)/;
+assertThrows(function() { lookahead.test(subject); }, RangeError);
+assertTrue(lookahead.test("aab"));
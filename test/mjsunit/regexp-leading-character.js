@@ -0,0 +1,40 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Regexps whose matches all start with the same character skip ahead to its
+// first occurrence in the subject.
+
+var padding = new Array(1000).join("-");
+
+assertEquals(["x1", "1"], /x(\d)/.exec(padding + "x1"));
+assertEquals(null, /x(\d)/.exec(padding));
+assertEquals(["xa", "xa"], /(x[a-z])/.exec("x-" + padding + "xa"));
+assertEquals(["x"], /\bx/.exec(padding + "ax x"));
+assertEquals(["x"], /^x/m.exec(padding + "\nx"));
+assertEquals(null, /^x/.exec(padding + "x"));
+assertEquals(["xx"], /(?:xy|xx)/.exec(padding + "xx"));
+assertEquals(["y"], /x?y/.exec(padding + "y"));
+assertEquals(["abab", "ab"], /(ab)+/.exec(padding + "abab"));
+
+// Global matching and replacing.
+var subject = padding + "x1" + padding + "x2" + padding;
+assertEquals(["x1", "x2"], subject.match(/x\d/g));
+assertEquals(padding + "[1]" + padding + "[2]" + padding,
+             subject.replace(/x(\d)/g, "[$1]"));
+assertEquals(3, subject.split(/x\d/).length);
+
+var re = /x(\d)/g;
+assertEquals(["x1", "1"], re.exec(subject));
+assertEquals(padding.length + 2, re.lastIndex);
+assertEquals(["x2", "2"], re.exec(subject));
+assertEquals(null, re.exec(subject));
+assertEquals(0, re.lastIndex);
+
+// Two-byte subjects and leading characters.
+assertEquals(["\u1234x"], /\u1234x/.exec(padding + "\u1234x"));
+assertEquals(null, /\u1234x/.exec(padding + "x"));
+assertEquals(["ax"], /ax/.exec("\u1234" + padding + "ax"));
+
+// Case independent regexps match either case.
+assertEquals(["X1"], /x\d/i.exec(padding + "X1"));
@@ -0,0 +1,60 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-nfa --harmony-regexps
+
+// Captures and alternatives are chosen in the same order as by the
+// backtracking engine.
+assertEquals(["abc", "a", "bc"], /(a)(bc)/.exec("xabc"));
+assertEquals(["a", "a"], /(a|ab)/.exec("abc"));
+assertEquals(["ab", "ab"], /(ab|a)/.exec("abc"));
+assertEquals(["aaa", "aaa"], /(a*)/.exec("aaab"));
+assertEquals(["", ""], /(a*?)/.exec("aaab"));
+assertEquals(["aab", "a"], /(a+?)ab/.exec("aab"));
+assertEquals(["aaa", "aa", "a"], /(a+)(a)/.exec("aaa"));
+assertEquals(["aaa", "a", "aa"], /(a+?)(a+)/.exec("aaa"));
+assertEquals(["abab", "ab"], /(ab){2}/.exec("ababab"));
+assertEquals(["aaa"], /a{2,3}/.exec("aaaa"));
+assertEquals(["aa"], /a{2,3}?/.exec("aaaa"));
+assertEquals(null, /a{2,3}b/.exec("ab"));
+assertEquals(["zaacbbbcac", "z", "ac", "a", undefined, "c"],
+             /(z)((a+)?(b+)?(c))*/.exec("zaacbbbcac"));
+assertEquals(["b", undefined], /(a)?b/.exec("b"));
+assertEquals(["", undefined], /(a*)*/.exec("b"));
+
+// Flags.
+assertEquals(["aBc"], /abc/i.exec("xaBc"));
+assertEquals(["KK"], /[^a-z]+/.exec("abKK"));
+assertEquals(["b"], /^b/m.exec("a\nb"));
+assertEquals(null, /^b/.exec("a\nb"));
+assertEquals(["a"], /a$/m.exec("a\nb"));
+assertEquals(["foo"], /\bfoo\b/.exec("a foo b"));
+assertEquals(null, /\bfoo\b/.exec("afoo"));
+assertEquals(["oo"], /\Boo/.exec("foo"));
+assertEquals(["a", "b", "c"], "a b c".match(/\w/g));
+assertEquals("x-y-z", "x y z".replace(/ /g, "-"));
+assertEquals(["ab", "ab"], "abab".match(/ab/g));
+
+var sticky = /b/y;
+assertEquals(null, sticky.exec("ab"));
+sticky.lastIndex = 1;
+assertEquals(["b"], sticky.exec("ab"));
+assertEquals(2, sticky.lastIndex);
+
+// Two-byte subjects.
+assertEquals(["\u1234b", "\u1234"], /(.)b/.exec("a\u1234b"));
+assertEquals(["\u2028x"], /\sx/.exec("a\u2028x"));
+assertEquals(["x"], /^x/m.exec("a\u2028x"));
+assertEquals(["\u00e9"], /[\u00c9]/i.exec("\u00e9"));
+
+// Matching takes linear time for patterns that backtrack exponentially.
+var subject = new Array(40).join("a") + "b";
+assertEquals(null, /(a+)+$/.exec(subject));
+assertEquals(null, /(a|aa)*c/.exec(subject));
+assertEquals(null, /(a*)*c/.exec(subject));
+
+// Patterns with lookaheads and backreferences are left to Irregexp.
+assertEquals(["aa", "a"], /(a)\1/.exec("baab"));
+assertEquals(["a"], /a(?=b)/.exec("acab"));
+assertEquals(["a"], /a(?!c)/.exec("acab"));
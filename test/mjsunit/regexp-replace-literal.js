@@ -0,0 +1,34 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Global regexp replacements with a literal replacement string.
+
+function escape(s) {
+  return s.replace(/&/g, "&amp;").replace(/</g, "&lt;").replace(/[>]/g, "&gt;");
+}
+
+assertEquals("&lt;a href=&gt;x&amp;y&lt;/a&gt;", escape("<a href=>x&y</a>"));
+assertEquals("plain", escape("plain"));
+assertEquals("", "".replace(/x+/g, "y"));
+
+assertEquals("-b-c-", "abaca".replace(/a/g, "-"));
+assertEquals("<>b<>", "aaba".replace(/a+/g, "<>"));
+assertEquals("xaxbxcx", "abc".replace(/(?:)/g, "x"));
+assertEquals("[][][]", "aaa".replace(/(a)/g, "[]"));
+assertEquals("1.2.3", "1 - 2 -   3".replace(/\s*-\s*/g, "."));
+
+// Two-byte subjects and replacements.
+assertEquals("\u1234-\u1234", "\u1234a\u1234".replace(/a/g, "-"));
+assertEquals("x\u2028x", "xax".replace(/a/g, "\u2028"));
+assertEquals("\u00e9\u00e9", "\u00e9a\u00e9".replace(/a/g, ""));
+
+// The last match info reflects the last match.
+"a1b22c333".replace(/(\d)+/g, "#");
+assertEquals("333", RegExp.lastMatch);
+assertEquals("3", RegExp.$1);
+assertEquals("a1b22c", RegExp.leftContext);
+
+// Replacements with substitutions still work.
+assertEquals("[a][b]", "ab".replace(/(.)/g, "[$1]"));
+assertEquals("a$b", "ab".replace(/a/g, "$&$$"));
@@ -0,0 +1,52 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The constructor of an error can override Error.stackTraceLimit.
+
+function countFrames(error) {
+  return error.stack.split("\n    at ").length - 1;
+}
+
+function nest(depth, f) {
+  return depth == 0 ? f() : nest(depth - 1, f);
+}
+
+function makeTypeError() { return new TypeError("type"); }
+function makeRangeError() { return new RangeError("range"); }
+function throwTypeError() {
+  try {
+    undefined.foo;
+  } catch (e) {
+    return e;
+  }
+}
+
+Error.stackTraceLimit = 5;
+assertEquals(5, countFrames(nest(10, makeTypeError)));
+assertEquals(5, countFrames(nest(10, makeRangeError)));
+
+TypeError.stackTraceLimit = 0;
+assertEquals("TypeError: type", nest(10, makeTypeError).stack);
+assertEquals(0, countFrames(nest(10, throwTypeError)));
+assertEquals(5, countFrames(nest(10, makeRangeError)));
+
+TypeError.stackTraceLimit = 2;
+assertEquals(2, countFrames(nest(10, makeTypeError)));
+assertEquals(2, countFrames(nest(10, throwTypeError)));
+
+// A limit that is not a number falls back to the one of Error.
+TypeError.stackTraceLimit = "not a number";
+assertEquals(5, countFrames(nest(10, makeTypeError)));
+delete TypeError.stackTraceLimit;
+assertEquals(5, countFrames(nest(10, makeTypeError)));
+
+// Error.captureStackTrace uses the constructor of the object.
+function CustomError() {
+  Error.captureStackTrace(this, CustomError);
+}
+function makeCustomError() { return new CustomError(); }
+CustomError.stackTraceLimit = 1;
+assertEquals(1, countFrames(nest(10, makeCustomError)));
+delete CustomError.stackTraceLimit;
+assertEquals(5, countFrames(nest(10, makeCustomError)));
@@ -0,0 +1,57 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Reading characters of cons strings, with and without flattening them, and
+// joining arrays of cons strings.
+
+var s = "";
+var expected = [];
+for (var i = 0; i < 500; i++) {
+  var chunk = "chunk" + i + (i % 7 == 0 ? "ሴ" : "") + ";";
+  s += chunk;
+  for (var j = 0; j < chunk.length; j++) expected.push(chunk.charCodeAt(j));
+  // Read a character in the middle of the string built so far.
+  var index = (s.length >> 1);
+  assertEquals(expected[index], s.charCodeAt(index));
+  assertEquals(String.fromCharCode(expected[index]), s.charAt(index));
+  assertEquals(String.fromCharCode(expected[index]), s[index]);
+}
+assertEquals(expected.length, s.length);
+
+// Repeated reads of the same cons string.
+for (var i = 0; i < expected.length; i++) {
+  assertEquals(expected[i], s.charCodeAt(i));
+}
+assertTrue(isNaN(s.charCodeAt(s.length)));
+assertEquals("", s.charAt(s.length));
+
+// Concatenating strings that were flattened.
+var flattened = s + "x";
+flattened.charCodeAt(0);
+flattened.charCodeAt(1);
+var combined = flattened + flattened;
+assertEquals(2 * flattened.length, combined.length);
+assertEquals(combined.charCodeAt(flattened.length - 1),
+             "x".charCodeAt(0));
+assertEquals(flattened, combined.substring(0, flattened.length));
+
+// Joining cons strings with a separator.
+function Cons(prefix, i) {
+  var result = prefix + "0123456789abcdef";
+  return result + i;
+}
+var one_byte = [];
+var two_byte = [];
+for (var i = 0; i < 20; i++) {
+  one_byte.push(Cons("element", i));
+  two_byte.push(Cons(i == 10 ? "€" : "element", i));
+}
+var joined = one_byte.join(", ");
+assertEquals(one_byte.length * 2 - 2 +
+             one_byte.reduce(function(a, e) { return a + e.length; }, 0),
+             joined.length);
+assertEquals(one_byte, joined.split(", "));
+assertEquals(two_byte, two_byte.join("ÿ").split("ÿ"));
+assertEquals(two_byte, two_byte.join(", ").split(", "));
+assertEquals(one_byte, one_byte.join("€").split("€"));
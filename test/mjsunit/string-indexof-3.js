@@ -0,0 +1,37 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Searches in two-byte subjects whose characters share a byte with the
+// first character of the pattern, which must not produce false hits.
+
+var two_byte = "䅁Ł䄁A䅂";
+assertEquals(-1, two_byte.indexOf("䄀"));
+assertEquals(-1, two_byte.indexOf("ŀ"));
+assertEquals(0, two_byte.indexOf("䅁"));
+assertEquals(1, two_byte.indexOf("Ł"));
+assertEquals(2, two_byte.indexOf("䄁"));
+assertEquals(3, two_byte.indexOf("A"));
+assertEquals(3, two_byte.indexOf("A䅂"));
+assertEquals(-1, two_byte.indexOf("A䅁"));
+assertEquals(4, two_byte.indexOf("䅂"));
+assertEquals(-1, two_byte.indexOf("䅂", 5));
+assertEquals(1, two_byte.indexOf("Ł䄁"));
+assertEquals(-1, two_byte.indexOf("Ł䅁"));
+
+// One-byte patterns in two-byte subjects and vice versa.
+var subject = "ሴ" + "xxxxxxxxaxxxxxxxxab";
+assertEquals(18, subject.indexOf("ab"));
+assertEquals(-1, "xxxxxxxaxxxxb".indexOf("aሴ"));
+assertEquals(-1, "xxxxAxxxx".indexOf("Ł"));
+
+// Candidates that match on the first and last character only.
+var s = "";
+for (var i = 0; i < 1000; i++) s += "a€b ";
+s += "a€c";
+assertEquals(4000, s.indexOf("a€c"));
+assertEquals(4000, s.indexOf("a€c", 3999));
+assertEquals(-1, s.indexOf("a€c", 4001));
+assertEquals(-1, s.indexOf("abc"));
+assertEquals(3, s.split("a€b").length - 998);
+assertEquals("x a€b ", s.substring(0, 8).replace("a€b", "x"));
@@ -0,0 +1,34 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Splits of computed strings are cached by subject identity; the results
+// must still behave like fresh arrays.
+
+var line = ["a", "bb", "", "ccc"].join(",");
+var first = line.split(",");
+var second = line.split(",");
+assertEquals(["a", "bb", "", "ccc"], first);
+assertEquals(["a", "bb", "", "ccc"], second);
+assertFalse(first === second);
+first.push("d");
+first[0] = "changed";
+assertEquals(["changed", "bb", "", "ccc", "d"], first);
+assertEquals(["a", "bb", "", "ccc"], line.split(","));
+
+// Equal but distinct subjects, other separators and limits.
+var other = ["a", "bb", "", "ccc"].join(",");
+assertEquals(["a", "bb", "", "ccc"], other.split(","));
+assertEquals(["a", "bb"], line.split(",", 2));
+assertEquals(["a"], line.split(",", 1));
+assertEquals(["a,bb,,", "", "", ""], line.split("c"));
+assertEquals(["a", ",ccc"], line.split(",bb,"));
+
+// Two-byte subjects and separators.
+var two_byte = ["\u1234", "x", "\u2345y"].join("\u00e9");
+assertEquals(["\u1234", "x", "\u2345y"], two_byte.split("\u00e9"));
+assertEquals(["\u1234", "x", "\u2345y"], two_byte.split("\u00e9"));
+var separator = ["\u1234", "", "\u1269", "\u34e9"].join("\u2c2c");
+assertEquals(["\u1234", "", "\u1269", "\u34e9"], separator.split("\u2c2c"));
+assertEquals(["\u1234\u2c2c\u2c2c", "\u2c2c\u34e9"], separator.split("\u1269"));
+assertEquals(["\u1234", ""], separator.split("\u2c2c", 2));
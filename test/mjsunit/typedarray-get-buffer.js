@@ -0,0 +1,42 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Optimized code reads the buffer of a typed array directly and only calls
+// into the runtime to materialize the buffer of on-heap typed arrays.
+function bufferOf(a) {
+  return a.buffer;
+}
+
+function tail(a) {
+  return a.subarray(1);
+}
+
+for (var i = 0; i < 3; i++) {
+  var small = new Uint8Array(4);
+  var large = new Float64Array(100);
+  if (i == 2) {
+    %OptimizeFunctionOnNextCall(bufferOf);
+    %OptimizeFunctionOnNextCall(tail);
+  }
+  small[1] = 7;
+  var buffer = bufferOf(small);
+  assertTrue(buffer instanceof ArrayBuffer);
+  assertEquals(4, buffer.byteLength);
+  assertSame(buffer, bufferOf(small));
+  assertSame(large.buffer, bufferOf(large));
+
+  var t = tail(new Uint8Array([1, 2, 3]));
+  assertEquals(2, t.length);
+  assertEquals(2, t[0]);
+  assertEquals(1, t.byteOffset);
+
+  var u = tail(small);
+  assertSame(buffer, u.buffer);
+  assertEquals(7, u[0]);
+  u[0] = 9;
+  assertEquals(9, small[1]);
+  assertEquals(99, tail(large).length);
+}
@@ -0,0 +1,105 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --unbox-double-fields --expose-gc
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+function length(p) {
+  return Math.sqrt(p.x * p.x + p.y * p.y);
+}
+
+function move(p, dx, dy) {
+  p.x += dx;
+  p.y += dy;
+}
+
+// Loads and stores through the ICs.
+var p = new Point(1.5, 2.5);
+assertEquals(1.5, p.x);
+assertEquals(2.5, p.y);
+move(p, 1.5, 1.5);
+assertEquals(3, p.x);
+assertEquals(4, p.y);
+assertEquals(5, length(p));
+
+// Loads and stores from optimized code.
+for (var i = 0; i < 3; i++) {
+  move(p, 0.5, 0.5);
+  length(p);
+}
+%OptimizeFunctionOnNextCall(move);
+%OptimizeFunctionOnNextCall(length);
+move(p, -0.5 * 3, -0.5 * 3);
+assertEquals(5, length(p));
+assertEquals(3, p.x);
+
+// The values survive garbage collections, including moves to old space.
+var points = [];
+for (var i = 0; i < 100; i++) points.push(new Point(i + 0.25, -i - 0.25));
+gc();
+gc();
+for (var i = 0; i < 100; i++) {
+  assertEquals(i + 0.25, points[i].x);
+  assertEquals(-i - 0.25, points[i].y);
+}
+
+// Generalizing Smi to Double to Tagged migrates existing instances.
+function C(a) { this.a = a; this.b = 0.5; }
+var c1 = new C(1);
+var c2 = new C(1.25);
+assertEquals(1, c1.a);
+assertEquals(1.25, c2.a);
+var c3 = new C({});
+assertEquals(1, c1.a);
+assertEquals(1.25, c2.a);
+assertEquals(0.5, c1.b);
+assertEquals(0.5, c3.b);
+gc();
+assertEquals(1.25, c2.a);
+assertEquals(0.5, c2.b);
+
+// Transitions that add a double field from optimized code.
+function addZ(o, z) { o.z = z; return o; }
+for (var i = 0; i < 3; i++) addZ(new Point(1.5, 2.5), 0.5);
+%OptimizeFunctionOnNextCall(addZ);
+var q = addZ(new Point(1.5, 2.5), 7.5);
+assertEquals(7.5, q.z);
+assertEquals(1.5, q.x);
+gc();
+assertEquals(7.5, q.z);
+
+// Deleting a property and going back to fast mode keeps the values.
+var d = new Point(0.5, 1.5);
+delete d.x;
+assertEquals(undefined, d.x);
+assertEquals(1.5, d.y);
+d.x = 4.5;
+%ToFastProperties(d);
+assertEquals(4.5, d.x);
+assertEquals(1.5, d.y);
+gc();
+assertEquals(4.5, d.x);
+
+// Object literals with double-valued properties.
+function literal() { return { u: 1.5, v: 2.5 }; }
+for (var i = 0; i < 3; i++) literal().u = 0.25;
+%OptimizeFunctionOnNextCall(literal);
+var l1 = literal();
+var l2 = literal();
+l1.u = 3.5;
+assertEquals(3.5, l1.u);
+assertEquals(1.5, l2.u);
+assertEquals(2.5, l2.v);
+
+// for-in, JSON and keyed access read the unboxed values.
+var keys = [];
+var values = [];
+for (var k in l2) { keys.push(k); values.push(l2[k]); }
+assertEquals(["u", "v"], keys);
+assertEquals([1.5, 2.5], values);
+assertEquals('{"u":1.5,"v":2.5}', JSON.stringify(l2));
@@ -88,3 +88,30 @@ test("\u1234\u0123\uabcd");
 test("abcd");
 test("ab<\u1234\u0123");
 test("ab\u1234<\u0123");
+
+// Reserved characters and the component variants.
+assertEquals("a;/?:@&=+$,#b", encodeURI("a;/?:@&=+$,#b"));
+assertEquals("a%3B%2F%3F%3A%40%26%3D%2B%24%2C%23b",
+             encodeURIComponent("a;/?:@&=+$,#b"));
+assertEquals("-_.!~*'()", encodeURIComponent("-_.!~*'()"));
+assertEquals("%20%25%C3%A9%E2%82%AC%F0%9F%98%80",
+             encodeURIComponent(" %é€😀"));
+assertEquals("%23%2fA ", decodeURI("%23%2f%41%20"));
+assertEquals("#//", decodeURIComponent("%23%2f%2F"));
+assertEquals("é€😀ÿ",
+             decodeURIComponent("%c3%a9%E2%82%AC%F0%9F%98%80%C3%BF"));
+assertEquals("ÿሴx", decodeURIComponent("ÿ%E1%88%B4x"));
+
+// Malformed input.
+assertThrows(function() { encodeURIComponent("\ud800"); }, URIError);
+assertThrows(function() { encodeURIComponent("\udc00\ud800"); }, URIError);
+assertThrows(function() { encodeURI("a\ud800b"); }, URIError);
+assertThrows(function() { decodeURIComponent("%"); }, URIError);
+assertThrows(function() { decodeURIComponent("%4"); }, URIError);
+assertThrows(function() { decodeURIComponent("%zz"); }, URIError);
+assertThrows(function() { decodeURIComponent("%80"); }, URIError);
+assertThrows(function() { decodeURIComponent("%C0%AF"); }, URIError);
+assertThrows(function() { decodeURIComponent("%C3%41"); }, URIError);
+assertThrows(function() { decodeURIComponent("%ED%A0%80"); }, URIError);
+assertThrows(function() { decodeURIComponent("%F4%90%80%80"); }, URIError);
+assertThrows(function() { decodeURI("%E2%82"); }, URIError);
@@ -4,6 +4,8 @@
 
 #include "src/base/platform/mutex.h"
 
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace v8 {
@@ -87,5 +89,102 @@ TEST(Mutex, MultipleRecursiveMutexes) {
   recursive_mutex1.Unlock();
 }
 
+
+namespace {
+
+class HoldMutexThread FINAL : public Thread {
+ public:
+  HoldMutexThread(Mutex* mutex, Semaphore* locked)
+      : Thread(Options("HoldMutexThread")), mutex_(mutex), locked_(locked) {}
+  virtual ~HoldMutexThread() {}
+
+  virtual void Run() OVERRIDE {
+    mutex_->Lock();
+    locked_->Signal();
+    OS::Sleep(100);
+    mutex_->Unlock();
+  }
+
+ private:
+  Mutex* const mutex_;
+  Semaphore* const locked_;
+};
+
+}  // namespace
+
+
+TEST(Mutex, ContentionCount) {
+  Mutex mutex;
+  mutex.Lock();
+  EXPECT_FALSE(mutex.TryLock());
+  mutex.Unlock();
+  EXPECT_EQ(0, mutex.contention_count());
+
+  Semaphore locked(0);
+  HoldMutexThread thread(&mutex, &locked);
+  thread.Start();
+  locked.Wait();
+  mutex.Lock();
+  EXPECT_EQ(1, mutex.contention_count());
+  mutex.Unlock();
+  thread.Join();
+}
+
+
+TEST(Mutex, LockGuardSpinLock) {
+  SpinLock spin_lock;
+  { LockGuard<SpinLock> lock_guard(&spin_lock); }
+  {
+    LockGuard<SpinLock> lock_guard(&spin_lock);
+    EXPECT_FALSE(spin_lock.TryLock());
+  }
+  EXPECT_TRUE(spin_lock.TryLock());
+  spin_lock.Unlock();
+}
+
+
+namespace {
+
+class SpinLockIncrementThread FINAL : public Thread {
+ public:
+  SpinLockIncrementThread(SpinLock* spin_lock, int* counter)
+      : Thread(Options("SpinLockIncrementThread")),
+        spin_lock_(spin_lock),
+        counter_(counter) {}
+  virtual ~SpinLockIncrementThread() {}
+
+  static const int kIncrements = 10000;
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < kIncrements; ++i) {
+      LockGuard<SpinLock> lock_guard(spin_lock_);
+      ++*counter_;
+    }
+  }
+
+ private:
+  SpinLock* const spin_lock_;
+  int* const counter_;
+};
+
+}  // namespace
+
+
+TEST(Mutex, SpinLockMultipleThreads) {
+  static const int kThreads = 4;
+  SpinLock spin_lock;
+  int counter = 0;
+  SpinLockIncrementThread* threads[kThreads];
+  for (int i = 0; i < kThreads; ++i) {
+    threads[i] = new SpinLockIncrementThread(&spin_lock, &counter);
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kThreads; ++i) {
+    threads[i]->Join();
+    delete threads[i];
+  }
+  EXPECT_EQ(kThreads * SpinLockIncrementThread::kIncrements, counter);
+}
+
 }  // namespace base
 }  // namespace v8
@@ -0,0 +1,124 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "test/unittests/benchmarks/benchmark.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "src/isolate-inl.h"
+
+namespace v8 {
+namespace internal {
+
+// static
+Benchmark* Benchmark::first_ = NULL;
+// static
+Benchmark* Benchmark::last_ = NULL;
+
+
+Benchmark::Benchmark(const char* name, BenchmarkFunction function)
+    : name_(name), function_(function), next_(NULL) {
+  if (last_ == NULL) {
+    first_ = this;
+  } else {
+    last_->next_ = this;
+  }
+  last_ = this;
+}
+
+
+// static
+void Benchmark::RunBenchmarks(const char* filter, base::TimeDelta min_time,
+                              int repetitions) {
+  printf("%-44s %14s %14s %14s %12s %14s\n", "Benchmark", "Median (ns)",
+         "Min (ns)", "Max (ns)", "Iterations", "Items/s");
+  for (Benchmark* benchmark = first_; benchmark != NULL;
+       benchmark = benchmark->next_) {
+    if (filter != NULL && strstr(benchmark->name_, filter) == NULL) continue;
+    benchmark->Run(min_time, repetitions);
+  }
+}
+
+
+void Benchmark::Run(base::TimeDelta min_time, int repetitions) {
+  // Grow the iteration count until one run takes at least |min_time|,
+  // extrapolating from the last run with some headroom.
+  static const int64_t kMaxIterations = 1000000000;
+  int64_t iterations = 1;
+  for (;;) {
+    BenchmarkState state(iterations);
+    function_(&state);
+    double elapsed = state.elapsed().InSecondsF();
+    if (elapsed >= min_time.InSecondsF() || iterations >= kMaxIterations) {
+      break;
+    }
+    double factor = elapsed > 0 ? 1.4 * min_time.InSecondsF() / elapsed : 10;
+    factor = std::max(2.0, std::min(factor, 10.0));
+    iterations = std::min(kMaxIterations,
+                          static_cast<int64_t>(iterations * factor));
+  }
+
+  std::vector<double> times;
+  int64_t items_per_iteration = 0;
+  for (int i = 0; i < repetitions; ++i) {
+    BenchmarkState state(iterations);
+    function_(&state);
+    times.push_back(state.elapsed().InSecondsF() * 1e9 / iterations);
+    items_per_iteration = state.items_per_iteration();
+  }
+  std::sort(times.begin(), times.end());
+  double median = times[times.size() / 2];
+  printf("%-44s %14.1f %14.1f %14.1f %12.0f", name_, median, times[0],
+         times.back(), static_cast<double>(iterations));
+  if (items_per_iteration > 0) {
+    printf(" %14.0f", items_per_iteration * 1e9 / median);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+
+// static
+v8::Isolate* BenchmarkWithIsolate::isolate_ = NULL;
+
+
+BenchmarkWithIsolate::BenchmarkWithIsolate()
+    : isolate_scope_(isolate_), handle_scope_(isolate_) {}
+
+
+BenchmarkWithIsolate::~BenchmarkWithIsolate() {}
+
+
+Factory* BenchmarkWithIsolate::factory() const { return isolate()->factory(); }
+
+
+// static
+void BenchmarkWithIsolate::SetUpIsolate() {
+  DCHECK_EQ(NULL, isolate_);
+  isolate_ = v8::Isolate::New();
+  CHECK(isolate_ != NULL);
+}
+
+
+// static
+void BenchmarkWithIsolate::TearDownIsolate() {
+  CHECK(isolate_ != NULL);
+  isolate_->Dispose();
+  isolate_ = NULL;
+}
+
+
+BenchmarkWithContext::BenchmarkWithContext()
+    : context_(v8::Context::New(reinterpret_cast<v8::Isolate*>(isolate()))),
+      context_scope_(context_) {}
+
+
+BenchmarkWithContext::~BenchmarkWithContext() {}
+
+}  // namespace internal
+}  // namespace v8
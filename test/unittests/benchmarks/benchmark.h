@@ -0,0 +1,162 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_UNITTESTS_BENCHMARKS_BENCHMARK_H_
+#define V8_UNITTESTS_BENCHMARKS_BENCHMARK_H_
+
+#include "include/v8.h"
+#include "src/base/macros.h"
+#include "src/base/platform/time.h"
+
+namespace v8 {
+namespace internal {
+
+// Forward declarations.
+class Factory;
+class Isolate;
+
+
+// The state of one run of a benchmark. The body of a benchmark sets up its
+// data and then repeats the measured operation while KeepRunning() returns
+// true. Only the time between the first and the last call to KeepRunning()
+// is measured:
+//
+//   BENCHMARK(DoubleToCString) {
+//     char buffer[kDoubleToCStringMinBufferSize];
+//     while (state->KeepRunning()) {
+//       DoubleToCString(0.1, Vector<char>(buffer, arraysize(buffer)));
+//     }
+//   }
+class BenchmarkState FINAL {
+ public:
+  explicit BenchmarkState(int64_t iterations)
+      : iterations_(iterations),
+        remaining_(iterations),
+        items_per_iteration_(0) {}
+
+  bool KeepRunning() {
+    if (remaining_ == iterations_) {
+      start_ = base::TimeTicks::HighResolutionNow();
+    }
+    if (remaining_-- > 0) return true;
+    elapsed_ = base::TimeTicks::HighResolutionNow() - start_;
+    return false;
+  }
+
+  // Reports that each iteration processed |items| items (bytes, elements,
+  // calls), so that the throughput is printed next to the time.
+  void SetItemsPerIteration(int64_t items) { items_per_iteration_ = items; }
+
+  int64_t iterations() const { return iterations_; }
+  int64_t items_per_iteration() const { return items_per_iteration_; }
+  base::TimeDelta elapsed() const { return elapsed_; }
+
+ private:
+  int64_t iterations_;
+  int64_t remaining_;
+  int64_t items_per_iteration_;
+  base::TimeTicks start_;
+  base::TimeDelta elapsed_;
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkState);
+};
+
+
+typedef void (*BenchmarkFunction)(BenchmarkState* state);
+
+
+// A registered benchmark. Registrations are static objects that link
+// themselves into a list, which RunBenchmarks() walks in order.
+class Benchmark FINAL {
+ public:
+  Benchmark(const char* name, BenchmarkFunction function);
+
+  // Runs all benchmarks whose name contains |filter| (or all of them if
+  // |filter| is NULL). Each benchmark runs with an iteration count that
+  // takes at least |min_time|, |repetitions| times, and the median, minimum
+  // and maximum time per iteration are printed.
+  static void RunBenchmarks(const char* filter, base::TimeDelta min_time,
+                            int repetitions);
+
+ private:
+  void Run(base::TimeDelta min_time, int repetitions);
+
+  const char* name_;
+  BenchmarkFunction function_;
+  Benchmark* next_;
+
+  static Benchmark* first_;
+  static Benchmark* last_;
+
+  DISALLOW_COPY_AND_ASSIGN(Benchmark);
+};
+
+
+// Base class of benchmarks that need an isolate. The isolate is created
+// once by the benchmark runner and shared by all benchmarks, so that its
+// setup does not show up in the numbers.
+class BenchmarkWithIsolate {
+ public:
+  BenchmarkWithIsolate();
+  virtual ~BenchmarkWithIsolate();
+
+  Isolate* isolate() const { return reinterpret_cast<Isolate*>(isolate_); }
+  Factory* factory() const;
+
+  static void SetUpIsolate();
+  static void TearDownIsolate();
+
+ private:
+  static v8::Isolate* isolate_;
+  v8::Isolate::Scope isolate_scope_;
+  v8::HandleScope handle_scope_;
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkWithIsolate);
+};
+
+
+// Base class of benchmarks that need a native context in addition to an
+// isolate, for example because they create JavaScript objects.
+class BenchmarkWithContext : public BenchmarkWithIsolate {
+ public:
+  BenchmarkWithContext();
+  virtual ~BenchmarkWithContext();
+
+ private:
+  v8::Local<v8::Context> context_;
+  v8::Context::Scope context_scope_;
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkWithContext);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+
+// Defines and registers a benchmark that does not need a fixture.
+#define BENCHMARK(name)                                                        \
+  static void Benchmark_##name(::v8::internal::BenchmarkState* state);         \
+  static ::v8::internal::Benchmark benchmark_##name(#name,                     \
+                                                    Benchmark_##name);         \
+  static void Benchmark_##name(::v8::internal::BenchmarkState* state)
+
+
+// Defines and registers a benchmark that runs in a fresh instance of
+// |fixture|, whose constructor and destructor are not measured.
+#define BENCHMARK_F(fixture, name)                                             \
+  class fixture##_##name##_Benchmark : public fixture {                        \
+   public:                                                                     \
+    void Run(::v8::internal::BenchmarkState* state);                           \
+  };                                                                           \
+  static void Benchmark_##fixture##_##name(                                    \
+      ::v8::internal::BenchmarkState* state) {                                 \
+    fixture##_##name##_Benchmark benchmark;                                    \
+    benchmark.Run(state);                                                      \
+  }                                                                            \
+  static ::v8::internal::Benchmark benchmark_##fixture##_##name(               \
+      #fixture "." #name, Benchmark_##fixture##_##name);                       \
+  void fixture##_##name##_Benchmark::Run(                                      \
+      ::v8::internal::BenchmarkState* state)
+
+#endif  // V8_UNITTESTS_BENCHMARKS_BENCHMARK_H_
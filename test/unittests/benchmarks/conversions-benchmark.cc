@@ -0,0 +1,48 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/conversions.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Numbers that take the different paths of DoubleToCString: small
+// integers, shortest round-trip decimals and exponential notation.
+const double kDoubles[] = {0,      -1,         42,     1234567,  0.1,
+                           -2.5,   3.14159265, 1e21,   1.5e-7,   123.456,
+                           1e-300, 4.35e+250,  -0.001, 65536.25, 0.3};
+
+}  // namespace
+
+
+BENCHMARK(DoubleToCString) {
+  char buffer[kDoubleToCStringMinBufferSize];
+  Vector<char> vector(buffer, arraysize(buffer));
+  while (state->KeepRunning()) {
+    for (size_t i = 0; i < arraysize(kDoubles); ++i) {
+      DoubleToCString(kDoubles[i], vector);
+    }
+  }
+  state->SetItemsPerIteration(arraysize(kDoubles));
+}
+
+
+BENCHMARK(DoubleToCStringInteger) {
+  char buffer[kDoubleToCStringMinBufferSize];
+  Vector<char> vector(buffer, arraysize(buffer));
+  while (state->KeepRunning()) {
+    for (int i = 0; i < 100; ++i) {
+      DoubleToCString(i * 1000003, vector);
+    }
+  }
+  state->SetItemsPerIteration(100);
+}
+
+}  // namespace internal
+}  // namespace v8
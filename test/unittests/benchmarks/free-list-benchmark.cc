@@ -0,0 +1,114 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/heap/spaces.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+// An old space that gives access to its free list.
+class FreeListBenchmarkSpace FINAL : public OldSpace {
+ public:
+  explicit FreeListBenchmarkSpace(Heap* heap)
+      : OldSpace(heap, heap->MaxOldGenerationSize(), OLD_DATA_SPACE,
+                 NOT_EXECUTABLE) {}
+
+  FreeList* free_list() { return PagedSpace::free_list(); }
+};
+
+
+// Measures the free list of a private old space, so that the heap of the
+// isolate is not disturbed. One page of the space is carved into blocks of
+// mixed sizes that are put on the free list, and then objects of mixed
+// sizes are allocated from the free list until it runs dry.
+class FreeListBenchmark : public BenchmarkWithIsolate {
+ public:
+  FreeListBenchmark()
+      : space_(isolate()->heap()) {
+    CHECK(space_.SetUp());
+    HeapObject* page_object = HeapObject::cast(
+        space_.AllocateRaw(Page::kMaxRegularHeapObjectSize).ToObjectChecked());
+    start_ = page_object->address();
+    end_ = start_ + Page::kMaxRegularHeapObjectSize;
+  }
+
+  virtual ~FreeListBenchmark() {
+    space_.ResetFreeList();
+    space_.SetTopAndLimit(NULL, NULL);
+    space_.TearDown();
+  }
+
+  // Frees blocks cycling through |free_sizes| and allocates objects
+  // cycling through |allocation_sizes|, both given in words.
+  void FreeAndAllocate(BenchmarkState* state, const int* free_sizes,
+                       int free_count, const int* allocation_sizes,
+                       int allocation_count) {
+    FreeList* free_list = space_.free_list();
+    int operations = 0;
+    while (state->KeepRunning()) {
+      space_.ResetFreeList();
+      space_.SetTopAndLimit(NULL, NULL);
+      operations = 0;
+      Address current = start_;
+      for (int i = 0;; ++i, ++operations) {
+        int size = free_sizes[i % free_count] * kPointerSize;
+        if (current + size > end_) break;
+        free_list->Free(current, size);
+        current += size;
+      }
+      for (int i = 0;; ++i, ++operations) {
+        int size = allocation_sizes[i % allocation_count] * kPointerSize;
+        // Return the rest of the last block to the free list, as if inline
+        // allocation were disabled, so that every object comes from it.
+        space_.EmptyAllocationInfo();
+        if (free_list->Allocate(size) == NULL) break;
+      }
+    }
+    state->SetItemsPerIteration(operations);
+  }
+
+ private:
+  FreeListBenchmarkSpace space_;
+  Address start_;
+  Address end_;
+};
+
+
+namespace {
+
+// Blocks smaller than 32 words are not put on the free list.
+const int kBlockSizes[] = {32, 40, 48, 64, 96, 128, 192};
+const int kMixedBlockSizes[] = {32, 512, 48, 1024, 64, 2048, 96, 40, 4096};
+const int kObjectSizes[] = {4, 6, 8, 12, 16, 24, 32};
+
+}  // namespace
+
+
+// Blocks that are reused for objects of the same size.
+BENCHMARK_F(FreeListBenchmark, SameSizes) {
+  FreeAndAllocate(state, kBlockSizes, arraysize(kBlockSizes), kBlockSizes,
+                  arraysize(kBlockSizes));
+}
+
+
+// Small objects that split the blocks, with the rest of each block going
+// back to the free list.
+BENCHMARK_F(FreeListBenchmark, SplitBlocks) {
+  FreeAndAllocate(state, kBlockSizes, arraysize(kBlockSizes), kObjectSizes,
+                  arraysize(kObjectSizes));
+}
+
+
+// Objects that have to look beyond their own size class once the small
+// blocks have been used up.
+BENCHMARK_F(FreeListBenchmark, MixedBlocks) {
+  FreeAndAllocate(state, kMixedBlockSizes, arraysize(kMixedBlockSizes),
+                  kBlockSizes, arraysize(kBlockSizes));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,81 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/hashmap.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const int kKeys = 1000;
+
+
+void* KeyAt(int i) { return reinterpret_cast<void*>((i + 1) * kPointerSize); }
+
+
+uint32_t HashAt(int i) { return ComputeIntegerHash(i, 0); }
+
+}  // namespace
+
+
+// Fills a fresh map, which includes growing it a few times.
+BENCHMARK(HashMapInsert) {
+  while (state->KeepRunning()) {
+    HashMap map(HashMap::PointersMatch);
+    for (int i = 0; i < kKeys; ++i) {
+      map.Lookup(KeyAt(i), HashAt(i), true);
+    }
+  }
+  state->SetItemsPerIteration(kKeys);
+}
+
+
+BENCHMARK(HashMapLookupHit) {
+  HashMap map(HashMap::PointersMatch);
+  for (int i = 0; i < kKeys; ++i) {
+    map.Lookup(KeyAt(i), HashAt(i), true);
+  }
+  while (state->KeepRunning()) {
+    for (int i = 0; i < kKeys; ++i) {
+      map.Lookup(KeyAt(i), HashAt(i), false);
+    }
+  }
+  state->SetItemsPerIteration(kKeys);
+}
+
+
+BENCHMARK(HashMapLookupMiss) {
+  HashMap map(HashMap::PointersMatch);
+  for (int i = 0; i < kKeys; ++i) {
+    map.Lookup(KeyAt(i), HashAt(i), true);
+  }
+  while (state->KeepRunning()) {
+    for (int i = kKeys; i < 2 * kKeys; ++i) {
+      map.Lookup(KeyAt(i), HashAt(i), false);
+    }
+  }
+  state->SetItemsPerIteration(kKeys);
+}
+
+
+BENCHMARK(HashMapRemoveAndInsert) {
+  HashMap map(HashMap::PointersMatch);
+  for (int i = 0; i < kKeys; ++i) {
+    map.Lookup(KeyAt(i), HashAt(i), true);
+  }
+  while (state->KeepRunning()) {
+    for (int i = 0; i < kKeys; ++i) {
+      map.Remove(KeyAt(i), HashAt(i));
+      map.Lookup(KeyAt(i), HashAt(i), true);
+    }
+  }
+  state->SetItemsPerIteration(kKeys);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,57 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "src/v8.h"
+
+#include "src/json-parser.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+class JsonParserBenchmark : public BenchmarkWithContext {
+ public:
+  // Parses |json|, repeated |count| times as the elements of an array.
+  void Parse(BenchmarkState* state, const char* json, int count) {
+    std::string json_array = "[";
+    for (int i = 0; i < count; ++i) {
+      if (i > 0) json_array += ",";
+      json_array += json;
+    }
+    json_array += "]";
+    Handle<String> source =
+        factory()->NewStringFromAsciiChecked(json_array.c_str(), TENURED);
+    CHECK(source->IsSeqOneByteString());
+    while (state->KeepRunning()) {
+      HandleScope scope(isolate());
+      CHECK(!JsonParser<true>::Parse(source).is_null());
+    }
+    state->SetItemsPerIteration(source->length());
+  }
+};
+
+
+BENCHMARK_F(JsonParserBenchmark, Numbers) {
+  Parse(state, "[1, -2.5, 3e10, 42, 0.125, 1234567, -0, 7]", 1000);
+}
+
+
+BENCHMARK_F(JsonParserBenchmark, Strings) {
+  Parse(state, "[\"short\", \"a somewhat longer string\", \"esc\\\"aped\\n\"]",
+        1000);
+}
+
+
+// Objects of the same shape, as in typical API responses.
+BENCHMARK_F(JsonParserBenchmark, Objects) {
+  Parse(state,
+        "{\"id\": 12345, \"name\": \"item\", \"price\": 9.99, "
+        "\"tags\": [\"a\", \"b\"], \"active\": true, \"parent\": null}",
+        1000);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,61 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/libplatform/libplatform.h"
+#include "include/v8.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+// Runs the benchmarks of the microbenchmarks target. Options:
+//   --benchmark-filter=<substring>  only runs benchmarks whose name contains
+//                                   the substring
+//   --benchmark-min-time=<ms>       minimum duration of one run (default 500)
+//   --benchmark-repetitions=<n>     number of measured runs (default 5)
+// All other options are passed on to V8.
+int main(int argc, char** argv) {
+  const char* filter = NULL;
+  int min_time_ms = 500;
+  int repetitions = 5;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--benchmark-filter=", 19) == 0) {
+      filter = argv[i] + 19;
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--benchmark-min-time=", 21) == 0) {
+      min_time_ms = atoi(argv[i] + 21);
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--benchmark-repetitions=", 24) == 0) {
+      repetitions = atoi(argv[i] + 24);
+      argv[i] = NULL;
+    }
+  }
+  if (repetitions < 1) {
+    fprintf(stderr, "--benchmark-repetitions must be at least 1\n");
+    return 1;
+  }
+  int remaining = 1;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i] != NULL) argv[remaining++] = argv[i];
+  }
+  argc = remaining;
+  v8::V8::SetFlagsFromCommandLine(&argc, argv, true);
+
+  v8::V8::InitializeICU();
+  v8::Platform* platform = v8::platform::CreateDefaultPlatform();
+  v8::V8::InitializePlatform(platform);
+  v8::V8::Initialize();
+  v8::internal::BenchmarkWithIsolate::SetUpIsolate();
+
+  v8::internal::Benchmark::RunBenchmarks(
+      filter, v8::base::TimeDelta::FromMilliseconds(min_time_ms),
+      repetitions);
+
+  v8::internal::BenchmarkWithIsolate::TearDownIsolate();
+  v8::V8::Dispose();
+  v8::V8::ShutdownPlatform();
+  delete platform;
+  return 0;
+}
@@ -0,0 +1,58 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/string-search.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+class StringSearchBenchmark : public BenchmarkWithIsolate {
+ public:
+  static const int kSubjectLength = 64 * KB;
+
+  StringSearchBenchmark() {
+    // Text over a small alphabet, so that patterns have many partial
+    // matches, with the pattern only at the very end.
+    uint32_t seed = 1;
+    for (int i = 0; i < kSubjectLength; ++i) {
+      seed = seed * 1103515245 + 12345;
+      subject_[i] = 'a' + ((seed >> 16) % 4);
+    }
+  }
+
+  // Searches for the last |length| characters of the subject, after
+  // making them unique.
+  void Search(BenchmarkState* state, int length) {
+    DCHECK_LE(length, kSubjectLength);
+    subject_[kSubjectLength - length] = 'z';
+    Vector<const uint8_t> subject(subject_, kSubjectLength);
+    Vector<const uint8_t> pattern(subject_ + kSubjectLength - length, length);
+    while (state->KeepRunning()) {
+      CHECK_EQ(kSubjectLength - length,
+               SearchString(isolate(), subject, pattern, 0));
+    }
+    state->SetItemsPerIteration(kSubjectLength);
+  }
+
+ private:
+  uint8_t subject_[kSubjectLength];
+};
+
+
+BENCHMARK_F(StringSearchBenchmark, SingleChar) { Search(state, 1); }
+
+
+BENCHMARK_F(StringSearchBenchmark, Linear) { Search(state, 5); }
+
+
+BENCHMARK_F(StringSearchBenchmark, BoyerMooreHorspool) { Search(state, 16); }
+
+
+BENCHMARK_F(StringSearchBenchmark, BoyerMoore) { Search(state, 200); }
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,52 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/zone.h"
+#include "test/unittests/benchmarks/benchmark.h"
+
+namespace v8 {
+namespace internal {
+
+class ZoneBenchmark : public BenchmarkWithIsolate {};
+
+
+// Small allocations in a fresh zone, which includes the cost of getting and
+// releasing its segments.
+BENCHMARK_F(ZoneBenchmark, NewSmall) {
+  static const int kAllocations = 1000;
+  while (state->KeepRunning()) {
+    Zone zone(isolate());
+    for (int i = 0; i < kAllocations; ++i) {
+      zone.New(32);
+    }
+  }
+  state->SetItemsPerIteration(kAllocations);
+}
+
+
+// Allocations of mixed sizes that fill several segments.
+BENCHMARK_F(ZoneBenchmark, NewMixed) {
+  static const int kAllocations = 10000;
+  while (state->KeepRunning()) {
+    Zone zone(isolate());
+    for (int i = 0; i < kAllocations; ++i) {
+      zone.New(8 + (i % 16) * 8);
+    }
+  }
+  state->SetItemsPerIteration(kAllocations);
+}
+
+
+// One large allocation, which does not fit into a regular segment.
+BENCHMARK_F(ZoneBenchmark, NewLarge) {
+  while (state->KeepRunning()) {
+    Zone zone(isolate());
+    zone.New(256 * KB);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
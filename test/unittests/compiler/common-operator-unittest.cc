@@ -133,6 +133,8 @@ class CommonOperatorTest : public TestWithZone {
 
 const int kArguments[] = {1, 5, 6, 42, 100, 10000, kMaxInt};
 
+const BranchHint kHints[] = {kBranchNone, kBranchTrue, kBranchFalse};
+
 const float kFloat32Values[] = {
     std::numeric_limits<float>::min(), -1.0f, -0.0f, 0.0f, 1.0f,
     std::numeric_limits<float>::max()};
@@ -140,6 +142,24 @@ const float kFloat32Values[] = {
 }  // namespace
 
 
+TEST_F(CommonOperatorTest, Branch) {
+  TRACED_FOREACH(BranchHint, hint, kHints) {
+    const Operator* const op = common()->Branch(hint);
+    EXPECT_EQ(IrOpcode::kBranch, op->opcode());
+    EXPECT_EQ(Operator::kFoldable, op->properties());
+    EXPECT_EQ(hint, BranchHintOf(op));
+    EXPECT_EQ(op, common()->Branch(hint));
+    EXPECT_EQ(1, OperatorProperties::GetValueInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetControlInputCount(op));
+    EXPECT_EQ(2, OperatorProperties::GetTotalInputCount(op));
+    EXPECT_EQ(2, OperatorProperties::GetControlOutputCount(op));
+    EXPECT_EQ(0, OperatorProperties::GetEffectOutputCount(op));
+    EXPECT_EQ(0, OperatorProperties::GetValueOutputCount(op));
+  }
+  EXPECT_EQ(common()->Branch(kBranchNone), common()->Branch());
+}
+
+
 TEST_F(CommonOperatorTest, Float32Constant) {
   TRACED_FOREACH(float, value, kFloat32Values) {
     const Operator* op = common()->Float32Constant(value);
@@ -153,6 +173,21 @@ TEST_F(CommonOperatorTest, Float32Constant) {
 }
 
 
+TEST_F(CommonOperatorTest, OsrValue) {
+  TRACED_FOREACH(int, index, kArguments) {
+    const Operator* op = common()->OsrValue(index);
+    EXPECT_EQ(IrOpcode::kOsrValue, op->opcode());
+    EXPECT_EQ(Operator::kPure, op->properties());
+    EXPECT_EQ(index, OpParameter<int>(op));
+    EXPECT_EQ(1, OperatorProperties::GetValueInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetTotalInputCount(op));
+    EXPECT_EQ(0, OperatorProperties::GetControlOutputCount(op));
+    EXPECT_EQ(0, OperatorProperties::GetEffectOutputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetValueOutputCount(op));
+  }
+}
+
+
 TEST_F(CommonOperatorTest, ValueEffect) {
   TRACED_FOREACH(int, arguments, kArguments) {
     const Operator* op = common()->ValueEffect(arguments);
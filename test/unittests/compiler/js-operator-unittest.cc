@@ -74,7 +74,6 @@ const SharedOperator kSharedOperators[] = {
     SHARED(TypeOf, Operator::kPure, 1, 0, 0, 0, 1, 0),
     SHARED(InstanceOf, Operator::kNoProperties, 2, 0, 1, 1, 1, 1),
     SHARED(Debugger, Operator::kNoProperties, 0, 0, 1, 1, 0, 1),
-    SHARED(CreateFunctionContext, Operator::kNoProperties, 1, 0, 1, 1, 1, 1),
     SHARED(CreateWithContext, Operator::kNoProperties, 2, 0, 1, 1, 1, 1),
     SHARED(CreateBlockContext, Operator::kNoProperties, 2, 0, 1, 1, 1, 1),
     SHARED(CreateModuleContext, Operator::kNoProperties, 2, 0, 1, 1, 1, 1),
@@ -147,6 +146,31 @@ TEST_P(JSSharedOperatorTest, Properties) {
 INSTANTIATE_TEST_CASE_P(JSOperatorTest, JSSharedOperatorTest,
                         ::testing::ValuesIn(kSharedOperators));
 
+
+// -----------------------------------------------------------------------------
+// CreateFunctionContext.
+
+
+class JSOperatorTest : public TestWithZone {};
+
+
+TEST_F(JSOperatorTest, CreateFunctionContext) {
+  JSOperatorBuilder javascript(zone());
+  static const int kSlotCounts[] = {1, 2, 64, 65, 1000};
+  for (size_t i = 0; i < arraysize(kSlotCounts); ++i) {
+    const Operator* op = javascript.CreateFunctionContext(kSlotCounts[i]);
+    EXPECT_EQ(IrOpcode::kJSCreateFunctionContext, op->opcode());
+    EXPECT_EQ(Operator::kNoProperties, op->properties());
+    EXPECT_EQ(kSlotCounts[i], OpParameter<int>(op));
+    EXPECT_EQ(1, OperatorProperties::GetValueInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetContextInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetEffectInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetControlInputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetValueOutputCount(op));
+    EXPECT_EQ(1, OperatorProperties::GetEffectOutputCount(op));
+  }
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,138 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/load-elimination.h"
+#include "src/compiler/node-properties-inl.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoadEliminationTest : public GraphTest {
+ public:
+  LoadEliminationTest() : GraphTest(3), simplified_(zone()) {}
+  virtual ~LoadEliminationTest() {}
+
+ protected:
+  Reduction Reduce(Node* node) {
+    LoadElimination reducer;
+    return reducer.Reduce(node);
+  }
+
+  FieldAccess Field(int offset) {
+    FieldAccess access = {kTaggedBase, offset, Handle<Name>(), Type::Any(),
+                          kMachAnyTagged};
+    return access;
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(LoadEliminationTest, LoadFieldAfterLoadField) {
+  Node* const object = Parameter(0);
+  Node* const start = graph()->start();
+  Node* load1 = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                 start);
+  Node* load2 = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                 load1);
+  Reduction r = Reduce(load2);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(load1, r.replacement());
+}
+
+
+TEST_F(LoadEliminationTest, LoadFieldAfterStoreField) {
+  Node* const object = Parameter(0);
+  Node* const value = Parameter(1);
+  Node* const start = graph()->start();
+  Node* store = graph()->NewNode(simplified()->StoreField(Field(8)), object,
+                                 value, start);
+  Node* load = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                store);
+  Node* use = graph()->NewNode(simplified()->LoadField(Field(16)), object,
+                               load);
+  Reduction r = Reduce(load);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(value, r.replacement());
+  // Effect uses of the load are rewired to the load's effect input.
+  EXPECT_EQ(store, NodeProperties::GetEffectInput(use));
+}
+
+
+TEST_F(LoadEliminationTest, LoadFieldAfterUnrelatedStoreField) {
+  Node* const object = Parameter(0);
+  Node* const value = Parameter(1);
+  Node* const start = graph()->start();
+  Node* load1 = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                 start);
+  Node* store = graph()->NewNode(simplified()->StoreField(Field(16)), object,
+                                 value, load1);
+  Node* load2 = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                 store);
+  Reduction r = Reduce(load2);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(load1, r.replacement());
+}
+
+
+TEST_F(LoadEliminationTest, LoadFieldAfterStoreFieldToOtherObject) {
+  Node* const object1 = Parameter(0);
+  Node* const object2 = Parameter(1);
+  Node* const value = Parameter(2);
+  Node* const start = graph()->start();
+  Node* load1 = graph()->NewNode(simplified()->LoadField(Field(8)), object1,
+                                 start);
+  // The two objects may be the same, so the store may clobber the field.
+  Node* store = graph()->NewNode(simplified()->StoreField(Field(8)), object2,
+                                 value, load1);
+  Node* load2 = graph()->NewNode(simplified()->LoadField(Field(8)), object1,
+                                 store);
+  Reduction r = Reduce(load2);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(LoadEliminationTest, StoreFieldAfterStoreField) {
+  Node* const object = Parameter(0);
+  Node* const value1 = Parameter(1);
+  Node* const value2 = Parameter(2);
+  Node* const start = graph()->start();
+  Node* store1 = graph()->NewNode(simplified()->StoreField(Field(8)), object,
+                                  value1, start);
+  Node* store2 = graph()->NewNode(simplified()->StoreField(Field(16)), object,
+                                  value1, store1);
+  Node* store3 = graph()->NewNode(simplified()->StoreField(Field(8)), object,
+                                  value2, store2);
+  Reduction r = Reduce(store3);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(store3, r.replacement());
+  EXPECT_EQ(start, NodeProperties::GetEffectInput(store2));
+}
+
+
+TEST_F(LoadEliminationTest, StoreFieldAfterObservedStoreField) {
+  Node* const object = Parameter(0);
+  Node* const value1 = Parameter(1);
+  Node* const value2 = Parameter(2);
+  Node* const start = graph()->start();
+  Node* store1 = graph()->NewNode(simplified()->StoreField(Field(8)), object,
+                                  value1, start);
+  Node* load = graph()->NewNode(simplified()->LoadField(Field(8)), object,
+                                store1);
+  Node* store2 = graph()->NewNode(simplified()->StoreField(Field(8)), object,
+                                  value2, load);
+  Reduction r = Reduce(store2);
+  ASSERT_FALSE(r.Changed());
+  EXPECT_EQ(load, NodeProperties::GetEffectInput(store2));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,129 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-analysis.h"
+#include "src/compiler/machine-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopAnalysisTest : public GraphTest {
+ public:
+  LoopAnalysisTest() : GraphTest(2) {}
+  virtual ~LoopAnalysisTest() {}
+
+ protected:
+  LoopTree* BuildLoopTree() {
+    return LoopFinder::BuildLoopTree(graph(), zone());
+  }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+};
+
+
+TEST_F(LoopAnalysisTest, NoLoops) {
+  Node* ret = graph()->NewNode(common()->Return(), Parameter(0),
+                               graph()->start(), graph()->start());
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+  LoopTree* tree = BuildLoopTree();
+  EXPECT_TRUE(tree->loops().empty());
+  EXPECT_EQ(NULL, tree->ContainingLoop(ret));
+}
+
+
+TEST_F(LoopAnalysisTest, SimpleLoop) {
+  Node* const p0 = Parameter(0);
+  Node* const p1 = Parameter(1);
+  Node* const start = graph()->start();
+  Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+  Node* phi = graph()->NewNode(common()->Phi(kMachInt32, 2), p0, p0, loop);
+  Node* add = graph()->NewNode(machine()->Int32Add(), phi, p1);
+  Node* branch = graph()->NewNode(common()->Branch(), add, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  loop->ReplaceInput(1, if_true);
+  phi->ReplaceInput(1, add);
+  Node* ret = graph()->NewNode(common()->Return(), phi, start, if_false);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  LoopTree* tree = BuildLoopTree();
+  ASSERT_EQ(1u, tree->loops().size());
+  ASSERT_EQ(1u, tree->outer_loops().size());
+  LoopTree::Loop* l = tree->loops()[0];
+  EXPECT_EQ(loop, l->header());
+  EXPECT_EQ(NULL, l->parent());
+  EXPECT_EQ(1, l->depth());
+  EXPECT_TRUE(l->IsInnermost());
+  EXPECT_EQ(5u, l->body().size());
+  EXPECT_TRUE(l->Contains(loop));
+  EXPECT_TRUE(l->Contains(phi));
+  EXPECT_TRUE(l->Contains(add));
+  EXPECT_TRUE(l->Contains(branch));
+  EXPECT_TRUE(l->Contains(if_true));
+  EXPECT_FALSE(l->Contains(if_false));
+  EXPECT_FALSE(l->Contains(p1));
+  EXPECT_FALSE(l->Contains(ret));
+  EXPECT_EQ(l, tree->ContainingLoop(add));
+  EXPECT_EQ(NULL, tree->ContainingLoop(if_false));
+}
+
+
+TEST_F(LoopAnalysisTest, NestedLoops) {
+  Node* const p0 = Parameter(0);
+  Node* const p1 = Parameter(1);
+  Node* const start = graph()->start();
+  Node* outer = graph()->NewNode(common()->Loop(2), start, start);
+  Node* outer_phi =
+      graph()->NewNode(common()->Phi(kMachInt32, 2), p0, p0, outer);
+  Node* outer_branch = graph()->NewNode(common()->Branch(), outer_phi, outer);
+  Node* outer_true = graph()->NewNode(common()->IfTrue(), outer_branch);
+  Node* outer_false = graph()->NewNode(common()->IfFalse(), outer_branch);
+  Node* inner = graph()->NewNode(common()->Loop(2), outer_true, outer_true);
+  Node* inner_phi =
+      graph()->NewNode(common()->Phi(kMachInt32, 2), outer_phi, p0, inner);
+  Node* inner_add = graph()->NewNode(machine()->Int32Add(), inner_phi, p1);
+  Node* inner_branch = graph()->NewNode(common()->Branch(), inner_add, inner);
+  Node* inner_true = graph()->NewNode(common()->IfTrue(), inner_branch);
+  Node* inner_false = graph()->NewNode(common()->IfFalse(), inner_branch);
+  inner->ReplaceInput(1, inner_true);
+  inner_phi->ReplaceInput(1, inner_add);
+  outer->ReplaceInput(1, inner_false);
+  outer_phi->ReplaceInput(1, inner_phi);
+  Node* ret =
+      graph()->NewNode(common()->Return(), outer_phi, start, outer_false);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  LoopTree* tree = BuildLoopTree();
+  ASSERT_EQ(2u, tree->loops().size());
+  ASSERT_EQ(1u, tree->outer_loops().size());
+  LoopTree::Loop* o = tree->outer_loops()[0];
+  EXPECT_EQ(outer, o->header());
+  EXPECT_EQ(1, o->depth());
+  ASSERT_EQ(1u, o->children().size());
+  LoopTree::Loop* i = o->children()[0];
+  EXPECT_EQ(inner, i->header());
+  EXPECT_EQ(o, i->parent());
+  EXPECT_EQ(2, i->depth());
+  EXPECT_TRUE(i->IsInnermost());
+  EXPECT_FALSE(o->IsInnermost());
+
+  EXPECT_EQ(5u, i->body().size());
+  EXPECT_FALSE(i->Contains(outer_phi));
+  EXPECT_TRUE(o->Contains(inner_add));
+  EXPECT_TRUE(o->Contains(inner_false));
+  EXPECT_FALSE(o->Contains(outer_false));
+  EXPECT_EQ(i, tree->ContainingLoop(inner_add));
+  EXPECT_EQ(o, tree->ContainingLoop(outer_branch));
+  EXPECT_EQ(o, tree->ContainingLoop(inner_false));
+  EXPECT_EQ(NULL, tree->ContainingLoop(ret));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
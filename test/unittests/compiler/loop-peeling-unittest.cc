@@ -0,0 +1,105 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-peeling.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties-inl.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopPeelingTest : public GraphTest {
+ public:
+  LoopPeelingTest() : GraphTest(2) {}
+  virtual ~LoopPeelingTest() {}
+
+ protected:
+  int PeelInnerLoops() {
+    LoopTree* tree = LoopFinder::BuildLoopTree(graph(), zone());
+    return LoopPeeler::PeelInnerLoops(graph(), common(), tree, zone());
+  }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+};
+
+
+TEST_F(LoopPeelingTest, SimpleLoop) {
+  Node* const p0 = Parameter(0);
+  Node* const p1 = Parameter(1);
+  Node* const start = graph()->start();
+  Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+  Node* phi = graph()->NewNode(common()->Phi(kMachInt32, 2), p0, p0, loop);
+  Node* add = graph()->NewNode(machine()->Int32Add(), phi, p1);
+  Node* branch = graph()->NewNode(common()->Branch(), add, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  loop->ReplaceInput(1, if_true);
+  phi->ReplaceInput(1, add);
+  Node* ret = graph()->NewNode(common()->Return(), phi, start, if_false);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  EXPECT_EQ(1, PeelInnerLoops());
+
+  // The loop is now entered from the peeled iteration.
+  Node* entry = loop->InputAt(0);
+  EXPECT_EQ(IrOpcode::kIfTrue, entry->opcode());
+  Node* peeled_branch = entry->InputAt(0);
+  EXPECT_EQ(IrOpcode::kBranch, peeled_branch->opcode());
+  EXPECT_NE(branch, peeled_branch);
+  EXPECT_EQ(start, NodeProperties::GetControlInput(peeled_branch));
+  Node* peeled_add = NodeProperties::GetValueInput(peeled_branch, 0);
+  EXPECT_EQ(IrOpcode::kInt32Add, peeled_add->opcode());
+  EXPECT_EQ(p0, peeled_add->InputAt(0));
+  EXPECT_EQ(p1, peeled_add->InputAt(1));
+  EXPECT_EQ(peeled_add, phi->InputAt(0));
+  EXPECT_EQ(add, phi->InputAt(1));
+  EXPECT_EQ(if_true, loop->InputAt(1));
+
+  // Both exits are merged, and so is the value leaving the loop.
+  Node* merge = NodeProperties::GetControlInput(ret);
+  EXPECT_EQ(IrOpcode::kMerge, merge->opcode());
+  EXPECT_EQ(if_false, merge->InputAt(0));
+  Node* peeled_exit = merge->InputAt(1);
+  EXPECT_EQ(IrOpcode::kIfFalse, peeled_exit->opcode());
+  EXPECT_EQ(peeled_branch, peeled_exit->InputAt(0));
+  Node* exit_phi = NodeProperties::GetValueInput(ret, 0);
+  EXPECT_EQ(IrOpcode::kPhi, exit_phi->opcode());
+  EXPECT_EQ(phi, exit_phi->InputAt(0));
+  EXPECT_EQ(p0, exit_phi->InputAt(1));
+  EXPECT_EQ(merge, exit_phi->InputAt(2));
+}
+
+
+TEST_F(LoopPeelingTest, LoopWithTwoExitsIsNotPeeled) {
+  Node* const p0 = Parameter(0);
+  Node* const p1 = Parameter(1);
+  Node* const start = graph()->start();
+  Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+  Node* phi = graph()->NewNode(common()->Phi(kMachInt32, 2), p0, p0, loop);
+  Node* branch1 = graph()->NewNode(common()->Branch(), phi, loop);
+  Node* if_true1 = graph()->NewNode(common()->IfTrue(), branch1);
+  Node* if_false1 = graph()->NewNode(common()->IfFalse(), branch1);
+  Node* add = graph()->NewNode(machine()->Int32Add(), phi, p1);
+  Node* branch2 = graph()->NewNode(common()->Branch(), add, if_true1);
+  Node* if_true2 = graph()->NewNode(common()->IfTrue(), branch2);
+  Node* if_false2 = graph()->NewNode(common()->IfFalse(), branch2);
+  loop->ReplaceInput(1, if_true2);
+  phi->ReplaceInput(1, add);
+  Node* ret1 = graph()->NewNode(common()->Return(), phi, start, if_false1);
+  Node* ret2 = graph()->NewNode(common()->Return(), add, start, if_false2);
+  Node* merge = graph()->NewNode(common()->Merge(2), ret1, ret2);
+  graph()->SetEnd(graph()->NewNode(common()->End(), merge));
+
+  EXPECT_EQ(0, PeelInnerLoops());
+  EXPECT_EQ(start, loop->InputAt(0));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
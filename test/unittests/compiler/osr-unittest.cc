@@ -0,0 +1,129 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/node-properties-inl.h"
+#include "src/compiler/osr.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class OsrTest : public GraphTest {
+ public:
+  OsrTest() : GraphTest(2) {}
+  virtual ~OsrTest() {}
+
+ protected:
+  bool RemoveNormalEntry(Node* normal_entry) {
+    return OsrHelper::RemoveNormalEntry(graph(), common(), normal_entry);
+  }
+
+  // Builds the OSR loop {for (x = osr_value; x; x = x) {}} entered from the
+  // start node and returns its exit.
+  Node* NewOsrLoop(Node** value) {
+    Node* const start = graph()->start();
+    Node* osr_value = graph()->NewNode(common()->OsrValue(2), start);
+    Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+    Node* phi = graph()->NewNode(common()->Phi(kMachAnyTagged, 2), osr_value,
+                                 osr_value, loop);
+    Node* branch = graph()->NewNode(common()->Branch(), phi, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    loop->ReplaceInput(1, if_true);
+    phi->ReplaceInput(1, phi);
+    *value = phi;
+    return graph()->NewNode(common()->IfFalse(), branch);
+  }
+};
+
+
+TEST_F(OsrTest, EarlyReturnIsRemoved) {
+  Node* const p0 = Parameter(0);
+  Node* const start = graph()->start();
+  Node* normal_entry = graph()->NewNode(common()->Merge(1), start);
+  Node* branch = graph()->NewNode(common()->Branch(), p0, normal_entry);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* ret0 = graph()->NewNode(common()->Return(), p0, start, if_true);
+  Node* value;
+  Node* exit = NewOsrLoop(&value);
+  Node* ret1 = graph()->NewNode(common()->Return(), value, start, exit);
+  Node* merge = graph()->NewNode(common()->Merge(2), ret0, ret1);
+  graph()->SetEnd(graph()->NewNode(common()->End(), merge));
+
+  EXPECT_TRUE(RemoveNormalEntry(normal_entry));
+
+  EXPECT_EQ(1, merge->InputCount());
+  EXPECT_EQ(1, OperatorProperties::GetControlInputCount(merge->op()));
+  EXPECT_EQ(ret1, merge->InputAt(0));
+  EXPECT_EQ(NULL, ret0->InputAt(2));
+  EXPECT_EQ(NULL, normal_entry->InputAt(0));
+  for (UseIter i = start->uses().begin(); i != start->uses().end(); ++i) {
+    EXPECT_NE(normal_entry, *i);
+    EXPECT_NE(ret0, *i);
+  }
+}
+
+
+TEST_F(OsrTest, PhiInputsAreRemoved) {
+  Node* const p0 = Parameter(0);
+  Node* const p1 = Parameter(1);
+  Node* const start = graph()->start();
+  Node* normal_entry = graph()->NewNode(common()->Merge(1), start);
+  Node* branch = graph()->NewNode(common()->Branch(), p0, normal_entry);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* value;
+  Node* exit = NewOsrLoop(&value);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, exit);
+  Node* phi =
+      graph()->NewNode(common()->Phi(kMachAnyTagged, 2), p1, value, merge);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), start, start, merge);
+  Node* ret = graph()->NewNode(common()->Return(), phi, effect_phi, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  EXPECT_TRUE(RemoveNormalEntry(normal_entry));
+
+  EXPECT_EQ(1, merge->InputCount());
+  EXPECT_EQ(exit, merge->InputAt(0));
+  EXPECT_EQ(2, phi->InputCount());
+  EXPECT_EQ(1, OperatorProperties::GetValueInputCount(phi->op()));
+  EXPECT_EQ(value, phi->InputAt(0));
+  EXPECT_EQ(merge, phi->InputAt(1));
+  EXPECT_EQ(2, effect_phi->InputCount());
+  EXPECT_EQ(1, OperatorProperties::GetEffectInputCount(effect_phi->op()));
+  EXPECT_EQ(merge, effect_phi->InputAt(1));
+  EXPECT_EQ(NULL, branch->InputAt(0));
+}
+
+
+TEST_F(OsrTest, UseOfRegularEntryFails) {
+  Node* const p0 = Parameter(0);
+  Node* const start = graph()->start();
+  Node* normal_entry = graph()->NewNode(common()->Merge(1), start);
+  Node* normal_value =
+      graph()->NewNode(common()->Phi(kMachAnyTagged, 1), p0, normal_entry);
+  Node* value;
+  Node* exit = NewOsrLoop(&value);
+  Node* ret = graph()->NewNode(common()->Return(), normal_value, start, exit);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  EXPECT_FALSE(RemoveNormalEntry(normal_entry));
+}
+
+
+TEST_F(OsrTest, EndOnlyReachedFromRegularEntryFails) {
+  Node* const p0 = Parameter(0);
+  Node* const start = graph()->start();
+  Node* normal_entry = graph()->NewNode(common()->Merge(1), start);
+  Node* ret = graph()->NewNode(common()->Return(), p0, start, normal_entry);
+  Node* value;
+  NewOsrLoop(&value);
+  graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+
+  EXPECT_FALSE(RemoveNormalEntry(normal_entry));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
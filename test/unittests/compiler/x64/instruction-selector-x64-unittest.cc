@@ -308,6 +308,41 @@ TEST_F(AddressingModeUnitTest, AddressingMode_MNI) {
 }
 
 
+TEST_F(AddressingModeUnitTest, AddressingMode_MRNWithShift) {
+  AddressingMode expected[] = {kMode_MR1, kMode_MR2, kMode_MR4, kMode_MR8};
+  for (int32_t shift = 0; shift < 4; ++shift) {
+    Reset();
+    Node* base = base_reg;
+    Node* index = m->Word32Shl(index_reg, m->Int32Constant(shift));
+    Run(base, index, expected[shift]);
+  }
+}
+
+
+TEST_F(AddressingModeUnitTest, AddressingMode_MRNIWithShiftAndSub) {
+  AddressingMode expected[] = {kMode_MR1I, kMode_MR2I, kMode_MR4I, kMode_MR8I};
+  for (int32_t shift = 0; shift < 4; ++shift) {
+    Reset();
+    Node* base = base_reg;
+    Node* index = m->Int32Sub(m->Word32Shl(index_reg, m->Int32Constant(shift)),
+                              non_zero);
+    Run(base, index, expected[shift]);
+  }
+}
+
+
+TEST_F(AddressingModeUnitTest, AddressingModeWithLargeShift) {
+  Node* base = base_reg;
+  Node* index = m->Word32Shl(index_reg, m->Int32Constant(4));
+  Node* load = m->Load(kMachInt32, base, index);
+  m->Return(load);
+  Stream s = m->Build();
+  ASSERT_EQ(2U, s.size());
+  EXPECT_EQ(kX64Shl32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MR1, s[1]->addressing_mode());
+}
+
+
 // -----------------------------------------------------------------------------
 // Multiplication.
 
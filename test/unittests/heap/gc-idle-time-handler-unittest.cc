@@ -69,6 +69,16 @@ TEST(GCIdleTimeHandler, EstimateMarkingStepSizeNonZero) {
 }
 
 
+TEST(GCIdleTimeHandler, EstimateMarkingStepSizeSubMillisecond) {
+  size_t marking_speed_in_bytes_per_millisecond = 100 * KB;
+  size_t step_size = GCIdleTimeHandler::EstimateMarkingStepSize(
+      0.5, marking_speed_in_bytes_per_millisecond);
+  EXPECT_EQ(static_cast<size_t>(marking_speed_in_bytes_per_millisecond * 0.5 *
+                                GCIdleTimeHandler::kConservativeTimeRatio),
+            step_size);
+}
+
+
 TEST(GCIdleTimeHandler, EstimateMarkingStepSizeOverflow1) {
   size_t step_size = GCIdleTimeHandler::EstimateMarkingStepSize(
       10, std::numeric_limits<size_t>::max());
@@ -224,6 +234,18 @@ TEST_F(GCIdleTimeHandlerTest, IncrementalMarking2) {
 }
 
 
+TEST_F(GCIdleTimeHandlerTest, IncrementalMarkingSubMillisecond) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  size_t speed = heap_state.incremental_marking_speed_in_bytes_per_ms;
+  double idle_time_ms = 0.5;
+  GCIdleTimeAction action = handler()->Compute(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+  EXPECT_GT(static_cast<double>(speed) * idle_time_ms,
+            static_cast<double>(action.parameter));
+  EXPECT_LT(0, action.parameter);
+}
+
+
 TEST_F(GCIdleTimeHandlerTest, NotEnoughTime) {
   GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
   heap_state.incremental_marking_stopped = true;
@@ -0,0 +1,151 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/memory-reducer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+MemoryReducer::State DoneState() {
+  return MemoryReducer::State(MemoryReducer::kDone, 0, 0.0);
+}
+
+
+MemoryReducer::State WaitState(int started_gcs, double next_gc_start_ms) {
+  return MemoryReducer::State(MemoryReducer::kWait, started_gcs,
+                              next_gc_start_ms);
+}
+
+
+MemoryReducer::State RunState(int started_gcs) {
+  return MemoryReducer::State(MemoryReducer::kRun, started_gcs, 0.0);
+}
+
+
+MemoryReducer::Event TimerEvent(double time_ms, bool low_allocation_rate,
+                                bool can_start_incremental_marking) {
+  MemoryReducer::Event event;
+  event.type = MemoryReducer::kTimer;
+  event.time_ms = time_ms;
+  event.low_allocation_rate = low_allocation_rate;
+  event.can_start_incremental_marking = can_start_incremental_marking;
+  event.next_gc_likely_to_collect_more = false;
+  return event;
+}
+
+
+MemoryReducer::Event MarkCompactEvent(double time_ms,
+                                      bool next_gc_likely_to_collect_more) {
+  MemoryReducer::Event event;
+  event.type = MemoryReducer::kMarkCompact;
+  event.time_ms = time_ms;
+  event.low_allocation_rate = false;
+  event.can_start_incremental_marking = false;
+  event.next_gc_likely_to_collect_more = next_gc_likely_to_collect_more;
+  return event;
+}
+
+
+MemoryReducer::Event ContextDisposedEvent(double time_ms) {
+  MemoryReducer::Event event = TimerEvent(time_ms, false, false);
+  event.type = MemoryReducer::kContextDisposed;
+  return event;
+}
+
+}  // namespace
+
+
+TEST(MemoryReducer, FromDoneToDone) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(DoneState(), TimerEvent(0, true, true));
+  EXPECT_EQ(MemoryReducer::kDone, state.action);
+}
+
+
+TEST(MemoryReducer, FromDoneToWait) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(DoneState(), MarkCompactEvent(1000, false));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(1000 + MemoryReducer::kLongDelayMs, state.next_gc_start_ms);
+  EXPECT_EQ(0, state.started_gcs);
+
+  state = MemoryReducer::Step(DoneState(), ContextDisposedEvent(1000));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(1000 + MemoryReducer::kLongDelayMs, state.next_gc_start_ms);
+}
+
+
+TEST(MemoryReducer, FromWaitToWait) {
+  MemoryReducer::State state0 = WaitState(2, 1000.0);
+
+  // Too early.
+  MemoryReducer::State state =
+      MemoryReducer::Step(state0, TimerEvent(999, true, true));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(state0.next_gc_start_ms, state.next_gc_start_ms);
+
+  // The isolate is still busy.
+  state = MemoryReducer::Step(state0, TimerEvent(2000, false, true));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(2000 + MemoryReducer::kLongDelayMs, state.next_gc_start_ms);
+  EXPECT_EQ(state0.started_gcs, state.started_gcs);
+
+  // Incremental marking cannot be started.
+  state = MemoryReducer::Step(state0, TimerEvent(2000, true, false));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(2000 + MemoryReducer::kLongDelayMs, state.next_gc_start_ms);
+
+  // Another GC postpones ours.
+  state = MemoryReducer::Step(state0, MarkCompactEvent(2000, false));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(2000 + MemoryReducer::kLongDelayMs, state.next_gc_start_ms);
+
+  state = MemoryReducer::Step(state0, ContextDisposedEvent(2000));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(state0.next_gc_start_ms, state.next_gc_start_ms);
+}
+
+
+TEST(MemoryReducer, FromWaitToRun) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(WaitState(0, 1000.0), TimerEvent(1000, true, true));
+  EXPECT_EQ(MemoryReducer::kRun, state.action);
+  EXPECT_EQ(1, state.started_gcs);
+}
+
+
+TEST(MemoryReducer, FromRunToRun) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(RunState(1), TimerEvent(1000, true, true));
+  EXPECT_EQ(MemoryReducer::kRun, state.action);
+
+  state = MemoryReducer::Step(RunState(1), ContextDisposedEvent(1000));
+  EXPECT_EQ(MemoryReducer::kRun, state.action);
+}
+
+
+TEST(MemoryReducer, FromRunToWait) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(RunState(1), MarkCompactEvent(1000, true));
+  EXPECT_EQ(MemoryReducer::kWait, state.action);
+  EXPECT_EQ(1000 + MemoryReducer::kShortDelayMs, state.next_gc_start_ms);
+  EXPECT_EQ(1, state.started_gcs);
+}
+
+
+TEST(MemoryReducer, FromRunToDone) {
+  MemoryReducer::State state =
+      MemoryReducer::Step(RunState(1), MarkCompactEvent(1000, false));
+  EXPECT_EQ(MemoryReducer::kDone, state.action);
+
+  state = MemoryReducer::Step(RunState(MemoryReducer::kMaxNumberOfGCs),
+                              MarkCompactEvent(1000, true));
+  EXPECT_EQ(MemoryReducer::kDone, state.action);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,88 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/slot-set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const size_t kChunkSize = 4 * SlotSet::kBucketSizeInBytes;
+
+Address ChunkStart() { return reinterpret_cast<Address>(1 << 20); }
+
+
+Address SlotAt(int index) { return ChunkStart() + index * kPointerSize; }
+
+
+// Re-enters every slot whose index is a multiple of three.
+class KeepEveryThirdSlot {
+ public:
+  explicit KeepEveryThirdSlot(SlotSet* set) : set_(set), visited_(0) {}
+
+  void VisitSlot(Address slot) {
+    visited_++;
+    int index = static_cast<int>((slot - ChunkStart()) / kPointerSize);
+    if (index % 3 == 0) set_->Insert(slot);
+  }
+
+  int visited() const { return visited_; }
+
+ private:
+  SlotSet* set_;
+  int visited_;
+};
+
+}  // namespace
+
+
+TEST(SlotSet, InsertAndContains) {
+  SlotSet set(ChunkStart(), kChunkSize);
+  int slots = static_cast<int>(kChunkSize / kPointerSize);
+  for (int i = 0; i < slots; i += 7) set.Insert(SlotAt(i));
+  for (int i = 0; i < slots; i++) {
+    EXPECT_EQ(i % 7 == 0, set.Contains(SlotAt(i)));
+  }
+}
+
+
+TEST(SlotSet, NoDuplicates) {
+  SlotSet set(ChunkStart(), kChunkSize);
+  set.Insert(SlotAt(42));
+  set.Insert(SlotAt(42));
+  KeepEveryThirdSlot visitor(&set);
+  EXPECT_EQ(1, set.Iterate(&visitor));
+}
+
+
+TEST(SlotSet, IterateRemovesUnlessReinserted) {
+  SlotSet set(ChunkStart(), kChunkSize);
+  int slots = static_cast<int>(kChunkSize / kPointerSize);
+  for (int i = 0; i < slots; i++) set.Insert(SlotAt(i));
+  KeepEveryThirdSlot visitor(&set);
+  EXPECT_EQ(slots, set.Iterate(&visitor));
+  EXPECT_EQ(slots, visitor.visited());
+  for (int i = 0; i < slots; i++) {
+    EXPECT_EQ(i % 3 == 0, set.Contains(SlotAt(i)));
+  }
+
+  // A second pass only sees the slots that were kept.
+  KeepEveryThirdSlot second_visitor(&set);
+  EXPECT_EQ((slots + 2) / 3, set.Iterate(&second_visitor));
+}
+
+
+TEST(SlotSet, LastSlotOfPartialBucket) {
+  size_t size = SlotSet::kBucketSizeInBytes + kPointerSize;
+  SlotSet set(ChunkStart(), size);
+  int last = static_cast<int>(size / kPointerSize) - 1;
+  set.Insert(SlotAt(last));
+  EXPECT_TRUE(set.Contains(SlotAt(last)));
+  EXPECT_FALSE(set.Contains(SlotAt(last - 1)));
+}
+
+}  // namespace internal
+}  // namespace v8
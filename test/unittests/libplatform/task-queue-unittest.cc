@@ -23,13 +23,18 @@ struct MockTask : public Task {
 
 class TaskQueueThread FINAL : public base::Thread {
  public:
-  explicit TaskQueueThread(TaskQueue* queue)
-      : Thread(Options("libplatform TaskQueueThread")), queue_(queue) {}
+  explicit TaskQueueThread(TaskQueue* queue, int lane = 0)
+      : Thread(Options("libplatform TaskQueueThread")),
+        queue_(queue),
+        lane_(lane) {}
 
-  virtual void Run() OVERRIDE { EXPECT_THAT(queue_->GetNext(), IsNull()); }
+  virtual void Run() OVERRIDE {
+    EXPECT_THAT(queue_->GetNext(lane_), IsNull());
+  }
 
  private:
   TaskQueue* queue_;
+  int lane_;
 };
 
 }  // namespace
@@ -56,5 +61,93 @@ TEST(TaskQueueTest, TerminateMultipleReaders) {
   thread2.Join();
 }
 
+
+TEST(TaskQueueTest, StealFromOtherLanes) {
+  TaskQueue queue(2);
+  MockTask task1;
+  MockTask task2;
+  queue.Append(&task1);
+  queue.Append(&task2);
+  // The tasks went to different lanes, lane 0 steals the second one.
+  EXPECT_EQ(&task1, queue.GetNext(0));
+  EXPECT_EQ(&task2, queue.GetNext(0));
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+}
+
+
+TEST(TaskQueueTest, LongRunningTasksAvoidLaneZero) {
+  TaskQueue queue(2);
+  MockTask long_task;
+  MockTask short_task;
+  queue.Append(&long_task, Platform::kLongRunningTask);
+  queue.Append(&short_task, Platform::kShortRunningTask);
+  EXPECT_EQ(&short_task, queue.GetNext(0));
+  EXPECT_EQ(&long_task, queue.GetNext(1));
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+}
+
+
+TEST(TaskQueueTest, HigherPriorityFirst) {
+  TaskQueue queue;
+  MockTask best_effort;
+  MockTask user_visible;
+  MockTask user_blocking;
+  queue.Append(&best_effort, Platform::kShortRunningTask,
+               Platform::kBestEffortPriority);
+  queue.Append(&user_visible, Platform::kShortRunningTask,
+               Platform::kUserVisiblePriority);
+  queue.Append(&user_blocking, Platform::kShortRunningTask,
+               Platform::kUserBlockingPriority);
+  EXPECT_EQ(&user_blocking, queue.GetNext());
+  EXPECT_EQ(&user_visible, queue.GetNext());
+  EXPECT_EQ(&best_effort, queue.GetNext());
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(), IsNull());
+}
+
+
+TEST(TaskQueueTest, IsolatesTakeTurns) {
+  int dummy1, dummy2;
+  Isolate* isolate1 = reinterpret_cast<Isolate*>(&dummy1);
+  Isolate* isolate2 = reinterpret_cast<Isolate*>(&dummy2);
+  TaskQueue queue;
+  MockTask task1a;
+  MockTask task1b;
+  MockTask task2;
+  queue.Append(&task1a, Platform::kShortRunningTask,
+               Platform::kUserVisiblePriority, isolate1);
+  queue.Append(&task1b, Platform::kShortRunningTask,
+               Platform::kUserVisiblePriority, isolate1);
+  queue.Append(&task2, Platform::kShortRunningTask,
+               Platform::kUserVisiblePriority, isolate2);
+  Task* first = queue.GetNext();
+  Task* second = queue.GetNext();
+  // Whichever isolate goes first, the other one is served before isolate1
+  // gets its second task.
+  EXPECT_NE(&task1b, first);
+  EXPECT_NE(&task1b, second);
+  EXPECT_EQ(&task1b, queue.GetNext());
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(), IsNull());
+}
+
+
+TEST(TaskQueueTest, TerminateMultipleLanes) {
+  TaskQueue queue(3);
+  TaskQueueThread thread1(&queue, 0);
+  TaskQueueThread thread2(&queue, 1);
+  TaskQueueThread thread3(&queue, 2);
+  thread1.Start();
+  thread2.Start();
+  thread3.Start();
+  queue.Terminate();
+  thread1.Join();
+  thread2.Join();
+  thread3.Join();
+}
+
 }  // namespace platform
 }  // namespace v8
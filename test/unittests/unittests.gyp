@@ -45,8 +45,12 @@
         'compiler/instruction-selector-unittest.h',
         'compiler/js-builtin-reducer-unittest.cc',
         'compiler/js-operator-unittest.cc',
+        'compiler/load-elimination-unittest.cc',
+        'compiler/loop-analysis-unittest.cc',
+        'compiler/loop-peeling-unittest.cc',
         'compiler/machine-operator-reducer-unittest.cc',
         'compiler/machine-operator-unittest.cc',
+        'compiler/osr-unittest.cc',
         'compiler/simplified-operator-reducer-unittest.cc',
         'compiler/simplified-operator-unittest.cc',
         'compiler/value-numbering-reducer-unittest.cc',
@@ -54,6 +58,8 @@
         'libplatform/task-queue-unittest.cc',
         'libplatform/worker-thread-unittest.cc',
         'heap/gc-idle-time-handler-unittest.cc',
+        'heap/memory-reducer-unittest.cc',
+        'heap/slot-set-unittest.cc',
         'run-all-unittests.cc',
         'test-utils.h',
         'test-utils.cc',
@@ -114,5 +120,47 @@
         }],
       ],
     },
+    {
+      'target_name': 'microbenchmarks',
+      'type': 'executable',
+      'variables': {
+        'optimize': 'max',
+      },
+      'dependencies': [
+        '../../tools/gyp/v8.gyp:v8_libplatform',
+      ],
+      'include_dirs': [
+        '../..',
+      ],
+      'sources': [  ### gcmole(all) ###
+        'benchmarks/benchmark.cc',
+        'benchmarks/benchmark.h',
+        'benchmarks/conversions-benchmark.cc',
+        'benchmarks/free-list-benchmark.cc',
+        'benchmarks/hashmap-benchmark.cc',
+        'benchmarks/json-parser-benchmark.cc',
+        'benchmarks/run-all-benchmarks.cc',
+        'benchmarks/string-search-benchmark.cc',
+        'benchmarks/zone-benchmark.cc',
+      ],
+      'conditions': [
+        ['component=="shared_library"', {
+          # The benchmarks use internal classes, so they need to link against
+          # the underlying static target.
+          'conditions': [
+            ['v8_use_snapshot=="true"', {
+              'dependencies': ['../../tools/gyp/v8.gyp:v8_snapshot'],
+            },
+            {
+              'dependencies': [
+                '../../tools/gyp/v8.gyp:v8_nosnapshot',
+              ],
+            }],
+          ],
+        }, {
+          'dependencies': ['../../tools/gyp/v8.gyp:v8'],
+        }],
+      ],
+    },
   ],
 }
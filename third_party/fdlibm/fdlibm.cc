@@ -79,7 +79,40 @@ const double MathConstants::constants[] = {
     -7.93650757867487942473e-05,  //          49
     4.00821782732936239552e-06,   //          50
     -2.01099218183624371326e-07,  // Q5       51
-    710.4758600739439             //          52  overflow threshold sinh, cosh
+    710.4758600739439,            //          52  overflow threshold sinh, cosh
+    1.57079632679489655800e+00,   // pio2_hi  53
+    6.12323399573676603587e-17,   // pio2_lo  54
+    3.14159265358979311600e+00,   // pi       55
+    1.22464679914735317720e-16,   // pi_lo    56
+    1.66666666666666657415e-01,   // PS0      57  coefficients for asin, acos
+    -3.25565818622400915405e-01,  //          58
+    2.01212532134862925881e-01,   //          59
+    -4.00555345006794114027e-02,  //          60
+    7.91534994289814532176e-04,   //          61
+    3.47933107596021167570e-05,   // PS5      62
+    -2.40339491173441421878e+00,  // QS1      63
+    2.02094576023350569471e+00,   //          64
+    -6.88283971605453293030e-01,  //          65
+    7.70381505559019352791e-02,   // QS4      66
+    4.63647609000806093515e-01,   // atanhi   67  atan(0.5)hi
+    7.85398163397448278999e-01,   //          68  atan(1.0)hi
+    9.82793723247329054082e-01,   //          69  atan(1.5)hi
+    1.57079632679489655800e+00,   //          70  atan(inf)hi
+    2.26987774529616870924e-17,   // atanlo   71  atan(0.5)lo
+    3.06161699786838301793e-17,   //          72  atan(1.0)lo
+    1.39033110312309984516e-17,   //          73  atan(1.5)lo
+    6.12323399573676603587e-17,   //          74  atan(inf)lo
+    3.33333333333329318027e-01,   // AT0      75  coefficients for atan
+    -1.99999999998764832476e-01,  //          76
+    1.42857142725034663711e-01,   //          77
+    -1.11111104054623557880e-01,  //          78
+    9.09088713343650656196e-02,   //          79
+    -7.69187620504482999495e-02,  //          80
+    6.66107313738753120669e-02,   //          81
+    -5.83357013379057348645e-02,  //          82
+    4.97687799461593236017e-02,   //          83
+    -3.65315727442169155270e-02,  //          84
+    1.62858201153657823623e-02    // AT10     85
 };
 
 
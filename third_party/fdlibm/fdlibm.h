@@ -23,7 +23,7 @@ int rempio2(double x, double* y);
 
 // Constants to be exposed to builtins via Float64Array.
 struct MathConstants {
-  static const double constants[53];
+  static const double constants[86];
 };
 }
 }  // namespace v8::internal
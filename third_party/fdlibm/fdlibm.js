@@ -359,6 +359,286 @@ function MathTan(x) {
   return KernelTan(y0, y1, (n & 1) ? -1 : 1);
 }
 
+// ES6 draft 09-27-13, section 20.2.2.3 and 20.2.2.2.
+// Math.asin and Math.acos
+//
+// Method :
+//   Since  asin(x) = x + x^3/6 + x^5*3/40 + x^7*15/336 + ...
+//   we approximate asin(x) on [0,0.5] by
+//           asin(x) = x + x*x^2*R(x^2)
+//   where
+//           R(x^2) is a rational approximation of (asin(x)-x)/x^3
+//   and its remez error is bounded by
+//           |(asin(x)-x)/x^3 - R(x^2)| < 2^(-58.75)
+//
+//   For x in [0.5,1]
+//           asin(x) = pi/2-2*asin(sqrt((1-x)/2))
+//   Let y = (1-x), z = y/2, s := sqrt(z), and pio2_hi+pio2_lo=pi/2;
+//   then for x>0.98
+//           asin(x) = pi/2 - 2*(s+s*z*R(z))
+//                   = pio2_hi - (2*(s+s*z*R(z)) - pio2_lo)
+//   For x<=0.98, let pio4_hi = pio2_hi/2, then
+//           f = hi part of s;
+//           c = sqrt(z) - f = (z-f*f)/(s+f)     ...f+c=sqrt(z)
+//   and
+//           asin(x) = pi/2 - 2*(s+s*z*R(z))
+//                   = pio4_hi+(pio4-2s)-(2s*z*R(z)-pio2_lo)
+//                   = pio4_hi+(pio4-2f)-(2s*z*R(z)-(pio2_lo+2c))
+//
+//   acos(x) = pi/2 - asin(x) is computed from the same approximation:
+//      for |x|<0.5, acos(x) = pi/2 - (x + x*x^2*R(x^2))
+//      for x<-0.5,  acos(x) = pi - 2asin(sqrt((1-|x|)/2))
+//                           = pi - 2(s+s*z*R(z)), where z=(1-|x|)/2
+//      for x>0.5,   acos(x) = 2asin(sqrt((1-x)/2))
+//                           = 2(s+s*z*R(z)), computed as 2(f+(c+s*z*R(z)))
+//                   where f is the hi part of s and c = (z-f*f)/(s+f).
+//
+// Special cases:
+//   if x is NaN, return NaN.
+//   if |x|>1, return NaN.
+//
+const PIO2_HI = kMath[53];
+const PIO2_LO = kMath[54];
+const PI      = kMath[55];
+const PI_LO   = kMath[56];
+
+macro KASIN(x)
+kMath[57+x]
+endmacro
+
+// The rational approximation z*R(z) shared by asin and acos.
+macro ASIN_R(z)
+(((z) * (KASIN(0) + (z) * (KASIN(1) + (z) * (KASIN(2) + (z) * (KASIN(3) +
+  (z) * (KASIN(4) + (z) * KASIN(5))))))) /
+ (1 + (z) * (KASIN(6) + (z) * (KASIN(7) + (z) * (KASIN(8) +
+  (z) * KASIN(9))))))
+endmacro
+
+// ECMA 262 - 15.8.2.3
+function MathAsin(x) {
+  x = x * 1;  // Convert to number.
+  var hx = %_DoubleHi(x);
+  var ix = hx & 0x7fffffff;
+  if (ix >= 0x3ff00000) {  // |x| >= 1
+    if (((ix - 0x3ff00000) | %_DoubleLo(x)) == 0) {
+      // asin(+-1) = +-pi/2
+      return x * PIO2_HI + x * PIO2_LO;
+    }
+    return NAN;  // asin(|x| > 1) and asin(NaN) are NaN
+  }
+  if (ix < 0x3fe00000) {  // |x| < 0.5
+    if (ix < 0x3e500000) return x;  // |x| < 2^-26
+    var t = x * x;
+    return x + x * ASIN_R(t);
+  }
+  // 0.5 <= |x| < 1
+  var t = (1 - MathAbs(x)) * 0.5;
+  var s = %_MathSqrtRT(t);
+  if (ix >= 0x3fef3333) {  // |x| > 0.975
+    t = PIO2_HI - (2 * (s + s * ASIN_R(t)) - PIO2_LO);
+  } else {
+    var w = %_ConstructDouble(%_DoubleHi(s), 0);
+    var c = (t - w * w) / (s + w);
+    var p = 2 * s * ASIN_R(t) - (PIO2_LO - 2 * c);
+    var q = PIO4 - 2 * w;
+    t = PIO4 - (p - q);
+  }
+  return (hx > 0) ? t : -t;
+}
+
+// ECMA 262 - 15.8.2.2
+function MathAcos(x) {
+  x = x * 1;  // Convert to number.
+  var hx = %_DoubleHi(x);
+  var ix = hx & 0x7fffffff;
+  if (ix >= 0x3ff00000) {  // |x| >= 1
+    if (((ix - 0x3ff00000) | %_DoubleLo(x)) == 0) {
+      // acos(1) = 0, acos(-1) = pi
+      return (hx > 0) ? 0 : PI + 2 * PIO2_LO;
+    }
+    return NAN;  // acos(|x| > 1) and acos(NaN) are NaN
+  }
+  if (ix < 0x3fe00000) {  // |x| < 0.5
+    if (ix <= 0x3c600000) return PIO2_HI + PIO2_LO;  // |x| < 2^-57
+    var z = x * x;
+    return PIO2_HI - (x - (PIO2_LO - x * ASIN_R(z)));
+  }
+  if (hx < 0) {  // -1 < x <= -0.5
+    var z = (1 + x) * 0.5;
+    var s = %_MathSqrtRT(z);
+    var w = ASIN_R(z) * s - PIO2_LO;
+    return PI - 2 * (s + w);
+  }
+  // 0.5 <= x < 1
+  var z = (1 - x) * 0.5;
+  var s = %_MathSqrtRT(z);
+  var df = %_ConstructDouble(%_DoubleHi(s), 0);
+  var c = (z - df * df) / (s + df);
+  var w = ASIN_R(z) * s + c;
+  return 2 * (df + w);
+}
+
+// ES6 draft 09-27-13, section 20.2.2.4.
+// Math.atan
+//
+// Method :
+//   1. Reduce x to positive by atan(x) = -atan(-x).
+//   2. According to the integer k=4t+0.25 chopped, t=x, the argument
+//      is further reduced to one of the following intervals and the
+//      arctangent of t is evaluated by the corresponding formula:
+//
+//      [0,7/16]      atan(x) = t-t^3*(a1+t^2*(a2+...(a10+t^2*a11)...)
+//      [7/16,11/16]  atan(x) = atan(1/2) + atan( (t-0.5)/(1+t/2) )
+//      [11/16.19/16] atan(x) = atan( 1 ) + atan( (t-1)/(1+t) )
+//      [19/16,39/16] atan(x) = atan(3/2) + atan( (t-1.5)/(1+1.5t) )
+//      [39/16,INF]   atan(x) = atan(INF) + atan( -1/t )
+//
+// Constants:
+//   The hexadecimal values are the intended ones for the following
+//   constants. The decimal values may be used, provided that the
+//   compiler will convert from decimal to binary accurately enough
+//   to produce the hexadecimal values shown.
+//
+macro ATANHI(x)
+kMath[67+x]
+endmacro
+
+macro ATANLO(x)
+kMath[71+x]
+endmacro
+
+macro KATAN(x)
+kMath[75+x]
+endmacro
+
+// ECMA 262 - 15.8.2.4
+function MathAtan(x) {
+  x = x * 1;  // Convert to number.
+  var hx = %_DoubleHi(x);
+  var ix = hx & 0x7fffffff;
+  var id;
+  if (ix >= 0x44100000) {  // |x| >= 2^66
+    if (NUMBER_IS_NAN(x)) return x;
+    return (hx > 0) ? ATANHI(3) + ATANLO(3) : -ATANHI(3) - ATANLO(3);
+  }
+  if (ix < 0x3fdc0000) {  // |x| < 0.4375
+    if (ix < 0x3e400000) return x;  // |x| < 2^-27
+    id = -1;
+  } else {
+    x = MathAbs(x);
+    if (ix < 0x3ff30000) {  // |x| < 1.1875
+      if (ix < 0x3fe60000) {  // 7/16 <= |x| < 11/16
+        id = 0;
+        x = (2 * x - 1) / (2 + x);
+      } else {  // 11/16 <= |x| < 19/16
+        id = 1;
+        x = (x - 1) / (x + 1);
+      }
+    } else {
+      if (ix < 0x40038000) {  // |x| < 2.4375
+        id = 2;
+        x = (x - 1.5) / (1 + 1.5 * x);
+      } else {  // 2.4375 <= |x| < 2^66
+        id = 3;
+        x = -1 / x;
+      }
+    }
+  }
+  // End of argument reduction.
+  var z = x * x;
+  var w = z * z;
+  // Break sum from i=0 to 10 KATAN(i)*z^(i+1) into odd and even poly.
+  var s1 = z * (KATAN(0) + w * (KATAN(2) + w * (KATAN(4) + w *
+           (KATAN(6) + w * (KATAN(8) + w * KATAN(10))))));
+  var s2 = w * (KATAN(1) + w * (KATAN(3) + w * (KATAN(5) + w *
+           (KATAN(7) + w * KATAN(9)))));
+  if (id < 0) return x - x * (s1 + s2);
+  z = ATANHI(id) - ((x * (s1 + s2) - ATANLO(id)) - x);
+  return (hx < 0) ? -z : z;
+}
+
+// ES6 draft 09-27-13, section 20.2.2.5.
+// Math.atan2
+//
+// Method :
+//   1. Reduce y to positive by atan2(y,x)=-atan2(-y,x).
+//   2. Reduce x to positive by (if x and y are unexceptional):
+//      ARG (x+iy) = arctan(y/x)          ... if x > 0,
+//      ARG (x+iy) = pi - arctan[y/(-x)]  ... if x < 0,
+//
+// Special cases:
+//
+//   ATAN2((anything), NaN ) is NaN;
+//   ATAN2(NAN , (anything) ) is NaN;
+//   ATAN2(+-0, +(anything but NaN)) is +-0  ;
+//   ATAN2(+-0, -(anything but NaN)) is +-pi ;
+//   ATAN2(+-(anything but 0 and NaN), 0) is +-pi/2;
+//   ATAN2(+-(anything but INF and NaN), +INF) is +-0 ;
+//   ATAN2(+-(anything but INF and NaN), -INF) is +-pi;
+//   ATAN2(+-INF,+INF ) is +-pi/4 ;
+//   ATAN2(+-INF,-INF ) is +-3pi/4;
+//   ATAN2(+-INF, (anything but 0, NaN and INF)) is +-pi/2;
+//
+// ECMA 262 - 15.8.2.5
+// The naming of y and x matches the spec, as does the order in which
+// ToNumber (valueOf) is called.
+function MathAtan2(y, x) {
+  y = y * 1;  // Convert to number.
+  x = x * 1;  // Convert to number.
+  if (NUMBER_IS_NAN(x) || NUMBER_IS_NAN(y)) return NAN;
+  if (x === 1) return MathAtan(y);  // x = 1.0
+  var hx = %_DoubleHi(x);
+  var hy = %_DoubleHi(y);
+  var ix = hx & 0x7fffffff;
+  var iy = hy & 0x7fffffff;
+  var m = ((hy >> 31) & 1) | ((hx >> 30) & 2);  // 2 * sign(x) + sign(y)
+
+  // When y = 0.
+  if (y == 0) {
+    if (m < 2) return y;  // atan(+-0, +anything) = +-0
+    return (m == 2) ? PI : -PI;  // atan(+-0, -anything) = +-pi
+  }
+  // When x = 0.
+  if (x == 0) return (hy < 0) ? -PIO2_HI : PIO2_HI;
+  // When x is INF.
+  if (ix == 0x7ff00000) {
+    if (iy == 0x7ff00000) {
+      switch (m) {
+        case 0: return PIO4;        // atan(+INF, +INF)
+        case 1: return -PIO4;       // atan(-INF, +INF)
+        case 2: return 3 * PIO4;    // atan(+INF, -INF)
+        default: return -3 * PIO4;  // atan(-INF, -INF)
+      }
+    }
+    switch (m) {
+      case 0: return 0;     // atan(+..., +INF)
+      case 1: return -0;    // atan(-..., +INF)
+      case 2: return PI;    // atan(+..., -INF)
+      default: return -PI;  // atan(-..., -INF)
+    }
+  }
+  // When y is INF.
+  if (iy == 0x7ff00000) return (hy < 0) ? -PIO2_HI : PIO2_HI;
+
+  // Compute y/x.
+  var z;
+  var k = (iy - ix) >> 20;
+  if (k > 60) {  // |y/x| > 2^60
+    z = PIO2_HI + 0.5 * PI_LO;
+    m &= 1;
+  } else if (hx < 0 && k < -60) {  // 0 > |y|/x > -2^-60
+    z = 0;
+  } else {  // Safe to do y/x.
+    z = MathAtan(MathAbs(y / x));
+  }
+  switch (m) {
+    case 0: return z;                  // atan(+, +)
+    case 1: return -z;                 // atan(-, +)
+    case 2: return PI - (z - PI_LO);   // atan(+, -)
+    default: return (z - PI_LO) - PI;  // atan(-, -)
+  }
+}
+
 // ES6 draft 09-27-13, section 20.2.2.20.
 // Math.log1p
 //
@@ -339,8 +339,12 @@
         '../../src/api.h',
         '../../src/arguments.cc',
         '../../src/arguments.h',
+        '../../src/array-buffer-allocator.cc',
+        '../../src/array-buffer-allocator.h',
         '../../src/assembler.cc',
         '../../src/assembler.h',
+        '../../src/asm-validator.cc',
+        '../../src/asm-validator.h',
         '../../src/assert-scope.h',
         '../../src/assert-scope.cc',
         '../../src/ast-value-factory.cc',
@@ -391,6 +395,8 @@
         '../../src/compiler/code-generator-impl.h',
         '../../src/compiler/code-generator.cc',
         '../../src/compiler/code-generator.h',
+        '../../src/compiler/code-stub-assembler.cc',
+        '../../src/compiler/code-stub-assembler.h',
         '../../src/compiler/common-node-cache.h',
         '../../src/compiler/common-operator.cc',
         '../../src/compiler/common-operator.h',
@@ -438,12 +444,20 @@
         '../../src/compiler/linkage-impl.h',
         '../../src/compiler/linkage.cc',
         '../../src/compiler/linkage.h',
+        '../../src/compiler/load-elimination.cc',
+        '../../src/compiler/load-elimination.h',
+        '../../src/compiler/loop-analysis.cc',
+        '../../src/compiler/loop-analysis.h',
+        '../../src/compiler/loop-peeling.cc',
+        '../../src/compiler/loop-peeling.h',
         '../../src/compiler/machine-operator-reducer.cc',
         '../../src/compiler/machine-operator-reducer.h',
         '../../src/compiler/machine-operator.cc',
         '../../src/compiler/machine-operator.h',
         '../../src/compiler/machine-type.cc',
         '../../src/compiler/machine-type.h',
+        '../../src/compiler/move-optimizer.cc',
+        '../../src/compiler/move-optimizer.h',
         '../../src/compiler/node-aux-data-inl.h',
         '../../src/compiler/node-aux-data.h',
         '../../src/compiler/node-cache.cc',
@@ -459,6 +473,8 @@
         '../../src/compiler/operator-properties.h',
         '../../src/compiler/operator.cc',
         '../../src/compiler/operator.h',
+        '../../src/compiler/osr.cc',
+        '../../src/compiler/osr.h',
         '../../src/compiler/phi-reducer.h',
         '../../src/compiler/pipeline.cc',
         '../../src/compiler/pipeline.h',
@@ -579,9 +595,12 @@
         '../../src/heap/mark-compact-inl.h',
         '../../src/heap/mark-compact.cc',
         '../../src/heap/mark-compact.h',
+        '../../src/heap/memory-reducer.cc',
+        '../../src/heap/memory-reducer.h',
         '../../src/heap/objects-visiting-inl.h',
         '../../src/heap/objects-visiting.cc',
         '../../src/heap/objects-visiting.h',
+        '../../src/heap/slot-set.h',
         '../../src/heap/spaces-inl.h',
         '../../src/heap/spaces.cc',
         '../../src/heap/spaces.h',
@@ -589,6 +608,8 @@
         '../../src/heap/store-buffer.cc',
         '../../src/heap/store-buffer.h',
         '../../src/hydrogen-alias-analysis.h',
+        '../../src/hydrogen-allocation-folding.cc',
+        '../../src/hydrogen-allocation-folding.h',
         '../../src/hydrogen-bce.cc',
         '../../src/hydrogen-bce.h',
         '../../src/hydrogen-bch.cc',
@@ -665,6 +686,8 @@
         '../../src/interpreter-irregexp.h',
         '../../src/isolate.cc',
         '../../src/isolate.h',
+        '../../src/isolate-template.cc',
+        '../../src/isolate-template.h',
         '../../src/json-parser.h',
         '../../src/json-stringifier.h',
         '../../src/jsregexp-inl.h',
@@ -729,12 +752,15 @@
         '../../src/regexp-macro-assembler-tracer.h',
         '../../src/regexp-macro-assembler.cc',
         '../../src/regexp-macro-assembler.h',
+        '../../src/regexp-nfa.cc',
+        '../../src/regexp-nfa.h',
         '../../src/regexp-stack.cc',
         '../../src/regexp-stack.h',
         '../../src/rewriter.cc',
         '../../src/rewriter.h',
         '../../src/runtime-profiler.cc',
         '../../src/runtime-profiler.h',
+        '../../src/runtime/runtime-atomics.cc',
         '../../src/runtime/runtime-classes.cc',
         '../../src/runtime/runtime-collections.cc',
         '../../src/runtime/runtime-compiler.cc',
@@ -752,6 +778,7 @@
         '../../src/runtime/runtime-proxy.cc',
         '../../src/runtime/runtime-regexp.cc',
         '../../src/runtime/runtime-scopes.cc',
+        '../../src/runtime/runtime-simd.cc',
         '../../src/runtime/runtime-strings.cc',
         '../../src/runtime/runtime-symbol.cc',
         '../../src/runtime/runtime-test.cc',
@@ -765,6 +792,8 @@
         '../../src/safepoint-table.h',
         '../../src/sampler.cc',
         '../../src/sampler.h',
+        '../../src/sampling-heap-profiler.cc',
+        '../../src/sampling-heap-profiler.h',
         '../../src/scanner-character-streams.cc',
         '../../src/scanner-character-streams.h',
         '../../src/scanner.cc',
@@ -780,6 +809,8 @@
         '../../src/snapshot.h',
         '../../src/snapshot-source-sink.cc',
         '../../src/snapshot-source-sink.h',
+        '../../src/source-position-table.cc',
+        '../../src/source-position-table.h',
         '../../src/string-search.cc',
         '../../src/string-search.h',
         '../../src/string-stream.cc',
@@ -818,6 +849,8 @@
         '../../src/v8memory.h',
         '../../src/v8threads.cc',
         '../../src/v8threads.h',
+        '../../src/value-serializer.cc',
+        '../../src/value-serializer.h',
         '../../src/variables.cc',
         '../../src/variables.h',
         '../../src/vector.h',
@@ -1594,6 +1627,8 @@
           '../../src/harmony-string.js',
           '../../src/harmony-array.js',
           '../../src/harmony-classes.js',
+          '../../src/harmony-atomics.js',
+          '../../src/harmony-simd.js',
         ],
         'libraries_bin_file': '<(SHARED_INTERMEDIATE_DIR)/libraries.bin',
         'libraries_experimental_bin_file': '<(SHARED_INTERMEDIATE_DIR)/libraries-experimental.bin',
@@ -36,7 +36,10 @@
 #include "include/libplatform/libplatform.h"
 #include "src/api.h"
 #include "src/compiler.h"
+#include "src/full-codegen.h"
+#include "src/rewriter.h"
 #include "src/scanner-character-streams.h"
+#include "src/scopes.h"
 #include "tools/shell-utils.h"
 #include "src/parser.h"
 #include "src/preparse-data-format.h"
@@ -57,34 +60,120 @@ class StringResource8 : public v8::String::ExternalOneByteStringResource {
   int length_;
 };
 
-std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
-    const char* fname, Encoding encoding, int repeat, v8::Isolate* isolate,
-    v8::Handle<v8::Context> context) {
-  int length = 0;
-  const byte* source = ReadFileAndRepeat(fname, &length, repeat);
-  v8::Handle<v8::String> source_handle;
-  switch (encoding) {
-    case UTF8: {
-      source_handle = v8::String::NewFromUtf8(
-          isolate, reinterpret_cast<const char*>(source));
-      break;
-    }
-    case UTF16: {
-      source_handle = v8::String::NewFromTwoByte(
-          isolate, reinterpret_cast<const uint16_t*>(source),
-          v8::String::kNormalString, length / 2);
-      break;
-    }
-    case LATIN1: {
-      StringResource8* string_resource =
-          new StringResource8(reinterpret_cast<const char*>(source), length);
-      source_handle = v8::String::NewExternal(isolate, string_resource);
-      break;
-    }
+
+// Feeds a source to the streaming parser in chunks, the way a network
+// stack would.
+class ChunkedSourceStream
+    : public v8::ScriptCompiler::ExternalSourceStream {
+ public:
+  static const int kChunkSize = 32 * KB;
+
+  ChunkedSourceStream(const byte* data, int length)
+      : data_(data), length_(length), position_(0) {}
+
+  virtual size_t GetMoreData(const uint8_t** src) {
+    int chunk_length = Min(kChunkSize, length_ - position_);
+    if (chunk_length == 0) return 0;
+    // V8 takes ownership of the chunk.
+    uint8_t* chunk = new uint8_t[chunk_length];
+    MemCopy(chunk, data_ + position_, chunk_length);
+    position_ += chunk_length;
+    *src = chunk;
+    return chunk_length;
   }
+
+ private:
+  const byte* data_;
+  int length_;
+  int position_;
+};
+
+
+class StreamingThread : public v8::base::Thread {
+ public:
+  explicit StreamingThread(v8::ScriptCompiler::ScriptStreamingTask* task)
+      : v8::base::Thread(v8::base::Thread::Options("StreamingThread")),
+        task_(task) {}
+
+  virtual void Run() { task_->Run(); }
+
+ private:
+  v8::ScriptCompiler::ScriptStreamingTask* task_;
+};
+
+
+// The times of the benchmarked phases, summed over all files.
+struct PhaseTimes {
+  PhaseTimes() : full_parse_zone_bytes(0) {}
+
+  v8::base::TimeDelta scan;
+  v8::base::TimeDelta preparse;
+  v8::base::TimeDelta full_parse;
+  v8::base::TimeDelta first_parse;
+  v8::base::TimeDelta second_parse;
+  v8::base::TimeDelta full_codegen;
+  v8::base::TimeDelta streaming;
+  v8::base::TimeDelta streaming_finalize;
+  // The largest zone used by the full parser for any of the files.
+  unsigned full_parse_zone_bytes;
+};
+
+
+v8::base::TimeDelta RunScanner(Handle<String> source) {
+  Isolate* isolate = source->GetIsolate();
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  GenericStringUtf16CharacterStream stream(source, 0, source->length());
+  Scanner scanner(isolate->unicode_cache());
+  scanner.Initialize(&stream);
+  while (scanner.Next() != Token::EOS) {
+  }
+  return timer.Elapsed();
+}
+
+
+v8::base::TimeDelta RunPreParser(Handle<String> source) {
+  Isolate* isolate = source->GetIsolate();
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  GenericStringUtf16CharacterStream stream(source, 0, source->length());
+  CompleteParserRecorder log;
+  Scanner scanner(isolate->unicode_cache());
+  scanner.Initialize(&stream);
+  PreParser preparser(&scanner, &log, isolate->stack_guard()->real_climit());
+  preparser.set_allow_lazy(true);
+  PreParser::PreParseResult result = preparser.PreParseProgram();
+  v8::base::TimeDelta time = timer.Elapsed();
+  if (result != PreParser::kPreParseSuccess || log.HasError()) {
+    fprintf(stderr, "Preparsing failed\n");
+    return v8::base::TimeDelta();
+  }
+  return time;
+}
+
+
+// Parses the whole script eagerly, as needed when lazy parsing is not
+// possible, and records the size of the zone the parser used.
+v8::base::TimeDelta RunFullParser(Handle<Script> script,
+                                  unsigned* zone_bytes) {
+  CompilationInfoWithZone info(script);
+  info.MarkAsGlobal();
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  bool success = Parser::Parse(&info, false);
+  v8::base::TimeDelta time = timer.Elapsed();
+  if (!success) {
+    fprintf(stderr, "Parsing failed\n");
+    return v8::base::TimeDelta();
+  }
+  *zone_bytes = info.zone()->allocation_size();
+  return time;
+}
+
+
+std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
+    Handle<Script> script) {
   v8::base::TimeDelta parse_time1, parse_time2;
-  Handle<Script> script = Isolate::Current()->factory()->NewScript(
-      v8::Utils::OpenHandle(*source_handle));
   i::ScriptData* cached_data_impl = NULL;
   // First round of parsing (produce data to cache).
   {
@@ -118,10 +207,124 @@ std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
       return std::make_pair(v8::base::TimeDelta(), v8::base::TimeDelta());
     }
   }
+  delete cached_data_impl;
   return std::make_pair(parse_time1, parse_time2);
 }
 
 
+// Measures the scope analysis and full-codegen of the top-level code after
+// a lazy parse, as done when a script is first compiled.
+v8::base::TimeDelta RunFullCodegen(Handle<Script> script) {
+  CompilationInfoWithZone info(script);
+  info.MarkAsGlobal();
+  info.MarkAsToplevel();
+  if (!Parser::Parse(&info, true)) {
+    fprintf(stderr, "Parsing failed\n");
+    return v8::base::TimeDelta();
+  }
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  bool success = Rewriter::Rewrite(&info) && Scope::Analyze(&info) &&
+                 FullCodeGenerator::MakeCode(&info);
+  v8::base::TimeDelta time = timer.Elapsed();
+  if (!success) {
+    fprintf(stderr, "Compilation failed\n");
+    return v8::base::TimeDelta();
+  }
+  return time;
+}
+
+
+// Parses the script on a background thread with the streaming API, and
+// returns the time of the background parse and of the compilation that
+// finishes it on the main thread.
+std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunStreaming(
+    v8::Isolate* isolate, const byte* data, int length, Encoding encoding,
+    v8::Handle<v8::String> source_handle) {
+  v8::ScriptCompiler::StreamedSource::Encoding streamed_encoding =
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE;
+  if (encoding == UTF8) {
+    streamed_encoding = v8::ScriptCompiler::StreamedSource::UTF8;
+  } else if (encoding == UTF16) {
+    streamed_encoding = v8::ScriptCompiler::StreamedSource::TWO_BYTE;
+  }
+  v8::ScriptCompiler::StreamedSource source(
+      new ChunkedSourceStream(data, length), streamed_encoding);
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &source);
+  StreamingThread thread(task);
+  thread.Start();
+  thread.Join();
+  delete task;
+  v8::base::TimeDelta background_time = timer.Elapsed();
+  timer.Restart();
+  v8::ScriptOrigin origin(v8::String::NewFromUtf8(isolate, "streamed"));
+  v8::Local<v8::Script> script =
+      v8::ScriptCompiler::Compile(isolate, &source, source_handle, origin);
+  v8::base::TimeDelta finalize_time = timer.Elapsed();
+  if (script.IsEmpty()) {
+    fprintf(stderr, "Streaming compilation failed\n");
+    return std::make_pair(v8::base::TimeDelta(), v8::base::TimeDelta());
+  }
+  return std::make_pair(background_time, finalize_time);
+}
+
+
+void RunPhases(const char* fname, Encoding encoding, int repeat,
+               v8::Isolate* isolate, PhaseTimes* times) {
+  v8::HandleScope handle_scope(isolate);
+  int length = 0;
+  const byte* source = ReadFileAndRepeat(fname, &length, repeat);
+  if (source == NULL) {
+    fprintf(stderr, "Cannot read %s\n", fname);
+    return;
+  }
+  v8::Handle<v8::String> source_handle;
+  switch (encoding) {
+    case UTF8: {
+      source_handle = v8::String::NewFromUtf8(
+          isolate, reinterpret_cast<const char*>(source));
+      break;
+    }
+    case UTF16: {
+      source_handle = v8::String::NewFromTwoByte(
+          isolate, reinterpret_cast<const uint16_t*>(source),
+          v8::String::kNormalString, length / 2);
+      break;
+    }
+    case LATIN1: {
+      StringResource8* string_resource =
+          new StringResource8(reinterpret_cast<const char*>(source), length);
+      source_handle = v8::String::NewExternal(isolate, string_resource);
+      break;
+    }
+  }
+  Handle<String> source_string = v8::Utils::OpenHandle(*source_handle);
+  Handle<Script> script =
+      reinterpret_cast<Isolate*>(isolate)->factory()->NewScript(source_string);
+
+  times->scan += RunScanner(source_string);
+  times->preparse += RunPreParser(source_string);
+  unsigned zone_bytes = 0;
+  times->full_parse += RunFullParser(script, &zone_bytes);
+  times->full_parse_zone_bytes = Max(times->full_parse_zone_bytes, zone_bytes);
+  std::pair<v8::base::TimeDelta, v8::base::TimeDelta> baseline =
+      RunBaselineParser(script);
+  times->first_parse += baseline.first;
+  times->second_parse += baseline.second;
+  times->full_codegen += RunFullCodegen(script);
+  std::pair<v8::base::TimeDelta, v8::base::TimeDelta> streaming =
+      RunStreaming(isolate, source, length, encoding, source_handle);
+  times->streaming += streaming.first;
+  times->streaming_finalize += streaming.second;
+  // The external string resource of LATIN1 sources refers to |source|, so
+  // it is kept alive until the process exits.
+  if (encoding != LATIN1) delete[] source;
+}
+
+
 int main(int argc, char* argv[]) {
   v8::V8::SetFlagsFromCommandLine(&argc, argv, true);
   v8::V8::InitializeICU();
@@ -157,20 +360,29 @@ int main(int argc, char* argv[]) {
     DCHECK(!context.IsEmpty());
     {
       v8::Context::Scope scope(context);
-      double first_parse_total = 0;
-      double second_parse_total = 0;
+      PhaseTimes times;
       for (size_t i = 0; i < fnames.size(); i++) {
-        std::pair<v8::base::TimeDelta, v8::base::TimeDelta> time =
-            RunBaselineParser(fnames[i].c_str(), encoding, repeat, isolate,
-                              context);
-        first_parse_total += time.first.InMillisecondsF();
-        second_parse_total += time.second.InMillisecondsF();
+        RunPhases(fnames[i].c_str(), encoding, repeat, isolate, &times);
       }
       if (benchmark.empty()) benchmark = "Baseline";
-      printf("%s(FirstParseRunTime): %.f ms\n", benchmark.c_str(),
-             first_parse_total);
-      printf("%s(SecondParseRunTime): %.f ms\n", benchmark.c_str(),
-             second_parse_total);
+      const char* name = benchmark.c_str();
+      printf("%s(Scanner): %.f ms\n", name, times.scan.InMillisecondsF());
+      printf("%s(PreParser): %.f ms\n", name,
+             times.preparse.InMillisecondsF());
+      printf("%s(FullParser): %.f ms\n", name,
+             times.full_parse.InMillisecondsF());
+      printf("%s(FullParserZone): %u KB\n", name,
+             times.full_parse_zone_bytes / KB);
+      printf("%s(FirstParseRunTime): %.f ms\n", name,
+             times.first_parse.InMillisecondsF());
+      printf("%s(SecondParseRunTime): %.f ms\n", name,
+             times.second_parse.InMillisecondsF());
+      printf("%s(FullCodegen): %.f ms\n", name,
+             times.full_codegen.InMillisecondsF());
+      printf("%s(StreamingParse): %.f ms\n", name,
+             times.streaming.InMillisecondsF());
+      printf("%s(StreamingFinalize): %.f ms\n", name,
+             times.streaming_finalize.InMillisecondsF());
     }
   }
   v8::V8::Dispose();
@@ -22,6 +22,7 @@ The suite json format is expected to be:
   "results_regexp": <optional regexp>,
   "results_processor": <optional python results processor script>,
   "units": <the unit specification for the performance dashboard>,
+  "counter_limits": {<V8 counter name>: <upper bound>, ...},
   "tests": [
     {
       "name": <name of the trace>,
@@ -32,6 +33,12 @@ The suite json format is expected to be:
   ]
 }
 
+The counter limits are inherited by nested suites, which can override
+single limits. If a runnable suite has counter limits, the binary is run
+with --dump-counters and every run fails whose counter values exceed the
+limits, e.g. {"V8.Deoptimizations": 50, "V8.MaxOptCountReached": 0}. This
+guards against optimization and deoptimization loops.
+
 The tests field can also nest other suites in arbitrary depth. A suite
 with a "main" file is a leaf suite that can contain one more level of
 tests.
@@ -116,6 +123,8 @@ SUPPORTED_ARCHS = ["android_arm",
 
 GENERIC_RESULTS_RE = re.compile(
     r"^Trace\(([^\)]+)\), Result\(([^\)]+)\), StdDev\(([^\)]+)\)$")
+# A row of the table printed by d8 --dump-counters.
+COUNTER_RE = r"^\| %s +\| +(-?\d+) \|$"
 
 
 def GeometricMean(values):
@@ -173,6 +182,7 @@ class DefaultSentinel(Node):
     self.stddev_regexp = None
     self.units = "score"
     self.total = False
+    self.counter_limits = {}
 
 
 class Graph(Node):
@@ -188,12 +198,15 @@ class Graph(Node):
     assert isinstance(suite["name"], basestring)
     assert isinstance(suite.get("flags", []), list)
     assert isinstance(suite.get("resources", []), list)
+    assert isinstance(suite.get("counter_limits", {}), dict)
 
     # Accumulated values.
     self.path = parent.path[:] + suite.get("path", [])
     self.graphs = parent.graphs[:] + [suite["name"]]
     self.flags = parent.flags[:] + suite.get("flags", [])
     self.resources = parent.resources[:] + suite.get("resources", [])
+    self.counter_limits = dict(parent.counter_limits)
+    self.counter_limits.update(suite.get("counter_limits", {}))
 
     # Descrete values (with parent defaults).
     self.binary = suite.get("binary", parent.binary)
@@ -282,10 +295,26 @@ class Runnable(Graph):
     return (
       [os.path.join(shell_dir, self.binary)] +
       self.flags +
+      (["--dump-counters"] if self.counter_limits else []) +
       self.resources +
       [self.main]
     )
 
+  def CheckCounterLimits(self, stdout):
+    """Returns the errors for the counters in the output that are missing or
+    exceed their limits.
+    """
+    errors = []
+    for name, limit in sorted(self.counter_limits.iteritems()):
+      match = re.search(COUNTER_RE % re.escape(name), stdout, re.M)
+      if not match:
+        errors.append("Counter %s wasn't dumped for suite %s."
+                      % (name, "/".join(self.graphs)))
+      elif int(match.group(1)) > limit:
+        errors.append("Counter %s is %s for suite %s, above the limit of %d."
+                      % (name, match.group(1), "/".join(self.graphs), limit))
+    return errors
+
   def Run(self, runner):
     """Iterates over several runs and handles the output for all traces."""
     for stdout in runner():
@@ -461,6 +490,7 @@ def Main(args):
     for runnable in FlattenRunnables(BuildGraphs(suite, options.arch)):
       print ">>> Running suite: %s" % "/".join(runnable.graphs)
       runnable.ChangeCWD(path)
+      counter_errors = []
 
       def Runner():
         """Output generator that reruns several times."""
@@ -477,10 +507,12 @@ def Main(args):
             print output.stderr
           if output.timed_out:
             print ">>> Test timed out after %ss." % runnable.timeout
+          counter_errors.extend(runnable.CheckCounterLimits(output.stdout))
           yield output.stdout
 
       # Let runnable iterate over all runs and handle output.
       results += runnable.Run(Runner)
+      results.errors.extend(counter_errors)
 
   if options.json_test_results:
     results.WriteToFile(options.json_test_results)
@@ -0,0 +1,140 @@
+#!/usr/bin/env python
+# Copyright 2014 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Aggregates the TurboFan phase events of a V8 log.
+
+Run d8 with --log-turbo-phases (and optionally --logfile=<file>), then:
+
+  tools/turbo-phases.py [--top=N] [--function=<substring>] v8.log
+
+Prints the time and zone memory of every pipeline phase over all
+compilations, followed by the slowest compilations with their most
+expensive phases. Compilations started but never finished (because they
+bailed out) are counted as aborted.
+"""
+
+import csv
+import optparse
+import sys
+
+
+class Compilation(object):
+  def __init__(self, id, function):
+    self.id = id
+    self.function = function
+    self.phases = []
+    self.zone_bytes = 0
+    self.finished = False
+
+  def TotalTime(self):
+    return sum(ms for _, ms, _ in self.phases)
+
+
+class PhaseTotals(object):
+  def __init__(self, name):
+    self.name = name
+    self.count = 0
+    self.time = 0.0
+    self.max_time = 0.0
+    self.bytes = 0
+    self.max_bytes = 0
+
+  def Add(self, ms, bytes):
+    self.count += 1
+    self.time += ms
+    self.max_time = max(self.max_time, ms)
+    self.bytes += bytes
+    self.max_bytes = max(self.max_bytes, bytes)
+
+
+def ReadCompilations(log_file):
+  # Optimization ids are unique per isolate only, so a compilation is the
+  # latest one started with its id.
+  compilations = []
+  current = {}
+  for row in csv.reader(log_file):
+    if not row:
+      continue
+    event = row[0]
+    if event == "turbo-compile-start":
+      compilation = Compilation(int(row[1]), row[2])
+      compilations.append(compilation)
+      current[compilation.id] = compilation
+    elif event == "turbo-phase":
+      compilation = current.get(int(row[1]))
+      if compilation:
+        compilation.phases.append((row[2], float(row[3]), int(row[4])))
+    elif event == "turbo-compile-end":
+      compilation = current.get(int(row[1]))
+      if compilation:
+        compilation.zone_bytes = int(row[2])
+        compilation.finished = True
+  return compilations
+
+
+def PrintPhases(compilations):
+  phases = {}
+  order = []
+  for compilation in compilations:
+    for name, ms, bytes in compilation.phases:
+      if name not in phases:
+        phases[name] = PhaseTotals(name)
+        order.append(name)
+      phases[name].Add(ms, bytes)
+  total_time = sum(p.time for p in phases.values())
+  print "%-26s %6s %11s %7s %10s %10s %11s %11s" % (
+      "Phase", "Count", "Total (ms)", "%", "Mean (ms)", "Max (ms)",
+      "Zone (KB)", "Max zone")
+  for name in order:
+    p = phases[name]
+    print "%-26s %6d %11.3f %6.1f%% %10.3f %10.3f %11d %11d" % (
+        name, p.count, p.time, 100.0 * p.time / max(total_time, 1e-9),
+        p.time / p.count, p.max_time, p.bytes / 1024, p.max_bytes / 1024)
+  print "%-26s %6s %11.3f" % ("Total", "", total_time)
+
+
+def PrintSlowest(compilations, top):
+  slowest = sorted(compilations, key=lambda c: c.TotalTime(), reverse=True)
+  print
+  print "Slowest compilations:"
+  for compilation in slowest[:top]:
+    status = "" if compilation.finished else " (aborted)"
+    print "  %9.3f ms %7d KB  %s%s" % (
+        compilation.TotalTime(), compilation.zone_bytes / 1024,
+        compilation.function or "<anonymous>", status)
+    phases = sorted(compilation.phases, key=lambda p: p[1], reverse=True)
+    for name, ms, bytes in phases[:3]:
+      print "      %9.3f ms %7d KB  %s" % (ms, bytes / 1024, name)
+
+
+def Main(args):
+  parser = optparse.OptionParser(usage="%prog [options] <v8.log>")
+  parser.add_option("--top", type="int", default=10,
+                    help="Number of slowest compilations to print")
+  parser.add_option("--function",
+                    help="Only aggregate functions whose name contains this")
+  (options, args) = parser.parse_args(args)
+  if len(args) != 1:
+    parser.print_help()
+    return 1
+
+  with open(args[0]) as log_file:
+    compilations = ReadCompilations(log_file)
+  if options.function:
+    compilations = [c for c in compilations
+                    if options.function in c.function]
+  if not compilations:
+    print "No TurboFan compilations found, was --log-turbo-phases given?"
+    return 1
+  aborted = len([c for c in compilations if not c.finished])
+  print "%d compilations, %d aborted" % (len(compilations), aborted)
+  print
+  PrintPhases(compilations)
+  PrintSlowest(compilations, options.top)
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(Main(sys.argv[1:]))
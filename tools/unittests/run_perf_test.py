@@ -338,6 +338,35 @@ class PerfTest(unittest.TestCase):
         ["Regexp \"^Richards: (.+)$\" didn't match for test Richards."])
     self._VerifyMock(path.join("out", "x64.release", "d7"), "--flag", "run.js")
 
+  def testCounterLimits(self):
+    test_input = dict(V8_JSON)
+    test_input["counter_limits"] = {"V8.Deoptimizations": 5,
+                                    "V8.MaxOptCountReached": 0}
+    self._WriteTestInput(test_input)
+    self._MockCommand(["."], [
+      "Richards: 1.234\nDeltaBlue: 10657567\n"
+      "| V8.Deoptimizations          |           7 |\n"
+      "| V8.MaxOptCountReached       |           0 |\n"])
+    self.assertEquals(1, self._CallMain())
+    self._VerifyResults("test", "score", [
+      {"name": "Richards", "results": ["1.234"], "stddev": ""},
+      {"name": "DeltaBlue", "results": ["10657567"], "stddev": ""},
+    ])
+    self._VerifyErrors(
+        ["Counter V8.Deoptimizations is 7 for suite test, above the limit "
+         "of 5."])
+    self._VerifyMock(path.join("out", "x64.release", "d7"), "--flag",
+                     "--dump-counters", "run.js")
+
+  def testCounterLimitsMissingCounter(self):
+    test_input = dict(V8_JSON)
+    test_input["counter_limits"] = {"V8.Deoptimizations": 5}
+    self._WriteTestInput(test_input)
+    self._MockCommand(["."], ["Richards: 1.234\nDeltaBlue: 10657567\n"])
+    self.assertEquals(1, self._CallMain())
+    self._VerifyErrors(
+        ["Counter V8.Deoptimizations wasn't dumped for suite test."])
+
   def testOneRunGeneric(self):
     test_input = dict(V8_GENERIC_JSON)
     self._WriteTestInput(test_input)